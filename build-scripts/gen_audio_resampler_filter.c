@@ -51,6 +51,10 @@ gcc -o genfilter build-scripts/gen_audio_resampler_filter.c -lm && ./genfilter >
 #define RESAMPLER_SAMPLES_PER_ZERO_CROSSING  (1 << RESAMPLER_BITS_PER_ZERO_CROSSING)
 #define RESAMPLER_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_ZERO_CROSSINGS)
 
+/* A longer filter, for SDL_AUDIO_RESAMPLE_QUALITY_HIGH */
+#define RESAMPLER_HQ_ZERO_CROSSINGS 12
+#define RESAMPLER_HQ_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_HQ_ZERO_CROSSINGS)
+
 /* This is a "modified" bessel function, so you can't use POSIX j0() */
 static double
 bessel(const double x)
@@ -90,6 +94,7 @@ kaiser_and_sinc(double *table, const int tablelen, const double beta)
 }
 
 static double ResamplerFilter[RESAMPLER_FILTER_SIZE];
+static double ResamplerHQFilter[RESAMPLER_HQ_FILTER_SIZE];
 
 static void
 PrepareResampleFilter(void)
@@ -97,13 +102,27 @@ PrepareResampleFilter(void)
     /* if dB > 50, beta=(0.1102 * (dB - 8.7)), according to Matlab. */
     const double dB = 80.0;
     const double beta = 0.1102 * (dB - 8.7);
+    const double hq_dB = 100.0;
+    const double hq_beta = 0.1102 * (hq_dB - 8.7);
     kaiser_and_sinc(ResamplerFilter, RESAMPLER_FILTER_SIZE, beta);
+    kaiser_and_sinc(ResamplerHQFilter, RESAMPLER_HQ_FILTER_SIZE, hq_beta);
 }
 
-int main(void)
+static void
+PrintResampleFilter(const char *name, const double *filter, const int zero_crossings, const char *size)
 {
     int i, j;
 
+    printf("static const float %s[%s] = {", name, size);
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_ZERO_CROSSING * zero_crossings; i++) {
+        j = (i % zero_crossings) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING + (i / zero_crossings);
+        printf("%s%12.9ff,", (i % zero_crossings) ? "" : "\n    ", filter[j]);
+    }
+    printf("\n};\n\n");
+}
+
+int main(void)
+{
     PrepareResampleFilter();
 
     printf(
@@ -135,15 +154,13 @@ int main(void)
         "#define RESAMPLER_BITS_PER_ZERO_CROSSING ((RESAMPLER_BITS_PER_SAMPLE / 2) + 1)\n"
         "#define RESAMPLER_SAMPLES_PER_ZERO_CROSSING (1 << RESAMPLER_BITS_PER_ZERO_CROSSING)\n"
         "#define RESAMPLER_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_ZERO_CROSSINGS)\n"
-        "\n", RESAMPLER_ZERO_CROSSINGS, RESAMPLER_BITS_PER_SAMPLE
+        "#define RESAMPLER_HQ_ZERO_CROSSINGS %d\n"
+        "#define RESAMPLER_HQ_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_HQ_ZERO_CROSSINGS)\n"
+        "\n", RESAMPLER_ZERO_CROSSINGS, RESAMPLER_BITS_PER_SAMPLE, RESAMPLER_HQ_ZERO_CROSSINGS
     );
 
-    printf("static const float ResamplerFilter[RESAMPLER_FILTER_SIZE] = {");
-    for (i = 0; i < RESAMPLER_FILTER_SIZE; i++) {
-        j = (i % RESAMPLER_ZERO_CROSSINGS) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING + (i / RESAMPLER_ZERO_CROSSINGS);
-        printf("%s%12.9ff,", (i % RESAMPLER_ZERO_CROSSINGS) ? "" : "\n    ", ResamplerFilter[j]);
-    }
-    printf("\n};\n\n");
+    PrintResampleFilter("ResamplerFilter", ResamplerFilter, RESAMPLER_ZERO_CROSSINGS, "RESAMPLER_FILTER_SIZE");
+    PrintResampleFilter("ResamplerHQFilter", ResamplerHQFilter, RESAMPLER_HQ_ZERO_CROSSINGS, "RESAMPLER_HQ_FILTER_SIZE");
 
     return 0;
 }
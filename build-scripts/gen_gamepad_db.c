@@ -0,0 +1,275 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+
+Built with:
+
+gcc -o gengamepaddb build-scripts/gen_gamepad_db.c && ./gengamepaddb gamecontrollerdb.txt gamecontrollerdb.bin
+
+*/
+
+/*
+   This compiles a text gamepad mapping database, in the format read by
+   SDL_AddGamepadMappingsFromFile(), into the binary format that the same
+   function detects and loads without parsing GUID strings or splitting lines.
+
+   The format is described next to SDL_GAMEPAD_DB_MAGIC in
+   src/joystick/SDL_gamepad.c, keep the two in sync.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define GAMEPAD_DB_MAGIC        "SDLGPDB"
+#define GAMEPAD_DB_VERSION      1
+#define GAMEPAD_DB_FLAG_DEFAULT 0x01
+#define GAMEPAD_DB_FLAG_XINPUT  0x02
+#define PLATFORM_FIELD          "platform:"
+
+typedef struct
+{
+    unsigned char guid[16];
+    unsigned long flags;
+    unsigned long name;
+    unsigned long mapping;
+    unsigned long platform;
+} Entry;
+
+static Entry *entries;
+static unsigned long num_entries;
+static char *strings;
+static unsigned long strings_size;
+
+static unsigned long add_string(const char *string, size_t length)
+{
+    unsigned long offset = strings_size;
+
+    strings = (char *)realloc(strings, strings_size + length + 1);
+    if (!strings) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    memcpy(strings + strings_size, string, length);
+    strings[strings_size + length] = '\0';
+    strings_size += (unsigned long)(length + 1);
+    return offset;
+}
+
+static unsigned long add_platform(const char *platform, size_t length)
+{
+    unsigned long i;
+
+    /* There are only a handful of platforms, share their strings */
+    for (i = 0; i < num_entries; ++i) {
+        const char *other = strings + entries[i].platform;
+        if (strlen(other) == length && memcmp(other, platform, length) == 0) {
+            return entries[i].platform;
+        }
+    }
+    return add_string(platform, length);
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return 0;
+}
+
+/* This matches SDL_PrivateGetGamepadGUIDFromMappingString() and SDL_GUIDFromString() */
+static void parse_guid(char *guid_string, const char *platform, unsigned char *guid)
+{
+    size_t i, length = strlen(guid_string);
+
+    /* Convert old style GUIDs to the new style in 2.0.5 */
+    if (strcmp(platform, "Windows") == 0) {
+        if (length == 32 && memcmp(&guid_string[20], "504944564944", 12) == 0) {
+            memcpy(&guid_string[20], "000000000000", 12);
+            memcpy(&guid_string[16], &guid_string[4], 4);
+            memcpy(&guid_string[8], &guid_string[0], 4);
+            memcpy(&guid_string[0], "03000000", 8);
+        }
+    } else if (strcmp(platform, "Mac OS X") == 0) {
+        if (length == 32 &&
+            memcmp(&guid_string[4], "000000000000", 12) == 0 &&
+            memcmp(&guid_string[20], "000000000000", 12) == 0) {
+            memcpy(&guid_string[20], "000000000000", 12);
+            memcpy(&guid_string[8], &guid_string[0], 4);
+            memcpy(&guid_string[0], "03000000", 8);
+        }
+    }
+
+    memset(guid, 0, 16);
+    length &= ~(size_t)1;
+    for (i = 0; i < length && i < 32; i += 2) {
+        guid[i / 2] = (unsigned char)((hex_value(guid_string[i]) << 4) | hex_value(guid_string[i + 1]));
+    }
+}
+
+static void add_line(char *line)
+{
+    char *name, *mapping, *end, *platform, *platform_end;
+    Entry *entry;
+
+    while (isspace((unsigned char)*line)) {
+        ++line;
+    }
+    if (*line == '\0' || *line == '#') {
+        return;
+    }
+
+    /* Lines without a platform are ignored by SDL */
+    platform = strstr(line, PLATFORM_FIELD);
+    if (!platform) {
+        return;
+    }
+    platform += strlen(PLATFORM_FIELD);
+    platform_end = strchr(platform, ',');
+    if (!platform_end) {
+        return;
+    }
+
+    name = strchr(line, ',');
+    if (!name) {
+        return;
+    }
+    *name++ = '\0';
+    mapping = strchr(name, ',');
+    if (!mapping) {
+        return;
+    }
+    *mapping++ = '\0';
+    while (isspace((unsigned char)*mapping)) {
+        ++mapping;
+    }
+    end = mapping + strlen(mapping);
+    while (end > mapping && isspace((unsigned char)end[-1])) {
+        --end;
+    }
+
+    entries = (Entry *)realloc(entries, (num_entries + 1) * sizeof(*entries));
+    if (!entries) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    entry = &entries[num_entries];
+    memset(entry, 0, sizeof(*entry));
+
+    entry->platform = add_platform(platform, platform_end - platform);
+    if (strcmp(line, "default") == 0) {
+        entry->flags = GAMEPAD_DB_FLAG_DEFAULT;
+    } else if (strcmp(line, "xinput") == 0) {
+        entry->flags = GAMEPAD_DB_FLAG_XINPUT;
+    } else {
+        parse_guid(line, strings + entry->platform, entry->guid);
+    }
+    entry->name = add_string(name, strlen(name));
+    entry->mapping = add_string(mapping, end - mapping);
+    ++num_entries;
+}
+
+static void write_le32(FILE *file, unsigned long value)
+{
+    unsigned char data[4];
+
+    data[0] = (unsigned char)(value & 0xFF);
+    data[1] = (unsigned char)((value >> 8) & 0xFF);
+    data[2] = (unsigned char)((value >> 16) & 0xFF);
+    data[3] = (unsigned char)((value >> 24) & 0xFF);
+    fwrite(data, sizeof(data), 1, file);
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file;
+    char *text, *line, *line_end;
+    long text_size;
+    unsigned long i;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s gamecontrollerdb.txt gamecontrollerdb.bin\n", argv[0]);
+        return 1;
+    }
+
+    file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "Couldn't open %s\n", argv[1]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    text_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    text = (char *)malloc(text_size + 1);
+    if (!text || fread(text, 1, text_size, file) != (size_t)text_size) {
+        fprintf(stderr, "Couldn't read %s\n", argv[1]);
+        return 1;
+    }
+    text[text_size] = '\0';
+    fclose(file);
+
+    for (line = text; line < text + text_size; line = line_end + 1) {
+        line_end = strchr(line, '\n');
+        if (!line_end) {
+            line_end = text + text_size;
+        }
+        *line_end = '\0';
+        add_line(line);
+    }
+    if (strings_size == 0) {
+        /* The string table is never empty */
+        add_string("", 0);
+    }
+
+    file = fopen(argv[2], "wb");
+    if (!file) {
+        fprintf(stderr, "Couldn't create %s\n", argv[2]);
+        return 1;
+    }
+    fwrite(GAMEPAD_DB_MAGIC, sizeof(GAMEPAD_DB_MAGIC), 1, file);
+    write_le32(file, GAMEPAD_DB_VERSION);
+    write_le32(file, num_entries);
+    write_le32(file, strings_size);
+    for (i = 0; i < num_entries; ++i) {
+        fwrite(entries[i].guid, sizeof(entries[i].guid), 1, file);
+        write_le32(file, entries[i].flags);
+        write_le32(file, entries[i].name);
+        write_le32(file, entries[i].mapping);
+        write_le32(file, entries[i].platform);
+    }
+    fwrite(strings, strings_size, 1, file);
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Couldn't write %s\n", argv[2]);
+        return 1;
+    }
+
+    printf("Wrote %lu mappings to %s\n", num_entries, argv[2]);
+    return 0;
+}
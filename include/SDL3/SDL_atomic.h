@@ -409,6 +409,216 @@ extern DECLSPEC void* SDLCALL SDL_AtomicSetPtr(void **a, void* v);
  */
 extern DECLSPEC void* SDLCALL SDL_AtomicGetPtr(void **a);
 
+/**
+ * Define SDL_ATOMIC_INLINE before including SDL headers to have the atomic
+ * operations above compiled inline with compiler builtins instead of calling
+ * into SDL.
+ *
+ * The atomics are called often enough in tight loops that the function call
+ * and the dynamic API dispatch can show up in a profile. They have no state
+ * inside SDL, so inlining them can't change behavior, but it does mean an
+ * SDL library swapped in through SDL_DYNAMIC_API can't override them.
+ *
+ * This is only available with compilers that support the GCC __atomic
+ * builtins, and is ignored elsewhere.
+ */
+#if defined(SDL_ATOMIC_INLINE) && !defined(SDL_AtomicGet) && \
+    ((defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))) || defined(__clang__))
+
+SDL_FORCE_INLINE SDL_bool SDL_AtomicCAS_inline(SDL_AtomicInt *a, int oldval, int newval)
+{
+    return __atomic_compare_exchange_n(&a->value, &oldval, newval, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_FORCE_INLINE int SDL_AtomicSet_inline(SDL_AtomicInt *a, int v)
+{
+    return __atomic_exchange_n(&a->value, v, __ATOMIC_SEQ_CST);
+}
+
+SDL_FORCE_INLINE int SDL_AtomicGet_inline(SDL_AtomicInt *a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST);
+}
+
+SDL_FORCE_INLINE int SDL_AtomicAdd_inline(SDL_AtomicInt *a, int v)
+{
+    return __atomic_fetch_add(&a->value, v, __ATOMIC_SEQ_CST);
+}
+
+SDL_FORCE_INLINE SDL_bool SDL_AtomicCASPtr_inline(void **a, void *oldval, void *newval)
+{
+    return __atomic_compare_exchange_n(a, &oldval, newval, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_FORCE_INLINE void *SDL_AtomicSetPtr_inline(void **a, void *v)
+{
+    return __atomic_exchange_n(a, v, __ATOMIC_SEQ_CST);
+}
+
+SDL_FORCE_INLINE void *SDL_AtomicGetPtr_inline(void **a)
+{
+    return __atomic_load_n(a, __ATOMIC_SEQ_CST);
+}
+
+#define SDL_AtomicCAS       SDL_AtomicCAS_inline
+#define SDL_AtomicSet       SDL_AtomicSet_inline
+#define SDL_AtomicGet       SDL_AtomicGet_inline
+#define SDL_AtomicAdd       SDL_AtomicAdd_inline
+#define SDL_AtomicCASPtr    SDL_AtomicCASPtr_inline
+#define SDL_AtomicSetPtr    SDL_AtomicSetPtr_inline
+#define SDL_AtomicGetPtr    SDL_AtomicGetPtr_inline
+
+#endif /* SDL_ATOMIC_INLINE */
+
+/**
+ * A bounded lock-free queue with a single producer and a single consumer.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSPSCQueue
+ */
+typedef struct SDL_SPSCQueue SDL_SPSCQueue;
+
+/**
+ * Create a lock-free queue for passing items from one thread to another.
+ *
+ * One thread may call SDL_EnqueueSPSC() and one other thread may call
+ * SDL_DequeueSPSC() at the same time without any locking. Items are copied
+ * into and out of the queue, and are returned in the order they were added.
+ *
+ * \param capacity the number of items the queue can hold, rounded up to a
+ *                 power of two
+ * \param item_size the size of each item, in bytes
+ * \returns a new queue or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DequeueSPSC
+ * \sa SDL_DestroySPSCQueue
+ * \sa SDL_EnqueueSPSC
+ */
+extern DECLSPEC SDL_SPSCQueue *SDLCALL SDL_CreateSPSCQueue(int capacity, size_t item_size);
+
+/**
+ * Add an item to the end of a single producer queue.
+ *
+ * This must only be called from the producer thread.
+ *
+ * \param queue the queue to add to
+ * \param item a pointer to the item to copy into the queue
+ * \returns SDL_TRUE if the item was added or SDL_FALSE if the queue is full.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DequeueSPSC
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_EnqueueSPSC(SDL_SPSCQueue *queue, const void *item);
+
+/**
+ * Remove an item from the front of a single consumer queue.
+ *
+ * This must only be called from the consumer thread.
+ *
+ * \param queue the queue to remove from
+ * \param item a pointer filled in with a copy of the item
+ * \returns SDL_TRUE if an item was removed or SDL_FALSE if the queue is
+ *          empty.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EnqueueSPSC
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_DequeueSPSC(SDL_SPSCQueue *queue, void *item);
+
+/**
+ * Destroy a single producer, single consumer queue.
+ *
+ * No other thread may be using the queue when it is destroyed.
+ *
+ * \param queue the queue to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSPSCQueue
+ */
+extern DECLSPEC void SDLCALL SDL_DestroySPSCQueue(SDL_SPSCQueue *queue);
+
+/**
+ * A bounded lock-free queue with any number of producers and consumers.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateMPMCQueue
+ */
+typedef struct SDL_MPMCQueue SDL_MPMCQueue;
+
+/**
+ * Create a lock-free queue that can be shared by any number of threads.
+ *
+ * Any thread may call SDL_EnqueueMPMC() and SDL_DequeueMPMC() at the same
+ * time without any locking. Items are copied into and out of the queue.
+ * Items added by one thread are removed in the order that thread added
+ * them.
+ *
+ * \param capacity the number of items the queue can hold, rounded up to a
+ *                 power of two
+ * \param item_size the size of each item, in bytes
+ * \returns a new queue or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DequeueMPMC
+ * \sa SDL_DestroyMPMCQueue
+ * \sa SDL_EnqueueMPMC
+ */
+extern DECLSPEC SDL_MPMCQueue *SDLCALL SDL_CreateMPMCQueue(int capacity, size_t item_size);
+
+/**
+ * Add an item to the end of a multiple producer queue.
+ *
+ * \param queue the queue to add to
+ * \param item a pointer to the item to copy into the queue
+ * \returns SDL_TRUE if the item was added or SDL_FALSE if the queue is full.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DequeueMPMC
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_EnqueueMPMC(SDL_MPMCQueue *queue, const void *item);
+
+/**
+ * Remove an item from the front of a multiple consumer queue.
+ *
+ * \param queue the queue to remove from
+ * \param item a pointer filled in with a copy of the item
+ * \returns SDL_TRUE if an item was removed or SDL_FALSE if the queue is
+ *          empty.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EnqueueMPMC
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_DequeueMPMC(SDL_MPMCQueue *queue, void *item);
+
+/**
+ * Destroy a multiple producer, multiple consumer queue.
+ *
+ * No other thread may be using the queue when it is destroyed.
+ *
+ * \param queue the queue to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateMPMCQueue
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyMPMCQueue(SDL_MPMCQueue *queue);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -351,6 +351,73 @@ extern DECLSPEC char *SDLCALL SDL_GetAudioDeviceName(SDL_AudioDeviceID devid);
  */
 extern DECLSPEC int SDLCALL SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int *sample_frames);
 
+/**
+ * Get the properties associated with a physical audio device.
+ *
+ * The following read-only properties are provided by SDL, and are refreshed
+ * every time this function is called:
+ *
+ * ```
+ * "SDL.audio.device.latency_frames" (number) - the latency between SDL and the hardware, in sample frames, as reported by the audio backend. If the backend can't measure this, it's the device buffer size.
+ * "SDL.audio.device.low_latency" (boolean) - SDL_TRUE if the device is open and the backend honored SDL_HINT_AUDIO_DEVICE_LOW_LATENCY
+ * "SDL.audio.device.exclusive" (boolean) - SDL_TRUE if the device is open with exclusive access to the hardware
+ * ```
+ *
+ * Latency can be converted to milliseconds with the same equation as
+ * SDL_GetAudioDeviceFormat() uses for the buffer size.
+ *
+ * These read-only properties report how the device's audio thread is
+ * keeping up. They count from when the device was last opened, and are
+ * useful for tuning buffer sizes:
+ *
+ * ```
+ * "SDL.audio.device.stats.iterations" (number) - the number of buffers the audio thread has mixed (or captured)
+ * "SDL.audio.device.stats.mix_ns" (number) - the time spent mixing the last buffer, in nanoseconds
+ * "SDL.audio.device.stats.max_mix_ns" (number) - the longest time spent mixing a buffer, in nanoseconds
+ * "SDL.audio.device.stats.average_mix_ns" (number) - the average time spent mixing a buffer, in nanoseconds
+ * "SDL.audio.device.stats.wait_ns" (number) - the time between the last two buffers, mostly spent waiting for the device, in nanoseconds
+ * "SDL.audio.device.stats.max_wait_ns" (number) - the longest time between two buffers, in nanoseconds
+ * "SDL.audio.device.stats.streams" (number) - the number of streams mixed into the last buffer (or fed from it, for capture devices)
+ * "SDL.audio.device.stats.late_buffers" (number) - the number of buffers that took longer to mix than they take to play
+ * "SDL.audio.device.stats.xruns" (number) - the number of underruns (or overruns, for capture devices) reported by the audio backend. This stays zero if the backend can't report them.
+ * ```
+ *
+ * The app can set these properties to control the thread SDL runs the
+ * device on. They take effect the next time the physical device is opened:
+ *
+ * ```
+ * "SDL.audio.device.thread.priority" (string) - the scheduling class of the device thread: "normal", "high", "time_critical" or "realtime". "realtime" uses SCHED_FIFO (through rtkit if needed) on Linux and MMCSS "Pro Audio" on Windows. By default, output devices use "time_critical" and capture devices use "high".
+ * "SDL.audio.device.thread.cpu" (number) - the index of a CPU core to pin the device thread to, or -1 to let it move around, which is the default. This is supported on Linux and Windows.
+ * ```
+ *
+ * Whether those requests were granted is reported in these read-only
+ * properties, while the device is open:
+ *
+ * ```
+ * "SDL.audio.device.thread.priority_applied" (boolean) - SDL_TRUE if the device thread got the requested scheduling class
+ * "SDL.audio.device.thread.cpu_applied" (boolean) - SDL_TRUE if the device thread was pinned to the requested CPU core
+ * ```
+ *
+ * Backends that run the device on a thread they don't control, like
+ * PipeWire and CoreAudio, ignore the thread properties.
+ *
+ * You may also specify SDL_AUDIO_DEVICE_DEFAULT_OUTPUT or
+ * SDL_AUDIO_DEVICE_DEFAULT_CAPTURE here. Logical device IDs report the
+ * properties of the physical device they are opened on.
+ *
+ * \param devid the instance ID of the device to query.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceFormat
+ * \sa SDL_GetProperty
+ */
+extern DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid);
+
 
 /**
  * Open a specific audio device.
@@ -778,6 +845,265 @@ extern DECLSPEC float SDLCALL SDL_GetAudioStreamFrequencyRatio(SDL_AudioStream *
  */
 extern DECLSPEC int SDLCALL SDL_SetAudioStreamFrequencyRatio(SDL_AudioStream *stream, float ratio);
 
+/**
+ * The filter an audio stream uses when it changes sample rates.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamResampleQuality
+ */
+typedef enum
+{
+    SDL_AUDIO_RESAMPLE_QUALITY_LOW,     /**< linear interpolation; the cheapest, and good enough for many sound effects */
+    SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM,  /**< a short windowed sinc filter (the default) */
+    SDL_AUDIO_RESAMPLE_QUALITY_HIGH     /**< a long windowed sinc filter with better stopband rejection, for music; several times the cost of medium */
+} SDL_AudioResampleQuality;
+
+/**
+ * Get the resampling quality of an audio stream.
+ *
+ * \param stream the SDL_AudioStream to query.
+ * \returns the resampling quality of the stream.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamResampleQuality
+ */
+extern DECLSPEC SDL_AudioResampleQuality SDLCALL SDL_GetAudioStreamResampleQuality(SDL_AudioStream *stream);
+
+/**
+ * Change the resampling quality of an audio stream.
+ *
+ * This picks the filter used when the stream's input and output sample
+ * rates differ, or its frequency ratio isn't 1.0. Lower quality is cheaper,
+ * and also holds back fewer frames of input while waiting for more data. It
+ * can be changed at any time, and has no effect on a stream that isn't
+ * resampling.
+ *
+ * \param stream The stream whose resampling quality is being changed
+ * \param quality The SDL_AudioResampleQuality to use.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamResampleQuality
+ * \sa SDL_SetAudioStreamFrequencyRatio
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamResampleQuality(SDL_AudioStream *stream, SDL_AudioResampleQuality quality);
+
+/**
+ * Get the gain of an audio stream.
+ *
+ * If a fade is in progress, this reports the gain the stream has reached so
+ * far.
+ *
+ * \param stream the SDL_AudioStream to query.
+ * \returns the gain of the stream, or -1.0f on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamGain
+ * \sa SDL_FadeAudioStreamGain
+ */
+extern DECLSPEC float SDLCALL SDL_GetAudioStreamGain(SDL_AudioStream *stream);
+
+/**
+ * Change the gain of an audio stream.
+ *
+ * The gain of a stream is its volume; a larger gain means a louder output,
+ * with no change if the gain is 1.0. The gain is applied while converting
+ * data in SDL_GetAudioStreamData, so it costs little when a stream is already
+ * converting its data, and it can be changed at any time, including while the
+ * stream is bound to an audio device.
+ *
+ * This cancels any fade in progress.
+ *
+ * \param stream The stream whose gain is being changed
+ * \param gain The gain. 1.0 is no change, 0.0 is silence. Must be >= 0.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamGain
+ * \sa SDL_FadeAudioStreamGain
+ * \sa SDL_SetAudioStreamPan
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamGain(SDL_AudioStream *stream, float gain);
+
+/**
+ * Gradually change the gain of an audio stream.
+ *
+ * The gain moves in a straight line from its current value to `gain` over
+ * the next `frames` sample frames of output from the stream. This replaces
+ * any fade already in progress, starting from wherever it got to.
+ *
+ * \param stream The stream whose gain is being changed
+ * \param gain The gain to end up at. Must be >= 0.
+ * \param frames The number of output sample frames to spread the change
+ *               over, in the stream's destination format. 0 changes the gain
+ *               immediately.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamGain
+ * \sa SDL_SetAudioStreamGain
+ */
+extern DECLSPEC int SDLCALL SDL_FadeAudioStreamGain(SDL_AudioStream *stream, float gain, int frames);
+
+/**
+ * Get the pan of an audio stream.
+ *
+ * \param stream the SDL_AudioStream to query.
+ * \returns the pan of the stream, or 0.0f on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamPan
+ */
+extern DECLSPEC float SDLCALL SDL_GetAudioStreamPan(SDL_AudioStream *stream);
+
+/**
+ * Change the pan of an audio stream.
+ *
+ * Panning moves a stream's output toward the left or right by turning the
+ * other side down: at -1.0 only the left channel is heard, at 1.0 only the
+ * right, and at 0.0 both are left alone. It is applied along with the
+ * stream's gain, and only affects a stream whose output is stereo.
+ *
+ * \param stream The stream whose pan is being changed
+ * \param pan The pan, between -1.0 (left) and 1.0 (right).
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamPan
+ * \sa SDL_SetAudioStreamGain
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamPan(SDL_AudioStream *stream, float pan);
+
+/**
+ * Mix an audio stream's channels through a custom matrix.
+ *
+ * When an audio stream changes the number of channels, it normally mixes
+ * them with builtin weights for SDL's standard speaker layouts (see
+ * SDL_AudioSpec). This replaces those weights with a matrix of your own,
+ * which can also remap or mix channels when the count doesn't change.
+ *
+ * `matrix` is `dst_channels` rows of `src_channels` floats: output channel
+ * `o` is the sum of every input channel `i` multiplied by
+ * `matrix[o * src_channels + i]`. The matrix is copied, so it can be freed
+ * once this function returns.
+ *
+ * The matrix is only used while the stream's input has `src_channels`
+ * channels and its output has `dst_channels` channels. Any other channel
+ * counts get the builtin conversion.
+ *
+ * \param stream The stream whose channel mixing is being changed
+ * \param src_channels the number of input channels the matrix mixes (1-8).
+ * \param dst_channels the number of output channels the matrix produces
+ *                     (1-8).
+ * \param matrix `dst_channels * src_channels` weights, or NULL to go back to
+ *               the builtin conversion.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamFormat
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamChannelMatrix(SDL_AudioStream *stream, int src_channels, int dst_channels, const float *matrix);
+
+/**
+ * Let an audio stream accept new data without taking its lock.
+ *
+ * Normally, SDL_PutAudioStreamData holds a stream-specific mutex while it
+ * queues data, so a thread feeding a stream can stall the audio device
+ * thread that is reading from it, and vice versa. When this is enabled, new
+ * data is handed to the stream without taking that mutex, and picked up the
+ * next time the stream is read from or queried.
+ *
+ * This is meant for a single thread feeding a stream that is being read by
+ * another, like the audio device thread. While it is enabled, the source
+ * format of the stream should only be changed from the thread putting data
+ * into it. A stream with a put callback set always takes its lock in
+ * SDL_PutAudioStreamData, as the callback needs it.
+ *
+ * This is disabled by default.
+ *
+ * \param stream The stream to change
+ * \param enabled SDL_TRUE to put data without taking the stream's lock,
+ *                SDL_FALSE to go back to the default behavior.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_SetAudioStreamPutCallback
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamLockFree(SDL_AudioStream *stream, SDL_bool enabled);
+
+/**
+ * Let an audio stream convert new data as it is put, instead of as it is read.
+ *
+ * Normally, data is queued as-is and converted/resampled when it's taken out
+ * of the stream, which for a stream bound to an audio device happens on the
+ * device thread. When this is enabled, SDL_PutAudioStreamData and
+ * SDL_FlushAudioStream convert everything they can to the stream's output
+ * format before returning, a chunk at a time, so the device thread mostly
+ * just copies and mixes. If the reader gets ahead of the converted data, it
+ * converts the rest itself, as usual.
+ *
+ * Since conversion happens earlier, changes to the stream's gain, pan,
+ * channel matrix, frequency ratio or resampling quality only affect data put
+ * after the change. If the output format changes, already converted data is
+ * converted again on read; if the output sample rate changes, it is dropped.
+ * This has no effect on data put while lock-free puts are enabled, see
+ * SDL_SetAudioStreamLockFree.
+ *
+ * This is disabled by default.
+ *
+ * \param stream The stream to change
+ * \param enabled SDL_TRUE to convert data as it is put, SDL_FALSE to go back
+ *                to converting it as it is read.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_SetAudioStreamLockFree
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamPreconvert(SDL_AudioStream *stream, SDL_bool enabled);
+
 /**
  * Add data to be converted/resampled to the stream.
  *
@@ -807,9 +1133,62 @@ extern DECLSPEC int SDLCALL SDL_SetAudioStreamFrequencyRatio(SDL_AudioStream *st
  * \sa SDL_FlushAudioStream
  * \sa SDL_ClearAudioStream
  * \sa SDL_DestroyAudioStream
+ * \sa SDL_SetAudioStreamLockFree
  */
 extern DECLSPEC int SDLCALL SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len);
 
+/**
+ * A callback that fires when an SDL_AudioStream is done with data added by
+ * SDL_PutAudioStreamDataNoCopy.
+ *
+ * This runs once the stream has read all of the data, or thrown it away
+ * because the stream was cleared or destroyed. After that, the app may free
+ * or reuse the buffer. It may run on any thread, while the stream's lock is
+ * held, so it shouldn't do much more than release the buffer.
+ *
+ * \param userdata An opaque pointer provided by the app for their personal use.
+ * \param buf The pointer that was passed to SDL_PutAudioStreamDataNoCopy.
+ * \param buflen The number of bytes that were passed to
+ *               SDL_PutAudioStreamDataNoCopy.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+typedef void (SDLCALL *SDL_AudioStreamDataCompleteCallback)(void *userdata, const void *buf, int buflen);
+
+/**
+ * Add data to the stream without copying it.
+ *
+ * This works like SDL_PutAudioStreamData, except that the stream reads from
+ * `buf` directly instead of copying the data into memory of its own. This
+ * saves a copy and an allocation per call, which adds up for things like
+ * sound effects that are decoded once and played many times.
+ *
+ * The buffer belongs to the app, and must stay valid and unchanged until
+ * the stream is done with it. If `callback` isn't NULL, it is called at that
+ * point. The callback is only called if this function succeeds.
+ *
+ * \param stream The stream the audio data is being added to
+ * \param buf A pointer to the audio data to add
+ * \param len The number of bytes to add to the stream
+ * \param callback A function to call when the stream is done with `buf`, or
+ *                 NULL
+ * \param userdata An opaque pointer passed to `callback`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_ClearAudioStream
+ */
+extern DECLSPEC int SDLCALL SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata);
+
 /**
  * Get converted/resampled data from the stream.
  *
@@ -1264,6 +1643,76 @@ typedef void (SDLCALL *SDL_AudioPostmixCallback)(void *userdata, const SDL_Audio
  */
 extern DECLSPEC int SDLCALL SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
 
+/**
+ * Open a submix bus that mixes into an opened audio device.
+ *
+ * A submix bus is a new logical device ID that, instead of feeding a physical
+ * device directly, mixes into `devid`, which can itself be a submix bus. This
+ * lets an app build a graph like streams -> bus -> bus -> device, where each
+ * bus has its own postmix callback (see SDL_SetAudioPostmixCallback) and gain
+ * (see SDL_SetAudioDeviceGain). A bus is mixed once per device iteration:
+ * its bound streams and any buses feeding it are added together, then its
+ * postmix callback runs on the result, so one effect can process a whole
+ * group of streams instead of each stream individually.
+ *
+ * The returned ID works like any other logical device ID: streams can be
+ * bound to it, and it can be paused, resumed and closed. Pausing a bus also
+ * silences every bus that mixes into it. Closing a bus moves any buses that
+ * mixed into it over to its own parent.
+ *
+ * Submix buses are only available on playback devices.
+ *
+ * \param devid the logical device ID of the opened device or bus to mix
+ *              into.
+ * \returns the device ID of the new bus on success, 0 on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseAudioDevice
+ * \sa SDL_SetAudioDeviceGain
+ * \sa SDL_SetAudioPostmixCallback
+ */
+extern DECLSPEC SDL_AudioDeviceID SDLCALL SDL_OpenAudioSubmix(SDL_AudioDeviceID devid);
+
+/**
+ * Change the gain of an opened audio device or submix bus.
+ *
+ * The gain scales everything the logical device mixes, after its postmix
+ * callback runs. The default gain is 1.0f (no change), 0.0f is silence.
+ * Gain is only available on playback devices.
+ *
+ * \param devid the logical device ID of an opened device or submix bus.
+ * \param gain the gain, 0.0f or greater.
+ * \returns zero on success, -1 on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceGain
+ * \sa SDL_OpenAudioSubmix
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioDeviceGain(SDL_AudioDeviceID devid, float gain);
+
+/**
+ * Get the gain of an opened audio device or submix bus.
+ *
+ * \param devid the logical device ID of an opened device or submix bus.
+ * \returns the gain, or -1.0f on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioDeviceGain
+ */
+extern DECLSPEC float SDLCALL SDL_GetAudioDeviceGain(SDL_AudioDeviceID devid);
+
 
 /**
  * Load the audio data of a WAVE file into memory.
@@ -1388,6 +1837,71 @@ extern DECLSPEC int SDLCALL SDL_LoadWAV_RW(SDL_RWops * src, SDL_bool freesrc,
 extern DECLSPEC int SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec * spec,
                                         Uint8 ** audio_buf, Uint32 * audio_len);
 
+/**
+ * Create an audio stream that decodes a WAVE file as it plays.
+ *
+ * Unlike SDL_LoadWAV_RW, this doesn't read and decode the whole file up
+ * front. Only the headers are parsed here; the audio data is read from `src`
+ * and decoded a few thousand sample frames at a time, whenever the stream
+ * needs more data. This keeps the memory use low for long files, like music.
+ *
+ * The stream's input format is set to the format of the WAVE data, as
+ * SDL_LoadWAV_RW would report it. The output format is `dst_spec`, or the
+ * same as the input if `dst_spec` is NULL. The data can be read with
+ * SDL_GetAudioStreamData, or the stream can be bound to an audio device.
+ * Once all of the data was decoded, the stream is flushed.
+ *
+ * The stream uses its get callback to decode the data, so the app must not
+ * set its own with SDL_SetAudioStreamGetCallback, and shouldn't put data into
+ * the stream itself.
+ *
+ * The same hints as with SDL_LoadWAV_RW apply. Errors in the audio data
+ * that are found while decoding end the stream early.
+ *
+ * It is required that the data source supports seeking. If `freesrc` is
+ * SDL_FALSE, `src` has to stay valid until the stream is destroyed.
+ *
+ * \param src The data source for the WAVE data
+ * \param freesrc If SDL_TRUE, calls SDL_RWclose() on `src` when the stream is
+ *                destroyed, or before returning in the case of an error
+ * \param dst_spec The format details of the output audio, or NULL
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAudioStreamFromWAV
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAV_RW
+ */
+extern DECLSPEC SDL_AudioStream *SDLCALL SDL_CreateAudioStreamFromWAV_RW(SDL_RWops *src, SDL_bool freesrc, const SDL_AudioSpec *dst_spec);
+
+/**
+ * Create an audio stream that decodes a WAVE file from a file path as it
+ * plays.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_CreateAudioStreamFromWAV_RW(SDL_RWFromFile(path, "rb"), SDL_TRUE, dst_spec);
+ * ```
+ *
+ * \param path The file path of the WAV file to open.
+ * \param dst_spec The format details of the output audio, or NULL
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAudioStreamFromWAV_RW
+ * \sa SDL_DestroyAudioStream
+ */
+extern DECLSPEC SDL_AudioStream *SDLCALL SDL_CreateAudioStreamFromWAV(const char *path, const SDL_AudioSpec *dst_spec);
+
 
 
 #define SDL_MIX_MAXVOLUME 128
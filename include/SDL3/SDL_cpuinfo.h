@@ -54,6 +54,44 @@ extern "C" {
  */
 extern DECLSPEC int SDLCALL SDL_GetCPUCount(void);
 
+/**
+ * Information about a logical CPU core, as returned by SDL_GetCPUTopology().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUTopology
+ */
+typedef struct SDL_CPUCoreInfo
+{
+    int cpu;                /**< The logical CPU number, as passed to SDL_SetThreadAffinity() */
+    int core;               /**< The physical core, shared by hyperthreads on the same core */
+    int cache_group;        /**< The group of cores sharing the same last level cache */
+    int performance_class;  /**< 0 for the slowest cores, higher for faster cores on hybrid CPUs */
+} SDL_CPUCoreInfo;
+
+/**
+ * Get the layout of the logical CPU cores in the system.
+ *
+ * Physical cores and cache groups are numbered from 0 in the order they are
+ * first seen. On hybrid CPUs, efficiency cores have a lower
+ * `performance_class` than performance cores; on other CPUs every core has a
+ * `performance_class` of 0.
+ *
+ * Where the topology can't be queried, each logical CPU is reported as its
+ * own core in a single cache group.
+ *
+ * \param count a pointer filled in with the number of logical CPUs returned
+ * \returns an array of core information which should be freed with
+ *          SDL_free(), or NULL on error; call SDL_GetError() for more
+ *          details.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUCount
+ * \sa SDL_SetThreadAffinity
+ */
+extern DECLSPEC SDL_CPUCoreInfo *SDLCALL SDL_GetCPUTopology(int *count);
+
 /**
  * Determine the L1 cache line size of the CPU.
  *
@@ -173,6 +173,7 @@ typedef enum
     SDL_EVENT_FINGER_DOWN      = 0x700,
     SDL_EVENT_FINGER_UP,
     SDL_EVENT_FINGER_MOTION,
+    SDL_EVENT_FINGER_FRAME,             /**< A batch of finger motion, see SDL_HINT_EVENT_BATCH_TOUCH */
 
     /* 0x800, 0x801, and 0x802 were the Gesture events from SDL2. Do not reuse these values! sdl2-compat needs them! */
 
@@ -200,6 +201,7 @@ typedef enum
     SDL_EVENT_PEN_MOTION,                 /**< Pressure-sensitive pen moved, or angle/pressure changed */
     SDL_EVENT_PEN_BUTTON_DOWN,            /**< Pressure-sensitive pen button pressed */
     SDL_EVENT_PEN_BUTTON_UP,              /**< Pressure-sensitive pen button released */
+    SDL_EVENT_PEN_FRAME,                  /**< A batch of pen motion, see SDL_HINT_EVENT_BATCH_TOUCH */
 
     /* Render events */
     SDL_EVENT_RENDER_TARGETS_RESET = 0x2000, /**< The render targets have been reset and their contents need to be updated */
@@ -520,6 +522,19 @@ typedef struct SDL_TouchFingerEvent
     SDL_WindowID windowID; /**< The window underneath the finger, if any */
 } SDL_TouchFingerEvent;
 
+/**
+ *  Batched touch finger motion event structure (event.tframe.*)
+ *
+ *  The samples are freed automatically after the event is processed.
+ */
+typedef struct SDL_TouchFrameEvent
+{
+    Uint32 type;        /**< ::SDL_EVENT_FINGER_FRAME */
+    Uint64 timestamp;   /**< In nanoseconds, the timestamp of the newest sample */
+    int num_samples;    /**< The number of samples */
+    const SDL_TouchFingerEvent *samples; /**< The ::SDL_EVENT_FINGER_MOTION events in the batch, oldest first */
+} SDL_TouchFrameEvent;
+
 
 #define SDL_DROPEVENT_DATA_SIZE 64
 /**
@@ -579,6 +594,19 @@ typedef struct SDL_PenButtonEvent
     float axes[SDL_PEN_NUM_AXES]; /**< Pen axes such as pressure and tilt (ordered as per ::SDL_PenAxis) */
 } SDL_PenButtonEvent;
 
+/**
+ *  Batched pressure-sensitive pen motion event structure (event.pframe.*)
+ *
+ *  The samples are freed automatically after the event is processed.
+ */
+typedef struct SDL_PenFrameEvent
+{
+    Uint32 type;        /**< ::SDL_EVENT_PEN_FRAME */
+    Uint64 timestamp;   /**< In nanoseconds, the timestamp of the newest sample */
+    int num_samples;    /**< The number of samples */
+    const SDL_PenMotionEvent *samples; /**< The ::SDL_EVENT_PEN_MOTION events in the batch, oldest first */
+} SDL_PenFrameEvent;
+
 /**
  *  An event used to drop text or request a file open by the system (event.drop.*)
  *
@@ -670,9 +698,11 @@ typedef union SDL_Event
     SDL_QuitEvent quit;                     /**< Quit request event data */
     SDL_UserEvent user;                     /**< Custom event data */
     SDL_TouchFingerEvent tfinger;           /**< Touch finger event data */
+    SDL_TouchFrameEvent tframe;             /**< Batched touch finger motion */
     SDL_PenTipEvent ptip;                   /**< Pen tip touching or leaving drawing surface */
     SDL_PenMotionEvent pmotion;             /**< Pen change in position, pressure, or angle */
     SDL_PenButtonEvent pbutton;             /**< Pen button press */
+    SDL_PenFrameEvent pframe;               /**< Batched pen motion */
     SDL_DropEvent drop;                     /**< Drag and drop event data */
     SDL_ClipboardEvent clipboard;           /**< Clipboard event data */
 
@@ -853,6 +883,30 @@ extern DECLSPEC void SDLCALL SDL_FlushEvent(Uint32 type);
  */
 extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
 
+/**
+ * Retrieve recorded mouse and pen motion events.
+ *
+ * When SDL_HINT_EVENT_MOTION_HISTORY is set, every SDL_EVENT_MOUSE_MOTION and
+ * SDL_EVENT_PEN_MOTION event pushed to the event queue is also recorded, even
+ * if SDL_HINT_EVENT_COALESCE_MOTION merged it with other motion events in the
+ * queue. This lets apps that need the full rate input, like drawing
+ * programs, get it without flooding the event queue.
+ *
+ * The oldest recorded events are returned first, and are removed from the
+ * history. This function can be called from any thread.
+ *
+ * \param events an array of events to fill
+ * \param numevents the maximum number of events to return
+ * \returns the number of events returned, or a negative error code on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_HINT_EVENT_MOTION_HISTORY
+ */
+extern DECLSPEC int SDLCALL SDL_GetMotionHistory(SDL_Event *events, int numevents);
+
 /**
  * Poll for currently pending events.
  *
@@ -898,6 +952,49 @@ extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for many currently pending events at once.
+ *
+ * This works like calling SDL_PollEvent() until it returns SDL_FALSE or
+ * `numevents` events have been retrieved, but pumps events at most once and
+ * takes the event queue lock only once, which is much cheaper when there are
+ * a lot of events to process each frame.
+ *
+ * Like SDL_PollEvent(), this only returns the events that were pending as of
+ * the last time events were pumped. If fewer than `numevents` events are
+ * returned, the queue has been drained for this frame.
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that set the video mode.
+ *
+ * ```c
+ * while (game_is_still_running) {
+ *     SDL_Event events[256];
+ *     int i, count;
+ *     do {
+ *         count = SDL_PollEvents(events, SDL_arraysize(events));
+ *         for (i = 0; i < count; ++i) {
+ *             // decide what to do with events[i].
+ *         }
+ *     } while (count == SDL_arraysize(events));
+ *
+ *     // update game state, draw the current frame
+ * }
+ * ```
+ *
+ * \param events an array of at least `numevents` events to be filled with
+ *               events from the queue
+ * \param numevents the maximum number of events to retrieve
+ * \returns the number of events retrieved, or a negative error code on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PollEvent
+ * \sa SDL_PeepEvents
+ */
+extern DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -982,6 +1079,46 @@ extern DECLSPEC SDL_bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern DECLSPEC int SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * A function pointer used for callbacks that trace event delivery latency.
+ *
+ * `event->common.timestamp` is the time the event happened, taken from the
+ * OS input timestamp where the platform provides one, so the difference
+ * between it and `queued_ns` is the time the event took to reach SDL, and
+ * the difference between `queued_ns` and `retrieved_ns` is the time it
+ * waited in the event queue.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetEventLatencyCallback()
+ * \param event the event that was retrieved from the queue
+ * \param queued_ns the time the event was added to the queue, in
+ *                  nanoseconds since SDL initialization
+ * \param retrieved_ns the time the event was retrieved from the queue, in
+ *                     nanoseconds since SDL initialization
+ *
+ * \sa SDL_SetEventLatencyCallback
+ */
+typedef void (SDLCALL *SDL_EventLatencyCallback)(void *userdata, const SDL_Event *event, Uint64 queued_ns, Uint64 retrieved_ns);
+
+/**
+ * Set a callback that is called for every event retrieved from the queue.
+ *
+ * The callback is called for events removed from the queue by
+ * SDL_PollEvent(), SDL_PollEvents(), SDL_WaitEvent() and SDL_PeepEvents()
+ * with SDL_GETEVENT, on the thread retrieving them, with the event queue
+ * locked. It should return quickly and must not wait for events.
+ *
+ * Events added to the queue before the callback was set are not reported.
+ *
+ * \param callback the function to call, or NULL to stop tracing
+ * \param userdata a pointer that is passed to `callback`
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EventLatencyCallback
+ */
+extern DECLSPEC void SDLCALL SDL_SetEventLatencyCallback(SDL_EventLatencyCallback callback, void *userdata);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
@@ -1088,7 +1225,36 @@ extern DECLSPEC SDL_bool SDLCALL SDL_GetEventFilter(SDL_EventFilter *filter, voi
 extern DECLSPEC int SDLCALL SDL_AddEventWatch(SDL_EventFilter filter, void *userdata);
 
 /**
- * Remove an event watch callback added with SDL_AddEventWatch().
+ * Add a callback to be triggered when an event of a range of types is added
+ * to the event queue.
+ *
+ * This works like SDL_AddEventWatch(), but `filter` is only called for events
+ * with a type between `minType` and `maxType`, inclusive. Watching only the
+ * events you need keeps the cost of frequent events like mouse motion low.
+ *
+ * Watchers are dispatched without locking, so a watcher removed by another
+ * thread with SDL_DelEventWatch() may be called one last time for an event
+ * that was being dispatched when it was removed.
+ *
+ * \param filter an SDL_EventFilter function to call when an event happens.
+ * \param userdata a pointer that is passed to `filter`
+ * \param minType the low end of event types to watch, inclusive; see
+ *                SDL_EventType for details
+ * \param maxType the high end of event types to watch, inclusive; see
+ *                SDL_EventType for details
+ * \returns 0 on success, or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddEventWatch
+ * \sa SDL_DelEventWatch
+ */
+extern DECLSPEC int SDLCALL SDL_AddEventWatchRange(SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType);
+
+/**
+ * Remove an event watch callback added with SDL_AddEventWatch() or
+ * SDL_AddEventWatchRange().
  *
  * This function takes the same input as SDL_AddEventWatch() to identify and
  * delete the corresponding callback.
@@ -1099,6 +1265,7 @@ extern DECLSPEC int SDLCALL SDL_AddEventWatch(SDL_EventFilter filter, void *user
  * \since This function is available since SDL 3.0.0.
  *
  * \sa SDL_AddEventWatch
+ * \sa SDL_AddEventWatchRange
  */
 extern DECLSPEC void SDLCALL SDL_DelEventWatch(SDL_EventFilter filter, void *userdata);
 
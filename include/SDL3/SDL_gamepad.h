@@ -260,6 +260,10 @@ extern DECLSPEC int SDLCALL SDL_AddGamepadMapping(const char *mapping);
  * processing it, so take this into consideration if you are in a memory
  * constrained environment.
  *
+ * The data stream may also contain a compiled database, as written by
+ * build-scripts/gen_gamepad_db.c from a text database, which loads faster
+ * because the mappings don't need to be parsed line by line.
+ *
  * \param src the data stream for the mappings to be added
  * \param freesrc if SDL_TRUE, calls SDL_RWclose() on `src` before returning,
  *                even in the case of an error
@@ -1155,6 +1159,33 @@ extern DECLSPEC float SDLCALL SDL_GetGamepadSensorDataRate(SDL_Gamepad *gamepad,
  */
 extern DECLSPEC int SDLCALL SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *data, int num_values);
 
+/**
+ * Get all the readings from a gamepad sensor since the last call.
+ *
+ * Gamepad gyroscopes and accelerometers often report at 250-1000 Hz, and
+ * this returns every reading without the overhead of an event for each one.
+ * SDL_EVENT_GAMEPAD_SENSOR_UPDATE can be disabled with SDL_SetEventEnabled()
+ * while using this, the samples are collected either way.
+ *
+ * The sensor must be enabled with SDL_SetGamepadSensorEnabled(). Samples are
+ * collected from the first time this is called on a sensor, and up to
+ * SDL_SENSOR_BATCH_SIZE are kept between calls. They are returned oldest
+ * first, and any that don't fit in `samples` are returned on the next call.
+ *
+ * \param gamepad The gamepad to query
+ * \param type The type of sensor to query
+ * \param samples An array filled with the sensor readings
+ * \param num_samples The number of elements in `samples`
+ * \returns the number of samples written, or a negative error code on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetGamepadSensorData
+ * \sa SDL_SetGamepadSensorEnabled
+ */
+extern DECLSPEC int SDLCALL SDL_GetGamepadSensorDataBatch(SDL_Gamepad *gamepad, SDL_SensorType type, SDL_SensorSample *samples, int num_samples);
+
 /**
  * Start a rumble effect on a gamepad.
  *
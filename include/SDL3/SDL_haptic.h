@@ -1331,6 +1331,91 @@ extern DECLSPEC int SDLCALL SDL_HapticRumblePlay(SDL_Haptic * haptic, float stre
  */
 extern DECLSPEC int SDLCALL SDL_HapticRumbleStop(SDL_Haptic * haptic);
 
+/**
+ * The number of force levels that can be queued with SDL_HapticStreamQueue().
+ */
+#define SDL_HAPTIC_STREAM_SIZE  1024
+
+/**
+ * Start streaming a constant force on a haptic device.
+ *
+ * This creates a ::SDL_HAPTIC_CONSTANT effect and a thread that sets its
+ * level from the values queued with SDL_HapticStreamQueue(), one every
+ * `1 / rate` seconds. This lets force feedback follow a simulation running
+ * at a higher rate than the application's frame rate, without the
+ * application having to update the effect itself.
+ *
+ * If the queue runs empty the force is released to 0 until more levels are
+ * queued. The sign of a level gives the direction of the force along the
+ * first axis.
+ *
+ * While streaming, the haptic device must not be closed or have its other
+ * effects changed from another thread.
+ *
+ * \param haptic the haptic device to stream to
+ * \param rate the number of levels to play per second
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HapticStreamQueue
+ * \sa SDL_HapticStreamStop
+ */
+extern DECLSPEC int SDLCALL SDL_HapticStreamStart(SDL_Haptic * haptic, int rate);
+
+/**
+ * Queue force levels to be played on a haptic device.
+ *
+ * Up to ::SDL_HAPTIC_STREAM_SIZE levels can be waiting to be played, levels
+ * beyond that are not queued.
+ *
+ * \param haptic the haptic device to stream to
+ * \param levels an array of force levels, from -32767 to 32767
+ * \param num_levels the number of elements in `levels`
+ * \returns the number of levels queued or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * 	hreadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HapticStreamQueued
+ * \sa SDL_HapticStreamStart
+ */
+extern DECLSPEC int SDLCALL SDL_HapticStreamQueue(SDL_Haptic * haptic, const Sint16 *levels, int num_levels);
+
+/**
+ * Get the number of force levels waiting to be played on a haptic device.
+ *
+ * \param haptic the haptic device to query
+ * \returns the number of levels queued or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * 	hreadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HapticStreamQueue
+ */
+extern DECLSPEC int SDLCALL SDL_HapticStreamQueued(SDL_Haptic * haptic);
+
+/**
+ * Stop streaming on a haptic device.
+ *
+ * Any levels still queued are discarded, and the constant force effect is
+ * destroyed.
+ *
+ * \param haptic the haptic device to stop streaming to
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HapticStreamStart
+ */
+extern DECLSPEC int SDLCALL SDL_HapticStreamStop(SDL_Haptic * haptic);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
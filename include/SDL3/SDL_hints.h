@@ -346,6 +346,59 @@ extern "C" {
  */
 #define SDL_HINT_BMP_SAVE_LEGACY_FORMAT "SDL_BMP_SAVE_LEGACY_FORMAT"
 
+/**
+ *  Save BMPs with the top row first.
+ *
+ * BMP files normally store the bottom row first, so SDL has to reverse the
+ * rows of the surface while saving. Top-down BMPs are written in the order
+ * the rows are in memory, but some older applications can't read them.
+ *
+ * The variable can be set to the following values:
+ *   "0"       - BMPs are saved bottom-up.
+ *   "1"       - BMPs are saved top-down.
+ *
+ * The default value is "0".
+ */
+#define SDL_HINT_BMP_SAVE_TOP_DOWN "SDL_BMP_SAVE_TOP_DOWN"
+
+/**
+ *  A variable that limits what CPU features are available.
+ *
+ *  By default, SDL marks all features the current CPU supports as available.
+ *  This hint allows to limit these to a subset.
+ *
+ *  When the hint is unset, or empty, SDL will enable all detected CPU
+ *  features.
+ *
+ *  The variable can be set to a comma separated list containing the following
+ *  items:
+ *   "all"
+ *   "altivec"
+ *   "mmx"
+ *   "sse"
+ *   "sse2"
+ *   "sse3"
+ *   "sse41"
+ *   "sse42"
+ *   "avx"
+ *   "avx2"
+ *   "avx512f"
+ *   "arm-simd"
+ *   "neon"
+ *   "lsx"
+ *   "lasx"
+ *
+ *  The items can be prefixed by '+'/'-' to add/remove features. An item
+ *  without a prefix replaces the current set with just that feature, so
+ *  "-all,+sse2" and "sse2" are equivalent.
+ *
+ *  This hint must be set before the first call to any of the SDL_Has*()
+ *  functions or SDL_GetSIMDAlignment(), as the CPU features are only
+ *  detected once. It is mostly useful for benchmarking and testing the
+ *  scalar fallbacks of SDL's SIMD-accelerated code paths.
+ */
+#define SDL_HINT_CPU_FEATURE_MASK "SDL_CPU_FEATURE_MASK"
+
 /**
  *  Override for SDL_GetDisplayUsableBounds()
  *
@@ -409,6 +462,73 @@ extern "C" {
  */
 #define SDL_HINT_ENABLE_SCREEN_KEYBOARD "SDL_ENABLE_SCREEN_KEYBOARD"
 
+/**
+ *  A variable controlling whether touch and pen motion is batched in the event queue.
+ *
+ *  Touch screens and pens can report hundreds of samples per second for each
+ *  finger. When this is enabled, SDL_EVENT_FINGER_MOTION and
+ *  SDL_EVENT_PEN_MOTION events are collected as they arrive, and queued as a
+ *  single SDL_EVENT_FINGER_FRAME or SDL_EVENT_PEN_FRAME event carrying all of
+ *  the samples when SDL_PumpEvents() finishes. A pending batch is also queued
+ *  before any finger down/up, pen tip or pen button event, so these stay in
+ *  order with the motion around them.
+ *
+ *  Event watchers still see every sample. Batching is skipped while the frame
+ *  event type is disabled with SDL_SetEventEnabled().
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Each motion event is queued separately (default)
+ *    "1"       - Motion events are queued in batches
+ *
+ *  This hint can be changed at any time.
+ */
+#define SDL_HINT_EVENT_BATCH_TOUCH "SDL_EVENT_BATCH_TOUCH"
+
+/**
+ *  A variable controlling whether motion events are coalesced in the event queue.
+ *
+ *  High polling rate mice and pens can generate thousands of motion events
+ *  per second. When this is enabled, an SDL_EVENT_MOUSE_MOTION or
+ *  SDL_EVENT_PEN_MOTION event that is pushed while the most recently queued
+ *  event is a motion event for the same window, device and button state is
+ *  merged into that event instead of being queued separately. Merged mouse
+ *  motion keeps the latest position and timestamp and sums the relative
+ *  motion, merged pen motion keeps the latest values.
+ *
+ *  Event watchers still see every event, and SDL_HINT_EVENT_MOTION_HISTORY
+ *  can be used to keep the full rate motion around for the app.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Each motion event is queued separately (default)
+ *    "1"       - Consecutive motion events are merged
+ *
+ *  This hint can be changed at any time.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
+/**
+ *  A variable controlling whether input devices are updated on a separate thread.
+ *
+ *  When this is enabled, joysticks, gamepads and sensors are read on a
+ *  dedicated high priority thread, and their events are timestamped and added
+ *  to the event queue as they arrive, instead of when the app calls
+ *  SDL_PumpEvents(). This keeps a slow frame from delaying device reads.
+ *  Where the platform allows it, the thread sleeps until a device has new
+ *  input and reads each report as it arrives, otherwise it polls devices
+ *  every millisecond.
+ *
+ *  Input that is delivered to windows, like keyboard, mouse, pen and touch
+ *  events, is still processed by SDL_PumpEvents() on the main thread, and
+ *  carries the OS timestamp where the platform provides one.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Input devices are updated by SDL_PumpEvents() (default)
+ *    "1"       - Input devices are updated on a separate thread
+ *
+ *  This hint can be changed at any time.
+ */
+#define SDL_HINT_EVENT_INPUT_THREAD "SDL_EVENT_INPUT_THREAD"
+
 /**
  *  A variable controlling verbosity of the logging of SDL events pushed onto the internal queue.
  *
@@ -430,6 +550,21 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING   "SDL_EVENT_LOGGING"
 
+/**
+ *  A variable setting how many motion events are kept for SDL_GetMotionHistory().
+ *
+ *  When this is set to a number greater than 0, every SDL_EVENT_MOUSE_MOTION
+ *  and SDL_EVENT_PEN_MOTION event that is pushed to the event queue is also
+ *  recorded, whether or not it gets coalesced by
+ *  SDL_HINT_EVENT_COALESCE_MOTION. Once that many events are recorded, the
+ *  oldest ones are dropped.
+ *
+ *  The default value is "0", which doesn't record any motion history.
+ *
+ *  Changing this hint discards the motion history recorded so far.
+ */
+#define SDL_HINT_EVENT_MOTION_HISTORY "SDL_EVENT_MOTION_HISTORY"
+
 /**
  *  A variable controlling whether raising the window should be done more forcefully
  *
@@ -1057,6 +1192,22 @@ extern "C" {
  */
 #define SDL_HINT_KMSDRM_REQUIRE_DRM_MASTER      "SDL_KMSDRM_REQUIRE_DRM_MASTER"
 
+/**
+ * A variable controlling whether the KMSDRM backend uses atomic modesetting
+ *
+ * With atomic modesetting, new frames are committed to the display's primary
+ * plane along with a fence that signals when the GPU has finished rendering
+ * them, instead of relying on implicit synchronization in the kernel. Some
+ * drivers don't handle this well, so it can be turned off.
+ *
+ * This hint must be set before creating a window.
+ *
+ * This variable can be set to the following values:
+ *    "0"       - SDL will use legacy page flips
+ *    "1"       - SDL will use atomic commits if the driver supports them (default)
+ */
+#define SDL_HINT_KMSDRM_ATOMIC      "SDL_KMSDRM_ATOMIC"
+
 /**
   *  A comma separated list of devices to open as joysticks
   *
@@ -1102,6 +1253,22 @@ extern "C" {
   */
 #define SDL_HINT_LINUX_JOYSTICK_DEADZONES "SDL_LINUX_JOYSTICK_DEADZONES"
 
+/**
+ *  A variable controlling whether log messages are written out on a background thread
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Log messages are passed to the log output function before SDL_Log() returns (the default)
+ *    "1"       - Log messages are queued and passed to the log output function on a separate thread
+ *
+ *  This keeps a slow console from stalling the threads that are logging. If
+ *  messages are logged faster than they can be written out, the newest ones
+ *  are dropped and a count of dropped messages is logged instead. Queued
+ *  messages are written out by SDL_Quit().
+ *
+ *  This hint is checked when SDL subsystems are initialized.
+ */
+#define SDL_HINT_LOG_ASYNC "SDL_LOG_ASYNC"
+
 /**
 *  When set don't force the SDL app to become a foreground process
 *
@@ -1118,6 +1285,24 @@ extern "C" {
  */
 #define SDL_HINT_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK "SDL_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK"
 
+/**
+ *  A variable controlling whether SDL_AppIterate() is driven by the display link on Mac
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - SDL_AppIterate() is called as fast as presenting allows (default).
+ *    "1"       - SDL_AppIterate() is called once per display refresh, from a CVDisplayLink.
+ *
+ *  When this is enabled, the global properties "SDL.main.frame_target_ns" and
+ *  "SDL.main.frame_interval_ns" hold the time the next frame will be shown, in
+ *  the SDL_GetTicksNS() timebase, and the current refresh interval. Apps can use
+ *  them to schedule their work just in time instead of blocking in present, and
+ *  they follow the refresh rate on ProMotion displays.
+ *
+ *  This hint only applies to macOS apps using the main callbacks, and is checked
+ *  when the main callbacks start.
+ */
+#define SDL_HINT_MAC_DISPLAY_LINK_ITERATE "SDL_MAC_DISPLAY_LINK_ITERATE"
+
 /**
  *  A variable controlling whether dispatching OpenGL context updates should block the dispatching thread until the main thread finishes processing
  *
@@ -1238,6 +1423,18 @@ extern "C" {
  */
 #define SDL_HINT_MOUSE_AUTO_CAPTURE    "SDL_MOUSE_AUTO_CAPTURE"
 
+/**
+ *  A variable controlling how many times SDL_LockMutex() spins before sleeping
+ *
+ *  When a mutex is locked by another thread, SDL will retry taking the lock this many
+ *  times with a CPU pause instruction in between before waiting in the kernel. This
+ *  avoids a system call when the lock is only held for a short time.
+ *
+ *  The variable is read when each mutex is created. It can be set to "0" to disable
+ *  spinning. The default value is "100".
+ */
+#define SDL_HINT_MUTEX_SPIN_COUNT    "SDL_MUTEX_SPIN_COUNT"
+
 /**
  *  Treat pen movement as separate from mouse movement
  *
@@ -1400,6 +1597,30 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_LINE_METHOD "SDL_RENDER_LINE_METHOD"
 
+/**
+ *  A variable controlling whether logical presentation renders straight to the output
+ *
+ *  By default, SDL_SetRenderLogicalPresentation() makes SDL render to a texture
+ *  of the logical size and scale it to the output when presenting. When this
+ *  is enabled, rendering goes directly to the output instead, through the
+ *  viewport and a scale, which saves a full screen copy each frame and the
+ *  memory for the texture.
+ *
+ *  This is only done for SDL_LOGICAL_PRESENTATION_STRETCH,
+ *  SDL_LOGICAL_PRESENTATION_LETTERBOX and SDL_LOGICAL_PRESENTATION_INTEGER_SCALE
+ *  with SDL_SCALEMODE_NEAREST; other scale modes need the texture to filter
+ *  the image. Since nothing is drawn at the logical resolution, lines and
+ *  scaled textures come out sharper than they would with the texture, and the
+ *  output is not preserved between frames.
+ *
+ *  This variable can be set to the following values:
+ *    "0"     - Always render to a texture (default)
+ *    "1"     - Render straight to the output when the presentation allows it
+ *
+ *  This variable is checked when SDL_SetRenderLogicalPresentation() is called.
+ */
+#define SDL_HINT_RENDER_DIRECT_LOGICAL_PRESENTATION "SDL_RENDER_DIRECT_LOGICAL_PRESENTATION"
+
 /**
  *  A variable controlling whether to enable Direct3D 11+'s Debug Layer.
  *
@@ -1424,6 +1645,17 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_DIRECT3D_THREADSAFE "SDL_RENDER_DIRECT3D_THREADSAFE"
 
+/**
+ *  A variable controlling whether to enable the Vulkan validation layer in the Vulkan renderer.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Disable the validation layer
+ *    "1"       - Enable the validation layer, if it is installed
+ *
+ *  By default, SDL does not use the Vulkan validation layer.
+ */
+#define SDL_HINT_RENDER_VULKAN_DEBUG        "SDL_RENDER_VULKAN_DEBUG"
+
 /**
  *  A variable specifying which render driver to use.
  *
@@ -1439,6 +1671,7 @@ extern "C" {
  *    "opengles2"
  *    "opengles"
  *    "metal"
+ *    "vulkan"
  *    "software"
  *
  *  The default varies by platform, but it's the first one in the list that
@@ -1457,6 +1690,17 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_OPENGL_SHADERS      "SDL_RENDER_OPENGL_SHADERS"
 
+/**
+ *  A variable controlling whether the OpenGL and OpenGL ES 2.0 render drivers stream vertices through a persistently mapped buffer.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use client-side vertex arrays
+ *    "1"       - Use a persistently mapped vertex buffer ring
+ *
+ *  By default the vertex buffer ring is used if the driver supports GL_ARB_buffer_storage, or GL_EXT_buffer_storage on OpenGL ES.
+ */
+#define SDL_HINT_RENDER_OPENGL_PERSISTENT_VERTEX_BUFFER "SDL_RENDER_OPENGL_PERSISTENT_VERTEX_BUFFER"
+
 /**
  *  A variable controlling the scaling quality
  *
@@ -1469,6 +1713,17 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_SCALE_QUALITY       "SDL_RENDER_SCALE_QUALITY"
 
+/**
+ *  A variable controlling how many threads the software renderer rasterizes with.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Rasterize on the thread calling the render functions
+ *    N          - Split large render targets into N bands drawn in parallel, up to 8
+ *
+ *  By default the number of CPU cores is used. This hint should be set before the renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  *  A variable controlling whether updates to the SDL screen surface should be synchronized with the vertical refresh, to avoid tearing.
  *
@@ -1542,6 +1797,32 @@ extern "C" {
  */
 #define SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME "SDL_SCREENSAVER_INHIBIT_ACTIVITY_NAME"
 
+/**
+ *  A variable controlling how many threads large surface blits and pixel conversions are split across.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Blit on the calling thread (default)
+ *    N          - Split blits of 512x512 pixels or more into N bands of rows, up to 16
+ *    "-1"       - Use the number of CPU cores
+ *
+ *  This also applies to conversions from YUV formats to RGB formats and between YUV formats,
+ *  including the YUV texture updates of renderers without native YUV support, with bands that
+ *  start on even rows. Scaled blits and conversions between the planar YUV formats always run
+ *  on the calling thread. This hint can be changed at any time.
+ */
+#define SDL_HINT_SURFACE_BLIT_THREADS "SDL_SURFACE_BLIT_THREADS"
+
+/**
+ *  A variable controlling whether SDL logs when a surface blit falls back to the generic per-pixel blitter.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't log slow blits (default)
+ *    "1"       - Log the source and destination formats and blit flags, once each time the blit is set up
+ *
+ *  The message is logged at SDL_LOG_PRIORITY_INFO in the SDL_LOG_CATEGORY_VIDEO category.
+ */
+#define SDL_HINT_SURFACE_BLIT_LOG_SLOW "SDL_SURFACE_BLIT_LOG_SLOW"
+
 /**
  *  Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as realtime.
  *
@@ -1592,6 +1873,23 @@ extern "C" {
 */
 #define SDL_HINT_THREAD_STACK_SIZE              "SDL_THREAD_STACK_SIZE"
 
+/**
+ *  A variable controlling whether SDL_GetTicksNS() reads the CPU's cycle counter directly
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use the operating system's high resolution clock (the default)
+ *    "1"       - Use the CPU's invariant timestamp counter on x86, or the virtual counter on ARM64
+ *
+ *  Reading the counter directly avoids going through the operating system and
+ *  converts it to nanoseconds without a divide, which helps when timestamps
+ *  are taken very often. On x86 the counter rate is calibrated when the timer
+ *  starts, so SDL ticks may drift very slightly from the system clock. If the
+ *  CPU doesn't have a suitable counter, the system clock is used.
+ *
+ *  This hint is checked when the SDL timer is first used.
+ */
+#define SDL_HINT_TIMER_CPU_COUNTER "SDL_TIMER_CPU_COUNTER"
+
 /**
  *  A variable that controls the timer resolution, in milliseconds.
  *
@@ -1608,6 +1906,17 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ *  A variable specifying where SDL_Quit() writes the trace of SDL internals
+ *
+ *  This is only used when SDL is built with tracing enabled (-DSDL_TRACING=ON).
+ *  The trace is written in the Chrome trace event format, and can be opened
+ *  in Perfetto or chrome://tracing.
+ *
+ *  By default the trace is written to "SDL_trace.json" in the current directory.
+ */
+#define SDL_HINT_TRACE_FILE "SDL_TRACE_FILE"
+
 /**
  *  A variable controlling whether touch events should generate synthetic mouse events
  *
@@ -1652,6 +1961,39 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_ALLOW_SCREENSAVER    "SDL_VIDEO_ALLOW_SCREENSAVER"
 
+/**
+ *  A variable controlling which frames are dropped when the video capture
+ *  queue is full.
+ *
+ *  Captured frames wait in a fixed size queue until they are acquired with
+ *  SDL_AcquireVideoCaptureFrame(). If the application falls behind, the
+ *  queue fills up and a frame has to be given back to the driver.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - The newest frame is dropped, keeping the queued ones
+ *    "1"       - The oldest queued frame is dropped, so the queue always
+ *                holds the most recent frames (default)
+ *
+ *  This hint should be set before SDL_StartVideoCapture() is called.
+ */
+#define SDL_HINT_VIDEO_CAPTURE_DROP_OLDEST "SDL_VIDEO_CAPTURE_DROP_OLDEST"
+
+/**
+ *  A variable controlling whether MJPEG video capture is decoded in hardware.
+ *
+ *  Many cameras only deliver their highest resolutions and frame rates as
+ *  MJPEG. On Linux, if a V4L2 memory-to-memory JPEG decoder is available,
+ *  those modes are offered as SDL_PIXELFORMAT_NV12 and each frame is decoded
+ *  before the application acquires it.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - MJPEG modes aren't offered
+ *    "1"       - MJPEG modes are decoded when possible (default)
+ *
+ *  This hint should be set before the video subsystem is initialized.
+ */
+#define SDL_HINT_VIDEO_CAPTURE_MJPEG_DECODE "SDL_VIDEO_CAPTURE_MJPEG_DECODE"
+
 /**
  * Tell the video driver that we only want a double buffer.
  *
@@ -1723,6 +2065,20 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS   "SDL_VIDEO_MINIMIZE_ON_FOCUS_LOSS"
 
+/**
+ *  A variable selecting the GPU used by the offscreen video driver for OpenGL.
+ *
+ *  The offscreen driver creates its EGL display on one of the devices listed
+ *  by EGL_EXT_device_enumeration. This variable can be set to:
+ *    "0", "1", ... - The index of the EGL device to use
+ *    "/dev/dri/..." - The DRM primary or render node of the device to use
+ *
+ *  By default SDL will use the first device that can be initialized.
+ *
+ *  This hint should be set before the OpenGL library is loaded.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_EGL_DEVICE "SDL_VIDEO_OFFSCREEN_EGL_DEVICE"
+
 /**
  *  A variable controlling whether the libdecor Wayland backend is allowed to be used.
  *
@@ -2481,6 +2837,82 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES "SDL_AUDIO_DEVICE_SAMPLE_FRAMES"
 
+/**
+ * A variable controlling whether audio devices are opened for low latency.
+ *
+ * This variable can be set to the following values:
+ *   "0"         - Use the buffer sizes SDL normally picks (default)
+ *   "1"         - Use small buffers, and ask the backend for its smallest
+ *                 period (IAudioClient3 on WASAPI, mmap access on ALSA, a
+ *                 small node latency on PipeWire, a buffer tuned to the
+ *                 device's burst size on AAudio)
+ *   "exclusive" - Like "1", but also try to take exclusive access to the
+ *                 hardware where the backend supports it (WASAPI, AAudio).
+ *                 Other apps will not be able to play sound on that device
+ *                 while it's open.
+ *
+ * Small buffers mean the audio thread wakes up more often, and bound audio
+ * streams need to be fed promptly or the device will underrun. Backends fall
+ * back to their normal settings if they can't provide this; use
+ * SDL_GetAudioDeviceProperties() to see what was actually achieved.
+ * SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES still takes precedence for the buffer
+ * size.
+ *
+ * This hint is checked when a physical audio device is opened and can be
+ * changed between calls.
+ */
+#define SDL_HINT_AUDIO_DEVICE_LOW_LATENCY "SDL_AUDIO_DEVICE_LOW_LATENCY"
+
+/**
+ *  A variable controlling how many threads SDL_ConvertAudioSamples() splits large conversions across.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Convert on the calling thread (default)
+ *    N          - Split conversions that produce 256K sample frames or more across N threads, up to 16
+ *    "-1"       - Use the number of CPU cores
+ *
+ *  The result is the same either way. This hint can be changed at any time.
+ */
+#define SDL_HINT_AUDIO_CONVERT_THREADS "SDL_AUDIO_CONVERT_THREADS"
+
+/**
+ * A variable controlling how many threads an output device uses to get
+ * data from its bound audio streams.
+ *
+ * This variable can be set to the following values:
+ *   "0" or "1" - Convert and resample every stream on the device thread
+ *                (default)
+ *   N          - Split the streams of each logical device across N threads,
+ *                up to 16
+ *   "-1"       - Use the number of CPU cores
+ *
+ * Each thread mixes its share of streams into a buffer of its own, and the
+ * device thread adds those together, so the result can differ from mixing
+ * on one thread in the last bits of the float samples. Audio stream
+ * callbacks may be called from these threads.
+ *
+ * This hint is checked when opening an audio device and can be changed
+ * between calls.
+ */
+#define SDL_HINT_AUDIO_DEVICE_MIX_THREADS "SDL_AUDIO_DEVICE_MIX_THREADS"
+
+/**
+ * A variable controlling how much memory audio streams keep around for
+ * reuse, in bytes.
+ *
+ * Audio streams queue data in fixed-size chunks. When a stream is done with
+ * a chunk, it goes into a pool shared by every stream, so that new data and
+ * new streams can reuse it instead of allocating more memory. Chunks that
+ * would push the pool over this size are freed instead.
+ *
+ * This variable can be set to the following values:
+ *   "0"  - Don't pool chunks; allocate and free them as needed
+ *   N    - Keep up to N bytes of unused chunks (default is 1048576)
+ *
+ * This hint is checked when the audio subsystem is initialized.
+ */
+#define SDL_HINT_AUDIO_CHUNK_POOL_SIZE "SDL_AUDIO_CHUNK_POOL_SIZE"
+
 
 /**
  * Request SDL_AppIterate() be called at a specific rate.
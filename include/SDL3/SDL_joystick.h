@@ -880,6 +880,91 @@ extern DECLSPEC Uint8 SDLCALL SDL_GetJoystickHat(SDL_Joystick *joystick,
 extern DECLSPEC Uint8 SDLCALL SDL_GetJoystickButton(SDL_Joystick *joystick,
                                                     int button);
 
+/**
+ *  \name Joystick snapshot limits
+ *
+ *  The number of controls copied into an SDL_JoystickSnapshot, controls with
+ *  higher indices can be read with SDL_GetJoystickAxis() and friends.
+ */
+/* @{ */
+#define SDL_JOYSTICK_SNAPSHOT_MAX_AXES      32
+#define SDL_JOYSTICK_SNAPSHOT_MAX_BUTTONS   128
+#define SDL_JOYSTICK_SNAPSHOT_MAX_HATS      8
+/* @} */
+
+/**
+ * The state of a joystick at a single point in time.
+ *
+ * \sa SDL_GetJoystickSnapshot
+ */
+typedef struct SDL_JoystickSnapshot
+{
+    Uint64 timestamp;   /**< The time of the most recent state change, in nanoseconds, or 0 if the state hasn't changed since the joystick was opened */
+    int naxes;          /**< The number of valid entries in axes */
+    Sint16 axes[SDL_JOYSTICK_SNAPSHOT_MAX_AXES];
+    int nbuttons;       /**< The number of valid entries in buttons */
+    Uint8 buttons[SDL_JOYSTICK_SNAPSHOT_MAX_BUTTONS];
+    int nhats;          /**< The number of valid entries in hats */
+    Uint8 hats[SDL_JOYSTICK_SNAPSHOT_MAX_HATS];
+    float gyro[3];      /**< The gyroscope data, if the gyroscope is enabled, otherwise 0 */
+    float accel[3];     /**< The accelerometer data, if the accelerometer is enabled, otherwise 0 */
+} SDL_JoystickSnapshot;
+
+/**
+ * Get a consistent snapshot of the state of a joystick.
+ *
+ * Unlike the other joystick state functions, this doesn't wait for the lock
+ * that is held while joysticks are being updated, so a thread running game
+ * logic can read input without contending with the thread pumping events.
+ * The snapshot always reflects complete device reports: all of the values
+ * come from the same update.
+ *
+ * The joystick must stay open while this function is running.
+ *
+ * \param joystick an SDL_Joystick structure containing joystick information
+ * \param snapshot a pointer filled in with the current joystick state
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickAxis
+ * \sa SDL_GetJoystickButton
+ * \sa SDL_GetJoystickHat
+ */
+extern DECLSPEC int SDLCALL SDL_GetJoystickSnapshot(SDL_Joystick *joystick, SDL_JoystickSnapshot *snapshot);
+
+/**
+ * Set all the axes, buttons and hats of an opened virtual joystick at once.
+ *
+ * This is equivalent to calling SDL_SetJoystickVirtualAxis(),
+ * SDL_SetJoystickVirtualButton() and SDL_SetJoystickVirtualHat() for each
+ * control in `state`, but only takes the joystick lock once. The first
+ * `state->naxes`, `state->nbuttons` and `state->nhats` controls are set,
+ * controls the virtual joystick doesn't have are ignored, and the timestamp
+ * and sensor fields are not used. This means a snapshot recorded with
+ * SDL_GetJoystickSnapshot() can be replayed directly.
+ *
+ * As with the other virtual joystick functions, the values are applied on the
+ * next call to SDL_UpdateJoysticks() and events are only sent for controls
+ * whose value changed.
+ *
+ * \param joystick the virtual joystick on which to set state.
+ * \param state the new state of the virtual joystick.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickSnapshot
+ * \sa SDL_SetJoystickVirtualAxis
+ * \sa SDL_SetJoystickVirtualButton
+ * \sa SDL_SetJoystickVirtualHat
+ */
+extern DECLSPEC int SDLCALL SDL_SetJoystickVirtualState(SDL_Joystick *joystick, const SDL_JoystickSnapshot *state);
+
 /**
  * Start a rumble effect.
  *
@@ -39,6 +39,11 @@ extern "C" {
  */
 typedef Uint32 SDL_PropertiesID;
 
+/**
+ * An interned property name, see SDL_GetPropertyKey()
+ */
+typedef struct SDL_PropertyKey SDL_PropertyKey;
+
 /**
  * SDL property type
  */
@@ -348,6 +353,133 @@ extern DECLSPEC float SDLCALL SDL_GetFloatProperty(SDL_PropertiesID props, const
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value);
 
+/**
+ * Get the interned key for a property name
+ *
+ * Looking up a property by key skips hashing and comparing the name, so it's
+ * useful for properties that are read often. Every call with the same name
+ * returns the same key, and keys can be used with any set of properties.
+ *
+ * \param name the name of the property
+ * \returns the key for the property name, or NULL on failure; call
+ *          SDL_GetError() for more information. The key is valid until
+ *          SDL_Quit() is called.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyKeyName
+ * \sa SDL_GetPropertyByKey
+ */
+extern DECLSPEC const SDL_PropertyKey *SDLCALL SDL_GetPropertyKey(const char *name);
+
+/**
+ * Get the name of an interned property key
+ *
+ * \param key the key to query
+ * \returns the name of the property, or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetPropertyKeyName(const SDL_PropertyKey *key);
+
+/**
+ * Get a property on a set of properties using an interned key
+ *
+ * \param props the properties to query
+ * \param key the key of the property to query, from SDL_GetPropertyKey()
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a pointer property.
+ *
+ * \threadsafety It is safe to call this function from any thread, with the
+ *               same caveats as SDL_GetProperty().
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetProperty
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC void *SDLCALL SDL_GetPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, void *default_value);
+
+/**
+ * Get a string property on a set of properties using an interned key
+ *
+ * \param props the properties to query
+ * \param key the key of the property to query, from SDL_GetPropertyKey()
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a string property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetStringProperty
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetStringPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, const char *default_value);
+
+/**
+ * Get a number property on a set of properties using an interned key
+ *
+ * \param props the properties to query
+ * \param key the key of the property to query, from SDL_GetPropertyKey()
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a number property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetNumberProperty
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetNumberPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, Sint64 default_value);
+
+/**
+ * Get a floating point property on a set of properties using an interned key
+ *
+ * \param props the properties to query
+ * \param key the key of the property to query, from SDL_GetPropertyKey()
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a float property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetFloatProperty
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC float SDLCALL SDL_GetFloatPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, float default_value);
+
+/**
+ * Get a boolean property on a set of properties using an interned key
+ *
+ * \param props the properties to query
+ * \param key the key of the property to query, from SDL_GetPropertyKey()
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a boolean property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetBooleanProperty
+ * \sa SDL_GetPropertyKey
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, SDL_bool default_value);
+
 /**
  * Clear a property on a set of properties
  *
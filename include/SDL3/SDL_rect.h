@@ -70,6 +70,7 @@ typedef struct SDL_FPoint
  * \sa SDL_RectEmpty
  * \sa SDL_RectsEqual
  * \sa SDL_HasRectIntersection
+ * \sa SDL_HasRectIntersections
  * \sa SDL_GetRectIntersection
  * \sa SDL_GetRectAndLineIntersection
  * \sa SDL_GetRectUnion
@@ -89,6 +90,7 @@ typedef struct SDL_Rect
  * \sa SDL_RectsEqualFloat
  * \sa SDL_RectsEqualEpsilon
  * \sa SDL_HasRectIntersectionFloat
+ * \sa SDL_HasRectIntersectionsFloat
  * \sa SDL_GetRectIntersectionFloat
  * \sa SDL_GetRectAndLineIntersectionFloat
  * \sa SDL_GetRectUnionFloat
@@ -165,6 +167,29 @@ extern DECLSPEC SDL_bool SDLCALL SDL_GetRectIntersection(const SDL_Rect * A,
                                                    const SDL_Rect * B,
                                                    SDL_Rect * result);
 
+/**
+ * Determine which rectangles in an array intersect another rectangle.
+ *
+ * This is equivalent to calling SDL_HasRectIntersection() on each
+ * rectangle in the array, but is faster when culling many rectangles against
+ * the same clip rectangle, since several of them are tested at once where the
+ * CPU supports it.
+ *
+ * \param rects an array of SDL_Rect structures to test
+ * \param count the number of structures in the `rects` array
+ * \param B an SDL_Rect structure representing the rectangle to test against
+ * \param results an array of `count` SDL_bool filled in with SDL_TRUE for
+ *                each rectangle that intersects `B`, may be NULL
+ * \returns the number of rectangles that intersect `B` or a negative error
+ *          code on failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HasRectIntersection
+ */
+extern DECLSPEC int SDLCALL SDL_HasRectIntersections(const SDL_Rect *rects, int count,
+                                                     const SDL_Rect *B, SDL_bool *results);
+
 /**
  * Calculate the union of two rectangles.
  *
@@ -308,6 +333,29 @@ extern DECLSPEC SDL_bool SDLCALL SDL_GetRectIntersectionFloat(const SDL_FRect *
                                                     const SDL_FRect * B,
                                                     SDL_FRect * result);
 
+/**
+ * Determine which rectangles in an array intersect another rectangle.
+ *
+ * This is equivalent to calling SDL_HasRectIntersectionFloat() on each
+ * rectangle in the array, but is faster when culling many rectangles against
+ * the same clip rectangle, since several of them are tested at once where the
+ * CPU supports it.
+ *
+ * \param rects an array of SDL_FRect structures to test
+ * \param count the number of structures in the `rects` array
+ * \param B an SDL_FRect structure representing the rectangle to test against
+ * \param results an array of `count` SDL_bool filled in with SDL_TRUE for
+ *                each rectangle that intersects `B`, may be NULL
+ * \returns the number of rectangles that intersect `B` or a negative error
+ *          code on failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HasRectIntersectionFloat
+ */
+extern DECLSPEC int SDLCALL SDL_HasRectIntersectionsFloat(const SDL_FRect *rects, int count,
+                                                     const SDL_FRect *B, SDL_bool *results);
+
 /**
  * Calculate the union of two rectangles with float precision.
  *
@@ -95,16 +95,6 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
-/**
- * The scaling mode for a texture.
- */
-typedef enum
-{
-    SDL_SCALEMODE_NEAREST, /**< nearest pixel sampling */
-    SDL_SCALEMODE_LINEAR,  /**< linear filtering */
-    SDL_SCALEMODE_BEST     /**< anisotropic filtering */
-} SDL_ScaleMode;
-
 /**
  * The access pattern allowed for a texture.
  */
@@ -115,6 +105,20 @@ typedef enum
     SDL_TEXTUREACCESS_TARGET     /**< Texture can be used as a render target */
 } SDL_TextureAccess;
 
+/**
+ * The distance field stored in a texture, set with the "distance_field" texture property.
+ *
+ * Distance field textures are drawn as anti-aliased shapes whose edge is
+ * where the distance is 0.5, in the color modulation of the texture or the
+ * vertex colors, and stay sharp when scaled up.
+ */
+typedef enum
+{
+    SDL_DISTANCEFIELD_NONE, /**< The texture holds regular pixels */
+    SDL_DISTANCEFIELD_SDF,  /**< The alpha channel holds a signed distance field */
+    SDL_DISTANCEFIELD_MSDF  /**< The median of the red, green and blue channels is a multi-channel signed distance field */
+} SDL_DistanceField;
+
 /**
  * Flip constants for SDL_RenderTextureRotated
  */
@@ -125,6 +129,31 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  A copy of a texture drawn with SDL_RenderTextureInstanced()
+ */
+typedef struct SDL_TextureInstance
+{
+    SDL_FRect srcrect;          /**< The source rectangle in the texture */
+    SDL_FRect dstrect;          /**< The destination rectangle, in SDL_Renderer coordinates */
+    double angle;               /**< Clockwise rotation in degrees around the center of dstrect */
+    SDL_RendererFlip flip;      /**< Flipping actions performed on the texture */
+    SDL_Color color;            /**< Color and alpha modulation, combined with the texture modulation */
+} SDL_TextureInstance;
+
+/**
+ *  Presentation timing of a renderer, filled in by SDL_GetRenderPresentTiming()
+ *
+ *  All times are in nanoseconds, in the same timebase as SDL_GetTicksNS().
+ */
+typedef struct SDL_RenderPresentTiming
+{
+    Uint64 last_present_ns;     /**< When the most recently presented frame was shown */
+    Uint64 refresh_interval_ns; /**< The time between vertical blanks of the display */
+    Uint64 next_vblank_ns;      /**< The predicted time of the next vertical blank */
+    SDL_bool measured;          /**< SDL_TRUE if last_present_ns was reported by the display system, SDL_FALSE if SDL estimated it */
+} SDL_RenderPresentTiming;
+
 /**
  * How the logical size is mapped to the output
  */
@@ -149,6 +178,35 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ * A recorded sequence of rendering commands that can be replayed.
+ *
+ * \sa SDL_BeginRenderCommandList
+ */
+struct SDL_RenderCommandList;
+typedef struct SDL_RenderCommandList SDL_RenderCommandList;
+
+/**
+ * A sequence of drawing operations that can be built on any thread and is
+ * submitted to its renderer later.
+ *
+ * \sa SDL_CreateRenderRecorder
+ */
+struct SDL_RenderRecorder;
+typedef struct SDL_RenderRecorder SDL_RenderRecorder;
+
+/**
+ * A function that fills a texture again after it was evicted.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetTextureReloadCallback()
+ * \param texture the texture to fill, with SDL_UpdateTexture()
+ * \returns 0 on success or a negative error code on failure.
+ *
+ * \sa SDL_SetTextureReloadCallback
+ */
+typedef int (SDLCALL *SDL_TextureReloadCallback)(void *userdata, SDL_Texture *texture);
+
 /* Function prototypes */
 
 /**
@@ -254,6 +312,28 @@ extern DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window, co
  * - "surface" (pointer) - the surface where rendering is displayed, if you want a software renderer without a window
  * - "name" (string) - the name of the rendering driver to use, if a specific one is desired
  * - "present_vsync" (boolean) - true if you want present synchronized with the refresh rate
+ * - "texture_atlas" (boolean) - true if small static textures should be packed into shared textures, so drawing them doesn't break up batches, defaults to false
+ * - "stats" (boolean) - true if the renderer should count its work each frame and publish it in the renderer properties, defaults to false
+ * - "pipeline_cache" (string) - the path of a file where the renderer can keep the GPU pipeline states it builds, so later runs don't have to compile them again
+ * - "texture_memory_budget" (number) - the number of bytes of GPU memory textures and render targets should stay within, defaults to 0 for no limit
+ *
+ * When "texture_atlas" is enabled, static textures up to 128x128 pixels are
+ * placed in shared atlas pages and a copy of their pixels is kept in memory.
+ * These textures have no renderer specific properties, and binding one with
+ * SDL_GL_BindTexture() or changing its scale mode moves it into a texture of
+ * its own.
+ *
+ * The "pipeline_cache" file is read when the renderer is created and
+ * written when it's destroyed. It's specific to the GPU and driver it was
+ * made with and is rebuilt if they change. It's currently used by the
+ * direct3d12 and vulkan renderers and, on macOS 11 and iOS 14 or newer, by
+ * the metal renderer.
+ *
+ * The "texture_memory_budget" is a soft limit. When a new texture would go
+ * over it, render targets waiting in the SDL_AcquireRenderTarget() pool are
+ * destroyed, and then the least recently drawn textures that have a reload
+ * callback are evicted, see SDL_SetTextureReloadCallback(). If that's not
+ * enough the texture is created anyway.
  *
  * \param props the properties to use
  * \returns a valid rendering context or NULL if there was an error; call
@@ -338,8 +418,43 @@ extern DECLSPEC int SDLCALL SDL_GetRendererInfo(SDL_Renderer *renderer, SDL_Rend
  * "SDL.renderer.d3d11.device" (pointer) - the ID3D11Device associated with the renderer
  * "SDL.renderer.d3d12.device" (pointer) - the ID3D12Device associated with the renderer
  * "SDL.renderer.d3d12.command_queue" (pointer) - the ID3D12CommandQueue associated with the renderer
+ * "SDL.renderer.native_vertices" (boolean) - true if an SDL_Vertex array passed to SDL_RenderGeometry() or SDL_RenderGeometryRaw() with a texture is copied to the GPU as it is, when the render scale is 1
+ * "SDL.renderer.texture_memory" (number) - the bytes of GPU memory used by textures, not counting render targets
+ * "SDL.renderer.target_memory" (number) - the bytes of GPU memory used by render targets
+ * "SDL.renderer.texture_memory_budget" (number) - the "texture_memory_budget" the renderer was created with
+ * "SDL.renderer.texture_evictions" (number) - the number of times a texture has been evicted to stay within the budget
+ * ```
+ *
+ * The memory used by a texture is estimated from its size and pixel format,
+ * the GPU driver may need more than that.
+ *
+ * If the renderer was created with the "stats" property enabled, these
+ * counters are updated by SDL_RenderPresent() with the work done for the
+ * frame that was just presented:
+ *
+ * ```
+ * "SDL.renderer.stats.commands" (number) - the number of render commands
+ * "SDL.renderer.stats.commands.set_viewport" (number) - viewport changes
+ * "SDL.renderer.stats.commands.set_clip_rect" (number) - clip rectangle changes
+ * "SDL.renderer.stats.commands.set_draw_color" (number) - draw color changes
+ * "SDL.renderer.stats.commands.clear" (number) - clears
+ * "SDL.renderer.stats.commands.draw_points" (number) - point draws
+ * "SDL.renderer.stats.commands.draw_lines" (number) - line draws
+ * "SDL.renderer.stats.commands.fill_rects" (number) - rectangle fills
+ * "SDL.renderer.stats.commands.copy" (number) - texture copies
+ * "SDL.renderer.stats.commands.copy_ex" (number) - rotated or flipped texture copies
+ * "SDL.renderer.stats.commands.geometry" (number) - geometry draws
+ * "SDL.renderer.stats.commands.draw_instances" (number) - hardware instanced texture draws
+ * "SDL.renderer.stats.flushes" (number) - the number of times the command queue was flushed
+ * "SDL.renderer.stats.batches" (number) - the number of command queues sent to the GPU
+ * "SDL.renderer.stats.vertex_bytes" (number) - the bytes of vertex data sent to the GPU
+ * "SDL.renderer.stats.texture_upload_bytes" (number) - the bytes of pixel data uploaded to textures
+ * "SDL.renderer.stats.gpu_time_ns" (number) - the GPU time of the most recent frame that has finished, in nanoseconds, if the renderer supports timer queries
  * ```
  *
+ * Adjacent draws may be merged into a single command, so the command counts
+ * are not necessarily the number of API calls.
+ *
  * \param renderer the rendering context
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -451,18 +566,31 @@ extern DECLSPEC SDL_Texture *SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer *
  * - "access" (number) - one of the enumerated values in SDL_TextureAccess, defaults to SDL_TEXTUREACCESS_STATIC
  * - "width" (number) - the width of the texture in pixels, required
  * - "height" (number) - the height of the texture in pixels, required
+ * - "atlas" (boolean) - false if the texture shouldn't be packed into a shared texture when the renderer was created with "texture_atlas" enabled, defaults to true
+ * - "lock_shadow" (boolean) - true if a streaming texture should be shadowed in CPU memory, so SDL_LockTexture() never waits for the GPU, a locked area keeps its contents, and the changes are uploaded once right before the texture is next drawn, defaults to false
+ * - "distance_field" (number) - one of the enumerated values in SDL_DistanceField, defaults to SDL_DISTANCEFIELD_NONE. Texture creation fails if the renderer can't draw distance fields, this is supported by the opengl, opengles2 and vulkan renderers.
  *
  * With the direct3d11 renderer:
  *
  * - "d3d11.texture" (pointer) - the ID3D11Texture2D associated with the texture, if you want to wrap an existing texture.
  * - "d3d11.texture_u" (pointer) - the ID3D11Texture2D associated with the U plane of a YUV texture, if you want to wrap an existing texture.
  * - "d3d11.texture_v" (pointer) - the ID3D11Texture2D associated with the V plane of a YUV texture, if you want to wrap an existing texture.
+ * - "d3d11.shared_handle" (pointer) - a shared NT HANDLE to a texture created by another device or process, if you want to sample it without a copy.
+ * - "d3d11.shared_handle_u" (pointer) - a shared NT HANDLE to the U plane of a YUV texture, if you want to sample it without a copy.
+ * - "d3d11.shared_handle_v" (pointer) - a shared NT HANDLE to the V plane of a YUV texture, if you want to sample it without a copy.
  *
  * With the direct3d12 renderer:
  *
  * - "d3d12.texture" (pointer) - the ID3D12Resource associated with the texture, if you want to wrap an existing texture.
  * - "d3d12.texture_u" (pointer) - the ID3D12Resource associated with the U plane of a YUV texture, if you want to wrap an existing texture.
  * - "d3d12.texture_v" (pointer) - the ID3D12Resource associated with the V plane of a YUV texture, if you want to wrap an existing texture.
+ * - "d3d12.shared_handle" (pointer) - a shared NT HANDLE to a resource created by another device or process, if you want to sample it without a copy.
+ * - "d3d12.shared_handle_u" (pointer) - a shared NT HANDLE to the U plane of a YUV texture, if you want to sample it without a copy.
+ * - "d3d12.shared_handle_v" (pointer) - a shared NT HANDLE to the V plane of a YUV texture, if you want to sample it without a copy.
+ *
+ * With the metal renderer:
+ *
+ * - "metal.iosurface" (pointer) - the IOSurfaceRef to sample from without a copy. YUV data must use a two plane NV12 or NV21 surface.
  *
  * With the opengl renderer:
  *
@@ -477,6 +605,11 @@ extern DECLSPEC SDL_Texture *SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer *
  * - "opengles2.texture_uv" (number) - the GLuint texture associated with the UV plane of an NV12 texture, if you want to wrap an existing texture.
  * - "opengles2.texture_u" (number) - the GLuint texture associated with the U plane of a YUV texture, if you want to wrap an existing texture.
  * - "opengles2.texture_v" (number) - the GLuint texture associated with the V plane of a YUV texture, if you want to wrap an existing texture.
+ * - "opengles2.dmabuf.fd0" through "opengles2.dmabuf.fd3" (number) - the dmabuf file descriptors of each plane, in memory order, if you want to sample a dmabuf without a copy. The renderer must use an EGL context. NV12 and NV21 dmabufs should be imported as SDL_PIXELFORMAT_EXTERNAL_OES textures.
+ * - "opengles2.dmabuf.offset0" through "opengles2.dmabuf.offset3" (number) - the byte offset of each plane in its dmabuf, defaults to 0.
+ * - "opengles2.dmabuf.pitch0" through "opengles2.dmabuf.pitch3" (number) - the pitch in bytes of each plane, required with a dmabuf.
+ * - "opengles2.dmabuf.modifier" (number) - the DRM format modifier of the dmabuf, defaults to an implicit modifier.
+ * - "opengles2.dmabuf.format" (number) - the DRM fourcc of the dmabuf, required for SDL_PIXELFORMAT_EXTERNAL_OES textures. Other formats use the DRM format matching the texture format.
  *
  * \param renderer the rendering context
  * \param props the properties to use
@@ -494,6 +627,82 @@ extern DECLSPEC SDL_Texture *SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer *
  */
 extern DECLSPEC SDL_Texture *SDLCALL SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props);
 
+/**
+ * Get a render target texture, reusing one released earlier if possible.
+ *
+ * This is meant for intermediate targets that only live for part of a frame,
+ * like the passes of a post-processing effect. Textures given back with
+ * SDL_ReleaseRenderTarget() are kept in a pool for a few frames, and one
+ * that matches the format and size is returned instead of creating a new
+ * texture. Textures that aren't reused in time are destroyed by
+ * SDL_RenderPresent().
+ *
+ * A reused texture has the color and alpha modulation, blend mode, scale
+ * mode and viewport of a new texture, but its contents are undefined, so
+ * clear or fully overwrite it before use. Properties set on it are kept.
+ *
+ * The texture can be destroyed with SDL_DestroyTexture() as usual.
+ *
+ * \param renderer the rendering context
+ * \param format one of the enumerated values in SDL_PixelFormatEnum, or 0 for
+ *               the renderer's preferred format
+ * \param w the width of the texture in pixels
+ * \param h the height of the texture in pixels
+ * \returns a texture with SDL_TEXTUREACCESS_TARGET access or NULL if there
+ *          was an error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateTexture
+ * \sa SDL_ReleaseRenderTarget
+ */
+extern DECLSPEC SDL_Texture *SDLCALL SDL_AcquireRenderTarget(SDL_Renderer *renderer, Uint32 format, int w, int h);
+
+/**
+ * Give a render target texture back to the renderer for reuse.
+ *
+ * The texture must not be used after this call, it may be returned by a
+ * later call to SDL_AcquireRenderTarget() or destroyed. Drawing already
+ * queued with it is not affected.
+ *
+ * \param texture a texture with SDL_TEXTUREACCESS_TARGET access, which is
+ *                not the current render target
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireRenderTarget
+ */
+extern DECLSPEC int SDLCALL SDL_ReleaseRenderTarget(SDL_Texture *texture);
+
+/**
+ * Let a texture be evicted when the renderer is over its texture memory
+ * budget.
+ *
+ * An evicted texture gives its GPU memory back, and is created again the
+ * next time it's drawn or updated. The callback is then called to fill it
+ * with its pixels, which it does with SDL_UpdateTexture(). Textures are
+ * evicted least recently drawn first.
+ *
+ * Only static textures in a format the renderer supports directly, that
+ * aren't packed into a texture atlas, can be evicted. The renderer specific
+ * properties of a texture, like the OpenGL texture name, change when it's
+ * created again.
+ *
+ * \param texture the texture to set the callback for
+ * \param callback the function to call after the texture is created again,
+ *                 or NULL to keep the texture from being evicted
+ * \param userdata a pointer that is passed to `callback`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRendererWithProperties
+ */
+extern DECLSPEC int SDLCALL SDL_SetTextureReloadCallback(SDL_Texture *texture, SDL_TextureReloadCallback callback, void *userdata);
+
 /**
  * Get the properties associated with a texture.
  *
@@ -738,8 +947,8 @@ extern DECLSPEC int SDLCALL SDL_GetTextureScaleMode(SDL_Texture *texture, SDL_Sc
 extern DECLSPEC int SDLCALL SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch);
 
 /**
- * Update a rectangle within a planar YV12 or IYUV texture with new pixel
- * data.
+ * Update a rectangle within a planar YV12, IYUV or I444 texture with new
+ * pixel data.
  *
  * You can use SDL_UpdateTexture() as long as your pixel data is a contiguous
  * block of Y and U/V planes in the proper order, but this function is
@@ -771,12 +980,16 @@ extern DECLSPEC int SDLCALL SDL_UpdateYUVTexture(SDL_Texture *texture,
                                                  const Uint8 *Vplane, int Vpitch);
 
 /**
- * Update a rectangle within a planar NV12 or NV21 texture with new pixels.
+ * Update a rectangle within a planar NV12, NV21, P010 or P016 texture with
+ * new pixels.
  *
  * You can use SDL_UpdateTexture() as long as your pixel data is a contiguous
  * block of NV12/21 planes in the proper order, but this function is available
  * if your pixel data is not contiguous.
  *
+ * P010 and P016 textures use 16-bit samples, so the Y and UV planes are twice
+ * as wide in bytes as their NV12 counterparts.
+ *
  * \param texture the texture to update
  * \param rect a pointer to the rectangle of pixels to update, or NULL to
  *             update the entire texture.
@@ -796,6 +1009,74 @@ extern DECLSPEC int SDLCALL SDL_UpdateNVTexture(SDL_Texture *texture,
                                                  const Uint8 *Yplane, int Ypitch,
                                                  const Uint8 *UVplane, int UVpitch);
 
+/**
+ * Update the given texture rectangle with new pixel data without waiting for
+ * the copy to finish.
+ *
+ * This works like SDL_UpdateTexture(), but the pixels are copied into a
+ * staging buffer and handed to the GPU without blocking the render thread.
+ * The pixel data may be reused or freed as soon as this function returns.
+ *
+ * The update is ordered with other rendering: anything drawn with the texture
+ * before this call uses the old contents, anything drawn afterwards uses the
+ * new contents.
+ *
+ * On OpenGL the copy is done through a pixel buffer object, on other
+ * renderers it is deferred until the command queue is next flushed. Textures
+ * in formats the renderer converts on the CPU are updated immediately.
+ *
+ * \param texture the texture to update
+ * \param rect an SDL_Rect structure representing the area to update, or NULL
+ *             to update the entire texture
+ * \param pixels the raw pixel data in the format of the texture
+ * \param pitch the number of bytes in a row of pixel data, including padding
+ *              between lines
+ * \returns a non-zero ticket that can be passed to
+ *          SDL_IsTextureUploadComplete() and SDL_WaitTextureUpload(), or 0 on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IsTextureUploadComplete
+ * \sa SDL_UpdateTexture
+ * \sa SDL_WaitTextureUpload
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_UpdateTextureAsync(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch);
+
+/**
+ * Query whether an upload started with SDL_UpdateTextureAsync() has finished.
+ *
+ * An upload is complete once the renderer no longer needs its staging
+ * buffer.
+ *
+ * \param renderer the rendering context
+ * \param ticket the ticket returned by SDL_UpdateTextureAsync()
+ * \returns SDL_TRUE if the upload has finished or SDL_FALSE if it is still in
+ *          progress or the ticket is invalid; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_UpdateTextureAsync
+ * \sa SDL_WaitTextureUpload
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_IsTextureUploadComplete(SDL_Renderer *renderer, Uint64 ticket);
+
+/**
+ * Wait for an upload started with SDL_UpdateTextureAsync() to finish.
+ *
+ * \param renderer the rendering context
+ * \param ticket the ticket returned by SDL_UpdateTextureAsync()
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IsTextureUploadComplete
+ * \sa SDL_UpdateTextureAsync
+ */
+extern DECLSPEC int SDLCALL SDL_WaitTextureUpload(SDL_Renderer *renderer, Uint64 ticket);
+
 /**
  * Lock a portion of the texture for **write-only** pixel access.
  *
@@ -1391,6 +1672,32 @@ extern DECLSPEC int SDLCALL SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL
                                                      const double angle, const SDL_FPoint *center,
                                                      const SDL_RendererFlip flip);
 
+/**
+ * Copy many portions of a texture to the current rendering target in one
+ * call.
+ *
+ * This is equivalent to calling SDL_RenderTextureRotated() for each
+ * instance, and saves the per-call overhead when drawing many sprites or
+ * particles from the same texture. The OpenGL and OpenGL ES 2 renderers draw
+ * the instances with hardware instancing when the driver supports it, so only
+ * one small record per instance is uploaded. Other renderers expand the
+ * instances into vertices on the CPU and queue them as a single geometry
+ * draw.
+ *
+ * \param renderer The renderer which should copy parts of a texture.
+ * \param texture The source texture.
+ * \param instances An array of SDL_TextureInstance structures describing
+ *                  each copy.
+ * \param num_instances The number of instances.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTextureRotated
+ */
+extern DECLSPEC int SDLCALL SDL_RenderTextureInstanced(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int num_instances);
+
 /**
  * Render a list of triangles, optionally using a texture and indices into the
  * vertex array Color and alpha modulation is done per vertex
@@ -1450,6 +1757,230 @@ extern DECLSPEC int SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                                                int num_vertices,
                                                const void *indices, int num_indices, int size_indices);
 
+/**
+ * Start recording rendering commands into a reusable command list.
+ *
+ * Any pending rendering is flushed, and subsequent drawing calls on this
+ * renderer are recorded instead of being drawn, until
+ * SDL_EndRenderCommandList() is called. The recorded commands keep the
+ * renderer's backend-specific vertex data, so replaying them with
+ * SDL_ReplayRenderCommandList() doesn't need to translate the drawing calls
+ * again.
+ *
+ * While recording, anything that needs the command queue to be flushed, such
+ * as SDL_RenderPresent(), SDL_RenderReadPixels(), SDL_SetRenderTarget() or
+ * updating a texture that has already been drawn, will fail and cause
+ * SDL_EndRenderCommandList() to return NULL.
+ *
+ * \param renderer the rendering context
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EndRenderCommandList
+ * \sa SDL_ReplayRenderCommandList
+ */
+extern DECLSPEC int SDLCALL SDL_BeginRenderCommandList(SDL_Renderer *renderer);
+
+/**
+ * Finish recording rendering commands.
+ *
+ * \param renderer the rendering context
+ * \returns the recorded command list on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BeginRenderCommandList
+ * \sa SDL_DestroyRenderCommandList
+ * \sa SDL_ReplayRenderCommandList
+ */
+extern DECLSPEC SDL_RenderCommandList *SDLCALL SDL_EndRenderCommandList(SDL_Renderer *renderer);
+
+/**
+ * Queue a previously recorded command list for rendering.
+ *
+ * The commands are drawn with the viewport and clip rectangle that were in
+ * effect when they were recorded, translated by (`x`, `y`) in render
+ * coordinates. The current draw color, viewport and clip rectangle of the
+ * renderer are not changed.
+ *
+ * The command list becomes invalid if any texture it draws is destroyed, in
+ * which case this function returns an error.
+ *
+ * \param renderer the rendering context the list was recorded with
+ * \param list the command list to draw
+ * \param x the horizontal offset to draw the list at
+ * \param y the vertical offset to draw the list at
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BeginRenderCommandList
+ */
+extern DECLSPEC int SDLCALL SDL_ReplayRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list, float x, float y);
+
+/**
+ * Destroy a recorded command list.
+ *
+ * Command lists are destroyed automatically when their renderer is destroyed.
+ *
+ * \param list the command list to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EndRenderCommandList
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyRenderCommandList(SDL_RenderCommandList *list);
+
+/**
+ * Create a recorder for building drawing operations on another thread.
+ *
+ * A recorder collects draw calls without touching the renderer, so several
+ * threads can each fill their own recorder in parallel. A recorder may only
+ * be used by one thread at a time.
+ *
+ * Recorded operations are executed by the renderer in the order the
+ * recorders were submitted with SDL_SubmitRenderRecorder(), at the beginning
+ * of the next call to SDL_RenderPresent(). They use the render target,
+ * viewport, clipping rectangle and scale in effect at that time, and don't
+ * change the renderer's draw color or blend mode.
+ *
+ * \param renderer the rendering context the operations will be drawn with
+ * \returns a new recorder or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyRenderRecorder
+ * \sa SDL_SubmitRenderRecorder
+ */
+extern DECLSPEC SDL_RenderRecorder *SDLCALL SDL_CreateRenderRecorder(SDL_Renderer *renderer);
+
+/**
+ * Record setting the color used for drawing operations.
+ *
+ * \param recorder the recorder to add the operation to
+ * \param r the red value used to draw on the rendering target
+ * \param g the green value used to draw on the rendering target
+ * \param b the blue value used to draw on the rendering target
+ * \param a the alpha value used to draw on the rendering target
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetRenderDrawColor
+ */
+extern DECLSPEC int SDLCALL SDL_RecordRenderDrawColor(SDL_RenderRecorder *recorder, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+/**
+ * Record setting the blend mode used for drawing operations.
+ *
+ * \param recorder the recorder to add the operation to
+ * \param blendMode the SDL_BlendMode to use for blending
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetRenderDrawBlendMode
+ */
+extern DECLSPEC int SDLCALL SDL_RecordRenderDrawBlendMode(SDL_RenderRecorder *recorder, SDL_BlendMode blendMode);
+
+/**
+ * Record filling some number of rectangles with the recorded draw color.
+ *
+ * \param recorder the recorder to add the operation to
+ * \param rects a pointer to an array of destination rectangles
+ * \param count the number of rectangles
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderFillRects
+ */
+extern DECLSPEC int SDLCALL SDL_RecordRenderFillRects(SDL_RenderRecorder *recorder, const SDL_FRect *rects, int count);
+
+/**
+ * Record copying a portion of a texture to the rendering target.
+ *
+ * The texture must not be destroyed until the recording has been drawn.
+ *
+ * \param recorder the recorder to add the operation to
+ * \param texture the source texture
+ * \param srcrect a pointer to the source rectangle, or NULL for the entire
+ *                texture
+ * \param dstrect a pointer to the destination rectangle, or NULL for the
+ *                entire rendering target
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTexture
+ */
+extern DECLSPEC int SDLCALL SDL_RecordRenderTexture(SDL_RenderRecorder *recorder, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect);
+
+/**
+ * Record rendering a list of triangles.
+ *
+ * The texture must not be destroyed until the recording has been drawn.
+ *
+ * \param recorder the recorder to add the operation to
+ * \param texture (optional) The SDL texture to use.
+ * \param vertices Vertices.
+ * \param num_vertices Number of vertices.
+ * \param indices (optional) An array of integer indices into the 'vertices'
+ *                array, if NULL all vertices will be rendered in sequential
+ *                order.
+ * \param num_indices Number of indices.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderGeometry
+ */
+extern DECLSPEC int SDLCALL SDL_RecordRenderGeometry(SDL_RenderRecorder *recorder, SDL_Texture *texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices);
+
+/**
+ * Submit the operations in a recorder to its renderer.
+ *
+ * The recorded operations are drawn at the beginning of the next call to
+ * SDL_RenderPresent() or SDL_RenderFlush(), after any previously submitted
+ * recordings. The recorder is empty afterwards and can be reused.
+ *
+ * \param recorder the recorder to submit
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderRecorder
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitRenderRecorder(SDL_RenderRecorder *recorder);
+
+/**
+ * Destroy a recorder.
+ *
+ * Operations that were already submitted are still drawn.
+ *
+ * \param recorder the recorder to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderRecorder
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyRenderRecorder(SDL_RenderRecorder *recorder);
+
 /**
  * Read pixels from the current rendering target to an array of pixels.
  *
@@ -1481,6 +2012,84 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer,
                                                  Uint32 format,
                                                  void *pixels, int pitch);
 
+/**
+ * Start reading pixels from the current rendering target without waiting for
+ * the GPU.
+ *
+ * This works like SDL_RenderReadPixels(), but the pixels are copied into a
+ * staging buffer on the GPU timeline and the render thread keeps going. Call
+ * SDL_FinishRenderReadPixels() a frame or two later to get the pixels. Like
+ * SDL_RenderReadPixels(), this should be called after rendering and before
+ * SDL_RenderPresent() when reading the main rendering target.
+ *
+ * On OpenGL the copy is done into a pixel buffer object, with Direct3D 11
+ * into a staging texture and with Metal into a shared buffer. Other renderers
+ * read the pixels immediately.
+ *
+ * \param renderer the rendering context
+ * \param rect an SDL_Rect structure representing the area in pixels relative
+ *             to the to current viewport, or NULL for the entire viewport
+ * \param format an SDL_PixelFormatEnum value of the desired format of the
+ *               pixel data, or 0 to use the format of the rendering target
+ * \returns a non-zero ticket that can be passed to
+ *          SDL_IsRenderReadPixelsComplete() and SDL_FinishRenderReadPixels(),
+ *          or 0 on failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FinishRenderReadPixels
+ * \sa SDL_IsRenderReadPixelsComplete
+ * \sa SDL_RenderReadPixels
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format);
+
+/**
+ * Query whether a read started with SDL_RenderReadPixelsAsync() has
+ * finished on the GPU.
+ *
+ * Once this returns SDL_TRUE, SDL_FinishRenderReadPixels() won't block.
+ *
+ * \param renderer the rendering context
+ * \param ticket the ticket returned by SDL_RenderReadPixelsAsync()
+ * \returns SDL_TRUE if the pixels are ready or SDL_FALSE if the read is still
+ *          in progress or the ticket is invalid; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FinishRenderReadPixels
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_IsRenderReadPixelsComplete(SDL_Renderer *renderer, Uint64 ticket);
+
+/**
+ * Get the pixels of a read started with SDL_RenderReadPixelsAsync().
+ *
+ * This waits for the read to finish if necessary, copies the pixels and
+ * releases the staging buffer, after which the ticket is no longer valid.
+ *
+ * The pixels are laid out like those from SDL_RenderReadPixels() with the
+ * same rectangle, so `pixels` should be large enough to hold the rectangle
+ * that was passed to SDL_RenderReadPixelsAsync().
+ *
+ * Reads that are never finished are released when the renderer is
+ * destroyed.
+ *
+ * \param renderer the rendering context
+ * \param ticket the ticket returned by SDL_RenderReadPixelsAsync()
+ * \param pixels a pointer to the pixel data to copy into, or NULL to discard
+ *               the pixels
+ * \param pitch the pitch of the `pixels` parameter
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IsRenderReadPixelsComplete
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern DECLSPEC int SDLCALL SDL_FinishRenderReadPixels(SDL_Renderer *renderer, Uint64 ticket, void *pixels, int pitch);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
@@ -1566,6 +2175,9 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer *renderer);
  *
  * In all other cases, you can ignore this function.
  *
+ * Recordings submitted with SDL_SubmitRenderRecorder() are drawn before the
+ * commands are flushed.
+ *
  * \param renderer the rendering context
  * \returns 0 on success or a negative error code on failure; call
  *          SDL_GetError() for more information.
@@ -1690,6 +2302,54 @@ extern DECLSPEC int SDLCALL SDL_SetRenderVSync(SDL_Renderer *renderer, int vsync
  */
 extern DECLSPEC int SDLCALL SDL_GetRenderVSync(SDL_Renderer *renderer, int *vsync);
 
+/**
+ * Get the presentation timing of a renderer.
+ *
+ * Where the platform reports it, the time the last frame was shown is taken
+ * from the display system (DXGI frame statistics for the direct3d11 and
+ * direct3d12 renderers, the drawable's presented time for the metal
+ * renderer). Otherwise SDL estimates it from when SDL_RenderPresent()
+ * returned, which is close to the vertical blank when vsync is enabled.
+ *
+ * The values are updated by SDL_RenderPresent(). Before the first present
+ * last_present_ns and next_vblank_ns are zero.
+ *
+ * \param renderer the rendering context
+ * \param timing a pointer filled in with the presentation timing
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderPresent
+ * \sa SDL_WaitRenderFrame
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderPresentTiming(SDL_Renderer *renderer, SDL_RenderPresentTiming *timing);
+
+/**
+ * Wait until it's time to start rendering the next frame.
+ *
+ * This delays until `frame_time_ns` before the next vertical blank that a
+ * frame started now can still make, so input is sampled as late as possible
+ * without missing vsync. Pass the time it takes to render and present a
+ * frame, with some margin; if it's a full refresh interval or more, this
+ * returns immediately.
+ *
+ * If vsync is disabled there is no vertical blank to aim for, and this
+ * returns immediately.
+ *
+ * \param renderer the rendering context
+ * \param frame_time_ns the expected time to render and present a frame, in
+ *                      nanoseconds
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRenderPresentTiming
+ */
+extern DECLSPEC int SDLCALL SDL_WaitRenderFrame(SDL_Renderer *renderer, Uint64 frame_time_ns);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -46,6 +46,8 @@ extern "C" {
 #define SDL_RWOPS_JNIFILE   3   /**< Android asset */
 #define SDL_RWOPS_MEMORY    4   /**< Memory stream */
 #define SDL_RWOPS_MEMORY_RO 5   /**< Read-Only memory stream */
+#define SDL_RWOPS_MAPPED    6   /**< Read-Only memory mapped file */
+#define SDL_RWOPS_BUFFERED  7   /**< Buffered wrapper around another stream */
 
 /* RWops status, set by a read or write operation */
 #define SDL_RWOPS_STATUS_READY          0   /**< Everything is ready */
@@ -55,6 +57,15 @@ extern "C" {
 #define SDL_RWOPS_STATUS_READONLY       4   /**< Tried to write a read-only buffer */
 #define SDL_RWOPS_STATUS_WRITEONLY      5   /**< Tried to read a write-only buffer */
 
+/**
+ * A buffer for SDL_RWreadvAt() to read into.
+ */
+typedef struct SDL_RWvec
+{
+    void *ptr;      /**< The area to read into */
+    size_t size;    /**< The number of bytes to read into this area */
+} SDL_RWvec;
+
 /**
  * This is the read/write operation structure -- very basic.
  */
@@ -91,6 +102,34 @@ typedef struct SDL_RWops
      */
     size_t (SDLCALL *write)(struct SDL_RWops *context, const void *ptr, size_t size);
 
+    /**
+     *  Read up to \c size bytes starting at \c offset in the data stream,
+     *  without using or changing the current position. This may be NULL,
+     *  in which case SDL_RWreadAt() seeks and reads instead.
+     *
+     *  \return the number of bytes read
+     */
+    size_t (SDLCALL *readat)(struct SDL_RWops *context, void *ptr, size_t size, Sint64 offset);
+
+    /**
+     *  Read consecutive bytes starting at \c offset in the data stream
+     *  into \c count areas, without using or changing the current position.
+     *  This may be NULL, in which case SDL_RWreadvAt() reads each area
+     *  separately.
+     *
+     *  \return the total number of bytes read
+     */
+    size_t (SDLCALL *readvat)(struct SDL_RWops *context, const SDL_RWvec *vec, int count, Sint64 offset);
+
+    /**
+     *  Write exactly \c size bytes starting at \c offset in the data
+     *  stream, without using or changing the current position. This may be
+     *  NULL, in which case SDL_RWwriteAt() seeks and writes instead.
+     *
+     *  \return the number of bytes written
+     */
+    size_t (SDLCALL *writeat)(struct SDL_RWops *context, const void *ptr, size_t size, Sint64 offset);
+
     /**
      *  Close and free an allocated SDL_RWops structure.
      *
@@ -107,6 +146,8 @@ typedef struct SDL_RWops
         struct
         {
             void *asset;
+            int fd;         /* -1 if the asset is compressed */
+            Sint64 start;
         } androidio;
 
 #elif defined(__WIN32__) || defined(__GDK__) || defined(__WINRT__)
@@ -114,6 +155,7 @@ typedef struct SDL_RWops
         {
             SDL_bool append;
             void *h;
+            Sint64 position;
             struct
             {
                 void *data;
@@ -126,6 +168,7 @@ typedef struct SDL_RWops
         struct
         {
             SDL_bool autoclose;
+            SDL_bool unflushed;
             void *fp;
         } stdio;
 
@@ -136,6 +179,13 @@ typedef struct SDL_RWops
             Uint8 *stop;
         } mem;
 
+        struct
+        {
+            Uint8 *here;
+            Uint8 *stop;
+            void *data;
+        } buffered;
+
         struct
         {
             void *data1;
@@ -280,6 +330,73 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, size_t size);
  */
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem, size_t size);
 
+/**
+ * Use this function to map a file into memory for reading with SDL_RWops.
+ *
+ * Reads from the returned stream are served straight from the mapping, so
+ * the file doesn't need to be read in chunks through the C runtime or the
+ * operating system's file API. SDL_GetRWMemory() can be used to access the
+ * file contents directly, without copying them at all.
+ *
+ * The stream is read-only, attempting to write to it will report an error.
+ * The file shouldn't be modified or truncated while it's mapped.
+ *
+ * If the file can't be mapped, for example if it's empty, it's an Android
+ * asset, or the platform doesn't support memory mapped files, this falls
+ * back to SDL_RWFromFile() in read mode, and SDL_GetRWMemory() will return
+ * NULL for the stream.
+ *
+ * Closing the SDL_RWops will unmap the file.
+ *
+ * \param file a UTF-8 string representing the filename to open
+ * \returns a pointer to the SDL_RWops structure that is created, or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRWMemory
+ * \sa SDL_RWclose
+ * \sa SDL_RWFromFile
+ * \sa SDL_RWread
+ * \sa SDL_RWseek
+ * \sa SDL_RWtell
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromFileMapped(const char *file);
+
+/**
+ * Use this function to add a buffer in front of another SDL_RWops.
+ *
+ * Reads from the returned stream fill the buffer with large reads from
+ * `src`, and small writes are collected in the buffer before being written
+ * to `src`. This is useful for streams that go to the operating system or
+ * to a custom SDL_RWops implementation for every read, when the data is
+ * parsed a few bytes at a time, for example with SDL_ReadU32LE().
+ *
+ * Reads and writes larger than the buffer go straight to `src`. Seeking
+ * within the data that's currently buffered for reading doesn't touch
+ * `src` at all.
+ *
+ * `src` shouldn't be used directly while it's being buffered. When the
+ * returned stream is closed, any buffered writes are written to `src`, and
+ * if `freesrc` is SDL_FALSE, `src` is moved back to the position that had
+ * been reached in the buffered stream, if it supports seeking.
+ *
+ * \param src the SDL_RWops to buffer
+ * \param buffersize the size of the buffer in bytes, or 0 for a default size
+ * \param freesrc if SDL_TRUE, calls SDL_RWclose() on `src` when the
+ *                returned stream is closed, even in the case of an error
+ * \returns a pointer to the SDL_RWops structure that is created, or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWclose
+ * \sa SDL_RWread
+ * \sa SDL_RWseek
+ * \sa SDL_RWwrite
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_CreateBufferedRW(SDL_RWops *src, size_t buffersize, SDL_bool freesrc);
+
 /* @} *//* RWFrom functions */
 
 
@@ -336,6 +453,12 @@ extern DECLSPEC void SDLCALL SDL_DestroyRW(SDL_RWops *context);
 /**
  * Get the properties associated with an SDL_RWops.
  *
+ * The following properties are understood by SDL:
+ *
+ * - "SDL.rwops.size_hint" (number): the expected size of a stream that
+ *   doesn't know its size, used by SDL_LoadFile_RW() to allocate a buffer up
+ *   front.
+ *
  * \param context a pointer to an SDL_RWops structure
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -347,6 +470,31 @@ extern DECLSPEC void SDLCALL SDL_DestroyRW(SDL_RWops *context);
  */
 extern DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRWProperties(SDL_RWops *context);
 
+/**
+ * Get the memory backing an SDL_RWops stream.
+ *
+ * This works for streams created with SDL_RWFromMem(), SDL_RWFromConstMem()
+ * and SDL_RWFromFileMapped(), and lets loaders use the data in place instead
+ * of reading a copy of it. The returned pointer corresponds to offset 0 in
+ * the stream, use SDL_RWtell() to find the current position.
+ *
+ * The memory must not be written to, and is only valid until the stream is
+ * closed.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param size a pointer filled in with the size of the memory, in bytes, may
+ *             be NULL
+ * \returns a pointer to the memory, or NULL if the stream isn't backed by
+ *          memory.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWFromConstMem
+ * \sa SDL_RWFromFileMapped
+ * \sa SDL_RWFromMem
+ */
+extern DECLSPEC const void *SDLCALL SDL_GetRWMemory(SDL_RWops *context, size_t *size);
+
 #define SDL_RW_SEEK_SET 0       /**< Seek from the beginning of data */
 #define SDL_RW_SEEK_CUR 1       /**< Seek relative to current read point */
 #define SDL_RW_SEEK_END 2       /**< Seek relative to the end of data */
@@ -496,6 +644,89 @@ extern DECLSPEC size_t SDLCALL SDL_RWread(SDL_RWops *context, void *ptr, size_t
  */
 extern DECLSPEC size_t SDLCALL SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size);
 
+/**
+ * Read from a data source at a given offset.
+ *
+ * This function reads up to `size` bytes starting `offset` bytes into the
+ * data source, without using or changing the current read/write position,
+ * so it can be used on a stream that's also being read sequentially.
+ *
+ * Streams from SDL_RWFromFile() on most platforms, uncompressed Android
+ * assets and memory streams read at the offset directly, with a single
+ * system call or none at all, and can be read with this function from
+ * several threads at once. Other streams are read by seeking to `offset`,
+ * reading and seeking back, which isn't safe to do from more than one
+ * thread at a time.
+ *
+ * Unlike SDL_RWread(), this function doesn't change the stream's status.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param ptr a pointer to a buffer to read data into
+ * \param size the number of bytes to read from the data source
+ * \param offset the position in the data source to read from, in bytes
+ * \returns the number of bytes read, which will be less than `size` at the
+ *          end of the data or on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWread
+ * \sa SDL_RWreadvAt
+ * \sa SDL_RWwriteAt
+ */
+extern DECLSPEC size_t SDLCALL SDL_RWreadAt(SDL_RWops *context, void *ptr, size_t size, Sint64 offset);
+
+/**
+ * Read consecutive data from a data source into several buffers at once.
+ *
+ * This function fills the `count` areas described by `vec` in order with
+ * the data starting `offset` bytes into the data source, moving on to the
+ * next area once one is full. Like SDL_RWreadAt(), it doesn't use or change
+ * the current read/write position.
+ *
+ * Files are read with a single system call where the platform supports it,
+ * which is cheaper than reading each area separately when the data is split
+ * into, for example, a header and a payload that go to different places.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param vec an array of areas to read into
+ * \param count the number of elements in `vec`
+ * \param offset the position in the data source to read from, in bytes
+ * \returns the total number of bytes read, which will be less than the total
+ *          size of the areas at the end of the data or on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWreadAt
+ */
+extern DECLSPEC size_t SDLCALL SDL_RWreadvAt(SDL_RWops *context, const SDL_RWvec *vec, int count, Sint64 offset);
+
+/**
+ * Write to a data stream at a given offset.
+ *
+ * This function writes `size` bytes from the area pointed at by `ptr`
+ * starting `offset` bytes into the stream, without using or changing the
+ * current read/write position. Thread safety is the same as for
+ * SDL_RWreadAt().
+ *
+ * Where the data ends up in a file opened for appending depends on the
+ * platform, so this shouldn't be used with those.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param ptr a pointer to a buffer containing data to write
+ * \param size the number of bytes to write
+ * \param offset the position in the stream to write to, in bytes
+ * \returns the number of bytes written, which will be less than `size` on
+ *          error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWreadAt
+ * \sa SDL_RWwrite
+ */
+extern DECLSPEC size_t SDLCALL SDL_RWwriteAt(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset);
+
 /**
  * Print to an SDL_RWops data stream.
  *
@@ -578,6 +809,13 @@ extern DECLSPEC int SDLCALL SDL_RWclose(SDL_RWops *context);
  *
  * The data should be freed with SDL_free().
  *
+ * If the size of the stream isn't known, the buffer starts at the size in
+ * the stream's "SDL.rwops.size_hint" property, if it's set, and grows as
+ * needed.
+ *
+ * If you only need to read a file, SDL_RWFromFileMapped() and
+ * SDL_GetRWMemory() can be used to access it without copying it at all.
+ *
  * \param src the SDL_RWops to read all available data from
  * \param datasize if not NULL, will store the number of bytes read
  * \param freesrc if SDL_TRUE, calls SDL_RWclose() on `src` before returning,
@@ -585,6 +823,11 @@ extern DECLSPEC int SDLCALL SDL_RWclose(SDL_RWops *context);
  * \returns the data, or NULL if there was an error.
  *
  * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRWMemory
+ * \sa SDL_GetRWProperties
+ * \sa SDL_LoadFile
+ * \sa SDL_RWFromFileMapped
  */
 extern DECLSPEC void *SDLCALL SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc);
 
@@ -1036,6 +1279,261 @@ extern DECLSPEC SDL_bool SDLCALL SDL_WriteS64BE(SDL_RWops *dst, Sint64 value);
 
 /* @} *//* Write endian functions */
 
+/**
+ *  \name Asynchronous I/O
+ *
+ *  Reads and writes are started with SDL_ReadAsyncIO() and
+ *  SDL_WriteAsyncIO(), which return immediately, and their results are
+ *  collected later from an SDL_AsyncIOQueue. Many tasks can be in flight at
+ *  once without a thread for each of them.
+ */
+/* @{ */
+
+/**
+ * The opaque type for a file opened for asynchronous I/O.
+ *
+ * \sa SDL_AsyncIOFromFile
+ */
+typedef struct SDL_AsyncIO SDL_AsyncIO;
+
+/**
+ * The opaque type for a queue that collects the results of asynchronous I/O
+ * tasks.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ */
+typedef struct SDL_AsyncIOQueue SDL_AsyncIOQueue;
+
+/**
+ * The kind of an asynchronous I/O task.
+ */
+typedef enum
+{
+    SDL_ASYNCIO_TASK_READ,  /**< A read started with SDL_ReadAsyncIO() */
+    SDL_ASYNCIO_TASK_WRITE, /**< A write started with SDL_WriteAsyncIO() */
+    SDL_ASYNCIO_TASK_CLOSE  /**< A close started with SDL_CloseAsyncIO() */
+} SDL_AsyncIOTaskType;
+
+/**
+ * The result of an asynchronous I/O task.
+ */
+typedef enum
+{
+    SDL_ASYNCIO_COMPLETE, /**< The task finished, reads may be short at the end of the file */
+    SDL_ASYNCIO_FAILURE   /**< The task failed */
+} SDL_AsyncIOResult;
+
+/**
+ * The outcome of a finished asynchronous I/O task.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_WaitAsyncIOResult
+ */
+typedef struct SDL_AsyncIOOutcome
+{
+    SDL_AsyncIO *asyncio;      /**< The file the task was for, invalid after a close */
+    SDL_AsyncIOTaskType type;  /**< The kind of task */
+    SDL_AsyncIOResult result;  /**< Whether the task succeeded */
+    void *buffer;              /**< The buffer that was read into or written from */
+    Uint64 offset;             /**< The offset in the file */
+    Uint64 bytes_requested;    /**< The number of bytes requested */
+    Uint64 bytes_transferred;  /**< The number of bytes actually read or written */
+    void *userdata;            /**< The pointer passed when the task was started */
+} SDL_AsyncIOOutcome;
+
+/**
+ * Use this function to open a file for asynchronous I/O.
+ *
+ * The `mode` string is the same as for SDL_RWFromFile(), except that append
+ * modes aren't supported, since every write is given an offset.
+ *
+ * Opening the file happens immediately, only reads, writes and closing the
+ * file are asynchronous.
+ *
+ * \param file a UTF-8 string representing the filename to open
+ * \param mode an ASCII string representing the mode to be used for opening
+ *             the file
+ * \returns a pointer to the SDL_AsyncIO that is created, or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseAsyncIO
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WriteAsyncIO
+ */
+extern DECLSPEC SDL_AsyncIO *SDLCALL SDL_AsyncIOFromFile(const char *file, const char *mode);
+
+/**
+ * Use this function to get the size of a file opened for asynchronous I/O.
+ *
+ * This reports the current size and doesn't wait for pending writes.
+ *
+ * \param asyncio the file to query
+ * \returns the size of the file in bytes, or a negative error code on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio);
+
+/**
+ * Start reading from a file asynchronously.
+ *
+ * This reads up to `size` bytes at `offset` into `ptr`, stopping early only
+ * at the end of the file. The buffer must remain valid until the result is
+ * collected from `queue`.
+ *
+ * \param asyncio the file to read from
+ * \param ptr a pointer to a buffer to read data into
+ * \param offset the position in the file to start reading at
+ * \param size the number of bytes to read
+ * \param queue the queue to add the result to when the read finishes
+ * \param userdata a pointer reported in the task's outcome
+ * \returns 0 if the read was started or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_WaitAsyncIOResult
+ * \sa SDL_WriteAsyncIO
+ */
+extern DECLSPEC int SDLCALL SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Start writing to a file asynchronously.
+ *
+ * This writes `size` bytes from `ptr` at `offset`. The buffer must remain
+ * valid until the result is collected from `queue`.
+ *
+ * Writes that are in flight at the same time may be done in any order.
+ *
+ * \param asyncio the file to write to
+ * \param ptr a pointer to the data to write
+ * \param offset the position in the file to start writing at
+ * \param size the number of bytes to write
+ * \param queue the queue to add the result to when the write finishes
+ * \param userdata a pointer reported in the task's outcome
+ * \returns 0 if the write was started or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC int SDLCALL SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Close a file opened for asynchronous I/O.
+ *
+ * The file is closed once all of its tasks have finished, and the result of
+ * the close is added to `queue`. No more tasks can be started for the file
+ * after this is called, and it's freed when the close finishes.
+ *
+ * \param asyncio the file to close
+ * \param queue the queue to add the result to when the file is closed
+ * \param userdata a pointer reported in the task's outcome
+ * \returns 0 if the close was started or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AsyncIOFromFile
+ */
+extern DECLSPEC int SDLCALL SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Create a queue to collect the results of asynchronous I/O tasks.
+ *
+ * A queue can collect results for any number of files, and a file's tasks
+ * can use different queues.
+ *
+ * \returns a new queue, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyAsyncIOQueue
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC SDL_AsyncIOQueue *SDLCALL SDL_CreateAsyncIOQueue(void);
+
+/**
+ * Destroy a queue of asynchronous I/O results.
+ *
+ * This waits for all the tasks using the queue to finish and throws away
+ * their results, so their buffers can be freed afterwards.
+ *
+ * \param queue the queue to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue);
+
+/**
+ * Get the result of a finished asynchronous I/O task, if there is one.
+ *
+ * This doesn't block. Results are reported once each.
+ *
+ * \param queue the queue to check
+ * \param outcome filled in with the outcome of the task
+ * \returns SDL_TRUE if a task had finished, SDL_FALSE otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome);
+
+/**
+ * Wait for an asynchronous I/O task to finish.
+ *
+ * \param queue the queue to wait on
+ * \param outcome filled in with the outcome of the task
+ * \param timeoutMS the maximum number of milliseconds to wait, or -1 to wait
+ *                  indefinitely
+ * \returns SDL_TRUE if a task finished, SDL_FALSE if the wait timed out or
+ *          the queue was signaled with SDL_SignalAsyncIOQueue().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_SignalAsyncIOQueue
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome, Sint32 timeoutMS);
+
+/**
+ * Wake up the threads waiting on a queue of asynchronous I/O results.
+ *
+ * Their calls to SDL_WaitAsyncIOResult() return SDL_FALSE, which is useful
+ * for shutting down threads that wait for results.
+ *
+ * \param queue the queue to signal
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC void SDLCALL SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue);
+
+/* @} *//* Asynchronous I/O */
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -124,6 +124,27 @@ typedef enum
  * \sa SDL_GetCurrentDisplayOrientation()
  */
 
+/**
+ * A single timestamped sensor reading, as returned by SDL_GetSensorDataBatch()
+ * and SDL_GetGamepadSensorDataBatch().
+ *
+ * Values the sensor doesn't report are set to 0.
+ */
+typedef struct SDL_SensorSample
+{
+    Uint64 timestamp;           /**< In nanoseconds, populated using SDL_GetTicksNS() */
+    Uint64 sensor_timestamp;    /**< The timestamp of the sensor reading in nanoseconds, not necessarily synchronized with the system clock */
+    float data[6];              /**< Up to 6 values from the sensor, as defined above */
+} SDL_SensorSample;
+
+/**
+ * The number of samples kept for each sensor between calls to
+ * SDL_GetSensorDataBatch() or SDL_GetGamepadSensorDataBatch().
+ *
+ * If more samples than this arrive between calls, the oldest are dropped.
+ */
+#define SDL_SENSOR_BATCH_SIZE   256
+
 /* Function prototypes */
 
 /**
@@ -260,6 +281,31 @@ extern DECLSPEC SDL_SensorID SDLCALL SDL_GetSensorInstanceID(SDL_Sensor *sensor)
  */
 extern DECLSPEC int SDLCALL SDL_GetSensorData(SDL_Sensor *sensor, float *data, int num_values);
 
+/**
+ * Get all the readings from an opened sensor since the last call.
+ *
+ * This is intended for high rate sensors, where the application wants every
+ * reading rather than the latest state, without the overhead of an event for
+ * each one. SDL_EVENT_SENSOR_UPDATE can be disabled with SDL_SetEventEnabled()
+ * while using this, the samples are collected either way.
+ *
+ * Samples are collected from the first time this is called on a sensor, and
+ * up to SDL_SENSOR_BATCH_SIZE are kept between calls. They are returned
+ * oldest first, and any that don't fit in `samples` are returned on the next
+ * call.
+ *
+ * \param sensor The SDL_Sensor object to query
+ * \param samples An array filled with the sensor readings
+ * \param num_samples The number of elements in `samples`
+ * \returns the number of samples written, or a negative error code on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetSensorData
+ */
+extern DECLSPEC int SDLCALL SDL_GetSensorDataBatch(SDL_Sensor *sensor, SDL_SensorSample *samples, int num_samples);
+
 /**
  * Close a sensor previously opened with SDL_OpenSensor().
  *
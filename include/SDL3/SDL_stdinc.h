@@ -438,6 +438,9 @@ extern DECLSPEC void SDLCALL SDL_GetMemoryFunctions(SDL_malloc_func *malloc_func
 /**
  * Replace SDL's memory allocation functions with a custom set
  *
+ * This can be used to have SDL use a thread caching allocator, which may
+ * scale better when many threads are allocating memory at the same time.
+ *
  * \param malloc_func custom malloc function
  * \param calloc_func custom calloc function
  * \param realloc_func custom realloc function
@@ -485,18 +488,284 @@ extern DECLSPEC void SDLCALL SDL_aligned_free(void *mem);
 /**
  * Get the number of outstanding (unfreed) allocations
  *
+ * Allocations are counted per thread to keep allocating fast, so this sums
+ * the counts and the result is only exact if no other threads are
+ * allocating or freeing memory at the same time.
+ *
  * \returns the number of allocations
  *
  * \since This function is available since SDL 3.0.0.
  */
 extern DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * An arena that hands out memory from large blocks and frees it all at once.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateArena
+ * \sa SDL_GetThreadArena
+ */
+typedef struct SDL_Arena SDL_Arena;
+
+/**
+ * Create an arena for short-lived allocations.
+ *
+ * Memory is bump allocated out of blocks of `block_size` bytes, and is all
+ * released together by SDL_ResetArena(). The blocks are kept for reuse, so
+ * an arena that is reset every frame stops allocating from the system once
+ * it has grown to the largest size needed.
+ *
+ * An arena is not thread-safe, it should only be used by one thread at a
+ * time.
+ *
+ * \param block_size the size of each block of memory, or 0 for a default
+ *                   size
+ * \returns a new arena or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ArenaAlloc
+ * \sa SDL_DestroyArena
+ * \sa SDL_ResetArena
+ */
+extern DECLSPEC SDL_Arena *SDLCALL SDL_CreateArena(size_t block_size);
+
+/**
+ * Allocate memory from an arena.
+ *
+ * The memory is aligned to 16 bytes and stays valid until the arena is reset
+ * past it or destroyed. It must not be passed to SDL_free().
+ *
+ * \param arena the arena to allocate from
+ * \param size the number of bytes to allocate
+ * \returns a pointer to the memory or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateArena
+ * \sa SDL_ResetArena
+ */
+extern DECLSPEC SDL_MALLOC void *SDLCALL SDL_ArenaAlloc(SDL_Arena *arena, size_t size);
+
+/**
+ * Get the current position in an arena.
+ *
+ * The position can be passed to SDL_ResetArena() later to free everything
+ * allocated after this call, while keeping earlier allocations. This allows
+ * temporary allocations to be nested.
+ *
+ * \param arena the arena to query
+ * \returns the current position in the arena
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ResetArena
+ */
+extern DECLSPEC size_t SDLCALL SDL_GetArenaMark(SDL_Arena *arena);
+
+/**
+ * Free the memory allocated from an arena after a given position.
+ *
+ * \param arena the arena to reset
+ * \param mark a position returned by SDL_GetArenaMark(), or 0 to free
+ *             everything
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ArenaAlloc
+ * \sa SDL_GetArenaMark
+ */
+extern DECLSPEC void SDLCALL SDL_ResetArena(SDL_Arena *arena, size_t mark);
+
+/**
+ * Destroy an arena and all the memory allocated from it.
+ *
+ * \param arena the arena to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateArena
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyArena(SDL_Arena *arena);
+
+/**
+ * Get the scratch arena for the current thread.
+ *
+ * Each thread has its own arena, which is created the first time this is
+ * called and destroyed when the thread exits. SDL uses it for temporary
+ * memory inside of its own functions, always resetting it to where it found
+ * it before returning, so an application can also allocate from it and call
+ * `SDL_ResetArena(SDL_GetThreadArena(), 0)` once per frame.
+ *
+ * \returns the arena for the current thread or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ArenaAlloc
+ * \sa SDL_ResetArena
+ */
+extern DECLSPEC SDL_Arena *SDLCALL SDL_GetThreadArena(void);
+
 extern DECLSPEC char *SDLCALL SDL_getenv(const char *name);
 extern DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 
 extern DECLSPEC void SDLCALL SDL_qsort(void *base, size_t nmemb, size_t size, int (SDLCALL *compare) (const void *, const void *));
 extern DECLSPEC void * SDLCALL SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size, int (SDLCALL *compare) (const void *, const void *));
 
+/**
+ * A callback used with SDL sorting and binary search functions.
+ *
+ * \param userdata the pointer passed to the sorting or search function
+ * \param a the first element being compared
+ * \param b the second element being compared
+ * \returns a negative number if `a` should come before `b`, a positive
+ *          number if it should come after, or 0 if they're equal.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_qsort_r
+ * \sa SDL_bsearch_r
+ * \sa SDL_StableSort
+ */
+typedef int (SDLCALL *SDL_CompareCallback_r)(void *userdata, const void *a, const void *b);
+
+/**
+ * Sort an array, passing a pointer to the comparison function.
+ *
+ * This is an introsort (pattern-defeating quicksort) that runs in
+ * O(n log n) time in the worst case and takes linear time on arrays that
+ * are already sorted or have many equal elements. It doesn't allocate
+ * memory, and it isn't stable; use SDL_StableSort() if equal elements need
+ * to keep their order.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the function used to compare elements
+ * \param userdata a pointer that is passed to `compare`
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_bsearch_r
+ * \sa SDL_StableSort
+ */
+extern DECLSPEC void SDLCALL SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * Find an element in a sorted array, passing a pointer to the comparison
+ * function.
+ *
+ * \param key the element to look for, passed as the first element to
+ *            `compare`
+ * \param base the array to search, sorted in the order `compare` defines
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the function used to compare elements
+ * \param userdata a pointer that is passed to `compare`
+ * \returns a pointer to a matching element, or NULL if there isn't one.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_qsort_r
+ */
+extern DECLSPEC void * SDLCALL SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * Sort an array, keeping equal elements in their original order.
+ *
+ * This is a merge sort that runs in O(n log n) time, using the thread's
+ * scratch arena for half the size of the array. If that memory isn't
+ * available, it merges in place instead, which is slower but can't fail.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the function used to compare elements
+ * \param userdata a pointer that is passed to `compare`
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetThreadArena
+ * \sa SDL_qsort_r
+ */
+extern DECLSPEC void SDLCALL SDL_StableSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * Sort an array of structures by an unsigned 32-bit integer member.
+ *
+ * This is a radix sort, which doesn't call a comparison function and runs
+ * in linear time, so it's much faster than SDL_qsort() for large arrays,
+ * like sorting sprites by a depth or material key. It's stable, so elements
+ * with equal keys keep their order.
+ *
+ * It uses the thread's scratch arena for a copy of the array, and falls
+ * back to SDL_StableSort() if that memory isn't available.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param key_offset the offset of the key in each element, usually from
+ *                   offsetof()
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SortBySint32Key
+ * \sa SDL_SortByFloatKey
+ */
+extern DECLSPEC void SDLCALL SDL_SortByUint32Key(void *base, size_t nmemb, size_t size, size_t key_offset);
+
+/**
+ * Sort an array of structures by a signed 32-bit integer member.
+ *
+ * This works like SDL_SortByUint32Key(), for signed keys.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param key_offset the offset of the key in each element, usually from
+ *                   offsetof()
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SortByUint32Key
+ */
+extern DECLSPEC void SDLCALL SDL_SortBySint32Key(void *base, size_t nmemb, size_t size, size_t key_offset);
+
+/**
+ * Sort an array of structures by a float member.
+ *
+ * This works like SDL_SortByUint32Key(), for float keys. Negative zero
+ * sorts before positive zero, and NaNs sort before or after everything
+ * else depending on their sign bit.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param key_offset the offset of the key in each element, usually from
+ *                   offsetof()
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SortByUint32Key
+ */
+extern DECLSPEC void SDLCALL SDL_SortByFloatKey(void *base, size_t nmemb, size_t size, size_t key_offset);
+
 extern DECLSPEC int SDLCALL SDL_abs(int x);
 
 /* NOTE: these double-evaluate their arguments, so you should never have side effects in the parameters */
@@ -666,6 +935,71 @@ extern DECLSPEC float SDLCALL SDL_sqrtf(float x);
 extern DECLSPEC double SDLCALL SDL_tan(double x);
 extern DECLSPEC float SDLCALL SDL_tanf(float x);
 
+/**
+ * Compute the sine and cosine of an angle at the same time.
+ *
+ * This is faster than calling SDL_sinf() and SDL_cosf(), and the results are
+ * within a few ULP of theirs.
+ *
+ * \param x the angle, in radians.
+ * \param s a pointer filled in with the sine of `x`, may be NULL.
+ * \param c a pointer filled in with the cosine of `x`, may be NULL.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_sinf_array
+ * \sa SDL_cosf_array
+ */
+extern DECLSPEC void SDLCALL SDL_sincosf(float x, float *s, float *c);
+
+/**
+ * Compute the sine of each value in an array.
+ *
+ * This uses SIMD instructions where the CPU has them, and the results are
+ * within a few ULP of SDL_sinf(). `src` and `dst` may be the same array.
+ *
+ * \param src the angles, in radians.
+ * \param dst an array of at least `count` values filled in with the results.
+ * \param count the number of values.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_cosf_array
+ * \sa SDL_sincosf
+ */
+extern DECLSPEC void SDLCALL SDL_sinf_array(const float *src, float *dst, int count);
+
+/**
+ * Compute the cosine of each value in an array.
+ *
+ * This uses SIMD instructions where the CPU has them, and the results are
+ * within a few ULP of SDL_cosf(). `src` and `dst` may be the same array.
+ *
+ * \param src the angles, in radians.
+ * \param dst an array of at least `count` values filled in with the results.
+ * \param count the number of values.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_sinf_array
+ * \sa SDL_sincosf
+ */
+extern DECLSPEC void SDLCALL SDL_cosf_array(const float *src, float *dst, int count);
+
+/**
+ * Compute e raised to the power of each value in an array.
+ *
+ * This uses SIMD instructions where the CPU has them, and the results are
+ * within a few ULP of SDL_expf(). `src` and `dst` may be the same array.
+ *
+ * \param src the exponents.
+ * \param dst an array of at least `count` values filled in with the results.
+ * \param count the number of values.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC void SDLCALL SDL_expf_array(const float *src, float *dst, int count);
+
 /* The SDL implementation of iconv() returns these error codes */
 #define SDL_ICONV_ERROR     (size_t)-1
 #define SDL_ICONV_E2BIG     (size_t)-2
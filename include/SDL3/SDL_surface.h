@@ -64,6 +64,8 @@ extern "C" {
 
 typedef struct SDL_BlitMap SDL_BlitMap;  /* this is an opaque type. */
 
+typedef struct SDL_SurfacePool SDL_SurfacePool;  /* this is an opaque type. */
+
 /**
  * A collection of pixels used in software blitting.
  *
@@ -107,6 +109,9 @@ typedef struct SDL_Surface
     /** info for fast blit mapping to other surfaces */
     SDL_BlitMap *map;           /**< Private */
 
+    /** the pool the pixels are returned to when the surface is freed */
+    SDL_SurfacePool *pool;      /**< Private */
+
     /** Reference count -- used when freeing surface */
     int refcount;               /**< Read-mostly */
 } SDL_Surface;
@@ -117,6 +122,18 @@ typedef struct SDL_Surface
 typedef int (SDLCALL *SDL_blit) (struct SDL_Surface *src, const SDL_Rect *srcrect,
                                  struct SDL_Surface *dst, const SDL_Rect *dstrect);
 
+/**
+ * The scaling mode for a texture or a scaled surface blit.
+ */
+typedef enum
+{
+    SDL_SCALEMODE_NEAREST, /**< nearest pixel sampling */
+    SDL_SCALEMODE_LINEAR,  /**< linear filtering */
+    SDL_SCALEMODE_BEST,    /**< anisotropic filtering */
+    SDL_SCALEMODE_AREA,    /**< area averaging, for high quality downscaling of surfaces; textures use linear filtering */
+    SDL_SCALEMODE_LANCZOS  /**< Lanczos-3 filtering of surfaces; textures use linear filtering */
+} SDL_ScaleMode;
+
 /**
  * The formula used for converting between YUV and RGB
  */
@@ -190,6 +207,75 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateSurfaceFrom
  */
 extern DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
 
+/**
+ * Create a pool of pixel memory for surfaces.
+ *
+ * Surfaces created with SDL_CreateSurfaceFromPool() take their pixels from
+ * the pool, and SDL_DestroySurface() gives them back to it, so creating and
+ * destroying many surfaces of the same size reuses the same memory instead
+ * of allocating and freeing it each time.
+ *
+ * These are the supported properties:
+ *
+ * - "alignment" (number) - the alignment of the pixels in bytes, a power of two, defaults to SDL_SIMDGetAlignment()
+ * - "huge_pages" (boolean) - true if pixel memory of 2 MB or more should be backed by huge pages where the operating system supports it, currently with transparent huge pages on Linux, defaults to false
+ * - "clear" (boolean) - false if the pixels of new surfaces don't need to be cleared, which is faster when they are overwritten anyway, defaults to true
+ * - "max_bytes" (number) - the most memory the pool keeps for reuse while no surface uses it, memory beyond that is freed, defaults to 64 MB
+ *
+ * The pool is safe to use from several threads at once.
+ *
+ * \param props the properties to use, or 0 for the defaults
+ * \returns the new pool or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfaceFromPool
+ * \sa SDL_DestroySurfacePool
+ */
+extern DECLSPEC SDL_SurfacePool *SDLCALL SDL_CreateSurfacePool(SDL_PropertiesID props);
+
+/**
+ * Allocate a new RGB surface with its pixels from a surface pool.
+ *
+ * This behaves like SDL_CreateSurface(), but memory kept by the pool from a
+ * surface of the same size in bytes is reused when available. The pixels are
+ * cleared unless the pool was created with the "clear" property set to
+ * false. The pixels go back to the pool when the surface
+ * is freed with SDL_DestroySurface().
+ *
+ * \param pool the pool to take the pixels from
+ * \param width the width of the surface
+ * \param height the height of the surface
+ * \param format the SDL_PixelFormatEnum for the new surface's pixel format.
+ * \returns the new SDL_Surface structure that is created or NULL if it fails;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurface
+ * \sa SDL_CreateSurfacePool
+ * \sa SDL_DestroySurface
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateSurfaceFromPool(SDL_SurfacePool *pool, int width, int height, Uint32 format);
+
+/**
+ * Destroy a surface pool.
+ *
+ * The memory the pool keeps for reuse is freed. Surfaces still using pixels
+ * from the pool stay valid, and their pixels are freed when they are
+ * destroyed.
+ *
+ * It is safe to pass NULL to this function.
+ *
+ * \param pool the pool to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfacePool
+ */
+extern DECLSPEC void SDLCALL SDL_DestroySurfacePool(SDL_SurfacePool *pool);
+
 /**
  * Get the properties associated with a surface.
  *
@@ -291,6 +377,34 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool fre
  */
 extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP(const char *file);
 
+/**
+ * Load a BMP image from memory, referencing the pixels where possible.
+ *
+ * When the image is uncompressed and stored top-down, and the pixel data
+ * is aligned to the size of a 16 or 32 bit pixel, the new surface points
+ * directly at the pixels in `mem` and is created with the SDL_PREALLOC
+ * flag, so no pixel memory is allocated or copied. Otherwise the pixels are
+ * copied into a new surface, as with SDL_LoadBMP_RW().
+ *
+ * Since the surface may reference `mem`, the memory must stay valid until
+ * the surface is destroyed, and drawing to the surface may modify it. This
+ * works well with a file that the application has mapped into memory.
+ *
+ * The new surface should be freed with SDL_DestroySurface(). Not doing so
+ * will result in a memory leak.
+ *
+ * \param mem a pointer to the BMP file data
+ * \param size the size of the BMP file data, in bytes
+ * \returns a pointer to a new SDL_Surface structure or NULL if there was an
+ *          error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroySurface
+ * \sa SDL_LoadBMP_RW
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_Mem(void *mem, size_t size);
+
 /**
  * Save a surface to a seekable SDL data stream in BMP format.
  *
@@ -335,6 +449,54 @@ extern DECLSPEC int SDLCALL SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst,
  */
 extern DECLSPEC int SDLCALL SDL_SaveBMP(SDL_Surface *surface, const char *file);
 
+/**
+ * Save the RLE encoding of a colorkeyed surface to an SDL data stream.
+ *
+ * The encoding can be loaded again with SDL_LoadRLE_RW(), which gives a
+ * surface that is ready to be blitted without encoding it again. This lets
+ * applications encode their colorkeyed sprites ahead of time.
+ *
+ * The surface needs a colorkey and a pixel format with at least 8 bits per
+ * pixel; it doesn't need to have been blitted or to have RLE acceleration
+ * enabled. The encoded data uses the byte order of the current platform and
+ * can only be loaded on platforms with the same byte order.
+ *
+ * \param surface the colorkeyed SDL_Surface structure to save
+ * \param dst a data stream to save to
+ * \param freedst if SDL_TRUE, calls SDL_RWclose() on `dst` before returning,
+ *                even in the case of an error
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LoadRLE_RW
+ * \sa SDL_SetSurfaceColorKey
+ */
+extern DECLSPEC int SDLCALL SDL_SaveRLE_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst);
+
+/**
+ * Load an RLE encoded surface saved with SDL_SaveRLE_RW().
+ *
+ * The new surface has its colorkey set and RLE acceleration enabled, and
+ * keeps its encoding when it is blitted to surfaces with the same pixel
+ * format. Locking it decodes the pixels.
+ *
+ * The new surface should be freed with SDL_DestroySurface().
+ *
+ * \param src the data stream for the surface
+ * \param freesrc if SDL_TRUE, calls SDL_RWclose() on `src` before returning,
+ *                even in the case of an error
+ * \returns a pointer to a new SDL_Surface structure or NULL if there was an
+ *          error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroySurface
+ * \sa SDL_SaveRLE_RW
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadRLE_RW(SDL_RWops *src, SDL_bool freesrc);
+
 /**
  * Set the RLE acceleration hint for a surface.
  *
@@ -677,7 +839,9 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
  *
  * This is safe to use with src == dst, but not for other overlapping areas.
  *
- * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888.
+ * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888 and
+ * SDL_PIXELFORMAT_BGRA8888.
  *
  * \param width the width of the block to convert, in pixels
  * \param height the height of the block to convert, in pixels
@@ -698,6 +862,72 @@ extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height,
                                                  Uint32 dst_format,
                                                  void *dst, int dst_pitch);
 
+/**
+ * Undo the alpha premultiplication on a block of pixels.
+ *
+ * Each color channel is divided by the alpha of its pixel and rounded to
+ * the nearest value. Fully transparent pixels become transparent black,
+ * since their color can't be recovered.
+ *
+ * This is safe to use with src == dst, but not for other overlapping areas.
+ *
+ * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888 and
+ * SDL_PIXELFORMAT_BGRA8888.
+ *
+ * \param width the width of the block to convert, in pixels
+ * \param height the height of the block to convert, in pixels
+ * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
+ * \param src a pointer to the premultiplied source pixels
+ * \param src_pitch the pitch of the source pixels, in bytes
+ * \param dst_format an SDL_PixelFormatEnum value of the `dst` pixels format
+ * \param dst a pointer to be filled in with straight alpha pixel data
+ * \param dst_pitch the pitch of the destination pixels, in bytes
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ */
+extern DECLSPEC int SDLCALL SDL_UnpremultiplyAlpha(int width, int height,
+                                                   Uint32 src_format,
+                                                   const void *src, int src_pitch,
+                                                   Uint32 dst_format,
+                                                   void *dst, int dst_pitch);
+
+/**
+ * Premultiply the alpha of a surface in place.
+ *
+ * This supports the same pixel formats as SDL_PremultiplyAlpha().
+ *
+ * \param surface the SDL_Surface structure to modify
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ * \sa SDL_UnpremultiplySurfaceAlpha
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplySurfaceAlpha(SDL_Surface *surface);
+
+/**
+ * Undo the alpha premultiplication of a surface in place.
+ *
+ * This supports the same pixel formats as SDL_UnpremultiplyAlpha().
+ *
+ * \param surface the SDL_Surface structure to modify
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplySurfaceAlpha
+ * \sa SDL_UnpremultiplyAlpha
+ */
+extern DECLSPEC int SDLCALL SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface);
+
 /**
  * Perform a fast fill of a rectangle with a specific color.
  *
@@ -822,6 +1052,38 @@ extern DECLSPEC int SDLCALL SDL_BlitSurface
     (SDL_Surface *src, const SDL_Rect *srcrect,
      SDL_Surface *dst, SDL_Rect *dstrect);
 
+/**
+ * Performs a batch of fast blits from one source surface to one destination
+ * surface.
+ *
+ * This is equivalent to calling SDL_BlitSurface() once for each pair of
+ * rectangles, but the surfaces are validated and the blit is set up only
+ * once for the whole batch, which is much cheaper when drawing many small
+ * rectangles, such as the tiles of a map.
+ *
+ * Each entry in `dstrects` is clipped and updated with the actual rectangle
+ * used, exactly as SDL_BlitSurface() does for `dstrect`.
+ *
+ * \param src the SDL_Surface structure to be copied from
+ * \param srcrects an array of `count` SDL_Rect structures representing the
+ *                 rectangles to be copied, or NULL to copy the entire
+ *                 surface for each destination rectangle
+ * \param dst the SDL_Surface structure that is the blit target
+ * \param dstrects an array of `count` SDL_Rect structures representing the x
+ *                 and y positions in the destination surface, filled in with
+ *                 the actual rectangles used after clipping
+ * \param count the number of rectangles in the arrays
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurface
+ */
+extern DECLSPEC int SDLCALL SDL_BlitSurfaces
+    (SDL_Surface *src, const SDL_Rect *srcrects,
+     SDL_Surface *dst, SDL_Rect *dstrects, int count);
+
 /**
  * Perform low-level surface blitting only.
  *
@@ -908,6 +1170,34 @@ extern DECLSPEC int SDLCALL SDL_BlitSurfaceScaled
     (SDL_Surface *src, const SDL_Rect *srcrect,
      SDL_Surface *dst, SDL_Rect *dstrect);
 
+/**
+ * Perform a scaled surface copy to a destination surface using a specific
+ * scaling filter.
+ *
+ * SDL_SCALEMODE_AREA averages every source pixel covered by each destination
+ * pixel, and SDL_SCALEMODE_LANCZOS applies a separable Lanczos-3 filter.
+ * Both avoid the aliasing of nearest and linear scaling on large downscales,
+ * such as when generating thumbnails.
+ *
+ * \param src the SDL_Surface structure to be copied from
+ * \param srcrect the SDL_Rect structure representing the rectangle to be
+ *                copied
+ * \param dst the SDL_Surface structure that is the blit target
+ * \param dstrect the SDL_Rect structure representing the target rectangle in
+ *                the destination surface, filled with the actual rectangle
+ *                used after clipping
+ * \param scaleMode the SDL_ScaleMode to be used
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurfaceScaled
+ */
+extern DECLSPEC int SDLCALL SDL_BlitSurfaceScaledWithMode
+    (SDL_Surface *src, const SDL_Rect *srcrect,
+     SDL_Surface *dst, SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+
 /**
  * Perform low-level surface scaled blitting only.
  *
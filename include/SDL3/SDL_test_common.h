@@ -91,6 +91,7 @@ typedef struct
     /* Renderer info */
     const char *renderdriver;
     Uint32 render_flags;
+    SDL_bool render_stats;
     SDL_bool skip_renderer;
     SDL_Renderer **renderers;
     SDL_Texture **targets;
@@ -122,6 +122,25 @@ char *SDLTest_GenerateRunSeed(const int length);
  */
 int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations);
 
+/**
+ * Execute one shard of the test suites using the given run seed and execution key.
+ *
+ * The suites are dealt out to the shards round-robin, so running every shard
+ * from 0 to shardCount-1, e.g. in parallel processes, runs every suite exactly once.
+ * All the tests of a suite run in the same shard.
+ *
+ * \param testSuites Suites containing the test case.
+ * \param userRunSeed Custom run seed provided by user, or NULL to autogenerate one.
+ * \param userExecKey Custom execution key provided by user, or 0 to autogenerate one.
+ * \param filter Filter specification. NULL disables. Case sensitive.
+ * \param testIterations Number of iterations to run each test case.
+ * \param shardIndex The shard to run, from 0 to shardCount-1.
+ * \param shardCount The number of shards the suites are split into.
+ *
+ * \returns the test run result: 0 when all tests passed, 1 if any tests failed.
+ */
+int SDLTest_RunSuitesShard(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations, int shardIndex, int shardCount);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -72,6 +72,21 @@ typedef enum {
     SDL_THREAD_PRIORITY_TIME_CRITICAL
 } SDL_ThreadPriority;
 
+/**
+ * The kind of work a thread does, used to pick the cores it runs on.
+ *
+ * On macOS and iOS these map to the QoS classes, on Windows they control
+ * EcoQoS power throttling, and on Linux with hybrid CPUs they restrict the
+ * thread to the matching class of cores.
+ *
+ * \sa SDL_SetThreadQoS
+ */
+typedef enum {
+    SDL_THREAD_QOS_DEFAULT,     /**< Let the system decide */
+    SDL_THREAD_QOS_BACKGROUND,  /**< Throughput work that can run slowly on efficiency cores */
+    SDL_THREAD_QOS_INTERACTIVE  /**< Latency sensitive work, such as rendering or audio, that should run on performance cores */
+} SDL_ThreadQoS;
+
 /**
  * The function passed to SDL_CreateThread().
  *
@@ -307,6 +322,44 @@ extern DECLSPEC SDL_threadID SDLCALL SDL_GetThreadID(SDL_Thread * thread);
  */
 extern DECLSPEC int SDLCALL SDL_SetThreadPriority(SDL_ThreadPriority priority);
 
+/**
+ * Set the kind of work done by the current thread.
+ *
+ * This is a hint to the scheduler about which cores the thread should run
+ * on, separate from its priority. On Linux it replaces the thread's
+ * affinity when the CPU has more than one class of cores.
+ *
+ * \param qos the SDL_ThreadQoS to set
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetThreadAffinity
+ * \sa SDL_SetThreadPriority
+ */
+extern DECLSPEC int SDLCALL SDL_SetThreadQoS(SDL_ThreadQoS qos);
+
+/**
+ * Restrict the current thread to running on a set of logical CPUs.
+ *
+ * The CPU numbers are the `cpu` field returned by SDL_GetCPUTopology().
+ *
+ * This is only supported on Linux, Android and Windows. On Windows the CPUs
+ * must be in the first 64.
+ *
+ * \param cpus an array of logical CPU numbers, or NULL to allow all CPUs
+ * \param count the number of elements in `cpus`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUTopology
+ * \sa SDL_SetThreadQoS
+ */
+extern DECLSPEC int SDLCALL SDL_SetThreadAffinity(const int *cpus, int count);
+
 /**
  * Wait for a thread to finish.
  *
@@ -439,6 +492,115 @@ extern DECLSPEC int SDLCALL SDL_SetTLS(SDL_TLSID id, const void *value, void (SD
  */
 extern DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+/**
+ * The opaque type for a pool of worker threads.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+typedef struct SDL_ThreadPool SDL_ThreadPool;
+
+/**
+ * The function type for jobs run by a thread pool.
+ *
+ * \param userdata what was passed as `userdata` to SDL_SubmitJob()
+ *
+ * \sa SDL_SubmitJob
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * A count of unfinished jobs.
+ *
+ * A counter is incremented by each job submitted with it and decremented
+ * when that job finishes, so a counter of 0 means all of its jobs are done.
+ * Counters must be zero-initialized and only changed by the thread pool,
+ * the current count can be read with SDL_AtomicGet(&counter->value).
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJobCounter
+ */
+typedef struct SDL_JobCounter
+{
+    SDL_AtomicInt value;
+} SDL_JobCounter;
+
+/**
+ * Create a pool of worker threads for running jobs.
+ *
+ * Each worker has its own queue of jobs and takes work from the other
+ * workers when its own queue runs empty, so jobs submitted from inside a
+ * job stay on the same thread unless another thread is idle.
+ *
+ * \param num_threads the number of worker threads, or 0 to use one per CPU
+ *                    core
+ * \param cpus NULL, or an array of `num_threads` CPU indices to pin each
+ *             worker thread to, -1 leaves a worker's affinity unchanged
+ * \returns the new thread pool or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyThreadPool
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC SDL_ThreadPool *SDLCALL SDL_CreateThreadPool(int num_threads, const int *cpus);
+
+/**
+ * Submit a job to a thread pool.
+ *
+ * If `dependency` is not NULL, the job doesn't start until that counter
+ * reaches 0, and the counter must remain valid until then. If `counter` is
+ * not NULL, it is incremented now and decremented when the job finishes.
+ *
+ * \param pool the thread pool to run the job on
+ * \param func the function to run
+ * \param userdata a pointer passed to `func`
+ * \param dependency NULL, or a counter of jobs that must finish first
+ * \param counter NULL, or a counter to track this job with
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from inside a job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_WaitJobCounter
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitJob(SDL_ThreadPool *pool, SDL_JobFunction func, void *userdata, SDL_JobCounter *dependency, SDL_JobCounter *counter);
+
+/**
+ * Wait for all the jobs tracked by a counter to finish.
+ *
+ * The calling thread runs queued jobs from the pool while it waits, so this
+ * can be called from inside a job without tying up a worker.
+ *
+ * \param pool the thread pool running the jobs
+ * \param counter the counter to wait for
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from inside a job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJobCounter(SDL_ThreadPool *pool, SDL_JobCounter *counter);
+
+/**
+ * Destroy a thread pool.
+ *
+ * This waits for all the submitted jobs to finish, and must not be called
+ * from inside one of the pool's jobs.
+ *
+ * \param pool the thread pool to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyThreadPool(SDL_ThreadPool *pool);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
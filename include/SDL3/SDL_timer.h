@@ -124,6 +124,23 @@ extern DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
  */
 extern DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
 
+/**
+ * Wait a specified number of nanoseconds before returning, with high
+ * accuracy.
+ *
+ * This function sleeps for most of the requested time and then busy waits
+ * for the last part of it, so it wakes up much closer to the requested time
+ * than SDL_DelayNS() at the cost of some extra CPU usage. This is useful
+ * for frame limiters and other code that needs sub-millisecond accuracy.
+ *
+ * \param ns the number of nanoseconds to delay
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DelayNS
+ */
+extern DECLSPEC void SDLCALL SDL_DelayPrecise(Uint64 ns);
+
 /**
  * Function prototype for the timer callback function.
  *
@@ -134,6 +151,15 @@ extern DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
  */
 typedef Uint32 (SDLCALL *SDL_TimerCallback)(Uint32 interval, void *param);
 
+/**
+ * Function prototype for the nanosecond timer callback function.
+ *
+ * The callback function is passed the current timer interval and returns
+ * the next timer interval, in nanoseconds. If the callback returns 0, the
+ * periodic alarm is cancelled.
+ */
+typedef Uint64 (SDLCALL *SDL_NSTimerCallback)(Uint64 interval, void *param);
+
 /**
  * Definition of the timer ID type.
  */
@@ -176,7 +202,33 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
                                                  void *param);
 
 /**
- * Remove a timer created with SDL_AddTimer().
+ * Call a callback function at a future time, with nanosecond precision.
+ *
+ * This works like SDL_AddTimer(), except that the interval passed to and
+ * returned from the callback is in nanoseconds, so timers can run faster
+ * than once a millisecond.
+ *
+ * The callback is run on a separate thread, and timing may still be inexact
+ * due to OS scheduling.
+ *
+ * \param interval the timer delay, in nanoseconds, passed to `callback`
+ * \param callback the SDL_NSTimerCallback function to call when the
+ *                 specified `interval` elapses
+ * \param param a pointer that is passed to `callback`
+ * \returns a timer ID or 0 if an error occurs; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_RemoveTimer
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_NSTimerCallback callback,
+                                                   void *param);
+
+/**
+ * Remove a timer created with SDL_AddTimer() or SDL_AddTimerNS().
  *
  * \param id the ID of the timer to remove
  * \returns SDL_TRUE if the timer is removed or SDL_FALSE if the timer wasn't
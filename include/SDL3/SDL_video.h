@@ -341,6 +341,15 @@ extern DECLSPEC SDL_DisplayID SDLCALL SDL_GetPrimaryDisplay(void);
 /**
  * Get the properties associated with a display.
  *
+ * The following read-only properties are provided by SDL, on drivers that
+ * can report them:
+ *
+ * ```
+ * "SDL.display.vrr_capable" (boolean) - true if the display supports variable refresh rate (adaptive sync)
+ * "SDL.display.vrr_min_refresh_rate" (float) - the lowest refresh rate the display can run at with variable refresh rate
+ * "SDL.display.vrr_max_refresh_rate" (float) - the highest refresh rate the display can run at with variable refresh rate
+ * ```
+ *
  * \param displayID the instance ID of the display to query
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -820,6 +829,7 @@ extern DECLSPEC SDL_Window *SDLCALL SDL_CreatePopupWindow(SDL_Window *parent, in
  * - "transparent" (string) - true if the window show transparent in the areas with alpha of 0
  * - "tooltip" (boolean) - true if the window is a tooltip
  * - "utility" (boolean) - true if the window is a utility window, not showing in the task bar and window list
+ * - "variable-refresh-rate" (boolean) - true if the window should be shown with variable refresh rate (adaptive sync) where the display supports it, see SDL_SetWindowVariableRefreshRate()
  * - "vulkan" (string) - true if the window will be used with Vulkan rendering
  * - "width" (number) - the width of the window
  * - "x" (number) - the x position of the window, or `SDL_WINDOWPOS_CENTERED`, defaults to `SDL_WINDOWPOS_UNDEFINED`. This is relative to the parent for windows with the "parent" property set.
@@ -924,6 +934,27 @@ extern DECLSPEC SDL_Window *SDLCALL SDL_GetWindowParent(SDL_Window *window);
  * "SDL.window.kmsdrm.dev_index" (number) - the device index associated with the window (e.g. the X in /dev/dri/cardX)
  * "SDL.window.kmsdrm.drm_fd" (number) - the DRM FD associated with the window
  * "SDL.window.kmsdrm.gbm_dev" (pointer) - the GBM device associated with the window
+ * "SDL.window.kmsdrm.overlay.active" (boolean) - true if the last page flip put the overlay dmabuf on screen
+ * ```
+ *
+ * On KMS/DRM with atomic modesetting, an app can also set these properties
+ * to have a dmabuf, such as a decoded video frame, scanned out on an overlay
+ * plane in the same commit as each frame of the window, without being drawn
+ * by the GPU. They are read at every page flip, and the overlay is turned
+ * off once "SDL.window.kmsdrm.overlay.fd0" is cleared. The app must keep the
+ * buffer unchanged while it may be on screen, that is until the next buffer
+ * has been flipped in. Overlay planes are usually stacked above the window
+ * contents. If the display has no overlay plane that can show the buffer,
+ * the window is shown without it.
+ *
+ * ```
+ * "SDL.window.kmsdrm.overlay.fd0" through "SDL.window.kmsdrm.overlay.fd3" (number) - the dmabuf file descriptors of each plane, in memory order
+ * "SDL.window.kmsdrm.overlay.offset0" through "SDL.window.kmsdrm.overlay.offset3" (number) - the byte offset of each plane in its dmabuf, defaults to 0
+ * "SDL.window.kmsdrm.overlay.pitch0" through "SDL.window.kmsdrm.overlay.pitch3" (number) - the pitch in bytes of each plane
+ * "SDL.window.kmsdrm.overlay.format" (number) - the DRM fourcc of the dmabuf, e.g. NV12
+ * "SDL.window.kmsdrm.overlay.modifier" (number) - the DRM format modifier of the dmabuf, defaults to an implicit modifier
+ * "SDL.window.kmsdrm.overlay.width" and "SDL.window.kmsdrm.overlay.height" (number) - the size of the dmabuf in pixels
+ * "SDL.window.kmsdrm.overlay.x", "SDL.window.kmsdrm.overlay.y", "SDL.window.kmsdrm.overlay.w" and "SDL.window.kmsdrm.overlay.h" (number) - where to show it on the display, defaults to the whole display
  * ```
  *
  * On macOS:
@@ -980,6 +1011,14 @@ extern DECLSPEC SDL_Window *SDLCALL SDL_GetWindowParent(SDL_Window *window);
  * "SDL.window.x11.window" (number) - the X11 Window associated with the window
  * ```
  *
+ * On the offscreen driver, for windows created with SDL_WINDOW_OPENGL:
+ *
+ * ```
+ * "SDL.window.offscreen.egl_display" (pointer) - the EGLDisplay associated with the window
+ * "SDL.window.offscreen.egl_config" (pointer) - the EGLConfig of the window's surface
+ * "SDL.window.offscreen.egl_surface" (pointer) - the EGL pbuffer surface the window renders to
+ * ```
+ *
  * \param window the window to query
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -1734,6 +1773,35 @@ extern DECLSPEC int SDLCALL SDL_SetWindowInputFocus(SDL_Window *window);
  */
 extern DECLSPEC int SDLCALL SDL_SetWindowFocusable(SDL_Window *window, SDL_bool focusable);
 
+/**
+ * Set whether the window is shown with variable refresh rate.
+ *
+ * With variable refresh rate (also known as adaptive sync, FreeSync or
+ * G-Sync), the display refreshes when a new frame is presented instead of at
+ * a fixed rate, within the range given by the display's
+ * "SDL.display.vrr_min_refresh_rate" and "SDL.display.vrr_max_refresh_rate"
+ * properties. This removes judder when the frame rate doesn't match the
+ * refresh rate, and lets applications render only as fast as they need to.
+ *
+ * The request is only a hint to the system: it takes effect when the
+ * display is capable of variable refresh rate, and on some platforms only
+ * while the window is fullscreen.
+ *
+ * This is currently supported on X11 and KMSDRM.
+ *
+ * \param window the window to change
+ * \param enabled SDL_TRUE to enable variable refresh rate, SDL_FALSE to
+ *                use the display's fixed refresh rate
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetDisplayProperties
+ * \sa SDL_CreateWindowWithProperties
+ */
+extern DECLSPEC int SDLCALL SDL_SetWindowVariableRefreshRate(SDL_Window *window, SDL_bool enabled);
+
 
 /**
  * Display the system-level window menu.
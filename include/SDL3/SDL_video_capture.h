@@ -100,13 +100,31 @@ typedef enum
  */
 typedef struct SDL_VideoCaptureFrame
 {
-    Uint64 timestampNS;         /**< Frame timestamp in nanoseconds when read from the driver */
+    Uint64 timestampNS;         /**< Frame timestamp in nanoseconds, in the SDL_GetTicksNS() timebase. This is when the frame was captured if the driver reports it, otherwise when it was read from the driver */
+    Uint64 sequence;            /**< Frame sequence number, skipping the frames that were dropped by the driver */
     int num_planes;             /**< Number of planes */
     Uint8 *data[3];             /**< Pointer to data of i-th plane */
     int pitch[3];               /**< Pitch of i-th plane */
     void *internal;             /**< Private field */
 } SDL_VideoCaptureFrame;
 
+/**
+ * The function prototype for frame notifications.
+ *
+ * This is called from the video capture thread each time a frame (or an
+ * acquisition error) is queued, so it's safe to call
+ * SDL_AcquireVideoCaptureFrame() afterwards and get it. Keep it short: the
+ * next frame isn't read from the device until this returns.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetVideoCaptureFrameCallback()
+ * \param device the video capture device with a frame ready
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetVideoCaptureFrameCallback
+ */
+typedef void (SDLCALL *SDL_VideoCaptureFrameCallback)(void *userdata, SDL_VideoCaptureDevice *device);
 
 /**
  * Get a list of currently connected video capture devices.
@@ -301,6 +319,53 @@ extern DECLSPEC SDL_VideoCaptureStatus SDLCALL SDL_GetVideoCaptureStatus(SDL_Vid
  */
 extern DECLSPEC int SDLCALL SDL_StartVideoCapture(SDL_VideoCaptureDevice *device);
 
+/**
+ * Get the properties associated with a video capture device.
+ *
+ * The following read-only properties are updated as frames are captured:
+ *
+ * ```
+ * "SDL.video_capture.frames_captured" (number) - the number of frames read from the driver
+ * "SDL.video_capture.frames_dropped_driver" (number) - the number of frames the driver dropped, found from gaps in the frame sequence numbers
+ * "SDL.video_capture.frames_dropped_queue" (number) - the number of frames SDL dropped because the application didn't acquire them in time
+ * "SDL.video_capture.latency_ns" (number) - the time between the capture of the last frame and when it was queued for the application
+ * ```
+ *
+ * The time a frame spends on its way to the screen can be measured by
+ * comparing its `timestampNS` to SDL_GetTicksNS().
+ *
+ * \param device opened video capture device
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetProperty
+ */
+extern DECLSPEC SDL_PropertiesID SDLCALL SDL_GetVideoCaptureProperties(SDL_VideoCaptureDevice *device);
+
+/**
+ * Set a callback to be notified when a frame is ready.
+ *
+ * Frames are read from the device on a dedicated thread that sleeps until
+ * the device has one, so this lets an application wait for frames instead of
+ * calling SDL_AcquireVideoCaptureFrame() in a loop. A common approach is to
+ * push a user event from the callback.
+ *
+ * \param device opened video capture device
+ * \param callback the function to call, or NULL to disable notifications
+ * \param userdata a pointer that is passed to `callback`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireVideoCaptureFrame
+ */
+extern DECLSPEC int SDLCALL SDL_SetVideoCaptureFrameCallback(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrameCallback callback, void *userdata);
+
 /**
  * Acquire a frame.
  *
@@ -324,6 +389,58 @@ extern DECLSPEC int SDLCALL SDL_StartVideoCapture(SDL_VideoCaptureDevice *device
  */
 extern DECLSPEC int SDLCALL SDL_AcquireVideoCaptureFrame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrame *frame);
 
+/**
+ * Get the properties associated with an acquired frame.
+ *
+ * Frames may have these timing properties, when the platform reports them:
+ *
+ * ```
+ * "SDL.video_capture.frame.device_timestamp_ns" (number) - the time the frame was captured, on the device's own clock
+ * "SDL.video_capture.frame.duration_ns" (number) - how long the frame is displayed for
+ * ```
+ *
+ * The device timestamp comes from the V4L2 buffer on Linux (usually
+ * CLOCK_MONOTONIC), the CMSampleBuffer presentation time on Apple platforms
+ * and the camera sensor on Android. It is not in the SDL_GetTicksNS()
+ * timebase; use the frame's timestampNS for that. The duration is only
+ * available on Apple platforms. On Android, timestampNS is derived from the
+ * sensor time only when the camera reports realtime timestamps, and is the
+ * acquisition time otherwise.
+ *
+ * On Linux, frames of devices that can export their buffers with
+ * VIDIOC_EXPBUF also have these properties:
+ *
+ * ```
+ * "SDL.video_capture.frame.dmabuf_fd" (number) - the dmabuf file descriptor of the frame buffer
+ * ```
+ *
+ * along with the properties needed to create an opengles2 texture that
+ * samples the frame without a copy, so they can be passed straight to
+ * SDL_CreateTextureWithProperties(): "format", "width", "height",
+ * "opengles2.dmabuf.fd0", "opengles2.dmabuf.offset0",
+ * "opengles2.dmabuf.pitch0" and "opengles2.dmabuf.format".
+ *
+ * The driver has a small set of buffers that it fills in turn, and the
+ * properties of each one stay the same for as long as the device is open,
+ * so an application can create one texture per property ID and reuse it.
+ * The texture shows the buffer's current contents, so it should only be
+ * drawn while the frame is acquired.
+ *
+ * Frames that SDL decodes itself, such as MJPEG frames converted to a raw
+ * format, have no properties.
+ *
+ * \param device opened video capture device
+ * \param frame a frame obtained with SDL_AcquireVideoCaptureFrame()
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireVideoCaptureFrame
+ * \sa SDL_CreateTextureWithProperties
+ */
+extern DECLSPEC SDL_PropertiesID SDLCALL SDL_GetVideoCaptureFrameProperties(SDL_VideoCaptureDevice *device, const SDL_VideoCaptureFrame *frame);
+
 /**
  * Release a frame.
  *
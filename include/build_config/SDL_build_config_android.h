@@ -138,6 +138,8 @@
 #define HAVE_SIGACTION 1
 #define HAVE_SETJMP 1
 #define HAVE_NANOSLEEP  1
+#define HAVE_MMAP 1
+#define HAVE_PREAD 1
 #define HAVE_SYSCONF    1
 #define HAVE_CLOCK_GETTIME  1
 
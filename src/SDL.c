@@ -42,10 +42,14 @@
 #include "audio/SDL_sysaudio.h"
 #include "video/SDL_video_c.h"
 #include "events/SDL_events_c.h"
+#include "file/SDL_asyncio_c.h"
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_gamepad_c.h"
 #include "joystick/SDL_joystick_c.h"
+#include "power/SDL_power_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "thread/SDL_lockprofile.h"
+#include "SDL_trace_c.h"
 
 /* Initialization/Cleanup routines */
 #ifndef SDL_TIMERS_DISABLED
@@ -175,9 +179,19 @@ void SDL_SetMainReady(void)
     SDL_MainIsReady = SDL_TRUE;
 }
 
+/* Private helper to report how long each subsystem took to start up */
+static void SDL_LogInitTime(const char *subsystem, Uint64 start)
+{
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_SYSTEM, "%s subsystem initialized in %.2f ms",
+                 subsystem, (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
 int SDL_InitSubSystem(Uint32 flags)
 {
     Uint32 flags_initialized = 0;
+    Uint64 start;
 
     if (!SDL_MainIsReady) {
         return SDL_SetError("Application didn't initialize properly, did you include SDL_main.h in the file containing your main() function?");
@@ -190,9 +204,7 @@ int SDL_InitSubSystem(Uint32 flags)
     /* Clear the error message */
     SDL_ClearError();
 
-#ifdef SDL_USE_LIBDBUS
-    SDL_DBus_Init();
-#endif
+    /* D-Bus isn't connected here, it's done the first time something needs it */
 
 #ifdef SDL_VIDEO_DRIVER_WINDOWS
     if (flags & (SDL_INIT_HAPTIC | SDL_INIT_JOYSTICK)) {
@@ -211,10 +223,12 @@ int SDL_InitSubSystem(Uint32 flags)
 #ifndef SDL_EVENTS_DISABLED
         if (SDL_ShouldInitSubsystem(SDL_INIT_EVENTS)) {
             SDL_IncrementSubsystemRefCount(SDL_INIT_EVENTS);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitEvents() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_EVENTS);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Events", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_EVENTS);
         }
@@ -230,10 +244,12 @@ int SDL_InitSubSystem(Uint32 flags)
 #if !defined(SDL_TIMERS_DISABLED) && !defined(SDL_TIMER_DUMMY)
         if (SDL_ShouldInitSubsystem(SDL_INIT_TIMER)) {
             SDL_IncrementSubsystemRefCount(SDL_INIT_TIMER);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitTimers() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_TIMER);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Timers", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_TIMER);
         }
@@ -254,10 +270,12 @@ int SDL_InitSubSystem(Uint32 flags)
             }
 
             SDL_IncrementSubsystemRefCount(SDL_INIT_VIDEO);
+            start = SDL_GetPerformanceCounter();
             if (SDL_VideoInit(NULL) < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_VIDEO);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Video", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_VIDEO);
         }
@@ -278,10 +296,12 @@ int SDL_InitSubSystem(Uint32 flags)
             }
 
             SDL_IncrementSubsystemRefCount(SDL_INIT_AUDIO);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitAudio(NULL) < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_AUDIO);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Audio", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_AUDIO);
         }
@@ -302,10 +322,12 @@ int SDL_InitSubSystem(Uint32 flags)
             }
 
             SDL_IncrementSubsystemRefCount(SDL_INIT_JOYSTICK);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitJoysticks() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_JOYSTICK);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Joysticks", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_JOYSTICK);
         }
@@ -325,10 +347,12 @@ int SDL_InitSubSystem(Uint32 flags)
             }
 
             SDL_IncrementSubsystemRefCount(SDL_INIT_GAMEPAD);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitGamepads() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_GAMEPAD);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Gamepads", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_GAMEPAD);
         }
@@ -344,10 +368,12 @@ int SDL_InitSubSystem(Uint32 flags)
 #ifndef SDL_HAPTIC_DISABLED
         if (SDL_ShouldInitSubsystem(SDL_INIT_HAPTIC)) {
             SDL_IncrementSubsystemRefCount(SDL_INIT_HAPTIC);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitHaptics() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_HAPTIC);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Haptics", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_HAPTIC);
         }
@@ -363,10 +389,12 @@ int SDL_InitSubSystem(Uint32 flags)
 #ifndef SDL_SENSOR_DISABLED
         if (SDL_ShouldInitSubsystem(SDL_INIT_SENSOR)) {
             SDL_IncrementSubsystemRefCount(SDL_INIT_SENSOR);
+            start = SDL_GetPerformanceCounter();
             if (SDL_InitSensors() < 0) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_SENSOR);
                 goto quit_and_error;
             }
+            SDL_LogInitTime("Sensors", start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_SENSOR);
         }
@@ -397,7 +425,9 @@ void SDL_QuitSubSystem(Uint32 flags)
 #ifndef SDL_SENSOR_DISABLED
     if (flags & SDL_INIT_SENSOR) {
         if (SDL_ShouldQuitSubsystem(SDL_INIT_SENSOR)) {
+            SDL_LockInputThread();
             SDL_QuitSensors();
+            SDL_UnlockInputThread();
         }
         SDL_DecrementSubsystemRefCount(SDL_INIT_SENSOR);
     }
@@ -415,7 +445,9 @@ void SDL_QuitSubSystem(Uint32 flags)
 
     if (flags & SDL_INIT_JOYSTICK) {
         if (SDL_ShouldQuitSubsystem(SDL_INIT_JOYSTICK)) {
+            SDL_LockInputThread();
             SDL_QuitJoysticks();
+            SDL_UnlockInputThread();
             /* joystick implies events */
             SDL_QuitSubSystem(SDL_INIT_EVENTS);
         }
@@ -512,6 +544,12 @@ void SDL_Quit(void)
     SDL_HelperWindowDestroy();
 #endif
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
+    SDL_QuitAsyncIO();
+    SDL_QuitBlitThreads();
+    SDL_QuitBlitMapCache();
+    SDL_QuitPowerInfo();
+    SDL_QuitLockProfiling();
+    SDL_QuitTracing();
 
 #ifndef SDL_TIMERS_DISABLED
     SDL_QuitTicks();
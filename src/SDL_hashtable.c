@@ -21,17 +21,28 @@
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
 
+// This is an open addressing table using Robin Hood hashing: an item being
+// inserted takes the slot of any item that is closer to its home slot, which
+// keeps probe sequences short even when the table is mostly full. Removing an
+// item shifts the following items back, so there are no tombstones.
+//
+// Items with the same key in a stackable table are kept together, newest first,
+// so lookups find the latest insert like the old chained table did.
+
 typedef struct SDL_HashItem
 {
     const void *key;
     const void *value;
-    struct SDL_HashItem *next;
+    Uint32 hash;
+    Uint32 probe_len;  // 0 if this slot is empty, otherwise the distance from the home slot plus one.
 } SDL_HashItem;
 
 struct SDL_HashTable
 {
-    SDL_HashItem **table;
+    SDL_HashItem *table;
     Uint32 table_len;
+    Uint32 num_items;
+    Uint32 max_load;  // the number of items before the table grows
     SDL_bool stackable;
     void *data;
     SDL_HashTable_HashFn hash;
@@ -39,6 +50,14 @@ struct SDL_HashTable
     SDL_HashTable_NukeFn nuke;
 };
 
+// The largest table, so sizes and probe lengths can't overflow.
+#define SDL_HASHTABLE_MAX_LEN 0x40000000u
+
+static SDL_INLINE Uint32 calc_max_load(Uint32 table_len)
+{
+    return table_len - (table_len / 4);  // grow at 75% full
+}
+
 SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
                                    const SDL_HashTable_KeyMatchFn keymatchfn,
                                    const SDL_HashTable_NukeFn nukefn,
@@ -47,7 +66,7 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
     SDL_HashTable *table;
 
     // num_buckets must be a power of two so we get a solid block of bits to mask hash values against.
-    if ((num_buckets == 0) || ((num_buckets & (num_buckets - 1)) != 0)) {
+    if ((num_buckets == 0) || ((num_buckets & (num_buckets - 1)) != 0) || (num_buckets > SDL_HASHTABLE_MAX_LEN)) {
         SDL_SetError("num_buckets must be a power of two");
         return NULL;
     }
@@ -58,7 +77,7 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
         return NULL;
     }
 
-    table->table = (SDL_HashItem **) SDL_calloc(num_buckets, sizeof (SDL_HashItem *));
+    table->table = (SDL_HashItem *) SDL_calloc(num_buckets, sizeof (SDL_HashItem));
     if (!table->table) {
         SDL_free(table);
         SDL_OutOfMemory();
@@ -66,6 +85,7 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
     }
 
     table->table_len = num_buckets;
+    table->max_load = calc_max_load(num_buckets);
     table->stackable = stackable;
     table->data = data;
     table->hash = hashfn;
@@ -76,89 +96,199 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    return table->hash(key, table->data) & (table->table_len - 1);
+    // Mix the bits, since IDs often differ only in their upper bits and linear probing is sensitive to clustering.
+    Uint32 hash = table->hash(key, table->data) * 0x9E3779B1u;
+    return hash ^ (hash >> 16);
 }
 
+static SDL_INLINE Uint32 get_home_slot(const SDL_HashTable *table, Uint32 hash)
+{
+    return hash & (table->table_len - 1);
+}
 
-SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
+// Put an item in its place, moving aside any items that are closer to their home slots.
+// If the item is newer than the ones already in the table, it also goes in front of
+// any items with the same key.
+static void place_item(SDL_HashTable *table, SDL_HashItem item, SDL_bool newest)
 {
-    SDL_HashItem *item;
-    const Uint32 hash = calc_hash(table, key);
+    const Uint32 mask = table->table_len - 1;
+    Uint32 idx = get_home_slot(table, item.hash);
+
+    item.probe_len = 1;
+    for (;;) {
+        SDL_HashItem *slot = &table->table[idx];
+        if (slot->probe_len == 0) {
+            *slot = item;
+            return;
+        }
+        if (slot->probe_len < item.probe_len ||
+            (newest && table->stackable && slot->probe_len == item.probe_len &&
+             slot->hash == item.hash && table->keymatch(item.key, slot->key, table->data))) {
+            const SDL_HashItem displaced = *slot;
+            *slot = item;
+            item = displaced;
+            // Items are already stored newest first, so the displaced one goes in front of the rest of its key.
+            newest = SDL_TRUE;
+        }
+        idx = (idx + 1) & mask;
+        item.probe_len++;
+    }
+}
 
-    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
+static SDL_bool grow_table(SDL_HashTable *table)
+{
+    const Uint32 old_len = table->table_len;
+    SDL_HashItem *old_table = table->table;
+    SDL_HashItem *new_table;
+    Uint32 start, i;
+
+    if (old_len >= SDL_HASHTABLE_MAX_LEN) {
         return SDL_FALSE;
     }
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
-    item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
-    if (!item) {
-        SDL_OutOfMemory();
+    new_table = (SDL_HashItem *) SDL_calloc(old_len * 2, sizeof (SDL_HashItem));
+    if (!new_table) {
         return SDL_FALSE;
     }
 
-    item->key = key;
-    item->value = value;
-    item->next = table->table[hash];
-    table->table[hash] = item;
+    table->table = new_table;
+    table->table_len = old_len * 2;
+    table->max_load = calc_max_load(table->table_len);
 
+    // Start where no run of items wraps in from the end of the table, so we move
+    // items in order and each one goes after those with the same key we've already moved.
+    for (start = 0; start < old_len; start++) {
+        if (old_table[start].probe_len <= 1) {
+            break;
+        }
+    }
+    for (i = 0; i < old_len; i++) {
+        const SDL_HashItem *item = &old_table[(start + i) & (old_len - 1)];
+        if (item->probe_len) {
+            place_item(table, *item, SDL_FALSE);
+        }
+    }
+    SDL_free(old_table);
     return SDL_TRUE;
 }
 
-SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
+// Find the slot holding the first match for a key, or NULL.
+static SDL_HashItem *find_item(const SDL_HashTable *table, const void *key, Uint32 hash, Uint32 idx, Uint32 probe_len)
 {
-    const Uint32 hash = calc_hash(table, key);
+    const Uint32 mask = table->table_len - 1;
     void *data = table->data;
-    SDL_HashItem *i;
 
-    for (i = table->table[hash]; i; i = i->next) {
-        if (table->keymatch(key, i->key, data)) {
-            if (_value) {
-                *_value = i->value;
-            }
-            return SDL_TRUE;
+    for (;;) {
+        SDL_HashItem *slot = &table->table[idx];
+
+        // Once we reach an item closer to its home than we are to ours, our key can't be further along.
+        if (slot->probe_len < probe_len) {
+            return NULL;
+        }
+        if (slot->hash == hash && table->keymatch(key, slot->key, data)) {
+            return slot;
         }
+        idx = (idx + 1) & mask;
+        probe_len++;
     }
+}
 
-    return SDL_FALSE;
+SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
+{
+    SDL_HashItem item;
+
+    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
+        return SDL_FALSE;
+    }
+
+    // grow and rehash the table if it gets too saturated, it can fill up completely if that fails.
+    if (table->num_items >= table->max_load) {
+        if (!grow_table(table) && (table->num_items == table->table_len)) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+    }
+
+    item.key = key;
+    item.value = value;
+    item.hash = calc_hash(table, key);
+    item.probe_len = 0;
+    place_item(table, item, SDL_TRUE);
+    table->num_items++;
+
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
+{
+    const Uint32 hash = calc_hash(table, key);
+    const SDL_HashItem *item = find_item(table, key, hash, get_home_slot(table, hash), 1);
+
+    if (!item) {
+        return SDL_FALSE;
+    }
+    if (_value) {
+        *_value = item->value;
+    }
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
+    const Uint32 mask = table->table_len - 1;
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = NULL;
-    SDL_HashItem *prev = NULL;
-    void *data = table->data;
+    SDL_HashItem *item = find_item(table, key, hash, get_home_slot(table, hash), 1);
+    const void *removed_key;
+    const void *removed_value;
+    Uint32 idx;
 
-    for (item = table->table[hash]; item; item = item->next) {
-        if (table->keymatch(key, item->key, data)) {
-            if (prev) {
-                prev->next = item->next;
-            } else {
-                table->table[hash] = item->next;
-            }
+    if (!item) {
+        return SDL_FALSE;
+    }
 
-            table->nuke(item->key, item->value, data);
-            SDL_free(item);
-            return SDL_TRUE;
-        }
+    removed_key = item->key;
+    removed_value = item->value;
+    table->num_items--;
 
-        prev = item;
+    // Shift the items after this one back a slot, until one is already in its home slot.
+    idx = (Uint32)(item - table->table);
+    for (;;) {
+        SDL_HashItem *next = &table->table[(idx + 1) & mask];
+        if (next->probe_len <= 1) {
+            break;
+        }
+        table->table[idx] = *next;
+        table->table[idx].probe_len--;
+        idx = (idx + 1) & mask;
     }
+    SDL_zero(table->table[idx]);
 
-    return SDL_FALSE;
+    // Nuke last, the item is unlinked and the callback may change this table.
+    table->nuke(removed_key, removed_value, table->data);
+
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = *iter ? ((SDL_HashItem *) *iter)->next : table->table[calc_hash(table, key)];
+    const Uint32 mask = table->table_len - 1;
+    const Uint32 hash = calc_hash(table, key);
+    const Uint32 home = get_home_slot(table, hash);
+    const SDL_HashItem *item;
+
+    if (*iter) {
+        // Carry on from the slot after the last match.
+        const Uint32 idx = (Uint32)((const SDL_HashItem *) *iter - table->table);
+        const Uint32 next = (idx + 1) & mask;
+        item = find_item(table, key, hash, next, ((next - home) & mask) + 1);
+    } else {
+        item = find_item(table, key, hash, home, 1);
+    }
 
-    while (item) {
-        if (table->keymatch(key, item->key, table->data)) {
-            *_value = item->value;
-            *iter = item;
-            return SDL_TRUE;
-        }
-        item = item->next;
+    if (item) {
+        *_value = item->value;
+        *iter = (void *) item;
+        return SDL_TRUE;
     }
 
     // no more matches.
@@ -169,47 +299,28 @@ SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, co
 
 SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = (SDL_HashItem *) *iter;
-    Uint32 idx = 0;
+    Uint32 idx = *iter ? (Uint32)((const SDL_HashItem *) *iter - table->table) + 1 : 0;
 
-    if (item) {
-        const SDL_HashItem *orig = item;
-        item = item->next;
-        if (!item) {
-            idx = calc_hash(table, orig->key) + 1;  // !!! FIXME: we probably shouldn't rehash each time.
+    while (idx < table->table_len) {
+        const SDL_HashItem *item = &table->table[idx];
+        if (item->probe_len) {
+            *_key = item->key;
+            *_value = item->value;
+            *iter = (void *) item;
+            return SDL_TRUE;
         }
+        idx++;  // skip empty slots...
     }
 
-    while (!item && (idx < table->table_len)) {
-        item = table->table[idx++];  // skip empty buckets...
-    }
-
-    if (!item) {  // no more matches?
-        *_key = NULL;
-        *iter = NULL;
-        return SDL_FALSE;
-    }
-
-    *_key = item->key;
-    *_value = item->value;
-    *iter = item;
-
-    return SDL_TRUE;
+    // no more matches.
+    *_key = NULL;
+    *iter = NULL;
+    return SDL_FALSE;
 }
 
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    if (table) {
-        Uint32 i;
-
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            if (item) {
-                return SDL_FALSE;
-            }
-        }
-    }
-    return SDL_TRUE;
+    return (!table || table->num_items == 0);
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
@@ -219,12 +330,9 @@ void SDL_DestroyHashTable(SDL_HashTable *table)
         Uint32 i;
 
         for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            while (item) {
-                SDL_HashItem *next = item->next;
+            const SDL_HashItem *item = &table->table[i];
+            if (item->probe_len) {
                 table->nuke(item->key, item->value, data);
-                SDL_free(item);
-                item = next;
             }
         }
 
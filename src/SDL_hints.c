@@ -21,9 +21,12 @@
 #include "SDL_internal.h"
 
 #include "SDL_hints_c.h"
+#include "SDL_hashtable.h"
 
-/* Assuming there aren't many hints set and they aren't being queried in
-   critical performance paths, we'll just use linked lists here.
+/* Hints are queried in performance critical paths, so they're kept in a hash
+   table, and the value of each hint is cached along with its parsed boolean
+   and integer values. The cache is invalidated whenever a hint or the
+   environment changes, which is rare.
  */
 typedef struct SDL_HintWatch
 {
@@ -39,9 +42,160 @@ typedef struct SDL_Hint
     SDL_HintPriority priority;
     SDL_HintWatch *callbacks;
     struct SDL_Hint *next;
+
+    /* These are up to date if version matches the hints version */
+    Uint32 version;
+    char *env_value;
+    const char *current_value;
+    SDL_bool boolean_valid;
+    SDL_bool boolean_value;
+    SDL_bool integer_valid;
+    int integer_value;
 } SDL_Hint;
 
 static SDL_Hint *SDL_hints;
+static SDL_HashTable *SDL_hints_table;
+static SDL_SpinLock SDL_hints_lock; /* Protects SDL_hints_table and the cached values */
+static SDL_AtomicInt SDL_hints_version;
+
+Uint32 SDL_GetHintsVersion(void)
+{
+    return (Uint32)SDL_AtomicGet(&SDL_hints_version);
+}
+
+void SDL_MarkHintsChanged(void)
+{
+    SDL_AtomicIncRef(&SDL_hints_version);
+}
+
+static void SDL_NukeHint(const void *key, const void *value, void *data)
+{
+    /* Hints are owned by the SDL_hints list */
+}
+
+static SDL_Hint *SDL_FindHintLocked(const char *name)
+{
+    SDL_Hint *hint = NULL;
+
+    if (SDL_hints_table) {
+        SDL_FindInHashTable(SDL_hints_table, name, (const void **)&hint);
+    }
+    return hint;
+}
+
+static SDL_Hint *SDL_CreateHintLocked(const char *name)
+{
+    SDL_Hint *hint;
+
+    if (!SDL_hints_table) {
+        SDL_hints_table = SDL_CreateHashTable(NULL, 64, SDL_HashString, SDL_KeyMatchString, SDL_NukeHint, SDL_FALSE);
+        if (!SDL_hints_table) {
+            return NULL;
+        }
+    }
+
+    hint = (SDL_Hint *)SDL_calloc(1, sizeof(*hint));
+    if (!hint) {
+        return NULL;
+    }
+    hint->name = SDL_strdup(name);
+    if (!hint->name || !SDL_InsertIntoHashTable(SDL_hints_table, hint->name, hint)) {
+        SDL_free(hint->name);
+        SDL_free(hint);
+        return NULL;
+    }
+    hint->priority = SDL_HINT_DEFAULT;
+    hint->version = SDL_GetHintsVersion() - 1;
+    hint->next = SDL_hints;
+    SDL_hints = hint;
+    return hint;
+}
+
+static SDL_Hint *SDL_FindHint(const char *name)
+{
+    SDL_Hint *hint;
+
+    SDL_AtomicLock(&SDL_hints_lock);
+    hint = SDL_FindHintLocked(name);
+    SDL_AtomicUnlock(&SDL_hints_lock);
+
+    return hint;
+}
+
+static SDL_Hint *SDL_CreateHint(const char *name)
+{
+    SDL_Hint *hint;
+
+    SDL_AtomicLock(&SDL_hints_lock);
+    hint = SDL_FindHintLocked(name);
+    if (!hint) {
+        hint = SDL_CreateHintLocked(name);
+    }
+    SDL_AtomicUnlock(&SDL_hints_lock);
+
+    if (!hint) {
+        SDL_OutOfMemory();
+    }
+    return hint;
+}
+
+static void SDL_UpdateHintCacheLocked(SDL_Hint *hint)
+{
+    const Uint32 version = SDL_GetHintsVersion();
+    const char *env;
+    const char *value;
+
+    if (hint->version == version) {
+        return;
+    }
+
+    /* SDL_getenv() may use a shared buffer, so keep a copy, and keep the old
+       one if it hasn't changed, since callers may still be using it. */
+    env = SDL_getenv(hint->name);
+    if (!env || !hint->env_value || SDL_strcmp(env, hint->env_value) != 0) {
+        SDL_free(hint->env_value);
+        hint->env_value = env ? SDL_strdup(env) : NULL;
+    }
+
+    if (!hint->env_value || hint->priority == SDL_HINT_OVERRIDE) {
+        value = hint->value;
+    } else {
+        value = hint->env_value;
+    }
+    hint->current_value = value;
+
+    hint->boolean_valid = (value && *value);
+    hint->boolean_value = SDL_GetStringBoolean(value, SDL_FALSE);
+    hint->integer_valid = (value && (*value == '-' || SDL_isdigit(*value) ||
+                                     SDL_strcasecmp(value, "false") == 0 ||
+                                     SDL_strcasecmp(value, "true") == 0));
+    hint->integer_value = SDL_GetStringInteger(value, 0);
+
+    hint->version = version;
+}
+
+/* Get a hint with up to date cached values, adding it if it doesn't exist
+   so the environment is only checked again if something changes. */
+static SDL_Hint *SDL_GetHintEntry(const char *name)
+{
+    SDL_Hint *hint;
+
+    if (!name) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&SDL_hints_lock);
+    hint = SDL_FindHintLocked(name);
+    if (!hint) {
+        hint = SDL_CreateHintLocked(name);
+    }
+    if (hint) {
+        SDL_UpdateHintCacheLocked(hint);
+    }
+    SDL_AtomicUnlock(&SDL_hints_lock);
+
+    return hint;
+}
 
 SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriority priority)
 {
@@ -58,42 +212,42 @@ SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPr
         return SDL_FALSE;
     }
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
+    hint = SDL_FindHint(name);
+    if (hint) {
+        if (priority < hint->priority) {
+            return SDL_FALSE;
+        }
+        if (hint->value != value &&
+            (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
+            char *old_value = hint->value;
+
+            hint->value = value ? SDL_strdup(value) : NULL;
+            hint->priority = priority;
+            SDL_MarkHintsChanged();
+            for (entry = hint->callbacks; entry;) {
+                /* Save the next entry in case this one is deleted */
+                SDL_HintWatch *next = entry->next;
+                entry->callback(entry->userdata, name, old_value, value);
+                entry = next;
             }
-            if (hint->value != value &&
-                (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
-                char *old_value = hint->value;
-
-                hint->value = value ? SDL_strdup(value) : NULL;
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, old_value, value);
-                    entry = next;
-                }
-                if (old_value) {
-                    SDL_free(old_value);
-                }
+            if (old_value) {
+                SDL_free(old_value);
             }
+        } else if (hint->priority != priority) {
             hint->priority = priority;
-            return SDL_TRUE;
+            SDL_MarkHintsChanged();
         }
+        return SDL_TRUE;
     }
 
     /* Couldn't find the hint, add a new one */
-    hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
+    hint = SDL_CreateHint(name);
     if (!hint) {
         return SDL_FALSE;
     }
-    hint->name = SDL_strdup(name);
     hint->value = value ? SDL_strdup(value) : NULL;
     hint->priority = priority;
-    hint->callbacks = NULL;
-    hint->next = SDL_hints;
-    SDL_hints = hint;
+    SDL_MarkHintsChanged();
     return SDL_TRUE;
 }
 
@@ -107,26 +261,27 @@ SDL_bool SDL_ResetHint(const char *name)
         return SDL_FALSE;
     }
 
+    hint = SDL_FindHint(name);
+    if (!hint) {
+        return SDL_FALSE;
+    }
+
     env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if ((!env && hint->value) ||
-                (env && !hint->value) ||
-                (env && SDL_strcmp(env, hint->value) != 0)) {
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, env);
-                    entry = next;
-                }
-            }
-            SDL_free(hint->value);
-            hint->value = NULL;
-            hint->priority = SDL_HINT_DEFAULT;
-            return SDL_TRUE;
+    if ((!env && hint->value) ||
+        (env && !hint->value) ||
+        (env && SDL_strcmp(env, hint->value) != 0)) {
+        for (entry = hint->callbacks; entry;) {
+            /* Save the next entry in case this one is deleted */
+            SDL_HintWatch *next = entry->next;
+            entry->callback(entry->userdata, name, hint->value, env);
+            entry = next;
         }
     }
-    return SDL_FALSE;
+    SDL_free(hint->value);
+    hint->value = NULL;
+    hint->priority = SDL_HINT_DEFAULT;
+    SDL_MarkHintsChanged();
+    return SDL_TRUE;
 }
 
 void SDL_ResetHints(void)
@@ -151,6 +306,7 @@ void SDL_ResetHints(void)
         hint->value = NULL;
         hint->priority = SDL_HINT_DEFAULT;
     }
+    SDL_MarkHintsChanged();
 }
 
 SDL_bool SDL_SetHint(const char *name, const char *value)
@@ -160,19 +316,11 @@ SDL_bool SDL_SetHint(const char *name, const char *value)
 
 const char *SDL_GetHint(const char *name)
 {
-    const char *env;
-    SDL_Hint *hint;
-
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (!env || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
+    SDL_Hint *hint = SDL_GetHintEntry(name);
+    if (!hint) {
+        return name ? SDL_getenv(name) : NULL;
     }
-    return env;
+    return hint->current_value;
 }
 
 int SDL_GetStringInteger(const char *value, int default_value)
@@ -205,8 +353,20 @@ SDL_bool SDL_GetStringBoolean(const char *value, SDL_bool default_value)
 
 SDL_bool SDL_GetHintBoolean(const char *name, SDL_bool default_value)
 {
-    const char *hint = SDL_GetHint(name);
-    return SDL_GetStringBoolean(hint, default_value);
+    SDL_Hint *hint = SDL_GetHintEntry(name);
+    if (!hint) {
+        return SDL_GetStringBoolean(SDL_GetHint(name), default_value);
+    }
+    return hint->boolean_valid ? hint->boolean_value : default_value;
+}
+
+int SDL_GetHintInteger(const char *name, int default_value)
+{
+    SDL_Hint *hint = SDL_GetHintEntry(name);
+    if (!hint) {
+        return SDL_GetStringInteger(SDL_GetHint(name), default_value);
+    }
+    return hint->integer_valid ? hint->integer_value : default_value;
 }
 
 int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
@@ -231,29 +391,14 @@ int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userd
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
-    }
+    hint = SDL_FindHint(name);
     if (!hint) {
         /* Need to add a hint entry for this watcher */
-        hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
+        hint = SDL_CreateHint(name);
         if (!hint) {
             SDL_free(entry);
-            return SDL_OutOfMemory();
-        }
-        hint->name = SDL_strdup(name);
-        if (!hint->name) {
-            SDL_free(entry);
-            SDL_free(hint);
-            return SDL_OutOfMemory();
+            return -1;
         }
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
-        hint->callbacks = NULL;
-        hint->next = SDL_hints;
-        SDL_hints = hint;
     }
 
     /* Add it to the callbacks for this hint */
@@ -271,22 +416,20 @@ void SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *user
     SDL_Hint *hint;
     SDL_HintWatch *entry, *prev;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
+    hint = SDL_FindHint(name);
+    if (hint) {
+        prev = NULL;
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                if (prev) {
+                    prev->next = entry->next;
+                } else {
+                    hint->callbacks = entry->next;
                 }
-                prev = entry;
+                SDL_free(entry);
+                break;
             }
-            return;
+            prev = entry;
         }
     }
 }
@@ -296,12 +439,18 @@ void SDL_ClearHints(void)
     SDL_Hint *hint;
     SDL_HintWatch *entry;
 
+    SDL_AtomicLock(&SDL_hints_lock);
+    SDL_DestroyHashTable(SDL_hints_table);
+    SDL_hints_table = NULL;
+    SDL_AtomicUnlock(&SDL_hints_lock);
+
     while (SDL_hints) {
         hint = SDL_hints;
         SDL_hints = hint->next;
 
         SDL_free(hint->name);
         SDL_free(hint->value);
+        SDL_free(hint->env_value);
         for (entry = hint->callbacks; entry;) {
             SDL_HintWatch *freeable = entry;
             entry = entry->next;
@@ -309,4 +458,5 @@ void SDL_ClearHints(void)
         }
         SDL_free(hint);
     }
+    SDL_MarkHintsChanged();
 }
@@ -27,5 +27,12 @@
 
 extern SDL_bool SDL_GetStringBoolean(const char *value, SDL_bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
+extern int SDL_GetHintInteger(const char *name, int default_value);
+
+/* This changes whenever any hint or the environment changes, so values derived
+   from hints can be cached until it does.
+ */
+extern Uint32 SDL_GetHintsVersion(void);
+extern void SDL_MarkHintsChanged(void);
 
 #endif /* SDL_hints_c_h_ */
@@ -53,6 +53,12 @@
         SDL_free(ptr);               \
     }
 
+/* Temporary memory from the thread's scratch arena, everything allocated after
+   SDL_scratch_mark() is released by SDL_scratch_free() before returning to the app */
+#define SDL_scratch_mark()             SDL_GetArenaMark(SDL_GetThreadArena())
+#define SDL_scratch_alloc(type, count) ((type *)SDL_ArenaAlloc(SDL_GetThreadArena(), sizeof(type) * (count)))
+#define SDL_scratch_free(mark)         SDL_ResetArena(SDL_GetThreadArena(), (mark))
+
 #include "build_config/SDL_build_config.h"
 
 #include "dynapi/SDL_dynapi.h"
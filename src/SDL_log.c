@@ -37,10 +37,17 @@
 #endif
 
 #include "stdlib/SDL_vacopy.h"
+#include "thread/SDL_systhread.h"
 
 /* The size of the stack buffer to use for rendering log messages. */
 #define SDL_MAX_LOG_MESSAGE_STACK 256
 
+/* How many categories have their priority cached */
+#define SDL_LOG_PRIORITY_CACHE_SIZE 64
+
+/* How many messages can be waiting for the log thread, must be a power of two */
+#define SDL_LOG_QUEUE_SIZE 1024
+
 #define DEFAULT_PRIORITY             SDL_LOG_PRIORITY_ERROR
 #define DEFAULT_ASSERT_PRIORITY      SDL_LOG_PRIORITY_WARN
 #define DEFAULT_APPLICATION_PRIORITY SDL_LOG_PRIORITY_INFO
@@ -53,6 +60,13 @@ typedef struct SDL_LogLevel
     struct SDL_LogLevel *next;
 } SDL_LogLevel;
 
+typedef struct SDL_QueuedLogMessage
+{
+    int category;
+    SDL_LogPriority priority;
+    char *message;
+} SDL_QueuedLogMessage;
+
 /* The default log output function */
 static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message);
 
@@ -65,6 +79,16 @@ static SDL_LogOutputFunction SDL_log_function = SDL_LogOutput;
 static void *SDL_log_userdata = NULL;
 static SDL_Mutex *log_function_mutex = NULL;
 
+/* The priority of the most commonly used categories, or 0 if it needs to be looked up */
+static Uint8 SDL_log_priority_cache[SDL_LOG_PRIORITY_CACHE_SIZE];
+
+/* Messages being passed to the log thread, if SDL_HINT_LOG_ASYNC is set */
+static SDL_MPMCQueue *SDL_log_queue;
+static SDL_Semaphore *SDL_log_queue_sem;
+static SDL_Thread *SDL_log_thread;
+static SDL_AtomicInt SDL_log_thread_quit;
+static SDL_AtomicInt SDL_log_messages_dropped;
+
 #ifdef HAVE_GCC_DIAGNOSTIC_PRAGMA
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -110,16 +134,110 @@ static int SDL_android_priority[SDL_NUM_LOG_PRIORITIES] = {
 };
 #endif /* __ANDROID__ */
 
+static void SDL_WriteLogMessage(int category, SDL_LogPriority priority, const char *message)
+{
+    SDL_LockMutex(log_function_mutex);
+    if (SDL_log_function) {
+        SDL_log_function(SDL_log_userdata, category, priority, message);
+    }
+    SDL_UnlockMutex(log_function_mutex);
+}
+
+static void SDL_FlushLogQueue(SDL_MPMCQueue *queue)
+{
+    SDL_QueuedLogMessage entry;
+    int dropped;
+
+    while (SDL_DequeueMPMC(queue, &entry)) {
+        SDL_WriteLogMessage(entry.category, entry.priority, entry.message);
+        SDL_free(entry.message);
+    }
+
+    dropped = SDL_AtomicSet(&SDL_log_messages_dropped, 0);
+    if (dropped > 0) {
+        char message[64];
+
+        (void)SDL_snprintf(message, sizeof(message), "%d log messages were dropped", dropped);
+        SDL_WriteLogMessage(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_WARN, message);
+    }
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    SDL_MPMCQueue *queue = (SDL_MPMCQueue *)data;
+
+    while (!SDL_AtomicGet(&SDL_log_thread_quit)) {
+        SDL_WaitSemaphore(SDL_log_queue_sem);
+        SDL_FlushLogQueue(queue);
+    }
+    return 0;
+}
+
+static void SDL_StartLogThread(void)
+{
+    SDL_MPMCQueue *queue = SDL_CreateMPMCQueue(SDL_LOG_QUEUE_SIZE, sizeof(SDL_QueuedLogMessage));
+
+    if (!queue) {
+        /* Just keep logging synchronously */
+        return;
+    }
+
+    SDL_log_queue_sem = SDL_CreateSemaphore(0);
+    if (SDL_log_queue_sem) {
+        SDL_AtomicSet(&SDL_log_thread_quit, 0);
+        SDL_log_thread = SDL_CreateThreadInternal(SDL_LogThread, "SDLLog", 0, queue);
+    }
+    if (!SDL_log_thread) {
+        if (SDL_log_queue_sem) {
+            SDL_DestroySemaphore(SDL_log_queue_sem);
+            SDL_log_queue_sem = NULL;
+        }
+        SDL_DestroyMPMCQueue(queue);
+        return;
+    }
+
+    SDL_log_queue = queue;
+}
+
+static void SDL_StopLogThread(void)
+{
+    SDL_MPMCQueue *queue = SDL_log_queue;
+
+    if (!SDL_log_thread) {
+        return;
+    }
+
+    /* Anything logged from here on is written out directly */
+    SDL_log_queue = NULL;
+
+    SDL_AtomicSet(&SDL_log_thread_quit, 1);
+    SDL_PostSemaphore(SDL_log_queue_sem);
+    SDL_WaitThread(SDL_log_thread, NULL);
+    SDL_log_thread = NULL;
+
+    /* Write out whatever was queued after the thread's last look */
+    SDL_FlushLogQueue(queue);
+
+    SDL_DestroyMPMCQueue(queue);
+    SDL_DestroySemaphore(SDL_log_queue_sem);
+    SDL_log_queue_sem = NULL;
+}
+
 void SDL_InitLog(void)
 {
     if (!log_function_mutex) {
         /* if this fails we'll try to continue without it. */
         log_function_mutex = SDL_CreateMutex();
     }
+
+    if (!SDL_log_thread && SDL_GetHintBoolean(SDL_HINT_LOG_ASYNC, SDL_FALSE)) {
+        SDL_StartLogThread();
+    }
 }
 
 void SDL_QuitLog(void)
 {
+    SDL_StopLogThread();
     SDL_LogResetPriorities();
     if (log_function_mutex) {
         SDL_DestroyMutex(log_function_mutex);
@@ -137,12 +255,16 @@ void SDL_LogSetAllPriority(SDL_LogPriority priority)
     SDL_default_priority = priority;
     SDL_assert_priority = priority;
     SDL_application_priority = priority;
+
+    SDL_zeroa(SDL_log_priority_cache);
 }
 
 void SDL_LogSetPriority(int category, SDL_LogPriority priority)
 {
     SDL_LogLevel *entry;
 
+    SDL_zeroa(SDL_log_priority_cache);
+
     for (entry = SDL_loglevels; entry; entry = entry->next) {
         if (entry->category == category) {
             entry->priority = priority;
@@ -160,7 +282,7 @@ void SDL_LogSetPriority(int category, SDL_LogPriority priority)
     }
 }
 
-SDL_LogPriority SDL_LogGetPriority(int category)
+static SDL_LogPriority SDL_LookupLogPriority(int category)
 {
     SDL_LogLevel *entry;
 
@@ -181,6 +303,21 @@ SDL_LogPriority SDL_LogGetPriority(int category)
     }
 }
 
+SDL_LogPriority SDL_LogGetPriority(int category)
+{
+    SDL_LogPriority priority;
+
+    if (category >= 0 && category < SDL_LOG_PRIORITY_CACHE_SIZE) {
+        priority = (SDL_LogPriority)SDL_log_priority_cache[category];
+        if (!priority) {
+            priority = SDL_LookupLogPriority(category);
+            SDL_log_priority_cache[category] = (Uint8)priority;
+        }
+        return priority;
+    }
+    return SDL_LookupLogPriority(category);
+}
+
 void SDL_LogResetPriorities(void)
 {
     SDL_LogLevel *entry;
@@ -195,6 +332,8 @@ void SDL_LogResetPriorities(void)
     SDL_assert_priority = DEFAULT_ASSERT_PRIORITY;
     SDL_application_priority = DEFAULT_APPLICATION_PRIORITY;
     SDL_test_priority = DEFAULT_TEST_PRIORITY;
+
+    SDL_zeroa(SDL_log_priority_cache);
 }
 
 void SDL_Log(SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
@@ -341,9 +480,28 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
         }
     }
 
-    SDL_LockMutex(log_function_mutex);
-    SDL_log_function(SDL_log_userdata, category, priority, message);
-    SDL_UnlockMutex(log_function_mutex);
+    if (SDL_log_queue) {
+        /* Hand the message to the log thread, it owns the copy from here on */
+        SDL_QueuedLogMessage entry;
+
+        entry.category = category;
+        entry.priority = priority;
+        if (message != stack_buf) {
+            entry.message = message;
+        } else {
+            entry.message = SDL_strdup(message);
+        }
+        if (entry.message && SDL_EnqueueMPMC(SDL_log_queue, &entry)) {
+            SDL_PostSemaphore(SDL_log_queue_sem);
+        } else {
+            /* The log thread is falling behind, don't wait for it */
+            SDL_free(entry.message);
+            SDL_AtomicIncRef(&SDL_log_messages_dropped);
+        }
+        return;
+    }
+
+    SDL_WriteLogMessage(category, priority, message);
 
     /* Free only if dynamically allocated */
     if (message != stack_buf) {
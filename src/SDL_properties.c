@@ -24,6 +24,17 @@
 #include "SDL_properties_c.h"
 
 
+/* Property names are interned, so the property tables can use the key pointer
+   for comparisons and the hash doesn't have to be recalculated on lookup.
+   Keys are never freed until SDL_QuitProperties().
+ */
+struct SDL_PropertyKey
+{
+    const char *name;
+    Uint32 hash;
+    /* The name follows */
+};
+
 typedef struct
 {
     SDL_PropertyType type;
@@ -42,21 +53,36 @@ typedef struct
     void *userdata;
 } SDL_Property;
 
-typedef struct
+typedef struct SDL_Properties
 {
+    SDL_AtomicInt id; /* 0 if this isn't in use */
     SDL_HashTable *props;
-    SDL_Mutex *lock;
+    SDL_RWLock *lock;
+    void *owner; /* The thread holding the lock for writing */
+    int lock_depth;
+    struct SDL_Properties *next_free;
 } SDL_Properties;
 
+/* Properties are looked up on every get and set, so recently used ones are
+   kept in a cache that can be read without taking the global lock.
+   Properties objects are recycled rather than freed until SDL_QuitProperties(),
+   so a stale cache entry still points at valid memory, and checking its ID
+   tells us whether it's the one we want.
+ */
+#define SDL_PROPERTIES_CACHE_SIZE 256
+
+static SDL_HashTable *SDL_property_keys;
+static SDL_RWLock *SDL_property_keys_lock;
 static SDL_HashTable *SDL_properties;
 static SDL_Mutex *SDL_properties_lock;
 static SDL_PropertiesID SDL_last_properties_id;
 static SDL_PropertiesID SDL_global_properties;
+static void *SDL_properties_cache[SDL_PROPERTIES_CACHE_SIZE];
+static SDL_Properties *SDL_properties_freelist;
 
 
-static void SDL_FreeProperty(const void *key, const void *value, void *data)
+static void SDL_CleanupPropertyValue(SDL_Property *property)
 {
-    SDL_Property *property = (SDL_Property *)value;
     if (property) {
         switch (property->type) {
         case SDL_PROPERTY_TYPE_POINTER:
@@ -74,28 +100,184 @@ static void SDL_FreeProperty(const void *key, const void *value, void *data)
             SDL_free(property->string_storage);
         }
     }
-    SDL_free((void *)key);
+}
+
+/* Several threads may format the string for a property at the same time while
+   holding the read lock, so the first one to finish wins and the rest use its copy.
+ */
+static const char *SDL_GetPropertyStringStorage(SDL_Property *property)
+{
+    return (const char *)SDL_AtomicGetPtr((void **)&property->string_storage);
+}
+
+static const char *SDL_SetPropertyStringStorage(SDL_Property *property, char *string, const char *default_value)
+{
+    if (!string) {
+        SDL_OutOfMemory();
+        return default_value;
+    }
+    if (!SDL_AtomicCASPtr((void **)&property->string_storage, NULL, string)) {
+        SDL_free(string);
+    }
+    return SDL_GetPropertyStringStorage(property);
+}
+
+static void SDL_FreeProperty(const void *key, const void *value, void *data)
+{
+    SDL_CleanupPropertyValue((SDL_Property *)value);
+    SDL_free((void *)value);
+}
+
+static Uint32 SDL_HashPropertyKey(const void *key, void *unused)
+{
+    return ((const SDL_PropertyKey *)key)->hash;
+}
+
+static SDL_bool SDL_KeyMatchPropertyKey(const void *a, const void *b, void *unused)
+{
+    return (a == b);
+}
+
+static void SDL_FreePropertyKey(const void *key, const void *value, void *data)
+{
     SDL_free((void *)value);
 }
 
+static const SDL_PropertyKey *SDL_FindPropertyKey(const char *name)
+{
+    const SDL_PropertyKey *key = NULL;
+
+    if (!SDL_property_keys) {
+        return NULL;
+    }
+
+    SDL_LockRWLockForReading(SDL_property_keys_lock);
+    SDL_FindInHashTable(SDL_property_keys, name, (const void **)&key);
+    SDL_UnlockRWLock(SDL_property_keys_lock);
+
+    return key;
+}
+
+/* Find the key for a property that should already exist, setting an error if it doesn't */
+static const SDL_PropertyKey *SDL_GetExistingPropertyKey(SDL_PropertiesID props, const char *name)
+{
+    const SDL_PropertyKey *key;
+
+    if (!props) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return NULL;
+    }
+
+    key = SDL_FindPropertyKey(name);
+    if (!key) {
+        SDL_SetError("Couldn't find property named %s", name);
+    }
+    return key;
+}
+
 static void SDL_FreeProperties(const void *key, const void *value, void *data)
 {
     SDL_Properties *properties = (SDL_Properties *)value;
     if (properties) {
+        SDL_AtomicSet(&properties->id, 0);
         if (properties->props) {
             SDL_DestroyHashTable(properties->props);
             properties->props = NULL;
         }
         if (properties->lock) {
-            SDL_DestroyMutex(properties->lock);
+            SDL_DestroyRWLock(properties->lock);
             properties->lock = NULL;
         }
-        SDL_free(properties);
+
+        /* The cache may still point at this, so keep it around for reuse */
+        SDL_LockMutex(SDL_properties_lock);
+        properties->next_free = SDL_properties_freelist;
+        SDL_properties_freelist = properties;
+        SDL_UnlockMutex(SDL_properties_lock);
+    }
+}
+
+static SDL_Properties *SDL_GetPropertiesObject(SDL_PropertiesID props)
+{
+    void **slot = &SDL_properties_cache[props % SDL_PROPERTIES_CACHE_SIZE];
+    SDL_Properties *properties;
+
+    properties = (SDL_Properties *)SDL_AtomicGetPtr(slot);
+    if (properties && (SDL_PropertiesID)SDL_AtomicGet(&properties->id) == props) {
+        return properties;
+    }
+
+    properties = NULL;
+    SDL_LockMutex(SDL_properties_lock);
+    if (SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties)) {
+        SDL_AtomicSetPtr(slot, properties);
+    }
+    SDL_UnlockMutex(SDL_properties_lock);
+
+    return properties;
+}
+
+/* The write lock is recursive, so the application can hold it with
+   SDL_LockProperties() while it gets and sets properties, and readers
+   don't lock if this thread is already holding it.
+ */
+static SDL_bool SDL_PropertiesOwnedByThisThread(SDL_Properties *properties)
+{
+    return SDL_AtomicGetPtr(&properties->owner) == (void *)(uintptr_t)SDL_ThreadID();
+}
+
+static void SDL_LockPropertiesForReading(SDL_Properties *properties)
+{
+    if (!SDL_PropertiesOwnedByThisThread(properties)) {
+        SDL_LockRWLockForReading(properties->lock);
+    }
+}
+
+static void SDL_UnlockPropertiesForReading(SDL_Properties *properties)
+{
+    if (!SDL_PropertiesOwnedByThisThread(properties)) {
+        SDL_UnlockRWLock(properties->lock);
+    }
+}
+
+static void SDL_LockPropertiesForWriting(SDL_Properties *properties)
+{
+    if (!SDL_PropertiesOwnedByThisThread(properties)) {
+        SDL_LockRWLockForWriting(properties->lock);
+        SDL_AtomicSetPtr(&properties->owner, (void *)(uintptr_t)SDL_ThreadID());
+    }
+    ++properties->lock_depth;
+}
+
+static void SDL_UnlockPropertiesForWriting(SDL_Properties *properties)
+{
+    if (!SDL_PropertiesOwnedByThisThread(properties)) {
+        return;
+    }
+    if (--properties->lock_depth == 0) {
+        SDL_AtomicSetPtr(&properties->owner, NULL);
+        SDL_UnlockRWLock(properties->lock);
     }
 }
 
 int SDL_InitProperties(void)
 {
+    if (!SDL_property_keys_lock) {
+        SDL_property_keys_lock = SDL_CreateRWLock();
+        if (!SDL_property_keys_lock) {
+            return -1;
+        }
+    }
+    if (!SDL_property_keys) {
+        SDL_property_keys = SDL_CreateHashTable(NULL, 64, SDL_HashString, SDL_KeyMatchString, SDL_FreePropertyKey, SDL_FALSE);
+        if (!SDL_property_keys) {
+            return -1;
+        }
+    }
     if (!SDL_properties_lock) {
         SDL_properties_lock = SDL_CreateMutex();
         if (!SDL_properties_lock) {
@@ -121,10 +303,75 @@ void SDL_QuitProperties(void)
         SDL_DestroyHashTable(SDL_properties);
         SDL_properties = NULL;
     }
+    SDL_zeroa(SDL_properties_cache);
+    while (SDL_properties_freelist) {
+        SDL_Properties *properties = SDL_properties_freelist;
+        SDL_properties_freelist = properties->next_free;
+        SDL_free(properties);
+    }
     if (SDL_properties_lock) {
         SDL_DestroyMutex(SDL_properties_lock);
         SDL_properties_lock = NULL;
     }
+    if (SDL_property_keys) {
+        SDL_DestroyHashTable(SDL_property_keys);
+        SDL_property_keys = NULL;
+    }
+    if (SDL_property_keys_lock) {
+        SDL_DestroyRWLock(SDL_property_keys_lock);
+        SDL_property_keys_lock = NULL;
+    }
+}
+
+const SDL_PropertyKey *SDL_GetPropertyKey(const char *name)
+{
+    const SDL_PropertyKey *key;
+    SDL_PropertyKey *new_key;
+    size_t length;
+
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return NULL;
+    }
+
+    if (SDL_InitProperties() < 0) {
+        return NULL;
+    }
+
+    key = SDL_FindPropertyKey(name);
+    if (key) {
+        return key;
+    }
+
+    SDL_LockRWLockForWriting(SDL_property_keys_lock);
+    if (!SDL_FindInHashTable(SDL_property_keys, name, (const void **)&key)) {
+        length = SDL_strlen(name) + 1;
+        new_key = (SDL_PropertyKey *)SDL_malloc(sizeof(*new_key) + length);
+        if (new_key) {
+            SDL_memcpy(new_key + 1, name, length);
+            new_key->name = (const char *)(new_key + 1);
+            new_key->hash = SDL_HashString(new_key->name, NULL);
+            if (SDL_InsertIntoHashTable(SDL_property_keys, new_key->name, new_key)) {
+                key = new_key;
+            } else {
+                SDL_free(new_key);
+            }
+        } else {
+            SDL_OutOfMemory();
+        }
+    }
+    SDL_UnlockRWLock(SDL_property_keys_lock);
+
+    return key;
+}
+
+const char *SDL_GetPropertyKeyName(const SDL_PropertyKey *key)
+{
+    if (!key) {
+        SDL_InvalidParamError("key");
+        return NULL;
+    }
+    return key->name;
 }
 
 SDL_PropertiesID SDL_GetGlobalProperties(void)
@@ -141,27 +388,35 @@ SDL_PropertiesID SDL_CreateProperties(void)
     SDL_Properties *properties = NULL;
     SDL_bool inserted = SDL_FALSE;
 
-    if (!SDL_properties && SDL_InitProperties() < 0) {
+    if (SDL_InitProperties() < 0) {
         return 0;
     }
 
-    properties = SDL_calloc(1, sizeof(*properties));
+    SDL_LockMutex(SDL_properties_lock);
+    properties = SDL_properties_freelist;
+    if (properties) {
+        SDL_properties_freelist = properties->next_free;
+    }
+    SDL_UnlockMutex(SDL_properties_lock);
+
     if (!properties) {
-        goto error;
+        properties = SDL_calloc(1, sizeof(*properties));
+        if (!properties) {
+            SDL_OutOfMemory();
+            return 0;
+        }
     }
-    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, SDL_FALSE);
+    properties->owner = NULL;
+    properties->lock_depth = 0;
+    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashPropertyKey, SDL_KeyMatchPropertyKey, SDL_FreeProperty, SDL_FALSE);
     if (!properties->props) {
         goto error;
     }
-    properties->lock = SDL_CreateMutex();
+    properties->lock = SDL_CreateRWLock();
     if (!properties->lock) {
         goto error;
     }
 
-    if (SDL_InitProperties() < 0) {
-        goto error;
-    }
-
     SDL_LockMutex(SDL_properties_lock);
     ++SDL_last_properties_id;
     if (SDL_last_properties_id == 0) {
@@ -169,6 +424,8 @@ SDL_PropertiesID SDL_CreateProperties(void)
     }
     props = SDL_last_properties_id;
     if (SDL_InsertIntoHashTable(SDL_properties, (const void *)(uintptr_t)props, properties)) {
+        SDL_AtomicSet(&properties->id, (int)props);
+        SDL_AtomicSetPtr(&SDL_properties_cache[props % SDL_PROPERTIES_CACHE_SIZE], properties);
         inserted = SDL_TRUE;
     }
     SDL_UnlockMutex(SDL_properties_lock);
@@ -191,15 +448,13 @@ int SDL_LockProperties(SDL_PropertiesID props)
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     return 0;
 }
 
@@ -211,20 +466,19 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         return;
     }
 
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 }
 
 static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
+    const SDL_PropertyKey *key;
     int result = 0;
 
     if (!props) {
@@ -236,27 +490,44 @@ static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_
         return SDL_InvalidParamError("name");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_FreeProperty(NULL, property, NULL);
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    if (property) {
+        key = SDL_GetPropertyKey(name);
+        if (!key) {
+            SDL_FreeProperty(NULL, property, NULL);
+            return -1;
+        }
+    } else {
+        key = SDL_FindPropertyKey(name);
+        if (!key) {
+            /* This property was never set, so there's nothing to clear */
+            return 0;
+        }
+    }
+
+    SDL_LockPropertiesForWriting(properties);
     {
-        SDL_RemoveFromHashTable(properties->props, name);
-        if (property) {
-            char *key = SDL_strdup(name);
-            if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
-                SDL_FreeProperty(key, property, NULL);
-                result = -1;
-            }
+        SDL_Property *existing = NULL;
+
+        if (!property) {
+            SDL_RemoveFromHashTable(properties->props, key);
+        } else if (SDL_FindInHashTable(properties->props, key, (const void **)&existing)) {
+            /* Replace the value in place, so the table doesn't change */
+            SDL_CleanupPropertyValue(existing);
+            *existing = *property;
+            SDL_free(property);
+        } else if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
+            SDL_FreeProperty(key, property, NULL);
+            result = -1;
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 
     return result;
 }
@@ -355,41 +626,45 @@ int SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool va
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
+    const SDL_PropertyKey *key;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
 
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return SDL_PROPERTY_TYPE_INVALID;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             type = property->type;
         } else {
             SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return type;
 }
 
 void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    const SDL_PropertyKey *key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
+        return default_value;
+    }
+    return SDL_GetPropertyByKey(props, key, default_value);
+}
+
+void *SDL_GetPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, void *default_value)
 {
     SDL_Properties *properties = NULL;
     void *value = default_value;
@@ -398,14 +673,12 @@ void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_va
         SDL_InvalidParamError("props");
         return value;
     }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    if (!key) {
+        SDL_InvalidParamError("key");
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
@@ -416,25 +689,34 @@ void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_va
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      */
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             } else {
-                SDL_SetError("Property %s isn't a pointer value", name);
+                SDL_SetError("Property %s isn't a pointer value", key->name);
             }
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_SetError("Couldn't find property named %s", key->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+{
+    const SDL_PropertyKey *key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
+        return default_value;
+    }
+    return SDL_GetStringPropertyByKey(props, key, default_value);
+}
+
+const char *SDL_GetStringPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, const char *default_value)
 {
     SDL_Properties *properties = NULL;
     const char *value = default_value;
@@ -443,14 +725,12 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         SDL_InvalidParamError("props");
         return value;
     }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    if (!key) {
+        SDL_InvalidParamError("key");
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
@@ -463,55 +743,56 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
      *
      * FIXME: Should we SDL_strdup() the return value to avoid this?
      */
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = property->value.string_value;
                 break;
             case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64 "", property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    } else {
-                        SDL_OutOfMemory();
-                    }
+                value = SDL_GetPropertyStringStorage(property);
+                if (!value) {
+                    char *string = NULL;
+                    SDL_asprintf(&string, "%" SDL_PRIs64 "", property->value.number_value);
+                    value = SDL_SetPropertyStringStorage(property, string, default_value);
                 }
                 break;
             case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    } else {
-                        SDL_OutOfMemory();
-                    }
+                value = SDL_GetPropertyStringStorage(property);
+                if (!value) {
+                    char *string = NULL;
+                    SDL_asprintf(&string, "%f", property->value.float_value);
+                    value = SDL_SetPropertyStringStorage(property, string, default_value);
                 }
                 break;
             case SDL_PROPERTY_TYPE_BOOLEAN:
                 value = property->value.boolean_value ? "true" : "false";
                 break;
             default:
-                SDL_SetError("Property %s isn't a string value", name);
+                SDL_SetError("Property %s isn't a string value", key->name);
                 break;
             }
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_SetError("Couldn't find property named %s", key->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
 Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+{
+    const SDL_PropertyKey *key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
+        return default_value;
+    }
+    return SDL_GetNumberPropertyByKey(props, key, default_value);
+}
+
+Sint64 SDL_GetNumberPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
     Sint64 value = default_value;
@@ -520,24 +801,22 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
         SDL_InvalidParamError("props");
         return value;
     }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    if (!key) {
+        SDL_InvalidParamError("key");
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_strtoll(property->value.string_value, NULL, 0);
@@ -552,19 +831,28 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
                 value = property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a number value", name);
+                SDL_SetError("Property %s isn't a number value", key->name);
                 break;
             }
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_SetError("Couldn't find property named %s", key->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
 float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+{
+    const SDL_PropertyKey *key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
+        return default_value;
+    }
+    return SDL_GetFloatPropertyByKey(props, key, default_value);
+}
+
+float SDL_GetFloatPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, float default_value)
 {
     SDL_Properties *properties = NULL;
     float value = default_value;
@@ -573,24 +861,22 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
         SDL_InvalidParamError("props");
         return value;
     }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    if (!key) {
+        SDL_InvalidParamError("key");
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -605,19 +891,28 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
                 value = (float)property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a float value", name);
+                SDL_SetError("Property %s isn't a float value", key->name);
                 break;
             }
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_SetError("Couldn't find property named %s", key->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
 SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
+{
+    const SDL_PropertyKey *key = SDL_GetExistingPropertyKey(props, name);
+    if (!key) {
+        return default_value;
+    }
+    return SDL_GetBooleanPropertyByKey(props, key, default_value);
+}
+
+SDL_bool SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, SDL_bool default_value)
 {
     SDL_Properties *properties = NULL;
     SDL_bool value = default_value;
@@ -626,24 +921,22 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
         SDL_InvalidParamError("props");
         return value;
     }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
+    if (!key) {
+        SDL_InvalidParamError("key");
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         SDL_InvalidParamError("props");
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTable(properties->props, key, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -658,14 +951,14 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
                 value = property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a boolean value", name);
+                SDL_SetError("Property %s isn't a boolean value", key->name);
                 break;
             }
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_SetError("Couldn't find property named %s", key->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
@@ -686,25 +979,23 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = SDL_GetPropertiesObject(props);
 
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     {
         void *iter;
         const void *key, *value;
 
         iter = NULL;
         while (SDL_IterateHashTable(properties->props, &key, &value, &iter)) {
-            callback(userdata, props, (const char *)key);
+            callback(userdata, props, ((const SDL_PropertyKey *)key)->name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 
     return 0;
 }
@@ -0,0 +1,183 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_TRACING
+
+#include "SDL_trace_c.h"
+#include "thread/SDL_thread_c.h"
+
+/* This is how many events each thread keeps, and must be a power of two */
+#define TRACE_BUFFER_SIZE 16384
+
+typedef enum
+{
+    TRACE_EVENT_BEGIN,
+    TRACE_EVENT_END,
+    TRACE_EVENT_COUNTER
+} SDL_TraceEventType;
+
+typedef struct
+{
+    Uint64 ticks;
+    const char *name;
+    Sint64 value;
+    SDL_TraceEventType type;
+} SDL_TraceEvent;
+
+typedef struct SDL_TraceBuffer
+{
+    SDL_threadID thread;
+    Uint32 write_pos;   /* Only touched by the recording thread */
+    SDL_AtomicInt head; /* How many events have been recorded */
+    Uint32 tail;        /* How many events have been written out, only touched by SDL_QuitTracing() */
+    SDL_TraceEvent events[TRACE_BUFFER_SIZE];
+    struct SDL_TraceBuffer *next;
+} SDL_TraceBuffer;
+
+/* Buffers are only ever added to the front of this list, and never freed */
+static SDL_TraceBuffer *SDL_trace_buffers;
+
+#ifdef SDL_THREAD_LOCAL
+static SDL_THREAD_LOCAL SDL_TraceBuffer *SDL_thread_trace_buffer;
+#endif
+
+static SDL_TraceBuffer *GetTraceBuffer(void)
+{
+    const SDL_threadID thread = SDL_ThreadID();
+    SDL_TraceBuffer *buffer;
+    SDL_calloc_func calloc_func;
+
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_thread_trace_buffer) {
+        return SDL_thread_trace_buffer;
+    }
+#else
+    for (buffer = (SDL_TraceBuffer *)SDL_AtomicGetPtr((void **)&SDL_trace_buffers); buffer; buffer = buffer->next) {
+        if (buffer->thread == thread) {
+            return buffer;
+        }
+    }
+#endif
+
+    /* These outlive SDL_Quit(), since threads may still be recording, so use the original allocator */
+    SDL_GetOriginalMemoryFunctions(NULL, &calloc_func, NULL, NULL);
+    buffer = (SDL_TraceBuffer *)calloc_func(1, sizeof(*buffer));
+    if (!buffer) {
+        return NULL;
+    }
+    buffer->thread = thread;
+    do {
+        buffer->next = (SDL_TraceBuffer *)SDL_AtomicGetPtr((void **)&SDL_trace_buffers);
+    } while (!SDL_AtomicCASPtr((void **)&SDL_trace_buffers, buffer->next, buffer));
+
+#ifdef SDL_THREAD_LOCAL
+    SDL_thread_trace_buffer = buffer;
+#endif
+    return buffer;
+}
+
+static void SDL_RecordTraceEvent(SDL_TraceEventType type, const char *name, Sint64 value)
+{
+    SDL_TraceBuffer *buffer = GetTraceBuffer();
+    SDL_TraceEvent *event;
+
+    if (!buffer) {
+        return;
+    }
+
+    event = &buffer->events[buffer->write_pos & (TRACE_BUFFER_SIZE - 1)];
+    event->ticks = SDL_GetPerformanceCounter();
+    event->name = name;
+    event->value = value;
+    event->type = type;
+    ++buffer->write_pos;
+    SDL_AtomicSet(&buffer->head, (int)buffer->write_pos);
+}
+
+void SDL_TraceBegin(const char *name)
+{
+    SDL_RecordTraceEvent(TRACE_EVENT_BEGIN, name, 0);
+}
+
+void SDL_TraceEnd(const char *name)
+{
+    SDL_RecordTraceEvent(TRACE_EVENT_END, name, 0);
+}
+
+void SDL_TraceCounter(const char *name, Sint64 value)
+{
+    SDL_RecordTraceEvent(TRACE_EVENT_COUNTER, name, value);
+}
+
+void SDL_QuitTracing(void)
+{
+    const double us_per_tick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    const char *file = SDL_GetHint(SDL_HINT_TRACE_FILE);
+    SDL_TraceBuffer *buffer;
+    SDL_RWops *rw = NULL;
+    SDL_bool first = SDL_TRUE;
+
+    if (!file || !*file) {
+        file = "SDL_trace.json";
+    }
+
+    for (buffer = (SDL_TraceBuffer *)SDL_AtomicGetPtr((void **)&SDL_trace_buffers); buffer; buffer = buffer->next) {
+        const Uint32 head = (Uint32)SDL_AtomicGet(&buffer->head);
+        Uint32 pos = buffer->tail;
+
+        if (head - pos > TRACE_BUFFER_SIZE) {
+            /* The oldest events have been overwritten */
+            pos = head - TRACE_BUFFER_SIZE;
+        }
+        buffer->tail = head;
+
+        for (; pos != head; ++pos) {
+            const SDL_TraceEvent *event = &buffer->events[pos & (TRACE_BUFFER_SIZE - 1)];
+
+            if (!rw) {
+                rw = SDL_RWFromFile(file, "w");
+                if (!rw) {
+                    SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "Couldn't write trace to %s: %s", file, SDL_GetError());
+                    return;
+                }
+                SDL_RWprintf(rw, "{\"traceEvents\":[\n");
+            }
+
+            SDL_RWprintf(rw, "%s{\"name\":\"%s\",\"cat\":\"SDL\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu",
+                         first ? "" : ",\n", event->name,
+                         event->type == TRACE_EVENT_BEGIN ? 'B' : event->type == TRACE_EVENT_END ? 'E' : 'C',
+                         event->ticks * us_per_tick, (unsigned long)buffer->thread);
+            if (event->type == TRACE_EVENT_COUNTER) {
+                SDL_RWprintf(rw, ",\"args\":{\"value\":%" SDL_PRIs64 "}", event->value);
+            }
+            SDL_RWprintf(rw, "}");
+            first = SDL_FALSE;
+        }
+    }
+
+    if (rw) {
+        SDL_RWprintf(rw, "\n]}\n");
+        SDL_RWclose(rw);
+    }
+}
+
+#endif /* SDL_TRACING */
@@ -0,0 +1,60 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_trace_c_h_
+#define SDL_trace_c_h_
+
+/* Tracing of SDL internals, enabled by building with -DSDL_TRACING=ON
+
+   Zones and counters are recorded into a ring buffer owned by the thread
+   that records them, so recording never takes a lock. When the ring wraps,
+   the oldest events are overwritten. SDL_Quit() writes everything that was
+   recorded to a Chrome trace file (SDL_HINT_TRACE_FILE), which can be opened
+   in Perfetto or chrome://tracing.
+
+   Names must be string literals, since only the pointer is recorded.
+   When tracing is disabled, all of this compiles to nothing.
+ */
+
+#ifdef SDL_TRACING
+
+extern void SDL_TraceBegin(const char *name);
+extern void SDL_TraceEnd(const char *name);
+extern void SDL_TraceCounter(const char *name, Sint64 value);
+
+/* Write out the events recorded since the last call */
+extern void SDL_QuitTracing(void);
+
+#define SDL_TRACE_BEGIN(name)           SDL_TraceBegin(name)
+#define SDL_TRACE_END(name)             SDL_TraceEnd(name)
+#define SDL_TRACE_COUNTER(name, value)  SDL_TraceCounter(name, (Sint64)(value))
+
+#else
+
+#define SDL_TRACE_BEGIN(name)
+#define SDL_TRACE_END(name)
+#define SDL_TRACE_COUNTER(name, value)
+#define SDL_QuitTracing()
+
+#endif /* SDL_TRACING */
+
+#endif /* SDL_trace_c_h_ */
@@ -0,0 +1,272 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Bounded lock-free queues
+
+   The positions in these queues count up forever and wrap around, and are
+   masked to find the slot in the queue, so the capacity is a power of two.
+   They're compared as unsigned values so the wraparound is harmless.
+ */
+
+/* The largest capacity, so positions can't be more than a lap apart */
+#define SDL_MAX_QUEUE_CAPACITY (1 << 30)
+
+static Uint32 SDL_GetQueueCapacity(int capacity)
+{
+    Uint32 size = 1;
+
+    while (size < (Uint32)capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static SDL_bool SDL_CheckQueueParams(int capacity, size_t item_size)
+{
+    if (capacity <= 0 || capacity > SDL_MAX_QUEUE_CAPACITY) {
+        SDL_InvalidParamError("capacity");
+        return SDL_FALSE;
+    }
+    if (item_size == 0 || item_size > (SDL_SIZE_MAX / SDL_GetQueueCapacity(capacity))) {
+        SDL_InvalidParamError("item_size");
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+struct SDL_SPSCQueue
+{
+    SDL_AtomicInt head; /* The next position to read, only written by the consumer */
+    char pad1[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicInt)];
+    SDL_AtomicInt tail; /* The next position to write, only written by the producer */
+    char pad2[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicInt)];
+    Uint32 mask;
+    size_t item_size;
+    Uint8 *items;
+};
+
+SDL_SPSCQueue *SDL_CreateSPSCQueue(int capacity, size_t item_size)
+{
+    SDL_SPSCQueue *queue;
+    Uint32 size;
+
+    if (!SDL_CheckQueueParams(capacity, item_size)) {
+        return NULL;
+    }
+    size = SDL_GetQueueCapacity(capacity);
+
+    queue = (SDL_SPSCQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->items = (Uint8 *)SDL_malloc(size * item_size);
+    if (!queue->items) {
+        SDL_free(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->mask = size - 1;
+    queue->item_size = item_size;
+    return queue;
+}
+
+SDL_bool SDL_EnqueueSPSC(SDL_SPSCQueue *queue, const void *item)
+{
+    Uint32 head, tail;
+
+    if (!queue || !item) {
+        return SDL_FALSE;
+    }
+
+    tail = (Uint32)SDL_AtomicGet(&queue->tail);
+    head = (Uint32)SDL_AtomicGet(&queue->head);
+    if ((tail - head) > queue->mask) {
+        return SDL_FALSE; /* full */
+    }
+
+    SDL_memcpy(queue->items + (tail & queue->mask) * queue->item_size, item, queue->item_size);
+
+    /* Make sure the item is visible before the consumer can see it */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queue->tail, (int)(tail + 1));
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_DequeueSPSC(SDL_SPSCQueue *queue, void *item)
+{
+    Uint32 head, tail;
+
+    if (!queue || !item) {
+        return SDL_FALSE;
+    }
+
+    head = (Uint32)SDL_AtomicGet(&queue->head);
+    tail = (Uint32)SDL_AtomicGet(&queue->tail);
+    if (head == tail) {
+        return SDL_FALSE; /* empty */
+    }
+
+    SDL_MemoryBarrierAcquire();
+    SDL_memcpy(item, queue->items + (head & queue->mask) * queue->item_size, queue->item_size);
+
+    /* Make sure we're done reading before the producer can reuse the slot */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queue->head, (int)(head + 1));
+    return SDL_TRUE;
+}
+
+void SDL_DestroySPSCQueue(SDL_SPSCQueue *queue)
+{
+    if (queue) {
+        SDL_free(queue->items);
+        SDL_free(queue);
+    }
+}
+
+/* This is Dmitry Vyukov's bounded MPMC queue. Each slot has a sequence number
+   that says whether it's ready to be written or read for a given position, so
+   producers and consumers only contend on claiming positions.
+ */
+struct SDL_MPMCQueue
+{
+    SDL_AtomicInt enqueue_pos;
+    char pad1[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicInt)];
+    SDL_AtomicInt dequeue_pos;
+    char pad2[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicInt)];
+    Uint32 mask;
+    size_t item_size;
+    SDL_AtomicInt *sequences;
+    Uint8 *items;
+};
+
+SDL_MPMCQueue *SDL_CreateMPMCQueue(int capacity, size_t item_size)
+{
+    SDL_MPMCQueue *queue;
+    Uint32 i, size;
+
+    if (!SDL_CheckQueueParams(capacity, item_size)) {
+        return NULL;
+    }
+    size = SDL_GetQueueCapacity(capacity);
+
+    queue = (SDL_MPMCQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->sequences = (SDL_AtomicInt *)SDL_malloc(size * sizeof(*queue->sequences));
+    queue->items = (Uint8 *)SDL_malloc(size * item_size);
+    if (!queue->sequences || !queue->items) {
+        SDL_free(queue->sequences);
+        SDL_free(queue->items);
+        SDL_free(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->mask = size - 1;
+    queue->item_size = item_size;
+
+    /* Each slot starts out ready to be written at its own position */
+    for (i = 0; i < size; ++i) {
+        SDL_AtomicSet(&queue->sequences[i], (int)i);
+    }
+    return queue;
+}
+
+SDL_bool SDL_EnqueueMPMC(SDL_MPMCQueue *queue, const void *item)
+{
+    Uint32 pos, slot;
+
+    if (!queue || !item) {
+        return SDL_FALSE;
+    }
+
+    pos = (Uint32)SDL_AtomicGet(&queue->enqueue_pos);
+    for (;;) {
+        const Sint32 delta = (Sint32)((Uint32)SDL_AtomicGet(&queue->sequences[pos & queue->mask]) - pos);
+        if (delta == 0) {
+            /* The slot is free, try to claim it */
+            if (SDL_AtomicCAS(&queue->enqueue_pos, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (delta < 0) {
+            return SDL_FALSE; /* full, the slot still holds an item from the last lap */
+        } else {
+            SDL_CPUPauseInstruction();
+        }
+        /* Another producer got here first */
+        pos = (Uint32)SDL_AtomicGet(&queue->enqueue_pos);
+    }
+
+    slot = pos & queue->mask;
+    SDL_memcpy(queue->items + slot * queue->item_size, item, queue->item_size);
+
+    /* Make sure the item is visible before it's marked as ready to read */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queue->sequences[slot], (int)(pos + 1));
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_DequeueMPMC(SDL_MPMCQueue *queue, void *item)
+{
+    Uint32 pos, slot;
+
+    if (!queue || !item) {
+        return SDL_FALSE;
+    }
+
+    pos = (Uint32)SDL_AtomicGet(&queue->dequeue_pos);
+    for (;;) {
+        const Sint32 delta = (Sint32)((Uint32)SDL_AtomicGet(&queue->sequences[pos & queue->mask]) - (pos + 1));
+        if (delta == 0) {
+            /* The slot has been written, try to claim it */
+            if (SDL_AtomicCAS(&queue->dequeue_pos, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (delta < 0) {
+            return SDL_FALSE; /* empty, nothing has been written to this position yet */
+        } else {
+            SDL_CPUPauseInstruction();
+        }
+        /* Another consumer got here first */
+        pos = (Uint32)SDL_AtomicGet(&queue->dequeue_pos);
+    }
+
+    slot = pos & queue->mask;
+    SDL_MemoryBarrierAcquire();
+    SDL_memcpy(item, queue->items + slot * queue->item_size, queue->item_size);
+
+    /* Make sure we're done reading before the slot is marked as free for the next lap */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queue->sequences[slot], (int)(pos + queue->mask + 1));
+    return SDL_TRUE;
+}
+
+void SDL_DestroyMPMCQueue(SDL_MPMCQueue *queue)
+{
+    if (queue) {
+        SDL_free(queue->sequences);
+        SDL_free(queue->items);
+        SDL_free(queue);
+    }
+}
@@ -36,6 +36,8 @@
 #include <xmmintrin.h>
 #endif
 
+#include "../thread/SDL_lockprofile.h"
+
 #ifdef PS2
 #include <kernel.h>
 #endif
@@ -165,23 +167,47 @@ SDL_bool SDL_AtomicTryLock(SDL_SpinLock *lock)
 #endif
 }
 
+/* The most pause instructions to run between attempts to take a spinlock */
+#define SDL_SPINLOCK_MAX_BACKOFF 64
+
 void SDL_AtomicLock(SDL_SpinLock *lock)
 {
-    int iterations = 0;
+    int backoff = 1;
+#ifdef SDL_LOCK_PROFILING
+    SDL_SpinLockProfile *profile = SDL_FindSpinLockProfile(lock);
+    const Uint64 start = profile ? SDL_GetPerformanceCounter() : 0;
+#endif
+
     /* FIXME: Should we have an eventual timeout? */
     while (!SDL_AtomicTryLock(lock)) {
-        if (iterations < 32) {
-            iterations++;
-            SDL_CPUPauseInstruction();
+        if (backoff <= SDL_SPINLOCK_MAX_BACKOFF) {
+            /* Back off exponentially so contending threads don't hammer the cache line */
+            int i;
+            for (i = 0; i < backoff; ++i) {
+                SDL_CPUPauseInstruction();
+            }
+            backoff *= 2;
         } else {
             /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
             SDL_Delay(0);
         }
     }
+#ifdef SDL_LOCK_PROFILING
+    if (profile) {
+        SDL_RecordSpinLockAcquired(profile, (backoff > 1), SDL_GetPerformanceCounter() - start);
+    }
+#endif
 }
 
 void SDL_AtomicUnlock(SDL_SpinLock *lock)
 {
+#ifdef SDL_LOCK_PROFILING
+    SDL_SpinLockProfile *profile = SDL_FindSpinLockProfile(lock);
+    if (profile) {
+        SDL_RecordSpinLockReleased(profile);
+    }
+#endif
+
 #if defined(HAVE_GCC_ATOMICS) || defined(HAVE_GCC_SYNC_LOCK_TEST_AND_SET)
     __sync_lock_release(lock);
 
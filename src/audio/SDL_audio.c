@@ -22,7 +22,11 @@
 
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
+#include "SDL_audioqueue.h"
+#include "../thread/SDL_lockprofile.h"
+#include "../SDL_trace_c.h"
 #include "../thread/SDL_systhread.h"
+#include "../SDL_hints_c.h"
 #include "../SDL_utils_c.h"
 
 // Available audio drivers
@@ -116,7 +120,7 @@ const char *SDL_GetCurrentAudioDriver(void)
     return current_audio.name;
 }
 
-static int GetDefaultSampleFramesFromFreq(const int freq)
+static int GetDefaultSampleFramesFromFreq(const int freq, const SDL_bool low_latency)
 {
     const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES);
     if (hint) {
@@ -126,6 +130,18 @@ static int GetDefaultSampleFramesFromFreq(const int freq)
         }
     }
 
+    if (low_latency) {  // about 2.7ms at 48kHz; backends can still bump this up to whatever their minimum period is.
+        if (freq <= 22050) {
+            return 64;
+        } else if (freq <= 48000) {
+            return 128;
+        } else if (freq <= 96000) {
+            return 256;
+        } else {
+            return 512;
+        }
+    }
+
     if (freq <= 22050) {
         return 512;
     } else if (freq <= 48000) {
@@ -188,22 +204,45 @@ static SDL_bool AudioDeviceCanUseSimpleCopy(SDL_AudioDevice *device)
         device->logical_devices &&  // there's a logical device
         !device->logical_devices->next &&  // there's only _ONE_ logical device
         !device->logical_devices->postmix && // there isn't a postmix callback
+        (device->logical_devices->gain == 1.0f) &&  // there's no gain to apply
         device->logical_devices->bound_streams &&  // there's a bound stream
         !device->logical_devices->bound_streams->next_binding  // there's only _ONE_ bound stream.
     );
 }
 
+// device should be locked when calling this. Only meaningful if simple copy isn't possible.
+static SDL_bool AudioDeviceCanUseIntegerMix(SDL_AudioDevice *device)
+{
+    SDL_assert(device != NULL);
+    if (device->spec.format != SDL_AUDIO_S16) {  // native byte order only, so the saturating add works on the buffer directly.
+        return SDL_FALSE;
+    } else if (device->mix_pool) {  // the worker threads mix in float32.
+        return SDL_FALSE;
+    }
+
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (logdev->postmix) {  // postmix callbacks get float32 data.
+            return SDL_FALSE;
+        } else if ((logdev->gain != 1.0f) || logdev->parent) {  // buses get mixed (and scaled) in float32.
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
 // should hold device->lock before calling.
 static void UpdateAudioStreamFormatsPhysical(SDL_AudioDevice *device)
 {
     if (!device->iscapture) {  // for capture devices, we only want to move to float32 for postmix, which we'll handle elsewhere.
         const SDL_bool simple_copy = AudioDeviceCanUseSimpleCopy(device);
+        const SDL_bool integer_mix = !simple_copy && AudioDeviceCanUseIntegerMix(device);
         SDL_AudioSpec spec;
 
         device->simple_copy = simple_copy;
+        device->integer_mix = integer_mix;
         SDL_copyp(&spec, &device->spec);
 
-        if (!simple_copy) {
+        if (!simple_copy && !integer_mix) {
             spec.format = SDL_AUDIO_F32;  // mixing and postbuf operates in float32 format.
         }
 
@@ -417,6 +456,74 @@ static SDL_AudioDevice *ObtainPhysicalAudioDeviceDefaultAllowed(SDL_AudioDeviceI
     return NULL;
 }
 
+// Number of buses between this logical device and the physical device.
+static int GetLogicalAudioDeviceDepth(const SDL_LogicalAudioDevice *logdev)
+{
+    int depth = 0;
+    for (const SDL_LogicalAudioDevice *parent = logdev->parent; parent; parent = parent->parent) {
+        depth++;
+    }
+    return depth;
+}
+
+// SDL_TRUE if this logical device has to mix into a buffer of its own before adding it to its parent.
+static SDL_bool LogicalAudioDeviceNeedsOwnMix(const SDL_LogicalAudioDevice *logdev)
+{
+    return (logdev->postmix || (logdev->gain != 1.0f)) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void FreeSubmixBuffers(SDL_AudioDevice *device)
+{
+    for (int i = 0; i < device->num_submix_buffers; i++) {
+        SDL_aligned_free(device->submix_buffers[i]);
+    }
+    SDL_free(device->submix_buffers);
+    device->submix_buffers = NULL;
+    device->num_submix_buffers = 0;
+}
+
+// device should be locked when calling this. Makes sure there's a scratch buffer for every logical device that mixes on its own.
+static int AllocateAudioMixBuffers(SDL_AudioDevice *device)
+{
+    SDL_bool needs_postmix_buffer = SDL_FALSE;
+    int needed_submix_buffers = 0;
+
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (LogicalAudioDeviceNeedsOwnMix(logdev)) {
+            const int depth = GetLogicalAudioDeviceDepth(logdev);
+            if (depth == 0) {
+                needs_postmix_buffer = SDL_TRUE;
+            } else {
+                needed_submix_buffers = SDL_max(needed_submix_buffers, depth);
+            }
+        }
+    }
+
+    if (needs_postmix_buffer && !device->postmix_buffer) {
+        device->postmix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+        if (!device->postmix_buffer) {
+            return SDL_OutOfMemory();
+        }
+    }
+
+    if (needed_submix_buffers > device->num_submix_buffers) {
+        float **ptr = (float **)SDL_realloc(device->submix_buffers, needed_submix_buffers * sizeof (float *));
+        if (!ptr) {
+            return SDL_OutOfMemory();
+        }
+        device->submix_buffers = ptr;
+        while (device->num_submix_buffers < needed_submix_buffers) {
+            float *buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+            if (!buffer) {
+                return SDL_OutOfMemory();
+            }
+            device->submix_buffers[device->num_submix_buffers++] = buffer;
+        }
+    }
+
+    return 0;
+}
+
 // this assumes you hold the _physical_ device lock for this logical device! This will not unlock the lock or close the physical device!
 //  It also will not unref the physical device, since we might be shutting down; SDL_CloseAudioDevice handles the unref.
 static void DestroyLogicalAudioDevice(SDL_LogicalAudioDevice *logdev)
@@ -439,6 +546,13 @@ static void DestroyLogicalAudioDevice(SDL_LogicalAudioDevice *logdev)
         logdev->physical_device->logical_devices = logdev->next;
     }
 
+    // any buses that mixed into us go to our parent instead. They end up less nested, so their scratch buffers already exist.
+    for (SDL_LogicalAudioDevice *child = logdev->physical_device->logical_devices; child; child = child->next) {
+        if (child->parent == logdev) {
+            child->parent = logdev->parent;
+        }
+    }
+
     // unbind any still-bound streams...
     SDL_AudioStream *next;
     for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = next) {
@@ -473,6 +587,7 @@ static void DestroyPhysicalAudioDevice(SDL_AudioDevice *device)
 
     SDL_UnlockMutex(device->lock);  // don't use ReleaseAudioDevice because we don't want to change refcounts while destroying.
 
+    SDL_DestroyProperties(device->props);
     SDL_DestroyMutex(device->lock);
     SDL_DestroyCondition(device->close_cond);
     SDL_free(device->work_buffer);
@@ -529,6 +644,7 @@ static SDL_AudioDevice *CreatePhysicalAudioDevice(const char *name, SDL_bool isc
         SDL_free(device);
         return NULL;
     }
+    SDL_SetMutexName(device->lock, "audio device lock");
 
     device->close_cond = SDL_CreateCondition();
     if (!device->close_cond) {
@@ -543,7 +659,7 @@ static SDL_AudioDevice *CreatePhysicalAudioDevice(const char *name, SDL_bool isc
     device->iscapture = iscapture;
     SDL_copyp(&device->spec, spec);
     SDL_copyp(&device->default_spec, spec);
-    device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq);
+    device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq, SDL_FALSE);
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
     device->handle = handle;
 
@@ -814,10 +930,14 @@ int SDL_InitAudio(const char *driver_name)
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
 
+    const char *chunk_pool_hint = SDL_GetHint(SDL_HINT_AUDIO_CHUNK_POOL_SIZE);
+    SDL_SetAudioChunkPoolLimit(chunk_pool_hint ? (size_t) SDL_strtoull(chunk_pool_hint, NULL, 10) : SDL_AUDIO_CHUNK_POOL_DEFAULT_BYTES);
+
     SDL_RWLock *device_hash_lock = SDL_CreateRWLock();  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
     if (!device_hash_lock) {
         return -1;
     }
+    SDL_SetRWLockName(device_hash_lock, "audio device_hash_lock");
 
     SDL_HashTable *device_hash = SDL_CreateHashTable(NULL, 8, HashAudioDeviceID, MatchAudioDeviceID, NukeAudioDeviceHashItem, SDL_FALSE);
     if (!device_hash) {
@@ -987,6 +1107,13 @@ void SDL_QuitAudio(void)
     SDL_DestroyRWLock(current_audio.device_hash_lock);
     SDL_DestroyHashTable(device_hash);
 
+    // Every stream is gone, so nothing will be reusing the pooled chunks.
+    SDL_AudioChunkPoolStats chunk_pool_stats;
+    SDL_GetAudioChunkPoolStats(&chunk_pool_stats);
+    SDL_LogDebug(SDL_LOG_CATEGORY_AUDIO, "Audio chunk pool: %" SDL_PRIu64 " allocated, %" SDL_PRIu64 " reused, %" SDL_PRIu64 " freed, %u bytes at peak",
+                 chunk_pool_stats.allocated, chunk_pool_stats.reused, chunk_pool_stats.freed, (unsigned int) chunk_pool_stats.peak_idle_bytes);
+    SDL_SetAudioChunkPoolLimit(0);
+
     SDL_zero(current_audio);
 }
 
@@ -997,18 +1124,373 @@ void SDL_AudioThreadFinalize(SDL_AudioDevice *device)
 
 static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
 {
-    if (SDL_MixAudioFormat((Uint8 *) dst, (const Uint8 *) src, SDL_AUDIO_F32, buffer_size, SDL_MIX_MAXVOLUME) < 0) {
-        SDL_assert(!"This shouldn't happen.");
+    // streams are accumulated unclamped, ConvertAudio clamps once if the device format needs it.
+    SDL_MixFloat32Audio(dst, src, buffer_size / (int) sizeof (float));
+}
+
+
+// Worker threads that get data from an output device's bound streams in parallel.
+// Each worker mixes the streams it takes into its own buffer, the device thread adds those up at the end.
+#define SDL_MAX_AUDIO_MIX_THREADS 16
+
+typedef struct SDL_AudioMixWorker
+{
+    struct SDL_AudioMixPool *pool;
+    SDL_Thread *thread;
+    Uint8 *work_buffer;
+    float *mix_buffer;
+    SDL_bool mixed;  // SDL_TRUE if mix_buffer has data from this job.
+} SDL_AudioMixWorker;
+
+typedef struct SDL_AudioMixPool
+{
+    SDL_Mutex *lock;
+    SDL_Condition *ready;
+    SDL_Condition *done;
+    int num_workers;
+    SDL_AudioMixWorker *workers;
+    int buffer_size;  // size of each worker's buffers, in bytes.
+
+    // the current job, set up by the device thread.
+    SDL_AudioStream **streams;
+    int num_streams;
+    int max_streams;
+    int work_buffer_size;
+    SDL_AtomicInt next_stream;
+    SDL_AtomicInt failed;
+    Uint32 generation;
+    int remaining;
+    SDL_bool quit;
+} SDL_AudioMixPool;
+
+// Gets data from streams until the job runs out, mixing it into mix_buffer. Returns SDL_TRUE if anything was mixed.
+static SDL_bool MixAudioPoolStreams(SDL_AudioMixPool *pool, float *mix_buffer, Uint8 *work_buffer, SDL_bool mixed)
+{
+    const int work_buffer_size = pool->work_buffer_size;
+    int i;
+
+    while ((i = SDL_AtomicAdd(&pool->next_stream, 1)) < pool->num_streams) {
+        const int br = SDL_GetAudioStreamData(pool->streams[i], work_buffer, work_buffer_size);
+        if (br < 0) {
+            SDL_AtomicSet(&pool->failed, 1);
+        } else if (br > 0) {
+            if (!mixed) {  // the first stream is copied, instead of mixed into silence.
+                SDL_memcpy(mix_buffer, work_buffer, br);
+                SDL_memset((Uint8 *) mix_buffer + br, '\0', work_buffer_size - br);
+                mixed = SDL_TRUE;
+            } else {
+                MixFloat32Audio(mix_buffer, (const float *) work_buffer, br);
+            }
+        }
+    }
+    return mixed;
+}
+
+static int SDLCALL AudioMixThread(void *data)
+{
+    SDL_AudioMixWorker *worker = (SDL_AudioMixWorker *) data;
+    SDL_AudioMixPool *pool = worker->pool;
+    Uint32 generation = 0;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    SDL_LockMutex(pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == generation) {
+            SDL_WaitCondition(pool->ready, pool->lock);
+        }
+        if (pool->quit) {
+            break;
+        }
+        generation = pool->generation;
+
+        SDL_UnlockMutex(pool->lock);
+        worker->mixed = MixAudioPoolStreams(pool, worker->mix_buffer, worker->work_buffer, SDL_FALSE);
+        SDL_LockMutex(pool->lock);
+
+        if (--pool->remaining == 0) {
+            SDL_SignalCondition(pool->done);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    return 0;
+}
+
+static void DestroyAudioMixPool(SDL_AudioMixPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    if (pool->workers) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = SDL_TRUE;
+        SDL_BroadcastCondition(pool->ready);
+        SDL_UnlockMutex(pool->lock);
+
+        for (i = 0; i < pool->num_workers; i++) {
+            SDL_WaitThread(pool->workers[i].thread, NULL);
+            SDL_aligned_free(pool->workers[i].work_buffer);
+            SDL_aligned_free(pool->workers[i].mix_buffer);
+        }
+        SDL_free(pool->workers);
+    }
+    SDL_free(pool->streams);
+    SDL_DestroyCondition(pool->done);
+    SDL_DestroyCondition(pool->ready);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
+
+// The device thread counts as one of the threads, so this makes one less worker. Returns NULL if the streams should be mixed on the device thread.
+static SDL_AudioMixPool *CreateAudioMixPool(SDL_AudioDevice *device)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_MIX_THREADS);
+    int num_threads = 0;
+
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+        if (num_threads < 0) {
+            num_threads = SDL_GetCPUCount();
+        }
+    }
+    num_threads = SDL_min(num_threads, SDL_MAX_AUDIO_MIX_THREADS);
+    if (num_threads < 2) {
+        return NULL;
+    }
+
+    SDL_AudioMixPool *pool = (SDL_AudioMixPool *) SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->lock = SDL_CreateMutex();
+    pool->ready = SDL_CreateCondition();
+    pool->done = SDL_CreateCondition();
+    pool->workers = (SDL_AudioMixWorker *) SDL_calloc(num_threads - 1, sizeof (*pool->workers));
+    if (!pool->lock || !pool->ready || !pool->done || !pool->workers) {
+        DestroyAudioMixPool(pool);
+        return NULL;
+    }
+
+    char threadname[64];
+    SDL_GetAudioThreadName(device, threadname, sizeof (threadname));
+    SDL_strlcat(threadname, "Mix", sizeof (threadname));
+    for (int i = 0; i < num_threads - 1; i++) {
+        SDL_AudioMixWorker *worker = &pool->workers[pool->num_workers];
+        worker->pool = pool;
+        worker->thread = SDL_CreateThreadInternal(AudioMixThread, threadname, 0, worker);
+        if (!worker->thread) {
+            break;
+        }
+        pool->num_workers++;
+    }
+    if (pool->num_workers == 0) {
+        DestroyAudioMixPool(pool);
+        return NULL;
     }
+    return pool;
+}
+
+// Mixes the logical device's bound streams into mix_buffer with the pool. Returns SDL_FALSE if it couldn't, so the caller should mix them itself.
+static SDL_bool MixAudioStreamsThreaded(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, float *mix_buffer, int work_buffer_size, SDL_bool *failed)
+{
+    SDL_AudioMixPool *pool = device->mix_pool;
+    int num_streams = 0;
+    int i;
+
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        num_streams++;
+    }
+    if (num_streams < 2) {
+        return SDL_FALSE;  // not worth waking up the workers.
+    }
+
+    // the workers are idle between jobs, so their buffers can be replaced here.
+    if (num_streams > pool->max_streams) {
+        SDL_AudioStream **streams = (SDL_AudioStream **) SDL_realloc(pool->streams, num_streams * sizeof (*streams));
+        if (!streams) {
+            return SDL_FALSE;
+        }
+        pool->streams = streams;
+        pool->max_streams = num_streams;
+    }
+    if (work_buffer_size > pool->buffer_size) {
+        for (i = 0; i < pool->num_workers; i++) {
+            SDL_AudioMixWorker *worker = &pool->workers[i];
+            SDL_aligned_free(worker->work_buffer);
+            SDL_aligned_free(worker->mix_buffer);
+            worker->work_buffer = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), work_buffer_size);
+            worker->mix_buffer = (float *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), work_buffer_size);
+            if (!worker->work_buffer || !worker->mix_buffer) {
+                pool->buffer_size = 0;
+                return SDL_FALSE;
+            }
+        }
+        pool->buffer_size = work_buffer_size;
+    }
+
+    i = 0;
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        pool->streams[i++] = stream;
+    }
+    pool->num_streams = num_streams;
+    pool->work_buffer_size = work_buffer_size;
+    SDL_AtomicSet(&pool->next_stream, 0);
+    SDL_AtomicSet(&pool->failed, 0);
+
+    SDL_LockMutex(pool->lock);
+    pool->remaining = pool->num_workers;
+    pool->generation++;
+    SDL_BroadcastCondition(pool->ready);
+    SDL_UnlockMutex(pool->lock);
+
+    // mix_buffer starts out silent, so the device thread can mix straight into it.
+    MixAudioPoolStreams(pool, mix_buffer, device->work_buffer, SDL_TRUE);
+
+    SDL_LockMutex(pool->lock);
+    while (pool->remaining > 0) {
+        SDL_WaitCondition(pool->done, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    for (i = 0; i < pool->num_workers; i++) {
+        if (pool->workers[i].mixed) {
+            MixFloat32Audio(mix_buffer, pool->workers[i].mix_buffer, work_buffer_size);
+        }
+    }
+    if (SDL_AtomicGet(&pool->failed)) {
+        *failed = SDL_TRUE;
+    }
+    return SDL_TRUE;
 }
 
 
 // Output device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
+// Applies the scheduling class and CPU affinity the app set in the device properties. This runs on the device thread, after the backend's ThreadInit.
+static void ApplyAudioThreadProperties(SDL_AudioDevice *device)
+{
+    const SDL_PropertiesID props = device->props;  // only exists if someone asked for it before opening the device.
+    if (!props) {
+        return;
+    }
+
+    const char *priority = SDL_GetStringProperty(props, "SDL.audio.device.thread.priority", NULL);
+    if (priority) {
+        int rc = -1;
+        if (SDL_strcmp(priority, "realtime") == 0) {
+            rc = SDL_SYS_SetThreadRealtime();
+        } else if (SDL_strcmp(priority, "time_critical") == 0) {
+            rc = SDL_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+        } else if (SDL_strcmp(priority, "high") == 0) {
+            rc = SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+        } else if (SDL_strcmp(priority, "normal") == 0) {
+            rc = SDL_SetThreadPriority(SDL_THREAD_PRIORITY_NORMAL);
+        }
+        SDL_AtomicSet(&device->thread_priority_applied, (rc == 0) ? 1 : 0);
+    }
+
+    const Sint64 cpu = SDL_GetNumberProperty(props, "SDL.audio.device.thread.cpu", -1);
+    if ((cpu >= 0) && (cpu <= SDL_MAX_SINT32)) {
+        const int cpus[1] = { (int) cpu };
+        SDL_AtomicSet(&device->thread_cpu_applied, (SDL_SYS_SetThreadAffinity(cpus, 1) == 0) ? 1 : 0);
+    }
+}
+
 void SDL_OutputAudioThreadSetup(SDL_AudioDevice *device)
 {
     SDL_assert(!device->iscapture);
     current_audio.impl.ThreadInit(device);
+    ApplyAudioThreadProperties(device);
+}
+
+// Counts the streams an iteration of the device thread handles. This expects the device lock to be held.
+static int CountActiveAudioStreams(SDL_AudioDevice *device)
+{
+    int retval = 0;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (!SDL_AtomicGet(&logdev->paused)) {
+            for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                retval++;
+            }
+        }
+    }
+    return retval;
+}
+
+// Updates device->stats after an iteration of the device thread that started at `start_ns` and handled `buffer_size` bytes. This expects the device lock to be held.
+static void UpdateAudioThreadStats(SDL_AudioDevice *device, Uint64 start_ns, int buffer_size)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 mix_ns = now - start_ns;
+    const Uint64 buffer_ns = (((Uint64) (buffer_size / SDL_AUDIO_FRAMESIZE(device->spec))) * SDL_NS_PER_SECOND) / device->spec.freq;
+
+    if (device->stats.last_end_ns) {
+        device->stats.wait_ns = start_ns - device->stats.last_end_ns;
+        device->stats.max_wait_ns = SDL_max(device->stats.max_wait_ns, device->stats.wait_ns);
+    }
+    device->stats.last_end_ns = now;
+    device->stats.iterations++;
+    device->stats.mix_ns = mix_ns;
+    device->stats.max_mix_ns = SDL_max(device->stats.max_mix_ns, mix_ns);
+    device->stats.total_mix_ns += mix_ns;
+    device->stats.streams = CountActiveAudioStreams(device);
+    if (mix_ns > buffer_ns) {
+        device->stats.late_buffers++;
+    }
+}
+
+// device should be locked when calling this. Mixes a logical device's streams and any buses that mix into it, then adds that to `dst`.
+static void MixLogicalAudioDevice(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, int depth, float *dst, int work_buffer_size, const SDL_AudioSpec *outspec, SDL_bool *failed)
+{
+    if (SDL_AtomicGet(&logdev->paused)) {
+        return;  // paused? Skip this logical device, and every bus that mixes into it.
+    }
+
+    const SDL_AudioPostmixCallback postmix = logdev->postmix;
+    const float gain = logdev->gain;
+    float *mix_buffer = dst;
+    if (LogicalAudioDeviceNeedsOwnMix(logdev)) {
+        SDL_assert(depth <= device->num_submix_buffers);
+        mix_buffer = (depth == 0) ? device->postmix_buffer : device->submix_buffers[depth - 1];
+        SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
+    }
+
+    if (!device->mix_pool || !MixAudioStreamsThreaded(device, logdev, mix_buffer, work_buffer_size, failed)) {
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            // We should have updated this elsewhere if the format changed!
+            SDL_assert(AUDIO_SPECS_EQUAL(stream->dst_spec, *outspec));
+
+            /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+               for iterating here because the binding linked list can only change while the device lock is held.
+               (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+               the same stream to different devices at the same time, though.) */
+            const int br = SDL_GetAudioStreamData(stream, device->work_buffer, work_buffer_size);
+            if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                *failed = SDL_TRUE;
+                break;
+            } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+                MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
+            }
+        }
+    }
+
+    // buses feeding this one get mixed in before our postmix callback sees the data, so one effect can process the whole group.
+    for (SDL_LogicalAudioDevice *child = device->logical_devices; child; child = child->next) {
+        if (child->parent == logdev) {
+            MixLogicalAudioDevice(device, child, depth + 1, mix_buffer, work_buffer_size, outspec, failed);
+        }
+    }
+
+    if (mix_buffer != dst) {
+        if (postmix) {
+            postmix(logdev->postmix_userdata, outspec, mix_buffer, work_buffer_size);
+        }
+        SDL_MixFloat32AudioGain(dst, mix_buffer, work_buffer_size / (int) sizeof (float), gain);
+    }
 }
 
 SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
@@ -1022,6 +1504,9 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
         return SDL_FALSE;  // we're done, shut it down.
     }
 
+    SDL_TRACE_BEGIN("Output audio iteration");
+
+    const Uint64 start_ns = SDL_GetTicksNS();
     SDL_bool failed = SDL_FALSE;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
@@ -1032,6 +1517,7 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
     } else {
         SDL_assert(buffer_size <= device->buffer_size);  // you can ask for less, but not more.
         SDL_assert(AudioDeviceCanUseSimpleCopy(device) == device->simple_copy);  // make sure this hasn't gotten out of sync.
+        SDL_assert((!device->simple_copy && AudioDeviceCanUseIntegerMix(device)) == device->integer_mix);
 
         // can we do a basic copy without silencing/mixing the buffer? This is an extremely likely scenario, so we special-case it.
         if (device->simple_copy) {
@@ -1048,6 +1534,36 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
             } else if (br < buffer_size) {
                 SDL_memset(device_buffer + br, device->silence_value, buffer_size - br);  // silence whatever we didn't write to.
             }
+        } else if (device->integer_mix) {  // the streams already converted to the device format, so add them up right in the device buffer.
+            SDL_bool mixed = SDL_FALSE;
+            for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev && !failed; logdev = logdev->next) {
+                if (SDL_AtomicGet(&logdev->paused)) {
+                    continue;  // paused? Skip this logical device.
+                }
+
+                for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                    // We should have updated this elsewhere if the format changed!
+                    SDL_assert(AUDIO_SPECS_EQUAL(stream->dst_spec, device->spec));
+
+                    // the first stream with data writes straight to the device buffer, instead of getting mixed into silence.
+                    const int br = SDL_GetAudioStreamData(stream, mixed ? device->work_buffer : device_buffer, buffer_size);
+                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                        failed = SDL_TRUE;
+                        break;
+                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+                        if (!mixed) {
+                            SDL_memset(device_buffer + br, device->silence_value, buffer_size - br);
+                            mixed = SDL_TRUE;
+                        } else {
+                            SDL_MixS16Audio((Sint16 *) device_buffer, (const Sint16 *) device->work_buffer, br / (int) sizeof (Sint16));
+                        }
+                    }
+                }
+            }
+
+            if (!mixed) {
+                SDL_memset(device_buffer, device->silence_value, buffer_size);
+            }
         } else {  // need to actually mix (or silence the buffer)
             float *final_mix_buffer = (float *) ((device->spec.format == SDL_AUDIO_F32) ? device_buffer : device->mix_buffer);
             const int needed_samples = buffer_size / SDL_AUDIO_BYTESIZE(device->spec.format);
@@ -1063,55 +1579,28 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
             SDL_memset(final_mix_buffer, '\0', work_buffer_size);  // start with silence.
 
             for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
-                if (SDL_AtomicGet(&logdev->paused)) {
-                    continue;  // paused? Skip this logical device.
-                }
-
-                const SDL_AudioPostmixCallback postmix = logdev->postmix;
-                float *mix_buffer = final_mix_buffer;
-                if (postmix) {
-                    mix_buffer = device->postmix_buffer;
-                    SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
-                }
-
-                for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
-                    // We should have updated this elsewhere if the format changed!
-                    SDL_assert(AUDIO_SPECS_EQUAL(stream->dst_spec, outspec));
-
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamData(stream, device->work_buffer, work_buffer_size);
-                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
-                        failed = SDL_TRUE;
-                        break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
-                    }
-                }
-
-                if (postmix) {
-                    SDL_assert(mix_buffer == device->postmix_buffer);
-                    postmix(logdev->postmix_userdata, &outspec, mix_buffer, work_buffer_size);
-                    MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size);
+                if (!logdev->parent) {  // submix buses get mixed by their parent.
+                    MixLogicalAudioDevice(device, logdev, 0, final_mix_buffer, work_buffer_size, &outspec, &failed);
                 }
             }
 
             if (((Uint8 *) final_mix_buffer) != device_buffer) {
-                // !!! FIXME: we can't promise the device buf is aligned/padded for SIMD.
-                //ConvertAudio(needed_samples * device->spec.channels, final_mix_buffer, SDL_AUDIO_F32, device->spec.channels, device_buffer, device->spec.format, device->spec.channels, device->work_buffer);
-                ConvertAudio(needed_samples / device->spec.channels, final_mix_buffer, SDL_AUDIO_F32, device->spec.channels, device->work_buffer, device->spec.format, device->spec.channels, NULL);
-                SDL_memcpy(device_buffer, device->work_buffer, buffer_size);
+                // Same channel count, so this is a single pass from float32 (plus an in-place byteswap if needed), writing no more than buffer_size bytes.
+                //  The converters use unaligned loads and stores, so the device buffer doesn't need to be aligned for SIMD.
+                ConvertAudio(needed_samples / device->spec.channels, final_mix_buffer, SDL_AUDIO_F32, device->spec.channels, device_buffer, device->spec.format, device->spec.channels, NULL, NULL, NULL);
             }
         }
 
+        UpdateAudioThreadStats(device, start_ns, buffer_size);
+
         // PlayDevice SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice instead!
         if (device->PlayDevice(device, device_buffer, buffer_size) < 0) {
             failed = SDL_TRUE;
         }
     }
 
+    SDL_TRACE_END("Output audio iteration");
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1158,6 +1647,63 @@ void SDL_CaptureAudioThreadSetup(SDL_AudioDevice *device)
 {
     SDL_assert(device->iscapture);
     current_audio.impl.ThreadInit(device);
+    ApplyAudioThreadProperties(device);
+}
+
+// A captured buffer that bound streams queue without copying. The device holds one reference, each stream's queued track holds another.
+typedef struct SDL_AudioCaptureSlot
+{
+    SDL_AtomicInt refcount;
+    int size;
+    Uint8 data[1];
+} SDL_AudioCaptureSlot;
+
+// An SDL_AudioStreamDataCompleteCallback, called when a stream is done with the captured data (or the data is cleared or the stream destroyed).
+static void SDLCALL ReleaseAudioCaptureSlot(void *userdata, const void *buf, int buflen)
+{
+    SDL_AudioCaptureSlot *slot = (SDL_AudioCaptureSlot *) userdata;
+    if (SDL_AtomicDecRef(&slot->refcount)) {
+        SDL_free(slot);
+    }
+}
+
+// device should be locked. Drops the device's reference on every slot; slots still queued in streams are freed when the streams release them.
+static void FreeAudioCaptureSlots(SDL_AudioDevice *device)
+{
+    for (int i = 0; i < SDL_AUDIO_CAPTURE_SLOTS; i++) {
+        if (device->capture_slots[i]) {
+            ReleaseAudioCaptureSlot(device->capture_slots[i], NULL, 0);
+            device->capture_slots[i] = NULL;
+        }
+    }
+}
+
+// device should be locked. Returns a slot no stream is still reading from, or NULL if they're all in use.
+static SDL_AudioCaptureSlot *GetFreeAudioCaptureSlot(SDL_AudioDevice *device)
+{
+    for (int i = 0; i < SDL_AUDIO_CAPTURE_SLOTS; i++) {
+        SDL_AudioCaptureSlot *slot = device->capture_slots[i];
+        if (slot) {
+            // streams only ever drop references, so if we hold the only one, nothing else can pick it up.
+            if (SDL_AtomicGet(&slot->refcount) != 1) {
+                continue;
+            } else if (slot->size >= device->buffer_size) {
+                return slot;
+            }
+            ReleaseAudioCaptureSlot(slot, NULL, 0);  // too small after a format change, replace it.
+            device->capture_slots[i] = NULL;
+        }
+
+        // this allocates on the device thread, but only until the ring fills up.
+        slot = (SDL_AudioCaptureSlot *) SDL_malloc(sizeof (SDL_AudioCaptureSlot) + device->buffer_size);
+        if (slot) {
+            SDL_AtomicSet(&slot->refcount, 1);
+            slot->size = device->buffer_size;
+            device->capture_slots[i] = slot;
+        }
+        return slot;
+    }
+    return NULL;
 }
 
 SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
@@ -1171,22 +1717,30 @@ SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
         return SDL_FALSE;  // we're done, shut it down.
     }
 
+    SDL_TRACE_BEGIN("Capture audio iteration");
+
+    const Uint64 start_ns = SDL_GetTicksNS();
     SDL_bool failed = SDL_FALSE;
 
     if (!device->logical_devices) {
         device->FlushCapture(device); // nothing wants data, dump anything pending.
     } else {
+        // capture into a shared slot if one is free, so bound streams can queue it without each making a copy.
+        SDL_AudioCaptureSlot *slot = GetFreeAudioCaptureSlot(device);
+        Uint8 *capture_buffer = slot ? slot->data : device->work_buffer;
+
         // this SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitCaptureDevice!
-        int br = device->CaptureFromDevice(device, device->work_buffer, device->buffer_size);
+        int br = device->CaptureFromDevice(device, capture_buffer, device->buffer_size);
         if (br < 0) {  // uhoh, device failed for some reason!
             failed = SDL_TRUE;
         } else if (br > 0) {  // queue the new data to each bound stream.
+            const int captured = br;  // br changes below if there's a postmix callback.
             for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
                 if (SDL_AtomicGet(&logdev->paused)) {
                     continue;  // paused? Skip this logical device.
                 }
 
-                void *output_buffer = device->work_buffer;
+                void *output_buffer = capture_buffer;
 
                 // I don't know why someone would want a postmix on a capture device, but we offer it for API consistency.
                 if (logdev->postmix) {
@@ -1198,10 +1752,13 @@ SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
                     output_buffer = device->postmix_buffer;
                     const int frames = br / SDL_AUDIO_FRAMESIZE(device->spec);
                     br = frames * SDL_AUDIO_FRAMESIZE(outspec);
-                    ConvertAudio(frames, device->work_buffer, device->spec.format, outspec.channels, device->postmix_buffer, SDL_AUDIO_F32, outspec.channels, NULL);
+                    ConvertAudio(frames, capture_buffer, device->spec.format, outspec.channels, device->postmix_buffer, SDL_AUDIO_F32, outspec.channels, NULL, NULL, NULL);
                     logdev->postmix(logdev->postmix_userdata, &outspec, device->postmix_buffer, br);
                 }
 
+                // the postmix buffer gets overwritten by the next logical device, so only the raw capture can be shared.
+                SDL_AudioCaptureSlot *shared_slot = (output_buffer == capture_buffer) ? slot : NULL;
+
                 for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
                     // We should have updated this elsewhere if the format changed!
                     SDL_assert(stream->src_spec.format == (logdev->postmix ? SDL_AUDIO_F32 : device->spec.format));
@@ -1212,16 +1769,31 @@ SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
                        for iterating here because the binding linked list can only change while the device lock is held.
                        (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
                        the same stream to different devices at the same time, though.) */
-                    if (SDL_PutAudioStreamData(stream, output_buffer, br) < 0) {
+                    int rc;
+                    if (shared_slot) {
+                        SDL_AtomicIncRef(&shared_slot->refcount);  // released when the stream is done with this data.
+                        rc = SDL_PutAudioStreamDataNoCopy(stream, output_buffer, br, ReleaseAudioCaptureSlot, shared_slot);
+                        if (rc < 0) {
+                            SDL_AtomicDecRef(&shared_slot->refcount);  // the stream didn't take it, so the callback won't fire.
+                        }
+                    } else {
+                        rc = SDL_PutAudioStreamData(stream, output_buffer, br);
+                    }
+
+                    if (rc < 0) {
                         // oh crud, we probably ran out of memory. This is possibly an overreaction to kill the audio device, but it's likely the whole thing is going down in a moment anyhow.
                         failed = SDL_TRUE;
                         break;
                     }
                 }
             }
+
+            UpdateAudioThreadStats(device, start_ns, captured);
         }
     }
 
+    SDL_TRACE_END("Capture audio iteration");
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1389,6 +1961,39 @@ int SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int *
     return retval;
 }
 
+SDL_PropertiesID SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid)
+{
+    SDL_PropertiesID retval = 0;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        if (device->props == 0) {
+            device->props = SDL_CreateProperties();
+        }
+        retval = device->props;
+        if (retval) {
+            // refresh these every time, since the device might have been reopened (or the backend renegotiated things) since the last query.
+            const int latency_frames = SDL_AtomicGet(&device->latency_frames);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.latency_frames", (latency_frames > 0) ? latency_frames : device->sample_frames);
+            SDL_SetBooleanProperty(retval, "SDL.audio.device.low_latency", device->currently_opened && device->low_latency);
+            SDL_SetBooleanProperty(retval, "SDL.audio.device.exclusive", device->currently_opened && device->exclusive);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.iterations", (Sint64) device->stats.iterations);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.mix_ns", (Sint64) device->stats.mix_ns);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.max_mix_ns", (Sint64) device->stats.max_mix_ns);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.average_mix_ns", device->stats.iterations ? (Sint64) (device->stats.total_mix_ns / device->stats.iterations) : 0);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.wait_ns", (Sint64) device->stats.wait_ns);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.max_wait_ns", (Sint64) device->stats.max_wait_ns);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.streams", device->stats.streams);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.late_buffers", (Sint64) device->stats.late_buffers);
+            SDL_SetNumberProperty(retval, "SDL.audio.device.stats.xruns", SDL_AtomicGet(&device->xruns));
+            SDL_SetBooleanProperty(retval, "SDL.audio.device.thread.priority_applied", device->currently_opened && SDL_AtomicGet(&device->thread_priority_applied));
+            SDL_SetBooleanProperty(retval, "SDL.audio.device.thread.cpu_applied", device->currently_opened && SDL_AtomicGet(&device->thread_cpu_applied));
+        }
+    }
+    ReleaseAudioDevice(device);
+
+    return retval;
+}
+
 // this is awkward, but this makes sure we can release the device lock
 //  so the device thread can terminate but also not have two things
 //  race to close or open the device while the lock is unprotected.
@@ -1423,6 +2028,9 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
         device->hidden = NULL;  // just in case.
     }
 
+    DestroyAudioMixPool(device->mix_pool);  // nothing is mixing anymore.
+    device->mix_pool = NULL;
+
     SDL_LockMutex(device->lock);
     SDL_AtomicSet(&device->shutdown, 0);  // ready to go again.
     SDL_BroadcastCondition(device->close_cond);  // release anyone waiting in SerializePhysicalDeviceClose; they'll still block until we release device->lock, though.
@@ -1436,8 +2044,14 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_aligned_free(device->postmix_buffer);
     device->postmix_buffer = NULL;
 
+    FreeSubmixBuffers(device);
+    FreeAudioCaptureSlots(device);
+
     SDL_copyp(&device->spec, &device->default_spec);
     device->sample_frames = 0;
+    device->low_latency = SDL_FALSE;
+    device->exclusive = SDL_FALSE;
+    SDL_AtomicSet(&device->latency_frames, 0);
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
 }
 
@@ -1559,7 +2173,18 @@ static int OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
     device->spec.format = (SDL_AUDIO_BITSIZE(device->default_spec.format) >= SDL_AUDIO_BITSIZE(spec.format)) ? device->default_spec.format : spec.format;
     device->spec.freq = SDL_max(device->default_spec.freq, spec.freq);
     device->spec.channels = SDL_max(device->default_spec.channels, spec.channels);
-    device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq);
+
+    // Backends look at these during OpenDevice, and clear them if they can't (or won't) honor the request.
+    const char *latency_hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_LOW_LATENCY);
+    device->low_latency = SDL_GetStringBoolean(latency_hint, SDL_FALSE);
+    device->exclusive = (current_audio.impl.SupportsExclusiveAccess && latency_hint && (SDL_strcasecmp(latency_hint, "exclusive") == 0)) ? SDL_TRUE : SDL_FALSE;
+    SDL_AtomicSet(&device->latency_frames, 0);
+    SDL_zero(device->stats);
+    SDL_AtomicSet(&device->xruns, 0);
+    SDL_AtomicSet(&device->thread_priority_applied, 0);
+    SDL_AtomicSet(&device->thread_cpu_applied, 0);
+
+    device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq, device->low_latency);
     SDL_UpdatedAudioDeviceFormat(device);  // start this off sane.
 
     device->currently_opened = SDL_TRUE;  // mark this true even if impl.OpenDevice fails, so we know to clean up.
@@ -1585,6 +2210,10 @@ static int OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
         }
     }
 
+    if (!device->iscapture) {
+        device->mix_pool = CreateAudioMixPool(device);  // if this fails, we mix on the device thread.
+    }
+
     // Start the audio thread if necessary
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         const size_t stacksize = 0;  // just take the system default, since audio streams might have callbacks.
@@ -1636,6 +2265,7 @@ SDL_AudioDeviceID SDL_OpenAudioDevice(SDL_AudioDeviceID devid, const SDL_AudioSp
         } else {
             RefPhysicalAudioDevice(device);  // unref'd on successful SDL_CloseAudioDevice
             SDL_AtomicSet(&logdev->paused, 0);
+            logdev->gain = 1.0f;
             retval = logdev->instance_id = AssignAudioDeviceInstanceId(device->iscapture, /*islogical=*/SDL_TRUE);
             logdev->physical_device = device;
             logdev->opened_as_default = wants_default;
@@ -1701,15 +2331,12 @@ int SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallbac
     SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid, &device);
     int retval = 0;
     if (logdev) {
-        if (callback && !device->postmix_buffer) {
-            device->postmix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
-            if (!device->postmix_buffer) {
-                retval = SDL_OutOfMemory();
-            }
-        }
-
-        if (retval == 0) {
-            logdev->postmix = callback;
+        const SDL_AudioPostmixCallback orig_callback = logdev->postmix;
+        logdev->postmix = callback;
+        retval = AllocateAudioMixBuffers(device);
+        if (retval < 0) {
+            logdev->postmix = orig_callback;
+        } else {
             logdev->postmix_userdata = userdata;
 
             if (device->iscapture) {
@@ -1729,6 +2356,82 @@ int SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallbac
     return retval;
 }
 
+SDL_AudioDeviceID SDL_OpenAudioSubmix(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = NULL;
+    SDL_LogicalAudioDevice *parent = ObtainLogicalAudioDevice(devid, &device);
+    SDL_LogicalAudioDevice *logdev = NULL;
+    SDL_AudioDeviceID retval = 0;
+
+    if (parent) {
+        if (device->iscapture) {
+            SDL_SetError("Submix buses are only available on playback devices");
+        } else if ((logdev = (SDL_LogicalAudioDevice *) SDL_calloc(1, sizeof (SDL_LogicalAudioDevice))) == NULL) {
+            SDL_OutOfMemory();
+        } else {
+            RefPhysicalAudioDevice(device);  // unref'd on successful SDL_CloseAudioDevice
+            SDL_AtomicSet(&logdev->paused, 0);
+            logdev->gain = 1.0f;
+            retval = logdev->instance_id = AssignAudioDeviceInstanceId(device->iscapture, /*islogical=*/SDL_TRUE);
+            logdev->physical_device = device;
+            logdev->opened_as_default = parent->opened_as_default;  // so the whole bus tree migrates to a new default device together.
+            logdev->parent = parent;
+            logdev->next = device->logical_devices;
+            device->logical_devices->prev = logdev;
+            device->logical_devices = logdev;
+            UpdateAudioStreamFormatsPhysical(device);
+        }
+    }
+    ReleaseAudioDevice(device);
+
+    if (retval) {
+        SDL_LockRWLockForWriting(current_audio.device_hash_lock);
+        const SDL_bool inserted = SDL_InsertIntoHashTable(current_audio.device_hash, (const void *) (uintptr_t) retval, logdev);
+        SDL_UnlockRWLock(current_audio.device_hash_lock);
+        if (!inserted) {
+            SDL_CloseAudioDevice(retval);
+            retval = 0;
+        }
+    }
+
+    return retval;
+}
+
+int SDL_SetAudioDeviceGain(SDL_AudioDeviceID devid, float gain)
+{
+    if (gain < 0.0f) {
+        return SDL_InvalidParamError("gain");
+    }
+
+    SDL_AudioDevice *device = NULL;
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid, &device);
+    int retval = -1;  // ObtainLogicalAudioDevice will have set an error.
+    if (logdev) {
+        if (device->iscapture) {
+            retval = SDL_SetError("Gain is only available on playback devices");
+        } else {
+            const float orig_gain = logdev->gain;
+            logdev->gain = gain;
+            retval = AllocateAudioMixBuffers(device);
+            if (retval < 0) {
+                logdev->gain = orig_gain;
+            }
+            UpdateAudioStreamFormatsPhysical(device);
+        }
+    }
+    ReleaseAudioDevice(device);
+    return retval;
+}
+
+float SDL_GetAudioDeviceGain(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = NULL;
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid, &device);
+    const float retval = logdev ? logdev->gain : -1.0f;
+    ReleaseAudioDevice(device);
+    return retval;
+}
+
 int SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream **streams, int num_streams)
 {
     const SDL_bool islogical = !(devid & (1<<1));
@@ -2162,12 +2865,11 @@ int SDL_AudioDeviceFormatChangedAlreadyLocked(SDL_AudioDevice *device, const SDL
             kill_device = SDL_TRUE;
         }
 
-        if (device->postmix_buffer) {
-            SDL_aligned_free(device->postmix_buffer);
-            device->postmix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
-            if (!device->postmix_buffer) {
-                kill_device = SDL_TRUE;
-            }
+        SDL_aligned_free(device->postmix_buffer);
+        device->postmix_buffer = NULL;
+        FreeSubmixBuffers(device);
+        if (AllocateAudioMixBuffers(device) < 0) {
+            kill_device = SDL_TRUE;
         }
 
         SDL_aligned_free(device->mix_buffer);
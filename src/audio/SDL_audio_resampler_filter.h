@@ -26,6 +26,8 @@
 #define RESAMPLER_BITS_PER_ZERO_CROSSING ((RESAMPLER_BITS_PER_SAMPLE / 2) + 1)
 #define RESAMPLER_SAMPLES_PER_ZERO_CROSSING (1 << RESAMPLER_BITS_PER_ZERO_CROSSING)
 #define RESAMPLER_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_ZERO_CROSSINGS)
+#define RESAMPLER_HQ_ZERO_CROSSINGS 12
+#define RESAMPLER_HQ_FILTER_SIZE (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_HQ_ZERO_CROSSINGS)
 
 static const float ResamplerFilter[RESAMPLER_FILTER_SIZE] = {
      1.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,-0.000000000f,
@@ -542,3 +544,518 @@ static const float ResamplerFilter[RESAMPLER_FILTER_SIZE] = {
      0.001688435f,-0.000531434f, 0.000152351f,-0.000027682f, 0.000001057f,
 };
 
+static const float ResamplerHQFilter[RESAMPLER_HQ_FILTER_SIZE] = {
+     1.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,-0.000000000f, 0.000000000f,
+     0.999993599f,-0.001885396f, 0.000853470f,-0.000480401f, 0.000282797f,-0.000164143f, 0.000090953f,-0.000046897f, 0.000021887f,-0.000008897f, 0.000002947f,-0.000000682f,
+     0.999974395f,-0.003762895f, 0.001704796f,-0.000959774f, 0.000564998f,-0.000327919f, 0.000181682f,-0.000093664f, 0.000043703f,-0.000017759f, 0.000005880f,-0.000001360f,
+     0.999942389f,-0.005632471f, 0.002553951f,-0.001438103f, 0.000846592f,-0.000491323f, 0.000272184f,-0.000140297f, 0.000065447f,-0.000026587f, 0.000008798f,-0.000002033f,
+     0.999897581f,-0.007494097f, 0.003400910f,-0.001915372f, 0.001127571f,-0.000654348f, 0.000362455f,-0.000186796f, 0.000087119f,-0.000035379f, 0.000011702f,-0.000002701f,
+     0.999839973f,-0.009347749f, 0.004245647f,-0.002391566f, 0.001407925f,-0.000816990f, 0.000452492f,-0.000233160f, 0.000108717f,-0.000044136f, 0.000014591f,-0.000003365f,
+     0.999769566f,-0.011193401f, 0.005088136f,-0.002866667f, 0.001687644f,-0.000979243f, 0.000542293f,-0.000279386f, 0.000130242f,-0.000052857f, 0.000017465f,-0.000004024f,
+     0.999686362f,-0.013031028f, 0.005928351f,-0.003340661f, 0.001966718f,-0.001141101f, 0.000631854f,-0.000325473f, 0.000151692f,-0.000061543f, 0.000020325f,-0.000004678f,
+     0.999590363f,-0.014860605f, 0.006766267f,-0.003813530f, 0.002245138f,-0.001302559f, 0.000721173f,-0.000371420f, 0.000173067f,-0.000070192f, 0.000023169f,-0.000005327f,
+     0.999481571f,-0.016682108f, 0.007601857f,-0.004285261f, 0.002522895f,-0.001463611f, 0.000810246f,-0.000417225f, 0.000194366f,-0.000078805f, 0.000025999f,-0.000005972f,
+     0.999359988f,-0.018495513f, 0.008435098f,-0.004755836f, 0.002799979f,-0.001624252f, 0.000899071f,-0.000462887f, 0.000215589f,-0.000087382f, 0.000028814f,-0.000006612f,
+     0.999225617f,-0.020300795f, 0.009265963f,-0.005225241f, 0.003076381f,-0.001784476f, 0.000987644f,-0.000508404f, 0.000236734f,-0.000095921f, 0.000031614f,-0.000007247f,
+     0.999078462f,-0.022097931f, 0.010094428f,-0.005693459f, 0.003352091f,-0.001944279f, 0.001075963f,-0.000553775f, 0.000257802f,-0.000104424f, 0.000034399f,-0.000007878f,
+     0.998918526f,-0.023886897f, 0.010920468f,-0.006160476f, 0.003627100f,-0.002103654f, 0.001164024f,-0.000598999f, 0.000278791f,-0.000112889f, 0.000037169f,-0.000008503f,
+     0.998745813f,-0.025667669f, 0.011744059f,-0.006626276f, 0.003901400f,-0.002262596f, 0.001251825f,-0.000644073f, 0.000299702f,-0.000121317f, 0.000039923f,-0.000009124f,
+     0.998560327f,-0.027440226f, 0.012565175f,-0.007090843f, 0.004174979f,-0.002421100f, 0.001339364f,-0.000688997f, 0.000320532f,-0.000129707f, 0.000042662f,-0.000009740f,
+     0.998362072f,-0.029204544f, 0.013383792f,-0.007554163f, 0.004447831f,-0.002579161f, 0.001426636f,-0.000733769f, 0.000341283f,-0.000138059f, 0.000045386f,-0.000010351f,
+     0.998151053f,-0.030960600f, 0.014199886f,-0.008016220f, 0.004719944f,-0.002736774f, 0.001513640f,-0.000778388f, 0.000361953f,-0.000146373f, 0.000048095f,-0.000010958f,
+     0.997927275f,-0.032708372f, 0.015013433f,-0.008477000f, 0.004991312f,-0.002893933f, 0.001600372f,-0.000822852f, 0.000382541f,-0.000154649f, 0.000050788f,-0.000011560f,
+     0.997690743f,-0.034447839f, 0.015824409f,-0.008936486f, 0.005261923f,-0.003050633f, 0.001686830f,-0.000867160f, 0.000403047f,-0.000162886f, 0.000053466f,-0.000012157f,
+     0.997441463f,-0.036178978f, 0.016632790f,-0.009394666f, 0.005531770f,-0.003206868f, 0.001773011f,-0.000911311f, 0.000423471f,-0.000171084f, 0.000056128f,-0.000012749f,
+     0.997179441f,-0.037901768f, 0.017438553f,-0.009851523f, 0.005800844f,-0.003362635f, 0.001858911f,-0.000955303f, 0.000443811f,-0.000179243f, 0.000058775f,-0.000013336f,
+     0.996904683f,-0.039616187f, 0.018241673f,-0.010307042f, 0.006069135f,-0.003517927f, 0.001944530f,-0.000999135f, 0.000464067f,-0.000187363f, 0.000061406f,-0.000013919f,
+     0.996617195f,-0.041322215f, 0.019042128f,-0.010761210f, 0.006336635f,-0.003672740f, 0.002029862f,-0.001042805f, 0.000484240f,-0.000195444f, 0.000064022f,-0.000014497f,
+     0.996316985f,-0.043019831f, 0.019839894f,-0.011214012f, 0.006603335f,-0.003827069f, 0.002114907f,-0.001086312f, 0.000504327f,-0.000203485f, 0.000066621f,-0.000015070f,
+     0.996004059f,-0.044709014f, 0.020634949f,-0.011665433f, 0.006869226f,-0.003980908f, 0.002199661f,-0.001129656f, 0.000524328f,-0.000211486f, 0.000069205f,-0.000015638f,
+     0.995678424f,-0.046389744f, 0.021427269f,-0.012115459f, 0.007134300f,-0.004134253f, 0.002284121f,-0.001172834f, 0.000544244f,-0.000219447f, 0.000071773f,-0.000016201f,
+     0.995340089f,-0.048062002f, 0.022216831f,-0.012564075f, 0.007398548f,-0.004287098f, 0.002368285f,-0.001215845f, 0.000564073f,-0.000227368f, 0.000074326f,-0.000016760f,
+     0.994989061f,-0.049725766f, 0.023003613f,-0.013011267f, 0.007661962f,-0.004439439f, 0.002452151f,-0.001258688f, 0.000583815f,-0.000235249f, 0.000076862f,-0.000017314f,
+     0.994625349f,-0.051381018f, 0.023787593f,-0.013457021f, 0.007924533f,-0.004591271f, 0.002535715f,-0.001301362f, 0.000603469f,-0.000243089f, 0.000079383f,-0.000017863f,
+     0.994248962f,-0.053027738f, 0.024568747f,-0.013901324f, 0.008186252f,-0.004742589f, 0.002618975f,-0.001343866f, 0.000623035f,-0.000250888f, 0.000081887f,-0.000018407f,
+     0.993859907f,-0.054665908f, 0.025347055f,-0.014344160f, 0.008447111f,-0.004893388f, 0.002701929f,-0.001386197f, 0.000642512f,-0.000258646f, 0.000084376f,-0.000018947f,
+     0.993458195f,-0.056295508f, 0.026122493f,-0.014785517f, 0.008707102f,-0.005043663f, 0.002784573f,-0.001428356f, 0.000661899f,-0.000266363f, 0.000086848f,-0.000019481f,
+     0.993043835f,-0.057916521f, 0.026895041f,-0.015225379f, 0.008966216f,-0.005193410f, 0.002866906f,-0.001470340f, 0.000681197f,-0.000274039f, 0.000089305f,-0.000020011f,
+     0.992616836f,-0.059528927f, 0.027664676f,-0.015663735f, 0.009224446f,-0.005342624f, 0.002948924f,-0.001512149f, 0.000700405f,-0.000281673f, 0.000091745f,-0.000020536f,
+     0.992177209f,-0.061132709f, 0.028431377f,-0.016100569f, 0.009481782f,-0.005491299f, 0.003030626f,-0.001553781f, 0.000719521f,-0.000289266f, 0.000094169f,-0.000021057f,
+     0.991724964f,-0.062727850f, 0.029195122f,-0.016535868f, 0.009738218f,-0.005639433f, 0.003112009f,-0.001595235f, 0.000738547f,-0.000296817f, 0.000096577f,-0.000021572f,
+     0.991260112f,-0.064314331f, 0.029955890f,-0.016969619f, 0.009993744f,-0.005787019f, 0.003193070f,-0.001636510f, 0.000757480f,-0.000304326f, 0.000098968f,-0.000022083f,
+     0.990782664f,-0.065892136f, 0.030713660f,-0.017401809f, 0.010248352f,-0.005934053f, 0.003273806f,-0.001677605f, 0.000776321f,-0.000311792f, 0.000101344f,-0.000022589f,
+     0.990292631f,-0.067461247f, 0.031468412f,-0.017832424f, 0.010502035f,-0.006080532f, 0.003354217f,-0.001718518f, 0.000795069f,-0.000319217f, 0.000103703f,-0.000023090f,
+     0.989790024f,-0.069021648f, 0.032220124f,-0.018261451f, 0.010754785f,-0.006226449f, 0.003434298f,-0.001759249f, 0.000813724f,-0.000326599f, 0.000106045f,-0.000023586f,
+     0.989274856f,-0.070573322f, 0.032968776f,-0.018688876f, 0.011006594f,-0.006371801f, 0.003514048f,-0.001799796f, 0.000832285f,-0.000333938f, 0.000108372f,-0.000024078f,
+     0.988747139f,-0.072116254f, 0.033714347f,-0.019114688f, 0.011257453f,-0.006516582f, 0.003593464f,-0.001840157f, 0.000850751f,-0.000341234f, 0.000110682f,-0.000024565f,
+     0.988206885f,-0.073650427f, 0.034456817f,-0.019538872f, 0.011507356f,-0.006660790f, 0.003672544f,-0.001880333f, 0.000869123f,-0.000348488f, 0.000112975f,-0.000025047f,
+     0.987654106f,-0.075175825f, 0.035196166f,-0.019961416f, 0.011756294f,-0.006804419f, 0.003751285f,-0.001920322f, 0.000887400f,-0.000355698f, 0.000115252f,-0.000025524f,
+     0.987088817f,-0.076692433f, 0.035932373f,-0.020382307f, 0.012004259f,-0.006947465f, 0.003829686f,-0.001960122f, 0.000905581f,-0.000362865f, 0.000117513f,-0.000025997f,
+     0.986511030f,-0.078200237f, 0.036665420f,-0.020801533f, 0.012251245f,-0.007089923f, 0.003907743f,-0.001999733f, 0.000923665f,-0.000369989f, 0.000119757f,-0.000026465f,
+     0.985920759f,-0.079699220f, 0.037395287f,-0.021219080f, 0.012497243f,-0.007231789f, 0.003985455f,-0.002039153f, 0.000941653f,-0.000377069f, 0.000121984f,-0.000026928f,
+     0.985318017f,-0.081189369f, 0.038121953f,-0.021634937f, 0.012742246f,-0.007373060f, 0.004062820f,-0.002078382f, 0.000959545f,-0.000384106f, 0.000124195f,-0.000027386f,
+     0.984702820f,-0.082670668f, 0.038845399f,-0.022049091f, 0.012986247f,-0.007513730f, 0.004139835f,-0.002117419f, 0.000977338f,-0.000391098f, 0.000126389f,-0.000027839f,
+     0.984075181f,-0.084143105f, 0.039565607f,-0.022461530f, 0.013229238f,-0.007653795f, 0.004216497f,-0.002156261f, 0.000995034f,-0.000398047f, 0.000128567f,-0.000028288f,
+     0.983435116f,-0.085606664f, 0.040282558f,-0.022872241f, 0.013471211f,-0.007793252f, 0.004292806f,-0.002194909f, 0.001012632f,-0.000404952f, 0.000130728f,-0.000028732f,
+     0.982782639f,-0.087061332f, 0.040996232f,-0.023281212f, 0.013712160f,-0.007932096f, 0.004368758f,-0.002233361f, 0.001030130f,-0.000411812f, 0.000132872f,-0.000029172f,
+     0.982117766f,-0.088507097f, 0.041706610f,-0.023688431f, 0.013952076f,-0.008070322f, 0.004444351f,-0.002271617f, 0.001047530f,-0.000418628f, 0.000135000f,-0.000029606f,
+     0.981440512f,-0.089943944f, 0.042413675f,-0.024093886f, 0.014190954f,-0.008207928f, 0.004519583f,-0.002309674f, 0.001064830f,-0.000425400f, 0.000137111f,-0.000030036f,
+     0.980750894f,-0.091371861f, 0.043117408f,-0.024497566f, 0.014428786f,-0.008344909f, 0.004594453f,-0.002347533f, 0.001082030f,-0.000432127f, 0.000139205f,-0.000030462f,
+     0.980048928f,-0.092790836f, 0.043817790f,-0.024899458f, 0.014665564f,-0.008481260f, 0.004668958f,-0.002385192f, 0.001099130f,-0.000438809f, 0.000141282f,-0.000030882f,
+     0.979334630f,-0.094200855f, 0.044514804f,-0.025299551f, 0.014901282f,-0.008616979f, 0.004743095f,-0.002422651f, 0.001116129f,-0.000445447f, 0.000143343f,-0.000031298f,
+     0.978608017f,-0.095601908f, 0.045208431f,-0.025697833f, 0.015135932f,-0.008752060f, 0.004816863f,-0.002459907f, 0.001133027f,-0.000452039f, 0.000145387f,-0.000031709f,
+     0.977869107f,-0.096993981f, 0.045898655f,-0.026094293f, 0.015369509f,-0.008886500f, 0.004890260f,-0.002496961f, 0.001149824f,-0.000458587f, 0.000147414f,-0.000032116f,
+     0.977117916f,-0.098377064f, 0.046585456f,-0.026488920f, 0.015602004f,-0.009020296f, 0.004963284f,-0.002533812f, 0.001166518f,-0.000465089f, 0.000149425f,-0.000032518f,
+     0.976354463f,-0.099751145f, 0.047268819f,-0.026881701f, 0.015833411f,-0.009153442f, 0.005035933f,-0.002570457f, 0.001183110f,-0.000471546f, 0.000151418f,-0.000032915f,
+     0.975578766f,-0.101116214f, 0.047948725f,-0.027272626f, 0.016063724f,-0.009285936f, 0.005108204f,-0.002606898f, 0.001199600f,-0.000477958f, 0.000153395f,-0.000033307f,
+     0.974790842f,-0.102472258f, 0.048625158f,-0.027661684f, 0.016292935f,-0.009417774f, 0.005180097f,-0.002643132f, 0.001215987f,-0.000484324f, 0.000155355f,-0.000033695f,
+     0.973990710f,-0.103819269f, 0.049298101f,-0.028048863f, 0.016521038f,-0.009548952f, 0.005251608f,-0.002679159f, 0.001232270f,-0.000490644f, 0.000157298f,-0.000034079f,
+     0.973178389f,-0.105157235f, 0.049967537f,-0.028434153f, 0.016748027f,-0.009679466f, 0.005322736f,-0.002714977f, 0.001248450f,-0.000496919f, 0.000159224f,-0.000034457f,
+     0.972353899f,-0.106486146f, 0.050633449f,-0.028817543f, 0.016973894f,-0.009809312f, 0.005393479f,-0.002750587f, 0.001264526f,-0.000503148f, 0.000161133f,-0.000034831f,
+     0.971517258f,-0.107805993f, 0.051295821f,-0.029199022f, 0.017198634f,-0.009938487f, 0.005463835f,-0.002785986f, 0.001280497f,-0.000509331f, 0.000163025f,-0.000035201f,
+     0.970668487f,-0.109116767f, 0.051954637f,-0.029578579f, 0.017422240f,-0.010066988f, 0.005533803f,-0.002821175f, 0.001296364f,-0.000515468f, 0.000164901f,-0.000035565f,
+     0.969807605f,-0.110418457f, 0.052609880f,-0.029956204f, 0.017644706f,-0.010194810f, 0.005603380f,-0.002856152f, 0.001312126f,-0.000521559f, 0.000166760f,-0.000035926f,
+     0.968934633f,-0.111711055f, 0.053261535f,-0.030331886f, 0.017866025f,-0.010321951f, 0.005672564f,-0.002890917f, 0.001327782f,-0.000527604f, 0.000168601f,-0.000036281f,
+     0.968049591f,-0.112994553f, 0.053909586f,-0.030705616f, 0.018086191f,-0.010448406f, 0.005741355f,-0.002925469f, 0.001343333f,-0.000533603f, 0.000170426f,-0.000036632f,
+     0.967152500f,-0.114268941f, 0.054554017f,-0.031077382f, 0.018305198f,-0.010574172f, 0.005809749f,-0.002959806f, 0.001358778f,-0.000539555f, 0.000172234f,-0.000036979f,
+     0.966243382f,-0.115534212f, 0.055194813f,-0.031447174f, 0.018523040f,-0.010699246f, 0.005877746f,-0.002993929f, 0.001374117f,-0.000545461f, 0.000174025f,-0.000037321f,
+     0.965322257f,-0.116790358f, 0.055831959f,-0.031814983f, 0.018739710f,-0.010823625f, 0.005945343f,-0.003027835f, 0.001389349f,-0.000551320f, 0.000175799f,-0.000037658f,
+     0.964389147f,-0.118037370f, 0.056465439f,-0.032180798f, 0.018955204f,-0.010947304f, 0.006012539f,-0.003061526f, 0.001404474f,-0.000557133f, 0.000177556f,-0.000037991f,
+     0.963444074f,-0.119275242f, 0.057095239f,-0.032544610f, 0.019169514f,-0.011070282f, 0.006079333f,-0.003094999f, 0.001419492f,-0.000562900f, 0.000179296f,-0.000038320f,
+     0.962487061f,-0.120503966f, 0.057721344f,-0.032906409f, 0.019382635f,-0.011192553f, 0.006145721f,-0.003128254f, 0.001434403f,-0.000568619f, 0.000181019f,-0.000038644f,
+     0.961518129f,-0.121723535f, 0.058343739f,-0.033266184f, 0.019594561f,-0.011314116f, 0.006211704f,-0.003161291f, 0.001449206f,-0.000574292f, 0.000182726f,-0.000038963f,
+     0.960537303f,-0.122933943f, 0.058962410f,-0.033623927f, 0.019805286f,-0.011434967f, 0.006277278f,-0.003194108f, 0.001463901f,-0.000579918f, 0.000184415f,-0.000039278f,
+     0.959544604f,-0.124135183f, 0.059577342f,-0.033979628f, 0.020014805f,-0.011555102f, 0.006342443f,-0.003226705f, 0.001478488f,-0.000585497f, 0.000186088f,-0.000039589f,
+     0.958540056f,-0.125327249f, 0.060188522f,-0.034333277f, 0.020223112f,-0.011674519f, 0.006407197f,-0.003259081f, 0.001492967f,-0.000591029f, 0.000187743f,-0.000039895f,
+     0.957523683f,-0.126510135f, 0.060795935f,-0.034684866f, 0.020430201f,-0.011793214f, 0.006471538f,-0.003291235f, 0.001507337f,-0.000596514f, 0.000189382f,-0.000040196f,
+     0.956495509f,-0.127683836f, 0.061399568f,-0.035034384f, 0.020636067f,-0.011911185f, 0.006535465f,-0.003323167f, 0.001521598f,-0.000601952f, 0.000191004f,-0.000040493f,
+     0.955455558f,-0.128848346f, 0.061999407f,-0.035381823f, 0.020840704f,-0.012028428f, 0.006598976f,-0.003354876f, 0.001535749f,-0.000607343f, 0.000192609f,-0.000040786f,
+     0.954403853f,-0.130003659f, 0.062595439f,-0.035727174f, 0.021044107f,-0.012144940f, 0.006662070f,-0.003386361f, 0.001549792f,-0.000612687f, 0.000194197f,-0.000041074f,
+     0.953340421f,-0.131149772f, 0.063187651f,-0.036070428f, 0.021246271f,-0.012260719f, 0.006724745f,-0.003417623f, 0.001563724f,-0.000617983f, 0.000195768f,-0.000041358f,
+     0.952265286f,-0.132286679f, 0.063776029f,-0.036411576f, 0.021447190f,-0.012375761f, 0.006787000f,-0.003448659f, 0.001577547f,-0.000623232f, 0.000197322f,-0.000041638f,
+     0.951178473f,-0.133414376f, 0.064360560f,-0.036750609f, 0.021646858f,-0.012490064f, 0.006848833f,-0.003479469f, 0.001591260f,-0.000628434f, 0.000198860f,-0.000041913f,
+     0.950080008f,-0.134532859f, 0.064941232f,-0.037087519f, 0.021845272f,-0.012603624f, 0.006910243f,-0.003510054f, 0.001604862f,-0.000633589f, 0.000200380f,-0.000042184f,
+     0.948969916f,-0.135642124f, 0.065518032f,-0.037422297f, 0.022042425f,-0.012716439f, 0.006971229f,-0.003540412f, 0.001618354f,-0.000638696f, 0.000201884f,-0.000042450f,
+     0.947848224f,-0.136742167f, 0.066090948f,-0.037754935f, 0.022238313f,-0.012828506f, 0.007031788f,-0.003570542f, 0.001631735f,-0.000643755f, 0.000203371f,-0.000042713f,
+     0.946714957f,-0.137832986f, 0.066659968f,-0.038085424f, 0.022432930f,-0.012939822f, 0.007091920f,-0.003600444f, 0.001645005f,-0.000648767f, 0.000204841f,-0.000042970f,
+     0.945570143f,-0.138914576f, 0.067225078f,-0.038413756f, 0.022626272f,-0.013050385f, 0.007151624f,-0.003630118f, 0.001658163f,-0.000653732f, 0.000206294f,-0.000043224f,
+     0.944413809f,-0.139986936f, 0.067786269f,-0.038739924f, 0.022818334f,-0.013160191f, 0.007210897f,-0.003659562f, 0.001671211f,-0.000658649f, 0.000207730f,-0.000043473f,
+     0.943245981f,-0.141050062f, 0.068343527f,-0.039063918f, 0.023009111f,-0.013269239f, 0.007269739f,-0.003688777f, 0.001684147f,-0.000663519f, 0.000209150f,-0.000043718f,
+     0.942066687f,-0.142103952f, 0.068896841f,-0.039385731f, 0.023198598f,-0.013377525f, 0.007328149f,-0.003717761f, 0.001696971f,-0.000668340f, 0.000210553f,-0.000043959f,
+     0.940875955f,-0.143148604f, 0.069446200f,-0.039705356f, 0.023386790f,-0.013485047f, 0.007386124f,-0.003746515f, 0.001709684f,-0.000673115f, 0.000211939f,-0.000044196f,
+     0.939673812f,-0.144184016f, 0.069991593f,-0.040022784f, 0.023573684f,-0.013591803f, 0.007443664f,-0.003775037f, 0.001722284f,-0.000677841f, 0.000213308f,-0.000044428f,
+     0.938460286f,-0.145210187f, 0.070533008f,-0.040338008f, 0.023759273f,-0.013697790f, 0.007500768f,-0.003803328f, 0.001734773f,-0.000682520f, 0.000214661f,-0.000044656f,
+     0.937235407f,-0.146227116f, 0.071070434f,-0.040651020f, 0.023943554f,-0.013803005f, 0.007557435f,-0.003831386f, 0.001747149f,-0.000687151f, 0.000215997f,-0.000044880f,
+     0.935999203f,-0.147234800f, 0.071603862f,-0.040961812f, 0.024126523f,-0.013907446f, 0.007613662f,-0.003859212f, 0.001759412f,-0.000691735f, 0.000217316f,-0.000045100f,
+     0.934751702f,-0.148233240f, 0.072133279f,-0.041270379f, 0.024308174f,-0.014011110f, 0.007669450f,-0.003886804f, 0.001771563f,-0.000696271f, 0.000218619f,-0.000045315f,
+     0.933492935f,-0.149222435f, 0.072658677f,-0.041576711f, 0.024488504f,-0.014113996f, 0.007724796f,-0.003914162f, 0.001783601f,-0.000700759f, 0.000219905f,-0.000045527f,
+     0.932222930f,-0.150202384f, 0.073180044f,-0.041880803f, 0.024667508f,-0.014216101f, 0.007779701f,-0.003941286f, 0.001795526f,-0.000705199f, 0.000221174f,-0.000045734f,
+     0.930941717f,-0.151173088f, 0.073697371f,-0.042182647f, 0.024845182f,-0.014317422f, 0.007834162f,-0.003968175f, 0.001807338f,-0.000709592f, 0.000222427f,-0.000045937f,
+     0.929649327f,-0.152134546f, 0.074210648f,-0.042482236f, 0.025021522f,-0.014417958f, 0.007888178f,-0.003994830f, 0.001819037f,-0.000713937f, 0.000223663f,-0.000046136f,
+     0.928345789f,-0.153086759f, 0.074719865f,-0.042779563f, 0.025196524f,-0.014517706f, 0.007941749f,-0.004021248f, 0.001830623f,-0.000718234f, 0.000224883f,-0.000046331f,
+     0.927031134f,-0.154029728f, 0.075225012f,-0.043074622f, 0.025370183f,-0.014616664f, 0.007994874f,-0.004047431f, 0.001842095f,-0.000722483f, 0.000226086f,-0.000046522f,
+     0.925705393f,-0.154963454f, 0.075726080f,-0.043367405f, 0.025542496f,-0.014714830f, 0.008047551f,-0.004073378f, 0.001853453f,-0.000726685f, 0.000227273f,-0.000046709f,
+     0.924368596f,-0.155887937f, 0.076223060f,-0.043657907f, 0.025713459f,-0.014812201f, 0.008099780f,-0.004099087f, 0.001864698f,-0.000730839f, 0.000228443f,-0.000046892f,
+     0.923020776f,-0.156803180f, 0.076715943f,-0.043946121f, 0.025883068f,-0.014908777f, 0.008151558f,-0.004124560f, 0.001875830f,-0.000734945f, 0.000229596f,-0.000047071f,
+     0.921661964f,-0.157709183f, 0.077204720f,-0.044232041f, 0.026051319f,-0.015004553f, 0.008202887f,-0.004149795f, 0.001886847f,-0.000739003f, 0.000230734f,-0.000047246f,
+     0.920292190f,-0.158605949f, 0.077689382f,-0.044515659f, 0.026218209f,-0.015099529f, 0.008253764f,-0.004174792f, 0.001897751f,-0.000743014f, 0.000231854f,-0.000047417f,
+     0.918911489f,-0.159493480f, 0.078169921f,-0.044796971f, 0.026383733f,-0.015193703f, 0.008304189f,-0.004199551f, 0.001908541f,-0.000746977f, 0.000232959f,-0.000047584f,
+     0.917519891f,-0.160371778f, 0.078646328f,-0.045075971f, 0.026547888f,-0.015287073f, 0.008354160f,-0.004224071f, 0.001919216f,-0.000750892f, 0.000234047f,-0.000047747f,
+     0.916117429f,-0.161240847f, 0.079118596f,-0.045352651f, 0.026710671f,-0.015379636f, 0.008403678f,-0.004248353f, 0.001929778f,-0.000754760f, 0.000235119f,-0.000047906f,
+     0.914704136f,-0.162100688f, 0.079586716f,-0.045627007f, 0.026872078f,-0.015471392f, 0.008452740f,-0.004272395f, 0.001940225f,-0.000758579f, 0.000236174f,-0.000048061f,
+     0.913280045f,-0.162951305f, 0.080050680f,-0.045899032f, 0.027032106f,-0.015562337f, 0.008501346f,-0.004296197f, 0.001950558f,-0.000762352f, 0.000237214f,-0.000048212f,
+     0.911845189f,-0.163792702f, 0.080510480f,-0.046168722f, 0.027190751f,-0.015652471f, 0.008549496f,-0.004319760f, 0.001960777f,-0.000766076f, 0.000238237f,-0.000048359f,
+     0.910399603f,-0.164624882f, 0.080966110f,-0.046436070f, 0.027348010f,-0.015741791f, 0.008597189f,-0.004343083f, 0.001970881f,-0.000769753f, 0.000239243f,-0.000048503f,
+     0.908943318f,-0.165447848f, 0.081417561f,-0.046701071f, 0.027503880f,-0.015830297f, 0.008644423f,-0.004366166f, 0.001980871f,-0.000773383f, 0.000240234f,-0.000048642f,
+     0.907476370f,-0.166261606f, 0.081864827f,-0.046963720f, 0.027658357f,-0.015917985f, 0.008691198f,-0.004389007f, 0.001990746f,-0.000776965f, 0.000241209f,-0.000048778f,
+     0.905998793f,-0.167066159f, 0.082307900f,-0.047224011f, 0.027811439f,-0.016004855f, 0.008737514f,-0.004411608f, 0.002000507f,-0.000780499f, 0.000242167f,-0.000048910f,
+     0.904510621f,-0.167861513f, 0.082746775f,-0.047481939f, 0.027963122f,-0.016090905f, 0.008783369f,-0.004433968f, 0.002010153f,-0.000783986f, 0.000243109f,-0.000049039f,
+     0.903011889f,-0.168647671f, 0.083181443f,-0.047737500f, 0.028113403f,-0.016176134f, 0.008828763f,-0.004456087f, 0.002019685f,-0.000787425f, 0.000244036f,-0.000049163f,
+     0.901502632f,-0.169424639f, 0.083611898f,-0.047990688f, 0.028262280f,-0.016260539f, 0.008873695f,-0.004477964f, 0.002029102f,-0.000790818f, 0.000244946f,-0.000049284f,
+     0.899982885f,-0.170192423f, 0.084038135f,-0.048241499f, 0.028409749f,-0.016344120f, 0.008918165f,-0.004499599f, 0.002038405f,-0.000794162f, 0.000245841f,-0.000049401f,
+     0.898452683f,-0.170951027f, 0.084460147f,-0.048489928f, 0.028555808f,-0.016426874f, 0.008962171f,-0.004520992f, 0.002047593f,-0.000797460f, 0.000246719f,-0.000049514f,
+     0.896912063f,-0.171700459f, 0.084877927f,-0.048735970f, 0.028700454f,-0.016508801f, 0.009005714f,-0.004542143f, 0.002056666f,-0.000800710f, 0.000247582f,-0.000049624f,
+     0.895361059f,-0.172440723f, 0.085291471f,-0.048979620f, 0.028843684f,-0.016589899f, 0.009048793f,-0.004563051f, 0.002065625f,-0.000803912f, 0.000248428f,-0.000049730f,
+     0.893799709f,-0.173171826f, 0.085700772f,-0.049220875f, 0.028985496f,-0.016670167f, 0.009091407f,-0.004583717f, 0.002074469f,-0.000807068f, 0.000249259f,-0.000049832f,
+     0.892228048f,-0.173893775f, 0.086105826f,-0.049459730f, 0.029125887f,-0.016749603f, 0.009133555f,-0.004604141f, 0.002083199f,-0.000810177f, 0.000250075f,-0.000049931f,
+     0.890646113f,-0.174606577f, 0.086506625f,-0.049696180f, 0.029264855f,-0.016828207f, 0.009175238f,-0.004624321f, 0.002091813f,-0.000813238f, 0.000250874f,-0.000050026f,
+     0.889053941f,-0.175310238f, 0.086903166f,-0.049930222f, 0.029402396f,-0.016905976f, 0.009216454f,-0.004644259f, 0.002100314f,-0.000816252f, 0.000251658f,-0.000050117f,
+     0.887451569f,-0.176004765f, 0.087295444f,-0.050161851f, 0.029538509f,-0.016982910f, 0.009257203f,-0.004663953f, 0.002108699f,-0.000819220f, 0.000252426f,-0.000050205f,
+     0.885839035f,-0.176690167f, 0.087683453f,-0.050391064f, 0.029673192f,-0.017059007f, 0.009297484f,-0.004683404f, 0.002116971f,-0.000822140f, 0.000253179f,-0.000050290f,
+     0.884216375f,-0.177366451f, 0.088067189f,-0.050617857f, 0.029806441f,-0.017134267f, 0.009337298f,-0.004702612f, 0.002125127f,-0.000825014f, 0.000253916f,-0.000050370f,
+     0.882583627f,-0.178033625f, 0.088446647f,-0.050842226f, 0.029938255f,-0.017208688f, 0.009376643f,-0.004721577f, 0.002133170f,-0.000827840f, 0.000254637f,-0.000050448f,
+     0.880940830f,-0.178691697f, 0.088821823f,-0.051064167f, 0.030068632f,-0.017282270f, 0.009415520f,-0.004740298f, 0.002141097f,-0.000830620f, 0.000255343f,-0.000050522f,
+     0.879288022f,-0.179340675f, 0.089192713f,-0.051283677f, 0.030197570f,-0.017355010f, 0.009453928f,-0.004758775f, 0.002148911f,-0.000833354f, 0.000256034f,-0.000050592f,
+     0.877625240f,-0.179980569f, 0.089559313f,-0.051500753f, 0.030325066f,-0.017426909f, 0.009491866f,-0.004777009f, 0.002156610f,-0.000836040f, 0.000256709f,-0.000050659f,
+     0.875952524f,-0.180611387f, 0.089921619f,-0.051715391f, 0.030451119f,-0.017497965f, 0.009529334f,-0.004794999f, 0.002164194f,-0.000838681f, 0.000257369f,-0.000050722f,
+     0.874269912f,-0.181233138f, 0.090279627f,-0.051927588f, 0.030575726f,-0.017568178f, 0.009566332f,-0.004812746f, 0.002171665f,-0.000841274f, 0.000258013f,-0.000050782f,
+     0.872577444f,-0.181845832f, 0.090633334f,-0.052137340f, 0.030698887f,-0.017637545f, 0.009602860f,-0.004830248f, 0.002179021f,-0.000843821f, 0.000258642f,-0.000050839f,
+     0.870875159f,-0.182449477f, 0.090982736f,-0.052344646f, 0.030820598f,-0.017706068f, 0.009638917f,-0.004847507f, 0.002186264f,-0.000846322f, 0.000259257f,-0.000050892f,
+     0.869163096f,-0.183044086f, 0.091327830f,-0.052549501f, 0.030940859f,-0.017773744f, 0.009674503f,-0.004864522f, 0.002193392f,-0.000848777f, 0.000259855f,-0.000050942f,
+     0.867441295f,-0.183629666f, 0.091668614f,-0.052751903f, 0.031059667f,-0.017840573f, 0.009709617f,-0.004881294f, 0.002200406f,-0.000851185f, 0.000260439f,-0.000050989f,
+     0.865709796f,-0.184206228f, 0.092005084f,-0.052951850f, 0.031177021f,-0.017906554f, 0.009744260f,-0.004897821f, 0.002207307f,-0.000853548f, 0.000261008f,-0.000051032f,
+     0.863968639f,-0.184773784f, 0.092337237f,-0.053149338f, 0.031292920f,-0.017971687f, 0.009778431f,-0.004914105f, 0.002214093f,-0.000855864f, 0.000261562f,-0.000051072f,
+     0.862217865f,-0.185332343f, 0.092665072f,-0.053344365f, 0.031407362f,-0.018035971f, 0.009812131f,-0.004930145f, 0.002220766f,-0.000858134f, 0.000262101f,-0.000051109f,
+     0.860457513f,-0.185881917f, 0.092988585f,-0.053536929f, 0.031520345f,-0.018099405f, 0.009845358f,-0.004945941f, 0.002227326f,-0.000860359f, 0.000262625f,-0.000051142f,
+     0.858687626f,-0.186422517f, 0.093307775f,-0.053727028f, 0.031631869f,-0.018161989f, 0.009878113f,-0.004961494f, 0.002233772f,-0.000862537f, 0.000263134f,-0.000051172f,
+     0.856908242f,-0.186954154f, 0.093622640f,-0.053914658f, 0.031741931f,-0.018223721f, 0.009910395f,-0.004976803f, 0.002240105f,-0.000864670f, 0.000263628f,-0.000051199f,
+     0.855119405f,-0.187476840f, 0.093933176f,-0.054099819f, 0.031850531f,-0.018284603f, 0.009942205f,-0.004991868f, 0.002246324f,-0.000866758f, 0.000264107f,-0.000051223f,
+     0.853321156f,-0.187990587f, 0.094239384f,-0.054282508f, 0.031957668f,-0.018344632f, 0.009973542f,-0.005006690f, 0.002252430f,-0.000868799f, 0.000264572f,-0.000051244f,
+     0.851513535f,-0.188495407f, 0.094541261f,-0.054462722f, 0.032063340f,-0.018403809f, 0.010004407f,-0.005021269f, 0.002258423f,-0.000870796f, 0.000265022f,-0.000051261f,
+     0.849696585f,-0.188991313f, 0.094838806f,-0.054640461f, 0.032167546f,-0.018462133f, 0.010034799f,-0.005035604f, 0.002264304f,-0.000872747f, 0.000265457f,-0.000051276f,
+     0.847870347f,-0.189478316f, 0.095132017f,-0.054815723f, 0.032270286f,-0.018519603f, 0.010064718f,-0.005049697f, 0.002270071f,-0.000874653f, 0.000265878f,-0.000051287f,
+     0.846034865f,-0.189956430f, 0.095420894f,-0.054988505f, 0.032371557f,-0.018576220f, 0.010094164f,-0.005063546f, 0.002275726f,-0.000876513f, 0.000266285f,-0.000051295f,
+     0.844190180f,-0.190425668f, 0.095705436f,-0.055158807f, 0.032471361f,-0.018631984f, 0.010123138f,-0.005077152f, 0.002281268f,-0.000878329f, 0.000266677f,-0.000051301f,
+     0.842336335f,-0.190886042f, 0.095985642f,-0.055326626f, 0.032569694f,-0.018686893f, 0.010151638f,-0.005090515f, 0.002286698f,-0.000880100f, 0.000267054f,-0.000051303f,
+     0.840473372f,-0.191337567f, 0.096261510f,-0.055491962f, 0.032666558f,-0.018740947f, 0.010179666f,-0.005103636f, 0.002292016f,-0.000881826f, 0.000267418f,-0.000051302f,
+     0.838601336f,-0.191780256f, 0.096533042f,-0.055654813f, 0.032761951f,-0.018794147f, 0.010207222f,-0.005116514f, 0.002297222f,-0.000883507f, 0.000267767f,-0.000051298f,
+     0.836720269f,-0.192214123f, 0.096800236f,-0.055815179f, 0.032855872f,-0.018846492f, 0.010234304f,-0.005129150f, 0.002302316f,-0.000885143f, 0.000268101f,-0.000051291f,
+     0.834830214f,-0.192639182f, 0.097063093f,-0.055973057f, 0.032948321f,-0.018897982f, 0.010260914f,-0.005141544f, 0.002307298f,-0.000886735f, 0.000268422f,-0.000051282f,
+     0.832931215f,-0.193055447f, 0.097321612f,-0.056128448f, 0.033039297f,-0.018948616f, 0.010287052f,-0.005153696f, 0.002312168f,-0.000888283f, 0.000268728f,-0.000051269f,
+     0.831023315f,-0.193462933f, 0.097575794f,-0.056281350f, 0.033128800f,-0.018998396f, 0.010312718f,-0.005165606f, 0.002316927f,-0.000889786f, 0.000269021f,-0.000051253f,
+     0.829106560f,-0.193861655f, 0.097825639f,-0.056431762f, 0.033216830f,-0.019047320f, 0.010337911f,-0.005177275f, 0.002321575f,-0.000891245f, 0.000269299f,-0.000051235f,
+     0.827180993f,-0.194251627f, 0.098071148f,-0.056579684f, 0.033303385f,-0.019095389f, 0.010362632f,-0.005188702f, 0.002326112f,-0.000892660f, 0.000269564f,-0.000051213f,
+     0.825246657f,-0.194632865f, 0.098312320f,-0.056725116f, 0.033388467f,-0.019142603f, 0.010386882f,-0.005199888f, 0.002330538f,-0.000894031f, 0.000269814f,-0.000051189f,
+     0.823303599f,-0.195005384f, 0.098549158f,-0.056868056f, 0.033472074f,-0.019188961f, 0.010410660f,-0.005210833f, 0.002334853f,-0.000895359f, 0.000270051f,-0.000051162f,
+     0.821351862f,-0.195369200f, 0.098781662f,-0.057008505f, 0.033554206f,-0.019234464f, 0.010433967f,-0.005221538f, 0.002339058f,-0.000896642f, 0.000270274f,-0.000051132f,
+     0.819391492f,-0.195724329f, 0.099009833f,-0.057146462f, 0.033634863f,-0.019279113f, 0.010456802f,-0.005232002f, 0.002343152f,-0.000897882f, 0.000270483f,-0.000051100f,
+     0.817422533f,-0.196070787f, 0.099233672f,-0.057281927f, 0.033714046f,-0.019322906f, 0.010479167f,-0.005242226f, 0.002347136f,-0.000899078f, 0.000270679f,-0.000051064f,
+     0.815445032f,-0.196408589f, 0.099453182f,-0.057414899f, 0.033791754f,-0.019365845f, 0.010501061f,-0.005252210f, 0.002351010f,-0.000900231f, 0.000270861f,-0.000051026f,
+     0.813459032f,-0.196737753f, 0.099668363f,-0.057545380f, 0.033867986f,-0.019407930f, 0.010522485f,-0.005261955f, 0.002354775f,-0.000901341f, 0.000271030f,-0.000050986f,
+     0.811464581f,-0.197058295f, 0.099879217f,-0.057673369f, 0.033942745f,-0.019449160f, 0.010543440f,-0.005271460f, 0.002358430f,-0.000902408f, 0.000271185f,-0.000050942f,
+     0.809461723f,-0.197370232f, 0.100085747f,-0.057798866f, 0.034016028f,-0.019489536f, 0.010563924f,-0.005280726f, 0.002361975f,-0.000903431f, 0.000271326f,-0.000050896f,
+     0.807450505f,-0.197673581f, 0.100287953f,-0.057921871f, 0.034087837f,-0.019529059f, 0.010583940f,-0.005289754f, 0.002365412f,-0.000904412f, 0.000271455f,-0.000050847f,
+     0.805430973f,-0.197968359f, 0.100485840f,-0.058042385f, 0.034158172f,-0.019567729f, 0.010603486f,-0.005298543f, 0.002368740f,-0.000905350f, 0.000271570f,-0.000050796f,
+     0.803403173f,-0.198254584f, 0.100679408f,-0.058160409f, 0.034227034f,-0.019605546f, 0.010622564f,-0.005307094f, 0.002371959f,-0.000906246f, 0.000271672f,-0.000050742f,
+     0.801367152f,-0.198532273f, 0.100868661f,-0.058275943f, 0.034294422f,-0.019642510f, 0.010641174f,-0.005315407f, 0.002375069f,-0.000907099f, 0.000271760f,-0.000050685f,
+     0.799322956f,-0.198801445f, 0.101053600f,-0.058388987f, 0.034360337f,-0.019678623f, 0.010659317f,-0.005323483f, 0.002378072f,-0.000907909f, 0.000271836f,-0.000050626f,
+     0.797270633f,-0.199062118f, 0.101234230f,-0.058499543f, 0.034424780f,-0.019713884f, 0.010676992f,-0.005331322f, 0.002380966f,-0.000908678f, 0.000271898f,-0.000050565f,
+     0.795210230f,-0.199314310f, 0.101410553f,-0.058607611f, 0.034487751f,-0.019748295f, 0.010694200f,-0.005338924f, 0.002383753f,-0.000909404f, 0.000271948f,-0.000050500f,
+     0.793141792f,-0.199558039f, 0.101582571f,-0.058713192f, 0.034549251f,-0.019781855f, 0.010710943f,-0.005346290f, 0.002386432f,-0.000910089f, 0.000271985f,-0.000050434f,
+     0.791065369f,-0.199793324f, 0.101750290f,-0.058816287f, 0.034609280f,-0.019814565f, 0.010727219f,-0.005353419f, 0.002389005f,-0.000910731f, 0.000272009f,-0.000050365f,
+     0.788981007f,-0.200020184f, 0.101913711f,-0.058916898f, 0.034667839f,-0.019846426f, 0.010743030f,-0.005360314f, 0.002391470f,-0.000911332f, 0.000272020f,-0.000050293f,
+     0.786888755f,-0.200238638f, 0.102072838f,-0.059015026f, 0.034724929f,-0.019877438f, 0.010758377f,-0.005366973f, 0.002393828f,-0.000911892f, 0.000272018f,-0.000050219f,
+     0.784788659f,-0.200448706f, 0.102227675f,-0.059110671f, 0.034780552f,-0.019907603f, 0.010773260f,-0.005373397f, 0.002396080f,-0.000912410f, 0.000272004f,-0.000050143f,
+     0.782680769f,-0.200650407f, 0.102378227f,-0.059203836f, 0.034834707f,-0.019936921f, 0.010787679f,-0.005379587f, 0.002398226f,-0.000912887f, 0.000271977f,-0.000050064f,
+     0.780565131f,-0.200843760f, 0.102524496f,-0.059294522f, 0.034887395f,-0.019965392f, 0.010801635f,-0.005385543f, 0.002400266f,-0.000913323f, 0.000271938f,-0.000049983f,
+     0.778441795f,-0.201028786f, 0.102666488f,-0.059382730f, 0.034938618f,-0.019993018f, 0.010815128f,-0.005391266f, 0.002402200f,-0.000913718f, 0.000271886f,-0.000049899f,
+     0.776310810f,-0.201205505f, 0.102804207f,-0.059468463f, 0.034988377f,-0.020019799f, 0.010828160f,-0.005396756f, 0.002404029f,-0.000914072f, 0.000271822f,-0.000049814f,
+     0.774172222f,-0.201373937f, 0.102937656f,-0.059551721f, 0.035036673f,-0.020045736f, 0.010840731f,-0.005402013f, 0.002405753f,-0.000914386f, 0.000271745f,-0.000049726f,
+     0.772026083f,-0.201534103f, 0.103066841f,-0.059632507f, 0.035083507f,-0.020070831f, 0.010852842f,-0.005407037f, 0.002407372f,-0.000914659f, 0.000271657f,-0.000049635f,
+     0.769872440f,-0.201686023f, 0.103191767f,-0.059710824f, 0.035128880f,-0.020095083f, 0.010864492f,-0.005411830f, 0.002408886f,-0.000914892f, 0.000271556f,-0.000049543f,
+     0.767711342f,-0.201829718f, 0.103312438f,-0.059786672f, 0.035172794f,-0.020118494f, 0.010875684f,-0.005416392f, 0.002410296f,-0.000915084f, 0.000271443f,-0.000049448f,
+     0.765542839f,-0.201965209f, 0.103428860f,-0.059860054f, 0.035215250f,-0.020141064f, 0.010886417f,-0.005420723f, 0.002411603f,-0.000915237f, 0.000271318f,-0.000049351f,
+     0.763366980f,-0.202092518f, 0.103541037f,-0.059930972f, 0.035256248f,-0.020162796f, 0.010896693f,-0.005424824f, 0.002412805f,-0.000915350f, 0.000271181f,-0.000049252f,
+     0.761183815f,-0.202211665f, 0.103648975f,-0.059999429f, 0.035295792f,-0.020183689f, 0.010906511f,-0.005428695f, 0.002413904f,-0.000915423f, 0.000271032f,-0.000049151f,
+     0.758993394f,-0.202322673f, 0.103752680f,-0.060065428f, 0.035333882f,-0.020203746f, 0.010915874f,-0.005432337f, 0.002414901f,-0.000915456f, 0.000270872f,-0.000049047f,
+     0.756795766f,-0.202425563f, 0.103852156f,-0.060128969f, 0.035370520f,-0.020222966f, 0.010924781f,-0.005435750f, 0.002415794f,-0.000915450f, 0.000270699f,-0.000048942f,
+     0.754590981f,-0.202520358f, 0.103947411f,-0.060190057f, 0.035405707f,-0.020241352f, 0.010933233f,-0.005438935f, 0.002416585f,-0.000915405f, 0.000270515f,-0.000048834f,
+     0.752379089f,-0.202607080f, 0.104038450f,-0.060248694f, 0.035439445f,-0.020258904f, 0.010941232f,-0.005441892f, 0.002417274f,-0.000915321f, 0.000270319f,-0.000048724f,
+     0.750160141f,-0.202685750f, 0.104125279f,-0.060304882f, 0.035471736f,-0.020275623f, 0.010948778f,-0.005444622f, 0.002417861f,-0.000915198f, 0.000270112f,-0.000048613f,
+     0.747934188f,-0.202756392f, 0.104207903f,-0.060358625f, 0.035502581f,-0.020291511f, 0.010955871f,-0.005447125f, 0.002418346f,-0.000915036f, 0.000269893f,-0.000048499f,
+     0.745701278f,-0.202819028f, 0.104286331f,-0.060409925f, 0.035531983f,-0.020306569f, 0.010962514f,-0.005449402f, 0.002418731f,-0.000914836f, 0.000269663f,-0.000048383f,
+     0.743461464f,-0.202873681f, 0.104360567f,-0.060458786f, 0.035559943f,-0.020320798f, 0.010968706f,-0.005451454f, 0.002419014f,-0.000914597f, 0.000269421f,-0.000048265f,
+     0.741214797f,-0.202920375f, 0.104430619f,-0.060505210f, 0.035586463f,-0.020334200f, 0.010974448f,-0.005453281f, 0.002419197f,-0.000914320f, 0.000269169f,-0.000048146f,
+     0.738961326f,-0.202959132f, 0.104496493f,-0.060549201f, 0.035611546f,-0.020346776f, 0.010979742f,-0.005454883f, 0.002419280f,-0.000914005f, 0.000268905f,-0.000048024f,
+     0.736701103f,-0.202989976f, 0.104558197f,-0.060590763f, 0.035635192f,-0.020358527f, 0.010984588f,-0.005456262f, 0.002419263f,-0.000913653f, 0.000268630f,-0.000047901f,
+     0.734434180f,-0.203012931f, 0.104615737f,-0.060629897f, 0.035657405f,-0.020369455f, 0.010988988f,-0.005457417f, 0.002419146f,-0.000913262f, 0.000268343f,-0.000047775f,
+     0.732160607f,-0.203028020f, 0.104669121f,-0.060666609f, 0.035678186f,-0.020379561f, 0.010992942f,-0.005458350f, 0.002418931f,-0.000912834f, 0.000268046f,-0.000047648f,
+     0.729880437f,-0.203035268f, 0.104718355f,-0.060700902f, 0.035697538f,-0.020388846f, 0.010996451f,-0.005459061f, 0.002418616f,-0.000912368f, 0.000267738f,-0.000047519f,
+     0.727593720f,-0.203034699f, 0.104763448f,-0.060732778f, 0.035715463f,-0.020397312f, 0.010999516f,-0.005459550f, 0.002418203f,-0.000911865f, 0.000267419f,-0.000047388f,
+     0.725300509f,-0.203026337f, 0.104804407f,-0.060762243f, 0.035731962f,-0.020404961f, 0.011002138f,-0.005459819f, 0.002417692f,-0.000911326f, 0.000267089f,-0.000047255f,
+     0.723000855f,-0.203010206f, 0.104841239f,-0.060789299f, 0.035747040f,-0.020411794f, 0.011004318f,-0.005459867f, 0.002417083f,-0.000910749f, 0.000266749f,-0.000047121f,
+     0.720694810f,-0.202986331f, 0.104873953f,-0.060813951f, 0.035760697f,-0.020417813f, 0.011006058f,-0.005459696f, 0.002416377f,-0.000910136f, 0.000266398f,-0.000046984f,
+     0.718382427f,-0.202954738f, 0.104902557f,-0.060836202f, 0.035772936f,-0.020423019f, 0.011007358f,-0.005459306f, 0.002415573f,-0.000909486f, 0.000266037f,-0.000046846f,
+     0.716063757f,-0.202915450f, 0.104927058f,-0.060856058f, 0.035783760f,-0.020427415f, 0.011008219f,-0.005458698f, 0.002414673f,-0.000908800f, 0.000265664f,-0.000046707f,
+     0.713738853f,-0.202868494f, 0.104947465f,-0.060873521f, 0.035793172f,-0.020431000f, 0.011008642f,-0.005457872f, 0.002413677f,-0.000908078f, 0.000265282f,-0.000046565f,
+     0.711407768f,-0.202813895f, 0.104963786f,-0.060888596f, 0.035801173f,-0.020433778f, 0.011008629f,-0.005456830f, 0.002412585f,-0.000907319f, 0.000264889f,-0.000046422f,
+     0.709070553f,-0.202751678f, 0.104976031f,-0.060901287f, 0.035807767f,-0.020435750f, 0.011008181f,-0.005455571f, 0.002411397f,-0.000906525f, 0.000264486f,-0.000046277f,
+     0.706727261f,-0.202681869f, 0.104984207f,-0.060911600f, 0.035812956f,-0.020436918f, 0.011007298f,-0.005454097f, 0.002410114f,-0.000905696f, 0.000264073f,-0.000046131f,
+     0.704377946f,-0.202604493f, 0.104988323f,-0.060919538f, 0.035816744f,-0.020437283f, 0.011005983f,-0.005452408f, 0.002408736f,-0.000904831f, 0.000263650f,-0.000045983f,
+     0.702022660f,-0.202519578f, 0.104988388f,-0.060925105f, 0.035819132f,-0.020436848f, 0.011004235f,-0.005450504f, 0.002407263f,-0.000903930f, 0.000263216f,-0.000045834f,
+     0.699661457f,-0.202427148f, 0.104984412f,-0.060928307f, 0.035820124f,-0.020435614f, 0.011002056f,-0.005448388f, 0.002405697f,-0.000902995f, 0.000262773f,-0.000045682f,
+     0.697294388f,-0.202327231f, 0.104976403f,-0.060929149f, 0.035819722f,-0.020433583f, 0.010999448f,-0.005446058f, 0.002404036f,-0.000902025f, 0.000262320f,-0.000045530f,
+     0.694921508f,-0.202219852f, 0.104964371f,-0.060927634f, 0.035817930f,-0.020430756f, 0.010996411f,-0.005443517f, 0.002402283f,-0.000901020f, 0.000261857f,-0.000045376f,
+     0.692542870f,-0.202105040f, 0.104948326f,-0.060923769f, 0.035814750f,-0.020427137f, 0.010992947f,-0.005440764f, 0.002400437f,-0.000899981f, 0.000261384f,-0.000045220f,
+     0.690158527f,-0.201982819f, 0.104928276f,-0.060917557f, 0.035810186f,-0.020422727f, 0.010989057f,-0.005437800f, 0.002398498f,-0.000898907f, 0.000260902f,-0.000045063f,
+     0.687768532f,-0.201853218f, 0.104904232f,-0.060909004f, 0.035804240f,-0.020417527f, 0.010984742f,-0.005434627f, 0.002396467f,-0.000897800f, 0.000260409f,-0.000044904f,
+     0.685372940f,-0.201716263f, 0.104876203f,-0.060898116f, 0.035796916f,-0.020411540f, 0.010980003f,-0.005431244f, 0.002394344f,-0.000896658f, 0.000259908f,-0.000044744f,
+     0.682971804f,-0.201571982f, 0.104844199f,-0.060884897f, 0.035788217f,-0.020404768f, 0.010974843f,-0.005427654f, 0.002392130f,-0.000895483f, 0.000259397f,-0.000044583f,
+     0.680565177f,-0.201420403f, 0.104808231f,-0.060869352f, 0.035778146f,-0.020397212f, 0.010969261f,-0.005423855f, 0.002389825f,-0.000894274f, 0.000258877f,-0.000044420f,
+     0.678153114f,-0.201261552f, 0.104768309f,-0.060851488f, 0.035766707f,-0.020388876f, 0.010963260f,-0.005419850f, 0.002387430f,-0.000893032f, 0.000258347f,-0.000044256f,
+     0.675735669f,-0.201095458f, 0.104724442f,-0.060831309f, 0.035753902f,-0.020379760f, 0.010956840f,-0.005415638f, 0.002384945f,-0.000891756f, 0.000257808f,-0.000044090f,
+     0.673312896f,-0.200922148f, 0.104676642f,-0.060808821f, 0.035739735f,-0.020369868f, 0.010950003f,-0.005411222f, 0.002382369f,-0.000890448f, 0.000257260f,-0.000043923f,
+     0.670884849f,-0.200741651f, 0.104624918f,-0.060784029f, 0.035724210f,-0.020359201f, 0.010942750f,-0.005406600f, 0.002379705f,-0.000889107f, 0.000256703f,-0.000043755f,
+     0.668451582f,-0.200553995f, 0.104569282f,-0.060756940f, 0.035707330f,-0.020347762f, 0.010935083f,-0.005401775f, 0.002376952f,-0.000887733f, 0.000256137f,-0.000043586f,
+     0.666013149f,-0.200359208f, 0.104509745f,-0.060727559f, 0.035689098f,-0.020335552f, 0.010927003f,-0.005396747f, 0.002374110f,-0.000886327f, 0.000255562f,-0.000043415f,
+     0.663569606f,-0.200157318f, 0.104446317f,-0.060695891f, 0.035669519f,-0.020322574f, 0.010918511f,-0.005391517f, 0.002371180f,-0.000884889f, 0.000254978f,-0.000043243f,
+     0.661121006f,-0.199948355f, 0.104379010f,-0.060661944f, 0.035648595f,-0.020308830f, 0.010909609f,-0.005386085f, 0.002368163f,-0.000883419f, 0.000254386f,-0.000043070f,
+     0.658667404f,-0.199732347f, 0.104307834f,-0.060625722f, 0.035626330f,-0.020294323f, 0.010900298f,-0.005380453f, 0.002365059f,-0.000881917f, 0.000253784f,-0.000042895f,
+     0.656208855f,-0.199509323f, 0.104232800f,-0.060587232f, 0.035602728f,-0.020279055f, 0.010890580f,-0.005374621f, 0.002361868f,-0.000880383f, 0.000253174f,-0.000042720f,
+     0.653745413f,-0.199279311f, 0.104153922f,-0.060546480f, 0.035577793f,-0.020263028f, 0.010880456f,-0.005368591f, 0.002358590f,-0.000878818f, 0.000252556f,-0.000042543f,
+     0.651277134f,-0.199042343f, 0.104071208f,-0.060503472f, 0.035551528f,-0.020246244f, 0.010869927f,-0.005362362f, 0.002355227f,-0.000877222f, 0.000251929f,-0.000042365f,
+     0.648804073f,-0.198798445f, 0.103984673f,-0.060458214f, 0.035523938f,-0.020228706f, 0.010858995f,-0.005355936f, 0.002351779f,-0.000875595f, 0.000251294f,-0.000042186f,
+     0.646326283f,-0.198547650f, 0.103894326f,-0.060410714f, 0.035495026f,-0.020210417f, 0.010847661f,-0.005349313f, 0.002348245f,-0.000873937f, 0.000250650f,-0.000042006f,
+     0.643843822f,-0.198289984f, 0.103800181f,-0.060360976f, 0.035464796f,-0.020191378f, 0.010835927f,-0.005342495f, 0.002344627f,-0.000872249f, 0.000249999f,-0.000041825f,
+     0.641356742f,-0.198025480f, 0.103702249f,-0.060309008f, 0.035433251f,-0.020171592f, 0.010823795f,-0.005335482f, 0.002340925f,-0.000870530f, 0.000249339f,-0.000041643f,
+     0.638865101f,-0.197754166f, 0.103600542f,-0.060254817f, 0.035400397f,-0.020151062f, 0.010811265f,-0.005328275f, 0.002337139f,-0.000868781f, 0.000248671f,-0.000041459f,
+     0.636368952f,-0.197476072f, 0.103495072f,-0.060198409f, 0.035366237f,-0.020129790f, 0.010798339f,-0.005320875f, 0.002333270f,-0.000867002f, 0.000247994f,-0.000041275f,
+     0.633868353f,-0.197191229f, 0.103385852f,-0.060139790f, 0.035330775f,-0.020107779f, 0.010785020f,-0.005313284f, 0.002329318f,-0.000865193f, 0.000247310f,-0.000041090f,
+     0.631363357f,-0.196899667f, 0.103272894f,-0.060078968f, 0.035294016f,-0.020085032f, 0.010771307f,-0.005305500f, 0.002325284f,-0.000863355f, 0.000246619f,-0.000040903f,
+     0.628854020f,-0.196601417f, 0.103156211f,-0.060015949f, 0.035255963f,-0.020061550f, 0.010757204f,-0.005297527f, 0.002321168f,-0.000861487f, 0.000245919f,-0.000040716f,
+     0.626340398f,-0.196296508f, 0.103035816f,-0.059950740f, 0.035216620f,-0.020037336f, 0.010742711f,-0.005289364f, 0.002316971f,-0.000859590f, 0.000245212f,-0.000040528f,
+     0.623822547f,-0.195984972f, 0.102911720f,-0.059883349f, 0.035175992f,-0.020012394f, 0.010727831f,-0.005281012f, 0.002312692f,-0.000857665f, 0.000244497f,-0.000040339f,
+     0.621300521f,-0.195666840f, 0.102783937f,-0.059813782f, 0.035134084f,-0.019986725f, 0.010712564f,-0.005272473f, 0.002308333f,-0.000855710f, 0.000243774f,-0.000040149f,
+     0.618774378f,-0.195342142f, 0.102652481f,-0.059742047f, 0.035090899f,-0.019960333f, 0.010696912f,-0.005263747f, 0.002303895f,-0.000853727f, 0.000243044f,-0.000039958f,
+     0.616244173f,-0.195010910f, 0.102517364f,-0.059668150f, 0.035046442f,-0.019933220f, 0.010680877f,-0.005254834f, 0.002299376f,-0.000851716f, 0.000242307f,-0.000039766f,
+     0.613709961f,-0.194673175f, 0.102378598f,-0.059592100f, 0.035000717f,-0.019905389f, 0.010664461f,-0.005245737f, 0.002294779f,-0.000849676f, 0.000241562f,-0.000039574f,
+     0.611171798f,-0.194328968f, 0.102236199f,-0.059513902f, 0.034953729f,-0.019876842f, 0.010647665f,-0.005236456f, 0.002290103f,-0.000847609f, 0.000240810f,-0.000039380f,
+     0.608629741f,-0.193978320f, 0.102090179f,-0.059433566f, 0.034905482f,-0.019847583f, 0.010630490f,-0.005226992f, 0.002285349f,-0.000845514f, 0.000240051f,-0.000039186f,
+     0.606083845f,-0.193621263f, 0.101940551f,-0.059351098f, 0.034855982f,-0.019817613f, 0.010612940f,-0.005217345f, 0.002280517f,-0.000843391f, 0.000239285f,-0.000038991f,
+     0.603534166f,-0.193257829f, 0.101787329f,-0.059266505f, 0.034805231f,-0.019786937f, 0.010595014f,-0.005207517f, 0.002275608f,-0.000841241f, 0.000238512f,-0.000038795f,
+     0.600980761f,-0.192888050f, 0.101630528f,-0.059179796f, 0.034753236f,-0.019755556f, 0.010576715f,-0.005197509f, 0.002270622f,-0.000839064f, 0.000237732f,-0.000038599f,
+     0.598423686f,-0.192511957f, 0.101470160f,-0.059090979f, 0.034700000f,-0.019723474f, 0.010558044f,-0.005187321f, 0.002265560f,-0.000836861f, 0.000236945f,-0.000038401f,
+     0.595862996f,-0.192129583f, 0.101306240f,-0.059000060f, 0.034645528f,-0.019690694f, 0.010539004f,-0.005176955f, 0.002260422f,-0.000834630f, 0.000236151f,-0.000038203f,
+     0.593298748f,-0.191740960f, 0.101138782f,-0.058907047f, 0.034589826f,-0.019657218f, 0.010519596f,-0.005166411f, 0.002255209f,-0.000832373f, 0.000235351f,-0.000038005f,
+     0.590730999f,-0.191346120f, 0.100967799f,-0.058811950f, 0.034532897f,-0.019623049f, 0.010499821f,-0.005155691f, 0.002249921f,-0.000830090f, 0.000234544f,-0.000037805f,
+     0.588159805f,-0.190945095f, 0.100793307f,-0.058714775f, 0.034474748f,-0.019588190f, 0.010479682f,-0.005144795f, 0.002244559f,-0.000827781f, 0.000233730f,-0.000037606f,
+     0.585585221f,-0.190537917f, 0.100615319f,-0.058615530f, 0.034415381f,-0.019552645f, 0.010459179f,-0.005133724f, 0.002239123f,-0.000825446f, 0.000232910f,-0.000037405f,
+     0.583007305f,-0.190124621f, 0.100433851f,-0.058514224f, 0.034354803f,-0.019516416f, 0.010438316f,-0.005122480f, 0.002233613f,-0.000823086f, 0.000232083f,-0.000037204f,
+     0.580426112f,-0.189705237f, 0.100248915f,-0.058410865f, 0.034293019f,-0.019479506f, 0.010417093f,-0.005111063f, 0.002228031f,-0.000820700f, 0.000231250f,-0.000037002f,
+     0.577841700f,-0.189279800f, 0.100060528f,-0.058305460f, 0.034230033f,-0.019441918f, 0.010395513f,-0.005099474f, 0.002222376f,-0.000818289f, 0.000230411f,-0.000036800f,
+     0.575254125f,-0.188848341f, 0.099868703f,-0.058198019f, 0.034165850f,-0.019403655f, 0.010373576f,-0.005087715f, 0.002216649f,-0.000815853f, 0.000229566f,-0.000036597f,
+     0.572663442f,-0.188410895f, 0.099673457f,-0.058088549f, 0.034100475f,-0.019364721f, 0.010351286f,-0.005075785f, 0.002210851f,-0.000813392f, 0.000228714f,-0.000036393f,
+     0.570069710f,-0.187967494f, 0.099474802f,-0.057977060f, 0.034033914f,-0.019325118f, 0.010328644f,-0.005063687f, 0.002204982f,-0.000810907f, 0.000227857f,-0.000036189f,
+     0.567472984f,-0.187518171f, 0.099272756f,-0.057863558f, 0.033966171f,-0.019284849f, 0.010305651f,-0.005051421f, 0.002199043f,-0.000808397f, 0.000226993f,-0.000035985f,
+     0.564873321f,-0.187062959f, 0.099067332f,-0.057748054f, 0.033897252f,-0.019243919f, 0.010282310f,-0.005038988f, 0.002193033f,-0.000805864f, 0.000226124f,-0.000035780f,
+     0.562270777f,-0.186601893f, 0.098858546f,-0.057630555f, 0.033827162f,-0.019202328f, 0.010258622f,-0.005026390f, 0.002186954f,-0.000803306f, 0.000225249f,-0.000035574f,
+     0.559665410f,-0.186135006f, 0.098646413f,-0.057511069f, 0.033755906f,-0.019160082f, 0.010234588f,-0.005013627f, 0.002180807f,-0.000800725f, 0.000224368f,-0.000035368f,
+     0.557057276f,-0.185662331f, 0.098430949f,-0.057389607f, 0.033683489f,-0.019117183f, 0.010210212f,-0.005000699f, 0.002174591f,-0.000798120f, 0.000223482f,-0.000035162f,
+     0.554446431f,-0.185183902f, 0.098212169f,-0.057266176f, 0.033609916f,-0.019073634f, 0.010185495f,-0.004987610f, 0.002168306f,-0.000795493f, 0.000222590f,-0.000034955f,
+     0.551832933f,-0.184699753f, 0.097990088f,-0.057140785f, 0.033535194f,-0.019029438f, 0.010160439f,-0.004974358f, 0.002161955f,-0.000792842f, 0.000221692f,-0.000034748f,
+     0.549216837f,-0.184209918f, 0.097764723f,-0.057013444f, 0.033459327f,-0.018984600f, 0.010135045f,-0.004960946f, 0.002155536f,-0.000790168f, 0.000220789f,-0.000034540f,
+     0.546598202f,-0.183714431f, 0.097536089f,-0.056884160f, 0.033382320f,-0.018939121f, 0.010109315f,-0.004947374f, 0.002149051f,-0.000787472f, 0.000219881f,-0.000034332f,
+     0.543977083f,-0.183213325f, 0.097304202f,-0.056752944f, 0.033304180f,-0.018893005f, 0.010083252f,-0.004933643f, 0.002142501f,-0.000784753f, 0.000218967f,-0.000034124f,
+     0.541353537f,-0.182706637f, 0.097069077f,-0.056619803f, 0.033224911f,-0.018846256f, 0.010056857f,-0.004919755f, 0.002135884f,-0.000782012f, 0.000218048f,-0.000033915f,
+     0.538727621f,-0.182194398f, 0.096830731f,-0.056484748f, 0.033144519f,-0.018798877f, 0.010030132f,-0.004905710f, 0.002129203f,-0.000779249f, 0.000217124f,-0.000033706f,
+     0.536099393f,-0.181676645f, 0.096589181f,-0.056347787f, 0.033063009f,-0.018750871f, 0.010003080f,-0.004891509f, 0.002122458f,-0.000776465f, 0.000216195f,-0.000033497f,
+     0.533468907f,-0.181153411f, 0.096344441f,-0.056208929f, 0.032980388f,-0.018702241f, 0.009975701f,-0.004877154f, 0.002115648f,-0.000773659f, 0.000215261f,-0.000033288f,
+     0.530836223f,-0.180624731f, 0.096096528f,-0.056068184f, 0.032896660f,-0.018652992f, 0.009947998f,-0.004862646f, 0.002108776f,-0.000770832f, 0.000214322f,-0.000033078f,
+     0.528201395f,-0.180090639f, 0.095845459f,-0.055925561f, 0.032811831f,-0.018603125f, 0.009919974f,-0.004847985f, 0.002101840f,-0.000767983f, 0.000213378f,-0.000032868f,
+     0.525564482f,-0.179551171f, 0.095591251f,-0.055781069f, 0.032725908f,-0.018552645f, 0.009891629f,-0.004833172f, 0.002094842f,-0.000765114f, 0.000212430f,-0.000032658f,
+     0.522925540f,-0.179006361f, 0.095333919f,-0.055634719f, 0.032638895f,-0.018501555f, 0.009862966f,-0.004818210f, 0.002087782f,-0.000762224f, 0.000211477f,-0.000032447f,
+     0.520284625f,-0.178456245f, 0.095073480f,-0.055486518f, 0.032550798f,-0.018449859f, 0.009833987f,-0.004803098f, 0.002080661f,-0.000759314f, 0.000210519f,-0.000032236f,
+     0.517641795f,-0.177900856f, 0.094809951f,-0.055336477f, 0.032461623f,-0.018397560f, 0.009804694f,-0.004787838f, 0.002073479f,-0.000756384f, 0.000209556f,-0.000032026f,
+     0.514997106f,-0.177340230f, 0.094543348f,-0.055184605f, 0.032371376f,-0.018344660f, 0.009775088f,-0.004772431f, 0.002066237f,-0.000753433f, 0.000208590f,-0.000031815f,
+     0.512350615f,-0.176774403f, 0.094273689f,-0.055030913f, 0.032280063f,-0.018291165f, 0.009745172f,-0.004756878f, 0.002058935f,-0.000750463f, 0.000207618f,-0.000031603f,
+     0.509702379f,-0.176203409f, 0.094000990f,-0.054875409f, 0.032187689f,-0.018237077f, 0.009714948f,-0.004741179f, 0.002051573f,-0.000747473f, 0.000206643f,-0.000031392f,
+     0.507052455f,-0.175627285f, 0.093725269f,-0.054718103f, 0.032094260f,-0.018182400f, 0.009684418f,-0.004725337f, 0.002044153f,-0.000744464f, 0.000205663f,-0.000031181f,
+     0.504400899f,-0.175046064f, 0.093446542f,-0.054559005f, 0.031999782f,-0.018127137f, 0.009653584f,-0.004709352f, 0.002036675f,-0.000741436f, 0.000204679f,-0.000030969f,
+     0.501747768f,-0.174459783f, 0.093164826f,-0.054398126f, 0.031904262f,-0.018071292f, 0.009622447f,-0.004693226f, 0.002029139f,-0.000738389f, 0.000203691f,-0.000030757f,
+     0.499093120f,-0.173868477f, 0.092880139f,-0.054235474f, 0.031807705f,-0.018014869f, 0.009591011f,-0.004676958f, 0.002021546f,-0.000735323f, 0.000202699f,-0.000030546f,
+     0.496437010f,-0.173272181f, 0.092592498f,-0.054071059f, 0.031710116f,-0.017957871f, 0.009559276f,-0.004660551f, 0.002013897f,-0.000732239f, 0.000201703f,-0.000030334f,
+     0.493779495f,-0.172670932f, 0.092301921f,-0.053904893f, 0.031611503f,-0.017900301f, 0.009527246f,-0.004644006f, 0.002006191f,-0.000729136f, 0.000200703f,-0.000030122f,
+     0.491120633f,-0.172064766f, 0.092008424f,-0.053736984f, 0.031511870f,-0.017842163f, 0.009494921f,-0.004627323f, 0.001998429f,-0.000726016f, 0.000199699f,-0.000029910f,
+     0.488460479f,-0.171453717f, 0.091712026f,-0.053567342f, 0.031411225f,-0.017783461f, 0.009462304f,-0.004610504f, 0.001990613f,-0.000722877f, 0.000198691f,-0.000029699f,
+     0.485799091f,-0.170837822f, 0.091412743f,-0.053395979f, 0.031309573f,-0.017724199f, 0.009429398f,-0.004593550f, 0.001982742f,-0.000719722f, 0.000197680f,-0.000029487f,
+     0.483136525f,-0.170217116f, 0.091110594f,-0.053222903f, 0.031206920f,-0.017664380f, 0.009396204f,-0.004576461f, 0.001974817f,-0.000716548f, 0.000196665f,-0.000029275f,
+     0.480472838f,-0.169591636f, 0.090805596f,-0.053048126f, 0.031103273f,-0.017604007f, 0.009362724f,-0.004559240f, 0.001966838f,-0.000713358f, 0.000195647f,-0.000029063f,
+     0.477808087f,-0.168961418f, 0.090497766f,-0.052871657f, 0.030998637f,-0.017543085f, 0.009328961f,-0.004541886f, 0.001958807f,-0.000710150f, 0.000194625f,-0.000028851f,
+     0.475142327f,-0.168326498f, 0.090187124f,-0.052693506f, 0.030893019f,-0.017481617f, 0.009294916f,-0.004524402f, 0.001950723f,-0.000706926f, 0.000193600f,-0.000028640f,
+     0.472475615f,-0.167686911f, 0.089873686f,-0.052513685f, 0.030786425f,-0.017419607f, 0.009260591f,-0.004506788f, 0.001942587f,-0.000703685f, 0.000192571f,-0.000028428f,
+     0.469808009f,-0.167042695f, 0.089557471f,-0.052332203f, 0.030678861f,-0.017357058f, 0.009225990f,-0.004489046f, 0.001934399f,-0.000700428f, 0.000191540f,-0.000028217f,
+     0.467139564f,-0.166393886f, 0.089238497f,-0.052149071f, 0.030570334f,-0.017293974f, 0.009191113f,-0.004471176f, 0.001926161f,-0.000697155f, 0.000190505f,-0.000028005f,
+     0.464470337f,-0.165740519f, 0.088916782f,-0.051964299f, 0.030460849f,-0.017230359f, 0.009155963f,-0.004453180f, 0.001917873f,-0.000693866f, 0.000189466f,-0.000027794f,
+     0.461800385f,-0.165082632f, 0.088592343f,-0.051777898f, 0.030350414f,-0.017166218f, 0.009120542f,-0.004435059f, 0.001909534f,-0.000690562f, 0.000188425f,-0.000027583f,
+     0.459129763f,-0.164420260f, 0.088265200f,-0.051589878f, 0.030239034f,-0.017101552f, 0.009084852f,-0.004416813f, 0.001901147f,-0.000687242f, 0.000187381f,-0.000027372f,
+     0.456458528f,-0.163753440f, 0.087935370f,-0.051400250f, 0.030126716f,-0.017036367f, 0.009048896f,-0.004398444f, 0.001892710f,-0.000683906f, 0.000186334f,-0.000027161f,
+     0.453786736f,-0.163082210f, 0.087602872f,-0.051209025f, 0.030013466f,-0.016970665f, 0.009012675f,-0.004379954f, 0.001884226f,-0.000680556f, 0.000185284f,-0.000026950f,
+     0.451114445f,-0.162406604f, 0.087267725f,-0.051016213f, 0.029899291f,-0.016904452f, 0.008976192f,-0.004361343f, 0.001875693f,-0.000677191f, 0.000184232f,-0.000026740f,
+     0.448441709f,-0.161726661f, 0.086929946f,-0.050821824f, 0.029784197f,-0.016837730f, 0.008939448f,-0.004342612f, 0.001867114f,-0.000673811f, 0.000183176f,-0.000026530f,
+     0.445768585f,-0.161042417f, 0.086589555f,-0.050625870f, 0.029668190f,-0.016770504f, 0.008902447f,-0.004323763f, 0.001858488f,-0.000670417f, 0.000182119f,-0.000026320f,
+     0.443095129f,-0.160353908f, 0.086246569f,-0.050428362f, 0.029551277f,-0.016702777f, 0.008865189f,-0.004304796f, 0.001849816f,-0.000667009f, 0.000181058f,-0.000026110f,
+     0.440421398f,-0.159661171f, 0.085901008f,-0.050229310f, 0.029433465f,-0.016634553f, 0.008827678f,-0.004285713f, 0.001841098f,-0.000663587f, 0.000179995f,-0.000025900f,
+     0.437747447f,-0.158964244f, 0.085552890f,-0.050028725f, 0.029314759f,-0.016565836f, 0.008789915f,-0.004266515f, 0.001832335f,-0.000660151f, 0.000178930f,-0.000025691f,
+     0.435073332f,-0.158263162f, 0.085202234f,-0.049826618f, 0.029195168f,-0.016496629f, 0.008751902f,-0.004247203f, 0.001823528f,-0.000656702f, 0.000177862f,-0.000025482f,
+     0.432399110f,-0.157557964f, 0.084849059f,-0.049622999f, 0.029074696f,-0.016426938f, 0.008713643f,-0.004227779f, 0.001814677f,-0.000653239f, 0.000176792f,-0.000025273f,
+     0.429724836f,-0.156848685f, 0.084493384f,-0.049417881f, 0.028953351f,-0.016356765f, 0.008675138f,-0.004208242f, 0.001805782f,-0.000649763f, 0.000175720f,-0.000025064f,
+     0.427050565f,-0.156135364f, 0.084135228f,-0.049211274f, 0.028831139f,-0.016286115f, 0.008636390f,-0.004188595f, 0.001796845f,-0.000646275f, 0.000174645f,-0.000024856f,
+     0.424376355f,-0.155418036f, 0.083774608f,-0.049003188f, 0.028708067f,-0.016214991f, 0.008597402f,-0.004168839f, 0.001787865f,-0.000642774f, 0.000173569f,-0.000024648f,
+     0.421702260f,-0.154696740f, 0.083411546f,-0.048793635f, 0.028584142f,-0.016143397f, 0.008558175f,-0.004148974f, 0.001778843f,-0.000639260f, 0.000172490f,-0.000024441f,
+     0.419028336f,-0.153971512f, 0.083046059f,-0.048582627f, 0.028459370f,-0.016071337f, 0.008518712f,-0.004129002f, 0.001769780f,-0.000635734f, 0.000171410f,-0.000024234f,
+     0.416354640f,-0.153242389f, 0.082678167f,-0.048370174f, 0.028333758f,-0.015998816f, 0.008479015f,-0.004108924f, 0.001760676f,-0.000632196f, 0.000170327f,-0.000024027f,
+     0.413681225f,-0.152509409f, 0.082307890f,-0.048156287f, 0.028207313f,-0.015925837f, 0.008439086f,-0.004088742f, 0.001751532f,-0.000628647f, 0.000169243f,-0.000023820f,
+     0.411008149f,-0.151772608f, 0.081935245f,-0.047940978f, 0.028080041f,-0.015852404f, 0.008398928f,-0.004068455f, 0.001742348f,-0.000625085f, 0.000168157f,-0.000023614f,
+     0.408335465f,-0.151032025f, 0.081560253f,-0.047724257f, 0.027951949f,-0.015778521f, 0.008358542f,-0.004048066f, 0.001733125f,-0.000621512f, 0.000167069f,-0.000023408f,
+     0.405663231f,-0.150287696f, 0.081182933f,-0.047506137f, 0.027823044f,-0.015704192f, 0.008317930f,-0.004027576f, 0.001723864f,-0.000617929f, 0.000165980f,-0.000023203f,
+     0.402991500f,-0.149539658f, 0.080803304f,-0.047286628f, 0.027693332f,-0.015629421f, 0.008277096f,-0.004006986f, 0.001714564f,-0.000614334f, 0.000164889f,-0.000022998f,
+     0.400320329f,-0.148787950f, 0.080421385f,-0.047065742f, 0.027562821f,-0.015554212f, 0.008236041f,-0.003986296f, 0.001705226f,-0.000610728f, 0.000163797f,-0.000022794f,
+     0.397649772f,-0.148032608f, 0.080037197f,-0.046843490f, 0.027431517f,-0.015478569f, 0.008194768f,-0.003965508f, 0.001695852f,-0.000607112f, 0.000162703f,-0.000022590f,
+     0.394979884f,-0.147273669f, 0.079650758f,-0.046619884f, 0.027299427f,-0.015402496f, 0.008153278f,-0.003944624f, 0.001686441f,-0.000603486f, 0.000161608f,-0.000022386f,
+     0.392310721f,-0.146511172f, 0.079262088f,-0.046394934f, 0.027166559f,-0.015325997f, 0.008111574f,-0.003923644f, 0.001676994f,-0.000599849f, 0.000160511f,-0.000022183f,
+     0.389642337f,-0.145745153f, 0.078871207f,-0.046168653f, 0.027032918f,-0.015249076f, 0.008069658f,-0.003902569f, 0.001667511f,-0.000596202f, 0.000159413f,-0.000021980f,
+     0.386974788f,-0.144975651f, 0.078478135f,-0.045941052f, 0.026898511f,-0.015171738f, 0.008027533f,-0.003881401f, 0.001657994f,-0.000592546f, 0.000158314f,-0.000021778f,
+     0.384308127f,-0.144202702f, 0.078082890f,-0.045712142f, 0.026763346f,-0.015093985f, 0.007985200f,-0.003860141f, 0.001648442f,-0.000588880f, 0.000157214f,-0.000021576f,
+     0.381642411f,-0.143426343f, 0.077685493f,-0.045481935f, 0.026627430f,-0.015015822f, 0.007942662f,-0.003838790f, 0.001638857f,-0.000585205f, 0.000156113f,-0.000021375f,
+     0.378977692f,-0.142646614f, 0.077285964f,-0.045250442f, 0.026490769f,-0.014937254f, 0.007899921f,-0.003817348f, 0.001629238f,-0.000581521f, 0.000155011f,-0.000021175f,
+     0.376314027f,-0.141863550f, 0.076884322f,-0.045017676f, 0.026353370f,-0.014858284f, 0.007856980f,-0.003795819f, 0.001619586f,-0.000577828f, 0.000153908f,-0.000020974f,
+     0.373651469f,-0.141077191f, 0.076480587f,-0.044783647f, 0.026215240f,-0.014778916f, 0.007813841f,-0.003774201f, 0.001609901f,-0.000574126f, 0.000152804f,-0.000020775f,
+     0.370990073f,-0.140287572f, 0.076074778f,-0.044548368f, 0.026076387f,-0.014699155f, 0.007770505f,-0.003752497f, 0.001600186f,-0.000570416f, 0.000151699f,-0.000020576f,
+     0.368329893f,-0.139494732f, 0.075666917f,-0.044311849f, 0.025936817f,-0.014619004f, 0.007726975f,-0.003730708f, 0.001590438f,-0.000566698f, 0.000150594f,-0.000020377f,
+     0.365670984f,-0.138698708f, 0.075257022f,-0.044074104f, 0.025796537f,-0.014538468f, 0.007683254f,-0.003708835f, 0.001580660f,-0.000562971f, 0.000149488f,-0.000020179f,
+     0.363013398f,-0.137899539f, 0.074845114f,-0.043835142f, 0.025655554f,-0.014457550f, 0.007639344f,-0.003686879f, 0.001570852f,-0.000559237f, 0.000148381f,-0.000019982f,
+     0.360357192f,-0.137097261f, 0.074431213f,-0.043594977f, 0.025513876f,-0.014376255f, 0.007595247f,-0.003664840f, 0.001561015f,-0.000555495f, 0.000147273f,-0.000019785f,
+     0.357702417f,-0.136291912f, 0.074015339f,-0.043353620f, 0.025371509f,-0.014294587f, 0.007550964f,-0.003642722f, 0.001551148f,-0.000551745f, 0.000146166f,-0.000019589f,
+     0.355049130f,-0.135483530f, 0.073597511f,-0.043111082f, 0.025228460f,-0.014212550f, 0.007506500f,-0.003620523f, 0.001541252f,-0.000547988f, 0.000145057f,-0.000019393f,
+     0.352397382f,-0.134672152f, 0.073177750f,-0.042867376f, 0.025084737f,-0.014130148f, 0.007461855f,-0.003598247f, 0.001531329f,-0.000544224f, 0.000143948f,-0.000019198f,
+     0.349747227f,-0.133857816f, 0.072756076f,-0.042622513f, 0.024940346f,-0.014047386f, 0.007417032f,-0.003575893f, 0.001521377f,-0.000540454f, 0.000142839f,-0.000019004f,
+     0.347098721f,-0.133040560f, 0.072332509f,-0.042376505f, 0.024795294f,-0.013964266f, 0.007372034f,-0.003553463f, 0.001511399f,-0.000536676f, 0.000141730f,-0.000018810f,
+     0.344451915f,-0.132220422f, 0.071907070f,-0.042129364f, 0.024649589f,-0.013880794f, 0.007326862f,-0.003530959f, 0.001501394f,-0.000532892f, 0.000140620f,-0.000018617f,
+     0.341806863f,-0.131397438f, 0.071479778f,-0.041881102f, 0.024503238f,-0.013796974f, 0.007281519f,-0.003508380f, 0.001491364f,-0.000529102f, 0.000139511f,-0.000018424f,
+     0.339163618f,-0.130571647f, 0.071050654f,-0.041631731f, 0.024356248f,-0.013712810f, 0.007236007f,-0.003485729f, 0.001481307f,-0.000525306f, 0.000138401f,-0.000018233f,
+     0.336522234f,-0.129743086f, 0.070619718f,-0.041381262f, 0.024208626f,-0.013628305f, 0.007190328f,-0.003463007f, 0.001471226f,-0.000521504f, 0.000137291f,-0.000018042f,
+     0.333882764f,-0.128911793f, 0.070186991f,-0.041129708f, 0.024060378f,-0.013543464f, 0.007144486f,-0.003440214f, 0.001461121f,-0.000517697f, 0.000136181f,-0.000017851f,
+     0.331245260f,-0.128077806f, 0.069752491f,-0.040877081f, 0.023911513f,-0.013458292f, 0.007098481f,-0.003417352f, 0.001450991f,-0.000513883f, 0.000135071f,-0.000017661f,
+     0.328609775f,-0.127241162f, 0.069316241f,-0.040623392f, 0.023762038f,-0.013372792f, 0.007052316f,-0.003394422f, 0.001440838f,-0.000510065f, 0.000133962f,-0.000017472f,
+     0.325976363f,-0.126401898f, 0.068878260f,-0.040368654f, 0.023611959f,-0.013286968f, 0.007005995f,-0.003371426f, 0.001430662f,-0.000506242f, 0.000132852f,-0.000017284f,
+     0.323345076f,-0.125560053f, 0.068438569f,-0.040112879f, 0.023461283f,-0.013200825f, 0.006959517f,-0.003348363f, 0.001420464f,-0.000502413f, 0.000131743f,-0.000017096f,
+     0.320715966f,-0.124715664f, 0.067997188f,-0.039856078f, 0.023310019f,-0.013114367f, 0.006912888f,-0.003325236f, 0.001410244f,-0.000498580f, 0.000130634f,-0.000016909f,
+     0.318089086f,-0.123868769f, 0.067554138f,-0.039598263f, 0.023158172f,-0.013027598f, 0.006866107f,-0.003302046f, 0.001400002f,-0.000494743f, 0.000129525f,-0.000016723f,
+     0.315464488f,-0.123019404f, 0.067109438f,-0.039339448f, 0.023005751f,-0.012940522f, 0.006819178f,-0.003278794f, 0.001389740f,-0.000490901f, 0.000128417f,-0.000016537f,
+     0.312842224f,-0.122167609f, 0.066663110f,-0.039079643f, 0.022852762f,-0.012853143f, 0.006772103f,-0.003255480f, 0.001379458f,-0.000487055f, 0.000127309f,-0.000016353f,
+     0.310222347f,-0.121313420f, 0.066215173f,-0.038818861f, 0.022699213f,-0.012765466f, 0.006724884f,-0.003232107f, 0.001369155f,-0.000483205f, 0.000126202f,-0.000016169f,
+     0.307604908f,-0.120456874f, 0.065765649f,-0.038557114f, 0.022545111f,-0.012677495f, 0.006677524f,-0.003208675f, 0.001358833f,-0.000479352f, 0.000125096f,-0.000015985f,
+     0.304989959f,-0.119598010f, 0.065314558f,-0.038294414f, 0.022390463f,-0.012589233f, 0.006630025f,-0.003185185f, 0.001348493f,-0.000475495f, 0.000123990f,-0.000015803f,
+     0.302377551f,-0.118736865f, 0.064861920f,-0.038030773f, 0.022235277f,-0.012500685f, 0.006582389f,-0.003161639f, 0.001338134f,-0.000471634f, 0.000122884f,-0.000015621f,
+     0.299767738f,-0.117873477f, 0.064407756f,-0.037766204f, 0.022079559f,-0.012411856f, 0.006534618f,-0.003138037f, 0.001327758f,-0.000467771f, 0.000121780f,-0.000015440f,
+     0.297160569f,-0.117007882f, 0.063952087f,-0.037500718f, 0.021923316f,-0.012322749f, 0.006486714f,-0.003114381f, 0.001317364f,-0.000463904f, 0.000120676f,-0.000015260f,
+     0.294556097f,-0.116140119f, 0.063494933f,-0.037234328f, 0.021766557f,-0.012233369f, 0.006438681f,-0.003090672f, 0.001306953f,-0.000460035f, 0.000119573f,-0.000015081f,
+     0.291954372f,-0.115270225f, 0.063036314f,-0.036967045f, 0.021609288f,-0.012143719f, 0.006390520f,-0.003066911f, 0.001296527f,-0.000456163f, 0.000118471f,-0.000014902f,
+     0.289355446f,-0.114398236f, 0.062576252f,-0.036698882f, 0.021451517f,-0.012053805f, 0.006342234f,-0.003043100f, 0.001286084f,-0.000452289f, 0.000117370f,-0.000014724f,
+     0.286759369f,-0.113524192f, 0.062114766f,-0.036429852f, 0.021293251f,-0.011963629f, 0.006293824f,-0.003019238f, 0.001275626f,-0.000448412f, 0.000116269f,-0.000014548f,
+     0.284166193f,-0.112648128f, 0.061651878f,-0.036159966f, 0.021134496f,-0.011873197f, 0.006245293f,-0.002995329f, 0.001265154f,-0.000444534f, 0.000115170f,-0.000014371f,
+     0.281575968f,-0.111770083f, 0.061187608f,-0.035889236f, 0.020975261f,-0.011782513f, 0.006196644f,-0.002971371f, 0.001254667f,-0.000440654f, 0.000114072f,-0.000014196f,
+     0.278988744f,-0.110890094f, 0.060721976f,-0.035617675f, 0.020815553f,-0.011691580f, 0.006147878f,-0.002947368f, 0.001244167f,-0.000436772f, 0.000112975f,-0.000014022f,
+     0.276404573f,-0.110008197f, 0.060255004f,-0.035345296f, 0.020655379f,-0.011600404f, 0.006098998f,-0.002923319f, 0.001233653f,-0.000432888f, 0.000111879f,-0.000013848f,
+     0.273823505f,-0.109124431f, 0.059786712f,-0.035072109f, 0.020494745f,-0.011508987f, 0.006050006f,-0.002899227f, 0.001223126f,-0.000429003f, 0.000110785f,-0.000013675f,
+     0.271245589f,-0.108238832f, 0.059317120f,-0.034798128f, 0.020333661f,-0.011417335f, 0.006000905f,-0.002875092f, 0.001212588f,-0.000425118f, 0.000109692f,-0.000013503f,
+     0.268670876f,-0.107351438f, 0.058846250f,-0.034523364f, 0.020172132f,-0.011325451f, 0.005951696f,-0.002850914f, 0.001202037f,-0.000421231f, 0.000108600f,-0.000013332f,
+     0.266099416f,-0.106462286f, 0.058374122f,-0.034247831f, 0.020010166f,-0.011233340f, 0.005902383f,-0.002826697f, 0.001191475f,-0.000417343f, 0.000107510f,-0.000013162f,
+     0.263531258f,-0.105571412f, 0.057900756f,-0.033971539f, 0.019847770f,-0.011141006f, 0.005852966f,-0.002802440f, 0.001180903f,-0.000413455f, 0.000106420f,-0.000012993f,
+     0.260966452f,-0.104678855f, 0.057426173f,-0.033694502f, 0.019684952f,-0.011048453f, 0.005803449f,-0.002778144f, 0.001170320f,-0.000409567f, 0.000105333f,-0.000012824f,
+     0.258405047f,-0.103784651f, 0.056950395f,-0.033416732f, 0.019521719f,-0.010955685f, 0.005753834f,-0.002753811f, 0.001159727f,-0.000405678f, 0.000104247f,-0.000012657f,
+     0.255847094f,-0.102888837f, 0.056473441f,-0.033138241f, 0.019358078f,-0.010862706f, 0.005704123f,-0.002729442f, 0.001149126f,-0.000401790f, 0.000103163f,-0.000012490f,
+     0.253292641f,-0.101991451f, 0.055995332f,-0.032859040f, 0.019194036f,-0.010769522f, 0.005654318f,-0.002705038f, 0.001138515f,-0.000397901f, 0.000102080f,-0.000012324f,
+     0.250741736f,-0.101092528f, 0.055516090f,-0.032579144f, 0.019029601f,-0.010676135f, 0.005604422f,-0.002680601f, 0.001127896f,-0.000394013f, 0.000100999f,-0.000012159f,
+     0.248194430f,-0.100192107f, 0.055035734f,-0.032298563f, 0.018864781f,-0.010582550f, 0.005554437f,-0.002656130f, 0.001117269f,-0.000390125f, 0.000099919f,-0.000011995f,
+     0.245650771f,-0.099290223f, 0.054554285f,-0.032017310f, 0.018699581f,-0.010488771f, 0.005504365f,-0.002631628f, 0.001106635f,-0.000386238f, 0.000098842f,-0.000011832f,
+     0.243110807f,-0.098386914f, 0.054071764f,-0.031735397f, 0.018534011f,-0.010394803f, 0.005454207f,-0.002607095f, 0.001095994f,-0.000382352f, 0.000097766f,-0.000011670f,
+     0.240574587f,-0.097482217f, 0.053588192f,-0.031452837f, 0.018368076f,-0.010300650f, 0.005403968f,-0.002582533f, 0.001085346f,-0.000378467f, 0.000096692f,-0.000011509f,
+     0.238042160f,-0.096576168f, 0.053103590f,-0.031169642f, 0.018201784f,-0.010206315f, 0.005353648f,-0.002557942f, 0.001074693f,-0.000374583f, 0.000095620f,-0.000011348f,
+     0.235513573f,-0.095668804f, 0.052617977f,-0.030885823f, 0.018035143f,-0.010111803f, 0.005303251f,-0.002533324f, 0.001064034f,-0.000370701f, 0.000094550f,-0.000011189f,
+     0.232988874f,-0.094760162f, 0.052131375f,-0.030601395f, 0.017868160f,-0.010017118f, 0.005252777f,-0.002508680f, 0.001053370f,-0.000366820f, 0.000093482f,-0.000011030f,
+     0.230468111f,-0.093850278f, 0.051643804f,-0.030316367f, 0.017700842f,-0.009922264f, 0.005202231f,-0.002484011f, 0.001042702f,-0.000362941f, 0.000092415f,-0.000010873f,
+     0.227951333f,-0.092939188f, 0.051155285f,-0.030030754f, 0.017533196f,-0.009827246f, 0.005151613f,-0.002459319f, 0.001032029f,-0.000359063f, 0.000091351f,-0.000010716f,
+     0.225438586f,-0.092026930f, 0.050665838f,-0.029744567f, 0.017365230f,-0.009732067f, 0.005100926f,-0.002434603f, 0.001021353f,-0.000355188f, 0.000090290f,-0.000010560f,
+     0.222929918f,-0.091113540f, 0.050175485f,-0.029457818f, 0.017196951f,-0.009636732f, 0.005050172f,-0.002409865f, 0.001010674f,-0.000351315f, 0.000089230f,-0.000010406f,
+     0.220425376f,-0.090199054f, 0.049684245f,-0.029170520f, 0.017028366f,-0.009541245f, 0.004999354f,-0.002385107f, 0.000999993f,-0.000347444f, 0.000088172f,-0.000010252f,
+     0.217925007f,-0.089283509f, 0.049192140f,-0.028882685f, 0.016859482f,-0.009445610f, 0.004948473f,-0.002360329f, 0.000989309f,-0.000343576f, 0.000087117f,-0.000010099f,
+     0.215428858f,-0.088366940f, 0.048699190f,-0.028594326f, 0.016690307f,-0.009349832f, 0.004897533f,-0.002335533f, 0.000978624f,-0.000339710f, 0.000086064f,-0.000009947f,
+     0.212936976f,-0.087449385f, 0.048205415f,-0.028305453f, 0.016520848f,-0.009253913f, 0.004846534f,-0.002310719f, 0.000967937f,-0.000335848f, 0.000085014f,-0.000009796f,
+     0.210449408f,-0.086530878f, 0.047710837f,-0.028016081f, 0.016351112f,-0.009157859f, 0.004795480f,-0.002285889f, 0.000957250f,-0.000331988f, 0.000083965f,-0.000009646f,
+     0.207966199f,-0.085611457f, 0.047215475f,-0.027726220f, 0.016181107f,-0.009061674f, 0.004744372f,-0.002261044f, 0.000946562f,-0.000328132f, 0.000082919f,-0.000009497f,
+     0.205487396f,-0.084691158f, 0.046719351f,-0.027435883f, 0.016010840f,-0.008965362f, 0.004693213f,-0.002236184f, 0.000935875f,-0.000324279f, 0.000081876f,-0.000009349f,
+     0.203013046f,-0.083770016f, 0.046222484f,-0.027145083f, 0.015840317f,-0.008868926f, 0.004642005f,-0.002211311f, 0.000925188f,-0.000320429f, 0.000080835f,-0.000009202f,
+     0.200543193f,-0.082848067f, 0.045724896f,-0.026853832f, 0.015669547f,-0.008772371f, 0.004590751f,-0.002186427f, 0.000914502f,-0.000316583f, 0.000079797f,-0.000009056f,
+     0.198077885f,-0.081925348f, 0.045226606f,-0.026562141f, 0.015498536f,-0.008675702f, 0.004539451f,-0.002161531f, 0.000903818f,-0.000312741f, 0.000078761f,-0.000008911f,
+     0.195617165f,-0.081001894f, 0.044727636f,-0.026270024f, 0.015327292f,-0.008578921f, 0.004488109f,-0.002136625f, 0.000893136f,-0.000308904f, 0.000077728f,-0.000008767f,
+     0.193161081f,-0.080077741f, 0.044228005f,-0.025977491f, 0.015155822f,-0.008482034f, 0.004436727f,-0.002111711f, 0.000882456f,-0.000305070f, 0.000076697f,-0.000008624f,
+     0.190709676f,-0.079152924f, 0.043727735f,-0.025684556f, 0.014984132f,-0.008385045f, 0.004385307f,-0.002086789f, 0.000871779f,-0.000301240f, 0.000075670f,-0.000008482f,
+     0.188262996f,-0.078227480f, 0.043226845f,-0.025391231f, 0.014812232f,-0.008287957f, 0.004333851f,-0.002061860f, 0.000861105f,-0.000297415f, 0.000074645f,-0.000008340f,
+     0.185821087f,-0.077301444f, 0.042725356f,-0.025097527f, 0.014640126f,-0.008190775f, 0.004282361f,-0.002036925f, 0.000850435f,-0.000293595f, 0.000073622f,-0.000008200f,
+     0.183383992f,-0.076374851f, 0.042223289f,-0.024803458f, 0.014467824f,-0.008093502f, 0.004230839f,-0.002011986f, 0.000839770f,-0.000289779f, 0.000072603f,-0.000008061f,
+     0.180951756f,-0.075447736f, 0.041720664f,-0.024509034f, 0.014295331f,-0.007996143f, 0.004179289f,-0.001987043f, 0.000829109f,-0.000285969f, 0.000071586f,-0.000007923f,
+     0.178524423f,-0.074520136f, 0.041217500f,-0.024214269f, 0.014122655f,-0.007898702f, 0.004127711f,-0.001962097f, 0.000818453f,-0.000282163f, 0.000070572f,-0.000007786f,
+     0.176102038f,-0.073592085f, 0.040713820f,-0.023919174f, 0.013949804f,-0.007801183f, 0.004076107f,-0.001937150f, 0.000807803f,-0.000278363f, 0.000069561f,-0.000007650f,
+     0.173684645f,-0.072663619f, 0.040209642f,-0.023623762f, 0.013776784f,-0.007703590f, 0.004024481f,-0.001912203f, 0.000797159f,-0.000274568f, 0.000068554f,-0.000007515f,
+     0.171272287f,-0.071734773f, 0.039704987f,-0.023328044f, 0.013603603f,-0.007605927f, 0.003972835f,-0.001887256f, 0.000786521f,-0.000270778f, 0.000067549f,-0.000007380f,
+     0.168865008f,-0.070805581f, 0.039199875f,-0.023032032f, 0.013430267f,-0.007508199f, 0.003921169f,-0.001862310f, 0.000775890f,-0.000266995f, 0.000066547f,-0.000007247f,
+     0.166462852f,-0.069876080f, 0.038694327f,-0.022735740f, 0.013256784f,-0.007410408f, 0.003869487f,-0.001837367f, 0.000765266f,-0.000263217f, 0.000065548f,-0.000007115f,
+     0.164065861f,-0.068946303f, 0.038188363f,-0.022439178f, 0.013083161f,-0.007312559f, 0.003817791f,-0.001812428f, 0.000754650f,-0.000259445f, 0.000064552f,-0.000006984f,
+     0.161674079f,-0.068016286f, 0.037682003f,-0.022142359f, 0.012909405f,-0.007214657f, 0.003766082f,-0.001787494f, 0.000744042f,-0.000255679f, 0.000063559f,-0.000006854f,
+     0.159287549f,-0.067086063f, 0.037175267f,-0.021845295f, 0.012735524f,-0.007116705f, 0.003714364f,-0.001762565f, 0.000733443f,-0.000251920f, 0.000062570f,-0.000006725f,
+     0.156906313f,-0.066155669f, 0.036668175f,-0.021547998f, 0.012561523f,-0.007018707f, 0.003662637f,-0.001737643f, 0.000722853f,-0.000248167f, 0.000061584f,-0.000006597f,
+     0.154530414f,-0.065225140f, 0.036160747f,-0.021250480f, 0.012387411f,-0.006920667f, 0.003610905f,-0.001712728f, 0.000712272f,-0.000244420f, 0.000060601f,-0.000006470f,
+     0.152159894f,-0.064294508f, 0.035653004f,-0.020952752f, 0.012213195f,-0.006822590f, 0.003559168f,-0.001687823f, 0.000701701f,-0.000240680f, 0.000059621f,-0.000006344f,
+     0.149794795f,-0.063363809f, 0.035144966f,-0.020654828f, 0.012038881f,-0.006724479f, 0.003507430f,-0.001662927f, 0.000691140f,-0.000236947f, 0.000058644f,-0.000006219f,
+     0.147435160f,-0.062433078f, 0.034636652f,-0.020356718f, 0.011864476f,-0.006626338f, 0.003455693f,-0.001638041f, 0.000680590f,-0.000233221f, 0.000057671f,-0.000006095f,
+     0.145081030f,-0.061502348f, 0.034128082f,-0.020058435f, 0.011689988f,-0.006528171f, 0.003403958f,-0.001613168f, 0.000670051f,-0.000229502f, 0.000056701f,-0.000005972f,
+     0.142732446f,-0.060571653f, 0.033619277f,-0.019759991f, 0.011515424f,-0.006429983f, 0.003352227f,-0.001588307f, 0.000659523f,-0.000225791f, 0.000055735f,-0.000005850f,
+     0.140389450f,-0.059641028f, 0.033110255f,-0.019461398f, 0.011340790f,-0.006331776f, 0.003300504f,-0.001563460f, 0.000649008f,-0.000222086f, 0.000054772f,-0.000005729f,
+     0.138052083f,-0.058710507f, 0.032601039f,-0.019162667f, 0.011166095f,-0.006233556f, 0.003248789f,-0.001538627f, 0.000638504f,-0.000218390f, 0.000053812f,-0.000005610f,
+     0.135720386f,-0.057780124f, 0.032091646f,-0.018863810f, 0.010991343f,-0.006135326f, 0.003197085f,-0.001513810f, 0.000628014f,-0.000214701f, 0.000052856f,-0.000005491f,
+     0.133394399f,-0.056849912f, 0.031582097f,-0.018564839f, 0.010816543f,-0.006037089f, 0.003145393f,-0.001489010f, 0.000617536f,-0.000211020f, 0.000051903f,-0.000005373f,
+     0.131074164f,-0.055919906f, 0.031072411f,-0.018265766f, 0.010641702f,-0.005938850f, 0.003093717f,-0.001464227f, 0.000607072f,-0.000207346f, 0.000050954f,-0.000005256f,
+     0.128759721f,-0.054990138f, 0.030562609f,-0.017966604f, 0.010466827f,-0.005840614f, 0.003042058f,-0.001439463f, 0.000596622f,-0.000203681f, 0.000050009f,-0.000005141f,
+     0.126451109f,-0.054060644f, 0.030052711f,-0.017667362f, 0.010291924f,-0.005742382f, 0.002990418f,-0.001414719f, 0.000586186f,-0.000200024f, 0.000049067f,-0.000005026f,
+     0.124148370f,-0.053131455f, 0.029542734f,-0.017368055f, 0.010117000f,-0.005644161f, 0.002938798f,-0.001389995f, 0.000575765f,-0.000196375f, 0.000048128f,-0.000004912f,
+     0.121851541f,-0.052202606f, 0.029032700f,-0.017068692f, 0.009942062f,-0.005545952f, 0.002887202f,-0.001365292f, 0.000565359f,-0.000192735f, 0.000047194f,-0.000004800f,
+     0.119560664f,-0.051274130f, 0.028522629f,-0.016769286f, 0.009767118f,-0.005447762f, 0.002835631f,-0.001340612f, 0.000554969f,-0.000189103f, 0.000046263f,-0.000004688f,
+     0.117275778f,-0.050346060f, 0.028012538f,-0.016469849f, 0.009592174f,-0.005349592f, 0.002784087f,-0.001315955f, 0.000544594f,-0.000185480f, 0.000045335f,-0.000004578f,
+     0.114996921f,-0.049418430f, 0.027502449f,-0.016170392f, 0.009417237f,-0.005251447f, 0.002732573f,-0.001291323f, 0.000534236f,-0.000181866f, 0.000044412f,-0.000004468f,
+     0.112724132f,-0.048491271f, 0.026992380f,-0.015870927f, 0.009242314f,-0.005153331f, 0.002681089f,-0.001266716f, 0.000523894f,-0.000178261f, 0.000043492f,-0.000004360f,
+     0.110457451f,-0.047564618f, 0.026482351f,-0.015571465f, 0.009067411f,-0.005055248f, 0.002629639f,-0.001242135f, 0.000513570f,-0.000174665f, 0.000042576f,-0.000004252f,
+     0.108196916f,-0.046638503f, 0.025972381f,-0.015272018f, 0.008892536f,-0.004957202f, 0.002578224f,-0.001217581f, 0.000503262f,-0.000171078f, 0.000041664f,-0.000004146f,
+     0.105942565f,-0.045712958f, 0.025462490f,-0.014972598f, 0.008717695f,-0.004859196f, 0.002526846f,-0.001193056f, 0.000492973f,-0.000167501f, 0.000040756f,-0.000004040f,
+     0.103694436f,-0.044788018f, 0.024952697f,-0.014673217f, 0.008542895f,-0.004761234f, 0.002475507f,-0.001168559f, 0.000482702f,-0.000163933f, 0.000039851f,-0.000003936f,
+     0.101452567f,-0.043863712f, 0.024443021f,-0.014373885f, 0.008368143f,-0.004663320f, 0.002424209f,-0.001144093f, 0.000472449f,-0.000160374f, 0.000038950f,-0.000003833f,
+     0.099216996f,-0.042940076f, 0.023933482f,-0.014074615f, 0.008193446f,-0.004565457f, 0.002372954f,-0.001119657f, 0.000462216f,-0.000156826f, 0.000038054f,-0.000003730f,
+     0.096987761f,-0.042017140f, 0.023424098f,-0.013775417f, 0.008018810f,-0.004467650f, 0.002321745f,-0.001095253f, 0.000452001f,-0.000153287f, 0.000037161f,-0.000003629f,
+     0.094764898f,-0.041094937f, 0.022914889f,-0.013476303f, 0.007844242f,-0.004369903f, 0.002270582f,-0.001070882f, 0.000441807f,-0.000149758f, 0.000036272f,-0.000003529f,
+     0.092548445f,-0.040173499f, 0.022405873f,-0.013177286f, 0.007669749f,-0.004272218f, 0.002219468f,-0.001046544f, 0.000431632f,-0.000146239f, 0.000035387f,-0.000003430f,
+     0.090338438f,-0.039252859f, 0.021897071f,-0.012878375f, 0.007495338f,-0.004174601f, 0.002168405f,-0.001022241f, 0.000421478f,-0.000142730f, 0.000034506f,-0.000003331f,
+     0.088134915f,-0.038333047f, 0.021388500f,-0.012579583f, 0.007321014f,-0.004077053f, 0.002117395f,-0.000997973f, 0.000411344f,-0.000139232f, 0.000033629f,-0.000003234f,
+     0.085937911f,-0.037414096f, 0.020880180f,-0.012280920f, 0.007146786f,-0.003979580f, 0.002066439f,-0.000973742f, 0.000401232f,-0.000135744f, 0.000032757f,-0.000003138f,
+     0.083747462f,-0.036496038f, 0.020372130f,-0.011982399f, 0.006972658f,-0.003882185f, 0.002015541f,-0.000949547f, 0.000391141f,-0.000132266f, 0.000031888f,-0.000003043f,
+     0.081563606f,-0.035578904f, 0.019864368f,-0.011684030f, 0.006798639f,-0.003784871f, 0.001964700f,-0.000925391f, 0.000381072f,-0.000128799f, 0.000031023f,-0.000002949f,
+     0.079386377f,-0.034662726f, 0.019356913f,-0.011385825f, 0.006624735f,-0.003687643f, 0.001913920f,-0.000901274f, 0.000371025f,-0.000125343f, 0.000030163f,-0.000002856f,
+     0.077215811f,-0.033747535f, 0.018849785f,-0.011087795f, 0.006450952f,-0.003590503f, 0.001863203f,-0.000877197f, 0.000361000f,-0.000121898f, 0.000029306f,-0.000002764f,
+     0.075051943f,-0.032833362f, 0.018343001f,-0.010789951f, 0.006277296f,-0.003493456f, 0.001812549f,-0.000853160f, 0.000350999f,-0.000118463f, 0.000028454f,-0.000002673f,
+     0.072894809f,-0.031920238f, 0.017836580f,-0.010492304f, 0.006103775f,-0.003396506f, 0.001761962f,-0.000829165f, 0.000341021f,-0.000115040f, 0.000027606f,-0.000002583f,
+     0.070744443f,-0.031008196f, 0.017330542f,-0.010194866f, 0.005930395f,-0.003299655f, 0.001711443f,-0.000805212f, 0.000331066f,-0.000111628f, 0.000026762f,-0.000002494f,
+     0.068600880f,-0.030097264f, 0.016824904f,-0.009897647f, 0.005757163f,-0.003202908f, 0.001660993f,-0.000781303f, 0.000321135f,-0.000108227f, 0.000025923f,-0.000002406f,
+     0.066464155f,-0.029187475f, 0.016319684f,-0.009600659f, 0.005584084f,-0.003106267f, 0.001610615f,-0.000757438f, 0.000311229f,-0.000104838f, 0.000025087f,-0.000002319f,
+     0.064334301f,-0.028278859f, 0.015814902f,-0.009303913f, 0.005411165f,-0.003009738f, 0.001560311f,-0.000733618f, 0.000301347f,-0.000101460f, 0.000024256f,-0.000002233f,
+     0.062211353f,-0.027371447f, 0.015310576f,-0.009007419f, 0.005238414f,-0.002913322f, 0.001510082f,-0.000709843f, 0.000291490f,-0.000098093f, 0.000023429f,-0.000002148f,
+     0.060095345f,-0.026465268f, 0.014806724f,-0.008711189f, 0.005065835f,-0.002817025f, 0.001459930f,-0.000686116f, 0.000281658f,-0.000094739f, 0.000022607f,-0.000002064f,
+     0.057986309f,-0.025560354f, 0.014303364f,-0.008415234f, 0.004893436f,-0.002720849f, 0.001409857f,-0.000662436f, 0.000271852f,-0.000091396f, 0.000021788f,-0.000001981f,
+     0.055884279f,-0.024656735f, 0.013800515f,-0.008119564f, 0.004721223f,-0.002624797f, 0.001359865f,-0.000638804f, 0.000262071f,-0.000088065f, 0.000020974f,-0.000001899f,
+     0.053789289f,-0.023754441f, 0.013298194f,-0.007824191f, 0.004549203f,-0.002528875f, 0.001309956f,-0.000615222f, 0.000252317f,-0.000084746f, 0.000020165f,-0.000001818f,
+     0.051701371f,-0.022853501f, 0.012796420f,-0.007529125f, 0.004377381f,-0.002433084f, 0.001260131f,-0.000591690f, 0.000242590f,-0.000081439f, 0.000019360f,-0.000001738f,
+     0.049620558f,-0.021953946f, 0.012295210f,-0.007234377f, 0.004205764f,-0.002337428f, 0.001210392f,-0.000568208f, 0.000232889f,-0.000078144f, 0.000018559f,-0.000001659f,
+     0.047546882f,-0.021055806f, 0.011794584f,-0.006939958f, 0.004034359f,-0.002241912f, 0.001160741f,-0.000544778f, 0.000223216f,-0.000074862f, 0.000017762f,-0.000001581f,
+     0.045480376f,-0.020159110f, 0.011294558f,-0.006645879f, 0.003863171f,-0.002146537f, 0.001111180f,-0.000521401f, 0.000213570f,-0.000071592f, 0.000016970f,-0.000001504f,
+     0.043421071f,-0.019263887f, 0.010795150f,-0.006352151f, 0.003692207f,-0.002051309f, 0.001061711f,-0.000498077f, 0.000203952f,-0.000068334f, 0.000016182f,-0.000001428f,
+     0.041368998f,-0.018370167f, 0.010296379f,-0.006058783f, 0.003521473f,-0.001956230f, 0.001012334f,-0.000474807f, 0.000194362f,-0.000065089f, 0.000015399f,-0.000001353f,
+     0.039324191f,-0.017477980f, 0.009798262f,-0.005765787f, 0.003350975f,-0.001861304f, 0.000963053f,-0.000451592f, 0.000184801f,-0.000061857f, 0.000014620f,-0.000001279f,
+     0.037286679f,-0.016587355f, 0.009300816f,-0.005473174f, 0.003180720f,-0.001766534f, 0.000913869f,-0.000428433f, 0.000175268f,-0.000058637f, 0.000013846f,-0.000001206f,
+     0.035256494f,-0.015698319f, 0.008804060f,-0.005180953f, 0.003010714f,-0.001671923f, 0.000864783f,-0.000405330f, 0.000165764f,-0.000055430f, 0.000013076f,-0.000001134f,
+     0.033233667f,-0.014810904f, 0.008308010f,-0.004889136f, 0.002840962f,-0.001577475f, 0.000815797f,-0.000382284f, 0.000156290f,-0.000052236f, 0.000012311f,-0.000001062f,
+     0.031218228f,-0.013925136f, 0.007812685f,-0.004597733f, 0.002671471f,-0.001483194f, 0.000766914f,-0.000359296f, 0.000146845f,-0.000049056f, 0.000011550f,-0.000000992f,
+     0.029210207f,-0.013041046f, 0.007318101f,-0.004306754f, 0.002502248f,-0.001389082f, 0.000718133f,-0.000336368f, 0.000137431f,-0.000045888f, 0.000010794f,-0.000000923f,
+     0.027209635f,-0.012158660f, 0.006824277f,-0.004016210f, 0.002333297f,-0.001295143f, 0.000669459f,-0.000313498f, 0.000128046f,-0.000042733f, 0.000010042f,-0.000000855f,
+     0.025216541f,-0.011278009f, 0.006331229f,-0.003726112f, 0.002164625f,-0.001201381f, 0.000620891f,-0.000290689f, 0.000118693f,-0.000039592f, 0.000009295f,-0.000000788f,
+     0.023230955f,-0.010399120f, 0.005838974f,-0.003436469f, 0.001996239f,-0.001107798f, 0.000572432f,-0.000267941f, 0.000109370f,-0.000036464f, 0.000008552f,-0.000000721f,
+     0.021252907f,-0.009522020f, 0.005347531f,-0.003147291f, 0.001828143f,-0.001014398f, 0.000524083f,-0.000245255f, 0.000100078f,-0.000033350f, 0.000007814f,-0.000000656f,
+     0.019282425f,-0.008646739f, 0.004856915f,-0.002858590f, 0.001660345f,-0.000921185f, 0.000475847f,-0.000222632f, 0.000090817f,-0.000030249f, 0.000007081f,-0.000000592f,
+     0.017319538f,-0.007773305f, 0.004367144f,-0.002570376f, 0.001492850f,-0.000828160f, 0.000427724f,-0.000200072f, 0.000081588f,-0.000027161f, 0.000006352f,-0.000000528f,
+     0.015364276f,-0.006901744f, 0.003878235f,-0.002282658f, 0.001325664f,-0.000735329f, 0.000379716f,-0.000177576f, 0.000072391f,-0.000024088f, 0.000005627f,-0.000000466f,
+     0.013416665f,-0.006032084f, 0.003390204f,-0.001995446f, 0.001158792f,-0.000642693f, 0.000331825f,-0.000155144f, 0.000063227f,-0.000021028f, 0.000004908f,-0.000000404f,
+     0.011476736f,-0.005164354f, 0.002903069f,-0.001708752f, 0.000992242f,-0.000550257f, 0.000284053f,-0.000132779f, 0.000054095f,-0.000017982f, 0.000004193f,-0.000000344f,
+     0.009544515f,-0.004298579f, 0.002416847f,-0.001422584f, 0.000826018f,-0.000458023f, 0.000236401f,-0.000110479f, 0.000044995f,-0.000014949f, 0.000003482f,-0.000000284f,
+     0.007620030f,-0.003434788f, 0.001931553f,-0.001136954f, 0.000660126f,-0.000365995f, 0.000188871f,-0.000088246f, 0.000035929f,-0.000011931f, 0.000002776f,-0.000000226f,
+     0.005703309f,-0.002573008f, 0.001447205f,-0.000851870f, 0.000494573f,-0.000274175f, 0.000141464f,-0.000066082f, 0.000026896f,-0.000008927f, 0.000002075f,-0.000000168f,
+     0.003794379f,-0.001713266f, 0.000963819f,-0.000567343f, 0.000329364f,-0.000182567f, 0.000094182f,-0.000043985f, 0.000017897f,-0.000005937f, 0.000001379f,-0.000000111f,
+     0.001893267f,-0.000855587f, 0.000481412f,-0.000283383f, 0.000164504f,-0.000091175f, 0.000047027f,-0.000021958f, 0.000008931f,-0.000002961f, 0.000000687f,-0.000000055f,
+};
+
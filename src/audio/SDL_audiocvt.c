@@ -24,6 +24,7 @@
 
 #include "SDL_audioqueue.h"
 #include "SDL_audioresample.h"
+#include "../thread/SDL_systhread.h"
 
 #ifndef SDL_INT_MAX
 #define SDL_INT_MAX ((int)(~0u>>1))
@@ -129,6 +130,302 @@ static void SDL_TARGETING("sse") SDL_ConvertMonoToStereo_SSE(float *dst, const f
 }
 #endif
 
+// Generic channel mixing: each frame is multiplied by a [dst_channels][src_channels] matrix, so
+// output channel `o` is the sum of input channel `i` times `matrix[o * src_channels + i]`.
+// Every input sample of a frame is read before any output is written, and we walk backwards when
+// the output grows, so all of these work in-place.
+static void MixChannelFrame(float *dst, const float *src, int src_channels, int dst_channels, const float *matrix)
+{
+    float input[8];
+    for (int i = 0; i < src_channels; i++) {
+        input[i] = src[i];
+    }
+
+    for (int o = 0; o < dst_channels; o++, matrix += src_channels) {
+        float sample = 0.0f;
+        for (int i = 0; i < src_channels; i++) {
+            sample += input[i] * matrix[i];
+        }
+        dst[o] = sample;
+    }
+}
+
+static void MixChannels_Scalar(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    if (dst_channels > src_channels) {
+        // convert backwards, since output is growing in-place.
+        for (int i = num_frames - 1; i >= 0; i--) {
+            MixChannelFrame(dst + (i * dst_channels), src + (i * src_channels), src_channels, dst_channels, matrix);
+        }
+    } else {
+        for (int i = 0; i < num_frames; i++) {
+            MixChannelFrame(dst + (i * dst_channels), src + (i * src_channels), src_channels, dst_channels, matrix);
+        }
+    }
+}
+
+// The SIMD mixers keep a pair of weight vectors per input channel. Outputs of 1, 2 or 4 channels fit
+// exactly 4, 2 or 1 frames in a vector. Anything else mixes one frame into one or two vectors, and lets
+// the store run over into the next frame. They mix a chunk at a time onto the stack and copy it out
+// afterwards, so the over-long stores stay out of the caller's buffer, and a chunk's input is always
+// read before its output is written. The few frames that don't fill a vector go through the scalar path.
+#define CHANNEL_MIX_CHUNK_FRAMES 128
+
+static int GetChannelMixFrameGroup(int dst_channels)
+{
+    return ((dst_channels == 1) || (dst_channels == 2) || (dst_channels == 4)) ? (4 / dst_channels) : 1;
+}
+
+static void GetChannelMixWeights(float *weights, int src_channels, int dst_channels, const float *matrix)
+{
+    const int group = GetChannelMixFrameGroup(dst_channels);
+
+    for (int i = 0; i < src_channels; i++, weights += 8) {
+        for (int lane = 0; lane < 8; lane++) {
+            const int o = (group > 1) ? (lane % dst_channels) : lane;
+            weights[lane] = (o < dst_channels) ? matrix[(o * src_channels) + i] : 0.0f;
+        }
+    }
+}
+
+#ifdef SDL_SSE_INTRINSICS
+// Mix a chunk of frames into `out`, which has room for CHANNEL_MIX_CHUNK_FRAMES frames plus a spare frame.
+// Even and odd input channels go to separate sums, so the adds don't wait on each other as much.
+SDL_FORCE_INLINE void SDL_TARGETING("sse") MixChannelChunk_SSE(float *out, const float *src, int num_frames, const int src_channels, int dst_channels, const __m128 *weights)
+{
+    const int group = GetChannelMixFrameGroup(dst_channels);
+
+    if (group > 1) {
+        for (int f = 0; f < num_frames; f += group, src += src_channels * group, out += 4) {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (int i = 0; i < src_channels; i++) {
+                const __m128 in = (group == 4) ? _mm_setr_ps(src[i], src[src_channels + i], src[(src_channels * 2) + i], src[(src_channels * 3) + i])
+                                               : _mm_setr_ps(src[i], src[i], src[src_channels + i], src[src_channels + i]);
+                if (i & 1) {
+                    sum1 = _mm_add_ps(sum1, _mm_mul_ps(in, weights[i * 2]));
+                } else {
+                    sum0 = _mm_add_ps(sum0, _mm_mul_ps(in, weights[i * 2]));
+                }
+            }
+            _mm_storeu_ps(out, _mm_add_ps(sum0, sum1));
+        }
+    } else if (dst_channels <= 4) {
+        // each store runs into the next frame, which gets overwritten on the next iteration.
+        for (int f = 0; f < num_frames; f++, src += src_channels, out += dst_channels) {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (int i = 0; i < src_channels; i++) {
+                if (i & 1) {
+                    sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_set1_ps(src[i]), weights[i * 2]));
+                } else {
+                    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_set1_ps(src[i]), weights[i * 2]));
+                }
+            }
+            _mm_storeu_ps(out, _mm_add_ps(sum0, sum1));
+        }
+    } else {
+        for (int f = 0; f < num_frames; f++, src += src_channels, out += dst_channels) {
+            __m128 lo0 = _mm_setzero_ps();
+            __m128 hi0 = _mm_setzero_ps();
+            __m128 lo1 = _mm_setzero_ps();
+            __m128 hi1 = _mm_setzero_ps();
+            for (int i = 0; i < src_channels; i++) {
+                const __m128 in = _mm_set1_ps(src[i]);
+                if (i & 1) {
+                    lo1 = _mm_add_ps(lo1, _mm_mul_ps(in, weights[i * 2]));
+                    hi1 = _mm_add_ps(hi1, _mm_mul_ps(in, weights[(i * 2) + 1]));
+                } else {
+                    lo0 = _mm_add_ps(lo0, _mm_mul_ps(in, weights[i * 2]));
+                    hi0 = _mm_add_ps(hi0, _mm_mul_ps(in, weights[(i * 2) + 1]));
+                }
+            }
+            _mm_storeu_ps(out, _mm_add_ps(lo0, lo1));
+            _mm_storeu_ps(out + 4, _mm_add_ps(hi0, hi1));
+        }
+    }
+}
+
+static void SDL_TARGETING("sse") MixChannels_SSE(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    LOG_DEBUG_AUDIO_CONVERT("channel matrix", "channel matrix (using SSE)");
+
+    const int group = GetChannelMixFrameGroup(dst_channels);
+    const int leftover = (num_frames / group) * group;
+    const int num_chunks = (leftover + CHANNEL_MIX_CHUNK_FRAMES - 1) / CHANNEL_MIX_CHUNK_FRAMES;
+    float raw_weights[8 * 8];
+    __m128 weights[8 * 2];
+    float out[(CHANNEL_MIX_CHUNK_FRAMES + 1) * 8];
+
+    GetChannelMixWeights(raw_weights, src_channels, dst_channels, matrix);
+    for (int i = 0; i < src_channels * 2; i++) {
+        weights[i] = _mm_loadu_ps(raw_weights + (i * 4));
+    }
+
+    // the leftover frames at the end have to go first if we're converting backwards.
+    if (dst_channels > src_channels) {
+        MixChannels_Scalar(dst + (leftover * dst_channels), src + (leftover * src_channels), num_frames - leftover, src_channels, dst_channels, matrix);
+    }
+
+    for (int c = 0; c < num_chunks; c++) {
+        // convert backwards, since output is growing in-place.
+        const int chunk = (dst_channels > src_channels) ? (num_chunks - 1 - c) : c;
+        const int first = chunk * CHANNEL_MIX_CHUNK_FRAMES;
+        const int frames = SDL_min(leftover - first, CHANNEL_MIX_CHUNK_FRAMES);
+        const float *chunk_src = src + (first * src_channels);
+
+        // a constant channel count lets the compiler unroll the inner loops.
+        switch (src_channels) {
+            case 1: MixChannelChunk_SSE(out, chunk_src, frames, 1, dst_channels, weights); break;
+            case 2: MixChannelChunk_SSE(out, chunk_src, frames, 2, dst_channels, weights); break;
+            case 3: MixChannelChunk_SSE(out, chunk_src, frames, 3, dst_channels, weights); break;
+            case 4: MixChannelChunk_SSE(out, chunk_src, frames, 4, dst_channels, weights); break;
+            case 5: MixChannelChunk_SSE(out, chunk_src, frames, 5, dst_channels, weights); break;
+            case 6: MixChannelChunk_SSE(out, chunk_src, frames, 6, dst_channels, weights); break;
+            case 7: MixChannelChunk_SSE(out, chunk_src, frames, 7, dst_channels, weights); break;
+            case 8: MixChannelChunk_SSE(out, chunk_src, frames, 8, dst_channels, weights); break;
+            default: SDL_assert(!"Unexpected channel count!"); break;
+        }
+
+        // the whole chunk has been read by now, so this can't clobber input we still need.
+        SDL_memmove(dst + (first * dst_channels), out, frames * dst_channels * sizeof (float));
+    }
+
+    if (dst_channels <= src_channels) {
+        MixChannels_Scalar(dst + (leftover * dst_channels), src + (leftover * src_channels), num_frames - leftover, src_channels, dst_channels, matrix);
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+// This matches MixChannelChunk_SSE.
+SDL_FORCE_INLINE void MixChannelChunk_NEON(float *out, const float *src, int num_frames, const int src_channels, int dst_channels, const float32x4_t *weights)
+{
+    const int group = GetChannelMixFrameGroup(dst_channels);
+
+    if (group > 1) {
+        for (int f = 0; f < num_frames; f += group, src += src_channels * group, out += 4) {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+            for (int i = 0; i < src_channels; i++) {
+                float32x4_t in;
+                if (group == 4) {
+                    in = vsetq_lane_f32(src[(src_channels * 3) + i], vsetq_lane_f32(src[(src_channels * 2) + i], vsetq_lane_f32(src[src_channels + i], vdupq_n_f32(src[i]), 1), 2), 3);
+                } else {
+                    in = vcombine_f32(vdup_n_f32(src[i]), vdup_n_f32(src[src_channels + i]));
+                }
+                if (i & 1) {
+                    sum1 = vmlaq_f32(sum1, in, weights[i * 2]);
+                } else {
+                    sum0 = vmlaq_f32(sum0, in, weights[i * 2]);
+                }
+            }
+            vst1q_f32(out, vaddq_f32(sum0, sum1));
+        }
+    } else if (dst_channels <= 4) {
+        // each store runs into the next frame, which gets overwritten on the next iteration.
+        for (int f = 0; f < num_frames; f++, src += src_channels, out += dst_channels) {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+            for (int i = 0; i < src_channels; i++) {
+                if (i & 1) {
+                    sum1 = vmlaq_f32(sum1, vdupq_n_f32(src[i]), weights[i * 2]);
+                } else {
+                    sum0 = vmlaq_f32(sum0, vdupq_n_f32(src[i]), weights[i * 2]);
+                }
+            }
+            vst1q_f32(out, vaddq_f32(sum0, sum1));
+        }
+    } else {
+        for (int f = 0; f < num_frames; f++, src += src_channels, out += dst_channels) {
+            float32x4_t lo0 = vdupq_n_f32(0.0f);
+            float32x4_t hi0 = vdupq_n_f32(0.0f);
+            float32x4_t lo1 = vdupq_n_f32(0.0f);
+            float32x4_t hi1 = vdupq_n_f32(0.0f);
+            for (int i = 0; i < src_channels; i++) {
+                const float32x4_t in = vdupq_n_f32(src[i]);
+                if (i & 1) {
+                    lo1 = vmlaq_f32(lo1, in, weights[i * 2]);
+                    hi1 = vmlaq_f32(hi1, in, weights[(i * 2) + 1]);
+                } else {
+                    lo0 = vmlaq_f32(lo0, in, weights[i * 2]);
+                    hi0 = vmlaq_f32(hi0, in, weights[(i * 2) + 1]);
+                }
+            }
+            vst1q_f32(out, vaddq_f32(lo0, lo1));
+            vst1q_f32(out + 4, vaddq_f32(hi0, hi1));
+        }
+    }
+}
+
+static void MixChannels_NEON(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    LOG_DEBUG_AUDIO_CONVERT("channel matrix", "channel matrix (using NEON)");
+
+    const int group = GetChannelMixFrameGroup(dst_channels);
+    const int leftover = (num_frames / group) * group;
+    const int num_chunks = (leftover + CHANNEL_MIX_CHUNK_FRAMES - 1) / CHANNEL_MIX_CHUNK_FRAMES;
+    float raw_weights[8 * 8];
+    float32x4_t weights[8 * 2];
+    float out[(CHANNEL_MIX_CHUNK_FRAMES + 1) * 8];
+
+    GetChannelMixWeights(raw_weights, src_channels, dst_channels, matrix);
+    for (int i = 0; i < src_channels * 2; i++) {
+        weights[i] = vld1q_f32(raw_weights + (i * 4));
+    }
+
+    // the leftover frames at the end have to go first if we're converting backwards.
+    if (dst_channels > src_channels) {
+        MixChannels_Scalar(dst + (leftover * dst_channels), src + (leftover * src_channels), num_frames - leftover, src_channels, dst_channels, matrix);
+    }
+
+    for (int c = 0; c < num_chunks; c++) {
+        // convert backwards, since output is growing in-place.
+        const int chunk = (dst_channels > src_channels) ? (num_chunks - 1 - c) : c;
+        const int first = chunk * CHANNEL_MIX_CHUNK_FRAMES;
+        const int frames = SDL_min(leftover - first, CHANNEL_MIX_CHUNK_FRAMES);
+        const float *chunk_src = src + (first * src_channels);
+
+        // a constant channel count lets the compiler unroll the inner loops.
+        switch (src_channels) {
+            case 1: MixChannelChunk_NEON(out, chunk_src, frames, 1, dst_channels, weights); break;
+            case 2: MixChannelChunk_NEON(out, chunk_src, frames, 2, dst_channels, weights); break;
+            case 3: MixChannelChunk_NEON(out, chunk_src, frames, 3, dst_channels, weights); break;
+            case 4: MixChannelChunk_NEON(out, chunk_src, frames, 4, dst_channels, weights); break;
+            case 5: MixChannelChunk_NEON(out, chunk_src, frames, 5, dst_channels, weights); break;
+            case 6: MixChannelChunk_NEON(out, chunk_src, frames, 6, dst_channels, weights); break;
+            case 7: MixChannelChunk_NEON(out, chunk_src, frames, 7, dst_channels, weights); break;
+            case 8: MixChannelChunk_NEON(out, chunk_src, frames, 8, dst_channels, weights); break;
+            default: SDL_assert(!"Unexpected channel count!"); break;
+        }
+
+        // the whole chunk has been read by now, so this can't clobber input we still need.
+        SDL_memmove(dst + (first * dst_channels), out, frames * dst_channels * sizeof (float));
+    }
+
+    if (dst_channels <= src_channels) {
+        MixChannels_Scalar(dst + (leftover * dst_channels), src + (leftover * src_channels), num_frames - leftover, src_channels, dst_channels, matrix);
+    }
+}
+#endif
+
+static void MixChannels(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        MixChannels_SSE(dst, src, num_frames, src_channels, dst_channels, matrix);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        MixChannels_NEON(dst, src, num_frames, src_channels, dst_channels, matrix);
+        return;
+    }
+#endif
+    MixChannels_Scalar(dst, src, num_frames, src_channels, dst_channels, matrix);
+}
+
 // Include the autogenerated channel converters...
 #include "SDL_audio_channel_converters.h"
 
@@ -210,6 +507,51 @@ static SDL_bool SDL_IsSupportedChannelCount(const int channels)
     return ((channels >= 1) && (channels <= 8));
 }
 
+// Scale float32 samples by `gain`. This is safe to do in-place.
+static void ApplyAudioGain(float *dst, const float *src, int num_frames, int channels, const SDL_AudioGain *gain)
+{
+    const float left = (channels == 2) ? gain->left : 1.0f;
+    const float right = (channels == 2) ? gain->right : 1.0f;
+    const int ramp_frames = SDL_min(gain->ramp_frames, num_frames);
+    int i = 0;
+
+    if (channels == 2) {
+        for (; i < ramp_frames; i++) {
+            const float g = gain->start + (gain->step * (float) i);
+            dst[i * 2] = src[i * 2] * (g * left);
+            dst[i * 2 + 1] = src[i * 2 + 1] * (g * right);
+        }
+    } else {
+        for (; i < ramp_frames; i++) {
+            const float g = gain->start + (gain->step * (float) i);
+            for (int c = 0; c < channels; c++) {
+                dst[i * channels + c] = src[i * channels + c] * g;
+            }
+        }
+    }
+
+    if (i == num_frames) {
+        return;
+    }
+
+    // past the ramp, the gain holds steady.
+    const float g = gain->start + (gain->step * (float) ramp_frames);
+
+    if (left == right) {
+        const float g0 = g * left;
+        for (int j = i * channels; j < num_frames * channels; j++) {
+            dst[j] = src[j] * g0;
+        }
+    } else {
+        const float gl = g * left;
+        const float gr = g * right;
+        for (; i < num_frames; i++) {
+            dst[i * 2] = src[i * 2] * gl;
+            dst[i * 2 + 1] = src[i * 2 + 1] * gr;
+        }
+    }
+}
+
 
 // This does type and channel conversions _but not resampling_ (resampling happens in SDL_AudioStream).
 // This does not check parameter validity, (beyond asserts), it expects you did that already!
@@ -218,8 +560,12 @@ static SDL_bool SDL_IsSupportedChannelCount(const int channels)
 //
 // The scratch buffer must be able to store `num_frames * CalculateMaxSampleFrameSize(src_format, src_channels, dst_format, dst_channels)` bytes.
 // If the scratch buffer is NULL, this restriction applies to the output buffer instead.
+//
+// If `channel_matrix` isn't NULL, it replaces the builtin channel conversion (see MixChannels), even if the channel count doesn't change.
+// If `gain` isn't NULL, it gets applied as part of the float32 stage, so it costs no extra trip through the data in most cases.
 void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
-                  void *dst, SDL_AudioFormat dst_format, int dst_channels, void* scratch)
+                  void *dst, SDL_AudioFormat dst_format, int dst_channels, void* scratch,
+                  const float *channel_matrix, const SDL_AudioGain *gain)
 {
     SDL_assert(src != NULL);
     SDL_assert(dst != NULL);
@@ -256,7 +602,7 @@ void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, i
        it was a bloat on SDL compile times and final library size. */
 
     // see if we can skip float conversion entirely.
-    if (src_channels == dst_channels) {
+    if ((src_channels == dst_channels) && !channel_matrix && !gain) {
         if (src_format == dst_format) {
             // nothing to do, we're already in the right format, just copy it over if necessary.
             if (src != dst) {
@@ -284,7 +630,7 @@ void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, i
 
     const SDL_bool srcbyteswap = (SDL_AUDIO_ISBIGENDIAN(src_format) != 0) == (SDL_BYTEORDER == SDL_LIL_ENDIAN) && (src_bitsize > 8);
     const SDL_bool srcconvert = !SDL_AUDIO_ISFLOAT(src_format);
-    const SDL_bool channelconvert = src_channels != dst_channels;
+    const SDL_bool channelconvert = (src_channels != dst_channels) || (channel_matrix != NULL);
     const SDL_bool dstconvert = !SDL_AUDIO_ISFLOAT(dst_format);
     const SDL_bool dstbyteswap = (SDL_AUDIO_ISBIGENDIAN(dst_format) != 0) == (SDL_BYTEORDER == SDL_LIL_ENDIAN) && (dst_bitsize > 8);
 
@@ -304,7 +650,11 @@ void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, i
 
     // Channel conversion
 
-    if (channelconvert) {
+    if (channelconvert && channel_matrix) {
+        void* buf = (dstconvert || dstbyteswap) ? scratch : dst;
+        MixChannels((float *) buf, (const float *) src, num_frames, src_channels, dst_channels, channel_matrix);
+        src = buf;
+    } else if (channelconvert) {
         SDL_AudioChannelConverter channel_converter;
         SDL_AudioChannelConverter override = NULL;
 
@@ -335,6 +685,13 @@ void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, i
         src = buf;
     }
 
+    // Volume and panning, while we're in float32 and have the final channel count.
+    if (gain) {
+        void* buf = (dstconvert || dstbyteswap) ? scratch : dst;
+        ApplyAudioGain((float *) buf, (const float *) src, num_frames, dst_channels, gain);
+        src = buf;
+    }
+
     // Resampling is not done in here. SDL_AudioStream handles that.
 
     // Move to final data type.
@@ -414,6 +771,8 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
     }
 
     retval->freq_ratio = 1.0f;
+    retval->gain = 1.0f;
+    retval->resample_quality = SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM;
     retval->queue = SDL_CreateAudioQueue(4096);
 
     if (!retval->queue) {
@@ -470,6 +829,7 @@ int SDL_SetAudioStreamPutCallback(SDL_AudioStream *stream, SDL_AudioStreamCallba
     SDL_LockMutex(stream->lock);
     stream->put_callback = callback;
     stream->put_callback_userdata = userdata;
+    SDL_AtomicSet(&stream->lock_free_puts, (stream->lock_free && !callback) ? 1 : 0);
     SDL_UnlockMutex(stream->lock);
     return 0;
 }
@@ -516,12 +876,8 @@ int SDL_GetAudioStreamFormat(SDL_AudioStream *stream, SDL_AudioSpec *src_spec, S
     return 0;
 }
 
-int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
+static int CheckAudioStreamSpecs(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
 {
-    if (!stream) {
-        return SDL_InvalidParamError("stream");
-    }
-
     // Picked mostly arbitrarily.
     static const int min_freq = 4000;
     static const int max_freq = 384000;
@@ -554,6 +910,19 @@ int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_s
         }
     }
 
+    return 0;
+}
+
+int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    if (CheckAudioStreamSpecs(src_spec, dst_spec) != 0) {
+        return -1;
+    }
+
     SDL_LockMutex(stream->lock);
 
     // quietly refuse to change the format of the end currently bound to a device.
@@ -615,6 +984,177 @@ int SDL_SetAudioStreamFrequencyRatio(SDL_AudioStream *stream, float freq_ratio)
     return 0;
 }
 
+SDL_AudioResampleQuality SDL_GetAudioStreamResampleQuality(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM;
+    }
+
+    SDL_LockMutex(stream->lock);
+    const SDL_AudioResampleQuality quality = stream->resample_quality;
+    SDL_UnlockMutex(stream->lock);
+
+    return quality;
+}
+
+int SDL_SetAudioStreamResampleQuality(SDL_AudioStream *stream, SDL_AudioResampleQuality quality)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_QUALITY_LOW:
+    case SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM:
+    case SDL_AUDIO_RESAMPLE_QUALITY_HIGH:
+        break;
+    default:
+        return SDL_InvalidParamError("quality");
+    }
+
+    SDL_LockMutex(stream->lock);
+    stream->resample_quality = quality;
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+float SDL_GetAudioStreamGain(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return -1.0f;
+    }
+
+    SDL_LockMutex(stream->lock);
+    const float gain = stream->gain;
+    SDL_UnlockMutex(stream->lock);
+
+    return gain;
+}
+
+int SDL_SetAudioStreamGain(SDL_AudioStream *stream, float gain)
+{
+    return SDL_FadeAudioStreamGain(stream, gain, 0);
+}
+
+int SDL_FadeAudioStreamGain(SDL_AudioStream *stream, float gain, int frames)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (gain < 0.0f) {
+        return SDL_InvalidParamError("gain");
+    } else if (frames < 0) {
+        return SDL_InvalidParamError("frames");
+    }
+
+    SDL_LockMutex(stream->lock);
+    stream->fade_gain = gain;
+    stream->fade_frames = frames;
+    if (frames == 0) {
+        stream->gain = gain;
+    }
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+float SDL_GetAudioStreamPan(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return 0.0f;
+    }
+
+    SDL_LockMutex(stream->lock);
+    const float pan = stream->pan;
+    SDL_UnlockMutex(stream->lock);
+
+    return pan;
+}
+
+int SDL_SetAudioStreamPan(SDL_AudioStream *stream, float pan)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if ((pan < -1.0f) || (pan > 1.0f)) {
+        return SDL_InvalidParamError("pan");
+    }
+
+    SDL_LockMutex(stream->lock);
+    stream->pan = pan;
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+int SDL_SetAudioStreamChannelMatrix(SDL_AudioStream *stream, int src_channels, int dst_channels, const float *matrix)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (matrix && !SDL_IsSupportedChannelCount(src_channels)) {
+        return SDL_InvalidParamError("src_channels");
+    } else if (matrix && !SDL_IsSupportedChannelCount(dst_channels)) {
+        return SDL_InvalidParamError("dst_channels");
+    }
+
+    SDL_LockMutex(stream->lock);
+    if (matrix) {
+        SDL_memcpy(stream->channel_matrix, matrix, src_channels * dst_channels * sizeof (float));
+        stream->channel_matrix_src_channels = src_channels;
+        stream->channel_matrix_dst_channels = dst_channels;
+    } else {
+        stream->channel_matrix_src_channels = 0;
+        stream->channel_matrix_dst_channels = 0;
+    }
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+int SDL_SetAudioStreamLockFree(SDL_AudioStream *stream, SDL_bool enabled)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    SDL_LockMutex(stream->lock);
+    stream->lock_free = enabled ? SDL_TRUE : SDL_FALSE;
+    SDL_AtomicSet(&stream->lock_free_puts, (stream->lock_free && !stream->put_callback) ? 1 : 0);
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+int SDL_SetAudioStreamPreconvert(SDL_AudioStream *stream, SDL_bool enabled)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    SDL_LockMutex(stream->lock);
+    if (enabled && !stream->preconverted) {
+        stream->preconverted = SDL_CreateAudioQueue(SDL_GetAudioQueueChunkSize(stream->queue));
+        if (!stream->preconverted) {
+            SDL_UnlockMutex(stream->lock);
+            return -1;
+        }
+    }
+    // anything already converted still gets read first if this is turned off, so nothing is lost or reordered.
+    stream->preconvert = enabled ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockMutex(stream->lock);
+
+    return 0;
+}
+
+// Move data added by lock-free puts into the queue proper.
+// You must hold stream->lock before calling this!
+static void CommitPendingAudioStreamData(SDL_AudioStream *stream)
+{
+    stream->total_bytes_queued += SDL_CommitPendingAudioTracks(stream->queue);
+}
+
 static int CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
 {
     if (stream->src_spec.format == 0) {
@@ -626,10 +1166,23 @@ static int CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
     return 0;
 }
 
-int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
+static int PreconvertAudioStreamData(SDL_AudioStream *stream);
+
+// Make a track for a put: either a copy of the data, or a track that reads the app's buffer directly.
+static SDL_AudioTrack *CreateAudioStreamTrack(SDL_AudioStream *stream, const SDL_AudioSpec *spec, const void *buf, int len,
+                                              SDL_bool no_copy, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    if (no_copy) {
+        return SDL_CreateExternalAudioTrack(spec, (const Uint8 *) buf, len, callback, userdata);
+    }
+    return SDL_CreateChunkedAudioTrack(spec, (const Uint8 *) buf, len, SDL_GetAudioQueueChunkSize(stream->queue));
+}
+
+static int PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len,
+                              SDL_bool no_copy, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
 {
 #if DEBUG_AUDIOSTREAM
-    SDL_Log("AUDIOSTREAM: wants to put %d bytes", len);
+    SDL_Log("AUDIOSTREAM: wants to put %d bytes%s", len, no_copy ? " (without copying)" : "");
 #endif
 
     if (!stream) {
@@ -642,6 +1195,27 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return 0; // nothing to do.
     }
 
+    if (SDL_AtomicGet(&stream->lock_free_puts)) {
+        // The putting thread owns the source format in this mode, so it's safe to read it here.
+        SDL_AudioSpec src_spec;
+        SDL_copyp(&src_spec, &stream->src_spec);
+
+        if (src_spec.format == 0) {
+            return SDL_SetError("Stream has no source format");
+        } else if ((len % SDL_AUDIO_FRAMESIZE(src_spec)) != 0) {
+            return SDL_SetError("Can't add partial sample frames");
+        }
+
+        // Build the whole track here, and hand it to whoever next holds the stream lock.
+        SDL_AudioTrack *track = CreateAudioStreamTrack(stream, &src_spec, buf, len, no_copy, callback, userdata);
+        if (!track) {
+            return -1;
+        }
+
+        SDL_AddPendingTrackToAudioQueue(stream->queue, track);
+        return 0;
+    }
+
     SDL_LockMutex(stream->lock);
 
     if (CheckAudioStreamIsFullySetup(stream) != 0) {
@@ -654,20 +1228,29 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    CommitPendingAudioStreamData(stream);  // keep anything put before lock-free mode was disabled in order.
+
     SDL_AudioTrack* track = NULL;
 
     // When copying in large amounts of data, try and do as much work as possible
     // outside of the stream lock, otherwise the output device is likely to be starved.
     const int large_input_thresh = 1024 * 1024;
 
-    if (len >= large_input_thresh) {
+    if (no_copy) {
+        // nothing to copy, so this is cheap enough to do under the lock.
+        track = CreateAudioStreamTrack(stream, &stream->src_spec, buf, len, no_copy, callback, userdata);
+
+        if (!track) {
+            SDL_UnlockMutex(stream->lock);
+            return -1;
+        }
+    } else if (len >= large_input_thresh) {
         SDL_AudioSpec src_spec;
         SDL_copyp(&src_spec, &stream->src_spec);
 
         SDL_UnlockMutex(stream->lock);
 
-        size_t chunk_size = SDL_GetAudioQueueChunkSize(stream->queue);
-        track = SDL_CreateChunkedAudioTrack(&src_spec, buf, len, chunk_size);
+        track = CreateAudioStreamTrack(stream, &src_spec, buf, len, no_copy, callback, userdata);
 
         if (!track) {
             return -1;
@@ -694,11 +1277,27 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         }
     }
 
+    const SDL_bool preconvert = stream->preconvert;
+
     SDL_UnlockMutex(stream->lock);
 
+    if ((retval == 0) && preconvert) {
+        retval = PreconvertAudioStreamData(stream);
+    }
+
     return retval;
 }
 
+int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
+{
+    return PutAudioStreamData(stream, buf, len, SDL_FALSE, NULL, NULL);
+}
+
+int SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    return PutAudioStreamData(stream, buf, len, SDL_TRUE, callback, userdata);
+}
+
 int SDL_FlushAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -706,9 +1305,16 @@ int SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    CommitPendingAudioStreamData(stream);
     SDL_FlushAudioQueue(stream->queue);
+    const SDL_bool preconvert = stream->preconvert;
     SDL_UnlockMutex(stream->lock);
 
+    // the end of the data can be converted now, too.
+    if (preconvert) {
+        return PreconvertAudioStreamData(stream);
+    }
+
     return 0;
 }
 
@@ -788,7 +1394,7 @@ static Sint64 NextAudioStreamIter(SDL_AudioStream* stream, void** inout_iter,
         // Past the end of the track, the right padding is filled with silence.
         // But we only want to do that if the track is actually finished (flushed).
         if (!flushed) {
-            output_frames -= SDL_GetResamplerPaddingFrames(resample_rate);
+            output_frames -= SDL_GetResamplerPaddingFrames(resample_rate, stream->resample_quality);
         }
 
         output_frames = SDL_GetResamplerOutputFrames(output_frames, resample_rate, &resample_offset);
@@ -845,6 +1451,50 @@ static Sint64 GetAudioStreamHead(SDL_AudioStream* stream, SDL_AudioSpec* out_spe
     return NextAudioStreamIter(stream, &iter, &resample_offset, out_spec, out_flushed);
 }
 
+// Work out the gain for the next `output_frames` frames of output. Returns SDL_FALSE if the volume doesn't need changing.
+static SDL_bool CalculateAudioStreamGain(const SDL_AudioStream *stream, int output_frames, SDL_AudioGain *gain)
+{
+    if ((stream->fade_frames == 0) && (stream->gain == 1.0f) && (stream->pan == 0.0f)) {
+        return SDL_FALSE;
+    }
+
+    gain->start = stream->gain;
+    if (stream->fade_frames > 0) {
+        gain->step = (stream->fade_gain - stream->gain) / (float) stream->fade_frames;
+        gain->ramp_frames = SDL_min(output_frames, stream->fade_frames);
+    } else {
+        gain->step = 0.0f;
+        gain->ramp_frames = 0;
+    }
+
+    // Linear balance: panning turns one side down, and leaves the other at full volume.
+    gain->left = (stream->pan > 0.0f) ? (1.0f - stream->pan) : 1.0f;
+    gain->right = (stream->pan < 0.0f) ? (1.0f + stream->pan) : 1.0f;
+
+    return SDL_TRUE;
+}
+
+// Move any fade in progress along by the `output_frames` frames just produced.
+static void AdvanceAudioStreamFade(SDL_AudioStream *stream, int output_frames)
+{
+    if (stream->fade_frames > 0) {
+        const int frames = SDL_min(output_frames, stream->fade_frames);
+        const float step = (stream->fade_gain - stream->gain) / (float) stream->fade_frames;
+
+        stream->fade_frames -= frames;
+        stream->gain = stream->fade_frames ? (stream->gain + (step * (float) frames)) : stream->fade_gain;
+    }
+}
+
+// The custom channel matrix, if there is one and it fits the data being processed right now.
+static const float *GetAudioStreamChannelMatrix(const SDL_AudioStream *stream)
+{
+    if ((stream->channel_matrix_src_channels == stream->input_spec.channels) && (stream->channel_matrix_dst_channels == stream->dst_spec.channels)) {
+        return stream->channel_matrix;
+    }
+    return NULL;
+}
+
 // You must hold stream->lock and validate your parameters before calling this!
 // Enough input data MUST be available!
 static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int output_frames)
@@ -862,6 +1512,11 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     const int max_frame_size = CalculateMaxFrameSize(src_format, src_channels, dst_format, dst_channels);
     const Sint64 resample_rate = GetAudioStreamResampleRate(stream, src_spec->freq, stream->resample_offset);
 
+    const float *channel_matrix = GetAudioStreamChannelMatrix(stream);
+
+    SDL_AudioGain gain_data;
+    const SDL_AudioGain *gain = CalculateAudioStreamGain(stream, output_frames, &gain_data) ? &gain_data : NULL;
+
 #if DEBUG_AUDIOSTREAM
     SDL_Log("AUDIOSTREAM: asking for %d frames.", output_frames);
 #endif
@@ -875,7 +1530,8 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
         // If no conversion is happening, read straight into the output buffer.
         // Note, this is just to avoid extra copies.
         // Some other formats may fit directly into the output buffer, but i'd rather process data in a SIMD-aligned buffer.
-        if ((src_format == dst_format) && (src_channels == dst_channels)) {
+        // Applying gain or a channel matrix to float32 data can happen in place, but other formats need room to go through float32.
+        if ((src_format == dst_format) && (src_channels == dst_channels) && ((!gain && !channel_matrix) || (src_format == SDL_AUDIO_F32))) {
             input_buffer = buf;
         } else {
             input_buffer = EnsureAudioStreamWorkBufferSize(stream, output_frames * max_frame_size);
@@ -896,10 +1552,12 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
         UpdateAudioStreamHistoryBuffer(stream, input_buffer, input_bytes, NULL, 0);
 
         // Convert the data, if necessary
-        if (buf != input_buffer) {
-            ConvertAudio(output_frames, input_buffer, src_format, src_channels, buf, dst_format, dst_channels, input_buffer);
+        if ((buf != input_buffer) || channel_matrix || gain) {
+            ConvertAudio(output_frames, input_buffer, src_format, src_channels, buf, dst_format, dst_channels, input_buffer, channel_matrix, gain);
         }
 
+        AdvanceAudioStreamFade(stream, output_frames);
+
         return 0;
     }
 
@@ -911,13 +1569,16 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     const int input_frames = (int) SDL_GetResamplerInputFrames(output_frames, resample_rate, stream->resample_offset);
     const int input_bytes = input_frames * src_frame_size;
 
-    const int resampler_padding_frames = SDL_GetResamplerPaddingFrames(resample_rate);
+    const int resampler_padding_frames = SDL_GetResamplerPaddingFrames(resample_rate, stream->resample_quality);
 
     // If increasing channels, do it after resampling, since we'd just
     // do more work to resample duplicate channels. If we're decreasing, do
     // it first so we resample the interpolated data instead of interpolating
     // the resampled data.
+    // A custom channel matrix goes wherever the channel count changes (or first, if it doesn't).
     const int resample_channels = SDL_min(src_channels, dst_channels);
+    const float *pre_resample_matrix = (dst_channels <= src_channels) ? channel_matrix : NULL;
+    const float *post_resample_matrix = (dst_channels > src_channels) ? channel_matrix : NULL;
 
     // The size of the frame used when resampling
     const int resample_frame_size = resample_channels * sizeof(float);
@@ -993,7 +1654,7 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     SDL_assert(work_buffer_frames == input_frames + (resampler_padding_frames * 2));
 
     // Resampling! get the work buffer to float32 format, etc, in-place.
-    ConvertAudio(work_buffer_frames, work_buffer, src_format, src_channels, work_buffer, SDL_AUDIO_F32, resample_channels, NULL);
+    ConvertAudio(work_buffer_frames, work_buffer, src_format, src_channels, work_buffer, SDL_AUDIO_F32, resample_channels, NULL, pre_resample_matrix, NULL);
 
     // Update the work_buffer pointers based on the new frame size
     input_buffer = work_buffer + ((input_buffer - work_buffer) / src_frame_size * resample_frame_size);
@@ -1006,16 +1667,192 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     SDL_ResampleAudio(resample_channels,
                   (const float *) input_buffer, input_frames,
                   (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+                  resample_rate, &stream->resample_offset, stream->resample_quality);
 
-    // Convert to the final format, if necessary
-    if (buf != resample_buffer) {
-        ConvertAudio(output_frames, resample_buffer, SDL_AUDIO_F32, resample_channels, buf, dst_format, dst_channels, work_buffer);
+    // Convert to the final format (and volume), if necessary
+    if ((buf != resample_buffer) || post_resample_matrix || gain) {
+        ConvertAudio(output_frames, resample_buffer, SDL_AUDIO_F32, resample_channels, buf, dst_format, dst_channels, work_buffer, post_resample_matrix, gain);
     }
 
+    AdvanceAudioStreamFade(stream, output_frames);
+
     return 0;
 }
 
+// Convert and resample as much queued data as is available, up to `len` bytes. Returns bytes written, or -1 on error.
+// You must hold stream->lock before calling this!
+static int ConvertAudioStreamData(SDL_AudioStream *stream, Uint8 *buf, int len)
+{
+    const int dst_frame_size = SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+
+    // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
+    const int chunk_size = 4096;
+
+    int total = 0;
+
+    while (total < len) {
+        // Audio is processed a track at a time.
+        SDL_AudioSpec input_spec;
+        SDL_bool flushed;
+        const Sint64 available_frames = GetAudioStreamHead(stream, &input_spec, &flushed);
+
+        if (available_frames == 0) {
+            if (flushed) {
+                SDL_PopAudioQueueHead(stream->queue);
+                SDL_zero(stream->input_spec);
+                stream->resample_offset = 0;
+                continue;
+            }
+            // There are no frames available, but the track hasn't been flushed, so more might be added later.
+            break;
+        }
+
+        if (UpdateAudioStreamInputSpec(stream, &input_spec) != 0) {
+            total = total ? total : -1;
+            break;
+        }
+
+        // Clamp the output length to the maximum currently available.
+        // GetAudioStreamDataInternal requires enough input data is available.
+        int output_frames = (len - total) / dst_frame_size;
+        output_frames = SDL_min(output_frames, chunk_size);
+        output_frames = (int) SDL_min(output_frames, available_frames);
+
+        if (GetAudioStreamDataInternal(stream, &buf[total], output_frames) != 0) {
+            total = total ? total : -1;
+            break;
+        }
+
+        total += output_frames * dst_frame_size;
+    }
+
+    return total;
+}
+
+static Uint8 *EnsureAudioStreamPreconvertBufferSize(SDL_AudioStream *stream, size_t newlen)
+{
+    if (stream->preconvert_buffer_allocation >= newlen) {
+        return stream->preconvert_buffer;
+    }
+
+    Uint8 *ptr = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), newlen);
+    if (!ptr) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    SDL_aligned_free(stream->preconvert_buffer);
+    stream->preconvert_buffer = ptr;
+    stream->preconvert_buffer_allocation = newlen;
+    return ptr;
+}
+
+// Read data that was converted at put time. Returns bytes written, or -1 on error.
+// You must hold stream->lock before calling this!
+static int GetPreconvertedAudioStreamData(SDL_AudioStream *stream, Uint8 *buf, int len)
+{
+    const SDL_AudioSpec *dst_spec = &stream->dst_spec;
+    const int dst_frame_size = SDL_AUDIO_FRAMESIZE(*dst_spec);
+    const int chunk_size = 4096;
+    int total = 0;
+
+    while ((total < len) && (stream->preconverted_bytes > 0)) {
+        void *iter = SDL_BeginAudioQueueIter(stream->preconverted);
+        if (!iter) {
+            break;
+        }
+
+        SDL_AudioSpec spec;
+        SDL_bool flushed;
+        const size_t available = SDL_NextAudioQueueIter(stream->preconverted, &iter, &spec, &flushed);
+        if (available == 0) {
+            if (!flushed) {
+                break;
+            }
+            SDL_PopAudioQueueHead(stream->preconverted);
+            continue;
+        }
+
+        const int frame_size = SDL_AUDIO_FRAMESIZE(spec);
+        int frames = (int) SDL_min(available / frame_size, (size_t) ((len - total) / dst_frame_size));
+        frames = SDL_min(frames, chunk_size);
+        const int bytes = frames * frame_size;
+        int written = 0;
+
+        if (AUDIO_SPECS_EQUAL(spec, *dst_spec)) {
+            if (SDL_ReadFromAudioQueue(stream->preconverted, &buf[total], bytes) != 0) {
+                return total ? total : -1;
+            }
+            written = bytes;
+        } else {
+            // The output format changed after this was converted, like a device moving between mixing paths.
+            Uint8 *scratch = EnsureAudioStreamPreconvertBufferSize(stream, (size_t) frames * CalculateMaxFrameSize(spec.format, spec.channels, dst_spec->format, dst_spec->channels));
+            if (!scratch || (SDL_ReadFromAudioQueue(stream->preconverted, scratch, bytes) != 0)) {
+                return total ? total : -1;
+            }
+
+            if (spec.freq == dst_spec->freq) {  // just finish the job with a format/channel conversion.
+                ConvertAudio(frames, scratch, spec.format, spec.channels, &buf[total], dst_spec->format, dst_spec->channels, scratch, NULL, NULL);
+                written = frames * dst_frame_size;
+            }
+            // otherwise, it was resampled for a rate we aren't playing at anymore, so it was just dropped.
+        }
+
+        // the input this came from stops counting as queued as it gets read out.
+        const Uint64 input_bytes = (stream->preconverted_input_bytes * (Uint64) bytes) / stream->preconverted_bytes;
+        stream->preconverted_input_bytes -= input_bytes;
+        stream->preconverted_bytes -= bytes;
+        if (stream->preconverted_bytes == 0) {
+            stream->preconverted_input_bytes = 0;
+        }
+
+        total += written;
+    }
+
+    return total;
+}
+
+// Convert everything that's ready in the queue into the preconverted queue, a chunk at a time, so a thread
+//  reading from this stream only waits for one chunk if it needs the lock meanwhile.
+static int PreconvertAudioStreamData(SDL_AudioStream *stream)
+{
+    const int chunk_frames = 4096;
+    int retval = 0;
+
+    for (;;) {
+        SDL_LockMutex(stream->lock);
+
+        if (!stream->preconvert || (CheckAudioStreamIsFullySetup(stream) != 0)) {
+            SDL_UnlockMutex(stream->lock);
+            break;
+        }
+
+        const int chunk_bytes = chunk_frames * SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+        Uint8 *buffer = EnsureAudioStreamPreconvertBufferSize(stream, (size_t) chunk_bytes);
+        const Uint64 queued_before = stream->total_bytes_queued;
+        const int br = buffer ? ConvertAudioStreamData(stream, buffer, chunk_bytes) : -1;
+
+        if (br > 0) {
+            if (SDL_WriteToAudioQueue(stream->preconverted, &stream->dst_spec, buffer, br) != 0) {
+                retval = -1;  // the converted data is lost, but the stream state is still consistent.
+            } else {
+                stream->preconverted_bytes += br;
+                stream->preconverted_input_bytes += queued_before - stream->total_bytes_queued;
+            }
+        } else if (br < 0) {
+            retval = -1;
+        }
+
+        SDL_UnlockMutex(stream->lock);
+
+        if ((br < chunk_bytes) || (retval < 0)) {
+            break;  // converted everything that's ready.
+        }
+    }
+
+    return retval;
+}
+
 // get converted/resampled data from the stream
 int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 {
@@ -1046,6 +1883,8 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 
     len -= len % dst_frame_size;  // chop off any fractional sample frame.
 
+    CommitPendingAudioStreamData(stream);
+
     // give the callback a chance to fill in more stream data if it wants.
     if (stream->get_callback) {
         Sint64 total_request = len / dst_frame_size;  // start with sample frames desired
@@ -1053,6 +1892,7 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 
         Sint64 resample_offset = 0;
         Sint64 available_frames = GetAudioStreamAvailableFrames(stream, &resample_offset);
+        available_frames += (Sint64) (stream->preconverted_bytes / dst_frame_size);
 
         additional_request -= SDL_min(additional_request, available_frames);
 
@@ -1066,47 +1906,23 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
         total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+        CommitPendingAudioStreamData(stream);  // the callback might have put data without the lock.
     }
 
-    // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
-    const int chunk_size = 4096;
-
     int total = 0;
 
-    while (total < len) {
-        // Audio is processed a track at a time.
-        SDL_AudioSpec input_spec;
-        SDL_bool flushed;
-        const Sint64 available_frames = GetAudioStreamHead(stream, &input_spec, &flushed);
-
-        if (available_frames == 0) {
-            if (flushed) {
-                SDL_PopAudioQueueHead(stream->queue);
-                SDL_zero(stream->input_spec);
-                stream->resample_offset = 0;
-                continue;
-            }
-            // There are no frames available, but the track hasn't been flushed, so more might be added later.
-            break;
-        }
-
-        if (UpdateAudioStreamInputSpec(stream, &input_spec) != 0) {
-            total = total ? total : -1;
-            break;
-        }
-
-        // Clamp the output length to the maximum currently available.
-        // GetAudioStreamDataInternal requires enough input data is available.
-        int output_frames = (len - total) / dst_frame_size;
-        output_frames = SDL_min(output_frames, chunk_size);
-        output_frames = (int) SDL_min(output_frames, available_frames);
+    // anything converted at put time comes first, it's older than what's still in the queue.
+    if (stream->preconverted_bytes > 0) {
+        total = GetPreconvertedAudioStreamData(stream, buf, len);
+    }
 
-        if (GetAudioStreamDataInternal(stream, &buf[total], output_frames) != 0) {
+    if ((total >= 0) && (total < len)) {
+        const int br = ConvertAudioStreamData(stream, &buf[total], len - total);
+        if (br < 0) {
             total = total ? total : -1;
-            break;
+        } else {
+            total += br;
         }
-
-        total += output_frames * dst_frame_size;
     }
 
     SDL_UnlockMutex(stream->lock);
@@ -1132,10 +1948,13 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
         return 0;
     }
 
+    CommitPendingAudioStreamData(stream);
+
     Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
 
     // convert from sample frames to bytes in destination format.
     count *= SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+    count += (Sint64) stream->preconverted_bytes;
 
     SDL_UnlockMutex(stream->lock);
 
@@ -1151,7 +1970,8 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
-    const Uint64 total = stream->total_bytes_queued;
+    CommitPendingAudioStreamData(stream);
+    const Uint64 total = stream->total_bytes_queued + stream->preconverted_input_bytes;
     SDL_UnlockMutex(stream->lock);
 
     // if this overflows an int, just clamp it to a maximum.
@@ -1166,10 +1986,16 @@ int SDL_ClearAudioStream(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    CommitPendingAudioStreamData(stream);
     SDL_ClearAudioQueue(stream->queue);
     SDL_zero(stream->input_spec);
     stream->resample_offset = 0;
     stream->total_bytes_queued = 0;
+    if (stream->preconverted) {
+        SDL_ClearAudioQueue(stream->preconverted);
+    }
+    stream->preconverted_bytes = 0;
+    stream->preconverted_input_bytes = 0;
 
     SDL_UnlockMutex(stream->lock);
     return 0;
@@ -1197,12 +2023,159 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
 
     SDL_aligned_free(stream->history_buffer);
     SDL_aligned_free(stream->work_buffer);
+    SDL_aligned_free(stream->preconvert_buffer);
     SDL_DestroyAudioQueue(stream->queue);
+    if (stream->preconverted) {
+        SDL_DestroyAudioQueue(stream->preconverted);
+    }
     SDL_DestroyMutex(stream->lock);
 
     SDL_free(stream);
 }
 
+// One-shot conversions work like a new stream that has everything put and flushed at once:
+//  silence before the start and after the end, the default resampler quality, no gain and no channel matrix.
+//  They skip the stream's queue and locking, and convert straight from the caller's buffer.
+#define CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES 4096
+#define MIN_THREADED_CONVERT_AUDIO_FRAMES (256 * 1024)
+#define MAX_CONVERT_AUDIO_THREADS 16
+
+typedef struct ConvertAudioSamplesJob
+{
+    const SDL_AudioSpec *src_spec;
+    const Uint8 *src;
+    int src_frames;
+    const SDL_AudioSpec *dst_spec;
+    Uint8 *dst;
+    Sint64 resample_rate;
+    int first_frame;  // the output frames this job converts
+    int num_frames;
+    int retval;
+} ConvertAudioSamplesJob;
+
+static Uint8 *EnsureConvertAudioBufferSize(Uint8 **buffer, size_t *allocation, size_t newlen)
+{
+    if (*allocation < newlen) {
+        Uint8 *ptr = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), newlen);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        SDL_aligned_free(*buffer);
+        *buffer = ptr;
+        *allocation = newlen;
+    }
+    return *buffer;
+}
+
+static int ConvertAudioSamplesRange(ConvertAudioSamplesJob *job)
+{
+    const SDL_AudioFormat src_format = job->src_spec->format;
+    const int src_channels = job->src_spec->channels;
+    const int src_frame_size = SDL_AUDIO_FRAMESIZE(*job->src_spec);
+    const SDL_AudioFormat dst_format = job->dst_spec->format;
+    const int dst_channels = job->dst_spec->channels;
+    const int dst_frame_size = SDL_AUDIO_FRAMESIZE(*job->dst_spec);
+    const int max_frame_size = CalculateMaxFrameSize(src_format, src_channels, dst_format, dst_channels);
+    const Sint64 resample_rate = job->resample_rate;
+    const int end_frame = job->first_frame + job->num_frames;
+    Uint8 *work_buffer = NULL;
+    size_t work_buffer_allocation = 0;
+    int retval = 0;
+    int frame, output_frames;
+
+    for (frame = job->first_frame; frame < end_frame; frame += output_frames) {
+        output_frames = SDL_min(end_frame - frame, CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES);
+        Uint8 *buf = job->dst + (size_t) frame * dst_frame_size;
+
+        if (resample_rate == 0) {
+            if (!EnsureConvertAudioBufferSize(&work_buffer, &work_buffer_allocation, (size_t) output_frames * max_frame_size)) {
+                retval = -1;
+                break;
+            }
+            ConvertAudio(output_frames, job->src + (size_t) frame * src_frame_size, src_format, src_channels, buf, dst_format, dst_channels, work_buffer, NULL, NULL);
+            continue;
+        }
+
+        // Where this chunk starts in the input, the stream would have got here a chunk at a time.
+        const Sint64 srcpos = (Sint64) frame * resample_rate;
+        const int input_start = (int) (srcpos >> 32);
+        Sint64 resample_offset = srcpos & 0xFFFFFFFF;
+        const int input_frames = (int) SDL_GetResamplerInputFrames(output_frames, resample_rate, resample_offset);
+        const int padding_frames = SDL_GetResamplerPaddingFrames(resample_rate, SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM);
+        const int work_buffer_frames = input_frames + (padding_frames * 2);
+        const int resample_channels = SDL_min(src_channels, dst_channels);
+        const int resample_frame_size = resample_channels * sizeof(float);
+
+        // Same layout as the stream's work buffer: the input with its padding, then the resampled output if it can't go straight to buf.
+        size_t work_buffer_capacity = SDL_max((size_t) work_buffer_frames, (size_t) output_frames) * max_frame_size;
+        size_t resample_buffer_offset = 0;
+        if ((dst_format != SDL_AUDIO_F32) || (dst_channels != resample_channels)) {
+            const size_t simd_alignment = SDL_SIMDGetAlignment();
+            work_buffer_capacity = (work_buffer_capacity + simd_alignment - 1) & ~(simd_alignment - 1);
+            resample_buffer_offset = work_buffer_capacity;
+            work_buffer_capacity += (size_t) output_frames * resample_frame_size;
+        }
+
+        if (!EnsureConvertAudioBufferSize(&work_buffer, &work_buffer_allocation, work_buffer_capacity)) {
+            retval = -1;
+            break;
+        }
+
+        // Copy in the input and padding, with silence outside of the data.
+        const int first = input_start - padding_frames;
+        const int copy_start = SDL_max(first, 0);
+        const int copy_end = SDL_min(first + work_buffer_frames, job->src_frames);
+        if (copy_end <= copy_start) {
+            SDL_memset(work_buffer, SDL_GetSilenceValueForFormat(src_format), (size_t) work_buffer_frames * src_frame_size);
+        } else {
+            SDL_memset(work_buffer, SDL_GetSilenceValueForFormat(src_format), (size_t) (copy_start - first) * src_frame_size);
+            SDL_memcpy(work_buffer + (size_t) (copy_start - first) * src_frame_size, job->src + (size_t) copy_start * src_frame_size, (size_t) (copy_end - copy_start) * src_frame_size);
+            SDL_memset(work_buffer + (size_t) (copy_end - first) * src_frame_size, SDL_GetSilenceValueForFormat(src_format), (size_t) (first + work_buffer_frames - copy_end) * src_frame_size);
+        }
+
+        ConvertAudio(work_buffer_frames, work_buffer, src_format, src_channels, work_buffer, SDL_AUDIO_F32, resample_channels, NULL, NULL, NULL);
+
+        float *resample_buffer = resample_buffer_offset ? (float *) (work_buffer + resample_buffer_offset) : (float *) buf;
+        SDL_ResampleAudio(resample_channels,
+                          (const float *) work_buffer + (padding_frames * resample_channels), input_frames,
+                          resample_buffer, output_frames,
+                          resample_rate, &resample_offset, SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM);
+
+        if ((Uint8 *) resample_buffer != buf) {
+            ConvertAudio(output_frames, resample_buffer, SDL_AUDIO_F32, resample_channels, buf, dst_format, dst_channels, work_buffer, NULL, NULL);
+        }
+    }
+
+    SDL_aligned_free(work_buffer);
+    return retval;
+}
+
+static int SDLCALL ConvertAudioSamplesThread(void *data)
+{
+    ConvertAudioSamplesJob *job = (ConvertAudioSamplesJob *) data;
+    job->retval = ConvertAudioSamplesRange(job);
+    return 0;
+}
+
+static int GetNumConvertAudioThreads(int output_frames)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_CONVERT_THREADS);
+    int num_threads = 0;
+
+    if (output_frames < MIN_THREADED_CONVERT_AUDIO_FRAMES) {
+        return 1;
+    }
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+        if (num_threads < 0) {
+            num_threads = SDL_GetCPUCount();
+        }
+    }
+    num_threads = SDL_min(num_threads, output_frames / CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES);
+    return SDL_clamp(num_threads, 1, MAX_CONVERT_AUDIO_THREADS);
+}
+
 int SDL_ConvertAudioSamples(const SDL_AudioSpec *src_spec, const Uint8 *src_data, int src_len,
                             const SDL_AudioSpec *dst_spec, Uint8 **dst_data, int *dst_len)
 {
@@ -1222,34 +2195,89 @@ int SDL_ConvertAudioSamples(const SDL_AudioSpec *src_spec, const Uint8 *src_data
         return SDL_InvalidParamError("dst_data");
     } else if (!dst_len) {
         return SDL_InvalidParamError("dst_len");
+    } else if (!src_spec) {
+        return SDL_InvalidParamError("src_spec");
+    } else if (!dst_spec) {
+        return SDL_InvalidParamError("dst_spec");
+    } else if (CheckAudioStreamSpecs(src_spec, dst_spec) != 0) {
+        return -1;
     }
 
-    int retval = -1;
-    Uint8 *dst = NULL;
-    int dstlen = 0;
+    const int src_frame_size = SDL_AUDIO_FRAMESIZE(*src_spec);
+    const int dst_frame_size = SDL_AUDIO_FRAMESIZE(*dst_spec);
 
-    SDL_AudioStream *stream = SDL_CreateAudioStream(src_spec, dst_spec);
-    if (stream) {
-        if ((SDL_PutAudioStreamData(stream, src_data, src_len) == 0) && (SDL_FlushAudioStream(stream) == 0)) {
-            dstlen = SDL_GetAudioStreamAvailable(stream);
-            if (dstlen >= 0) {
-                dst = (Uint8 *)SDL_malloc(dstlen);
-                if (!dst) {
-                    SDL_OutOfMemory();
-                } else {
-                    retval = (SDL_GetAudioStreamData(stream, dst, dstlen) >= 0) ? 0 : -1;
-                }
+    if ((src_len % src_frame_size) != 0) {
+        return SDL_SetError("Can't add partial sample frames");
+    }
+
+    SDL_ChooseAudioConverters();
+    SDL_SetupAudioResampler();
+
+    const int src_frames = src_len / src_frame_size;
+    Sint64 resample_rate = SDL_GetResampleRate(src_spec->freq, dst_spec->freq);
+    Sint64 output_frames = src_frames;
+    if (resample_rate == 0x100000000) {
+        resample_rate = 0;
+    } else {
+        Sint64 resample_offset = 0;
+        output_frames = SDL_GetResamplerOutputFrames(src_frames, resample_rate, &resample_offset);
+    }
+
+    if (output_frames > (SDL_INT_MAX / dst_frame_size)) {
+        return SDL_SetError("Converted audio would be too large");
+    }
+
+    const int dstlen = (int) output_frames * dst_frame_size;
+    Uint8 *dst = (Uint8 *) SDL_malloc(dstlen);
+    if (!dst) {
+        return SDL_OutOfMemory();
+    }
+
+    // Large conversions can be split across threads, every chunk of output is independent.
+    ConvertAudioSamplesJob jobs[MAX_CONVERT_AUDIO_THREADS];
+    SDL_Thread *threads[MAX_CONVERT_AUDIO_THREADS];
+    const int num_jobs = GetNumConvertAudioThreads((int) output_frames);
+    const int frames_per_job = (((int) output_frames / num_jobs) + CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES - 1) / CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES * CONVERT_AUDIO_SAMPLES_CHUNK_FRAMES;
+    int retval = 0;
+    int i;
+
+    for (i = 0; i < num_jobs; i++) {
+        ConvertAudioSamplesJob *job = &jobs[i];
+        job->src_spec = src_spec;
+        job->src = src_data;
+        job->src_frames = src_frames;
+        job->dst_spec = dst_spec;
+        job->dst = dst;
+        job->resample_rate = resample_rate;
+        job->first_frame = (int) SDL_min((Sint64) i * frames_per_job, output_frames);
+        job->num_frames = (i == num_jobs - 1) ? ((int) output_frames - job->first_frame) : (int) SDL_min(frames_per_job, output_frames - job->first_frame);
+        job->retval = 0;
+        threads[i] = NULL;
+        if (i > 0) {
+            threads[i] = SDL_CreateThreadInternal(ConvertAudioSamplesThread, "SDLAudioConv", 0, job);
+            if (!threads[i]) {
+                job->retval = ConvertAudioSamplesRange(job);  // run it here instead.
             }
         }
     }
 
-    if (retval == -1) {
+    jobs[0].retval = ConvertAudioSamplesRange(&jobs[0]);
+
+    for (i = 0; i < num_jobs; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+        if (jobs[i].retval < 0) {
+            retval = -1;
+        }
+    }
+
+    if (retval < 0) {
         SDL_free(dst);
-    } else {
-        *dst_data = dst;
-        *dst_len = dstlen;
+        return -1;
     }
 
-    SDL_DestroyAudioStream(stream);
-    return retval;
+    *dst_data = dst;
+    *dst_len = dstlen;
+    return 0;
 }
@@ -41,6 +41,8 @@ struct SDL_AudioQueue
     SDL_AudioTrack *head;
     SDL_AudioTrack *tail;
     size_t chunk_size;
+
+    void *pending;  // SDL_AudioTrack list, newest first, pushed by SDL_AddPendingTrackToAudioQueue.
 };
 
 typedef struct SDL_AudioChunk SDL_AudioChunk;
@@ -62,25 +64,29 @@ typedef struct SDL_ChunkedAudioTrack
     SDL_AudioChunk *head;
     SDL_AudioChunk *tail;
     size_t queued_bytes;
+} SDL_ChunkedAudioTrack;
 
+// Every queue shares one pool of free chunks, so memory freed by one stream gets reused by the next,
+// instead of each track keeping (and then freeing) a list of its own. Chunks are only interchangeable
+// if they're the same size, so there's a free list per chunk size; in practice there is only one.
+#define NUM_AUDIO_CHUNK_POOLS 4
+
+typedef struct SDL_AudioChunkPool
+{
+    size_t chunk_size;  // zero if this pool is unused.
     SDL_AudioChunk *free_chunks;
-    size_t num_free_chunks;
-} SDL_ChunkedAudioTrack;
+} SDL_AudioChunkPool;
+
+static SDL_SpinLock audio_chunk_pool_lock;
+static SDL_AudioChunkPool audio_chunk_pools[NUM_AUDIO_CHUNK_POOLS];
+static size_t audio_chunk_pool_max_bytes = SDL_AUDIO_CHUNK_POOL_DEFAULT_BYTES;
+static SDL_AudioChunkPoolStats audio_chunk_pool_stats;
 
 static void DestroyAudioChunk(SDL_AudioChunk *chunk)
 {
     SDL_free(chunk);
 }
 
-static void DestroyAudioChunks(SDL_AudioChunk *chunk)
-{
-    while (chunk) {
-        SDL_AudioChunk *next = chunk->next;
-        DestroyAudioChunk(chunk);
-        chunk = next;
-    }
-}
-
 static void ResetAudioChunk(SDL_AudioChunk *chunk)
 {
     chunk->next = NULL;
@@ -88,12 +94,51 @@ static void ResetAudioChunk(SDL_AudioChunk *chunk)
     chunk->tail = 0;
 }
 
+// You must hold audio_chunk_pool_lock before calling this!
+static SDL_AudioChunkPool *GetAudioChunkPool(size_t chunk_size, SDL_bool create)
+{
+    SDL_AudioChunkPool *unused = NULL;
+
+    for (int i = 0; i < NUM_AUDIO_CHUNK_POOLS; i++) {
+        SDL_AudioChunkPool *pool = &audio_chunk_pools[i];
+        if (pool->chunk_size == chunk_size) {
+            return pool;
+        } else if (!unused && (pool->chunk_size == 0)) {
+            unused = pool;
+        }
+    }
+
+    if (create && unused) {
+        unused->chunk_size = chunk_size;
+        return unused;
+    }
+
+    return NULL;
+}
+
 static SDL_AudioChunk *CreateAudioChunk(size_t chunk_size)
 {
-    SDL_AudioChunk *chunk = (SDL_AudioChunk *)SDL_malloc(sizeof(*chunk) + chunk_size);
+    SDL_AtomicLock(&audio_chunk_pool_lock);
+
+    SDL_AudioChunkPool *pool = GetAudioChunkPool(chunk_size, SDL_FALSE);
+    SDL_AudioChunk *chunk = pool ? pool->free_chunks : NULL;
+
+    if (chunk) {
+        pool->free_chunks = chunk->next;
+        audio_chunk_pool_stats.idle_bytes -= chunk_size;
+        ++audio_chunk_pool_stats.reused;
+    } else {
+        ++audio_chunk_pool_stats.allocated;
+    }
+
+    SDL_AtomicUnlock(&audio_chunk_pool_lock);
 
     if (!chunk) {
-        return NULL;
+        chunk = (SDL_AudioChunk *)SDL_malloc(sizeof(*chunk) + chunk_size);
+
+        if (!chunk) {
+            return NULL;
+        }
     }
 
     ResetAudioChunk(chunk);
@@ -101,34 +146,87 @@ static SDL_AudioChunk *CreateAudioChunk(size_t chunk_size)
     return chunk;
 }
 
-static void DestroyAudioTrackChunk(SDL_ChunkedAudioTrack *track, SDL_AudioChunk *chunk)
+// Hand a chunk back to the pool, or free it if the pool is full.
+static void ReleaseAudioChunk(SDL_AudioChunk *chunk, size_t chunk_size)
 {
-    // Keeping a list of free chunks reduces memory allocations,
-    // But also increases the amount of work to perform when freeing the track.
-    const size_t max_free_bytes = 64 * 1024;
+    SDL_AtomicLock(&audio_chunk_pool_lock);
 
-    if (track->chunk_size * track->num_free_chunks < max_free_bytes) {
-        chunk->next = track->free_chunks;
-        track->free_chunks = chunk;
-        ++track->num_free_chunks;
+    SDL_AudioChunkPool *pool = GetAudioChunkPool(chunk_size, SDL_TRUE);
+
+    if (pool && (audio_chunk_pool_stats.idle_bytes + chunk_size <= audio_chunk_pool_max_bytes)) {
+        chunk->next = pool->free_chunks;
+        pool->free_chunks = chunk;
+        audio_chunk_pool_stats.idle_bytes += chunk_size;
+        audio_chunk_pool_stats.peak_idle_bytes = SDL_max(audio_chunk_pool_stats.peak_idle_bytes, audio_chunk_pool_stats.idle_bytes);
+        chunk = NULL;
     } else {
+        ++audio_chunk_pool_stats.freed;
+    }
+
+    SDL_AtomicUnlock(&audio_chunk_pool_lock);
+
+    if (chunk) {
         DestroyAudioChunk(chunk);
     }
 }
 
-static SDL_AudioChunk *CreateAudioTrackChunk(SDL_ChunkedAudioTrack *track)
+static void ReleaseAudioChunks(SDL_AudioChunk *chunk, size_t chunk_size)
+{
+    while (chunk) {
+        SDL_AudioChunk *next = chunk->next;
+        ReleaseAudioChunk(chunk, chunk_size);
+        chunk = next;
+    }
+}
+
+void SDL_SetAudioChunkPoolLimit(size_t max_bytes)
 {
-    if (track->num_free_chunks > 0) {
-        SDL_AudioChunk *chunk = track->free_chunks;
+    SDL_AudioChunk *to_free = NULL;
+
+    SDL_AtomicLock(&audio_chunk_pool_lock);
+
+    audio_chunk_pool_max_bytes = max_bytes;
+
+    // Trim the pools down to the new limit.
+    for (int i = 0; (i < NUM_AUDIO_CHUNK_POOLS) && (audio_chunk_pool_stats.idle_bytes > max_bytes); i++) {
+        SDL_AudioChunkPool *pool = &audio_chunk_pools[i];
+        while (pool->free_chunks && (audio_chunk_pool_stats.idle_bytes > max_bytes)) {
+            SDL_AudioChunk *chunk = pool->free_chunks;
+            pool->free_chunks = chunk->next;
+            audio_chunk_pool_stats.idle_bytes -= pool->chunk_size;
+            ++audio_chunk_pool_stats.freed;
+            chunk->next = to_free;
+            to_free = chunk;
+        }
 
-        track->free_chunks = chunk->next;
-        --track->num_free_chunks;
+        if (!pool->free_chunks) {
+            pool->chunk_size = 0;  // let a different size have this slot.
+        }
+    }
 
-        ResetAudioChunk(chunk);
+    SDL_AtomicUnlock(&audio_chunk_pool_lock);
 
-        return chunk;
+    while (to_free) {
+        SDL_AudioChunk *next = to_free->next;
+        DestroyAudioChunk(to_free);
+        to_free = next;
     }
+}
 
+void SDL_GetAudioChunkPoolStats(SDL_AudioChunkPoolStats *stats)
+{
+    SDL_AtomicLock(&audio_chunk_pool_lock);
+    SDL_copyp(stats, &audio_chunk_pool_stats);
+    SDL_AtomicUnlock(&audio_chunk_pool_lock);
+}
+
+static void DestroyAudioTrackChunk(SDL_ChunkedAudioTrack *track, SDL_AudioChunk *chunk)
+{
+    ReleaseAudioChunk(chunk, track->chunk_size);
+}
+
+static SDL_AudioChunk *CreateAudioTrackChunk(SDL_ChunkedAudioTrack *track)
+{
     return CreateAudioChunk(track->chunk_size);
 }
 
@@ -187,7 +285,7 @@ static int WriteToChunkedAudioTrack(void *ctx, const Uint8 *data, size_t len)
         chunk->next = NULL;
         chunk->tail = old_tail;
 
-        DestroyAudioChunks(next);
+        ReleaseAudioChunks(next, chunk_size);
 
         return SDL_OutOfMemory();
     }
@@ -246,8 +344,7 @@ static size_t ReadFromChunkedAudioTrack(void *ctx, Uint8 *data, size_t len, SDL_
 static void DestroyChunkedAudioTrack(void *ctx)
 {
     SDL_ChunkedAudioTrack *track = ctx;
-    DestroyAudioChunks(track->head);
-    DestroyAudioChunks(track->free_chunks);
+    ReleaseAudioChunks(track->head, track->chunk_size);
     SDL_free(track);
 }
 
@@ -271,6 +368,51 @@ static SDL_AudioTrack *CreateChunkedAudioTrack(const SDL_AudioSpec *spec, size_t
     return &track->track;
 }
 
+// A track that reads straight out of memory the app owns, and tells the app when it's done with it.
+typedef struct SDL_ExternalAudioTrack
+{
+    SDL_AudioTrack track;
+
+    const Uint8 *data;
+    size_t len;
+    size_t head;
+
+    SDL_AudioStreamDataCompleteCallback callback;
+    void *userdata;
+} SDL_ExternalAudioTrack;
+
+static size_t AvailExternalAudioTrack(void *ctx)
+{
+    SDL_ExternalAudioTrack *track = ctx;
+
+    return track->len - track->head;
+}
+
+static size_t ReadFromExternalAudioTrack(void *ctx, Uint8 *data, size_t len, SDL_bool advance)
+{
+    SDL_ExternalAudioTrack *track = ctx;
+
+    size_t to_read = SDL_min(len, track->len - track->head);
+    SDL_memcpy(data, &track->data[track->head], to_read);
+
+    if (advance) {
+        track->head += to_read;
+    }
+
+    return to_read;
+}
+
+static void DestroyExternalAudioTrack(void *ctx)
+{
+    SDL_ExternalAudioTrack *track = ctx;
+
+    if (track->callback) {
+        track->callback(track->userdata, track->data, (int)track->len);
+    }
+
+    SDL_free(track);
+}
+
 SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size)
 {
     SDL_AudioQueue *queue = (SDL_AudioQueue *)SDL_calloc(1, sizeof(*queue));
@@ -285,9 +427,19 @@ SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size)
     return queue;
 }
 
+static void DestroyAudioTracks(SDL_AudioTrack *track)
+{
+    while (track) {
+        SDL_AudioTrack *next = track->next;
+        track->destroy(track);
+        track = next;
+    }
+}
+
 void SDL_DestroyAudioQueue(SDL_AudioQueue *queue)
 {
     SDL_ClearAudioQueue(queue);
+    DestroyAudioTracks((SDL_AudioTrack *)SDL_AtomicSetPtr(&queue->pending, NULL));
 
     SDL_free(queue);
 }
@@ -298,11 +450,7 @@ void SDL_ClearAudioQueue(SDL_AudioQueue *queue)
     queue->head = NULL;
     queue->tail = NULL;
 
-    while (track) {
-        SDL_AudioTrack *next = track->next;
-        track->destroy(track);
-        track = next;
-    }
+    DestroyAudioTracks(track);
 }
 
 static void SDL_FlushAudioTrack(SDL_AudioTrack *track)
@@ -364,6 +512,30 @@ SDL_AudioTrack *SDL_CreateChunkedAudioTrack(const SDL_AudioSpec *spec, const Uin
     return track;
 }
 
+SDL_AudioTrack *SDL_CreateExternalAudioTrack(const SDL_AudioSpec *spec, const Uint8 *data, size_t len,
+                                             SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    SDL_ExternalAudioTrack *track = (SDL_ExternalAudioTrack *)SDL_calloc(1, sizeof(*track));
+
+    if (!track) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    // There's no write function: anything queued after this goes in a new track.
+    SDL_copyp(&track->track.spec, spec);
+    track->track.avail = AvailExternalAudioTrack;
+    track->track.read = ReadFromExternalAudioTrack;
+    track->track.destroy = DestroyExternalAudioTrack;
+
+    track->data = data;
+    track->len = len;
+    track->callback = callback;
+    track->userdata = userdata;
+
+    return &track->track;
+}
+
 void SDL_AddTrackToAudioQueue(SDL_AudioQueue *queue, SDL_AudioTrack *track)
 {
     SDL_AudioTrack *tail = queue->tail;
@@ -382,6 +554,47 @@ void SDL_AddTrackToAudioQueue(SDL_AudioQueue *queue, SDL_AudioTrack *track)
     queue->tail = track;
 }
 
+void SDL_AddPendingTrackToAudioQueue(SDL_AudioQueue *queue, SDL_AudioTrack *track)
+{
+    void *head;
+
+    // The consumer only ever takes the whole list at once, so there is no ABA problem here.
+    do {
+        head = SDL_AtomicGetPtr(&queue->pending);
+        track->next = (SDL_AudioTrack *)head;
+    } while (!SDL_AtomicCASPtr(&queue->pending, head, track));
+}
+
+size_t SDL_CommitPendingAudioTracks(SDL_AudioQueue *queue)
+{
+    if (!SDL_AtomicGetPtr(&queue->pending)) {
+        return 0;  // the common case: don't dirty the cache line.
+    }
+
+    SDL_AudioTrack *track = (SDL_AudioTrack *)SDL_AtomicSetPtr(&queue->pending, NULL);
+    SDL_AudioTrack *oldest = NULL;
+
+    // The list was pushed newest first, so reverse it.
+    while (track) {
+        SDL_AudioTrack *next = track->next;
+        track->next = oldest;
+        oldest = track;
+        track = next;
+    }
+
+    size_t total = 0;
+
+    while (oldest) {
+        SDL_AudioTrack *next = oldest->next;
+        oldest->next = NULL;
+        total += oldest->avail(oldest);
+        SDL_AddTrackToAudioQueue(queue, oldest);
+        oldest = next;
+    }
+
+    return total;
+}
+
 int SDL_WriteToAudioQueue(SDL_AudioQueue *queue, const SDL_AudioSpec *spec, const Uint8 *data, size_t len)
 {
     if (len == 0) {
@@ -469,6 +682,15 @@ int SDL_ReadFromAudioQueue(SDL_AudioQueue *queue, Uint8 *data, size_t len)
         total += track->read(track, &data[total], len - total, SDL_TRUE);
 
         if (total == len) {
+            // A track that can't grow is finished once it's empty, so let it go now instead of
+            // whenever the next read moves past it. Flushed tracks are left for SDL_PopAudioQueueHead.
+            if (!track->write && !track->flushed && (track->avail(track) == 0)) {
+                queue->head = track->next;
+                if (!queue->head) {
+                    queue->tail = NULL;
+                }
+                track->destroy(track);
+            }
             return 0;
         }
 
@@ -28,6 +28,27 @@
 typedef struct SDL_AudioQueue SDL_AudioQueue;
 typedef struct SDL_AudioTrack SDL_AudioTrack;
 
+// Counters for the chunk pool that all audio queues share.
+typedef struct SDL_AudioChunkPoolStats
+{
+    Uint64 allocated;  // chunks that had to come from SDL_malloc
+    Uint64 reused;  // chunks that came from the pool instead
+    Uint64 freed;  // chunks given back to SDL_free because the pool was full
+    size_t idle_bytes;  // memory sitting in the pool right now
+    size_t peak_idle_bytes;
+} SDL_AudioChunkPoolStats;
+
+// How much memory the shared chunk pool holds onto, unless SDL_HINT_AUDIO_CHUNK_POOL_SIZE says otherwise.
+#define SDL_AUDIO_CHUNK_POOL_DEFAULT_BYTES (1024 * 1024)
+
+// Limit how much memory the shared chunk pool can hold onto, freeing anything over the new limit. 0 disables pooling.
+// This can be called from any thread
+void SDL_SetAudioChunkPoolLimit(size_t max_bytes);
+
+// Get a snapshot of the shared chunk pool's counters
+// This can be called from any thread
+void SDL_GetAudioChunkPoolStats(SDL_AudioChunkPoolStats *stats);
+
 // Create a new audio queue
 SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size);
 
@@ -55,10 +76,25 @@ int SDL_WriteToAudioQueue(SDL_AudioQueue *queue, const SDL_AudioSpec *spec, cons
 // Create a track without needing to hold any locks
 SDL_AudioTrack *SDL_CreateChunkedAudioTrack(const SDL_AudioSpec *spec, const Uint8 *data, size_t len, size_t chunk_size);
 
+// Create a track that reads straight from `data` instead of copying it, calling `callback` (if not NULL) when the track is destroyed.
+// Nothing else can be written to this track; SDL_WriteToAudioQueue starts a new one after it.
+// This can be called without holding any locks
+SDL_AudioTrack *SDL_CreateExternalAudioTrack(const SDL_AudioSpec *spec, const Uint8 *data, size_t len,
+                                             SDL_AudioStreamDataCompleteCallback callback, void *userdata);
+
 // Add a track to the end of the queue
 // REQUIRES: `track != NULL`
 void SDL_AddTrackToAudioQueue(SDL_AudioQueue *queue, SDL_AudioTrack *track);
 
+// Add a track to a list of tracks waiting to be added to the end of the queue
+// This can be called from any thread, without holding any locks
+// REQUIRES: `track != NULL`
+void SDL_AddPendingTrackToAudioQueue(SDL_AudioQueue *queue, SDL_AudioTrack *track);
+
+// Move any pending tracks to the end of the queue, in the order they were added
+// Returns the number of bytes moved
+size_t SDL_CommitPendingAudioTracks(SDL_AudioQueue *queue);
+
 // Iterate over the tracks in the queue
 void *SDL_BeginAudioQueueIter(SDL_AudioQueue *queue);
 
@@ -30,7 +30,10 @@
 
 // For a given srcpos, `srcpos + frame` are sampled, where `-RESAMPLER_ZERO_CROSSINGS < frame <= RESAMPLER_ZERO_CROSSINGS`.
 // Note, when upsampling, it is also possible to start sampling from `srcpos = -1`.
-#define RESAMPLER_MAX_PADDING_FRAMES (RESAMPLER_ZERO_CROSSINGS + 1)
+#define RESAMPLER_PADDING_FRAMES (RESAMPLER_ZERO_CROSSINGS + 1)
+#define RESAMPLER_HQ_PADDING_FRAMES (RESAMPLER_HQ_ZERO_CROSSINGS + 1)
+#define RESAMPLER_LINEAR_PADDING_FRAMES 2
+#define RESAMPLER_MAX_PADDING_FRAMES RESAMPLER_HQ_PADDING_FRAMES
 
 #define RESAMPLER_FILTER_INTERP_BITS  (32 - RESAMPLER_BITS_PER_ZERO_CROSSING)
 #define RESAMPLER_FILTER_INTERP_RANGE (1 << RESAMPLER_FILTER_INTERP_BITS)
@@ -39,6 +42,10 @@
 
 #define RESAMPLER_FULL_FILTER_SIZE (RESAMPLER_SAMPLES_PER_FRAME * (RESAMPLER_SAMPLES_PER_ZERO_CROSSING + 1))
 
+#define RESAMPLER_HQ_SAMPLES_PER_FRAME (RESAMPLER_HQ_ZERO_CROSSINGS * 2)
+
+#define RESAMPLER_HQ_FULL_FILTER_SIZE (RESAMPLER_HQ_SAMPLES_PER_FRAME * (RESAMPLER_SAMPLES_PER_ZERO_CROSSING + 1))
+
 static void ResampleFrame_Scalar(const float *src, float *dst, const float *raw_filter, float interp, int chans)
 {
     int i, chan;
@@ -181,46 +188,362 @@ static void SDL_TARGETING("sse") ResampleFrame_SSE(const float *src, float *dst,
 }
 #endif
 
-static void (*ResampleFrame)(const float *src, float *dst, const float *raw_filter, float interp, int chans);
+#ifdef SDL_NEON_INTRINSICS
+static void ResampleFrame_NEON(const float *src, float *dst, const float *raw_filter, float interp, int chans)
+{
+#if RESAMPLER_SAMPLES_PER_FRAME != 10
+#error Invalid samples per frame
+#endif
+
+    // Load the filter
+    float32x4_t f0 = vld1q_f32(raw_filter + 0);
+    float32x4_t f1 = vld1q_f32(raw_filter + 4);
+    float32x2_t f2 = vld1_f32(raw_filter + 8);
+
+    float32x4_t g0 = vld1q_f32(raw_filter + 10);
+    float32x4_t g1 = vld1q_f32(raw_filter + 14);
+    float32x2_t g2 = vld1_f32(raw_filter + 18);
+
+    const float32x4_t interp1 = vdupq_n_f32(interp);
+    const float32x4_t interp2 = vdupq_n_f32(1.0f - interp);
+
+    // Linear interpolate the filter
+    f0 = vaddq_f32(vmulq_f32(f0, interp2), vmulq_f32(g0, interp1));
+    f1 = vaddq_f32(vmulq_f32(f1, interp2), vmulq_f32(g1, interp1));
+    f2 = vadd_f32(vmul_f32(f2, vget_low_f32(interp2)), vmul_f32(g2, vget_low_f32(interp1)));
+
+    if (chans == 2) {
+        // Duplicate each of the filter elements
+        const float32x4x2_t d0 = vzipq_f32(f0, f0);
+        const float32x4x2_t d1 = vzipq_f32(f1, f1);
+        const float32x2x2_t d2 = vzip_f32(f2, f2);
+
+        // Multiply the filter by the input
+        float32x4_t s0 = vmulq_f32(d0.val[0], vld1q_f32(src + 0));
+        float32x4_t s1 = vmulq_f32(d0.val[1], vld1q_f32(src + 4));
+        float32x4_t s2 = vmulq_f32(d1.val[0], vld1q_f32(src + 8));
+        float32x4_t s3 = vmulq_f32(d1.val[1], vld1q_f32(src + 12));
+        float32x4_t s4 = vmulq_f32(vcombine_f32(d2.val[0], d2.val[1]), vld1q_f32(src + 16));
+
+        // Calculate the sum
+        s0 = vaddq_f32(vaddq_f32(vaddq_f32(s0, s1), vaddq_f32(s2, s3)), s4);
+
+        // Store the result
+        vst1_f32(dst, vadd_f32(vget_low_f32(s0), vget_high_f32(s0)));
+        return;
+    }
+
+    if (chans == 1) {
+        // Multiply the filter by the input
+        float32x4_t s0 = vmulq_f32(f0, vld1q_f32(src + 0));
+        const float32x4_t s1 = vmulq_f32(f1, vld1q_f32(src + 4));
+        const float32x2_t s2 = vmul_f32(f2, vld1_f32(src + 8));
+
+        // Calculate the sum
+        s0 = vaddq_f32(s0, s1);
+        float32x2_t sum = vadd_f32(vadd_f32(vget_low_f32(s0), s2), vget_high_f32(s0));
+        sum = vpadd_f32(sum, sum);
+
+        // Store the result
+        vst1_lane_f32(dst, sum, 0);
+        return;
+    }
+
+    float filter[RESAMPLER_SAMPLES_PER_FRAME];
+    vst1q_f32(filter + 0, f0);
+    vst1q_f32(filter + 4, f1);
+    vst1_f32(filter + 8, f2);
+
+    int i, chan = 0;
+
+    for (; chan + 4 <= chans; chan += 4) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+
+        for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+            sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(&src[i * chans + chan]), filter[i]));
+        }
+
+        vst1q_f32(&dst[chan], sum);
+    }
+
+    for (; chan < chans; chan++) {
+        float f = 0.0f;
+
+        for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+            f += src[i * chans + chan] * filter[i];
+        }
+
+        dst[chan] = f;
+    }
+}
+#endif
+
+// Find the input frames, filter and interpolation factor used for the output frame at `srcpos`.
+#define RESAMPLER_FRAME_SETUP(srcpos, chans, frame, filter, interp) \
+    const Uint32 srcfraction_##frame = (Uint32)((srcpos) & 0xFFFFFFFF); \
+    const float *frame = &src[((int)(Sint32)((srcpos) >> 32) - (RESAMPLER_ZERO_CROSSINGS - 1)) * (chans)]; \
+    const float *filter = &FullResamplerFilter[(srcfraction_##frame >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_SAMPLES_PER_FRAME]; \
+    const float interp = (float)(srcfraction_##frame & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE)
 
 static float FullResamplerFilter[RESAMPLER_FULL_FILTER_SIZE];
 
-void SDL_SetupAudioResampler(void)
+// Multi-frame kernels: these produce `outframes` frames, keeping the per-frame setup and the kernel itself in one loop.
+#define RESAMPLER_FRAMES_FUNC(name, frame_func) \
+    static void name(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans) \
+    { \
+        int i; \
+        for (i = 0; i < outframes; i++) { \
+            RESAMPLER_FRAME_SETUP(srcpos, chans, frame, filter, interp); \
+            frame_func(frame, dst, filter, interp, chans); \
+            srcpos += resample_rate; \
+            dst += chans; \
+        } \
+    }
+
+RESAMPLER_FRAMES_FUNC(ResampleFrames_Scalar, ResampleFrame_Scalar)
+
+#ifdef SDL_SSE_INTRINSICS
+static void SDL_TARGETING("sse") ResampleFrames_SSE(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans)
 {
-    static SDL_bool setup = SDL_FALSE;
-    if (setup) {
+    int i;
+    for (i = 0; i < outframes; i++) {
+        RESAMPLER_FRAME_SETUP(srcpos, chans, frame, filter, interp);
+        ResampleFrame_SSE(frame, dst, filter, interp, chans);
+        srcpos += resample_rate;
+        dst += chans;
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+RESAMPLER_FRAMES_FUNC(ResampleFrames_NEON, ResampleFrame_NEON)
+#endif
+
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE_INTRINSICS)
+// Loads 4 floats from each of two pointers, one into each 128-bit lane.
+#define RESAMPLER_LOAD2X4(a, b) _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a)), _mm_loadu_ps(b), 1)
+#define RESAMPLER_LOAD2X2(a, b) _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_castpd_ps(_mm_load_sd((const double *)(a)))), _mm_castpd_ps(_mm_load_sd((const double *)(b))), 1)
+// The lane-wise equivalent of _mm_movehl_ps(x, x).
+#define RESAMPLER_MOVEHL2(x) _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(x), _mm256_castps_pd(x)))
+
+// Mono and stereo data get two output frames per step, one in each 128-bit lane, doing exactly what ResampleFrame_SSE does.
+static void SDL_TARGETING("avx2") ResampleFrames_AVX2(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans)
+{
+#if RESAMPLER_SAMPLES_PER_FRAME != 10
+#error Invalid samples per frame
+#endif
+
+    int i = 0;
+
+    if ((chans == 1) || (chans == 2)) {
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        for (; i + 2 <= outframes; i += 2) {
+            RESAMPLER_FRAME_SETUP(srcpos, chans, frame_a, filter_a, interp_a);
+            RESAMPLER_FRAME_SETUP(srcpos + resample_rate, chans, frame_b, filter_b, interp_b);
+
+            // Load and linear interpolate the filters
+            __m256 f0 = RESAMPLER_LOAD2X4(filter_a + 0, filter_b + 0);
+            __m256 f1 = RESAMPLER_LOAD2X4(filter_a + 4, filter_b + 4);
+            __m256 f2 = RESAMPLER_LOAD2X2(filter_a + 8, filter_b + 8);
+
+            const __m256 g0 = RESAMPLER_LOAD2X4(filter_a + 10, filter_b + 10);
+            const __m256 g1 = RESAMPLER_LOAD2X4(filter_a + 14, filter_b + 14);
+            const __m256 g2 = RESAMPLER_LOAD2X2(filter_a + 18, filter_b + 18);
+
+            const __m256 interp1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(interp_a)), _mm_set1_ps(interp_b), 1);
+            const __m256 interp2 = _mm256_sub_ps(one, interp1);
+
+            f0 = _mm256_add_ps(_mm256_mul_ps(f0, interp2), _mm256_mul_ps(g0, interp1));
+            f1 = _mm256_add_ps(_mm256_mul_ps(f1, interp2), _mm256_mul_ps(g1, interp1));
+            f2 = _mm256_add_ps(_mm256_mul_ps(f2, interp2), _mm256_mul_ps(g2, interp1));
+
+            if (chans == 2) {
+                // Duplicate each of the filter elements
+                __m256 h0 = _mm256_unpackhi_ps(f0, f0);
+                f0 = _mm256_unpacklo_ps(f0, f0);
+                __m256 h1 = _mm256_unpackhi_ps(f1, f1);
+                f1 = _mm256_unpacklo_ps(f1, f1);
+                f2 = _mm256_unpacklo_ps(f2, f2);
+
+                // Multiply the filters by the input
+                f0 = _mm256_mul_ps(f0, RESAMPLER_LOAD2X4(frame_a + 0, frame_b + 0));
+                h0 = _mm256_mul_ps(h0, RESAMPLER_LOAD2X4(frame_a + 4, frame_b + 4));
+                f1 = _mm256_mul_ps(f1, RESAMPLER_LOAD2X4(frame_a + 8, frame_b + 8));
+                h1 = _mm256_mul_ps(h1, RESAMPLER_LOAD2X4(frame_a + 12, frame_b + 12));
+                f2 = _mm256_mul_ps(f2, RESAMPLER_LOAD2X4(frame_a + 16, frame_b + 16));
+
+                // Calculate the sums
+                f0 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(f0, h0), _mm256_add_ps(f1, h1)), f2);
+                f0 = _mm256_add_ps(f0, RESAMPLER_MOVEHL2(f0));
+
+                // Store the results
+                _mm_storel_pi((__m64 *)(dst + 0), _mm256_castps256_ps128(f0));
+                _mm_storel_pi((__m64 *)(dst + 2), _mm256_extractf128_ps(f0, 1));
+            } else {
+                // Multiply the filters by the input
+                f0 = _mm256_mul_ps(f0, RESAMPLER_LOAD2X4(frame_a + 0, frame_b + 0));
+                f1 = _mm256_mul_ps(f1, RESAMPLER_LOAD2X4(frame_a + 4, frame_b + 4));
+                f2 = _mm256_mul_ps(f2, RESAMPLER_LOAD2X2(frame_a + 8, frame_b + 8));
+
+                // Calculate the sums
+                f0 = _mm256_add_ps(f0, f1);
+                f0 = _mm256_add_ps(_mm256_add_ps(f0, f2), RESAMPLER_MOVEHL2(f0));
+                f0 = _mm256_add_ps(f0, _mm256_shuffle_ps(f0, f0, _MM_SHUFFLE(1, 1, 1, 1)));
+
+                // Store the results
+                dst[0] = _mm_cvtss_f32(_mm256_castps256_ps128(f0));
+                dst[1] = _mm_cvtss_f32(_mm256_extractf128_ps(f0, 1));
+            }
+
+            srcpos += resample_rate * 2;
+            dst += chans * 2;
+        }
+    }
+
+    // Anything left over, and other channel counts, one frame at a time.
+    ResampleFrames_SSE(src, dst, outframes - i, srcpos, resample_rate, chans);
+}
+
+#undef RESAMPLER_LOAD2X4
+#undef RESAMPLER_LOAD2X2
+#undef RESAMPLER_MOVEHL2
+#endif
+
+static void (*ResampleFrames)(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans);
+
+static float FullResamplerHQFilter[RESAMPLER_HQ_FULL_FILTER_SIZE];
+
+// SDL_AUDIO_RESAMPLE_QUALITY_HIGH: the same algorithm, with a filter more than twice as long.
+static void ResampleFrames_HQ(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans)
+{
+    float filter[RESAMPLER_HQ_SAMPLES_PER_FRAME];
+    int i, j, chan;
+
+    for (i = 0; i < outframes; i++) {
+        const Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        const float *frame = &src[((int)(Sint32)(srcpos >> 32) - (RESAMPLER_HQ_ZERO_CROSSINGS - 1)) * chans];
+        const float *raw_filter = &FullResamplerHQFilter[(srcfraction >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_HQ_SAMPLES_PER_FRAME];
+        const float interp = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+
+        // Interpolate between the nearest two filters
+        for (j = 0; j < RESAMPLER_HQ_SAMPLES_PER_FRAME; j++) {
+            filter[j] = (raw_filter[j] * (1.0f - interp)) + (raw_filter[j + RESAMPLER_HQ_SAMPLES_PER_FRAME] * interp);
+        }
+
+        for (chan = 0; chan < chans; chan++) {
+            float f = 0.0f;
+
+            for (j = 0; j < RESAMPLER_HQ_SAMPLES_PER_FRAME; j++) {
+                f += frame[j * chans + chan] * filter[j];
+            }
+
+            dst[chan] = f;
+        }
+
+        srcpos += resample_rate;
+        dst += chans;
+    }
+}
+
+// SDL_AUDIO_RESAMPLE_QUALITY_LOW: straight lines between neighboring input frames.
+static void ResampleFrames_Linear(const float *src, float *dst, int outframes, Sint64 srcpos, Sint64 resample_rate, int chans)
+{
+    int i, chan;
+
+// the top 24 bits of the fraction fit exactly in a float.
+#define RESAMPLER_LINEAR_SETUP() \
+    const float *frame = &src[(int)(Sint32)(srcpos >> 32) * chans]; \
+    const float interp = (float)((Uint32)(srcpos & 0xFFFFFFFF) >> 8) * (1.0f / 16777216.0f)
+
+    if (chans == 1) {
+        for (i = 0; i < outframes; i++) {
+            RESAMPLER_LINEAR_SETUP();
+            dst[i] = frame[0] + ((frame[1] - frame[0]) * interp);
+            srcpos += resample_rate;
+        }
         return;
     }
 
-    // Build a table combining the left and right wings, for faster access
+    if (chans == 2) {
+        for (i = 0; i < outframes; i++) {
+            RESAMPLER_LINEAR_SETUP();
+            dst[i * 2 + 0] = frame[0] + ((frame[2] - frame[0]) * interp);
+            dst[i * 2 + 1] = frame[1] + ((frame[3] - frame[1]) * interp);
+            srcpos += resample_rate;
+        }
+        return;
+    }
+
+    for (i = 0; i < outframes; i++) {
+        RESAMPLER_LINEAR_SETUP();
+
+        for (chan = 0; chan < chans; chan++) {
+            dst[chan] = frame[chan] + ((frame[chan + chans] - frame[chan]) * interp);
+        }
+
+        srcpos += resample_rate;
+        dst += chans;
+    }
+
+#undef RESAMPLER_LINEAR_SETUP
+}
+
+// Build a table combining the left and right wings, for faster access
+static void BuildFullResamplerFilter(float *full_filter, const float *filter, int zero_crossings)
+{
+    const int samples_per_frame = zero_crossings * 2;
+    const int full_filter_size = samples_per_frame * (RESAMPLER_SAMPLES_PER_ZERO_CROSSING + 1);
     int i, j;
 
     for (i = 0; i < RESAMPLER_SAMPLES_PER_ZERO_CROSSING; ++i) {
-        for (j = 0; j < RESAMPLER_ZERO_CROSSINGS; j++) {
-            int lwing = (i * RESAMPLER_SAMPLES_PER_FRAME) + (RESAMPLER_ZERO_CROSSINGS - 1) - j;
-            int rwing = (RESAMPLER_FULL_FILTER_SIZE - 1) - lwing;
+        for (j = 0; j < zero_crossings; j++) {
+            int lwing = (i * samples_per_frame) + (zero_crossings - 1) - j;
+            int rwing = (full_filter_size - 1) - lwing;
 
-            float value = ResamplerFilter[(i * RESAMPLER_ZERO_CROSSINGS) + j];
-            FullResamplerFilter[lwing] = value;
-            FullResamplerFilter[rwing] = value;
+            float value = filter[(i * zero_crossings) + j];
+            full_filter[lwing] = value;
+            full_filter[rwing] = value;
         }
     }
 
-    for (i = 0; i < RESAMPLER_ZERO_CROSSINGS; ++i) {
-        int rwing = i + RESAMPLER_ZERO_CROSSINGS;
-        int lwing = (RESAMPLER_FULL_FILTER_SIZE - 1) - rwing;
+    for (i = 0; i < zero_crossings; ++i) {
+        int rwing = i + zero_crossings;
+        int lwing = (full_filter_size - 1) - rwing;
 
-        FullResamplerFilter[lwing] = 0.0f;
-        FullResamplerFilter[rwing] = 0.0f;
+        full_filter[lwing] = 0.0f;
+        full_filter[rwing] = 0.0f;
     }
+}
 
-    ResampleFrame = ResampleFrame_Scalar;
+void SDL_SetupAudioResampler(void)
+{
+    static SDL_bool setup = SDL_FALSE;
+    if (setup) {
+        return;
+    }
 
+    BuildFullResamplerFilter(FullResamplerFilter, ResamplerFilter, RESAMPLER_ZERO_CROSSINGS);
+    BuildFullResamplerFilter(FullResamplerHQFilter, ResamplerHQFilter, RESAMPLER_HQ_ZERO_CROSSINGS);
+
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE_INTRINSICS)
+    if (SDL_HasAVX2()) {
+        ResampleFrames = ResampleFrames_AVX2;
+    } else
+#endif
 #ifdef SDL_SSE_INTRINSICS
     if (SDL_HasSSE()) {
-        ResampleFrame = ResampleFrame_SSE;
-    }
+        ResampleFrames = ResampleFrames_SSE;
+    } else
 #endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        ResampleFrames = ResampleFrames_NEON;
+    } else
+#endif
+    {
+        ResampleFrames = ResampleFrames_Scalar;
+    }
 
     setup = SDL_TRUE;
 }
@@ -243,11 +566,22 @@ int SDL_GetResamplerHistoryFrames(void)
     return RESAMPLER_MAX_PADDING_FRAMES;
 }
 
-int SDL_GetResamplerPaddingFrames(Sint64 resample_rate)
+int SDL_GetResamplerPaddingFrames(Sint64 resample_rate, SDL_AudioResampleQuality quality)
 {
     // This must always be <= SDL_GetResamplerHistoryFrames()
 
-    return resample_rate ? RESAMPLER_MAX_PADDING_FRAMES : 0;
+    if (!resample_rate) {
+        return 0;
+    }
+
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_QUALITY_LOW:
+        return RESAMPLER_LINEAR_PADDING_FRAMES;
+    case SDL_AUDIO_RESAMPLE_QUALITY_HIGH:
+        return RESAMPLER_HQ_PADDING_FRAMES;
+    default:
+        return RESAMPLER_PADDING_FRAMES;
+    }
 }
 
 // These are not general purpose. They do not check for all possible underflow/overflow
@@ -308,27 +642,29 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
 }
 
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset)
+                       Sint64 resample_rate, Sint64 *inout_resample_offset, SDL_AudioResampleQuality quality)
 {
-    int i;
     Sint64 srcpos = *inout_resample_offset;
 
     SDL_assert(resample_rate > 0);
 
-    for (i = 0; i < outframes; i++) {
-        int srcindex = (int)(Sint32)(srcpos >> 32);
-        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
-        srcpos += resample_rate;
-
-        SDL_assert(srcindex >= -1 && srcindex < inframes);
-
-        const float *filter = &FullResamplerFilter[(srcfraction >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_SAMPLES_PER_FRAME];
-        const float interp = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
-
-        const float *frame = &src[(srcindex - (RESAMPLER_ZERO_CROSSINGS - 1)) * chans];
-        ResampleFrame(frame, dst, filter, interp, chans);
-
-        dst += chans;
+    if (outframes > 0) {
+        // srcpos only ever moves forward, so checking the first and last frames covers the rest.
+        SDL_assert((int)(Sint32)(srcpos >> 32) >= -1);
+        SDL_assert((int)(Sint32)((srcpos + (resample_rate * (outframes - 1))) >> 32) < inframes);
+
+        switch (quality) {
+        case SDL_AUDIO_RESAMPLE_QUALITY_LOW:
+            ResampleFrames_Linear(src, dst, outframes, srcpos, resample_rate, chans);
+            break;
+        case SDL_AUDIO_RESAMPLE_QUALITY_HIGH:
+            ResampleFrames_HQ(src, dst, outframes, srcpos, resample_rate, chans);
+            break;
+        default:
+            ResampleFrames(src, dst, outframes, srcpos, resample_rate, chans);
+            break;
+        }
+        srcpos += resample_rate * outframes;
     }
 
     *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
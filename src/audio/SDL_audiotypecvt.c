@@ -1001,6 +1001,10 @@ void SDL_ChooseAudioConverters(void)
 
 #if NEED_SCALAR_CONVERTER_FALLBACKS
     SET_CONVERTER_FUNCS(Scalar);
+#elif defined(SDL_SSE2_INTRINSICS)
+    SET_CONVERTER_FUNCS(SSE2); // guaranteed by the platform, even if masked out by SDL_HINT_CPU_FEATURE_MASK.
+#elif defined(SDL_NEON_INTRINSICS)
+    SET_CONVERTER_FUNCS(NEON); // guaranteed by the platform, even if masked out by SDL_HINT_CPU_FEATURE_MASK.
 #endif
 
 #undef SET_CONVERTER_FUNCS
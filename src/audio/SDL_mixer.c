@@ -81,16 +81,254 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / SDL_MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / SDL_MIX_MAXVOLUME) + 128))
 
+// The vector kernels mix native byte order samples and return how many they did, the scalar code finishes the buffer.
 
-// !!! FIXME: this needs some SIMD magic.
+#ifdef SDL_SSE_INTRINSICS
+static int SDL_TARGETING("sse") MixFloat32_SSE(float *dst, const float *src, int num_samples, float volume, float scale, SDL_bool clamp)
+{
+    const __m128 vvolume = _mm_set1_ps(volume);
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 vmax = _mm_set1_ps(3.402823466e+38F);
+    const __m128 vmin = _mm_set1_ps(-3.402823466e+38F);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        __m128 sample = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src + i), vvolume), vscale));
+        if (clamp) {
+            // NaNs pass through, like the scalar comparisons
+            sample = _mm_min_ps(vmax, _mm_max_ps(vmin, sample));
+        }
+        _mm_storeu_ps(dst + i, sample);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_AVX_INTRINSICS
+static int SDL_TARGETING("avx") MixFloat32_AVX(float *dst, const float *src, int num_samples, float volume, float scale, SDL_bool clamp)
+{
+    const __m256 vvolume = _mm256_set1_ps(volume);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 vmax = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 vmin = _mm256_set1_ps(-3.402823466e+38F);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m256 sample = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), vvolume), vscale));
+        if (clamp) {
+            sample = _mm256_min_ps(vmax, _mm256_max_ps(vmin, sample));
+        }
+        _mm256_storeu_ps(dst + i, sample);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") MixS16_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    const __m128i vvolume = _mm_set1_epi16((short)volume);
+    const __m128i round = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m128i sample = _mm_loadu_si128((const __m128i *)(src + i));
+        if (volume != SDL_MIX_MAXVOLUME) {
+            const __m128i lo = _mm_mullo_epi16(sample, vvolume);
+            const __m128i hi = _mm_mulhi_epi16(sample, vvolume);
+            __m128i prod0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i prod1 = _mm_unpackhi_epi16(lo, hi);
+            // Divide by 128, rounding toward zero like the scalar division
+            prod0 = _mm_srai_epi32(_mm_add_epi32(prod0, _mm_and_si128(_mm_srai_epi32(prod0, 31), round)), 7);
+            prod1 = _mm_srai_epi32(_mm_add_epi32(prod1, _mm_and_si128(_mm_srai_epi32(prod1, 31), round)), 7);
+            sample = _mm_packs_epi32(prod0, prod1);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(dst + i)), sample));
+    }
+    return i;
+}
+
+// Only at full volume, SSE2 can't multiply 32-bit integers
+static int SDL_TARGETING("sse2") MixS32_SSE2(Sint32 *dst, const Sint32 *src, int num_samples)
+{
+    const __m128i vmax = _mm_set1_epi32(SDL_MAX_SINT32);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i sum = _mm_add_epi32(a, b);
+        // The sum overflowed where its sign differs from both inputs, saturate toward the sign of the inputs
+        const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+        const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), vmax);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(overflow, saturated), _mm_andnot_si128(overflow, sum)));
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int MixFloat32_NEON(float *dst, const float *src, int num_samples, float volume, float scale, SDL_bool clamp)
+{
+    const float32x4_t vmax = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t vmin = vdupq_n_f32(-3.402823466e+38F);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        float32x4_t sample = vaddq_f32(vld1q_f32(dst + i), vmulq_n_f32(vmulq_n_f32(vld1q_f32(src + i), volume), scale));
+        if (clamp) {
+            sample = vminq_f32(vmaxq_f32(sample, vmin), vmax);
+        }
+        vst1q_f32(dst + i, sample);
+    }
+    return i;
+}
+
+static int MixS16_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    const int32x4_t round = vdupq_n_s32(SDL_MIX_MAXVOLUME - 1);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        int16x8_t sample = vld1q_s16(src + i);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            int32x4_t prod0 = vmull_n_s16(vget_low_s16(sample), (int16_t)volume);
+            int32x4_t prod1 = vmull_n_s16(vget_high_s16(sample), (int16_t)volume);
+            prod0 = vshrq_n_s32(vaddq_s32(prod0, vandq_s32(vshrq_n_s32(prod0, 31), round)), 7);
+            prod1 = vshrq_n_s32(vaddq_s32(prod1, vandq_s32(vshrq_n_s32(prod1, 31), round)), 7);
+            sample = vcombine_s16(vmovn_s32(prod0), vmovn_s32(prod1));
+        }
+        vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), sample));
+    }
+    return i;
+}
+
+static int MixS32_NEON(Sint32 *dst, const Sint32 *src, int num_samples)
+{
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        vst1q_s32(dst + i, vqaddq_s32(vld1q_s32(dst + i), vld1q_s32(src + i)));
+    }
+    return i;
+}
+#endif
+
+// The volume and scale are applied one after the other, so overflow matches the scalar code
+static int MixFloat32(float *dst, const float *src, int num_samples, float volume, float scale, SDL_bool clamp)
+{
+#ifdef SDL_AVX_INTRINSICS
+    if (SDL_HasAVX()) {
+        return MixFloat32_AVX(dst, src, num_samples, volume, scale, clamp);
+    }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        return MixFloat32_SSE(dst, src, num_samples, volume, scale, clamp);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return MixFloat32_NEON(dst, src, num_samples, volume, scale, clamp);
+    }
+#endif
+    return 0;
+}
+
+// Returns the number of bytes mixed
+static Uint32 MixAudioSIMD(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, int volume)
+{
+    int num_samples;
+
+    if (volume < 0 || volume > SDL_MIX_MAXVOLUME) {
+        return 0;  // the scalar code wraps around, leave that to it
+    }
+    if (format != SDL_AUDIO_F32 && format != SDL_AUDIO_S16 && format != SDL_AUDIO_S32) {
+        return 0;
+    }
+    num_samples = (int)SDL_min(len / SDL_AUDIO_BYTESIZE(format), SDL_MAX_SINT32 / 4);
+
+    if (format == SDL_AUDIO_F32) {
+        return (Uint32)MixFloat32((float *)dst, (const float *)src, num_samples, (float)volume, 1.0f / ((float)SDL_MIX_MAXVOLUME), SDL_TRUE) * 4;
+    } else if (format == SDL_AUDIO_S16) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return (Uint32)MixS16_SSE2((Sint16 *)dst, (const Sint16 *)src, num_samples, volume) * 2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return (Uint32)MixS16_NEON((Sint16 *)dst, (const Sint16 *)src, num_samples, volume) * 2;
+        }
+#endif
+    } else if (format == SDL_AUDIO_S32 && volume == SDL_MIX_MAXVOLUME) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return (Uint32)MixS32_SSE2((Sint32 *)dst, (const Sint32 *)src, num_samples) * 4;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return (Uint32)MixS32_NEON((Sint32 *)dst, (const Sint32 *)src, num_samples) * 4;
+        }
+#endif
+    }
+    return 0;
+}
+
+void SDL_MixFloat32Audio(float *dst, const float *src, int num_samples)
+{
+    int i = MixFloat32(dst, src, num_samples, 1.0f, 1.0f, SDL_FALSE);
+
+    for (; i < num_samples; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+void SDL_MixFloat32AudioGain(float *dst, const float *src, int num_samples, float gain)
+{
+    int i = MixFloat32(dst, src, num_samples, gain, 1.0f, SDL_FALSE);
+
+    for (; i < num_samples; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+void SDL_MixS16Audio(Sint16 *dst, const Sint16 *src, int num_samples)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i = MixS16_SSE2(dst, src, num_samples, SDL_MIX_MAXVOLUME);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!i && SDL_HasNEON()) {
+        i = MixS16_NEON(dst, src, num_samples, SDL_MIX_MAXVOLUME);
+    }
+#endif
+
+    for (; i < num_samples; ++i) {
+        const int sample = (int)dst[i] + (int)src[i];
+        dst[i] = (Sint16)SDL_clamp(sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+    }
+}
 
 int SDL_MixAudioFormat(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
                         Uint32 len, int volume)
 {
+    Uint32 mixed;
+
     if (volume == 0) {
         return 0;
     }
 
+    mixed = MixAudioSIMD(dst, src, format, len, volume);
+    dst += mixed;
+    src += mixed;
+    len -= mixed;
+
     switch (format) {
 
     case SDL_AUDIO_U8:
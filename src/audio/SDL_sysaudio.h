@@ -63,6 +63,9 @@ extern void (*SDL_Convert_F32_to_S32)(Sint32 *dst, const float *src, int num_sam
 typedef struct SDL_AudioDevice SDL_AudioDevice;
 typedef struct SDL_LogicalAudioDevice SDL_LogicalAudioDevice;
 
+// Number of captured buffers that can be waiting in bound streams before capture falls back to copying into each stream.
+#define SDL_AUDIO_CAPTURE_SLOTS 32
+
 // Used by src/SDL.c to initialize a particular audio driver.
 extern int SDL_InitAudio(const char *driver_name);
 
@@ -119,9 +122,32 @@ extern SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device);
 extern void SDL_CaptureAudioThreadShutdown(SDL_AudioDevice *device);
 extern void SDL_AudioThreadFinalize(SDL_AudioDevice *device);
 
+// Adds native byte order float samples together without clamping, for mixing streams before the final conversion.
+extern void SDL_MixFloat32Audio(float *dst, const float *src, int num_samples);
+
+// Same as SDL_MixFloat32Audio, but scales `src` by `gain` on the way, for submix buses.
+extern void SDL_MixFloat32AudioGain(float *dst, const float *src, int num_samples, float gain);
+
+// Adds native byte order Sint16 samples together, saturating, for mixing streams straight into an S16 device buffer.
+extern void SDL_MixS16Audio(Sint16 *dst, const Sint16 *src, int num_samples);
+
+// Gain that ConvertAudio applies while the data is in float32 format.
+// The first frame is scaled by `start`, which changes by `step` each frame for the first `ramp_frames` frames, then holds.
+// `left` and `right` scale the two channels of stereo output on top of that, for panning.
+typedef struct SDL_AudioGain
+{
+    float start;
+    float step;
+    int ramp_frames;
+    float left;
+    float right;
+} SDL_AudioGain;
+
 // this gets used from the audio device threads. It has rules, don't use this if you don't know how to use it!
+// `channel_matrix` can be NULL to use the builtin channel conversion, and `gain` can be NULL to leave the volume alone.
 extern void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
-                         void *dst, SDL_AudioFormat dst_format, int dst_channels, void* scratch);
+                         void *dst, SDL_AudioFormat dst_format, int dst_channels, void* scratch,
+                         const float *channel_matrix, const SDL_AudioGain *gain);
 
 // Special case to let something in SDL_audiocvt.c access something in SDL_audio.c. Don't use this.
 extern void OnAudioStreamCreated(SDL_AudioStream *stream);
@@ -149,6 +175,7 @@ typedef struct SDL_AudioDriverImpl
     SDL_bool HasCaptureSupport;
     SDL_bool OnlyHasDefaultOutputDevice;
     SDL_bool OnlyHasDefaultCaptureDevice;   // !!! FIXME: is there ever a time where you'd have a default output and not a default capture (or vice versa)?
+    SDL_bool SupportsExclusiveAccess;  // backend looks at SDL_AudioDevice::exclusive in OpenDevice.
 } SDL_AudioDriverImpl;
 
 
@@ -194,10 +221,30 @@ struct SDL_AudioStream
     SDL_AudioSpec src_spec;
     SDL_AudioSpec dst_spec;
     float freq_ratio;
+    SDL_AudioResampleQuality resample_quality;
+
+    float gain;  // current gain; moves toward fade_gain while fade_frames is nonzero.
+    float fade_gain;
+    int fade_frames;
+    float pan;
+
+    float channel_matrix[8 * 8];  // set by SDL_SetAudioStreamChannelMatrix, [dst][src].
+    int channel_matrix_src_channels;  // zero if there's no custom matrix.
+    int channel_matrix_dst_channels;
 
     struct SDL_AudioQueue* queue;
     Uint64 total_bytes_queued;
 
+    SDL_bool lock_free;  // SDL_TRUE if SDL_SetAudioStreamLockFree enabled it.
+    SDL_AtomicInt lock_free_puts;  // nonzero if puts can skip the lock: lock_free is set and there's no put_callback.
+
+    SDL_bool preconvert;  // SDL_TRUE if SDL_SetAudioStreamPreconvert enabled it.
+    struct SDL_AudioQueue *preconverted;  // data converted when it was put, read before anything still in `queue`. NULL until preconvert is first enabled.
+    Uint64 preconverted_bytes;  // bytes waiting in `preconverted`.
+    Uint64 preconverted_input_bytes;  // input bytes that went into `preconverted_bytes`, still reported by SDL_GetAudioStreamQueued.
+    Uint8 *preconvert_buffer;  // scratch space for converting at put time.
+    size_t preconvert_buffer_allocation;
+
     SDL_AudioSpec input_spec; // The spec of input data currently being processed
     Sint64 resample_offset;
 
@@ -247,6 +294,12 @@ struct SDL_LogicalAudioDevice
     // App-supplied pointer for postmix callback.
     void *postmix_userdata;
 
+    // Volume applied to everything this device mixes, after the postmix callback. Protected by the physical device lock.
+    float gain;
+
+    // If non-NULL, this is a submix bus that mixes into `parent` instead of straight into the physical device.
+    SDL_LogicalAudioDevice *parent;
+
     // double-linked list of opened devices on the same physical device.
     SDL_LogicalAudioDevice *next;
     SDL_LogicalAudioDevice *prev;
@@ -293,6 +346,39 @@ struct SDL_AudioDevice
     // Value to use for SDL_memset to silence a buffer in this device's format
     int silence_value;
 
+    // SDL_TRUE if the app wants the smallest buffers the backend can manage. Backends clear this during OpenDevice if they can't provide it.
+    SDL_bool low_latency;
+
+    // SDL_TRUE if the app wants exclusive access to the hardware. Only set if the backend has SupportsExclusiveAccess, and it clears this during OpenDevice if it didn't get it.
+    SDL_bool exclusive;
+
+    // Latency between SDL and the hardware in sample frames, as measured by the backend. Zero if the backend can't tell.
+    SDL_AtomicInt latency_frames;
+
+    // Timing of the device thread, reported through SDL_GetAudioDeviceProperties. Protected by the device lock, reset when the device opens.
+    struct
+    {
+        Uint64 iterations;      // iterations that supplied (or took) a buffer.
+        Uint64 last_end_ns;     // when the previous iteration finished, zero before the first one.
+        Uint64 mix_ns;          // time spent mixing (or distributing captured data) in the last iteration.
+        Uint64 max_mix_ns;
+        Uint64 total_mix_ns;
+        Uint64 wait_ns;         // time between the last two iterations, usually spent in WaitDevice.
+        Uint64 max_wait_ns;
+        Uint64 late_buffers;    // iterations where mixing took longer than the buffer plays.
+        int streams;            // streams that were mixed (or fed) in the last iteration.
+    } stats;
+
+    // Number of underruns/overruns the backend reported since the device opened. Backends increment this from any thread.
+    SDL_AtomicInt xruns;
+
+    // Non-zero if the device thread got the scheduling class and CPU affinity the app asked for in the device properties.
+    SDL_AtomicInt thread_priority_applied;
+    SDL_AtomicInt thread_cpu_applied;
+
+    // Properties reported through SDL_GetAudioDeviceProperties.
+    SDL_PropertiesID props;
+
     // non-zero if we are signaling the audio thread to end.
     SDL_AtomicInt shutdown;
 
@@ -305,14 +391,27 @@ struct SDL_AudioDevice
     // SDL_TRUE if audio thread can skip silence/mix/convert stages and just do a basic memcpy.
     SDL_bool simple_copy;
 
+    // SDL_TRUE if bound streams produce the device's native S16 format and get mixed straight into the device buffer, skipping float32.
+    SDL_bool integer_mix;
+
     // Scratch buffers used for mixing.
     Uint8 *work_buffer;
     Uint8 *mix_buffer;
     float *postmix_buffer;
 
+    // Scratch buffers for submix buses that need their own mix, one per nesting level below the top.
+    float **submix_buffers;
+    int num_submix_buffers;
+
     // Size of work_buffer (and mix_buffer) in bytes.
     int work_buffer_size;
 
+    // Captured buffers shared by every bound stream without copying. Each slot is refcounted, streams release theirs as they read.
+    struct SDL_AudioCaptureSlot *capture_slots[SDL_AUDIO_CAPTURE_SLOTS];
+
+    // Worker threads that get data from bound streams in parallel, NULL to do it all on the device thread.
+    struct SDL_AudioMixPool *mix_pool;
+
     // A thread to feed the audio device
     SDL_Thread *thread;
 
@@ -35,6 +35,20 @@
 
 #include "SDL_wave.h"
 #include "SDL_sysaudio.h"
+#include "../thread/SDL_systhread.h"
+
+/* The companded formats are decoded with lookup tables by default. Computing
+ * the samples is a lot slower, but saves 1 KiB of tables.
+ */
+#if !defined(SDL_WAVE_LAW_LUT) && !defined(SDL_WAVE_NO_LAW_LUT)
+#define SDL_WAVE_LAW_LUT
+#endif
+
+/* Files with at least this many sample frames per thread get their ADPCM
+ * blocks decoded on several threads.
+ */
+#define ADPCM_PARALLEL_MIN_FRAMES 65536
+#define ADPCM_PARALLEL_MAX_THREADS 16
 
 /* Reads the value stored at the location of the f1 pointer, multiplies it
  * with the second argument and then stores the result to f1.
@@ -495,7 +509,7 @@ static Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sampl
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
     const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
+    static const Uint16 adaptive[] = {
         230, 230, 230, 230, 307, 409, 512, 614,
         768, 614, 512, 409, 307, 230, 230, 230
     };
@@ -633,6 +647,119 @@ static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     return 0;
 }
 
+typedef struct ADPCM_DecodeTask
+{
+    ADPCM_DecoderState state; /* Own copy with its own positions and channel state. */
+    size_t numblocks;
+    int (*decodeheader)(ADPCM_DecoderState *state);
+    int (*decodedata)(ADPCM_DecoderState *state);
+    SDL_Thread *thread;
+    int result;
+} ADPCM_DecodeTask;
+
+static int SDLCALL ADPCM_DecodeTaskBlocks(void *data)
+{
+    ADPCM_DecodeTask *task = (ADPCM_DecodeTask *)data;
+    ADPCM_DecoderState *state = &task->state;
+    size_t i;
+
+    for (i = 0; i < task->numblocks; i++) {
+        state->block.data = state->input.data + state->input.pos;
+        state->block.size = state->blocksize;
+        state->block.pos = 0;
+
+        if (task->decodeheader(state) < 0 || task->decodedata(state) < 0) {
+            task->result = -1;
+            return -1;
+        }
+
+        state->input.pos += state->blocksize;
+    }
+
+    task->result = 0;
+    return 0;
+}
+
+/* ADPCM blocks don't depend on each other, so large files can be decoded on
+ * several threads. This decodes the leading blocks that are complete and
+ * advances the state past them. The rest is left to the caller, which also
+ * handles truncated blocks. If anything fails, the state is left untouched,
+ * so the caller decodes everything again and reports the error.
+ */
+static void ADPCM_DecodeParallel(ADPCM_DecoderState *state, size_t cstatesize,
+                                 int (*decodeheader)(ADPCM_DecoderState *state),
+                                 int (*decodedata)(ADPCM_DecoderState *state))
+{
+    const Uint64 completeframes = (Uint64)state->framesleft / state->samplesperblock;
+    const size_t completeblocks = (state->input.size - state->input.pos) / state->blocksize;
+    const size_t numblocks = completeframes < completeblocks ? (size_t)completeframes : completeblocks;
+    const size_t minblocks = (ADPCM_PARALLEL_MIN_FRAMES + state->samplesperblock - 1) / state->samplesperblock;
+    const size_t blocksamples = state->samplesperblock * state->channels;
+    ADPCM_DecodeTask *tasks;
+    Uint8 *cstates;
+    size_t numtasks = (size_t)SDL_GetCPUCount();
+    size_t i, firstblock = 0;
+    SDL_bool failed = SDL_FALSE;
+
+    if (numtasks > ADPCM_PARALLEL_MAX_THREADS) {
+        numtasks = ADPCM_PARALLEL_MAX_THREADS;
+    }
+    if (numtasks > numblocks / minblocks) {
+        numtasks = numblocks / minblocks;
+    }
+    if (numtasks < 2) {
+        return;
+    }
+
+    tasks = (ADPCM_DecodeTask *)SDL_calloc(numtasks, sizeof(*tasks));
+    cstates = (Uint8 *)SDL_calloc(numtasks, cstatesize * state->channels);
+    if (!tasks || !cstates) {
+        SDL_free(tasks);
+        SDL_free(cstates);
+        return;
+    }
+
+    for (i = 0; i < numtasks; i++) {
+        ADPCM_DecodeTask *task = &tasks[i];
+
+        task->numblocks = numblocks / numtasks + (i < numblocks % numtasks ? 1 : 0);
+        task->decodeheader = decodeheader;
+        task->decodedata = decodedata;
+        task->state = *state;
+        task->state.cstate = cstates + i * cstatesize * state->channels;
+        task->state.input.pos = state->input.pos + firstblock * state->blocksize;
+        task->state.output.pos = state->output.pos + firstblock * blocksamples;
+        task->state.framesleft = (Sint64)(task->numblocks * state->samplesperblock);
+        firstblock += task->numblocks;
+
+        /* The calling thread decodes the first part itself. */
+        if (i > 0) {
+            task->thread = SDL_CreateThreadInternal(ADPCM_DecodeTaskBlocks, "SDLWaveDecoder", 0, task);
+        }
+    }
+
+    for (i = 0; i < numtasks; i++) {
+        if (!tasks[i].thread) {
+            /* Also picks up the parts whose thread couldn't be created. */
+            ADPCM_DecodeTaskBlocks(&tasks[i]);
+        } else {
+            SDL_WaitThread(tasks[i].thread, NULL);
+        }
+        if (tasks[i].result < 0) {
+            failed = SDL_TRUE;
+        }
+    }
+
+    if (!failed) {
+        state->input.pos += numblocks * state->blocksize;
+        state->output.pos += numblocks * blocksamples;
+        state->framesleft -= (Sint64)(numblocks * state->samplesperblock);
+    }
+
+    SDL_free(tasks);
+    SDL_free(cstates);
+}
+
 static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result;
@@ -688,7 +815,9 @@ static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 
     state.cstate = cstate;
 
-    /* Decode block by block. A truncated block will stop the decoding. */
+    ADPCM_DecodeParallel(&state, sizeof(MS_ADPCM_ChannelState), MS_ADPCM_DecodeBlockHeader, MS_ADPCM_DecodeBlockData);
+
+    /* Decode the remaining blocks. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
         state.block.data = state.input.data + state.input.pos;
@@ -854,13 +983,13 @@ static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 ny
 {
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
-    const Sint8 index_table_4b[16] = {
+    static const Sint8 index_table_4b[16] = {
         -1, -1, -1, -1,
         2, 4, 6, 8,
         -1, -1, -1, -1,
         2, 4, 6, 8
     };
-    const Uint16 step_table[89] = {
+    static const Uint16 step_table[89] = {
         7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
         34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
         143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
@@ -1000,20 +1129,32 @@ static int IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
         const size_t subblocksamples = blockframesleft < 8 ? (size_t)blockframesleft : 8;
 
         for (c = 0; c < channels; c++) {
-            Uint8 nybble = 0;
+            Sint16 *out = state->output.data + outpos + c;
+            const Uint8 *in = state->block.data + blockpos;
+            /* Work on a copy of the step index, so it can stay in a register. */
+            Sint8 cindex = ((Sint8 *)state->cstate)[c];
             /* Load previous sample which may come from the block header. */
-            Sint16 sample = state->output.data[outpos + c - channels];
-
-            for (i = 0; i < subblocksamples; i++) {
-                if (i & 1) {
-                    nybble >>= 4;
-                } else {
-                    nybble = state->block.data[blockpos++];
+            Sint16 sample = out[-(Sint32)channels];
+
+            if (subblocksamples == 8) {
+                /* The common case: a whole sub-block, two nibbles per byte. */
+                for (i = 0; i < 4; i++) {
+                    const Uint8 nybble = in[i];
+                    sample = IMA_ADPCM_ProcessNibble(&cindex, sample, nybble & 0x0f);
+                    out[(i * 2) * channels] = sample;
+                    sample = IMA_ADPCM_ProcessNibble(&cindex, sample, nybble >> 4);
+                    out[(i * 2 + 1) * channels] = sample;
+                }
+            } else {
+                for (i = 0; i < subblocksamples; i++) {
+                    const Uint8 nybble = in[i / 2] >> ((i & 1) * 4);
+                    sample = IMA_ADPCM_ProcessNibble(&cindex, sample, nybble & 0x0f);
+                    out[i * channels] = sample;
                 }
-
-                sample = IMA_ADPCM_ProcessNibble((Sint8 *)state->cstate + c, sample, nybble & 0x0f);
-                state->output.data[outpos + c + i * channels] = sample;
             }
+
+            ((Sint8 *)state->cstate)[c] = cindex;
+            blockpos += (subblocksamples + 1) / 2;
         }
 
         outpos += channels * subblocksamples;
@@ -1084,7 +1225,9 @@ static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
     }
     state.cstate = cstate;
 
-    /* Decode block by block. A truncated block will stop the decoding. */
+    ADPCM_DecodeParallel(&state, sizeof(Sint8), IMA_ADPCM_DecodeBlockHeader, IMA_ADPCM_DecodeBlockData);
+
+    /* Decode the remaining blocks. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
         state.block.data = state.input.data + state.input.pos;
@@ -1161,7 +1304,7 @@ static int LAW_Init(WaveFile *file, size_t datalength)
 static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
 #ifdef SDL_WAVE_LAW_LUT
-    const Sint16 alaw_lut[256] = {
+    static const Sint16 alaw_lut[256] = {
         -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
         -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
         -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
@@ -1179,7 +1322,7 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
         656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
     };
-    const Sint16 mulaw_lut[256] = {
+    static const Sint16 mulaw_lut[256] = {
         -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
         -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
         -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
@@ -1496,9 +1639,12 @@ static WaveFactChunkHint WaveGetFactChunkHint(void)
 static void WaveFreeChunkData(WaveChunk *chunk)
 {
     if (chunk->data) {
-        SDL_free(chunk->data);
+        if (!chunk->borrowed) {
+            SDL_free(chunk->data);
+        }
         chunk->data = NULL;
     }
+    chunk->borrowed = SDL_FALSE;
     chunk->size = 0;
 }
 
@@ -1567,6 +1713,25 @@ static int WaveReadChunkData(SDL_RWops *src, WaveChunk *chunk)
     return WaveReadPartialChunkData(src, chunk, chunk->length);
 }
 
+/* Points the chunk at the data in place if the stream is in memory. The data
+ * must only be read, so this can't be used if it's handed to the caller.
+ */
+static SDL_bool WaveBorrowChunkData(SDL_RWops *src, WaveChunk *chunk)
+{
+    size_t memsize;
+    const Uint8 *mem = (const Uint8 *)SDL_GetRWMemory(src, &memsize);
+
+    if (!mem || chunk->position < 0 || (Uint64)chunk->position > memsize) {
+        return SDL_FALSE;
+    }
+
+    WaveFreeChunkData(chunk);
+    chunk->data = (Uint8 *)mem + chunk->position;
+    chunk->size = SDL_min(chunk->length, memsize - (size_t)chunk->position);
+    chunk->borrowed = SDL_TRUE;
+    return SDL_TRUE;
+}
+
 typedef struct WaveExtensibleGUID
 {
     Uint16 encoding;
@@ -1769,7 +1934,11 @@ static int WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Parses the chunks up to the data chunk and checks the format. On success,
+ * file->chunk holds the position and length of the data chunk (but not its
+ * data), spec is filled in and endposition is set to where the WAVE data ends.
+ */
+static int WaveLoadHeaders(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1980,52 +2149,9 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
 
     WaveFreeChunkData(chunk);
 
-    /* Process data chunk. */
+    /* The data chunk is read later. */
     *chunk = datachunk;
 
-    if (chunk->length > 0) {
-        result = WaveReadChunkData(src, chunk);
-        if (result == -1) {
-            return -1;
-        } else if (result == -2) {
-            return SDL_SetError("Could not seek data of WAVE data chunk");
-        }
-    }
-
-    if (chunk->length != chunk->size) {
-        /* I/O issues or corrupt file. */
-        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
-            return SDL_SetError("Could not read data of WAVE data chunk");
-        }
-        /* The decoders handle this truncation. */
-    }
-
-    /* Decode or convert the data if necessary. */
-    switch (format->encoding) {
-    case PCM_CODE:
-    case IEEE_FLOAT_CODE:
-        if (PCM_Decode(file, audio_buf, audio_len) < 0) {
-            return -1;
-        }
-        break;
-    case ALAW_CODE:
-    case MULAW_CODE:
-        if (LAW_Decode(file, audio_buf, audio_len) < 0) {
-            return -1;
-        }
-        break;
-    case MS_ADPCM_CODE:
-        if (MS_ADPCM_Decode(file, audio_buf, audio_len) < 0) {
-            return -1;
-        }
-        break;
-    case IMA_ADPCM_CODE:
-        if (IMA_ADPCM_Decode(file, audio_buf, audio_len) < 0) {
-            return -1;
-        }
-        break;
-    }
-
     /* Setting up the specs. All unsupported formats were filtered out
      * by checks earlier in this function.
      */
@@ -2065,16 +2191,79 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
         return SDL_SetError("Unexpected data format");
     }
 
-    /* Report the end position back to the cleanup code. */
+    /* Report the end position back to the caller. */
     if (RIFFlengthknown) {
-        chunk->position = RIFFend;
+        *endposition = RIFFend;
     } else {
-        chunk->position = lastchunkpos;
+        *endposition = lastchunkpos;
     }
 
     return 0;
 }
 
+/* Decodes the data in file->chunk with file->sampleframes frames. */
+static int WaveDecode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    switch (file->format.encoding) {
+    case PCM_CODE:
+    case IEEE_FLOAT_CODE:
+        return PCM_Decode(file, audio_buf, audio_len);
+    case ALAW_CODE:
+    case MULAW_CODE:
+        return LAW_Decode(file, audio_buf, audio_len);
+    case MS_ADPCM_CODE:
+        return MS_ADPCM_Decode(file, audio_buf, audio_len);
+    case IMA_ADPCM_CODE:
+        return IMA_ADPCM_Decode(file, audio_buf, audio_len);
+    }
+    return SDL_SetError("Unexpected data format");
+}
+
+static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition = 0;
+    WaveChunk *chunk = &file->chunk;
+
+    if (WaveLoadHeaders(src, file, spec, &endposition) < 0) {
+        return -1;
+    }
+
+    /* Process data chunk. The ADPCM decoders write to a new buffer, so they
+     * can read straight from memory streams.
+     */
+    if (chunk->length > 0 &&
+        (file->format.encoding == MS_ADPCM_CODE || file->format.encoding == IMA_ADPCM_CODE) &&
+        WaveBorrowChunkData(src, chunk)) {
+        /* Nothing to read */
+    } else if (chunk->length > 0) {
+        result = WaveReadChunkData(src, chunk);
+        if (result == -1) {
+            return -1;
+        } else if (result == -2) {
+            return SDL_SetError("Could not seek data of WAVE data chunk");
+        }
+    }
+
+    if (chunk->length != chunk->size) {
+        /* I/O issues or corrupt file. */
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+        /* The decoders handle this truncation. */
+    }
+
+    /* Decode or convert the data if necessary. */
+    if (WaveDecode(file, audio_buf, audio_len) < 0) {
+        return -1;
+    }
+
+    /* Report the end position back to the cleanup code. */
+    chunk->position = endposition;
+
+    return 0;
+}
+
 int SDL_LoadWAV_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result = -1;
@@ -2127,3 +2316,216 @@ int SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32
     return SDL_LoadWAV_RW(SDL_RWFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* The number of sample frames an audio stream made from a WAVE file decodes
+ * at a time. The data is read in whole blocks, so this may be rounded up.
+ */
+#define WAVE_STREAM_FRAMES 4096
+
+typedef struct WaveStream
+{
+    SDL_RWops *src;
+    SDL_bool freesrc;
+    /* file.chunk holds the position and length of the data chunk. */
+    WaveFile file;
+    Sint64 offset;     /* Bytes of the data chunk that were already decoded. */
+    Sint64 framesleft; /* Sample frames that still have to be decoded. */
+    size_t readsize;   /* Bytes read and decoded at a time, always whole blocks. */
+    SDL_bool done;
+    SDL_bool flushed;
+} WaveStream;
+
+static void SDLCALL WaveStreamFreeBuffer(void *userdata, const void *buf, int buflen)
+{
+    SDL_free((void *)buf);
+}
+
+static void SDLCALL WaveStreamCleanup(void *userdata, void *value)
+{
+    WaveStream *wavestream = (WaveStream *)value;
+
+    if (wavestream->freesrc) {
+        SDL_RWclose(wavestream->src);
+    }
+    SDL_free(wavestream->file.decoderdata);
+    SDL_free(wavestream);
+}
+
+/* Reads and decodes the next piece of the data chunk and puts it into the
+ * audio stream. Returns the number of decoded bytes or -1 on error.
+ */
+static int WaveStreamDecodePiece(WaveStream *wavestream, SDL_AudioStream *stream)
+{
+    WaveFile piece = wavestream->file;
+    const Sint64 remaining = (Sint64)wavestream->file.chunk.length - wavestream->offset;
+    const Sint64 position = wavestream->file.chunk.position + wavestream->offset;
+    size_t toread = wavestream->readsize;
+    size_t bytesread;
+    Uint8 *audio_buf = NULL;
+    Uint32 audio_len = 0;
+    int result = 0;
+
+    if (remaining <= 0 || wavestream->framesleft <= 0) {
+        wavestream->done = SDL_TRUE;
+        return 0;
+    } else if ((Sint64)toread > remaining) {
+        toread = (size_t)remaining;
+    }
+
+    piece.chunk.data = (Uint8 *)SDL_malloc(toread);
+    if (!piece.chunk.data) {
+        return SDL_OutOfMemory();
+    }
+
+    if (SDL_RWseek(wavestream->src, position, SDL_RW_SEEK_SET) != position) {
+        SDL_free(piece.chunk.data);
+        return SDL_SetError("Could not seek data of WAVE data chunk");
+    }
+
+    bytesread = SDL_RWread(wavestream->src, piece.chunk.data, toread);
+    if (bytesread < toread) {
+        /* I/O issues or corrupt file. */
+        if (piece.trunchint == TruncVeryStrict || piece.trunchint == TruncStrict) {
+            SDL_free(piece.chunk.data);
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+        /* Decode whatever is there and stop. */
+        wavestream->done = SDL_TRUE;
+    }
+    wavestream->offset += bytesread;
+
+    /* The piece is decoded as if it was a file of its own. The fact chunk
+     * applies to the whole file and is already accounted for in framesleft.
+     */
+    piece.chunk.length = (Uint32)bytesread;
+    piece.chunk.size = bytesread;
+    piece.fact.status = 0;
+
+    switch (piece.format.encoding) {
+    case MS_ADPCM_CODE:
+        result = MS_ADPCM_CalculateSampleFrames(&piece, bytesread);
+        break;
+    case IMA_ADPCM_CODE:
+        result = IMA_ADPCM_CalculateSampleFrames(&piece, bytesread);
+        break;
+    default:
+        piece.sampleframes = bytesread / piece.format.blockalign;
+        break;
+    }
+
+    if (result == 0) {
+        if (piece.sampleframes > wavestream->framesleft) {
+            piece.sampleframes = wavestream->framesleft;
+        }
+        result = WaveDecode(&piece, &audio_buf, &audio_len);
+    }
+    WaveFreeChunkData(&piece.chunk);
+
+    if (result < 0) {
+        SDL_free(audio_buf);
+        return -1;
+    }
+
+    wavestream->framesleft -= piece.sampleframes;
+
+    if (audio_len > 0 && SDL_PutAudioStreamDataNoCopy(stream, audio_buf, (int)audio_len, WaveStreamFreeBuffer, NULL) < 0) {
+        SDL_free(audio_buf);
+        return -1;
+    }
+
+    return (int)audio_len;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    WaveStream *wavestream = (WaveStream *)userdata;
+
+    while (additional_amount > 0 && !wavestream->done) {
+        const int result = WaveStreamDecodePiece(wavestream, stream);
+        if (result < 0) {
+            /* There's no way to report this from here. Stop at the error. */
+            wavestream->done = SDL_TRUE;
+            break;
+        }
+        additional_amount -= result;
+    }
+
+    /* Let the stream output the data it still holds back for resampling. */
+    if (wavestream->done && !wavestream->flushed) {
+        SDL_FlushAudioStream(stream);
+        wavestream->flushed = SDL_TRUE;
+    }
+}
+
+SDL_AudioStream *SDL_CreateAudioStreamFromWAV_RW(SDL_RWops *src, SDL_bool freesrc, const SDL_AudioSpec *dst_spec)
+{
+    WaveStream *wavestream = NULL;
+    WaveFormat *format;
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream = NULL;
+    Sint64 endposition = 0;
+
+    /* Make sure we are passed a valid data source */
+    if (!src) {
+        return NULL;  /* Error may come from RWops. */
+    }
+
+    wavestream = (WaveStream *)SDL_calloc(1, sizeof(*wavestream));
+    if (!wavestream) {
+        SDL_OutOfMemory();
+        goto failed;
+    }
+
+    wavestream->src = src;
+    wavestream->freesrc = freesrc;
+    wavestream->file.riffhint = WaveGetRiffSizeHint();
+    wavestream->file.trunchint = WaveGetTruncationHint();
+    wavestream->file.facthint = WaveGetFactChunkHint();
+
+    if (WaveLoadHeaders(src, &wavestream->file, &spec, &endposition) < 0) {
+        goto failed;
+    }
+
+    wavestream->framesleft = wavestream->file.sampleframes;
+
+    /* Read whole blocks, so each piece can be decoded on its own. */
+    format = &wavestream->file.format;
+    if (format->encoding == MS_ADPCM_CODE || format->encoding == IMA_ADPCM_CODE) {
+        const size_t blocks = (WAVE_STREAM_FRAMES + format->samplesperblock - 1) / format->samplesperblock;
+        wavestream->readsize = blocks * format->blockalign;
+    } else {
+        wavestream->readsize = (size_t)WAVE_STREAM_FRAMES * format->blockalign;
+    }
+
+    stream = SDL_CreateAudioStream(&spec, dst_spec ? dst_spec : &spec);
+    if (!stream) {
+        goto failed;
+    }
+
+    if (SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, wavestream) < 0) {
+        goto failed;
+    }
+
+    /* The stream owns wavestream and src from here on. */
+    if (SDL_SetPropertyWithCleanup(SDL_GetAudioStreamProperties(stream), "SDL.audio.stream.wave", wavestream, WaveStreamCleanup, NULL) < 0) {
+        goto failed;
+    }
+
+    return stream;
+
+failed:
+    SDL_DestroyAudioStream(stream);
+    if (wavestream) {
+        SDL_free(wavestream->file.decoderdata);
+        SDL_free(wavestream);
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+SDL_AudioStream *SDL_CreateAudioStreamFromWAV(const char *path, const SDL_AudioSpec *dst_spec)
+{
+    return SDL_CreateAudioStreamFromWAV_RW(SDL_RWFromFile(path, "rb"), SDL_TRUE, dst_spec);
+}
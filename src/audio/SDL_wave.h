@@ -99,6 +99,7 @@ typedef struct WaveChunk
     Sint64 position; /* Position of the data in the stream. */
     Uint8 *data;     /* When allocated, this points to the chunk data. length is used for the memory allocation size. */
     size_t size;     /* Number of bytes in data that could be read from the stream. Can be smaller than length. */
+    SDL_bool borrowed; /* data points into the stream's memory instead of an allocation. */
 } WaveChunk;
 
 /* Controls how the size of the RIFF chunk affects the loading of a WAVE file. */
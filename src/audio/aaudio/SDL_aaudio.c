@@ -44,6 +44,8 @@ struct SDL_PrivateAudioData
     SDL_Semaphore *semaphore;
     SDL_AtomicInt error_callback_triggered;
     SDL_bool resume;  // Resume device if it was paused automatically
+    int32_t xrun_count;     // The stream's xrun count when the data callback last checked
+    int32_t burst_frames;   // Buffer size step when tuning latency, zero if we leave the buffer size alone
 };
 
 // Debug
@@ -95,6 +97,27 @@ static aaudio_data_callback_result_t AAUDIO_dataCallback(AAudioStream *stream, v
     size_t framesize = SDL_AUDIO_FRAMESIZE(device->spec);
     size_t callback_bytes = numFrames * framesize;
     size_t old_buffer_index = hidden->callback_bytes / device->buffer_size;
+    const int32_t xrun_count = ctx.AAudioStream_getXRunCount(stream);
+
+    if (xrun_count > hidden->xrun_count) {
+        SDL_AtomicAdd(&device->xruns, xrun_count - hidden->xrun_count);
+        hidden->xrun_count = xrun_count;
+
+        // We started with the smallest buffer that might work; grow it by a burst every time the device underruns.
+        if (hidden->burst_frames > 0) {
+            const int32_t capacity = ctx.AAudioStream_getBufferCapacityInFrames(stream);
+            const int32_t size = ctx.AAudioStream_getBufferSizeInFrames(stream);
+            if (size < capacity) {
+                const int32_t new_size = ctx.AAudioStream_setBufferSizeInFrames(stream, SDL_min(size + hidden->burst_frames, capacity));
+                if (new_size > 0) {
+                    LOGI("AAudio underrun, buffer size now %d frames", (int)new_size);
+                    SDL_AtomicSet(&device->latency_frames, (int)new_size);
+                }
+            } else {
+                hidden->burst_frames = 0;  // nothing left to tune.
+            }
+        }
+    }
 
     if (device->iscapture) {
         const Uint8 *input = (const Uint8 *)audioData;
@@ -312,9 +335,14 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
     ctx.AAudioStreamBuilder_setErrorCallback(builder, AAUDIO_errorCallback, device);
     ctx.AAudioStreamBuilder_setDataCallback(builder, AAUDIO_dataCallback, device);
     // Some devices have flat sounding audio when low latency mode is enabled, but this is a better experience for most people
-    if (SDL_GetHintBoolean("SDL_ANDROID_LOW_LATENCY_AUDIO", SDL_TRUE)) {
+    const SDL_bool low_latency_mode = SDL_GetHintBoolean("SDL_ANDROID_LOW_LATENCY_AUDIO", SDL_TRUE) || device->low_latency;
+    if (low_latency_mode) {
         ctx.AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
     }
+    // Exclusive streams can get an MMAP path straight to the hardware, skipping the system mixer and its buffering.
+    if (device->exclusive) {
+        ctx.AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
+    }
 
     LOGI("AAudio Try to open %u hz %u bit chan %u %s samples %u",
          device->spec.freq, SDL_AUDIO_BITSIZE(device->spec.format),
@@ -328,6 +356,11 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
     }
     ctx.AAudioStreamBuilder_delete(builder);
 
+    if (device->exclusive && (ctx.AAudioStream_getSharingMode(hidden->stream) != AAUDIO_SHARING_MODE_EXCLUSIVE)) {
+        LOGI("AAudio didn't give us exclusive access, falling back to shared mode");
+        device->exclusive = SDL_FALSE;
+    }
+
     device->sample_frames = (int)ctx.AAudioStream_getFramesPerDataCallback(hidden->stream);
     if (device->sample_frames == AAUDIO_UNSPECIFIED) {
         // We'll get variable frames in the callback, make sure we have at least half a buffer available
@@ -360,6 +393,21 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
     hidden->processed_bytes = 0;
     hidden->callback_bytes = 0;
 
+    // The stream usually starts out with a generous buffer. When the app asked for low latency, cut it down
+    // to two bursts (or what the data callback needs) and let AAUDIO_dataCallback grow it if the device underruns.
+    hidden->xrun_count = ctx.AAudioStream_getXRunCount(hidden->stream);
+    hidden->burst_frames = 0;
+    if (!iscapture && low_latency_mode && (device->low_latency || device->exclusive)) {
+        const int32_t burst_frames = ctx.AAudioStream_getFramesPerBurst(hidden->stream);
+        if (burst_frames > 0) {
+            const int32_t wanted = SDL_max(burst_frames * 2, (int32_t)device->sample_frames);
+            if (ctx.AAudioStream_setBufferSizeInFrames(hidden->stream, wanted) > 0) {
+                hidden->burst_frames = burst_frames;
+            }
+        }
+    }
+    SDL_AtomicSet(&device->latency_frames, (int)ctx.AAudioStream_getBufferSizeInFrames(hidden->stream));
+
     hidden->semaphore = SDL_CreateSemaphore(iscapture ? 0 : hidden->num_buffers);
     if (!hidden->semaphore) {
         LOGI("SDL Failed SDL_CreateSemaphore %s iscapture:%d", SDL_GetError(), iscapture);
@@ -523,6 +571,7 @@ static SDL_bool AAUDIO_Init(SDL_AudioDriverImpl *impl)
 #else
     impl->OnlyHasDefaultOutputDevice = SDL_TRUE;
     impl->OnlyHasDefaultCaptureDevice = SDL_TRUE;
+    impl->SupportsExclusiveAccess = SDL_TRUE;
 #endif
 
     LOGI("SDL AAUDIO_Init OK");
@@ -48,6 +48,8 @@ static int (*ALSA_snd_pcm_close)(snd_pcm_t *pcm);
 static int (*ALSA_snd_pcm_start)(snd_pcm_t *pcm);
 static snd_pcm_sframes_t (*ALSA_snd_pcm_writei)(snd_pcm_t *, const void *, snd_pcm_uframes_t);
 static snd_pcm_sframes_t (*ALSA_snd_pcm_readi)(snd_pcm_t *, void *, snd_pcm_uframes_t);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_writei)(snd_pcm_t *, const void *, snd_pcm_uframes_t);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_readi)(snd_pcm_t *, void *, snd_pcm_uframes_t);
 static int (*ALSA_snd_pcm_recover)(snd_pcm_t *, int, int);
 static int (*ALSA_snd_pcm_prepare)(snd_pcm_t *);
 static int (*ALSA_snd_pcm_drain)(snd_pcm_t *);
@@ -119,6 +121,8 @@ static int load_alsa_syms(void)
     SDL_ALSA_SYM(snd_pcm_start);
     SDL_ALSA_SYM(snd_pcm_writei);
     SDL_ALSA_SYM(snd_pcm_readi);
+    SDL_ALSA_SYM(snd_pcm_mmap_writei);
+    SDL_ALSA_SYM(snd_pcm_mmap_readi);
     SDL_ALSA_SYM(snd_pcm_recover);
     SDL_ALSA_SYM(snd_pcm_prepare);
     SDL_ALSA_SYM(snd_pcm_drain);
@@ -354,6 +358,9 @@ static int ALSA_WaitDevice(SDL_AudioDevice *device)
     while (!SDL_AtomicGet(&device->shutdown)) {
         const int rc = ALSA_snd_pcm_wait(device->hidden->pcm_handle, delay);
         if (rc < 0 && (rc != -EAGAIN)) {
+            if (rc == -EPIPE) {
+                SDL_AtomicIncRef(&device->xruns);
+            }
             const int status = ALSA_snd_pcm_recover(device->hidden->pcm_handle, rc, 0);
             if (status < 0) {
                 // Hmm, not much we can do - abort
@@ -383,11 +390,14 @@ static int ALSA_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buf
     device->hidden->swizzle_func(device, sample_buf, frames_left);
 
     while ((frames_left > 0) && !SDL_AtomicGet(&device->shutdown)) {
-        const int rc = ALSA_snd_pcm_writei(device->hidden->pcm_handle, sample_buf, frames_left);
+        const int rc = device->hidden->writei(device->hidden->pcm_handle, sample_buf, frames_left);
         //SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "ALSA PLAYDEVICE: WROTE %d of %d bytes", (rc >= 0) ? ((int) (rc * frame_size)) : rc, (int) (frames_left * frame_size));
         SDL_assert(rc != 0);  // assuming this can't happen if we used snd_pcm_wait and queried for available space.
         if (rc < 0) {
             SDL_assert(rc != -EAGAIN);  // assuming this can't happen if we used snd_pcm_wait and queried for available space. snd_pcm_recover won't handle it!
+            if (rc == -EPIPE) {  // underrun.
+                SDL_AtomicIncRef(&device->xruns);
+            }
             const int status = ALSA_snd_pcm_recover(device->hidden->pcm_handle, rc, 0);
             if (status < 0) {
                 // Hmm, not much we can do - abort
@@ -435,11 +445,14 @@ static int ALSA_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, int buf
     const snd_pcm_sframes_t total_available = ALSA_snd_pcm_avail(device->hidden->pcm_handle);
     const int total_frames = SDL_min(buflen / frame_size, total_available);
 
-    const int rc = ALSA_snd_pcm_readi(device->hidden->pcm_handle, buffer, total_frames);
+    const int rc = device->hidden->readi(device->hidden->pcm_handle, buffer, total_frames);
 
     SDL_assert(rc != -EAGAIN);  // assuming this can't happen if we used snd_pcm_wait and queried for available space. snd_pcm_recover won't handle it!
 
     if (rc < 0) {
+        if (rc == -EPIPE) {  // overrun.
+            SDL_AtomicIncRef(&device->xruns);
+        }
         const int status = ALSA_snd_pcm_recover(device->hidden->pcm_handle, rc, 0);
         if (status < 0) {
             // Hmm, not much we can do - abort
@@ -515,12 +528,14 @@ static int ALSA_set_buffer_size(SDL_AudioDevice *device, snd_pcm_hw_params_t *pa
 
     device->sample_frames = persize;
 
+    // Everything queued in the ring buffer is waiting to be played (or read), so that's our latency.
+    snd_pcm_uframes_t bufsize = 0;
+    if (ALSA_snd_pcm_hw_params_get_buffer_size(hwparams, &bufsize) == 0) {
+        SDL_AtomicSet(&device->latency_frames, (int) bufsize);
+    }
+
     // This is useful for debugging
     if (SDL_getenv("SDL_AUDIO_ALSA_DEBUG")) {
-        snd_pcm_uframes_t bufsize;
-
-        ALSA_snd_pcm_hw_params_get_buffer_size(hwparams, &bufsize);
-
         SDL_LogError(SDL_LOG_CATEGORY_AUDIO,
                      "ALSA: period size = %ld, periods = %u, buffer size = %lu",
                      persize, periods, bufsize);
@@ -563,10 +578,30 @@ static int ALSA_OpenDevice(SDL_AudioDevice *device)
     }
 
     // SDL only uses interleaved sample output
-    status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
-                                               SND_PCM_ACCESS_RW_INTERLEAVED);
+    device->hidden->writei = ALSA_snd_pcm_writei;
+    device->hidden->readi = ALSA_snd_pcm_readi;
+    status = -1;
+    if (device->low_latency) {
+        /* mmap access copies straight into the hardware ring buffer instead of
+           going through the kernel's read/write path, which shaves a little
+           off each period. Try it on a scratch copy, since a failed set_access
+           can leave the configuration space narrowed. */
+        snd_pcm_hw_params_t *mmap_hwparams = NULL;
+        snd_pcm_hw_params_alloca(&mmap_hwparams);
+        ALSA_snd_pcm_hw_params_copy(mmap_hwparams, hwparams);
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, mmap_hwparams, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        if (status >= 0) {
+            ALSA_snd_pcm_hw_params_copy(hwparams, mmap_hwparams);
+            device->hidden->writei = ALSA_snd_pcm_mmap_writei;
+            device->hidden->readi = ALSA_snd_pcm_mmap_readi;
+        }
+    }
     if (status < 0) {
-        return SDL_SetError("ALSA: Couldn't set interleaved access: %s", ALSA_snd_strerror(status));
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+                                                   SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (status < 0) {
+            return SDL_SetError("ALSA: Couldn't set interleaved access: %s", ALSA_snd_strerror(status));
+        }
     }
 
     // Try for a closest match on audio format
@@ -35,6 +35,10 @@ struct SDL_PrivateAudioData
     // Raw mixing buffer
     Uint8 *mixbuf;
 
+    // snd_pcm_writei/readi, or their mmap versions if we got mmap access.
+    snd_pcm_sframes_t (*writei)(snd_pcm_t *, const void *, snd_pcm_uframes_t);
+    snd_pcm_sframes_t (*readi)(snd_pcm_t *, void *, snd_pcm_uframes_t);
+
     // swizzle function
     void (*swizzle_func)(SDL_AudioDevice *_this, void *buffer, Uint32 bufferlen);
 };
@@ -25,6 +25,7 @@
 // Output raw audio data to a file.
 
 #include "../SDL_sysaudio.h"
+#include "../../thread/SDL_systhread.h"
 #include "SDL_diskaudio.h"
 
 // !!! FIXME: these should be SDL hints, not environment variables.
@@ -34,14 +35,25 @@
 #define DISKENVR_INFILE     "SDL_DISKAUDIOFILEIN"
 #define DISKDEFAULT_INFILE  "sdlaudio-in.raw"
 #define DISKENVR_IODELAY    "SDL_DISKAUDIODELAY"
+#define DISKENVR_WRITEBUFFER "SDL_DISKAUDIOWRITEBUFFER"
+#define DISKDEFAULT_WRITEBUFFER (1024 * 1024)
+#define DISKENVR_ASYNC      "SDL_DISKAUDIOASYNC"
+
+// Size of the WAVE header written before the data, when the output file ends in ".wav".
+#define DISKAUDIO_WAV_HEADER_SIZE 58
 
 static int DISKAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
-    SDL_Delay(device->hidden->io_delay);
+    // a delay of zero runs the device thread as fast as it can go, for rendering faster than real time.
+    if (device->hidden->io_delay > 0) {
+        SDL_Delay(device->hidden->io_delay);
+    } else if (device->hidden->skip_buffer) {
+        SDL_Delay(1);  // nothing to render, don't spin while the app catches up.
+    }
     return 0;
 }
 
-static int DISKAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+static int DISKAUDIO_Write(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
 {
     const int written = (int)SDL_RWwrite(device->hidden->io, buffer, (size_t)buffer_size);
     if (written != buffer_size) { // If we couldn't write, assume fatal error for now
@@ -53,9 +65,143 @@ static int DISKAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, in
     return 0;
 }
 
+static int SDLCALL DISKAUDIO_WriterThread(void *data)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *)data;
+    struct SDL_PrivateAudioData *h = device->hidden;
+
+    SDL_LockMutex(h->writer_lock);
+    for (;;) {
+        while (!h->pending_len && !h->writer_shutdown) {
+            SDL_WaitCondition(h->writer_cond, h->writer_lock);
+        }
+        if (!h->pending_len) {
+            break;  // shutting down, and everything is written.
+        }
+
+        const Uint8 *buffer = h->write_buffers[h->current_buffer ^ 1];  // the device thread only swaps when we're idle.
+        const int len = h->pending_len;
+        SDL_UnlockMutex(h->writer_lock);
+        const int rc = DISKAUDIO_Write(device, buffer, len);
+        SDL_LockMutex(h->writer_lock);
+
+        if (rc < 0) {
+            h->write_failed = SDL_TRUE;
+        }
+        h->pending_len = 0;
+        SDL_BroadcastCondition(h->writer_cond);
+    }
+    SDL_UnlockMutex(h->writer_lock);
+
+    return 0;
+}
+
+// Write out whatever is gathered in the current buffer, or hand it to the writer thread and switch to the other one.
+static int DISKAUDIO_FlushWrites(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *h = device->hidden;
+    int retval = 0;
+
+    if (!h->write_buffer_fill) {
+        return 0;
+    } else if (!h->writer) {
+        retval = DISKAUDIO_Write(device, h->write_buffers[0], h->write_buffer_fill);
+        h->write_buffer_fill = 0;
+        return retval;
+    }
+
+    SDL_LockMutex(h->writer_lock);
+    while (h->pending_len) {
+        SDL_WaitCondition(h->writer_cond, h->writer_lock);  // the disk is slower than we are; wait for the other buffer.
+    }
+    if (h->write_failed) {
+        retval = -1;
+    } else {
+        h->pending_len = h->write_buffer_fill;
+        h->current_buffer ^= 1;
+        h->write_buffer_fill = 0;
+        SDL_BroadcastCondition(h->writer_cond);
+    }
+    SDL_UnlockMutex(h->writer_lock);
+
+    return retval;
+}
+
+// The device lock is held here, so it's safe to look at the bound streams.
+static SDL_bool DISKAUDIO_HasDataToRender(SDL_AudioDevice *device)
+{
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (SDL_AtomicGet(&logdev->paused)) {
+            continue;
+        }
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            if (stream->get_callback || (SDL_GetAudioStreamAvailable(stream) > 0)) {
+                return SDL_TRUE;
+            }
+        }
+    }
+    return SDL_FALSE;
+}
+
+static int DISKAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+{
+    struct SDL_PrivateAudioData *h = device->hidden;
+
+    if (h->skip_buffer) {
+        return 0;  // rendering faster than real time, and there was nothing to render, so don't pad the file with silence.
+    }
+
+    h->wav_data_bytes += (Uint64) buffer_size;
+
+    if (!h->write_buffer_size) {
+        return DISKAUDIO_Write(device, buffer, buffer_size);
+    }
+
+    // the device thread rendered straight into the write buffer (see GetDeviceBuf), so there's nothing to copy.
+    SDL_assert(buffer == h->write_buffers[h->current_buffer] + h->write_buffer_fill);
+    h->write_buffer_fill += buffer_size;
+    if ((h->write_buffer_fill + device->buffer_size) > h->write_buffer_size) {
+        return DISKAUDIO_FlushWrites(device);
+    }
+    return 0;
+}
+
 static Uint8 *DISKAUDIO_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
 {
-    return device->hidden->mixbuf;
+    struct SDL_PrivateAudioData *h = device->hidden;
+    h->skip_buffer = (h->io_delay == 0) && !DISKAUDIO_HasDataToRender(device);
+    if (!h->write_buffer_size) {
+        return h->mixbuf;
+    }
+    return h->write_buffers[h->current_buffer] + h->write_buffer_fill;
+}
+
+static void DISKAUDIO_WriteWavHeader(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *h = device->hidden;
+    const SDL_AudioSpec *spec = &device->spec;
+    const Uint16 format_tag = SDL_AUDIO_ISFLOAT(spec->format) ? 3 : 1;  // WAVE_FORMAT_IEEE_FLOAT or WAVE_FORMAT_PCM
+    const Uint16 block_align = (Uint16) SDL_AUDIO_FRAMESIZE(*spec);
+    const Uint32 data_size = (Uint32) SDL_min(h->wav_data_bytes, (Uint64) (0xFFFFFFFF - DISKAUDIO_WAV_HEADER_SIZE));
+    SDL_RWops *io = h->io;
+
+    SDL_RWwrite(io, "RIFF", 4);
+    SDL_WriteU32LE(io, data_size + DISKAUDIO_WAV_HEADER_SIZE - 8);
+    SDL_RWwrite(io, "WAVE", 4);
+    SDL_RWwrite(io, "fmt ", 4);
+    SDL_WriteU32LE(io, 18);
+    SDL_WriteU16LE(io, format_tag);
+    SDL_WriteU16LE(io, (Uint16) spec->channels);
+    SDL_WriteU32LE(io, (Uint32) spec->freq);
+    SDL_WriteU32LE(io, (Uint32) spec->freq * block_align);
+    SDL_WriteU16LE(io, block_align);
+    SDL_WriteU16LE(io, (Uint16) SDL_AUDIO_BITSIZE(spec->format));
+    SDL_WriteU16LE(io, 0);  // cbSize
+    SDL_RWwrite(io, "fact", 4);  // every format but PCM is supposed to have one.
+    SDL_WriteU32LE(io, 4);
+    SDL_WriteU32LE(io, data_size / block_align);
+    SDL_RWwrite(io, "data", 4);
+    SDL_WriteU32LE(io, data_size);
 }
 
 static int DISKAUDIO_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, int buflen)
@@ -86,16 +232,43 @@ static void DISKAUDIO_FlushCapture(SDL_AudioDevice *device)
 
 static void DISKAUDIO_CloseDevice(SDL_AudioDevice *device)
 {
-    if (device->hidden) {
-        if (device->hidden->io) {
-            SDL_RWclose(device->hidden->io);
+    struct SDL_PrivateAudioData *h = device->hidden;
+    if (h) {
+        if (h->io) {
+            DISKAUDIO_FlushWrites(device);
         }
-        SDL_free(device->hidden->mixbuf);
-        SDL_free(device->hidden);
+
+        if (h->writer) {
+            SDL_LockMutex(h->writer_lock);
+            h->writer_shutdown = SDL_TRUE;
+            SDL_BroadcastCondition(h->writer_cond);
+            SDL_UnlockMutex(h->writer_lock);
+            SDL_WaitThread(h->writer, NULL);
+        }
+        SDL_DestroyCondition(h->writer_cond);
+        SDL_DestroyMutex(h->writer_lock);
+
+        if (h->io) {
+            // now that we know how much was written, fill in the real sizes (this fails quietly on pipes and such).
+            if (h->wav && (SDL_RWseek(h->io, 0, SDL_RW_SEEK_SET) == 0)) {
+                DISKAUDIO_WriteWavHeader(device);
+            }
+            SDL_RWclose(h->io);
+        }
+        SDL_aligned_free(h->write_buffers[0]);
+        SDL_aligned_free(h->write_buffers[1]);
+        SDL_free(h->mixbuf);
+        SDL_free(h);
         device->hidden = NULL;
     }
 }
 
+static SDL_bool is_wav_filename(const char *fname)
+{
+    const size_t len = SDL_strlen(fname);
+    return ((len >= 4) && (SDL_strcasecmp(fname + len - 4, ".wav") == 0)) ? SDL_TRUE : SDL_FALSE;
+}
+
 static const char *get_filename(const SDL_bool iscapture)
 {
     const char *devname = SDL_getenv(iscapture ? DISKENVR_INFILE : DISKENVR_OUTFILE);
@@ -128,13 +301,61 @@ static int DISKAUDIO_OpenDevice(SDL_AudioDevice *device)
         return -1;
     }
 
+    if (!iscapture && is_wav_filename(fname)) {
+        // WAVE files are little endian, and 8-bit data is unsigned.
+        SDL_AudioFormat format = device->spec.format;
+        if (format == SDL_AUDIO_S8) {
+            format = SDL_AUDIO_U8;
+        } else if (SDL_AUDIO_BITSIZE(format) == 16) {
+            format = SDL_AUDIO_S16LE;
+        } else if (SDL_AUDIO_ISFLOAT(format)) {
+            format = SDL_AUDIO_F32LE;
+        } else if (SDL_AUDIO_BITSIZE(format) == 32) {
+            format = SDL_AUDIO_S32LE;
+        }
+        if (format != device->spec.format) {
+            device->spec.format = format;
+            SDL_UpdatedAudioDeviceFormat(device);
+        }
+
+        device->hidden->wav = SDL_TRUE;
+        DISKAUDIO_WriteWavHeader(device);  // sizes are zero for now, CloseDevice fills them in.
+    }
+
     // Allocate mixing buffer
     if (!iscapture) {
-        device->hidden->mixbuf = (Uint8 *)SDL_malloc(device->buffer_size);
-        if (!device->hidden->mixbuf) {
-            return SDL_OutOfMemory();
+        envr = SDL_getenv(DISKENVR_WRITEBUFFER);
+        const int write_buffer_size = envr ? SDL_atoi(envr) : DISKDEFAULT_WRITEBUFFER;
+
+        if (write_buffer_size > 0) {
+            // the device renders straight into this, so make room for at least one whole device buffer.
+            struct SDL_PrivateAudioData *h = device->hidden;
+            h->write_buffer_size = SDL_max(write_buffer_size, device->buffer_size);
+            h->write_buffers[0] = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), h->write_buffer_size);
+            if (!h->write_buffers[0]) {
+                return SDL_OutOfMemory();
+            }
+
+            envr = SDL_getenv(DISKENVR_ASYNC);
+            if (envr && SDL_atoi(envr)) {
+                h->write_buffers[1] = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), h->write_buffer_size);
+                h->writer_lock = SDL_CreateMutex();
+                h->writer_cond = SDL_CreateCondition();
+                if (!h->write_buffers[1] || !h->writer_lock || !h->writer_cond) {
+                    return SDL_OutOfMemory();
+                }
+                h->writer = SDL_CreateThreadInternal(DISKAUDIO_WriterThread, "SDLDiskAudioWriter", 0, device);
+                if (!h->writer) {
+                    return -1;
+                }
+            }
+        } else {
+            device->hidden->mixbuf = (Uint8 *)SDL_malloc(device->buffer_size);
+            if (!device->hidden->mixbuf) {
+                return SDL_OutOfMemory();
+            }
+            SDL_memset(device->hidden->mixbuf, device->silence_value, device->buffer_size);
         }
-        SDL_memset(device->hidden->mixbuf, device->silence_value, device->buffer_size);
     }
 
     SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO, "You are using the SDL disk i/o audio driver!");
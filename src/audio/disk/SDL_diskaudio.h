@@ -31,6 +31,27 @@ struct SDL_PrivateAudioData
     SDL_RWops *io;
     Uint32 io_delay;
     Uint8 *mixbuf;
+
+    // Output is gathered in one of these and written in large blocks; the device renders straight into them.
+    Uint8 *write_buffers[2];
+    int write_buffer_size;
+    int write_buffer_fill;  // bytes used in write_buffers[current_buffer]
+    int current_buffer;
+
+    // If non-NULL, a thread writes full buffers while the device thread renders into the other one.
+    SDL_Thread *writer;
+    SDL_Mutex *writer_lock;
+    SDL_Condition *writer_cond;
+    int pending_len;  // bytes in the other buffer waiting for the writer thread, 0 if it's idle.
+    SDL_bool writer_shutdown;
+    SDL_bool write_failed;
+
+    // SDL_TRUE if the output file gets a WAVE header, which is patched with the final sizes on close.
+    SDL_bool wav;
+    Uint64 wav_data_bytes;
+
+    // SDL_TRUE if this iteration had nothing to render; without a delay, such buffers are skipped instead of written.
+    SDL_bool skip_buffer;
 };
 
 #endif // SDL_diskaudio_h_
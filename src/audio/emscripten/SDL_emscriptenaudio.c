@@ -23,6 +23,7 @@
 #ifdef SDL_AUDIO_DRIVER_EMSCRIPTEN
 
 #include "../SDL_sysaudio.h"
+#include "../../SDL_utils_c.h"
 #include "SDL_emscriptenaudio.h"
 
 #include <emscripten/emscripten.h>
@@ -36,9 +37,64 @@ static Uint8 *EMSCRIPTENAUDIO_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_
     return device->hidden->mixbuf;
 }
 
+// The ring holds this many device buffers, so the worklet can ride out a late wakeup of our thread.
+#define RING_BUFFERS 4
+
+// ring_positions[2] asks the worklet to stop, and the worklet sets ring_positions[3] when it has.
+#define RING_POSITION_COUNT 4
+
+static int GetRingFramesQueued(struct SDL_PrivateAudioData *hidden)
+{
+    return (int)((Uint32)SDL_AtomicGet(&hidden->ring_positions[1]) - (Uint32)SDL_AtomicGet(&hidden->ring_positions[0]));
+}
+
+static void PlayDeviceRing(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int framelen = SDL_AUDIO_FRAMESIZE(device->spec);
+    const int frames = buffer_size / framelen;
+    const int written = SDL_AtomicGet(&hidden->ring_positions[1]);
+
+    if (hidden->ring_frames - GetRingFramesQueued(hidden) >= frames) {
+        const int start = written & (hidden->ring_frames - 1);
+        const int first = SDL_min(frames, hidden->ring_frames - start);
+        Uint8 *ring = (Uint8 *)hidden->ring;
+
+        SDL_memcpy(ring + (start * framelen), buffer, first * framelen);
+        SDL_memcpy(ring, buffer + (first * framelen), (frames - first) * framelen);
+        SDL_AtomicSet(&hidden->ring_positions[1], (int)((Uint32)written + (Uint32)frames));
+    }
+    // else the worklet isn't consuming (autoplay is blocked?), drop this buffer so the app keeps going.
+}
+
+static int SDLCALL EMSCRIPTENAUDIO_RingThread(void *devicep)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *)devicep;
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const Uint64 ring_duration = (SDL_NS_PER_SECOND * hidden->ring_frames) / device->spec.freq;
+
+    SDL_OutputAudioThreadSetup(device);
+    do {
+        // Wait for room for another buffer, but give up after the whole ring's worth of time so we don't stall while the context is suspended.
+        const Uint64 timeout = SDL_GetTicksNS() + ring_duration;
+        while ((hidden->ring_frames - GetRingFramesQueued(hidden)) < device->sample_frames &&
+               !SDL_AtomicGet(&device->shutdown) && SDL_GetTicksNS() < timeout) {
+            SDL_Delay(1);
+        }
+    } while (SDL_OutputAudioThreadIterate(device));
+    SDL_OutputAudioThreadShutdown(device);
+    return 0;
+}
+
 static int EMSCRIPTENAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
 {
     const int framelen = SDL_AUDIO_FRAMESIZE(device->spec);
+
+    if (device->hidden->ring) {
+        PlayDeviceRing(device, buffer, buffer_size);
+        return 0;
+    }
+
     MAIN_THREAD_EM_ASM({
         var SDL3 = Module['SDL3'];
         var numChannels = SDL3.audio.currentOutputBuffer['numberOfChannels'];
@@ -90,10 +146,26 @@ static int EMSCRIPTENAUDIO_CaptureFromDevice(SDL_AudioDevice *device, void *buff
 
 static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
 {
+    SDL_bool worklet_stopped = SDL_TRUE;
+
     if (!device->hidden) {
         return;
     }
 
+    if (device->hidden->thread) {
+        SDL_WaitThread(device->hidden->thread, NULL);
+    }
+
+    if (device->hidden->ring_positions) {
+        // Make sure the worklet is done with the ring before it's freed. It won't answer if the context isn't running.
+        const Uint64 timeout = SDL_GetTicksNS() + SDL_MS_TO_NS(100);
+        SDL_AtomicSet(&device->hidden->ring_positions[2], 1);
+        while (!SDL_AtomicGet(&device->hidden->ring_positions[3]) && SDL_GetTicksNS() < timeout) {
+            SDL_Delay(1);
+        }
+        worklet_stopped = SDL_AtomicGet(&device->hidden->ring_positions[3]) ? SDL_TRUE : SDL_FALSE;
+    }
+
     MAIN_THREAD_EM_ASM({
         var SDL3 = Module['SDL3'];
         if ($0) {
@@ -118,6 +190,12 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
             if (SDL3.audio.scriptProcessorNode != undefined) {
                 SDL3.audio.scriptProcessorNode.disconnect();
             }
+            if (SDL3.audio.workletNode !== undefined) {
+                SDL3.audio.workletNode.disconnect();
+            }
+            if (SDL3.audio.resumeTimer !== undefined) {
+                clearInterval(SDL3.audio.resumeTimer);
+            }
             if (SDL3.audio.silenceTimer !== undefined) {
                 clearInterval(SDL3.audio.silenceTimer);
             }
@@ -129,6 +207,11 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
         }
     }, device->iscapture);
 
+    if (worklet_stopped) {
+        SDL_free(device->hidden->ring);
+        SDL_free(device->hidden->ring_positions);
+    }
+    // else the worklet might still touch the ring if the context resumes, so leave it alone.
     SDL_free(device->hidden->mixbuf);
     SDL_free(device->hidden);
     device->hidden = NULL;
@@ -140,6 +223,8 @@ EM_JS_DEPS(sdlaudio, "$autoResumeAudioContext,$dynCall");
 
 static int EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
 {
+    SDL_bool use_worklet = SDL_FALSE;
+
     // based on parts of library_sdl.js
 
     // create context
@@ -186,6 +271,16 @@ static int EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
 
     SDL_UpdatedAudioDeviceFormat(device);
 
+#ifndef SDL_THREADS_DISABLED
+    // An AudioWorklet can only read our memory directly if it's a SharedArrayBuffer, which means a pthreads build.
+    use_worklet = !device->iscapture && MAIN_THREAD_EM_ASM_INT({
+        return (typeof(AudioWorkletNode) !== 'undefined') &&
+               (Module['SDL3'].audioContext.audioWorklet !== undefined) &&
+               (typeof(SharedArrayBuffer) !== 'undefined') &&
+               (HEAPF32.buffer instanceof SharedArrayBuffer);
+    });
+#endif
+
     if (!device->iscapture) {
         device->hidden->mixbuf = (Uint8 *)SDL_malloc(device->buffer_size);
         if (!device->hidden->mixbuf) {
@@ -253,6 +348,85 @@ static int EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
                 navigator.webkitGetUserMedia({ audio: true, video: false }, have_microphone, no_microphone);
             }
         }, device->spec.channels, device->sample_frames, SDL_CaptureAudioThreadIterate, device);
+    } else if (use_worklet) {
+        /* Mixing runs on our own thread, which fills a ring in the shared wasm memory.
+           An AudioWorklet on the audio rendering thread plays from it, so a busy
+           main thread doesn't make the audio glitch. */
+        const int channels = device->spec.channels;
+        char threadname[64];
+
+        device->hidden->ring_frames = SDL_powerof2(device->sample_frames * RING_BUFFERS);
+        device->hidden->ring = (float *)SDL_calloc((size_t)device->hidden->ring_frames * channels, sizeof(float));
+        device->hidden->ring_positions = (SDL_AtomicInt *)SDL_calloc(RING_POSITION_COUNT, sizeof(SDL_AtomicInt));
+        if (!device->hidden->ring || !device->hidden->ring_positions) {
+            return SDL_OutOfMemory();
+        }
+
+        MAIN_THREAD_EM_ASM({
+            var SDL3 = Module['SDL3'];
+            var source = [
+                "class SDLAudioRingProcessor extends AudioWorkletProcessor {",
+                "  constructor(options) {",
+                "    super();",
+                "    var o = options.processorOptions;",
+                "    this.ring = new Float32Array(o.memory, o.ring, o.frames * o.channels);",
+                "    this.positions = new Int32Array(o.memory, o.positions, 4);",
+                "    this.mask = o.frames - 1;",
+                "    this.channels = o.channels;",
+                "  }",
+                "  process(inputs, outputs) {",
+                "    if (Atomics.load(this.positions, 2)) {",
+                "      Atomics.store(this.positions, 3, 1);",
+                "      return false;",
+                "    }",
+                "    var output = outputs[0];",
+                "    var channels = Math.min(this.channels, output.length);",
+                "    var read = Atomics.load(this.positions, 0);",
+                "    var count = Math.min((Atomics.load(this.positions, 1) - read) | 0, output[0].length);",
+                "    for (var c = 0; c < channels; ++c) {",
+                "      var out = output[c];",
+                "      for (var i = 0; i < count; ++i) {",
+                "        out[i] = this.ring[(((read + i) & this.mask) * this.channels) + c];",
+                "      }",
+                "      out.fill(0, count);",
+                "    }",
+                "    Atomics.store(this.positions, 0, (read + count) | 0);",
+                "    return true;",
+                "  }",
+                "}",
+                "registerProcessor('sdl-audio-ring', SDLAudioRingProcessor);"
+            ].join('\n');
+            var url = URL.createObjectURL(new Blob([source], { type: 'application/javascript' }));
+
+            SDL3.audioContext.audioWorklet.addModule(url).then(function() {
+                URL.revokeObjectURL(url);
+                if ((SDL3 === undefined) || (SDL3.audio === undefined)) { return; }
+                SDL3.audio.workletNode = new AudioWorkletNode(SDL3.audioContext, 'sdl-audio-ring', {
+                    numberOfInputs: 0,
+                    numberOfOutputs: 1,
+                    outputChannelCount: [$0],
+                    processorOptions: { memory: HEAPF32.buffer, ring: $1, positions: $2, frames: $3, channels: $0 }
+                });
+                SDL3.audio.workletNode.connect(SDL3.audioContext.destination);
+            });
+
+            if (SDL3.audioContext.state === 'suspended') {  // uhoh, autoplay is blocked.
+                SDL3.audio.resumeTimer = setInterval(function() {
+                    if (SDL3.audioContext.state !== 'suspended') {
+                        clearInterval(SDL3.audio.resumeTimer);
+                        SDL3.audio.resumeTimer = undefined;
+                    } else if (((typeof navigator.userActivation) !== 'undefined') && navigator.userActivation.hasBeenActive) {
+                        SDL3.audioContext.resume();
+                    }
+                }, 100);
+            }
+        }, channels, device->hidden->ring, device->hidden->ring_positions, device->hidden->ring_frames);
+
+        SDL_GetAudioThreadName(device, threadname, sizeof(threadname));
+        device->hidden->thread = SDL_CreateThreadInternal(EMSCRIPTENAUDIO_RingThread, threadname, 0, device);
+        if (!device->hidden->thread) {
+            return SDL_SetError("Couldn't create audio thread");
+        }
     } else {
         // setup a ScriptProcessorNode
         MAIN_THREAD_EM_ASM({
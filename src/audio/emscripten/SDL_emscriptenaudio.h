@@ -28,6 +28,12 @@
 struct SDL_PrivateAudioData
 {
     Uint8 *mixbuf;
+
+    /* AudioWorklet output: interleaved frames shared with the audio rendering thread */
+    float *ring;
+    int ring_frames;
+    SDL_AtomicInt *ring_positions; /* [0] is frames read by the worklet, [1] is frames written by us */
+    SDL_Thread *thread;
 };
 
 #endif // SDL_emscriptenaudio_h_
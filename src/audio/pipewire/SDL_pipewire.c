@@ -26,8 +26,10 @@
 #include "SDL_pipewire.h"
 
 #include <pipewire/extensions/metadata.h>
+#include <spa/node/io.h>
 #include <spa/param/audio/format-utils.h>
 #include <spa/utils/json.h>
+#include <time.h>
 
 /*
  * The following keys are defined for compatibility when building against older versions of Pipewire
@@ -59,6 +61,14 @@
 #define PW_KEY_TARGET_OBJECT "target.object"
 #endif
 
+/*
+ * Not in older headers; older servers just ignore unknown keys.
+ * Taken from src/pipewire/keys.h
+ */
+#ifndef PW_KEY_NODE_LOCK_QUANTUM
+#define PW_KEY_NODE_LOCK_QUANTUM "node.lock-quantum"
+#endif
+
 /*
  * This seems to be a sane lower limit as Pipewire
  * uses it in several of it's own modules.
@@ -956,9 +966,35 @@ static int PIPEWIRE_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int
     return 0;
 }
 
+// The graph quantum is whatever PipeWire settled on after weighing every node's PW_KEY_NODE_LATENCY; report that, in our sample rate.
+static void update_latency(SDL_AudioDevice *device)
+{
+    const struct spa_io_position *position = device->hidden->position;
+    if (position && position->clock.rate.denom) {
+        const Uint64 frames = (position->clock.duration * position->clock.rate.num * (Uint64)device->spec.freq) / position->clock.rate.denom;
+        SDL_AtomicSet(&device->latency_frames, (int)frames);
+    }
+}
+
+// PipeWire doesn't tell streams about xruns, but if we're still busy when the graph expected its next cycle, we made it late.
+static void check_xrun(SDL_AudioDevice *device)
+{
+    const struct spa_io_position *position = device->hidden->position;
+    if (position && position->clock.next_nsec) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);  // the graph clock uses CLOCK_MONOTONIC.
+        if (((Uint64)SDL_SECONDS_TO_NS(now.tv_sec) + now.tv_nsec) > position->clock.next_nsec) {
+            SDL_AtomicIncRef(&device->xruns);
+        }
+    }
+}
+
 static void output_callback(void *data)
 {
-    SDL_OutputAudioThreadIterate((SDL_AudioDevice *)data);
+    SDL_AudioDevice *device = (SDL_AudioDevice *)data;
+    update_latency(device);
+    SDL_OutputAudioThreadIterate(device);
+    check_xrun(device);
 }
 
 static void PIPEWIRE_FlushCapture(SDL_AudioDevice *device)
@@ -999,7 +1035,18 @@ static int PIPEWIRE_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, int
 
 static void input_callback(void *data)
 {
-    SDL_CaptureAudioThreadIterate((SDL_AudioDevice *)data);
+    SDL_AudioDevice *device = (SDL_AudioDevice *)data;
+    update_latency(device);
+    SDL_CaptureAudioThreadIterate(device);
+    check_xrun(device);
+}
+
+static void stream_io_changed_callback(void *data, uint32_t id, void *area, uint32_t size)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *) data;
+    if (id == SPA_IO_Position) {
+        device->hidden->position = (area && size >= sizeof(struct spa_io_position)) ? (struct spa_io_position *)area : NULL;
+    }
 }
 
 static void stream_add_buffer_callback(void *data, struct pw_buffer *buffer)
@@ -1036,10 +1083,12 @@ static void stream_state_changed_callback(void *data, enum pw_stream_state old,
 
 static const struct pw_stream_events stream_output_events = { PW_VERSION_STREAM_EVENTS,
                                                               .state_changed = stream_state_changed_callback,
+                                                              .io_changed = stream_io_changed_callback,
                                                               .add_buffer = stream_add_buffer_callback,
                                                               .process = output_callback };
 static const struct pw_stream_events stream_input_events = { PW_VERSION_STREAM_EVENTS,
                                                              .state_changed = stream_state_changed_callback,
+                                                             .io_changed = stream_io_changed_callback,
                                                              .add_buffer = stream_add_buffer_callback,
                                                              .process = input_callback };
 
@@ -1152,6 +1201,10 @@ static int PIPEWIRE_OpenDevice(SDL_AudioDevice *device)
     PIPEWIRE_pw_properties_setf(props, PW_KEY_NODE_RATE, "1/%u", device->spec.freq);
     PIPEWIRE_pw_properties_set(props, PW_KEY_NODE_ALWAYS_PROCESS, "true");
     PIPEWIRE_pw_properties_set(props, PW_KEY_NODE_DONT_RECONNECT, "true");  // Requesting a specific device, don't migrate to new default hardware.
+    if (device->low_latency) {
+        // Don't let another client with a larger node latency drag the graph quantum back up while we're running.
+        PIPEWIRE_pw_properties_set(props, PW_KEY_NODE_LOCK_QUANTUM, "true");
+    }
 
     /*
      * Pipewire 0.3.44 introduced PW_KEY_TARGET_OBJECT that takes either a path
@@ -38,6 +38,9 @@ struct SDL_PrivateAudioData
 
     // Set in GetDeviceBuf, filled in AudioThreadIterate, queued in PlayDevice
     struct pw_buffer *pw_buf;
+
+    // The graph clock, handed to us by io_changed. Used to report the negotiated quantum.
+    struct spa_io_position *position;
 };
 
 #endif // SDL_pipewire_h_
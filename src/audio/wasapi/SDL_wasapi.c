@@ -46,6 +46,9 @@
 // Some GUIDs we need to know without linking to libraries that aren't available before Vista.
 static const IID SDL_IID_IAudioRenderClient = { 0xf294acfc, 0x3146, 0x4483, { 0xa7, 0xbf, 0xad, 0xdc, 0xa7, 0xc2, 0x60, 0xe2 } };
 static const IID SDL_IID_IAudioCaptureClient = { 0xc8adbd64, 0xe71e, 0x48a0, { 0xa4, 0xde, 0x18, 0x5c, 0x39, 0x5c, 0xd3, 0x17 } };
+#ifdef __IAudioClient3_INTERFACE_DEFINED__
+static const IID SDL_IID_IAudioClient3 = { 0x7ed4ee07, 0x8e67, 0x4cd4, { 0x8c, 0x1a, 0x2b, 0x7a, 0x59, 0x87, 0xad, 0x42 } };
+#endif
 
 
 // WASAPI is _really_ particular about various things happening on the same thread, for COM and such,
@@ -498,6 +501,10 @@ static int WASAPI_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, int b
             const int leftover = total - cpy;
             const SDL_bool silent = (flags & AUDCLNT_BUFFERFLAGS_SILENT) ? SDL_TRUE : SDL_FALSE;
 
+            if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {  // we didn't read fast enough and the device dropped data.
+                SDL_AtomicIncRef(&device->xruns);
+            }
+
             SDL_assert(leftover == 0);  // according to MSDN, this isn't everything available, just one "packet" of data per-GetBuffer call.
 
             if (silent) {
@@ -544,22 +551,36 @@ static void WASAPI_CloseDevice(SDL_AudioDevice *device)
     }
 }
 
+// Windows 10 lets shared-mode streams run at the audio engine's smallest period instead of the default ~10ms.
+static SDL_bool InitializeLowLatencySharedStream(IAudioClient *client, const WAVEFORMATEX *waveformat, DWORD streamflags, UINT32 *period_frames)
+{
+    SDL_bool retval = SDL_FALSE;
+#ifdef __IAudioClient3_INTERFACE_DEFINED__
+    IAudioClient3 *client3 = NULL;
+    if (SUCCEEDED(IAudioClient_QueryInterface(client, &SDL_IID_IAudioClient3, (void **)&client3))) {
+        UINT32 default_frames = 0, fundamental_frames = 0, min_frames = 0, max_frames = 0;
+        if (SUCCEEDED(IAudioClient3_GetSharedModeEnginePeriod(client3, waveformat, &default_frames, &fundamental_frames, &min_frames, &max_frames)) &&
+            SUCCEEDED(IAudioClient3_InitializeSharedAudioStream(client3, streamflags, min_frames, waveformat, NULL))) {
+            *period_frames = min_frames;
+            retval = SDL_TRUE;
+        }
+        IAudioClient3_Release(client3);
+    }
+#endif
+    return retval;
+}
+
 static int mgmtthrtask_PrepDevice(void *userdata)
 {
     SDL_AudioDevice *device = (SDL_AudioDevice *)userdata;
 
-    /* !!! FIXME: we could request an exclusive mode stream, which is lower latency;
-       !!!  it will write into the kernel's audio buffer directly instead of
-       !!!  shared memory that a user-mode mixer then writes to the kernel with
-       !!!  everything else. Doing this means any other sound using this device will
-       !!!  stop playing, including the user's MP3 player and system notification
-       !!!  sounds. You'd probably need to release the device when the app isn't in
-       !!!  the foreground, to be a good citizen of the system. It's doable, but it's
-       !!!  more work and causes some annoyances, and I don't know what the latency
-       !!!  wins actually look like. Maybe add a hint to force exclusive mode at
-       !!!  some point. To be sure, defaulting to shared mode is the right thing to
-       !!!  do in any case. */
-    const AUDCLNT_SHAREMODE sharemode = AUDCLNT_SHAREMODE_SHARED;
+    /* Exclusive mode writes into the kernel's audio buffer directly instead of
+       shared memory that a user-mode mixer then writes to the kernel with
+       everything else. Doing this means any other sound using this device will
+       stop playing, including the user's MP3 player and system notification
+       sounds, so we only do it when the app explicitly asks for it with
+       SDL_HINT_AUDIO_DEVICE_LOW_LATENCY. Shared mode is the right default. */
+    AUDCLNT_SHAREMODE sharemode = AUDCLNT_SHAREMODE_SHARED;
 
     IAudioClient *client = device->hidden->client;
     SDL_assert(client != NULL);
@@ -604,11 +625,21 @@ static int mgmtthrtask_PrepDevice(void *userdata)
     }
 
     REFERENCE_TIME default_period = 0;
-    ret = IAudioClient_GetDevicePeriod(client, &default_period, NULL);
+    REFERENCE_TIME min_period = 0;
+    ret = IAudioClient_GetDevicePeriod(client, &default_period, &min_period);
     if (FAILED(ret)) {
         return WIN_SetErrorFromHRESULT("WASAPI can't determine minimum device period", ret);
     }
 
+    // Exclusive mode takes the device's mix format as-is (we'll resample on our side), so check that the hardware will accept it directly.
+    if (device->exclusive) {
+        if (SUCCEEDED(IAudioClient_IsFormatSupported(client, AUDCLNT_SHAREMODE_EXCLUSIVE, waveformat, NULL))) {
+            sharemode = AUDCLNT_SHAREMODE_EXCLUSIVE;
+        } else {
+            device->exclusive = SDL_FALSE;
+        }
+    }
+
     DWORD streamflags = 0;
 
     /* we've gotten reports that WASAPI's resampler introduces distortions, but in the short term
@@ -616,7 +647,7 @@ static int mgmtthrtask_PrepDevice(void *userdata)
        Refer to bug #6326 for the immediate concern. */
 #if 1
     // favor WASAPI's resampler over our own
-    if ((DWORD)device->spec.freq != waveformat->nSamplesPerSec) {
+    if ((sharemode == AUDCLNT_SHAREMODE_SHARED) && ((DWORD)device->spec.freq != waveformat->nSamplesPerSec)) {
         streamflags |= (AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM | AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY);
         waveformat->nSamplesPerSec = device->spec.freq;
         waveformat->nAvgBytesPerSec = waveformat->nSamplesPerSec * waveformat->nChannels * (waveformat->wBitsPerSample / 8);
@@ -626,9 +657,20 @@ static int mgmtthrtask_PrepDevice(void *userdata)
     newspec.freq = waveformat->nSamplesPerSec;
 
     streamflags |= AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
-    ret = IAudioClient_Initialize(client, sharemode, streamflags, 0, 0, waveformat, NULL);
-    if (FAILED(ret)) {
-        return WIN_SetErrorFromHRESULT("WASAPI can't initialize audio client", ret);
+
+    UINT32 period_frames = 0;  // if nonzero, the period we negotiated, in sample frames.
+    if (sharemode == AUDCLNT_SHAREMODE_EXCLUSIVE) {
+        // in exclusive event mode, the buffer is exactly one period and the hardware double-buffers it for us.
+        ret = IAudioClient_Initialize(client, sharemode, streamflags, min_period, min_period, waveformat, NULL);
+        if (FAILED(ret)) {
+            return WIN_SetErrorFromHRESULT("WASAPI can't initialize exclusive-mode audio client", ret);
+        }
+    } else if (!device->low_latency || (streamflags & AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM) || !InitializeLowLatencySharedStream(client, waveformat, streamflags, &period_frames)) {
+        device->low_latency = SDL_FALSE;  // we're stuck with the engine's default period.
+        ret = IAudioClient_Initialize(client, sharemode, streamflags, 0, 0, waveformat, NULL);
+        if (FAILED(ret)) {
+            return WIN_SetErrorFromHRESULT("WASAPI can't initialize audio client", ret);
+        }
     }
 
     ret = IAudioClient_SetEventHandle(client, device->hidden->event);
@@ -644,9 +686,22 @@ static int mgmtthrtask_PrepDevice(void *userdata)
 
     /* Match the callback size to the period size to cut down on the number of
        interrupts waited for in each call to WaitDevice */
-    const float period_millis = default_period / 10000.0f;
-    const float period_frames = period_millis * newspec.freq / 1000.0f;
-    const int new_sample_frames = (int) SDL_ceilf(period_frames);
+    int new_sample_frames;
+    if (sharemode == AUDCLNT_SHAREMODE_EXCLUSIVE) {
+        new_sample_frames = (int) bufsize;  // GetBuffer has to hand over the whole buffer every period in exclusive event mode.
+    } else if (period_frames) {
+        new_sample_frames = (int) period_frames;
+    } else {
+        const float period_millis = default_period / 10000.0f;
+        new_sample_frames = (int) SDL_ceilf(period_millis * newspec.freq / 1000.0f);
+    }
+
+    // What we keep queued, plus whatever the engine and driver add on their end.
+    REFERENCE_TIME stream_latency = 0;
+    if (FAILED(IAudioClient_GetStreamLatency(client, &stream_latency))) {
+        stream_latency = 0;
+    }
+    SDL_AtomicSet(&device->latency_frames, new_sample_frames + (int) ((stream_latency * newspec.freq) / 10000000));
 
     // Update the fragment size as size in bytes
     if (SDL_AudioDeviceFormatChangedAlreadyLocked(device, &newspec, new_sample_frames) < 0) {
@@ -774,6 +829,7 @@ static SDL_bool WASAPI_Init(SDL_AudioDriverImpl *impl)
     impl->FreeDeviceHandle = WASAPI_FreeDeviceHandle;
 
     impl->HasCaptureSupport = SDL_TRUE;
+    impl->SupportsExclusiveAccess = SDL_TRUE;
 
     return SDL_TRUE;
 }
@@ -43,6 +43,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <dlfcn.h>
+#include <errno.h>
 
 #define SDL_JAVA_PREFIX                               org_libsdl_app
 #define CONCAT1(prefix, class, function)              CONCAT2(prefix, class, function)
@@ -1968,7 +1969,9 @@ int Android_JNI_FileOpen(SDL_RWops *ctx,
                          const char *fileName, const char *mode)
 {
     AAsset *asset = NULL;
+    off64_t start = 0, length = 0;
     ctx->hidden.androidio.asset = NULL;
+    ctx->hidden.androidio.fd = -1;
 
     if (!asset_manager) {
         Internal_Android_Create_AssetManager();
@@ -1984,6 +1987,10 @@ int Android_JNI_FileOpen(SDL_RWops *ctx,
     }
 
     ctx->hidden.androidio.asset = (void *)asset;
+
+    /* Uncompressed assets can be read at an offset through the package file */
+    ctx->hidden.androidio.fd = AAsset_openFileDescriptor64(asset, &start, &length);
+    ctx->hidden.androidio.start = start;
     return 0;
 }
 
@@ -1998,6 +2005,28 @@ size_t Android_JNI_FileRead(SDL_RWops *ctx, void *buffer, size_t size)
     return (size_t)bytes;
 }
 
+size_t Android_JNI_FileReadAt(SDL_RWops *ctx, void *buffer, size_t size, Sint64 offset)
+{
+    AAsset *asset = (AAsset *)ctx->hidden.androidio.asset;
+    const off64_t length = AAsset_getLength64(asset);
+    ssize_t bytes;
+
+    if (offset >= length) {
+        return 0;
+    }
+    size = (size_t)SDL_min((Uint64)size, (Uint64)(length - offset));
+
+    do {
+        bytes = pread64(ctx->hidden.androidio.fd, buffer, size, ctx->hidden.androidio.start + offset);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0) {
+        SDL_SetError("pread64() failed");
+        return 0;
+    }
+    return (size_t)bytes;
+}
+
 size_t Android_JNI_FileWrite(SDL_RWops *ctx, const void *buffer, size_t size)
 {
     return SDL_SetError("Cannot write to Android package filesystem");
@@ -2022,6 +2051,9 @@ Sint64 Android_JNI_FileSeek(SDL_RWops *ctx, Sint64 offset, int whence)
 int Android_JNI_FileClose(SDL_RWops *ctx)
 {
     AAsset *asset = (AAsset *)ctx->hidden.androidio.asset;
+    if (ctx->hidden.androidio.fd >= 0) {
+        close(ctx->hidden.androidio.fd);
+    }
     AAsset_close(asset);
     return 0;
 }
@@ -70,6 +70,7 @@ int Android_JNI_FileOpen(SDL_RWops *ctx, const char *fileName, const char *mode)
 Sint64 Android_JNI_FileSize(SDL_RWops *ctx);
 Sint64 Android_JNI_FileSeek(SDL_RWops *ctx, Sint64 offset, int whence);
 size_t Android_JNI_FileRead(SDL_RWops *ctx, void *buffer, size_t size);
+size_t Android_JNI_FileReadAt(SDL_RWops *ctx, void *buffer, size_t size, Sint64 offset);
 size_t Android_JNI_FileWrite(SDL_RWops *ctx, const void *buffer, size_t size);
 int Android_JNI_FileClose(SDL_RWops *ctx);
 
@@ -29,6 +29,8 @@ static const char *dbus_library = "libdbus-1.so.3";
 static void *dbus_handle = NULL;
 static char *inhibit_handle = NULL;
 static unsigned int screensaver_cookie = 0;
+static DBusPendingCall *inhibit_pending = NULL;
+static SDL_bool inhibit_wanted = SDL_FALSE;
 static SDL_DBusContext dbus;
 
 static int LoadDBUSSyms(void)
@@ -56,6 +58,7 @@ static int LoadDBUSSyms(void)
     SDL_DBUS_SYM(dbus_bool_t (*)(DBusConnection *, const char *, const DBusObjectPathVTable *, void *, DBusError *), connection_try_register_object_path);
     SDL_DBUS_SYM(dbus_bool_t (*)(DBusConnection *, DBusMessage *, dbus_uint32_t *), connection_send);
     SDL_DBUS_SYM(DBusMessage *(*)(DBusConnection *, DBusMessage *, int, DBusError *), connection_send_with_reply_and_block);
+    SDL_DBUS_SYM(dbus_bool_t (*)(DBusConnection *, DBusMessage *, DBusPendingCall **, int), connection_send_with_reply);
     SDL_DBUS_SYM(void (*)(DBusConnection *), connection_close);
     SDL_DBUS_SYM(void (*)(DBusConnection *), connection_ref);
     SDL_DBUS_SYM(void (*)(DBusConnection *), connection_unref);
@@ -78,6 +81,10 @@ static int LoadDBUSSyms(void)
     SDL_DBUS_SYM(int (*)(DBusMessageIter *), message_iter_get_arg_type);
     SDL_DBUS_SYM(void (*)(DBusMessageIter *, DBusMessageIter *), message_iter_recurse);
     SDL_DBUS_SYM(void (*)(DBusMessage *), message_unref);
+    SDL_DBUS_SYM(dbus_bool_t (*)(DBusPendingCall *, DBusPendingCallNotifyFunction, void *, DBusFreeFunction), pending_call_set_notify);
+    SDL_DBUS_SYM(DBusMessage *(*)(DBusPendingCall *), pending_call_steal_reply);
+    SDL_DBUS_SYM(void (*)(DBusPendingCall *), pending_call_cancel);
+    SDL_DBUS_SYM(void (*)(DBusPendingCall *), pending_call_unref);
     SDL_DBUS_SYM(dbus_bool_t (*)(void), threads_init_default);
     SDL_DBUS_SYM(void (*)(DBusError *), error_init);
     SDL_DBUS_SYM(dbus_bool_t (*)(const DBusError *), error_is_set);
@@ -195,6 +202,9 @@ void SDL_DBus_Quit(void)
     UnloadDBUSLibrary();
     SDL_free(inhibit_handle);
     inhibit_handle = NULL;
+    screensaver_cookie = 0;
+    inhibit_pending = NULL;
+    inhibit_wanted = SDL_FALSE;
 }
 
 SDL_DBusContext *SDL_DBus_GetContext(void)
@@ -206,6 +216,14 @@ SDL_DBusContext *SDL_DBus_GetContext(void)
     return (dbus_handle && dbus.session_conn) ? &dbus : NULL;
 }
 
+/* The bus is connected the first time it's needed, since connecting can be slow */
+static DBusConnection *SDL_DBus_GetSessionConnection(void)
+{
+    SDL_DBusContext *context = SDL_DBus_GetContext();
+
+    return context ? context->session_conn : NULL;
+}
+
 static SDL_bool SDL_DBus_CallMethodInternal(DBusConnection *conn, const char *node, const char *path, const char *interface, const char *method, va_list ap)
 {
     SDL_bool retval = SDL_FALSE;
@@ -264,7 +282,7 @@ SDL_bool SDL_DBus_CallMethod(const char *node, const char *path, const char *int
     SDL_bool retval;
     va_list ap;
     va_start(ap, method);
-    retval = SDL_DBus_CallMethodInternal(dbus.session_conn, node, path, interface, method, ap);
+    retval = SDL_DBus_CallMethodInternal(SDL_DBus_GetSessionConnection(), node, path, interface, method, ap);
     va_end(ap);
     return retval;
 }
@@ -291,25 +309,35 @@ static SDL_bool SDL_DBus_CallVoidMethodInternal(DBusConnection *conn, const char
     return retval;
 }
 
+SDL_bool SDL_DBus_GetBasicReply(DBusMessage *reply, const int expectedtype, void *result)
+{
+    DBusMessageIter iter, actual_iter;
+
+    if (!reply) {
+        return SDL_FALSE;
+    }
+
+    dbus.message_iter_init(reply, &iter);
+    if (dbus.message_iter_get_arg_type(&iter) == DBUS_TYPE_VARIANT) {
+        dbus.message_iter_recurse(&iter, &actual_iter);
+    } else {
+        actual_iter = iter;
+    }
+
+    if (dbus.message_iter_get_arg_type(&actual_iter) == expectedtype) {
+        dbus.message_iter_get_basic(&actual_iter, result);
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
 static SDL_bool SDL_DBus_CallWithBasicReply(DBusConnection *conn, DBusMessage *msg, const int expectedtype, void *result)
 {
     SDL_bool retval = SDL_FALSE;
 
     DBusMessage *reply = dbus.connection_send_with_reply_and_block(conn, msg, 300, NULL);
     if (reply) {
-        DBusMessageIter iter, actual_iter;
-        dbus.message_iter_init(reply, &iter);
-        if (dbus.message_iter_get_arg_type(&iter) == DBUS_TYPE_VARIANT) {
-            dbus.message_iter_recurse(&iter, &actual_iter);
-        } else {
-            actual_iter = iter;
-        }
-
-        if (dbus.message_iter_get_arg_type(&actual_iter) == expectedtype) {
-            dbus.message_iter_get_basic(&actual_iter, result);
-            retval = SDL_TRUE;
-        }
-
+        retval = SDL_DBus_GetBasicReply(reply, expectedtype, result);
         dbus.message_unref(reply);
     }
 
@@ -331,7 +359,7 @@ SDL_bool SDL_DBus_CallVoidMethod(const char *node, const char *path, const char
     SDL_bool retval;
     va_list ap;
     va_start(ap, method);
-    retval = SDL_DBus_CallVoidMethodInternal(dbus.session_conn, node, path, interface, method, ap);
+    retval = SDL_DBus_CallVoidMethodInternal(SDL_DBus_GetSessionConnection(), node, path, interface, method, ap);
     va_end(ap);
     return retval;
 }
@@ -353,9 +381,98 @@ SDL_bool SDL_DBus_QueryPropertyOnConnection(DBusConnection *conn, const char *no
     return retval;
 }
 
+typedef struct SDL_DBusPendingReply
+{
+    SDL_DBusReplyCallback callback;
+    void *userdata;
+} SDL_DBusPendingReply;
+
+static void SDL_DBus_PendingCallNotify(DBusPendingCall *pending, void *data)
+{
+    SDL_DBusPendingReply *pending_reply = (SDL_DBusPendingReply *)data;
+    DBusMessage *reply = dbus.pending_call_steal_reply(pending);
+
+    pending_reply->callback(reply, pending_reply->userdata);
+
+    if (reply) {
+        dbus.message_unref(reply);
+    }
+}
+
+static void SDL_DBus_FreePendingReply(void *data)
+{
+    SDL_free(data);
+}
+
+DBusPendingCall *SDL_DBus_SendWithReplyAsync(DBusConnection *conn, DBusMessage *msg, SDL_DBusReplyCallback callback, void *userdata)
+{
+    DBusPendingCall *pending = NULL;
+    SDL_DBusPendingReply *pending_reply;
+
+    if (!conn) {
+        return NULL;
+    }
+
+    pending_reply = (SDL_DBusPendingReply *)SDL_malloc(sizeof(*pending_reply));
+    if (!pending_reply) {
+        return NULL;
+    }
+    pending_reply->callback = callback;
+    pending_reply->userdata = userdata;
+
+    if (!dbus.connection_send_with_reply(conn, msg, &pending, DBUS_TIMEOUT_USE_DEFAULT) || !pending) {
+        /* pending is NULL if the connection was lost */
+        SDL_free(pending_reply);
+        return NULL;
+    }
+
+    if (!dbus.pending_call_set_notify(pending, SDL_DBus_PendingCallNotify, pending_reply, SDL_DBus_FreePendingReply)) {
+        dbus.pending_call_cancel(pending);
+        dbus.pending_call_unref(pending);
+        SDL_free(pending_reply);
+        return NULL;
+    }
+
+    /* The connection keeps the call alive until the reply is dispatched or it's cancelled */
+    dbus.pending_call_unref(pending);
+    dbus.connection_flush(conn);
+
+    return pending;
+}
+
+DBusPendingCall *SDL_DBus_CallMethodAsync(SDL_DBusReplyCallback callback, void *userdata, const char *node, const char *path, const char *interface, const char *method, ...)
+{
+    DBusPendingCall *pending = NULL;
+    DBusConnection *conn = SDL_DBus_GetSessionConnection();
+
+    if (conn) {
+        DBusMessage *msg = dbus.message_new_method_call(node, path, interface, method);
+        if (msg) {
+            int firstarg;
+            va_list ap;
+            va_start(ap, method);
+            firstarg = va_arg(ap, int);
+            if ((firstarg == DBUS_TYPE_INVALID) || dbus.message_append_args_valist(msg, firstarg, ap)) {
+                pending = SDL_DBus_SendWithReplyAsync(conn, msg, callback, userdata);
+            }
+            va_end(ap);
+            dbus.message_unref(msg);
+        }
+    }
+
+    return pending;
+}
+
+void SDL_DBus_CancelCall(DBusPendingCall *pending)
+{
+    if (pending) {
+        dbus.pending_call_cancel(pending);
+    }
+}
+
 SDL_bool SDL_DBus_QueryProperty(const char *node, const char *path, const char *interface, const char *property, const int expectedtype, void *result)
 {
-    return SDL_DBus_QueryPropertyOnConnection(dbus.session_conn, node, path, interface, property, expectedtype, result);
+    return SDL_DBus_QueryPropertyOnConnection(SDL_DBus_GetSessionConnection(), node, path, interface, property, expectedtype, result);
 }
 
 void SDL_DBus_ScreensaverTickle(void)
@@ -424,15 +541,52 @@ static SDL_bool SDL_DBus_AppendDictWithKeyValue(DBusMessageIter *iterInit, const
    return SDL_DBus_AppendDictWithKeysAndValues(iterInit, keys, values, 1);
 }
 
+static void SDL_DBus_FinishScreensaverInhibit(void)
+{
+    inhibit_pending = NULL;
+
+    /* The screensaver was allowed again while we were waiting */
+    if (!inhibit_wanted) {
+        SDL_DBus_ScreensaverInhibit(SDL_FALSE);
+    }
+}
+
+static void SDL_DBus_PortalInhibitReply(DBusMessage *reply, void *userdata)
+{
+    const char *handle = NULL;
+
+    if (SDL_DBus_GetBasicReply(reply, DBUS_TYPE_OBJECT_PATH, &handle)) {
+        inhibit_handle = SDL_strdup(handle);
+    }
+    SDL_DBus_FinishScreensaverInhibit();
+}
+
+static void SDL_DBus_ScreensaverInhibitReply(DBusMessage *reply, void *userdata)
+{
+    Uint32 cookie = 0;
+
+    if (SDL_DBus_GetBasicReply(reply, DBUS_TYPE_UINT32, &cookie)) {
+        screensaver_cookie = cookie;
+    }
+    SDL_DBus_FinishScreensaverInhibit();
+}
+
 SDL_bool SDL_DBus_ScreensaverInhibit(SDL_bool inhibit)
 {
     const char *default_inhibit_reason = "Playing a game";
 
+    inhibit_wanted = inhibit;
+
+    if (inhibit_pending) {
+        /* This will be sorted out when the reply to the Inhibit call arrives */
+        return SDL_TRUE;
+    }
+
     if ((inhibit && (screensaver_cookie != 0 || inhibit_handle)) || (!inhibit && (screensaver_cookie == 0 && !inhibit_handle))) {
         return SDL_TRUE;
     }
 
-    if (!dbus.session_conn) {
+    if (!SDL_DBus_GetSessionConnection()) {
         /* We either lost connection to the session bus or were not able to
          * load the D-Bus library at all. */
         return SDL_FALSE;
@@ -448,9 +602,7 @@ SDL_bool SDL_DBus_ScreensaverInhibit(SDL_bool inhibit)
 
         if (inhibit) {
             DBusMessage *msg;
-            SDL_bool retval = SDL_FALSE;
             const char *key = "reason";
-            const char *reply = NULL;
             const char *reason = SDL_GetHint(SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME);
             if (!reason || !reason[0]) {
                 reason = default_inhibit_reason;
@@ -474,13 +626,11 @@ SDL_bool SDL_DBus_ScreensaverInhibit(SDL_bool inhibit)
                 return SDL_FALSE;
             }
 
-            if (SDL_DBus_CallWithBasicReply(dbus.session_conn, msg, DBUS_TYPE_OBJECT_PATH, &reply)) {
-                inhibit_handle = SDL_strdup(reply);
-                retval = SDL_TRUE;
-            }
+            /* Don't wait for the portal, the handle is filled in when the reply arrives */
+            inhibit_pending = SDL_DBus_SendWithReplyAsync(dbus.session_conn, msg, SDL_DBus_PortalInhibitReply, NULL);
 
             dbus.message_unref(msg);
-            return retval;
+            return (inhibit_pending != NULL);
         } else {
             if (!SDL_DBus_CallVoidMethod(bus_name, inhibit_handle, "org.freedesktop.portal.Request", "Close", DBUS_TYPE_INVALID)) {
                 return SDL_FALSE;
@@ -503,12 +653,10 @@ SDL_bool SDL_DBus_ScreensaverInhibit(SDL_bool inhibit)
                 reason = default_inhibit_reason;
             }
 
-            if (!SDL_DBus_CallMethod(bus_name, path, interface, "Inhibit",
-                                     DBUS_TYPE_STRING, &app, DBUS_TYPE_STRING, &reason, DBUS_TYPE_INVALID,
-                                     DBUS_TYPE_UINT32, &screensaver_cookie, DBUS_TYPE_INVALID)) {
-                return SDL_FALSE;
-            }
-            return (screensaver_cookie != 0);
+            /* Don't wait for the screensaver, the cookie is filled in when the reply arrives */
+            inhibit_pending = SDL_DBus_CallMethodAsync(SDL_DBus_ScreensaverInhibitReply, NULL, bus_name, path, interface, "Inhibit",
+                                                       DBUS_TYPE_STRING, &app, DBUS_TYPE_STRING, &reason, DBUS_TYPE_INVALID);
+            return (inhibit_pending != NULL);
         } else {
             if (!SDL_DBus_CallVoidMethod(bus_name, path, interface, "UnInhibit", DBUS_TYPE_UINT32, &screensaver_cookie, DBUS_TYPE_INVALID)) {
                 return SDL_FALSE;
@@ -540,6 +688,11 @@ char *SDL_DBus_GetLocalMachineId(void)
     DBusError err;
     char *result;
 
+    if (!SDL_DBus_GetContext()) {
+        SDL_SetError("D-Bus isn't available");
+        return NULL;
+    }
+
     dbus.error_init(&err);
 
     if (dbus.try_get_local_machine_id) {
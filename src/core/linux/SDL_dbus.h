@@ -48,6 +48,7 @@ typedef struct SDL_DBusContext
                                                        const DBusObjectPathVTable *, void *, DBusError *);
     dbus_bool_t (*connection_send)(DBusConnection *, DBusMessage *, dbus_uint32_t *);
     DBusMessage *(*connection_send_with_reply_and_block)(DBusConnection *, DBusMessage *, int, DBusError *);
+    dbus_bool_t (*connection_send_with_reply)(DBusConnection *, DBusMessage *, DBusPendingCall **, int);
     void (*connection_close)(DBusConnection *);
     void (*connection_ref)(DBusConnection *);
     void (*connection_unref)(DBusConnection *);
@@ -70,6 +71,10 @@ typedef struct SDL_DBusContext
     int (*message_iter_get_arg_type)(DBusMessageIter *);
     void (*message_iter_recurse)(DBusMessageIter *, DBusMessageIter *);
     void (*message_unref)(DBusMessage *);
+    dbus_bool_t (*pending_call_set_notify)(DBusPendingCall *, DBusPendingCallNotifyFunction, void *, DBusFreeFunction);
+    DBusMessage *(*pending_call_steal_reply)(DBusPendingCall *);
+    void (*pending_call_cancel)(DBusPendingCall *);
+    void (*pending_call_unref)(DBusPendingCall *);
     dbus_bool_t (*threads_init_default)(void);
     void (*error_init)(DBusError *);
     dbus_bool_t (*error_is_set)(const DBusError *);
@@ -82,6 +87,10 @@ typedef struct SDL_DBusContext
 
 } SDL_DBusContext;
 
+/* Called from SDL_DBus_PumpEvents() when the reply to an asynchronous call arrives.
+   The reply may be an error, or NULL if the call couldn't be completed. */
+typedef void (*SDL_DBusReplyCallback)(DBusMessage *reply, void *userdata);
+
 extern void SDL_DBus_Init(void);
 extern void SDL_DBus_Quit(void);
 extern SDL_DBusContext *SDL_DBus_GetContext(void);
@@ -96,6 +105,13 @@ extern SDL_bool SDL_DBus_CallMethodOnConnection(DBusConnection *conn, const char
 extern SDL_bool SDL_DBus_CallVoidMethodOnConnection(DBusConnection *conn, const char *node, const char *path, const char *interface, const char *method, ...);
 extern SDL_bool SDL_DBus_QueryPropertyOnConnection(DBusConnection *conn, const char *node, const char *path, const char *interface, const char *property, const int expectedtype, void *result);
 
+/* These don't wait for the reply, the callback is invoked when it's dispatched.
+   The returned call can be passed to SDL_DBus_CancelCall() until the callback runs. */
+extern DBusPendingCall *SDL_DBus_SendWithReplyAsync(DBusConnection *conn, DBusMessage *msg, SDL_DBusReplyCallback callback, void *userdata);
+extern DBusPendingCall *SDL_DBus_CallMethodAsync(SDL_DBusReplyCallback callback, void *userdata, const char *node, const char *path, const char *interface, const char *method, ...);
+extern void SDL_DBus_CancelCall(DBusPendingCall *pending);
+extern SDL_bool SDL_DBus_GetBasicReply(DBusMessage *reply, const int expectedtype, void *result);
+
 extern void SDL_DBus_ScreensaverTickle(void);
 extern SDL_bool SDL_DBus_ScreensaverInhibit(SDL_bool inhibit);
 
@@ -44,6 +44,7 @@ typedef struct FcitxClient
     SDL_DBusContext *dbus;
 
     char *ic_path;
+    DBusPendingCall *ic_pending; /* CreateInputContext call that hasn't been answered yet */
 
     int id;
 
@@ -255,15 +256,44 @@ static void SDLCALL Fcitx_SetCapabilities(void *data,
     SDL_DBus_CallVoidMethod(FCITX_DBUS_SERVICE, client->ic_path, FCITX_IC_DBUS_INTERFACE, "SetCapability", DBUS_TYPE_UINT64, &caps, DBUS_TYPE_INVALID);
 }
 
-static SDL_bool FcitxCreateInputContext(SDL_DBusContext *dbus, const char *appname, char **ic_path)
+static void FcitxCreateInputContextReply(DBusMessage *reply, void *userdata)
 {
+    FcitxClient *client = (FcitxClient *)userdata;
+    SDL_DBusContext *dbus = client->dbus;
+    char *ic_path = NULL;
+
+    client->ic_pending = NULL;
+
+    if (!reply || !dbus->message_get_args(reply, NULL, DBUS_TYPE_OBJECT_PATH, &ic_path, DBUS_TYPE_INVALID)) {
+        return;
+    }
+
+    SDL_free(client->ic_path);
+    client->ic_path = SDL_strdup(ic_path);
+
+    dbus->bus_add_match(dbus->session_conn,
+                        "type='signal', interface='org.fcitx.Fcitx.InputContext1'",
+                        NULL);
+    dbus->connection_add_filter(dbus->session_conn,
+                                &DBus_MessageFilter, dbus,
+                                NULL);
+    dbus->connection_flush(dbus->session_conn);
+
+    SDL_AddHintCallback(SDL_HINT_IME_INTERNAL_EDITING, Fcitx_SetCapabilities, client);
+
+    /* Catch up with anything that happened while the context was being created */
+    SDL_Fcitx_SetFocus(SDL_GetKeyboardFocus() != NULL);
+    SDL_Fcitx_UpdateTextRect(NULL);
+}
+
+static SDL_bool FcitxCreateInputContext(FcitxClient *client, const char *appname)
+{
+    SDL_DBusContext *dbus = client->dbus;
     const char *program = "program";
-    SDL_bool retval = SDL_FALSE;
 
     if (dbus && dbus->session_conn) {
         DBusMessage *msg = dbus->message_new_method_call(FCITX_DBUS_SERVICE, FCITX_IM_DBUS_PATH, FCITX_IM_DBUS_INTERFACE, "CreateInputContext");
         if (msg) {
-            DBusMessage *reply = NULL;
             DBusMessageIter args, array, sub;
             dbus->message_iter_init_append(msg, &args);
             dbus->message_iter_open_container(&args, DBUS_TYPE_ARRAY, "(ss)", &array);
@@ -272,49 +302,25 @@ static SDL_bool FcitxCreateInputContext(SDL_DBusContext *dbus, const char *appna
             dbus->message_iter_append_basic(&sub, DBUS_TYPE_STRING, &appname);
             dbus->message_iter_close_container(&array, &sub);
             dbus->message_iter_close_container(&args, &array);
-            reply = dbus->connection_send_with_reply_and_block(dbus->session_conn, msg, 300, NULL);
-            if (reply) {
-                if (dbus->message_get_args(reply, NULL, DBUS_TYPE_OBJECT_PATH, ic_path, DBUS_TYPE_INVALID)) {
-                    retval = SDL_TRUE;
-                }
-                dbus->message_unref(reply);
-            }
+            /* Don't wait for fcitx to answer, the context is set up when the reply arrives */
+            client->ic_pending = SDL_DBus_SendWithReplyAsync(dbus->session_conn, msg, FcitxCreateInputContextReply, client);
             dbus->message_unref(msg);
         }
     }
-    return retval;
+    return (client->ic_pending != NULL);
 }
 
 static SDL_bool FcitxClientCreateIC(FcitxClient *client)
 {
     char *appname = GetAppName();
-    char *ic_path = NULL;
-    SDL_DBusContext *dbus = client->dbus;
+    SDL_bool retval;
 
     /* SDL_DBus_CallMethod cannot handle a(ss) type, call dbus function directly */
-    if (!FcitxCreateInputContext(dbus, appname, &ic_path)) {
-        ic_path = NULL; /* just in case. */
-    }
+    retval = FcitxCreateInputContext(client, appname);
 
     SDL_free(appname);
 
-    if (ic_path) {
-        SDL_free(client->ic_path);
-        client->ic_path = SDL_strdup(ic_path);
-
-        dbus->bus_add_match(dbus->session_conn,
-                            "type='signal', interface='org.fcitx.Fcitx.InputContext1'",
-                            NULL);
-        dbus->connection_add_filter(dbus->session_conn,
-                                    &DBus_MessageFilter, dbus,
-                                    NULL);
-        dbus->connection_flush(dbus->session_conn);
-
-        SDL_AddHintCallback(SDL_HINT_IME_INTERNAL_EDITING, Fcitx_SetCapabilities, client);
-        return SDL_TRUE;
-    }
-
-    return SDL_FALSE;
+    return retval;
 }
 
 static Uint32 Fcitx_ModState(void)
@@ -364,6 +370,11 @@ SDL_bool SDL_Fcitx_Init(void)
 
 void SDL_Fcitx_Quit(void)
 {
+    if (fcitx_client.ic_pending) {
+        SDL_DBus_CancelCall(fcitx_client.ic_pending);
+        fcitx_client.ic_pending = NULL;
+    }
+
     FcitxClientICCallMethod(&fcitx_client, "DestroyIC");
     if (fcitx_client.ic_path) {
         SDL_free(fcitx_client.ic_path);
@@ -418,6 +429,10 @@ void SDL_Fcitx_UpdateTextRect(const SDL_Rect *rect)
         SDL_copyp(cursor, rect);
     }
 
+    if (!fcitx_client.ic_path) {
+        return;
+    }
+
     focused_win = SDL_GetKeyboardFocus();
     if (!focused_win) {
         return;
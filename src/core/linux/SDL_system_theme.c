@@ -106,6 +106,23 @@ not_our_signal:
     return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 }
 
+static void DBus_ReadReply(DBusMessage *reply, void *userdata) {
+    SDL_DBusContext *dbus = system_theme_data.dbus;
+    DBusMessageIter reply_iter, variant_outer_iter;
+
+    if (!reply)
+        return;
+    dbus->message_iter_init(reply, &reply_iter);
+    /* The response has signature <<u>>, anything else is an error reply */
+    if (dbus->message_iter_get_arg_type(&reply_iter) != DBUS_TYPE_VARIANT)
+        return;
+    dbus->message_iter_recurse(&reply_iter, &variant_outer_iter);
+    if (!DBus_ExtractThemeVariant(&variant_outer_iter, &system_theme_data.theme))
+        return;
+
+    SDL_SetSystemTheme(system_theme_data.theme);
+}
+
 SDL_bool SDL_SystemTheme_Init(void)
 {
     SDL_DBusContext *dbus = SDL_DBus_GetContext();
@@ -119,23 +136,13 @@ SDL_bool SDL_SystemTheme_Init(void)
         return SDL_FALSE;
     }
 
+    /* Don't wait for the portal here, it can take a long time to start.
+       The theme is unknown until the reply is dispatched from the event loop,
+       at which point a theme changed event is sent. */
     msg = dbus->message_new_method_call(PORTAL_DESTINATION, PORTAL_PATH, PORTAL_INTERFACE, PORTAL_METHOD);
     if (msg) {
         if (dbus->message_append_args(msg, DBUS_TYPE_STRING, &namespace, DBUS_TYPE_STRING, &key, DBUS_TYPE_INVALID)) {
-            DBusMessage *reply = dbus->connection_send_with_reply_and_block(dbus->session_conn, msg, 300, NULL);
-            if (reply) {
-                DBusMessageIter reply_iter, variant_outer_iter;
-
-                dbus->message_iter_init(reply, &reply_iter);
-                /* The response has signature <<u>> */
-                if (dbus->message_iter_get_arg_type(&reply_iter) != DBUS_TYPE_VARIANT)
-                    goto incorrect_type;
-                dbus->message_iter_recurse(&reply_iter, &variant_outer_iter);
-                if (!DBus_ExtractThemeVariant(&variant_outer_iter, &system_theme_data.theme))
-                    goto incorrect_type;
-incorrect_type:
-                dbus->message_unref(reply);
-            }
+            SDL_DBus_SendWithReplyAsync(dbus->session_conn, msg, DBus_ReadReply, NULL);
         }
         dbus->message_unref(msg);
     }
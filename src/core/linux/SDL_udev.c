@@ -105,6 +105,14 @@ static SDL_bool SDL_UDEV_hotplug_update_available(void)
     return SDL_FALSE;
 }
 
+int SDL_UDEV_GetMonitorFD(void)
+{
+    if (!_this || !_this->udev_mon) {
+        return -1;
+    }
+    return _this->syms.udev_monitor_get_fd(_this->udev_mon);
+}
+
 int SDL_UDEV_Init(void)
 {
     int retval = 0;
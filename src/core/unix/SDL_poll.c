@@ -22,6 +22,9 @@
 #include "SDL_internal.h"
 
 #include "SDL_poll.h"
+#ifndef SDL_EVENTS_DISABLED
+#include "../../events/SDL_events_c.h"
+#endif
 
 #ifdef HAVE_POLL
 #include <poll.h>
@@ -93,3 +96,52 @@ int SDL_IOReady(int fd, int flags, Sint64 timeoutNS)
 
     return result;
 }
+
+int SDL_IOReadyWakeup(int fd, int flags, Sint64 timeoutNS)
+{
+#if defined(HAVE_POLL) && !defined(SDL_EVENTS_DISABLED)
+    struct pollfd info[1 + SDL_MAX_EVENT_WAKEUP_FDS];
+    int wakeup_fds[SDL_MAX_EVENT_WAKEUP_FDS];
+    int i, num_wakeup_fds, timeoutMS, result;
+
+    num_wakeup_fds = SDL_GetEventWakeupFDs(wakeup_fds, SDL_arraysize(wakeup_fds));
+    if (num_wakeup_fds == 0) {
+        return SDL_IOReady(fd, flags, timeoutNS);
+    }
+
+    SDL_assert(flags & (SDL_IOR_READ | SDL_IOR_WRITE));
+
+    info[0].fd = fd;
+    info[0].events = 0;
+    if (flags & SDL_IOR_READ) {
+        info[0].events |= POLLIN | POLLPRI;
+    }
+    if (flags & SDL_IOR_WRITE) {
+        info[0].events |= POLLOUT;
+    }
+    for (i = 0; i < num_wakeup_fds; ++i) {
+        info[1 + i].fd = wakeup_fds[i];
+        info[1 + i].events = POLLIN | POLLPRI;
+    }
+
+    if (timeoutNS > 0) {
+        timeoutMS = (int)SDL_NS_TO_MS(timeoutNS);
+    } else if (timeoutNS == 0) {
+        timeoutMS = 0;
+    } else {
+        timeoutMS = -1;
+    }
+
+    /* Note: We don't bother to account for elapsed time if we get EINTR */
+    do {
+        result = poll(info, 1 + num_wakeup_fds, timeoutMS);
+    } while (result < 0 && errno == EINTR && !(flags & SDL_IOR_NO_RETRY));
+
+    if (result > 0) {
+        result = info[0].revents ? 1 : 2;
+    }
+    return result;
+#else
+    return SDL_IOReady(fd, flags, timeoutNS);
+#endif
+}
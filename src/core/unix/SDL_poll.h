@@ -30,4 +30,9 @@
 
 extern int SDL_IOReady(int fd, int flags, Sint64 timeoutNS);
 
+/* Like SDL_IOReady(), but also wakes up when an event wakeup file descriptor is readable.
+   Returns 1 if `fd` is ready, and 2 if only a wakeup file descriptor is.
+ */
+extern int SDL_IOReadyWakeup(int fd, int flags, Sint64 timeoutNS);
+
 #endif /* SDL_poll_h_ */
@@ -19,6 +19,7 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 #include "SDL_internal.h"
+#include "SDL_cpuinfo_c.h"
 
 #if defined(__WIN32__) || defined(__WINRT__) || defined(__GDK__)
 #include "../core/windows/SDL_windows.h"
@@ -70,6 +71,11 @@
 #include <cpu-features.h>
 #endif
 
+#if defined(__LINUX__) || defined(__ANDROID__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #if defined(HAVE_GETAUXVAL) || defined(HAVE_ELF_AUX_INFO)
 #include <sys/auxv.h>
 #endif
@@ -101,6 +107,7 @@
 #define CPU_HAS_ARM_SIMD (1 << 11)
 #define CPU_HAS_LSX      (1 << 12)
 #define CPU_HAS_LASX     (1 << 13)
+#define CPU_HAS_PCLMUL   (1 << 14)
 
 #define CPU_CFG2      0x2
 #define CPU_CFG2_LSX  (1 << 6)
@@ -555,6 +562,11 @@ static int CPU_readCPUCFG(void)
 #else
 #define CPU_haveAVX() (0)
 #endif
+#ifdef __PCLMUL__
+#define CPU_havePCLMUL() (1)
+#else
+#define CPU_havePCLMUL() (0)
+#endif
 #else
 #define CPU_haveMMX()   (CPU_CPUIDFeatures[3] & 0x00800000)
 #define CPU_haveSSE()   (CPU_CPUIDFeatures[3] & 0x02000000)
@@ -563,6 +575,7 @@ static int CPU_readCPUCFG(void)
 #define CPU_haveSSE41() (CPU_CPUIDFeatures[2] & 0x00080000)
 #define CPU_haveSSE42() (CPU_CPUIDFeatures[2] & 0x00100000)
 #define CPU_haveAVX()   (CPU_OSSavesYMM && (CPU_CPUIDFeatures[2] & 0x10000000))
+#define CPU_havePCLMUL() (CPU_CPUIDFeatures[2] & 0x00000002)
 #endif
 
 #ifdef __e2k__
@@ -646,6 +659,367 @@ int SDL_GetCPUCount(void)
     return SDL_CPUCount;
 }
 
+/* Return the index of a key in a list, adding it if it's not there yet */
+static int CPU_getTopologyIndex(int *keys, int *num_keys, int key)
+{
+    int i;
+
+    for (i = 0; i < *num_keys; ++i) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    keys[i] = key;
+    ++*num_keys;
+    return i;
+}
+
+/* Turn raw performance values into classes, numbered from 0 for the slowest cores */
+static void CPU_rankPerformanceClasses(SDL_CPUCoreInfo *cores, int count)
+{
+    int *values = (int *)SDL_malloc(count * sizeof(*values));
+    int i, j;
+
+    if (!values) {
+        for (i = 0; i < count; ++i) {
+            cores[i].performance_class = 0;
+        }
+        return;
+    }
+
+    for (i = 0; i < count; ++i) {
+        values[i] = cores[i].performance_class;
+    }
+    for (i = 0; i < count; ++i) {
+        int rank = 0;
+        for (j = 0; j < count; ++j) {
+            int k;
+            /* Count each distinct slower value once */
+            if (values[j] < values[i]) {
+                for (k = 0; k < j; ++k) {
+                    if (values[k] == values[j]) {
+                        break;
+                    }
+                }
+                if (k == j) {
+                    ++rank;
+                }
+            }
+        }
+        cores[i].performance_class = rank;
+    }
+    SDL_free(values);
+}
+
+#if defined(__LINUX__) || defined(__ANDROID__)
+static SDL_bool CPU_readSysfs(const char *path, char *buf, size_t buflen)
+{
+    ssize_t len;
+    int fd;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SDL_FALSE;
+    }
+    len = read(fd, buf, buflen - 1);
+    close(fd);
+    if (len <= 0) {
+        return SDL_FALSE;
+    }
+    buf[len] = '\0';
+    return SDL_TRUE;
+}
+
+static int CPU_readSysfsInt(const char *path, int default_value)
+{
+    char buf[32];
+
+    if (!CPU_readSysfs(path, buf, sizeof(buf))) {
+        return default_value;
+    }
+    return SDL_atoi(buf);
+}
+
+/* Walk a CPU list like "0-3,8,10-11", returning the highest CPU, or -1 if the list is invalid.
+   If cpu is in the list, *found is set to SDL_TRUE. */
+static int CPU_parseCPUList(const char *list, int cpu, SDL_bool *found)
+{
+    int highest = -1;
+
+    while (*list) {
+        char *end;
+        long first, last;
+
+        first = SDL_strtol(list, &end, 10);
+        if (end == list) {
+            break;
+        }
+        last = first;
+        if (*end == '-') {
+            list = end + 1;
+            last = SDL_strtol(list, &end, 10);
+            if (end == list) {
+                break;
+            }
+        }
+        if (found && cpu >= first && cpu <= last) {
+            *found = SDL_TRUE;
+        }
+        highest = SDL_max(highest, (int)last);
+
+        list = end;
+        if (*list != ',') {
+            break;
+        }
+        ++list;
+    }
+    return highest;
+}
+
+static SDL_CPUCoreInfo *CPU_getLinuxTopology(int *count)
+{
+    char path[128];
+    char online[256], atom[256];
+    SDL_bool have_atom;
+    SDL_CPUCoreInfo *cores;
+    int *core_keys, *cache_keys;
+    int num_core_keys = 0, num_cache_keys = 0;
+    int cpu, highest, num_cores = 0;
+
+    if (!CPU_readSysfs("/sys/devices/system/cpu/online", online, sizeof(online))) {
+        return NULL;
+    }
+    highest = CPU_parseCPUList(online, -1, NULL);
+    if (highest < 0) {
+        return NULL;
+    }
+
+    /* Intel hybrid CPUs list their efficiency cores here */
+    have_atom = CPU_readSysfs("/sys/devices/cpu_atom/cpus", atom, sizeof(atom));
+
+    cores = (SDL_CPUCoreInfo *)SDL_calloc(highest + 1, sizeof(*cores));
+    core_keys = (int *)SDL_calloc(highest + 1, sizeof(*core_keys));
+    cache_keys = (int *)SDL_calloc(highest + 1, sizeof(*cache_keys));
+    if (!cores || !core_keys || !cache_keys) {
+        SDL_free(cores);
+        SDL_free(core_keys);
+        SDL_free(cache_keys);
+        return NULL;
+    }
+
+    for (cpu = 0; cpu <= highest; ++cpu) {
+        SDL_CPUCoreInfo *core;
+        SDL_bool is_online = SDL_FALSE;
+        int package, core_id, index, cache_level = 0, cache_key = cpu;
+
+        CPU_parseCPUList(online, cpu, &is_online);
+        if (!is_online) {
+            continue;
+        }
+        core = &cores[num_cores++];
+        core->cpu = cpu;
+
+        (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        package = CPU_readSysfsInt(path, 0);
+        (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        core_id = CPU_readSysfsInt(path, cpu);
+        core->core = CPU_getTopologyIndex(core_keys, &num_core_keys, (package << 16) | (core_id & 0xFFFF));
+
+        /* The cache group is the first CPU sharing the last level cache */
+        for (index = 0; index < 10; ++index) {
+            char shared[256];
+            int level;
+
+            (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+            level = CPU_readSysfsInt(path, -1);
+            if (level < 0) {
+                break;
+            }
+            (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+            if (level >= cache_level && CPU_readSysfs(path, shared, sizeof(shared))) {
+                cache_level = level;
+                cache_key = SDL_atoi(shared);
+            }
+        }
+        core->cache_group = CPU_getTopologyIndex(cache_keys, &num_cache_keys, cache_key);
+
+        /* ARM big.LITTLE reports the relative capacity of each core */
+        (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+        core->performance_class = CPU_readSysfsInt(path, -1);
+        if (core->performance_class < 0) {
+            SDL_bool is_atom = SDL_FALSE;
+            if (have_atom) {
+                CPU_parseCPUList(atom, cpu, &is_atom);
+            }
+            core->performance_class = is_atom ? 0 : 1;
+        }
+    }
+    SDL_free(core_keys);
+    SDL_free(cache_keys);
+
+    if (num_cores == 0) {
+        SDL_free(cores);
+        return NULL;
+    }
+    CPU_rankPerformanceClasses(cores, num_cores);
+    *count = num_cores;
+    return cores;
+}
+#endif /* __LINUX__ || __ANDROID__ */
+
+#if defined(__WIN32__) || defined(__GDK__)
+typedef BOOL(WINAPI *pfnGetLogicalProcessorInformationEx)(LOGICAL_PROCESSOR_RELATIONSHIP, PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX, PDWORD);
+
+static SDL_CPUCoreInfo *CPU_getWindowsTopology(int *count)
+{
+    pfnGetLogicalProcessorInformationEx pGetLogicalProcessorInformationEx;
+    HMODULE kernel32;
+    DWORD length = 0, offset;
+    BYTE *buffer;
+    SDL_CPUCoreInfo *cores;
+    int *cache_keys;
+    int num_cache_keys = 0, num_cores = 0, num_physical = 0;
+    BYTE cache_level = 0;
+
+    kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+    if (!kernel32) {
+        return NULL;
+    }
+    pGetLogicalProcessorInformationEx = (pfnGetLogicalProcessorInformationEx)GetProcAddress(kernel32, "GetLogicalProcessorInformationEx");
+    if (!pGetLogicalProcessorInformationEx) {
+        return NULL;
+    }
+
+    pGetLogicalProcessorInformationEx(RelationAll, NULL, &length);
+    if (length == 0) {
+        return NULL;
+    }
+    buffer = (BYTE *)SDL_malloc(length);
+    if (!buffer) {
+        return NULL;
+    }
+    if (!pGetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &length)) {
+        SDL_free(buffer);
+        return NULL;
+    }
+
+    /* Count the logical processors and find the last level of cache */
+    for (offset = 0; offset < length;) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        if (info->Relationship == RelationProcessorCore) {
+            WORD group;
+            for (group = 0; group < info->Processor.GroupCount; ++group) {
+                KAFFINITY mask = info->Processor.GroupMask[group].Mask;
+                for (; mask; mask &= (mask - 1)) {
+                    ++num_cores;
+                }
+            }
+        } else if (info->Relationship == RelationCache) {
+            cache_level = SDL_max(cache_level, info->Cache.Level);
+        }
+        offset += info->Size;
+    }
+
+    cores = (SDL_CPUCoreInfo *)SDL_calloc(num_cores, sizeof(*cores));
+    cache_keys = (int *)SDL_calloc(num_cores, sizeof(*cache_keys));
+    if (!cores || !cache_keys) {
+        SDL_free(cores);
+        SDL_free(cache_keys);
+        SDL_free(buffer);
+        return NULL;
+    }
+
+    num_cores = 0;
+    for (offset = 0; offset < length;) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        if (info->Relationship == RelationProcessorCore) {
+            /* EfficiencyClass follows Flags, but older SDKs call it Reserved */
+            const int efficiency = ((const BYTE *)&info->Processor.Flags)[1];
+            WORD group;
+            for (group = 0; group < info->Processor.GroupCount; ++group) {
+                const GROUP_AFFINITY *affinity = &info->Processor.GroupMask[group];
+                int bit;
+                for (bit = 0; bit < (int)(sizeof(KAFFINITY) * 8); ++bit) {
+                    if (affinity->Mask & ((KAFFINITY)1 << bit)) {
+                        SDL_CPUCoreInfo *core = &cores[num_cores++];
+                        core->cpu = affinity->Group * 64 + bit;
+                        core->core = num_physical;
+                        core->performance_class = efficiency;
+                    }
+                }
+            }
+            ++num_physical;
+        }
+        offset += info->Size;
+    }
+
+    for (offset = 0; offset < length;) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        if (info->Relationship == RelationCache && info->Cache.Level == cache_level) {
+            const GROUP_AFFINITY *affinity = &info->Cache.GroupMask;
+            int i, cache_group = -1;
+            for (i = 0; i < num_cores; ++i) {
+                const int bit = cores[i].cpu - affinity->Group * 64;
+                if (bit >= 0 && bit < (int)(sizeof(KAFFINITY) * 8) && (affinity->Mask & ((KAFFINITY)1 << bit))) {
+                    if (cache_group < 0) {
+                        cache_group = CPU_getTopologyIndex(cache_keys, &num_cache_keys, cores[i].cpu);
+                    }
+                    cores[i].cache_group = cache_group;
+                }
+            }
+        }
+        offset += info->Size;
+    }
+    SDL_free(cache_keys);
+    SDL_free(buffer);
+
+    if (num_cores == 0) {
+        SDL_free(cores);
+        return NULL;
+    }
+    CPU_rankPerformanceClasses(cores, num_cores);
+    *count = num_cores;
+    return cores;
+}
+#endif /* __WIN32__ || __GDK__ */
+
+SDL_CPUCoreInfo *SDL_GetCPUTopology(int *count)
+{
+    SDL_CPUCoreInfo *cores = NULL;
+    int num_cores = 0;
+
+#ifndef SDL_CPUINFO_DISABLED
+#if defined(__LINUX__) || defined(__ANDROID__)
+    cores = CPU_getLinuxTopology(&num_cores);
+#elif defined(__WIN32__) || defined(__GDK__)
+    cores = CPU_getWindowsTopology(&num_cores);
+#endif
+#endif
+
+    if (!cores) {
+        int i;
+
+        num_cores = SDL_GetCPUCount();
+        cores = (SDL_CPUCoreInfo *)SDL_calloc(num_cores, sizeof(*cores));
+        if (!cores) {
+            SDL_OutOfMemory();
+            if (count) {
+                *count = 0;
+            }
+            return NULL;
+        }
+        for (i = 0; i < num_cores; ++i) {
+            cores[i].cpu = i;
+            cores[i].core = i;
+        }
+    }
+
+    if (count) {
+        *count = num_cores;
+    }
+    return cores;
+}
+
 #ifdef __e2k__
 inline const char *
 SDL_GetCPUType(void)
@@ -860,6 +1234,69 @@ int SDL_GetCPUCacheLineSize(void)
 static Uint32 SDL_CPUFeatures = 0xFFFFFFFF;
 static Uint32 SDL_SIMDAlignment = 0xFFFFFFFF;
 
+static const struct
+{
+    const char *name;
+    Uint32 feature;
+} SDL_CPUFeatureNames[] = {
+    { "all", 0xFFFFFFFF },
+    { "altivec", CPU_HAS_ALTIVEC },
+    { "mmx", CPU_HAS_MMX },
+    { "sse", CPU_HAS_SSE },
+    { "sse2", CPU_HAS_SSE2 },
+    { "sse3", CPU_HAS_SSE3 },
+    { "sse41", CPU_HAS_SSE41 },
+    { "sse42", CPU_HAS_SSE42 },
+    { "avx", CPU_HAS_AVX },
+    { "avx2", CPU_HAS_AVX2 },
+    { "avx512f", CPU_HAS_AVX512F },
+    { "arm-simd", CPU_HAS_ARM_SIMD },
+    { "neon", CPU_HAS_NEON },
+    { "lsx", CPU_HAS_LSX },
+    { "lasx", CPU_HAS_LASX },
+    { "pclmul", CPU_HAS_PCLMUL }
+};
+
+static Uint32 SDL_GetCPUFeatureMask(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_CPU_FEATURE_MASK);
+    Uint32 mask = 0xFFFFFFFF;
+
+    if (hint && *hint) {
+        char *copy = SDL_strdup(hint);
+        char *saveptr = NULL;
+        char *item;
+
+        if (!copy) {
+            return mask;
+        }
+
+        for (item = SDL_strtok_r(copy, ",", &saveptr); item; item = SDL_strtok_r(NULL, ",", &saveptr)) {
+            const char op = *item;
+            size_t i;
+
+            if (op == '+' || op == '-') {
+                ++item;
+            }
+            for (i = 0; i < SDL_arraysize(SDL_CPUFeatureNames); ++i) {
+                if (SDL_strcasecmp(item, SDL_CPUFeatureNames[i].name) == 0) {
+                    const Uint32 feature = SDL_CPUFeatureNames[i].feature;
+                    if (op == '+') {
+                        mask |= feature;
+                    } else if (op == '-') {
+                        mask &= ~feature;
+                    } else {
+                        mask = feature;
+                    }
+                    break;
+                }
+            }
+        }
+        SDL_free(copy);
+    }
+    return mask;
+}
+
 static Uint32 SDL_GetCPUFeatures(void)
 {
     if (SDL_CPUFeatures == 0xFFFFFFFF) {
@@ -894,6 +1331,9 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_SSE42;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 16);
         }
+        if (CPU_havePCLMUL()) {
+            SDL_CPUFeatures |= CPU_HAS_PCLMUL;
+        }
         if (CPU_haveAVX()) {
             SDL_CPUFeatures |= CPU_HAS_AVX;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 32);
@@ -922,6 +1362,7 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_LASX;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 32);
         }
+        SDL_CPUFeatures &= SDL_GetCPUFeatureMask();
     }
     return SDL_CPUFeatures;
 }
@@ -998,6 +1439,33 @@ SDL_bool SDL_HasLASX(void)
     return CPU_FEATURE_AVAILABLE(CPU_HAS_LASX);
 }
 
+SDL_bool SDL_HasPCLMUL(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_PCLMUL);
+}
+
+SDL_bool SDL_HasInvariantTSC(void)
+{
+    static int has_invariant_tsc = -1;
+
+    if (has_invariant_tsc < 0) {
+        int a, b, c, d;
+
+        has_invariant_tsc = 0;
+        CPU_calcCPUIDFeatures();
+        if (CPU_CPUIDMaxFunction > 0) {
+            cpuid(0x80000000, a, b, c, d);
+            if ((unsigned int)a >= 0x80000007) {
+                cpuid(0x80000007, a, b, c, d);
+                if (d & 0x00000100) {
+                    has_invariant_tsc = 1;
+                }
+            }
+        }
+    }
+    return has_invariant_tsc ? SDL_TRUE : SDL_FALSE;
+}
+
 static int SDL_SystemRAM = 0;
 
 int SDL_GetSystemRAM(void)
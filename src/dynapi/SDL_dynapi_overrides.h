@@ -988,3 +988,129 @@
 #define SDL_GetBooleanProperty SDL_GetBooleanProperty_REAL
 #define SDL_CreateTextureWithProperties SDL_CreateTextureWithProperties_REAL
 #define SDL_CreateRendererWithProperties SDL_CreateRendererWithProperties_REAL
+#define SDL_BeginRenderCommandList SDL_BeginRenderCommandList_REAL
+#define SDL_EndRenderCommandList SDL_EndRenderCommandList_REAL
+#define SDL_ReplayRenderCommandList SDL_ReplayRenderCommandList_REAL
+#define SDL_DestroyRenderCommandList SDL_DestroyRenderCommandList_REAL
+#define SDL_RenderTextureInstanced SDL_RenderTextureInstanced_REAL
+#define SDL_CreateRenderRecorder SDL_CreateRenderRecorder_REAL
+#define SDL_RecordRenderDrawColor SDL_RecordRenderDrawColor_REAL
+#define SDL_RecordRenderDrawBlendMode SDL_RecordRenderDrawBlendMode_REAL
+#define SDL_RecordRenderFillRects SDL_RecordRenderFillRects_REAL
+#define SDL_RecordRenderTexture SDL_RecordRenderTexture_REAL
+#define SDL_RecordRenderGeometry SDL_RecordRenderGeometry_REAL
+#define SDL_SubmitRenderRecorder SDL_SubmitRenderRecorder_REAL
+#define SDL_DestroyRenderRecorder SDL_DestroyRenderRecorder_REAL
+#define SDL_UpdateTextureAsync SDL_UpdateTextureAsync_REAL
+#define SDL_IsTextureUploadComplete SDL_IsTextureUploadComplete_REAL
+#define SDL_WaitTextureUpload SDL_WaitTextureUpload_REAL
+#define SDL_GetRenderPresentTiming SDL_GetRenderPresentTiming_REAL
+#define SDL_WaitRenderFrame SDL_WaitRenderFrame_REAL
+#define SDL_AcquireRenderTarget SDL_AcquireRenderTarget_REAL
+#define SDL_ReleaseRenderTarget SDL_ReleaseRenderTarget_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_IsRenderReadPixelsComplete SDL_IsRenderReadPixelsComplete_REAL
+#define SDL_FinishRenderReadPixels SDL_FinishRenderReadPixels_REAL
+#define SDL_BlitSurfaceScaledWithMode SDL_BlitSurfaceScaledWithMode_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
+#define SDL_PremultiplySurfaceAlpha SDL_PremultiplySurfaceAlpha_REAL
+#define SDL_UnpremultiplySurfaceAlpha SDL_UnpremultiplySurfaceAlpha_REAL
+#define SDL_SaveRLE_RW SDL_SaveRLE_RW_REAL
+#define SDL_LoadRLE_RW SDL_LoadRLE_RW_REAL
+#define SDL_LoadBMP_Mem SDL_LoadBMP_Mem_REAL
+#define SDL_CreateSurfacePool SDL_CreateSurfacePool_REAL
+#define SDL_CreateSurfaceFromPool SDL_CreateSurfaceFromPool_REAL
+#define SDL_DestroySurfacePool SDL_DestroySurfacePool_REAL
+#define SDL_BlitSurfaces SDL_BlitSurfaces_REAL
+#define SDL_SetAudioStreamLockFree SDL_SetAudioStreamLockFree_REAL
+#define SDL_GetAudioStreamGain SDL_GetAudioStreamGain_REAL
+#define SDL_SetAudioStreamGain SDL_SetAudioStreamGain_REAL
+#define SDL_FadeAudioStreamGain SDL_FadeAudioStreamGain_REAL
+#define SDL_GetAudioStreamPan SDL_GetAudioStreamPan_REAL
+#define SDL_SetAudioStreamPan SDL_SetAudioStreamPan_REAL
+#define SDL_GetAudioStreamResampleQuality SDL_GetAudioStreamResampleQuality_REAL
+#define SDL_SetAudioStreamResampleQuality SDL_SetAudioStreamResampleQuality_REAL
+#define SDL_SetAudioStreamChannelMatrix SDL_SetAudioStreamChannelMatrix_REAL
+#define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
+#define SDL_GetAudioDeviceProperties SDL_GetAudioDeviceProperties_REAL
+#define SDL_CreateAudioStreamFromWAV_RW SDL_CreateAudioStreamFromWAV_RW_REAL
+#define SDL_CreateAudioStreamFromWAV SDL_CreateAudioStreamFromWAV_REAL
+#define SDL_OpenAudioSubmix SDL_OpenAudioSubmix_REAL
+#define SDL_SetAudioDeviceGain SDL_SetAudioDeviceGain_REAL
+#define SDL_GetAudioDeviceGain SDL_GetAudioDeviceGain_REAL
+#define SDL_SetAudioStreamPreconvert SDL_SetAudioStreamPreconvert_REAL
+#define SDL_GetMotionHistory SDL_GetMotionHistory_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_SetEventLatencyCallback SDL_SetEventLatencyCallback_REAL
+#define SDL_AddEventWatchRange SDL_AddEventWatchRange_REAL
+#define SDL_GetJoystickSnapshot SDL_GetJoystickSnapshot_REAL
+#define SDL_GetGamepadSensorDataBatch SDL_GetGamepadSensorDataBatch_REAL
+#define SDL_GetSensorDataBatch SDL_GetSensorDataBatch_REAL
+#define SDL_SetJoystickVirtualState SDL_SetJoystickVirtualState_REAL
+#define SDL_HapticStreamStart SDL_HapticStreamStart_REAL
+#define SDL_HapticStreamQueue SDL_HapticStreamQueue_REAL
+#define SDL_HapticStreamQueued SDL_HapticStreamQueued_REAL
+#define SDL_HapticStreamStop SDL_HapticStreamStop_REAL
+#define SDL_CreateThreadPool SDL_CreateThreadPool_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_WaitJobCounter SDL_WaitJobCounter_REAL
+#define SDL_DestroyThreadPool SDL_DestroyThreadPool_REAL
+#define SDL_DelayPrecise SDL_DelayPrecise_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
+#define SDL_CreateArena SDL_CreateArena_REAL
+#define SDL_ArenaAlloc SDL_ArenaAlloc_REAL
+#define SDL_GetArenaMark SDL_GetArenaMark_REAL
+#define SDL_ResetArena SDL_ResetArena_REAL
+#define SDL_DestroyArena SDL_DestroyArena_REAL
+#define SDL_GetThreadArena SDL_GetThreadArena_REAL
+#define SDL_GetCPUTopology SDL_GetCPUTopology_REAL
+#define SDL_SetThreadQoS SDL_SetThreadQoS_REAL
+#define SDL_SetThreadAffinity SDL_SetThreadAffinity_REAL
+#define SDL_CreateSPSCQueue SDL_CreateSPSCQueue_REAL
+#define SDL_EnqueueSPSC SDL_EnqueueSPSC_REAL
+#define SDL_DequeueSPSC SDL_DequeueSPSC_REAL
+#define SDL_DestroySPSCQueue SDL_DestroySPSCQueue_REAL
+#define SDL_CreateMPMCQueue SDL_CreateMPMCQueue_REAL
+#define SDL_EnqueueMPMC SDL_EnqueueMPMC_REAL
+#define SDL_DequeueMPMC SDL_DequeueMPMC_REAL
+#define SDL_DestroyMPMCQueue SDL_DestroyMPMCQueue_REAL
+#define SDL_GetPropertyKey SDL_GetPropertyKey_REAL
+#define SDL_GetPropertyKeyName SDL_GetPropertyKeyName_REAL
+#define SDL_GetPropertyByKey SDL_GetPropertyByKey_REAL
+#define SDL_GetStringPropertyByKey SDL_GetStringPropertyByKey_REAL
+#define SDL_GetNumberPropertyByKey SDL_GetNumberPropertyByKey_REAL
+#define SDL_GetFloatPropertyByKey SDL_GetFloatPropertyByKey_REAL
+#define SDL_GetBooleanPropertyByKey SDL_GetBooleanPropertyByKey_REAL
+#define SDL_qsort_r SDL_qsort_r_REAL
+#define SDL_bsearch_r SDL_bsearch_r_REAL
+#define SDL_StableSort SDL_StableSort_REAL
+#define SDL_SortByUint32Key SDL_SortByUint32Key_REAL
+#define SDL_SortBySint32Key SDL_SortBySint32Key_REAL
+#define SDL_SortByFloatKey SDL_SortByFloatKey_REAL
+#define SDL_RWFromFileMapped SDL_RWFromFileMapped_REAL
+#define SDL_GetRWMemory SDL_GetRWMemory_REAL
+#define SDL_AsyncIOFromFile SDL_AsyncIOFromFile_REAL
+#define SDL_GetAsyncIOSize SDL_GetAsyncIOSize_REAL
+#define SDL_ReadAsyncIO SDL_ReadAsyncIO_REAL
+#define SDL_WriteAsyncIO SDL_WriteAsyncIO_REAL
+#define SDL_CloseAsyncIO SDL_CloseAsyncIO_REAL
+#define SDL_CreateAsyncIOQueue SDL_CreateAsyncIOQueue_REAL
+#define SDL_DestroyAsyncIOQueue SDL_DestroyAsyncIOQueue_REAL
+#define SDL_GetAsyncIOResult SDL_GetAsyncIOResult_REAL
+#define SDL_WaitAsyncIOResult SDL_WaitAsyncIOResult_REAL
+#define SDL_SignalAsyncIOQueue SDL_SignalAsyncIOQueue_REAL
+#define SDL_CreateBufferedRW SDL_CreateBufferedRW_REAL
+#define SDL_RWreadAt SDL_RWreadAt_REAL
+#define SDL_RWreadvAt SDL_RWreadvAt_REAL
+#define SDL_RWwriteAt SDL_RWwriteAt_REAL
+#define SDL_SetWindowVariableRefreshRate SDL_SetWindowVariableRefreshRate_REAL
+#define SDL_SetVideoCaptureFrameCallback SDL_SetVideoCaptureFrameCallback_REAL
+#define SDL_GetVideoCaptureFrameProperties SDL_GetVideoCaptureFrameProperties_REAL
+#define SDL_GetVideoCaptureProperties SDL_GetVideoCaptureProperties_REAL
+#define SDL_HasRectIntersections SDL_HasRectIntersections_REAL
+#define SDL_HasRectIntersectionsFloat SDL_HasRectIntersectionsFloat_REAL
+#define SDL_SetTextureReloadCallback SDL_SetTextureReloadCallback_REAL
+#define SDL_sincosf SDL_sincosf_REAL
+#define SDL_sinf_array SDL_sinf_array_REAL
+#define SDL_cosf_array SDL_cosf_array_REAL
+#define SDL_expf_array SDL_expf_array_REAL
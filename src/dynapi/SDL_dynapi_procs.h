@@ -1013,3 +1013,129 @@ SDL_DYNAPI_PROC(int,SDL_SetBooleanProperty,(SDL_PropertiesID a, const char *b, S
 SDL_DYNAPI_PROC(SDL_bool,SDL_GetBooleanProperty,(SDL_PropertiesID a, const char *b, SDL_bool c),(a,b,c),return)
 SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateTextureWithProperties,(SDL_Renderer *a, SDL_PropertiesID b),(a,b),return)
 SDL_DYNAPI_PROC(SDL_Renderer*,SDL_CreateRendererWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_BeginRenderCommandList,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RenderCommandList*,SDL_EndRenderCommandList,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReplayRenderCommandList,(SDL_Renderer *a, SDL_RenderCommandList *b, float c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderCommandList,(SDL_RenderCommandList *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderTextureInstanced,(SDL_Renderer *a, SDL_Texture *b, const SDL_TextureInstance *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_RenderRecorder*,SDL_CreateRenderRecorder,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderDrawColor,(SDL_RenderRecorder *a, Uint8 b, Uint8 c, Uint8 d, Uint8 e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderDrawBlendMode,(SDL_RenderRecorder *a, SDL_BlendMode b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderFillRects,(SDL_RenderRecorder *a, const SDL_FRect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderTexture,(SDL_RenderRecorder *a, SDL_Texture *b, const SDL_FRect *c, const SDL_FRect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderGeometry,(SDL_RenderRecorder *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitRenderRecorder,(SDL_RenderRecorder *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderRecorder,(SDL_RenderRecorder *a),(a),)
+SDL_DYNAPI_PROC(Uint64,SDL_UpdateTextureAsync,(SDL_Texture *a, const SDL_Rect *b, const void *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_IsTextureUploadComplete,(SDL_Renderer *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitTextureUpload,(SDL_Renderer *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderPresentTiming,(SDL_Renderer *a, SDL_RenderPresentTiming *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitRenderFrame,(SDL_Renderer *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_AcquireRenderTarget,(SDL_Renderer *a, Uint32 b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_ReleaseRenderTarget,(SDL_Texture *a),(a),return)
+SDL_DYNAPI_PROC(Uint64,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_IsRenderReadPixelsComplete,(SDL_Renderer *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_FinishRenderReadPixels,(SDL_Renderer *a, Uint64 b, void *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_BlitSurfaceScaledWithMode,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, SDL_Rect *d, SDL_ScaleMode e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_UnpremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplySurfaceAlpha,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_UnpremultiplySurfaceAlpha,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SaveRLE_RW,(SDL_Surface *a, SDL_RWops *b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadRLE_RW,(SDL_RWops *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadBMP_Mem,(void *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_SurfacePool*,SDL_CreateSurfacePool,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateSurfaceFromPool,(SDL_SurfacePool *a, int b, int c, Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_DestroySurfacePool,(SDL_SurfacePool *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_BlitSurfaces,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, SDL_Rect *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamLockFree,(SDL_AudioStream *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(float,SDL_GetAudioStreamGain,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamGain,(SDL_AudioStream *a, float b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_FadeAudioStreamGain,(SDL_AudioStream *a, float b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(float,SDL_GetAudioStreamPan,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamPan,(SDL_AudioStream *a, float b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioResampleQuality,SDL_GetAudioStreamResampleQuality,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamResampleQuality,(SDL_AudioStream *a, SDL_AudioResampleQuality b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamChannelMatrix,(SDL_AudioStream *a, int b, int c, const float *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_PutAudioStreamDataNoCopy,(SDL_AudioStream *a, const void *b, int c, SDL_AudioStreamDataCompleteCallback d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetAudioDeviceProperties,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_CreateAudioStreamFromWAV_RW,(SDL_RWops *a, SDL_bool b, const SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_CreateAudioStreamFromWAV,(const char *a, const SDL_AudioSpec *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioDeviceID,SDL_OpenAudioSubmix,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioDeviceGain,(SDL_AudioDeviceID a, float b),(a,b),return)
+SDL_DYNAPI_PROC(float,SDL_GetAudioDeviceGain,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamPreconvert,(SDL_AudioStream *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetMotionHistory,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_SetEventLatencyCallback,(SDL_EventLatencyCallback a, void *b),(a,b),)
+SDL_DYNAPI_PROC(int,SDL_AddEventWatchRange,(SDL_EventFilter a, void *b, Uint32 c, Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetJoystickSnapshot,(SDL_Joystick *a, SDL_JoystickSnapshot *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetGamepadSensorDataBatch,(SDL_Gamepad *a, SDL_SensorType b, SDL_SensorSample *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetSensorDataBatch,(SDL_Sensor *a, SDL_SensorSample *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SetJoystickVirtualState,(SDL_Joystick *a, const SDL_JoystickSnapshot *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_HapticStreamStart,(SDL_Haptic *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_HapticStreamQueue,(SDL_Haptic *a, const Sint16 *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_HapticStreamQueued,(SDL_Haptic *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_HapticStreamStop,(SDL_Haptic *a),(a),return)
+SDL_DYNAPI_PROC(SDL_ThreadPool*,SDL_CreateThreadPool,(int a, const int *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJob,(SDL_ThreadPool *a, SDL_JobFunction b, void *c, SDL_JobCounter *d, SDL_JobCounter *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJobCounter,(SDL_ThreadPool *a, SDL_JobCounter *b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_DestroyThreadPool,(SDL_ThreadPool *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DelayPrecise,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_NSTimerCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Arena*,SDL_CreateArena,(size_t a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_ArenaAlloc,(SDL_Arena *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(size_t,SDL_GetArenaMark,(SDL_Arena *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetArena,(SDL_Arena *a, size_t b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_DestroyArena,(SDL_Arena *a),(a),)
+SDL_DYNAPI_PROC(SDL_Arena*,SDL_GetThreadArena,(void),(),return)
+SDL_DYNAPI_PROC(SDL_CPUCoreInfo*,SDL_GetCPUTopology,(int *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetThreadQoS,(SDL_ThreadQoS a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetThreadAffinity,(const int *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_SPSCQueue*,SDL_CreateSPSCQueue,(int a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_EnqueueSPSC,(SDL_SPSCQueue *a, const void *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_DequeueSPSC,(SDL_SPSCQueue *a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroySPSCQueue,(SDL_SPSCQueue *a),(a),)
+SDL_DYNAPI_PROC(SDL_MPMCQueue*,SDL_CreateMPMCQueue,(int a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_EnqueueMPMC,(SDL_MPMCQueue *a, const void *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_DequeueMPMC,(SDL_MPMCQueue *a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyMPMCQueue,(SDL_MPMCQueue *a),(a),)
+SDL_DYNAPI_PROC(const SDL_PropertyKey*,SDL_GetPropertyKey,(const char *a),(a),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetPropertyKeyName,(const SDL_PropertyKey *a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_GetPropertyByKey,(SDL_PropertiesID a, const SDL_PropertyKey *b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetStringPropertyByKey,(SDL_PropertiesID a, const SDL_PropertyKey *b, const char *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetNumberPropertyByKey,(SDL_PropertiesID a, const SDL_PropertyKey *b, Sint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(float,SDL_GetFloatPropertyByKey,(SDL_PropertiesID a, const SDL_PropertyKey *b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetBooleanPropertyByKey,(SDL_PropertiesID a, const SDL_PropertyKey *b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_qsort_r,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),)
+SDL_DYNAPI_PROC(void*,SDL_bsearch_r,(const void *a, const void *b, size_t c, size_t d, SDL_CompareCallback_r e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(void,SDL_StableSort,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),)
+SDL_DYNAPI_PROC(void,SDL_SortByUint32Key,(void *a, size_t b, size_t c, size_t d),(a,b,c,d),)
+SDL_DYNAPI_PROC(void,SDL_SortBySint32Key,(void *a, size_t b, size_t c, size_t d),(a,b,c,d),)
+SDL_DYNAPI_PROC(void,SDL_SortByFloatKey,(void *a, size_t b, size_t c, size_t d),(a,b,c,d),)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromFileMapped,(const char *a),(a),return)
+SDL_DYNAPI_PROC(const void*,SDL_GetRWMemory,(SDL_RWops *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_AsyncIOFromFile,(const char *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetAsyncIOSize,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_WriteAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_CloseAsyncIO,(SDL_AsyncIO *a, SDL_AsyncIOQueue *b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOQueue*,SDL_CreateAsyncIOQueue,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_WaitAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_SignalAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_CreateBufferedRW,(SDL_RWops *a, size_t b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(size_t,SDL_RWreadAt,(SDL_RWops *a, void *b, size_t c, Sint64 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(size_t,SDL_RWreadvAt,(SDL_RWops *a, const SDL_RWvec *b, int c, Sint64 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(size_t,SDL_RWwriteAt,(SDL_RWops *a, const void *b, size_t c, Sint64 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_SetWindowVariableRefreshRate,(SDL_Window *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetVideoCaptureFrameCallback,(SDL_VideoCaptureDevice *a, SDL_VideoCaptureFrameCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetVideoCaptureFrameProperties,(SDL_VideoCaptureDevice *a, const SDL_VideoCaptureFrame *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetVideoCaptureProperties,(SDL_VideoCaptureDevice *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_HasRectIntersections,(const SDL_Rect *a, int b, const SDL_Rect *c, SDL_bool *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_HasRectIntersectionsFloat,(const SDL_FRect *a, int b, const SDL_FRect *c, SDL_bool *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_SetTextureReloadCallback,(SDL_Texture *a, SDL_TextureReloadCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_sincosf,(float a, float *b, float *c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_sinf_array,(const float *a, float *b, int c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_cosf_array,(const float *a, float *b, int c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_expf_array,(const float *a, float *b, int c),(a,b,c),)
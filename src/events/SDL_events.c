@@ -25,6 +25,9 @@
 #include "SDL_events_c.h"
 #include "../SDL_hints_c.h"
 #include "../audio/SDL_audio_c.h"
+#include "../thread/SDL_lockprofile.h"
+#include "../SDL_trace_c.h"
+#include "../thread/SDL_systhread.h"
 #include "../timer/SDL_timer_c.h"
 #ifndef SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
@@ -34,6 +37,11 @@
 #endif
 #include "../video/SDL_sysvideo.h"
 
+#ifdef HAVE_POLL
+#include <errno.h>
+#include <poll.h>
+#endif
+
 #undef SDL_PRIs64
 #if (defined(__WIN32__) || defined(__GDK__)) && !defined(__CYGWIN__)
 #define SDL_PRIs64 "I64d"
@@ -44,6 +52,12 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS 65535
 
+/* The number of events that can be pushed without taking the event queue lock, must be a power of two */
+#define SDL_EVENT_RING_SIZE 1024
+
+/* The most event types in a range that are merged from their per-type lists, before just walking the whole queue */
+#define SDL_MAX_MERGED_EVENT_TYPES 16
+
 /* Determines how often we wake to call SDL_PumpEvents() in SDL_WaitEventTimeout_Device() */
 #define PERIODIC_POLL_INTERVAL_NS (3 * SDL_NS_PER_SECOND)
 
@@ -51,15 +65,33 @@ typedef struct SDL_EventWatcher
 {
     SDL_EventFilter callback;
     void *userdata;
-    SDL_bool removed;
+    Uint32 minType;
+    Uint32 maxType;
+    SDL_AtomicInt removed;
+    struct SDL_EventWatcher *next_removed;
 } SDL_EventWatcher;
 
-static SDL_Mutex *SDL_event_watchers_lock;
-static SDL_EventWatcher SDL_EventOK;
-static SDL_EventWatcher *SDL_event_watchers = NULL;
-static int SDL_event_watchers_count = 0;
-static SDL_bool SDL_event_watchers_dispatching = SDL_FALSE;
-static SDL_bool SDL_event_watchers_removed = SDL_FALSE;
+/* An immutable snapshot of the event filter and watchers.
+
+   SDL_PushEvent() dispatches from the current snapshot without taking a lock.
+   Changes build a new snapshot and publish it, and the old one is freed once
+   no thread is dispatching anymore.
+ */
+typedef struct SDL_EventWatcherList
+{
+    SDL_EventFilter filter;
+    void *filter_userdata;
+    int count;
+    SDL_EventWatcher **watchers;
+    struct SDL_EventWatcherList *next_retired;
+} SDL_EventWatcherList;
+
+static SDL_Mutex *SDL_event_watchers_lock; /* serializes changes to the watchers */
+static SDL_EventWatcherList *SDL_event_watchers = NULL;
+static SDL_AtomicInt SDL_event_watchers_readers;
+static SDL_AtomicInt SDL_event_watchers_reclaim;
+static SDL_EventWatcherList *SDL_event_watchers_retired = NULL; /* protected by SDL_event_watchers_lock */
+static SDL_EventWatcher *SDL_event_watchers_removed = NULL;     /* protected by SDL_event_watchers_lock */
 static SDL_AtomicInt SDL_sentinel_pending;
 static Uint32 SDL_last_event_id = 0;
 
@@ -75,10 +107,40 @@ static Uint32 SDL_userevents = SDL_EVENT_USER;
 typedef struct SDL_EventEntry
 {
     SDL_Event event;
+    Uint64 queued; /* time the event was added, if latency tracing was on */
+    Uint32 id;
+    Uint32 indexed_type;
+    SDL_bool indexed;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
+    struct SDL_EventEntry *type_prev;
+    struct SDL_EventEntry *type_next;
 } SDL_EventEntry;
 
+/* Queued events of 256 consecutive event types, laid out like SDL_disabled_events */
+typedef struct SDL_EventTypeBlock
+{
+    int count;      /* events queued with any type in this block */
+    int types_used; /* types in this block with at least one event queued */
+    int counts[256];
+    SDL_EventEntry *heads[256];
+    SDL_EventEntry *tails[256];
+} SDL_EventTypeBlock;
+
+/* Set in SDL_EventQ.producers while the event loop is stopped, so producers
+   that haven't started yet stay out of the ring. */
+#define SDL_EVENT_PRODUCERS_CLOSED 0x40000000
+
+/* Slots of the lock-free ring that producers push into.
+   A slot is free for the producer at position N when its sequence is N,
+   and holds a published event for the consumer when its sequence is N+1. */
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicInt sequence;
+    Uint64 queued;
+    SDL_Event event;
+} SDL_EventRingSlot;
+
 static struct
 {
     SDL_Mutex *lock;
@@ -88,49 +150,87 @@ static struct
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL };
+    SDL_EventRingSlot *ring;
+    SDL_AtomicInt ring_enqueue_pos;
+    Uint32 ring_dequeue_pos; /* protected by lock */
+    SDL_AtomicInt producers; /* threads adding events without the lock, plus SDL_EVENT_PRODUCERS_CLOSED */
+    SDL_EventTypeBlock *types[256];
+    int unindexed; /* events that aren't in the per-type lists, forcing full scans */
+} SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL, NULL, { 0 }, 0, { SDL_EVENT_PRODUCERS_CLOSED }, { NULL }, 0 };
+
+/* Latency tracing, protected by SDL_EventQ.lock */
+static SDL_EventLatencyCallback SDL_event_latency_callback = NULL;
+static void *SDL_event_latency_userdata = NULL;
+
+/* Event memory is bump allocated out of arenas, which are freed all at once
+   when every event that might reference them has been consumed. */
+#define SDL_EVENT_MEMORY_ARENA_SIZE 4096
+#define SDL_EVENT_MEMORY_ALIGNMENT  16
 
 typedef struct SDL_EventMemory
 {
-    Uint32 eventID;
-    void *memory;
+    Uint32 eventID; /* the last event ID at the time of the newest allocation */
+    size_t size;
+    size_t used;
     struct SDL_EventMemory *next;
+    /* Memory follows, aligned to SDL_EVENT_MEMORY_ALIGNMENT */
 } SDL_EventMemory;
 
+#define SDL_EVENT_MEMORY_HEADER_SIZE ((sizeof(SDL_EventMemory) + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1))
+
 static SDL_Mutex *SDL_event_memory_lock;
 static SDL_EventMemory *SDL_event_memory_head;
 static SDL_EventMemory *SDL_event_memory_tail;
+static SDL_EventMemory *SDL_event_memory_spare; /* an empty arena kept around for reuse */
 
 void *SDL_AllocateEventMemory(size_t size)
 {
-    void *memory = SDL_malloc(size);
-    if (!memory) {
+    void *memory = NULL;
+
+    if (size > SDL_SIZE_MAX - (SDL_EVENT_MEMORY_HEADER_SIZE + SDL_EVENT_MEMORY_ALIGNMENT)) {
         SDL_OutOfMemory();
         return NULL;
     }
+    size = (size + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1);
 
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        SDL_EventMemory *entry = (SDL_EventMemory *)SDL_malloc(sizeof(*entry));
-        if (entry) {
-            entry->eventID = SDL_last_event_id;
-            entry->memory = memory;
-            entry->next = NULL;
-
-            if (SDL_event_memory_tail) {
-                SDL_event_memory_tail->next = entry;
+        SDL_EventMemory *arena = SDL_event_memory_tail;
+
+        if (!arena || (arena->size - arena->used) < size) {
+            if (SDL_event_memory_spare && SDL_event_memory_spare->size >= size) {
+                arena = SDL_event_memory_spare;
+                SDL_event_memory_spare = NULL;
             } else {
-                SDL_event_memory_head = entry;
+                const size_t arena_size = SDL_max(size, SDL_EVENT_MEMORY_ARENA_SIZE - SDL_EVENT_MEMORY_HEADER_SIZE);
+                arena = (SDL_EventMemory *)SDL_malloc(SDL_EVENT_MEMORY_HEADER_SIZE + arena_size);
+                if (arena) {
+                    arena->size = arena_size;
+                }
+            }
+            if (arena) {
+                arena->used = 0;
+                arena->next = NULL;
+                if (SDL_event_memory_tail) {
+                    SDL_event_memory_tail->next = arena;
+                } else {
+                    SDL_event_memory_head = arena;
+                }
+                SDL_event_memory_tail = arena;
             }
-            SDL_event_memory_tail = entry;
-        } else {
-            SDL_free(memory);
-            memory = NULL;
-            SDL_OutOfMemory();
+        }
+
+        if (arena) {
+            memory = (Uint8 *)arena + SDL_EVENT_MEMORY_HEADER_SIZE + arena->used;
+            arena->used += size;
+            arena->eventID = SDL_last_event_id;
         }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
 
+    if (!memory) {
+        SDL_OutOfMemory();
+    }
     return memory;
 }
 
@@ -138,25 +238,30 @@ static void SDL_FlushEventMemory(Uint32 eventID)
 {
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        if (SDL_event_memory_head) {
-            while (SDL_event_memory_head) {
-                SDL_EventMemory *entry = SDL_event_memory_head;
-
-                if (eventID && (Sint32)(eventID - entry->eventID) < 0) {
-                    break;
-                }
+        while (SDL_event_memory_head) {
+            SDL_EventMemory *arena = SDL_event_memory_head;
 
-                /* If you crash here, your application has memory corruption
-                 * or freed memory in an event, which is no longer necessary.
-                 */
-                SDL_event_memory_head = entry->next;
-                SDL_free(entry->memory);
-                SDL_free(entry);
+            if (eventID && (Sint32)(eventID - arena->eventID) < 0) {
+                break;
             }
-            if (!SDL_event_memory_head) {
-                SDL_event_memory_tail = NULL;
+
+            /* If you crash here, your application has memory corruption
+             * or freed memory in an event, which is no longer necessary.
+             */
+            SDL_event_memory_head = arena->next;
+            if (eventID && !SDL_event_memory_spare && arena->size == SDL_EVENT_MEMORY_ARENA_SIZE - SDL_EVENT_MEMORY_HEADER_SIZE) {
+                SDL_event_memory_spare = arena;
+            } else {
+                SDL_free(arena);
             }
         }
+        if (!SDL_event_memory_head) {
+            SDL_event_memory_tail = NULL;
+        }
+        if (!eventID) {
+            SDL_free(SDL_event_memory_spare);
+            SDL_event_memory_spare = NULL;
+        }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
 }
@@ -183,6 +288,213 @@ static void SDLCALL SDL_AutoUpdateSensorsChanged(void *userdata, const char *nam
 
 #endif /* !SDL_SENSOR_DISABLED */
 
+/* Input devices that aren't tied to a window can be updated on their own thread */
+#define SDL_INPUT_THREAD_INTERVAL_NS SDL_NS_PER_MS
+
+/* How long the input thread sleeps on the event wakeup fds before checking for new devices and shutdown */
+#define SDL_INPUT_THREAD_WAKEUP_TIMEOUT_MS 10
+
+static struct
+{
+    SDL_Thread *thread;
+    SDL_AtomicInt active;
+    SDL_SpinLock lock; /* held while updating devices, and while their subsystems shut down */
+} SDL_input_thread;
+
+static SDL_bool SDL_WaitInputThreadWakeup(void);
+
+/* Whether every device the input thread updates will make an event wakeup fd readable when it has new input */
+static SDL_bool SDL_InputThreadCanWait(void)
+{
+    SDL_bool can_wait = SDL_FALSE;
+
+#ifndef SDL_SENSOR_DISABLED
+    if (SDL_update_sensors && SDL_SensorsOpened()) {
+        return SDL_FALSE;
+    }
+#endif
+
+#ifndef SDL_JOYSTICK_DISABLED
+    /* If joysticks aren't being read, their fds would stay readable */
+    can_wait = SDL_update_joysticks && SDL_WasInit(SDL_INIT_JOYSTICK) &&
+               !SDL_JoysticksNeedPolling() && !SDL_JoysticksNeedPeriodicPoll();
+#endif
+
+    return can_wait;
+}
+
+static int SDLCALL SDL_InputThread(void *data)
+{
+    SDL_bool can_wait;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_AtomicGet(&SDL_input_thread.active)) {
+        can_wait = SDL_FALSE;
+
+        /* If a subsystem is shutting down, skip this update rather than waiting for it */
+        if (SDL_AtomicTryLock(&SDL_input_thread.lock)) {
+#ifndef SDL_SENSOR_DISABLED
+            if (SDL_update_sensors) {
+                SDL_UpdateSensors();
+            }
+#endif
+#ifndef SDL_JOYSTICK_DISABLED
+            if (SDL_update_joysticks) {
+                SDL_UpdateJoysticks();
+            }
+#endif
+            can_wait = SDL_InputThreadCanWait();
+            SDL_AtomicUnlock(&SDL_input_thread.lock);
+        }
+
+        /* Read each report as soon as it arrives, instead of on the next tick */
+        if (!can_wait || !SDL_WaitInputThreadWakeup()) {
+            SDL_DelayNS(SDL_INPUT_THREAD_INTERVAL_NS);
+        }
+    }
+    return 0;
+}
+
+static void SDL_StartInputThread(void)
+{
+    if (SDL_input_thread.thread) {
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_input_thread.active, 1);
+    SDL_input_thread.thread = SDL_CreateThreadInternal(SDL_InputThread, "SDLInput", 0, NULL);
+    if (!SDL_input_thread.thread) {
+        /* Keep updating devices from SDL_PumpEvents() */
+        SDL_AtomicSet(&SDL_input_thread.active, 0);
+    }
+}
+
+static void SDL_StopInputThread(void)
+{
+    if (!SDL_input_thread.thread) {
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_input_thread.active, 0);
+    SDL_WaitThread(SDL_input_thread.thread, NULL);
+    SDL_input_thread.thread = NULL;
+}
+
+static void SDLCALL SDL_InputThreadChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    if (SDL_GetStringBoolean(hint, SDL_FALSE)) {
+        SDL_StartInputThread();
+    } else {
+        SDL_StopInputThread();
+    }
+}
+
+static SDL_SpinLock SDL_event_wakeup_lock;
+static int SDL_event_wakeup_fds[SDL_MAX_EVENT_WAKEUP_FDS];
+static int SDL_event_wakeup_count;
+
+int SDL_AddEventWakeupFD(int fd)
+{
+    int result = 0;
+
+    if (fd < 0) {
+        return SDL_InvalidParamError("fd");
+    }
+
+    SDL_AtomicLock(&SDL_event_wakeup_lock);
+    {
+        if (SDL_event_wakeup_count < SDL_arraysize(SDL_event_wakeup_fds)) {
+            SDL_event_wakeup_fds[SDL_event_wakeup_count++] = fd;
+        } else {
+            result = SDL_SetError("Too many event wakeup file descriptors");
+        }
+    }
+    SDL_AtomicUnlock(&SDL_event_wakeup_lock);
+
+    return result;
+}
+
+void SDL_DelEventWakeupFD(int fd)
+{
+    int i;
+
+    SDL_AtomicLock(&SDL_event_wakeup_lock);
+    {
+        for (i = 0; i < SDL_event_wakeup_count; ++i) {
+            if (SDL_event_wakeup_fds[i] == fd) {
+                SDL_event_wakeup_fds[i] = SDL_event_wakeup_fds[--SDL_event_wakeup_count];
+                break;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&SDL_event_wakeup_lock);
+}
+
+int SDL_GetEventWakeupFDs(int *fds, int maxfds)
+{
+    int count;
+
+#ifndef SDL_JOYSTICK_DISABLED
+    /* Joysticks are only read by SDL_PumpEvents() when it's updating them,
+       otherwise their file descriptors would stay readable and we'd never sleep */
+    if (!SDL_update_joysticks || SDL_input_thread.thread) {
+        return 0;
+    }
+#endif
+
+    SDL_AtomicLock(&SDL_event_wakeup_lock);
+    {
+        count = SDL_min(maxfds, SDL_event_wakeup_count);
+        SDL_memcpy(fds, SDL_event_wakeup_fds, count * sizeof(*fds));
+    }
+    SDL_AtomicUnlock(&SDL_event_wakeup_lock);
+
+    return count;
+}
+
+/* Returns SDL_FALSE if there's nothing to wait on, and the input thread should poll instead */
+static SDL_bool SDL_WaitInputThreadWakeup(void)
+{
+#ifdef HAVE_POLL
+    struct pollfd info[SDL_MAX_EVENT_WAKEUP_FDS];
+    int i, count, result;
+
+    SDL_AtomicLock(&SDL_event_wakeup_lock);
+    {
+        count = SDL_event_wakeup_count;
+        for (i = 0; i < count; ++i) {
+            info[i].fd = SDL_event_wakeup_fds[i];
+            info[i].events = POLLIN | POLLPRI;
+            info[i].revents = 0;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_event_wakeup_lock);
+
+    if (count == 0) {
+        return SDL_FALSE;
+    }
+
+    do {
+        result = poll(info, count, SDL_INPUT_THREAD_WAKEUP_TIMEOUT_MS);
+    } while (result < 0 && errno == EINTR);
+
+    return (result >= 0) ? SDL_TRUE : SDL_FALSE;
+#else
+    return SDL_FALSE;
+#endif
+}
+
+void SDL_LockInputThread(void)
+{
+    SDL_AtomicLock(&SDL_input_thread.lock);
+}
+
+void SDL_UnlockInputThread(void)
+{
+    SDL_AtomicUnlock(&SDL_input_thread.lock);
+}
+
 static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, SDL_TRUE));
@@ -201,6 +513,49 @@ static void SDLCALL SDL_EventLoggingChanged(void *userdata, const char *name, co
     SDL_EventLoggingVerbosity = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 3) : 0;
 }
 
+/* Set by SDL_HINT_EVENT_COALESCE_MOTION */
+static SDL_bool SDL_coalesce_motion = SDL_FALSE;
+
+/* Raw motion events recorded for SDL_GetMotionHistory(), protected by SDL_EventQ.lock */
+static struct
+{
+    SDL_Event *events;
+    int capacity;
+    int first;
+    int count;
+} SDL_motion_history;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_motion = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
+/* Set by SDL_HINT_EVENT_BATCH_TOUCH */
+static SDL_bool SDL_batch_touch = SDL_FALSE;
+
+/* Motion samples waiting to be queued as a frame event, protected by SDL_EventQ.lock */
+typedef struct SDL_EventFrame
+{
+    Uint32 type;        /* the frame event type */
+    Uint32 first_type;  /* the range of event types that end the frame */
+    Uint32 last_type;
+    Uint32 sample_type; /* the event type collected in the frame */
+    size_t sample_size;
+    int num_samples;
+    int max_samples;
+    Uint8 *samples;
+} SDL_EventFrame;
+
+static SDL_EventFrame SDL_event_frames[] = {
+    { SDL_EVENT_FINGER_FRAME, SDL_EVENT_FINGER_DOWN, SDL_EVENT_FINGER_MOTION, SDL_EVENT_FINGER_MOTION, sizeof(SDL_TouchFingerEvent), 0, 0, NULL },
+    { SDL_EVENT_PEN_FRAME, SDL_EVENT_PEN_DOWN, SDL_EVENT_PEN_BUTTON_UP, SDL_EVENT_PEN_MOTION, sizeof(SDL_PenMotionEvent), 0, 0, NULL }
+};
+
+static void SDLCALL SDL_BatchTouchChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_batch_touch = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 static void SDL_LogEvent(const SDL_Event *event)
 {
     char name[64];
@@ -210,7 +565,9 @@ static void SDL_LogEvent(const SDL_Event *event)
     if ((SDL_EventLoggingVerbosity < 2) &&
         ((event->type == SDL_EVENT_MOUSE_MOTION) ||
          (event->type == SDL_EVENT_FINGER_MOTION) ||
+         (event->type == SDL_EVENT_FINGER_FRAME) ||
          (event->type == SDL_EVENT_PEN_MOTION) ||
+         (event->type == SDL_EVENT_PEN_FRAME) ||
          (event->type == SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION) ||
          (event->type == SDL_EVENT_GAMEPAD_SENSOR_UPDATE) ||
          (event->type == SDL_EVENT_SENSOR_UPDATE))) {
@@ -473,6 +830,11 @@ static void SDL_LogEvent(const SDL_Event *event)
         break;
 #undef PRINT_FINGER_EVENT
 
+        SDL_EVENT_CASE(SDL_EVENT_FINGER_FRAME)
+        (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u samples=%d)",
+                           (uint)event->tframe.timestamp, event->tframe.num_samples);
+        break;
+
 #define PRINT_PTIP_EVENT(event)                                                                                    \
     (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u windowid=%u which=%u tip=%u state=%s x=%g y=%g)", \
                        (uint)event->ptip.timestamp, (uint)event->ptip.windowID,                                    \
@@ -520,6 +882,11 @@ static void SDL_LogEvent(const SDL_Event *event)
         break;
 #undef PRINT_PBUTTON_EVENT
 
+        SDL_EVENT_CASE(SDL_EVENT_PEN_FRAME)
+        (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u samples=%d)",
+                           (uint)event->pframe.timestamp, event->pframe.num_samples);
+        break;
+
 #define PRINT_DROP_EVENT(event) (void)SDL_snprintf(details, sizeof(details), " (data='%s' timestamp=%u windowid=%u x=%f y=%f)", event->drop.data, (uint)event->drop.timestamp, (uint)event->drop.windowID, event->drop.x, event->drop.y)
         SDL_EVENT_CASE(SDL_EVENT_DROP_FILE)
         PRINT_DROP_EVENT(event);
@@ -578,11 +945,126 @@ static void SDL_LogEvent(const SDL_Event *event)
 #undef uint
 }
 
+/* Free snapshots and watchers that are no longer published -- called with the watchers locked */
+static void SDL_ReclaimEventWatchers(void)
+{
+    if (SDL_AtomicGet(&SDL_event_watchers_readers) > 0) {
+        /* Someone may still be dispatching from them, the last one out will try again */
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_event_watchers_reclaim, 0);
+
+    while (SDL_event_watchers_retired) {
+        SDL_EventWatcherList *list = SDL_event_watchers_retired;
+        SDL_event_watchers_retired = list->next_retired;
+        SDL_free(list);
+    }
+    while (SDL_event_watchers_removed) {
+        SDL_EventWatcher *watcher = SDL_event_watchers_removed;
+        SDL_event_watchers_removed = watcher->next_removed;
+        SDL_free(watcher);
+    }
+}
+
+/* Publish a new snapshot of the filter and watchers -- called with the watchers locked
+
+   Watchers marked as removed are left out of the new snapshot, and `added` is appended to it.
+ */
+static int SDL_PublishEventWatchers(SDL_EventFilter filter, void *filter_userdata, SDL_EventWatcher *added)
+{
+    SDL_EventWatcherList *current = SDL_event_watchers;
+    SDL_EventWatcherList *list = NULL;
+    const int max_count = (current ? current->count : 0) + (added ? 1 : 0);
+    int i;
+
+    if (filter || max_count > 0) {
+        list = (SDL_EventWatcherList *)SDL_malloc(sizeof(*list) + max_count * sizeof(*list->watchers));
+        if (list == NULL) {
+            return SDL_OutOfMemory();
+        }
+        list->filter = filter;
+        list->filter_userdata = filter_userdata;
+        list->count = 0;
+        list->watchers = (SDL_EventWatcher **)(list + 1);
+        list->next_retired = NULL;
+    }
+
+    if (current) {
+        for (i = 0; i < current->count; ++i) {
+            SDL_EventWatcher *watcher = current->watchers[i];
+            if (SDL_AtomicGet(&watcher->removed)) {
+                watcher->next_removed = SDL_event_watchers_removed;
+                SDL_event_watchers_removed = watcher;
+            } else {
+                list->watchers[list->count++] = watcher;
+            }
+        }
+    }
+    if (added) {
+        list->watchers[list->count++] = added;
+    }
+    if (list && !list->filter && list->count == 0) {
+        /* Nothing left to dispatch, let SDL_PushEvent() skip it entirely */
+        SDL_free(list);
+        list = NULL;
+    }
+
+    SDL_AtomicSetPtr((void **)&SDL_event_watchers, list);
+
+    if (current) {
+        current->next_retired = SDL_event_watchers_retired;
+        SDL_event_watchers_retired = current;
+    }
+    if (SDL_event_watchers_retired || SDL_event_watchers_removed) {
+        SDL_AtomicSet(&SDL_event_watchers_reclaim, 1);
+        SDL_ReclaimEventWatchers();
+    }
+    return 0;
+}
+
+static void SDL_DestroyEventWatchers(void)
+{
+    SDL_EventWatcherList *list = (SDL_EventWatcherList *)SDL_AtomicSetPtr((void **)&SDL_event_watchers, NULL);
+
+    if (list) {
+        int i;
+        for (i = 0; i < list->count; ++i) {
+            SDL_free(list->watchers[i]);
+        }
+        SDL_free(list);
+    }
+    SDL_AtomicSet(&SDL_event_watchers_readers, 0);
+    SDL_ReclaimEventWatchers();
+}
+
+/* Stop dispatching from the current snapshot, freeing retired ones if this was the last dispatch */
+static void SDL_ReleaseEventWatchers(void)
+{
+    if (SDL_AtomicDecRef(&SDL_event_watchers_readers) && SDL_AtomicGet(&SDL_event_watchers_reclaim)) {
+        if (SDL_TryLockMutex(SDL_event_watchers_lock) == 0) {
+            SDL_ReclaimEventWatchers();
+            SDL_UnlockMutex(SDL_event_watchers_lock);
+        }
+    }
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
     int i;
     SDL_EventEntry *entry;
+    int producers;
+
+    /* Keep new producers out, and wait for the ones already adding events
+       to finish, since they don't take the lock and the ring is freed below */
+    do {
+        producers = SDL_AtomicGet(&SDL_EventQ.producers);
+    } while (!(producers & SDL_EVENT_PRODUCERS_CLOSED) &&
+             !SDL_AtomicCAS(&SDL_EventQ.producers, producers, producers | SDL_EVENT_PRODUCERS_CLOSED));
+    while (SDL_AtomicGet(&SDL_EventQ.producers) != SDL_EVENT_PRODUCERS_CLOSED) {
+        SDL_Delay(0);
+    }
 
     SDL_LockMutex(SDL_EventQ.lock);
 
@@ -605,11 +1087,29 @@ void SDL_StopEventLoop(void)
         entry = next;
     }
 
+    SDL_free(SDL_EventQ.ring);
+    SDL_free(SDL_motion_history.events);
+    SDL_zero(SDL_motion_history);
+    for (i = 0; i < SDL_arraysize(SDL_event_frames); ++i) {
+        SDL_free(SDL_event_frames[i].samples);
+        SDL_event_frames[i].samples = NULL;
+        SDL_event_frames[i].num_samples = 0;
+        SDL_event_frames[i].max_samples = 0;
+    }
+    for (i = 0; i < SDL_arraysize(SDL_EventQ.types); ++i) {
+        SDL_free(SDL_EventQ.types[i]);
+        SDL_EventQ.types[i] = NULL;
+    }
+    SDL_EventQ.unindexed = 0;
+
     SDL_AtomicSet(&SDL_EventQ.count, 0);
     SDL_EventQ.max_events_seen = 0;
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_EventQ.ring = NULL;
+    SDL_AtomicSet(&SDL_EventQ.ring_enqueue_pos, 0);
+    SDL_EventQ.ring_dequeue_pos = 0;
     SDL_AtomicSet(&SDL_sentinel_pending, 0);
 
     SDL_FlushEventMemory(0);
@@ -628,12 +1128,7 @@ void SDL_StopEventLoop(void)
         SDL_DestroyMutex(SDL_event_watchers_lock);
         SDL_event_watchers_lock = NULL;
     }
-    if (SDL_event_watchers) {
-        SDL_free(SDL_event_watchers);
-        SDL_event_watchers = NULL;
-        SDL_event_watchers_count = 0;
-    }
-    SDL_zero(SDL_EventOK);
+    SDL_DestroyEventWatchers();
 
     SDL_UnlockMutex(SDL_EventQ.lock);
 
@@ -659,6 +1154,7 @@ int SDL_StartEventLoop(void)
         if (SDL_EventQ.lock == NULL) {
             return -1;
         }
+        SDL_SetMutexName(SDL_EventQ.lock, "SDL_EventQ.lock");
     }
     SDL_LockMutex(SDL_EventQ.lock);
 
@@ -668,6 +1164,7 @@ int SDL_StartEventLoop(void)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
+        SDL_SetMutexName(SDL_event_watchers_lock, "SDL_event_watchers_lock");
     }
 
     if (SDL_event_memory_lock == NULL) {
@@ -679,6 +1176,19 @@ int SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    /* If this fails, events simply all go through the linked list */
+    if (!SDL_EventQ.ring) {
+        SDL_EventQ.ring = (SDL_EventRingSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventQ.ring));
+        if (SDL_EventQ.ring) {
+            int i;
+            for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_AtomicSet(&SDL_EventQ.ring[i].sequence, i);
+            }
+            SDL_AtomicSet(&SDL_EventQ.ring_enqueue_pos, 0);
+            SDL_EventQ.ring_dequeue_pos = 0;
+        }
+    }
+
     /* Process most event types */
     SDL_SetEventEnabled(SDL_EVENT_TEXT_INPUT, SDL_FALSE);
     SDL_SetEventEnabled(SDL_EVENT_TEXT_EDITING, SDL_FALSE);
@@ -687,68 +1197,612 @@ int SDL_StartEventLoop(void)
     SDL_SetEventEnabled(SDL_EVENT_DROP_TEXT, SDL_FALSE);
 #endif
 
+    if (!SDL_EventQ.active) {
+        SDL_AtomicAdd(&SDL_EventQ.producers, -SDL_EVENT_PRODUCERS_CLOSED);
+    }
     SDL_EventQ.active = SDL_TRUE;
     SDL_UnlockMutex(SDL_EventQ.lock);
     return 0;
 }
 
-/* Add an event to the event queue -- called with the queue locked */
-static int SDL_AddEvent(SDL_Event *event)
+static void SDLCALL SDL_MotionHistoryChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
+    const int capacity = (hint && *hint) ? SDL_max(SDL_atoi(hint), 0) : 0;
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        SDL_free(SDL_motion_history.events);
+        SDL_zero(SDL_motion_history);
+        if (capacity > 0) {
+            SDL_motion_history.events = (SDL_Event *)SDL_malloc(capacity * sizeof(SDL_Event));
+            if (SDL_motion_history.events) {
+                SDL_motion_history.capacity = capacity;
+            }
         }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
-    }
-
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
     }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
 
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
-    }
+/* Record a motion event for SDL_GetMotionHistory() -- called with the queue locked */
+static void SDL_RecordMotionHistory(const SDL_Event *event)
+{
+    int slot;
 
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
+    if (SDL_motion_history.capacity == 0) {
+        return;
     }
-
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    if (SDL_motion_history.count == SDL_motion_history.capacity) {
+        /* Full, drop the oldest */
+        SDL_motion_history.first = (SDL_motion_history.first + 1) % SDL_motion_history.capacity;
+        --SDL_motion_history.count;
     }
-
-    ++SDL_last_event_id;
-
-    return 1;
+    slot = (SDL_motion_history.first + SDL_motion_history.count) % SDL_motion_history.capacity;
+    SDL_copyp(&SDL_motion_history.events[slot], event);
+    ++SDL_motion_history.count;
 }
 
-/* Remove an event from the queue -- called with the queue locked */
-static void SDL_CutEvent(SDL_EventEntry *entry)
+/* Merge a motion event into the queued one if they're for the same window, device and button state */
+static SDL_bool SDL_CoalesceMotionEvent(SDL_Event *queued, const SDL_Event *event)
 {
+    if (queued->type != event->type) {
+        return SDL_FALSE;
+    }
+    if (event->type == SDL_EVENT_MOUSE_MOTION) {
+        if (queued->motion.windowID != event->motion.windowID ||
+            queued->motion.which != event->motion.which ||
+            queued->motion.state != event->motion.state) {
+            return SDL_FALSE;
+        }
+        queued->motion.timestamp = event->motion.timestamp;
+        queued->motion.x = event->motion.x;
+        queued->motion.y = event->motion.y;
+        queued->motion.xrel += event->motion.xrel;
+        queued->motion.yrel += event->motion.yrel;
+        return SDL_TRUE;
+    }
+    if (event->type == SDL_EVENT_PEN_MOTION) {
+        if (queued->pmotion.windowID != event->pmotion.windowID ||
+            queued->pmotion.which != event->pmotion.which ||
+            queued->pmotion.pen_state != event->pmotion.pen_state) {
+            return SDL_FALSE;
+        }
+        SDL_copyp(&queued->pmotion, &event->pmotion);
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+/* Add an entry to the list for its event type, keeping the list in queue order -- called with the queue locked */
+static void SDL_IndexEvent(SDL_EventEntry *entry)
+{
+    const Uint32 type = entry->event.type;
+    SDL_EventTypeBlock *block = NULL;
+    SDL_EventEntry *prev;
+    Uint8 lo;
+
+    entry->indexed_type = type;
+    entry->type_prev = NULL;
+    entry->type_next = NULL;
+
+    if (type <= 0xFFFF) {
+        block = SDL_EventQ.types[type >> 8];
+        if (!block) {
+            block = (SDL_EventTypeBlock *)SDL_calloc(1, sizeof(*block));
+            SDL_EventQ.types[type >> 8] = block;
+        }
+    }
+    if (!block) {
+        entry->indexed = SDL_FALSE;
+        ++SDL_EventQ.unindexed;
+        return;
+    }
+
+    lo = (Uint8)(type & 0xFF);
+    if (!block->heads[lo]) {
+        ++block->types_used;
+    }
+
+    /* New events always go at the end, this only walks back for events re-filed by SDL_FilterEvents() */
+    prev = block->tails[lo];
+    while (prev && (Sint32)(prev->id - entry->id) > 0) {
+        prev = prev->type_prev;
+    }
+    entry->type_prev = prev;
+    if (prev) {
+        entry->type_next = prev->type_next;
+        prev->type_next = entry;
+    } else {
+        entry->type_next = block->heads[lo];
+        block->heads[lo] = entry;
+    }
+    if (entry->type_next) {
+        entry->type_next->type_prev = entry;
+    } else {
+        block->tails[lo] = entry;
+    }
+
+    ++block->counts[lo];
+    ++block->count;
+    entry->indexed = SDL_TRUE;
+}
+
+/* Remove an entry from the list for its event type -- called with the queue locked */
+static void SDL_UnindexEvent(SDL_EventEntry *entry)
+{
+    SDL_EventTypeBlock *block;
+    Uint8 lo;
+
+    if (!entry->indexed) {
+        SDL_assert(SDL_EventQ.unindexed > 0);
+        --SDL_EventQ.unindexed;
+        return;
+    }
+
+    block = SDL_EventQ.types[entry->indexed_type >> 8];
+    lo = (Uint8)(entry->indexed_type & 0xFF);
+    if (entry->type_prev) {
+        entry->type_prev->type_next = entry->type_next;
+    } else {
+        block->heads[lo] = entry->type_next;
+    }
+    if (entry->type_next) {
+        entry->type_next->type_prev = entry->type_prev;
+    } else {
+        block->tails[lo] = entry->type_prev;
+    }
+    if (!block->heads[lo]) {
+        --block->types_used;
+    }
+    --block->counts[lo];
+    --block->count;
+    entry->indexed = SDL_FALSE;
+}
+
+/* Walks the queued events with a type in [minType, maxType], in queue order */
+typedef struct SDL_EventIterator
+{
+    Uint32 minType;
+    Uint32 maxType;
+    int num_lists; /* -1 when walking the whole queue */
+    SDL_EventEntry *next;
+    SDL_EventEntry *lists[SDL_MAX_MERGED_EVENT_TYPES];
+} SDL_EventIterator;
+
+/* Set up an iterator -- called with the queue locked */
+static void SDL_StartEventIterator(SDL_EventIterator *iter, Uint32 minType, Uint32 maxType)
+{
+    Uint32 hi;
+    int num_lists = 0;
+
+    iter->minType = minType;
+    iter->maxType = maxType;
+    iter->num_lists = -1;
+    iter->next = SDL_EventQ.head;
+
+    if (minType > maxType) {
+        iter->num_lists = 0;
+        return;
+    }
+    if (SDL_EventQ.unindexed > 0 || maxType > 0xFFFF || (minType == 0 && maxType == 0xFFFF)) {
+        /* Everything matches, or we can't trust the index */
+        return;
+    }
+
+    for (hi = (minType >> 8); hi <= (maxType >> 8); ++hi) {
+        const SDL_EventTypeBlock *block = SDL_EventQ.types[hi];
+        const Uint32 lo_min = (hi == (minType >> 8)) ? (minType & 0xFF) : 0;
+        const Uint32 lo_max = (hi == (maxType >> 8)) ? (maxType & 0xFF) : 0xFF;
+        Uint32 lo;
+        int found = 0;
+
+        if (!block || !block->count) {
+            continue;
+        }
+        for (lo = lo_min; lo <= lo_max && found < block->types_used; ++lo) {
+            if (block->heads[lo]) {
+                if (num_lists == SDL_MAX_MERGED_EVENT_TYPES) {
+                    /* Too many types, walking the whole queue is cheaper */
+                    return;
+                }
+                iter->lists[num_lists++] = block->heads[lo];
+                ++found;
+            }
+        }
+    }
+    iter->num_lists = num_lists;
+}
+
+/* Get the next matching event, it's safe to cut the returned entry -- called with the queue locked */
+static SDL_EventEntry *SDL_NextEvent(SDL_EventIterator *iter)
+{
+    SDL_EventEntry *entry;
+    int i, best = -1;
+
+    if (iter->num_lists < 0) {
+        while (iter->next) {
+            entry = iter->next;
+            iter->next = entry->next;
+            if (iter->minType <= entry->event.type && entry->event.type <= iter->maxType) {
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    /* Merge the per-type lists back into queue order */
+    for (i = 0; i < iter->num_lists; ++i) {
+        if (iter->lists[i] && (best < 0 || (Sint32)(iter->lists[i]->id - iter->lists[best]->id) < 0)) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return NULL;
+    }
+    entry = iter->lists[best];
+    iter->lists[best] = entry->type_next;
+    return entry;
+}
+
+/* Count the events with a type in [minType, maxType], not including poll sentinels -- called with the queue locked */
+static int SDL_CountEventsInRange(Uint32 minType, Uint32 maxType)
+{
+    Uint32 hi;
+    int count = 0;
+
+    SDL_assert(SDL_EventQ.unindexed == 0 && minType <= maxType && maxType <= 0xFFFF);
+
+    for (hi = (minType >> 8); hi <= (maxType >> 8); ++hi) {
+        const SDL_EventTypeBlock *block = SDL_EventQ.types[hi];
+        const Uint32 lo_min = (hi == (minType >> 8)) ? (minType & 0xFF) : 0;
+        const Uint32 lo_max = (hi == (maxType >> 8)) ? (maxType & 0xFF) : 0xFF;
+        Uint32 lo;
+
+        if (!block || !block->count) {
+            continue;
+        }
+        if (lo_min == 0 && lo_max == 0xFF) {
+            count += block->count;
+        } else {
+            for (lo = lo_min; lo <= lo_max; ++lo) {
+                count += block->counts[lo];
+            }
+        }
+    }
+
+    if (minType <= SDL_EVENT_POLL_SENTINEL && SDL_EVENT_POLL_SENTINEL <= maxType) {
+        const SDL_EventTypeBlock *block = SDL_EventQ.types[SDL_EVENT_POLL_SENTINEL >> 8];
+        if (block) {
+            count -= block->counts[SDL_EVENT_POLL_SENTINEL & 0xFF];
+        }
+    }
+    return count;
+}
+
+/* Append an already counted event to the linked list -- called with the queue locked */
+static SDL_bool SDL_LinkEvent(const SDL_Event *event, Uint64 queued)
+{
+    SDL_EventEntry *entry;
+    int count;
+
+    if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+        if (entry == NULL) {
+            return SDL_FALSE;
+        }
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+
+    SDL_copyp(&entry->event, event);
+    entry->queued = queued;
+
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+
+    count = SDL_AtomicGet(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+
+    ++SDL_last_event_id;
+
+    entry->id = SDL_last_event_id;
+    SDL_IndexEvent(entry);
+
+    return SDL_TRUE;
+}
+
+/* Push an event into the ring without locking, returns SDL_FALSE if the ring is full */
+static SDL_bool SDL_PushEventRing(const SDL_Event *event, Uint64 queued)
+{
+    SDL_EventRingSlot *ring = SDL_EventQ.ring;
+    Uint32 pos;
+
+    if (!ring) {
+        return SDL_FALSE;
+    }
+
+    pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue_pos);
+    for (;;) {
+        SDL_EventRingSlot *slot = &ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        const Sint32 diff = (Sint32)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+
+        if (diff == 0) {
+            /* The slot is free, try to claim it */
+            if (SDL_AtomicCAS(&SDL_EventQ.ring_enqueue_pos, (int)pos, (int)(pos + 1))) {
+                SDL_copyp(&slot->event, event);
+                slot->queued = queued;
+                SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+                return SDL_TRUE;
+            }
+        } else if (diff < 0) {
+            /* The consumer hasn't drained this slot yet, the ring is full */
+            return SDL_FALSE;
+        }
+        /* Another producer got here first, try the next position */
+        pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue_pos);
+    }
+}
+
+/* Move published events from the ring to the end of the linked list -- called with the queue locked
+
+   If wait is SDL_TRUE, this also waits for producers that claimed a slot but haven't filled it yet,
+   so that everything pushed to the ring before this call is in the list afterwards.
+ */
+static void SDL_DrainEventRing(SDL_bool wait)
+{
+    SDL_EventRingSlot *ring = SDL_EventQ.ring;
+    Uint32 end;
+    int spins = 0;
+
+    if (!ring) {
+        return;
+    }
+
+    end = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue_pos);
+    while (SDL_EventQ.ring_dequeue_pos != end) {
+        const Uint32 pos = SDL_EventQ.ring_dequeue_pos;
+        SDL_EventRingSlot *slot = &ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+
+        if ((Uint32)SDL_AtomicGet(&slot->sequence) != pos + 1) {
+            if (!wait) {
+                break;
+            }
+            /* A producer is in the middle of filling this slot */
+            if (++spins < 64) {
+                SDL_CPUPauseInstruction();
+            } else {
+                SDL_Delay(0);
+            }
+            continue;
+        }
+
+        if (!SDL_LinkEvent(&slot->event, slot->queued)) {
+            /* Out of memory, leave the rest in the ring for now */
+            break;
+        }
+        SDL_AtomicSet(&slot->sequence, (int)(pos + SDL_EVENT_RING_SIZE));
+        SDL_EventQ.ring_dequeue_pos = pos + 1;
+        spins = 0;
+    }
+}
+
+/* Move the samples collected in a frame into event memory and fill in the frame event -- called with the queue locked */
+static SDL_bool SDL_TakeEventFrame(SDL_EventFrame *frame, SDL_Event *event)
+{
+    const Uint8 *last;
+    Uint8 *samples;
+
+    if (frame->num_samples == 0) {
+        return SDL_FALSE;
+    }
+    if (!SDL_EventEnabled(frame->type)) {
+        frame->num_samples = 0;
+        return SDL_FALSE;
+    }
+
+    samples = (Uint8 *)SDL_AllocateEventMemory(frame->num_samples * frame->sample_size);
+    if (!samples) {
+        frame->num_samples = 0;
+        return SDL_FALSE;
+    }
+    SDL_memcpy(samples, frame->samples, frame->num_samples * frame->sample_size);
+    last = samples + (frame->num_samples - 1) * frame->sample_size;
+
+    SDL_zerop(event);
+    event->type = frame->type;
+    event->common.timestamp = ((const SDL_CommonEvent *)last)->timestamp;
+    if (frame->type == SDL_EVENT_FINGER_FRAME) {
+        event->tframe.num_samples = frame->num_samples;
+        event->tframe.samples = (const SDL_TouchFingerEvent *)samples;
+    } else {
+        event->pframe.num_samples = frame->num_samples;
+        event->pframe.samples = (const SDL_PenMotionEvent *)samples;
+    }
+    frame->num_samples = 0;
+    return SDL_TRUE;
+}
+
+/* Add a sample to a frame, returning SDL_FALSE if it should be queued on its own -- called with the queue locked */
+static SDL_bool SDL_AddEventFrameSample(SDL_EventFrame *frame, const SDL_Event *event)
+{
+    if (frame->num_samples == frame->max_samples) {
+        const int max_samples = frame->max_samples ? frame->max_samples * 2 : 16;
+        Uint8 *samples = (Uint8 *)SDL_realloc(frame->samples, max_samples * frame->sample_size);
+        if (!samples) {
+            return SDL_FALSE;
+        }
+        frame->samples = samples;
+        frame->max_samples = max_samples;
+    }
+    SDL_memcpy(frame->samples + frame->num_samples * frame->sample_size, event, frame->sample_size);
+    ++frame->num_samples;
+    return SDL_TRUE;
+}
+
+static int SDL_AddEvent(SDL_Event *event);
+
+/* Collect touch and pen motion into frames, returning SDL_TRUE if the event was added to one */
+static SDL_bool SDL_BatchEvent(const SDL_Event *event)
+{
+    SDL_EventFrame *frame = NULL;
+    SDL_Event frame_event;
+    SDL_bool batched = SDL_FALSE;
+    SDL_bool flushed;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_frames); ++i) {
+        if (event->type >= SDL_event_frames[i].first_type && event->type <= SDL_event_frames[i].last_type) {
+            frame = &SDL_event_frames[i];
+            break;
+        }
+    }
+    if (!frame) {
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        if (event->type == frame->sample_type && SDL_EventEnabled(frame->type)) {
+            if (event->type == SDL_EVENT_PEN_MOTION) {
+                SDL_RecordMotionHistory(event);
+            }
+            batched = SDL_AddEventFrameSample(frame, event);
+        }
+
+        /* Anything else for these devices ends the frame, so it stays in order with the samples */
+        if (batched && frame->num_samples < SDL_MAX_QUEUED_EVENTS) {
+            flushed = SDL_FALSE;
+        } else {
+            flushed = SDL_TakeEventFrame(frame, &frame_event);
+        }
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    if (flushed) {
+        SDL_AddEvent(&frame_event);
+    }
+    return batched;
+}
+
+/* Queue any partially collected frames */
+static void SDL_FlushEventFrames(void)
+{
+    SDL_Event frame_event;
+    SDL_bool flushed;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_frames); ++i) {
+        if (SDL_event_frames[i].num_samples == 0) {
+            continue;
+        }
+
+        SDL_LockMutex(SDL_EventQ.lock);
+        {
+            flushed = SDL_TakeEventFrame(&SDL_event_frames[i], &frame_event);
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        if (flushed) {
+            SDL_AddEvent(&frame_event);
+        }
+    }
+}
+
+/* Add an event to the event queue -- this doesn't take the queue lock unless the ring is full */
+static int SDL_AddEvent(SDL_Event *event)
+{
+    int initial_count;
+    Uint64 queued;
+    SDL_bool added;
+
+    if (SDL_batch_touch && SDL_BatchEvent(event)) {
+        return 1;
+    }
+
+    initial_count = SDL_AtomicAdd(&SDL_EventQ.count, 1);
+    queued = SDL_event_latency_callback ? SDL_GetTicksNS() : 0;
+
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+    }
+
+    if ((event->type == SDL_EVENT_MOUSE_MOTION || event->type == SDL_EVENT_PEN_MOTION) &&
+        (SDL_coalesce_motion || SDL_motion_history.capacity > 0)) {
+        /* Motion needs to look at the end of the queue, so it goes straight to the linked list */
+        SDL_bool coalesced = SDL_FALSE;
+
+        SDL_LockMutex(SDL_EventQ.lock);
+        {
+            SDL_RecordMotionHistory(event);
+            SDL_DrainEventRing(SDL_TRUE);
+            if (SDL_coalesce_motion && SDL_EventQ.tail) {
+                coalesced = SDL_CoalesceMotionEvent(&SDL_EventQ.tail->event, event);
+            }
+            added = coalesced ? SDL_TRUE : SDL_LinkEvent(event, queued);
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        if (coalesced) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            return 1;
+        }
+    } else if (SDL_PushEventRing(event, queued)) {
+        return 1;
+    } else {
+        /* The ring is full, so fall back to the linked list, after whatever is already in the ring */
+        SDL_LockMutex(SDL_EventQ.lock);
+        {
+            SDL_DrainEventRing(SDL_TRUE);
+            added = SDL_LinkEvent(event, queued);
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+
+    if (!added) {
+        if (event->type == SDL_EVENT_POLL_SENTINEL) {
+            SDL_AtomicAdd(&SDL_sentinel_pending, -1);
+        }
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        return 0;
+    }
+    return 1;
+}
+
+/* Report an event being retrieved to the latency callback -- called with the queue locked */
+static void SDL_TraceEventLatency(const SDL_EventEntry *entry)
+{
+    if (SDL_event_latency_callback && entry->queued) {
+        SDL_event_latency_callback(SDL_event_latency_userdata, &entry->event, entry->queued, SDL_GetTicksNS());
+    }
+}
+
+/* Remove an event from the queue -- called with the queue locked */
+static void SDL_CutEvent(SDL_EventEntry *entry)
+{
+    SDL_UnindexEvent(entry);
+
     if (entry->prev) {
         entry->prev->next = entry->next;
     }
@@ -802,9 +1856,26 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
 {
     int i, used, sentinels_expected = 0;
 
-    /* Lock the event queue */
     used = 0;
 
+    /* Adding events doesn't need the lock, they go through the ring buffer */
+    if (action == SDL_ADDEVENT) {
+        /* Don't add after we've quit, SDL_StopEventLoop() waits for us to leave */
+        if (SDL_AtomicAdd(&SDL_EventQ.producers, 1) & SDL_EVENT_PRODUCERS_CLOSED) {
+            SDL_AtomicAdd(&SDL_EventQ.producers, -1);
+            return -1;
+        }
+        for (i = 0; i < numevents; ++i) {
+            used += SDL_AddEvent(&events[i]);
+        }
+        SDL_AtomicAdd(&SDL_EventQ.producers, -1);
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        return used;
+    }
+
+    /* Lock the event queue */
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
@@ -816,50 +1887,49 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
-            }
+        SDL_DrainEventRing(SDL_FALSE);
+
+        if (events == NULL && !include_sentinel && SDL_EventQ.unindexed == 0 && maxType <= 0xFFFF) {
+            /* Just counting, which the per-type index can do without looking at the events */
+            used = (minType <= maxType) ? SDL_CountEventsInRange(minType, maxType) : 0;
         } else {
-            SDL_EventEntry *entry, *next;
+            SDL_EventIterator iter;
+            SDL_EventEntry *entry;
             Uint32 type;
 
-            for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
-                next = entry->next;
+            SDL_StartEventIterator(&iter, minType, maxType);
+            while ((events == NULL || used < numevents) && (entry = SDL_NextEvent(&iter)) != NULL) {
                 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        SDL_copyp(&events[used], &entry->event);
+                if (events) {
+                    SDL_copyp(&events[used], &entry->event);
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
+                    if (action == SDL_GETEVENT) {
+                        if (type != SDL_EVENT_POLL_SENTINEL) {
+                            SDL_TraceEventLatency(entry);
                         }
+                        SDL_CutEvent(entry);
                     }
-                    if (type == SDL_EVENT_POLL_SENTINEL) {
-                        /* Special handling for the sentinel event */
-                        if (!include_sentinel) {
-                            /* Skip it, we don't want to include it */
-                            continue;
-                        }
-                        if (events == NULL || action != SDL_GETEVENT) {
-                            ++sentinels_expected;
-                        }
-                        if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
-                            /* Skip it, there's another one pending */
-                            continue;
-                        }
+                }
+                if (type == SDL_EVENT_POLL_SENTINEL) {
+                    /* Special handling for the sentinel event */
+                    if (!include_sentinel) {
+                        /* Skip it, we don't want to include it */
+                        continue;
+                    }
+                    if (events == NULL || action != SDL_GETEVENT) {
+                        ++sentinels_expected;
+                    }
+                    if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
+                        /* Skip it, there's another one pending */
+                        continue;
                     }
-                    ++used;
                 }
+                ++used;
             }
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 
-    if (used > 0 && action == SDL_ADDEVENT) {
-        SDL_SendWakeupEvent();
-    }
-
     return used;
 }
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_eventaction action,
@@ -885,8 +1955,8 @@ void SDL_FlushEvent(Uint32 type)
 
 void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 {
-    SDL_EventEntry *entry, *next;
-    Uint32 type;
+    SDL_EventIterator iter;
+    SDL_EventEntry *entry;
 
     /* Make sure the events are current */
 #if 0
@@ -904,12 +1974,10 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
-            }
+        SDL_DrainEventRing(SDL_FALSE);
+        SDL_StartEventIterator(&iter, minType, maxType);
+        while ((entry = SDL_NextEvent(&iter)) != NULL) {
+            SDL_CutEvent(entry);
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -920,6 +1988,8 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
 {
     SDL_VideoDevice *_this = SDL_GetVideoDevice();
 
+    SDL_TRACE_BEGIN("SDL_PumpEvents");
+
     /* Free old event memory */
     /*SDL_FlushEventMemory(SDL_last_event_id - SDL_MAX_QUEUED_EVENTS);*/
     if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
@@ -940,20 +2010,23 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
 
 #ifndef SDL_SENSOR_DISABLED
     /* Check for sensor state change */
-    if (SDL_update_sensors) {
+    if (SDL_update_sensors && !SDL_input_thread.thread) {
         SDL_UpdateSensors();
     }
 #endif
 
 #ifndef SDL_JOYSTICK_DISABLED
     /* Check for joystick state change */
-    if (SDL_update_joysticks) {
+    if (SDL_update_joysticks && !SDL_input_thread.thread) {
         SDL_UpdateJoysticks();
     }
 #endif
 
     SDL_SendPendingSignalEvents(); /* in case we had a signal handler fire, etc. */
 
+    /* Queue the touch and pen motion collected during this pump */
+    SDL_FlushEventFrames();
+
     if (push_sentinel && SDL_EventEnabled(SDL_EVENT_POLL_SENTINEL)) {
         SDL_Event sentinel;
 
@@ -966,6 +2039,9 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
         sentinel.common.timestamp = 0;
         SDL_PushEvent(&sentinel);
     }
+
+    SDL_TRACE_COUNTER("Queued events", SDL_AtomicGet(&SDL_EventQ.count));
+    SDL_TRACE_END("SDL_PumpEvents");
 }
 
 void SDL_PumpEvents(void)
@@ -980,12 +2056,60 @@ SDL_bool SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeoutNS(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    SDL_EventEntry *entry, *next;
+    int used = 0;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents < 0) {
+        return SDL_InvalidParamError("numevents");
+    }
+
+    /* If there isn't a poll sentinel event pending, pump events and add one */
+    if (SDL_AtomicGet(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(SDL_TRUE);
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        if (!SDL_EventQ.active) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            return SDL_SetError("The event system has been shut down");
+        }
+
+        SDL_DrainEventRing(SDL_FALSE);
+
+        for (entry = SDL_EventQ.head; entry && used < numevents; entry = next) {
+            next = entry->next;
+            if (entry->event.type == SDL_EVENT_POLL_SENTINEL) {
+                SDL_CutEvent(entry);
+                if (SDL_AtomicGet(&SDL_sentinel_pending) == 0) {
+                    /* Reached the end of a poll cycle */
+                    break;
+                }
+                /* There's another one pending, keep going */
+                continue;
+            }
+            SDL_copyp(&events[used++], &entry->event);
+            SDL_TraceEventLatency(entry);
+            SDL_CutEvent(entry);
+        }
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return used;
+}
+
 static SDL_bool SDL_events_need_periodic_poll(void)
 {
     SDL_bool need_periodic_poll = SDL_FALSE;
 
 #ifndef SDL_JOYSTICK_DISABLED
-    need_periodic_poll = SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks;
+    need_periodic_poll = SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks && !SDL_input_thread.thread &&
+                         SDL_JoysticksNeedPeriodicPoll();
 #endif
 
     return need_periodic_poll;
@@ -1063,8 +2187,13 @@ static SDL_bool SDL_events_need_polling(void)
 {
     SDL_bool need_polling = SDL_FALSE;
 
+    if (SDL_input_thread.thread) {
+        /* The input thread wakes us up when it adds events */
+        return SDL_FALSE;
+    }
+
 #ifndef SDL_JOYSTICK_DISABLED
-    need_polling = SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks && SDL_JoysticksOpened();
+    need_polling = SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks && SDL_JoysticksNeedPolling();
 #endif
 
 #ifndef SDL_SENSOR_DISABLED
@@ -1196,46 +2325,70 @@ SDL_bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
     }
 }
 
+int SDL_GetMotionHistory(SDL_Event *events, int numevents)
+{
+    int i, count;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents < 0) {
+        return SDL_InvalidParamError("numevents");
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        count = SDL_min(numevents, SDL_motion_history.count);
+        for (i = 0; i < count; ++i) {
+            SDL_copyp(&events[i], &SDL_motion_history.events[SDL_motion_history.first]);
+            SDL_motion_history.first = (SDL_motion_history.first + 1) % SDL_motion_history.capacity;
+        }
+        SDL_motion_history.count -= count;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return count;
+}
+
+void SDL_SetEventLatencyCallback(SDL_EventLatencyCallback callback, void *userdata)
+{
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        SDL_event_latency_callback = callback;
+        SDL_event_latency_userdata = userdata;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
 int SDL_PushEvent(SDL_Event *event)
 {
     if (!event->common.timestamp) {
         event->common.timestamp = SDL_GetTicksNS();
     }
 
-    if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
-        SDL_LockMutex(SDL_event_watchers_lock);
-        {
-            if (SDL_EventOK.callback && !SDL_EventOK.callback(SDL_EventOK.userdata, event)) {
-                SDL_UnlockMutex(SDL_event_watchers_lock);
+    if (SDL_AtomicGetPtr((void **)&SDL_event_watchers)) {
+        SDL_EventWatcherList *list;
+
+        /* Announce the dispatch before looking at the snapshot, so it isn't freed underneath us */
+        SDL_AtomicIncRef(&SDL_event_watchers_readers);
+        list = (SDL_EventWatcherList *)SDL_AtomicGetPtr((void **)&SDL_event_watchers);
+        if (list) {
+            const Uint32 type = event->type;
+            int i;
+
+            if (list->filter && !list->filter(list->filter_userdata, event)) {
+                SDL_ReleaseEventWatchers();
                 return 0;
             }
 
-            if (SDL_event_watchers_count > 0) {
-                /* Make sure we only dispatch the current watcher list */
-                int i, event_watchers_count = SDL_event_watchers_count;
-
-                SDL_event_watchers_dispatching = SDL_TRUE;
-                for (i = 0; i < event_watchers_count; ++i) {
-                    if (!SDL_event_watchers[i].removed) {
-                        SDL_event_watchers[i].callback(SDL_event_watchers[i].userdata, event);
-                    }
-                }
-                SDL_event_watchers_dispatching = SDL_FALSE;
-
-                if (SDL_event_watchers_removed) {
-                    for (i = SDL_event_watchers_count; i--;) {
-                        if (SDL_event_watchers[i].removed) {
-                            --SDL_event_watchers_count;
-                            if (i < SDL_event_watchers_count) {
-                                SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
-                            }
-                        }
-                    }
-                    SDL_event_watchers_removed = SDL_FALSE;
+            for (i = 0; i < list->count; ++i) {
+                SDL_EventWatcher *watcher = list->watchers[i];
+                if (type >= watcher->minType && type <= watcher->maxType && !SDL_AtomicGet(&watcher->removed)) {
+                    watcher->callback(watcher->userdata, event);
                 }
             }
         }
-        SDL_UnlockMutex(SDL_event_watchers_lock);
+        SDL_ReleaseEventWatchers();
     }
 
     if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
@@ -1250,8 +2403,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_event_watchers_lock);
     {
         /* Set filter and discard pending events */
-        SDL_EventOK.callback = filter;
-        SDL_EventOK.userdata = userdata;
+        SDL_PublishEventWatchers(filter, userdata, NULL);
         SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
     }
     SDL_UnlockMutex(SDL_event_watchers_lock);
@@ -1259,48 +2411,58 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 
 SDL_bool SDL_GetEventFilter(SDL_EventFilter *filter, void **userdata)
 {
-    SDL_EventWatcher event_ok;
+    SDL_EventFilter event_ok = NULL;
+    void *event_ok_userdata = NULL;
 
     SDL_LockMutex(SDL_event_watchers_lock);
     {
-        event_ok = SDL_EventOK;
+        if (SDL_event_watchers) {
+            event_ok = SDL_event_watchers->filter;
+            event_ok_userdata = SDL_event_watchers->filter_userdata;
+        }
     }
     SDL_UnlockMutex(SDL_event_watchers_lock);
 
     if (filter) {
-        *filter = event_ok.callback;
+        *filter = event_ok;
     }
     if (userdata) {
-        *userdata = event_ok.userdata;
+        *userdata = event_ok_userdata;
     }
-    return event_ok.callback ? SDL_TRUE : SDL_FALSE;
+    return event_ok ? SDL_TRUE : SDL_FALSE;
 }
 
 int SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
 {
-    int result = 0;
+    return SDL_AddEventWatchRange(filter, userdata, 0, 0xFFFFFFFF);
+}
+
+int SDL_AddEventWatchRange(SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType)
+{
+    SDL_EventWatcher *watcher;
+    int result;
+
+    watcher = (SDL_EventWatcher *)SDL_malloc(sizeof(*watcher));
+    if (watcher == NULL) {
+        return SDL_OutOfMemory();
+    }
+    watcher->callback = filter;
+    watcher->userdata = userdata;
+    watcher->minType = minType;
+    watcher->maxType = maxType;
+    SDL_AtomicSet(&watcher->removed, 0);
+    watcher->next_removed = NULL;
 
     SDL_LockMutex(SDL_event_watchers_lock);
     {
-        SDL_EventWatcher *event_watchers;
-
-        event_watchers = SDL_realloc(SDL_event_watchers, (SDL_event_watchers_count + 1) * sizeof(*event_watchers));
-        if (event_watchers) {
-            SDL_EventWatcher *watcher;
-
-            SDL_event_watchers = event_watchers;
-            watcher = &SDL_event_watchers[SDL_event_watchers_count];
-            watcher->callback = filter;
-            watcher->userdata = userdata;
-            watcher->removed = SDL_FALSE;
-            ++SDL_event_watchers_count;
-        } else {
-            SDL_OutOfMemory();
-            result = -1;
-        }
+        SDL_EventWatcherList *current = SDL_event_watchers;
+        result = SDL_PublishEventWatchers(current ? current->filter : NULL, current ? current->filter_userdata : NULL, watcher);
     }
     SDL_UnlockMutex(SDL_event_watchers_lock);
 
+    if (result < 0) {
+        SDL_free(watcher);
+    }
     return result;
 }
 
@@ -1308,20 +2470,19 @@ void SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
 {
     SDL_LockMutex(SDL_event_watchers_lock);
     {
+        SDL_EventWatcherList *current = SDL_event_watchers;
         int i;
 
-        for (i = 0; i < SDL_event_watchers_count; ++i) {
-            if (SDL_event_watchers[i].callback == filter && SDL_event_watchers[i].userdata == userdata) {
-                if (SDL_event_watchers_dispatching) {
-                    SDL_event_watchers[i].removed = SDL_TRUE;
-                    SDL_event_watchers_removed = SDL_TRUE;
-                } else {
-                    --SDL_event_watchers_count;
-                    if (i < SDL_event_watchers_count) {
-                        SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
-                    }
+        if (current) {
+            for (i = 0; i < current->count; ++i) {
+                SDL_EventWatcher *watcher = current->watchers[i];
+                if (watcher->callback == filter && watcher->userdata == userdata && !SDL_AtomicGet(&watcher->removed)) {
+                    /* Dispatches in progress skip it from now on, and if publishing
+                       fails it's left out the next time the watchers change */
+                    SDL_AtomicSet(&watcher->removed, 1);
+                    SDL_PublishEventWatchers(current->filter, current->filter_userdata, NULL);
+                    break;
                 }
-                break;
             }
         }
     }
@@ -1333,10 +2494,16 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+
+        SDL_DrainEventRing(SDL_FALSE);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
                 SDL_CutEvent(entry);
+            } else if (entry->event.type != entry->indexed_type) {
+                /* The filter changed the event type, file it under the new one */
+                SDL_UnindexEvent(entry);
+                SDL_IndexEvent(entry);
             }
         }
     }
@@ -1471,6 +2638,10 @@ int SDL_InitEvents(void)
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return -1;
     }
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_BATCH_TOUCH, SDL_BatchTouchChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_MOTION_HISTORY, SDL_MotionHistoryChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_INPUT_THREAD, SDL_InputThreadChanged, NULL);
 
     SDL_InitQuit();
 
@@ -1480,6 +2651,11 @@ int SDL_InitEvents(void)
 void SDL_QuitEvents(void)
 {
     SDL_QuitQuit();
+    SDL_DelHintCallback(SDL_HINT_EVENT_INPUT_THREAD, SDL_InputThreadChanged, NULL);
+    SDL_StopInputThread();
+    SDL_DelHintCallback(SDL_HINT_EVENT_MOTION_HISTORY, SDL_MotionHistoryChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_BATCH_TOUCH, SDL_BatchTouchChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_StopEventLoop();
     SDL_DelHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
@@ -50,6 +50,18 @@ extern int SDL_SendQuit(void);
 extern int SDL_InitEvents(void);
 extern void SDL_QuitEvents(void);
 
+/* File descriptors of joystick devices and hotplug notifications.
+   Video backends that wait on a file descriptor also wake up when these are readable,
+   so SDL_WaitEvent() doesn't need to poll joysticks. */
+#define SDL_MAX_EVENT_WAKEUP_FDS 32
+extern int SDL_AddEventWakeupFD(int fd);
+extern void SDL_DelEventWakeupFD(int fd);
+extern int SDL_GetEventWakeupFDs(int *fds, int maxfds);
+
+/* Keep the input thread from updating devices, while their subsystem shuts down */
+extern void SDL_LockInputThread(void);
+extern void SDL_UnlockInputThread(void);
+
 extern void SDL_SendPendingSignalEvents(void);
 
 extern int SDL_InitQuit(void);
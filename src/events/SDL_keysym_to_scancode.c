@@ -387,52 +387,134 @@ static const struct {
 };
 /* *INDENT-ON* */ /* clang-format on */
 
-SDL_Scancode SDL_GetScancodeFromKeySym(Uint32 keysym, Uint32 keycode)
+/* All the keysyms in the tables above, sorted so they can be found with a binary search */
+typedef struct
 {
+    Uint32 keysym;
+    SDL_Scancode custom_scancode; /* from KeySymToSDLScancode */
+    Uint32 linux_keycode;         /* from the Linux keycode tables, 0 if not found */
+} SDL_KeySymIndexEntry;
+
+static SDL_KeySymIndexEntry keysym_index[SDL_arraysize(KeySymToSDLScancode) +
+                                         SDL_arraysize(LinuxKeycodeKeysyms) +
+                                         SDL_arraysize(ExtendedLinuxKeycodeKeysyms)];
+static int keysym_index_count;
+static SDL_bool keysym_index_initialized;
+
+static int SDLCALL CompareKeySymIndexEntries(const void *a, const void *b)
+{
+    const SDL_KeySymIndexEntry *A = (const SDL_KeySymIndexEntry *)a;
+    const SDL_KeySymIndexEntry *B = (const SDL_KeySymIndexEntry *)b;
+
+    if (A->keysym < B->keysym) {
+        return -1;
+    } else if (A->keysym > B->keysym) {
+        return 1;
+    }
+    return 0;
+}
+
+static SDL_KeySymIndexEntry *FindKeySym(Uint32 keysym)
+{
+    int lo = 0;
+    int hi = keysym_index_count - 1;
+
+    while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        if (keysym_index[mid].keysym < keysym) {
+            lo = mid + 1;
+        } else if (keysym_index[mid].keysym > keysym) {
+            hi = mid - 1;
+        } else {
+            return &keysym_index[mid];
+        }
+    }
+    return NULL;
+}
+
+static SDL_KeySymIndexEntry *AddKeySym(Uint32 keysym)
+{
+    SDL_KeySymIndexEntry *entry;
     int i;
-    Uint32 linux_keycode = 0;
 
-    /* First check our custom list */
+    /* The index is only sorted once it's complete */
+    for (i = 0; i < keysym_index_count; ++i) {
+        if (keysym_index[i].keysym == keysym) {
+            return &keysym_index[i];
+        }
+    }
+
+    entry = &keysym_index[keysym_index_count++];
+    entry->keysym = keysym;
+    entry->custom_scancode = SDL_SCANCODE_UNKNOWN;
+    entry->linux_keycode = 0;
+    return entry;
+}
+
+static void InitKeySymIndex(void)
+{
+    SDL_KeySymIndexEntry *entry;
+    int i;
+
+    /* Earlier entries take precedence, matching the order the tables used to be searched in */
     for (i = 0; i < SDL_arraysize(KeySymToSDLScancode); ++i) {
-        if (keysym == KeySymToSDLScancode[i].keysym) {
-            return KeySymToSDLScancode[i].scancode;
+        entry = AddKeySym(KeySymToSDLScancode[i].keysym);
+        if (entry->custom_scancode == SDL_SCANCODE_UNKNOWN) {
+            entry->custom_scancode = KeySymToSDLScancode[i].scancode;
+        }
+    }
+    for (i = 0; i < SDL_arraysize(LinuxKeycodeKeysyms); ++i) {
+        if (LinuxKeycodeKeysyms[i]) {
+            entry = AddKeySym(LinuxKeycodeKeysyms[i]);
+            if (!entry->linux_keycode) {
+                entry->linux_keycode = i;
+            }
+        }
+    }
+    for (i = 0; i < SDL_arraysize(ExtendedLinuxKeycodeKeysyms); ++i) {
+        entry = AddKeySym(ExtendedLinuxKeycodeKeysyms[i].keysym);
+        if (!entry->linux_keycode) {
+            entry->linux_keycode = ExtendedLinuxKeycodeKeysyms[i].linux_keycode;
         }
     }
 
+    SDL_qsort(keysym_index, keysym_index_count, sizeof(*keysym_index), CompareKeySymIndexEntries);
+    keysym_index_initialized = SDL_TRUE;
+}
+
+SDL_Scancode SDL_GetScancodeFromKeySym(Uint32 keysym, Uint32 keycode)
+{
+    const SDL_KeySymIndexEntry *entry;
+    Uint32 i;
+
+    if (!keysym_index_initialized) {
+        InitKeySymIndex();
+    }
+
+    /* First check our custom list */
+    entry = FindKeySym(keysym);
+    if (entry && entry->custom_scancode != SDL_SCANCODE_UNKNOWN) {
+        return entry->custom_scancode;
+    }
+
     if (keysym >= 0x41 && keysym <= 0x5a) {
         /* Normalize alphabetic keysyms to the lowercase form */
         keysym += 0x20;
+        entry = FindKeySym(keysym);
     } else if (keysym >= 0x10081000 && keysym <= 0x10081FFF) {
         /* The rest of the keysyms map to Linux keycodes, so use that mapping
          * Per xkbcommon-keysyms.h, this is actually a linux keycode.
          */
-        linux_keycode = (keysym - 0x10081000);
-    }
-    if (!linux_keycode) {
-        /* See if this keysym is an exact match in our table */
-        i = (keycode - 8);
-        if (i >= 0 && i < SDL_arraysize(LinuxKeycodeKeysyms) && keysym == LinuxKeycodeKeysyms[i]) {
-            linux_keycode = i;
-        } else {
-            /* Scan the table for this keysym */
-            for (i = 0; i < SDL_arraysize(LinuxKeycodeKeysyms); ++i) {
-                if (keysym == LinuxKeycodeKeysyms[i]) {
-                    linux_keycode = i;
-                    break;
-                }
-            }
-        }
+        return SDL_GetScancodeFromTable(SDL_SCANCODE_TABLE_LINUX, (keysym - 0x10081000));
     }
-    if (!linux_keycode) {
-        /* Scan the extended table for this keysym */
-        for (i = 0; i < SDL_arraysize(ExtendedLinuxKeycodeKeysyms); ++i) {
-            if (keysym == ExtendedLinuxKeycodeKeysyms[i].keysym) {
-                linux_keycode = ExtendedLinuxKeycodeKeysyms[i].linux_keycode;
-                break;
-            }
-        }
+
+    /* See if this keysym is an exact match in our table */
+    i = (keycode - 8);
+    if (i < SDL_arraysize(LinuxKeycodeKeysyms) && keysym == LinuxKeycodeKeysyms[i] && i != 0) {
+        return SDL_GetScancodeFromTable(SDL_SCANCODE_TABLE_LINUX, i);
     }
-    return SDL_GetScancodeFromTable(SDL_SCANCODE_TABLE_LINUX, linux_keycode);
+
+    return SDL_GetScancodeFromTable(SDL_SCANCODE_TABLE_LINUX, entry ? entry->linux_keycode : 0);
 }
 
 #endif /* SDL_VIDEO_DRIVER_WAYLAND */
@@ -105,13 +105,63 @@ SDL_TouchDeviceType SDL_GetTouchDeviceType(SDL_TouchID id)
     return SDL_TOUCH_DEVICE_INVALID;
 }
 
+static Uint32 SDL_HashFingerID(SDL_FingerID fingerid)
+{
+    /* Fibonacci hashing, finger IDs are often small sequential numbers */
+    return (Uint32)(((Uint64)fingerid * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+/* Rebuild the finger lookup table after fingers are added or removed */
+static int SDL_RebuildFingerHash(SDL_Touch *touch)
+{
+    int i, size = touch->finger_hash_size;
+
+    if (size < touch->num_fingers * 2) {
+        int *finger_hash;
+
+        if (size == 0) {
+            size = 16;
+        }
+        while (size < touch->num_fingers * 2) {
+            size *= 2;
+        }
+        finger_hash = (int *)SDL_realloc(touch->finger_hash, size * sizeof(*finger_hash));
+        if (!finger_hash) {
+            return SDL_OutOfMemory();
+        }
+        touch->finger_hash = finger_hash;
+        touch->finger_hash_size = size;
+    }
+
+    for (i = 0; i < size; ++i) {
+        touch->finger_hash[i] = -1;
+    }
+    for (i = 0; i < touch->num_fingers; ++i) {
+        Uint32 slot = SDL_HashFingerID(touch->fingers[i]->id) & (size - 1);
+        while (touch->finger_hash[slot] >= 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        touch->finger_hash[slot] = i;
+    }
+    return 0;
+}
+
 static int SDL_GetFingerIndex(const SDL_Touch *touch, SDL_FingerID fingerid)
 {
+    const Uint32 mask = (Uint32)touch->finger_hash_size - 1;
+    Uint32 slot;
     int index;
-    for (index = 0; index < touch->num_fingers; ++index) {
+
+    if (touch->num_fingers == 0) {
+        return -1;
+    }
+
+    slot = SDL_HashFingerID(fingerid) & mask;
+    while ((index = touch->finger_hash[slot]) >= 0) {
         if (touch->fingers[index]->id == fingerid) {
             return index;
         }
+        slot = (slot + 1) & mask;
     }
     return -1;
 }
@@ -181,6 +231,8 @@ int SDL_AddTouch(SDL_TouchID touchID, SDL_TouchDeviceType type, const char *name
     SDL_touchDevices[index]->num_fingers = 0;
     SDL_touchDevices[index]->max_fingers = 0;
     SDL_touchDevices[index]->fingers = NULL;
+    SDL_touchDevices[index]->finger_hash = NULL;
+    SDL_touchDevices[index]->finger_hash_size = 0;
     SDL_touchDevices[index]->name = SDL_strdup(name ? name : "");
 
     return index;
@@ -209,6 +261,11 @@ static int SDL_AddFinger(SDL_Touch *touch, SDL_FingerID fingerid, float x, float
     finger->x = x;
     finger->y = y;
     finger->pressure = pressure;
+
+    if (SDL_RebuildFingerHash(touch) < 0) {
+        touch->num_fingers--;
+        return -1;
+    }
     return 0;
 }
 
@@ -225,6 +282,9 @@ static int SDL_DelFinger(SDL_Touch *touch, SDL_FingerID fingerid)
     temp = touch->fingers[index];
     touch->fingers[index] = touch->fingers[touch->num_fingers];
     touch->fingers[touch->num_fingers] = temp;
+
+    /* This never grows the table, so it can't fail */
+    SDL_RebuildFingerHash(touch);
     return 0;
 }
 
@@ -469,6 +529,7 @@ void SDL_DelTouch(SDL_TouchID id)
         SDL_free(touch->fingers[i]);
     }
     SDL_free(touch->fingers);
+    SDL_free(touch->finger_hash);
     SDL_free(touch->name);
     SDL_free(touch);
 
@@ -30,6 +30,8 @@ typedef struct SDL_Touch
     int num_fingers;
     int max_fingers;
     SDL_Finger **fingers;
+    int *finger_hash; /* open addressing table of indices into fingers, -1 for empty slots */
+    int finger_hash_size;
     char *name;
 } SDL_Touch;
 
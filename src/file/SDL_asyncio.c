@@ -0,0 +1,865 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_asyncio_c.h"
+
+#ifdef __LINUX__
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SDL_ASYNCIO_FD
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(IORING_FEAT_NODROP) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define SDL_ASYNCIO_IO_URING
+#endif
+#endif
+#endif /* __LINUX__ */
+
+/* Asynchronous file I/O
+
+   Tasks are collected from the queue their results go to. On Linux each
+   queue has its own io_uring if the kernel supports it, otherwise tasks run
+   on a small, shared pool of I/O threads doing blocking reads and writes, so
+   the number of threads doesn't grow with the number of tasks in flight.
+
+   Each file holds a reference for every task in flight, plus one until it's
+   closed. Whoever drops the last reference queues the close, so a close
+   always happens after the file's other tasks have finished. */
+
+/* Enough to keep a few devices busy, the work is waiting, not computing */
+#define SDL_ASYNCIO_THREADS 4
+
+/* Reads and writes are split into pieces of at most this size */
+#define SDL_ASYNCIO_MAX_CHUNK (1024 * 1024 * 1024)
+
+typedef struct SDL_AsyncIOTask
+{
+    SDL_AsyncIOOutcome outcome;
+    SDL_AsyncIOQueue *queue;
+#ifdef SDL_ASYNCIO_IO_URING
+    struct iovec iov;
+#endif
+    struct SDL_AsyncIOTask *next;
+} SDL_AsyncIOTask;
+
+struct SDL_AsyncIO
+{
+#ifdef SDL_ASYNCIO_FD
+    int fd;
+#else
+    SDL_RWops *rwops;
+    SDL_Mutex *lock; /* Seeking and reading or writing have to happen together */
+#endif
+    SDL_bool closing;
+    SDL_AtomicInt refcount;
+    SDL_AsyncIOTask *close_task;
+};
+
+#ifdef SDL_ASYNCIO_IO_URING
+typedef struct SDL_IOUring
+{
+    int fd;
+    SDL_Mutex *sq_lock; /* Tasks can be started from any thread */
+    SDL_Mutex *cq_lock; /* Results can be collected from any thread */
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    struct io_uring_cqe *cqes;
+    unsigned cq_mask;
+    unsigned cq_entries;
+    SDL_AtomicInt inflight; /* Tasks submitted that haven't been reaped */
+} SDL_IOUring;
+
+#define SDL_IO_URING_ENTRIES 256
+#endif /* SDL_ASYNCIO_IO_URING */
+
+struct SDL_AsyncIOQueue
+{
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_AsyncIOTask *head; /* Finished tasks, oldest first */
+    SDL_AsyncIOTask *tail;
+    SDL_AtomicInt pending; /* Tasks started that haven't been collected */
+    SDL_AtomicInt signals; /* Counts calls to SDL_SignalAsyncIOQueue() */
+    SDL_AtomicInt waiters;
+#ifdef SDL_ASYNCIO_IO_URING
+    SDL_IOUring *ring; /* NULL if tasks run on the I/O threads */
+#endif
+};
+
+static SDL_SpinLock SDL_asyncio_lock;
+static SDL_ThreadPool *SDL_asyncio_pool;
+
+static SDL_ThreadPool *SDL_GetAsyncIOPool(void)
+{
+    SDL_ThreadPool *pool;
+
+    SDL_AtomicLock(&SDL_asyncio_lock);
+    if (!SDL_asyncio_pool) {
+        SDL_asyncio_pool = SDL_CreateThreadPool(SDL_ASYNCIO_THREADS, NULL);
+    }
+    pool = SDL_asyncio_pool;
+    SDL_AtomicUnlock(&SDL_asyncio_lock);
+
+    return pool;
+}
+
+/* Blocking file operations */
+
+static SDL_bool SDL_TransferFileData(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIO *asyncio = task->outcome.asyncio;
+    const SDL_bool reading = (task->outcome.type == SDL_ASYNCIO_TASK_READ);
+    Uint8 *ptr = (Uint8 *)task->outcome.buffer;
+    SDL_bool failed = SDL_FALSE;
+    Uint64 done = 0;
+
+#ifdef SDL_ASYNCIO_FD
+    while (done < task->outcome.bytes_requested) {
+        const size_t chunk = (size_t)SDL_min(task->outcome.bytes_requested - done, SDL_ASYNCIO_MAX_CHUNK);
+        const off_t offset = (off_t)(task->outcome.offset + done);
+        ssize_t result;
+
+        if (reading) {
+            result = pread(asyncio->fd, ptr + done, chunk, offset);
+        } else {
+            result = pwrite(asyncio->fd, ptr + done, chunk, offset);
+        }
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = SDL_TRUE;
+            break;
+        } else if (result == 0) {
+            break; /* End of file */
+        }
+        done += (Uint64)result;
+    }
+#else
+    SDL_LockMutex(asyncio->lock);
+    if (SDL_RWseek(asyncio->rwops, (Sint64)task->outcome.offset, SDL_RW_SEEK_SET) != (Sint64)task->outcome.offset) {
+        failed = SDL_TRUE;
+    } else {
+        while (done < task->outcome.bytes_requested) {
+            const size_t chunk = (size_t)SDL_min(task->outcome.bytes_requested - done, SDL_ASYNCIO_MAX_CHUNK);
+            size_t result;
+
+            if (reading) {
+                result = SDL_RWread(asyncio->rwops, ptr + done, chunk);
+            } else {
+                result = SDL_RWwrite(asyncio->rwops, ptr + done, chunk);
+            }
+            if (result == 0) {
+                if (!reading || asyncio->rwops->status == SDL_RWOPS_STATUS_ERROR) {
+                    failed = SDL_TRUE;
+                }
+                break;
+            }
+            done += result;
+        }
+    }
+    SDL_UnlockMutex(asyncio->lock);
+#endif
+
+    task->outcome.bytes_transferred = done;
+    return !failed;
+}
+
+static SDL_bool SDL_CloseFile(SDL_AsyncIO *asyncio)
+{
+    int result;
+
+#ifdef SDL_ASYNCIO_FD
+    result = close(asyncio->fd);
+#else
+    result = SDL_RWclose(asyncio->rwops);
+    SDL_DestroyMutex(asyncio->lock);
+#endif
+    SDL_free(asyncio);
+
+    return (result == 0);
+}
+
+/* Adds a finished task to its queue */
+static void SDL_CompleteTask(SDL_AsyncIOTask *task);
+
+static void SDLCALL SDL_RunAsyncIOTask(void *userdata);
+
+static void SDL_ReleaseAsyncIO(SDL_AsyncIO *asyncio)
+{
+    if (SDL_AtomicDecRef(&asyncio->refcount)) {
+        /* Everything else has finished, closing may block so do it on an I/O thread */
+        SDL_ThreadPool *pool = SDL_GetAsyncIOPool();
+        SDL_AsyncIOTask *task = asyncio->close_task;
+
+        if (!pool || SDL_SubmitJob(pool, SDL_RunAsyncIOTask, task, NULL, NULL) < 0) {
+            SDL_RunAsyncIOTask(task);
+        }
+    }
+}
+
+static void SDLCALL SDL_RunAsyncIOTask(void *userdata)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *)userdata;
+    SDL_AsyncIO *asyncio = task->outcome.asyncio;
+
+    if (task->outcome.type == SDL_ASYNCIO_TASK_CLOSE) {
+        task->outcome.result = SDL_CloseFile(asyncio) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+        SDL_CompleteTask(task);
+    } else {
+        task->outcome.result = SDL_TransferFileData(task) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+        SDL_CompleteTask(task);
+        SDL_ReleaseAsyncIO(asyncio);
+    }
+}
+
+#ifdef SDL_ASYNCIO_IO_URING
+
+/* io_uring, using the system calls directly */
+
+static void SDL_DestroyIOUring(SDL_IOUring *ring)
+{
+    if (ring->sqes) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring) {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
+    close(ring->fd);
+    SDL_DestroyMutex(ring->sq_lock);
+    SDL_DestroyMutex(ring->cq_lock);
+    SDL_free(ring);
+}
+
+static SDL_IOUring *SDL_CreateIOUring(void)
+{
+    struct io_uring_params params;
+    SDL_IOUring *ring;
+    Uint8 *sq, *cq;
+    int fd;
+
+    SDL_zero(params);
+    fd = (int)syscall(__NR_io_uring_setup, SDL_IO_URING_ENTRIES, &params);
+    if (fd < 0) {
+        return NULL; /* Not supported, or not allowed */
+    }
+
+    /* Completions must never be dropped, or their tasks would be lost */
+    if (!(params.features & IORING_FEAT_NODROP)) {
+        close(fd);
+        return NULL;
+    }
+
+    ring = (SDL_IOUring *)SDL_calloc(1, sizeof(*ring));
+    if (!ring) {
+        close(fd);
+        return NULL;
+    }
+    ring->fd = fd;
+    ring->sq_lock = SDL_CreateMutex();
+    ring->cq_lock = SDL_CreateMutex();
+    if (!ring->sq_lock || !ring->cq_lock) {
+        SDL_DestroyIOUring(ring);
+        return NULL;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_ring_size = SDL_max(ring->sq_ring_size, ring->cq_ring_size);
+    }
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        ring->sq_ring = NULL;
+        SDL_DestroyIOUring(ring);
+        return NULL;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            ring->cq_ring = NULL;
+            SDL_DestroyIOUring(ring);
+            return NULL;
+        }
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        SDL_DestroyIOUring(ring);
+        return NULL;
+    }
+
+    sq = (Uint8 *)ring->sq_ring;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+
+    cq = (Uint8 *)ring->cq_ring;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cq_entries = params.cq_entries;
+
+    return ring;
+}
+
+/* Queues an operation and submits it, along with any other queued operations.
+   A NULL task is a wakeup, or a timeout if `ts` is set. */
+static SDL_bool SDL_SubmitIOUring(SDL_IOUring *ring, SDL_AsyncIOTask *task, struct __kernel_timespec *ts, SDL_bool wait)
+{
+    struct io_uring_sqe *sqe;
+    unsigned tail;
+    int result;
+
+    SDL_LockMutex(ring->sq_lock);
+    tail = *ring->sq_tail;
+    if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries) {
+        SDL_UnlockMutex(ring->sq_lock);
+        return SDL_FALSE;
+    }
+
+    sqe = &ring->sqes[tail & ring->sq_mask];
+    SDL_zerop(sqe);
+    if (task) {
+        const Uint64 done = task->outcome.bytes_transferred;
+
+        task->iov.iov_base = (Uint8 *)task->outcome.buffer + done;
+        task->iov.iov_len = (size_t)SDL_min(task->outcome.bytes_requested - done, SDL_ASYNCIO_MAX_CHUNK);
+        sqe->opcode = (task->outcome.type == SDL_ASYNCIO_TASK_READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+        sqe->fd = task->outcome.asyncio->fd;
+        sqe->addr = (Uint64)(uintptr_t)&task->iov;
+        sqe->len = 1;
+        sqe->off = task->outcome.offset + done;
+        sqe->user_data = (Uint64)(uintptr_t)task;
+    } else if (ts) {
+        /* The kernel copies the timeout when it's submitted */
+        sqe->opcode = IORING_OP_TIMEOUT;
+        sqe->fd = -1;
+        sqe->addr = (Uint64)(uintptr_t)ts;
+        sqe->len = 1;
+    } else {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->fd = -1;
+    }
+    ring->sq_array[tail & ring->sq_mask] = tail & ring->sq_mask;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    SDL_AtomicIncRef(&ring->inflight);
+    SDL_UnlockMutex(ring->sq_lock);
+
+    /* This submits everything queued so far, in case an earlier call failed */
+    do {
+        result = (int)syscall(__NR_io_uring_enter, ring->fd, ring->sq_entries, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while (result < 0 && errno == EINTR && !wait);
+
+    return SDL_TRUE;
+}
+
+/* Returns the next finished task, handling short transfers and wakeups */
+static SDL_AsyncIOTask *SDL_ReapIOUring(SDL_IOUring *ring)
+{
+    SDL_AsyncIOTask *task = NULL;
+
+    SDL_LockMutex(ring->cq_lock);
+    while (!task) {
+        const unsigned head = *ring->cq_head;
+        struct io_uring_cqe *cqe;
+        int res;
+
+        if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        cqe = &ring->cqes[head & ring->cq_mask];
+        task = (SDL_AsyncIOTask *)(uintptr_t)cqe->user_data;
+        res = cqe->res;
+        __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+        SDL_AtomicDecRef(&ring->inflight);
+
+        if (!task) {
+            continue; /* A wakeup or a timeout */
+        }
+
+        if (res > 0) {
+            task->outcome.bytes_transferred += (Uint64)res;
+            if (task->outcome.bytes_transferred < task->outcome.bytes_requested && SDL_SubmitIOUring(ring, task, NULL, SDL_FALSE)) {
+                task = NULL; /* Keep going until the end of the file */
+                continue;
+            }
+            task->outcome.result = SDL_ASYNCIO_COMPLETE;
+        } else if (res == 0) {
+            task->outcome.result = SDL_ASYNCIO_COMPLETE;
+        } else if ((res == -EINTR || res == -EAGAIN) && SDL_SubmitIOUring(ring, task, NULL, SDL_FALSE)) {
+            task = NULL;
+            continue;
+        } else {
+            task->outcome.result = SDL_ASYNCIO_FAILURE;
+        }
+    }
+    SDL_UnlockMutex(ring->cq_lock);
+
+    if (task) {
+        SDL_ReleaseAsyncIO(task->outcome.asyncio);
+    }
+    return task;
+}
+
+static void SDL_WaitIOUring(SDL_IOUring *ring, Sint32 timeoutMS)
+{
+    if (timeoutMS < 0) {
+        SDL_SubmitIOUring(ring, NULL, NULL, SDL_TRUE);
+    } else {
+        struct __kernel_timespec ts;
+
+        ts.tv_sec = timeoutMS / 1000;
+        ts.tv_nsec = (long long)(timeoutMS % 1000) * 1000000;
+        if (!SDL_SubmitIOUring(ring, NULL, &ts, SDL_TRUE)) {
+            /* The ring is full, try again soon */
+            SDL_Delay(1);
+        }
+    }
+}
+
+#endif /* SDL_ASYNCIO_IO_URING */
+
+static void SDL_CompleteTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    task->next = NULL;
+    SDL_LockMutex(queue->lock);
+    if (queue->tail) {
+        queue->tail->next = task;
+    } else {
+        queue->head = task;
+    }
+    queue->tail = task;
+    SDL_SignalCondition(queue->cond);
+#ifdef SDL_ASYNCIO_IO_URING
+    if (queue->ring) {
+        /* Wake up a thread waiting for completions on the ring */
+        SDL_SubmitIOUring(queue->ring, NULL, NULL, SDL_FALSE);
+    }
+#endif
+    SDL_UnlockMutex(queue->lock);
+}
+
+static SDL_AsyncIOTask *SDL_PopCompletedTask(SDL_AsyncIOQueue *queue)
+{
+    SDL_AsyncIOTask *task = queue->head;
+
+    if (task) {
+        queue->head = task->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+    }
+    return task;
+}
+
+static SDL_AsyncIOTask *SDL_GetCompletedTask(SDL_AsyncIOQueue *queue)
+{
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(queue->lock);
+    task = SDL_PopCompletedTask(queue);
+    SDL_UnlockMutex(queue->lock);
+
+#ifdef SDL_ASYNCIO_IO_URING
+    if (!task && queue->ring) {
+        task = SDL_ReapIOUring(queue->ring);
+    }
+#endif
+    return task;
+}
+
+static void SDL_CollectTask(SDL_AsyncIOQueue *queue, SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
+{
+    SDL_copyp(outcome, &task->outcome);
+    SDL_free(task);
+    SDL_AtomicDecRef(&queue->pending);
+}
+
+static int SDL_StartAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTaskType type, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_ThreadPool *pool;
+    SDL_AsyncIOTask *task;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    if (!ptr && size) {
+        return SDL_InvalidParamError("ptr");
+    }
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    if (asyncio->closing) {
+        return SDL_SetError("The file is being closed");
+    }
+
+    task = (SDL_AsyncIOTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        return SDL_OutOfMemory();
+    }
+    task->outcome.asyncio = asyncio;
+    task->outcome.type = type;
+    task->outcome.buffer = ptr;
+    task->outcome.offset = offset;
+    task->outcome.bytes_requested = size;
+    task->outcome.userdata = userdata;
+    task->queue = queue;
+
+    SDL_AtomicIncRef(&asyncio->refcount);
+    SDL_AtomicIncRef(&queue->pending);
+
+#ifdef SDL_ASYNCIO_IO_URING
+    /* Keep room in the completion ring for wakeups and timeouts */
+    if (queue->ring && size > 0 &&
+        SDL_AtomicGet(&queue->ring->inflight) < (int)(queue->ring->cq_entries / 2) &&
+        SDL_SubmitIOUring(queue->ring, task, NULL, SDL_FALSE)) {
+        return 0;
+    }
+#endif
+
+    pool = SDL_GetAsyncIOPool();
+    if (!pool || SDL_SubmitJob(pool, SDL_RunAsyncIOTask, task, NULL, NULL) < 0) {
+        SDL_AtomicDecRef(&queue->pending);
+        SDL_AtomicDecRef(&asyncio->refcount); /* The file still holds its own reference */
+        SDL_free(task);
+        return -1;
+    }
+    return 0;
+}
+
+SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
+{
+    SDL_AsyncIO *asyncio;
+#ifdef SDL_ASYNCIO_FD
+    int flags;
+#endif
+
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+    if (!mode || !*mode) {
+        SDL_InvalidParamError("mode");
+        return NULL;
+    }
+    if (SDL_strchr(mode, 'a')) {
+        SDL_SetError("Append mode isn't supported for asynchronous I/O");
+        return NULL;
+    }
+
+#ifdef SDL_ASYNCIO_FD
+    if (*mode == 'r') {
+        flags = SDL_strchr(mode, '+') ? O_RDWR : O_RDONLY;
+    } else if (*mode == 'w') {
+        flags = (SDL_strchr(mode, '+') ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC;
+    } else {
+        SDL_SetError("Unsupported file mode \"%s\"", mode);
+        return NULL;
+    }
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+#endif
+
+    asyncio = (SDL_AsyncIO *)SDL_calloc(1, sizeof(*asyncio));
+    if (!asyncio) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+#ifdef SDL_ASYNCIO_FD
+    asyncio->fd = open(file, flags, 0666);
+    if (asyncio->fd < 0) {
+        SDL_SetError("Couldn't open %s", file);
+        SDL_free(asyncio);
+        return NULL;
+    }
+#else
+    asyncio->lock = SDL_CreateMutex();
+    if (!asyncio->lock) {
+        SDL_free(asyncio);
+        return NULL;
+    }
+    asyncio->rwops = SDL_RWFromFile(file, mode);
+    if (!asyncio->rwops) {
+        SDL_DestroyMutex(asyncio->lock);
+        SDL_free(asyncio);
+        return NULL;
+    }
+#endif
+
+    SDL_AtomicSet(&asyncio->refcount, 1);
+    return asyncio;
+}
+
+Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
+{
+#ifdef SDL_ASYNCIO_FD
+    struct stat st;
+#else
+    Sint64 size;
+#endif
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+
+#ifdef SDL_ASYNCIO_FD
+    if (fstat(asyncio->fd, &st) < 0) {
+        return SDL_SetError("Couldn't get the file size");
+    }
+    return (Sint64)st.st_size;
+#else
+    SDL_LockMutex(asyncio->lock);
+    size = SDL_RWsize(asyncio->rwops);
+    SDL_UnlockMutex(asyncio->lock);
+    return size;
+#endif
+}
+
+int SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return SDL_StartAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_READ, ptr, offset, size, queue, userdata);
+}
+
+int SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return SDL_StartAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_WRITE, ptr, offset, size, queue, userdata);
+}
+
+int SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    if (asyncio->closing) {
+        return SDL_SetError("The file is already being closed");
+    }
+
+    task = (SDL_AsyncIOTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        return SDL_OutOfMemory();
+    }
+    task->outcome.asyncio = asyncio;
+    task->outcome.type = SDL_ASYNCIO_TASK_CLOSE;
+    task->outcome.userdata = userdata;
+    task->queue = queue;
+
+    SDL_AtomicIncRef(&queue->pending);
+    asyncio->closing = SDL_TRUE;
+    asyncio->close_task = task;
+    SDL_ReleaseAsyncIO(asyncio);
+    return 0;
+}
+
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
+{
+    SDL_AsyncIOQueue *queue = (SDL_AsyncIOQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    queue->lock = SDL_CreateMutex();
+    queue->cond = SDL_CreateCondition();
+    if (!queue->lock || !queue->cond) {
+        SDL_DestroyCondition(queue->cond);
+        SDL_DestroyMutex(queue->lock);
+        SDL_free(queue);
+        return NULL;
+    }
+#ifdef SDL_ASYNCIO_IO_URING
+    queue->ring = SDL_CreateIOUring();
+#endif
+    return queue;
+}
+
+void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    SDL_AsyncIOOutcome outcome;
+
+    if (!queue) {
+        return;
+    }
+
+    /* The buffers may be freed after this returns, so everything has to finish */
+    while (SDL_AtomicGet(&queue->pending) > 0) {
+        SDL_WaitAsyncIOResult(queue, &outcome, -1);
+    }
+
+    /* Make sure the last task to finish is done with the queue */
+    SDL_LockMutex(queue->lock);
+    SDL_UnlockMutex(queue->lock);
+
+#ifdef SDL_ASYNCIO_IO_URING
+    if (queue->ring) {
+        SDL_DestroyIOUring(queue->ring);
+    }
+#endif
+    SDL_DestroyCondition(queue->cond);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
+
+SDL_bool SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+
+    task = SDL_GetCompletedTask(queue);
+    if (!task) {
+        return SDL_FALSE;
+    }
+    SDL_CollectTask(queue, task, outcome);
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome, Sint32 timeoutMS)
+{
+    SDL_AsyncIOTask *task = NULL;
+    Uint64 deadline = 0;
+    int signals;
+
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+
+    if (timeoutMS > 0) {
+        deadline = SDL_GetTicks() + timeoutMS;
+    }
+
+#ifdef SDL_ASYNCIO_IO_URING
+    if (queue->ring) {
+        /* Signals and finished tasks from the I/O threads post a wakeup for each waiter */
+        SDL_AtomicIncRef(&queue->waiters);
+        signals = SDL_AtomicGet(&queue->signals);
+        for (;;) {
+            task = SDL_GetCompletedTask(queue);
+            if (task || SDL_AtomicGet(&queue->signals) != signals || timeoutMS == 0) {
+                break;
+            }
+            if (timeoutMS > 0) {
+                const Uint64 now = SDL_GetTicks();
+                if (now >= deadline) {
+                    break;
+                }
+                SDL_WaitIOUring(queue->ring, (Sint32)(deadline - now));
+            } else {
+                SDL_WaitIOUring(queue->ring, -1);
+            }
+        }
+        SDL_AtomicDecRef(&queue->waiters);
+    } else
+#endif
+    {
+        SDL_LockMutex(queue->lock);
+        signals = SDL_AtomicGet(&queue->signals);
+        while (!queue->head && SDL_AtomicGet(&queue->signals) == signals && timeoutMS != 0) {
+            if (timeoutMS > 0) {
+                const Uint64 now = SDL_GetTicks();
+                if (now >= deadline) {
+                    break;
+                }
+                SDL_WaitConditionTimeout(queue->cond, queue->lock, (Sint32)(deadline - now));
+            } else {
+                SDL_WaitCondition(queue->cond, queue->lock);
+            }
+        }
+        task = SDL_PopCompletedTask(queue);
+        SDL_UnlockMutex(queue->lock);
+    }
+
+    if (!task) {
+        return SDL_FALSE;
+    }
+    SDL_CollectTask(queue, task, outcome);
+    return SDL_TRUE;
+}
+
+void SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    if (!queue) {
+        return;
+    }
+
+    SDL_LockMutex(queue->lock);
+    SDL_AtomicAdd(&queue->signals, 1);
+    SDL_BroadcastCondition(queue->cond);
+#ifdef SDL_ASYNCIO_IO_URING
+    if (queue->ring) {
+        int waiters = SDL_AtomicGet(&queue->waiters);
+        while (waiters-- > 0) {
+            SDL_SubmitIOUring(queue->ring, NULL, NULL, SDL_FALSE);
+        }
+    }
+#endif
+    SDL_UnlockMutex(queue->lock);
+}
+
+void SDL_QuitAsyncIO(void)
+{
+    SDL_ThreadPool *pool;
+
+    SDL_AtomicLock(&SDL_asyncio_lock);
+    pool = SDL_asyncio_pool;
+    SDL_asyncio_pool = NULL;
+    SDL_AtomicUnlock(&SDL_asyncio_lock);
+
+    /* This waits for the tasks still running on the I/O threads */
+    SDL_DestroyThreadPool(pool);
+}
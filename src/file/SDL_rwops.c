@@ -31,6 +31,27 @@
 #include <limits.h>
 #endif
 
+#if (defined(__WIN32__) || defined(__GDK__)) && !defined(__XBOXONE__) && !defined(__XBOXSERIES__) && !defined(__WINRT__)
+#define SDL_MAPPED_FILES_WINDOWS
+#elif defined(HAVE_MMAP)
+#define SDL_MAPPED_FILES_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_STDIO_H) && defined(HAVE_PREAD) && !(defined(__WIN32__) || defined(__GDK__))
+#define SDL_RWOPS_PREAD
+#include <errno.h>
+#include <unistd.h>
+/* preadv() isn't available on older macOS and iOS versions */
+#if defined(HAVE_PREADV) && !defined(__APPLE__)
+#define SDL_RWOPS_PREADV
+#include <sys/uio.h>
+#endif
+#endif
+
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
@@ -67,6 +88,7 @@ static int SDLCALL windows_file_open(SDL_RWops *context, const char *filename, c
     int a_mode;
 
     context->hidden.windowsio.h = INVALID_HANDLE_VALUE; /* mark this as unusable */
+    context->hidden.windowsio.position = 0;
     context->hidden.windowsio.buffer.data = NULL;
     context->hidden.windowsio.buffer.size = 0;
     context->hidden.windowsio.buffer.left = 0;
@@ -152,36 +174,68 @@ static Sint64 SDLCALL windows_file_size(SDL_RWops *context)
     return size.QuadPart;
 }
 
+/* Reads and writes always give the offset, since reading or writing at an
+   offset moves the file pointer of a handle that isn't opened for overlapped
+   I/O, and SDL_RWreadAt() shouldn't change the position for SDL_RWread() */
+static BOOL windows_read_at(HANDLE h, void *ptr, DWORD size, Sint64 offset, DWORD *bytes)
+{
+    OVERLAPPED overlapped;
+
+    SDL_zero(overlapped);
+    overlapped.Offset = (DWORD)offset;
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    if (!ReadFile(h, ptr, size, bytes, &overlapped)) {
+        /* Reading at the end of the file fails when an offset is given */
+        if (GetLastError() == ERROR_HANDLE_EOF) {
+            *bytes = 0;
+            return TRUE;
+        }
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static BOOL windows_write_at(HANDLE h, const void *ptr, DWORD size, Sint64 offset, DWORD *bytes)
+{
+    OVERLAPPED overlapped;
+
+    SDL_zero(overlapped);
+    overlapped.Offset = (DWORD)offset;
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    return WriteFile(h, ptr, size, bytes, &overlapped);
+}
+
 static Sint64 SDLCALL windows_file_seek(SDL_RWops *context, Sint64 offset, int whence)
 {
-    DWORD windowswhence;
-    LARGE_INTEGER windowsoffset;
+    Sint64 position;
 
     /* FIXME: We may be able to satisfy the seek within buffered data */
-    if (whence == SDL_RW_SEEK_CUR && context->hidden.windowsio.buffer.left) {
-        offset -= context->hidden.windowsio.buffer.left;
-    }
-    context->hidden.windowsio.buffer.left = 0;
-
     switch (whence) {
     case SDL_RW_SEEK_SET:
-        windowswhence = FILE_BEGIN;
+        position = offset;
         break;
     case SDL_RW_SEEK_CUR:
-        windowswhence = FILE_CURRENT;
+        position = context->hidden.windowsio.position - (Sint64)context->hidden.windowsio.buffer.left + offset;
         break;
     case SDL_RW_SEEK_END:
-        windowswhence = FILE_END;
+    {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(context->hidden.windowsio.h, &size)) {
+            return WIN_SetError("windows_file_seek");
+        }
+        position = size.QuadPart + offset;
         break;
+    }
     default:
         return SDL_SetError("windows_file_seek: Unknown value for 'whence'");
     }
 
-    windowsoffset.QuadPart = offset;
-    if (!SetFilePointerEx(context->hidden.windowsio.h, windowsoffset, &windowsoffset, windowswhence)) {
-        return WIN_SetError("windows_file_seek");
+    if (position < 0) {
+        return SDL_SetError("windows_file_seek: Seek before the start of the file");
     }
-    return windowsoffset.QuadPart;
+    context->hidden.windowsio.buffer.left = 0;
+    context->hidden.windowsio.position = position;
+    return position;
 }
 
 static size_t SDLCALL windows_file_read(SDL_RWops *context, void *ptr, size_t size)
@@ -208,21 +262,23 @@ static size_t SDLCALL windows_file_read(SDL_RWops *context, void *ptr, size_t si
     }
 
     if (total_need < READAHEAD_BUFFER_SIZE) {
-        if (!ReadFile(context->hidden.windowsio.h, context->hidden.windowsio.buffer.data,
-                      READAHEAD_BUFFER_SIZE, &bytes, NULL)) {
+        if (!windows_read_at(context->hidden.windowsio.h, context->hidden.windowsio.buffer.data,
+                             READAHEAD_BUFFER_SIZE, context->hidden.windowsio.position, &bytes)) {
             SDL_Error(SDL_EFREAD);
             return 0;
         }
+        context->hidden.windowsio.position += bytes;
         read_ahead = SDL_min(total_need, bytes);
         SDL_memcpy(ptr, context->hidden.windowsio.buffer.data, read_ahead);
         context->hidden.windowsio.buffer.size = bytes;
         context->hidden.windowsio.buffer.left = bytes - read_ahead;
         total_read += read_ahead;
     } else {
-        if (!ReadFile(context->hidden.windowsio.h, ptr, (DWORD)total_need, &bytes, NULL)) {
+        if (!windows_read_at(context->hidden.windowsio.h, ptr, (DWORD)total_need, context->hidden.windowsio.position, &bytes)) {
             SDL_Error(SDL_EFREAD);
             return 0;
         }
+        context->hidden.windowsio.position += bytes;
         total_read += bytes;
     }
     return total_read;
@@ -234,33 +290,57 @@ static size_t SDLCALL windows_file_write(SDL_RWops *context, const void *ptr, si
     DWORD bytes;
 
     if (context->hidden.windowsio.buffer.left) {
-        if (!SetFilePointer(context->hidden.windowsio.h,
-                       -(LONG)context->hidden.windowsio.buffer.left, NULL,
-                       FILE_CURRENT)) {
-            SDL_Error(SDL_EFSEEK);
-            return 0;
-        }
+        context->hidden.windowsio.position -= context->hidden.windowsio.buffer.left;
         context->hidden.windowsio.buffer.left = 0;
     }
 
     /* if in append mode, we must go to the EOF before write */
     if (context->hidden.windowsio.append) {
-        LARGE_INTEGER windowsoffset;
-        windowsoffset.QuadPart = 0;
-        if (!SetFilePointerEx(context->hidden.windowsio.h, windowsoffset, &windowsoffset, FILE_END)) {
+        LARGE_INTEGER filesize;
+        if (!GetFileSizeEx(context->hidden.windowsio.h, &filesize)) {
             SDL_Error(SDL_EFSEEK);
             return 0;
         }
+        context->hidden.windowsio.position = filesize.QuadPart;
     }
 
-    if (!WriteFile(context->hidden.windowsio.h, ptr, (DWORD)total_bytes, &bytes, NULL)) {
+    if (!windows_write_at(context->hidden.windowsio.h, ptr, (DWORD)total_bytes, context->hidden.windowsio.position, &bytes)) {
         SDL_Error(SDL_EFWRITE);
         return 0;
     }
+    context->hidden.windowsio.position += bytes;
 
     return bytes;
 }
 
+static size_t SDLCALL windows_file_readat(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    DWORD bytes;
+
+    if (!windows_read_at(context->hidden.windowsio.h, ptr, (DWORD)SDL_min(size, 0xFFFFFFFF), offset, &bytes)) {
+        SDL_Error(SDL_EFREAD);
+        return 0;
+    }
+    return bytes;
+}
+
+static size_t SDLCALL windows_file_writeat(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    DWORD bytes;
+
+    /* The data that's been read ahead might be overwritten */
+    if (context->hidden.windowsio.buffer.left) {
+        context->hidden.windowsio.position -= context->hidden.windowsio.buffer.left;
+        context->hidden.windowsio.buffer.left = 0;
+    }
+
+    if (!windows_write_at(context->hidden.windowsio.h, ptr, (DWORD)SDL_min(size, 0xFFFFFFFF), offset, &bytes)) {
+        SDL_Error(SDL_EFWRITE);
+        return 0;
+    }
+    return bytes;
+}
+
 static int SDLCALL windows_file_close(SDL_RWops *context)
 {
     if (context->hidden.windowsio.h != INVALID_HANDLE_VALUE) {
@@ -369,9 +449,120 @@ static size_t SDLCALL stdio_write(SDL_RWops *context, const void *ptr, size_t si
     if (bytes == 0 && ferror((FILE *)context->hidden.stdio.fp)) {
         SDL_Error(SDL_EFWRITE);
     }
+    context->hidden.stdio.unflushed = SDL_TRUE;
     return bytes;
 }
 
+#ifdef SDL_RWOPS_PREAD
+/* Reading and writing the file descriptor directly doesn't see data that's
+   still waiting in the stdio buffer */
+static int stdio_flush(SDL_RWops *context)
+{
+    if (context->hidden.stdio.unflushed) {
+        if (fflush((FILE *)context->hidden.stdio.fp) != 0) {
+            return SDL_Error(SDL_EFWRITE);
+        }
+        context->hidden.stdio.unflushed = SDL_FALSE;
+    }
+    return 0;
+}
+
+static size_t SDLCALL stdio_readat(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    const int fd = fileno((FILE *)context->hidden.stdio.fp);
+    ssize_t bytes;
+
+    if (stdio_flush(context) < 0) {
+        return 0;
+    }
+
+    do {
+        bytes = pread(fd, ptr, size, (off_t)offset);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0) {
+        SDL_Error(SDL_EFREAD);
+        return 0;
+    }
+    return (size_t)bytes;
+}
+
+#ifdef SDL_RWOPS_PREADV
+#define STDIO_MAX_IOVEC 16
+
+static size_t SDLCALL stdio_readvat(SDL_RWops *context, const SDL_RWvec *vec, int count, Sint64 offset)
+{
+    const int fd = fileno((FILE *)context->hidden.stdio.fp);
+    struct iovec iov[STDIO_MAX_IOVEC];
+    size_t total = 0;
+    size_t skip = 0; /* The part of vec[0] that's already been read */
+
+    if (stdio_flush(context) < 0) {
+        return 0;
+    }
+
+    while (count > 0) {
+        const int n = SDL_min(count, STDIO_MAX_IOVEC);
+        ssize_t bytes;
+        size_t done;
+        int i;
+
+        for (i = 0; i < n; ++i) {
+            iov[i].iov_base = vec[i].ptr;
+            iov[i].iov_len = vec[i].size;
+        }
+        iov[0].iov_base = (Uint8 *)iov[0].iov_base + skip;
+        iov[0].iov_len -= skip;
+
+        bytes = preadv(fd, iov, n, (off_t)(offset + (Sint64)total));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDL_Error(SDL_EFREAD);
+            break;
+        } else if (bytes == 0) {
+            break;
+        }
+        total += (size_t)bytes;
+
+        /* Move past the areas that have been filled */
+        done = (size_t)bytes + skip;
+        while (count > 0 && done >= vec->size) {
+            done -= vec->size;
+            ++vec;
+            --count;
+        }
+        skip = done;
+    }
+    return total;
+}
+#endif /* SDL_RWOPS_PREADV */
+
+static size_t SDLCALL stdio_writeat(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    const int fd = fileno((FILE *)context->hidden.stdio.fp);
+    ssize_t bytes;
+
+    /* This also drops any data read ahead, which might be overwritten */
+    if (fflush((FILE *)context->hidden.stdio.fp) != 0) {
+        SDL_Error(SDL_EFWRITE);
+        return 0;
+    }
+    context->hidden.stdio.unflushed = SDL_FALSE;
+
+    do {
+        bytes = pwrite(fd, ptr, size, (off_t)offset);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0) {
+        SDL_Error(SDL_EFWRITE);
+        return 0;
+    }
+    return (size_t)bytes;
+}
+#endif /* SDL_RWOPS_PREAD */
+
 static int SDLCALL stdio_close(SDL_RWops *context)
 {
     int status = 0;
@@ -393,6 +584,13 @@ static SDL_RWops *SDL_RWFromFP(void *fp, SDL_bool autoclose)
         rwops->seek = stdio_seek;
         rwops->read = stdio_read;
         rwops->write = stdio_write;
+#ifdef SDL_RWOPS_PREAD
+        rwops->readat = stdio_readat;
+#ifdef SDL_RWOPS_PREADV
+        rwops->readvat = stdio_readvat;
+#endif
+        rwops->writeat = stdio_writeat;
+#endif
         rwops->close = stdio_close;
         rwops->hidden.stdio.fp = fp;
         rwops->hidden.stdio.autoclose = autoclose;
@@ -457,6 +655,355 @@ static size_t SDLCALL mem_write(SDL_RWops *context, const void *ptr, size_t size
     return mem_io(context, context->hidden.mem.here, ptr, size);
 }
 
+static size_t SDLCALL mem_readat(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    const Sint64 mem_available = mem_size(context) - offset;
+    if (mem_available <= 0) {
+        return 0;
+    }
+    if ((Uint64)size > (Uint64)mem_available) {
+        size = (size_t)mem_available;
+    }
+    SDL_memcpy(ptr, context->hidden.mem.base + offset, size);
+    return size;
+}
+
+static size_t SDLCALL mem_writeat(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    const Sint64 mem_available = mem_size(context) - offset;
+    if (mem_available <= 0) {
+        return 0;
+    }
+    if ((Uint64)size > (Uint64)mem_available) {
+        size = (size_t)mem_available;
+    }
+    SDL_memcpy(context->hidden.mem.base + offset, ptr, size);
+    return size;
+}
+
+/* Functions to read memory mapped files */
+
+#if defined(SDL_MAPPED_FILES_WINDOWS) || defined(SDL_MAPPED_FILES_MMAP)
+static void *SDL_MapFile(const char *file, size_t *size)
+{
+    void *data = NULL;
+#ifdef SDL_MAPPED_FILES_WINDOWS
+    LPTSTR tstr = WIN_UTF8ToString(file);
+    HANDLE h, mapping;
+    LARGE_INTEGER filesize;
+
+    h = CreateFile(tstr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    SDL_free(tstr);
+    if (h == INVALID_HANDLE_VALUE) {
+        SDL_SetError("Couldn't open %s", file);
+        return NULL;
+    }
+
+    /* Empty files can't be mapped */
+    if (GetFileSizeEx(h, &filesize) && filesize.QuadPart > 0 && (Uint64)filesize.QuadPart <= SDL_SIZE_MAX) {
+        /* The view keeps the mapping and the file open */
+        mapping = CreateFileMapping(h, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(h);
+
+    if (data) {
+        *size = (size_t)filesize.QuadPart;
+    }
+#else
+    struct stat st;
+    int flags = O_RDONLY;
+    int fd;
+
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    fd = open(file, flags);
+    if (fd < 0) {
+        SDL_SetError("Couldn't open %s", file);
+        return NULL;
+    }
+
+    /* Empty files can't be mapped */
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (Uint64)st.st_size <= SDL_SIZE_MAX) {
+        /* The mapping keeps the file open */
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        }
+    }
+    close(fd);
+
+    if (data) {
+        *size = (size_t)st.st_size;
+    }
+#endif
+    if (!data) {
+        SDL_SetError("Couldn't map %s", file);
+    }
+    return data;
+}
+
+static void SDL_UnmapFile(void *data, size_t size)
+{
+#ifdef SDL_MAPPED_FILES_WINDOWS
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+static int SDLCALL mapped_close(SDL_RWops *context)
+{
+    SDL_UnmapFile(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+    SDL_DestroyRW(context);
+    return 0;
+}
+#endif /* SDL_MAPPED_FILES_WINDOWS || SDL_MAPPED_FILES_MMAP */
+
+/* Functions to buffer another stream */
+
+#define SDL_DEFAULT_RW_BUFFER_SIZE 4096
+
+typedef struct SDL_RWBuffer
+{
+    SDL_RWops *src;
+    SDL_bool freesrc;
+    Uint8 *data;
+    size_t size;
+    size_t written;  /* Bytes waiting to be written to src, nothing is buffered for reading then */
+    Sint64 position; /* The position of src, after any data buffered for reading, or -1 if unknown */
+} SDL_RWBuffer;
+
+static int buffered_flush(SDL_RWops *context)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+    size_t done = 0;
+    int result = 0;
+
+    while (done < buffer->written) {
+        const size_t bytes = SDL_RWwrite(buffer->src, buffer->data + done, buffer->written - done);
+        if (bytes == 0) {
+            result = -1;
+            break;
+        }
+        done += bytes;
+    }
+
+    /* Keep anything that couldn't be written, so it can be tried again */
+    buffer->written -= done;
+    SDL_memmove(buffer->data, buffer->data + done, buffer->written);
+    if (buffer->position >= 0) {
+        buffer->position += (Sint64)done;
+    }
+    return result;
+}
+
+/* Drops the data buffered for reading, moving src back to the position it was read up to */
+static int buffered_unread(SDL_RWops *context)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+    const size_t unread = (size_t)(context->hidden.buffered.stop - context->hidden.buffered.here);
+
+    if (unread > 0) {
+        const Sint64 position = SDL_RWseek(buffer->src, -(Sint64)unread, SDL_RW_SEEK_CUR);
+        if (position < 0) {
+            return -1;
+        }
+        buffer->position = position;
+    }
+    context->hidden.buffered.here = context->hidden.buffered.stop = buffer->data;
+    return 0;
+}
+
+static Sint64 SDLCALL buffered_size(SDL_RWops *context)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+
+    if (buffer->written && buffered_flush(context) < 0) {
+        return -1;
+    }
+    return SDL_RWsize(buffer->src);
+}
+
+static Sint64 SDLCALL buffered_seek(SDL_RWops *context, Sint64 offset, int whence)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+    const Sint64 unread = (Sint64)(context->hidden.buffered.stop - context->hidden.buffered.here);
+    Sint64 position;
+
+    /* Seeking within the data buffered for reading doesn't touch src */
+    if (!buffer->written && buffer->position >= 0 && (whence == SDL_RW_SEEK_SET || whence == SDL_RW_SEEK_CUR)) {
+        const Sint64 start = buffer->position - (Sint64)(context->hidden.buffered.stop - buffer->data);
+        const Sint64 target = (whence == SDL_RW_SEEK_SET) ? offset : (buffer->position - unread + offset);
+
+        if (target >= start && target <= buffer->position) {
+            context->hidden.buffered.here = buffer->data + (size_t)(target - start);
+            return target;
+        }
+    }
+
+    if (buffer->written) {
+        if (buffered_flush(context) < 0) {
+            return -1;
+        }
+    } else if (whence == SDL_RW_SEEK_CUR) {
+        offset -= unread;
+    }
+
+    position = SDL_RWseek(buffer->src, offset, whence);
+    if (position < 0) {
+        return -1;
+    }
+    context->hidden.buffered.here = context->hidden.buffered.stop = buffer->data;
+    buffer->position = position;
+    return position;
+}
+
+static size_t SDLCALL buffered_read(SDL_RWops *context, void *ptr, size_t size)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    if (buffer->written && buffered_flush(context) < 0) {
+        context->status = SDL_RWOPS_STATUS_ERROR;
+        return 0;
+    }
+
+    while (size > 0) {
+        size_t bytes = (size_t)(context->hidden.buffered.stop - context->hidden.buffered.here);
+
+        if (bytes == 0) {
+            if (size >= buffer->size) {
+                /* Large reads go straight to the destination */
+                bytes = SDL_RWread(buffer->src, dst, size);
+                if (bytes == 0) {
+                    break;
+                }
+                if (buffer->position >= 0) {
+                    buffer->position += (Sint64)bytes;
+                }
+                total += bytes;
+                dst += bytes;
+                size -= bytes;
+                continue;
+            }
+
+            bytes = SDL_RWread(buffer->src, buffer->data, buffer->size);
+            if (bytes == 0) {
+                break;
+            }
+            if (buffer->position >= 0) {
+                buffer->position += (Sint64)bytes;
+            }
+            context->hidden.buffered.here = buffer->data;
+            context->hidden.buffered.stop = buffer->data + bytes;
+        }
+
+        bytes = SDL_min(bytes, size);
+        SDL_memcpy(dst, context->hidden.buffered.here, bytes);
+        context->hidden.buffered.here += bytes;
+        total += bytes;
+        dst += bytes;
+        size -= bytes;
+    }
+
+    if (total == 0) {
+        context->status = buffer->src->status;
+    }
+    return total;
+}
+
+static size_t SDLCALL buffered_write(SDL_RWops *context, const void *ptr, size_t size)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+
+    if (!buffer->written && buffered_unread(context) < 0) {
+        context->status = SDL_RWOPS_STATUS_ERROR;
+        return 0;
+    }
+
+    if (size > buffer->size - buffer->written) {
+        if (buffered_flush(context) < 0) {
+            context->status = SDL_RWOPS_STATUS_ERROR;
+            return 0;
+        }
+        if (size >= buffer->size) {
+            /* Large writes go straight to src */
+            const size_t bytes = SDL_RWwrite(buffer->src, ptr, size);
+            if (buffer->position >= 0) {
+                buffer->position += (Sint64)bytes;
+            }
+            return bytes;
+        }
+    }
+
+    SDL_memcpy(buffer->data + buffer->written, ptr, size);
+    buffer->written += size;
+    return size;
+}
+
+/* Positional reads and writes go straight to src, they only need to agree
+   with what's been buffered */
+static size_t SDLCALL buffered_readat(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+
+    if (buffer->written && buffered_flush(context) < 0) {
+        return 0;
+    }
+    return SDL_RWreadAt(buffer->src, ptr, size, offset);
+}
+
+static size_t SDLCALL buffered_readvat(SDL_RWops *context, const SDL_RWvec *vec, int count, Sint64 offset)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+
+    if (buffer->written && buffered_flush(context) < 0) {
+        return 0;
+    }
+    return SDL_RWreadvAt(buffer->src, vec, count, offset);
+}
+
+static size_t SDLCALL buffered_writeat(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+
+    if (buffer->written) {
+        if (buffered_flush(context) < 0) {
+            return 0;
+        }
+    } else if (buffered_unread(context) < 0) {
+        return 0;
+    }
+    return SDL_RWwriteAt(buffer->src, ptr, size, offset);
+}
+
+static int SDLCALL buffered_close(SDL_RWops *context)
+{
+    SDL_RWBuffer *buffer = (SDL_RWBuffer *)context->hidden.buffered.data;
+    int result = 0;
+
+    if (buffer->written) {
+        result = buffered_flush(context);
+    } else if (!buffer->freesrc && buffer->src->seek) {
+        /* Leave src where the caller expects it to be */
+        buffered_unread(context);
+    }
+    if (buffer->freesrc && SDL_RWclose(buffer->src) < 0) {
+        result = -1;
+    }
+    SDL_free(buffer->data);
+    SDL_free(buffer);
+    SDL_DestroyRW(context);
+    return result;
+}
+
 /* Functions to create SDL_RWops structures from various data sources */
 
 SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
@@ -507,6 +1054,9 @@ SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
     rwops->seek = Android_JNI_FileSeek;
     rwops->read = Android_JNI_FileRead;
     rwops->write = Android_JNI_FileWrite;
+    if (rwops->hidden.androidio.fd >= 0) {
+        rwops->readat = Android_JNI_FileReadAt;
+    }
     rwops->close = Android_JNI_FileClose;
     rwops->type = SDL_RWOPS_JNIFILE;
 
@@ -524,6 +1074,8 @@ SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
     rwops->seek = windows_file_seek;
     rwops->read = windows_file_read;
     rwops->write = windows_file_write;
+    rwops->readat = windows_file_readat;
+    rwops->writeat = windows_file_writeat;
     rwops->close = windows_file_close;
     rwops->type = SDL_RWOPS_WINFILE;
 #elif defined(HAVE_STDIO_H)
@@ -570,6 +1122,8 @@ SDL_RWops *SDL_RWFromMem(void *mem, size_t size)
         rwops->seek = mem_seek;
         rwops->read = mem_read;
         rwops->write = mem_write;
+        rwops->readat = mem_readat;
+        rwops->writeat = mem_writeat;
         rwops->hidden.mem.base = (Uint8 *)mem;
         rwops->hidden.mem.here = rwops->hidden.mem.base;
         rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
@@ -596,6 +1150,7 @@ SDL_RWops *SDL_RWFromConstMem(const void *mem, size_t size)
         rwops->size = mem_size;
         rwops->seek = mem_seek;
         rwops->read = mem_read;
+        rwops->readat = mem_readat;
         rwops->hidden.mem.base = (Uint8 *)mem;
         rwops->hidden.mem.here = rwops->hidden.mem.base;
         rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
@@ -604,6 +1159,108 @@ SDL_RWops *SDL_RWFromConstMem(const void *mem, size_t size)
     return rwops;
 }
 
+SDL_RWops *SDL_RWFromFileMapped(const char *file)
+{
+#if defined(SDL_MAPPED_FILES_WINDOWS) || defined(SDL_MAPPED_FILES_MMAP)
+    SDL_RWops *rwops;
+    void *data;
+    size_t size;
+#endif
+
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+#if defined(SDL_MAPPED_FILES_WINDOWS) || defined(SDL_MAPPED_FILES_MMAP)
+#if defined(__ANDROID__) || defined(__APPLE__)
+    /* Relative paths are looked up in the app's assets or bundle first */
+    if (*file == '/')
+#endif
+    {
+        data = SDL_MapFile(file, &size);
+        if (data) {
+            rwops = SDL_CreateRW();
+            if (!rwops) {
+                SDL_UnmapFile(data, size);
+                return NULL;
+            }
+            rwops->size = mem_size;
+            rwops->seek = mem_seek;
+            rwops->read = mem_read;
+            rwops->readat = mem_readat;
+            rwops->close = mapped_close;
+            rwops->hidden.mem.base = (Uint8 *)data;
+            rwops->hidden.mem.here = rwops->hidden.mem.base;
+            rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+            rwops->type = SDL_RWOPS_MAPPED;
+            return rwops;
+        }
+    }
+#endif
+
+    return SDL_RWFromFile(file, "rb");
+}
+
+SDL_RWops *SDL_CreateBufferedRW(SDL_RWops *src, size_t buffersize, SDL_bool freesrc)
+{
+    SDL_RWBuffer *buffer;
+    SDL_RWops *rwops;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    if (!buffersize) {
+        buffersize = SDL_DEFAULT_RW_BUFFER_SIZE;
+    }
+
+    buffer = (SDL_RWBuffer *)SDL_calloc(1, sizeof(*buffer));
+    if (buffer) {
+        buffer->data = (Uint8 *)SDL_malloc(buffersize);
+    }
+    rwops = SDL_CreateRW();
+    if (!buffer || !buffer->data || !rwops) {
+        if (buffer) {
+            SDL_free(buffer->data);
+            SDL_free(buffer);
+        }
+        if (rwops) {
+            SDL_DestroyRW(rwops);
+        }
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buffer->src = src;
+    buffer->freesrc = freesrc;
+    buffer->size = buffersize;
+    buffer->position = src->seek ? SDL_RWtell(src) : -1;
+
+    rwops->size = buffered_size;
+    if (src->seek) {
+        rwops->seek = buffered_seek;
+    }
+    if (src->read) {
+        rwops->read = buffered_read;
+        rwops->readat = buffered_readat;
+        rwops->readvat = buffered_readvat;
+    }
+    if (src->write) {
+        rwops->write = buffered_write;
+        rwops->writeat = buffered_writeat;
+    }
+    rwops->close = buffered_close;
+    rwops->hidden.buffered.here = buffer->data;
+    rwops->hidden.buffered.stop = buffer->data;
+    rwops->hidden.buffered.data = buffer;
+    rwops->type = SDL_RWOPS_BUFFERED;
+    return rwops;
+}
+
 SDL_RWops *SDL_CreateRW(void)
 {
     SDL_RWops *context;
@@ -627,7 +1284,8 @@ void SDL_DestroyRW(SDL_RWops *context)
 void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
 {
     const int FILE_CHUNK_SIZE = 1024;
-    Sint64 size, size_total;
+    char probe[1024];
+    Sint64 size, size_total, grow;
     size_t size_read;
     char *data = NULL, *newdata;
     SDL_bool loading_chunks = SDL_FALSE;
@@ -639,7 +1297,11 @@ void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
 
     size = SDL_RWsize(src);
     if (size < 0) {
-        size = FILE_CHUNK_SIZE;
+        /* Start with the size hint, if the stream has one */
+        size = src->props ? SDL_GetNumberProperty(src->props, "SDL.rwops.size_hint", 0) : 0;
+        if (size <= 0) {
+            size = FILE_CHUNK_SIZE;
+        }
         loading_chunks = SDL_TRUE;
     }
     if (size >= SDL_SIZE_MAX) {
@@ -654,32 +1316,52 @@ void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
 
     size_total = 0;
     for (;;) {
-        if (loading_chunks) {
-            if ((size_total + FILE_CHUNK_SIZE) > size) {
-                size = (size_total + FILE_CHUNK_SIZE);
-                if (size >= SDL_SIZE_MAX) {
-                    newdata = NULL;
-                } else {
-                    newdata = SDL_realloc(data, (size_t)(size + 1));
-                }
-                if (!newdata) {
-                    SDL_free(data);
-                    data = NULL;
-                    SDL_OutOfMemory();
-                    goto done;
-                }
-                data = newdata;
+        if (size_total == size) {
+            if (!loading_chunks) {
+                break;
             }
-        }
 
-        size_read = SDL_RWread(src, data + size_total, (size_t)(size - size_total));
-        if (size_read > 0) {
+            /* Make sure there's more data before growing the buffer */
+            size_read = SDL_RWread(src, probe, sizeof(probe));
+            if (size_read == 0) {
+                break;
+            }
+
+            /* Grow geometrically, so large streams aren't copied over and over */
+            grow = SDL_max(size / 2, FILE_CHUNK_SIZE);
+            if ((Uint64)grow >= (Uint64)SDL_SIZE_MAX - (Uint64)size) {
+                newdata = NULL;
+            } else {
+                newdata = (char *)SDL_realloc(data, (size_t)(size + grow + 1));
+            }
+            if (!newdata) {
+                SDL_free(data);
+                data = NULL;
+                SDL_OutOfMemory();
+                goto done;
+            }
+            data = newdata;
+            size += grow;
+
+            SDL_memcpy(data + size_total, probe, size_read);
             size_total += size_read;
             continue;
         }
 
-        /* The stream status will remain set for the caller to check */
-        break;
+        size_read = SDL_RWread(src, data + size_total, (size_t)(size - size_total));
+        if (size_read == 0) {
+            /* The stream status will remain set for the caller to check */
+            break;
+        }
+        size_total += size_read;
+    }
+
+    if (loading_chunks && size_total < size) {
+        /* Give back the unused part of the buffer */
+        newdata = (char *)SDL_realloc(data, (size_t)(size_total + 1));
+        if (newdata) {
+            data = newdata;
+        }
     }
 
     if (datasize) {
@@ -712,6 +1394,30 @@ SDL_PropertiesID SDL_GetRWProperties(SDL_RWops *context)
     return context->props;
 }
 
+const void *SDL_GetRWMemory(SDL_RWops *context, size_t *size)
+{
+    if (size) {
+        *size = 0;
+    }
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    }
+
+    switch (context->type) {
+    case SDL_RWOPS_MEMORY:
+    case SDL_RWOPS_MEMORY_RO:
+    case SDL_RWOPS_MAPPED:
+        if (size) {
+            *size = (size_t)(context->hidden.mem.stop - context->hidden.mem.base);
+        }
+        return context->hidden.mem.base;
+    default:
+        return NULL;
+    }
+}
+
 Sint64 SDL_RWsize(SDL_RWops *context)
 {
     if (!context) {
@@ -808,6 +1514,145 @@ size_t SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size)
     return bytes;
 }
 
+/* Reads and writes at an offset for streams that can't do it themselves */
+static size_t SDL_RWreadAtBySeeking(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    const Sint64 position = SDL_RWtell(context);
+    size_t bytes = 0;
+
+    if (position < 0) {
+        return 0;
+    }
+    if (SDL_RWseek(context, offset, SDL_RW_SEEK_SET) == offset) {
+        bytes = context->read(context, ptr, size);
+    }
+    SDL_RWseek(context, position, SDL_RW_SEEK_SET);
+    return bytes;
+}
+
+static size_t SDL_RWwriteAtBySeeking(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    const Sint64 position = SDL_RWtell(context);
+    size_t bytes = 0;
+
+    if (position < 0) {
+        return 0;
+    }
+    if (SDL_RWseek(context, offset, SDL_RW_SEEK_SET) == offset) {
+        bytes = context->write(context, ptr, size);
+    }
+    SDL_RWseek(context, position, SDL_RW_SEEK_SET);
+    return bytes;
+}
+
+size_t SDL_RWreadAt(SDL_RWops *context, void *ptr, size_t size, Sint64 offset)
+{
+    size_t total = 0;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (offset < 0) {
+        SDL_InvalidParamError("offset");
+        return 0;
+    }
+    if (!context->readat && (!context->read || !context->seek)) {
+        SDL_Unsupported();
+        return 0;
+    }
+
+    SDL_ClearError();
+
+    while (total < size) {
+        void *dst = (Uint8 *)ptr + total;
+        size_t bytes;
+
+        if (context->readat) {
+            bytes = context->readat(context, dst, size - total, offset + (Sint64)total);
+        } else {
+            bytes = SDL_RWreadAtBySeeking(context, dst, size - total, offset + (Sint64)total);
+        }
+        if (bytes == 0) {
+            break;
+        }
+        total += bytes;
+    }
+    return total;
+}
+
+size_t SDL_RWreadvAt(SDL_RWops *context, const SDL_RWvec *vec, int count, Sint64 offset)
+{
+    size_t total = 0;
+    int i;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (!vec && count > 0) {
+        SDL_InvalidParamError("vec");
+        return 0;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (context->readvat) {
+        if (offset < 0) {
+            SDL_InvalidParamError("offset");
+            return 0;
+        }
+        SDL_ClearError();
+        return context->readvat(context, vec, count, offset);
+    }
+
+    for (i = 0; i < count; ++i) {
+        const size_t bytes = SDL_RWreadAt(context, vec[i].ptr, vec[i].size, offset + (Sint64)total);
+        total += bytes;
+        if (bytes < vec[i].size) {
+            break;
+        }
+    }
+    return total;
+}
+
+size_t SDL_RWwriteAt(SDL_RWops *context, const void *ptr, size_t size, Sint64 offset)
+{
+    size_t total = 0;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (offset < 0) {
+        SDL_InvalidParamError("offset");
+        return 0;
+    }
+    if (!context->writeat && (!context->write || !context->seek)) {
+        SDL_Unsupported();
+        return 0;
+    }
+
+    SDL_ClearError();
+
+    while (total < size) {
+        const void *src = (const Uint8 *)ptr + total;
+        size_t bytes;
+
+        if (context->writeat) {
+            bytes = context->writeat(context, src, size - total, offset + (Sint64)total);
+        } else {
+            bytes = SDL_RWwriteAtBySeeking(context, src, size - total, offset + (Sint64)total);
+        }
+        if (bytes == 0) {
+            break;
+        }
+        total += bytes;
+    }
+    return total;
+}
+
 size_t SDL_RWprintf(SDL_RWops *context, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
 {
     va_list ap;
@@ -857,12 +1702,45 @@ int SDL_RWclose(SDL_RWops *context)
 
 /* Functions for dynamically reading and writing endian-specific values */
 
+/* Small reads that buffered and memory streams already have the data for
+   don't need to go through the read callback */
+static SDL_INLINE SDL_bool SDL_ReadValue(SDL_RWops *src, void *ptr, size_t size)
+{
+    Uint8 **here = NULL;
+    Uint8 *stop = NULL;
+
+    if (src) {
+        switch (src->type) {
+        case SDL_RWOPS_MEMORY:
+        case SDL_RWOPS_MEMORY_RO:
+        case SDL_RWOPS_MAPPED:
+            here = &src->hidden.mem.here;
+            stop = src->hidden.mem.stop;
+            break;
+        case SDL_RWOPS_BUFFERED:
+            here = &src->hidden.buffered.here;
+            stop = src->hidden.buffered.stop;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (here && (size_t)(stop - *here) >= size) {
+        SDL_memcpy(ptr, *here, size);
+        *here += size;
+        src->status = SDL_RWOPS_STATUS_READY;
+        return SDL_TRUE;
+    }
+    return (SDL_RWread(src, ptr, size) == size);
+}
+
 SDL_bool SDL_ReadU8(SDL_RWops *src, Uint8 *value)
 {
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -876,7 +1754,7 @@ SDL_bool SDL_ReadU16LE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -895,7 +1773,7 @@ SDL_bool SDL_ReadU16BE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -914,7 +1792,7 @@ SDL_bool SDL_ReadU32LE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -933,7 +1811,7 @@ SDL_bool SDL_ReadU32BE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -952,7 +1830,7 @@ SDL_bool SDL_ReadU64LE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -971,7 +1849,7 @@ SDL_bool SDL_ReadU64BE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
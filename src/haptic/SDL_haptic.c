@@ -23,6 +23,22 @@
 #include "SDL_syshaptic.h"
 #include "SDL_haptic_c.h"
 #include "../joystick/SDL_joystick_c.h" /* For SDL_IsJoystickValid */
+#include "../thread/SDL_systhread.h"
+
+/* Streamed force levels waiting to be played */
+struct haptic_stream
+{
+    SDL_Haptic *haptic;
+    SDL_Thread *thread;
+    SDL_Mutex *lock;
+    SDL_AtomicInt done;
+    Uint64 interval_ns;
+    int effect;
+    SDL_HapticEffect data;
+    Sint16 levels[SDL_HAPTIC_STREAM_SIZE];
+    int first;
+    int count;
+};
 
 /* Global for SDL_windowshaptic.c */
 #if (defined(SDL_HAPTIC_DINPUT) && SDL_HAPTIC_DINPUT) || (defined(SDL_HAPTIC_XINPUT) && SDL_HAPTIC_XINPUT)
@@ -343,6 +359,9 @@ void SDL_HapticClose(SDL_Haptic *haptic)
     }
 
     /* Close it, properly removing effects if needed */
+    if (haptic->stream) {
+        SDL_HapticStreamStop(haptic);
+    }
     for (i = 0; i < haptic->neffects; i++) {
         if (haptic->effects[i].hweffect != NULL) {
             SDL_HapticDestroyEffect(haptic, i);
@@ -811,3 +830,196 @@ int SDL_HapticRumbleStop(SDL_Haptic *haptic)
 
     return SDL_HapticStopEffect(haptic, haptic->rumble_id);
 }
+
+/*
+ * Plays the streamed levels at a fixed rate, independently of the application's frame rate.
+ */
+static int SDLCALL SDL_HapticStreamThread(void *data)
+{
+    struct haptic_stream *stream = (struct haptic_stream *)data;
+    SDL_Haptic *haptic = stream->haptic;
+    Uint64 next = SDL_GetTicksNS();
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_AtomicGet(&stream->done)) {
+        Uint64 now;
+        Sint16 level = 0;
+
+        SDL_LockMutex(stream->lock);
+        if (stream->count > 0) {
+            level = stream->levels[stream->first];
+            stream->first = (stream->first + 1) % SDL_HAPTIC_STREAM_SIZE;
+            --stream->count;
+        }
+        SDL_UnlockMutex(stream->lock);
+
+        /* Each change is a separate upload, so only send the ones that matter */
+        if (level != stream->data.constant.level) {
+            stream->data.constant.level = level;
+            SDL_SYS_HapticUpdateEffect(haptic, &haptic->effects[stream->effect], &stream->data);
+        }
+
+        next += stream->interval_ns;
+        now = SDL_GetTicksNS();
+        if (next > now) {
+            SDL_DelayNS(next - now);
+        } else if (now - next > stream->interval_ns) {
+            /* We fell behind, don't try to catch up with a burst of uploads */
+            next = now;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Starts streaming a constant force on a haptic device.
+ */
+int SDL_HapticStreamStart(SDL_Haptic *haptic, int rate)
+{
+    struct haptic_stream *stream;
+
+    if (!ValidHaptic(haptic)) {
+        return -1;
+    }
+
+    if (rate <= 0) {
+        return SDL_InvalidParamError("rate");
+    }
+
+    if (!(haptic->supported & SDL_HAPTIC_CONSTANT)) {
+        return SDL_SetError("Haptic: Device doesn't support constant force effects");
+    }
+
+    if (haptic->stream) {
+        return SDL_SetError("Haptic: Streaming already started on haptic device");
+    }
+
+    stream = (struct haptic_stream *)SDL_calloc(1, sizeof(*stream));
+    if (!stream) {
+        return SDL_OutOfMemory();
+    }
+    stream->haptic = haptic;
+    stream->interval_ns = SDL_NS_PER_SECOND / rate;
+
+    stream->data.type = SDL_HAPTIC_CONSTANT;
+    stream->data.constant.type = SDL_HAPTIC_CONSTANT;
+    stream->data.constant.direction.type = SDL_HAPTIC_CARTESIAN;
+    stream->data.constant.direction.dir[0] = 1;
+    stream->data.constant.length = SDL_HAPTIC_INFINITY;
+    stream->data.constant.level = 0;
+
+    stream->effect = SDL_HapticNewEffect(haptic, &stream->data);
+    if (stream->effect < 0) {
+        SDL_free(stream);
+        return -1;
+    }
+    if (SDL_HapticRunEffect(haptic, stream->effect, 1) < 0) {
+        SDL_HapticDestroyEffect(haptic, stream->effect);
+        SDL_free(stream);
+        return -1;
+    }
+
+    stream->lock = SDL_CreateMutex();
+    if (!stream->lock) {
+        SDL_HapticDestroyEffect(haptic, stream->effect);
+        SDL_free(stream);
+        return -1;
+    }
+
+    stream->thread = SDL_CreateThreadInternal(SDL_HapticStreamThread, "SDLHapticStream", 0, stream);
+    if (!stream->thread) {
+        SDL_DestroyMutex(stream->lock);
+        SDL_HapticDestroyEffect(haptic, stream->effect);
+        SDL_free(stream);
+        return -1;
+    }
+
+    haptic->stream = stream;
+    return 0;
+}
+
+/*
+ * Queues force levels to be played on a haptic device.
+ */
+int SDL_HapticStreamQueue(SDL_Haptic *haptic, const Sint16 *levels, int num_levels)
+{
+    struct haptic_stream *stream;
+    int i;
+
+    if (!ValidHaptic(haptic)) {
+        return -1;
+    }
+
+    if (!levels) {
+        return SDL_InvalidParamError("levels");
+    }
+
+    stream = haptic->stream;
+    if (!stream) {
+        return SDL_SetError("Haptic: Streaming not started on haptic device");
+    }
+
+    SDL_LockMutex(stream->lock);
+    num_levels = SDL_clamp(num_levels, 0, SDL_HAPTIC_STREAM_SIZE - stream->count);
+    for (i = 0; i < num_levels; ++i) {
+        stream->levels[(stream->first + stream->count) % SDL_HAPTIC_STREAM_SIZE] = levels[i];
+        ++stream->count;
+    }
+    SDL_UnlockMutex(stream->lock);
+
+    return num_levels;
+}
+
+/*
+ * Gets the number of force levels waiting to be played on a haptic device.
+ */
+int SDL_HapticStreamQueued(SDL_Haptic *haptic)
+{
+    struct haptic_stream *stream;
+    int count;
+
+    if (!ValidHaptic(haptic)) {
+        return -1;
+    }
+
+    stream = haptic->stream;
+    if (!stream) {
+        return SDL_SetError("Haptic: Streaming not started on haptic device");
+    }
+
+    SDL_LockMutex(stream->lock);
+    count = stream->count;
+    SDL_UnlockMutex(stream->lock);
+
+    return count;
+}
+
+/*
+ * Stops streaming on a haptic device.
+ */
+int SDL_HapticStreamStop(SDL_Haptic *haptic)
+{
+    struct haptic_stream *stream;
+
+    if (!ValidHaptic(haptic)) {
+        return -1;
+    }
+
+    stream = haptic->stream;
+    if (!stream) {
+        return SDL_SetError("Haptic: Streaming not started on haptic device");
+    }
+
+    SDL_AtomicSet(&stream->done, 1);
+    SDL_WaitThread(stream->thread, NULL);
+    SDL_DestroyMutex(stream->lock);
+
+    SDL_HapticStopEffect(haptic, stream->effect);
+    SDL_HapticDestroyEffect(haptic, stream->effect);
+
+    haptic->stream = NULL;
+    SDL_free(stream);
+
+    return 0;
+}
@@ -1321,6 +1321,28 @@ Uint32 SDL_hid_device_change_count(void)
     return counter;
 }
 
+int SDL_HIDAPI_GetDeviceChangeFD(void)
+{
+    int fd = -1;
+
+#ifndef SDL_HIDAPI_DISABLED
+    if (SDL_HIDAPI_discovery.m_bInitialized && SDL_HIDAPI_discovery.m_bCanGetNotifications) {
+#ifdef SDL_USE_LIBUDEV
+        if (linux_enumeration_method == ENUMERATION_LIBUDEV) {
+            fd = SDL_HIDAPI_discovery.m_nUdevFd;
+        }
+#endif
+#ifdef HAVE_INOTIFY
+        if (inotify_fd >= 0) {
+            fd = inotify_fd;
+        }
+#endif
+    }
+#endif /* !SDL_HIDAPI_DISABLED */
+
+    return fd;
+}
+
 static void AddDeviceToEnumeration(const char *driver_name, struct hid_device_info *dev, struct SDL_hid_device_info **devs, struct SDL_hid_device_info **last)
 {
     struct SDL_hid_device_info *new_dev;
@@ -1592,6 +1614,17 @@ int SDL_hid_read_timeout(SDL_hid_device *device, unsigned char *data, size_t len
     return device->backend->hid_read_timeout(device->device, data, length, milliseconds);
 }
 
+int SDL_HIDAPI_GetDeviceInputFD(SDL_hid_device *device)
+{
+#if defined(HAVE_PLATFORM_BACKEND) && defined(__LINUX__)
+    /* The hidraw backend reads straight from the device node */
+    if (device && device->magic == &device_magic && device->backend == &PLATFORM_Backend) {
+        return ((PLATFORM_hid_device *)device->device)->device_handle;
+    }
+#endif
+    return -1;
+}
+
 int SDL_hid_read(SDL_hid_device *device, unsigned char *data, size_t length)
 {
     CHECK_DEVICE_MAGIC(device, -1);
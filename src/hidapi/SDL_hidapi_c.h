@@ -24,6 +24,12 @@
 /* Return true if the HIDAPI should ignore a device during enumeration */
 extern SDL_bool SDL_HIDAPI_ShouldIgnoreDevice(int bus_type, Uint16 vendor_id, Uint16 product_id, Uint16 usage_page, Uint16 usage);
 
+/* Return a file descriptor that becomes readable when devices change, or -1 if there isn't one */
+extern int SDL_HIDAPI_GetDeviceChangeFD(void);
+
+/* Return a file descriptor that is readable when the device has input reports, or -1 if the backend doesn't have one */
+extern int SDL_HIDAPI_GetDeviceInputFD(SDL_hid_device *device);
+
 #ifdef SDL_JOYSTICK_HIDAPI
 #ifdef HAVE_LIBUSB
 #define HAVE_ENABLE_GAMECUBE_ADAPTORS
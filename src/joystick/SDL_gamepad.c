@@ -56,6 +56,28 @@
 #define SDL_GAMEPAD_SDKLE_FIELD         "sdk<=:"
 #define SDL_GAMEPAD_SDKLE_FIELD_SIZE    SDL_strlen(SDL_GAMEPAD_SDKLE_FIELD)
 
+/* Compiled mapping databases, as written by build-scripts/gen_gamepad_db.c
+
+   All values are little endian:
+     char magic[8]          "SDLGPDB" with a trailing NUL
+     Uint32 version         SDL_GAMEPAD_DB_VERSION
+     Uint32 num_entries
+     Uint32 strings_size
+     entries[num_entries], each SDL_GAMEPAD_DB_ENTRY_SIZE bytes:
+       Uint8 guid[16]       zero for the "default" and "xinput" mappings
+       Uint32 flags         SDL_GAMEPAD_DB_FLAG_*
+       Uint32 name_offset
+       Uint32 mapping_offset    the mapping text following the name
+       Uint32 platform_offset
+     char strings[strings_size]   NUL terminated strings referenced by offset
+ */
+#define SDL_GAMEPAD_DB_MAGIC            "SDLGPDB"
+#define SDL_GAMEPAD_DB_VERSION          1
+#define SDL_GAMEPAD_DB_HEADER_SIZE      20
+#define SDL_GAMEPAD_DB_ENTRY_SIZE       32
+#define SDL_GAMEPAD_DB_FLAG_DEFAULT     0x01 /* the "default" mapping */
+#define SDL_GAMEPAD_DB_FLAG_XINPUT      0x02 /* the "xinput" mapping */
+
 static SDL_bool SDL_gamepads_initialized;
 static SDL_Gamepad *SDL_gamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 
@@ -85,6 +107,7 @@ typedef struct GamepadMapping_t
     char *mapping _guarded;
     SDL_GamepadMappingPriority priority _guarded;
     struct GamepadMapping_t *next _guarded;
+    struct GamepadMapping_t *hash_next _guarded;
 } GamepadMapping_t;
 
 typedef struct
@@ -102,6 +125,11 @@ typedef struct
 
 static SDL_JoystickGUID s_zeroGUID;
 static GamepadMapping_t *s_pSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pSupportedGamepadsTail SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static int s_nSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = 0;
+/* The mappings are also indexed by GUID, ignoring the version and CRC so every kind of match is found in one bucket */
+static GamepadMapping_t **s_pGamepadMappingBuckets SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static int s_nGamepadMappingBuckets SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static GamepadMapping_t *s_pDefaultMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pXInputMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static MappingChangeTracker *s_mappingChangeTracker SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
@@ -154,6 +182,7 @@ static void SDLCALL SDL_GamepadIgnoreDevicesExceptChanged(void *userdata, const
 }
 
 static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_GamepadMappingPriority priority);
+static int SDL_PrivateAddGamepadMappingsFromDB(const Uint8 *data, size_t size);
 static void SDL_PrivateLoadButtonMapping(SDL_Gamepad *gamepad, GamepadMapping_t *pGamepadMapping);
 static GamepadMapping_t *SDL_PrivateGetGamepadMapping(SDL_JoystickID instance_id);
 static int SDL_SendGamepadAxis(Uint64 timestamp, SDL_Gamepad *gamepad, SDL_GamepadAxis axis, Sint16 value);
@@ -855,6 +884,66 @@ static GamepadMapping_t *SDL_CreateMappingForWGIGamepad(SDL_JoystickGUID guid)
     return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
+static Uint32 SDL_HashGamepadMappingGUID(SDL_JoystickGUID guid)
+{
+    SDL_SetJoystickGUIDCRC(&guid, 0);
+    SDL_SetJoystickGUIDVersion(&guid, 0);
+    return SDL_crc32(0, &guid, sizeof(guid));
+}
+
+/*
+ * Helper function to add a mapping to the end of its hash bucket, keeping the buckets in database order
+ */
+static void SDL_PrivateIndexGamepadMapping(GamepadMapping_t *mapping)
+{
+    GamepadMapping_t **link;
+
+    SDL_AssertJoysticksLocked();
+
+    mapping->hash_next = NULL;
+
+    if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
+        /* Mappings without a GUID are never matched */
+        return;
+    }
+
+    link = &s_pGamepadMappingBuckets[SDL_HashGamepadMappingGUID(mapping->guid) & (s_nGamepadMappingBuckets - 1)];
+    while (*link) {
+        link = &(*link)->hash_next;
+    }
+    *link = mapping;
+}
+
+/*
+ * Helper function to make sure there's room in the GUID index for another mapping
+ */
+static int SDL_PrivateGrowGamepadMappingIndex(void)
+{
+    GamepadMapping_t **buckets;
+    GamepadMapping_t *mapping;
+    int num_buckets;
+
+    SDL_AssertJoysticksLocked();
+
+    if (s_nSupportedGamepads < s_nGamepadMappingBuckets) {
+        return 0;
+    }
+
+    num_buckets = s_nGamepadMappingBuckets ? s_nGamepadMappingBuckets * 2 : 256;
+    buckets = (GamepadMapping_t **)SDL_calloc(num_buckets, sizeof(*buckets));
+    if (!buckets) {
+        return SDL_OutOfMemory();
+    }
+    SDL_free(s_pGamepadMappingBuckets);
+    s_pGamepadMappingBuckets = buckets;
+    s_nGamepadMappingBuckets = num_buckets;
+
+    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
+        SDL_PrivateIndexGamepadMapping(mapping);
+    }
+    return 0;
+}
+
 /*
  * Helper function to scan the mappings database for a gamepad with the specified GUID
  */
@@ -865,6 +954,10 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
 
     SDL_AssertJoysticksLocked();
 
+    if (!s_pGamepadMappingBuckets) {
+        return NULL;
+    }
+
     if (match_crc) {
         SDL_GetJoystickGUIDInfo(guid, NULL, NULL, NULL, &crc);
     }
@@ -876,13 +969,10 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
         SDL_SetJoystickGUIDVersion(&guid, 0);
     }
 
-    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
+    mapping = s_pGamepadMappingBuckets[SDL_HashGamepadMappingGUID(guid) & (s_nGamepadMappingBuckets - 1)];
+    for (; mapping; mapping = mapping->hash_next) {
         SDL_JoystickGUID mapping_guid;
 
-        if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
-            continue;
-        }
-
         SDL_memcpy(&mapping_guid, &mapping->guid, sizeof(mapping_guid));
         if (!match_version) {
             SDL_SetJoystickGUIDVersion(&mapping_guid, 0);
@@ -1530,12 +1620,12 @@ static char *SDL_PrivateGetGamepadMappingFromMappingString(const char *pMapping)
 /*
  * Helper function to add a mapping for a guid
  */
+static GamepadMapping_t *SDL_PrivateAddMappingForGUIDAndStrings(SDL_JoystickGUID jGUID, char *pchName, char *pchMapping, SDL_bool *existing, SDL_GamepadMappingPriority priority);
+
 static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_GamepadMappingPriority priority)
 {
     char *pchName;
     char *pchMapping;
-    GamepadMapping_t *pGamepadMapping;
-    Uint16 crc;
 
     SDL_AssertJoysticksLocked();
 
@@ -1552,6 +1642,19 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         return NULL;
     }
 
+    return SDL_PrivateAddMappingForGUIDAndStrings(jGUID, pchName, pchMapping, existing, priority);
+}
+
+/*
+ * Helper function to add a mapping for a guid, taking ownership of the name and mapping strings
+ */
+static GamepadMapping_t *SDL_PrivateAddMappingForGUIDAndStrings(SDL_JoystickGUID jGUID, char *pchName, char *pchMapping, SDL_bool *existing, SDL_GamepadMappingPriority priority)
+{
+    GamepadMapping_t *pGamepadMapping;
+    Uint16 crc;
+
+    SDL_AssertJoysticksLocked();
+
     /* Fix up the GUID and the mapping with the CRC, if needed */
     SDL_GetJoystickGUIDInfo(jGUID, NULL, NULL, NULL, &crc);
     if (crc) {
@@ -1615,6 +1718,12 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         }
         AddMappingChangeTracking(pGamepadMapping);
     } else {
+        if (SDL_PrivateGrowGamepadMappingIndex() < 0) {
+            PopMappingChangeTracking();
+            SDL_free(pchName);
+            SDL_free(pchMapping);
+            return NULL;
+        }
         pGamepadMapping = SDL_malloc(sizeof(*pGamepadMapping));
         if (!pGamepadMapping) {
             PopMappingChangeTracking();
@@ -1633,19 +1742,16 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         pGamepadMapping->next = NULL;
         pGamepadMapping->priority = priority;
 
-        if (s_pSupportedGamepads) {
-            /* Add the mapping to the end of the list */
-            GamepadMapping_t *pCurrMapping, *pPrevMapping;
-
-            for (pPrevMapping = s_pSupportedGamepads, pCurrMapping = pPrevMapping->next;
-                 pCurrMapping;
-                 pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next) {
-                /* continue; */
-            }
-            pPrevMapping->next = pGamepadMapping;
+        /* Add the mapping to the end of the list */
+        if (s_pSupportedGamepadsTail) {
+            s_pSupportedGamepadsTail->next = pGamepadMapping;
         } else {
             s_pSupportedGamepads = pGamepadMapping;
         }
+        s_pSupportedGamepadsTail = pGamepadMapping;
+        ++s_nSupportedGamepads;
+        SDL_PrivateIndexGamepadMapping(pGamepadMapping);
+
         if (existing) {
             *existing = SDL_FALSE;
         }
@@ -1814,6 +1920,11 @@ int SDL_AddGamepadMappingsFromRW(SDL_RWops *src, SDL_bool freesrc)
 
     PushMappingChangeTracking();
 
+    if (db_size >= sizeof(SDL_GAMEPAD_DB_MAGIC) && SDL_memcmp(buf, SDL_GAMEPAD_DB_MAGIC, sizeof(SDL_GAMEPAD_DB_MAGIC)) == 0) {
+        gamepads = SDL_PrivateAddGamepadMappingsFromDB((const Uint8 *)buf, db_size);
+        db_size = 0; /* Skip the text parsing below */
+    }
+
     while (line < buf + db_size) {
         line_end = SDL_strchr(line, '\n');
         if (line_end) {
@@ -1878,23 +1989,10 @@ int SDL_ReloadGamepadMappings(void)
 }
 
 /*
- * Add or update an entry into the Mappings Database with a priority
+ * Check the hint and SDK version conditions in a mapping, returning 1 if it should be added, 0 if it should be skipped, or -1 on error
  */
-static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMappingPriority priority)
+static int SDL_PrivateCheckGamepadMappingConditions(const char *mappingString)
 {
-    char *pchGUID;
-    SDL_JoystickGUID jGUID;
-    SDL_bool is_default_mapping = SDL_FALSE;
-    SDL_bool is_xinput_mapping = SDL_FALSE;
-    SDL_bool existing = SDL_FALSE;
-    GamepadMapping_t *pGamepadMapping;
-
-    SDL_AssertJoysticksLocked();
-
-    if (!mappingString) {
-        return SDL_InvalidParamError("mappingString");
-    }
-
     { /* Extract and verify the hint field */
         const char *tmp;
 
@@ -1957,6 +2055,33 @@ static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMa
     }
 #endif
 
+    return 1;
+}
+
+/*
+ * Add or update an entry into the Mappings Database with a priority
+ */
+static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMappingPriority priority)
+{
+    char *pchGUID;
+    SDL_JoystickGUID jGUID;
+    SDL_bool is_default_mapping = SDL_FALSE;
+    SDL_bool is_xinput_mapping = SDL_FALSE;
+    SDL_bool existing = SDL_FALSE;
+    GamepadMapping_t *pGamepadMapping;
+    int result;
+
+    SDL_AssertJoysticksLocked();
+
+    if (!mappingString) {
+        return SDL_InvalidParamError("mappingString");
+    }
+
+    result = SDL_PrivateCheckGamepadMappingConditions(mappingString);
+    if (result <= 0) {
+        return result;
+    }
+
     pchGUID = SDL_PrivateGetGamepadGUIDFromMappingString(mappingString);
     if (!pchGUID) {
         return SDL_SetError("Couldn't parse GUID from %s", mappingString);
@@ -1986,6 +2111,89 @@ static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMa
     }
 }
 
+static Uint32 SDL_PrivateReadGamepadDB32(const Uint8 *data)
+{
+    Uint32 value;
+
+    SDL_memcpy(&value, data, sizeof(value));
+    return SDL_SwapLE32(value);
+}
+
+/*
+ * Add the entries of a compiled mapping database
+ */
+static int SDL_PrivateAddGamepadMappingsFromDB(const Uint8 *data, size_t size)
+{
+    const char *platform = SDL_GetPlatform();
+    const char *strings;
+    const Uint8 *entry;
+    Uint32 i, version, num_entries, strings_size;
+    int gamepads = 0;
+
+    SDL_AssertJoysticksLocked();
+
+    if (size < SDL_GAMEPAD_DB_HEADER_SIZE) {
+        return SDL_SetError("Corrupt gamepad mapping database");
+    }
+    version = SDL_PrivateReadGamepadDB32(data + 8);
+    if (version != SDL_GAMEPAD_DB_VERSION) {
+        return SDL_SetError("Unsupported gamepad mapping database version %u", (unsigned int)version);
+    }
+    num_entries = SDL_PrivateReadGamepadDB32(data + 12);
+    strings_size = SDL_PrivateReadGamepadDB32(data + 16);
+    size -= SDL_GAMEPAD_DB_HEADER_SIZE;
+    if (num_entries > size / SDL_GAMEPAD_DB_ENTRY_SIZE ||
+        strings_size == 0 || strings_size != size - (size_t)num_entries * SDL_GAMEPAD_DB_ENTRY_SIZE ||
+        data[SDL_GAMEPAD_DB_HEADER_SIZE + size - 1] != '\0') {
+        return SDL_SetError("Corrupt gamepad mapping database");
+    }
+    entry = data + SDL_GAMEPAD_DB_HEADER_SIZE;
+    strings = (const char *)entry + (size_t)num_entries * SDL_GAMEPAD_DB_ENTRY_SIZE;
+
+    for (i = 0; i < num_entries; ++i, entry += SDL_GAMEPAD_DB_ENTRY_SIZE) {
+        const Uint32 flags = SDL_PrivateReadGamepadDB32(entry + 16);
+        const Uint32 name_offset = SDL_PrivateReadGamepadDB32(entry + 20);
+        const Uint32 mapping_offset = SDL_PrivateReadGamepadDB32(entry + 24);
+        const Uint32 platform_offset = SDL_PrivateReadGamepadDB32(entry + 28);
+        SDL_JoystickGUID jGUID;
+        SDL_bool existing = SDL_FALSE;
+        GamepadMapping_t *pGamepadMapping;
+        char *pchName, *pchMapping;
+
+        /* The strings end with a NUL, so any offset inside them is a valid string */
+        if (name_offset >= strings_size || mapping_offset >= strings_size || platform_offset >= strings_size) {
+            return SDL_SetError("Corrupt gamepad mapping database");
+        }
+
+        if (SDL_strcasecmp(strings + platform_offset, platform) != 0) {
+            continue;
+        }
+        if (SDL_PrivateCheckGamepadMappingConditions(strings + mapping_offset) <= 0) {
+            continue;
+        }
+
+        pchName = SDL_strdup(strings + name_offset);
+        pchMapping = SDL_strdup(strings + mapping_offset);
+        if (!pchName || !pchMapping) {
+            SDL_free(pchName);
+            SDL_free(pchMapping);
+            return SDL_OutOfMemory();
+        }
+
+        SDL_memcpy(jGUID.data, entry, sizeof(jGUID.data));
+        pGamepadMapping = SDL_PrivateAddMappingForGUIDAndStrings(jGUID, pchName, pchMapping, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_API);
+        if (pGamepadMapping && !existing) {
+            if (flags & SDL_GAMEPAD_DB_FLAG_DEFAULT) {
+                s_pDefaultMapping = pGamepadMapping;
+            } else if (flags & SDL_GAMEPAD_DB_FLAG_XINPUT) {
+                s_pXInputMapping = pGamepadMapping;
+            }
+            ++gamepads;
+        }
+    }
+    return gamepads;
+}
+
 /*
  * Add or update an entry into the Mappings Database
  */
@@ -3152,6 +3360,35 @@ int SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *d
     return SDL_Unsupported();
 }
 
+int SDL_GetGamepadSensorDataBatch(SDL_Gamepad *gamepad, SDL_SensorType type, SDL_SensorSample *samples, int num_samples)
+{
+    int retval = -1;
+    SDL_bool found = SDL_FALSE;
+
+    SDL_LockJoysticks();
+    {
+        SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
+        if (joystick) {
+            int i;
+            for (i = 0; i < joystick->nsensors; ++i) {
+                SDL_JoystickSensorInfo *sensor = &joystick->sensors[i];
+
+                if (sensor->type == type) {
+                    retval = SDL_ReadSensorBatch(&sensor->batch, samples, num_samples);
+                    found = SDL_TRUE;
+                    break;
+                }
+            }
+            if (!found) {
+                SDL_Unsupported();
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return retval;
+}
+
 SDL_JoystickID SDL_GetGamepadInstanceID(SDL_Gamepad *gamepad)
 {
     SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
@@ -3577,6 +3814,11 @@ void SDL_QuitGamepadMappings(void)
         SDL_free(pGamepadMap->mapping);
         SDL_free(pGamepadMap);
     }
+    s_pSupportedGamepadsTail = NULL;
+    s_nSupportedGamepads = 0;
+    SDL_free(s_pGamepadMappingBuckets);
+    s_pGamepadMappingBuckets = NULL;
+    s_nGamepadMappingBuckets = 0;
 
     SDL_DelHintCallback(SDL_HINT_GAMECONTROLLER_IGNORE_DEVICES,
                         SDL_GamepadIgnoreDevicesChanged, NULL);
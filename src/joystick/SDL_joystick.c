@@ -32,6 +32,8 @@
 #endif
 #include "../video/SDL_sysvideo.h"
 #include "../sensor/SDL_sensor_c.h"
+#include "../thread/SDL_lockprofile.h"
+#include "../SDL_trace_c.h"
 #include "hidapi/SDL_hidapijoystick_c.h"
 
 /* This is included in only one place because it has a large static list of controllers */
@@ -118,6 +120,7 @@ static SDL_bool SDL_joystick_being_added;
 static SDL_Joystick *SDL_joysticks SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static int SDL_joystick_player_count SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static SDL_JoystickID *SDL_joystick_players SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static SDL_bool SDL_joystick_detect_wakeup[SDL_arraysize(SDL_joystick_drivers)] SDL_GUARDED_BY(SDL_joystick_lock);
 static SDL_bool SDL_joystick_allows_background_events = SDL_FALSE;
 char SDL_joystick_magic;
 
@@ -320,6 +323,7 @@ int SDL_InitJoysticks(void)
     /* Create the joystick list lock */
     if (SDL_joystick_lock == NULL) {
         SDL_joystick_lock = SDL_CreateMutex();
+        SDL_SetMutexName(SDL_joystick_lock, "SDL_joystick_lock");
     }
 
 #ifndef SDL_EVENTS_DISABLED
@@ -340,8 +344,12 @@ int SDL_InitJoysticks(void)
 
     status = -1;
     for (i = 0; i < SDL_arraysize(SDL_joystick_drivers); ++i) {
+        SDL_joystick_detect_wakeup[i] = SDL_FALSE;
         if (SDL_joystick_drivers[i]->Init() >= 0) {
             status = 0;
+        } else {
+            /* This driver won't find any devices */
+            SDL_joystick_detect_wakeup[i] = SDL_TRUE;
         }
     }
     SDL_UnlockJoysticks();
@@ -370,6 +378,64 @@ SDL_bool SDL_JoysticksOpened(void)
     return opened;
 }
 
+SDL_bool SDL_JoysticksNeedPolling(void)
+{
+    SDL_Joystick *joystick;
+    SDL_bool need_polling = SDL_FALSE;
+
+    SDL_LockJoysticks();
+    {
+        for (joystick = SDL_joysticks; joystick; joystick = joystick->next) {
+            if (!joystick->input_wakeup ||
+                joystick->delayed_guide_button ||
+                joystick->rumble_expiration || joystick->rumble_resend ||
+                joystick->trigger_rumble_expiration ||
+                joystick->led_expiration) {
+                need_polling = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return need_polling;
+}
+
+void SDL_SetJoystickDetectWakeup(SDL_JoystickDriver *driver, SDL_bool enabled)
+{
+    int i;
+
+    SDL_LockJoysticks();
+    {
+        for (i = 0; i < SDL_arraysize(SDL_joystick_drivers); ++i) {
+            if (SDL_joystick_drivers[i] == driver) {
+                SDL_joystick_detect_wakeup[i] = enabled;
+                break;
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+}
+
+SDL_bool SDL_JoysticksNeedPeriodicPoll(void)
+{
+    int i;
+    SDL_bool need_periodic_poll = SDL_FALSE;
+
+    SDL_LockJoysticks();
+    {
+        for (i = 0; i < SDL_arraysize(SDL_joystick_drivers); ++i) {
+            if (!SDL_joystick_detect_wakeup[i]) {
+                need_periodic_poll = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return need_periodic_poll;
+}
+
 SDL_JoystickID *SDL_GetJoysticks(int *count)
 {
     int i, num_joysticks, device_index;
@@ -713,6 +779,26 @@ static void CleanupSensorFusion(SDL_Joystick *joystick)
     }
 }
 
+/* State changes can nest, for example sends within a driver update, so that snapshots contain whole reports */
+static void SDL_BeginJoystickStateUpdate(SDL_Joystick *joystick)
+{
+    SDL_AssertJoysticksLocked();
+
+    if (joystick->state_update_depth++ == 0) {
+        SDL_AtomicAdd(&joystick->state_sequence, 1);
+    }
+}
+
+static void SDL_EndJoystickStateUpdate(SDL_Joystick *joystick)
+{
+    SDL_AssertJoysticksLocked();
+
+    SDL_assert(joystick->state_update_depth > 0);
+    if (--joystick->state_update_depth == 0) {
+        SDL_AtomicAdd(&joystick->state_sequence, 1);
+    }
+}
+
 /*
  * Open a joystick for use - the index passed as an argument refers to
  * the N'th joystick on the system.  This index is the value which will
@@ -831,7 +917,9 @@ SDL_Joystick *SDL_OpenJoystick(SDL_JoystickID instance_id)
     joystick->epowerlevel = SDL_JOYSTICK_POWER_UNKNOWN;
     SDL_SendJoystickBatteryLevel(joystick, initial_power_level);
 
+    SDL_BeginJoystickStateUpdate(joystick);
     driver->Update(joystick);
+    SDL_EndJoystickStateUpdate(joystick);
 
     SDL_UnlockJoysticks();
 
@@ -957,6 +1045,25 @@ int SDL_SetJoystickVirtualHat(SDL_Joystick *joystick, int hat, Uint8 value)
     return retval;
 }
 
+int SDL_SetJoystickVirtualState(SDL_Joystick *joystick, const SDL_JoystickSnapshot *state)
+{
+    int retval;
+
+    SDL_LockJoysticks();
+    {
+        CHECK_JOYSTICK_MAGIC(joystick, -1);
+
+#ifdef SDL_JOYSTICK_VIRTUAL
+        retval = SDL_SetJoystickVirtualStateInner(joystick, state);
+#else
+        retval = SDL_SetError("SDL not built with virtual-joystick support");
+#endif
+    }
+    SDL_UnlockJoysticks();
+
+    return retval;
+}
+
 /*
  * Checks to make sure the joystick is valid.
  */
@@ -1130,6 +1237,52 @@ Uint8 SDL_GetJoystickButton(SDL_Joystick *joystick, int button)
     return state;
 }
 
+int SDL_GetJoystickSnapshot(SDL_Joystick *joystick, SDL_JoystickSnapshot *snapshot)
+{
+    int i, sequence;
+
+    /* This is called without SDL_joystick_lock, the caller guarantees the joystick stays open */
+    if (!joystick || joystick->magic != &SDL_joystick_magic) {
+        return SDL_InvalidParamError("joystick");
+    }
+    if (!snapshot) {
+        return SDL_InvalidParamError("snapshot");
+    }
+
+    do {
+        while ((sequence = SDL_AtomicGet(&joystick->state_sequence)) & 1) {
+            SDL_CPUPauseInstruction();
+        }
+
+        SDL_zerop(snapshot);
+        snapshot->timestamp = joystick->state_timestamp;
+        snapshot->naxes = SDL_min(joystick->naxes, SDL_JOYSTICK_SNAPSHOT_MAX_AXES);
+        for (i = 0; i < snapshot->naxes; ++i) {
+            snapshot->axes[i] = joystick->axes[i].value;
+        }
+        snapshot->nbuttons = SDL_min(joystick->nbuttons, SDL_JOYSTICK_SNAPSHOT_MAX_BUTTONS);
+        SDL_memcpy(snapshot->buttons, joystick->buttons, snapshot->nbuttons);
+        snapshot->nhats = SDL_min(joystick->nhats, SDL_JOYSTICK_SNAPSHOT_MAX_HATS);
+        SDL_memcpy(snapshot->hats, joystick->hats, snapshot->nhats);
+        for (i = 0; i < joystick->nsensors; ++i) {
+            const SDL_JoystickSensorInfo *sensor = &joystick->sensors[i];
+
+            if (!sensor->enabled) {
+                continue;
+            }
+            if (sensor->type == SDL_SENSOR_GYRO) {
+                SDL_memcpy(snapshot->gyro, sensor->data, sizeof(snapshot->gyro));
+            } else if (sensor->type == SDL_SENSOR_ACCEL) {
+                SDL_memcpy(snapshot->accel, sensor->data, sizeof(snapshot->accel));
+            }
+        }
+
+        SDL_MemoryBarrierAcquire();
+    } while (SDL_AtomicGet(&joystick->state_sequence) != sequence);
+
+    return 0;
+}
+
 /*
  * Return if the joystick in question is currently attached to the system,
  *  \return SDL_FALSE if not plugged in, SDL_TRUE if still present.
@@ -1519,6 +1672,9 @@ void SDL_CloseJoystick(SDL_Joystick *joystick)
             SDL_free(touchpad->fingers);
         }
         SDL_free(joystick->touchpads);
+        for (i = 0; i < joystick->nsensors; i++) {
+            SDL_FreeSensorBatch(&joystick->sensors[i].batch);
+        }
         SDL_free(joystick->sensors);
         SDL_free(joystick);
     }
@@ -1775,7 +1931,9 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
     if (!info->has_initial_value ||
         (!info->has_second_value && (info->initial_value <= -32767 || info->initial_value == 32767) && SDL_abs(value) < (SDL_JOYSTICK_AXIS_MAX / 4))) {
         info->initial_value = value;
+        SDL_BeginJoystickStateUpdate(joystick);
         info->value = value;
+        SDL_EndJoystickStateUpdate(joystick);
         info->zero = value;
         info->has_initial_value = SDL_TRUE;
     } else if (value == info->value && !info->sending_initial_value) {
@@ -1809,7 +1967,10 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
 
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
+    SDL_BeginJoystickStateUpdate(joystick);
     info->value = value;
+    joystick->state_timestamp = timestamp;
+    SDL_EndJoystickStateUpdate(joystick);
     joystick->update_complete = timestamp;
 
     /* Post the event, if desired */
@@ -1853,7 +2014,10 @@ int SDL_SendJoystickHat(Uint64 timestamp, SDL_Joystick *joystick, Uint8 hat, Uin
 
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
+    SDL_BeginJoystickStateUpdate(joystick);
     joystick->hats[hat] = value;
+    joystick->state_timestamp = timestamp;
+    SDL_EndJoystickStateUpdate(joystick);
     joystick->update_complete = timestamp;
 
     /* Post the event, if desired */
@@ -1913,7 +2077,10 @@ int SDL_SendJoystickButton(Uint64 timestamp, SDL_Joystick *joystick, Uint8 butto
 
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
+    SDL_BeginJoystickStateUpdate(joystick);
     joystick->buttons[button] = state;
+    joystick->state_timestamp = timestamp;
+    SDL_EndJoystickStateUpdate(joystick);
     joystick->update_complete = timestamp;
 
     /* Post the event, if desired */
@@ -1930,6 +2097,112 @@ int SDL_SendJoystickButton(Uint64 timestamp, SDL_Joystick *joystick, Uint8 butto
     return posted;
 }
 
+/* Find the next button state that differs from the current state, comparing 16 buttons at a time where possible */
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_FindChangedJoystickButton_SSE2(const Uint8 *current, const Uint8 *states, int start, int count)
+{
+    int i;
+
+    for (i = start; (i + 16) <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)&current[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i *)&states[i]);
+        const int changed = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF;
+        if (changed) {
+            int bit = 0;
+            while (!(changed & (1 << bit))) {
+                ++bit;
+            }
+            return i + bit;
+        }
+    }
+    for (; i < count; ++i) {
+        if (current[i] != states[i]) {
+            return i;
+        }
+    }
+    return count;
+}
+#endif
+
+static int SDL_FindChangedJoystickButton(const Uint8 *current, const Uint8 *states, int start, int count)
+{
+    int i;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_FindChangedJoystickButton_SSE2(current, states, start, count);
+    }
+#endif
+    for (i = start; i < count; ++i) {
+        if (current[i] != states[i]) {
+            return i;
+        }
+    }
+    return count;
+}
+
+int SDL_SendJoystickButtons(Uint64 timestamp, SDL_Joystick *joystick, Uint8 first_button, const Uint8 *states, int num_states)
+{
+    const Uint8 *current;
+    int posted = 0;
+    int i;
+
+    SDL_AssertJoysticksLocked();
+
+    if (first_button >= joystick->nbuttons) {
+        return 0;
+    }
+    num_states = SDL_min(num_states, joystick->nbuttons - first_button);
+    current = &joystick->buttons[first_button];
+
+    i = SDL_FindChangedJoystickButton(current, states, 0, num_states);
+    if (i == num_states) {
+        return 0;
+    }
+
+    /* Only the buttons that changed go through the full event path, and snapshots see them all at once */
+    SDL_BeginJoystickStateUpdate(joystick);
+    for (; i < num_states; i = SDL_FindChangedJoystickButton(current, states, i + 1, num_states)) {
+        posted += SDL_SendJoystickButton(timestamp, joystick, (Uint8)(first_button + i), states[i]);
+    }
+    SDL_EndJoystickStateUpdate(joystick);
+
+    return posted;
+}
+
+int SDL_SendJoystickAxes(Uint64 timestamp, SDL_Joystick *joystick, Uint8 first_axis, const Sint16 *values, int num_values)
+{
+    SDL_bool updating = SDL_FALSE;
+    int posted = 0;
+    int i;
+
+    SDL_AssertJoysticksLocked();
+
+    if (first_axis >= joystick->naxes) {
+        return 0;
+    }
+    num_values = SDL_min(num_values, joystick->naxes - first_axis);
+
+    for (i = 0; i < num_values; ++i) {
+        const SDL_JoystickAxisInfo *info = &joystick->axes[first_axis + i];
+
+        /* This is the same check SDL_SendJoystickAxis() makes before it ignores a value */
+        if (info->has_initial_value && values[i] == info->value) {
+            continue;
+        }
+        if (!updating) {
+            SDL_BeginJoystickStateUpdate(joystick);
+            updating = SDL_TRUE;
+        }
+        posted += SDL_SendJoystickAxis(timestamp, joystick, (Uint8)(first_axis + i), values[i]);
+    }
+    if (updating) {
+        SDL_EndJoystickStateUpdate(joystick);
+    }
+
+    return posted;
+}
+
 void SDL_UpdateJoysticks(void)
 {
     int i;
@@ -1942,6 +2215,8 @@ void SDL_UpdateJoysticks(void)
 
     SDL_LockJoysticks();
 
+    SDL_TRACE_BEGIN("SDL_UpdateJoysticks");
+
 #ifdef SDL_JOYSTICK_HIDAPI
     /* Special function for HIDAPI devices, as a single device can provide multiple SDL_Joysticks */
     HIDAPI_UpdateDevices();
@@ -1949,7 +2224,9 @@ void SDL_UpdateJoysticks(void)
 
     for (joystick = SDL_joysticks; joystick; joystick = joystick->next) {
         if (joystick->attached) {
+            SDL_BeginJoystickStateUpdate(joystick);
             joystick->driver->Update(joystick);
+            SDL_EndJoystickStateUpdate(joystick);
 
             if (joystick->delayed_guide_button) {
                 SDL_GamepadHandleDelayedGuideButton(joystick);
@@ -1997,6 +2274,8 @@ void SDL_UpdateJoysticks(void)
         SDL_joystick_drivers[i]->Detect();
     }
 
+    SDL_TRACE_END("SDL_UpdateJoysticks");
+
     SDL_UnlockJoysticks();
 }
 
@@ -3369,7 +3648,11 @@ int SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick, SDL_SensorT
                 num_values = SDL_min(num_values, SDL_arraysize(sensor->data));
 
                 /* Update internal sensor state */
+                SDL_BeginJoystickStateUpdate(joystick);
                 SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
+                joystick->state_timestamp = timestamp;
+                SDL_EndJoystickStateUpdate(joystick);
+                SDL_AddSensorBatchSample(&sensor->batch, timestamp, sensor_timestamp, data, num_values);
                 joystick->update_complete = timestamp;
 
                 /* Post the event, if desired */
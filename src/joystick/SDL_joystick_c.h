@@ -53,6 +53,15 @@ extern void SDL_AssertJoysticksLocked(void) SDL_ASSERT_CAPABILITY(SDL_joystick_l
 /* Function to return whether there are any joysticks opened by the application */
 extern SDL_bool SDL_JoysticksOpened(void);
 
+/* Function to return whether opened joysticks need to be updated without waiting for an event wakeup */
+extern SDL_bool SDL_JoysticksNeedPolling(void);
+
+/* Drivers call this when an event wakeup fd tells them about device changes */
+extern void SDL_SetJoystickDetectWakeup(struct SDL_JoystickDriver *driver, SDL_bool enabled);
+
+/* Function to return whether any joystick driver needs periodic updates to detect devices */
+extern SDL_bool SDL_JoysticksNeedPeriodicPoll(void);
+
 /* Function to standardize the name for a controller
    This should be freed with SDL_free() when no longer needed
  */
@@ -160,6 +169,11 @@ extern int SDL_SendJoystickHat(Uint64 timestamp, SDL_Joystick *joystick,
                                   Uint8 hat, Uint8 value);
 extern int SDL_SendJoystickButton(Uint64 timestamp, SDL_Joystick *joystick,
                                      Uint8 button, Uint8 state);
+/* Bulk versions for drivers that parse whole reports, only the elements that differ from the current state are sent */
+extern int SDL_SendJoystickButtons(Uint64 timestamp, SDL_Joystick *joystick,
+                                      Uint8 first_button, const Uint8 *states, int num_states);
+extern int SDL_SendJoystickAxes(Uint64 timestamp, SDL_Joystick *joystick,
+                                   Uint8 first_axis, const Sint16 *values, int num_values);
 extern int SDL_SendJoystickTouchpad(Uint64 timestamp, SDL_Joystick *joystick,
                                        int touchpad, int finger, Uint8 state, float x, float y, float pressure);
 extern int SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick,
@@ -25,6 +25,7 @@
 
 /* This is the system specific header for the SDL joystick API */
 #include "SDL_joystick_c.h"
+#include "../sensor/SDL_sensor_c.h"
 
 /* Set up for C function definitions, even when using C++ */
 #ifdef __cplusplus
@@ -63,6 +64,7 @@ typedef struct SDL_JoystickSensorInfo
     SDL_bool enabled;
     float rate;
     float data[3]; /* If this needs to expand, update SDL_GamepadSensorEvent */
+    SDL_SensorBatch batch; /* Readings since the last SDL_GetGamepadSensorDataBatch() */
 } SDL_JoystickSensorInfo;
 
 #define _guarded SDL_GUARDED_BY(SDL_joystick_lock)
@@ -111,6 +113,7 @@ struct SDL_Joystick
     SDL_bool attached _guarded;
     SDL_bool is_gamepad _guarded;
     SDL_bool delayed_guide_button _guarded;      /* SDL_TRUE if this device has the guide button event delayed */
+    SDL_bool input_wakeup _guarded;              /* SDL_TRUE if the driver registered an event wakeup fd for this device's input */
     SDL_JoystickPowerLevel epowerlevel _guarded; /* power level of this joystick, SDL_JOYSTICK_POWER_UNKNOWN if not supported */
 
     SDL_SensorID accel_sensor _guarded;
@@ -121,6 +124,12 @@ struct SDL_Joystick
 
     Uint64 update_complete _guarded;
 
+    /* The input state is published with a sequence lock, so SDL_GetJoystickSnapshot() can read it without SDL_joystick_lock.
+       The sequence is odd while the state is being changed. */
+    SDL_AtomicInt state_sequence;
+    int state_update_depth _guarded;
+    Uint64 state_timestamp _guarded;
+
     struct SDL_JoystickDriver *driver _guarded;
 
     struct joystick_hwdata *hwdata _guarded; /* Driver dependent information */
@@ -77,6 +77,7 @@ static SDL_bool HIDAPI_DriverLuna_InitDevice(SDL_HIDAPI_Device *device)
         return SDL_FALSE;
     }
     device->context = ctx;
+    device->update_on_input = SDL_TRUE;
 
     HIDAPI_SetDeviceName(device, "Amazon Luna Controller");
 
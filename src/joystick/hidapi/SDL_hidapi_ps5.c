@@ -1025,6 +1025,49 @@ static int HIDAPI_DriverPS5_SetJoystickLED(SDL_HIDAPI_Device *device, SDL_Joysti
     return HIDAPI_DriverPS5_UpdateEffects(ctx, k_EDS5EffectLED, SDL_TRUE);
 }
 
+static void HIDAPI_DriverPS5_SetEffectsCRC(SDL_DriverPS5_Context *ctx, Uint8 *data, int report_size)
+{
+    if (ctx->device->is_bluetooth) {
+        /* Bluetooth reports need a CRC at the end of the packet (at least on Linux) */
+        Uint8 ubHdr = 0xA2; /* hidp header is part of the CRC calculation */
+        Uint32 unCRC;
+        unCRC = SDL_crc32(0, &ubHdr, 1);
+        unCRC = SDL_crc32(unCRC, data, (size_t)(report_size - sizeof(unCRC)));
+        SDL_memcpy(&data[report_size - sizeof(unCRC)], &unCRC, sizeof(unCRC));
+    }
+}
+
+/* Light updates in ucEnableBits2 that can be carried over into a newer effects report: mic light, LED color and pad lights */
+#define PS5_MERGEABLE_ENABLE_BITS2 (0x01 | 0x04 | 0x10)
+
+/* Fold the light updates of an older pending report into a newer one, so they go out in a single write */
+static SDL_bool HIDAPI_DriverPS5_MergePendingEffects(DS5EffectsState_t *effects, const DS5EffectsState_t *pending_effects)
+{
+    Uint8 carried_bits;
+
+    /* Rumble transitions and LED resets need their own report */
+    if (effects->ucEnableBits1 != pending_effects->ucEnableBits1 ||
+        effects->ucEnableBits3 != pending_effects->ucEnableBits3 ||
+        ((effects->ucEnableBits2 | pending_effects->ucEnableBits2) & ~PS5_MERGEABLE_ENABLE_BITS2) != 0) {
+        return SDL_FALSE;
+    }
+
+    carried_bits = (pending_effects->ucEnableBits2 & ~effects->ucEnableBits2);
+    if (carried_bits & 0x01) {
+        effects->ucMicLightMode = pending_effects->ucMicLightMode;
+    }
+    if (carried_bits & 0x04) {
+        effects->ucLedRed = pending_effects->ucLedRed;
+        effects->ucLedGreen = pending_effects->ucLedGreen;
+        effects->ucLedBlue = pending_effects->ucLedBlue;
+    }
+    if (carried_bits & 0x10) {
+        effects->ucPadLights = pending_effects->ucPadLights;
+    }
+    effects->ucEnableBits2 |= carried_bits;
+    return SDL_TRUE;
+}
+
 static int HIDAPI_DriverPS5_InternalSendJoystickEffect(SDL_DriverPS5_Context *ctx, const void *effect, int size, SDL_bool application_usage)
 {
     Uint8 data[78];
@@ -1066,33 +1109,27 @@ static int HIDAPI_DriverPS5_InternalSendJoystickEffect(SDL_DriverPS5_Context *ct
 
     SDL_memcpy(&data[offset], effect, SDL_min((sizeof(data) - offset), (size_t)size));
 
-    if (ctx->device->is_bluetooth) {
-        /* Bluetooth reports need a CRC at the end of the packet (at least on Linux) */
-        Uint8 ubHdr = 0xA2; /* hidp header is part of the CRC calculation */
-        Uint32 unCRC;
-        unCRC = SDL_crc32(0, &ubHdr, 1);
-        unCRC = SDL_crc32(unCRC, data, (size_t)(report_size - sizeof(unCRC)));
-        SDL_memcpy(&data[report_size - sizeof(unCRC)], &unCRC, sizeof(unCRC));
-    }
-
     if (SDL_HIDAPI_LockRumble() != 0) {
         return -1;
     }
 
     /* See if we can update an existing pending request */
-    if (SDL_HIDAPI_GetPendingRumbleLocked(ctx->device, &pending_data, &pending_size, &maximum_size)) {
+    if (SDL_HIDAPI_GetPendingRumbleLocked(ctx->device, &pending_data, &pending_size, &maximum_size) &&
+        report_size == *pending_size) {
         DS5EffectsState_t *effects = (DS5EffectsState_t *)&data[offset];
         DS5EffectsState_t *pending_effects = (DS5EffectsState_t *)&pending_data[offset];
-        if (report_size == *pending_size &&
-            effects->ucEnableBits1 == pending_effects->ucEnableBits1 &&
-            effects->ucEnableBits2 == pending_effects->ucEnableBits2) {
+        if ((effects->ucEnableBits1 == pending_effects->ucEnableBits1 &&
+             effects->ucEnableBits2 == pending_effects->ucEnableBits2) ||
+            HIDAPI_DriverPS5_MergePendingEffects(effects, pending_effects)) {
             /* We're simply updating the data for this request */
+            HIDAPI_DriverPS5_SetEffectsCRC(ctx, data, report_size);
             SDL_memcpy(pending_data, data, report_size);
             SDL_HIDAPI_UnlockRumble();
             return 0;
         }
     }
 
+    HIDAPI_DriverPS5_SetEffectsCRC(ctx, data, report_size);
     if (SDL_HIDAPI_SendRumbleAndUnlock(ctx->device, data, report_size) != report_size) {
         return -1;
     }
@@ -1125,209 +1162,67 @@ static int HIDAPI_DriverPS5_SetJoystickSensorsEnabled(SDL_HIDAPI_Device *device,
     return 0;
 }
 
-static void HIDAPI_DriverPS5_HandleSimpleStatePacket(SDL_Joystick *joystick, SDL_hid_device *dev, SDL_DriverPS5_Context *ctx, PS5SimpleStatePacket_t *packet, Uint64 timestamp)
+static void HIDAPI_DriverPS5_SendButtons(Uint64 timestamp, SDL_Joystick *joystick, Uint8 buttons0, Uint8 buttons1, Uint8 buttons2)
 {
-    Sint16 axis;
-
-    if (ctx->last_state.simple.rgucButtonsHatAndCounter[0] != packet->rgucButtonsHatAndCounter[0]) {
-        {
-            Uint8 data = (packet->rgucButtonsHatAndCounter[0] >> 4);
+    Uint8 buttons[SDL_CONTROLLER_BUTTON_PS5_RIGHT_PADDLE + 1];
+
+    buttons[SDL_GAMEPAD_BUTTON_SOUTH] = (buttons0 >> 5) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_EAST] = (buttons0 >> 6) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_WEST] = (buttons0 >> 4) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_NORTH] = (buttons0 >> 7) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_BACK] = (buttons1 >> 4) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_GUIDE] = buttons2 & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_START] = (buttons1 >> 5) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_LEFT_STICK] = (buttons1 >> 6) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_RIGHT_STICK] = (buttons1 >> 7) & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_LEFT_SHOULDER] = buttons1 & 0x01;
+    buttons[SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER] = (buttons1 >> 1) & 0x01;
+    SDL_memcpy(&buttons[SDL_GAMEPAD_BUTTON_DPAD_UP], HIDAPI_GetDpadStatesFromHat(buttons0 & 0x0F), 4);
+    buttons[SDL_GAMEPAD_BUTTON_MISC1] = (buttons2 >> 1) & 0x01;
+    buttons[SDL_CONTROLLER_BUTTON_PS5_TOUCHPAD] = (buttons2 >> 2) & 0x01;
+    buttons[SDL_CONTROLLER_BUTTON_PS5_LEFT_FUNCTION] = (buttons2 >> 4) & 0x01;
+    buttons[SDL_CONTROLLER_BUTTON_PS5_RIGHT_FUNCTION] = (buttons2 >> 5) & 0x01;
+    buttons[SDL_CONTROLLER_BUTTON_PS5_LEFT_PADDLE] = (buttons2 >> 6) & 0x01;
+    buttons[SDL_CONTROLLER_BUTTON_PS5_RIGHT_PADDLE] = (buttons2 >> 7) & 0x01;
+
+    SDL_SendJoystickButtons(timestamp, joystick, 0, buttons, SDL_arraysize(buttons));
+}
 
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_WEST, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_SOUTH, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_EAST, (data & 0x04) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_NORTH, (data & 0x08) ? SDL_PRESSED : SDL_RELEASED);
-        }
-        {
-            Uint8 data = (packet->rgucButtonsHatAndCounter[0] & 0x0F);
-            SDL_bool dpad_up = SDL_FALSE;
-            SDL_bool dpad_down = SDL_FALSE;
-            SDL_bool dpad_left = SDL_FALSE;
-            SDL_bool dpad_right = SDL_FALSE;
-
-            switch (data) {
-            case 0:
-                dpad_up = SDL_TRUE;
-                break;
-            case 1:
-                dpad_up = SDL_TRUE;
-                dpad_right = SDL_TRUE;
-                break;
-            case 2:
-                dpad_right = SDL_TRUE;
-                break;
-            case 3:
-                dpad_right = SDL_TRUE;
-                dpad_down = SDL_TRUE;
-                break;
-            case 4:
-                dpad_down = SDL_TRUE;
-                break;
-            case 5:
-                dpad_left = SDL_TRUE;
-                dpad_down = SDL_TRUE;
-                break;
-            case 6:
-                dpad_left = SDL_TRUE;
-                break;
-            case 7:
-                dpad_up = SDL_TRUE;
-                dpad_left = SDL_TRUE;
-                break;
-            default:
-                break;
-            }
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_DOWN, dpad_down);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_UP, dpad_up);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_RIGHT, dpad_right);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_LEFT, dpad_left);
-        }
+static void HIDAPI_DriverPS5_SendAxes(Uint64 timestamp, SDL_Joystick *joystick, Uint8 left_x, Uint8 left_y, Uint8 right_x, Uint8 right_y, Uint8 trigger_left, Uint8 trigger_right, Uint8 buttons1)
+{
+    Sint16 axes[SDL_GAMEPAD_AXIS_MAX];
+
+    axes[SDL_GAMEPAD_AXIS_LEFTX] = ((int)left_x * 257) - 32768;
+    axes[SDL_GAMEPAD_AXIS_LEFTY] = ((int)left_y * 257) - 32768;
+    axes[SDL_GAMEPAD_AXIS_RIGHTX] = ((int)right_x * 257) - 32768;
+    axes[SDL_GAMEPAD_AXIS_RIGHTY] = ((int)right_y * 257) - 32768;
+    if (trigger_left == 0 && (buttons1 & 0x04)) {
+        axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] = SDL_JOYSTICK_AXIS_MAX;
+    } else {
+        axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] = ((int)trigger_left * 257) - 32768;
     }
-
-    if (ctx->last_state.simple.rgucButtonsHatAndCounter[1] != packet->rgucButtonsHatAndCounter[1]) {
-        Uint8 data = packet->rgucButtonsHatAndCounter[1];
-
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_BACK, (data & 0x10) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_START, (data & 0x20) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_STICK, (data & 0x40) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_STICK, (data & 0x80) ? SDL_PRESSED : SDL_RELEASED);
+    if (trigger_right == 0 && (buttons1 & 0x08)) {
+        axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] = SDL_JOYSTICK_AXIS_MAX;
+    } else {
+        axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] = ((int)trigger_right * 257) - 32768;
     }
 
-    if (ctx->last_state.simple.rgucButtonsHatAndCounter[2] != packet->rgucButtonsHatAndCounter[2]) {
-        Uint8 data = (packet->rgucButtonsHatAndCounter[2] & 0x03);
-
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_GUIDE, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_MISC1, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-    }
+    SDL_SendJoystickAxes(timestamp, joystick, 0, axes, SDL_arraysize(axes));
+}
 
-    if (packet->ucTriggerLeft == 0 && (packet->rgucButtonsHatAndCounter[1] & 0x04)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerLeft * 257) - 32768;
-    }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
-    if (packet->ucTriggerRight == 0 && (packet->rgucButtonsHatAndCounter[1] & 0x08)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerRight * 257) - 32768;
-    }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
-    axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-    axis = ((int)packet->ucRightJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = ((int)packet->ucRightJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
+static void HIDAPI_DriverPS5_HandleSimpleStatePacket(SDL_Joystick *joystick, SDL_hid_device *dev, SDL_DriverPS5_Context *ctx, PS5SimpleStatePacket_t *packet, Uint64 timestamp)
+{
+    /* The upper bits of the third byte are a counter */
+    HIDAPI_DriverPS5_SendButtons(timestamp, joystick, packet->rgucButtonsHatAndCounter[0], packet->rgucButtonsHatAndCounter[1], packet->rgucButtonsHatAndCounter[2] & 0x03);
+    HIDAPI_DriverPS5_SendAxes(timestamp, joystick, packet->ucLeftJoystickX, packet->ucLeftJoystickY, packet->ucRightJoystickX, packet->ucRightJoystickY, packet->ucTriggerLeft, packet->ucTriggerRight, packet->rgucButtonsHatAndCounter[1]);
 
     SDL_memcpy(&ctx->last_state.simple, packet, sizeof(ctx->last_state.simple));
 }
 
 static void HIDAPI_DriverPS5_HandleStatePacketCommon(SDL_Joystick *joystick, SDL_hid_device *dev, SDL_DriverPS5_Context *ctx, PS5StatePacketCommon_t *packet, Uint64 timestamp)
 {
-    Sint16 axis;
-
-    if (ctx->last_state.state.rgucButtonsAndHat[0] != packet->rgucButtonsAndHat[0]) {
-        {
-            Uint8 data = (packet->rgucButtonsAndHat[0] >> 4);
-
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_WEST, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_SOUTH, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_EAST, (data & 0x04) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_NORTH, (data & 0x08) ? SDL_PRESSED : SDL_RELEASED);
-        }
-        {
-            Uint8 data = (packet->rgucButtonsAndHat[0] & 0x0F);
-            SDL_bool dpad_up = SDL_FALSE;
-            SDL_bool dpad_down = SDL_FALSE;
-            SDL_bool dpad_left = SDL_FALSE;
-            SDL_bool dpad_right = SDL_FALSE;
-
-            switch (data) {
-            case 0:
-                dpad_up = SDL_TRUE;
-                break;
-            case 1:
-                dpad_up = SDL_TRUE;
-                dpad_right = SDL_TRUE;
-                break;
-            case 2:
-                dpad_right = SDL_TRUE;
-                break;
-            case 3:
-                dpad_right = SDL_TRUE;
-                dpad_down = SDL_TRUE;
-                break;
-            case 4:
-                dpad_down = SDL_TRUE;
-                break;
-            case 5:
-                dpad_left = SDL_TRUE;
-                dpad_down = SDL_TRUE;
-                break;
-            case 6:
-                dpad_left = SDL_TRUE;
-                break;
-            case 7:
-                dpad_up = SDL_TRUE;
-                dpad_left = SDL_TRUE;
-                break;
-            default:
-                break;
-            }
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_DOWN, dpad_down);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_UP, dpad_up);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_RIGHT, dpad_right);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_LEFT, dpad_left);
-        }
-    }
-
-    if (ctx->last_state.state.rgucButtonsAndHat[1] != packet->rgucButtonsAndHat[1]) {
-        Uint8 data = packet->rgucButtonsAndHat[1];
-
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_BACK, (data & 0x10) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_START, (data & 0x20) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_STICK, (data & 0x40) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_STICK, (data & 0x80) ? SDL_PRESSED : SDL_RELEASED);
-    }
-
-    if (ctx->last_state.state.rgucButtonsAndHat[2] != packet->rgucButtonsAndHat[2]) {
-        Uint8 data = packet->rgucButtonsAndHat[2];
-
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_GUIDE, (data & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_MISC1, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_CONTROLLER_BUTTON_PS5_TOUCHPAD, (data & 0x04) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_CONTROLLER_BUTTON_PS5_LEFT_FUNCTION, (data & 0x10) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_CONTROLLER_BUTTON_PS5_RIGHT_FUNCTION, (data & 0x20) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_CONTROLLER_BUTTON_PS5_LEFT_PADDLE, (data & 0x40) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_CONTROLLER_BUTTON_PS5_RIGHT_PADDLE, (data & 0x80) ? SDL_PRESSED : SDL_RELEASED);
-    }
-
-    if (packet->ucTriggerLeft == 0 && (packet->rgucButtonsAndHat[1] & 0x04)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerLeft * 257) - 32768;
-    }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
-    if (packet->ucTriggerRight == 0 && (packet->rgucButtonsAndHat[1] & 0x08)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerRight * 257) - 32768;
-    }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
-    axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-    axis = ((int)packet->ucRightJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = ((int)packet->ucRightJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
+    HIDAPI_DriverPS5_SendButtons(timestamp, joystick, packet->rgucButtonsAndHat[0], packet->rgucButtonsAndHat[1], packet->rgucButtonsAndHat[2]);
+    HIDAPI_DriverPS5_SendAxes(timestamp, joystick, packet->ucLeftJoystickX, packet->ucLeftJoystickY, packet->ucRightJoystickX, packet->ucRightJoystickY, packet->ucTriggerLeft, packet->ucTriggerRight, packet->rgucButtonsAndHat[1]);
 
     if (ctx->report_sensors) {
         Uint64 sensor_timestamp;
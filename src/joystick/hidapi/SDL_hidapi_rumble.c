@@ -63,6 +63,7 @@ static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
 
     while (SDL_AtomicGet(&ctx->running)) {
         SDL_HIDAPI_RumbleRequest *request = NULL;
+        SDL_bool next_for_other_device = SDL_FALSE;
 
         SDL_WaitSemaphore(ctx->request_sem);
 
@@ -73,6 +74,9 @@ static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
                 ctx->requests_head = NULL;
             }
             ctx->requests_tail = request->prev;
+            if (ctx->requests_tail && ctx->requests_tail->device != request->device) {
+                next_for_other_device = SDL_TRUE;
+            }
         }
         SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 
@@ -91,8 +95,12 @@ static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
             (void)SDL_AtomicDecRef(&request->device->rumble_pending);
             SDL_free(request);
 
-            /* Make sure we're not starving report reads when there's lots of rumble */
-            SDL_Delay(10);
+            /* Make sure we're not starving report reads when there's lots of rumble.
+               This also gives new updates for this device time to coalesce into a single request,
+               but there's no reason to hold up a request that's already waiting for another device. */
+            if (!next_for_other_device) {
+                SDL_Delay(10);
+            }
         }
     }
     return 0;
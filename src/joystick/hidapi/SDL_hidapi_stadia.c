@@ -74,6 +74,7 @@ static SDL_bool HIDAPI_DriverStadia_InitDevice(SDL_HIDAPI_Device *device)
         return SDL_FALSE;
     }
     device->context = ctx;
+    device->update_on_input = SDL_TRUE;
 
     /* Check whether rumble is supported */
     {
@@ -1706,6 +1706,7 @@ static void HandleInputOnlyControllerState(SDL_Joystick *joystick, SDL_DriverSwi
 static void HandleSimpleControllerState(SDL_Joystick *joystick, SDL_DriverSwitch_Context *ctx, SwitchSimpleStatePacket_t *packet)
 {
     Sint16 axis;
+    Sint16 axes[4];
     Uint64 timestamp = SDL_GetTicksNS();
 
     if (packet->rgucButtons[0] != ctx->m_lastSimpleState.rgucButtons[0]) {
@@ -1735,60 +1736,14 @@ static void HandleSimpleControllerState(SDL_Joystick *joystick, SDL_DriverSwitch
     }
 
     if (packet->ucStickHat != ctx->m_lastSimpleState.ucStickHat) {
-        SDL_bool dpad_up = SDL_FALSE;
-        SDL_bool dpad_down = SDL_FALSE;
-        SDL_bool dpad_left = SDL_FALSE;
-        SDL_bool dpad_right = SDL_FALSE;
-
-        switch (packet->ucStickHat) {
-        case 0:
-            dpad_up = SDL_TRUE;
-            break;
-        case 1:
-            dpad_up = SDL_TRUE;
-            dpad_right = SDL_TRUE;
-            break;
-        case 2:
-            dpad_right = SDL_TRUE;
-            break;
-        case 3:
-            dpad_right = SDL_TRUE;
-            dpad_down = SDL_TRUE;
-            break;
-        case 4:
-            dpad_down = SDL_TRUE;
-            break;
-        case 5:
-            dpad_left = SDL_TRUE;
-            dpad_down = SDL_TRUE;
-            break;
-        case 6:
-            dpad_left = SDL_TRUE;
-            break;
-        case 7:
-            dpad_up = SDL_TRUE;
-            dpad_left = SDL_TRUE;
-            break;
-        default:
-            break;
-        }
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_DOWN, dpad_down);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_UP, dpad_up);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_RIGHT, dpad_right);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_LEFT, dpad_left);
+        SDL_SendJoystickButtons(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_UP, HIDAPI_GetDpadStatesFromHat(packet->ucStickHat), 4);
     }
 
-    axis = ApplySimpleStickCalibration(ctx, 0, 0, packet->sJoystickLeft[0]);
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-
-    axis = ApplySimpleStickCalibration(ctx, 0, 1, packet->sJoystickLeft[1]);
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-
-    axis = ApplySimpleStickCalibration(ctx, 1, 0, packet->sJoystickRight[0]);
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-
-    axis = ApplySimpleStickCalibration(ctx, 1, 1, packet->sJoystickRight[1]);
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
+    axes[0] = ApplySimpleStickCalibration(ctx, 0, 0, packet->sJoystickLeft[0]);
+    axes[1] = ApplySimpleStickCalibration(ctx, 0, 1, packet->sJoystickLeft[1]);
+    axes[2] = ApplySimpleStickCalibration(ctx, 1, 0, packet->sJoystickRight[0]);
+    axes[3] = ApplySimpleStickCalibration(ctx, 1, 1, packet->sJoystickRight[1]);
+    SDL_SendJoystickAxes(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axes, SDL_arraysize(axes));
 
     ctx->m_lastSimpleState = *packet;
 }
@@ -1984,6 +1939,7 @@ static void HandleFullControllerState(SDL_Joystick *joystick, SDL_DriverSwitch_C
         }
     } else {
         Sint16 axis;
+        Sint16 axes[4];
 
         if (packet->controllerState.rgucButtons[0] != ctx->m_lastFullState.controllerState.rgucButtons[0]) {
             Uint8 data = packet->controllerState.rgucButtons[0];
@@ -2019,20 +1975,19 @@ static void HandleFullControllerState(SDL_Joystick *joystick, SDL_DriverSwitch_C
         }
 
         axis = packet->controllerState.rgucJoystickLeft[0] | ((packet->controllerState.rgucJoystickLeft[1] & 0xF) << 8);
-        axis = ApplyStickCalibration(ctx, 0, 0, axis);
-        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
+        axes[0] = ApplyStickCalibration(ctx, 0, 0, axis);
 
         axis = ((packet->controllerState.rgucJoystickLeft[1] & 0xF0) >> 4) | (packet->controllerState.rgucJoystickLeft[2] << 4);
-        axis = ApplyStickCalibration(ctx, 0, 1, axis);
-        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, ~axis);
+        axes[1] = ~ApplyStickCalibration(ctx, 0, 1, axis);
 
         axis = packet->controllerState.rgucJoystickRight[0] | ((packet->controllerState.rgucJoystickRight[1] & 0xF) << 8);
-        axis = ApplyStickCalibration(ctx, 1, 0, axis);
-        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
+        axes[2] = ApplyStickCalibration(ctx, 1, 0, axis);
 
         axis = ((packet->controllerState.rgucJoystickRight[1] & 0xF0) >> 4) | (packet->controllerState.rgucJoystickRight[2] << 4);
-        axis = ApplyStickCalibration(ctx, 1, 1, axis);
-        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, ~axis);
+        axes[3] = ~ApplyStickCalibration(ctx, 1, 1, axis);
+
+        /* The sticks are in SDL_GAMEPAD_AXIS_LEFTX, LEFTY, RIGHTX, RIGHTY order */
+        SDL_SendJoystickAxes(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axes, SDL_arraysize(axes));
     }
 
     if (ctx->device->is_bluetooth) {
@@ -146,6 +146,7 @@ static SDL_bool HIDAPI_DriverXbox360_InitDevice(SDL_HIDAPI_Device *device)
     ctx->device = device;
 
     device->context = ctx;
+    device->update_on_input = SDL_TRUE;
 
     device->type = SDL_GAMEPAD_TYPE_XBOX360;
 
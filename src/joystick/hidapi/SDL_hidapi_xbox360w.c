@@ -138,6 +138,7 @@ static SDL_bool HIDAPI_DriverXbox360W_InitDevice(SDL_HIDAPI_Device *device)
     ctx->device = device;
 
     device->context = ctx;
+    device->update_on_input = SDL_TRUE;
 
     if (SDL_hid_write(device->dev, init_packet, sizeof(init_packet)) != sizeof(init_packet)) {
         SDL_SetError("Couldn't write init packet");
@@ -644,6 +644,7 @@ static void HIDAPI_DriverXboxOne_HandleUnmappedStatePacket(SDL_Joystick *joystic
 static void HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, SDL_DriverXboxOne_Context *ctx, Uint8 *data, int size)
 {
     Sint16 axis;
+    Sint16 axes[SDL_GAMEPAD_AXIS_MAX];
     Uint64 timestamp = SDL_GetTicksNS();
 
     /* Enable paddles on the Xbox Elite controller when connected over USB */
@@ -656,30 +657,34 @@ static void HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, SDL_D
         SDL_HIDAPI_SendRumble(ctx->device, packet, sizeof(packet));
     }
 
-    if (ctx->last_state[0] != data[0]) {
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_START, (data[0] & 0x04) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_BACK, (data[0] & 0x08) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_SOUTH, (data[0] & 0x10) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_EAST, (data[0] & 0x20) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_WEST, (data[0] & 0x40) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_NORTH, (data[0] & 0x80) ? SDL_PRESSED : SDL_RELEASED);
-    }
+    {
+        /* The guide button comes in a separate packet, so it's left out of these */
+        Uint8 buttons[SDL_GAMEPAD_BUTTON_DPAD_RIGHT + 1];
 
-    if (ctx->last_state[1] != data[1]) {
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_UP, (data[1] & 0x01) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_DOWN, (data[1] & 0x02) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_LEFT, (data[1] & 0x04) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_DPAD_RIGHT, (data[1] & 0x08) ? SDL_PRESSED : SDL_RELEASED);
+        buttons[SDL_GAMEPAD_BUTTON_SOUTH] = (data[0] >> 4) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_EAST] = (data[0] >> 5) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_WEST] = (data[0] >> 6) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_NORTH] = (data[0] >> 7) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_BACK] = (data[0] >> 3) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_GUIDE] = SDL_RELEASED;
+        buttons[SDL_GAMEPAD_BUTTON_START] = (data[0] >> 2) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_LEFT_STICK] = (data[1] >> 6) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_RIGHT_STICK] = (data[1] >> 7) & 0x01;
         if (ctx->vendor_id == USB_VENDOR_RAZER && ctx->product_id == USB_PRODUCT_RAZER_ATROX) {
             /* The Razer Atrox has the right and left shoulder bits reversed */
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, (data[1] & 0x20) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER, (data[1] & 0x10) ? SDL_PRESSED : SDL_RELEASED);
+            buttons[SDL_GAMEPAD_BUTTON_LEFT_SHOULDER] = (data[1] >> 5) & 0x01;
+            buttons[SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER] = (data[1] >> 4) & 0x01;
         } else {
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, (data[1] & 0x10) ? SDL_PRESSED : SDL_RELEASED);
-            SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER, (data[1] & 0x20) ? SDL_PRESSED : SDL_RELEASED);
+            buttons[SDL_GAMEPAD_BUTTON_LEFT_SHOULDER] = (data[1] >> 4) & 0x01;
+            buttons[SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER] = (data[1] >> 5) & 0x01;
         }
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_LEFT_STICK, (data[1] & 0x40) ? SDL_PRESSED : SDL_RELEASED);
-        SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_RIGHT_STICK, (data[1] & 0x80) ? SDL_PRESSED : SDL_RELEASED);
+        buttons[SDL_GAMEPAD_BUTTON_DPAD_UP] = data[1] & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_DPAD_DOWN] = (data[1] >> 1) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_DPAD_LEFT] = (data[1] >> 2) & 0x01;
+        buttons[SDL_GAMEPAD_BUTTON_DPAD_RIGHT] = (data[1] >> 3) & 0x01;
+
+        SDL_SendJoystickButtons(timestamp, joystick, SDL_GAMEPAD_BUTTON_SOUTH, &buttons[SDL_GAMEPAD_BUTTON_SOUTH], SDL_GAMEPAD_BUTTON_GUIDE - SDL_GAMEPAD_BUTTON_SOUTH);
+        SDL_SendJoystickButtons(timestamp, joystick, SDL_GAMEPAD_BUTTON_START, &buttons[SDL_GAMEPAD_BUTTON_START], SDL_arraysize(buttons) - SDL_GAMEPAD_BUTTON_START);
     }
 
     if (ctx->has_share_button) {
@@ -802,7 +807,7 @@ static void HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, SDL_D
     if (axis == -32768 && size == 26 && (data[18] & 0x80)) {
         axis = 32767;
     }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
+    axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] = axis;
 
     axis = ((int)SDL_SwapLE16(*(Sint16 *)(&data[4])) * 64) - 32768;
     if (axis == -32768 && size == 26 && (data[18] & 0x40)) {
@@ -811,16 +816,13 @@ static void HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, SDL_D
     if (axis == 32704) {
         axis = 32767;
     }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
+    axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] = axis;
 
-    axis = SDL_SwapLE16(*(Sint16 *)(&data[6]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = SDL_SwapLE16(*(Sint16 *)(&data[8]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, ~axis);
-    axis = SDL_SwapLE16(*(Sint16 *)(&data[10]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = SDL_SwapLE16(*(Sint16 *)(&data[12]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, ~axis);
+    axes[SDL_GAMEPAD_AXIS_LEFTX] = SDL_SwapLE16(*(Sint16 *)(&data[6]));
+    axes[SDL_GAMEPAD_AXIS_LEFTY] = ~SDL_SwapLE16(*(Sint16 *)(&data[8]));
+    axes[SDL_GAMEPAD_AXIS_RIGHTX] = SDL_SwapLE16(*(Sint16 *)(&data[10]));
+    axes[SDL_GAMEPAD_AXIS_RIGHTY] = ~SDL_SwapLE16(*(Sint16 *)(&data[12]));
+    SDL_SendJoystickAxes(timestamp, joystick, 0, axes, SDL_arraysize(axes));
 
     SDL_memcpy(ctx->last_state, data, SDL_min(size, sizeof(ctx->last_state)));
 
@@ -26,6 +26,9 @@
 #include "SDL_hidapijoystick_c.h"
 #include "SDL_hidapi_rumble.h"
 #include "../../SDL_hints_c.h"
+#include "../../events/SDL_events_c.h"
+#include "../../hidapi/SDL_hidapi_c.h"
+#include "../../thread/SDL_systhread.h"
 
 #if defined(__WIN32__) || defined(__WINGDK__)
 #include "../windows/SDL_rawinputjoystick_c.h"
@@ -35,6 +38,10 @@
 #include "../../core/linux/SDL_sandbox.h"
 #endif
 
+#ifdef HAVE_POLL
+#include <poll.h>
+#endif
+
 struct joystick_hwdata
 {
     SDL_HIDAPI_Device *device;
@@ -86,6 +93,7 @@ static int SDL_HIDAPI_numdrivers = 0;
 static SDL_SpinLock SDL_HIDAPI_spinlock;
 static SDL_bool SDL_HIDAPI_hints_changed = SDL_FALSE;
 static Uint32 SDL_HIDAPI_change_count = 0;
+static int SDL_HIDAPI_wakeup_fd = -1;
 static SDL_HIDAPI_Device *SDL_HIDAPI_devices SDL_GUARDED_BY(SDL_joystick_lock);
 static char SDL_HIDAPI_device_magic;
 static int SDL_HIDAPI_numjoysticks = 0;
@@ -93,6 +101,26 @@ static SDL_bool SDL_HIDAPI_combine_joycons = SDL_TRUE;
 static SDL_bool initialized = SDL_FALSE;
 static SDL_bool shutting_down = SDL_FALSE;
 
+/* Enumerating HID devices can take tens of milliseconds with many devices connected,
+   so after startup it's done on a separate thread where the backend allows it */
+#if (defined(__WIN32__) || defined(__WINGDK__) || defined(__LINUX__)) && !defined(SDL_THREADS_DISABLED)
+#define SDL_HIDAPI_ENUMERATE_ON_THREAD
+#endif
+
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+static struct
+{
+    SDL_Thread *thread;
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_bool quit;
+    SDL_bool requested;
+    SDL_bool complete;
+    struct SDL_hid_device_info *devs; /* The results, once complete */
+} SDL_HIDAPI_enumeration;
+#endif
+static SDL_Mutex *SDL_HIDAPI_enumerate_lock; /* Held while calling SDL_hid_enumerate() */
+
 static char *HIDAPI_ConvertString(const wchar_t *wide_string)
 {
     char *string = NULL;
@@ -197,7 +225,32 @@ float HIDAPI_RemapVal(float val, float val_min, float val_max, float output_min,
     return output_min + (output_max - output_min) * (val - val_min) / (val_max - val_min);
 }
 
+const Uint8 *HIDAPI_GetDpadStatesFromHat(Uint8 hat)
+{
+    /* D-pad button states in SDL_GAMEPAD_BUTTON_DPAD_UP, DOWN, LEFT, RIGHT order, the last entry is centered */
+    static const Uint8 dpad_states[9][4] = {
+        { SDL_PRESSED, SDL_RELEASED, SDL_RELEASED, SDL_RELEASED },
+        { SDL_PRESSED, SDL_RELEASED, SDL_RELEASED, SDL_PRESSED },
+        { SDL_RELEASED, SDL_RELEASED, SDL_RELEASED, SDL_PRESSED },
+        { SDL_RELEASED, SDL_PRESSED, SDL_RELEASED, SDL_PRESSED },
+        { SDL_RELEASED, SDL_PRESSED, SDL_RELEASED, SDL_RELEASED },
+        { SDL_RELEASED, SDL_PRESSED, SDL_PRESSED, SDL_RELEASED },
+        { SDL_RELEASED, SDL_RELEASED, SDL_PRESSED, SDL_RELEASED },
+        { SDL_PRESSED, SDL_RELEASED, SDL_PRESSED, SDL_RELEASED },
+        { SDL_RELEASED, SDL_RELEASED, SDL_RELEASED, SDL_RELEASED }
+    };
+
+    if (hat >= SDL_arraysize(dpad_states)) {
+        hat = SDL_arraysize(dpad_states) - 1;
+    }
+    return dpad_states[hat];
+}
+
 static void HIDAPI_UpdateDeviceList(void);
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+static void HIDAPI_StartEnumerationThread(void);
+static void HIDAPI_StopEnumerationThread(void);
+#endif
 static void HIDAPI_JoystickClose(SDL_Joystick *joystick);
 
 static SDL_GamepadType SDL_GetJoystickGameControllerProtocol(const char *name, Uint16 vendor, Uint16 product, int interface_number, int interface_class, int interface_subclass, int interface_protocol)
@@ -391,6 +444,13 @@ static void HIDAPI_CleanupDeviceDriver(SDL_HIDAPI_Device *device)
     device->driver->FreeDevice(device);
     device->driver = NULL;
 
+    if (device->input_fd >= 0) {
+        SDL_DelEventWakeupFD(device->input_fd);
+        device->input_fd = -1;
+    }
+    device->update_on_input = SDL_FALSE;
+    device->input_pending = SDL_FALSE;
+
     SDL_LockMutex(device->dev_lock);
     {
         if (device->dev) {
@@ -518,6 +578,14 @@ static void HIDAPI_SetupDeviceDriver(SDL_HIDAPI_Device *device, SDL_bool *remove
             SDL_hid_close(device->dev);
             device->dev = NULL;
         }
+
+        /* Let SDL_WaitEvent() and HIDAPI_UpdateDevices() wait for input from this device */
+        if (device->driver && device->dev && device->update_on_input) {
+            device->input_fd = SDL_HIDAPI_GetDeviceInputFD(device->dev);
+            if (device->input_fd >= 0 && SDL_AddEventWakeupFD(device->input_fd) < 0) {
+                device->input_fd = -1;
+            }
+        }
     }
 }
 
@@ -597,10 +665,27 @@ static int HIDAPI_JoystickInit(void)
     SDL_AddHintCallback(SDL_HINT_JOYSTICK_HIDAPI,
                         SDL_HIDAPIDriverHintChanged, NULL);
 
+    SDL_HIDAPI_enumerate_lock = SDL_CreateMutex();
+
+    /* The initial device list is needed right away, later changes are picked up in the background */
     SDL_HIDAPI_change_count = SDL_hid_device_change_count();
     HIDAPI_UpdateDeviceList();
     HIDAPI_UpdateDevices();
 
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+    HIDAPI_StartEnumerationThread();
+#endif
+
+    /* Let SDL_WaitEvent() sleep until a device is added or removed */
+    SDL_HIDAPI_wakeup_fd = SDL_HIDAPI_GetDeviceChangeFD();
+    if (SDL_HIDAPI_wakeup_fd >= 0) {
+        if (SDL_AddEventWakeupFD(SDL_HIDAPI_wakeup_fd) == 0) {
+            SDL_SetJoystickDetectWakeup(&SDL_HIDAPI_JoystickDriver, SDL_TRUE);
+        } else {
+            SDL_HIDAPI_wakeup_fd = -1;
+        }
+    }
+
     initialized = SDL_TRUE;
 
     return 0;
@@ -888,6 +973,7 @@ static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *inf
     device->usage = info->usage;
     device->is_bluetooth = (info->bus_type == SDL_HID_API_BUS_BLUETOOTH);
     device->dev_lock = SDL_CreateMutex();
+    device->input_fd = -1;
 
     /* Need the device name before getting the driver to know whether to ignore this device */
     {
@@ -1075,18 +1161,25 @@ static SDL_bool HIDAPI_CreateCombinedJoyCons(void)
     return SDL_FALSE;
 }
 
-static void HIDAPI_UpdateDeviceList(void)
+static struct SDL_hid_device_info *HIDAPI_EnumerateDevices(void)
+{
+    struct SDL_hid_device_info *devs;
+
+    SDL_LockMutex(SDL_HIDAPI_enumerate_lock);
+    devs = SDL_hid_enumerate(0, 0);
+    SDL_UnlockMutex(SDL_HIDAPI_enumerate_lock);
+
+    return devs;
+}
+
+/* Add and remove devices to match an enumeration, only devices that changed are opened or closed */
+static void HIDAPI_UpdateDeviceListFromEnumeration(struct SDL_hid_device_info *devs)
 {
     SDL_HIDAPI_Device *device;
-    struct SDL_hid_device_info *devs, *info;
+    struct SDL_hid_device_info *info;
 
     SDL_LockJoysticks();
 
-    if (SDL_HIDAPI_hints_changed) {
-        SDL_HIDAPI_UpdateDrivers();
-        SDL_HIDAPI_hints_changed = SDL_FALSE;
-    }
-
     /* Prepare the existing device list */
     for (device = SDL_HIDAPI_devices; device; device = device->next) {
         if (device->children) {
@@ -1095,24 +1188,20 @@ static void HIDAPI_UpdateDeviceList(void)
         device->seen = SDL_FALSE;
     }
 
-    /* Enumerate the devices */
+    /* Match up the enumerated devices */
     if (SDL_HIDAPI_numdrivers > 0) {
-        devs = SDL_hid_enumerate(0, 0);
-        if (devs) {
-            for (info = devs; info; info = info->next) {
-                device = HIDAPI_GetJoystickByInfo(info->path, info->vendor_id, info->product_id);
-                if (device) {
-                    device->seen = SDL_TRUE;
-
-                    /* Check to see if the serial number is available now */
-                    if(HIDAPI_SerialIsEmpty(device)) {
-                        HIDAPI_SetDeviceSerialW(device, info->serial_number);
-                    }
-                } else {
-                    HIDAPI_AddDevice(info, 0, NULL);
+        for (info = devs; info; info = info->next) {
+            device = HIDAPI_GetJoystickByInfo(info->path, info->vendor_id, info->product_id);
+            if (device) {
+                device->seen = SDL_TRUE;
+
+                /* Check to see if the serial number is available now */
+                if(HIDAPI_SerialIsEmpty(device)) {
+                    HIDAPI_SetDeviceSerialW(device, info->serial_number);
                 }
+            } else {
+                HIDAPI_AddDevice(info, 0, NULL);
             }
-            SDL_hid_free_enumeration(devs);
         }
     }
 
@@ -1155,6 +1244,158 @@ check_removed:
     SDL_UnlockJoysticks();
 }
 
+static void HIDAPI_UpdateDeviceList(void)
+{
+    struct SDL_hid_device_info *devs = NULL;
+
+    SDL_LockJoysticks();
+    {
+        if (SDL_HIDAPI_hints_changed) {
+            SDL_HIDAPI_UpdateDrivers();
+            SDL_HIDAPI_hints_changed = SDL_FALSE;
+        }
+
+        if (SDL_HIDAPI_numdrivers > 0) {
+            devs = HIDAPI_EnumerateDevices();
+        }
+        HIDAPI_UpdateDeviceListFromEnumeration(devs);
+    }
+    SDL_UnlockJoysticks();
+
+    if (devs) {
+        SDL_hid_free_enumeration(devs);
+    }
+}
+
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+static int SDLCALL HIDAPI_EnumerationThread(void *data)
+{
+    struct SDL_hid_device_info *devs;
+
+    SDL_LockMutex(SDL_HIDAPI_enumeration.lock);
+    for ( ;; ) {
+        while (!SDL_HIDAPI_enumeration.quit && !SDL_HIDAPI_enumeration.requested) {
+            SDL_WaitCondition(SDL_HIDAPI_enumeration.cond, SDL_HIDAPI_enumeration.lock);
+        }
+        if (SDL_HIDAPI_enumeration.quit) {
+            break;
+        }
+        SDL_HIDAPI_enumeration.requested = SDL_FALSE;
+        SDL_UnlockMutex(SDL_HIDAPI_enumeration.lock);
+
+        devs = HIDAPI_EnumerateDevices();
+
+        SDL_LockMutex(SDL_HIDAPI_enumeration.lock);
+        if (SDL_HIDAPI_enumeration.devs) {
+            /* The main thread hasn't picked up the previous results, these are newer */
+            SDL_hid_free_enumeration(SDL_HIDAPI_enumeration.devs);
+        }
+        SDL_HIDAPI_enumeration.devs = devs;
+        SDL_HIDAPI_enumeration.complete = SDL_TRUE;
+    }
+    SDL_UnlockMutex(SDL_HIDAPI_enumeration.lock);
+
+    return 0;
+}
+
+static void HIDAPI_StartEnumerationThread(void)
+{
+    SDL_HIDAPI_enumeration.lock = SDL_CreateMutex();
+    SDL_HIDAPI_enumeration.cond = SDL_CreateCondition();
+    if (SDL_HIDAPI_enumeration.lock && SDL_HIDAPI_enumeration.cond) {
+        SDL_HIDAPI_enumeration.thread = SDL_CreateThreadInternal(HIDAPI_EnumerationThread, "SDLHIDAPIEnumeration", 0, NULL);
+    }
+    /* If the thread couldn't be created, we'll enumerate devices on the calling thread */
+}
+
+static void HIDAPI_StopEnumerationThread(void)
+{
+    if (SDL_HIDAPI_enumeration.thread) {
+        SDL_LockMutex(SDL_HIDAPI_enumeration.lock);
+        SDL_HIDAPI_enumeration.quit = SDL_TRUE;
+        SDL_SignalCondition(SDL_HIDAPI_enumeration.cond);
+        SDL_UnlockMutex(SDL_HIDAPI_enumeration.lock);
+
+        SDL_WaitThread(SDL_HIDAPI_enumeration.thread, NULL);
+        SDL_HIDAPI_enumeration.thread = NULL;
+    }
+    if (SDL_HIDAPI_enumeration.devs) {
+        SDL_hid_free_enumeration(SDL_HIDAPI_enumeration.devs);
+        SDL_HIDAPI_enumeration.devs = NULL;
+    }
+    if (SDL_HIDAPI_enumeration.cond) {
+        SDL_DestroyCondition(SDL_HIDAPI_enumeration.cond);
+        SDL_HIDAPI_enumeration.cond = NULL;
+    }
+    if (SDL_HIDAPI_enumeration.lock) {
+        SDL_DestroyMutex(SDL_HIDAPI_enumeration.lock);
+        SDL_HIDAPI_enumeration.lock = NULL;
+    }
+    SDL_HIDAPI_enumeration.quit = SDL_FALSE;
+    SDL_HIDAPI_enumeration.requested = SDL_FALSE;
+    SDL_HIDAPI_enumeration.complete = SDL_FALSE;
+}
+#endif /* SDL_HIDAPI_ENUMERATE_ON_THREAD */
+
+/* Start updating the device list, returns SDL_FALSE if it has to be done synchronously */
+static SDL_bool HIDAPI_RequestDeviceListUpdate(void)
+{
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+    if (SDL_HIDAPI_enumeration.thread) {
+        SDL_LockMutex(SDL_HIDAPI_enumeration.lock);
+        SDL_HIDAPI_enumeration.requested = SDL_TRUE;
+        SDL_SignalCondition(SDL_HIDAPI_enumeration.cond);
+        SDL_UnlockMutex(SDL_HIDAPI_enumeration.lock);
+
+        /* Keep polling until the results are in, the change notification has already been consumed */
+        SDL_SetJoystickDetectWakeup(&SDL_HIDAPI_JoystickDriver, SDL_FALSE);
+        return SDL_TRUE;
+    }
+#endif
+    return SDL_FALSE;
+}
+
+/* Apply the results of a background enumeration, if there are any */
+static void HIDAPI_CheckDeviceListUpdate(void)
+{
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+    struct SDL_hid_device_info *devs = NULL;
+    SDL_bool complete = SDL_FALSE;
+
+    if (!SDL_HIDAPI_enumeration.thread) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_HIDAPI_enumeration.lock);
+    if (SDL_HIDAPI_enumeration.complete) {
+        devs = SDL_HIDAPI_enumeration.devs;
+        SDL_HIDAPI_enumeration.devs = NULL;
+        SDL_HIDAPI_enumeration.complete = SDL_FALSE;
+        complete = SDL_TRUE;
+    }
+    if (complete && !SDL_HIDAPI_enumeration.requested) {
+        SDL_SetJoystickDetectWakeup(&SDL_HIDAPI_JoystickDriver, (SDL_HIDAPI_wakeup_fd >= 0));
+    }
+    SDL_UnlockMutex(SDL_HIDAPI_enumeration.lock);
+
+    if (complete) {
+        SDL_LockJoysticks();
+        {
+            if (SDL_HIDAPI_hints_changed) {
+                SDL_HIDAPI_UpdateDrivers();
+                SDL_HIDAPI_hints_changed = SDL_FALSE;
+            }
+            HIDAPI_UpdateDeviceListFromEnumeration(devs);
+        }
+        SDL_UnlockJoysticks();
+
+        if (devs) {
+            SDL_hid_free_enumeration(devs);
+        }
+    }
+#endif
+}
+
 static SDL_bool HIDAPI_IsEquivalentToDevice(Uint16 vendor_id, Uint16 product_id, SDL_HIDAPI_Device *device)
 {
     if (vendor_id == device->vendor_id && product_id == device->product_id) {
@@ -1312,12 +1553,60 @@ static void HIDAPI_JoystickDetect(void)
         Uint32 count = SDL_hid_device_change_count();
         if (SDL_HIDAPI_change_count != count) {
             SDL_HIDAPI_change_count = count;
-            HIDAPI_UpdateDeviceList();
+            if (!HIDAPI_RequestDeviceListUpdate()) {
+                HIDAPI_UpdateDeviceList();
+            }
         }
+        HIDAPI_CheckDeviceListUpdate();
         SDL_AtomicUnlock(&SDL_HIDAPI_spinlock);
     }
 }
 
+/* Check all the devices that read input from a file descriptor with a single poll() */
+static void HIDAPI_PollDeviceInput(void)
+{
+#ifdef HAVE_POLL
+    struct pollfd fds[SDL_MAX_EVENT_WAKEUP_FDS];
+    SDL_HIDAPI_Device *devices[SDL_MAX_EVENT_WAKEUP_FDS];
+    SDL_HIDAPI_Device *device;
+    int i, count = 0;
+
+    for (device = SDL_HIDAPI_devices; device; device = device->next) {
+        if (device->input_fd < 0) {
+            continue;
+        }
+        if (count == SDL_arraysize(fds)) {
+            /* The count is limited by the event wakeup fds, so this shouldn't happen */
+            device->input_pending = SDL_TRUE;
+            continue;
+        }
+        fds[count].fd = device->input_fd;
+        fds[count].events = POLLIN;
+        fds[count].revents = 0;
+        devices[count] = device;
+        ++count;
+    }
+
+    if (count > 0 && poll(fds, count, 0) < 0) {
+        /* Read all the devices, so errors are handled by the drivers */
+        for (i = 0; i < count; ++i) {
+            fds[i].revents = POLLIN;
+        }
+    }
+
+    for (i = 0; i < count; ++i) {
+        /* Disconnections show up as POLLERR or POLLHUP, and are reported by the read */
+        devices[i]->input_pending = (fds[i].revents != 0) ? SDL_TRUE : SDL_FALSE;
+    }
+#else
+    SDL_HIDAPI_Device *device;
+
+    for (device = SDL_HIDAPI_devices; device; device = device->next) {
+        device->input_pending = SDL_TRUE;
+    }
+#endif /* HAVE_POLL */
+}
+
 void HIDAPI_UpdateDevices(void)
 {
     SDL_HIDAPI_Device *device;
@@ -1328,10 +1617,16 @@ void HIDAPI_UpdateDevices(void)
 
     /* Prepare the existing device list */
     if (SDL_AtomicTryLock(&SDL_HIDAPI_spinlock)) {
+        HIDAPI_PollDeviceInput();
+
         for (device = SDL_HIDAPI_devices; device; device = device->next) {
             if (device->parent) {
                 continue;
             }
+            if (device->input_fd >= 0 && !device->input_pending) {
+                /* Nothing to read, skip the syscalls */
+                continue;
+            }
             if (device->driver) {
                 if (SDL_TryLockMutex(device->dev_lock) == 0) {
                     device->updating = SDL_TRUE;
@@ -1463,6 +1758,10 @@ static int HIDAPI_JoystickOpen(SDL_Joystick *joystick, int device_index)
         joystick->serial = SDL_strdup(device->serial);
     }
 
+    if (device->input_fd >= 0) {
+        joystick->input_wakeup = SDL_TRUE;
+    }
+
     joystick->hwdata = hwdata;
     return 0;
 }
@@ -1605,6 +1904,10 @@ static void HIDAPI_JoystickQuit(void)
 
     shutting_down = SDL_TRUE;
 
+#ifdef SDL_HIDAPI_ENUMERATE_ON_THREAD
+    HIDAPI_StopEnumerationThread();
+#endif
+
     SDL_HIDAPI_QuitRumble();
 
     while (SDL_HIDAPI_devices) {
@@ -1633,8 +1936,18 @@ static void HIDAPI_JoystickQuit(void)
     SDL_DelHintCallback(SDL_HINT_JOYSTICK_HIDAPI,
                         SDL_HIDAPIDriverHintChanged, NULL);
 
+    if (SDL_HIDAPI_wakeup_fd >= 0) {
+        SDL_DelEventWakeupFD(SDL_HIDAPI_wakeup_fd);
+        SDL_HIDAPI_wakeup_fd = -1;
+    }
+
     SDL_hid_exit();
 
+    if (SDL_HIDAPI_enumerate_lock) {
+        SDL_DestroyMutex(SDL_HIDAPI_enumerate_lock);
+        SDL_HIDAPI_enumerate_lock = NULL;
+    }
+
     SDL_HIDAPI_change_count = 0;
     shutting_down = SDL_FALSE;
     initialized = SDL_FALSE;
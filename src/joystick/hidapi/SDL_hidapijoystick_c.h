@@ -82,6 +82,12 @@ typedef struct SDL_HIDAPI_Device
     /* Used to flag that the device is being updated */
     SDL_bool updating;
 
+    /* Set by drivers whose UpdateDevice() only processes input reports,
+       so it can be skipped while the device has nothing to read */
+    SDL_bool update_on_input;
+    int input_fd;           /* The file descriptor polled for input, or -1 if it isn't available */
+    SDL_bool input_pending; /* Set by HIDAPI_UpdateDevices() when input_fd is readable */
+
     struct SDL_HIDAPI_Device *parent;
     int num_children;
     struct SDL_HIDAPI_Device **children;
@@ -159,4 +165,7 @@ extern SDL_bool HIDAPI_SupportsPlaystationDetection(Uint16 vendor, Uint16 produc
 
 extern float HIDAPI_RemapVal(float val, float val_min, float val_max, float output_min, float output_max);
 
+/* Returns the 4 D-pad button states for a hat value, starting at SDL_GAMEPAD_BUTTON_DPAD_UP, for use with SDL_SendJoystickButtons() */
+extern const Uint8 *HIDAPI_GetDpadStatesFromHat(Uint8 hat);
+
 #endif /* SDL_JOYSTICK_HIDAPI_H */
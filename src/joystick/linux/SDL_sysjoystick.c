@@ -181,6 +181,7 @@ static SDL_joylist_item *SDL_joylist_tail SDL_GUARDED_BY(SDL_joystick_lock) = NU
 static int numjoysticks SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static SDL_sensorlist_item *SDL_sensorlist SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static int inotify_fd = -1;
+static int detect_wakeup_fd = -1;
 
 static Uint64 last_joy_detect_time;
 static time_t last_input_dir_mtime;
@@ -951,6 +952,12 @@ static int LINUX_JoystickInit(void)
 
         /* Force a scan to build the initial device list */
         SDL_UDEV_Scan();
+
+        /* Let SDL_WaitEvent() sleep until udev has something for us */
+        if (SDL_AddEventWakeupFD(SDL_UDEV_GetMonitorFD()) == 0) {
+            detect_wakeup_fd = SDL_UDEV_GetMonitorFD();
+            SDL_SetJoystickDetectWakeup(&SDL_LINUX_JoystickDriver, SDL_TRUE);
+        }
     } else
 #endif
     {
@@ -974,6 +981,9 @@ static int LINUX_JoystickInit(void)
                 SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
                             "Unable to add inotify watch, falling back to polling: %s",
                             strerror(errno));
+            } else if (SDL_AddEventWakeupFD(inotify_fd) == 0) {
+                detect_wakeup_fd = inotify_fd;
+                SDL_SetJoystickDetectWakeup(&SDL_LINUX_JoystickDriver, SDL_TRUE);
             }
         }
 #endif /* HAVE_INOTIFY */
@@ -1503,6 +1513,11 @@ static int LINUX_JoystickOpen(SDL_Joystick *joystick, int device_index)
         joystick->hwdata->fd_sensor = -1;
     }
 
+    /* Input is read from the device node, so SDL_WaitEvent() can sleep on it */
+    if (SDL_AddEventWakeupFD(joystick->hwdata->fd) == 0) {
+        joystick->input_wakeup = SDL_TRUE;
+    }
+
     return 0;
 }
 
@@ -1597,8 +1612,12 @@ static int LINUX_JoystickSetSensorsEnabled(SDL_Joystick *joystick, SDL_bool enab
             return SDL_SetError("Couldn't open sensor file %s.", joystick->hwdata->item_sensor->path);
         }
         fcntl(joystick->hwdata->fd_sensor, F_SETFL, O_NONBLOCK);
+        if (SDL_AddEventWakeupFD(joystick->hwdata->fd_sensor) < 0) {
+            joystick->input_wakeup = SDL_FALSE;
+        }
     } else {
         SDL_assert(joystick->hwdata->fd_sensor >= 0);
+        SDL_DelEventWakeupFD(joystick->hwdata->fd_sensor);
         close(joystick->hwdata->fd_sensor);
         joystick->hwdata->fd_sensor = -1;
     }
@@ -1881,6 +1900,9 @@ static void HandleInputEvents(SDL_Joystick *joystick)
         /* We have to wait until the JoystickDetect callback to remove this */
         joystick->hwdata->gone = SDL_TRUE;
         errno = 0;
+
+        /* The node stays readable once it's gone, don't let it wake us up */
+        SDL_DelEventWakeupFD(joystick->hwdata->fd);
     }
 
     if (joystick->hwdata->report_sensor) {
@@ -1971,6 +1993,8 @@ static void HandleInputEvents(SDL_Joystick *joystick)
     if (errno == ENODEV) {
         /* We have to wait until the JoystickDetect callback to remove this */
         joystick->hwdata->sensor_gone = SDL_TRUE;
+
+        SDL_DelEventWakeupFD(joystick->hwdata->fd_sensor);
     }
 }
 
@@ -2048,9 +2072,11 @@ static void LINUX_JoystickClose(SDL_Joystick *joystick)
             joystick->hwdata->effect.id = -1;
         }
         if (joystick->hwdata->fd >= 0) {
+            SDL_DelEventWakeupFD(joystick->hwdata->fd);
             close(joystick->hwdata->fd);
         }
         if (joystick->hwdata->fd_sensor >= 0) {
+            SDL_DelEventWakeupFD(joystick->hwdata->fd_sensor);
             close(joystick->hwdata->fd_sensor);
         }
         if (joystick->hwdata->item) {
@@ -2077,6 +2103,11 @@ static void LINUX_JoystickQuit(void)
 
     SDL_AssertJoysticksLocked();
 
+    if (detect_wakeup_fd >= 0) {
+        SDL_DelEventWakeupFD(detect_wakeup_fd);
+        detect_wakeup_fd = -1;
+    }
+
     if (inotify_fd >= 0) {
         close(inotify_fd);
         inotify_fd = -1;
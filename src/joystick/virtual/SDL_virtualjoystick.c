@@ -331,8 +331,37 @@ int SDL_SetJoystickVirtualHatInner(SDL_Joystick *joystick, int hat, Uint8 value)
     return 0;
 }
 
+int SDL_SetJoystickVirtualStateInner(SDL_Joystick *joystick, const SDL_JoystickSnapshot *state)
+{
+    joystick_hwdata *hwdata;
+    int naxes, nbuttons, nhats;
+
+    SDL_AssertJoysticksLocked();
+
+    if (!joystick || !joystick->hwdata) {
+        return SDL_SetError("Invalid joystick");
+    }
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+
+    hwdata = (joystick_hwdata *)joystick->hwdata;
+    naxes = SDL_clamp(state->naxes, 0, SDL_min(hwdata->desc.naxes, SDL_arraysize(state->axes)));
+    nbuttons = SDL_clamp(state->nbuttons, 0, SDL_min(hwdata->desc.nbuttons, SDL_arraysize(state->buttons)));
+    nhats = SDL_clamp(state->nhats, 0, SDL_min(hwdata->desc.nhats, SDL_arraysize(state->hats)));
+
+    /* The next update sends events for the controls that changed */
+    SDL_memcpy(hwdata->axes, state->axes, naxes * sizeof(*hwdata->axes));
+    SDL_memcpy(hwdata->buttons, state->buttons, nbuttons * sizeof(*hwdata->buttons));
+    SDL_memcpy(hwdata->hats, state->hats, nhats * sizeof(*hwdata->hats));
+
+    return 0;
+}
+
 static int VIRTUAL_JoystickInit(void)
 {
+    /* Devices are added and removed by the application, there's nothing to detect */
+    SDL_SetJoystickDetectWakeup(&SDL_VIRTUAL_JoystickDriver, SDL_TRUE);
     return 0;
 }
 
@@ -548,12 +577,8 @@ static void VIRTUAL_JoystickUpdate(SDL_Joystick *joystick)
         hwdata->desc.Update(hwdata->desc.userdata);
     }
 
-    for (i = 0; i < hwdata->desc.naxes; ++i) {
-        SDL_SendJoystickAxis(timestamp, joystick, i, hwdata->axes[i]);
-    }
-    for (i = 0; i < hwdata->desc.nbuttons; ++i) {
-        SDL_SendJoystickButton(timestamp, joystick, i, hwdata->buttons[i]);
-    }
+    SDL_SendJoystickAxes(timestamp, joystick, 0, hwdata->axes, hwdata->desc.naxes);
+    SDL_SendJoystickButtons(timestamp, joystick, 0, hwdata->buttons, hwdata->desc.nbuttons);
     for (i = 0; i < hwdata->desc.nhats; ++i) {
         SDL_SendJoystickHat(timestamp, joystick, i, hwdata->hats[i]);
     }
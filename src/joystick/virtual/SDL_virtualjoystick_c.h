@@ -50,6 +50,7 @@ int SDL_JoystickDetachVirtualInner(SDL_JoystickID instance_id);
 int SDL_SetJoystickVirtualAxisInner(SDL_Joystick *joystick, int axis, Sint16 value);
 int SDL_SetJoystickVirtualButtonInner(SDL_Joystick *joystick, int button, Uint8 value);
 int SDL_SetJoystickVirtualHatInner(SDL_Joystick *joystick, int hat, Uint8 value);
+int SDL_SetJoystickVirtualStateInner(SDL_Joystick *joystick, const SDL_JoystickSnapshot *state);
 
 #endif /* SDL_JOYSTICK_VIRTUAL */
 
@@ -25,6 +25,11 @@
 
 #ifndef __IOS__
 
+#ifdef __MACOS__
+#include <CoreVideo/CVDisplayLink.h>
+#include <mach/mach_time.h>
+#endif
+
 static int callback_rate_increment = 0;
 
 static void SDLCALL MainCallbackRateHintChanged(void *userdata, const char *name, const char *oldValue, const char *newValue)
@@ -37,12 +42,102 @@ static void SDLCALL MainCallbackRateHintChanged(void *userdata, const char *name
     }
 }
 
+#ifdef __MACOS__
+
+static SDL_Semaphore *display_link_frame;
+static SDL_SpinLock display_link_lock;
+static Uint64 display_link_target; /* host time of the next frame */
+static Uint64 display_link_interval_ns;
+
+static CVReturn MainCallbackDisplayLinkCallback(CVDisplayLinkRef displayLink, const CVTimeStamp *now, const CVTimeStamp *outputTime, CVOptionFlags flagsIn, CVOptionFlags *flagsOut, void *displayLinkContext)
+{
+    SDL_AtomicLock(&display_link_lock);
+    display_link_target = outputTime->hostTime;
+    if (outputTime->videoTimeScale > 0) {
+        display_link_interval_ns = ((Uint64)outputTime->videoRefreshPeriod * SDL_NS_PER_SECOND) / (Uint64)outputTime->videoTimeScale;
+    }
+    SDL_AtomicUnlock(&display_link_lock);
+
+    SDL_PostSemaphore(display_link_frame);
+    return kCVReturnSuccess;
+}
+
+/* Run the app iterations as the display link fires, returns SDL_FALSE if the display link isn't available */
+static SDL_bool IterateMainCallbacksWithDisplayLink(int *rc)
+{
+    SDL_PropertiesID props = SDL_GetGlobalProperties();
+    CVDisplayLinkRef link = NULL;
+    mach_timebase_info_data_t timebase;
+
+    display_link_frame = SDL_CreateSemaphore(0);
+    if (!display_link_frame) {
+        return SDL_FALSE;
+    }
+    if (CVDisplayLinkCreateWithActiveCGDisplays(&link) != kCVReturnSuccess ||
+        CVDisplayLinkSetOutputCallback(link, MainCallbackDisplayLinkCallback, NULL) != kCVReturnSuccess ||
+        CVDisplayLinkStart(link) != kCVReturnSuccess) {
+        if (link) {
+            CVDisplayLinkRelease(link);
+        }
+        SDL_DestroySemaphore(display_link_frame);
+        display_link_frame = NULL;
+        return SDL_FALSE;
+    }
+    mach_timebase_info(&timebase);
+
+    do {
+        Uint64 target, interval_ns, now_host, now_ns, target_ns;
+
+        /* Don't hang if the display sleeps and the link stops firing */
+        SDL_WaitSemaphoreTimeout(display_link_frame, 100);
+
+        /* If we fell behind, just run once for the latest frame */
+        while (SDL_TryWaitSemaphore(display_link_frame) == 0) {
+        }
+
+        SDL_AtomicLock(&display_link_lock);
+        target = display_link_target;
+        interval_ns = display_link_interval_ns;
+        SDL_AtomicUnlock(&display_link_lock);
+
+        /* SDL_GetTicksNS() is based on the same host clock, so just carry the offset over */
+        now_host = mach_absolute_time();
+        now_ns = SDL_GetTicksNS();
+        if (target >= now_host) {
+            target_ns = now_ns + ((target - now_host) * timebase.numer) / timebase.denom;
+        } else {
+            target_ns = now_ns - SDL_min(now_ns, ((now_host - target) * timebase.numer) / timebase.denom);
+        }
+        SDL_SetNumberProperty(props, "SDL.main.frame_target_ns", (Sint64)target_ns);
+        SDL_SetNumberProperty(props, "SDL.main.frame_interval_ns", (Sint64)interval_ns);
+
+        *rc = SDL_IterateMainCallbacks(SDL_TRUE);
+    } while (*rc == 0);
+
+    CVDisplayLinkStop(link);
+    CVDisplayLinkRelease(link);
+    SDL_DestroySemaphore(display_link_frame);
+    display_link_frame = NULL;
+    return SDL_TRUE;
+}
+
+#endif /* __MACOS__ */
+
 int SDL_EnterAppMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit, SDL_AppIterate_func appiter, SDL_AppEvent_func appevent, SDL_AppQuit_func appquit)
 {
     int rc = SDL_InitMainCallbacks(argc, argv, appinit, appiter, appevent, appquit);
     if (rc == 0) {
         SDL_AddHintCallback(SDL_HINT_MAIN_CALLBACK_RATE, MainCallbackRateHintChanged, NULL);
 
+#ifdef __MACOS__
+        if (SDL_GetHintBoolean(SDL_HINT_MAC_DISPLAY_LINK_ITERATE, SDL_FALSE) &&
+            IterateMainCallbacksWithDisplayLink(&rc)) {
+            SDL_DelHintCallback(SDL_HINT_MAIN_CALLBACK_RATE, MainCallbackRateHintChanged, NULL);
+            SDL_QuitMainCallbacks();
+            return (rc < 0) ? 1 : 0;
+        }
+#endif
+
         Uint64 next_iteration = callback_rate_increment ? (SDL_GetTicksNS() + callback_rate_increment) : 0;
 
         while ((rc = SDL_IterateMainCallbacks(SDL_TRUE)) == 0) {
@@ -20,6 +20,7 @@
 */
 #include "SDL_internal.h"
 #include "SDL_syspower.h"
+#include "SDL_power_c.h"
 
 /*
  * Returns SDL_TRUE if we have a definitive answer.
@@ -41,11 +42,8 @@ static SDL_bool SDL_GetPowerInfo_Hardwired(SDL_PowerState *state, int *seconds,
 #endif
 
 static SDL_GetPowerInfo_Impl implementations[] = {
-#ifdef SDL_POWER_LINUX /* in order of preference. More than could work. */
-    SDL_GetPowerInfo_Linux_org_freedesktop_upower,
-    SDL_GetPowerInfo_Linux_sys_class_power_supply,
-    SDL_GetPowerInfo_Linux_proc_acpi,
-    SDL_GetPowerInfo_Linux_proc_apm,
+#ifdef SDL_POWER_LINUX /* caches UPower, sysfs, ACPI and APM */
+    SDL_GetPowerInfo_Linux,
 #endif
 #ifdef SDL_POWER_WINDOWS /* handles Win32, Win64, PocketPC. */
     SDL_GetPowerInfo_Windows,
@@ -114,3 +112,10 @@ SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent)
     *percent = -1;
     return SDL_POWERSTATE_UNKNOWN;
 }
+
+void SDL_QuitPowerInfo(void)
+{
+#if !defined(SDL_POWER_DISABLED) && defined(SDL_POWER_LINUX)
+    SDL_QuitPowerInfo_Linux();
+#endif
+}
@@ -34,6 +34,11 @@
 #include "../SDL_syspower.h"
 
 #include "../../core/linux/SDL_dbus.h"
+#include "../../core/linux/SDL_udev.h"
+
+#ifdef SDL_USE_LIBUDEV
+#include <poll.h>
+#endif
 
 static const char *proc_apm_path = "/proc/apm";
 static const char *proc_acpi_battery_path = "/proc/acpi/battery";
@@ -644,5 +649,157 @@ SDL_bool SDL_GetPowerInfo_Linux_org_freedesktop_upower(SDL_PowerState *state, in
     return retval;
 }
 
+/* Asking UPower or walking sysfs is far too slow to do every time the
+ * application polls, so the last answer is kept until udev reports that a
+ * power supply changed. Not every driver sends change events for capacity,
+ * so the answer is refreshed now and then regardless.
+ */
+#define POWER_CACHE_TIMEOUT_MS        1000
+#define POWER_CACHE_NOTIFY_TIMEOUT_MS 10000
+
+static struct
+{
+    SDL_SpinLock lock;
+    SDL_bool valid;
+    SDL_bool found;
+    Uint64 last_update;
+    SDL_PowerState state;
+    int seconds;
+    int percent;
+#ifdef SDL_USE_LIBUDEV
+    SDL_bool udev_initialized;
+    const SDL_UDEV_Symbols *usyms;
+    struct udev *udev;
+    struct udev_monitor *monitor;
+    int fd;
+#endif
+} power_cache;
+
+#ifdef SDL_USE_LIBUDEV
+static void QuitPowerSupplyMonitor(void)
+{
+    if (power_cache.monitor) {
+        power_cache.usyms->udev_monitor_unref(power_cache.monitor);
+        power_cache.monitor = NULL;
+    }
+    if (power_cache.udev) {
+        power_cache.usyms->udev_unref(power_cache.udev);
+        power_cache.udev = NULL;
+    }
+    if (power_cache.usyms) {
+        SDL_UDEV_ReleaseUdevSyms();
+        power_cache.usyms = NULL;
+    }
+    power_cache.fd = -1;
+}
+
+static void InitPowerSupplyMonitor(void)
+{
+    power_cache.udev_initialized = SDL_TRUE;
+    power_cache.fd = -1;
+
+    power_cache.usyms = SDL_UDEV_GetUdevSyms();
+    if (!power_cache.usyms) {
+        return;
+    }
+
+    power_cache.udev = power_cache.usyms->udev_new();
+    if (power_cache.udev) {
+        power_cache.monitor = power_cache.usyms->udev_monitor_new_from_netlink(power_cache.udev, "udev");
+        if (power_cache.monitor) {
+            power_cache.usyms->udev_monitor_filter_add_match_subsystem_devtype(power_cache.monitor, "power_supply", NULL);
+            power_cache.usyms->udev_monitor_enable_receiving(power_cache.monitor);
+            power_cache.fd = power_cache.usyms->udev_monitor_get_fd(power_cache.monitor);
+        }
+    }
+    if (power_cache.fd < 0) {
+        QuitPowerSupplyMonitor();
+    }
+}
+
+/* Drains pending power_supply events, returns SDL_TRUE if there were any */
+static SDL_bool CheckPowerSupplyChanged(void)
+{
+    SDL_bool changed = SDL_FALSE;
+    struct pollfd pfd;
+
+    if (!power_cache.udev_initialized) {
+        InitPowerSupplyMonitor();
+    }
+    if (power_cache.fd < 0) {
+        return SDL_FALSE;
+    }
+
+    pfd.fd = power_cache.fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    while (poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN)) {
+        struct udev_device *pDevice = power_cache.usyms->udev_monitor_receive_device(power_cache.monitor);
+        if (!pDevice) {
+            break;
+        }
+        power_cache.usyms->udev_device_unref(pDevice);
+        changed = SDL_TRUE;
+    }
+    return changed;
+}
+#endif /* SDL_USE_LIBUDEV */
+
+SDL_bool SDL_GetPowerInfo_Linux(SDL_PowerState *state, int *seconds, int *percent)
+{
+    const Uint64 now = SDL_GetTicks();
+    Uint64 timeout = POWER_CACHE_TIMEOUT_MS;
+    SDL_bool found;
+
+    SDL_AtomicLock(&power_cache.lock);
+#ifdef SDL_USE_LIBUDEV
+    if (CheckPowerSupplyChanged()) {
+        power_cache.valid = SDL_FALSE;
+    }
+    if (power_cache.fd >= 0) {
+        timeout = POWER_CACHE_NOTIFY_TIMEOUT_MS;
+    }
+#endif
+    if (power_cache.valid && (now - power_cache.last_update) < timeout) {
+        found = power_cache.found;
+        *state = power_cache.state;
+        *seconds = power_cache.seconds;
+        *percent = power_cache.percent;
+        SDL_AtomicUnlock(&power_cache.lock);
+        return found;
+    }
+    SDL_AtomicUnlock(&power_cache.lock);
+
+    /* in order of preference. More than could work. */
+    found = SDL_GetPowerInfo_Linux_org_freedesktop_upower(state, seconds, percent) ||
+            SDL_GetPowerInfo_Linux_sys_class_power_supply(state, seconds, percent) ||
+            SDL_GetPowerInfo_Linux_proc_acpi(state, seconds, percent) ||
+            SDL_GetPowerInfo_Linux_proc_apm(state, seconds, percent);
+
+    SDL_AtomicLock(&power_cache.lock);
+    power_cache.valid = SDL_TRUE;
+    power_cache.found = found;
+    power_cache.last_update = now;
+    if (found) {
+        power_cache.state = *state;
+        power_cache.seconds = *seconds;
+        power_cache.percent = *percent;
+    }
+    SDL_AtomicUnlock(&power_cache.lock);
+
+    return found;
+}
+
+void SDL_QuitPowerInfo_Linux(void)
+{
+    SDL_AtomicLock(&power_cache.lock);
+#ifdef SDL_USE_LIBUDEV
+    QuitPowerSupplyMonitor();
+    power_cache.udev_initialized = SDL_FALSE;
+#endif
+    power_cache.valid = SDL_FALSE;
+    SDL_AtomicUnlock(&power_cache.lock);
+}
+
 #endif /* SDL_POWER_LINUX */
 #endif /* SDL_POWER_DISABLED */
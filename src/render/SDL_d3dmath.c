@@ -86,9 +86,9 @@ Float4X4 MatrixTranslation(float x, float y, float z)
 
 Float4X4 MatrixRotationX(float r)
 {
-    float sinR = SDL_sinf(r);
-    float cosR = SDL_cosf(r);
+    float sinR, cosR;
     Float4X4 m;
+    SDL_sincosf(r, &sinR, &cosR);
     SDL_zero(m);
     m.v._11 = 1.0f;
     m.v._22 = cosR;
@@ -101,9 +101,9 @@ Float4X4 MatrixRotationX(float r)
 
 Float4X4 MatrixRotationY(float r)
 {
-    float sinR = SDL_sinf(r);
-    float cosR = SDL_cosf(r);
+    float sinR, cosR;
     Float4X4 m;
+    SDL_sincosf(r, &sinR, &cosR);
     SDL_zero(m);
     m.v._11 = cosR;
     m.v._13 = -sinR;
@@ -116,9 +116,9 @@ Float4X4 MatrixRotationY(float r)
 
 Float4X4 MatrixRotationZ(float r)
 {
-    float sinR = SDL_sinf(r);
-    float cosR = SDL_cosf(r);
+    float sinR, cosR;
     Float4X4 m;
+    SDL_sincosf(r, &sinR, &cosR);
     SDL_zero(m);
     m.v._11 = cosR;
     m.v._12 = sinR;
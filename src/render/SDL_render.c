@@ -26,6 +26,7 @@
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 #include "../video/SDL_video_c.h"
+#include "../SDL_trace_c.h"
 
 #ifdef __ANDROID__
 #include "../core/android/SDL_android.h"
@@ -57,6 +58,29 @@ this should probably be removed at some point in the future.  --ryan. */
         return retval;                                          \
     }
 
+#define CHECK_RECORDER_MAGIC(recorder, retval)                                \
+    if (!(recorder) || (recorder)->magic != &SDL_render_recorder_magic) {    \
+        SDL_InvalidParamError("recorder");                                   \
+        return retval;                                                       \
+    }
+
+#define CHECK_COMMAND_LIST_MAGIC(list, retval)                               \
+    if (!(list) || (list)->magic != &SDL_render_command_list_magic) {       \
+        SDL_InvalidParamError("list");                                       \
+        return retval;                                                       \
+    }
+
+#define CHECK_NOT_RECORDING(renderer, retval)                                \
+    if ((renderer)->recording_commands) {                                    \
+        (renderer)->recording_failed = SDL_TRUE;                             \
+        SDL_SetError("Can't do that while recording a render command list"); \
+        return retval;                                                       \
+    }
+
+/* Offsets into the vertex data of a replayed command list keep this alignment,
+   which is at least as strict as anything the backends ask for. */
+#define COMMAND_LIST_VERTEX_ALIGNMENT 256
+
 /* Predefined blend modes */
 #define SDL_COMPOSE_BLENDMODE(srcColorFactor, dstColorFactor, colorOperation, \
                               srcAlphaFactor, dstAlphaFactor, alphaOperation) \
@@ -107,6 +131,9 @@ static const SDL_RenderDriver *render_drivers[] = {
 #ifdef SDL_VIDEO_RENDER_OGL_ES2
     &GLES2_RenderDriver,
 #endif
+#ifdef SDL_VIDEO_RENDER_VULKAN
+    &VULKAN_RenderDriver,
+#endif
 #ifdef SDL_VIDEO_RENDER_PS2
     &PS2_RenderDriver,
 #endif
@@ -124,6 +151,11 @@ static const SDL_RenderDriver *render_drivers[] = {
 
 char SDL_renderer_magic;
 char SDL_texture_magic;
+char SDL_render_command_list_magic;
+char SDL_render_recorder_magic;
+
+/* Triangle indices for the corners of a rect, unless the backend needs another order */
+static const int default_rect_index_order[6] = { 0, 1, 2, 0, 2, 3 };
 
 static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 {
@@ -219,39 +251,203 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
                         (int) cmd->data.draw.blend, cmd->data.draw.texture);
                 break;
 
+            case SDL_RENDERCMD_DRAW_INSTANCES:
+                SDL_Log(" %u. draw instances (first=%u, count=%u, blend=%d, tex=%p)", i++,
+                        (unsigned int) cmd->data.draw.first,
+                        (unsigned int) cmd->data.draw.count,
+                        (int) cmd->data.draw.blend, cmd->data.draw.texture);
+                break;
+
         }
         cmd = cmd->next;
     }
 #endif
 }
 
+static void ResetRenderCommands(SDL_Renderer *renderer)
+{
+    /* Move the whole render command queue to the unused pool so we can reuse them next time. */
+    if (renderer->render_commands_tail) {
+        renderer->render_commands_tail->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = renderer->render_commands;
+        renderer->render_commands_tail = NULL;
+        renderer->render_commands = NULL;
+    }
+    renderer->vertex_data_used = 0;
+    renderer->render_command_generation++;
+    renderer->color_queued = SDL_FALSE;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+}
+
+static const char *SDL_render_stats_command_names[SDL_RENDERCMD_COUNT] = {
+    NULL, /* SDL_RENDERCMD_NO_OP */
+    "SDL.renderer.stats.commands.set_viewport",
+    "SDL.renderer.stats.commands.set_clip_rect",
+    "SDL.renderer.stats.commands.set_draw_color",
+    "SDL.renderer.stats.commands.clear",
+    "SDL.renderer.stats.commands.draw_points",
+    "SDL.renderer.stats.commands.draw_lines",
+    "SDL.renderer.stats.commands.fill_rects",
+    "SDL.renderer.stats.commands.copy",
+    "SDL.renderer.stats.commands.copy_ex",
+    "SDL.renderer.stats.commands.geometry",
+    "SDL.renderer.stats.commands.draw_instances"
+};
+
+static void CountRenderCommands(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
+{
+    while (cmd) {
+        ++renderer->stats.commands[cmd->command];
+        cmd = cmd->next;
+    }
+}
+
+static void CountTextureUpload(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    Uint64 size;
+
+    if (!renderer->stats_enabled) {
+        return;
+    }
+
+    size = (Uint64)rect->w * rect->h * bpp;
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format) && texture->format != SDL_PIXELFORMAT_YUY2 &&
+        texture->format != SDL_PIXELFORMAT_UYVY && texture->format != SDL_PIXELFORMAT_YVYU) {
+        if (texture->format == SDL_PIXELFORMAT_I444) {
+            /* Planar YUV, add the two full size chroma planes */
+            size *= 3;
+        } else {
+            /* Planar YUV, add the two quarter size chroma planes */
+            size += 2 * (Uint64)((rect->w + 1) / 2) * ((rect->h + 1) / 2) * bpp;
+        }
+    }
+    renderer->stats.texture_upload_bytes += size;
+}
+
+static void PublishRenderStats(SDL_Renderer *renderer)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    Uint64 commands = 0;
+    Uint64 gpu_time;
+    int i;
+
+    if (!props) {
+        return;
+    }
+
+    SDL_LockProperties(props);
+    for (i = 0; i < SDL_RENDERCMD_COUNT; ++i) {
+        if (SDL_render_stats_command_names[i]) {
+            SDL_SetNumberProperty(props, SDL_render_stats_command_names[i], (Sint64)renderer->stats.commands[i]);
+            commands += renderer->stats.commands[i];
+        }
+    }
+    SDL_SetNumberProperty(props, "SDL.renderer.stats.commands", (Sint64)commands);
+    SDL_SetNumberProperty(props, "SDL.renderer.stats.flushes", (Sint64)renderer->stats.flushes);
+    SDL_SetNumberProperty(props, "SDL.renderer.stats.batches", (Sint64)renderer->stats.batches);
+    SDL_SetNumberProperty(props, "SDL.renderer.stats.vertex_bytes", (Sint64)renderer->stats.vertex_bytes);
+    SDL_SetNumberProperty(props, "SDL.renderer.stats.texture_upload_bytes", (Sint64)renderer->stats.texture_upload_bytes);
+    if (renderer->GetFrameGPUTime && renderer->GetFrameGPUTime(renderer, &gpu_time)) {
+        SDL_SetNumberProperty(props, "SDL.renderer.stats.gpu_time_ns", (Sint64)gpu_time);
+    }
+    SDL_UnlockProperties(props);
+
+    SDL_zero(renderer->stats);
+}
+
+static int RunTextureUploads(SDL_Renderer *renderer)
+{
+    int retval = 0;
+
+    while (renderer->texture_uploads) {
+        SDL_TextureUpload *upload = renderer->texture_uploads;
+        SDL_Texture *texture = upload->texture;
+
+        renderer->texture_uploads = upload->next;
+        --texture->pending_uploads;
+        CountTextureUpload(texture, &upload->rect);
+        if (renderer->UpdateTexture(renderer, texture, &upload->rect, upload->pixels, upload->pitch) < 0) {
+            retval = -1;
+        }
+        SDL_free(upload->pixels);
+        SDL_free(upload);
+    }
+    renderer->texture_uploads_tail = NULL;
+    return retval;
+}
+
+static void DiscardTextureUploads(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_TextureUpload *prev = NULL;
+    SDL_TextureUpload *upload;
+
+    if (!texture->pending_uploads) {
+        return;
+    }
+
+    upload = renderer->texture_uploads;
+    while (upload) {
+        SDL_TextureUpload *next = upload->next;
+        if (upload->texture == texture) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                renderer->texture_uploads = next;
+            }
+            SDL_free(upload->pixels);
+            SDL_free(upload);
+        } else {
+            prev = upload;
+        }
+        upload = next;
+    }
+    renderer->texture_uploads_tail = prev;
+    texture->pending_uploads = 0;
+}
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
 
+    if (renderer->stats_enabled) {
+        ++renderer->stats.flushes;
+    }
+
+    if (renderer->texture_uploads) {
+        /* Deferred uploads happen before any draws queued after them */
+        RunTextureUploads(renderer);
+    }
+
     if (!renderer->render_commands) { /* nothing to do! */
         SDL_assert(renderer->vertex_data_used == 0);
         return 0;
     }
 
+    /* The queue is being recorded into a command list, it can't be run now */
+    CHECK_NOT_RECORDING(renderer, -1);
+
     DebugLogRenderCommands(renderer->render_commands);
 
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    SDL_TRACE_BEGIN("FlushRenderCommands");
+    SDL_TRACE_COUNTER("Render vertex bytes", renderer->vertex_data_used);
 
-    /* Move the whole render command queue to the unused pool so we can reuse them next time. */
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        renderer->render_commands_pool = renderer->render_commands;
-        renderer->render_commands_tail = NULL;
-        renderer->render_commands = NULL;
+    if (renderer->stats_enabled) {
+        ++renderer->stats.batches;
+        renderer->stats.vertex_bytes += renderer->vertex_data_used;
+        CountRenderCommands(renderer, renderer->render_commands);
     }
-    renderer->vertex_data_used = 0;
-    renderer->render_command_generation++;
-    renderer->color_queued = SDL_FALSE;
-    renderer->viewport_queued = SDL_FALSE;
-    renderer->cliprect_queued = SDL_FALSE;
+
+    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+
+    ResetRenderCommands(renderer);
+
+    SDL_TRACE_END("FlushRenderCommands");
     return retval;
 }
 
@@ -262,14 +458,47 @@ static int FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
         /* the current command queue depends on this texture, flush the queue now before it changes */
         return FlushRenderCommands(renderer);
     }
+    if (texture->pending_uploads > 0) {
+        /* finish the deferred uploads before the texture contents change */
+        return RunTextureUploads(renderer);
+    }
     return 0;
 }
 
+static void ReplayRenderRecordings(SDL_Renderer *renderer);
+
 int SDL_RenderFlush(SDL_Renderer *renderer)
 {
+    /* Submitted recordings are pending commands too */
+    if (!renderer->recording_commands) {
+        ReplayRenderRecordings(renderer);
+    }
     return FlushRenderCommands(renderer);
 }
 
+void SDL_GetRenderQuadIndices(const SDL_Renderer *renderer, Uint16 *indices, int num_quads)
+{
+    const int *order = renderer->rect_index_order;
+    int i;
+
+    /* Backends fill their index buffers while they're being created, before
+       the default order is set up in SDL_CreateRendererWithProperties() */
+    if (order[0] == 0 && order[1] == 0) {
+        order = default_rect_index_order;
+    }
+
+    SDL_assert(num_quads <= SDL_RENDER_MAX_QUADS);
+    for (i = 0; i < num_quads; ++i) {
+        const int first = i * 4;
+        *indices++ = (Uint16)(first + order[0]);
+        *indices++ = (Uint16)(first + order[1]);
+        *indices++ = (Uint16)(first + order[2]);
+        *indices++ = (Uint16)(first + order[3]);
+        *indices++ = (Uint16)(first + order[4]);
+        *indices++ = (Uint16)(first + order[5]);
+    }
+}
+
 void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
 {
     const size_t needed = renderer->vertex_data_used + numbytes + alignment;
@@ -305,6 +534,138 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
+SDL_bool SDL_IsRenderVertexArray(const float *xy, int xy_stride, const SDL_Color *color, int color_stride, const float *uv, int uv_stride)
+{
+    const SDL_Vertex *vertices = (const SDL_Vertex *)xy;
+
+    return (xy_stride == sizeof(SDL_Vertex) &&
+            color_stride == sizeof(SDL_Vertex) &&
+            uv_stride == sizeof(SDL_Vertex) &&
+            color == &vertices->color &&
+            uv == &vertices->tex_coord.x);
+}
+
+void SDL_CopyRenderVertices(SDL_Vertex *dst, const SDL_Vertex *vertices, int count, const void *indices, int size_indices)
+{
+    int i;
+
+    if (size_indices == 4) {
+        for (i = 0; i < count; ++i) {
+            dst[i] = vertices[((const Uint32 *)indices)[i]];
+        }
+    } else if (size_indices == 2) {
+        for (i = 0; i < count; ++i) {
+            dst[i] = vertices[((const Uint16 *)indices)[i]];
+        }
+    } else if (size_indices == 1) {
+        for (i = 0; i < count; ++i) {
+            dst[i] = vertices[((const Uint8 *)indices)[i]];
+        }
+    } else {
+        SDL_memcpy(dst, vertices, count * sizeof(*dst));
+    }
+}
+
+static int GetRenderInstances(SDL_Texture *texture, const SDL_TextureInstance *instances, int count,
+                              float scale_x, float scale_y, SDL_bool map_atlas, SDL_RenderInstance *dst)
+{
+    SDL_FRect texture_rect;
+    float scale_u = 1.0f, scale_v = 1.0f;
+    float offset_u = 0.0f, offset_v = 0.0f;
+    int i, num_instances = 0;
+
+    texture_rect.x = 0.0f;
+    texture_rect.y = 0.0f;
+    texture_rect.w = (float)texture->w;
+    texture_rect.h = (float)texture->h;
+
+    if (map_atlas && texture->atlas_page) {
+        /* Map the texture coordinates into the atlas page */
+        scale_u = (float)texture->w / texture->atlas_page->texture->w;
+        scale_v = (float)texture->h / texture->atlas_page->texture->h;
+        offset_u = (float)texture->atlas_rect.x / texture->atlas_page->texture->w;
+        offset_v = (float)texture->atlas_rect.y / texture->atlas_page->texture->h;
+    }
+
+    for (i = 0; i < count; ++i) {
+        const SDL_TextureInstance *instance = &instances[i];
+        const SDL_FRect *dstrect = &instance->dstrect;
+        SDL_RenderInstance *out = &dst[num_instances];
+        SDL_FRect srcrect;
+        float minu, minv, maxu, maxv;
+
+        if (!SDL_GetRectIntersectionFloat(&instance->srcrect, &texture_rect, &srcrect)) {
+            continue;
+        }
+
+        minu = offset_u + (srcrect.x / texture->w) * scale_u;
+        minv = offset_v + (srcrect.y / texture->h) * scale_v;
+        maxu = offset_u + ((srcrect.x + srcrect.w) / texture->w) * scale_u;
+        maxv = offset_v + ((srcrect.y + srcrect.h) / texture->h) * scale_v;
+
+        if (instance->flip & SDL_FLIP_HORIZONTAL) {
+            out->uv[0] = maxu;
+            out->uv[2] = minu;
+        } else {
+            out->uv[0] = minu;
+            out->uv[2] = maxu;
+        }
+        if (instance->flip & SDL_FLIP_VERTICAL) {
+            out->uv[1] = maxv;
+            out->uv[3] = minv;
+        } else {
+            out->uv[1] = minv;
+            out->uv[3] = maxv;
+        }
+
+        if (instance->angle != 0.0) {
+            /* rotate the corners around the center with 2x2 matrix ( c -s )
+             *                                                      ( s  c ) */
+            const float radian_angle = (float)((SDL_PI_D * instance->angle) / 180.0);
+            const float half_w = dstrect->w / 2.0f;
+            const float half_h = dstrect->h / 2.0f;
+            float s, c;
+
+            SDL_sincosf(radian_angle, &s, &c);
+
+            out->origin.x = dstrect->x + half_w - (c * half_w - s * half_h);
+            out->origin.y = dstrect->y + half_h - (s * half_w + c * half_h);
+            out->axis_x.x = c * dstrect->w;
+            out->axis_x.y = s * dstrect->w;
+            out->axis_y.x = -s * dstrect->h;
+            out->axis_y.y = c * dstrect->h;
+        } else {
+            out->origin.x = dstrect->x;
+            out->origin.y = dstrect->y;
+            out->axis_x.x = dstrect->w;
+            out->axis_x.y = 0.0f;
+            out->axis_y.x = 0.0f;
+            out->axis_y.y = dstrect->h;
+        }
+
+        out->origin.x *= scale_x;
+        out->origin.y *= scale_y;
+        out->axis_x.x *= scale_x;
+        out->axis_x.y *= scale_y;
+        out->axis_y.x *= scale_x;
+        out->axis_y.y *= scale_y;
+
+        out->color.r = (Uint8)(((Uint32)instance->color.r * texture->color.r) / 255);
+        out->color.g = (Uint8)(((Uint32)instance->color.g * texture->color.g) / 255);
+        out->color.b = (Uint8)(((Uint32)instance->color.b * texture->color.b) / 255);
+        out->color.a = (Uint8)(((Uint32)instance->color.a * texture->color.a) / 255);
+
+        ++num_instances;
+    }
+    return num_instances;
+}
+
+int SDL_GetRenderInstances(SDL_Texture *texture, const SDL_TextureInstance *instances, int count,
+                           float scale_x, float scale_y, SDL_RenderInstance *dst)
+{
+    return GetRenderInstances(texture, instances, count, scale_x, scale_y, SDL_TRUE, dst);
+}
+
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *retval = NULL;
@@ -347,6 +708,31 @@ static void GetRenderViewportInPixels(SDL_Renderer *renderer, SDL_Rect *rect)
     } else {
         rect->h = renderer->view->pixel_h;
     }
+    if (renderer->view == &renderer->logical_view) {
+        /* The logical presentation sits somewhere inside the output */
+        rect->x += (int)renderer->logical_dst_rect.x;
+        rect->y += (int)renderer->logical_dst_rect.y;
+    }
+}
+
+/* The view the app draws to when it renders to the window, and the render scale it set there */
+static SDL_RenderViewState *GetWindowView(SDL_Renderer *renderer, SDL_FPoint *scale)
+{
+    SDL_RenderViewState *view;
+
+    if (renderer->logical_target) {
+        view = &renderer->logical_target->view;
+    } else if (renderer->logical_direct) {
+        view = &renderer->logical_view;
+    } else {
+        view = &renderer->main_view;
+    }
+    *scale = view->scale;
+    if (view == &renderer->logical_view) {
+        scale->x /= renderer->logical_scale.x;
+        scale->y /= renderer->logical_scale.y;
+    }
+    return view;
 }
 
 static int QueueCmdSetViewport(SDL_Renderer *renderer)
@@ -405,6 +791,18 @@ static int QueueCmdSetClipRect(SDL_Renderer *renderer)
     return retval;
 }
 
+static int SetRenderView(SDL_Renderer *renderer, SDL_RenderViewState *view)
+{
+    if (renderer->view == view) {
+        return 0;
+    }
+    renderer->view = view;
+    if (QueueCmdSetViewport(renderer) < 0) {
+        return -1;
+    }
+    return QueueCmdSetClipRect(renderer);
+}
+
 static int QueueCmdSetDrawColor(SDL_Renderer *renderer, SDL_Color *col)
 {
     const Uint32 color = (((Uint32)col->a << 24) | (col->r << 16) | (col->g << 8) | col->b);
@@ -449,6 +847,9 @@ static int QueueCmdClear(SDL_Renderer *renderer)
     return 0;
 }
 
+static int UseTexture(SDL_Texture *texture);
+static SDL_Texture *GetAtlasPageTexture(SDL_Texture *texture);
+
 static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype, SDL_Texture *texture)
 {
     SDL_RenderCommand *cmd = NULL;
@@ -457,6 +858,9 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
     SDL_BlendMode blendMode;
 
     if (texture) {
+        if (UseTexture(texture) < 0) {
+            return NULL;
+        }
         color = &texture->color;
         blendMode = texture->blendMode;
     } else {
@@ -464,7 +868,7 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
         blendMode = renderer->blendMode;
     }
 
-    if (cmdtype != SDL_RENDERCMD_GEOMETRY) {
+    if (cmdtype != SDL_RENDERCMD_GEOMETRY && cmdtype != SDL_RENDERCMD_DRAW_INSTANCES) {
         retval = QueueCmdSetDrawColor(renderer, color);
     }
 
@@ -489,16 +893,19 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
             cmd->data.draw.a = color->a;
             cmd->data.draw.blend = blendMode;
             cmd->data.draw.texture = texture;
+            cmd->data.draw.size = 1.0f;
+            cmd->data.draw.quads = SDL_FALSE;
         }
     }
     return cmd;
 }
 
-static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
+static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count, const float size)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
     int retval = -1;
     if (cmd) {
+        cmd->data.draw.size = size;
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
@@ -507,11 +914,12 @@ static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points,
     return retval;
 }
 
-static int QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
+static int QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, const int count, const float size)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_LINES, NULL);
     int retval = -1;
     if (cmd) {
+        cmd->data.draw.size = size;
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
@@ -529,11 +937,46 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
     cmd = PrepQueueCmdDraw(renderer, (use_rendergeometry ? SDL_RENDERCMD_GEOMETRY : SDL_RENDERCMD_FILL_RECTS), NULL);
 
     if (cmd) {
-        if (use_rendergeometry) {
-            SDL_bool isstack1;
-            SDL_bool isstack2;
-            float *xy = SDL_small_alloc(float, 4 * 2 * count, &isstack1);
-            int *indices = SDL_small_alloc(int, 6 * count, &isstack2);
+        if (use_rendergeometry && renderer->indexed_quads && count <= SDL_RENDER_MAX_QUADS) {
+            const size_t mark = SDL_scratch_mark();
+            float *xy = SDL_scratch_alloc(float, 4 * 2 * count);
+
+            if (xy) {
+                int i;
+                float *ptr_xy = xy;
+
+                for (i = 0; i < count; ++i) {
+                    const float minx = rects[i].x;
+                    const float miny = rects[i].y;
+                    const float maxx = rects[i].x + rects[i].w;
+                    const float maxy = rects[i].y + rects[i].h;
+
+                    *ptr_xy++ = minx;
+                    *ptr_xy++ = miny;
+                    *ptr_xy++ = maxx;
+                    *ptr_xy++ = miny;
+                    *ptr_xy++ = maxx;
+                    *ptr_xy++ = maxy;
+                    *ptr_xy++ = minx;
+                    *ptr_xy++ = maxy;
+                }
+
+                cmd->data.draw.quads = SDL_TRUE;
+                retval = renderer->QueueGeometry(renderer, cmd, NULL,
+                                                 xy, 2 * sizeof(float), &renderer->color, 0 /* color_stride */, NULL, 0,
+                                                 4 * count, NULL, 0, 0,
+                                                 1.0f, 1.0f);
+
+                if (retval < 0) {
+                    cmd->command = SDL_RENDERCMD_NO_OP;
+                }
+            }
+            SDL_scratch_free(mark);
+
+        } else if (use_rendergeometry) {
+            const size_t mark = SDL_scratch_mark();
+            float *xy = SDL_scratch_alloc(float, 4 * 2 * count);
+            int *indices = SDL_scratch_alloc(int, 6 * count);
 
             if (xy && indices) {
                 int i;
@@ -581,8 +1024,7 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
                     cmd->command = SDL_RENDERCMD_NO_OP;
                 }
             }
-            SDL_small_free(xy, isstack1);
-            SDL_small_free(indices, isstack2);
+            SDL_scratch_free(mark);
 
         } else {
             retval = renderer->QueueFillRects(renderer, cmd, rects, count);
@@ -634,6 +1076,14 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     int retval = -1;
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
+        if (renderer->indexed_quads && indices == renderer->rect_index_order) {
+            /* A single rect or texture, the backend only needs the corners */
+            SDL_assert(num_vertices == 4 && num_indices == 6);
+            cmd->data.draw.quads = SDL_TRUE;
+            indices = NULL;
+            num_indices = 0;
+            size_indices = 0;
+        }
         retval = renderer->QueueGeometry(renderer, cmd, texture,
                                          xy, xy_stride,
                                          color, color_stride, uv, uv_stride,
@@ -646,6 +1096,25 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval;
 }
 
+static int QueueCmdInstances(SDL_Renderer *renderer, SDL_Texture *texture,
+                             const SDL_TextureInstance *instances, int count,
+                             float scale_x, float scale_y)
+{
+    SDL_Texture *drawtexture = texture->atlas_page ? GetAtlasPageTexture(texture) : texture;
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+
+    cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_INSTANCES, drawtexture);
+    if (cmd) {
+        drawtexture->last_command_generation = renderer->render_command_generation;
+        retval = renderer->QueueInstances(renderer, cmd, texture, instances, count, scale_x, scale_y);
+        if (retval < 0 || cmd->data.draw.count == 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        }
+    }
+    return retval;
+}
+
 static void UpdateMainViewDimensions(SDL_Renderer *renderer)
 {
     int window_w = 0, window_h = 0;
@@ -797,6 +1266,14 @@ static void SDL_CalculateSimulatedVSyncInterval(SDL_Renderer *renderer, SDL_Wind
     renderer->simulate_vsync_interval_ns = (SDL_NS_PER_SECOND * num) / den;
 }
 
+static void SetTextureMemoryBudget(SDL_Renderer *renderer, Sint64 budget)
+{
+    renderer->texture_memory_budget = SDL_max(budget, 0);
+    if (renderer->texture_memory_budget > 0) {
+        SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), "SDL.renderer.texture_memory_budget", renderer->texture_memory_budget);
+    }
+}
+
 #endif /* !SDL_RENDER_DISABLED */
 
 
@@ -812,7 +1289,13 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
     int i;
 
     if (!window && surface) {
-        return SDL_CreateSoftwareRenderer(surface);
+        renderer = SDL_CreateSoftwareRenderer(surface);
+        if (renderer) {
+            renderer->texture_atlas = SDL_GetBooleanProperty(props, "texture_atlas", SDL_FALSE);
+            renderer->stats_enabled = SDL_GetBooleanProperty(props, "stats", SDL_FALSE);
+            SetTextureMemoryBudget(renderer, SDL_GetNumberProperty(props, "texture_memory_budget", 0));
+        }
+        return renderer;
     }
 
 #ifdef __ANDROID__
@@ -878,12 +1361,17 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
         }
     }
     SDL_CalculateSimulatedVSyncInterval(renderer, window);
+    renderer->refresh_interval = renderer->simulate_vsync_interval_ns;
+
+    renderer->texture_atlas = SDL_GetBooleanProperty(props, "texture_atlas", SDL_FALSE);
+    renderer->stats_enabled = SDL_GetBooleanProperty(props, "stats", SDL_FALSE);
 
     VerifyDrawQueueFunctions(renderer);
 
     renderer->magic = &SDL_renderer_magic;
     renderer->window = window;
     renderer->target_mutex = SDL_CreateMutex();
+    renderer->recordings_lock = SDL_CreateMutex();
     renderer->main_view.viewport.w = -1;
     renderer->main_view.viewport.h = -1;
     renderer->main_view.scale.x = 1.0f;
@@ -895,12 +1383,7 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
 
     /* Default value, if not specified by the renderer back-end */
     if (renderer->rect_index_order[0] == 0 && renderer->rect_index_order[1] == 0) {
-        renderer->rect_index_order[0] = 0;
-        renderer->rect_index_order[1] = 1;
-        renderer->rect_index_order[2] = 2;
-        renderer->rect_index_order[3] = 0;
-        renderer->rect_index_order[4] = 2;
-        renderer->rect_index_order[5] = 3;
+        SDL_memcpy(renderer->rect_index_order, default_rect_index_order, sizeof(renderer->rect_index_order));
     }
 
     /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
@@ -918,6 +1401,11 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
 
     SDL_SetRenderViewport(renderer, NULL);
 
+    if (renderer->native_vertices) {
+        SDL_SetBooleanProperty(SDL_GetRendererProperties(renderer), "SDL.renderer.native_vertices", SDL_TRUE);
+    }
+    SetTextureMemoryBudget(renderer, SDL_GetNumberProperty(props, "texture_memory_budget", 0));
+
     SDL_AddEventWatch(SDL_RendererEventWatch, renderer);
 
     SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
@@ -970,6 +1458,7 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
         VerifyDrawQueueFunctions(renderer);
         renderer->magic = &SDL_renderer_magic;
         renderer->target_mutex = SDL_CreateMutex();
+        renderer->recordings_lock = SDL_CreateMutex();
         renderer->main_view.pixel_w = surface->w;
         renderer->main_view.pixel_h = surface->h;
         renderer->main_view.viewport.w = -1;
@@ -1042,6 +1531,16 @@ int SDL_GetCurrentRenderOutputSize(SDL_Renderer *renderer, int *w, int *h)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (renderer->view == &renderer->logical_view) {
+        if (w) {
+            *w = (int)renderer->logical_src_rect.w;
+        }
+        if (h) {
+            *h = (int)renderer->logical_src_rect.h;
+        }
+        return 0;
+    }
+
     if (w) {
         *w = renderer->view->pixel_w;
     }
@@ -1119,19 +1618,407 @@ static SDL_ScaleMode SDL_GetScaleMode(void)
     }
 }
 
-SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
+/* Small static textures can be packed into shared atlas pages so that drawing
+   them doesn't break up batches in the backends. */
+#define SDL_TEXTURE_ATLAS_PAGE_SIZE    1024
+#define SDL_TEXTURE_ATLAS_MAX_SIZE     128
+#define SDL_TEXTURE_ATLAS_PADDING      1
+
+/* Released render targets are destroyed if they aren't reused for this many frames */
+#define SDL_RENDER_TARGET_POOL_FRAMES  3
+
+static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroying);
+
+/* Get the GPU memory used by a texture, estimated from the size of its pixels */
+static Sint64 GetTextureMemorySize(SDL_Texture *texture)
 {
-    SDL_Texture *texture;
-    Uint32 format = (Uint32)SDL_GetNumberProperty(props, "format", SDL_PIXELFORMAT_UNKNOWN);
-    int access = (int)SDL_GetNumberProperty(props, "access", SDL_TEXTUREACCESS_STATIC);
-    int w = (int)SDL_GetNumberProperty(props, "width", 0);
-    int h = (int)SDL_GetNumberProperty(props, "height", 0);
-    SDL_bool texture_is_fourcc_and_target;
+    size_t size = 0;
 
-    CHECK_RENDERER_MAGIC(renderer, NULL);
+    if (SDL_CalculateSize(texture->format, texture->w, texture->h, &size, NULL, SDL_TRUE) < 0) {
+        return 0;
+    }
+    return (Sint64)size;
+}
 
-    if (!format) {
-        format = renderer->info.texture_formats[0];
+static void UpdateTextureMemoryProperties(SDL_Renderer *renderer)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+
+    SDL_SetNumberProperty(props, "SDL.renderer.texture_memory", renderer->texture_memory);
+    SDL_SetNumberProperty(props, "SDL.renderer.target_memory", renderer->target_memory);
+}
+
+static void AddTextureMemory(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    texture->memory = GetTextureMemorySize(texture);
+    if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+        renderer->target_memory += texture->memory;
+    } else {
+        renderer->texture_memory += texture->memory;
+    }
+    UpdateTextureMemoryProperties(renderer);
+}
+
+static void RemoveTextureMemory(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+        renderer->target_memory -= texture->memory;
+    } else {
+        renderer->texture_memory -= texture->memory;
+    }
+    texture->memory = 0;
+    UpdateTextureMemoryProperties(renderer);
+}
+
+static SDL_bool CanEvictTexture(SDL_Texture *texture)
+{
+    return (texture->reload_callback && !texture->evicted && texture->memory > 0 &&
+            texture->access == SDL_TEXTUREACCESS_STATIC &&
+            !texture->native && !texture->yuv && !texture->atlas_page &&
+            !SDL_ISPIXELFORMAT_FOURCC(texture->format) &&
+            texture->pending_uploads == 0);
+}
+
+/* Destroy pooled render targets and then evict the least recently used textures,
+   until the budget has room for another `size` bytes or there's nothing left to free */
+static void MakeRoomForTextureMemory(SDL_Renderer *renderer, Sint64 size)
+{
+    if (renderer->texture_memory_budget <= 0 || renderer->recording_commands) {
+        return;
+    }
+
+    while (renderer->texture_memory + renderer->target_memory + size > renderer->texture_memory_budget) {
+        SDL_Texture *texture, *lru = NULL;
+
+        if (renderer->target_pool) {
+            /* This unlinks it from the pool */
+            SDL_DestroyTexture(renderer->target_pool);
+            continue;
+        }
+
+        for (texture = renderer->textures; texture; texture = texture->next) {
+            if (CanEvictTexture(texture) && (!lru || texture->last_used < lru->last_used)) {
+                lru = texture;
+            }
+        }
+        if (!lru || FlushRenderCommandsIfTextureNeeded(lru) < 0) {
+            break;
+        }
+
+        renderer->DestroyTexture(renderer, lru);
+        lru->driverdata = NULL;
+        lru->evicted = SDL_TRUE;
+        RemoveTextureMemory(lru);
+
+        ++renderer->texture_evictions;
+        SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), "SDL.renderer.texture_evictions", renderer->texture_evictions);
+    }
+}
+
+/* Create the GPU texture for a texture that doesn't have one */
+static int CreateTextureStorage(SDL_Texture *texture, SDL_PropertiesID create_props)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    MakeRoomForTextureMemory(renderer, GetTextureMemorySize(texture));
+
+    if (create_props) {
+        if (renderer->CreateTexture(renderer, texture, create_props) < 0) {
+            return -1;
+        }
+    } else {
+        SDL_PropertiesID props;
+        int retval;
+
+        props = SDL_CreateProperties();
+        SDL_SetNumberProperty(props, "format", texture->format);
+        SDL_SetNumberProperty(props, "access", texture->access);
+        SDL_SetNumberProperty(props, "width", texture->w);
+        SDL_SetNumberProperty(props, "height", texture->h);
+        retval = renderer->CreateTexture(renderer, texture, props);
+        SDL_DestroyProperties(props);
+        if (retval < 0) {
+            return -1;
+        }
+        renderer->SetTextureScaleMode(renderer, texture, texture->scaleMode);
+    }
+    AddTextureMemory(texture);
+    return 0;
+}
+
+/* Mark a texture as used, creating it again if it was evicted */
+static int UseTexture(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    texture->last_used = ++renderer->texture_use_count;
+    if (!texture->evicted) {
+        return 0;
+    }
+
+    if (CreateTextureStorage(texture, 0) < 0) {
+        return -1;
+    }
+    texture->evicted = SDL_FALSE;
+    return texture->reload_callback(texture->reload_userdata, texture);
+}
+
+static void SDLCALL CheckAtlasTextureProperty(void *userdata, SDL_PropertiesID props, const char *name)
+{
+    SDL_bool *can_atlas = (SDL_bool *)userdata;
+
+    /* Renderer specific properties, like wrapped native textures, need a real texture */
+    if (SDL_strchr(name, '.') != NULL) {
+        *can_atlas = SDL_FALSE;
+    }
+}
+
+static SDL_bool CanAtlasTexture(SDL_Renderer *renderer, SDL_PropertiesID props, Uint32 format, int access, int w, int h)
+{
+    SDL_bool can_atlas = SDL_TRUE;
+
+    if (!renderer->texture_atlas ||
+        access != SDL_TEXTUREACCESS_STATIC ||
+        SDL_ISPIXELFORMAT_FOURCC(format) ||
+        SDL_ISPIXELFORMAT_INDEXED(format) ||
+        !IsSupportedFormat(renderer, format) ||
+        w > SDL_TEXTURE_ATLAS_MAX_SIZE || h > SDL_TEXTURE_ATLAS_MAX_SIZE) {
+        return SDL_FALSE;
+    }
+    if (props) {
+        if (!SDL_GetBooleanProperty(props, "atlas", SDL_TRUE) ||
+            SDL_GetNumberProperty(props, "distance_field", SDL_DISTANCEFIELD_NONE) != SDL_DISTANCEFIELD_NONE) {
+            return SDL_FALSE;
+        }
+        SDL_EnumerateProperties(props, CheckAtlasTextureProperty, &can_atlas);
+    }
+    return can_atlas;
+}
+
+static SDL_bool AllocateAtlasRect(SDL_TextureAtlasPage *page, int w, int h, SDL_Rect *rect)
+{
+    const int padded_w = w + 2 * SDL_TEXTURE_ATLAS_PADDING;
+    const int padded_h = h + 2 * SDL_TEXTURE_ATLAS_PADDING;
+
+    if (padded_w > page->texture->w) {
+        return SDL_FALSE;
+    }
+    if (page->shelf_x + padded_w > page->texture->w) {
+        /* Start a new shelf */
+        page->shelf_x = 0;
+        page->shelf_y += page->shelf_h;
+        page->shelf_h = 0;
+    }
+    if (page->shelf_y + padded_h > page->texture->h) {
+        return SDL_FALSE;
+    }
+
+    rect->x = page->shelf_x + SDL_TEXTURE_ATLAS_PADDING;
+    rect->y = page->shelf_y + SDL_TEXTURE_ATLAS_PADDING;
+    rect->w = w;
+    rect->h = h;
+    page->shelf_x += padded_w;
+    page->shelf_h = SDL_max(page->shelf_h, padded_h);
+    ++page->num_textures;
+    return SDL_TRUE;
+}
+
+static SDL_TextureAtlasPage *CreateAtlasPage(SDL_Renderer *renderer, Uint32 format, SDL_ScaleMode scaleMode)
+{
+    SDL_TextureAtlasPage *page;
+    SDL_PropertiesID props;
+    int w = SDL_TEXTURE_ATLAS_PAGE_SIZE;
+    int h = SDL_TEXTURE_ATLAS_PAGE_SIZE;
+
+    if (renderer->info.max_texture_width) {
+        w = SDL_min(w, renderer->info.max_texture_width);
+    }
+    if (renderer->info.max_texture_height) {
+        h = SDL_min(h, renderer->info.max_texture_height);
+    }
+
+    page = (SDL_TextureAtlasPage *)SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "format", format);
+    SDL_SetNumberProperty(props, "access", SDL_TEXTUREACCESS_STATIC);
+    SDL_SetNumberProperty(props, "width", w);
+    SDL_SetNumberProperty(props, "height", h);
+    SDL_SetBooleanProperty(props, "atlas", SDL_FALSE);
+    page->texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    if (!page->texture) {
+        SDL_free(page);
+        return NULL;
+    }
+    SDL_SetTextureScaleMode(page->texture, scaleMode);
+
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    return page;
+}
+
+static int AddTextureToAtlas(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_TextureAtlasPage *page;
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        if (page->texture->format == texture->format &&
+            page->texture->scaleMode == texture->scaleMode &&
+            AllocateAtlasRect(page, texture->w, texture->h, &texture->atlas_rect)) {
+            break;
+        }
+    }
+    if (!page) {
+        page = CreateAtlasPage(renderer, texture->format, texture->scaleMode);
+        if (!page) {
+            return -1;
+        }
+        if (!AllocateAtlasRect(page, texture->w, texture->h, &texture->atlas_rect)) {
+            return SDL_SetError("Texture doesn't fit in an atlas page");
+        }
+    }
+    texture->atlas_page = page;
+
+    /* Keep a copy of the pixels for the padding and in case we need a real texture later */
+    texture->pitch = (((texture->w * SDL_BYTESPERPIXEL(texture->format)) + 3) & ~3);
+    texture->pixels = SDL_calloc(1, (size_t)texture->pitch * texture->h);
+    if (!texture->pixels) {
+        return SDL_OutOfMemory();
+    }
+    return 0;
+}
+
+static void RemoveTextureFromAtlas(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_TextureAtlasPage *page = texture->atlas_page;
+
+    texture->atlas_page = NULL;
+
+    /* Space is only reclaimed once the whole page is unused */
+    if (--page->num_textures == 0) {
+        SDL_TextureAtlasPage *prev = NULL;
+        SDL_TextureAtlasPage *node;
+
+        for (node = renderer->atlas_pages; node; prev = node, node = node->next) {
+            if (node == page) {
+                if (prev) {
+                    prev->next = page->next;
+                } else {
+                    renderer->atlas_pages = page->next;
+                }
+                break;
+            }
+        }
+        SDL_DestroyTextureInternal(page->texture, SDL_FALSE);
+        SDL_free(page);
+    }
+}
+
+static int UpdateAtlasTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    const int padded_w = texture->w + 2 * SDL_TEXTURE_ATLAS_PADDING;
+    const int padded_h = texture->h + 2 * SDL_TEXTURE_ATLAS_PADDING;
+    const int padded_pitch = padded_w * bpp;
+    const Uint8 *src;
+    Uint8 *dst;
+    Uint8 *padded;
+    SDL_Rect padded_rect;
+    int retval;
+    int x, y;
+
+    /* Update our copy of the pixels */
+    src = (const Uint8 *)pixels;
+    dst = (Uint8 *)texture->pixels + rect->y * texture->pitch + rect->x * bpp;
+    for (y = 0; y < rect->h; ++y) {
+        SDL_memcpy(dst, src, (size_t)rect->w * bpp);
+        src += pitch;
+        dst += texture->pitch;
+    }
+
+    /* Repeat the edge pixels into the padding so linear filtering doesn't bleed into neighbors */
+    padded = (Uint8 *)SDL_malloc((size_t)padded_h * padded_pitch);
+    if (!padded) {
+        return SDL_OutOfMemory();
+    }
+    for (y = 0; y < padded_h; ++y) {
+        const int src_y = SDL_clamp(y - SDL_TEXTURE_ATLAS_PADDING, 0, texture->h - 1);
+        src = (const Uint8 *)texture->pixels + src_y * texture->pitch;
+        dst = padded + y * padded_pitch;
+        for (x = 0; x < SDL_TEXTURE_ATLAS_PADDING; ++x) {
+            SDL_memcpy(dst + x * bpp, src, bpp);
+            SDL_memcpy(dst + (padded_w - 1 - x) * bpp, src + (texture->w - 1) * bpp, bpp);
+        }
+        SDL_memcpy(dst + SDL_TEXTURE_ATLAS_PADDING * bpp, src, (size_t)texture->w * bpp);
+    }
+
+    padded_rect.x = texture->atlas_rect.x - SDL_TEXTURE_ATLAS_PADDING;
+    padded_rect.y = texture->atlas_rect.y - SDL_TEXTURE_ATLAS_PADDING;
+    padded_rect.w = padded_w;
+    padded_rect.h = padded_h;
+    retval = SDL_UpdateTexture(texture->atlas_page->texture, &padded_rect, padded, padded_pitch);
+    SDL_free(padded);
+    return retval;
+}
+
+/* Move a texture out of its atlas page into a texture of its own */
+static int DetachTextureFromAtlas(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_Rect rect;
+
+    if (CreateTextureStorage(texture, 0) < 0) {
+        return -1;
+    }
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = texture->w;
+    rect.h = texture->h;
+    CountTextureUpload(texture, &rect);
+    renderer->UpdateTexture(renderer, texture, &rect, texture->pixels, texture->pitch);
+
+    RemoveTextureFromAtlas(texture);
+    SDL_free(texture->pixels);
+    texture->pixels = NULL;
+    texture->pitch = 0;
+    return 0;
+}
+
+/* Get the atlas page to draw with, carrying over the texture draw state */
+static SDL_Texture *GetAtlasPageTexture(SDL_Texture *texture)
+{
+    SDL_Texture *page = texture->atlas_page->texture;
+
+    page->color = texture->color;
+    page->blendMode = texture->blendMode;
+    return page;
+}
+
+SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
+{
+    SDL_Texture *texture;
+    Uint32 format = (Uint32)SDL_GetNumberProperty(props, "format", SDL_PIXELFORMAT_UNKNOWN);
+    int access = (int)SDL_GetNumberProperty(props, "access", SDL_TEXTUREACCESS_STATIC);
+    int w = (int)SDL_GetNumberProperty(props, "width", 0);
+    int h = (int)SDL_GetNumberProperty(props, "height", 0);
+    SDL_DistanceField distance_field = (SDL_DistanceField)SDL_GetNumberProperty(props, "distance_field", SDL_DISTANCEFIELD_NONE);
+    SDL_bool texture_is_fourcc_and_target;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = renderer->info.texture_formats[0];
     }
     if (SDL_BYTESPERPIXEL(format) == 0) {
         SDL_SetError("Invalid texture format");
@@ -1147,6 +2034,21 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
         SDL_SetError("Texture dimensions can't be 0");
         return NULL;
     }
+    if (distance_field != SDL_DISTANCEFIELD_NONE) {
+        if (distance_field != SDL_DISTANCEFIELD_SDF && distance_field != SDL_DISTANCEFIELD_MSDF) {
+            SDL_SetError("Unknown distance field: %d", (int)distance_field);
+            return NULL;
+        }
+        if (!renderer->supports_distance_fields) {
+            SDL_Unsupported();
+            return NULL;
+        }
+        if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format) ||
+            (distance_field == SDL_DISTANCEFIELD_SDF && !SDL_ISPIXELFORMAT_ALPHA(format))) {
+            SDL_SetError("Distance fields aren't supported with %s", SDL_GetPixelFormatName(format));
+            return NULL;
+        }
+    }
     if ((renderer->info.max_texture_width && w > renderer->info.max_texture_width) ||
         (renderer->info.max_texture_height && h > renderer->info.max_texture_height)) {
         SDL_SetError("Texture dimensions are limited to %dx%d", renderer->info.max_texture_width, renderer->info.max_texture_height);
@@ -1167,6 +2069,7 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     texture->color.b = 255;
     texture->color.a = 255;
     texture->scaleMode = SDL_GetScaleMode();
+    texture->distance_field = distance_field;
     texture->view.pixel_w = w;
     texture->view.pixel_h = h;
     texture->view.viewport.w = -1;
@@ -1183,11 +2086,26 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     /* FOURCC format cannot be used directly by renderer back-ends for target texture */
     texture_is_fourcc_and_target = (access == SDL_TEXTUREACCESS_TARGET && SDL_ISPIXELFORMAT_FOURCC(texture->format));
 
-    if (texture_is_fourcc_and_target == SDL_FALSE && IsSupportedFormat(renderer, format)) {
-        if (renderer->CreateTexture(renderer, texture, props) < 0) {
+    if (CanAtlasTexture(renderer, props, format, access, w, h)) {
+        if (AddTextureToAtlas(renderer, texture) < 0) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
+    } else if (texture_is_fourcc_and_target == SDL_FALSE && IsSupportedFormat(renderer, format)) {
+        if (CreateTextureStorage(texture, props) < 0) {
             SDL_DestroyTexture(texture);
             return NULL;
         }
+        if (access == SDL_TEXTUREACCESS_STREAMING && SDL_GetBooleanProperty(props, "lock_shadow", SDL_FALSE)) {
+            /* The pitch is 4 byte aligned */
+            texture->pitch = (((w * SDL_BYTESPERPIXEL(format)) + 3) & ~3);
+            texture->pixels = SDL_calloc(1, (size_t)texture->pitch * h);
+            if (!texture->pixels) {
+                SDL_DestroyTexture(texture);
+                return NULL;
+            }
+            texture->shadowed = SDL_TRUE;
+        }
     } else {
         int closest_format;
 
@@ -1197,7 +2115,23 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
             closest_format = renderer->info.texture_formats[0];
         }
 
-        texture->native = SDL_CreateTexture(renderer, closest_format, access, w, h);
+        if (distance_field != SDL_DISTANCEFIELD_NONE) {
+            /* The backends choose their shader when the texture is created */
+            SDL_PropertiesID native_props = SDL_CreateProperties();
+            if (!native_props) {
+                SDL_DestroyTexture(texture);
+                return NULL;
+            }
+            SDL_SetNumberProperty(native_props, "format", closest_format);
+            SDL_SetNumberProperty(native_props, "access", access);
+            SDL_SetNumberProperty(native_props, "width", w);
+            SDL_SetNumberProperty(native_props, "height", h);
+            SDL_SetNumberProperty(native_props, "distance_field", distance_field);
+            texture->native = SDL_CreateTextureWithProperties(renderer, native_props);
+            SDL_DestroyProperties(native_props);
+        } else {
+            texture->native = SDL_CreateTexture(renderer, closest_format, access, w, h);
+        }
         if (!texture->native) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -1252,6 +2186,113 @@ SDL_Texture *SDL_CreateTexture(SDL_Renderer *renderer, Uint32 format, int access
     return texture;
 }
 
+static void RemoveTextureFromPool(SDL_Texture *texture)
+{
+    SDL_Texture **prev = &texture->renderer->target_pool;
+
+    while (*prev) {
+        if (*prev == texture) {
+            *prev = texture->pool_next;
+            break;
+        }
+        prev = &(*prev)->pool_next;
+    }
+    texture->pooled = SDL_FALSE;
+    texture->pool_next = NULL;
+}
+
+static void ExpirePooledRenderTargets(SDL_Renderer *renderer)
+{
+    SDL_Texture **prev = &renderer->target_pool;
+
+    while (*prev) {
+        SDL_Texture *texture = *prev;
+
+        if ((renderer->present_count - texture->pool_release_frame) > SDL_RENDER_TARGET_POOL_FRAMES) {
+            /* This unlinks it from the pool */
+            SDL_DestroyTexture(texture);
+        } else {
+            prev = &texture->pool_next;
+        }
+    }
+}
+
+SDL_Texture *SDL_AcquireRenderTarget(SDL_Renderer *renderer, Uint32 format, int w, int h)
+{
+    SDL_Texture *texture;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = renderer->info.texture_formats[0];
+    }
+
+    for (texture = renderer->target_pool; texture; texture = texture->pool_next) {
+        if (texture->format == format && texture->w == w && texture->h == h) {
+            break;
+        }
+    }
+    if (!texture) {
+        return SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, w, h);
+    }
+
+    RemoveTextureFromPool(texture);
+
+    /* Reset the state to what a new texture would have */
+    texture->blendMode = SDL_BLENDMODE_NONE;
+    texture->color.r = 255;
+    texture->color.g = 255;
+    texture->color.b = 255;
+    texture->color.a = 255;
+    if (texture->scaleMode != SDL_GetScaleMode()) {
+        SDL_SetTextureScaleMode(texture, SDL_GetScaleMode());
+    }
+    SDL_zero(texture->view);
+    texture->view.pixel_w = w;
+    texture->view.pixel_h = h;
+    texture->view.viewport.w = -1;
+    texture->view.viewport.h = -1;
+    texture->view.scale.x = 1.0f;
+    texture->view.scale.y = 1.0f;
+    return texture;
+}
+
+int SDL_SetTextureReloadCallback(SDL_Texture *texture, SDL_TextureReloadCallback callback, void *userdata)
+{
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!callback && texture->evicted && UseTexture(texture) < 0) {
+        return -1;
+    }
+    texture->reload_callback = callback;
+    texture->reload_userdata = userdata;
+    return 0;
+}
+
+int SDL_ReleaseRenderTarget(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    renderer = texture->renderer;
+    if (texture->access != SDL_TEXTUREACCESS_TARGET) {
+        return SDL_SetError("Texture is not a render target");
+    }
+    if (texture->pooled) {
+        return SDL_SetError("Texture has already been released");
+    }
+    if (texture == renderer->target) {
+        return SDL_SetError("Can't release the current render target");
+    }
+
+    texture->pooled = SDL_TRUE;
+    texture->pool_release_frame = renderer->present_count;
+    texture->pool_next = renderer->target_pool;
+    renderer->target_pool = texture;
+    return 0;
+}
+
 SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface)
 {
     const SDL_PixelFormat *fmt;
@@ -1511,7 +2552,11 @@ int SDL_SetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode scaleMode)
     texture->scaleMode = scaleMode;
     if (texture->native) {
         return SDL_SetTextureScaleMode(texture->native, scaleMode);
-    } else {
+    } else if (texture->atlas_page) {
+        if (scaleMode != texture->atlas_page->texture->scaleMode) {
+            return DetachTextureFromAtlas(texture);
+        }
+    } else if (!texture->evicted) {
         renderer->SetTextureScaleMode(renderer, texture, scaleMode);
     }
     return 0;
@@ -1614,7 +2659,50 @@ static int SDL_UpdateTextureNative(SDL_Texture *texture, const SDL_Rect *rect,
     return 0;
 }
 
-int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+static void AddTextureShadowDirtyRect(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    if (SDL_RectEmpty(&texture->shadow_dirty)) {
+        texture->shadow_dirty = *rect;
+    } else {
+        SDL_GetRectUnion(&texture->shadow_dirty, rect, &texture->shadow_dirty);
+    }
+}
+
+static int UpdateTextureShadow(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    const size_t length = (size_t)rect->w * SDL_BYTESPERPIXEL(texture->format);
+    Uint8 *dst = (Uint8 *)texture->pixels + rect->y * texture->pitch + rect->x * SDL_BYTESPERPIXEL(texture->format);
+    int row;
+
+    for (row = 0; row < rect->h; ++row) {
+        SDL_memcpy(dst, (const Uint8 *)pixels + row * pitch, length);
+        dst += texture->pitch;
+    }
+    AddTextureShadowDirtyRect(texture, rect);
+    return 0;
+}
+
+/* Upload the area of a shadowed texture that changed since it was last drawn */
+static int UploadTextureShadow(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    const SDL_Rect rect = texture->shadow_dirty;
+    const void *pixels;
+
+    if (SDL_RectEmpty(&rect)) {
+        return 0;
+    }
+    SDL_zero(texture->shadow_dirty);
+
+    if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        return -1;
+    }
+    pixels = (const Uint8 *)texture->pixels + rect.y * texture->pitch + rect.x * SDL_BYTESPERPIXEL(texture->format);
+    CountTextureUpload(texture, &rect);
+    return renderer->UpdateTexture(renderer, texture, &rect, pixels, texture->pitch);
+}
+
+int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
 {
     SDL_Rect real_rect;
 
@@ -1645,15 +2733,170 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pi
 #endif
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, &real_rect, pixels, pitch);
+    } else if (texture->atlas_page) {
+        return UpdateAtlasTexture(texture, &real_rect, pixels, pitch);
+    } else if (texture->shadowed) {
+        return UpdateTextureShadow(texture, &real_rect, pixels, pitch);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        if (UseTexture(texture) < 0) {
+            return -1;
+        }
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        CountTextureUpload(texture, &real_rect);
         return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
     }
 }
 
+Uint64 SDL_UpdateTextureAsync(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    SDL_Renderer *renderer;
+    SDL_TextureUpload *upload;
+    SDL_Rect real_rect;
+    Uint64 ticket;
+    size_t length;
+    int row;
+
+    CHECK_TEXTURE_MAGIC(texture, 0);
+
+    if (!pixels) {
+        SDL_InvalidParamError("pixels");
+        return 0;
+    }
+    if (!pitch) {
+        SDL_InvalidParamError("pitch");
+        return 0;
+    }
+
+    renderer = texture->renderer;
+    ticket = ++renderer->texture_upload_ticket;
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
+            return ticket;
+        }
+    }
+
+    if (real_rect.w == 0 || real_rect.h == 0) {
+        return ticket; /* nothing to do. */
+    }
+
+    if (texture->yuv || texture->native || texture->atlas_page || texture->shadowed ||
+        SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        /* These are converted or shadowed on the CPU anyway, upload them right away */
+        if (SDL_UpdateTexture(texture, &real_rect, pixels, pitch) < 0) {
+            return 0;
+        }
+        return ticket;
+    }
+
+    if (UseTexture(texture) < 0) {
+        return 0;
+    }
+
+    if (texture->last_command_generation == renderer->render_command_generation) {
+        /* the current command queue depends on this texture, flush the queue now before it changes */
+        if (FlushRenderCommands(renderer) < 0) {
+            return 0;
+        }
+    }
+
+    if (renderer->UpdateTextureAsync) {
+        CountTextureUpload(texture, &real_rect);
+        if (renderer->UpdateTextureAsync(renderer, texture, &real_rect, pixels, pitch, ticket) < 0) {
+            return 0;
+        }
+        return ticket;
+    }
+
+    /* Stage a packed copy of the pixels, it's uploaded when the command queue is next flushed */
+    upload = (SDL_TextureUpload *)SDL_malloc(sizeof(*upload));
+    if (!upload) {
+        SDL_OutOfMemory();
+        return 0;
+    }
+    length = (size_t)real_rect.w * SDL_BYTESPERPIXEL(texture->format);
+    upload->pixels = SDL_malloc(length * real_rect.h);
+    if (!upload->pixels) {
+        SDL_free(upload);
+        SDL_OutOfMemory();
+        return 0;
+    }
+    for (row = 0; row < real_rect.h; ++row) {
+        SDL_memcpy((Uint8 *)upload->pixels + row * length, (const Uint8 *)pixels + row * pitch, length);
+    }
+    upload->texture = texture;
+    upload->rect = real_rect;
+    upload->pitch = (int)length;
+    upload->ticket = ticket;
+    upload->next = NULL;
+
+    if (renderer->texture_uploads_tail) {
+        renderer->texture_uploads_tail->next = upload;
+    } else {
+        renderer->texture_uploads = upload;
+    }
+    renderer->texture_uploads_tail = upload;
+    ++texture->pending_uploads;
+
+    return ticket;
+}
+
+static SDL_bool IsTextureUploadPending(SDL_Renderer *renderer, Uint64 ticket)
+{
+    SDL_TextureUpload *upload;
+
+    for (upload = renderer->texture_uploads; upload; upload = upload->next) {
+        if (upload->ticket == ticket) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+SDL_bool SDL_IsTextureUploadComplete(SDL_Renderer *renderer, Uint64 ticket)
+{
+    CHECK_RENDERER_MAGIC(renderer, SDL_FALSE);
+
+    if (!ticket || ticket > renderer->texture_upload_ticket) {
+        SDL_InvalidParamError("ticket");
+        return SDL_FALSE;
+    }
+
+    if (IsTextureUploadPending(renderer, ticket)) {
+        return SDL_FALSE;
+    }
+    if (renderer->QueryTextureUpload) {
+        return renderer->QueryTextureUpload(renderer, ticket, SDL_FALSE);
+    }
+    return SDL_TRUE;
+}
+
+int SDL_WaitTextureUpload(SDL_Renderer *renderer, Uint64 ticket)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!ticket || ticket > renderer->texture_upload_ticket) {
+        return SDL_InvalidParamError("ticket");
+    }
+
+    if (IsTextureUploadPending(renderer, ticket)) {
+        if (RunTextureUploads(renderer) < 0) {
+            return -1;
+        }
+    }
+    if (renderer->QueryTextureUpload) {
+        renderer->QueryTextureUpload(renderer, ticket, SDL_TRUE);
+    }
+    return 0;
+}
+
 #if SDL_HAVE_YUV
 static int SDL_UpdateTextureYUVPlanar(SDL_Texture *texture, const SDL_Rect *rect,
                                       const Uint8 *Yplane, int Ypitch,
@@ -1789,8 +3032,9 @@ int SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
     }
 
     if (texture->format != SDL_PIXELFORMAT_YV12 &&
-        texture->format != SDL_PIXELFORMAT_IYUV) {
-        return SDL_SetError("Texture format must by YV12 or IYUV");
+        texture->format != SDL_PIXELFORMAT_IYUV &&
+        texture->format != SDL_PIXELFORMAT_I444) {
+        return SDL_SetError("Texture format must by YV12, IYUV or I444");
     }
 
     real_rect.x = 0;
@@ -1815,6 +3059,7 @@ int SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
+            CountTextureUpload(texture, &real_rect);
             return renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -1849,8 +3094,10 @@ int SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
     }
 
     if (texture->format != SDL_PIXELFORMAT_NV12 &&
-        texture->format != SDL_PIXELFORMAT_NV21) {
-        return SDL_SetError("Texture format must by NV12 or NV21");
+        texture->format != SDL_PIXELFORMAT_NV21 &&
+        texture->format != SDL_PIXELFORMAT_P010 &&
+        texture->format != SDL_PIXELFORMAT_P016) {
+        return SDL_SetError("Texture format must by NV12, NV21, P010 or P016");
     }
 
     real_rect.x = 0;
@@ -1875,6 +3122,7 @@ int SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
+            CountTextureUpload(texture, &real_rect);
             return renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
         } else {
             return SDL_Unsupported();
@@ -1933,11 +3181,15 @@ int SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect, void **pixels, i
         if (texture->native) {
         /* Calls a real SDL_LockTexture/SDL_UnlockTexture on unlock, flushing then. */
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
+    } else if (texture->shadowed) {
+        /* The GPU never reads this memory, the locked area is uploaded before the next draw */
+        return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
         SDL_Renderer *renderer = texture->renderer;
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        texture->locked_rect = *rect; /* for the render statistics */
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -2032,8 +3284,11 @@ void SDL_UnlockTexture(SDL_Texture *texture)
 #endif
         if (texture->native) {
         SDL_UnlockTextureNative(texture);
+    } else if (texture->shadowed) {
+        AddTextureShadowDirtyRect(texture, &texture->locked_rect);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        CountTextureUpload(texture, &texture->locked_rect);
         renderer->UnlockTexture(renderer, texture);
     }
 
@@ -2063,6 +3318,8 @@ static int SDL_SetRenderTargetInternal(SDL_Renderer *renderer, SDL_Texture *text
         return 0;
     }
 
+    CHECK_NOT_RECORDING(renderer, -1);
+
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
 
     SDL_LockMutex(renderer->target_mutex);
@@ -2096,6 +3353,11 @@ int SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     if (!texture && renderer->logical_target) {
         return SDL_SetRenderTargetInternal(renderer, renderer->logical_target);
+    } else if (!texture && renderer->logical_direct) {
+        if (SDL_SetRenderTargetInternal(renderer, NULL) < 0) {
+            return -1;
+        }
+        return SetRenderView(renderer, &renderer->logical_view);
     } else {
         return SDL_SetRenderTargetInternal(renderer, texture);
     }
@@ -2126,7 +3388,10 @@ static int UpdateLogicalPresentation(SDL_Renderer *renderer)
         return 0;
     }
 
-    if (SDL_QueryTexture(renderer->logical_target, NULL, NULL, &logical_w, &logical_h) < 0) {
+    if (renderer->logical_direct) {
+        logical_w = (int)renderer->logical_src_rect.w;
+        logical_h = (int)renderer->logical_src_rect.h;
+    } else if (SDL_QueryTexture(renderer->logical_target, NULL, NULL, &logical_w, &logical_h) < 0) {
         goto error;
     }
 
@@ -2201,6 +3466,31 @@ static int UpdateLogicalPresentation(SDL_Renderer *renderer)
         }
     }
 
+    if (renderer->logical_direct) {
+        SDL_RenderViewState *view = &renderer->logical_view;
+
+        /* Keep the app's render scale, on top of the new presentation scale */
+        view->scale.x /= renderer->logical_scale.x;
+        view->scale.y /= renderer->logical_scale.y;
+        renderer->logical_scale.x = renderer->logical_dst_rect.w / logical_w;
+        renderer->logical_scale.y = renderer->logical_dst_rect.h / logical_h;
+        view->scale.x *= renderer->logical_scale.x;
+        view->scale.y *= renderer->logical_scale.y;
+        view->pixel_w = (int)renderer->logical_dst_rect.w;
+        view->pixel_h = (int)renderer->logical_dst_rect.h;
+
+        if (!renderer->target) {
+            if (renderer->view == view) {
+                /* Move the viewport to where the presentation is now */
+                QueueCmdSetViewport(renderer);
+                QueueCmdSetClipRect(renderer);
+            } else {
+                SetRenderView(renderer, view);
+            }
+        }
+        return 0;
+    }
+
     SDL_SetTextureScaleMode(renderer->logical_target, renderer->logical_scale_mode);
 
     if (!renderer->target) {
@@ -2214,10 +3504,56 @@ error:
     return -1;
 }
 
+/* Drawing straight to the output looks like the texture would, unless the texture is filtered or overscanned */
+static SDL_bool CanPresentLogicalDirectly(SDL_RendererLogicalPresentation mode, SDL_ScaleMode scale_mode)
+{
+    if (!SDL_GetHintBoolean(SDL_HINT_RENDER_DIRECT_LOGICAL_PRESENTATION, SDL_FALSE)) {
+        return SDL_FALSE;
+    }
+    if (scale_mode != SDL_SCALEMODE_NEAREST) {
+        return SDL_FALSE;
+    }
+    return (mode == SDL_LOGICAL_PRESENTATION_STRETCH ||
+            mode == SDL_LOGICAL_PRESENTATION_LETTERBOX ||
+            mode == SDL_LOGICAL_PRESENTATION_INTEGER_SCALE);
+}
+
 int SDL_SetRenderLogicalPresentation(SDL_Renderer *renderer, int w, int h, SDL_RendererLogicalPresentation mode, SDL_ScaleMode scale_mode)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (mode != SDL_LOGICAL_PRESENTATION_DISABLED && CanPresentLogicalDirectly(mode, scale_mode)) {
+        if (w <= 0 || h <= 0) {
+            SDL_InvalidParamError("w");
+            goto error;
+        }
+        if (renderer->logical_target) {
+            SDL_DestroyTexture(renderer->logical_target);
+        }
+        if (!renderer->logical_direct) {
+            SDL_zero(renderer->logical_view);
+            renderer->logical_view.viewport.w = -1;
+            renderer->logical_view.viewport.h = -1;
+            renderer->logical_view.scale.x = 1.0f;
+            renderer->logical_view.scale.y = 1.0f;
+            renderer->logical_scale.x = 1.0f;
+            renderer->logical_scale.y = 1.0f;
+            renderer->logical_direct = SDL_TRUE;
+        }
+        renderer->logical_src_rect.w = (float)w;
+        renderer->logical_src_rect.h = (float)h;
+        renderer->logical_presentation_mode = mode;
+        renderer->logical_scale_mode = scale_mode;
+        return UpdateLogicalPresentation(renderer);
+    }
+
+    if (renderer->logical_direct) {
+        renderer->logical_direct = SDL_FALSE;
+        if (renderer->view == &renderer->logical_view) {
+            SetRenderView(renderer, &renderer->main_view);
+        }
+    }
+
     if (mode == SDL_LOGICAL_PRESENTATION_DISABLED) {
         if (renderer->logical_target) {
             SDL_DestroyTexture(renderer->logical_target);
@@ -2260,6 +3596,13 @@ int SDL_GetRenderLogicalPresentation(SDL_Renderer *renderer, int *w, int *h, SDL
         if (SDL_QueryTexture(renderer->logical_target, NULL, NULL, w, h) < 0) {
             return -1;
         }
+    } else if (renderer->logical_direct) {
+        if (w) {
+            *w = (int)renderer->logical_src_rect.w;
+        }
+        if (h) {
+            *h = (int)renderer->logical_src_rect.h;
+        }
     } else {
         if (w) {
             *w = 0;
@@ -2329,12 +3672,15 @@ static void SDL_RenderLogicalPresentation(SDL_Renderer *renderer)
     SDL_SetRenderClipRect(renderer, NULL);
     SDL_SetRenderScale(renderer, 1.0f, 1.0f);
     SDL_RenderLogicalBorders(renderer);
-    SDL_RenderTexture(renderer, renderer->logical_target, &renderer->logical_src_rect, &renderer->logical_dst_rect);
+    if (renderer->logical_target) {
+        SDL_RenderTexture(renderer, renderer->logical_target, &renderer->logical_src_rect, &renderer->logical_dst_rect);
+    }
 }
 
 int SDL_RenderCoordinatesFromWindow(SDL_Renderer *renderer, float window_x, float window_y, float *x, float *y)
 {
     SDL_RenderViewState *view;
+    SDL_FPoint scale;
     float render_x, render_y;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
@@ -2344,7 +3690,7 @@ int SDL_RenderCoordinatesFromWindow(SDL_Renderer *renderer, float window_x, floa
     render_y = window_y * renderer->dpi_scale.y;
 
     /* Convert from pixels within the window to pixels within the view */
-    if (renderer->logical_target) {
+    if (renderer->logical_target || renderer->logical_direct) {
         const SDL_FRect *src = &renderer->logical_src_rect;
         const SDL_FRect *dst = &renderer->logical_dst_rect;
         render_x = ((render_x - dst->x) * src->w) / dst->w;
@@ -2352,13 +3698,9 @@ int SDL_RenderCoordinatesFromWindow(SDL_Renderer *renderer, float window_x, floa
     }
 
     /* Convert from pixels within the view to render coordinates */
-    if (renderer->logical_target) {
-        view = &renderer->logical_target->view;
-    } else {
-        view = &renderer->main_view;
-    }
-    render_x = (render_x / view->scale.x) - view->viewport.x;
-    render_y = (render_y / view->scale.y) - view->viewport.y;
+    view = GetWindowView(renderer, &scale);
+    render_x = (render_x / scale.x) - view->viewport.x;
+    render_y = (render_y / scale.y) - view->viewport.y;
 
     if (x) {
         *x = render_x;
@@ -2372,20 +3714,17 @@ int SDL_RenderCoordinatesFromWindow(SDL_Renderer *renderer, float window_x, floa
 int SDL_RenderCoordinatesToWindow(SDL_Renderer *renderer, float x, float y, float *window_x, float *window_y)
 {
     SDL_RenderViewState *view;
+    SDL_FPoint scale;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
     /* Convert from render coordinates to pixels within the view */
-    if (renderer->logical_target) {
-        view = &renderer->logical_target->view;
-    } else {
-        view = &renderer->main_view;
-    }
-    x = (view->viewport.x + x) * view->scale.x;
-    y = (view->viewport.y + y) * view->scale.y;
+    view = GetWindowView(renderer, &scale);
+    x = (view->viewport.x + x) * scale.x;
+    y = (view->viewport.y + y) * scale.y;
 
     /* Convert from pixels within the view to pixels within the window */
-    if (renderer->logical_target) {
+    if (renderer->logical_target || renderer->logical_direct) {
         const SDL_FRect *src = &renderer->logical_src_rect;
         const SDL_FRect *dst = &renderer->logical_dst_rect;
         x = dst->x + ((x * dst->w) / src->w);
@@ -2415,48 +3754,40 @@ int SDL_ConvertEventToRenderCoordinates(SDL_Renderer *renderer, SDL_Event *event
             SDL_RenderCoordinatesFromWindow(renderer, event->motion.x, event->motion.y, &event->motion.x, &event->motion.y);
 
             if (event->motion.xrel != 0.0f) {
-                SDL_RenderViewState *view;
+                SDL_FPoint view_scale;
 
                 /* Convert from window coordinates to pixels within the window */
                 float scale = renderer->dpi_scale.x;
 
                 /* Convert from pixels within the window to pixels within the view */
-                if (renderer->logical_target) {
+                if (renderer->logical_target || renderer->logical_direct) {
                     const SDL_FRect *src = &renderer->logical_src_rect;
                     const SDL_FRect *dst = &renderer->logical_dst_rect;
                     scale = (scale * src->w) / dst->w;
                 }
 
                 /* Convert from pixels within the view to render coordinates */
-                if (renderer->logical_target) {
-                    view = &renderer->logical_target->view;
-                } else {
-                    view = &renderer->main_view;
-                }
-                scale = (scale / view->scale.x);
+                GetWindowView(renderer, &view_scale);
+                scale = (scale / view_scale.x);
 
                 event->motion.xrel *= scale;
             }
             if (event->motion.yrel != 0.0f) {
-                SDL_RenderViewState *view;
+                SDL_FPoint view_scale;
 
                 /* Convert from window coordinates to pixels within the window */
                 float scale = renderer->dpi_scale.y;
 
                 /* Convert from pixels within the window to pixels within the view */
-                if (renderer->logical_target) {
+                if (renderer->logical_target || renderer->logical_direct) {
                     const SDL_FRect *src = &renderer->logical_src_rect;
                     const SDL_FRect *dst = &renderer->logical_dst_rect;
                     scale = (scale * src->h) / dst->h;
                 }
 
                 /* Convert from pixels within the view to render coordinates */
-                if (renderer->logical_target) {
-                    view = &renderer->logical_target->view;
-                } else {
-                    view = &renderer->main_view;
-                }
-                scale = (scale / view->scale.y);
+                GetWindowView(renderer, &view_scale);
+                scale = (scale / view_scale.y);
 
                 event->motion.yrel *= scale;
             }
@@ -2585,13 +3916,18 @@ int SDL_SetRenderScale(SDL_Renderer *renderer, float scaleX, float scaleY)
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
-    if (renderer->view->scale.x == scaleX &&
+    if (renderer->view != &renderer->logical_view &&
+        renderer->view->scale.x == scaleX &&
         renderer->view->scale.y == scaleY) {
         return 0;
     }
 
     renderer->view->scale.x = scaleX;
     renderer->view->scale.y = scaleY;
+    if (renderer->view == &renderer->logical_view) {
+        renderer->view->scale.x *= renderer->logical_scale.x;
+        renderer->view->scale.y *= renderer->logical_scale.y;
+    }
 
     /* The scale affects the existing viewport and clip rectangle */
     retval += QueueCmdSetViewport(renderer);
@@ -2609,6 +3945,14 @@ int SDL_GetRenderScale(SDL_Renderer *renderer, float *scaleX, float *scaleY)
     if (scaleY) {
         *scaleY = renderer->view->scale.y;
     }
+    if (renderer->view == &renderer->logical_view) {
+        if (scaleX) {
+            *scaleX /= renderer->logical_scale.x;
+        }
+        if (scaleY) {
+            *scaleY /= renderer->logical_scale.y;
+        }
+    }
     return 0;
 }
 
@@ -2677,10 +4021,25 @@ int SDL_RenderPoint(SDL_Renderer *renderer, float x, float y)
     return SDL_RenderPoints(renderer, &fpoint, 1);
 }
 
+/* Returns the size to draw points or lines at with the current scale,
+   or 0 if the backend can't draw them that size and they need to be expanded into rects */
+static float GetNativePrimitiveSize(SDL_Renderer *renderer, const float max_size)
+{
+    const float scale = renderer->view->scale.x;
+
+    if (scale == 1.0f && renderer->view->scale.y == 1.0f) {
+        return 1.0f;
+    }
+    if (scale != renderer->view->scale.y || scale < 1.0f || scale > max_size) {
+        return 0.0f;
+    }
+    return scale;
+}
+
 static int RenderPointsWithRects(SDL_Renderer *renderer, const SDL_FPoint *fpoints, const int count)
 {
     int retval;
-    SDL_bool isstack;
+    size_t mark;
     SDL_FRect *frects;
     int i;
 
@@ -2688,7 +4047,8 @@ static int RenderPointsWithRects(SDL_Renderer *renderer, const SDL_FPoint *fpoin
         return 0;
     }
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    mark = SDL_scratch_mark();
+    frects = SDL_scratch_alloc(SDL_FRect, count);
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -2702,13 +4062,14 @@ static int RenderPointsWithRects(SDL_Renderer *renderer, const SDL_FPoint *fpoin
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    SDL_scratch_free(mark);
 
     return retval;
 }
 
 int SDL_RenderPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
 {
+    float size;
     int retval;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
@@ -2727,10 +4088,11 @@ int SDL_RenderPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count
     }
 #endif
 
-    if (renderer->view->scale.x != 1.0f || renderer->view->scale.y != 1.0f) {
-        retval = RenderPointsWithRects(renderer, points, count);
+    size = GetNativePrimitiveSize(renderer, renderer->max_point_size);
+    if (size > 0.0f) {
+        retval = QueueCmdDrawPoints(renderer, points, count, size);
     } else {
-        retval = QueueCmdDrawPoints(renderer, points, count);
+        retval = RenderPointsWithRects(renderer, points, count);
     }
     return retval;
 }
@@ -2752,8 +4114,9 @@ static int RenderLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x2, i
     int d, dinc1, dinc2;
     int x, xinc1, xinc2;
     int y, yinc1, yinc2;
+    float size;
     int retval;
-    SDL_bool isstack;
+    size_t mark;
     SDL_FPoint *points;
     SDL_Rect viewport;
 
@@ -2808,7 +4171,8 @@ static int RenderLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x2, i
         return SDL_SetError("Line too long (tried to draw %d pixels, max %d)", numpixels, MAX_PIXELS);
     }
 
-    points = SDL_small_alloc(SDL_FPoint, numpixels, &isstack);
+    mark = SDL_scratch_mark();
+    points = SDL_scratch_alloc(SDL_FPoint, numpixels);
     if (!points) {
         return SDL_OutOfMemory();
     }
@@ -2827,13 +4191,14 @@ static int RenderLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x2, i
         }
     }
 
-    if (renderer->view->scale.x != 1.0f || renderer->view->scale.y != 1.0f) {
-        retval = RenderPointsWithRects(renderer, points, numpixels);
+    size = GetNativePrimitiveSize(renderer, renderer->max_point_size);
+    if (size > 0.0f) {
+        retval = QueueCmdDrawPoints(renderer, points, numpixels, size);
     } else {
-        retval = QueueCmdDrawPoints(renderer, points, numpixels);
+        retval = RenderPointsWithRects(renderer, points, numpixels);
     }
 
-    SDL_small_free(points, isstack);
+    SDL_scratch_free(mark);
 
     return retval;
 }
@@ -2847,11 +4212,12 @@ static int RenderLinesWithRectsF(SDL_Renderer *renderer,
     SDL_FRect *frects;
     int i, nrects = 0;
     int retval = 0;
-    SDL_bool isstack;
+    size_t mark;
     SDL_bool drew_line = SDL_FALSE;
     SDL_bool draw_last = SDL_FALSE;
 
-    frects = SDL_small_alloc(SDL_FRect, count - 1, &isstack);
+    mark = SDL_scratch_mark();
+    frects = SDL_scratch_alloc(SDL_FRect, count - 1);
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -2904,7 +4270,7 @@ static int RenderLinesWithRectsF(SDL_Renderer *renderer,
         retval += QueueCmdFillRects(renderer, frects, nrects);
     }
 
-    SDL_small_free(frects, isstack);
+    SDL_scratch_free(mark);
 
     if (retval < 0) {
         retval = -1;
@@ -2935,13 +4301,12 @@ int SDL_RenderLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
     if (renderer->line_method == SDL_RENDERLINEMETHOD_POINTS) {
         retval = RenderLinesWithRectsF(renderer, points, count);
     } else if (renderer->line_method == SDL_RENDERLINEMETHOD_GEOMETRY) {
-        SDL_bool isstack1;
-        SDL_bool isstack2;
+        const size_t mark = SDL_scratch_mark();
         const float scale_x = renderer->view->scale.x;
         const float scale_y = renderer->view->scale.y;
-        float *xy = SDL_small_alloc(float, 4 * 2 * count, &isstack1);
-        int *indices = SDL_small_alloc(int,
-                                       (4) * 3 * (count - 1) + (2) * 3 * (count), &isstack2);
+        float *xy = SDL_scratch_alloc(float, 4 * 2 * count);
+        int *indices = SDL_scratch_alloc(int,
+                                         (4) * 3 * (count - 1) + (2) * 3 * (count));
 
         if (xy && indices) {
             int i;
@@ -3051,13 +4416,15 @@ int SDL_RenderLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
                                       1.0f, 1.0f);
         }
 
-        SDL_small_free(xy, isstack1);
-        SDL_small_free(indices, isstack2);
+        SDL_scratch_free(mark);
 
-    } else if (renderer->view->scale.x != 1.0f || renderer->view->scale.y != 1.0f) {
-        retval = RenderLinesWithRectsF(renderer, points, count);
     } else {
-        retval = QueueCmdDrawLines(renderer, points, count);
+        const float size = GetNativePrimitiveSize(renderer, renderer->max_line_width);
+        if (size > 0.0f) {
+            retval = QueueCmdDrawLines(renderer, points, count, size);
+        } else {
+            retval = RenderLinesWithRectsF(renderer, points, count);
+        }
     }
 
     return retval;
@@ -3136,7 +4503,7 @@ int SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int coun
     SDL_FRect *frects;
     int i;
     int retval;
-    SDL_bool isstack;
+    size_t mark;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -3154,7 +4521,8 @@ int SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int coun
     }
 #endif
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    mark = SDL_scratch_mark();
+    frects = SDL_scratch_alloc(SDL_FRect, count);
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -3167,7 +4535,7 @@ int SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int coun
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    SDL_scratch_free(mark);
 
     return retval;
 }
@@ -3185,6 +4553,9 @@ int SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FR
     if (renderer != texture->renderer) {
         return SDL_SetError("Texture was not created with this renderer");
     }
+    if (texture->shadowed && UploadTextureShadow(texture) < 0) {
+        return -1;
+    }
 
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't draw while we're hidden */
@@ -3217,6 +4588,12 @@ int SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FR
         texture = texture->native;
     }
 
+    if (texture->atlas_page) {
+        real_srcrect.x += texture->atlas_rect.x;
+        real_srcrect.y += texture->atlas_rect.y;
+        texture = GetAtlasPageTexture(texture);
+    }
+
     texture->last_command_generation = renderer->render_command_generation;
 
     if (use_rendergeometry) {
@@ -3297,6 +4674,9 @@ int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
     if (renderer != texture->renderer) {
         return SDL_SetError("Texture was not created with this renderer");
     }
+    if (texture->shadowed && UploadTextureShadow(texture) < 0) {
+        return -1;
+    }
     if (!renderer->QueueCopyEx && !renderer->QueueGeometry) {
         return SDL_SetError("Renderer does not support RenderCopyEx");
     }
@@ -3331,6 +4711,12 @@ int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
         texture = texture->native;
     }
 
+    if (texture->atlas_page) {
+        real_srcrect.x += texture->atlas_rect.x;
+        real_srcrect.y += texture->atlas_rect.y;
+        texture = GetAtlasPageTexture(texture);
+    }
+
     if (center) {
         real_center = *center;
     } else {
@@ -3357,8 +4743,9 @@ int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
         float c_minx, c_miny, c_maxx, c_maxy;
 
         const float radian_angle = (float)((SDL_PI_D * angle) / 180.0);
-        const float s = SDL_sinf(radian_angle);
-        const float c = SDL_cosf(radian_angle);
+        float s, c;
+
+        SDL_sincosf(radian_angle, &s, &c);
 
         minu = real_srcrect.x / texture->w;
         minv = real_srcrect.y / texture->h;
@@ -3432,6 +4819,119 @@ int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval;
 }
 
+int SDL_RenderTextureInstanced(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int num_instances)
+{
+    SDL_RenderInstance *quads;
+    float *xy;
+    float *uv;
+    SDL_Color *colors;
+    int *indices;
+    void *buffer;
+    size_t buffer_size;
+    int i, num_quads;
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (texture->shadowed && UploadTextureShadow(texture) < 0) {
+        return -1;
+    }
+    if (!instances) {
+        return SDL_InvalidParamError("instances");
+    }
+    if (num_instances < 0 || num_instances > (SDL_MAX_SINT32 / 6)) {
+        return SDL_InvalidParamError("num_instances");
+    }
+    if (num_instances == 0) {
+        return 0;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    if (renderer->QueueInstances) {
+        /* The backend draws one quad per instance with hardware instancing */
+        return QueueCmdInstances(renderer, texture, instances, num_instances,
+                                 renderer->view->scale.x,
+                                 renderer->view->scale.y);
+    }
+
+    /* Otherwise build them all into a single batch of quads */
+    buffer_size = (size_t)num_instances * (sizeof(SDL_RenderInstance) + 8 * sizeof(float) + 8 * sizeof(float) + 4 * sizeof(SDL_Color) + 6 * sizeof(int));
+    buffer = SDL_malloc(buffer_size);
+    if (!buffer) {
+        return SDL_OutOfMemory();
+    }
+    quads = (SDL_RenderInstance *)buffer;
+    xy = (float *)(quads + num_instances);
+    uv = xy + num_instances * 8;
+    colors = (SDL_Color *)(uv + num_instances * 8);
+    indices = (int *)(colors + num_instances * 4);
+
+    /* SDL_RenderGeometryRaw() scales them and maps them into the texture's atlas page */
+    num_quads = GetRenderInstances(texture, instances, num_instances, 1.0f, 1.0f, SDL_FALSE, quads);
+
+    for (i = 0; i < num_quads; ++i) {
+        const SDL_RenderInstance *quad = &quads[i];
+        float *quad_xy = &xy[i * 8];
+        float *quad_uv = &uv[i * 8];
+        SDL_Color *quad_colors = &colors[i * 4];
+        int *quad_indices = &indices[i * 6];
+        int j;
+
+        quad_xy[0] = quad->origin.x;
+        quad_xy[1] = quad->origin.y;
+        quad_xy[2] = quad->origin.x + quad->axis_x.x;
+        quad_xy[3] = quad->origin.y + quad->axis_x.y;
+        quad_xy[4] = quad->origin.x + quad->axis_x.x + quad->axis_y.x;
+        quad_xy[5] = quad->origin.y + quad->axis_x.y + quad->axis_y.y;
+        quad_xy[6] = quad->origin.x + quad->axis_y.x;
+        quad_xy[7] = quad->origin.y + quad->axis_y.y;
+
+        quad_uv[0] = quad->uv[0];
+        quad_uv[1] = quad->uv[1];
+        quad_uv[2] = quad->uv[2];
+        quad_uv[3] = quad->uv[1];
+        quad_uv[4] = quad->uv[2];
+        quad_uv[5] = quad->uv[3];
+        quad_uv[6] = quad->uv[0];
+        quad_uv[7] = quad->uv[3];
+
+        for (j = 0; j < 4; ++j) {
+            quad_colors[j] = quad->color;
+        }
+
+        for (j = 0; j < 6; ++j) {
+            quad_indices[j] = i * 4 + renderer->rect_index_order[j];
+        }
+    }
+
+    if (num_quads > 0) {
+        retval = SDL_RenderGeometryRaw(renderer, texture,
+                                       xy, 2 * sizeof(float),
+                                       colors, sizeof(SDL_Color),
+                                       uv, 2 * sizeof(float),
+                                       num_quads * 4,
+                                       indices, num_quads * 6, sizeof(int));
+    } else {
+        retval = 0;
+    }
+    SDL_free(buffer);
+    return retval;
+}
+
 int SDL_RenderGeometry(SDL_Renderer *renderer,
                        SDL_Texture *texture,
                        const SDL_Vertex *vertices, int num_vertices,
@@ -3829,6 +5329,8 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
     int i;
     int retval = 0;
     int count = indices ? num_indices : num_vertices;
+    float *atlas_uv = NULL;
+    size_t atlas_uv_mark = 0;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -3842,6 +5344,9 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         if (renderer != texture->renderer) {
             return SDL_SetError("Texture was not created with this renderer");
         }
+        if (texture->shadowed && UploadTextureShadow(texture) < 0) {
+            return -1;
+        }
     }
 
     if (!xy) {
@@ -3910,43 +5415,632 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         }
     }
 
+    if (texture && texture->atlas_page) {
+        /* Remap the texture coordinates into the atlas page */
+        const float scale_u = (float)texture->w / texture->atlas_page->texture->w;
+        const float scale_v = (float)texture->h / texture->atlas_page->texture->h;
+        const float offset_u = (float)texture->atlas_rect.x / texture->atlas_page->texture->w;
+        const float offset_v = (float)texture->atlas_rect.y / texture->atlas_page->texture->h;
+
+        atlas_uv_mark = SDL_scratch_mark();
+        atlas_uv = SDL_scratch_alloc(float, num_vertices * 2);
+        if (!atlas_uv) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            const float *uv_ = (const float *)((const char *)uv + i * uv_stride);
+            atlas_uv[i * 2 + 0] = offset_u + uv_[0] * scale_u;
+            atlas_uv[i * 2 + 1] = offset_v + uv_[1] * scale_v;
+        }
+        uv = atlas_uv;
+        uv_stride = 2 * sizeof(float);
+        texture = GetAtlasPageTexture(texture);
+    }
+
     if (texture) {
         texture->last_command_generation = renderer->render_command_generation;
     }
 
-    /* For the software renderer, try to reinterpret triangles as SDL_Rect */
     if (renderer->info.flags & SDL_RENDERER_SOFTWARE) {
-        return SDL_SW_RenderGeometryRaw(renderer, texture,
-                                        xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
-                                        indices, num_indices, size_indices);
+        /* For the software renderer, try to reinterpret triangles as SDL_Rect */
+        retval = SDL_SW_RenderGeometryRaw(renderer, texture,
+                                          xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
+                                          indices, num_indices, size_indices);
+    } else {
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, color, color_stride, uv, uv_stride,
+                                  num_vertices,
+                                  indices, num_indices, size_indices,
+                                  renderer->view->scale.x,
+                                  renderer->view->scale.y);
     }
 
-    retval = QueueCmdGeometry(renderer, texture,
-                              xy, xy_stride, color, color_stride, uv, uv_stride,
-                              num_vertices,
-                              indices, num_indices, size_indices,
-                              renderer->view->scale.x,
-                              renderer->view->scale.y);
-
+    if (atlas_uv) {
+        SDL_scratch_free(atlas_uv_mark);
+    }
     return retval;
 }
 
-int SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format, void *pixels, int pitch)
+int SDL_BeginRenderCommandList(SDL_Renderer *renderer)
 {
-    SDL_Rect real_rect;
-
     CHECK_RENDERER_MAGIC(renderer, -1);
 
-    if (!renderer->RenderReadPixels) {
+    if (renderer->command_lists_unsupported) {
         return SDL_Unsupported();
     }
+    if (renderer->recording_commands) {
+        return SDL_SetError("Already recording a render command list");
+    }
 
-    FlushRenderCommands(renderer); /* we need to render before we read the results. */
+    /* Start with an empty queue, so offsets in the list are relative to the start of the vertex data */
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
 
-    if (!format) {
-        if (!renderer->target) {
-            format = SDL_GetWindowPixelFormat(renderer->window);
-        } else {
+    renderer->recording_commands = SDL_TRUE;
+    renderer->recording_failed = SDL_FALSE;
+    return 0;
+}
+
+SDL_RenderCommandList *SDL_EndRenderCommandList(SDL_Renderer *renderer)
+{
+    SDL_RenderCommandList *list = NULL;
+    SDL_RenderCommand *cmd;
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->recording_commands && !renderer->recording_failed) {
+        SDL_SetError("Not recording a render command list");
+        return NULL;
+    }
+
+    if (renderer->recording_failed) {
+        SDL_SetError("Render command list recording was interrupted");
+    } else {
+        list = (SDL_RenderCommandList *)SDL_calloc(1, sizeof(*list));
+        if (list) {
+            for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+                ++list->num_commands;
+            }
+            if (list->num_commands > 0) {
+                list->commands = (SDL_RenderCommand *)SDL_malloc(list->num_commands * sizeof(*list->commands));
+            }
+            if (renderer->vertex_data_used > 0) {
+                list->vertex_data = SDL_malloc(renderer->vertex_data_used);
+            }
+            if ((list->num_commands > 0 && !list->commands) ||
+                (renderer->vertex_data_used > 0 && !list->vertex_data)) {
+                SDL_free(list->commands);
+                SDL_free(list->vertex_data);
+                SDL_free(list);
+                list = NULL;
+            }
+        }
+
+        if (list) {
+            for (cmd = renderer->render_commands, i = 0; cmd; cmd = cmd->next, ++i) {
+                SDL_copyp(&list->commands[i], cmd);
+                list->commands[i].next = NULL;
+            }
+            if (renderer->vertex_data_used > 0) {
+                SDL_memcpy(list->vertex_data, renderer->vertex_data, renderer->vertex_data_used);
+            }
+            list->vertex_data_used = renderer->vertex_data_used;
+            list->renderer = renderer;
+            list->magic = &SDL_render_command_list_magic;
+            list->next = renderer->command_lists;
+            if (renderer->command_lists) {
+                renderer->command_lists->prev = list;
+            }
+            renderer->command_lists = list;
+        } else {
+            SDL_OutOfMemory();
+        }
+    }
+
+    /* The recorded commands are never run directly */
+    ResetRenderCommands(renderer);
+    renderer->recording_commands = SDL_FALSE;
+    renderer->recording_failed = SDL_FALSE;
+
+    return list;
+}
+
+int SDL_ReplayRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list, float x, float y)
+{
+    size_t first = 0;
+    int dx, dy;
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_COMMAND_LIST_MAGIC(list, -1);
+
+    if (list->renderer != renderer) {
+        return SDL_SetError("Command list was not recorded with this renderer");
+    }
+    if (list->invalid) {
+        return SDL_SetError("Command list uses a texture that has been destroyed");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    /* Bring back any evicted textures before the commands using them are queued */
+    for (i = 0; i < list->num_commands; ++i) {
+        const SDL_RenderCommand *src = &list->commands[i];
+
+        switch (src->command) {
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+        case SDL_RENDERCMD_DRAW_INSTANCES:
+            if (src->data.draw.texture && UseTexture(src->data.draw.texture) < 0) {
+                return -1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (list->vertex_data_used > 0) {
+        void *verts = SDL_AllocateRenderVertices(renderer, list->vertex_data_used, COMMAND_LIST_VERTEX_ALIGNMENT, &first);
+        if (!verts) {
+            return -1;
+        }
+        SDL_memcpy(verts, list->vertex_data, list->vertex_data_used);
+    }
+
+    dx = (int)SDL_roundf(x * renderer->view->scale.x);
+    dy = (int)SDL_roundf(y * renderer->view->scale.y);
+
+    for (i = 0; i < list->num_commands; ++i) {
+        const SDL_RenderCommand *src = &list->commands[i];
+        SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
+        if (!cmd) {
+            return -1;
+        }
+
+        cmd->command = src->command;
+        SDL_copyp(&cmd->data, &src->data);
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+            cmd->data.viewport.first += first;
+            cmd->data.viewport.rect.x += dx;
+            cmd->data.viewport.rect.y += dy;
+            break;
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        case SDL_RENDERCMD_CLEAR:
+            cmd->data.color.first += first;
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+        case SDL_RENDERCMD_DRAW_INSTANCES:
+            cmd->data.draw.first += first;
+            if (cmd->data.draw.texture) {
+                cmd->data.draw.texture->last_command_generation = renderer->render_command_generation;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* The list left its own state in the queue, make sure the next draw sets ours again */
+    renderer->color_queued = SDL_FALSE;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+
+    return 0;
+}
+
+void SDL_DestroyRenderCommandList(SDL_RenderCommandList *list)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_COMMAND_LIST_MAGIC(list,);
+
+    renderer = list->renderer;
+    if (list->next) {
+        list->next->prev = list->prev;
+    }
+    if (list->prev) {
+        list->prev->next = list->next;
+    } else {
+        renderer->command_lists = list->next;
+    }
+
+    list->magic = NULL;
+    SDL_free(list->commands);
+    SDL_free(list->vertex_data);
+    SDL_free(list);
+}
+
+typedef enum
+{
+    SDL_RENDERRECORD_DRAW_COLOR,
+    SDL_RENDERRECORD_DRAW_BLEND_MODE,
+    SDL_RENDERRECORD_FILL_RECTS,
+    SDL_RENDERRECORD_TEXTURE,
+    SDL_RENDERRECORD_GEOMETRY
+} SDL_RenderRecordType;
+
+typedef struct SDL_RenderRecordHeader
+{
+    Uint32 type;
+    Uint32 size; /* the size of the record, including this header */
+} SDL_RenderRecordHeader;
+
+typedef struct SDL_RenderRecordTexture
+{
+    SDL_Texture *texture;
+    SDL_bool has_srcrect;
+    SDL_bool has_dstrect;
+    SDL_FRect srcrect;
+    SDL_FRect dstrect;
+} SDL_RenderRecordTexture;
+
+typedef struct SDL_RenderRecordGeometry
+{
+    SDL_Texture *texture;
+    int num_vertices;
+    int num_indices;
+} SDL_RenderRecordGeometry;
+
+#define RENDER_RECORD_ALIGN(size) (((size) + 7) & ~((size_t)7))
+
+static void *AddRenderRecord(SDL_RenderRecorder *recorder, SDL_RenderRecordType type, size_t size)
+{
+    SDL_RenderRecordHeader *header;
+    const size_t needed = RENDER_RECORD_ALIGN(sizeof(*header)) + RENDER_RECORD_ALIGN(size);
+
+    if (needed > SDL_MAX_UINT32) {
+        SDL_SetError("Recorded operation is too large");
+        return NULL;
+    }
+    if (recorder->size + needed > recorder->allocated) {
+        size_t newsize = recorder->allocated ? recorder->allocated * 2 : 1024;
+        Uint8 *data;
+
+        while (newsize < recorder->size + needed) {
+            newsize *= 2;
+        }
+        data = (Uint8 *)SDL_realloc(recorder->data, newsize);
+        if (!data) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        recorder->data = data;
+        recorder->allocated = newsize;
+    }
+
+    header = (SDL_RenderRecordHeader *)(recorder->data + recorder->size);
+    header->type = (Uint32)type;
+    header->size = (Uint32)needed;
+    recorder->size += needed;
+    return (Uint8 *)header + RENDER_RECORD_ALIGN(sizeof(*header));
+}
+
+SDL_RenderRecorder *SDL_CreateRenderRecorder(SDL_Renderer *renderer)
+{
+    SDL_RenderRecorder *recorder;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    recorder = (SDL_RenderRecorder *)SDL_calloc(1, sizeof(*recorder));
+    if (!recorder) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    recorder->magic = &SDL_render_recorder_magic;
+    recorder->renderer = renderer;
+    return recorder;
+}
+
+int SDL_RecordRenderDrawColor(SDL_RenderRecorder *recorder, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_Color *color;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+
+    color = (SDL_Color *)AddRenderRecord(recorder, SDL_RENDERRECORD_DRAW_COLOR, sizeof(*color));
+    if (!color) {
+        return -1;
+    }
+    color->r = r;
+    color->g = g;
+    color->b = b;
+    color->a = a;
+    return 0;
+}
+
+int SDL_RecordRenderDrawBlendMode(SDL_RenderRecorder *recorder, SDL_BlendMode blendMode)
+{
+    SDL_BlendMode *mode;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+
+    mode = (SDL_BlendMode *)AddRenderRecord(recorder, SDL_RENDERRECORD_DRAW_BLEND_MODE, sizeof(*mode));
+    if (!mode) {
+        return -1;
+    }
+    *mode = blendMode;
+    return 0;
+}
+
+int SDL_RecordRenderFillRects(SDL_RenderRecorder *recorder, const SDL_FRect *rects, int count)
+{
+    int *data;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    data = (int *)AddRenderRecord(recorder, SDL_RENDERRECORD_FILL_RECTS, RENDER_RECORD_ALIGN(sizeof(int)) + count * sizeof(*rects));
+    if (!data) {
+        return -1;
+    }
+    *data = count;
+    SDL_memcpy((Uint8 *)data + RENDER_RECORD_ALIGN(sizeof(int)), rects, count * sizeof(*rects));
+    return 0;
+}
+
+int SDL_RecordRenderTexture(SDL_RenderRecorder *recorder, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_RenderRecordTexture *data;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (recorder->renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+
+    data = (SDL_RenderRecordTexture *)AddRenderRecord(recorder, SDL_RENDERRECORD_TEXTURE, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+    SDL_zerop(data);
+    data->texture = texture;
+    if (srcrect) {
+        data->has_srcrect = SDL_TRUE;
+        data->srcrect = *srcrect;
+    }
+    if (dstrect) {
+        data->has_dstrect = SDL_TRUE;
+        data->dstrect = *dstrect;
+    }
+    return 0;
+}
+
+int SDL_RecordRenderGeometry(SDL_RenderRecorder *recorder, SDL_Texture *texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices)
+{
+    SDL_RenderRecordGeometry *data;
+    const size_t vertices_offset = RENDER_RECORD_ALIGN(sizeof(*data));
+    size_t indices_offset;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (recorder->renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (!indices || num_indices < 0) {
+        num_indices = 0;
+    }
+
+    indices_offset = vertices_offset + RENDER_RECORD_ALIGN(num_vertices * sizeof(*vertices));
+    data = (SDL_RenderRecordGeometry *)AddRenderRecord(recorder, SDL_RENDERRECORD_GEOMETRY, indices_offset + num_indices * sizeof(*indices));
+    if (!data) {
+        return -1;
+    }
+    data->texture = texture;
+    data->num_vertices = num_vertices;
+    data->num_indices = num_indices;
+    SDL_memcpy((Uint8 *)data + vertices_offset, vertices, num_vertices * sizeof(*vertices));
+    if (num_indices > 0) {
+        SDL_memcpy((Uint8 *)data + indices_offset, indices, num_indices * sizeof(*indices));
+    }
+    return 0;
+}
+
+int SDL_SubmitRenderRecorder(SDL_RenderRecorder *recorder)
+{
+    SDL_Renderer *renderer;
+    SDL_RenderRecording *recording;
+
+    CHECK_RECORDER_MAGIC(recorder, -1);
+
+    renderer = recorder->renderer;
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (recorder->size == 0) {
+        return 0; /* nothing to do. */
+    }
+
+    recording = (SDL_RenderRecording *)SDL_malloc(sizeof(*recording));
+    if (!recording) {
+        return SDL_OutOfMemory();
+    }
+
+    /* Hand the recorded data over to the renderer, the recorder starts over */
+    recording->data = recorder->data;
+    recording->size = recorder->size;
+    recording->next = NULL;
+    recorder->data = NULL;
+    recorder->size = 0;
+    recorder->allocated = 0;
+
+    SDL_LockMutex(renderer->recordings_lock);
+    if (renderer->recordings_tail) {
+        renderer->recordings_tail->next = recording;
+    } else {
+        renderer->recordings = recording;
+    }
+    renderer->recordings_tail = recording;
+    SDL_UnlockMutex(renderer->recordings_lock);
+
+    return 0;
+}
+
+void SDL_DestroyRenderRecorder(SDL_RenderRecorder *recorder)
+{
+    CHECK_RECORDER_MAGIC(recorder,);
+
+    recorder->magic = NULL;
+    SDL_free(recorder->data);
+    SDL_free(recorder);
+}
+
+static void ReplayRenderRecording(SDL_Renderer *renderer, const SDL_RenderRecording *recording)
+{
+    size_t offset = 0;
+
+    while (offset < recording->size) {
+        const SDL_RenderRecordHeader *header = (const SDL_RenderRecordHeader *)(recording->data + offset);
+        const Uint8 *data = (const Uint8 *)header + RENDER_RECORD_ALIGN(sizeof(*header));
+
+        switch (header->type) {
+        case SDL_RENDERRECORD_DRAW_COLOR:
+        {
+            const SDL_Color *color = (const SDL_Color *)data;
+            SDL_SetRenderDrawColor(renderer, color->r, color->g, color->b, color->a);
+            break;
+        }
+        case SDL_RENDERRECORD_DRAW_BLEND_MODE:
+            SDL_SetRenderDrawBlendMode(renderer, *(const SDL_BlendMode *)data);
+            break;
+        case SDL_RENDERRECORD_FILL_RECTS:
+        {
+            const int count = *(const int *)data;
+            SDL_RenderFillRects(renderer, (const SDL_FRect *)(data + RENDER_RECORD_ALIGN(sizeof(int))), count);
+            break;
+        }
+        case SDL_RENDERRECORD_TEXTURE:
+        {
+            const SDL_RenderRecordTexture *copy = (const SDL_RenderRecordTexture *)data;
+            SDL_RenderTexture(renderer, copy->texture,
+                              copy->has_srcrect ? &copy->srcrect : NULL,
+                              copy->has_dstrect ? &copy->dstrect : NULL);
+            break;
+        }
+        case SDL_RENDERRECORD_GEOMETRY:
+        {
+            const SDL_RenderRecordGeometry *geometry = (const SDL_RenderRecordGeometry *)data;
+            const size_t vertices_offset = RENDER_RECORD_ALIGN(sizeof(*geometry));
+            const size_t indices_offset = vertices_offset + RENDER_RECORD_ALIGN(geometry->num_vertices * sizeof(SDL_Vertex));
+            SDL_RenderGeometry(renderer, geometry->texture,
+                               (const SDL_Vertex *)(data + vertices_offset), geometry->num_vertices,
+                               geometry->num_indices ? (const int *)(data + indices_offset) : NULL, geometry->num_indices);
+            break;
+        }
+        default:
+            SDL_assert(!"Unknown render record type");
+            break;
+        }
+        offset += header->size;
+    }
+}
+
+static void ReplayRenderRecordings(SDL_Renderer *renderer)
+{
+    SDL_RenderRecording *recording;
+    Uint8 r = 0, g = 0, b = 0, a = 0;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+
+    SDL_LockMutex(renderer->recordings_lock);
+    recording = renderer->recordings;
+    renderer->recordings = NULL;
+    renderer->recordings_tail = NULL;
+    SDL_UnlockMutex(renderer->recordings_lock);
+
+    if (!recording) {
+        return; /* nothing to do. */
+    }
+
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+    while (recording) {
+        SDL_RenderRecording *next = recording->next;
+        ReplayRenderRecording(renderer, recording);
+        SDL_free(recording->data);
+        SDL_free(recording);
+        recording = next;
+    }
+
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+}
+
+static void DiscardRenderRecordings(SDL_Renderer *renderer)
+{
+    while (renderer->recordings) {
+        SDL_RenderRecording *next = renderer->recordings->next;
+        SDL_free(renderer->recordings->data);
+        SDL_free(renderer->recordings);
+        renderer->recordings = next;
+    }
+    renderer->recordings_tail = NULL;
+}
+
+static void InvalidateRenderCommandLists(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderCommandList *list;
+    int i;
+
+    for (list = renderer->command_lists; list; list = list->next) {
+        for (i = 0; !list->invalid && i < list->num_commands; ++i) {
+            const SDL_RenderCommand *cmd = &list->commands[i];
+            if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS && cmd->data.draw.texture == texture) {
+                list->invalid = SDL_TRUE;
+            }
+        }
+    }
+}
+
+int SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format, void *pixels, int pitch)
+{
+    SDL_Rect real_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->RenderReadPixels) {
+        return SDL_Unsupported();
+    }
+
+    CHECK_NOT_RECORDING(renderer, -1);
+
+    FlushRenderCommands(renderer); /* we need to render before we read the results. */
+
+    if (!format) {
+        if (!renderer->target) {
+            format = SDL_GetWindowPixelFormat(renderer->window);
+        } else {
             format = renderer->target->format;
         }
     }
@@ -3970,7 +6064,166 @@ int SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 fo
                                       format, pixels, pitch);
 }
 
-static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
+Uint64 SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format)
+{
+    SDL_RenderReadback *readback;
+    SDL_RenderReadback *tail;
+    SDL_Rect real_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, 0);
+
+    if (!renderer->RenderReadPixels) {
+        SDL_Unsupported();
+        return 0;
+    }
+
+    CHECK_NOT_RECORDING(renderer, 0);
+
+    if (FlushRenderCommands(renderer) < 0) { /* we need to render before we read the results. */
+        return 0;
+    }
+
+    if (!format) {
+        if (!renderer->target) {
+            format = SDL_GetWindowPixelFormat(renderer->window);
+        } else {
+            format = renderer->target->format;
+        }
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_SetError("Asynchronous reads don't support YUV formats");
+        return 0;
+    }
+
+    readback = (SDL_RenderReadback *)SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        return 0;
+    }
+    readback->format = format;
+
+    GetRenderViewportInPixels(renderer, &real_rect);
+
+    if (rect) {
+        if (SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
+            readback->offset.x = real_rect.x - rect->x;
+            readback->offset.y = real_rect.y - rect->y;
+        } else {
+            SDL_zero(real_rect); /* nothing to read, the ticket completes right away */
+        }
+    }
+    readback->rect = real_rect;
+
+    if (real_rect.w > 0 && real_rect.h > 0) {
+        if (renderer->QueueReadPixels) {
+            if (renderer->QueueReadPixels(renderer, readback) < 0) {
+                SDL_free(readback);
+                return 0;
+            }
+        } else {
+            readback->pitch = real_rect.w * SDL_BYTESPERPIXEL(format);
+            readback->pixels = SDL_malloc((size_t)real_rect.h * readback->pitch);
+            if (!readback->pixels ||
+                renderer->RenderReadPixels(renderer, &real_rect, format, readback->pixels, readback->pitch) < 0) {
+                SDL_free(readback->pixels);
+                SDL_free(readback);
+                return 0;
+            }
+        }
+    }
+
+    readback->ticket = ++renderer->readback_ticket;
+    if (renderer->readbacks) {
+        tail = renderer->readbacks;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        tail->next = readback;
+    } else {
+        renderer->readbacks = readback;
+    }
+    return readback->ticket;
+}
+
+static SDL_RenderReadback *FindRenderReadback(SDL_Renderer *renderer, Uint64 ticket, SDL_RenderReadback **prev)
+{
+    SDL_RenderReadback *readback;
+
+    *prev = NULL;
+    for (readback = renderer->readbacks; readback; readback = readback->next) {
+        if (readback->ticket == ticket) {
+            return readback;
+        }
+        *prev = readback;
+    }
+    return NULL;
+}
+
+static int FinishRenderReadback(SDL_Renderer *renderer, SDL_RenderReadback *readback, void *pixels, int pitch)
+{
+    int retval = 0;
+
+    if (readback->rect.w > 0 && readback->rect.h > 0) {
+        if (pixels) {
+            pixels = (Uint8 *)pixels + pitch * readback->offset.y + SDL_BYTESPERPIXEL(readback->format) * readback->offset.x;
+        }
+        if (readback->pixels) {
+            if (pixels) {
+                retval = SDL_ConvertPixels(readback->rect.w, readback->rect.h,
+                                           readback->format, readback->pixels, readback->pitch,
+                                           readback->format, pixels, pitch);
+            }
+            SDL_free(readback->pixels);
+        } else {
+            retval = renderer->FinishReadPixels(renderer, readback, pixels, pitch);
+        }
+    }
+    SDL_free(readback);
+    return retval;
+}
+
+SDL_bool SDL_IsRenderReadPixelsComplete(SDL_Renderer *renderer, Uint64 ticket)
+{
+    SDL_RenderReadback *readback;
+    SDL_RenderReadback *prev;
+
+    CHECK_RENDERER_MAGIC(renderer, SDL_FALSE);
+
+    readback = FindRenderReadback(renderer, ticket, &prev);
+    if (!readback) {
+        SDL_InvalidParamError("ticket");
+        return SDL_FALSE;
+    }
+
+    if (readback->pixels || readback->rect.w == 0 || readback->rect.h == 0) {
+        return SDL_TRUE;
+    }
+    return renderer->QueryReadPixels(renderer, readback);
+}
+
+int SDL_FinishRenderReadPixels(SDL_Renderer *renderer, Uint64 ticket, void *pixels, int pitch)
+{
+    SDL_RenderReadback *readback;
+    SDL_RenderReadback *prev;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    readback = FindRenderReadback(renderer, ticket, &prev);
+    if (!readback) {
+        return SDL_InvalidParamError("ticket");
+    }
+    if (pixels && !pitch) {
+        return SDL_InvalidParamError("pitch");
+    }
+
+    if (prev) {
+        prev->next = readback->next;
+    } else {
+        renderer->readbacks = readback->next;
+    }
+    return FinishRenderReadback(renderer, readback, pixels, pitch);
+}
+
+void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 {
     Uint64 now, elapsed;
     const Uint64 interval = renderer->simulate_vsync_interval_ns;
@@ -3997,15 +6250,82 @@ static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
     }
 }
 
+static void SDL_UpdatePresentTiming(SDL_Renderer *renderer, SDL_bool presented)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    Uint64 present_time = 0;
+    Uint64 interval = 0;
+
+    if (presented && renderer->GetPresentTiming &&
+        renderer->GetPresentTiming(renderer, &present_time, &interval) &&
+        present_time > 0 && present_time <= now) {
+        renderer->present_time = present_time;
+        renderer->present_time_measured = SDL_TRUE;
+        if (interval) {
+            renderer->refresh_interval = interval;
+        }
+        return;
+    }
+
+    interval = renderer->refresh_interval;
+    present_time = renderer->present_time;
+    if (renderer->simulate_vsync || (!presented && renderer->wanted_vsync)) {
+        /* We're pacing the presents ourselves, so we know the timeline */
+        present_time = renderer->last_present;
+    } else if (renderer->wanted_vsync && present_time && interval &&
+               (now - present_time) < SDL_MS_TO_NS(1000)) {
+        /* Present returns shortly after the vertical blank, but not at a
+           precise time, so lock onto the refresh timeline and correct
+           slowly for drift */
+        Uint64 predicted = present_time + ((now - present_time + interval / 2) / interval) * interval;
+        if (now >= predicted) {
+            predicted += (now - predicted) / 8;
+        } else {
+            predicted -= (predicted - now) / 8;
+        }
+        present_time = predicted;
+    } else {
+        present_time = now;
+    }
+    renderer->present_time = present_time;
+    renderer->present_time_measured = SDL_FALSE;
+}
+
+static Uint64 SDL_PredictNextVBlank(SDL_Renderer *renderer, Uint64 now)
+{
+    const Uint64 present_time = renderer->present_time;
+    const Uint64 interval = renderer->refresh_interval;
+
+    if (!present_time || !interval) {
+        return 0;
+    }
+    if (now < present_time) {
+        return present_time;
+    }
+    return present_time + ((now - present_time) / interval + 1) * interval;
+}
+
 int SDL_RenderPresent(SDL_Renderer *renderer)
 {
     SDL_bool presented = SDL_TRUE;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    CHECK_NOT_RECORDING(renderer, -1);
+
+    SDL_TRACE_BEGIN("SDL_RenderPresent");
+
+    /* Draw everything that was recorded on other threads */
+    ReplayRenderRecordings(renderer);
+
     if (renderer->logical_target) {
         SDL_SetRenderTargetInternal(renderer, NULL);
         SDL_RenderLogicalPresentation(renderer);
+    } else if (renderer->logical_direct) {
+        /* The frame is already in place, just cover anything drawn outside it */
+        SDL_SetRenderTargetInternal(renderer, NULL);
+        SetRenderView(renderer, &renderer->main_view);
+        SDL_RenderLogicalPresentation(renderer);
     }
 
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
@@ -4022,12 +6342,27 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
 
     if (renderer->logical_target) {
         SDL_SetRenderTargetInternal(renderer, renderer->logical_target);
+    } else if (renderer->logical_direct) {
+        SetRenderView(renderer, &renderer->logical_view);
+    }
+
+    if (renderer->stats_enabled) {
+        PublishRenderStats(renderer);
     }
 
     if (renderer->simulate_vsync ||
         (!presented && renderer->wanted_vsync)) {
         SDL_SimulateRenderVSync(renderer);
     }
+
+    SDL_UpdatePresentTiming(renderer, presented);
+
+    ++renderer->present_count;
+    if (renderer->target_pool) {
+        ExpirePooledRenderTargets(renderer);
+    }
+
+    SDL_TRACE_END("SDL_RenderPresent");
     return 0;
 }
 
@@ -4040,10 +6375,20 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
     SDL_DestroyProperties(texture->props);
 
     renderer = texture->renderer;
+    DiscardTextureUploads(texture);
+    if (texture->pooled) {
+        RemoveTextureFromPool(texture);
+    }
     if (is_destroying) {
         /* Renderer get destroyed, avoid to queue more commands */
     } else {
         if (texture == renderer->target) {
+            if (renderer->recording_commands) {
+                /* The recording draws to this texture, throw it away */
+                ResetRenderCommands(renderer);
+                renderer->recording_commands = SDL_FALSE;
+                renderer->recording_failed = SDL_TRUE;
+            }
             SDL_SetRenderTargetInternal(renderer, NULL); /* implies command queue flush */
 
             if (texture == renderer->logical_target) {
@@ -4060,6 +6405,8 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
         renderer->logical_target = NULL;
     }
 
+    InvalidateRenderCommandLists(renderer, texture);
+
     texture->magic = NULL;
 
     if (texture->next) {
@@ -4081,7 +6428,17 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
 #endif
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas_page) {
+        /* The atlas pages are cleaned up with the renderer */
+        if (!is_destroying) {
+            RemoveTextureFromAtlas(texture);
+        }
+    } else if (!texture->evicted) {
+        renderer->DestroyTexture(renderer, texture);
+        if (!is_destroying) {
+            RemoveTextureMemory(texture);
+        }
+    }
 
     SDL_DestroySurface(texture->locked_surface);
     texture->locked_surface = NULL;
@@ -4127,6 +6484,13 @@ void SDL_DestroyRenderer(SDL_Renderer *renderer)
 
     SDL_DiscardAllCommands(renderer);
 
+    /* Release the staging buffers of reads that were never finished */
+    while (renderer->readbacks) {
+        SDL_RenderReadback *readback = renderer->readbacks;
+        renderer->readbacks = readback->next;
+        FinishRenderReadback(renderer, readback, NULL, 0);
+    }
+
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_Texture *tex = renderer->textures;
@@ -4135,6 +6499,17 @@ void SDL_DestroyRenderer(SDL_Renderer *renderer)
         SDL_assert(tex != renderer->textures); /* satisfy static analysis. */
     }
 
+    while (renderer->command_lists) {
+        SDL_DestroyRenderCommandList(renderer->command_lists);
+    }
+
+    /* The atlas page textures were freed with the other textures */
+    while (renderer->atlas_pages) {
+        SDL_TextureAtlasPage *next = renderer->atlas_pages->next;
+        SDL_free(renderer->atlas_pages);
+        renderer->atlas_pages = next;
+    }
+
     SDL_free(renderer->vertex_data);
 
     if (renderer->window) {
@@ -4148,6 +6523,10 @@ void SDL_DestroyRenderer(SDL_Renderer *renderer)
     SDL_DestroyMutex(renderer->target_mutex);
     renderer->target_mutex = NULL;
 
+    DiscardRenderRecordings(renderer);
+    SDL_DestroyMutex(renderer->recordings_lock);
+    renderer->recordings_lock = NULL;
+
     /* Free the renderer instance */
     renderer->DestroyRenderer(renderer);
 }
@@ -4161,6 +6540,15 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
+        if (texture->atlas_page && DetachTextureFromAtlas(texture) < 0) {
+            return -1;
+        }
+        if (texture->shadowed && UploadTextureShadow(texture) < 0) {
+            return -1;
+        }
+        if (UseTexture(texture) < 0) {
+            return -1;
+        }
         FlushRenderCommandsIfTextureNeeded(texture); /* in case the app is going to mess with it. */
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
@@ -4333,3 +6721,45 @@ int SDL_GetRenderVSync(SDL_Renderer *renderer, int *vsync)
     *vsync = renderer->wanted_vsync;
     return 0;
 }
+
+int SDL_GetRenderPresentTiming(SDL_Renderer *renderer, SDL_RenderPresentTiming *timing)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    if (!timing) {
+        return SDL_InvalidParamError("timing");
+    }
+
+    timing->last_present_ns = renderer->present_time;
+    timing->refresh_interval_ns = renderer->refresh_interval;
+    timing->next_vblank_ns = SDL_PredictNextVBlank(renderer, SDL_GetTicksNS());
+    timing->measured = renderer->present_time_measured;
+    return 0;
+}
+
+int SDL_WaitRenderFrame(SDL_Renderer *renderer, Uint64 frame_time_ns)
+{
+    Uint64 interval, now, next_vblank, wake;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    interval = renderer->refresh_interval;
+    if (!renderer->wanted_vsync || !interval || frame_time_ns >= interval) {
+        return 0;
+    }
+
+    now = SDL_GetTicksNS();
+    next_vblank = SDL_PredictNextVBlank(renderer, now);
+    if (next_vblank < frame_time_ns) {
+        return 0;
+    }
+
+    /* If it's too late to make the next vertical blank, aim for the one after */
+    wake = next_vblank - frame_time_ns;
+    if (wake < now) {
+        wake += interval;
+    }
+    if (wake > now) {
+        SDL_DelayNS(wake - now);
+    }
+    return 0;
+}
@@ -46,6 +46,8 @@ typedef struct SDL_DRect
 typedef struct SDL_RenderDriver SDL_RenderDriver;
 extern char SDL_renderer_magic;
 extern char SDL_texture_magic;
+extern char SDL_render_command_list_magic;
+extern char SDL_render_recorder_magic;
 
 /* Rendering view state */
 typedef struct SDL_RenderViewState
@@ -59,6 +61,32 @@ typedef struct SDL_RenderViewState
 
 } SDL_RenderViewState;
 
+typedef struct SDL_TextureAtlasPage SDL_TextureAtlasPage;
+
+/* An upload from SDL_UpdateTextureAsync() waiting for the next flush */
+typedef struct SDL_TextureUpload
+{
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    void *pixels;
+    int pitch;
+    Uint64 ticket;
+    struct SDL_TextureUpload *next;
+} SDL_TextureUpload;
+
+/* A read from SDL_RenderReadPixelsAsync() waiting to be finished */
+typedef struct SDL_RenderReadback
+{
+    Uint64 ticket;
+    SDL_Rect rect;     /* the area being read, in output pixels */
+    SDL_Point offset;  /* where the area starts relative to the requested rectangle */
+    Uint32 format;
+    void *pixels;      /* read right away by backends without QueueReadPixels */
+    int pitch;
+    void *driverdata;
+    struct SDL_RenderReadback *next;
+} SDL_RenderReadback;
+
 /* Define the SDL texture structure */
 struct SDL_Texture
 {
@@ -69,6 +97,7 @@ struct SDL_Texture
     int h;                      /**< The height of the texture */
     SDL_BlendMode blendMode;    /**< The texture blend mode */
     SDL_ScaleMode scaleMode;    /**< The texture scale mode */
+    SDL_DistanceField distance_field; /**< The distance field stored in the texture */
     SDL_Color color;            /**< Texture modulation values */
     SDL_RenderViewState view;   /**< Target texture view state */
 
@@ -82,7 +111,31 @@ struct SDL_Texture
     SDL_Rect locked_rect;
     SDL_Surface *locked_surface; /**< Locked region exposed as a SDL surface */
 
+    /* Support for packing small static textures into shared atlas pages,
+       the pixels are kept in texture->pixels so the texture can be detached */
+    SDL_TextureAtlasPage *atlas_page;
+    SDL_Rect atlas_rect;
+
+    /* Support for streaming textures shadowed in CPU memory, enabled with the "lock_shadow" property.
+       The pixels are kept in texture->pixels and the area changed since the texture
+       was last drawn is uploaded right before it's drawn again */
+    SDL_bool shadowed;
+    SDL_Rect shadow_dirty;
+
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
+    int pending_uploads;            /* number of deferred uploads waiting for this texture. */
+
+    /* Support for recycling render targets, set while the texture is in the pool */
+    SDL_bool pooled;
+    Uint64 pool_release_frame;
+    SDL_Texture *pool_next;
+
+    /* Support for texture memory accounting and eviction */
+    Sint64 memory;              /* bytes counted for the GPU texture, 0 while there isn't one */
+    Uint64 last_used;           /* renderer->texture_use_count when the texture was last used */
+    SDL_bool evicted;           /* the GPU texture was released and is created again when needed */
+    SDL_TextureReloadCallback reload_callback;
+    void *reload_userdata;
 
     SDL_PropertiesID props;
 
@@ -92,6 +145,34 @@ struct SDL_Texture
     SDL_Texture *next;
 };
 
+/* Drawing operations submitted from a SDL_RenderRecorder */
+typedef struct SDL_RenderRecording
+{
+    Uint8 *data;
+    size_t size;
+    struct SDL_RenderRecording *next;
+} SDL_RenderRecording;
+
+struct SDL_RenderRecorder
+{
+    const void *magic;
+    SDL_Renderer *renderer;
+    Uint8 *data;
+    size_t size;
+    size_t allocated;
+};
+
+/* A renderer texture that small static textures are packed into */
+struct SDL_TextureAtlasPage
+{
+    SDL_Texture *texture;
+    int shelf_x;
+    int shelf_y;
+    int shelf_h;
+    int num_textures;
+    SDL_TextureAtlasPage *next;
+};
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -104,9 +185,22 @@ typedef enum
     SDL_RENDERCMD_FILL_RECTS,
     SDL_RENDERCMD_COPY,
     SDL_RENDERCMD_COPY_EX,
-    SDL_RENDERCMD_GEOMETRY
+    SDL_RENDERCMD_GEOMETRY,
+    SDL_RENDERCMD_DRAW_INSTANCES
 } SDL_RenderCommandType;
 
+#define SDL_RENDERCMD_COUNT (SDL_RENDERCMD_DRAW_INSTANCES + 1)
+
+/* Per-frame counters, published as renderer properties at present time */
+typedef struct SDL_RenderStats
+{
+    Uint64 commands[SDL_RENDERCMD_COUNT];
+    Uint64 flushes;              /* FlushRenderCommands() calls */
+    Uint64 batches;              /* command queues run by the backend */
+    Uint64 vertex_bytes;
+    Uint64 texture_upload_bytes;
+} SDL_RenderStats;
+
 typedef struct SDL_RenderCommand
 {
     SDL_RenderCommandType command;
@@ -129,6 +223,8 @@ typedef struct SDL_RenderCommand
             Uint8 r, g, b, a;
             SDL_BlendMode blend;
             SDL_Texture *texture;
+            float size; /* point size or line width in pixels for DRAW_POINTS and DRAW_LINES */
+            SDL_bool quads; /* GEOMETRY vertices are four corners per quad, see indexed_quads */
         } draw;
         struct
         {
@@ -139,12 +235,41 @@ typedef struct SDL_RenderCommand
     struct SDL_RenderCommand *next;
 } SDL_RenderCommand;
 
+/* A retained list of render commands and their backend vertex data */
+struct SDL_RenderCommandList
+{
+    const void *magic;
+    SDL_Renderer *renderer;
+    SDL_RenderCommand *commands;
+    int num_commands;
+    void *vertex_data;
+    size_t vertex_data_used;
+    SDL_bool invalid;
+
+    SDL_RenderCommandList *prev;
+    SDL_RenderCommandList *next;
+};
+
 typedef struct SDL_VertexSolid
 {
     SDL_FPoint position;
     SDL_Color color;
 } SDL_VertexSolid;
 
+/* A texture instance of SDL_RENDERCMD_DRAW_INSTANCES, in output coordinates.
+   The corners of the instance are origin + u * axis_x + v * axis_y for u and v
+   of 0 and 1, and they sample the texture at the matching corner of uv, which
+   is minu, minv, maxu, maxv and swapped for flipped instances. The color
+   includes the texture color modulation. */
+typedef struct SDL_RenderInstance
+{
+    SDL_FPoint origin;
+    SDL_FPoint axis_x;
+    SDL_FPoint axis_y;
+    float uv[4];
+    SDL_Color color;
+} SDL_RenderInstance;
+
 typedef enum
 {
     SDL_RENDERLINEMETHOD_POINTS,
@@ -178,6 +303,11 @@ struct SDL_Renderer
                          const float *xy, int xy_stride, const SDL_Color *color, int color_stride, const float *uv, int uv_stride,
                          int num_vertices, const void *indices, int num_indices, int size_indices,
                          float scale_x, float scale_y);
+    /* Optional, for backends that draw SDL_RenderTextureInstanced() with hardware instancing.
+       The instances are converted with SDL_GetRenderInstances(texture, ...), and drawn from
+       cmd->data.draw.texture, which is the atlas page for textures packed into one. */
+    int (*QueueInstances)(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture,
+                          const SDL_TextureInstance *instances, int count, float scale_x, float scale_y);
 
     int (*RunCommandQueue)(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
     int (*UpdateTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
@@ -194,6 +324,10 @@ struct SDL_Renderer
                            const Uint8 *Yplane, int Ypitch,
                            const Uint8 *UVplane, int UVpitch);
 #endif
+    int (*UpdateTextureAsync)(SDL_Renderer *renderer, SDL_Texture *texture,
+                              const SDL_Rect *rect, const void *pixels,
+                              int pitch, Uint64 ticket);
+    SDL_bool (*QueryTextureUpload)(SDL_Renderer *renderer, Uint64 ticket, SDL_bool wait);
     int (*LockTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
                        const SDL_Rect *rect, void **pixels, int *pitch);
     void (*UnlockTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
@@ -201,6 +335,12 @@ struct SDL_Renderer
     int (*SetRenderTarget)(SDL_Renderer *renderer, SDL_Texture *texture);
     int (*RenderReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect,
                             Uint32 format, void *pixels, int pitch);
+    /* Optional, copy readback->rect into a staging buffer without waiting for the GPU.
+       FinishReadPixels waits, converts to readback->format and frees the staging
+       buffer, pixels is NULL if the read is being discarded. */
+    int (*QueueReadPixels)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    SDL_bool (*QueryReadPixels)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    int (*FinishReadPixels)(SDL_Renderer *renderer, SDL_RenderReadback *readback, void *pixels, int pitch);
     int (*RenderPresent)(SDL_Renderer *renderer);
     void (*DestroyTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
@@ -208,6 +348,13 @@ struct SDL_Renderer
 
     int (*SetVSync)(SDL_Renderer *renderer, int vsync);
 
+    /* Optional, the GPU time of the most recent frame that has finished */
+    SDL_bool (*GetFrameGPUTime)(SDL_Renderer *renderer, Uint64 *nanoseconds);
+
+    /* Optional, when the most recent frame with known timing was shown, in SDL_GetTicksNS() time,
+       and the refresh interval of the display, or 0 if it isn't known */
+    SDL_bool (*GetPresentTiming)(SDL_Renderer *renderer, Uint64 *present_ns, Uint64 *refresh_interval_ns);
+
     int (*GL_BindTexture)(SDL_Renderer *renderer, SDL_Texture *texture, float *texw, float *texh);
     int (*GL_UnbindTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
@@ -227,6 +374,11 @@ struct SDL_Renderer
     Uint64 simulate_vsync_interval_ns;
     Uint64 last_present;
 
+    /* Presentation timing feedback */
+    Uint64 present_time;
+    Uint64 refresh_interval;
+    SDL_bool present_time_measured;
+
     /* Support for logical output coordinates */
     SDL_Texture *logical_target;
     SDL_RendererLogicalPresentation logical_presentation_mode;
@@ -234,6 +386,13 @@ struct SDL_Renderer
     SDL_FRect logical_src_rect;
     SDL_FRect logical_dst_rect;
 
+    /* When the logical presentation is drawn straight to the output instead
+       of logical_target, this is the view the app renders to. Its scale
+       includes logical_scale, the size of a logical pixel in output pixels. */
+    SDL_bool logical_direct;
+    SDL_RenderViewState logical_view;
+    SDL_FPoint logical_scale;
+
     SDL_RenderViewState *view;
     SDL_RenderViewState main_view;
 
@@ -243,9 +402,21 @@ struct SDL_Renderer
     /* The method of drawing lines */
     SDL_RenderLineMethod line_method;
 
+    /* The largest point size and line width the backend draws natively.
+       Scaled points and lines up to this size are queued with cmd->data.draw.size
+       in unscaled coordinates, larger ones are expanded into rects. */
+    float max_point_size;
+    float max_line_width;
+
     /* List of triangle indices to draw rects */
     int rect_index_order[6];
 
+    /* Set by backends that draw quads from a static index buffer filled by
+       SDL_GetRenderQuadIndices(). Rects and textures are then queued as
+       GEOMETRY commands with draw.quads set and only four vertices per quad,
+       up to SDL_RENDER_MAX_QUADS in a single command. */
+    SDL_bool indexed_quads;
+
     /* The list of textures */
     SDL_Texture *textures;
     SDL_Texture *target;
@@ -270,6 +441,53 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Support for retained command lists.
+       Backends that keep vertex data outside of vertex_data can't be replayed. */
+    SDL_bool command_lists_unsupported;
+    SDL_bool recording_commands;
+    SDL_bool recording_failed;
+    SDL_RenderCommandList *command_lists;
+
+    /* Recordings submitted from other threads, drawn at the next present */
+    SDL_Mutex *recordings_lock;
+    SDL_RenderRecording *recordings;
+    SDL_RenderRecording *recordings_tail;
+
+    /* Asynchronous texture uploads, backends without UpdateTextureAsync
+       stage the pixels here until the next flush */
+    Uint64 texture_upload_ticket;
+    SDL_TextureUpload *texture_uploads;
+    SDL_TextureUpload *texture_uploads_tail;
+
+    /* Asynchronous reads from SDL_RenderReadPixelsAsync(), in submission order */
+    Uint64 readback_ticket;
+    SDL_RenderReadback *readbacks;
+
+    /* Set by backends that have shaders for SDL_DISTANCEFIELD_SDF and SDL_DISTANCEFIELD_MSDF */
+    SDL_bool supports_distance_fields;
+
+    /* Set by backends whose QueueGeometry() takes SDL_Vertex arrays as they are */
+    SDL_bool native_vertices;
+
+    /* Implicit texture atlasing, enabled with the "texture_atlas" property */
+    SDL_bool texture_atlas;
+    SDL_TextureAtlasPage *atlas_pages;
+
+    /* Render statistics, enabled with the "stats" property */
+    SDL_bool stats_enabled;
+    SDL_RenderStats stats;
+
+    /* Render targets released with SDL_ReleaseRenderTarget(), most recent first */
+    SDL_Texture *target_pool;
+    Uint64 present_count;
+
+    /* Texture memory accounting, kept within the "texture_memory_budget" property if it's set */
+    Sint64 texture_memory;
+    Sint64 target_memory;
+    Sint64 texture_memory_budget;
+    Sint64 texture_evictions;
+    Uint64 texture_use_count;
+
     SDL_PropertiesID props;
 
     void *driverdata;
@@ -295,6 +513,7 @@ extern SDL_RenderDriver PS2_RenderDriver;
 extern SDL_RenderDriver PSP_RenderDriver;
 extern SDL_RenderDriver SW_RenderDriver;
 extern SDL_RenderDriver VITA_GXM_RenderDriver;
+extern SDL_RenderDriver VULKAN_RenderDriver;
 
 /* Blend mode functions */
 extern SDL_BlendFactor SDL_GetBlendModeSrcColorFactor(SDL_BlendMode blendMode);
@@ -309,6 +528,27 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
    the next call, because it might be in an array that gets realloc()'d. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
+/* Drivers whose vertices are laid out like SDL_Vertex check this in QueueGeometry(). If the
+   arrays are really one packed SDL_Vertex array, they can take them as they are with
+   SDL_CopyRenderVertices(), which copies them in one go when there are no indices. */
+extern SDL_bool SDL_IsRenderVertexArray(const float *xy, int xy_stride, const SDL_Color *color, int color_stride, const float *uv, int uv_stride);
+extern void SDL_CopyRenderVertices(SDL_Vertex *dst, const SDL_Vertex *vertices, int count, const void *indices, int size_indices);
+
+/* Drivers call this in QueueInstances() to convert the instances into dst, skipping the
+   ones whose source rectangle is outside the texture. Returns the number written. */
+extern int SDL_GetRenderInstances(SDL_Texture *texture, const SDL_TextureInstance *instances, int count,
+                                  float scale_x, float scale_y, SDL_RenderInstance *dst);
+
+/* The most quads that can be drawn with 16-bit indices */
+#define SDL_RENDER_MAX_QUADS (65536 / 4)
+
+/* Wait until the next refresh, for renderers that have nothing to present */
+extern void SDL_SimulateRenderVSync(SDL_Renderer *renderer);
+
+/* drivers that set indexed_quads call this to fill their quad index buffer,
+   which is 6 * num_quads indices following the renderer's rect_index_order. */
+extern void SDL_GetRenderQuadIndices(const SDL_Renderer *renderer, Uint16 *indices, int num_quads);
+
 extern int SDL_PrivateBlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 extern int SDL_PrivateBlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
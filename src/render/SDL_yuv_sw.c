@@ -39,6 +39,9 @@ SDL_SW_YUVTexture *SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
     case SDL_PIXELFORMAT_YVYU:
     case SDL_PIXELFORMAT_NV12:
     case SDL_PIXELFORMAT_NV21:
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+    case SDL_PIXELFORMAT_I444:
         break;
     default:
         SDL_SetError("Unsupported YUV format");
@@ -96,6 +99,23 @@ SDL_SW_YUVTexture *SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
         break;
 
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        swdata->pitches[0] = w * 2;
+        swdata->pitches[1] = 4 * ((swdata->pitches[0] + 3) / 4);
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
+        break;
+
+    case SDL_PIXELFORMAT_I444:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = w;
+        swdata->pitches[2] = w;
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
+        swdata->planes[2] = swdata->planes[1] + swdata->pitches[1] * h;
+        break;
+
     default:
         SDL_assert(0 && "We should never get here (caught above)");
         break;
@@ -121,8 +141,9 @@ int SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
     case SDL_PIXELFORMAT_IYUV:
         if (rect->x == 0 && rect->y == 0 &&
             rect->w == swdata->w && rect->h == swdata->h) {
-            SDL_memcpy(swdata->pixels, pixels,
-                       (size_t)(swdata->h * swdata->w) + 2 * ((swdata->h + 1) / 2) * ((swdata->w + 1) / 2));
+            /* Large frames are copied in bands across the blit worker threads */
+            return SDL_ConvertPixels(swdata->w, swdata->h, swdata->format, pixels, pitch,
+                                     swdata->format, swdata->pixels, swdata->pitches[0]);
         } else {
             Uint8 *src, *dst;
             int row;
@@ -166,27 +187,17 @@ int SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
     {
-        Uint8 *src, *dst;
-        int row;
-        size_t length;
-
-        src = (Uint8 *)pixels;
-        dst =
-            swdata->planes[0] + rect->y * swdata->pitches[0] +
-            rect->x * 2;
-        length = 4 * (((size_t)rect->w + 1) / 2);
-        for (row = 0; row < rect->h; ++row) {
-            SDL_memcpy(dst, src, length);
-            src += pitch;
-            dst += swdata->pitches[0];
-        }
-    } break;
+        Uint8 *dst = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x * 2;
+
+        return SDL_ConvertPixels(rect->w, rect->h, swdata->format, pixels, pitch,
+                                 swdata->format, dst, swdata->pitches[0]);
+    }
     case SDL_PIXELFORMAT_NV12:
     case SDL_PIXELFORMAT_NV21:
     {
         if (rect->x == 0 && rect->y == 0 && rect->w == swdata->w && rect->h == swdata->h) {
-            SDL_memcpy(swdata->pixels, pixels,
-                       (size_t)(swdata->h * swdata->w) + 2 * ((swdata->h + 1) / 2) * ((swdata->w + 1) / 2));
+            return SDL_ConvertPixels(swdata->w, swdata->h, swdata->format, pixels, pitch,
+                                     swdata->format, swdata->pixels, swdata->pitches[0]);
         } else {
 
             Uint8 *src, *dst;
@@ -214,7 +225,59 @@ int SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
                 dst += 2 * ((swdata->w + 1) / 2);
             }
         }
-    }
+    } break;
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        if (rect->x == 0 && rect->y == 0 && rect->w == swdata->w && rect->h == swdata->h) {
+            return SDL_ConvertPixels(swdata->w, swdata->h, swdata->format, pixels, pitch,
+                                     swdata->format, swdata->pixels, swdata->pitches[0]);
+        } else {
+            const Uint8 *src;
+            Uint8 *dst;
+            int row;
+            size_t length;
+
+            /* Copy the Y plane */
+            src = (const Uint8 *)pixels;
+            dst = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x * 2;
+            length = (size_t)rect->w * 2;
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[0];
+            }
+
+            /* Copy the U/V plane */
+            src = (const Uint8 *)pixels + rect->h * pitch;
+            dst = swdata->planes[1] + (rect->y / 2) * swdata->pitches[1] + (rect->x / 2) * 4;
+            length = 4 * (((size_t)rect->w + 1) / 2);
+            for (row = 0; row < (rect->h + 1) / 2; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += 4 * ((pitch + 3) / 4);
+                dst += swdata->pitches[1];
+            }
+        }
+        break;
+    case SDL_PIXELFORMAT_I444:
+        if (rect->x == 0 && rect->y == 0 && rect->w == swdata->w && rect->h == swdata->h) {
+            return SDL_ConvertPixels(swdata->w, swdata->h, swdata->format, pixels, pitch,
+                                     swdata->format, swdata->pixels, swdata->pitches[0]);
+        } else {
+            int plane, row;
+
+            /* The planes are the same size, one after the other */
+            for (plane = 0; plane < 3; ++plane) {
+                const Uint8 *src = (const Uint8 *)pixels + plane * rect->h * pitch;
+                Uint8 *dst = swdata->planes[plane] + rect->y * swdata->pitches[plane] + rect->x;
+
+                for (row = 0; row < rect->h; ++row) {
+                    SDL_memcpy(dst, src, rect->w);
+                    src += pitch;
+                    dst += swdata->pitches[plane];
+                }
+            }
+        }
+        break;
     }
     return 0;
 }
@@ -229,6 +292,28 @@ int SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture *swdata, const SDL_Rect *rec
     int row;
     size_t length;
 
+    if (swdata->format == SDL_PIXELFORMAT_I444) {
+        const Uint8 *planes[3];
+        int pitches[3], plane;
+
+        planes[0] = Yplane;
+        planes[1] = Uplane;
+        planes[2] = Vplane;
+        pitches[0] = Ypitch;
+        pitches[1] = Upitch;
+        pitches[2] = Vpitch;
+        for (plane = 0; plane < 3; ++plane) {
+            src = planes[plane];
+            dst = swdata->planes[plane] + rect->y * swdata->pitches[plane] + rect->x;
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, rect->w);
+                src += pitches[plane];
+                dst += swdata->pitches[plane];
+            }
+        }
+        return 0;
+    }
+
     /* Copy the Y plane */
     src = Yplane;
     dst = swdata->pixels + rect->y * swdata->w + rect->x;
@@ -282,6 +367,29 @@ int SDL_SW_UpdateNVTexturePlanar(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect
     int row;
     size_t length;
 
+    if (swdata->format == SDL_PIXELFORMAT_P010 || swdata->format == SDL_PIXELFORMAT_P016) {
+        /* Copy the Y plane */
+        src = Yplane;
+        dst = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x * 2;
+        length = (size_t)rect->w * 2;
+        for (row = 0; row < rect->h; ++row) {
+            SDL_memcpy(dst, src, length);
+            src += Ypitch;
+            dst += swdata->pitches[0];
+        }
+
+        /* Copy the U/V plane */
+        src = UVplane;
+        dst = swdata->planes[1] + (rect->y / 2) * swdata->pitches[1] + (rect->x / 2) * 4;
+        length = 4 * (((size_t)rect->w + 1) / 2);
+        for (row = 0; row < (rect->h + 1) / 2; ++row) {
+            SDL_memcpy(dst, src, length);
+            src += UVpitch;
+            dst += swdata->pitches[1];
+        }
+        return 0;
+    }
+
     /* Copy the Y plane */
     src = Yplane;
     dst = swdata->pixels + rect->y * swdata->w + rect->x;
@@ -315,8 +423,11 @@ int SDL_SW_LockYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
     case SDL_PIXELFORMAT_IYUV:
     case SDL_PIXELFORMAT_NV12:
     case SDL_PIXELFORMAT_NV21:
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+    case SDL_PIXELFORMAT_I444:
         if (rect && (rect->x != 0 || rect->y != 0 || rect->w != swdata->w || rect->h != swdata->h)) {
-            return SDL_SetError("YV12, IYUV, NV12, NV21 textures only support full surface locks");
+            return SDL_SetError("Planar YUV textures only support full surface locks");
         }
         break;
     }
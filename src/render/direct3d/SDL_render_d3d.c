@@ -1271,6 +1271,9 @@ static int D3D_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
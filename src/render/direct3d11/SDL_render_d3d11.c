@@ -29,6 +29,7 @@
 #endif
 #include "../SDL_sysrender.h"
 #include "../SDL_d3dmath.h"
+#include "../../timer/SDL_timer_c.h"
 
 #include <d3d11_1.h>
 
@@ -62,6 +63,10 @@ extern ISwapChainBackgroundPanelNative *WINRT_GlobalSwapChainBackgroundPanelNati
         X = NULL;                                         \
     }
 
+/* The vertex data for each frame is appended to a single dynamic buffer of
+   at least this size, which is only discarded when it wraps around. */
+#define D3D11_VERTEX_BUFFER_SIZE (1024 * 1024)
+
 /* !!! FIXME: vertex buffer bandwidth could be lower; only use UV coords when
    !!! FIXME:  textures are needed. */
 
@@ -126,11 +131,15 @@ typedef struct
     ID3D11DeviceContext1 *d3dContext;
     IDXGISwapChain1 *swapChain;
     DXGI_SWAP_EFFECT swapEffect;
+    UINT lastSyncRefreshCount;
+    LONGLONG lastSyncQPCTime;
     ID3D11RenderTargetView *mainRenderTargetView;
     ID3D11RenderTargetView *currentOffscreenRenderTargetView;
     ID3D11InputLayout *inputLayout;
-    ID3D11Buffer *vertexBuffers[8];
-    size_t vertexBufferSizes[8];
+    ID3D11Buffer *vertexBuffer;
+    size_t vertexBufferSize;
+    size_t vertexBufferOffset;
+    ID3D11Buffer *quadIndexBuffer;
     ID3D11VertexShader *vertexShader;
     ID3D11PixelShader *pixelShaders[NUM_SHADERS];
     int blendModesCount;
@@ -163,7 +172,6 @@ typedef struct
     int currentViewportRotation;
     SDL_bool viewportDirty;
     Float4X4 identity;
-    int currentVertexBuffer;
 } D3D11_RenderData;
 
 /* Define D3D GUIDs here so we don't have to include uuid.lib.
@@ -265,9 +273,10 @@ static void D3D11_ReleaseAll(SDL_Renderer *renderer)
         SAFE_RELEASE(data->mainRenderTargetView);
         SAFE_RELEASE(data->currentOffscreenRenderTargetView);
         SAFE_RELEASE(data->inputLayout);
-        for (i = 0; i < SDL_arraysize(data->vertexBuffers); ++i) {
-            SAFE_RELEASE(data->vertexBuffers[i]);
-        }
+        SAFE_RELEASE(data->vertexBuffer);
+        data->vertexBufferSize = 0;
+        data->vertexBufferOffset = 0;
+        SAFE_RELEASE(data->quadIndexBuffer);
         SAFE_RELEASE(data->vertexShader);
         for (i = 0; i < SDL_arraysize(data->pixelShaders); ++i) {
             SAFE_RELEASE(data->pixelShaders[i]);
@@ -599,6 +608,38 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
         goto done;
     }
 
+    /* Create the index buffer used to draw quads from 4 vertices each */
+    {
+        D3D11_BUFFER_DESC indexBufferDesc;
+        D3D11_SUBRESOURCE_DATA indexBufferData;
+        Uint16 *indices = (Uint16 *)SDL_malloc(SDL_RENDER_MAX_QUADS * 6 * sizeof(Uint16));
+
+        if (!indices) {
+            SDL_OutOfMemory();
+            result = E_OUTOFMEMORY;
+            goto done;
+        }
+        SDL_GetRenderQuadIndices(renderer, indices, SDL_RENDER_MAX_QUADS);
+
+        SDL_zero(indexBufferDesc);
+        indexBufferDesc.ByteWidth = SDL_RENDER_MAX_QUADS * 6 * sizeof(Uint16);
+        indexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+        indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+        SDL_zero(indexBufferData);
+        indexBufferData.pSysMem = indices;
+
+        result = ID3D11Device_CreateBuffer(data->d3dDevice,
+                                           &indexBufferDesc,
+                                           &indexBufferData,
+                                           &data->quadIndexBuffer);
+        SDL_free(indices);
+        if (FAILED(result)) {
+            WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateBuffer [quad index buffer]"), result);
+            goto done;
+        }
+    }
+
     /* Create samplers to use when drawing textures: */
     SDL_zero(samplerDesc);
     samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
@@ -665,6 +706,7 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
     ID3D11DeviceContext_IASetInputLayout(data->d3dContext, data->inputLayout);
     ID3D11DeviceContext_VSSetShader(data->d3dContext, data->vertexShader, NULL, 0);
     ID3D11DeviceContext_VSSetConstantBuffers(data->d3dContext, 0, 1, &data->vertexShaderConstants);
+    ID3D11DeviceContext_IASetIndexBuffer(data->d3dContext, data->quadIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
 
     SDL_SetProperty(SDL_GetRendererProperties(renderer), "SDL.renderer.d3d11.device", data->d3dDevice);
 
@@ -1079,6 +1121,19 @@ static int GetTextureProperty(SDL_PropertiesID props, const char *name, ID3D11Te
     return 0;
 }
 
+static int GetSharedTextureProperty(D3D11_RenderData *rendererData, SDL_PropertiesID props, const char *name, ID3D11Texture2D **texture)
+{
+    HANDLE handle = (HANDLE)SDL_GetProperty(props, name, NULL);
+    if (handle && !*texture) {
+        /* This opens the memory of another device or process, there is no copy involved */
+        HRESULT result = ID3D11Device1_OpenSharedResource1(rendererData->d3dDevice, handle, &SDL_IID_ID3D11Texture2D, (void **)texture);
+        if (FAILED(result)) {
+            return WIN_SetErrorFromHRESULT(name, result);
+        }
+    }
+    return 0;
+}
+
 static int D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->driverdata;
@@ -1126,7 +1181,8 @@ static int D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
     }
 
-    if (GetTextureProperty(create_props, "d3d11.texture", &textureData->mainTexture) < 0) {
+    if (GetTextureProperty(create_props, "d3d11.texture", &textureData->mainTexture) < 0 ||
+        GetSharedTextureProperty(rendererData, create_props, "d3d11.shared_handle", &textureData->mainTexture) < 0) {
         return -1;
     }
     if (!textureData->mainTexture) {
@@ -1148,7 +1204,8 @@ static int D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         textureDesc.Width = (textureDesc.Width + 1) / 2;
         textureDesc.Height = (textureDesc.Height + 1) / 2;
 
-        if (GetTextureProperty(create_props, "d3d11.texture_u", &textureData->mainTextureU) < 0) {
+        if (GetTextureProperty(create_props, "d3d11.texture_u", &textureData->mainTextureU) < 0 ||
+            GetSharedTextureProperty(rendererData, create_props, "d3d11.shared_handle_u", &textureData->mainTextureU) < 0) {
             return -1;
         }
         if (!textureData->mainTextureU) {
@@ -1163,7 +1220,8 @@ static int D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         }
         SDL_SetProperty(SDL_GetTextureProperties(texture), "SDL.texture.d3d11.texture_u", textureData->mainTextureU);
 
-        if (GetTextureProperty(create_props, "d3d11.texture_v", &textureData->mainTextureV) < 0) {
+        if (GetTextureProperty(create_props, "d3d11.texture_v", &textureData->mainTextureV) < 0 ||
+            GetSharedTextureProperty(rendererData, create_props, "d3d11.shared_handle_v", &textureData->mainTextureV) < 0) {
             return -1;
         }
         if (!textureData->mainTextureV) {
@@ -1774,66 +1832,78 @@ static int D3D11_UpdateVertexBuffer(SDL_Renderer *renderer,
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->driverdata;
     HRESULT result = S_OK;
-    const int vbidx = rendererData->currentVertexBuffer;
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    D3D11_MAP mapType;
     const UINT stride = sizeof(VertexPositionColor);
-    const UINT offset = 0;
+    UINT offset;
 
     if (dataSizeInBytes == 0) {
         return 0; /* nothing to do. */
     }
 
-    if (rendererData->vertexBuffers[vbidx] && rendererData->vertexBufferSizes[vbidx] >= dataSizeInBytes) {
-        D3D11_MAPPED_SUBRESOURCE mappedResource;
-        result = ID3D11DeviceContext_Map(rendererData->d3dContext,
-                                         (ID3D11Resource *)rendererData->vertexBuffers[vbidx],
-                                         0,
-                                         D3D11_MAP_WRITE_DISCARD,
-                                         0,
-                                         &mappedResource);
-        if (FAILED(result)) {
-            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
-        }
-        SDL_memcpy(mappedResource.pData, vertexData, dataSizeInBytes);
-        ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffers[vbidx], 0);
-    } else {
+    if (rendererData->vertexBufferSize < dataSizeInBytes) {
         D3D11_BUFFER_DESC vertexBufferDesc;
-        D3D11_SUBRESOURCE_DATA vertexBufferData;
+        size_t size = D3D11_VERTEX_BUFFER_SIZE;
+
+        while (size < dataSizeInBytes) {
+            size *= 2;
+        }
+        if (size > SDL_MAX_UINT32) {
+            return SDL_SetError("Vertex data is too large");
+        }
 
-        SAFE_RELEASE(rendererData->vertexBuffers[vbidx]);
+        SAFE_RELEASE(rendererData->vertexBuffer);
+        rendererData->vertexBufferSize = 0;
 
         SDL_zero(vertexBufferDesc);
-        vertexBufferDesc.ByteWidth = (UINT)dataSizeInBytes;
+        vertexBufferDesc.ByteWidth = (UINT)size;
         vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
         vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
-        SDL_zero(vertexBufferData);
-        vertexBufferData.pSysMem = vertexData;
-        vertexBufferData.SysMemPitch = 0;
-        vertexBufferData.SysMemSlicePitch = 0;
-
         result = ID3D11Device_CreateBuffer(rendererData->d3dDevice,
                                            &vertexBufferDesc,
-                                           &vertexBufferData,
-                                           &rendererData->vertexBuffers[vbidx]);
+                                           NULL,
+                                           &rendererData->vertexBuffer);
         if (FAILED(result)) {
             return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateBuffer [vertex buffer]"), result);
         }
 
-        rendererData->vertexBufferSizes[vbidx] = dataSizeInBytes;
+        rendererData->vertexBufferSize = size;
+        rendererData->vertexBufferOffset = size; /* Force a discard below */
     }
 
+    /* Append to the data the GPU may still be reading, and only make the
+       driver hand us fresh memory when we run out of room. */
+    if (rendererData->vertexBufferOffset + dataSizeInBytes > rendererData->vertexBufferSize) {
+        mapType = D3D11_MAP_WRITE_DISCARD;
+        rendererData->vertexBufferOffset = 0;
+    } else {
+        mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    }
+
+    result = ID3D11DeviceContext_Map(rendererData->d3dContext,
+                                     (ID3D11Resource *)rendererData->vertexBuffer,
+                                     0,
+                                     mapType,
+                                     0,
+                                     &mappedResource);
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
+    }
+    offset = (UINT)rendererData->vertexBufferOffset;
+    SDL_memcpy((Uint8 *)mappedResource.pData + offset, vertexData, dataSizeInBytes);
+    ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffer, 0);
+
     ID3D11DeviceContext_IASetVertexBuffers(rendererData->d3dContext,
                                            0,
                                            1,
-                                           &rendererData->vertexBuffers[vbidx],
+                                           &rendererData->vertexBuffer,
                                            &stride,
                                            &offset);
 
-    rendererData->currentVertexBuffer++;
-    if (rendererData->currentVertexBuffer >= SDL_arraysize(rendererData->vertexBuffers)) {
-        rendererData->currentVertexBuffer = 0;
-    }
+    /* Keep the next batch aligned to the vertex size */
+    rendererData->vertexBufferOffset += ((dataSizeInBytes + stride - 1) / stride) * stride;
 
     return 0;
 }
@@ -2124,6 +2194,13 @@ static void D3D11_DrawPrimitives(SDL_Renderer *renderer, D3D11_PRIMITIVE_TOPOLOG
     ID3D11DeviceContext_Draw(rendererData->d3dContext, (UINT)vertexCount, (UINT)vertexStart);
 }
 
+static void D3D11_DrawQuads(SDL_Renderer *renderer, const size_t vertexStart, const size_t vertexCount)
+{
+    D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->driverdata;
+    ID3D11DeviceContext_IASetPrimitiveTopology(rendererData->d3dContext, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    ID3D11DeviceContext_DrawIndexed(rendererData->d3dContext, (UINT)(vertexCount / 4 * 6), 0, (INT)vertexStart);
+}
+
 static int D3D11_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->driverdata;
@@ -2232,10 +2309,17 @@ static int D3D11_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                 D3D11_SetDrawState(renderer, cmd, rendererData->pixelShaders[SHADER_SOLID], 0, NULL, NULL, NULL);
             }
 
-            D3D11_DrawPrimitives(renderer, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, start, count);
+            if (cmd->data.draw.quads) {
+                D3D11_DrawQuads(renderer, start, count);
+            } else {
+                D3D11_DrawPrimitives(renderer, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, start, count);
+            }
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -2246,19 +2330,19 @@ static int D3D11_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     return 0;
 }
 
-static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
-                                  Uint32 format, void *pixels, int pitch)
+/* Copy part of the current render target into a new staging texture */
+static int D3D11_CopyToStagingTexture(SDL_Renderer *renderer, const SDL_Rect *rect, ID3D11Texture2D **stagingTexture, DXGI_FORMAT *stagingFormat)
 {
     D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
     ID3D11RenderTargetView *renderTargetView = NULL;
     ID3D11Texture2D *backBuffer = NULL;
-    ID3D11Texture2D *stagingTexture = NULL;
     HRESULT result;
     int status = -1;
     D3D11_TEXTURE2D_DESC stagingTextureDesc;
     D3D11_RECT srcRect = { 0, 0, 0, 0 };
     D3D11_BOX srcBox;
-    D3D11_MAPPED_SUBRESOURCE textureMemory;
+
+    *stagingTexture = NULL;
 
     renderTargetView = D3D11_GetCurrentRenderTargetView(renderer);
     if (!renderTargetView) {
@@ -2283,15 +2367,17 @@ static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
     result = ID3D11Device_CreateTexture2D(data->d3dDevice,
                                           &stagingTextureDesc,
                                           NULL,
-                                          &stagingTexture);
+                                          stagingTexture);
     if (FAILED(result)) {
         WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateTexture2D [create staging texture]"), result);
         goto done;
     }
+    *stagingFormat = stagingTextureDesc.Format;
 
     /* Copy the desired portion of the back buffer to the staging texture: */
     if (D3D11_GetViewportAlignedD3DRect(renderer, rect, &srcRect, FALSE) != 0) {
         /* D3D11_GetViewportAlignedD3DRect will have set the SDL error */
+        SAFE_RELEASE(*stagingTexture);
         goto done;
     }
 
@@ -2302,12 +2388,26 @@ static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
     srcBox.front = 0;
     srcBox.back = 1;
     ID3D11DeviceContext_CopySubresourceRegion(data->d3dContext,
-                                              (ID3D11Resource *)stagingTexture,
+                                              (ID3D11Resource *)*stagingTexture,
                                               0,
                                               0, 0, 0,
                                               (ID3D11Resource *)backBuffer,
                                               0,
                                               &srcBox);
+    status = 0;
+
+done:
+    SAFE_RELEASE(backBuffer);
+    return status;
+}
+
+/* Map a staging texture and convert its pixels into the desired buffer */
+static int D3D11_ReadStagingTexture(D3D11_RenderData *data, ID3D11Texture2D *stagingTexture, DXGI_FORMAT stagingFormat,
+                                    const SDL_Rect *rect, Uint32 format, void *pixels, int pitch)
+{
+    D3D11_MAPPED_SUBRESOURCE textureMemory;
+    HRESULT result;
+    int status;
 
     /* Map the staging texture's data to CPU-accessible memory: */
     result = ID3D11DeviceContext_Map(data->d3dContext,
@@ -2317,8 +2417,7 @@ static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
                                      0,
                                      &textureMemory);
     if (FAILED(result)) {
-        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [map staging texture]"), result);
-        goto done;
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [map staging texture]"), result);
     }
 
     /* Copy the data into the desired buffer, converting pixels to the
@@ -2326,7 +2425,7 @@ static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
      */
     status = SDL_ConvertPixels(
         rect->w, rect->h,
-        D3D11_DXGIFormatToSDLPixelFormat(stagingTextureDesc.Format),
+        D3D11_DXGIFormatToSDLPixelFormat(stagingFormat),
         textureMemory.pData,
         textureMemory.RowPitch,
         format,
@@ -2337,13 +2436,82 @@ static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
     ID3D11DeviceContext_Unmap(data->d3dContext,
                               (ID3D11Resource *)stagingTexture,
                               0);
+    return status;
+}
 
-done:
-    SAFE_RELEASE(backBuffer);
+static int D3D11_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
+                                  Uint32 format, void *pixels, int pitch)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
+    ID3D11Texture2D *stagingTexture = NULL;
+    DXGI_FORMAT stagingFormat;
+    int status;
+
+    if (D3D11_CopyToStagingTexture(renderer, rect, &stagingTexture, &stagingFormat) < 0) {
+        return -1;
+    }
+    status = D3D11_ReadStagingTexture(data, stagingTexture, stagingFormat, rect, format, pixels, pitch);
     SAFE_RELEASE(stagingTexture);
     return status;
 }
 
+typedef struct D3D11_Readback
+{
+    ID3D11Texture2D *stagingTexture;
+    DXGI_FORMAT stagingFormat;
+} D3D11_Readback;
+
+static int D3D11_QueueReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    D3D11_Readback *rb = (D3D11_Readback *)SDL_calloc(1, sizeof(*rb));
+    if (!rb) {
+        return -1;
+    }
+    if (D3D11_CopyToStagingTexture(renderer, &readback->rect, &rb->stagingTexture, &rb->stagingFormat) < 0) {
+        SDL_free(rb);
+        return -1;
+    }
+    readback->driverdata = rb;
+    return 0;
+}
+
+static SDL_bool D3D11_QueryReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
+    D3D11_Readback *rb = (D3D11_Readback *)readback->driverdata;
+    D3D11_MAPPED_SUBRESOURCE textureMemory;
+    HRESULT result;
+
+    result = ID3D11DeviceContext_Map(data->d3dContext,
+                                     (ID3D11Resource *)rb->stagingTexture,
+                                     0,
+                                     D3D11_MAP_READ,
+                                     D3D11_MAP_FLAG_DO_NOT_WAIT,
+                                     &textureMemory);
+    if (result == DXGI_ERROR_WAS_STILL_DRAWING) {
+        return SDL_FALSE;
+    }
+    if (SUCCEEDED(result)) {
+        ID3D11DeviceContext_Unmap(data->d3dContext, (ID3D11Resource *)rb->stagingTexture, 0);
+    }
+    return SDL_TRUE;
+}
+
+static int D3D11_FinishReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback, void *pixels, int pitch)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
+    D3D11_Readback *rb = (D3D11_Readback *)readback->driverdata;
+    int status = 0;
+
+    if (pixels) {
+        status = D3D11_ReadStagingTexture(data, rb->stagingTexture, rb->stagingFormat, &readback->rect, readback->format, pixels, pitch);
+    }
+    SAFE_RELEASE(rb->stagingTexture);
+    SDL_free(rb);
+    readback->driverdata = NULL;
+    return status;
+}
+
 static int D3D11_RenderPresent(SDL_Renderer *renderer)
 {
     D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
@@ -2402,6 +2570,33 @@ static int D3D11_RenderPresent(SDL_Renderer *renderer)
     return 0;
 }
 
+static SDL_bool D3D11_GetPresentTiming(SDL_Renderer *renderer, Uint64 *present_ns, Uint64 *refresh_interval_ns)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->driverdata;
+    DXGI_FRAME_STATISTICS stats;
+    Uint64 interval = 0;
+
+    /* This fails unless the swap chain is presenting directly to the
+       display (fullscreen or independent flip), so that's expected */
+    if (!data->swapChain || FAILED(IDXGISwapChain1_GetFrameStatistics(data->swapChain, &stats)) || stats.SyncQPCTime.QuadPart == 0) {
+        return SDL_FALSE;
+    }
+
+    if (data->lastSyncRefreshCount && stats.SyncRefreshCount > data->lastSyncRefreshCount &&
+        stats.SyncQPCTime.QuadPart > data->lastSyncQPCTime) {
+        interval = (SDL_PerformanceCounterToTicksNS(stats.SyncQPCTime.QuadPart) -
+                    SDL_PerformanceCounterToTicksNS(data->lastSyncQPCTime)) /
+                   (stats.SyncRefreshCount - data->lastSyncRefreshCount);
+    }
+    data->lastSyncRefreshCount = stats.SyncRefreshCount;
+    data->lastSyncQPCTime = stats.SyncQPCTime.QuadPart;
+
+    /* The QPC time is the performance counter on Windows */
+    *present_ns = SDL_PerformanceCounterToTicksNS(stats.SyncQPCTime.QuadPart);
+    *refresh_interval_ns = interval;
+    return SDL_TRUE;
+}
+
 #if SDL_WINAPI_FAMILY_PHONE
 /* no-op. */
 #else
@@ -2455,8 +2650,13 @@ SDL_Renderer *D3D11_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_p
     renderer->QueueDrawLines = D3D11_QueueDrawPoints; /* lines and points queue vertices the same way. */
     renderer->QueueGeometry = D3D11_QueueGeometry;
     renderer->RunCommandQueue = D3D11_RunCommandQueue;
+    renderer->indexed_quads = SDL_TRUE;
     renderer->RenderReadPixels = D3D11_RenderReadPixels;
+    renderer->QueueReadPixels = D3D11_QueueReadPixels;
+    renderer->QueryReadPixels = D3D11_QueryReadPixels;
+    renderer->FinishReadPixels = D3D11_FinishReadPixels;
     renderer->RenderPresent = D3D11_RenderPresent;
+    renderer->GetPresentTiming = D3D11_GetPresentTiming;
     renderer->DestroyTexture = D3D11_DestroyTexture;
     renderer->DestroyRenderer = D3D11_DestroyRenderer;
     renderer->info = D3D11_RenderDriver.info;
@@ -31,6 +31,7 @@
 #include "../../video/windows/SDL_windowswindow.h"
 #include "../SDL_sysrender.h"
 #include "../SDL_d3dmath.h"
+#include "../../timer/SDL_timer_c.h"
 
 #if defined(__XBOXONE__) || defined(__XBOXSERIES__)
 #include "SDL_render_d3d12_xbox.h"
@@ -173,6 +174,8 @@ typedef struct
     ID3D12CommandQueue *commandQueue;
     ID3D12GraphicsCommandList2 *commandList;
     DXGI_SWAP_EFFECT swapEffect;
+    UINT lastSyncRefreshCount;
+    LONGLONG lastSyncQPCTime;
     UINT swapFlags;
     SDL_bool pixelSizeChanged;
 
@@ -201,6 +204,12 @@ typedef struct
     D3D12_PipelineState *pipelineStates;
     D3D12_PipelineState *currentPipelineState;
 
+    /* Pipeline library, if the pipeline states are cached on disk */
+    char *pipelineLibraryPath;
+    void *pipelineLibraryData;
+    ID3D12PipelineLibrary *pipelineLibrary;
+    SDL_bool pipelineLibraryDirty;
+
     D3D12_VertexBuffer vertexBuffers[SDL_D3D12_NUM_VERTEX_BUFFERS];
     D3D12_CPU_DESCRIPTOR_HANDLE nearestPixelSampler;
     D3D12_CPU_DESCRIPTOR_HANDLE linearSampler;
@@ -257,6 +266,7 @@ static const GUID SDL_IID_ID3D12Fence = { 0x0a753dcf, 0xc4d8, 0x4b91, { 0xad, 0x
 static const GUID SDL_IID_ID3D12Resource = { 0x696442be, 0xa72e, 0x4059, { 0xbc, 0x79, 0x5b, 0x5c, 0x98, 0x04, 0x0f, 0xad } };
 static const GUID SDL_IID_ID3D12RootSignature = { 0xc54a6b66, 0x72df, 0x4ee8, { 0x8b, 0xe5, 0xa9, 0x46, 0xa1, 0x42, 0x92, 0x14 } };
 static const GUID SDL_IID_ID3D12PipelineState = { 0x765a30f3, 0xf624, 0x4c6f, { 0xa8, 0x28, 0xac, 0xe9, 0x48, 0x62, 0x24, 0x45 } };
+static const GUID SDL_IID_ID3D12PipelineLibrary = { 0xc64226a8, 0x9201, 0x46af, { 0xb4, 0xcc, 0x53, 0xfb, 0x9f, 0xf7, 0x41, 0x4f } };
 static const GUID SDL_IID_ID3D12Heap = { 0x6b3b2502, 0x6e51, 0x45b3, { 0x90, 0xee, 0x98, 0x84, 0x26, 0x5e, 0x8d, 0xf3 } };
 static const GUID SDL_IID_ID3D12InfoQueue = { 0x0742a90b, 0xc387, 0x483f, { 0xb9, 0x46, 0x30, 0xa7, 0xe4, 0xe6, 0x14, 0x58 } };
 
@@ -318,6 +328,70 @@ static DXGI_FORMAT SDLPixelFormatToDXGIMainResourceViewFormat(Uint32 sdlFormat)
 
 static void D3D12_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
 
+static void D3D12_CreatePipelineLibrary(D3D12_RenderData *data)
+{
+    size_t size = 0;
+    HRESULT result;
+
+    if (!data->pipelineLibraryPath) {
+        return;
+    }
+
+    /* The serialized library has to stay around for as long as the library is used */
+    data->pipelineLibraryData = SDL_LoadFile(data->pipelineLibraryPath, &size);
+    if (data->pipelineLibraryData) {
+        result = D3D_CALL(data->d3dDevice, CreatePipelineLibrary,
+                          data->pipelineLibraryData,
+                          size,
+                          D3D_GUID(SDL_IID_ID3D12PipelineLibrary),
+                          (void **)&data->pipelineLibrary);
+        if (SUCCEEDED(result)) {
+            return;
+        }
+
+        /* The cache was made with a different driver or adapter, start a new one */
+        SDL_free(data->pipelineLibraryData);
+        data->pipelineLibraryData = NULL;
+        data->pipelineLibraryDirty = SDL_TRUE;
+    }
+
+    result = D3D_CALL(data->d3dDevice, CreatePipelineLibrary,
+                      NULL,
+                      0,
+                      D3D_GUID(SDL_IID_ID3D12PipelineLibrary),
+                      (void **)&data->pipelineLibrary);
+    if (FAILED(result)) {
+        /* Not supported by the driver, the pipeline states will be created every time */
+        data->pipelineLibrary = NULL;
+    }
+}
+
+static void D3D12_SavePipelineLibrary(D3D12_RenderData *data)
+{
+    SIZE_T size;
+    void *blob;
+
+    if (!data->pipelineLibrary || !data->pipelineLibraryDirty) {
+        return;
+    }
+    data->pipelineLibraryDirty = SDL_FALSE;
+
+    size = D3D_CALL(data->pipelineLibrary, GetSerializedSize);
+    blob = SDL_malloc(size);
+    if (!blob) {
+        return;
+    }
+
+    if (SUCCEEDED(D3D_CALL(data->pipelineLibrary, Serialize, blob, size))) {
+        SDL_RWops *file = SDL_RWFromFile(data->pipelineLibraryPath, "wb");
+        if (file) {
+            SDL_RWwrite(file, blob, size);
+            SDL_RWclose(file);
+        }
+    }
+    SDL_free(blob);
+}
+
 static void D3D12_ReleaseAll(SDL_Renderer *renderer)
 {
     D3D12_RenderData *data = (D3D12_RenderData *)renderer->driverdata;
@@ -336,6 +410,8 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
     if (data) {
         int i;
 
+        D3D12_SavePipelineLibrary(data);
+
 #if !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
         SAFE_RELEASE(data->dxgiFactory);
         SAFE_RELEASE(data->dxgiAdapter);
@@ -363,6 +439,9 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
             SDL_free(data->pipelineStates);
             data->pipelineStateCount = 0;
         }
+        SAFE_RELEASE(data->pipelineLibrary);
+        SDL_free(data->pipelineLibraryData);
+        data->pipelineLibraryData = NULL;
 
         for (i = 0; i < NUM_ROOTSIGS; ++i) {
             SAFE_RELEASE(data->rootSignatures[i]);
@@ -515,6 +594,7 @@ static void D3D12_DestroyRenderer(SDL_Renderer *renderer)
     D3D12_WaitForGPU(data);
     D3D12_ReleaseAll(renderer);
     if (data) {
+        SDL_free(data->pipelineLibraryPath);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -604,6 +684,9 @@ static D3D12_PipelineState *D3D12_CreatePipelineState(SDL_Renderer *renderer,
     ID3D12PipelineState *pipelineState = NULL;
     D3D12_PipelineState *pipelineStates;
     HRESULT result = S_OK;
+    char name[64];
+    WCHAR pipelineName[64];
+    int i;
 
     SDL_zero(pipelineDesc);
     pipelineDesc.pRootSignature = data->rootSignatures[D3D12_GetRootSignatureType(shader)];
@@ -632,13 +715,40 @@ static D3D12_PipelineState *D3D12_CreatePipelineState(SDL_Renderer *renderer,
     pipelineDesc.SampleDesc.Count = 1;
     pipelineDesc.SampleDesc.Quality = 0;
 
-    result = D3D_CALL(data->d3dDevice, CreateGraphicsPipelineState,
-                      &pipelineDesc,
-                      D3D_GUID(SDL_IID_ID3D12PipelineState),
-                      (void **)&pipelineState);
-    if (FAILED(result)) {
-        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateGraphicsPipelineState"), result);
-        return NULL;
+    if (data->pipelineLibrary) {
+        /* The shaders may change between SDL versions, so the version is part of the key */
+        (void)SDL_snprintf(name, sizeof(name), "SDL-%d.%d.%d-%d-%x-%d-%d",
+                           SDL_MAJOR_VERSION, SDL_MINOR_VERSION, SDL_PATCHLEVEL,
+                           (int)shader, (unsigned int)blendMode, (int)topology, (int)rtvFormat);
+        for (i = 0; name[i]; ++i) {
+            pipelineName[i] = (WCHAR)name[i];
+        }
+        pipelineName[i] = 0;
+
+        result = D3D_CALL(data->pipelineLibrary, LoadGraphicsPipeline,
+                          pipelineName,
+                          &pipelineDesc,
+                          D3D_GUID(SDL_IID_ID3D12PipelineState),
+                          (void **)&pipelineState);
+        if (FAILED(result)) {
+            pipelineState = NULL;
+        }
+    }
+
+    if (!pipelineState) {
+        result = D3D_CALL(data->d3dDevice, CreateGraphicsPipelineState,
+                          &pipelineDesc,
+                          D3D_GUID(SDL_IID_ID3D12PipelineState),
+                          (void **)&pipelineState);
+        if (FAILED(result)) {
+            WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateGraphicsPipelineState"), result);
+            return NULL;
+        }
+
+        if (data->pipelineLibrary &&
+            SUCCEEDED(D3D_CALL(data->pipelineLibrary, StorePipeline, pipelineName, pipelineState))) {
+            data->pipelineLibraryDirty = SDL_TRUE;
+        }
     }
 
     pipelineStates = (D3D12_PipelineState *)SDL_realloc(data->pipelineStates, (data->pipelineStateCount + 1) * sizeof(*pipelineStates));
@@ -1025,6 +1135,9 @@ static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
         }
     }
 
+    /* Load the pipeline states cached by a previous run, if we have a file for them */
+    D3D12_CreatePipelineLibrary(data);
+
     /* Create all the default pipeline state objects
        (will add everything except custom blend states) */
     for (i = 0; i < NUM_SHADERS; ++i) {
@@ -1444,6 +1557,19 @@ static int GetTextureProperty(SDL_PropertiesID props, const char *name, ID3D12Re
     return 0;
 }
 
+static int GetSharedTextureProperty(D3D12_RenderData *rendererData, SDL_PropertiesID props, const char *name, ID3D12Resource **texture)
+{
+    HANDLE handle = (HANDLE)SDL_GetProperty(props, name, NULL);
+    if (handle && !*texture) {
+        /* This opens the memory of another device or process, there is no copy involved */
+        HRESULT result = D3D_CALL(rendererData->d3dDevice, OpenSharedHandle, handle, D3D_GUID(SDL_IID_ID3D12Resource), (void **)texture);
+        if (FAILED(result)) {
+            return WIN_SetErrorFromHRESULT(name, result);
+        }
+    }
+    return 0;
+}
+
 static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     D3D12_RenderData *rendererData = (D3D12_RenderData *)renderer->driverdata;
@@ -1488,7 +1614,8 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     heapProps.CreationNodeMask = 1;
     heapProps.VisibleNodeMask = 1;
 
-    if (GetTextureProperty(create_props, "d3d12.texture", &textureData->mainTexture) < 0) {
+    if (GetTextureProperty(create_props, "d3d12.texture", &textureData->mainTexture) < 0 ||
+        GetSharedTextureProperty(rendererData, create_props, "d3d12.shared_handle", &textureData->mainTexture) < 0) {
         return -1;
     }
     if (!textureData->mainTexture) {
@@ -1515,7 +1642,8 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         textureDesc.Width = (textureDesc.Width + 1) / 2;
         textureDesc.Height = (textureDesc.Height + 1) / 2;
 
-        if (GetTextureProperty(create_props, "d3d12.texture_u", &textureData->mainTextureU) < 0) {
+        if (GetTextureProperty(create_props, "d3d12.texture_u", &textureData->mainTextureU) < 0 ||
+            GetSharedTextureProperty(rendererData, create_props, "d3d12.shared_handle_u", &textureData->mainTextureU) < 0) {
             return -1;
         }
         if (!textureData->mainTextureU) {
@@ -1535,7 +1663,8 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         textureData->mainResourceStateU = D3D12_RESOURCE_STATE_COPY_DEST;
         SDL_SetProperty(SDL_GetTextureProperties(texture), "SDL.texture.d3d12.texture_u", textureData->mainTextureU);
 
-        if (GetTextureProperty(create_props, "d3d12.texture_v", &textureData->mainTextureV) < 0) {
+        if (GetTextureProperty(create_props, "d3d12.texture_v", &textureData->mainTextureV) < 0 ||
+            GetSharedTextureProperty(rendererData, create_props, "d3d12.shared_handle_v", &textureData->mainTextureV) < 0) {
             return -1;
         }
         if (!textureData->mainTextureV) {
@@ -2711,6 +2840,9 @@ static int D3D12_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -2960,6 +3092,35 @@ static int D3D12_RenderPresent(SDL_Renderer *renderer)
     }
 }
 
+#if !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
+static SDL_bool D3D12_GetPresentTiming(SDL_Renderer *renderer, Uint64 *present_ns, Uint64 *refresh_interval_ns)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->driverdata;
+    DXGI_FRAME_STATISTICS stats;
+    Uint64 interval = 0;
+
+    /* This fails unless the swap chain is presenting directly to the
+       display (fullscreen or independent flip), so that's expected */
+    if (!data->swapChain || FAILED(D3D_CALL(data->swapChain, GetFrameStatistics, &stats)) || stats.SyncQPCTime.QuadPart == 0) {
+        return SDL_FALSE;
+    }
+
+    if (data->lastSyncRefreshCount && stats.SyncRefreshCount > data->lastSyncRefreshCount &&
+        stats.SyncQPCTime.QuadPart > data->lastSyncQPCTime) {
+        interval = (SDL_PerformanceCounterToTicksNS(stats.SyncQPCTime.QuadPart) -
+                    SDL_PerformanceCounterToTicksNS(data->lastSyncQPCTime)) /
+                   (stats.SyncRefreshCount - data->lastSyncRefreshCount);
+    }
+    data->lastSyncRefreshCount = stats.SyncRefreshCount;
+    data->lastSyncQPCTime = stats.SyncQPCTime.QuadPart;
+
+    /* The QPC time is the performance counter on Windows */
+    *present_ns = SDL_PerformanceCounterToTicksNS(stats.SyncQPCTime.QuadPart);
+    *refresh_interval_ns = interval;
+    return SDL_TRUE;
+}
+#endif
+
 static int D3D12_SetVSync(SDL_Renderer *renderer, const int vsync)
 {
     if (vsync) {
@@ -2974,6 +3135,7 @@ SDL_Renderer *D3D12_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_p
 {
     SDL_Renderer *renderer;
     D3D12_RenderData *data;
+    const char *pipeline_cache;
 
     renderer = (SDL_Renderer *)SDL_calloc(1, sizeof(*renderer));
     if (!renderer) {
@@ -2991,6 +3153,11 @@ SDL_Renderer *D3D12_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_p
 
     data->identity = MatrixIdentity();
 
+    pipeline_cache = SDL_GetStringProperty(create_props, "pipeline_cache", NULL);
+    if (pipeline_cache && *pipeline_cache) {
+        data->pipelineLibraryPath = SDL_strdup(pipeline_cache);
+    }
+
     renderer->WindowEvent = D3D12_WindowEvent;
     renderer->SupportsBlendMode = D3D12_SupportsBlendMode;
     renderer->CreateTexture = D3D12_CreateTexture;
@@ -3011,6 +3178,9 @@ SDL_Renderer *D3D12_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_p
     renderer->RunCommandQueue = D3D12_RunCommandQueue;
     renderer->RenderReadPixels = D3D12_RenderReadPixels;
     renderer->RenderPresent = D3D12_RenderPresent;
+#if !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
+    renderer->GetPresentTiming = D3D12_GetPresentTiming;
+#endif
     renderer->DestroyTexture = D3D12_DestroyTexture;
     renderer->DestroyRenderer = D3D12_DestroyRenderer;
     renderer->info = D3D12_RenderDriver.info;
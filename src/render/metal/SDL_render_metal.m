@@ -91,6 +91,21 @@ typedef enum SDL_MetalFragmentFunction
     SDL_METAL_FRAGMENT_COUNT,
 } SDL_MetalFragmentFunction;
 
+/* Pipeline states can be cached on disk when the SDK has MTLBinaryArchive */
+#if defined(__MAC_11_0) || defined(__IPHONE_14_0) || defined(__TVOS_14_0)
+#define SDL_METAL_BINARY_ARCHIVE 1
+#endif
+
+/* Drawables report when they were shown when the SDK has presentedTime */
+#if defined(__MAC_10_15_4) || defined(__IPHONE_10_3) || defined(__TVOS_10_3)
+#define SDL_METAL_PRESENTED_TIME 1
+#endif
+
+/* Vertex data is streamed through this many shared buffers, so the CPU can
+   fill one while the GPU is still reading the others. */
+#define METAL_VERTEX_BUFFER_COUNT 3
+#define METAL_VERTEX_BUFFER_MIN_LENGTH (64 * 1024)
+
 typedef struct METAL_PipelineState
 {
     SDL_BlendMode blendMode;
@@ -136,6 +151,13 @@ typedef struct METAL_ShaderPipelines
 @property(nonatomic, assign) METAL_ShaderPipelines *activepipelines;
 @property(nonatomic, assign) METAL_ShaderPipelines *allpipelines;
 @property(nonatomic, assign) int pipelinescount;
+@property(nonatomic, retain) id mtlbinaryarchive;
+@property(nonatomic, retain) NSURL *mtlbinaryarchiveurl;
+@property(nonatomic, assign) BOOL mtlbinaryarchivedirty;
+@property(atomic, assign) CFTimeInterval mtlpresentedtime;
+@property(nonatomic, retain) NSMutableArray<id<MTLBuffer>> *mtlbufvertexring;
+@property(nonatomic, assign) int mtlbufvertexindex;
+@property(nonatomic, retain) dispatch_semaphore_t mtlbufvertexsemaphore;
 @end
 
 @implementation METAL_RenderData
@@ -159,6 +181,16 @@ typedef struct METAL_ShaderPipelines
 @implementation METAL_TextureData
 @end
 
+@interface METAL_Readback : NSObject
+@property(nonatomic, retain) id<MTLBuffer> mtlbuffer;
+@property(nonatomic, retain) id<MTLCommandBuffer> mtlcmdbuffer;
+@property(nonatomic, assign) Uint32 format;
+@property(nonatomic, assign) size_t pitch;
+@end
+
+@implementation METAL_Readback
+@end
+
 static SDL_bool IsMetalAvailable()
 {
 #if (defined(__MACOS__) && (MAC_OS_X_VERSION_MIN_REQUIRED < 101100))
@@ -325,8 +357,29 @@ static id<MTLRenderPipelineState> MakePipelineState(METAL_RenderData *data, META
 
     mtlpipedesc.label = [@(cache->label) stringByAppendingString:blendlabel];
 
-    state = [data.mtldevice newRenderPipelineStateWithDescriptor:mtlpipedesc error:&err];
-    SDL_assert(err == nil);
+    state = nil;
+#ifdef SDL_METAL_BINARY_ARCHIVE
+    if (@available(macOS 11.0, iOS 14.0, tvOS 14.0, *)) {
+        id<MTLBinaryArchive> archive = data.mtlbinaryarchive;
+        if (archive != nil) {
+            mtlpipedesc.binaryArchives = @[ archive ];
+            state = [data.mtldevice newRenderPipelineStateWithDescriptor:mtlpipedesc
+                                                                 options:MTLPipelineOptionFailOnBinaryArchiveMiss
+                                                              reflection:nil
+                                                                   error:nil];
+            if (state == nil) {
+                /* Not in the archive yet, compile it and save it for next time */
+                if ([archive addRenderPipelineFunctionsWithDescriptor:mtlpipedesc error:nil]) {
+                    data.mtlbinaryarchivedirty = YES;
+                }
+            }
+        }
+    }
+#endif
+    if (state == nil) {
+        state = [data.mtldevice newRenderPipelineStateWithDescriptor:mtlpipedesc error:&err];
+        SDL_assert(err == nil);
+    }
 
     pipeline.blendMode = blendmode;
     pipeline.pipe = (void *)CFBridgingRetain(state);
@@ -344,6 +397,52 @@ static id<MTLRenderPipelineState> MakePipelineState(METAL_RenderData *data, META
     }
 }
 
+static void LoadPipelineArchive(METAL_RenderData *data, const char *path)
+{
+#ifdef SDL_METAL_BINARY_ARCHIVE
+    if (@available(macOS 11.0, iOS 14.0, tvOS 14.0, *)) {
+        MTLBinaryArchiveDescriptor *desc;
+        id<MTLBinaryArchive> archive;
+        NSURL *url;
+
+        if (!path || !*path) {
+            return;
+        }
+
+        url = [NSURL fileURLWithPath:@(path)];
+        desc = [[MTLBinaryArchiveDescriptor alloc] init];
+        if ([[NSFileManager defaultManager] fileExistsAtPath:url.path]) {
+            desc.url = url;
+        }
+
+        archive = [data.mtldevice newBinaryArchiveWithDescriptor:desc error:nil];
+        if (archive == nil && desc.url != nil) {
+            /* The archive was made by a different OS or GPU, start a new one */
+            desc.url = nil;
+            archive = [data.mtldevice newBinaryArchiveWithDescriptor:desc error:nil];
+            data.mtlbinaryarchivedirty = YES;
+        }
+
+        data.mtlbinaryarchive = archive;
+        data.mtlbinaryarchiveurl = url;
+    }
+#endif
+}
+
+static void SavePipelineArchive(METAL_RenderData *data)
+{
+#ifdef SDL_METAL_BINARY_ARCHIVE
+    if (@available(macOS 11.0, iOS 14.0, tvOS 14.0, *)) {
+        id<MTLBinaryArchive> archive = data.mtlbinaryarchive;
+
+        if (archive != nil && data.mtlbinaryarchivedirty) {
+            [archive serializeToURL:data.mtlbinaryarchiveurl error:nil];
+            data.mtlbinaryarchivedirty = NO;
+        }
+    }
+#endif
+}
+
 static void MakePipelineCache(METAL_RenderData *data, METAL_PipelineCache *cache, const char *label,
                               MTLPixelFormat rtformat, SDL_MetalVertexFunction vertfn, SDL_MetalFragmentFunction fragfn)
 {
@@ -553,6 +652,7 @@ static int METAL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         id<MTLTexture> mtltexture, mtltextureUv;
         BOOL yuv, nv12;
         METAL_TextureData *texturedata;
+        IOSurfaceRef surface = (IOSurfaceRef)SDL_GetProperty(create_props, "metal.iosurface", NULL);
 
         switch (texture->format) {
         case SDL_PIXELFORMAT_ABGR8888:
@@ -585,7 +685,18 @@ static int METAL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
             }
         }
 
-        mtltexture = [data.mtldevice newTextureWithDescriptor:mtltexdesc];
+        if (surface) {
+            /* The texture samples the surface memory directly, there is no copy involved */
+            if (![data.mtldevice respondsToSelector:@selector(newTextureWithDescriptor:iosurface:plane:)]) {
+                return SDL_SetError("IOSurface textures are not supported on this device");
+            }
+            if (texture->format == SDL_PIXELFORMAT_IYUV || texture->format == SDL_PIXELFORMAT_YV12) {
+                return SDL_SetError("IOSurface textures must be NV12 or NV21 for YUV data");
+            }
+            mtltexture = [data.mtldevice newTextureWithDescriptor:mtltexdesc iosurface:surface plane:0];
+        } else {
+            mtltexture = [data.mtldevice newTextureWithDescriptor:mtltexdesc];
+        }
         if (mtltexture == nil) {
             return SDL_SetError("Texture allocation failed");
         }
@@ -607,7 +718,12 @@ static int METAL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
             mtltexdesc.height = (texture->h + 1) / 2;
         }
 
-        if (yuv || nv12) {
+        if (surface && nv12) {
+            mtltextureUv = [data.mtldevice newTextureWithDescriptor:mtltexdesc iosurface:surface plane:1];
+            if (mtltextureUv == nil) {
+                return SDL_SetError("Texture allocation failed");
+            }
+        } else if (yuv || nv12) {
             mtltextureUv = [data.mtldevice newTextureWithDescriptor:mtltexdesc];
             if (mtltextureUv == nil) {
                 return SDL_SetError("Texture allocation failed");
@@ -1328,7 +1444,13 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         statecache.projection_offset = 0;
         statecache.color_offset = 0;
 
-        // !!! FIXME: have a ring of pre-made MTLBuffers we cycle through? How expensive is creation?
+        // If there's a command buffer here unexpectedly (app requested one?). Commit it so we can start fresh.
+        // This also makes sure everything that used the vertex buffers so far will complete.
+        [data.mtlcmdencoder endEncoding];
+        [data.mtlcmdbuffer commit];
+        data.mtlcmdencoder = nil;
+        data.mtlcmdbuffer = nil;
+
         if (vertsize > 0) {
             /* We can memcpy to a shared buffer from the CPU and read it from the GPU
              * without any extra copying. It's a bit slower on macOS to read shared
@@ -1337,19 +1459,31 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
              * practices guide recommends this approach for streamed vertex data.
              * TODO: this buffer is also used for constants. Is performance still
              * good for those, or should we have a managed buffer for them? */
-            mtlbufvertex = [data.mtldevice newBufferWithLength:vertsize options:MTLResourceStorageModeShared];
-            mtlbufvertex.label = @"SDL vertex data";
+            const int index = data.mtlbufvertexindex;
+
+            /* Wait until the GPU is done with the last batch that used this buffer */
+            dispatch_semaphore_wait(data.mtlbufvertexsemaphore, DISPATCH_TIME_FOREVER);
+
+            mtlbufvertex = data.mtlbufvertexring[index];
+            if (mtlbufvertex.length < vertsize) {
+                NSUInteger length = METAL_VERTEX_BUFFER_MIN_LENGTH;
+                while (length < vertsize) {
+                    length *= 2;
+                }
+                mtlbufvertex = [data.mtldevice newBufferWithLength:length options:MTLResourceStorageModeShared];
+                if (mtlbufvertex == nil) {
+                    dispatch_semaphore_signal(data.mtlbufvertexsemaphore);
+                    return SDL_OutOfMemory();
+                }
+                mtlbufvertex.label = @"SDL vertex data";
+                data.mtlbufvertexring[index] = mtlbufvertex;
+            }
             SDL_memcpy([mtlbufvertex contents], vertices, vertsize);
 
+            data.mtlbufvertexindex = (index + 1) % METAL_VERTEX_BUFFER_COUNT;
             statecache.vertex_buffer = mtlbufvertex;
         }
 
-        // If there's a command buffer here unexpectedly (app requested one?). Commit it so we can start fresh.
-        [data.mtlcmdencoder endEncoding];
-        [data.mtlcmdbuffer commit];
-        data.mtlcmdencoder = nil;
-        data.mtlcmdbuffer = nil;
-
         while (cmd) {
             switch (cmd->command) {
             case SDL_RENDERCMD_SETVIEWPORT:
@@ -1437,24 +1571,53 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                 const size_t count = cmd->data.draw.count;
                 SDL_Texture *texture = cmd->data.draw.texture;
 
+                SDL_bool ready;
+
                 if (texture) {
-                    if (SetCopyState(renderer, cmd, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache)) {
-                        [data.mtlcmdencoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:count];
-                    }
+                    ready = SetCopyState(renderer, cmd, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache);
                 } else {
-                    if (SetDrawState(renderer, cmd, SDL_METAL_FRAGMENT_SOLID, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache)) {
+                    ready = SetDrawState(renderer, cmd, SDL_METAL_FRAGMENT_SOLID, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache);
+                }
+                if (ready) {
+                    if (cmd->data.draw.quads) {
+                        [data.mtlcmdencoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                                       indexCount:count / 4 * 6
+                                                        indexType:MTLIndexTypeUInt16
+                                                      indexBuffer:data.mtlbufquadindices
+                                                indexBufferOffset:0];
+                    } else {
                         [data.mtlcmdencoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:count];
                     }
                 }
                 break;
             }
 
+            case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+                break;
+
             case SDL_RENDERCMD_NO_OP:
                 break;
             }
             cmd = cmd->next;
         }
 
+        if (mtlbufvertex != nil) {
+            /* Command buffers complete in the order they were enqueued, so the
+               vertex buffer is free again once the last one using it is done. */
+            dispatch_semaphore_t semaphore = data.mtlbufvertexsemaphore;
+            id<MTLCommandBuffer> mtlcmdbuffer = data.mtlcmdbuffer;
+            if (mtlcmdbuffer == nil) {
+                /* Everything was already committed, so track an empty one */
+                mtlcmdbuffer = [data.mtlcmdqueue commandBuffer];
+            }
+            [mtlcmdbuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+              dispatch_semaphore_signal(semaphore);
+            }];
+            if (mtlcmdbuffer != data.mtlcmdbuffer) {
+                [mtlcmdbuffer commit];
+            }
+        }
+
         return 0;
     }
 }
@@ -1514,6 +1677,77 @@ static int METAL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
     }
 }
 
+static int METAL_QueueReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    @autoreleasepool {
+        METAL_RenderData *data = (__bridge METAL_RenderData *)renderer->driverdata;
+        const SDL_Rect *rect = &readback->rect;
+        id<MTLTexture> mtltexture;
+        id<MTLBlitCommandEncoder> blit;
+        METAL_Readback *rb;
+
+        if (!METAL_ActivateRenderCommandEncoder(renderer, MTLLoadActionLoad, NULL, nil)) {
+            return SDL_SetError("Failed to activate render command encoder (is your window in the background?");
+        }
+
+        [data.mtlcmdencoder endEncoding];
+        mtltexture = data.mtlpassdesc.colorAttachments[0].texture;
+
+        rb = [[METAL_Readback alloc] init];
+        // we only do BGRA8 or RGBA8 at the moment, so 4 will do.
+        rb.pitch = rect->w * 4UL;
+        rb.format = (mtltexture.pixelFormat == MTLPixelFormatBGRA8Unorm) ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_ABGR8888;
+        rb.mtlbuffer = [data.mtldevice newBufferWithLength:rb.pitch * rect->h options:MTLResourceStorageModeShared];
+        if (rb.mtlbuffer == nil) {
+            return SDL_SetError("Failed to allocate readback buffer");
+        }
+
+        blit = [data.mtlcmdbuffer blitCommandEncoder];
+        [blit copyFromTexture:mtltexture
+                         sourceSlice:0
+                         sourceLevel:0
+                        sourceOrigin:MTLOriginMake(rect->x, rect->y, 0)
+                          sourceSize:MTLSizeMake(rect->w, rect->h, 1)
+                            toBuffer:rb.mtlbuffer
+                   destinationOffset:0
+              destinationBytesPerRow:rb.pitch
+            destinationBytesPerImage:rb.pitch * rect->h];
+        [blit endEncoding];
+
+        /* Commit without waiting, the buffer is read once the command buffer has completed */
+        [data.mtlcmdbuffer commit];
+        rb.mtlcmdbuffer = data.mtlcmdbuffer;
+        data.mtlcmdencoder = nil;
+        data.mtlcmdbuffer = nil;
+
+        readback->driverdata = (void *)CFBridgingRetain(rb);
+        return 0;
+    }
+}
+
+static SDL_bool METAL_QueryReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    @autoreleasepool {
+        METAL_Readback *rb = (__bridge METAL_Readback *)readback->driverdata;
+        return (rb.mtlcmdbuffer.status >= MTLCommandBufferStatusCompleted);
+    }
+}
+
+static int METAL_FinishReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback, void *pixels, int pitch)
+{
+    @autoreleasepool {
+        METAL_Readback *rb = (METAL_Readback *)CFBridgingRelease(readback->driverdata);
+        int status = 0;
+
+        readback->driverdata = NULL;
+        if (pixels) {
+            [rb.mtlcmdbuffer waitUntilCompleted];
+            status = SDL_ConvertPixels(readback->rect.w, readback->rect.h, rb.format, rb.mtlbuffer.contents, (int)rb.pitch, readback->format, pixels, pitch);
+        }
+        return status;
+    }
+}
+
 static int METAL_RenderPresent(SDL_Renderer *renderer)
 {
     @autoreleasepool {
@@ -1537,6 +1771,18 @@ static int METAL_RenderPresent(SDL_Renderer *renderer)
         //  But we'll still try to commit the command buffer in case it was already enqueued.
         if (ready) {
             SDL_assert(data.mtlbackbuffer != nil);
+#ifdef SDL_METAL_PRESENTED_TIME
+            if (@available(macOS 10.15.4, iOS 10.3, tvOS 10.3, *)) {
+                /* This is called on another thread once the frame is on screen */
+                __weak METAL_RenderData *weakdata = data;
+                [data.mtlbackbuffer addPresentedHandler:^(id<MTLDrawable> drawable) {
+                  const CFTimeInterval presented = drawable.presentedTime;
+                  if (presented > 0.0) { /* it's zero if the frame was dropped */
+                      weakdata.mtlpresentedtime = presented;
+                  }
+                }];
+            }
+#endif
             [data.mtlcmdbuffer presentDrawable:data.mtlbackbuffer];
         }
 
@@ -1571,6 +1817,7 @@ static void METAL_DestroyRenderer(SDL_Renderer *renderer)
                 [data.mtlcmdencoder endEncoding];
             }
 
+            SavePipelineArchive(data);
             DestroyAllPipelines(data.allpipelines, data.pipelinescount);
 
             /* Release the metal view instead of destroying it,
@@ -1592,6 +1839,32 @@ static void *METAL_GetMetalLayer(SDL_Renderer *renderer)
     }
 }
 
+#ifdef SDL_METAL_PRESENTED_TIME
+static SDL_bool METAL_GetPresentTiming(SDL_Renderer *renderer, Uint64 *present_ns, Uint64 *refresh_interval_ns)
+{
+    @autoreleasepool {
+        METAL_RenderData *data = (__bridge METAL_RenderData *)renderer->driverdata;
+        const CFTimeInterval presented = data.mtlpresentedtime;
+        const CFTimeInterval now = CACurrentMediaTime();
+        const Uint64 ticks = SDL_GetTicksNS();
+        Uint64 age;
+
+        if (presented <= 0.0 || presented > now) {
+            return SDL_FALSE;
+        }
+
+        /* presentedTime is in the CACurrentMediaTime() timebase */
+        age = (Uint64)((now - presented) * SDL_NS_PER_SECOND);
+        if (age >= ticks) {
+            return SDL_FALSE;
+        }
+        *present_ns = ticks - age;
+        *refresh_interval_ns = 0;
+        return SDL_TRUE;
+    }
+}
+#endif
+
 static void *METAL_GetMetalCommandEncoder(SDL_Renderer *renderer)
 {
     @autoreleasepool {
@@ -1664,7 +1937,7 @@ static SDL_Renderer *METAL_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
         NSError *err = nil;
         dispatch_data_t mtllibdata;
         char *constantdata;
-        int maxtexsize, quadcount = UINT16_MAX / 4;
+        int maxtexsize, quadcount = SDL_RENDER_MAX_QUADS;
         UInt16 *indexdata;
         size_t indicessize = sizeof(UInt16) * quadcount * 6;
         MTLSamplerDescriptor *samplerdesc;
@@ -1824,6 +2097,9 @@ static SDL_Renderer *METAL_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
         SDL_assert(err == nil);
         data.mtllibrary.label = @"SDL Metal renderer shader library";
 
+        /* Load the pipeline states cached by a previous run, if we have a file for them */
+        LoadPipelineArchive(data, SDL_GetStringProperty(create_props, "pipeline_cache", NULL));
+
         /* Do some shader pipeline state loading up-front rather than on demand. */
         data.pipelinescount = 0;
         data.allpipelines = NULL;
@@ -1852,21 +2128,9 @@ static SDL_Renderer *METAL_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
 
         mtlbufquadindicesstaging = [data.mtldevice newBufferWithLength:indicessize options:MTLResourceStorageModeShared];
 
-        /* Quads in the following vertex order (matches the FillRects vertices):
-         * 1---3
-         * | \ |
-         * 0---2
-         */
+        /* Quads in the same vertex order as rects queued as geometry */
         indexdata = [mtlbufquadindicesstaging contents];
-        for (int i = 0; i < quadcount; i++) {
-            indexdata[i * 6 + 0] = i * 4 + 0;
-            indexdata[i * 6 + 1] = i * 4 + 1;
-            indexdata[i * 6 + 2] = i * 4 + 2;
-
-            indexdata[i * 6 + 3] = i * 4 + 2;
-            indexdata[i * 6 + 4] = i * 4 + 1;
-            indexdata[i * 6 + 5] = i * 4 + 3;
-        }
+        SDL_GetRenderQuadIndices(renderer, indexdata, quadcount);
 
         mtlbufconstants = [data.mtldevice newBufferWithLength:CONSTANTS_LENGTH options:MTLResourceStorageModePrivate];
         data.mtlbufconstants = mtlbufconstants;
@@ -1876,6 +2140,14 @@ static SDL_Renderer *METAL_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
         data.mtlbufquadindices = mtlbufquadindices;
         data.mtlbufquadindices.label = @"SDL quad index buffer";
 
+        data.mtlbufvertexring = [NSMutableArray arrayWithCapacity:METAL_VERTEX_BUFFER_COUNT];
+        for (int i = 0; i < METAL_VERTEX_BUFFER_COUNT; ++i) {
+            id<MTLBuffer> mtlbufvertex = [data.mtldevice newBufferWithLength:METAL_VERTEX_BUFFER_MIN_LENGTH options:MTLResourceStorageModeShared];
+            mtlbufvertex.label = @"SDL vertex data";
+            [data.mtlbufvertexring addObject:mtlbufvertex];
+        }
+        data.mtlbufvertexsemaphore = dispatch_semaphore_create(METAL_VERTEX_BUFFER_COUNT);
+
         cmdbuffer = [data.mtlcmdqueue commandBuffer];
         blitcmd = [cmdbuffer blitCommandEncoder];
 
@@ -1905,9 +2177,18 @@ static SDL_Renderer *METAL_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
         renderer->QueueDrawPoints = METAL_QueueDrawPoints;
         renderer->QueueDrawLines = METAL_QueueDrawLines;
         renderer->QueueGeometry = METAL_QueueGeometry;
+        renderer->indexed_quads = SDL_TRUE;
         renderer->RunCommandQueue = METAL_RunCommandQueue;
         renderer->RenderReadPixels = METAL_RenderReadPixels;
+        renderer->QueueReadPixels = METAL_QueueReadPixels;
+        renderer->QueryReadPixels = METAL_QueryReadPixels;
+        renderer->FinishReadPixels = METAL_FinishReadPixels;
         renderer->RenderPresent = METAL_RenderPresent;
+#ifdef SDL_METAL_PRESENTED_TIME
+        if (@available(macOS 10.15.4, iOS 10.3, tvOS 10.3, *)) {
+            renderer->GetPresentTiming = METAL_GetPresentTiming;
+        }
+#endif
         renderer->DestroyTexture = METAL_DestroyTexture;
         renderer->DestroyRenderer = METAL_DestroyRenderer;
         renderer->SetVSync = METAL_SetVSync;
@@ -43,6 +43,37 @@
 #define RENDERER_CONTEXT_MAJOR 2
 #define RENDERER_CONTEXT_MINOR 1
 
+/* When the driver supports persistently mapped buffers, vertices are
+   streamed through a ring of segments. Each flush suballocates from the
+   current segment and moves on to the next one when it's full, waiting on
+   that segment's fence first, so we never write to memory the GPU is still
+   reading. */
+#ifdef GL_ARB_buffer_storage
+#define SDL_GL_VERTEX_RING
+#define GL_VERTEX_RING_SEGMENTS     3
+#define GL_VERTEX_RING_MIN_SEGMENT  (64 * 1024)
+#endif
+
+/* SDL_UpdateTextureAsync() copies through pixel buffer objects, fenced so
+   they can be recycled once the GPU has consumed them. */
+#ifdef GL_ARB_sync
+#define SDL_GL_ASYNC_UPLOAD
+#define GL_MAX_FREE_UPLOAD_BUFFERS  4
+#endif
+
+/* SDL_RenderReadPixelsAsync() reads into pixel buffer objects, fenced so
+   they are only mapped once the GPU has written them. */
+#ifdef GL_ARB_sync
+#define SDL_GL_ASYNC_READBACK
+#endif
+
+/* Render statistics time each frame with a timer query, the results are
+   read a few frames later so we never stall waiting for them. */
+#ifdef GL_ARB_timer_query
+#define SDL_GL_GPU_TIMER
+#define GL_GPU_TIMER_FRAMES 4
+#endif
+
 /* OpenGL renderer implementation */
 
 /* Details on optimizing the texture path on macOS:
@@ -60,6 +91,18 @@ struct GL_FBOList
     GL_FBOList *next;
 };
 
+#ifdef SDL_GL_ASYNC_UPLOAD
+typedef struct GL_TextureUpload GL_TextureUpload;
+
+struct GL_TextureUpload
+{
+    Uint64 ticket;
+    GLuint buffer;
+    GLsync fence;
+    GL_TextureUpload *next;
+};
+#endif
+
 typedef struct
 {
     SDL_bool viewport_dirty;
@@ -80,6 +123,8 @@ typedef struct
     SDL_bool texture_array;
     Uint32 color;
     Uint32 clear_color;
+    GLfloat point_size;
+    GLfloat line_width;
 } GL_DrawStateCache;
 
 typedef struct
@@ -119,6 +164,69 @@ typedef struct
     /* Shader support */
     GL_ShaderContext *shaders;
 
+    /* Instanced arrays, from OpenGL 3.3 or GL_ARB_instanced_arrays */
+    PFNGLVERTEXATTRIBPOINTERARBPROC glVertexAttribPointer;
+    PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray;
+    PFNGLDISABLEVERTEXATTRIBARRAYARBPROC glDisableVertexAttribArray;
+    PFNGLVERTEXATTRIBDIVISORARBPROC glVertexAttribDivisor;
+    PFNGLDRAWARRAYSINSTANCEDARBPROC glDrawArraysInstanced;
+
+#ifdef GL_ARB_sync
+    /* Buffer object and sync support */
+    SDL_bool GL_ARB_sync_supported;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLMAPBUFFERPROC glMapBuffer;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+#endif
+
+#ifdef SDL_GL_ASYNC_UPLOAD
+    /* Pixel buffer object uploads, in flight ones are in submission order */
+    SDL_bool async_upload_supported;
+    GL_TextureUpload *uploads;
+    GL_TextureUpload *uploads_tail;
+    GL_TextureUpload *free_uploads;
+    int num_free_uploads;
+#endif
+
+#ifdef SDL_GL_VERTEX_RING
+    /* Persistently mapped vertex buffer support */
+    SDL_bool vertex_ring_supported;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    GLuint vertex_ring;
+    Uint8 *vertex_ring_memory;
+    size_t vertex_ring_segment_size;
+    int vertex_ring_segment;
+    size_t vertex_ring_offset;
+    GLsync vertex_ring_fences[GL_VERTEX_RING_SEGMENTS];
+#endif
+
+#ifdef SDL_GL_GPU_TIMER
+    /* GPU frame time queries */
+    SDL_bool gpu_timer_supported;
+    PFNGLGENQUERIESPROC glGenQueries;
+    PFNGLDELETEQUERIESPROC glDeleteQueries;
+    PFNGLBEGINQUERYPROC glBeginQuery;
+    PFNGLENDQUERYPROC glEndQuery;
+    PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+    GLuint gpu_timers[GL_GPU_TIMER_FRAMES];
+    SDL_bool gpu_timer_pending[GL_GPU_TIMER_FRAMES];
+    int gpu_timer_frame;
+    SDL_bool gpu_timer_active;
+    SDL_bool gpu_time_valid;
+    Uint64 gpu_time;
+#endif
+
+    /* Client side indices for drawing quads, see SDL_GetRenderQuadIndices() */
+    Uint16 *quad_indices;
+
     GL_DrawStateCache drawstate;
 } GL_RenderData;
 
@@ -139,6 +247,7 @@ typedef struct
     /* YUV texture support */
     SDL_bool yuv;
     SDL_bool nv12;
+    SDL_bool packed; /* YUY2, UYVY and YVYU, utexture holds the same pixels as RGBA for the chroma */
     GLuint utexture;
     SDL_bool utexture_external;
     GLuint vtexture;
@@ -430,7 +539,15 @@ static SDL_bool convert_format(GL_RenderData *renderdata, Uint32 pixel_format,
         *format = GL_YCBCR_422_APPLE;
         *type = GL_UNSIGNED_SHORT_8_8_APPLE;
         break;
+#else
+    case SDL_PIXELFORMAT_UYVY:
 #endif
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_YVYU:
+        *internalFormat = GL_LUMINANCE_ALPHA;
+        *format = GL_LUMINANCE_ALPHA;
+        *type = GL_UNSIGNED_BYTE;
+        break;
     default:
         return SDL_FALSE;
     }
@@ -652,9 +769,32 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
                                  (texture_h + 1) / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
         SDL_SetNumberProperty(props, "SDL.texture.opengl.texture_uv", data->utexture);
     }
+
+    if (format == GL_LUMINANCE_ALPHA) {
+        /* Packed YUV is sampled twice, the luma from a LUMINANCE_ALPHA texture
+           and the chroma from a half width RGBA texture of the same pixels */
+        data->packed = SDL_TRUE;
+
+        renderdata->glGenTextures(1, &data->utexture);
+        renderdata->glBindTexture(textype, data->utexture);
+        renderdata->glTexParameteri(textype, GL_TEXTURE_MIN_FILTER,
+                                    scaleMode);
+        renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER,
+                                    scaleMode);
+        renderdata->glTexParameteri(textype, GL_TEXTURE_WRAP_S,
+                                    GL_CLAMP_TO_EDGE);
+        renderdata->glTexParameteri(textype, GL_TEXTURE_WRAP_T,
+                                    GL_CLAMP_TO_EDGE);
+        renderdata->glTexImage2D(textype, 0, GL_RGBA8, (texture_w + 1) / 2,
+                                 texture_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
 #endif
 
-    if (texture->format == SDL_PIXELFORMAT_ABGR8888 || texture->format == SDL_PIXELFORMAT_ARGB8888) {
+    if (texture->distance_field == SDL_DISTANCEFIELD_SDF) {
+        data->shader = SHADER_SDF;
+    } else if (texture->distance_field == SDL_DISTANCEFIELD_MSDF) {
+        data->shader = SHADER_MSDF;
+    } else if (texture->format == SDL_PIXELFORMAT_ABGR8888 || texture->format == SDL_PIXELFORMAT_ARGB8888) {
         data->shader = SHADER_RGBA;
     } else {
         data->shader = SHADER_RGB;
@@ -703,6 +843,30 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
             break;
         }
     }
+
+    if (data->packed) {
+        int shader;
+
+        if (texture->format == SDL_PIXELFORMAT_YUY2) {
+            shader = SHADER_YUY2_JPEG;
+        } else if (texture->format == SDL_PIXELFORMAT_UYVY) {
+            shader = SHADER_UYVY_JPEG;
+        } else {
+            shader = SHADER_YVYU_JPEG;
+        }
+        /* The BT601 and BT709 variants follow the JPEG one */
+        switch (SDL_GetYUVConversionModeForResolution(texture->w, texture->h)) {
+        case SDL_YUV_CONVERSION_BT709:
+            ++shader;
+            SDL_FALLTHROUGH;
+        case SDL_YUV_CONVERSION_BT601:
+            ++shader;
+            break;
+        default:
+            break;
+        }
+        data->shader = (GL_Shader)shader;
+    }
 #endif /* SDL_HAVE_YUV */
 
     return GL_CheckError("", renderer);
@@ -765,10 +929,155 @@ static int GL_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                                     (rect->w + 1) / 2, (rect->h + 1) / 2,
                                     GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, pixels);
     }
+
+    if (data->packed) {
+        /* The same pixels again, two to a texel */
+        renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (pitch / 4));
+        renderdata->glBindTexture(textype, data->utexture);
+        renderdata->glTexSubImage2D(textype, 0, rect->x / 2, rect->y,
+                                    (rect->w + 1) / 2, rect->h,
+                                    GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
 #endif
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
+#ifdef SDL_GL_ASYNC_UPLOAD
+static void GL_DestroyTextureUploads(GL_RenderData *data)
+{
+    while (data->uploads) {
+        GL_TextureUpload *next = data->uploads->next;
+        data->glDeleteSync(data->uploads->fence);
+        data->glDeleteBuffers(1, &data->uploads->buffer);
+        SDL_free(data->uploads);
+        data->uploads = next;
+    }
+    data->uploads_tail = NULL;
+
+    while (data->free_uploads) {
+        GL_TextureUpload *next = data->free_uploads->next;
+        data->glDeleteBuffers(1, &data->free_uploads->buffer);
+        SDL_free(data->free_uploads);
+        data->free_uploads = next;
+    }
+    data->num_free_uploads = 0;
+}
+
+/* Recycle the buffers of uploads the GPU has finished with, returns SDL_TRUE if the ticket was among them */
+static SDL_bool GL_RetireTextureUploads(GL_RenderData *data, Uint64 ticket, SDL_bool wait)
+{
+    SDL_bool found = SDL_FALSE;
+
+    while (data->uploads && !found) {
+        GL_TextureUpload *upload = data->uploads;
+        const SDL_bool waiting = (wait && upload->ticket <= ticket);
+        GLenum result;
+
+        do {
+            result = data->glClientWaitSync(upload->fence, GL_SYNC_FLUSH_COMMANDS_BIT, waiting ? 1000000000 /* 1 second */ : 0);
+        } while (waiting && result == GL_TIMEOUT_EXPIRED);
+
+        if (result == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+
+        /* Fences are signaled in order, so everything up to here is done */
+        found = (upload->ticket == ticket);
+        data->uploads = upload->next;
+        if (!data->uploads) {
+            data->uploads_tail = NULL;
+        }
+        data->glDeleteSync(upload->fence);
+        upload->fence = NULL;
+        if (data->num_free_uploads < GL_MAX_FREE_UPLOAD_BUFFERS) {
+            upload->next = data->free_uploads;
+            data->free_uploads = upload;
+            ++data->num_free_uploads;
+        } else {
+            data->glDeleteBuffers(1, &upload->buffer);
+            SDL_free(upload);
+        }
+    }
+    return found;
+}
+
+static int GL_UpdateTextureAsync(SDL_Renderer *renderer, SDL_Texture *texture,
+                                 const SDL_Rect *rect, const void *pixels, int pitch, Uint64 ticket)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    const size_t length = (size_t)rect->w * SDL_BYTESPERPIXEL(texture->format);
+    const size_t size = (size_t)(rect->h - 1) * pitch + length;
+    GL_TextureUpload *upload;
+    Uint8 *dst;
+    int row;
+    int retval;
+
+    GL_ActivateRenderer(renderer);
+
+    GL_RetireTextureUploads(data, 0, SDL_FALSE);
+
+    if (data->free_uploads) {
+        upload = data->free_uploads;
+        data->free_uploads = upload->next;
+        --data->num_free_uploads;
+    } else {
+        upload = (GL_TextureUpload *)SDL_calloc(1, sizeof(*upload));
+        if (!upload) {
+            return SDL_OutOfMemory();
+        }
+        data->glGenBuffers(1, &upload->buffer);
+    }
+
+    /* Orphan the old storage so we never wait on the driver here */
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, upload->buffer);
+    data->glBufferData(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptr)size, NULL, GL_STREAM_DRAW);
+    dst = (Uint8 *)data->glMapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY);
+    if (!dst) {
+        data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        data->glDeleteBuffers(1, &upload->buffer);
+        SDL_free(upload);
+        return SDL_SetError("Couldn't map pixel buffer");
+    }
+    for (row = 0; row < rect->h; ++row) {
+        SDL_memcpy(dst + row * pitch, (const Uint8 *)pixels + row * pitch, length);
+    }
+    data->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
+
+    /* With the buffer bound, the pixel pointer is an offset into it */
+    retval = GL_UpdateTexture(renderer, texture, rect, NULL, pitch);
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+    upload->ticket = ticket;
+    upload->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    upload->next = NULL;
+    if (data->uploads_tail) {
+        data->uploads_tail->next = upload;
+    } else {
+        data->uploads = upload;
+    }
+    data->uploads_tail = upload;
+
+    return retval;
+}
+
+static SDL_bool GL_QueryTextureUpload(SDL_Renderer *renderer, Uint64 ticket, SDL_bool wait)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    GL_TextureUpload *upload;
+
+    GL_ActivateRenderer(renderer);
+
+    GL_RetireTextureUploads(data, ticket, wait);
+
+    for (upload = data->uploads; upload; upload = upload->next) {
+        if (upload->ticket == ticket) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+#endif /* SDL_GL_ASYNC_UPLOAD */
+
 #if SDL_HAVE_YUV
 static int GL_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
                                const SDL_Rect *rect,
@@ -886,7 +1195,8 @@ static void GL_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture,
     }
 
     if (texture->format == SDL_PIXELFORMAT_NV12 ||
-        texture->format == SDL_PIXELFORMAT_NV21) {
+        texture->format == SDL_PIXELFORMAT_NV21 ||
+        data->packed) {
         renderdata->glBindTexture(textype, data->utexture);
         renderdata->glTexParameteri(textype, GL_TEXTURE_MIN_FILTER, glScaleMode);
         renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER, glScaleMode);
@@ -935,6 +1245,7 @@ static int GL_QueueSetViewport(SDL_Renderer *renderer, SDL_RenderCommand *cmd)
 
 static int GL_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FPoint *points, int count)
 {
+    const GLfloat size = cmd->data.draw.size;
     GLfloat *verts = (GLfloat *)SDL_AllocateRenderVertices(renderer, count * 2 * sizeof(GLfloat), 0, &cmd->data.draw.first);
     int i;
 
@@ -942,10 +1253,11 @@ static int GL_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd, co
         return -1;
     }
 
+    /* Points are drawn glPointSize() wide, centered on the scaled pixel. */
     cmd->data.draw.count = count;
     for (i = 0; i < count; i++) {
-        *(verts++) = 0.5f + points[i].x;
-        *(verts++) = 0.5f + points[i].y;
+        *(verts++) = (0.5f + points[i].x) * size;
+        *(verts++) = (0.5f + points[i].y) * size;
     }
 
     return 0;
@@ -955,6 +1267,10 @@ static int GL_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd, con
 {
     int i;
     GLfloat prevx, prevy;
+    const GLfloat size = cmd->data.draw.size;
+    /* Lines wider than a pixel stop at the center of their end pixels,
+       so push them out half a pixel to cover them like scaled rects. */
+    const GLfloat bump = (size > 1.0f) ? (0.5f * size) : 0.25f;
     const size_t vertlen = (sizeof(GLfloat) * 2) * count;
     GLfloat *verts = (GLfloat *)SDL_AllocateRenderVertices(renderer, vertlen, 0, &cmd->data.draw.first);
 
@@ -964,8 +1280,13 @@ static int GL_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd, con
     cmd->data.draw.count = count;
 
     /* 0.5f offset to hit the center of the pixel. */
-    prevx = 0.5f + points->x;
-    prevy = 0.5f + points->y;
+    prevx = (0.5f + points->x) * size;
+    prevy = (0.5f + points->y) * size;
+    if (size > 1.0f) {
+        const GLfloat angle = SDL_atan2f(points[1].y - points[0].y, points[1].x - points[0].x);
+        prevx -= (SDL_cosf(angle) * bump);
+        prevy -= (SDL_sinf(angle) * bump);
+    }
     *(verts++) = prevx;
     *(verts++) = prevy;
 
@@ -976,14 +1297,14 @@ static int GL_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd, con
     for (i = 1; i < count; i++) {
         const GLfloat xstart = prevx;
         const GLfloat ystart = prevy;
-        const GLfloat xend = points[i].x + 0.5f; /* 0.5f to hit pixel center. */
-        const GLfloat yend = points[i].y + 0.5f;
+        const GLfloat xend = (points[i].x + 0.5f) * size; /* 0.5f to hit pixel center. */
+        const GLfloat yend = (points[i].y + 0.5f) * size;
         /* bump a little in the direction we are moving in. */
         const GLfloat deltax = xend - xstart;
         const GLfloat deltay = yend - ystart;
         const GLfloat angle = SDL_atan2f(deltay, deltax);
-        prevx = xend + (SDL_cosf(angle) * 0.25f);
-        prevy = yend + (SDL_sinf(angle) * 0.25f);
+        prevx = xend + (SDL_cosf(angle) * bump);
+        prevy = yend + (SDL_sinf(angle) * bump);
         *(verts++) = prevx;
         *(verts++) = prevy;
     }
@@ -1014,6 +1335,15 @@ static int GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     cmd->data.draw.count = count;
     size_indices = indices ? size_indices : 0;
 
+    if (texture && texturedata->texw == 1.0f && texturedata->texh == 1.0f &&
+        scale_x == 1.0f && scale_y == 1.0f &&
+        SDL_IsRenderVertexArray(xy, xy_stride, color, color_stride, uv, uv_stride)) {
+        /* These are already our vertices */
+        SDL_COMPILE_TIME_ASSERT(gl_vertex_size, sizeof(SDL_Vertex) == 2 * sizeof(GLfloat) + 4 * sizeof(Uint8) + 2 * sizeof(GLfloat));
+        SDL_CopyRenderVertices((SDL_Vertex *)verts, (const SDL_Vertex *)xy, count, indices, size_indices);
+        return 0;
+    }
+
     for (i = 0; i < count; i++) {
         int j;
         float *xy_;
@@ -1046,6 +1376,40 @@ static int GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
+static int GL_QueueInstances(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture,
+                             const SDL_TextureInstance *instances, int count, float scale_x, float scale_y)
+{
+    /* Drawn as a triangle strip, see GL_RunCommandQueue() */
+    static const GLfloat corners[8] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+    /* This is the atlas page for textures packed into one */
+    GL_TextureData *texturedata = (GL_TextureData *)cmd->data.draw.texture->driverdata;
+    SDL_RenderInstance *quads;
+    GLfloat *verts;
+    int i;
+
+    SDL_COMPILE_TIME_ASSERT(gl_instance_size, sizeof(SDL_RenderInstance) == 10 * sizeof(GLfloat) + 4 * sizeof(Uint8));
+
+    verts = (GLfloat *)SDL_AllocateRenderVertices(renderer, sizeof(corners) + count * sizeof(*quads), 0, &cmd->data.draw.first);
+    if (!verts) {
+        return -1;
+    }
+    SDL_memcpy(verts, corners, sizeof(corners));
+
+    quads = (SDL_RenderInstance *)(verts + SDL_arraysize(corners));
+    count = SDL_GetRenderInstances(texture, instances, count, scale_x, scale_y, quads);
+    if (texturedata->texw != 1.0f || texturedata->texh != 1.0f) {
+        for (i = 0; i < count; ++i) {
+            quads[i].uv[0] *= texturedata->texw;
+            quads[i].uv[1] *= texturedata->texh;
+            quads[i].uv[2] *= texturedata->texw;
+            quads[i].uv[3] *= texturedata->texh;
+        }
+    }
+    cmd->data.draw.count = count;
+
+    return 0;
+}
+
 static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const GL_Shader shader)
 {
     const SDL_BlendMode blend = cmd->data.draw.blend;
@@ -1103,7 +1467,12 @@ static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const
         data->drawstate.blend = blend;
     }
 
-    if (data->shaders && (shader != data->drawstate.shader)) {
+    if (cmd->command == SDL_RENDERCMD_DRAW_INSTANCES) {
+        if (!GL_SelectInstancedShader(data->shaders, shader)) {
+            return SDL_SetError("Couldn't compile instanced shader");
+        }
+        data->drawstate.shader = SHADER_INVALID; /* The next draw selects a regular program again */
+    } else if (data->shaders && (shader != data->drawstate.shader)) {
         GL_SelectShader(data->shaders, shader);
         data->drawstate.shader = shader;
     }
@@ -1120,7 +1489,7 @@ static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const
 
     vertex_array = cmd->command == SDL_RENDERCMD_DRAW_POINTS || cmd->command == SDL_RENDERCMD_DRAW_LINES || cmd->command == SDL_RENDERCMD_GEOMETRY;
     color_array = cmd->command == SDL_RENDERCMD_GEOMETRY;
-    texture_array = cmd->data.draw.texture != NULL;
+    texture_array = cmd->data.draw.texture != NULL && cmd->command != SDL_RENDERCMD_DRAW_INSTANCES;
 
     if (vertex_array != data->drawstate.vertex_array) {
         if (vertex_array) {
@@ -1159,7 +1528,9 @@ static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
     SDL_Texture *texture = cmd->data.draw.texture;
     const GL_TextureData *texturedata = (GL_TextureData *)texture->driverdata;
 
-    SetDrawState(data, cmd, texturedata->shader);
+    if (SetDrawState(data, cmd, texturedata->shader) < 0) {
+        return -1;
+    }
 
     if (texture != data->drawstate.texture) {
         const GLenum textype = data->textype;
@@ -1175,7 +1546,7 @@ static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
             }
             data->glBindTexture(textype, texturedata->utexture);
         }
-        if (texturedata->nv12) {
+        if (texturedata->nv12 || texturedata->packed) {
             if (data->GL_ARB_multitexture_supported) {
                 data->glActiveTextureARB(GL_TEXTURE1_ARB);
             }
@@ -1193,10 +1564,104 @@ static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
     return 0;
 }
 
+#ifdef SDL_GL_VERTEX_RING
+static void GL_DestroyVertexRing(GL_RenderData *data)
+{
+    int i;
+
+    for (i = 0; i < GL_VERTEX_RING_SEGMENTS; ++i) {
+        if (data->vertex_ring_fences[i]) {
+            data->glDeleteSync(data->vertex_ring_fences[i]);
+            data->vertex_ring_fences[i] = NULL;
+        }
+    }
+    if (data->vertex_ring) {
+        /* This also unmaps the buffer, the driver keeps it alive until the GPU is done with it */
+        data->glDeleteBuffers(1, &data->vertex_ring);
+        data->vertex_ring = 0;
+    }
+    data->vertex_ring_memory = NULL;
+    data->vertex_ring_segment_size = 0;
+    data->vertex_ring_segment = 0;
+    data->vertex_ring_offset = 0;
+}
+
+static int GL_CreateVertexRing(GL_RenderData *data, size_t segment_size)
+{
+    const GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+    const GLsizeiptr size = (GLsizeiptr)(segment_size * GL_VERTEX_RING_SEGMENTS);
+
+    data->glGenBuffers(1, &data->vertex_ring);
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_ring);
+    data->glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+    data->vertex_ring_memory = (Uint8 *)data->glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    if (!data->vertex_ring_memory) {
+        GL_DestroyVertexRing(data);
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return SDL_SetError("Couldn't map vertex buffer");
+    }
+    data->vertex_ring_segment_size = segment_size;
+    return 0;
+}
+
+/* Copy the vertices into the current segment, the offset is where they start in the buffer. */
+static int GL_UploadVertexRing(GL_RenderData *data, const void *vertices, size_t vertsize, size_t *offset)
+{
+    if (vertsize > data->vertex_ring_segment_size) {
+        size_t segment_size = SDL_max(data->vertex_ring_segment_size * 2, GL_VERTEX_RING_MIN_SEGMENT);
+
+        while (segment_size < vertsize) {
+            segment_size *= 2;
+        }
+        GL_DestroyVertexRing(data);
+        if (GL_CreateVertexRing(data, segment_size) < 0) {
+            return -1;
+        }
+    } else if (data->vertex_ring_offset + vertsize > data->vertex_ring_segment_size) {
+        GLsync fence;
+
+        /* This segment is full, move on to the next one */
+        data->vertex_ring_segment = (data->vertex_ring_segment + 1) % GL_VERTEX_RING_SEGMENTS;
+        data->vertex_ring_offset = 0;
+
+        fence = data->vertex_ring_fences[data->vertex_ring_segment];
+        if (fence) {
+            /* Wait for the GPU to finish with the last draws from this segment */
+            GLenum result;
+            do {
+                result = data->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 /* 1 second */);
+            } while (result == GL_TIMEOUT_EXPIRED);
+            data->glDeleteSync(fence);
+            data->vertex_ring_fences[data->vertex_ring_segment] = NULL;
+        }
+    }
+
+    *offset = data->vertex_ring_segment * data->vertex_ring_segment_size + data->vertex_ring_offset;
+    SDL_memcpy(data->vertex_ring_memory + *offset, vertices, vertsize);
+    data->vertex_ring_offset += vertsize;
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_ring);
+    return 0;
+}
+
+/* Fence the draws we just made from the current segment */
+static void GL_FenceVertexRing(GL_RenderData *data)
+{
+    GLsync *fence = &data->vertex_ring_fences[data->vertex_ring_segment];
+
+    /* The new fence also covers any earlier draws from this segment */
+    if (*fence) {
+        data->glDeleteSync(*fence);
+    }
+    *fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+#endif /* SDL_GL_VERTEX_RING */
+
 static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
-    /* !!! FIXME: it'd be nice to use a vertex buffer instead of immediate mode... */
     GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+#ifdef SDL_GL_VERTEX_RING
+    SDL_bool use_vertex_ring = SDL_FALSE;
+#endif
 
     if (GL_ActivateRenderer(renderer) < 0) {
         return -1;
@@ -1221,6 +1686,28 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
     data->drawstate.viewport_dirty = SDL_TRUE;
 #endif
 
+#ifdef SDL_GL_VERTEX_RING
+    if (data->vertex_ring_supported && vertsize > 0) {
+        size_t offset = 0;
+        if (GL_UploadVertexRing(data, vertices, vertsize, &offset) == 0) {
+            vertices = (void *)(uintptr_t)offset; /* array pointers will be offsets into the ring. */
+            use_vertex_ring = SDL_TRUE;
+        } else {
+            /* Fall back to client-side arrays */
+            data->vertex_ring_supported = SDL_FALSE;
+        }
+    }
+#endif
+
+#ifdef SDL_GL_GPU_TIMER
+    if (data->gpu_timer_supported && !data->gpu_timer_active &&
+        !data->gpu_timer_pending[data->gpu_timer_frame]) {
+        /* Start timing this frame, it ends at present */
+        data->glBeginQuery(GL_TIME_ELAPSED, data->gpu_timers[data->gpu_timer_frame]);
+        data->gpu_timer_active = SDL_TRUE;
+    }
+#endif
+
     while (cmd) {
         switch (cmd->command) {
         case SDL_RENDERCMD_SETDRAWCOLOR:
@@ -1305,6 +1792,11 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 /* SetDrawState handles glEnableClientState. */
                 data->glVertexPointer(2, GL_FLOAT, sizeof(float) * 2, verts);
 
+                if (data->drawstate.line_width != cmd->data.draw.size) {
+                    data->glLineWidth(cmd->data.draw.size);
+                    data->drawstate.line_width = cmd->data.draw.size;
+                }
+
                 if (count > 2) {
                     /* joined lines cannot be grouped */
                     data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)count);
@@ -1322,6 +1814,8 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                             break; /* can't go any further on this draw call, those are joined lines */
                         } else if (nextcmd->data.draw.blend != thisblend) {
                             break; /* can't go any further on this draw call, different blendmode copy up next. */
+                        } else if (nextcmd->data.draw.size != cmd->data.draw.size) {
+                            break; /* can't go any further on this draw call, different line width up next. */
                         } else {
                             finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                             count += nextcmd->data.draw.count;
@@ -1354,6 +1848,12 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     break; /* can't go any further on this draw call, different render command up next. */
                 } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != thisblend) {
                     break; /* can't go any further on this draw call, different texture/blendmode copy up next. */
+                } else if (nextcmd->data.draw.size != cmd->data.draw.size) {
+                    break; /* can't go any further on this draw call, different point size up next. */
+                } else if (nextcmd->data.draw.quads != cmd->data.draw.quads) {
+                    break; /* can't go any further on this draw call, quads and triangles are drawn differently. */
+                } else if (cmd->data.draw.quads && (count + nextcmd->data.draw.count) > SDL_RENDER_MAX_QUADS * 4) {
+                    break; /* can't go any further on this draw call, out of quad indices. */
                 } else {
                     finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                     count += nextcmd->data.draw.count;
@@ -1377,6 +1877,11 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 if (thiscmdtype == SDL_RENDERCMD_DRAW_POINTS) {
                     /* SetDrawState handles glEnableClientState. */
                     data->glVertexPointer(2, GL_FLOAT, sizeof(float) * 2, verts);
+
+                    if (data->drawstate.point_size != cmd->data.draw.size) {
+                        data->glPointSize(cmd->data.draw.size);
+                        data->drawstate.point_size = cmd->data.draw.size;
+                    }
                 } else {
                     /* SetDrawState handles glEnableClientState. */
                     if (thistexture) {
@@ -1389,7 +1894,11 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
-                data->glDrawArrays(op, 0, (GLsizei)count);
+                if (cmd->data.draw.quads) {
+                    data->glDrawElements(GL_TRIANGLES, (GLsizei)(count / 4 * 6), GL_UNSIGNED_SHORT, data->quad_indices);
+                } else {
+                    data->glDrawArrays(op, 0, (GLsizei)count);
+                }
 
                 /* Restore previously set color when we're done. */
                 if (thiscmdtype != SDL_RENDERCMD_DRAW_POINTS) {
@@ -1406,6 +1915,40 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES:
+        {
+            if (SetCopyState(data, cmd) == 0) {
+                /* The quad corners, followed by the instances, see GL_QueueInstances() */
+                const GLfloat *corners = (const GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                const SDL_RenderInstance *instances = (const SDL_RenderInstance *)(corners + 8);
+                const GLsizei stride = sizeof(SDL_RenderInstance);
+                GLuint i;
+
+                data->glVertexAttribPointer(GL_INSTANCE_ATTRIBUTE_CORNER, 2, GL_FLOAT, GL_FALSE, 0, corners);
+                data->glVertexAttribPointer(GL_INSTANCE_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, stride, &instances->origin);
+                data->glVertexAttribPointer(GL_INSTANCE_ATTRIBUTE_AXES, 4, GL_FLOAT, GL_FALSE, stride, &instances->axis_x);
+                data->glVertexAttribPointer(GL_INSTANCE_ATTRIBUTE_TEXRECT, 4, GL_FLOAT, GL_FALSE, stride, instances->uv);
+                data->glVertexAttribPointer(GL_INSTANCE_ATTRIBUTE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, &instances->color);
+                for (i = 0; i < GL_NUM_INSTANCE_ATTRIBUTES; ++i) {
+                    data->glEnableVertexAttribArray(i);
+                    if (i != GL_INSTANCE_ATTRIBUTE_CORNER) {
+                        data->glVertexAttribDivisor(i, 1);
+                    }
+                }
+
+                data->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)cmd->data.draw.count);
+
+                /* Leave the generic attributes off, in case external code relies on it */
+                for (i = 0; i < GL_NUM_INSTANCE_ATTRIBUTES; ++i) {
+                    if (i != GL_INSTANCE_ATTRIBUTE_CORNER) {
+                        data->glVertexAttribDivisor(i, 0);
+                    }
+                    data->glDisableVertexAttribArray(i);
+                }
+            }
+            break;
+        }
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -1428,6 +1971,14 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         data->drawstate.texture_array = SDL_FALSE;
     }
 
+#ifdef SDL_GL_VERTEX_RING
+    if (use_vertex_ring) {
+        GL_FenceVertexRing(data);
+        /* Leave client-side arrays working for anyone else using the context */
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+#endif
+
     return GL_CheckError("", renderer);
 }
 
@@ -1501,10 +2052,180 @@ static int GL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
     return status;
 }
 
+#ifdef SDL_GL_ASYNC_READBACK
+typedef struct GL_Readback
+{
+    GLuint buffer;
+    GLsync fence;
+    Uint32 format;
+    int pitch;
+    SDL_bool flip;
+} GL_Readback;
+
+static int GL_QueueReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    const SDL_Rect *rect = &readback->rect;
+    GL_Readback *rb;
+    GLint internalFormat;
+    GLenum format, type;
+    int w, h;
+
+    GL_ActivateRenderer(renderer);
+
+    rb = (GL_Readback *)SDL_calloc(1, sizeof(*rb));
+    if (!rb) {
+        return -1;
+    }
+    rb->format = renderer->target ? renderer->target->format : SDL_PIXELFORMAT_ARGB8888;
+    if (!convert_format(data, rb->format, &internalFormat, &format, &type)) {
+        SDL_free(rb);
+        return SDL_SetError("Texture format %s not supported by OpenGL",
+                            SDL_GetPixelFormatName(rb->format));
+    }
+    rb->pitch = rect->w * SDL_BYTESPERPIXEL(rb->format);
+    rb->flip = renderer->target ? SDL_FALSE : SDL_TRUE;
+
+    SDL_GetCurrentRenderOutputSize(renderer, &w, &h);
+
+    data->glGenBuffers(1, &rb->buffer);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, rb->buffer);
+    data->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, (GLsizeiptr)rect->h * rb->pitch, NULL, GL_STREAM_READ);
+
+    data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    data->glPixelStorei(GL_PACK_ROW_LENGTH, rect->w);
+
+    /* With the buffer bound, the pixel pointer is an offset into it and the read doesn't block */
+    data->glReadPixels(rect->x, renderer->target ? rect->y : (h - rect->y) - rect->h,
+                       rect->w, rect->h, format, type, NULL);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+    if (GL_CheckError("glReadPixels()", renderer) < 0) {
+        data->glDeleteBuffers(1, &rb->buffer);
+        SDL_free(rb);
+        return -1;
+    }
+
+    rb->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback->driverdata = rb;
+    return 0;
+}
+
+static SDL_bool GL_QueryReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    GL_Readback *rb = (GL_Readback *)readback->driverdata;
+
+    GL_ActivateRenderer(renderer);
+
+    return (data->glClientWaitSync(rb->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) != GL_TIMEOUT_EXPIRED);
+}
+
+static int GL_FinishReadPixels(SDL_Renderer *renderer, SDL_RenderReadback *readback, void *pixels, int pitch)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    GL_Readback *rb = (GL_Readback *)readback->driverdata;
+    const SDL_Rect *rect = &readback->rect;
+    int retval = 0;
+
+    GL_ActivateRenderer(renderer);
+
+    if (pixels) {
+        const Uint8 *src;
+        GLenum result;
+        int row;
+
+        do {
+            result = data->glClientWaitSync(rb->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 /* 1 second */);
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        data->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, rb->buffer);
+        src = (const Uint8 *)data->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY);
+        if (src) {
+            if (rb->flip) {
+                /* Convert a row at a time to flip the rows to be top-down */
+                for (row = 0; row < rect->h && retval == 0; ++row) {
+                    retval = SDL_ConvertPixels(rect->w, 1,
+                                               rb->format, src + (rect->h - 1 - row) * rb->pitch, rb->pitch,
+                                               readback->format, (Uint8 *)pixels + row * pitch, pitch);
+                }
+            } else {
+                retval = SDL_ConvertPixels(rect->w, rect->h,
+                                           rb->format, src, rb->pitch,
+                                           readback->format, pixels, pitch);
+            }
+            data->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+        } else {
+            retval = SDL_SetError("Couldn't map pixel buffer");
+        }
+        data->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    }
+
+    data->glDeleteSync(rb->fence);
+    data->glDeleteBuffers(1, &rb->buffer);
+    SDL_free(rb);
+    readback->driverdata = NULL;
+    return retval;
+}
+#endif /* SDL_GL_ASYNC_READBACK */
+
+#ifdef SDL_GL_GPU_TIMER
+static void GL_EndFrameGPUTimer(GL_RenderData *data)
+{
+    int i;
+
+    if (data->gpu_timer_active) {
+        data->glEndQuery(GL_TIME_ELAPSED);
+        data->gpu_timer_pending[data->gpu_timer_frame] = SDL_TRUE;
+        data->gpu_timer_active = SDL_FALSE;
+        data->gpu_timer_frame = (data->gpu_timer_frame + 1) % GL_GPU_TIMER_FRAMES;
+    }
+
+    /* Collect finished queries, oldest first so the newest result wins */
+    for (i = 0; i < GL_GPU_TIMER_FRAMES; ++i) {
+        const int frame = (data->gpu_timer_frame + i) % GL_GPU_TIMER_FRAMES;
+        GLint available = 0;
+
+        if (!data->gpu_timer_pending[frame]) {
+            continue;
+        }
+        data->glGetQueryObjectiv(data->gpu_timers[frame], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 elapsed = 0;
+            data->glGetQueryObjectui64v(data->gpu_timers[frame], GL_QUERY_RESULT, &elapsed);
+            data->gpu_time = elapsed;
+            data->gpu_time_valid = SDL_TRUE;
+            data->gpu_timer_pending[frame] = SDL_FALSE;
+        }
+    }
+}
+
+static SDL_bool GL_GetFrameGPUTime(SDL_Renderer *renderer, Uint64 *nanoseconds)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+
+    if (!data->gpu_time_valid) {
+        return SDL_FALSE;
+    }
+    *nanoseconds = data->gpu_time;
+    return SDL_TRUE;
+}
+#endif /* SDL_GL_GPU_TIMER */
+
 static int GL_RenderPresent(SDL_Renderer *renderer)
 {
+#ifdef SDL_GL_GPU_TIMER
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+#endif
+
     GL_ActivateRenderer(renderer);
 
+#ifdef SDL_GL_GPU_TIMER
+    if (data->gpu_timer_supported) {
+        GL_EndFrameGPUTimer(data);
+    }
+#endif
+
     return SDL_GL_SwapWindow(renderer->window);
 }
 
@@ -1542,6 +2263,9 @@ static void GL_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
             renderdata->glDeleteTextures(1, &data->utexture);
         }
     }
+    if (data->packed) {
+        renderdata->glDeleteTextures(1, &data->utexture);
+    }
 #endif
     SDL_free(data->pixels);
     SDL_free(data);
@@ -1570,6 +2294,24 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
             GL_DestroyShaderContext(data->shaders);
         }
         if (data->context) {
+#ifdef SDL_GL_VERTEX_RING
+            if (data->vertex_ring_supported) {
+                GL_DestroyVertexRing(data);
+            }
+#endif
+#ifdef SDL_GL_ASYNC_UPLOAD
+            if (data->async_upload_supported) {
+                GL_DestroyTextureUploads(data);
+            }
+#endif
+#ifdef SDL_GL_GPU_TIMER
+            if (data->gpu_timer_supported) {
+                if (data->gpu_timer_active) {
+                    data->glEndQuery(GL_TIME_ELAPSED);
+                }
+                data->glDeleteQueries(GL_GPU_TIMER_FRAMES, data->gpu_timers);
+            }
+#endif
             while (data->framebuffers) {
                 GL_FBOList *nextnode = data->framebuffers->next;
                 /* delete the framebuffer object */
@@ -1580,6 +2322,7 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
             }
             SDL_GL_DeleteContext(data->context);
         }
+        SDL_free(data->quad_indices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -1610,7 +2353,7 @@ static int GL_BindTexture(SDL_Renderer *renderer, SDL_Texture *texture, float *t
             data->glActiveTextureARB(GL_TEXTURE0_ARB);
         }
     }
-    if (texturedata->nv12) {
+    if (texturedata->nv12 || texturedata->packed) {
         if (data->GL_ARB_multitexture_supported) {
             data->glActiveTextureARB(GL_TEXTURE1_ARB);
         }
@@ -1663,7 +2406,7 @@ static int GL_UnbindTexture(SDL_Renderer *renderer, SDL_Texture *texture)
             data->glActiveTextureARB(GL_TEXTURE0_ARB);
         }
     }
-    if (texturedata->nv12) {
+    if (texturedata->nv12 || texturedata->packed) {
         if (data->GL_ARB_multitexture_supported) {
             data->glActiveTextureARB(GL_TEXTURE1_ARB);
         }
@@ -1897,6 +2640,7 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
     data->textype = GL_TEXTURE_2D;
     if (non_power_of_two_supported) {
         data->GL_ARB_texture_non_power_of_two_supported = SDL_TRUE;
+        renderer->native_vertices = SDL_TRUE;
         data->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &value);
         renderer->info.max_texture_width = value;
         renderer->info.max_texture_height = value;
@@ -1913,6 +2657,17 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
         renderer->info.max_texture_height = value;
     }
 
+    /* Scaled points and lines are drawn with glPointSize() and glLineWidth() */
+    {
+        GLfloat range[2] = { 1.0f, 1.0f };
+
+        data->glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, range);
+        renderer->max_point_size = range[1];
+        range[1] = 1.0f;
+        data->glGetFloatv(GL_ALIASED_LINE_WIDTH_RANGE, range);
+        renderer->max_line_width = range[1];
+    }
+
     /* Check for multitexture support */
     if (SDL_GL_ExtensionSupported("GL_ARB_multitexture")) {
         data->glActiveTextureARB = (PFNGLACTIVETEXTUREARBPROC)SDL_GL_GetProcAddress("glActiveTextureARB");
@@ -1922,12 +2677,117 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
         }
     }
 
+#ifdef GL_ARB_sync
+    /* Check for buffer object and sync support */
+    if (SDL_GL_ExtensionSupported("GL_ARB_vertex_buffer_object") &&
+        SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers");
+        data->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)SDL_GL_GetProcAddress("glDeleteBuffers");
+        data->glBindBuffer = (PFNGLBINDBUFFERPROC)SDL_GL_GetProcAddress("glBindBuffer");
+        data->glBufferData = (PFNGLBUFFERDATAPROC)SDL_GL_GetProcAddress("glBufferData");
+        data->glMapBuffer = (PFNGLMAPBUFFERPROC)SDL_GL_GetProcAddress("glMapBuffer");
+        data->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glGenBuffers && data->glDeleteBuffers && data->glBindBuffer &&
+            data->glBufferData && data->glMapBuffer && data->glUnmapBuffer &&
+            data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->GL_ARB_sync_supported = SDL_TRUE;
+        }
+    }
+#endif
+
+#ifdef SDL_GL_ASYNC_UPLOAD
+    /* Check for pixel buffer object support */
+    if (data->GL_ARB_sync_supported &&
+        SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object")) {
+        data->async_upload_supported = SDL_TRUE;
+        renderer->UpdateTextureAsync = GL_UpdateTextureAsync;
+        renderer->QueryTextureUpload = GL_QueryTextureUpload;
+    }
+#endif
+
+#ifdef SDL_GL_ASYNC_READBACK
+    if (data->GL_ARB_sync_supported &&
+        SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object")) {
+        renderer->QueueReadPixels = GL_QueueReadPixels;
+        renderer->QueryReadPixels = GL_QueryReadPixels;
+        renderer->FinishReadPixels = GL_FinishReadPixels;
+    }
+#endif
+
+#ifdef SDL_GL_GPU_TIMER
+    /* Check for timer query support, only used for render statistics */
+    if (SDL_GetBooleanProperty(create_props, "stats", SDL_FALSE) &&
+        SDL_GL_ExtensionSupported("GL_ARB_timer_query")) {
+        data->glGenQueries = (PFNGLGENQUERIESPROC)SDL_GL_GetProcAddress("glGenQueries");
+        data->glDeleteQueries = (PFNGLDELETEQUERIESPROC)SDL_GL_GetProcAddress("glDeleteQueries");
+        data->glBeginQuery = (PFNGLBEGINQUERYPROC)SDL_GL_GetProcAddress("glBeginQuery");
+        data->glEndQuery = (PFNGLENDQUERYPROC)SDL_GL_GetProcAddress("glEndQuery");
+        data->glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)SDL_GL_GetProcAddress("glGetQueryObjectiv");
+        data->glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+        if (data->glGenQueries && data->glDeleteQueries && data->glBeginQuery &&
+            data->glEndQuery && data->glGetQueryObjectiv && data->glGetQueryObjectui64v) {
+            data->glGenQueries(GL_GPU_TIMER_FRAMES, data->gpu_timers);
+            data->gpu_timer_supported = SDL_TRUE;
+            renderer->GetFrameGPUTime = GL_GetFrameGPUTime;
+        }
+    }
+#endif
+
+#ifdef SDL_GL_VERTEX_RING
+    /* Check for persistently mapped buffer support */
+    if (data->GL_ARB_sync_supported &&
+        SDL_GL_ExtensionSupported("GL_ARB_buffer_storage") &&
+        SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range") &&
+        SDL_GetHintBoolean(SDL_HINT_RENDER_OPENGL_PERSISTENT_VERTEX_BUFFER, SDL_TRUE)) {
+        data->glBufferStorage = (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress("glBufferStorage");
+        data->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        if (data->glBufferStorage && data->glMapBufferRange) {
+            data->vertex_ring_supported = SDL_TRUE;
+        }
+    }
+#endif
+
     /* Check for shader support */
     if (SDL_GetHintBoolean(SDL_HINT_RENDER_OPENGL_SHADERS, SDL_TRUE)) {
         data->shaders = GL_CreateShaderContext();
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "OpenGL shaders: %s",
                 data->shaders ? "ENABLED" : "DISABLED");
+    if (data->shaders) {
+        renderer->supports_distance_fields = SDL_TRUE;
+    }
+
+    /* Texture instances are drawn with instanced arrays, in core OpenGL 3.3 or an extension */
+    if (data->shaders) {
+        const char *verstr = (const char *)data->glGetString(GL_VERSION);
+        int gl_major = 0, gl_minor = 0;
+
+        if (verstr && SDL_sscanf(verstr, "%d.%d", &gl_major, &gl_minor) == 2 &&
+            (gl_major > 3 || (gl_major == 3 && gl_minor >= 3))) {
+            data->glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERARBPROC)SDL_GL_GetProcAddress("glVertexAttribPointer");
+            data->glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYARBPROC)SDL_GL_GetProcAddress("glEnableVertexAttribArray");
+            data->glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYARBPROC)SDL_GL_GetProcAddress("glDisableVertexAttribArray");
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORARBPROC)SDL_GL_GetProcAddress("glVertexAttribDivisor");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDARBPROC)SDL_GL_GetProcAddress("glDrawArraysInstanced");
+        } else if (SDL_GL_ExtensionSupported("GL_ARB_instanced_arrays") &&
+                   SDL_GL_ExtensionSupported("GL_ARB_draw_instanced")) {
+            data->glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERARBPROC)SDL_GL_GetProcAddress("glVertexAttribPointerARB");
+            data->glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYARBPROC)SDL_GL_GetProcAddress("glEnableVertexAttribArrayARB");
+            data->glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYARBPROC)SDL_GL_GetProcAddress("glDisableVertexAttribArrayARB");
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORARBPROC)SDL_GL_GetProcAddress("glVertexAttribDivisorARB");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDARBPROC)SDL_GL_GetProcAddress("glDrawArraysInstancedARB");
+        }
+        /* Make sure the instanced programs build with this driver before using them */
+        if (data->glVertexAttribPointer && data->glEnableVertexAttribArray &&
+            data->glDisableVertexAttribArray && data->glVertexAttribDivisor &&
+            data->glDrawArraysInstanced && GL_SelectInstancedShader(data->shaders, SHADER_RGBA)) {
+            GL_SelectShader(data->shaders, SHADER_NONE);
+            renderer->QueueInstances = GL_QueueInstances;
+        }
+    }
 #if SDL_HAVE_YUV
     /* We support YV12 textures using 3 textures and a shader */
     if (data->shaders && data->num_texture_units >= 3) {
@@ -1940,6 +2800,15 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
         renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV12;
         renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV21;
     }
+
+    /* We support packed YUV textures using 2 textures and a shader */
+    if (data->shaders && data->num_texture_units >= 2) {
+        renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_YUY2;
+        renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_YVYU;
+#ifndef __MACOS__
+        renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_UYVY;
+#endif
+    }
 #endif
 #ifdef __MACOS__
     renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_UYVY;
@@ -1972,6 +2841,13 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
         goto error;
     }
 
+    /* Draw rects and textures as 4 vertices per quad */
+    data->quad_indices = (Uint16 *)SDL_malloc(SDL_RENDER_MAX_QUADS * 6 * sizeof(Uint16));
+    if (data->quad_indices) {
+        SDL_GetRenderQuadIndices(renderer, data->quad_indices, SDL_RENDER_MAX_QUADS);
+        renderer->indexed_quads = SDL_TRUE;
+    }
+
     /* Set up parameters for rendering */
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
@@ -1988,6 +2864,8 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
     data->drawstate.shader = SHADER_INVALID;
     data->drawstate.color = 0xFFFFFFFF;
     data->drawstate.clear_color = 0xFFFFFFFF;
+    data->drawstate.point_size = 1.0f;
+    data->drawstate.line_width = 1.0f;
 
     return renderer;
 
@@ -41,6 +41,7 @@ struct GL_ShaderContext
     GLenum (*glGetError)(void);
 
     PFNGLATTACHOBJECTARBPROC glAttachObjectARB;
+    PFNGLBINDATTRIBLOCATIONARBPROC glBindAttribLocationARB;
     PFNGLCOMPILESHADERARBPROC glCompileShaderARB;
     PFNGLCREATEPROGRAMOBJECTARBPROC glCreateProgramObjectARB;
     PFNGLCREATESHADEROBJECTARBPROC glCreateShaderObjectARB;
@@ -57,6 +58,9 @@ struct GL_ShaderContext
     SDL_bool GL_ARB_texture_rectangle_supported;
 
     GL_ShaderData shaders[NUM_SHADERS];
+
+    /* Compiled on first use, with INSTANCED_TEXTURE_VERTEX_SHADER */
+    GL_ShaderData instanced_shaders[NUM_SHADERS];
 };
 
 /* *INDENT-OFF* */ /* clang-format off */
@@ -81,6 +85,37 @@ struct GL_ShaderContext
 "    v_texCoord = vec2(gl_MultiTexCoord0);\n"                   \
 "}"                                                             \
 
+/* Expands one instance of SDL_RenderInstance per draw into a quad */
+#define INSTANCED_TEXTURE_VERTEX_SHADER                         \
+"attribute vec2 a_corner;\n"                                    \
+"attribute vec2 a_position;\n"                                  \
+"attribute vec4 a_axes;\n"                                      \
+"attribute vec4 a_texRect;\n"                                   \
+"attribute vec4 a_color;\n"                                     \
+"varying vec4 v_color;\n"                                       \
+"varying vec2 v_texCoord;\n"                                    \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    vec2 position = a_position + a_corner.x * a_axes.xy + a_corner.y * a_axes.zw;\n" \
+"    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 0.0, 1.0);\n" \
+"    v_color = a_color;\n"                                      \
+"    v_texCoord = mix(a_texRect.xy, a_texRect.zw, a_corner);\n" \
+"}"                                                             \
+
+#define DISTANCE_FIELD_SHADER_PROLOGUE                          \
+"varying vec4 v_color;\n"                                       \
+"varying vec2 v_texCoord;\n"                                    \
+"uniform sampler2D tex0;\n"                                     \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+
+#define DISTANCE_FIELD_SHADER_BODY                              \
+"    float width = fwidth(dist);\n"                             \
+"    gl_FragColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, dist)) * v_color;\n" \
+"}"                                                             \
+
 #define JPEG_SHADER_CONSTANTS                                   \
 "// YUV offset \n"                                              \
 "const vec3 offset = vec3(0, -0.501960814, -0.501960814);\n"    \
@@ -231,6 +266,48 @@ struct GL_ShaderContext
 "    gl_FragColor = vec4(rgb, 1.0) * v_color;\n"                \
 "}"                                                             \
 
+#define PACKED_SHADER_PROLOGUE                                  \
+"varying vec4 v_color;\n"                                       \
+"varying vec2 v_texCoord;\n"                                    \
+"uniform sampler2D tex0; // Y/chroma pairs \n"                  \
+"uniform sampler2D tex1; // 2 pixels per texel \n"              \
+"\n"                                                            \
+
+/* Y is the channel of the luma in tex0, U and V are the channels of the chroma in tex1 */
+#define PACKED_SHADER_BODY(Y, U, V)                             \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    vec2 tcoord;\n"                                            \
+"    vec4 pair;\n"                                              \
+"    vec3 yuv, rgb;\n"                                          \
+"\n"                                                            \
+"    // Get the Y value \n"                                     \
+"    tcoord = v_texCoord;\n"                                    \
+"    yuv.x = texture2D(tex0, tcoord)." Y ";\n"                  \
+"\n"                                                            \
+"    // Get the U and V values \n"                              \
+"    tcoord.x *= UVCoordScale;\n"                               \
+"    pair = texture2D(tex1, tcoord);\n"                         \
+"    yuv.y = pair." U ";\n"                                     \
+"    yuv.z = pair." V ";\n"                                     \
+"\n"                                                            \
+"    // Do the color transform \n"                              \
+"    yuv += offset;\n"                                          \
+"    rgb.r = dot(yuv, Rcoeff);\n"                               \
+"    rgb.g = dot(yuv, Gcoeff);\n"                               \
+"    rgb.b = dot(yuv, Bcoeff);\n"                               \
+"\n"                                                            \
+"    gl_FragColor = vec4(rgb, 1.0) * v_color;\n"                \
+"}"                                                             \
+
+/* Byte order Y0 U Y1 V */
+#define YUY2_SHADER_BODY PACKED_SHADER_BODY("r", "g", "a")
+/* Byte order U Y0 V Y1 */
+#define UYVY_SHADER_BODY PACKED_SHADER_BODY("a", "r", "b")
+/* Byte order Y0 V Y1 U */
+#define YVYU_SHADER_BODY PACKED_SHADER_BODY("r", "a", "g")
+
 /*
  * NOTE: Always use sampler2D, etc here. We'll #define them to the
  *  texture_rectangle versions if we choose to use that extension.
@@ -283,6 +360,27 @@ static const char *shader_source[NUM_SHADERS][2] = {
 "    gl_FragColor = texture2D(tex0, v_texCoord) * v_color;\n"
 "}"
     },
+
+    /* SHADER_SDF */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        DISTANCE_FIELD_SHADER_PROLOGUE
+"    float dist = texture2D(tex0, v_texCoord).a;\n"
+        DISTANCE_FIELD_SHADER_BODY
+    },
+
+    /* SHADER_MSDF */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        DISTANCE_FIELD_SHADER_PROLOGUE
+"    vec3 msdf = texture2D(tex0, v_texCoord).rgb;\n"
+"    float dist = max(min(msdf.r, msdf.g), min(max(msdf.r, msdf.g), msdf.b));\n"
+        DISTANCE_FIELD_SHADER_BODY
+    },
 #if SDL_HAVE_YUV
     /* SHADER_YUV_JPEG */
     {
@@ -383,6 +481,87 @@ static const char *shader_source[NUM_SHADERS][2] = {
         BT709_SHADER_CONSTANTS
         NV21_SHADER_BODY
     },
+    /* SHADER_YUY2_JPEG */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        JPEG_SHADER_CONSTANTS
+        YUY2_SHADER_BODY
+    },
+    /* SHADER_YUY2_BT601 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT601_SHADER_CONSTANTS
+        YUY2_SHADER_BODY
+    },
+    /* SHADER_YUY2_BT709 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT709_SHADER_CONSTANTS
+        YUY2_SHADER_BODY
+    },
+    /* SHADER_UYVY_JPEG */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        JPEG_SHADER_CONSTANTS
+        UYVY_SHADER_BODY
+    },
+    /* SHADER_UYVY_BT601 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT601_SHADER_CONSTANTS
+        UYVY_SHADER_BODY
+    },
+    /* SHADER_UYVY_BT709 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT709_SHADER_CONSTANTS
+        UYVY_SHADER_BODY
+    },
+    /* SHADER_YVYU_JPEG */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        JPEG_SHADER_CONSTANTS
+        YVYU_SHADER_BODY
+    },
+    /* SHADER_YVYU_BT601 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT601_SHADER_CONSTANTS
+        YVYU_SHADER_BODY
+    },
+    /* SHADER_YVYU_BT709 */
+    {
+        /* vertex shader */
+        TEXTURE_VERTEX_SHADER,
+        /* fragment shader */
+        PACKED_SHADER_PROLOGUE
+        BT709_SHADER_CONSTANTS
+        YVYU_SHADER_BODY
+    },
 #endif /* SDL_HAVE_YUV */
 };
 
@@ -421,7 +600,7 @@ static SDL_bool CompileShader(GL_ShaderContext *ctx, GLhandleARB shader, const c
     }
 }
 
-static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_ShaderData *data)
+static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_ShaderData *data, SDL_bool instanced)
 {
     const int num_tmus_bound = 4;
     const char *vert_defines = "";
@@ -451,7 +630,7 @@ static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_Shader
 
     /* Create the vertex shader */
     data->vert_shader = ctx->glCreateShaderObjectARB(GL_VERTEX_SHADER_ARB);
-    if (!CompileShader(ctx, data->vert_shader, vert_defines, shader_source[index][0])) {
+    if (!CompileShader(ctx, data->vert_shader, vert_defines, instanced ? INSTANCED_TEXTURE_VERTEX_SHADER : shader_source[index][0])) {
         return SDL_FALSE;
     }
 
@@ -464,6 +643,13 @@ static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_Shader
     /* ... and in the darkness bind them */
     ctx->glAttachObjectARB(data->program, data->vert_shader);
     ctx->glAttachObjectARB(data->program, data->frag_shader);
+    if (instanced) {
+        ctx->glBindAttribLocationARB(data->program, GL_INSTANCE_ATTRIBUTE_CORNER, "a_corner");
+        ctx->glBindAttribLocationARB(data->program, GL_INSTANCE_ATTRIBUTE_POSITION, "a_position");
+        ctx->glBindAttribLocationARB(data->program, GL_INSTANCE_ATTRIBUTE_AXES, "a_axes");
+        ctx->glBindAttribLocationARB(data->program, GL_INSTANCE_ATTRIBUTE_TEXRECT, "a_texRect");
+        ctx->glBindAttribLocationARB(data->program, GL_INSTANCE_ATTRIBUTE_COLOR, "a_color");
+    }
     ctx->glLinkProgramARB(data->program);
 
     /* Set up some uniform variables */
@@ -513,6 +699,7 @@ GL_ShaderContext *GL_CreateShaderContext(void)
         SDL_GL_ExtensionSupported("GL_ARB_fragment_shader")) {
         ctx->glGetError = (GLenum(*)(void))SDL_GL_GetProcAddress("glGetError");
         ctx->glAttachObjectARB = (PFNGLATTACHOBJECTARBPROC)SDL_GL_GetProcAddress("glAttachObjectARB");
+        ctx->glBindAttribLocationARB = (PFNGLBINDATTRIBLOCATIONARBPROC)SDL_GL_GetProcAddress("glBindAttribLocationARB");
         ctx->glCompileShaderARB = (PFNGLCOMPILESHADERARBPROC)SDL_GL_GetProcAddress("glCompileShaderARB");
         ctx->glCreateProgramObjectARB = (PFNGLCREATEPROGRAMOBJECTARBPROC)SDL_GL_GetProcAddress("glCreateProgramObjectARB");
         ctx->glCreateShaderObjectARB = (PFNGLCREATESHADEROBJECTARBPROC)SDL_GL_GetProcAddress("glCreateShaderObjectARB");
@@ -527,6 +714,7 @@ GL_ShaderContext *GL_CreateShaderContext(void)
         ctx->glUseProgramObjectARB = (PFNGLUSEPROGRAMOBJECTARBPROC)SDL_GL_GetProcAddress("glUseProgramObjectARB");
         if (ctx->glGetError &&
             ctx->glAttachObjectARB &&
+            ctx->glBindAttribLocationARB &&
             ctx->glCompileShaderARB &&
             ctx->glCreateProgramObjectARB &&
             ctx->glCreateShaderObjectARB &&
@@ -550,7 +738,7 @@ GL_ShaderContext *GL_CreateShaderContext(void)
 
     /* Compile all the shaders */
     for (i = 0; i < NUM_SHADERS; ++i) {
-        if (!CompileShaderProgram(ctx, i, &ctx->shaders[i])) {
+        if (!CompileShaderProgram(ctx, i, &ctx->shaders[i], SDL_FALSE)) {
             GL_DestroyShaderContext(ctx);
             return NULL;
         }
@@ -565,12 +753,33 @@ void GL_SelectShader(GL_ShaderContext *ctx, GL_Shader shader)
     ctx->glUseProgramObjectARB(ctx->shaders[shader].program);
 }
 
+SDL_bool GL_SelectInstancedShader(GL_ShaderContext *ctx, GL_Shader shader)
+{
+    GL_ShaderData *data;
+
+    if (shader <= SHADER_SOLID) {
+        return SDL_FALSE; /* Instances are always textured */
+    }
+
+    data = &ctx->instanced_shaders[shader];
+    if (!data->program) {
+        if (!CompileShaderProgram(ctx, shader, data, SDL_TRUE)) {
+            DestroyShaderProgram(ctx, data);
+            SDL_zerop(data);
+            return SDL_FALSE;
+        }
+    }
+    ctx->glUseProgramObjectARB(data->program);
+    return SDL_TRUE;
+}
+
 void GL_DestroyShaderContext(GL_ShaderContext *ctx)
 {
     int i;
 
     for (i = 0; i < NUM_SHADERS; ++i) {
         DestroyShaderProgram(ctx, &ctx->shaders[i]);
+        DestroyShaderProgram(ctx, &ctx->instanced_shaders[i]);
     }
     SDL_free(ctx);
 }
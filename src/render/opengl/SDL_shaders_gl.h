@@ -33,6 +33,8 @@ typedef enum
     SHADER_SOLID,
     SHADER_RGB,
     SHADER_RGBA,
+    SHADER_SDF,
+    SHADER_MSDF,
 #if SDL_HAVE_YUV
     SHADER_YUV_JPEG,
     SHADER_YUV_BT601,
@@ -45,14 +47,35 @@ typedef enum
     SHADER_NV21_JPEG,
     SHADER_NV21_BT601,
     SHADER_NV21_BT709,
+    SHADER_YUY2_JPEG,
+    SHADER_YUY2_BT601,
+    SHADER_YUY2_BT709,
+    SHADER_UYVY_JPEG,
+    SHADER_UYVY_BT601,
+    SHADER_UYVY_BT709,
+    SHADER_YVYU_JPEG,
+    SHADER_YVYU_BT601,
+    SHADER_YVYU_BT709,
 #endif
     NUM_SHADERS
 } GL_Shader;
 
+/* Generic vertex attributes of the instanced shaders, one corner per vertex and the rest per instance */
+typedef enum
+{
+    GL_INSTANCE_ATTRIBUTE_CORNER,
+    GL_INSTANCE_ATTRIBUTE_POSITION,
+    GL_INSTANCE_ATTRIBUTE_AXES,
+    GL_INSTANCE_ATTRIBUTE_TEXRECT,
+    GL_INSTANCE_ATTRIBUTE_COLOR,
+    GL_NUM_INSTANCE_ATTRIBUTES
+} GL_InstanceAttribute;
+
 typedef struct GL_ShaderContext GL_ShaderContext;
 
 extern GL_ShaderContext *GL_CreateShaderContext(void);
 extern void GL_SelectShader(GL_ShaderContext *ctx, GL_Shader shader);
+extern SDL_bool GL_SelectInstancedShader(GL_ShaderContext *ctx, GL_Shader shader);
 extern void GL_DestroyShaderContext(GL_ShaderContext *ctx);
 
 #endif /* SDL_shaders_gl_h_ */
@@ -28,6 +28,10 @@
 #include "../../video/SDL_blit.h"
 #include "SDL_shaders_gles2.h"
 
+#ifdef SDL_VIDEO_OPENGL_EGL
+#include <SDL3/SDL_egl.h>
+#endif
+
 /* WebGL doesn't offer client-side arrays, so use Vertex Buffer Objects
    on Emscripten, which converts GLES2 into WebGL calls.
    In all other cases, attempt to use client-side arrays, as they tend to
@@ -39,6 +43,14 @@
 #define USE_VERTEX_BUFFER_OBJECTS 0
 #endif
 
+/* When the driver supports persistently mapped buffers, vertices are
+   streamed through a ring of segments. Each flush suballocates from the
+   current segment and moves on to the next one when it's full, waiting on
+   that segment's fence first, so we never write to memory the GPU is still
+   reading. */
+#define GLES2_VERTEX_RING_SEGMENTS     3
+#define GLES2_VERTEX_RING_MIN_SEGMENT  (64 * 1024)
+
 /* To prevent unnecessary window recreation,
  * these should match the defaults selected in SDL_GL_ResetAttributes
  */
@@ -67,14 +79,22 @@ typedef struct GLES2_TextureData
     GLenum pixel_type;
     void *pixel_data;
     int pitch;
+    SDL_Rect locked_rect;
 #if SDL_HAVE_YUV
     /* YUV texture support */
     SDL_bool yuv;
     SDL_bool nv12;
+    SDL_bool packed; /* YUY2, UYVY and YVYU, texture_u holds the same pixels as RGBA for the chroma */
     GLuint texture_v;
     GLuint texture_v_external;
     GLuint texture_u;
     GLuint texture_u_external;
+#endif
+#ifdef SDL_VIDEO_OPENGL_EGL
+    /* Images imported from dmabuf file descriptors */
+    EGLImageKHR egl_image;
+    EGLImageKHR egl_image_u;
+    EGLImageKHR egl_image_v;
 #endif
     GLES2_FBOList *fbo;
 } GLES2_TextureData;
@@ -85,28 +105,24 @@ typedef struct GLES2_ProgramCacheEntry
     GLuint vertex_shader;
     GLuint fragment_shader;
     GLuint uniform_locations[16];
-    GLfloat projection[4][4];
-    struct GLES2_ProgramCacheEntry *prev;
-    struct GLES2_ProgramCacheEntry *next;
+    Uint32 projection_serial; /* The drawstate projection last uploaded to this program */
+    GLfloat point_size;
 } GLES2_ProgramCacheEntry;
 
-typedef struct GLES2_ProgramCache
-{
-    int count;
-    GLES2_ProgramCacheEntry *head;
-    GLES2_ProgramCacheEntry *tail;
-} GLES2_ProgramCache;
-
 typedef enum
 {
     GLES2_ATTRIBUTE_POSITION = 0,
     GLES2_ATTRIBUTE_COLOR = 1,
     GLES2_ATTRIBUTE_TEXCOORD = 2,
+    GLES2_ATTRIBUTE_CORNER = 3,
+    GLES2_ATTRIBUTE_AXES = 4,
+    GLES2_ATTRIBUTE_TEXRECT = 5,
 } GLES2_Attribute;
 
 typedef enum
 {
     GLES2_UNIFORM_PROJECTION,
+    GLES2_UNIFORM_POINT_SIZE,
     GLES2_UNIFORM_TEXTURE,
     GLES2_UNIFORM_TEXTURE_U,
     GLES2_UNIFORM_TEXTURE_V
@@ -123,7 +139,12 @@ typedef enum
     GLES2_IMAGESOURCE_TEXTURE_YUV,
     GLES2_IMAGESOURCE_TEXTURE_NV12,
     GLES2_IMAGESOURCE_TEXTURE_NV21,
-    GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES
+    GLES2_IMAGESOURCE_TEXTURE_YUY2,
+    GLES2_IMAGESOURCE_TEXTURE_UYVY,
+    GLES2_IMAGESOURCE_TEXTURE_YVYU,
+    GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES,
+    GLES2_IMAGESOURCE_TEXTURE_SDF,
+    GLES2_IMAGESOURCE_TEXTURE_MSDF
 } GLES2_ImageSource;
 
 typedef struct
@@ -143,6 +164,8 @@ typedef struct
     int drawableh;
     GLES2_ProgramCacheEntry *program;
     GLfloat projection[4][4];
+    Uint32 projection_serial; /* Incremented whenever projection changes */
+    GLfloat line_width;
 } GLES2_DrawStateCache;
 
 typedef struct GLES2_RenderData
@@ -159,23 +182,50 @@ typedef struct GLES2_RenderData
     GLES2_FBOList *framebuffers;
     GLuint window_framebuffer;
 
+    /* Stays bound to GL_ELEMENT_ARRAY_BUFFER, see SDL_GetRenderQuadIndices() */
+    GLuint quad_index_buffer;
+
     GLuint shader_id_cache[GLES2_SHADER_COUNT];
 
-    GLES2_ProgramCache program_cache;
+    /* All programs use the default vertex shader, so they're looked up by fragment shader */
+    GLES2_ProgramCacheEntry *program_cache[GLES2_SHADER_COUNT];
+    GLES2_ProgramCacheEntry *instanced_program_cache[GLES2_SHADER_COUNT];
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
 #if USE_VERTEX_BUFFER_OBJECTS
     GLuint vertex_buffers[8];
     size_t vertex_buffer_size[8];
     int current_vertex_buffer;
+#else
+    SDL_bool vertex_ring_supported;
+    PFNGLBUFFERSTORAGEEXTPROC glBufferStorageEXT;
+    PFNGLMAPBUFFERRANGEEXTPROC glMapBufferRange;
+    PFNGLFENCESYNCAPPLEPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCAPPLEPROC glClientWaitSync;
+    PFNGLDELETESYNCAPPLEPROC glDeleteSync;
+    GLuint vertex_ring;
+    Uint8 *vertex_ring_memory;
+    size_t vertex_ring_segment_size;
+    int vertex_ring_segment;
+    size_t vertex_ring_offset;
+    GLsync vertex_ring_fences[GLES2_VERTEX_RING_SEGMENTS];
 #endif
 
+#ifdef SDL_VIDEO_OPENGL_EGL
+    EGLDisplay egl_display;
+    PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR;
+    PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR;
+    PFNGLEGLIMAGETARGETTEXTURE2DOESPROC glEGLImageTargetTexture2DOES;
+#endif
+
+    /* OpenGL ES 3.0 or one of the instanced arrays extensions, NULL if unsupported */
+    PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor;
+    PFNGLDRAWARRAYSINSTANCEDEXTPROC glDrawArraysInstanced;
+
     GLES2_DrawStateCache drawstate;
     GLES2_ShaderIncludeType texcoord_precision_hint;
 } GLES2_RenderData;
 
-#define GLES2_MAX_CACHED_PROGRAMS 8
-
 static const float inv255f = 1.0f / 255.0f;
 
 static const char *GL_TranslateError(GLenum error)
@@ -392,30 +442,6 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     GLES2_ProgramCacheEntry *entry;
     GLint linkSuccessful;
 
-    /* Check if we've already cached this program */
-    entry = data->program_cache.head;
-    while (entry) {
-        if (entry->vertex_shader == vertex && entry->fragment_shader == fragment) {
-            break;
-        }
-        entry = entry->next;
-    }
-    if (entry) {
-        if (data->program_cache.head != entry) {
-            if (entry->next) {
-                entry->next->prev = entry->prev;
-            }
-            if (entry->prev) {
-                entry->prev->next = entry->next;
-            }
-            entry->prev = NULL;
-            entry->next = data->program_cache.head;
-            data->program_cache.head->prev = entry;
-            data->program_cache.head = entry;
-        }
-        return entry;
-    }
-
     /* Create a program cache entry */
     entry = (GLES2_ProgramCacheEntry *)SDL_calloc(1, sizeof(GLES2_ProgramCacheEntry));
     if (!entry) {
@@ -432,6 +458,9 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_POSITION, "a_position");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CORNER, "a_corner");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_AXES, "a_axes");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXRECT, "a_texRect");
     data->glLinkProgram(entry->id);
     data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
     if (!linkSuccessful) {
@@ -444,6 +473,8 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     /* Predetermine locations of uniform variables */
     entry->uniform_locations[GLES2_UNIFORM_PROJECTION] =
         data->glGetUniformLocation(entry->id, "u_projection");
+    entry->uniform_locations[GLES2_UNIFORM_POINT_SIZE] =
+        data->glGetUniformLocation(entry->id, "u_pointSize");
     entry->uniform_locations[GLES2_UNIFORM_TEXTURE_V] =
         data->glGetUniformLocation(entry->id, "u_texture_v");
     entry->uniform_locations[GLES2_UNIFORM_TEXTURE_U] =
@@ -461,29 +492,10 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     if (entry->uniform_locations[GLES2_UNIFORM_TEXTURE] != -1) {
         data->glUniform1i(entry->uniform_locations[GLES2_UNIFORM_TEXTURE], 0); /* always texture unit 0. */
     }
-    if (entry->uniform_locations[GLES2_UNIFORM_PROJECTION] != -1) {
-        data->glUniformMatrix4fv(entry->uniform_locations[GLES2_UNIFORM_PROJECTION], 1, GL_FALSE, (GLfloat *)entry->projection);
-    }
-
-    /* Cache the linked program */
-    if (data->program_cache.head) {
-        entry->next = data->program_cache.head;
-        data->program_cache.head->prev = entry;
-    } else {
-        data->program_cache.tail = entry;
-    }
-    data->program_cache.head = entry;
-    ++data->program_cache.count;
-
-    /* Evict the last entry from the cache if we exceed the limit */
-    if (data->program_cache.count > GLES2_MAX_CACHED_PROGRAMS) {
-        data->glDeleteProgram(data->program_cache.tail->id);
-        data->program_cache.tail = data->program_cache.tail->prev;
-        if (data->program_cache.tail) {
-            SDL_free(data->program_cache.tail->next);
-            data->program_cache.tail->next = NULL;
-        }
-        --data->program_cache.count;
+    /* The projection is uploaded by SetDrawState(), since projection_serial is 0 */
+    entry->point_size = 1.0f;
+    if (entry->uniform_locations[GLES2_UNIFORM_POINT_SIZE] != -1) {
+        data->glUniform1f(entry->uniform_locations[GLES2_UNIFORM_POINT_SIZE], entry->point_size);
     }
     return entry;
 }
@@ -590,15 +602,16 @@ static int GLES2_CacheShaders(GLES2_RenderData *data)
     return 0;
 }
 
-static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source, int w, int h)
+static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source, int w, int h, SDL_bool instanced)
 {
     GLuint vertex;
     GLuint fragment;
     GLES2_ShaderType vtype, ftype;
     GLES2_ProgramCacheEntry *program;
+    GLES2_ProgramCacheEntry **program_cache = instanced ? data->instanced_program_cache : data->program_cache;
 
     /* Select an appropriate shader pair for the specified modes */
-    vtype = GLES2_SHADER_VERTEX_DEFAULT;
+    vtype = instanced ? GLES2_SHADER_VERTEX_INSTANCED : GLES2_SHADER_VERTEX_DEFAULT;
     switch (source) {
     case GLES2_IMAGESOURCE_SOLID:
         ftype = GLES2_SHADER_FRAGMENT_SOLID;
@@ -672,14 +685,78 @@ static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source,
             goto fault;
         }
         break;
+    case GLES2_IMAGESOURCE_TEXTURE_YUY2:
+        switch (SDL_GetYUVConversionModeForResolution(w, h)) {
+        case SDL_YUV_CONVERSION_JPEG:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_JPEG;
+            break;
+        case SDL_YUV_CONVERSION_BT601:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT601;
+            break;
+        case SDL_YUV_CONVERSION_BT709:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT709;
+            break;
+        default:
+            SDL_SetError("Unsupported YUV conversion mode: %d\n", SDL_GetYUVConversionModeForResolution(w, h));
+            goto fault;
+        }
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_UYVY:
+        switch (SDL_GetYUVConversionModeForResolution(w, h)) {
+        case SDL_YUV_CONVERSION_JPEG:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_JPEG;
+            break;
+        case SDL_YUV_CONVERSION_BT601:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT601;
+            break;
+        case SDL_YUV_CONVERSION_BT709:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT709;
+            break;
+        default:
+            SDL_SetError("Unsupported YUV conversion mode: %d\n", SDL_GetYUVConversionModeForResolution(w, h));
+            goto fault;
+        }
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_YVYU:
+        switch (SDL_GetYUVConversionModeForResolution(w, h)) {
+        case SDL_YUV_CONVERSION_JPEG:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_JPEG;
+            break;
+        case SDL_YUV_CONVERSION_BT601:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT601;
+            break;
+        case SDL_YUV_CONVERSION_BT709:
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT709;
+            break;
+        default:
+            SDL_SetError("Unsupported YUV conversion mode: %d\n", SDL_GetYUVConversionModeForResolution(w, h));
+            goto fault;
+        }
+        break;
 #endif /* SDL_HAVE_YUV */
     case GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES:
         ftype = GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES;
         break;
+    case GLES2_IMAGESOURCE_TEXTURE_SDF:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_SDF;
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_MSDF:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_MSDF;
+        break;
     default:
         goto fault;
     }
 
+    /* Check if we need to change programs at all */
+    program = program_cache[(Uint32)ftype];
+    if (program) {
+        if (program != data->drawstate.program) {
+            data->glUseProgram(program->id);
+            data->drawstate.program = program;
+        }
+        return 0;
+    }
+
     /* Load the requested shaders */
     vertex = data->shader_id_cache[(Uint32)vtype];
     if (!vertex) {
@@ -697,18 +774,12 @@ static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source,
         }
     }
 
-    /* Check if we need to change programs at all */
-    if (data->drawstate.program &&
-        data->drawstate.program->vertex_shader == vertex &&
-        data->drawstate.program->fragment_shader == fragment) {
-        return 0;
-    }
-
     /* Generate a matching program */
     program = GLES2_CacheProgram(data, vertex, fragment);
     if (!program) {
         goto fault;
     }
+    program_cache[(Uint32)ftype] = program;
 
     /* Select that program in OpenGL */
     data->glUseProgram(program->id);
@@ -730,6 +801,7 @@ static int GLES2_QueueSetViewport(SDL_Renderer *renderer, SDL_RenderCommand *cmd
 
 static int GLES2_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FPoint *points, int count)
 {
+    const GLfloat size = cmd->data.draw.size;
     const SDL_bool colorswap = (renderer->target && (renderer->target->format == SDL_PIXELFORMAT_BGRA32 || renderer->target->format == SDL_PIXELFORMAT_BGRX32));
     SDL_VertexSolid *verts = (SDL_VertexSolid *)SDL_AllocateRenderVertices(renderer, count * sizeof(*verts), 0, &cmd->data.draw.first);
     int i;
@@ -749,10 +821,11 @@ static int GLES2_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         color.b = r;
     }
 
+    /* Points are drawn gl_PointSize wide, centered on the scaled pixel. */
     cmd->data.draw.count = count;
     for (i = 0; i < count; i++) {
-        verts->position.x = 0.5f + points[i].x;
-        verts->position.y = 0.5f + points[i].y;
+        verts->position.x = (0.5f + points[i].x) * size;
+        verts->position.y = (0.5f + points[i].y) * size;
         verts->color = color;
         verts++;
     }
@@ -765,6 +838,10 @@ static int GLES2_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     const SDL_bool colorswap = (renderer->target && (renderer->target->format == SDL_PIXELFORMAT_BGRA32 || renderer->target->format == SDL_PIXELFORMAT_BGRX32));
     int i;
     GLfloat prevx, prevy;
+    const GLfloat size = cmd->data.draw.size;
+    /* Lines wider than a pixel stop at the center of their end pixels,
+       so push them out half a pixel to cover them like scaled rects. */
+    const GLfloat bump = (size > 1.0f) ? (0.5f * size) : 0.25f;
     SDL_VertexSolid *verts = (SDL_VertexSolid *)SDL_AllocateRenderVertices(renderer, count * sizeof(*verts), 0, &cmd->data.draw.first);
     SDL_Color color;
     color.r = cmd->data.draw.r;
@@ -785,8 +862,13 @@ static int GLES2_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     cmd->data.draw.count = count;
 
     /* 0.5f offset to hit the center of the pixel. */
-    prevx = 0.5f + points->x;
-    prevy = 0.5f + points->y;
+    prevx = (0.5f + points->x) * size;
+    prevy = (0.5f + points->y) * size;
+    if (size > 1.0f) {
+        const GLfloat angle = SDL_atan2f(points[1].y - points[0].y, points[1].x - points[0].x);
+        prevx -= (SDL_cosf(angle) * bump);
+        prevy -= (SDL_sinf(angle) * bump);
+    }
     verts->position.x = prevx;
     verts->position.y = prevy;
     verts->color = color;
@@ -799,14 +881,14 @@ static int GLES2_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     for (i = 1; i < count; i++) {
         const GLfloat xstart = prevx;
         const GLfloat ystart = prevy;
-        const GLfloat xend = points[i].x + 0.5f; /* 0.5f to hit pixel center. */
-        const GLfloat yend = points[i].y + 0.5f;
+        const GLfloat xend = (points[i].x + 0.5f) * size; /* 0.5f to hit pixel center. */
+        const GLfloat yend = (points[i].y + 0.5f) * size;
         /* bump a little in the direction we are moving in. */
         const GLfloat deltax = xend - xstart;
         const GLfloat deltay = yend - ystart;
         const GLfloat angle = SDL_atan2f(deltay, deltax);
-        prevx = xend + (SDL_cosf(angle) * 0.25f);
-        prevy = yend + (SDL_sinf(angle) * 0.25f);
+        prevx = xend + (SDL_cosf(angle) * bump);
+        prevy = yend + (SDL_sinf(angle) * bump);
         verts->position.x = prevx;
         verts->position.y = prevy;
         verts->color = color;
@@ -834,6 +916,13 @@ static int GLES2_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, S
             return -1;
         }
 
+        if (!colorswap && scale_x == 1.0f && scale_y == 1.0f &&
+            SDL_IsRenderVertexArray(xy, xy_stride, color, color_stride, uv, uv_stride)) {
+            /* These are already our vertices */
+            SDL_CopyRenderVertices(verts, (const SDL_Vertex *)xy, count, indices, size_indices);
+            return 0;
+        }
+
         for (i = 0; i < count; i++) {
             int j;
             float *xy_;
@@ -909,10 +998,44 @@ static int GLES2_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, S
     return 0;
 }
 
+static int GLES2_QueueInstances(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture,
+                                const SDL_TextureInstance *instances, int count, float scale_x, float scale_y)
+{
+    /* Drawn as a triangle strip, see SetDrawState() */
+    static const GLfloat corners[8] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+    const SDL_bool colorswap = (renderer->target && (renderer->target->format == SDL_PIXELFORMAT_BGRA32 || renderer->target->format == SDL_PIXELFORMAT_BGRX32));
+    SDL_RenderInstance *quads;
+    GLfloat *verts;
+    int i;
+
+    SDL_COMPILE_TIME_ASSERT(render_instance_size, sizeof(SDL_RenderInstance) == 10 * sizeof(GLfloat) + 4);
+
+    verts = (GLfloat *)SDL_AllocateRenderVertices(renderer, sizeof(corners) + count * sizeof(*quads), 0, &cmd->data.draw.first);
+    if (!verts) {
+        return -1;
+    }
+    SDL_memcpy(verts, corners, sizeof(corners));
+
+    quads = (SDL_RenderInstance *)(verts + SDL_arraysize(corners));
+    count = SDL_GetRenderInstances(texture, instances, count, scale_x, scale_y, quads);
+    if (colorswap) {
+        for (i = 0; i < count; ++i) {
+            Uint8 r = quads[i].color.r;
+            quads[i].color.r = quads[i].color.b;
+            quads[i].color.b = r;
+        }
+    }
+    cmd->data.draw.count = count;
+
+    return 0;
+}
+
 static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_ImageSource imgsrc, void *vertices)
 {
     SDL_Texture *texture = cmd->data.draw.texture;
     const SDL_BlendMode blend = cmd->data.draw.blend;
+    const SDL_bool instanced = (cmd->command == SDL_RENDERCMD_DRAW_INSTANCES);
+    const SDL_bool texturing = (texture && !instanced);
     GLES2_ProgramCacheEntry *program;
     int stride;
 
@@ -927,6 +1050,7 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
             data->drawstate.projection[0][0] = 2.0f / viewport->w;
             data->drawstate.projection[1][1] = (data->drawstate.target ? 2.0f : -2.0f) / viewport->h;
             data->drawstate.projection[3][1] = data->drawstate.target ? -1.0f : 1.0f;
+            ++data->drawstate.projection_serial;
         }
         data->drawstate.viewport_dirty = SDL_FALSE;
     }
@@ -949,8 +1073,9 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
         data->drawstate.cliprect_dirty = SDL_FALSE;
     }
 
-    if ((texture != NULL) != data->drawstate.texturing) {
-        if (!texture) {
+    /* Instances compute their texture coordinates in the vertex shader */
+    if (texturing != data->drawstate.texturing) {
+        if (!texturing) {
             data->glDisableVertexAttribArray((GLenum)GLES2_ATTRIBUTE_TEXCOORD);
             data->drawstate.texturing = SDL_FALSE;
         } else {
@@ -965,21 +1090,28 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
         stride = sizeof(SDL_VertexSolid);
     }
 
-    if (texture) {
+    if (texturing) {
         SDL_Vertex *verts = (SDL_Vertex *)(((Uint8 *)vertices) + cmd->data.draw.first);
         data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)&verts->tex_coord);
     }
 
-    if (GLES2_SelectProgram(data, imgsrc, texture ? texture->w : 0, texture ? texture->h : 0) < 0) {
+    if (GLES2_SelectProgram(data, imgsrc, texture ? texture->w : 0, texture ? texture->h : 0, instanced) < 0) {
         return -1;
     }
 
     program = data->drawstate.program;
 
     if (program->uniform_locations[GLES2_UNIFORM_PROJECTION] != -1) {
-        if (SDL_memcmp(program->projection, data->drawstate.projection, sizeof(data->drawstate.projection)) != 0) {
+        if (program->projection_serial != data->drawstate.projection_serial) {
             data->glUniformMatrix4fv(program->uniform_locations[GLES2_UNIFORM_PROJECTION], 1, GL_FALSE, (GLfloat *)data->drawstate.projection);
-            SDL_memcpy(program->projection, data->drawstate.projection, sizeof(data->drawstate.projection));
+            program->projection_serial = data->drawstate.projection_serial;
+        }
+    }
+
+    if (cmd->command == SDL_RENDERCMD_DRAW_POINTS && program->uniform_locations[GLES2_UNIFORM_POINT_SIZE] != -1) {
+        if (program->point_size != cmd->data.draw.size) {
+            data->glUniform1f(program->uniform_locations[GLES2_UNIFORM_POINT_SIZE], cmd->data.draw.size);
+            program->point_size = cmd->data.draw.size;
         }
     }
 
@@ -998,8 +1130,18 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
         data->drawstate.blend = blend;
     }
 
-    /* all drawing commands use this */
-    {
+    if (instanced) {
+        /* The quad corners, followed by the instances, see GLES2_QueueInstances() */
+        const GLfloat *corners = (const GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_RenderInstance *instances = (const SDL_RenderInstance *)(corners + 8);
+        stride = sizeof(SDL_RenderInstance);
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_CORNER, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *)corners);
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)&instances->origin);
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_AXES, 4, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)&instances->axis_x);
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXRECT, 4, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)instances->uv);
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE /* Normalized */, stride, (const GLvoid *)&instances->color);
+    } else {
+        /* all other drawing commands use this */
         SDL_VertexSolid *verts = (SDL_VertexSolid *)(((Uint8 *)vertices) + cmd->data.draw.first);
         data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)&verts->position);
         data->glVertexAttribPointer(GLES2_ATTRIBUTE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE /* Normalized */, stride, (const GLvoid *)&verts->color);
@@ -1079,6 +1221,15 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
             case SDL_PIXELFORMAT_NV21:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
                 break;
+            case SDL_PIXELFORMAT_YUY2:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_YUY2;
+                break;
+            case SDL_PIXELFORMAT_UYVY:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_UYVY;
+                break;
+            case SDL_PIXELFORMAT_YVYU:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_YVYU;
+                break;
 #endif
             case SDL_PIXELFORMAT_EXTERNAL_OES:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES;
@@ -1114,6 +1265,15 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
         case SDL_PIXELFORMAT_NV21:
             sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
             break;
+        case SDL_PIXELFORMAT_YUY2:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_YUY2;
+            break;
+        case SDL_PIXELFORMAT_UYVY:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_UYVY;
+            break;
+        case SDL_PIXELFORMAT_YVYU:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_YVYU;
+            break;
 #endif
         case SDL_PIXELFORMAT_EXTERNAL_OES:
             sourceType = GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES;
@@ -1123,6 +1283,13 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
         }
     }
 
+    /* Distance field shaders only read the alpha channel or a median of the color channels */
+    if (texture->distance_field == SDL_DISTANCEFIELD_SDF) {
+        sourceType = GLES2_IMAGESOURCE_TEXTURE_SDF;
+    } else if (texture->distance_field == SDL_DISTANCEFIELD_MSDF) {
+        sourceType = GLES2_IMAGESOURCE_TEXTURE_MSDF;
+    }
+
     ret = SetDrawState(data, cmd, sourceType, vertices);
 
     if (texture != data->drawstate.texture) {
@@ -1136,7 +1303,7 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
             data->glBindTexture(tdata->texture_type, tdata->texture_u);
 
             data->glActiveTexture(GL_TEXTURE0);
-        } else if (tdata->nv12) {
+        } else if (tdata->nv12 || tdata->packed) {
             data->glActiveTexture(GL_TEXTURE1);
             data->glBindTexture(tdata->texture_type, tdata->texture_u);
 
@@ -1150,6 +1317,100 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
     return ret;
 }
 
+#if !USE_VERTEX_BUFFER_OBJECTS
+static void GLES2_DestroyVertexRing(GLES2_RenderData *data)
+{
+    int i;
+
+    for (i = 0; i < GLES2_VERTEX_RING_SEGMENTS; ++i) {
+        if (data->vertex_ring_fences[i]) {
+            data->glDeleteSync(data->vertex_ring_fences[i]);
+            data->vertex_ring_fences[i] = NULL;
+        }
+    }
+    if (data->vertex_ring) {
+        /* This also unmaps the buffer, the driver keeps it alive until the GPU is done with it */
+        data->glDeleteBuffers(1, &data->vertex_ring);
+        data->vertex_ring = 0;
+    }
+    data->vertex_ring_memory = NULL;
+    data->vertex_ring_segment_size = 0;
+    data->vertex_ring_segment = 0;
+    data->vertex_ring_offset = 0;
+}
+
+static int GLES2_CreateVertexRing(GLES2_RenderData *data, size_t segment_size)
+{
+    const GLbitfield flags = (GL_MAP_WRITE_BIT_EXT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT);
+    const GLsizeiptr size = (GLsizeiptr)(segment_size * GLES2_VERTEX_RING_SEGMENTS);
+
+    data->glGenBuffers(1, &data->vertex_ring);
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_ring);
+    data->glBufferStorageEXT(GL_ARRAY_BUFFER, size, NULL, flags);
+    data->vertex_ring_memory = (Uint8 *)data->glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    if (!data->vertex_ring_memory) {
+        GLES2_DestroyVertexRing(data);
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return SDL_SetError("Couldn't map vertex buffer");
+    }
+    data->vertex_ring_segment_size = segment_size;
+    return 0;
+}
+
+/* Copy the vertices into the current segment, the offset is where they start in the buffer. */
+static int GLES2_UploadVertexRing(GLES2_RenderData *data, const void *vertices, size_t vertsize, size_t *offset)
+{
+    if (vertsize > data->vertex_ring_segment_size) {
+        size_t segment_size = SDL_max(data->vertex_ring_segment_size * 2, GLES2_VERTEX_RING_MIN_SEGMENT);
+
+        while (segment_size < vertsize) {
+            segment_size *= 2;
+        }
+        GLES2_DestroyVertexRing(data);
+        if (GLES2_CreateVertexRing(data, segment_size) < 0) {
+            return -1;
+        }
+    } else if (data->vertex_ring_offset + vertsize > data->vertex_ring_segment_size) {
+        GLsync fence;
+
+        /* This segment is full, move on to the next one */
+        data->vertex_ring_segment = (data->vertex_ring_segment + 1) % GLES2_VERTEX_RING_SEGMENTS;
+        data->vertex_ring_offset = 0;
+
+        fence = data->vertex_ring_fences[data->vertex_ring_segment];
+        if (fence) {
+            /* Wait for the GPU to finish with the last draws from this segment */
+            GLenum result;
+            do {
+                result = data->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT_APPLE, 1000000000 /* 1 second */);
+            } while (result == GL_TIMEOUT_EXPIRED_APPLE);
+            data->glDeleteSync(fence);
+            data->vertex_ring_fences[data->vertex_ring_segment] = NULL;
+        }
+    }
+
+    *offset = data->vertex_ring_segment * data->vertex_ring_segment_size + data->vertex_ring_offset;
+    SDL_memcpy(data->vertex_ring_memory + *offset, vertices, vertsize);
+    data->vertex_ring_offset += vertsize;
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_ring);
+    return 0;
+}
+
+/* Fence the draws we just made from the current segment, and unbind the ring
+   so later client-side arrays (and the application) don't draw from it. */
+static void GLES2_FenceVertexRing(GLES2_RenderData *data)
+{
+    GLsync *fence = &data->vertex_ring_fences[data->vertex_ring_segment];
+
+    /* The new fence also covers any earlier draws from this segment */
+    if (*fence) {
+        data->glDeleteSync(*fence);
+    }
+    *fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE_APPLE, 0);
+    data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+#endif /* !USE_VERTEX_BUFFER_OBJECTS */
+
 static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->driverdata;
@@ -1158,6 +1419,8 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
 #if USE_VERTEX_BUFFER_OBJECTS
     const int vboidx = data->current_vertex_buffer;
     const GLuint vbo = data->vertex_buffers[vboidx];
+#else
+    SDL_bool use_vertex_ring = SDL_FALSE;
 #endif
 
     if (GLES2_ActivateRenderer(renderer) < 0) {
@@ -1192,6 +1455,17 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         data->current_vertex_buffer = 0;
     }
     vertices = NULL; /* attrib pointers will be offsets into the VBO. */
+#else
+    if (data->vertex_ring_supported && vertsize > 0) {
+        size_t offset = 0;
+        if (GLES2_UploadVertexRing(data, vertices, vertsize, &offset) == 0) {
+            vertices = (void *)(uintptr_t)offset; /* attrib pointers will be offsets into the ring. */
+            use_vertex_ring = SDL_TRUE;
+        } else {
+            /* Fall back to client-side arrays */
+            data->vertex_ring_supported = SDL_FALSE;
+        }
+    }
 #endif
 
     while (cmd) {
@@ -1264,6 +1538,12 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         {
             if (SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID, vertices) == 0) {
                 size_t count = cmd->data.draw.count;
+
+                if (data->drawstate.line_width != cmd->data.draw.size) {
+                    data->glLineWidth(cmd->data.draw.size);
+                    data->drawstate.line_width = cmd->data.draw.size;
+                }
+
                 if (count > 2) {
                     /* joined lines cannot be grouped */
                     data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)count);
@@ -1281,6 +1561,8 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                             break; /* can't go any further on this draw call, those are joined lines */
                         } else if (nextcmd->data.draw.blend != thisblend) {
                             break; /* can't go any further on this draw call, different blendmode copy up next. */
+                        } else if (nextcmd->data.draw.size != cmd->data.draw.size) {
+                            break; /* can't go any further on this draw call, different line width up next. */
                         } else {
                             finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                             count += nextcmd->data.draw.count;
@@ -1313,6 +1595,12 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                     break; /* can't go any further on this draw call, different render command up next. */
                 } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != thisblend) {
                     break; /* can't go any further on this draw call, different texture/blendmode copy up next. */
+                } else if (nextcmd->data.draw.size != cmd->data.draw.size) {
+                    break; /* can't go any further on this draw call, different point size up next. */
+                } else if (nextcmd->data.draw.quads != cmd->data.draw.quads) {
+                    break; /* can't go any further on this draw call, quads and triangles are drawn differently. */
+                } else if (cmd->data.draw.quads && (count + nextcmd->data.draw.count) > SDL_RENDER_MAX_QUADS * 4) {
+                    break; /* can't go any further on this draw call, out of quad indices. */
                 } else {
                     finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                     count += nextcmd->data.draw.count;
@@ -1331,13 +1619,37 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                 if (thiscmdtype == SDL_RENDERCMD_DRAW_POINTS) {
                     op = GL_POINTS;
                 }
-                data->glDrawArrays(op, 0, (GLsizei)count);
+                if (cmd->data.draw.quads) {
+                    /* The vertex attributes start at this command's first vertex */
+                    data->glDrawElements(GL_TRIANGLES, (GLsizei)(count / 4 * 6), GL_UNSIGNED_SHORT, NULL);
+                } else {
+                    data->glDrawArrays(op, 0, (GLsizei)count);
+                }
             }
 
             cmd = finalcmd; /* skip any copy commands we just combined in here. */
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES:
+        {
+            if (SetCopyState(renderer, cmd, vertices) == 0) {
+                /* The corners advance per vertex, everything else per instance */
+                data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_CORNER);
+                data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_AXES);
+                data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_TEXRECT);
+                data->glVertexAttribDivisor(GLES2_ATTRIBUTE_POSITION, 1);
+                data->glVertexAttribDivisor(GLES2_ATTRIBUTE_COLOR, 1);
+                data->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)cmd->data.draw.count);
+                data->glVertexAttribDivisor(GLES2_ATTRIBUTE_POSITION, 0);
+                data->glVertexAttribDivisor(GLES2_ATTRIBUTE_COLOR, 0);
+                data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_CORNER);
+                data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_AXES);
+                data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXRECT);
+            }
+            break;
+        }
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -1345,6 +1657,12 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         cmd = cmd->next;
     }
 
+#if !USE_VERTEX_BUFFER_OBJECTS
+    if (use_vertex_ring) {
+        GLES2_FenceVertexRing(data);
+    }
+#endif
+
     return GL_CheckError("", renderer);
 }
 
@@ -1366,14 +1684,18 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
             }
         }
         {
-            GLES2_ProgramCacheEntry *entry;
-            GLES2_ProgramCacheEntry *next;
-            entry = data->program_cache.head;
-            while (entry) {
-                data->glDeleteProgram(entry->id);
-                next = entry->next;
-                SDL_free(entry);
-                entry = next;
+            int i;
+            for (i = 0; i < GLES2_SHADER_COUNT; i++) {
+                GLES2_ProgramCacheEntry *entry = data->program_cache[i];
+                if (entry) {
+                    data->glDeleteProgram(entry->id);
+                    SDL_free(entry);
+                }
+                entry = data->instanced_program_cache[i];
+                if (entry) {
+                    data->glDeleteProgram(entry->id);
+                    SDL_free(entry);
+                }
             }
         }
 
@@ -1386,9 +1708,18 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
                 data->framebuffers = nextnode;
             }
 
+            if (data->quad_index_buffer) {
+                data->glDeleteBuffers(1, &data->quad_index_buffer);
+            }
+
 #if USE_VERTEX_BUFFER_OBJECTS
             data->glDeleteBuffers(SDL_arraysize(data->vertex_buffers), data->vertex_buffers);
             GL_CheckError("", renderer);
+#else
+            if (data->vertex_ring_supported) {
+                GLES2_DestroyVertexRing(data);
+                GL_CheckError("", renderer);
+            }
 #endif
 
             SDL_GL_DeleteContext(data->context);
@@ -1399,6 +1730,103 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
     SDL_free(renderer);
 }
 
+#ifdef SDL_VIDEO_OPENGL_EGL
+#define GLES2_MAX_DMABUF_PLANES 4
+
+#define GLES2_DRM_FOURCC(a, b, c, d) ((Uint32)(a) | ((Uint32)(b) << 8) | ((Uint32)(c) << 16) | ((Uint32)(d) << 24))
+#define GLES2_DRM_FORMAT_R8          GLES2_DRM_FOURCC('R', '8', ' ', ' ')
+#define GLES2_DRM_FORMAT_MOD_INVALID 0x00ffffffffffffffLL
+
+static Uint32 GLES2_GetDRMFormat(Uint32 format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_BGRA32:
+        return GLES2_DRM_FOURCC('A', 'R', '2', '4');
+    case SDL_PIXELFORMAT_RGBA32:
+        return GLES2_DRM_FOURCC('A', 'B', '2', '4');
+    case SDL_PIXELFORMAT_BGRX32:
+        return GLES2_DRM_FOURCC('X', 'R', '2', '4');
+    case SDL_PIXELFORMAT_RGBX32:
+        return GLES2_DRM_FOURCC('X', 'B', '2', '4');
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YV12:
+        return GLES2_DRM_FORMAT_R8;
+    default:
+        return 0;
+    }
+}
+
+static SDL_bool GLES2_HasDMABuf(SDL_PropertiesID create_props)
+{
+    return (SDL_GetNumberProperty(create_props, "opengles2.dmabuf.fd0", -1) >= 0);
+}
+
+/* Import dmabuf planes as an EGL image and attach it to the currently bound texture */
+static int GLES2_ImportDMABuf(GLES2_RenderData *data, GLenum target, SDL_PropertiesID create_props,
+                              int first_plane, int num_planes, Uint32 drm_format, int w, int h, EGLImageKHR *image)
+{
+    static const EGLint plane_attribs[GLES2_MAX_DMABUF_PLANES][5] = {
+        { EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT, EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT },
+        { EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT, EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT },
+        { EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT, EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT },
+        { EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT, EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT }
+    };
+    EGLint attribs[6 + GLES2_MAX_DMABUF_PLANES * 10 + 1];
+    Sint64 modifier = SDL_GetNumberProperty(create_props, "opengles2.dmabuf.modifier", GLES2_DRM_FORMAT_MOD_INVALID);
+    char name[64];
+    int i, n = 0;
+
+    if (!data->eglCreateImageKHR) {
+        return SDL_SetError("dmabuf import requires EGL and GL_OES_EGL_image");
+    }
+    if (!drm_format) {
+        return SDL_SetError("Unknown DRM format for dmabuf import");
+    }
+
+    attribs[n++] = EGL_WIDTH;
+    attribs[n++] = w;
+    attribs[n++] = EGL_HEIGHT;
+    attribs[n++] = h;
+    attribs[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+    attribs[n++] = (EGLint)drm_format;
+    for (i = 0; i < num_planes; ++i) {
+        const int plane = first_plane + i;
+        Sint64 fd, offset, pitch;
+
+        SDL_snprintf(name, sizeof(name), "opengles2.dmabuf.fd%d", plane);
+        fd = SDL_GetNumberProperty(create_props, name, -1);
+        SDL_snprintf(name, sizeof(name), "opengles2.dmabuf.offset%d", plane);
+        offset = SDL_GetNumberProperty(create_props, name, 0);
+        SDL_snprintf(name, sizeof(name), "opengles2.dmabuf.pitch%d", plane);
+        pitch = SDL_GetNumberProperty(create_props, name, 0);
+        if (fd < 0 || pitch <= 0) {
+            return SDL_SetError("Missing file descriptor or pitch for dmabuf plane %d", plane);
+        }
+
+        attribs[n++] = plane_attribs[i][0];
+        attribs[n++] = (EGLint)fd;
+        attribs[n++] = plane_attribs[i][1];
+        attribs[n++] = (EGLint)offset;
+        attribs[n++] = plane_attribs[i][2];
+        attribs[n++] = (EGLint)pitch;
+        if (modifier != GLES2_DRM_FORMAT_MOD_INVALID) {
+            attribs[n++] = plane_attribs[i][3];
+            attribs[n++] = (EGLint)(modifier & 0xFFFFFFFF);
+            attribs[n++] = plane_attribs[i][4];
+            attribs[n++] = (EGLint)(modifier >> 32);
+        }
+    }
+    attribs[n++] = EGL_NONE;
+
+    *image = data->eglCreateImageKHR(data->egl_display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT, NULL, attribs);
+    if (*image == EGL_NO_IMAGE_KHR) {
+        return SDL_SetError("eglCreateImageKHR() failed for dmabuf plane %d", first_plane);
+    }
+    data->glEGLImageTargetTexture2DOES(target, (GLeglImageOES)*image);
+    return 0;
+}
+#endif /* SDL_VIDEO_OPENGL_EGL */
+
 static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     GLES2_RenderData *renderdata = (GLES2_RenderData *)renderer->driverdata;
@@ -1406,6 +1834,9 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     GLenum format;
     GLenum type;
     GLenum scaleMode;
+#ifdef SDL_VIDEO_OPENGL_EGL
+    SDL_bool dmabuf;
+#endif
 
     GLES2_ActivateRenderer(renderer);
 
@@ -1428,6 +1859,12 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         format = GL_LUMINANCE;
         type = GL_UNSIGNED_BYTE;
         break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        format = GL_LUMINANCE_ALPHA;
+        type = GL_UNSIGNED_BYTE;
+        break;
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
     case SDL_PIXELFORMAT_EXTERNAL_OES:
@@ -1444,6 +1881,21 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         return SDL_SetError("Unsupported texture access for SDL_PIXELFORMAT_EXTERNAL_OES");
     }
 
+#ifdef SDL_VIDEO_OPENGL_EGL
+    dmabuf = GLES2_HasDMABuf(create_props);
+    if (dmabuf) {
+        if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
+            return SDL_SetError("dmabuf textures can't be streaming textures");
+        }
+        if (texture->format == SDL_PIXELFORMAT_NV12 || texture->format == SDL_PIXELFORMAT_NV21) {
+            return SDL_SetError("Use SDL_PIXELFORMAT_EXTERNAL_OES to import NV12 and NV21 dmabufs");
+        }
+        if (format == GL_LUMINANCE_ALPHA) {
+            return SDL_SetError("Use SDL_PIXELFORMAT_EXTERNAL_OES to import packed YUV dmabufs");
+        }
+    }
+#endif
+
     /* Allocate a texture struct */
     data = (GLES2_TextureData *)SDL_calloc(1, sizeof(GLES2_TextureData));
     if (!data) {
@@ -1460,6 +1912,7 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
 #if SDL_HAVE_YUV
     data->yuv = ((texture->format == SDL_PIXELFORMAT_IYUV) || (texture->format == SDL_PIXELFORMAT_YV12));
     data->nv12 = ((texture->format == SDL_PIXELFORMAT_NV12) || (texture->format == SDL_PIXELFORMAT_NV21));
+    data->packed = (format == GL_LUMINANCE_ALPHA);
     data->texture_u = 0;
     data->texture_v = 0;
 #endif
@@ -1506,7 +1959,17 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+#ifdef SDL_VIDEO_OPENGL_EGL
+        if (dmabuf) {
+            if (GLES2_ImportDMABuf(renderdata, data->texture_type, create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 1 : 2, 1,
+                                   GLES2_DRM_FORMAT_R8, (texture->w + 1) / 2, (texture->h + 1) / 2, &data->egl_image_v) < 0) {
+                return -1;
+            }
+        } else
+#endif
+        {
+            renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        }
         SDL_SetNumberProperty(SDL_GetTextureProperties(texture), "SDL.texture.opengles2.texture_v", data->texture_v);
 
         data->texture_u = (GLuint)SDL_GetNumberProperty(create_props, "opengles2.texture_u", 0);
@@ -1524,7 +1987,17 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+#ifdef SDL_VIDEO_OPENGL_EGL
+        if (dmabuf) {
+            if (GLES2_ImportDMABuf(renderdata, data->texture_type, create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 2 : 1, 1,
+                                   GLES2_DRM_FORMAT_R8, (texture->w + 1) / 2, (texture->h + 1) / 2, &data->egl_image_u) < 0) {
+                return -1;
+            }
+        } else
+#endif
+        {
+            renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        }
         if (GL_CheckError("glTexImage2D()", renderer) < 0) {
             return -1;
         }
@@ -1551,6 +2024,23 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
             return -1;
         }
         SDL_SetNumberProperty(SDL_GetTextureProperties(texture), "SDL.texture.opengles2.texture_uv", data->texture_u);
+    } else if (data->packed) {
+        /* Packed YUV is sampled twice, the luma from a LUMINANCE_ALPHA texture
+           and the chroma from a half width RGBA texture of the same pixels */
+        renderdata->glGenTextures(1, &data->texture_u);
+        if (GL_CheckError("glGenTexures()", renderer) < 0) {
+            return -1;
+        }
+        renderdata->glActiveTexture(GL_TEXTURE1);
+        renderdata->glBindTexture(data->texture_type, data->texture_u);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        renderdata->glTexImage2D(data->texture_type, 0, GL_RGBA, (texture->w + 1) / 2, texture->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        if (GL_CheckError("glTexImage2D()", renderer) < 0) {
+            return -1;
+        }
     }
 #endif
 
@@ -1570,6 +2060,30 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#ifdef SDL_VIDEO_OPENGL_EGL
+    if (dmabuf) {
+        if (texture->format == SDL_PIXELFORMAT_EXTERNAL_OES) {
+            /* The whole multi-planar buffer is one image, the driver does any color conversion */
+            Uint32 drm_format = (Uint32)SDL_GetNumberProperty(create_props, "opengles2.dmabuf.format", 0);
+            char name[64];
+            int num_planes;
+
+            for (num_planes = 1; num_planes < GLES2_MAX_DMABUF_PLANES; ++num_planes) {
+                SDL_snprintf(name, sizeof(name), "opengles2.dmabuf.fd%d", num_planes);
+                if (SDL_GetNumberProperty(create_props, name, -1) < 0) {
+                    break;
+                }
+            }
+            if (GLES2_ImportDMABuf(renderdata, data->texture_type, create_props, 0, num_planes,
+                                   drm_format, texture->w, texture->h, &data->egl_image) < 0) {
+                return -1;
+            }
+        } else if (GLES2_ImportDMABuf(renderdata, data->texture_type, create_props, 0, 1,
+                                      GLES2_GetDRMFormat(texture->format), texture->w, texture->h, &data->egl_image) < 0) {
+            return -1;
+        }
+    } else
+#endif
     if (texture->format != SDL_PIXELFORMAT_EXTERNAL_OES) {
         renderdata->glTexImage2D(data->texture_type, 0, format, texture->w, texture->h, 0, format, type, NULL);
         if (GL_CheckError("glTexImage2D()", renderer) < 0) {
@@ -1693,6 +2207,17 @@ static int GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, con
                             GL_LUMINANCE_ALPHA,
                             GL_UNSIGNED_BYTE,
                             pixels, 2 * ((pitch + 1) / 2), 2);
+    } else if (tdata->packed) {
+        /* The same pixels again, two to a texel */
+        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        GLES2_TexSubImage2D(data, tdata->texture_type,
+                            rect->x / 2,
+                            rect->y,
+                            (rect->w + 1) / 2,
+                            rect->h,
+                            GL_RGBA,
+                            GL_UNSIGNED_BYTE,
+                            pixels, pitch, 4);
     }
 #endif
 
@@ -1797,6 +2322,8 @@ static int GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const
 {
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
 
+    tdata->locked_rect = *rect;
+
     /* Retrieve the buffer/pitch for the specified region */
     *pixels = (Uint8 *)tdata->pixel_data +
               (tdata->pitch * rect->y) +
@@ -1811,12 +2338,23 @@ static void GLES2_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
     SDL_Rect rect;
 
-    /* We do whole texture updates, at least for now */
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = texture->w;
-    rect.h = texture->h;
-    GLES2_UpdateTexture(renderer, texture, &rect, tdata->pixel_data, tdata->pitch);
+#if SDL_HAVE_YUV
+    if (tdata->yuv || tdata->nv12 || tdata->packed) {
+        /* The chroma planes are laid out for the whole texture, so update all of it */
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = texture->w;
+        rect.h = texture->h;
+        GLES2_UpdateTexture(renderer, texture, &rect, tdata->pixel_data, tdata->pitch);
+        return;
+    }
+#endif
+
+    /* Only upload what was locked, the rest of the texture is already up to date */
+    rect = tdata->locked_rect;
+    GLES2_UpdateTexture(renderer, texture, &rect,
+                        (Uint8 *)tdata->pixel_data + (tdata->pitch * rect.y) + (rect.x * SDL_BYTESPERPIXEL(texture->format)),
+                        tdata->pitch);
 }
 
 static void GLES2_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
@@ -1836,7 +2374,7 @@ static void GLES2_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *textu
         renderdata->glBindTexture(data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, glScaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, glScaleMode);
-    } else if (data->nv12) {
+    } else if (data->nv12 || data->packed) {
         renderdata->glActiveTexture(GL_TEXTURE1);
         renderdata->glBindTexture(data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, glScaleMode);
@@ -1900,6 +2438,17 @@ static void GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         if (tdata->texture_u && !tdata->texture_u_external) {
             data->glDeleteTextures(1, &tdata->texture_u);
         }
+#endif
+#ifdef SDL_VIDEO_OPENGL_EGL
+        if (tdata->egl_image) {
+            data->eglDestroyImageKHR(data->egl_display, tdata->egl_image);
+        }
+        if (tdata->egl_image_u) {
+            data->eglDestroyImageKHR(data->egl_display, tdata->egl_image_u);
+        }
+        if (tdata->egl_image_v) {
+            data->eglDestroyImageKHR(data->egl_display, tdata->egl_image_v);
+        }
 #endif
         SDL_free(tdata->pixel_data);
         SDL_free(tdata);
@@ -2014,7 +2563,7 @@ static int GLES2_BindTexture(SDL_Renderer *renderer, SDL_Texture *texture, float
         data->glBindTexture(texturedata->texture_type, texturedata->texture_u);
 
         data->glActiveTexture(GL_TEXTURE0);
-    } else if (texturedata->nv12) {
+    } else if (texturedata->nv12 || texturedata->packed) {
         data->glActiveTexture(GL_TEXTURE1);
         data->glBindTexture(texturedata->texture_type, texturedata->texture_u);
 
@@ -2169,9 +2718,49 @@ static SDL_Renderer *GLES2_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
     data->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &value);
     renderer->info.max_texture_height = value;
 
+    renderer->native_vertices = SDL_TRUE;
+
+    /* Scaled points and lines are drawn with gl_PointSize and glLineWidth() */
+    {
+        GLfloat range[2] = { 1.0f, 1.0f };
+
+        data->glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, range);
+        renderer->max_point_size = range[1];
+        range[1] = 1.0f;
+        data->glGetFloatv(GL_ALIASED_LINE_WIDTH_RANGE, range);
+        renderer->max_line_width = range[1];
+    }
+
 #if USE_VERTEX_BUFFER_OBJECTS
     /* we keep a few of these and cycle through them, so data can live for a few frames. */
     data->glGenBuffers(SDL_arraysize(data->vertex_buffers), data->vertex_buffers);
+#else
+    /* GL_EXT_buffer_storage requires OpenGL ES 3.1, so the sync functions are available too */
+    if (SDL_GL_ExtensionSupported("GL_EXT_buffer_storage") &&
+        SDL_GetHintBoolean(SDL_HINT_RENDER_OPENGL_PERSISTENT_VERTEX_BUFFER, SDL_TRUE)) {
+        data->glBufferStorageEXT = (PFNGLBUFFERSTORAGEEXTPROC)SDL_GL_GetProcAddress("glBufferStorageEXT");
+        data->glMapBufferRange = (PFNGLMAPBUFFERRANGEEXTPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glFenceSync = (PFNGLFENCESYNCAPPLEPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCAPPLEPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCAPPLEPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glBufferStorageEXT && data->glMapBufferRange &&
+            data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->vertex_ring_supported = SDL_TRUE;
+        }
+    }
+#endif
+
+#ifdef SDL_VIDEO_OPENGL_EGL
+    /* Importing dmabufs needs an EGL context that can target textures with EGL images */
+    if (SDL_GetVideoDevice()->egl_data && SDL_GL_ExtensionSupported("GL_OES_EGL_image")) {
+        data->egl_display = SDL_EGL_GetCurrentEGLDisplay();
+        data->eglCreateImageKHR = (PFNEGLCREATEIMAGEKHRPROC)SDL_EGL_GetProcAddress("eglCreateImageKHR");
+        data->eglDestroyImageKHR = (PFNEGLDESTROYIMAGEKHRPROC)SDL_EGL_GetProcAddress("eglDestroyImageKHR");
+        data->glEGLImageTargetTexture2DOES = (PFNGLEGLIMAGETARGETTEXTURE2DOESPROC)SDL_GL_GetProcAddress("glEGLImageTargetTexture2DOES");
+        if (!data->eglCreateImageKHR || !data->eglDestroyImageKHR || !data->glEGLImageTargetTexture2DOES) {
+            data->eglCreateImageKHR = NULL;
+        }
+    }
 #endif
 
     data->framebuffers = NULL;
@@ -2209,6 +2798,9 @@ static SDL_Renderer *GLES2_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
     renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_IYUV;
     renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV12;
     renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV21;
+    renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_YUY2;
+    renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_UYVY;
+    renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_YVYU;
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
     if (GLES2_CacheShader(data, GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES, GL_FRAGMENT_SHADER)) {
@@ -2227,6 +2819,50 @@ static SDL_Renderer *GLES2_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
         data->GL_EXT_blend_minmax_supported = SDL_TRUE;
     }
 
+    /* The distance field shaders need fwidth() */
+    if (SDL_GL_ExtensionSupported("GL_OES_standard_derivatives")) {
+        renderer->supports_distance_fields = SDL_TRUE;
+    }
+
+    /* Texture instances are drawn with instanced arrays, in core OpenGL ES 3.0 or an extension */
+    {
+        const char *version = (const char *)data->glGetString(GL_VERSION);
+        int gles_major = 0, gles_minor = 0;
+
+        if (version && SDL_sscanf(version, "OpenGL ES %d.%d", &gles_major, &gles_minor) == 2 && gles_major >= 3) {
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)SDL_GL_GetProcAddress("glVertexAttribDivisor");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDEXTPROC)SDL_GL_GetProcAddress("glDrawArraysInstanced");
+        } else if (SDL_GL_ExtensionSupported("GL_EXT_instanced_arrays")) {
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)SDL_GL_GetProcAddress("glVertexAttribDivisorEXT");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDEXTPROC)SDL_GL_GetProcAddress("glDrawArraysInstancedEXT");
+        } else if (SDL_GL_ExtensionSupported("GL_ANGLE_instanced_arrays")) {
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)SDL_GL_GetProcAddress("glVertexAttribDivisorANGLE");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDEXTPROC)SDL_GL_GetProcAddress("glDrawArraysInstancedANGLE");
+        } else if (SDL_GL_ExtensionSupported("GL_NV_instanced_arrays") && SDL_GL_ExtensionSupported("GL_NV_draw_instanced")) {
+            data->glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)SDL_GL_GetProcAddress("glVertexAttribDivisorNV");
+            data->glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDEXTPROC)SDL_GL_GetProcAddress("glDrawArraysInstancedNV");
+        }
+        if (data->glVertexAttribDivisor && data->glDrawArraysInstanced) {
+            renderer->QueueInstances = GLES2_QueueInstances;
+        } else {
+            data->glVertexAttribDivisor = NULL;
+            data->glDrawArraysInstanced = NULL;
+        }
+    }
+
+    /* Draw rects and textures as 4 vertices per quad */
+    {
+        Uint16 *indices = (Uint16 *)SDL_malloc(SDL_RENDER_MAX_QUADS * 6 * sizeof(Uint16));
+        if (indices) {
+            SDL_GetRenderQuadIndices(renderer, indices, SDL_RENDER_MAX_QUADS);
+            data->glGenBuffers(1, &data->quad_index_buffer);
+            data->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data->quad_index_buffer);
+            data->glBufferData(GL_ELEMENT_ARRAY_BUFFER, SDL_RENDER_MAX_QUADS * 6 * sizeof(Uint16), indices, GL_STATIC_DRAW);
+            SDL_free(indices);
+            renderer->indexed_quads = SDL_TRUE;
+        }
+    }
+
     /* Set up parameters for rendering */
     data->glActiveTexture(GL_TEXTURE0);
     data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
@@ -2235,13 +2871,20 @@ static SDL_Renderer *GLES2_CreateRenderer(SDL_Window *window, SDL_PropertiesID c
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_POSITION);
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
+    if (renderer->QueueInstances) {
+        /* These are only used by instances, the position and color divisors are set per draw */
+        data->glVertexAttribDivisor(GLES2_ATTRIBUTE_AXES, 1);
+        data->glVertexAttribDivisor(GLES2_ATTRIBUTE_TEXRECT, 1);
+    }
 
     data->glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
 
     data->drawstate.blend = SDL_BLENDMODE_INVALID;
     data->drawstate.clear_color = 0xFFFFFFFF;
+    data->drawstate.line_width = 1.0f;
     data->drawstate.projection[3][0] = -1.0f;
     data->drawstate.projection[3][3] = 1.0f;
+    data->drawstate.projection_serial = 1;
 
     GL_CheckError("", renderer);
 
@@ -64,6 +64,7 @@ static const char GLES2_Fragment_Include_Undef_Precision[] =    \
 
 static const char GLES2_Vertex_Default[] =                      \
 "uniform mat4 u_projection;\n"                                  \
+"uniform float u_pointSize;\n"                                  \
 "attribute vec2 a_position;\n"                                  \
 "attribute vec4 a_color;\n"                                     \
 "attribute vec2 a_texCoord;\n"                                  \
@@ -74,7 +75,27 @@ static const char GLES2_Vertex_Default[] =                      \
 "{\n"                                                           \
 "    v_texCoord = a_texCoord;\n"                                \
 "    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);\n" \
-"    gl_PointSize = 1.0;\n"                                     \
+"    gl_PointSize = u_pointSize;\n"                             \
+"    v_color = a_color;\n"                                      \
+"}\n"                                                           \
+;
+
+/* Expands one instance of SDL_RenderInstance per draw into a quad */
+static const char GLES2_Vertex_Instanced[] =                    \
+"uniform mat4 u_projection;\n"                                  \
+"attribute vec2 a_corner;\n"                                    \
+"attribute vec2 a_position;\n"                                  \
+"attribute vec4 a_axes;\n"                                      \
+"attribute vec4 a_texRect;\n"                                   \
+"attribute vec4 a_color;\n"                                     \
+"varying vec2 v_texCoord;\n"                                    \
+"varying vec4 v_color;\n"                                       \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    vec2 position = a_position + a_corner.x * a_axes.xy + a_corner.y * a_axes.zw;\n" \
+"    v_texCoord = mix(a_texRect.xy, a_texRect.zw, a_corner);\n" \
+"    gl_Position = u_projection * vec4(position, 0.0, 1.0);\n"  \
 "    v_color = a_color;\n"                                      \
 "}\n"                                                           \
 ;
@@ -326,6 +347,87 @@ static const char GLES2_Fragment_TextureNV21BT709[] = \
         BT709_SHADER_CONSTANTS \
         NV21_SHADER_BODY \
 ;
+
+/* Packed YUV, u_texture holds luma/chroma pairs and u_texture_u the same pixels two to a texel.
+   Y is the channel of the luma in u_texture, U and V are the channels of the chroma in u_texture_u */
+#define PACKED_SHADER_BODY(Y, U, V)                             \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump vec3 yuv;\n"                                       \
+"    mediump vec4 pair;\n"                                      \
+"    lowp vec3 rgb;\n"                                          \
+"\n"                                                            \
+"    // Get the YUV values \n"                                  \
+"    yuv.x = texture2D(u_texture,   v_texCoord)." Y ";\n"       \
+"    pair = texture2D(u_texture_u, v_texCoord);\n"              \
+"    yuv.y = pair." U ";\n"                                     \
+"    yuv.z = pair." V ";\n"                                     \
+"\n"                                                            \
+"    // Do the color transform \n"                              \
+"    yuv += offset;\n"                                          \
+"    rgb = matrix * yuv;\n"                                     \
+"\n"                                                            \
+"    gl_FragColor = vec4(rgb, 1);\n"                            \
+"    gl_FragColor *= v_color;\n"                                \
+"}"                                                             \
+
+/* Byte order Y0 U Y1 V */
+#define YUY2_SHADER_BODY PACKED_SHADER_BODY("r", "g", "a")
+/* Byte order U Y0 V Y1 */
+#define UYVY_SHADER_BODY PACKED_SHADER_BODY("a", "r", "b")
+/* Byte order Y0 V Y1 U */
+#define YVYU_SHADER_BODY PACKED_SHADER_BODY("r", "a", "g")
+
+/* YUY2 to ABGR conversion */
+static const char GLES2_Fragment_TextureYUY2JPEG[] = \
+        YUV_SHADER_PROLOGUE \
+        JPEG_SHADER_CONSTANTS \
+        YUY2_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureYUY2BT601[] = \
+        YUV_SHADER_PROLOGUE \
+        BT601_SHADER_CONSTANTS \
+        YUY2_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureYUY2BT709[] = \
+        YUV_SHADER_PROLOGUE \
+        BT709_SHADER_CONSTANTS \
+        YUY2_SHADER_BODY \
+;
+
+/* UYVY to ABGR conversion */
+static const char GLES2_Fragment_TextureUYVYJPEG[] = \
+        YUV_SHADER_PROLOGUE \
+        JPEG_SHADER_CONSTANTS \
+        UYVY_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureUYVYBT601[] = \
+        YUV_SHADER_PROLOGUE \
+        BT601_SHADER_CONSTANTS \
+        UYVY_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureUYVYBT709[] = \
+        YUV_SHADER_PROLOGUE \
+        BT709_SHADER_CONSTANTS \
+        UYVY_SHADER_BODY \
+;
+
+/* YVYU to ABGR conversion */
+static const char GLES2_Fragment_TextureYVYUJPEG[] = \
+        YUV_SHADER_PROLOGUE \
+        JPEG_SHADER_CONSTANTS \
+        YVYU_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureYVYUBT601[] = \
+        YUV_SHADER_PROLOGUE \
+        BT601_SHADER_CONSTANTS \
+        YVYU_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureYVYUBT709[] = \
+        YUV_SHADER_PROLOGUE \
+        BT709_SHADER_CONSTANTS \
+        YVYU_SHADER_BODY \
+;
 #endif
 
 /* Custom Android video format texture */
@@ -345,6 +447,41 @@ static const char GLES2_Fragment_TextureExternalOES[] =         \
 "}\n"                                                           \
 ;
 
+/* Distance field textures, drawn as shapes with the edge at a distance of 0.5 */
+static const char GLES2_Fragment_TextureDistanceField_Prologue[] = \
+"#extension GL_OES_standard_derivatives : enable\n"             \
+"\n"                                                            \
+;
+#define DISTANCE_FIELD_SHADER_BODY                              \
+"    mediump float width = fwidth(dist);\n"                     \
+"    gl_FragColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, dist));\n" \
+"    gl_FragColor *= v_color;\n"                                \
+"}\n"                                                           \
+
+static const char GLES2_Fragment_TextureSDF[] =                 \
+"uniform sampler2D u_texture;\n"                                \
+"varying mediump vec4 v_color;\n"                               \
+"varying SDL_TEXCOORD_PRECISION vec2 v_texCoord;\n"             \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump float dist = texture2D(u_texture, v_texCoord).a;\n" \
+DISTANCE_FIELD_SHADER_BODY                                      \
+;
+
+/* The distance is the median of the color channels, so the channel order doesn't matter */
+static const char GLES2_Fragment_TextureMSDF[] =                \
+"uniform sampler2D u_texture;\n"                                \
+"varying mediump vec4 v_color;\n"                               \
+"varying SDL_TEXCOORD_PRECISION vec2 v_texCoord;\n"             \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump vec3 msdf = texture2D(u_texture, v_texCoord).rgb;\n" \
+"    mediump float dist = max(min(msdf.r, msdf.g), min(max(msdf.r, msdf.g), msdf.b));\n" \
+DISTANCE_FIELD_SHADER_BODY                                      \
+;
+
 /* *INDENT-ON* */ /* clang-format on */
 
 /*************************************************************************************************
@@ -356,6 +493,9 @@ const char *GLES2_GetShaderPrologue(GLES2_ShaderType type)
     switch (type) {
     case GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES:
         return GLES2_Fragment_TextureExternalOES_Prologue;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_SDF:
+    case GLES2_SHADER_FRAGMENT_TEXTURE_MSDF:
+        return GLES2_Fragment_TextureDistanceField_Prologue;
     default:
         return "";
     }
@@ -436,6 +576,32 @@ const char *GLES2_GetShader(GLES2_ShaderType type)
 #endif
     case GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES:
         return GLES2_Fragment_TextureExternalOES;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_SDF:
+        return GLES2_Fragment_TextureSDF;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_MSDF:
+        return GLES2_Fragment_TextureMSDF;
+#if SDL_HAVE_YUV
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_JPEG:
+        return GLES2_Fragment_TextureYUY2JPEG;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT601:
+        return GLES2_Fragment_TextureYUY2BT601;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT709:
+        return GLES2_Fragment_TextureYUY2BT709;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_JPEG:
+        return GLES2_Fragment_TextureUYVYJPEG;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT601:
+        return GLES2_Fragment_TextureUYVYBT601;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT709:
+        return GLES2_Fragment_TextureUYVYBT709;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_JPEG:
+        return GLES2_Fragment_TextureYVYUJPEG;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT601:
+        return GLES2_Fragment_TextureYVYUBT601;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT709:
+        return GLES2_Fragment_TextureYVYUBT709;
+#endif
+    case GLES2_SHADER_VERTEX_INSTANCED:
+        return GLES2_Vertex_Instanced;
     default:
         return NULL;
     }
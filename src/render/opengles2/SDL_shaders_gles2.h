@@ -58,6 +58,20 @@ typedef enum
 #endif
     /* Shaders beyond this point are optional and not cached at render creation */
     GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES,
+    GLES2_SHADER_FRAGMENT_TEXTURE_SDF,
+    GLES2_SHADER_FRAGMENT_TEXTURE_MSDF,
+#if SDL_HAVE_YUV
+    GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_JPEG,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT601,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YUY2_BT709,
+    GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_JPEG,
+    GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT601,
+    GLES2_SHADER_FRAGMENT_TEXTURE_UYVY_BT709,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_JPEG,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT601,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YVYU_BT709,
+#endif
+    GLES2_SHADER_VERTEX_INSTANCED,
     GLES2_SHADER_COUNT
 } GLES2_ShaderType;
 
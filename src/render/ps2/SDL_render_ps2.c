@@ -52,6 +52,7 @@ typedef struct
 {
     GSGLOBAL *gsGlobal;
     uint64_t drawColor;
+    SDL_BlendMode blendMode; /* the blend mode last sent to the GS, or SDL_BLENDMODE_INVALID */
     int32_t vsync_callback_id;
     uint8_t vsync; /* 0 (Disabled), 1 (Enabled), 2 (Dynamic) */
 } PS2_RenderData;
@@ -370,6 +371,11 @@ static void PS2_SetBlendMode(PS2_RenderData *data, int blendMode)
 #define A_ALPHA_DEST   1
 #define A_ALPHA_FIX    2
 
+    if (blendMode == data->blendMode) {
+        return;
+    }
+    data->blendMode = blendMode;
+
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
     {
@@ -399,10 +405,9 @@ static void PS2_SetBlendMode(PS2_RenderData *data, int blendMode)
     }
 }
 
-static int PS2_RenderGeometry(SDL_Renderer *renderer, void *vertices, SDL_RenderCommand *cmd)
+static int PS2_RenderGeometry(SDL_Renderer *renderer, void *vertices, SDL_RenderCommand *cmd, size_t count)
 {
     PS2_RenderData *data = (PS2_RenderData *)renderer->driverdata;
-    const size_t count = cmd->data.draw.count;
 
     PS2_SetBlendMode(data, cmd->data.draw.blend);
 
@@ -448,6 +453,11 @@ int PS2_RenderPoints(SDL_Renderer *renderer, void *vertices, SDL_RenderCommand *
 
 static int PS2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    PS2_RenderData *data = (PS2_RenderData *)renderer->driverdata;
+
+    /* The GS alpha state isn't known at the start of a new queue */
+    data->blendMode = SDL_BLENDMODE_INVALID;
+
     while (cmd) {
         switch (cmd->command) {
         case SDL_RENDERCMD_SETVIEWPORT:
@@ -488,9 +498,32 @@ static int PS2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             break;
         case SDL_RENDERCMD_GEOMETRY:
         {
-            PS2_RenderGeometry(renderer, vertices, cmd);
+            /* Draw runs of triangles with the same texture and blend mode as one primitive list,
+               binding the texture once for the whole run. */
+            SDL_Texture *thistexture = cmd->data.draw.texture;
+            const size_t stride = thistexture ? sizeof(GSPRIMUVPOINT) : sizeof(GSPRIMPOINT);
+            SDL_RenderCommand *finalcmd = cmd;
+            SDL_RenderCommand *nextcmd = cmd->next;
+            size_t count = cmd->data.draw.count;
+            while (nextcmd) {
+                if (nextcmd->command != SDL_RENDERCMD_GEOMETRY) {
+                    break; /* can't go any further on this draw call, different render command up next. */
+                } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != cmd->data.draw.blend) {
+                    break; /* can't go any further on this draw call, different texture/blendmode copy up next. */
+                } else if (nextcmd->data.draw.first != cmd->data.draw.first + count * stride) {
+                    break; /* the vertices aren't contiguous. */
+                }
+                finalcmd = nextcmd;
+                count += nextcmd->data.draw.count;
+                nextcmd = nextcmd->next;
+            }
+
+            PS2_RenderGeometry(renderer, vertices, cmd, count);
+            cmd = finalcmd; /* skip any copy commands we just combined in here. */
             break;
         }
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -93,6 +93,7 @@ typedef struct
 
     SDL_bool vsync;                       /**< whether we do vsync */
     PSP_BlendState blendState;            /**< current blend mode */
+    SDL_bool textureDirty;                /**< the current texture must be activated again */
     PSP_TextureData *most_recent_target;  /**< start of render target LRU double linked list */
     PSP_TextureData *least_recent_target; /**< end of the LRU list */
 
@@ -563,6 +564,7 @@ static int PSP_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                              const SDL_Rect *rect, const void *pixels, int pitch)
 {
     /*  PSP_TextureData *psp_texture = (PSP_TextureData *) texture->driverdata; */
+    PSP_RenderData *data = (PSP_RenderData *)renderer->driverdata;
     const Uint8 *src;
     Uint8 *dst;
     int row, length, dpitch;
@@ -581,6 +583,10 @@ static int PSP_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     }
 
     sceKernelDcacheWritebackAll();
+
+    if (texture == data->blendState.texture) {
+        data->textureDirty = SDL_TRUE;
+    }
     return 0;
 }
 
@@ -962,6 +968,8 @@ static void StartDrawing(SDL_Renderer *renderer)
             sceGuDrawBufferList(data->psm, vrelptr(data->frontbuffer), PSP_FRAME_BUFFER_WIDTH);
         }
         data->boundTarget = texture;
+        /* Binding a target may have moved texture data between VRAM and system memory */
+        data->textureDirty = SDL_TRUE;
     }
 }
 
@@ -1009,7 +1017,8 @@ static void PSP_SetBlendState(PSP_RenderData *data, PSP_BlendState *state)
         sceGuShadeModel(state->shadeModel);
     }
 
-    if (state->texture != current->texture) {
+    if (state->texture != current->texture || (state->texture && data->textureDirty)) {
+        data->textureDirty = SDL_FALSE;
         if (state->texture) {
             TextureActivate(state->texture);
             sceGuEnable(GU_TEXTURE_2D);
@@ -1021,6 +1030,36 @@ static void PSP_SetBlendState(PSP_RenderData *data, PSP_BlendState *state)
     *current = *state;
 }
 
+/* Finds the run of commands starting at cmd that can go out as one sprite list:
+   same texture, blend mode and color, with their vertex pairs back to back. */
+static SDL_RenderCommand *PSP_FindSpriteBatch(SDL_RenderCommand *cmd, size_t vertsize, size_t *count)
+{
+    SDL_RenderCommand *finalcmd = cmd;
+    SDL_RenderCommand *nextcmd = cmd->next;
+    size_t total = cmd->data.draw.count;
+
+    while (nextcmd) {
+        if (nextcmd->command != cmd->command) {
+            break;
+        } else if (nextcmd->data.draw.texture != cmd->data.draw.texture || nextcmd->data.draw.blend != cmd->data.draw.blend) {
+            break;
+        } else if (nextcmd->data.draw.r != cmd->data.draw.r || nextcmd->data.draw.g != cmd->data.draw.g ||
+                   nextcmd->data.draw.b != cmd->data.draw.b || nextcmd->data.draw.a != cmd->data.draw.a) {
+            break;
+        } else if (nextcmd->data.draw.first != cmd->data.draw.first + total * 2 * vertsize) {
+            break;
+        } else if ((total + nextcmd->data.draw.count) * 2 > 0xFFFF) {
+            break; /* sceGuDrawArray() takes a 16-bit vertex count */
+        }
+        total += nextcmd->data.draw.count;
+        finalcmd = nextcmd;
+        nextcmd = nextcmd->next;
+    }
+
+    *count = total;
+    return finalcmd;
+}
+
 static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     PSP_RenderData *data = (PSP_RenderData *)renderer->driverdata;
@@ -1119,7 +1158,8 @@ static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
         case SDL_RENDERCMD_FILL_RECTS:
         {
-            const size_t count = cmd->data.draw.count;
+            size_t count;
+            SDL_RenderCommand *finalcmd = PSP_FindSpriteBatch(cmd, sizeof(VertV), &count);
             const VertV *verts = (VertV *)(gpumem + cmd->data.draw.first);
             const Uint8 r = cmd->data.draw.r;
             const Uint8 g = cmd->data.draw.g;
@@ -1133,12 +1173,14 @@ static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             };
             PSP_SetBlendState(data, &state);
             sceGuDrawArray(GU_SPRITES, GU_VERTEX_32BITF | GU_TRANSFORM_2D, 2 * count, 0, verts);
+            cmd = finalcmd; /* skip the commands we just drew with this one */
             break;
         }
 
         case SDL_RENDERCMD_COPY:
         {
-            const size_t count = cmd->data.draw.count;
+            size_t count;
+            SDL_RenderCommand *finalcmd = PSP_FindSpriteBatch(cmd, sizeof(VertTV), &count);
             const VertTV *verts = (VertTV *)(gpumem + cmd->data.draw.first);
             const Uint8 a = cmd->data.draw.a;
             const Uint8 r = cmd->data.draw.r;
@@ -1152,6 +1194,7 @@ static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             };
             PSP_SetBlendState(data, &state);
             sceGuDrawArray(GU_SPRITES, GU_TEXTURE_32BITF | GU_VERTEX_32BITF | GU_TRANSFORM_2D, 2 * count, 0, verts);
+            cmd = finalcmd; /* skip the commands we just drew with this one */
             break;
         }
 
@@ -1178,10 +1221,14 @@ static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const size_t count = cmd->data.draw.count;
             if (!cmd->data.draw.texture) {
                 const VertCV *verts = (VertCV *)(gpumem + cmd->data.draw.first);
-                sceGuDisable(GU_TEXTURE_2D);
-                /* In GU_SMOOTH mode */
+                PSP_BlendState state = {
+                    .color = data->blendState.color,
+                    .texture = NULL,
+                    .mode = cmd->data.draw.blend,
+                    .shadeModel = GU_SMOOTH
+                };
+                PSP_SetBlendState(data, &state);
                 sceGuDrawArray(GU_TRIANGLES, GU_COLOR_8888 | GU_VERTEX_32BITF | GU_TRANSFORM_2D, count, 0, verts);
-                sceGuEnable(GU_TEXTURE_2D);
             } else {
                 const VertTCV *verts = (VertTCV *)(gpumem + cmd->data.draw.first);
                 const Uint8 a = cmd->data.draw.a;
@@ -1190,17 +1237,19 @@ static int PSP_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
                 const Uint8 b = cmd->data.draw.b;
                 PSP_BlendState state = {
                     .color = GU_RGBA(r, g, b, a),
-                    .texture = NULL,
+                    .texture = cmd->data.draw.texture,
                     .mode = cmd->data.draw.blend,
                     .shadeModel = GU_FLAT
                 };
-                TextureActivate(cmd->data.draw.texture);
                 PSP_SetBlendState(data, &state);
                 sceGuDrawArray(GU_TRIANGLES, GU_TEXTURE_32BITF | GU_COLOR_8888 | GU_VERTEX_32BITF | GU_TRANSFORM_2D, count, 0, verts);
             }
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -1252,6 +1301,10 @@ static void PSP_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         return;
     }
 
+    if (texture == renderdata->blendState.texture) {
+        renderdata->textureDirty = SDL_TRUE;
+    }
+
     LRUTargetRemove(renderdata, psp_texture);
     TextureStorageFree(psp_texture->data);
     SDL_free(psp_texture);
@@ -25,6 +25,406 @@
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
 
+/* Vectorized fills for the common 16 and 32-bit formats.  They give exactly
+   the same results as the DRAW_SETPIXEL_* operators, and handle the widest
+   run of columns that fits their vector width; the remaining columns on the
+   right go through the per-pixel operators. */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN && (defined(SDL_SSE2_INTRINSICS) || defined(SDL_NEON_INTRINSICS))
+#define SDL_BLENDFILL_SIMD
+
+/* Per channel constants, in the byte order of a 32-bit pixel in memory */
+typedef struct
+{
+    SDL_BlendMode blendMode;
+    Uint32 add;  /* added premultiplied color for BLEND and ADD */
+    Uint32 mul;  /* color multiplier for MOD and MUL */
+    Uint32 inva; /* destination multiplier for BLEND and MUL */
+    Uint32 color;
+    Uint32 mask;
+} SDL_BlendFill8888;
+
+static void SDL_SetupBlendFill8888(SDL_BlendFill8888 *fill, SDL_BlendMode blendMode,
+                                   Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_bool has_alpha)
+{
+    const Uint32 rgb = ((Uint32)r << 16) | ((Uint32)g << 8) | b;
+    const Uint32 inva = 0xff - a;
+
+    fill->blendMode = blendMode;
+    fill->mask = has_alpha ? 0xFFFFFFFF : 0x00FFFFFF;
+    fill->color = (((Uint32)a << 24) | rgb) & fill->mask;
+    fill->inva = inva * 0x010101;
+    fill->add = rgb;
+    fill->mul = rgb;
+
+    /* Pick the alpha channel constants so the destination alpha is
+       blended for BLEND and left alone otherwise */
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        fill->add |= (Uint32)a << 24;
+        fill->inva |= inva << 24;
+        break;
+    case SDL_BLENDMODE_MOD:
+    case SDL_BLENDMODE_MUL:
+        fill->mul |= 0xFF000000;
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* x / 255 for x <= 255 * 255 */
+#define DIV255_SSE2(x) _mm_srli_epi16(_mm_mulhi_epu16(x, div255), 7)
+
+static int SDL_TARGETING("sse2") SDL_BlendFillRect8888_SSE2(Uint8 *pixels, int pitch, int w, int h, const SDL_BlendFill8888 *fill)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div255 = _mm_set1_epi16((short)0x8081);
+    const __m128i add8 = _mm_set1_epi32((int)fill->add);
+    const __m128i add = _mm_unpacklo_epi8(add8, zero);
+    const __m128i mul = _mm_unpacklo_epi8(_mm_set1_epi32((int)fill->mul), zero);
+    const __m128i inva = _mm_unpacklo_epi8(_mm_set1_epi32((int)fill->inva), zero);
+    const __m128i mask = _mm_set1_epi32((int)fill->mask);
+    const __m128i color = _mm_set1_epi32((int)fill->color);
+    const int width = w & ~3;
+    int x;
+
+    while (h--) {
+        __m128i *pixel = (__m128i *)pixels;
+
+        for (x = 0; x < width; x += 4, ++pixel) {
+            const __m128i d = _mm_loadu_si128(pixel);
+            __m128i lo = _mm_unpacklo_epi8(d, zero);
+            __m128i hi = _mm_unpackhi_epi8(d, zero);
+            __m128i result;
+
+            switch (fill->blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                lo = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(lo, inva)), add);
+                hi = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(hi, inva)), add);
+                result = _mm_packus_epi16(lo, hi);
+                break;
+            case SDL_BLENDMODE_ADD:
+                result = _mm_adds_epu8(d, add8);
+                break;
+            case SDL_BLENDMODE_MOD:
+                lo = DIV255_SSE2(_mm_mullo_epi16(lo, mul));
+                hi = DIV255_SSE2(_mm_mullo_epi16(hi, mul));
+                result = _mm_packus_epi16(lo, hi);
+                break;
+            case SDL_BLENDMODE_MUL:
+                lo = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(lo, mul)), DIV255_SSE2(_mm_mullo_epi16(lo, inva)));
+                hi = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(hi, mul)), DIV255_SSE2(_mm_mullo_epi16(hi, inva)));
+                result = _mm_packus_epi16(lo, hi);
+                break;
+            default:
+                result = color;
+                break;
+            }
+            _mm_storeu_si128(pixel, _mm_and_si128(result, mask));
+        }
+        pixels += pitch;
+    }
+    return width;
+}
+
+static int SDL_TARGETING("sse2") SDL_BlendFillRect_RGB565_SSE2(Uint8 *pixels, int pitch, int w, int h,
+                                                              SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const __m128i div255 = _mm_set1_epi16((short)0x8081);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mult5 = _mm_set1_epi16(1053);
+    const __m128i mult6 = _mm_set1_epi16(259);
+    const __m128i round6 = _mm_set1_epi16(3);
+    const __m128i max = _mm_set1_epi16(0xFF);
+    const __m128i cr = _mm_set1_epi16(r);
+    const __m128i cg = _mm_set1_epi16(g);
+    const __m128i cb = _mm_set1_epi16(b);
+    const __m128i inva = _mm_set1_epi16(0xFF - a);
+    const __m128i color = _mm_set1_epi16((short)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)));
+    const int width = w & ~7;
+    int x;
+
+    while (h--) {
+        __m128i *pixel = (__m128i *)pixels;
+
+        for (x = 0; x < width; x += 8, ++pixel) {
+            const __m128i d = _mm_loadu_si128(pixel);
+            /* Expand the channels the same way as SDL_expand_byte[] */
+            __m128i sr = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(d, 11), mult5), 7);
+            __m128i sg = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 5), mask6), mult6), round6), 6);
+            __m128i sb = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(d, mask5), mult5), 7);
+
+            switch (blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                sr = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sr, inva)), cr);
+                sg = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sg, inva)), cg);
+                sb = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sb, inva)), cb);
+                break;
+            case SDL_BLENDMODE_ADD:
+                sr = _mm_min_epi16(_mm_add_epi16(sr, cr), max);
+                sg = _mm_min_epi16(_mm_add_epi16(sg, cg), max);
+                sb = _mm_min_epi16(_mm_add_epi16(sb, cb), max);
+                break;
+            case SDL_BLENDMODE_MOD:
+                sr = DIV255_SSE2(_mm_mullo_epi16(sr, cr));
+                sg = DIV255_SSE2(_mm_mullo_epi16(sg, cg));
+                sb = DIV255_SSE2(_mm_mullo_epi16(sb, cb));
+                break;
+            case SDL_BLENDMODE_MUL:
+                sr = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sr, cr)), DIV255_SSE2(_mm_mullo_epi16(sr, inva))), max);
+                sg = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sg, cg)), DIV255_SSE2(_mm_mullo_epi16(sg, inva))), max);
+                sb = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(sb, cb)), DIV255_SSE2(_mm_mullo_epi16(sb, inva))), max);
+                break;
+            default:
+                _mm_storeu_si128(pixel, color);
+                continue;
+            }
+            _mm_storeu_si128(pixel, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(sr, 3), 11),
+                                                              _mm_slli_epi16(_mm_srli_epi16(sg, 2), 5)),
+                                                 _mm_srli_epi16(sb, 3)));
+        }
+        pixels += pitch;
+    }
+    return width;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+#define DIV255_AVX2(x) _mm256_srli_epi16(_mm256_mulhi_epu16(x, div255), 7)
+
+static int SDL_TARGETING("avx2") SDL_BlendFillRect8888_AVX2(Uint8 *pixels, int pitch, int w, int h, const SDL_BlendFill8888 *fill)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i div255 = _mm256_set1_epi16((short)0x8081);
+    const __m256i add8 = _mm256_set1_epi32((int)fill->add);
+    const __m256i add = _mm256_unpacklo_epi8(add8, zero);
+    const __m256i mul = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)fill->mul), zero);
+    const __m256i inva = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)fill->inva), zero);
+    const __m256i mask = _mm256_set1_epi32((int)fill->mask);
+    const __m256i color = _mm256_set1_epi32((int)fill->color);
+    const int width = w & ~7;
+    int x;
+
+    while (h--) {
+        __m256i *pixel = (__m256i *)pixels;
+
+        for (x = 0; x < width; x += 8, ++pixel) {
+            const __m256i d = _mm256_loadu_si256(pixel);
+            __m256i lo = _mm256_unpacklo_epi8(d, zero);
+            __m256i hi = _mm256_unpackhi_epi8(d, zero);
+            __m256i result;
+
+            /* The unpacks and packs work within 128-bit lanes, which keeps
+               the pixels in order */
+            switch (fill->blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                lo = _mm256_add_epi16(DIV255_AVX2(_mm256_mullo_epi16(lo, inva)), add);
+                hi = _mm256_add_epi16(DIV255_AVX2(_mm256_mullo_epi16(hi, inva)), add);
+                result = _mm256_packus_epi16(lo, hi);
+                break;
+            case SDL_BLENDMODE_ADD:
+                result = _mm256_adds_epu8(d, add8);
+                break;
+            case SDL_BLENDMODE_MOD:
+                lo = DIV255_AVX2(_mm256_mullo_epi16(lo, mul));
+                hi = DIV255_AVX2(_mm256_mullo_epi16(hi, mul));
+                result = _mm256_packus_epi16(lo, hi);
+                break;
+            case SDL_BLENDMODE_MUL:
+                lo = _mm256_add_epi16(DIV255_AVX2(_mm256_mullo_epi16(lo, mul)), DIV255_AVX2(_mm256_mullo_epi16(lo, inva)));
+                hi = _mm256_add_epi16(DIV255_AVX2(_mm256_mullo_epi16(hi, mul)), DIV255_AVX2(_mm256_mullo_epi16(hi, inva)));
+                result = _mm256_packus_epi16(lo, hi);
+                break;
+            default:
+                result = color;
+                break;
+            }
+            _mm256_storeu_si256(pixel, _mm256_and_si256(result, mask));
+        }
+        pixels += pitch;
+    }
+    return width;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* x / 255 for x <= 255 * 255, narrowed to bytes */
+static SDL_INLINE uint8x8_t DIV255_NEON(uint16x8_t x)
+{
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+static SDL_INLINE uint16x8_t DIV255_NEON_U16(uint16x8_t x)
+{
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+static int SDL_BlendFillRect8888_NEON(Uint8 *pixels, int pitch, int w, int h, const SDL_BlendFill8888 *fill)
+{
+    const uint8x16_t add = vreinterpretq_u8_u32(vdupq_n_u32(fill->add));
+    const uint8x8_t mul = vreinterpret_u8_u32(vdup_n_u32(fill->mul));
+    const uint8x8_t inva = vreinterpret_u8_u32(vdup_n_u32(fill->inva));
+    const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(fill->mask));
+    const uint32x4_t color = vdupq_n_u32(fill->color);
+    const int width = w & ~3;
+    int x;
+
+    while (h--) {
+        Uint8 *pixel = pixels;
+
+        for (x = 0; x < width; x += 4, pixel += 16) {
+            const uint8x16_t d = vld1q_u8(pixel);
+            uint8x16_t result;
+
+            switch (fill->blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                result = vaddq_u8(vcombine_u8(DIV255_NEON(vmull_u8(vget_low_u8(d), inva)),
+                                              DIV255_NEON(vmull_u8(vget_high_u8(d), inva))),
+                                  add);
+                break;
+            case SDL_BLENDMODE_ADD:
+                result = vqaddq_u8(d, add);
+                break;
+            case SDL_BLENDMODE_MOD:
+                result = vcombine_u8(DIV255_NEON(vmull_u8(vget_low_u8(d), mul)),
+                                     DIV255_NEON(vmull_u8(vget_high_u8(d), mul)));
+                break;
+            case SDL_BLENDMODE_MUL:
+                result = vqaddq_u8(vcombine_u8(DIV255_NEON(vmull_u8(vget_low_u8(d), mul)),
+                                               DIV255_NEON(vmull_u8(vget_high_u8(d), mul))),
+                                   vcombine_u8(DIV255_NEON(vmull_u8(vget_low_u8(d), inva)),
+                                               DIV255_NEON(vmull_u8(vget_high_u8(d), inva))));
+                break;
+            default:
+                result = vreinterpretq_u8_u32(color);
+                break;
+            }
+            vst1q_u8(pixel, vandq_u8(result, mask));
+        }
+        pixels += pitch;
+    }
+    return width;
+}
+
+static int SDL_BlendFillRect_RGB565_NEON(Uint8 *pixels, int pitch, int w, int h,
+                                         SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    const uint16x8_t round6 = vdupq_n_u16(3);
+    const uint16x8_t max = vdupq_n_u16(0xFF);
+    const uint16x8_t cr = vdupq_n_u16(r);
+    const uint16x8_t cg = vdupq_n_u16(g);
+    const uint16x8_t cb = vdupq_n_u16(b);
+    const uint16x8_t inva = vdupq_n_u16(0xFF - a);
+    const uint16x8_t color = vdupq_n_u16((Uint16)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)));
+    const int width = w & ~7;
+    int x;
+
+    while (h--) {
+        Uint16 *pixel = (Uint16 *)pixels;
+
+        for (x = 0; x < width; x += 8, pixel += 8) {
+            const uint16x8_t d = vld1q_u16(pixel);
+            /* Expand the channels the same way as SDL_expand_byte[] */
+            uint16x8_t sr = vshrq_n_u16(vmulq_n_u16(vshrq_n_u16(d, 11), 1053), 7);
+            uint16x8_t sg = vshrq_n_u16(vaddq_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(d, 5), mask6), 259), round6), 6);
+            uint16x8_t sb = vshrq_n_u16(vmulq_n_u16(vandq_u16(d, mask5), 1053), 7);
+
+            switch (blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                sr = vaddq_u16(DIV255_NEON_U16(vmulq_u16(sr, inva)), cr);
+                sg = vaddq_u16(DIV255_NEON_U16(vmulq_u16(sg, inva)), cg);
+                sb = vaddq_u16(DIV255_NEON_U16(vmulq_u16(sb, inva)), cb);
+                break;
+            case SDL_BLENDMODE_ADD:
+                sr = vminq_u16(vaddq_u16(sr, cr), max);
+                sg = vminq_u16(vaddq_u16(sg, cg), max);
+                sb = vminq_u16(vaddq_u16(sb, cb), max);
+                break;
+            case SDL_BLENDMODE_MOD:
+                sr = DIV255_NEON_U16(vmulq_u16(sr, cr));
+                sg = DIV255_NEON_U16(vmulq_u16(sg, cg));
+                sb = DIV255_NEON_U16(vmulq_u16(sb, cb));
+                break;
+            case SDL_BLENDMODE_MUL:
+                sr = vminq_u16(vaddq_u16(DIV255_NEON_U16(vmulq_u16(sr, cr)), DIV255_NEON_U16(vmulq_u16(sr, inva))), max);
+                sg = vminq_u16(vaddq_u16(DIV255_NEON_U16(vmulq_u16(sg, cg)), DIV255_NEON_U16(vmulq_u16(sg, inva))), max);
+                sb = vminq_u16(vaddq_u16(DIV255_NEON_U16(vmulq_u16(sb, cb)), DIV255_NEON_U16(vmulq_u16(sb, inva))), max);
+                break;
+            default:
+                vst1q_u16(pixel, color);
+                continue;
+            }
+            vst1q_u16(pixel, vorrq_u16(vorrq_u16(vshlq_n_u16(vshrq_n_u16(sr, 3), 11),
+                                                 vshlq_n_u16(vshrq_n_u16(sg, 2), 5)),
+                                       vshrq_n_u16(sb, 3)));
+        }
+        pixels += pitch;
+    }
+    return width;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Returns the number of columns on the left of the rectangle that were filled */
+static int SDL_BlendFillRect8888_SIMD(SDL_Surface *dst, const SDL_Rect *rect, SDL_BlendMode blendMode,
+                                      Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_bool has_alpha)
+{
+    Uint8 *pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch + rect->x * 4;
+    SDL_BlendFill8888 fill;
+
+    SDL_SetupBlendFill8888(&fill, blendMode, r, g, b, a, has_alpha);
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_BlendFillRect8888_AVX2(pixels, dst->pitch, rect->w, rect->h, &fill);
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_BlendFillRect8888_SSE2(pixels, dst->pitch, rect->w, rect->h, &fill);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_BlendFillRect8888_NEON(pixels, dst->pitch, rect->w, rect->h, &fill);
+    }
+#endif
+    return 0;
+}
+
+static int SDL_BlendFillRect565_SIMD(SDL_Surface *dst, const SDL_Rect *rect, SDL_BlendMode blendMode,
+                                     Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    Uint8 *pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch + rect->x * 2;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_BlendFillRect_RGB565_SSE2(pixels, dst->pitch, rect->w, rect->h, blendMode, r, g, b, a);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_BlendFillRect_RGB565_NEON(pixels, dst->pitch, rect->w, rect->h, blendMode, r, g, b, a);
+    }
+#endif
+    return 0;
+}
+
+/* Narrow the rectangle to the columns the vectorized fill didn't cover */
+#define SDL_BLENDFILL_REMAINDER(done)  \
+    if (done) {                        \
+        tail = *rect;                  \
+        tail.x += done;                \
+        tail.w -= done;                \
+        if (tail.w == 0) {             \
+            return 0;                  \
+        }                              \
+        rect = &tail;                  \
+    }
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN && (SSE2 || NEON) */
+
 static int SDL_BlendFillRect_RGB555(SDL_Surface *dst, const SDL_Rect *rect,
                                     SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
@@ -54,6 +454,12 @@ static int SDL_BlendFillRect_RGB565(SDL_Surface *dst, const SDL_Rect *rect,
                                     SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     unsigned inva = 0xff - a;
+#ifdef SDL_BLENDFILL_SIMD
+    SDL_Rect tail;
+    const int done = SDL_BlendFillRect565_SIMD(dst, rect, blendMode, r, g, b, a);
+
+    SDL_BLENDFILL_REMAINDER(done);
+#endif
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
@@ -79,6 +485,12 @@ static int SDL_BlendFillRect_XRGB8888(SDL_Surface *dst, const SDL_Rect *rect,
                                     SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     unsigned inva = 0xff - a;
+#ifdef SDL_BLENDFILL_SIMD
+    SDL_Rect tail;
+    const int done = SDL_BlendFillRect8888_SIMD(dst, rect, blendMode, r, g, b, a, SDL_FALSE);
+
+    SDL_BLENDFILL_REMAINDER(done);
+#endif
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
@@ -104,6 +516,12 @@ static int SDL_BlendFillRect_ARGB8888(SDL_Surface *dst, const SDL_Rect *rect,
                                       SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     unsigned inva = 0xff - a;
+#ifdef SDL_BLENDFILL_SIMD
+    SDL_Rect tail;
+    const int done = SDL_BlendFillRect8888_SIMD(dst, rect, blendMode, r, g, b, a, SDL_TRUE);
+
+    SDL_BLENDFILL_REMAINDER(done);
+#endif
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
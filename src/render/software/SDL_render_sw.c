@@ -33,20 +33,66 @@
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
+#include "../../thread/SDL_systhread.h"
 
 /* SDL surface based renderer implementation */
 
+/* Large targets are rasterized in parallel: the target is split into
+   horizontal bands, one per worker, and each run of commands that only
+   touch the target is replayed by every worker clipped to its own band,
+   so the draw order within a band is preserved. Commands that read from
+   textures change the source surface state, so they run on the calling
+   thread in between runs. */
+#define SW_MAX_RENDER_THREADS   8
+#define SW_MIN_THREADED_PIXELS  (256 * 256)
+
+/* Presenting to a window only updates the parts of the window surface that
+   the queued commands drew to. Up to this many separate rects are tracked,
+   after that they're merged into their bounding rect. */
+#define SW_MAX_DAMAGE_RECTS 8
+
 typedef struct
 {
     const SDL_Rect *viewport;
     const SDL_Rect *cliprect;
+    const SDL_Rect *band;
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+typedef struct SW_RenderWorker
+{
+    SDL_Renderer *renderer;
+    SDL_Thread *thread;
+    SDL_Surface *surface; /* this worker's view of the target pixels */
+    SDL_Rect band;
+} SW_RenderWorker;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The parts of the window surface changed since the last present */
+    SDL_Rect damage[SW_MAX_DAMAGE_RECTS];
+    int num_damage;
+    SDL_bool full_damage;
+
+    /* Worker pool for threaded rasterization */
+    int num_threads;
+    int num_workers;
+    SW_RenderWorker *workers;
+    SDL_Mutex *work_lock;
+    SDL_Condition *work_ready;
+    SDL_Condition *work_done;
+    Uint32 work_generation;
+    int work_remaining;
+    SDL_bool work_quit;
+
+    /* The run of commands the workers are rasterizing */
+    SDL_RenderCommand *work_first;
+    SDL_RenderCommand *work_end;
+    void *work_vertices;
+    SW_DrawStateCache work_drawstate;
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -60,6 +106,7 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->full_damage = SDL_TRUE;
         }
     }
     return data->surface;
@@ -72,6 +119,9 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->full_damage = SDL_TRUE;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED) {
+        data->full_damage = SDL_TRUE;
     }
 }
 
@@ -309,6 +359,62 @@ static int Blit_to_Screen(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *surf
     return retval;
 }
 
+/* Draws a rotated copy by sampling the texture directly, returns SDL_FALSE if the texture or
+ * target format isn't supported that way.
+ */
+static SDL_bool SW_BlitTransformed(SDL_Surface *surface, SDL_Texture *texture, SDL_Surface *src,
+                                   const SDL_Rect *srcrect, const SDL_Rect *final_rect,
+                                   const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip, float scale_x, float scale_y)
+{
+    double transform[6];
+    double sinangle, cosangle, kx, ky, ox, oy;
+    const double rad = angle * (SDL_PI_D / 180.0);
+    int angle90 = (int)(angle / 90);
+
+    /* Keep multiples of 90 degrees exact */
+    if (angle90 == angle / 90) {
+        angle90 %= 4;
+        if (angle90 < 0) {
+            angle90 += 4;
+        }
+        sinangle = (angle90 == 1) ? 1.0 : (angle90 == 3) ? -1.0 : 0.0;
+        cosangle = (angle90 == 0) ? 1.0 : (angle90 == 2) ? -1.0 : 0.0;
+    } else {
+        sinangle = SDL_sin(rad);
+        cosangle = SDL_cos(rad);
+    }
+
+    if (srcrect->w <= 0 || srcrect->h <= 0) {
+        return SDL_TRUE;
+    }
+
+    /* Scale the source rect onto the destination rect, flipping it within the rect */
+    kx = (double)final_rect->w / srcrect->w;
+    ky = (double)final_rect->h / srcrect->h;
+    ox = -srcrect->x * kx;
+    oy = -srcrect->y * ky;
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        kx = -kx;
+        ox = final_rect->w - ox;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        ky = -ky;
+        oy = final_rect->h - oy;
+    }
+    ox -= center->x;
+    oy -= center->y;
+
+    /* Then rotate clockwise around the center and apply the renderer scale */
+    transform[0] = scale_x * (cosangle * kx);
+    transform[1] = scale_x * (-sinangle * ky);
+    transform[2] = scale_x * (cosangle * ox - sinangle * oy + center->x + final_rect->x);
+    transform[3] = scale_y * (sinangle * kx);
+    transform[4] = scale_y * (cosangle * ky);
+    transform[5] = scale_y * (sinangle * ox + cosangle * oy + center->y + final_rect->y);
+
+    return SDLgfx_blitTransformed(src, srcrect, surface, transform, texture->scaleMode != SDL_SCALEMODE_NEAREST);
+}
+
 static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture,
                            const SDL_Rect *srcrect, const SDL_Rect *final_rect,
                            const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip, float scale_x, float scale_y)
@@ -340,6 +446,14 @@ static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Tex
         SDL_LockSurface(src);
     }
 
+    /* The common formats and blend modes don't need any intermediate surfaces */
+    if (SW_BlitTransformed(surface, texture, src, srcrect, final_rect, angle, center, flip, scale_x, scale_y)) {
+        if (SDL_MUSTLOCK(src)) {
+            SDL_UnlockSurface(src);
+        }
+        return 0;
+    }
+
     /* Clone the source surface but use its pixel buffer directly.
      * The original source surface must be treated as read-only.
      */
@@ -643,35 +757,294 @@ static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
         const SDL_Rect *cliprect = drawstate->cliprect;
         SDL_assert_release(viewport != NULL); /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
 
+        SDL_Rect clip_rect;
+
         if (cliprect) {
-            SDL_Rect clip_rect;
             clip_rect.x = cliprect->x + viewport->x;
             clip_rect.y = cliprect->y + viewport->y;
             clip_rect.w = cliprect->w;
             clip_rect.h = cliprect->h;
             SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
         } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
+            clip_rect = *viewport;
         }
+        if (drawstate->band) {
+            if (!SDL_GetRectIntersection(drawstate->band, &clip_rect, &clip_rect)) {
+                SDL_zero(clip_rect);
+            }
+        }
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = SDL_FALSE;
     }
 }
 
-static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+/* Offset all the vertex data by the viewport it's drawn in, once, so the commands can be replayed by several workers */
+static void SW_ApplyViewports(SDL_RenderCommand *cmd, void *vertices)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    const SDL_Rect *viewport = NULL;
+    int i;
 
-    if (!surface) {
-        return -1;
+    for (; cmd; cmd = cmd->next) {
+        if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = &cmd->data.viewport.rect;
+            continue;
+        }
+        if (!viewport || (!viewport->x && !viewport->y)) {
+            continue;
+        }
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        {
+            const int count = (int)cmd->data.draw.count;
+            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            for (i = 0; i < count; i++) {
+                verts[i].x += viewport->x;
+                verts[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS:
+        {
+            const int count = (int)cmd->data.draw.count;
+            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            for (i = 0; i < count; i++) {
+                verts[i].x += viewport->x;
+                verts[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY:
+        {
+            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            SDL_Rect *dstrect = verts + 1;
+            dstrect->x += viewport->x;
+            dstrect->y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            copydata->dstrect.x += viewport->x;
+            copydata->dstrect.y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            const int count = (int)cmd->data.draw.count;
+            void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+            SDL_Point vp;
+            vp.x = viewport->x;
+            vp.y = viewport->y;
+            trianglepoint_2_fixedpoint(&vp);
+            if (cmd->data.draw.texture) {
+                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            } else {
+                GeometryFillData *ptr = (GeometryFillData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
     }
+}
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = SDL_TRUE;
+static void SW_AddDamage(SW_RenderData *data, const SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Rect bounds;
+    SDL_Rect damage;
+    int i;
+
+    if (data->full_damage) {
+        return;
+    }
 
-    while (cmd) {
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+    if (!SDL_GetRectIntersection(&bounds, rect, &damage)) {
+        return;
+    }
+
+    for (i = 0; i < data->num_damage; ++i) {
+        if (SDL_HasRectIntersection(&data->damage[i], &damage)) {
+            SDL_GetRectUnion(&data->damage[i], &damage, &data->damage[i]);
+            break;
+        }
+    }
+    if (i == data->num_damage) {
+        if (data->num_damage == SW_MAX_DAMAGE_RECTS) {
+            for (i = 1; i < data->num_damage; ++i) {
+                SDL_GetRectUnion(&data->damage[0], &data->damage[i], &data->damage[0]);
+            }
+            i = 0;
+            data->num_damage = 1;
+            SDL_GetRectUnion(&data->damage[0], &damage, &data->damage[0]);
+        } else {
+            data->damage[data->num_damage++] = damage;
+        }
+    }
+
+    if (SDL_RectsEqual(&data->damage[i], &bounds)) {
+        data->full_damage = SDL_TRUE;
+    }
+}
+
+/* Work out which parts of the target the commands will draw to, after their viewports have been applied */
+static void SW_AccumulateDamage(SW_RenderData *data, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    const SDL_Rect *viewport = NULL;
+    const SDL_Rect *cliprect = NULL;
+    SDL_Rect clip_rect;
+    SDL_Rect rect;
+    int i;
+
+    SDL_zero(clip_rect);
+
+    for (; cmd && !data->full_damage; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+            if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+                viewport = &cmd->data.viewport.rect;
+            } else {
+                cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            }
+            if (!viewport) {
+                SDL_zero(clip_rect);
+            } else if (cliprect) {
+                clip_rect.x = cliprect->x + viewport->x;
+                clip_rect.y = cliprect->y + viewport->y;
+                clip_rect.w = cliprect->w;
+                clip_rect.h = cliprect->h;
+                if (!SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect)) {
+                    SDL_zero(clip_rect);
+                }
+            } else {
+                clip_rect = *viewport;
+            }
+            continue;
+
+        case SDL_RENDERCMD_CLEAR:
+            rect.x = 0;
+            rect.y = 0;
+            rect.w = surface->w;
+            rect.h = surface->h;
+            SW_AddDamage(data, surface, &rect);
+            continue;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        {
+            const int count = (int)cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            if (!SDL_GetRectEnclosingPoints(verts, count, NULL, &rect)) {
+                continue;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS:
+        {
+            const int count = (int)cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            SDL_zero(rect);
+            for (i = 0; i < count; i++) {
+                SDL_GetRectUnion(&rect, &verts[i], &rect);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY:
+        {
+            const SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            rect = verts[1];
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            const CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            if (copydata->angle == 0.0) {
+                rect = copydata->dstrect;
+            } else {
+                /* Anything the rotated rect could cover is within its farthest corner from the center */
+                const float cx = copydata->dstrect.x + copydata->center.x;
+                const float cy = copydata->dstrect.y + copydata->center.y;
+                const float dx = SDL_max(copydata->center.x, copydata->dstrect.w - copydata->center.x);
+                const float dy = SDL_max(copydata->center.y, copydata->dstrect.h - copydata->center.y);
+                const int radius = (int)SDL_ceilf(SDL_sqrtf(dx * dx + dy * dy)) + 1;
+                rect.x = (int)cx - radius;
+                rect.y = (int)cy - radius;
+                rect.w = 2 * radius + 1;
+                rect.h = 2 * radius + 1;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            const int count = (int)cmd->data.draw.count;
+            void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+            SDL_Point min, max;
+            if (count <= 0) {
+                continue;
+            }
+            if (cmd->data.draw.texture) {
+                const GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                min = max = ptr[0].dst;
+                for (i = 1; i < count; i++) {
+                    min.x = SDL_min(min.x, ptr[i].dst.x);
+                    min.y = SDL_min(min.y, ptr[i].dst.y);
+                    max.x = SDL_max(max.x, ptr[i].dst.x);
+                    max.y = SDL_max(max.y, ptr[i].dst.y);
+                }
+            } else {
+                const GeometryFillData *ptr = (GeometryFillData *)verts;
+                min = max = ptr[0].dst;
+                for (i = 1; i < count; i++) {
+                    min.x = SDL_min(min.x, ptr[i].dst.x);
+                    min.y = SDL_min(min.y, ptr[i].dst.y);
+                    max.x = SDL_max(max.x, ptr[i].dst.x);
+                    max.y = SDL_max(max.y, ptr[i].dst.y);
+                }
+            }
+            trianglebounds_2_rect(&min, &max, &rect);
+            break;
+        }
+
+        default:
+            continue;
+        }
+
+        if (SDL_GetRectIntersection(&clip_rect, &rect, &rect)) {
+            SW_AddDamage(data, surface, &rect);
+        }
+    }
+}
+
+/* Run the commands from cmd up to, but not including, end */
+static void SW_RunCommands(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, SDL_RenderCommand *end, void *vertices, SW_DrawStateCache *state)
+{
+    SW_DrawStateCache drawstate = *state;
+
+    while (cmd != end) {
         switch (cmd->command) {
         case SDL_RENDERCMD_SETDRAWCOLOR:
         {
@@ -698,8 +1071,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const Uint8 g = cmd->data.color.g;
             const Uint8 b = cmd->data.color.b;
             const Uint8 a = cmd->data.color.a;
-            /* By definition the clear ignores the clip rect */
-            SDL_SetSurfaceClipRect(surface, NULL);
+            /* By definition the clear ignores the clip rect, but not our band */
+            SDL_SetSurfaceClipRect(surface, drawstate.band);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
             drawstate.surface_cliprect_dirty = SDL_TRUE;
             break;
@@ -716,15 +1089,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -744,15 +1108,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -772,15 +1127,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_FillSurfaceRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -801,12 +1147,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
 
             PrepTextureForCopy(cmd);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
-            }
-
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
                 SDL_BlitSurface(src, srcrect, surface, dstrect);
             } else {
@@ -860,12 +1200,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             SetDrawState(surface, &drawstate);
             PrepTextureForCopy(cmd);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
-            }
-
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
                             copydata->scale_x, copydata->scale_y);
@@ -889,18 +1223,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
 
                 PrepTextureForCopy(cmd);
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_BlitTriangle(
                         src,
@@ -912,18 +1234,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             } else {
                 GeometryFillData *ptr = (GeometryFillData *)verts;
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
@@ -931,6 +1241,9 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -938,6 +1251,243 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         cmd = cmd->next;
     }
 
+    *state = drawstate;
+}
+
+/* Commands that only write to the target can be rasterized by the workers */
+static SDL_bool SW_IsThreadedCommand(const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_LINES:
+        /* Clipping moves the line end points, so lines split across bands wouldn't match */
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_COPY_EX:
+        return SDL_FALSE;
+    case SDL_RENDERCMD_GEOMETRY:
+        return (cmd->data.draw.texture == NULL);
+    default:
+        return SDL_TRUE;
+    }
+}
+
+static void SW_UpdateDrawState(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+{
+    if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+        drawstate->viewport = &cmd->data.viewport.rect;
+    } else if (cmd->command == SDL_RENDERCMD_SETCLIPRECT) {
+        drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+    }
+    /* The workers drew with their own views of the target, so the main surface clip rect needs updating */
+    drawstate->surface_cliprect_dirty = SDL_TRUE;
+}
+
+static int SDLCALL SW_RenderThread(void *data)
+{
+    SW_RenderWorker *worker = (SW_RenderWorker *)data;
+    SW_RenderData *renderdata = (SW_RenderData *)worker->renderer->driverdata;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(renderdata->work_lock);
+    for (;;) {
+        SW_DrawStateCache drawstate;
+
+        while (!renderdata->work_quit && renderdata->work_generation == generation) {
+            SDL_WaitCondition(renderdata->work_ready, renderdata->work_lock);
+        }
+        if (renderdata->work_quit) {
+            break;
+        }
+        generation = renderdata->work_generation;
+        drawstate = renderdata->work_drawstate;
+        drawstate.band = &worker->band;
+        drawstate.surface_cliprect_dirty = SDL_TRUE;
+        SDL_UnlockMutex(renderdata->work_lock);
+
+        SW_RunCommands(worker->renderer, worker->surface, renderdata->work_first, renderdata->work_end, renderdata->work_vertices, &drawstate);
+
+        SDL_LockMutex(renderdata->work_lock);
+        if (--renderdata->work_remaining == 0) {
+            SDL_SignalCondition(renderdata->work_done);
+        }
+    }
+    SDL_UnlockMutex(renderdata->work_lock);
+
+    return 0;
+}
+
+static void SW_StopRenderThreads(SW_RenderData *data)
+{
+    int i;
+
+    if (data->workers) {
+        SDL_LockMutex(data->work_lock);
+        data->work_quit = SDL_TRUE;
+        SDL_BroadcastCondition(data->work_ready);
+        SDL_UnlockMutex(data->work_lock);
+
+        for (i = 0; i < data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i].thread, NULL);
+            SDL_DestroySurface(data->workers[i].surface);
+        }
+        SDL_free(data->workers);
+        data->workers = NULL;
+    }
+    data->num_workers = 0;
+
+    SDL_DestroyCondition(data->work_done);
+    data->work_done = NULL;
+    SDL_DestroyCondition(data->work_ready);
+    data->work_ready = NULL;
+    SDL_DestroyMutex(data->work_lock);
+    data->work_lock = NULL;
+}
+
+static SDL_bool SW_StartRenderThreads(SDL_Renderer *renderer)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+    int i;
+
+    data->work_lock = SDL_CreateMutex();
+    data->work_ready = SDL_CreateCondition();
+    data->work_done = SDL_CreateCondition();
+    data->workers = (SW_RenderWorker *)SDL_calloc(data->num_threads, sizeof(*data->workers));
+    if (!data->work_lock || !data->work_ready || !data->work_done || !data->workers) {
+        SW_StopRenderThreads(data);
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < data->num_threads; ++i) {
+        SW_RenderWorker *worker = &data->workers[i];
+        worker->renderer = renderer;
+        worker->thread = SDL_CreateThreadInternal(SW_RenderThread, "SDLSWRender", 0, worker);
+        if (!worker->thread) {
+            break;
+        }
+        ++data->num_workers;
+    }
+    if (data->num_workers < 2) {
+        SW_StopRenderThreads(data);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static int SW_SetupRenderWorkers(SW_RenderData *data, SDL_Surface *surface)
+{
+    const int band_h = (surface->h + data->num_workers - 1) / data->num_workers;
+    int i;
+
+    for (i = 0; i < data->num_workers; ++i) {
+        SW_RenderWorker *worker = &data->workers[i];
+        SDL_Surface *view = worker->surface;
+
+        /* Each worker draws through its own surface so it has its own clip rect and blit maps */
+        if (!view || view->pixels != surface->pixels || view->w != surface->w || view->h != surface->h ||
+            view->pitch != surface->pitch || view->format->format != surface->format->format) {
+            SDL_DestroySurface(view);
+            view = SDL_CreateSurfaceFrom(surface->pixels, surface->w, surface->h, surface->pitch, surface->format->format);
+            worker->surface = view;
+            if (!view) {
+                return -1;
+            }
+        }
+
+        worker->band.x = 0;
+        worker->band.y = i * band_h;
+        worker->band.w = surface->w;
+        worker->band.h = SDL_max(SDL_min(band_h, surface->h - worker->band.y), 0);
+    }
+    return 0;
+}
+
+/* Have the workers rasterize the commands from cmd up to, but not including, end */
+static void SW_RunCommandsThreaded(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_RenderCommand *end, void *vertices, const SW_DrawStateCache *drawstate)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+
+    SDL_LockMutex(data->work_lock);
+    data->work_first = cmd;
+    data->work_end = end;
+    data->work_vertices = vertices;
+    data->work_drawstate = *drawstate;
+    data->work_remaining = data->num_workers;
+    ++data->work_generation;
+    SDL_BroadcastCondition(data->work_ready);
+    while (data->work_remaining > 0) {
+        SDL_WaitCondition(data->work_done, data->work_lock);
+    }
+    SDL_UnlockMutex(data->work_lock);
+}
+
+static SDL_bool SW_CanRunThreaded(SDL_Renderer *renderer, SDL_Surface *surface)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+
+    if (data->num_threads < 2 ||
+        (surface->w * surface->h) < SW_MIN_THREADED_PIXELS ||
+        SDL_MUSTLOCK(surface) ||
+        SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+        return SDL_FALSE;
+    }
+
+    if (!data->workers && !SW_StartRenderThreads(renderer)) {
+        /* Don't try again */
+        data->num_threads = 0;
+        return SDL_FALSE;
+    }
+    return (SW_SetupRenderWorkers(data, surface) == 0);
+}
+
+static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+
+    if (!surface) {
+        return -1;
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.band = NULL;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+
+    SW_ApplyViewports(cmd, vertices);
+
+    if (surface == data->window) {
+        SW_AccumulateDamage(data, surface, cmd, vertices);
+    }
+
+    if (SW_CanRunThreaded(renderer, surface)) {
+        SDL_RenderCommand *first = NULL;
+        SW_DrawStateCache first_drawstate;
+
+        SDL_zero(first_drawstate);
+
+        while (cmd) {
+            if (SW_IsThreadedCommand(cmd)) {
+                if (!first) {
+                    first = cmd;
+                    first_drawstate = drawstate;
+                }
+                SW_UpdateDrawState(cmd, &drawstate);
+            } else {
+                if (first) {
+                    SW_RunCommandsThreaded(renderer, first, cmd, vertices, &first_drawstate);
+                    first = NULL;
+                }
+                SW_RunCommands(renderer, surface, cmd, cmd->next, vertices, &drawstate);
+            }
+            cmd = cmd->next;
+        }
+        if (first) {
+            SW_RunCommandsThreaded(renderer, first, NULL, vertices, &first_drawstate);
+        }
+    } else {
+        SW_RunCommands(renderer, surface, cmd, NULL, vertices, &drawstate);
+    }
+
     return 0;
 }
 
@@ -973,12 +1523,26 @@ static int SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
 
 static int SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
     SDL_Window *window = renderer->window;
+    int retval = 0;
 
     if (!window) {
         return -1;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    if (data->full_damage) {
+        retval = SDL_UpdateWindowSurface(window);
+    } else if (data->num_damage > 0) {
+        retval = SDL_UpdateWindowSurfaceRects(window, data->damage, data->num_damage);
+    } else if (renderer->wanted_vsync && !renderer->simulate_vsync) {
+        /* Nothing to copy, but the window texture would have throttled us, so keep the pace */
+        SDL_SimulateRenderVSync(renderer);
+    }
+    data->num_damage = 0;
+    data->full_damage = SDL_FALSE;
+
+    return retval;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -996,6 +1560,9 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    if (data) {
+        SW_StopRenderThreads(data);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -1093,6 +1660,19 @@ static void SW_SelectBestFormats(SDL_Renderer *renderer, Uint32 format)
     }
 }
 
+static int SW_GetNumRenderThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    int num_threads;
+
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+    } else {
+        num_threads = SDL_GetCPUCount();
+    }
+    return SDL_clamp(num_threads, 0, SW_MAX_RENDER_THREADS);
+}
+
 SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
 {
     SDL_Renderer *renderer;
@@ -1117,6 +1697,8 @@ SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->full_damage = SDL_TRUE;
+    data->num_threads = SW_GetNumRenderThreads();
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
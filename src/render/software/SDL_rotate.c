@@ -613,4 +613,469 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
     return rz_dst;
 }
 
+/* ---- Direct affine blitting */
+
+/**
+Destination pixels are produced in chunks of this many pixels.
+*/
+#define AFFINE_CHUNK 256
+
+/**
+A run of destination pixels and where it samples the source.
+*/
+typedef struct tAffineSpan
+{
+    const Uint8 *pixels;
+    int pitch;
+    int minx, miny, maxx, maxy; /* inclusive source texel bounds, used for clamping */
+    int u, v;                   /* 16.16 source position of the first pixel */
+    int du, dv;                 /* 16.16 source step per destination pixel */
+} tAffineSpan;
+
+/**
+How sampled pixels are written to the destination.
+*/
+typedef struct tAffineBlend
+{
+    SDL_BlendMode blendMode; /* SDL_BLENDMODE_NONE or SDL_BLENDMODE_BLEND */
+    Uint32 opaque;           /* alpha bits set on every sample of a source without alpha */
+    int modulate;
+    Uint8 mod[4]; /* color and alpha modulation, indexed by channel shift / 8 */
+    int ashift;   /* shift of the alpha channel */
+} tAffineBlend;
+
+typedef void (*tAffineSampleFunc)(const tAffineSpan *span, Uint32 *dst, int n);
+
+static void sampleAffineNearest(const tAffineSpan *span, Uint32 *dst, int n)
+{
+    int u = span->u, v = span->v;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        dst[i] = *((const Uint32 *)(span->pixels + (v >> 16) * span->pitch) + (u >> 16));
+        u += span->du;
+        v += span->dv;
+    }
+}
+
+/* The bilinear samplers interpolate horizontally and then vertically with 8-bit weights,
+ * truncating after each step, so all of them give exactly the same results.
+ * Texels outside of the source rect are clamped to its edge.
+ */
+#define AFFINE_BILINEAR_SETUP() \
+    const int bu = u - 0x8000, bv = v - 0x8000; \
+    const int x0 = SDL_clamp(bu >> 16, span->minx, span->maxx); \
+    const int x1 = SDL_clamp((bu >> 16) + 1, span->minx, span->maxx); \
+    const int wx = (bu >> 8) & 0xFF; \
+    const int wy = (bv >> 8) & 0xFF; \
+    const Uint32 *row0 = (const Uint32 *)(span->pixels + SDL_clamp(bv >> 16, span->miny, span->maxy) * span->pitch); \
+    const Uint32 *row1 = (const Uint32 *)(span->pixels + SDL_clamp((bv >> 16) + 1, span->miny, span->maxy) * span->pitch)
+
+static SDL_INLINE Uint32 lerpAffine(Uint32 c0, Uint32 c1, int w)
+{
+    /* Two channels at a time, the products can't carry into the neighboring channel */
+    const Uint32 rb = ((((c0 & 0x00FF00FF) * (256 - w)) + ((c1 & 0x00FF00FF) * w)) >> 8) & 0x00FF00FF;
+    const Uint32 ag = (((((c0 >> 8) & 0x00FF00FF) * (256 - w)) + (((c1 >> 8) & 0x00FF00FF) * w)) >> 8) & 0x00FF00FF;
+    return rb | (ag << 8);
+}
+
+static void sampleAffineBilinear(const tAffineSpan *span, Uint32 *dst, int n)
+{
+    int u = span->u, v = span->v;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        AFFINE_BILINEAR_SETUP();
+        dst[i] = lerpAffine(lerpAffine(row0[x0], row0[x1], wx), lerpAffine(row1[x0], row1[x1], wx), wy);
+        u += span->du;
+        v += span->dv;
+    }
+}
+
+static void blendAffine(Uint32 *dst, const Uint32 *src, int n, const tAffineBlend *blend)
+{
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        Uint32 s = src[i] | blend->opaque;
+        Uint32 d, a;
+
+        if (blend->modulate) {
+            Uint32 m = 0;
+            for (k = 0; k < 4; k++) {
+                m |= ((((s >> (k * 8)) & 0xFF) * blend->mod[k]) / 255) << (k * 8);
+            }
+            s = m;
+        }
+        if (blend->blendMode == SDL_BLENDMODE_NONE) {
+            dst[i] = s;
+            continue;
+        }
+
+        a = (s >> blend->ashift) & 0xFF;
+        if (a == 0xFF) {
+            dst[i] = s;
+        } else if (a) {
+            d = dst[i];
+            for (k = 0; k < 32; k += 8) {
+                const Uint32 ws = (k == blend->ashift) ? 0xFF : a;
+                const Uint32 c = ((((s >> k) & 0xFF) * ws) + (((d >> k) & 0xFF) * (0xFF - a))) / 255;
+                d = (d & ~((Uint32)0xFF << k)) | (c << k);
+            }
+            dst[i] = d;
+        }
+    }
+}
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN && (defined(SDL_SSE2_INTRINSICS) || defined(SDL_NEON_INTRINSICS))
+#define SDL_AFFINE_SIMD
+#endif
+
+#if defined(SDL_AFFINE_SIMD) && defined(SDL_SSE2_INTRINSICS)
+static void SDL_TARGETING("sse2") sampleAffineBilinear_SSE2(const tAffineSpan *span, Uint32 *dst, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int u = span->u, v = span->v;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        AFFINE_BILINEAR_SETUP();
+        /* Pair each channel of the left texel with the right one, for both rows */
+        const __m128i top = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)row0[x0]), _mm_cvtsi32_si128((int)row0[x1]));
+        const __m128i bottom = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)row1[x0]), _mm_cvtsi32_si128((int)row1[x1]));
+        const __m128i rows = _mm_unpacklo_epi64(top, bottom);
+        const __m128i wxv = _mm_set1_epi32((wx << 16) | (256 - wx));
+        const __m128i wyv = _mm_set1_epi32((wy << 16) | (256 - wy));
+        const __m128i t = _mm_srli_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(rows, zero), wxv), 8);
+        const __m128i b = _mm_srli_epi32(_mm_madd_epi16(_mm_unpackhi_epi8(rows, zero), wxv), 8);
+        __m128i tb = _mm_packs_epi32(t, b);
+        tb = _mm_unpacklo_epi16(tb, _mm_srli_si128(tb, 8));
+        tb = _mm_srli_epi32(_mm_madd_epi16(tb, wyv), 8);
+        tb = _mm_packs_epi32(tb, tb);
+        dst[i] = (Uint32)_mm_cvtsi128_si32(_mm_packus_epi16(tb, tb));
+        u += span->du;
+        v += span->dv;
+    }
+}
+
+/* Exact division by 255 of 16-bit values up to 255 * 255 */
+#define AFFINE_DIV255_SSE2(x) _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)0x8081)), 7)
+
+static int SDL_TARGETING("sse2") blendAffine_SSE2(Uint32 *dst, const Uint32 *src, int n, const tAffineBlend *blend)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi32((int)blend->opaque);
+    const __m128i modv = _mm_set_epi16(blend->mod[3], blend->mod[2], blend->mod[1], blend->mod[0],
+                                       blend->mod[3], blend->mod[2], blend->mod[1], blend->mod[0]);
+    const __m128i amask = _mm_sll_epi64(_mm_set_epi32(0, 0xFFFF, 0, 0xFFFF), _mm_cvtsi32_si128(blend->ashift * 2));
+    const __m128i full = _mm_set1_epi16(0xFF);
+    const __m128i afull = _mm_and_si128(amask, full);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_or_si128(_mm_loadu_si128((const __m128i *)(src + i)), opaque);
+        __m128i slo = _mm_unpacklo_epi8(s, zero);
+        __m128i shi = _mm_unpackhi_epi8(s, zero);
+
+        if (blend->modulate) {
+            slo = AFFINE_DIV255_SSE2(_mm_mullo_epi16(slo, modv));
+            shi = AFFINE_DIV255_SSE2(_mm_mullo_epi16(shi, modv));
+        }
+        if (blend->blendMode == SDL_BLENDMODE_BLEND) {
+            const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i alo = _mm_and_si128(slo, amask);
+            __m128i ahi = _mm_and_si128(shi, amask);
+
+            /* Spread the alpha of each pixel over its four channels */
+            alo = _mm_or_si128(alo, _mm_or_si128(_mm_slli_epi64(alo, 16), _mm_srli_epi64(alo, 16)));
+            alo = _mm_or_si128(alo, _mm_or_si128(_mm_slli_epi64(alo, 32), _mm_srli_epi64(alo, 32)));
+            ahi = _mm_or_si128(ahi, _mm_or_si128(_mm_slli_epi64(ahi, 16), _mm_srli_epi64(ahi, 16)));
+            ahi = _mm_or_si128(ahi, _mm_or_si128(_mm_slli_epi64(ahi, 32), _mm_srli_epi64(ahi, 32)));
+
+            /* The source colors are weighted by alpha, the source alpha by 255 */
+            slo = _mm_add_epi16(_mm_mullo_epi16(slo, _mm_or_si128(_mm_andnot_si128(amask, alo), afull)),
+                                _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, alo)));
+            shi = _mm_add_epi16(_mm_mullo_epi16(shi, _mm_or_si128(_mm_andnot_si128(amask, ahi), afull)),
+                                _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, ahi)));
+            slo = AFFINE_DIV255_SSE2(slo);
+            shi = AFFINE_DIV255_SSE2(shi);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(slo, shi));
+    }
+    return i;
+}
+#endif /* SDL_AFFINE_SIMD && SDL_SSE2_INTRINSICS */
+
+#if defined(SDL_AFFINE_SIMD) && defined(SDL_NEON_INTRINSICS)
+static void sampleAffineBilinear_NEON(const tAffineSpan *span, Uint32 *dst, int n)
+{
+    int u = span->u, v = span->v;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        AFFINE_BILINEAR_SETUP();
+        const uint16x8_t wxv = vcombine_u16(vdup_n_u16((uint16_t)(256 - wx)), vdup_n_u16((uint16_t)wx));
+        uint32x2_t top = vdup_n_u32(row0[x0]);
+        uint32x2_t bottom = vdup_n_u32(row1[x0]);
+        uint16x8_t t, b;
+        uint16x4_t th, bh, r;
+
+        top = vset_lane_u32(row0[x1], top, 1);
+        bottom = vset_lane_u32(row1[x1], bottom, 1);
+        t = vmulq_u16(vmovl_u8(vreinterpret_u8_u32(top)), wxv);
+        b = vmulq_u16(vmovl_u8(vreinterpret_u8_u32(bottom)), wxv);
+        th = vshr_n_u16(vadd_u16(vget_low_u16(t), vget_high_u16(t)), 8);
+        bh = vshr_n_u16(vadd_u16(vget_low_u16(b), vget_high_u16(b)), 8);
+        r = vmul_n_u16(th, (uint16_t)(256 - wy));
+        r = vshr_n_u16(vmla_n_u16(r, bh, (uint16_t)wy), 8);
+        dst[i] = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(r, r))), 0);
+        u += span->du;
+        v += span->dv;
+    }
+}
+
+/* Exact division by 255 of 16-bit values up to 255 * 255 */
+#define AFFINE_DIV255_NEON(x) vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8)
+
+static int blendAffine_NEON(Uint32 *dst, const Uint32 *src, int n, const tAffineBlend *blend)
+{
+    const int aindex = blend->ashift / 8;
+    int i, k;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint8x8x4_t s = vld4_u8((const Uint8 *)(src + i));
+
+        if (blend->opaque) {
+            s.val[aindex] = vdup_n_u8(0xFF);
+        }
+        if (blend->modulate) {
+            for (k = 0; k < 4; k++) {
+                s.val[k] = AFFINE_DIV255_NEON(vmull_u8(s.val[k], vdup_n_u8(blend->mod[k])));
+            }
+        }
+        if (blend->blendMode == SDL_BLENDMODE_BLEND) {
+            uint8x8x4_t d = vld4_u8((const Uint8 *)(dst + i));
+            const uint8x8_t a = s.val[aindex];
+            const uint8x8_t inva = vmvn_u8(a);
+            for (k = 0; k < 4; k++) {
+                const uint8x8_t ws = (k == aindex) ? vdup_n_u8(0xFF) : a;
+                d.val[k] = AFFINE_DIV255_NEON(vmlal_u8(vmull_u8(s.val[k], ws), d.val[k], inva));
+            }
+            s = d;
+        }
+        vst4_u8((Uint8 *)(dst + i), s);
+    }
+    return i;
+}
+#endif /* SDL_AFFINE_SIMD && SDL_NEON_INTRINSICS */
+
+/* Returns floor(a / b) for b > 0 */
+static Sint64 floorDivAffine(Sint64 a, Sint64 b)
+{
+    Sint64 q = a / b;
+    if ((a % b) != 0 && a < 0) {
+        q--;
+    }
+    return q;
+}
+
+/* Narrows [*start, *end) to the steps t where lo <= f0 + t * df < hi */
+static void clipAffineSpan(Sint64 f0, Sint64 df, Sint64 lo, Sint64 hi, int *start, int *end)
+{
+    Sint64 s, e;
+
+    if (df > 0) {
+        s = -floorDivAffine(f0 - lo, df);
+        e = -floorDivAffine(f0 - hi, df);
+    } else if (df < 0) {
+        s = floorDivAffine(f0 - hi, -df) + 1;
+        e = floorDivAffine(f0 - lo, -df) + 1;
+    } else if (f0 >= lo && f0 < hi) {
+        return;
+    } else {
+        *end = *start;
+        return;
+    }
+    if (s > *start) {
+        *start = (int)SDL_min(s, (Sint64)*end);
+    }
+    if (e < *end) {
+        *end = (int)SDL_max(e, (Sint64)*start);
+    }
+}
+
+/**
+Blits a rect of a 32-bit surface to another 32-bit surface through an affine transform.
+
+Every destination pixel whose center falls inside the transformed rect is sampled straight
+from the source, so no intermediate surface is needed. Both surfaces must be 8888 surfaces with
+the same color channels, the source must not have a colorkey and its blend mode must be NONE or
+BLEND. The source must already be locked if it needs to be. The color and alpha modulation of
+the source is applied, and the destination clip rect is respected.
+
+\param src The source surface.
+\param srcrect The rect of the source surface to draw.
+\param dst The destination surface.
+\param transform Maps source coordinates to destination coordinates: x' = t[0] * x + t[1] * y + t[2]
+and y' = t[3] * x + t[4] * y + t[5].
+\param smooth Set to 1 to sample bilinearly instead of the nearest texel.
+\return SDL_TRUE if the surface was drawn, SDL_FALSE if this combination isn't supported.
+
+*/
+SDL_bool SDLgfx_blitTransformed(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst,
+                                const double transform[6], int smooth)
+{
+    const SDL_PixelFormat *sf = src->format;
+    const SDL_PixelFormat *df = dst->format;
+    tAffineSampleFunc sample = smooth ? sampleAffineBilinear : sampleAffineNearest;
+    int (*blend_simd)(Uint32 *, const Uint32 *, int, const tAffineBlend *) = NULL;
+    tAffineBlend blend;
+    tAffineSpan span;
+    Uint32 chunk[AFFINE_CHUNK];
+    Uint8 r, g, b, a;
+    double det, inv[6], corners[4][2];
+    double minx, miny, maxx, maxy;
+    Sint64 du, dv, lou, hiu, lov, hiv;
+    int x0, y0, x1, y1, x, y, i;
+    SDL_bool copy;
+
+    if (sf->BitsPerPixel != 32 || SDL_PIXELLAYOUT(sf->format) != SDL_PACKEDLAYOUT_8888 ||
+        df->BitsPerPixel != 32 || SDL_PIXELLAYOUT(df->format) != SDL_PACKEDLAYOUT_8888 ||
+        sf->Rmask != df->Rmask || sf->Gmask != df->Gmask || sf->Bmask != df->Bmask ||
+        SDL_SurfaceHasColorKey(src) || (SDL_MUSTLOCK(src) && !src->locked) || SDL_MUSTLOCK(dst) ||
+        src->w > 32767 || src->h > 32767) {
+        return SDL_FALSE;
+    }
+
+    SDL_zero(blend);
+    SDL_GetSurfaceBlendMode(src, &blend.blendMode);
+    if (blend.blendMode != SDL_BLENDMODE_NONE && blend.blendMode != SDL_BLENDMODE_BLEND) {
+        return SDL_FALSE;
+    }
+    blend.opaque = sf->Amask ? 0 : ~(sf->Rmask | sf->Gmask | sf->Bmask);
+    for (blend.ashift = 0; blend.ashift < 24; blend.ashift += 8) {
+        if (!(((sf->Rmask | sf->Gmask | sf->Bmask) >> blend.ashift) & 0xFF)) {
+            break;
+        }
+    }
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    blend.mod[sf->Rshift / 8] = r;
+    blend.mod[sf->Gshift / 8] = g;
+    blend.mod[sf->Bshift / 8] = b;
+    blend.mod[blend.ashift / 8] = a;
+    blend.modulate = (r & g & b & a) != 0xFF;
+    copy = (blend.blendMode == SDL_BLENDMODE_NONE && !blend.opaque && !blend.modulate);
+
+    if (srcrect->w <= 0 || srcrect->h <= 0) {
+        return SDL_TRUE;
+    }
+    det = transform[0] * transform[4] - transform[1] * transform[3];
+    if (det == 0.0) {
+        return SDL_TRUE; /* degenerate, nothing covers a pixel center */
+    }
+    inv[0] = transform[4] / det;
+    inv[1] = -transform[1] / det;
+    inv[2] = (transform[1] * transform[5] - transform[4] * transform[2]) / det;
+    inv[3] = -transform[3] / det;
+    inv[4] = transform[0] / det;
+    inv[5] = (transform[3] * transform[2] - transform[0] * transform[5]) / det;
+    if (SDL_fabs(inv[0]) > 16384.0 || SDL_fabs(inv[3]) > 16384.0) {
+        return SDL_FALSE;
+    }
+
+    /* The destination pixels that can be covered, within the clip rect */
+    for (i = 0; i < 4; i++) {
+        const double sx = srcrect->x + ((i & 1) ? srcrect->w : 0);
+        const double sy = srcrect->y + ((i & 2) ? srcrect->h : 0);
+        corners[i][0] = transform[0] * sx + transform[1] * sy + transform[2];
+        corners[i][1] = transform[3] * sx + transform[4] * sy + transform[5];
+    }
+    minx = SDL_min(SDL_min(corners[0][0], corners[1][0]), SDL_min(corners[2][0], corners[3][0]));
+    maxx = SDL_max(SDL_max(corners[0][0], corners[1][0]), SDL_max(corners[2][0], corners[3][0]));
+    miny = SDL_min(SDL_min(corners[0][1], corners[1][1]), SDL_min(corners[2][1], corners[3][1]));
+    maxy = SDL_max(SDL_max(corners[0][1], corners[1][1]), SDL_max(corners[2][1], corners[3][1]));
+    x0 = dst->clip_rect.x;
+    y0 = dst->clip_rect.y;
+    x1 = dst->clip_rect.x + dst->clip_rect.w;
+    y1 = dst->clip_rect.y + dst->clip_rect.h;
+    if (minx > x0) {
+        x0 = (minx < x1) ? (int)SDL_floor(minx) : x1;
+    }
+    if (maxx < x1) {
+        x1 = (maxx > x0) ? (int)SDL_ceil(maxx) : x0;
+    }
+    if (miny > y0) {
+        y0 = (miny < y1) ? (int)SDL_floor(miny) : y1;
+    }
+    if (maxy < y1) {
+        y1 = (maxy > y0) ? (int)SDL_ceil(maxy) : y0;
+    }
+    if (x0 >= x1 || y0 >= y1) {
+        return SDL_TRUE;
+    }
+
+#ifdef SDL_AFFINE_SIMD
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        if (smooth) {
+            sample = sampleAffineBilinear_SSE2;
+        }
+        blend_simd = blendAffine_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!blend_simd && SDL_HasNEON()) {
+        if (smooth) {
+            sample = sampleAffineBilinear_NEON;
+        }
+        blend_simd = blendAffine_NEON;
+    }
+#endif
+#endif /* SDL_AFFINE_SIMD */
+
+    span.pixels = (const Uint8 *)src->pixels;
+    span.pitch = src->pitch;
+    span.minx = srcrect->x;
+    span.miny = srcrect->y;
+    span.maxx = srcrect->x + srcrect->w - 1;
+    span.maxy = srcrect->y + srcrect->h - 1;
+    du = (Sint64)SDL_floor(inv[0] * 65536.0 + 0.5);
+    dv = (Sint64)SDL_floor(inv[3] * 65536.0 + 0.5);
+    span.du = (int)du;
+    span.dv = (int)dv;
+    lou = (Sint64)srcrect->x << 16;
+    hiu = (Sint64)(srcrect->x + srcrect->w) << 16;
+    lov = (Sint64)srcrect->y << 16;
+    hiv = (Sint64)(srcrect->y + srcrect->h) << 16;
+
+    for (y = y0; y < y1; y++) {
+        /* Source position of the first pixel center in the row, the rest step from it */
+        const double cx = x0 + 0.5, cy = y + 0.5;
+        const Sint64 u = (Sint64)SDL_floor((inv[0] * cx + inv[1] * cy + inv[2]) * 65536.0 + 0.5);
+        const Sint64 v = (Sint64)SDL_floor((inv[3] * cx + inv[4] * cy + inv[5]) * 65536.0 + 0.5);
+        Uint32 *row = (Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch);
+        int start = 0, end = x1 - x0;
+
+        clipAffineSpan(u, du, lou, hiu, &start, &end);
+        clipAffineSpan(v, dv, lov, hiv, &start, &end);
+
+        for (x = start; x < end; x += AFFINE_CHUNK) {
+            const int n = SDL_min(end - x, AFFINE_CHUNK);
+            Uint32 *out = row + x0 + x;
+
+            span.u = (int)(u + x * du);
+            span.v = (int)(v + x * dv);
+            if (copy) {
+                sample(&span, out, n);
+                continue;
+            }
+            sample(&span, chunk, n);
+            i = blend_simd ? blend_simd(out, chunk, n, &blend) : 0;
+            blendAffine(out + i, chunk + i, n - i, &blend);
+        }
+    }
+    return SDL_TRUE;
+}
+
 #endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
@@ -26,5 +26,7 @@ extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smo
                                          const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center);
 extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, const SDL_FPoint *center,
                                            SDL_Rect *rect_dest, double *cangle, double *sangle);
+extern SDL_bool SDLgfx_blitTransformed(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst,
+                                       const double transform[6], int smooth);
 
 #endif /* SDL_rotate_h_ */
@@ -118,6 +118,15 @@ void trianglepoint_2_fixedpoint(SDL_Point *a)
     a->y <<= FP_BITS;
 }
 
+/* Get the pixels that could be touched by a triangle with the given fixed point bounds */
+void trianglebounds_2_rect(const SDL_Point *min, const SDL_Point *max, SDL_Rect *r)
+{
+    r->x = min->x >> FP_BITS;
+    r->y = min->y >> FP_BITS;
+    r->w = (max->x >> FP_BITS) - r->x + 1;
+    r->h = (max->y >> FP_BITS) - r->y + 1;
+}
+
 /* bounding rect of three points (in fixed point) */
 static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
@@ -145,50 +154,111 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     r->h = (max_y - min_y);
 }
 
+/* Narrow [*x_start, *x_end) to the pixels where the edge function a + x * step is not negative */
+static void triangle_edge_span(int a, int step, int *x_start, int *x_end)
+{
+    if (step > 0) {
+        if (a < 0) {
+            const Sint64 x = ((Sint64)-a + step - 1) / step;
+            if (x > *x_start) {
+                *x_start = (x < *x_end) ? (int)x : *x_end;
+            }
+        }
+    } else if (step < 0) {
+        if (a < 0) {
+            *x_end = *x_start;
+        } else {
+            const Sint64 x = (Sint64)a / -step + 1;
+            if (x < *x_end) {
+                *x_end = (int)x;
+            }
+        }
+    } else if (a < 0) {
+        *x_end = *x_start;
+    }
+}
+
+/* Exact incremental evaluation of n / area along a row, where n grows by a
+ * constant each pixel. This gives the same result as dividing at every
+ * pixel, without the 64-bit division in the inner loop.
+ */
+typedef struct
+{
+    int q;     /* floor(n / area) */
+    Uint32 r;  /* n - q * area, in [0, area) */
+    int dq;
+    Uint32 dr;
+} TriangleLerp;
+
+static void triangle_lerp_setup(TriangleLerp *lerp, Sint64 n, Sint64 dn, int area)
+{
+    Sint64 q = n / area;
+    Sint64 r = n % area;
+    if (r < 0) {
+        r += area;
+        --q;
+    }
+    lerp->q = (int)q;
+    lerp->r = (Uint32)r;
+
+    q = dn / area;
+    r = dn % area;
+    if (r < 0) {
+        r += area;
+        --q;
+    }
+    lerp->dq = (int)q;
+    lerp->dr = (Uint32)r;
+}
+
+SDL_FORCE_INLINE void triangle_lerp_step(TriangleLerp *lerp, Uint32 area)
+{
+    lerp->q += lerp->dq;
+    lerp->r += lerp->dr;
+    if (lerp->r >= area) {
+        lerp->r -= area;
+        ++lerp->q;
+    }
+}
+
+/* The quotient rounded toward zero, like the integer division it replaces */
+#define TRIANGLE_LERP_VALUE(lerp) ((lerp).q + ((lerp).q < 0 && (lerp).r != 0))
+
 /* Triangle rendering, using Barycentric coordinates (w0, w1, w2)
  *
  * The cross product isn't computed from scratch at each iteration,
- * but optimized using constant step increments
+ * but optimized using constant step increments.
  *
+ * Each row only walks the span of pixels inside the triangle, and the
+ * interpolated colors and texture coordinates are stepped incrementally
+ * along it. 'setup' is run at the start of each span and 'step' is an
+ * expression evaluated after each pixel.
  */
 
-#define TRIANGLE_BEGIN_LOOP                                                        \
-    {                                                                              \
-        int x, y;                                                                  \
-        for (y = 0; y < dstrect.h; y++) {                                          \
-            /* y start */                                                          \
-            int w0 = w0_row;                                                       \
-            int w1 = w1_row;                                                       \
-            int w2 = w2_row;                                                       \
-            for (x = 0; x < dstrect.w; x++) {                                      \
-                /* In triangle */                                                  \
-                if (w0 + bias_w0 >= 0 && w1 + bias_w1 >= 0 && w2 + bias_w2 >= 0) { \
-                    Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
-
-/* Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles */
-#define TRIANGLE_GET_TEXTCOORD                                                          \
-    int srcx = (int)(((Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x) / area); \
-    int srcy = (int)(((Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y) / area);
-
-#define TRIANGLE_GET_MAPPED_COLOR                                                      \
-    Uint8 r = (Uint8)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    Uint8 g = (Uint8)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    Uint8 b = (Uint8)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    Uint8 a = (Uint8)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area); \
-    Uint32 color = SDL_MapRGBA(format, r, g, b, a);
-
-#define TRIANGLE_GET_COLOR                                                             \
-    int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    int g = (int)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    int b = (int)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    int a = (int)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area);
+#define TRIANGLE_NO_SETUP
+#define TRIANGLE_NO_STEP (void)0
+
+#define TRIANGLE_BEGIN_LOOP(setup, step)                                              \
+    {                                                                                 \
+        int x, y;                                                                     \
+        for (y = 0; y < dstrect.h; y++) {                                             \
+            int x_start = 0;                                                          \
+            int x_end = dstrect.w;                                                    \
+            int w0, w1, w2;                                                           \
+            triangle_edge_span(w0_row + bias_w0, d2d1_y, &x_start, &x_end);           \
+            triangle_edge_span(w1_row + bias_w1, d0d2_y, &x_start, &x_end);           \
+            triangle_edge_span(w2_row + bias_w2, d1d0_y, &x_start, &x_end);           \
+            w0 = w0_row + x_start * d2d1_y;                                           \
+            w1 = w1_row + x_start * d0d2_y;                                           \
+            w2 = w2_row + x_start * d1d0_y;                                           \
+            if (x_start < x_end) {                                                    \
+                setup                                                                 \
+            }                                                                         \
+            for (x = x_start; x < x_end;                                              \
+                 x++, w0 += d2d1_y, w1 += d0d2_y, w2 += d1d0_y, step) {               \
+                Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
 
 #define TRIANGLE_END_LOOP \
-    }                     \
-    /* x += 1 */          \
-    w0 += d2d1_y;         \
-    w1 += d0d2_y;         \
-    w2 += d1d0_y;         \
     }                     \
     /* y += 1 */          \
     w0_row += d1d2_x;     \
@@ -198,6 +268,53 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     }                     \
     }
 
+/* Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles */
+#define TRIANGLE_SETUP_TEXTCOORD                                                                                         \
+    triangle_lerp_setup(&lerp_srcx, (Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x,                              \
+                        (Sint64)d2d1_y * s2s0_x + (Sint64)d0d2_y * s2s1_x, area);                                        \
+    triangle_lerp_setup(&lerp_srcy, (Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y,                              \
+                        (Sint64)d2d1_y * s2s0_y + (Sint64)d0d2_y * s2s1_y, area);
+
+#define TRIANGLE_STEP_TEXTCOORD \
+    triangle_lerp_step(&lerp_srcx, area), triangle_lerp_step(&lerp_srcy, area)
+
+#define TRIANGLE_GET_TEXTCOORD                    \
+    int srcx = TRIANGLE_LERP_VALUE(lerp_srcx);    \
+    int srcy = TRIANGLE_LERP_VALUE(lerp_srcy);
+
+#define TRIANGLE_SETUP_COLOR_CHANNEL(lerp, channel)                                                          \
+    triangle_lerp_setup(&lerp, (Sint64)w0 * c0.channel + (Sint64)w1 * c1.channel + (Sint64)w2 * c2.channel, \
+                        (Sint64)d2d1_y * c0.channel + (Sint64)d0d2_y * c1.channel + (Sint64)d1d0_y * c2.channel, area);
+
+#define TRIANGLE_SETUP_COLOR                 \
+    TRIANGLE_SETUP_COLOR_CHANNEL(lerp_r, r) \
+    TRIANGLE_SETUP_COLOR_CHANNEL(lerp_g, g) \
+    TRIANGLE_SETUP_COLOR_CHANNEL(lerp_b, b) \
+    TRIANGLE_SETUP_COLOR_CHANNEL(lerp_a, a)
+
+#define TRIANGLE_STEP_COLOR                                                   \
+    triangle_lerp_step(&lerp_r, area), triangle_lerp_step(&lerp_g, area),    \
+    triangle_lerp_step(&lerp_b, area), triangle_lerp_step(&lerp_a, area)
+
+#define TRIANGLE_GET_MAPPED_COLOR                             \
+    Uint8 r = (Uint8)TRIANGLE_LERP_VALUE(lerp_r);             \
+    Uint8 g = (Uint8)TRIANGLE_LERP_VALUE(lerp_g);             \
+    Uint8 b = (Uint8)TRIANGLE_LERP_VALUE(lerp_b);             \
+    Uint8 a = (Uint8)TRIANGLE_LERP_VALUE(lerp_a);             \
+    Uint32 color = TRIANGLE_MAP_RGBA(format, r, g, b, a);
+
+#define TRIANGLE_GET_COLOR                   \
+    int r = TRIANGLE_LERP_VALUE(lerp_r);    \
+    int g = TRIANGLE_LERP_VALUE(lerp_g);    \
+    int b = TRIANGLE_LERP_VALUE(lerp_b);    \
+    int a = TRIANGLE_LERP_VALUE(lerp_a);
+
+/* SDL_MapRGBA(), inlined for formats without a palette */
+#define TRIANGLE_MAP_RGBA(format, r, g, b, a)                                                            \
+    ((format)->palette ? SDL_MapRGBA(format, r, g, b, a) :                                              \
+     ((Uint32)((r) >> (format)->Rloss) << (format)->Rshift | (Uint32)((g) >> (format)->Gloss) << (format)->Gshift | \
+      (Uint32)((b) >> (format)->Bloss) << (format)->Bshift | ((Uint32)((a) >> (format)->Aloss) << (format)->Ashift & (format)->Amask)))
+
 int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
     int ret = 0;
@@ -258,7 +375,10 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
         /* Clip triangle with surface clip rect */
         SDL_Rect rect;
         SDL_GetSurfaceClipRect(dst, &rect);
-        SDL_GetRectIntersection(&dstrect, &rect, &dstrect);
+        if (!SDL_GetRectIntersection(&dstrect, &rect, &dstrect)) {
+            /* Nothing to draw */
+            goto end;
+        }
     }
 
     if (blend != SDL_BLENDMODE_NONE) {
@@ -344,13 +464,15 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
         }
 
         if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+            /* Fill whole spans at once */
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_NO_SETUP, TRIANGLE_NO_STEP)
             {
-                *(Uint32 *)dptr = color;
+                SDL_memset4(dptr, color, x_end - x);
+                break;
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_NO_SETUP, TRIANGLE_NO_STEP)
             {
                 Uint8 *s = (Uint8 *)&color;
                 dptr[0] = s[0];
@@ -359,13 +481,13 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_NO_SETUP, TRIANGLE_NO_STEP)
             {
                 *(Uint16 *)dptr = (Uint16)color;
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_NO_SETUP, TRIANGLE_NO_STEP)
             {
                 *dptr = (Uint8)color;
             }
@@ -373,18 +495,19 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
         }
     } else {
         SDL_PixelFormat *format = dst->format;
+        TriangleLerp lerp_r, lerp_g, lerp_b, lerp_a;
         if (tmp) {
             format = tmp->format;
         }
         if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_COLOR, TRIANGLE_STEP_COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *(Uint32 *)dptr = color;
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_COLOR, TRIANGLE_STEP_COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 Uint8 *s = (Uint8 *)&color;
@@ -394,14 +517,14 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_COLOR, TRIANGLE_STEP_COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *(Uint16 *)dptr = (Uint16)color;
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_COLOR, TRIANGLE_STEP_COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *dptr = (Uint8)color;
@@ -459,6 +582,8 @@ int SDL_SW_BlitTriangle(
 
     int has_modulation;
 
+    TriangleLerp lerp_srcx, lerp_srcy;
+
     if (!src || !dst) {
         return -1;
     }
@@ -665,7 +790,7 @@ int SDL_SW_BlitTriangle(
     }
 
     if (dstbpp == 4) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_TEXTCOORD, TRIANGLE_STEP_TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint32 *sptr = (Uint32 *)((Uint8 *)src_ptr + srcy * src_pitch);
@@ -673,7 +798,7 @@ int SDL_SW_BlitTriangle(
         }
         TRIANGLE_END_LOOP
     } else if (dstbpp == 3) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_TEXTCOORD, TRIANGLE_STEP_TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
@@ -683,7 +808,7 @@ int SDL_SW_BlitTriangle(
         }
         TRIANGLE_END_LOOP
     } else if (dstbpp == 2) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_TEXTCOORD, TRIANGLE_STEP_TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint16 *sptr = (Uint16 *)((Uint8 *)src_ptr + srcy * src_pitch);
@@ -691,7 +816,7 @@ int SDL_SW_BlitTriangle(
         }
         TRIANGLE_END_LOOP
     } else if (dstbpp == 1) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_TEXTCOORD, TRIANGLE_STEP_TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
@@ -754,10 +879,26 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     Uint8 *dst_ptr = info->dst;
     int dst_pitch = info->dst_pitch;
 
+    TriangleLerp lerp_srcx, lerp_srcy;
+    TriangleLerp lerp_r, lerp_g, lerp_b, lerp_a;
+
     srcfmt_val = detect_format(src_fmt);
     dstfmt_val = detect_format(dst_fmt);
 
-    TRIANGLE_BEGIN_LOOP
+    SDL_zero(lerp_r);
+    SDL_zero(lerp_g);
+    SDL_zero(lerp_b);
+    SDL_zero(lerp_a);
+
+#define TRIANGLE_SETUP_SLOW      \
+    TRIANGLE_SETUP_TEXTCOORD     \
+    if (!is_uniform) {           \
+        TRIANGLE_SETUP_COLOR     \
+    }
+#define TRIANGLE_STEP_SLOW \
+    TRIANGLE_STEP_TEXTCOORD, (is_uniform ? (void)0 : ((void)(TRIANGLE_STEP_COLOR)))
+
+    TRIANGLE_BEGIN_LOOP(TRIANGLE_SETUP_SLOW, TRIANGLE_STEP_SLOW)
     {
         Uint8 *src;
         Uint8 *dst = dptr;
@@ -36,5 +36,6 @@ extern int SDL_SW_BlitTriangle(
     SDL_Color c0, SDL_Color c1, SDL_Color c2);
 
 extern void trianglepoint_2_fixedpoint(SDL_Point *a);
+extern void trianglebounds_2_rect(const SDL_Point *min, const SDL_Point *max, SDL_Rect *r);
 
 #endif /* SDL_triangle_h_ */
@@ -256,6 +256,9 @@ SDL_Renderer *VITA_GXM_CreateRenderer(SDL_Window *window, SDL_PropertiesID creat
     renderer->driverdata = data;
     renderer->window = window;
 
+    /* Vertex data lives in the per-frame GXM pools, so it can't be retained */
+    renderer->command_lists_unsupported = SDL_TRUE;
+
     data->initialized = SDL_TRUE;
 
     if (SDL_GetBooleanProperty(create_props, "present_vsync", SDL_FALSE)) {
@@ -675,6 +678,10 @@ static int VITA_GXM_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *c
         data,
         count * sizeof(color_vertex));
 
+    if (!vertex) {
+        return -1;
+    }
+
     cmd->data.draw.first = (size_t)vertex;
     cmd->data.draw.count = count;
 
@@ -696,6 +703,10 @@ static int VITA_GXM_QueueDrawLines(SDL_Renderer *renderer, SDL_RenderCommand *cm
         data,
         (count - 1) * 2 * sizeof(color_vertex));
 
+    if (!vertex) {
+        return -1;
+    }
+
     cmd->data.draw.first = (size_t)vertex;
     cmd->data.draw.count = (count - 1) * 2;
 
@@ -1001,6 +1012,7 @@ static int VITA_GXM_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *c
             SDL_Texture *thistexture = cmd->data.draw.texture;
             SDL_BlendMode thisblend = cmd->data.draw.blend;
             const SDL_RenderCommandType thiscmdtype = cmd->command;
+            const size_t vertsize = thistexture ? sizeof(texture_vertex) : sizeof(color_vertex);
             SDL_RenderCommand *finalcmd = cmd;
             SDL_RenderCommand *nextcmd = cmd->next;
             size_t count = cmd->data.draw.count;
@@ -1011,6 +1023,10 @@ static int VITA_GXM_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *c
                     break; /* can't go any further on this draw call, different render command up next. */
                 } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != thisblend) {
                     break; /* can't go any further on this draw call, different texture/blendmode copy up next. */
+                } else if (nextcmd->data.draw.first != cmd->data.draw.first + count * vertsize) {
+                    break; /* the vertices continue in another pool block. */
+                } else if (count + nextcmd->data.draw.count > UINT16_MAX + 1) {
+                    break; /* that's all the linear indices we have. */
                 } else {
                     finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                     count += nextcmd->data.draw.count;
@@ -1042,6 +1058,9 @@ static int VITA_GXM_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *c
             break;
         }
 
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -1174,9 +1193,9 @@ static int VITA_GXM_RenderPresent(SDL_Renderer *renderer)
     // update buffer indices
     data->frontBufferIndex = data->backBufferIndex;
     data->backBufferIndex = (data->backBufferIndex + 1) % VITA_GXM_BUFFERS;
-    data->pool_index = 0;
 
-    data->current_pool = (data->current_pool + 1) % 2;
+    // the GPU may still be reading the pools of the frames waiting to be displayed
+    pool_reset(data, (data->current_pool + 1) % VITA_GXM_POOL_COUNT);
     return 0;
 }
 
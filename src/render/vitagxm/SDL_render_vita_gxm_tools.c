@@ -79,28 +79,74 @@ static void patcher_host_free(void *user_data, void *mem)
     SDL_free(mem);
 }
 
-void *pool_malloc(VITA_GXM_RenderData *data, unsigned int size)
+static VITA_GXM_PoolBlock *pool_create_block(unsigned int size)
 {
+    VITA_GXM_PoolBlock *block = (VITA_GXM_PoolBlock *)SDL_calloc(1, sizeof(*block));
+    if (!block) {
+        return NULL;
+    }
+
+    block->addr = vita_mem_alloc(
+        SCE_KERNEL_MEMBLOCK_TYPE_USER_RW,
+        size,
+        sizeof(void *),
+        SCE_GXM_MEMORY_ATTRIB_READ,
+        &block->uid);
+
+    if (!block->addr) {
+        SDL_free(block);
+        return NULL;
+    }
+    block->size = size;
+    return block;
+}
 
-    if ((data->pool_index + size) < VITA_GXM_POOL_SIZE) {
-        void *addr = (void *)((unsigned int)data->pool_addr[data->current_pool] + data->pool_index);
-        data->pool_index += size;
-        return addr;
+static void pool_destroy_blocks(VITA_GXM_PoolBlock *block)
+{
+    while (block) {
+        VITA_GXM_PoolBlock *next = block->next;
+        vita_mem_free(block->uid);
+        SDL_free(block);
+        block = next;
     }
-    SDL_LogError(SDL_LOG_CATEGORY_RENDER, "POOL OVERFLOW\n");
-    return NULL;
+}
+
+void pool_reset(VITA_GXM_RenderData *data, unsigned int pool)
+{
+    data->current_pool = pool;
+    data->pool_block = data->pools[pool];
+    data->pool_index = 0;
+}
+
+void *pool_malloc(VITA_GXM_RenderData *data, unsigned int size)
+{
+    return pool_memalign(data, size, 1);
 }
 
 void *pool_memalign(VITA_GXM_RenderData *data, unsigned int size, unsigned int alignment)
 {
-    unsigned int new_index = (data->pool_index + alignment - 1) & ~(alignment - 1);
-    if ((new_index + size) < VITA_GXM_POOL_SIZE) {
-        void *addr = (void *)((unsigned int)data->pool_addr[data->current_pool] + new_index);
-        data->pool_index = new_index + size;
-        return addr;
+    VITA_GXM_PoolBlock *block = data->pool_block;
+
+    for (;;) {
+        unsigned int new_index = (data->pool_index + alignment - 1) & ~(alignment - 1);
+        if ((new_index + size) <= block->size) {
+            void *addr = (void *)((unsigned int)block->addr + new_index);
+            data->pool_index = new_index + size;
+            return addr;
+        }
+
+        // This block is full, move on to the next one, adding it if this frame never needed it before
+        if (!block->next) {
+            block->next = pool_create_block(SDL_max(size + alignment, VITA_GXM_POOL_SIZE));
+            if (!block->next) {
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "POOL OVERFLOW\n");
+                return NULL;
+            }
+        }
+        block = block->next;
+        data->pool_block = block;
+        data->pool_index = 0;
     }
-    SDL_LogError(SDL_LOG_CATEGORY_RENDER, "POOL OVERFLOW\n");
-    return NULL;
 }
 
 static int tex_format_to_bytespp(SceGxmTextureFormat format)
@@ -200,6 +246,10 @@ static void set_stencil_mask(VITA_GXM_RenderData *data, float x, float y, float
         4 * sizeof(color_vertex), // 4 vertices
         sizeof(color_vertex));
 
+    if (!vertices) {
+        return;
+    }
+
     vertices[0].x = x;
     vertices[0].y = y;
     vertices[0].color.r = 0;
@@ -710,7 +760,7 @@ int gxm_init(SDL_Renderer *renderer)
     // all drawing operations where we don't want to use indexing.
     data->linearIndices = (uint16_t *)vita_mem_alloc(
         SCE_KERNEL_MEMBLOCK_TYPE_USER_RW_UNCACHE,
-        UINT16_MAX * sizeof(uint16_t),
+        (UINT16_MAX + 1) * sizeof(uint16_t),
         sizeof(uint16_t),
         SCE_GXM_MEMORY_ATTRIB_READ,
         &data->linearIndicesUid);
@@ -830,27 +880,20 @@ int gxm_init(SDL_Renderer *renderer)
     data->colorWvpParam = (SceGxmProgramParameter *)sceGxmProgramFindParameterByName(colorVertexProgramGxp, "wvp");
     data->textureWvpParam = (SceGxmProgramParameter *)sceGxmProgramFindParameterByName(textureVertexProgramGxp, "wvp");
 
-    // Allocate memory for the memory pool
-    data->pool_addr[0] = vita_mem_alloc(
-        SCE_KERNEL_MEMBLOCK_TYPE_USER_RW,
-        VITA_GXM_POOL_SIZE,
-        sizeof(void *),
-        SCE_GXM_MEMORY_ATTRIB_READ,
-        &data->poolUid[0]);
-
-    data->pool_addr[1] = vita_mem_alloc(
-        SCE_KERNEL_MEMBLOCK_TYPE_USER_RW,
-        VITA_GXM_POOL_SIZE,
-        sizeof(void *),
-        SCE_GXM_MEMORY_ATTRIB_READ,
-        &data->poolUid[1]);
+    // Allocate the first block of each frame's memory pool, more are added as needed
+    for (i = 0; i < VITA_GXM_POOL_COUNT; i++) {
+        data->pools[i] = pool_create_block(VITA_GXM_POOL_SIZE);
+        if (!data->pools[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Pool allocation failed\n");
+            return -1;
+        }
+    }
 
     init_orthographic_matrix(data->ortho_matrix, 0.0f, VITA_GXM_SCREEN_WIDTH, VITA_GXM_SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f);
 
     data->backBufferIndex = 0;
     data->frontBufferIndex = 0;
-    data->pool_index = 0;
-    data->current_pool = 0;
+    pool_reset(data, 0);
     data->currentBlendMode = SDL_BLENDMODE_BLEND;
 
     return 0;
@@ -859,6 +902,7 @@ int gxm_init(SDL_Renderer *renderer)
 void gxm_finish(SDL_Renderer *renderer)
 {
     VITA_GXM_RenderData *data = (VITA_GXM_RenderData *)renderer->driverdata;
+    int i;
 
     // wait until rendering is done
     sceGxmFinish(data->gxm_context);
@@ -921,8 +965,10 @@ void gxm_finish(SDL_Renderer *renderer)
     vita_mem_free(data->vdmRingBufferUid);
     SDL_free(data->contextParams.hostMem);
 
-    vita_mem_free(data->poolUid[0]);
-    vita_mem_free(data->poolUid[1]);
+    for (i = 0; i < VITA_GXM_POOL_COUNT; i++) {
+        pool_destroy_blocks(data->pools[i]);
+        data->pools[i] = NULL;
+    }
     vita_gpu_mem_destroy(data);
 
     // terminate libgxm
@@ -37,6 +37,7 @@
 
 void init_orthographic_matrix(float *m, float left, float right, float bottom, float top, float near, float far);
 
+void pool_reset(VITA_GXM_RenderData *data, unsigned int pool);
 void *pool_malloc(VITA_GXM_RenderData *data, unsigned int size);
 void *pool_memalign(VITA_GXM_RenderData *data, unsigned int size, unsigned int alignment);
 
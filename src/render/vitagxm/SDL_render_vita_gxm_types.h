@@ -46,6 +46,16 @@
 #define VITA_GXM_BUFFERS       3
 #define VITA_GXM_PENDING_SWAPS 2
 #define VITA_GXM_POOL_SIZE     2 * 1024 * 1024
+#define VITA_GXM_POOL_COUNT    (VITA_GXM_PENDING_SWAPS + 1)
+
+/* Per-frame vertex memory, grown a block at a time and kept between frames */
+typedef struct VITA_GXM_PoolBlock
+{
+    void *addr;
+    SceUID uid;
+    unsigned int size;
+    struct VITA_GXM_PoolBlock *next;
+} VITA_GXM_PoolBlock;
 
 typedef struct
 {
@@ -155,8 +165,8 @@ typedef struct
     unsigned int backBufferIndex;
     unsigned int frontBufferIndex;
 
-    void *pool_addr[2];
-    SceUID poolUid[2];
+    VITA_GXM_PoolBlock *pools[VITA_GXM_POOL_COUNT];
+    VITA_GXM_PoolBlock *pool_block;
     unsigned int pool_index;
     unsigned int current_pool;
 
@@ -0,0 +1,2927 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#if defined(SDL_VIDEO_RENDER_VULKAN) && !defined(SDL_RENDER_DISABLED)
+
+#include "../../video/SDL_vulkan_internal.h"
+#include "../../video/SDL_sysvideo.h" /* For SDL_RecreateWindow */
+#include "../SDL_sysrender.h"
+#include "SDL_shaders_vulkan.h"
+
+/* Vulkan renderer implementation
+
+   Work is recorded into one command buffer per frame.  There are
+   SDL_VULKAN_FRAMES_IN_FLIGHT frames, each with its own fence, vertex
+   buffer, upload buffer and descriptor pools, so the CPU can record a frame
+   while the GPU is still working on the previous one.  A frame's resources
+   are only reused once its fence has signaled.
+ */
+
+#define SDL_VULKAN_FRAMES_IN_FLIGHT      2
+#define SDL_VULKAN_VERTEX_BUFFER_SIZE    (64 * 1024)
+#define SDL_VULKAN_UPLOAD_BUFFER_SIZE    (4 * 1024 * 1024)
+#define SDL_VULKAN_DESCRIPTOR_POOL_SIZE  256
+#define SDL_VULKAN_DESCRIPTOR_CACHE_SIZE 64 /* must be a power of two */
+#define SDL_VULKAN_MAX_RENDER_PASSES     4
+
+#define VULKAN_FUNCTIONS()                                              \
+    VULKAN_GLOBAL_FUNCTION(vkCreateInstance)                            \
+    VULKAN_GLOBAL_FUNCTION(vkEnumerateInstanceLayerProperties)          \
+    VULKAN_INSTANCE_FUNCTION(vkCreateDevice)                            \
+    VULKAN_INSTANCE_FUNCTION(vkDestroyInstance)                         \
+    VULKAN_INSTANCE_FUNCTION(vkDestroySurfaceKHR)                       \
+    VULKAN_INSTANCE_FUNCTION(vkEnumerateDeviceExtensionProperties)      \
+    VULKAN_INSTANCE_FUNCTION(vkEnumeratePhysicalDevices)                \
+    VULKAN_INSTANCE_FUNCTION(vkGetDeviceProcAddr)                       \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties)       \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties)             \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceQueueFamilyProperties)  \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceCapabilitiesKHR) \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceFormatsKHR)      \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfacePresentModesKHR) \
+    VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceSupportKHR)      \
+    VULKAN_DEVICE_FUNCTION(vkAcquireNextImageKHR)                       \
+    VULKAN_DEVICE_FUNCTION(vkAllocateCommandBuffers)                    \
+    VULKAN_DEVICE_FUNCTION(vkAllocateDescriptorSets)                    \
+    VULKAN_DEVICE_FUNCTION(vkAllocateMemory)                            \
+    VULKAN_DEVICE_FUNCTION(vkBeginCommandBuffer)                        \
+    VULKAN_DEVICE_FUNCTION(vkBindBufferMemory)                          \
+    VULKAN_DEVICE_FUNCTION(vkBindImageMemory)                           \
+    VULKAN_DEVICE_FUNCTION(vkCmdBeginRenderPass)                        \
+    VULKAN_DEVICE_FUNCTION(vkCmdBindDescriptorSets)                     \
+    VULKAN_DEVICE_FUNCTION(vkCmdBindPipeline)                           \
+    VULKAN_DEVICE_FUNCTION(vkCmdBindVertexBuffers)                      \
+    VULKAN_DEVICE_FUNCTION(vkCmdClearAttachments)                       \
+    VULKAN_DEVICE_FUNCTION(vkCmdCopyBufferToImage)                      \
+    VULKAN_DEVICE_FUNCTION(vkCmdCopyImageToBuffer)                      \
+    VULKAN_DEVICE_FUNCTION(vkCmdDraw)                                   \
+    VULKAN_DEVICE_FUNCTION(vkCmdEndRenderPass)                          \
+    VULKAN_DEVICE_FUNCTION(vkCmdPipelineBarrier)                        \
+    VULKAN_DEVICE_FUNCTION(vkCmdPushConstants)                          \
+    VULKAN_DEVICE_FUNCTION(vkCmdSetScissor)                             \
+    VULKAN_DEVICE_FUNCTION(vkCmdSetViewport)                            \
+    VULKAN_DEVICE_FUNCTION(vkCreateBuffer)                              \
+    VULKAN_DEVICE_FUNCTION(vkCreateCommandPool)                         \
+    VULKAN_DEVICE_FUNCTION(vkCreateDescriptorPool)                      \
+    VULKAN_DEVICE_FUNCTION(vkCreateDescriptorSetLayout)                 \
+    VULKAN_DEVICE_FUNCTION(vkCreateFence)                               \
+    VULKAN_DEVICE_FUNCTION(vkCreateFramebuffer)                         \
+    VULKAN_DEVICE_FUNCTION(vkCreateGraphicsPipelines)                   \
+    VULKAN_DEVICE_FUNCTION(vkCreateImage)                               \
+    VULKAN_DEVICE_FUNCTION(vkCreateImageView)                           \
+    VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache)                       \
+    VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout)                      \
+    VULKAN_DEVICE_FUNCTION(vkCreateRenderPass)                          \
+    VULKAN_DEVICE_FUNCTION(vkCreateSampler)                             \
+    VULKAN_DEVICE_FUNCTION(vkCreateSemaphore)                           \
+    VULKAN_DEVICE_FUNCTION(vkCreateShaderModule)                        \
+    VULKAN_DEVICE_FUNCTION(vkCreateSwapchainKHR)                        \
+    VULKAN_DEVICE_FUNCTION(vkDestroyBuffer)                             \
+    VULKAN_DEVICE_FUNCTION(vkDestroyCommandPool)                        \
+    VULKAN_DEVICE_FUNCTION(vkDestroyDescriptorPool)                     \
+    VULKAN_DEVICE_FUNCTION(vkDestroyDescriptorSetLayout)                \
+    VULKAN_DEVICE_FUNCTION(vkDestroyDevice)                             \
+    VULKAN_DEVICE_FUNCTION(vkDestroyFence)                              \
+    VULKAN_DEVICE_FUNCTION(vkDestroyFramebuffer)                        \
+    VULKAN_DEVICE_FUNCTION(vkDestroyImage)                              \
+    VULKAN_DEVICE_FUNCTION(vkDestroyImageView)                          \
+    VULKAN_DEVICE_FUNCTION(vkDestroyPipeline)                           \
+    VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache)                      \
+    VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout)                     \
+    VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass)                         \
+    VULKAN_DEVICE_FUNCTION(vkDestroySampler)                            \
+    VULKAN_DEVICE_FUNCTION(vkDestroySemaphore)                          \
+    VULKAN_DEVICE_FUNCTION(vkDestroyShaderModule)                       \
+    VULKAN_DEVICE_FUNCTION(vkDestroySwapchainKHR)                       \
+    VULKAN_DEVICE_FUNCTION(vkDeviceWaitIdle)                            \
+    VULKAN_DEVICE_FUNCTION(vkEndCommandBuffer)                          \
+    VULKAN_DEVICE_FUNCTION(vkFreeMemory)                                \
+    VULKAN_DEVICE_FUNCTION(vkGetBufferMemoryRequirements)               \
+    VULKAN_DEVICE_FUNCTION(vkGetDeviceQueue)                            \
+    VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements)                \
+    VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData)                      \
+    VULKAN_DEVICE_FUNCTION(vkGetSwapchainImagesKHR)                     \
+    VULKAN_DEVICE_FUNCTION(vkMapMemory)                                 \
+    VULKAN_DEVICE_FUNCTION(vkQueuePresentKHR)                           \
+    VULKAN_DEVICE_FUNCTION(vkQueueSubmit)                               \
+    VULKAN_DEVICE_FUNCTION(vkResetCommandBuffer)                        \
+    VULKAN_DEVICE_FUNCTION(vkResetDescriptorPool)                       \
+    VULKAN_DEVICE_FUNCTION(vkResetFences)                               \
+    VULKAN_DEVICE_FUNCTION(vkUpdateDescriptorSets)                      \
+    VULKAN_DEVICE_FUNCTION(vkWaitForFences)
+
+/* Vertex shader, common values */
+typedef struct
+{
+    float scale[2];
+    float translation[2];
+} VertexShaderConstants;
+
+/* Per-vertex data */
+typedef struct
+{
+    SDL_FPoint pos;
+    SDL_FPoint tex;
+    SDL_Color color;
+} VertexPositionColor;
+
+/* A host visible, persistently mapped buffer */
+typedef struct
+{
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    Uint8 *mapped;
+} VULKAN_Buffer;
+
+/* An image that can be rendered to */
+typedef struct
+{
+    VkImage image;
+    VkImageView view;
+    VkFramebuffer framebuffer;
+    VkImageLayout layout;
+    VkFormat format;
+    Uint32 width;
+    Uint32 height;
+} VULKAN_Image;
+
+/* Per-texture data */
+typedef struct
+{
+    VULKAN_Image image;
+    VkDeviceMemory memory;
+    VkImageView sampledView;
+    SDL_ScaleMode scaleMode;
+
+    /* Streaming texture support */
+    Uint8 *pixels;
+    int pitch;
+    SDL_Rect lockedRect;
+} VULKAN_TextureData;
+
+/* Objects that may still be in use by the GPU when they're released */
+typedef struct
+{
+    VkFramebuffer framebuffer;
+    VkImageView views[2];
+    VkImage image;
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+} VULKAN_PendingDestroy;
+
+typedef struct
+{
+    VkImageView view;
+    VkSampler sampler;
+    VkDescriptorSet descriptorSet;
+} VULKAN_DescriptorCacheEntry;
+
+/* Everything that's needed to record a frame while others are in flight */
+typedef struct
+{
+    VkCommandBuffer commandBuffer;
+    VkFence fence;
+    SDL_bool submitted;
+    VkSemaphore imageAvailable;
+    SDL_bool waitForImage;
+
+    VULKAN_Buffer vertexBuffer;
+    VkDeviceSize vertexBufferOffset;
+    VULKAN_Buffer uploadBuffer;
+    VkDeviceSize uploadBufferOffset;
+
+    VkDescriptorPool *descriptorPools;
+    int descriptorPoolCount;
+    int currentDescriptorPool;
+    int currentDescriptorPoolUsed;
+    VULKAN_DescriptorCacheEntry descriptorCache[SDL_VULKAN_DESCRIPTOR_CACHE_SIZE];
+
+    VULKAN_PendingDestroy *pendingDestroys;
+    int pendingDestroyCount;
+    int pendingDestroyMax;
+} VULKAN_FrameData;
+
+typedef struct
+{
+    VULKAN_Shader shader;
+    SDL_BlendMode blendMode;
+    VkPrimitiveTopology topology;
+    VkFormat format;
+    VkPipeline pipeline;
+} VULKAN_PipelineState;
+
+typedef struct
+{
+    VkFormat format;
+    VkRenderPass renderPass;
+} VULKAN_RenderPass;
+
+typedef enum
+{
+    SAMPLER_NEAREST,
+    SAMPLER_LINEAR,
+    NUM_SAMPLERS
+} VULKAN_Sampler;
+
+/* Private renderer data */
+typedef struct
+{
+    PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
+#define VULKAN_GLOBAL_FUNCTION(name)   PFN_##name name;
+#define VULKAN_INSTANCE_FUNCTION(name) PFN_##name name;
+#define VULKAN_DEVICE_FUNCTION(name)   PFN_##name name;
+    VULKAN_FUNCTIONS()
+#undef VULKAN_GLOBAL_FUNCTION
+#undef VULKAN_INSTANCE_FUNCTION
+#undef VULKAN_DEVICE_FUNCTION
+
+    VkInstance instance;
+    VkSurfaceKHR surface;
+    VkPhysicalDevice physicalDevice;
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    Uint32 queueFamilyIndex;
+    VkDevice device;
+    VkQueue queue;
+    VkCommandPool commandPool;
+
+    /* Swapchain data */
+    VkSwapchainKHR swapchain;
+    VULKAN_Image *swapchainImages;
+    VkSemaphore *renderFinished;
+    Uint32 swapchainImageCount;
+    Uint32 currentSwapchainImage;
+    SDL_bool swapchainImageAcquired;
+    SDL_bool swapchainSupportsReadback;
+    SDL_bool recreateSwapchain;
+    SDL_bool vsync;
+
+    /* Frame data */
+    VULKAN_FrameData frames[SDL_VULKAN_FRAMES_IN_FLIGHT];
+    int currentFrame;
+    SDL_bool recording;
+    VULKAN_PendingDestroy *pendingDestroys;
+    int pendingDestroyCount;
+    int pendingDestroyMax;
+
+    /* Pipeline data */
+    VULKAN_RenderPass renderPasses[SDL_VULKAN_MAX_RENDER_PASSES];
+    int renderPassCount;
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkPipelineLayout pipelineLayout;
+    VkShaderModule vertexShaders[NUM_SHADERS];
+    VkShaderModule pixelShaders[NUM_SHADERS];
+    VkSampler samplers[NUM_SAMPLERS];
+    VkPipelineCache pipelineCache;
+    char *pipelineCachePath;
+    VULKAN_PipelineState *pipelineStates;
+    int pipelineStateCount;
+
+    /* Current render state */
+    VULKAN_TextureData *textureRenderTarget;
+    SDL_bool renderPassActive;
+    VULKAN_PipelineState *currentPipelineState;
+    VkDescriptorSet currentDescriptorSet;
+    VkBuffer currentVertexBuffer;
+    VkDeviceSize currentVertexBufferOffset;
+    SDL_bool vertexBufferBound;
+    SDL_Rect currentViewport;
+    SDL_bool viewportDirty;
+    SDL_bool currentCliprectEnabled;
+    SDL_Rect currentCliprect;
+    SDL_bool cliprectDirty;
+} VULKAN_RenderData;
+
+static int VULKAN_SetError(const char *function, VkResult result)
+{
+    return SDL_SetError("%s: %s", function, SDL_Vulkan_GetResultString(result));
+}
+
+static VkFormat SDLPixelFormatToVkFormat(Uint32 sdlFormat)
+{
+    switch (sdlFormat) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_XRGB8888:
+        return VK_FORMAT_B8G8R8A8_UNORM;
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_XBGR8888:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    default:
+        return VK_FORMAT_UNDEFINED;
+    }
+}
+
+static Uint32 VkFormatToSDLPixelFormat(VkFormat vkFormat)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_B8G8R8A8_UNORM:
+        return SDL_PIXELFORMAT_ARGB8888;
+    case VK_FORMAT_R8G8B8A8_UNORM:
+        return SDL_PIXELFORMAT_ABGR8888;
+    default:
+        return SDL_PIXELFORMAT_UNKNOWN;
+    }
+}
+
+static int VULKAN_LoadGlobalFunctions(VULKAN_RenderData *data)
+{
+#define VULKAN_GLOBAL_FUNCTION(name)                                                        \
+    data->name = (PFN_##name)data->vkGetInstanceProcAddr(VK_NULL_HANDLE, #name);            \
+    if (!data->name) {                                                                      \
+        return SDL_SetError("vkGetInstanceProcAddr(VK_NULL_HANDLE, \"" #name "\") failed"); \
+    }
+#define VULKAN_INSTANCE_FUNCTION(name)
+#define VULKAN_DEVICE_FUNCTION(name)
+    VULKAN_FUNCTIONS()
+#undef VULKAN_GLOBAL_FUNCTION
+#undef VULKAN_INSTANCE_FUNCTION
+#undef VULKAN_DEVICE_FUNCTION
+    return 0;
+}
+
+static int VULKAN_LoadInstanceFunctions(VULKAN_RenderData *data)
+{
+#define VULKAN_GLOBAL_FUNCTION(name)
+#define VULKAN_INSTANCE_FUNCTION(name)                                                \
+    data->name = (PFN_##name)data->vkGetInstanceProcAddr(data->instance, #name);      \
+    if (!data->name) {                                                                \
+        return SDL_SetError("vkGetInstanceProcAddr(instance, \"" #name "\") failed"); \
+    }
+#define VULKAN_DEVICE_FUNCTION(name)
+    VULKAN_FUNCTIONS()
+#undef VULKAN_GLOBAL_FUNCTION
+#undef VULKAN_INSTANCE_FUNCTION
+#undef VULKAN_DEVICE_FUNCTION
+    return 0;
+}
+
+static int VULKAN_LoadDeviceFunctions(VULKAN_RenderData *data)
+{
+#define VULKAN_GLOBAL_FUNCTION(name)
+#define VULKAN_INSTANCE_FUNCTION(name)
+#define VULKAN_DEVICE_FUNCTION(name)                                              \
+    data->name = (PFN_##name)data->vkGetDeviceProcAddr(data->device, #name);      \
+    if (!data->name) {                                                            \
+        return SDL_SetError("vkGetDeviceProcAddr(device, \"" #name "\") failed"); \
+    }
+    VULKAN_FUNCTIONS()
+#undef VULKAN_GLOBAL_FUNCTION
+#undef VULKAN_INSTANCE_FUNCTION
+#undef VULKAN_DEVICE_FUNCTION
+    return 0;
+}
+
+static Uint32 VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *data, Uint32 typeBits,
+                                         VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred)
+{
+    const VkMemoryPropertyFlags wanted = (required | preferred);
+    Uint32 i;
+
+    /* Look for a memory type with all the properties we'd like first */
+    for (i = 0; i < data->memoryProperties.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) &&
+            (data->memoryProperties.memoryTypes[i].propertyFlags & wanted) == wanted) {
+            return i;
+        }
+    }
+    for (i = 0; i < data->memoryProperties.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) &&
+            (data->memoryProperties.memoryTypes[i].propertyFlags & required) == required) {
+            return i;
+        }
+    }
+    return SDL_MAX_UINT32;
+}
+
+static int VULKAN_AllocateMemory(VULKAN_RenderData *data, const VkMemoryRequirements *requirements,
+                                 VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred,
+                                 VkDeviceMemory *memory)
+{
+    VkMemoryAllocateInfo allocateInfo;
+    VkResult result;
+
+    SDL_zero(allocateInfo);
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.allocationSize = requirements->size;
+    allocateInfo.memoryTypeIndex = VULKAN_FindMemoryTypeIndex(data, requirements->memoryTypeBits, required, preferred);
+    if (allocateInfo.memoryTypeIndex == SDL_MAX_UINT32) {
+        return SDL_SetError("No suitable Vulkan memory type found");
+    }
+
+    result = data->vkAllocateMemory(data->device, &allocateInfo, NULL, memory);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkAllocateMemory", result);
+    }
+    return 0;
+}
+
+static void VULKAN_DestroyBuffer(VULKAN_RenderData *data, VULKAN_Buffer *buffer)
+{
+    if (buffer->buffer != VK_NULL_HANDLE) {
+        data->vkDestroyBuffer(data->device, buffer->buffer, NULL);
+    }
+    if (buffer->memory != VK_NULL_HANDLE) {
+        data->vkFreeMemory(data->device, buffer->memory, NULL);
+    }
+    SDL_zerop(buffer);
+}
+
+/* Host visible buffers are coherent and stay mapped for as long as they exist */
+static int VULKAN_CreateBuffer(VULKAN_RenderData *data, VkDeviceSize size, VkBufferUsageFlags usage,
+                               VkMemoryPropertyFlags preferred, VULKAN_Buffer *buffer)
+{
+    VkBufferCreateInfo bufferInfo;
+    VkMemoryRequirements requirements;
+    VkResult result;
+    void *mapped = NULL;
+
+    SDL_zerop(buffer);
+
+    SDL_zero(bufferInfo);
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    result = data->vkCreateBuffer(data->device, &bufferInfo, NULL, &buffer->buffer);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkCreateBuffer", result);
+    }
+
+    data->vkGetBufferMemoryRequirements(data->device, buffer->buffer, &requirements);
+    if (VULKAN_AllocateMemory(data, &requirements,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              preferred, &buffer->memory) < 0) {
+        VULKAN_DestroyBuffer(data, buffer);
+        return -1;
+    }
+
+    result = data->vkBindBufferMemory(data->device, buffer->buffer, buffer->memory, 0);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyBuffer(data, buffer);
+        return VULKAN_SetError("vkBindBufferMemory", result);
+    }
+
+    result = data->vkMapMemory(data->device, buffer->memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyBuffer(data, buffer);
+        return VULKAN_SetError("vkMapMemory", result);
+    }
+    buffer->mapped = (Uint8 *)mapped;
+    buffer->size = size;
+    return 0;
+}
+
+static void VULKAN_DestroyResources(VULKAN_RenderData *data, VULKAN_PendingDestroy *resources, int count)
+{
+    int i, j;
+
+    for (i = 0; i < count; ++i) {
+        VULKAN_PendingDestroy *resource = &resources[i];
+
+        if (resource->framebuffer != VK_NULL_HANDLE) {
+            data->vkDestroyFramebuffer(data->device, resource->framebuffer, NULL);
+        }
+        for (j = 0; j < SDL_arraysize(resource->views); ++j) {
+            if (resource->views[j] != VK_NULL_HANDLE) {
+                data->vkDestroyImageView(data->device, resource->views[j], NULL);
+            }
+        }
+        if (resource->image != VK_NULL_HANDLE) {
+            data->vkDestroyImage(data->device, resource->image, NULL);
+        }
+        if (resource->buffer != VK_NULL_HANDLE) {
+            data->vkDestroyBuffer(data->device, resource->buffer, NULL);
+        }
+        if (resource->memory != VK_NULL_HANDLE) {
+            data->vkFreeMemory(data->device, resource->memory, NULL);
+        }
+    }
+}
+
+static SDL_bool VULKAN_AppendResources(VULKAN_PendingDestroy **list, int *count, int *max,
+                                       const VULKAN_PendingDestroy *resources, int num_resources)
+{
+    if (*count + num_resources > *max) {
+        int new_max = SDL_max(*max * 2, 16);
+        VULKAN_PendingDestroy *new_list;
+
+        while (new_max < *count + num_resources) {
+            new_max *= 2;
+        }
+        new_list = (VULKAN_PendingDestroy *)SDL_realloc(*list, new_max * sizeof(*new_list));
+        if (!new_list) {
+            return SDL_FALSE;
+        }
+        *list = new_list;
+        *max = new_max;
+    }
+    SDL_memcpy(*list + *count, resources, num_resources * sizeof(*resources));
+    *count += num_resources;
+    return SDL_TRUE;
+}
+
+/* Queue objects for destruction once all the work submitted so far is done.
+   They're handed to the next frame that's submitted, and destroyed when that
+   frame's fence signals. */
+static void VULKAN_DeferDestroy(VULKAN_RenderData *data, const VULKAN_PendingDestroy *resource)
+{
+    if (!VULKAN_AppendResources(&data->pendingDestroys, &data->pendingDestroyCount, &data->pendingDestroyMax, resource, 1)) {
+        /* Out of memory, do it the slow way */
+        data->vkDeviceWaitIdle(data->device);
+        VULKAN_DestroyResources(data, (VULKAN_PendingDestroy *)resource, 1);
+    }
+}
+
+static void VULKAN_DeferDestroyBuffer(VULKAN_RenderData *data, VULKAN_Buffer *buffer)
+{
+    VULKAN_PendingDestroy resource;
+
+    SDL_zero(resource);
+    resource.buffer = buffer->buffer;
+    resource.memory = buffer->memory;
+    VULKAN_DeferDestroy(data, &resource);
+    SDL_zerop(buffer);
+}
+
+static void VULKAN_ResetFrame(VULKAN_RenderData *data, VULKAN_FrameData *frame)
+{
+    int i;
+
+    VULKAN_DestroyResources(data, frame->pendingDestroys, frame->pendingDestroyCount);
+    frame->pendingDestroyCount = 0;
+
+    for (i = 0; i < frame->descriptorPoolCount; ++i) {
+        data->vkResetDescriptorPool(data->device, frame->descriptorPools[i], 0);
+    }
+    frame->currentDescriptorPool = 0;
+    frame->currentDescriptorPoolUsed = 0;
+    SDL_zeroa(frame->descriptorCache);
+
+    frame->vertexBufferOffset = 0;
+    frame->uploadBufferOffset = 0;
+}
+
+/* Make sure there's a command buffer to record into */
+static int VULKAN_BeginFrame(VULKAN_RenderData *data)
+{
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    VkCommandBufferBeginInfo beginInfo;
+    VkResult result;
+
+    if (data->recording) {
+        return 0;
+    }
+
+    if (frame->submitted) {
+        result = data->vkWaitForFences(data->device, 1, &frame->fence, VK_TRUE, SDL_MAX_UINT64);
+        if (result != VK_SUCCESS) {
+            return VULKAN_SetError("vkWaitForFences", result);
+        }
+        data->vkResetFences(data->device, 1, &frame->fence);
+        frame->submitted = SDL_FALSE;
+    }
+    VULKAN_ResetFrame(data, frame);
+
+    result = data->vkResetCommandBuffer(frame->commandBuffer, 0);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkResetCommandBuffer", result);
+    }
+
+    SDL_zero(beginInfo);
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    result = data->vkBeginCommandBuffer(frame->commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkBeginCommandBuffer", result);
+    }
+
+    data->recording = SDL_TRUE;
+    data->renderPassActive = SDL_FALSE;
+    data->currentPipelineState = NULL;
+    data->currentDescriptorSet = VK_NULL_HANDLE;
+    data->vertexBufferBound = SDL_FALSE;
+    data->viewportDirty = SDL_TRUE;
+    data->cliprectDirty = SDL_TRUE;
+    return 0;
+}
+
+static void VULKAN_EndRenderPass(VULKAN_RenderData *data)
+{
+    if (data->renderPassActive) {
+        data->vkCmdEndRenderPass(data->frames[data->currentFrame].commandBuffer);
+        data->renderPassActive = SDL_FALSE;
+    }
+}
+
+static void VULKAN_GetLayoutAccess(VkImageLayout layout, SDL_bool source, VkAccessFlags *access, VkPipelineStageFlags *stage)
+{
+    switch (layout) {
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+        *access = VK_ACCESS_TRANSFER_READ_BIT;
+        *stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        break;
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+        *access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        *stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        break;
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+        *access = VK_ACCESS_SHADER_READ_BIT;
+        *stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        break;
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+        *access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        *stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        break;
+    default:
+        /* Undefined contents or presentation, which is synchronized with semaphores.
+           As a source this has to chain with the wait on the image acquire semaphore. */
+        *access = 0;
+        *stage = source ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        break;
+    }
+}
+
+static void VULKAN_TransitionImage(VULKAN_RenderData *data, VULKAN_Image *image, VkImageLayout layout)
+{
+    VkImageMemoryBarrier barrier;
+    VkPipelineStageFlags srcStage, dstStage;
+
+    if (image->layout == layout) {
+        return;
+    }
+
+    /* Layout transitions can't happen inside a render pass */
+    VULKAN_EndRenderPass(data);
+
+    SDL_zero(barrier);
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    VULKAN_GetLayoutAccess(image->layout, SDL_TRUE, &barrier.srcAccessMask, &srcStage);
+    VULKAN_GetLayoutAccess(layout, SDL_FALSE, &barrier.dstAccessMask, &dstStage);
+    barrier.oldLayout = image->layout;
+    barrier.newLayout = layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image->image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    data->vkCmdPipelineBarrier(data->frames[data->currentFrame].commandBuffer,
+                               srcStage, dstStage, 0,
+                               0, NULL,
+                               0, NULL,
+                               1, &barrier);
+    image->layout = layout;
+}
+
+static int VULKAN_Submit(VULKAN_RenderData *data, VkSemaphore signalSemaphore)
+{
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submitInfo;
+    VkResult result;
+
+    VULKAN_EndRenderPass(data);
+
+    data->recording = SDL_FALSE;
+    result = data->vkEndCommandBuffer(frame->commandBuffer);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkEndCommandBuffer", result);
+    }
+
+    SDL_zero(submitInfo);
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    if (frame->waitForImage) {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &frame->imageAvailable;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        frame->waitForImage = SDL_FALSE;
+    }
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &frame->commandBuffer;
+    if (signalSemaphore != VK_NULL_HANDLE) {
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphore;
+    }
+    result = data->vkQueueSubmit(data->queue, 1, &submitInfo, frame->fence);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkQueueSubmit", result);
+    }
+    frame->submitted = SDL_TRUE;
+
+    /* Anything released so far can go away once this frame is done */
+    if (VULKAN_AppendResources(&frame->pendingDestroys, &frame->pendingDestroyCount, &frame->pendingDestroyMax,
+                               data->pendingDestroys, data->pendingDestroyCount)) {
+        data->pendingDestroyCount = 0;
+    }
+    return 0;
+}
+
+/* Submit the work recorded so far and wait for it to finish, e.g. to read back pixels */
+static int VULKAN_IssueBatch(VULKAN_RenderData *data)
+{
+    if (!data->recording) {
+        return 0;
+    }
+    if (VULKAN_Submit(data, VK_NULL_HANDLE) < 0) {
+        return -1;
+    }
+    return VULKAN_BeginFrame(data);
+}
+
+static void VULKAN_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
+
+static VkRenderPass VULKAN_GetRenderPass(VULKAN_RenderData *data, VkFormat format)
+{
+    VkAttachmentDescription attachment;
+    VkAttachmentReference colorReference;
+    VkSubpassDescription subpass;
+    VkRenderPassCreateInfo renderPassInfo;
+    VkRenderPass renderPass;
+    VkResult result;
+    int i;
+
+    for (i = 0; i < data->renderPassCount; ++i) {
+        if (data->renderPasses[i].format == format) {
+            return data->renderPasses[i].renderPass;
+        }
+    }
+    if (data->renderPassCount == SDL_arraysize(data->renderPasses)) {
+        SDL_SetError("Too many Vulkan render target formats");
+        return VK_NULL_HANDLE;
+    }
+
+    /* The render target is kept in the attachment layout outside the pass,
+       layout transitions are done with explicit barriers. */
+    SDL_zero(attachment);
+    attachment.format = format;
+    attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    colorReference.attachment = 0;
+    colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    SDL_zero(subpass);
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorReference;
+
+    SDL_zero(renderPassInfo);
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 1;
+    renderPassInfo.pAttachments = &attachment;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    result = data->vkCreateRenderPass(data->device, &renderPassInfo, NULL, &renderPass);
+    if (result != VK_SUCCESS) {
+        VULKAN_SetError("vkCreateRenderPass", result);
+        return VK_NULL_HANDLE;
+    }
+
+    data->renderPasses[data->renderPassCount].format = format;
+    data->renderPasses[data->renderPassCount].renderPass = renderPass;
+    ++data->renderPassCount;
+    return renderPass;
+}
+
+static int VULKAN_CreateImageView(VULKAN_RenderData *data, VkImage image, VkFormat format,
+                                  SDL_bool opaque, VkImageView *view)
+{
+    VkImageViewCreateInfo viewInfo;
+    VkResult result;
+
+    SDL_zero(viewInfo);
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+    viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+    viewInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+    viewInfo.components.a = opaque ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+    result = data->vkCreateImageView(data->device, &viewInfo, NULL, view);
+    if (result != VK_SUCCESS) {
+        *view = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateImageView", result);
+    }
+    return 0;
+}
+
+static int VULKAN_CreateFramebuffer(VULKAN_RenderData *data, VULKAN_Image *image)
+{
+    VkFramebufferCreateInfo framebufferInfo;
+    VkResult result;
+
+    SDL_zero(framebufferInfo);
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = VULKAN_GetRenderPass(data, image->format);
+    if (framebufferInfo.renderPass == VK_NULL_HANDLE) {
+        return -1;
+    }
+    framebufferInfo.attachmentCount = 1;
+    framebufferInfo.pAttachments = &image->view;
+    framebufferInfo.width = image->width;
+    framebufferInfo.height = image->height;
+    framebufferInfo.layers = 1;
+    result = data->vkCreateFramebuffer(data->device, &framebufferInfo, NULL, &image->framebuffer);
+    if (result != VK_SUCCESS) {
+        image->framebuffer = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateFramebuffer", result);
+    }
+    return 0;
+}
+
+static void VULKAN_DestroySwapchainImages(VULKAN_RenderData *data)
+{
+    Uint32 i;
+
+    for (i = 0; i < data->swapchainImageCount; ++i) {
+        if (data->swapchainImages[i].framebuffer != VK_NULL_HANDLE) {
+            data->vkDestroyFramebuffer(data->device, data->swapchainImages[i].framebuffer, NULL);
+        }
+        if (data->swapchainImages[i].view != VK_NULL_HANDLE) {
+            data->vkDestroyImageView(data->device, data->swapchainImages[i].view, NULL);
+        }
+        if (data->renderFinished[i] != VK_NULL_HANDLE) {
+            data->vkDestroySemaphore(data->device, data->renderFinished[i], NULL);
+        }
+    }
+    SDL_free(data->swapchainImages);
+    data->swapchainImages = NULL;
+    SDL_free(data->renderFinished);
+    data->renderFinished = NULL;
+    data->swapchainImageCount = 0;
+}
+
+static VkSurfaceFormatKHR VULKAN_ChooseSurfaceFormat(VULKAN_RenderData *data)
+{
+    VkSurfaceFormatKHR chosen;
+    VkSurfaceFormatKHR *formats = NULL;
+    Uint32 count = 0;
+    Uint32 i;
+
+    chosen.format = VK_FORMAT_B8G8R8A8_UNORM;
+    chosen.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+
+    if (data->vkGetPhysicalDeviceSurfaceFormatsKHR(data->physicalDevice, data->surface, &count, NULL) != VK_SUCCESS || count == 0) {
+        return chosen;
+    }
+    formats = (VkSurfaceFormatKHR *)SDL_malloc(count * sizeof(*formats));
+    if (!formats) {
+        return chosen;
+    }
+    if (data->vkGetPhysicalDeviceSurfaceFormatsKHR(data->physicalDevice, data->surface, &count, formats) == VK_SUCCESS && count > 0) {
+        /* A single undefined format means anything goes */
+        if (count > 1 || formats[0].format != VK_FORMAT_UNDEFINED) {
+            chosen = formats[0];
+            for (i = 0; i < count; ++i) {
+                if (formats[i].format == VK_FORMAT_R8G8B8A8_UNORM) {
+                    chosen = formats[i];
+                }
+            }
+            for (i = 0; i < count; ++i) {
+                if (formats[i].format == VK_FORMAT_B8G8R8A8_UNORM) {
+                    chosen = formats[i];
+                    break;
+                }
+            }
+        }
+    }
+    SDL_free(formats);
+    return chosen;
+}
+
+static VkPresentModeKHR VULKAN_ChoosePresentMode(VULKAN_RenderData *data)
+{
+    VkPresentModeKHR chosen = VK_PRESENT_MODE_FIFO_KHR; /* always supported */
+    VkPresentModeKHR *modes = NULL;
+    Uint32 count = 0;
+    Uint32 i;
+
+    if (data->vsync) {
+        return chosen;
+    }
+
+    if (data->vkGetPhysicalDeviceSurfacePresentModesKHR(data->physicalDevice, data->surface, &count, NULL) != VK_SUCCESS || count == 0) {
+        return chosen;
+    }
+    modes = (VkPresentModeKHR *)SDL_malloc(count * sizeof(*modes));
+    if (!modes) {
+        return chosen;
+    }
+    if (data->vkGetPhysicalDeviceSurfacePresentModesKHR(data->physicalDevice, data->surface, &count, modes) == VK_SUCCESS) {
+        for (i = 0; i < count; ++i) {
+            if (modes[i] == VK_PRESENT_MODE_IMMEDIATE_KHR) {
+                chosen = modes[i];
+                break;
+            }
+            if (modes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
+                chosen = modes[i];
+            }
+        }
+    }
+    SDL_free(modes);
+    return chosen;
+}
+
+static int VULKAN_CreateSwapchain(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VkSurfaceCapabilitiesKHR capabilities;
+    VkSwapchainCreateInfoKHR swapchainInfo;
+    VkSurfaceFormatKHR surfaceFormat;
+    VkSwapchainKHR oldSwapchain = data->swapchain;
+    VkImage *images = NULL;
+    VkSemaphoreCreateInfo semaphoreInfo;
+    VkResult result;
+    Uint32 count = 0;
+    Uint32 i;
+    int w, h;
+
+    data->recreateSwapchain = SDL_FALSE;
+
+    /* None of the swapchain images can be in use when they go away */
+    data->vkDeviceWaitIdle(data->device);
+    VULKAN_DestroySwapchainImages(data);
+    data->swapchainImageAcquired = SDL_FALSE;
+
+    result = data->vkGetPhysicalDeviceSurfaceCapabilitiesKHR(data->physicalDevice, data->surface, &capabilities);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", result);
+    }
+
+    SDL_zero(swapchainInfo);
+    if (capabilities.currentExtent.width != SDL_MAX_UINT32) {
+        swapchainInfo.imageExtent = capabilities.currentExtent;
+    } else {
+        SDL_GetWindowSizeInPixels(renderer->window, &w, &h);
+        swapchainInfo.imageExtent.width = SDL_clamp((Uint32)w, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        swapchainInfo.imageExtent.height = SDL_clamp((Uint32)h, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+    if (swapchainInfo.imageExtent.width == 0 || swapchainInfo.imageExtent.height == 0) {
+        /* The window is minimized, there's nothing to present to */
+        if (oldSwapchain != VK_NULL_HANDLE) {
+            data->vkDestroySwapchainKHR(data->device, oldSwapchain, NULL);
+            data->swapchain = VK_NULL_HANDLE;
+        }
+        return 0;
+    }
+
+    surfaceFormat = VULKAN_ChooseSurfaceFormat(data);
+
+    swapchainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    swapchainInfo.surface = data->surface;
+    swapchainInfo.minImageCount = capabilities.minImageCount + 1;
+    if (capabilities.maxImageCount > 0 && swapchainInfo.minImageCount > capabilities.maxImageCount) {
+        swapchainInfo.minImageCount = capabilities.maxImageCount;
+    }
+    swapchainInfo.imageFormat = surfaceFormat.format;
+    swapchainInfo.imageColorSpace = surfaceFormat.colorSpace;
+    swapchainInfo.imageArrayLayers = 1;
+    swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    data->swapchainSupportsReadback = (capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) ? SDL_TRUE : SDL_FALSE;
+    if (data->swapchainSupportsReadback) {
+        swapchainInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    swapchainInfo.preTransform = capabilities.currentTransform;
+    if (capabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR) {
+        swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    } else {
+        /* Pick the first supported mode */
+        swapchainInfo.compositeAlpha = (VkCompositeAlphaFlagBitsKHR)(capabilities.supportedCompositeAlpha & ~(capabilities.supportedCompositeAlpha - 1));
+    }
+    swapchainInfo.presentMode = VULKAN_ChoosePresentMode(data);
+    swapchainInfo.clipped = VK_TRUE;
+    swapchainInfo.oldSwapchain = oldSwapchain;
+    result = data->vkCreateSwapchainKHR(data->device, &swapchainInfo, NULL, &data->swapchain);
+    if (oldSwapchain != VK_NULL_HANDLE) {
+        data->vkDestroySwapchainKHR(data->device, oldSwapchain, NULL);
+    }
+    if (result != VK_SUCCESS) {
+        data->swapchain = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateSwapchainKHR", result);
+    }
+
+    result = data->vkGetSwapchainImagesKHR(data->device, data->swapchain, &count, NULL);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkGetSwapchainImagesKHR", result);
+    }
+    images = (VkImage *)SDL_malloc(count * sizeof(*images));
+    data->swapchainImages = (VULKAN_Image *)SDL_calloc(count, sizeof(*data->swapchainImages));
+    data->renderFinished = (VkSemaphore *)SDL_calloc(count, sizeof(*data->renderFinished));
+    if (!images || !data->swapchainImages || !data->renderFinished) {
+        SDL_free(images);
+        return SDL_OutOfMemory();
+    }
+    data->swapchainImageCount = count;
+
+    result = data->vkGetSwapchainImagesKHR(data->device, data->swapchain, &count, images);
+    if (result != VK_SUCCESS) {
+        SDL_free(images);
+        return VULKAN_SetError("vkGetSwapchainImagesKHR", result);
+    }
+
+    SDL_zero(semaphoreInfo);
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (i = 0; i < count; ++i) {
+        VULKAN_Image *image = &data->swapchainImages[i];
+
+        image->image = images[i];
+        image->layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image->format = surfaceFormat.format;
+        image->width = swapchainInfo.imageExtent.width;
+        image->height = swapchainInfo.imageExtent.height;
+        if (VULKAN_CreateImageView(data, image->image, image->format, SDL_FALSE, &image->view) < 0 ||
+            VULKAN_CreateFramebuffer(data, image) < 0) {
+            SDL_free(images);
+            return -1;
+        }
+
+        result = data->vkCreateSemaphore(data->device, &semaphoreInfo, NULL, &data->renderFinished[i]);
+        if (result != VK_SUCCESS) {
+            SDL_free(images);
+            return VULKAN_SetError("vkCreateSemaphore", result);
+        }
+    }
+    SDL_free(images);
+
+    return 0;
+}
+
+static int VULKAN_AcquireNextImage(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    VkResult result;
+    int attempt;
+
+    for (attempt = 0; attempt < 2; ++attempt) {
+        if (data->recreateSwapchain || data->swapchain == VK_NULL_HANDLE) {
+            if (VULKAN_CreateSwapchain(renderer) < 0) {
+                return -1;
+            }
+            if (data->swapchain == VK_NULL_HANDLE) {
+                return -1; /* minimized, try again later */
+            }
+        }
+
+        result = data->vkAcquireNextImageKHR(data->device, data->swapchain, SDL_MAX_UINT64,
+                                             frame->imageAvailable, VK_NULL_HANDLE,
+                                             &data->currentSwapchainImage);
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+            data->swapchainImageAcquired = SDL_TRUE;
+            frame->waitForImage = SDL_TRUE;
+            return 0;
+        }
+        if (result != VK_ERROR_OUT_OF_DATE_KHR) {
+            return VULKAN_SetError("vkAcquireNextImageKHR", result);
+        }
+        data->recreateSwapchain = SDL_TRUE;
+    }
+    return SDL_SetError("Couldn't acquire a swapchain image");
+}
+
+/* The backbuffer image is acquired the first time it's needed in a frame */
+static VULKAN_Image *VULKAN_GetCurrentRenderTarget(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+
+    if (data->textureRenderTarget) {
+        return &data->textureRenderTarget->image;
+    }
+    if (!data->swapchainImageAcquired && VULKAN_AcquireNextImage(renderer) < 0) {
+        return NULL;
+    }
+    return &data->swapchainImages[data->currentSwapchainImage];
+}
+
+static int VULKAN_BeginRenderPass(SDL_Renderer *renderer, VULKAN_Image **outTarget)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VkRenderPassBeginInfo beginInfo;
+    VULKAN_Image *target;
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+
+    target = VULKAN_GetCurrentRenderTarget(renderer);
+    if (!target) {
+        return -1;
+    }
+    *outTarget = target;
+
+    if (data->renderPassActive) {
+        return 0;
+    }
+
+    VULKAN_TransitionImage(data, target, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    SDL_zero(beginInfo);
+    beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    beginInfo.renderPass = VULKAN_GetRenderPass(data, target->format);
+    if (beginInfo.renderPass == VK_NULL_HANDLE) {
+        return -1;
+    }
+    beginInfo.framebuffer = target->framebuffer;
+    beginInfo.renderArea.extent.width = target->width;
+    beginInfo.renderArea.extent.height = target->height;
+    data->vkCmdBeginRenderPass(data->frames[data->currentFrame].commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    data->renderPassActive = SDL_TRUE;
+
+    data->currentPipelineState = NULL;
+    data->currentDescriptorSet = VK_NULL_HANDLE;
+    data->vertexBufferBound = SDL_FALSE;
+    data->viewportDirty = SDL_TRUE;
+    data->cliprectDirty = SDL_TRUE;
+    return 0;
+}
+
+static void VULKAN_DestroyRenderer(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    int i;
+
+    if (data) {
+        if (data->device != VK_NULL_HANDLE) {
+            data->vkDeviceWaitIdle(data->device);
+
+            if (data->pipelineCache != VK_NULL_HANDLE) {
+                size_t size = 0;
+                void *blob;
+
+                if (data->pipelineCachePath &&
+                    data->vkGetPipelineCacheData(data->device, data->pipelineCache, &size, NULL) == VK_SUCCESS &&
+                    size > 0) {
+                    blob = SDL_malloc(size);
+                    if (blob) {
+                        if (data->vkGetPipelineCacheData(data->device, data->pipelineCache, &size, blob) == VK_SUCCESS) {
+                            SDL_RWops *file = SDL_RWFromFile(data->pipelineCachePath, "wb");
+                            if (file) {
+                                SDL_RWwrite(file, blob, size);
+                                SDL_RWclose(file);
+                            }
+                        }
+                        SDL_free(blob);
+                    }
+                }
+                data->vkDestroyPipelineCache(data->device, data->pipelineCache, NULL);
+            }
+
+            VULKAN_DestroyResources(data, data->pendingDestroys, data->pendingDestroyCount);
+            for (i = 0; i < SDL_VULKAN_FRAMES_IN_FLIGHT; ++i) {
+                VULKAN_FrameData *frame = &data->frames[i];
+                int j;
+
+                VULKAN_DestroyResources(data, frame->pendingDestroys, frame->pendingDestroyCount);
+                SDL_free(frame->pendingDestroys);
+                for (j = 0; j < frame->descriptorPoolCount; ++j) {
+                    data->vkDestroyDescriptorPool(data->device, frame->descriptorPools[j], NULL);
+                }
+                SDL_free(frame->descriptorPools);
+                VULKAN_DestroyBuffer(data, &frame->vertexBuffer);
+                VULKAN_DestroyBuffer(data, &frame->uploadBuffer);
+                if (frame->imageAvailable != VK_NULL_HANDLE) {
+                    data->vkDestroySemaphore(data->device, frame->imageAvailable, NULL);
+                }
+                if (frame->fence != VK_NULL_HANDLE) {
+                    data->vkDestroyFence(data->device, frame->fence, NULL);
+                }
+            }
+
+            VULKAN_DestroySwapchainImages(data);
+            if (data->swapchain != VK_NULL_HANDLE) {
+                data->vkDestroySwapchainKHR(data->device, data->swapchain, NULL);
+            }
+
+            for (i = 0; i < data->pipelineStateCount; ++i) {
+                data->vkDestroyPipeline(data->device, data->pipelineStates[i].pipeline, NULL);
+            }
+            SDL_free(data->pipelineStates);
+            for (i = 0; i < data->renderPassCount; ++i) {
+                data->vkDestroyRenderPass(data->device, data->renderPasses[i].renderPass, NULL);
+            }
+            for (i = 0; i < NUM_SAMPLERS; ++i) {
+                if (data->samplers[i] != VK_NULL_HANDLE) {
+                    data->vkDestroySampler(data->device, data->samplers[i], NULL);
+                }
+            }
+            for (i = 0; i < NUM_SHADERS; ++i) {
+                if (data->vertexShaders[i] != VK_NULL_HANDLE) {
+                    data->vkDestroyShaderModule(data->device, data->vertexShaders[i], NULL);
+                }
+                if (data->pixelShaders[i] != VK_NULL_HANDLE) {
+                    data->vkDestroyShaderModule(data->device, data->pixelShaders[i], NULL);
+                }
+            }
+            if (data->pipelineLayout != VK_NULL_HANDLE) {
+                data->vkDestroyPipelineLayout(data->device, data->pipelineLayout, NULL);
+            }
+            if (data->descriptorSetLayout != VK_NULL_HANDLE) {
+                data->vkDestroyDescriptorSetLayout(data->device, data->descriptorSetLayout, NULL);
+            }
+            if (data->commandPool != VK_NULL_HANDLE) {
+                data->vkDestroyCommandPool(data->device, data->commandPool, NULL);
+            }
+            data->vkDestroyDevice(data->device, NULL);
+        }
+        SDL_free(data->pendingDestroys);
+
+        if (data->surface != VK_NULL_HANDLE) {
+            data->vkDestroySurfaceKHR(data->instance, data->surface, NULL);
+        }
+        if (data->instance != VK_NULL_HANDLE) {
+            data->vkDestroyInstance(data->instance, NULL);
+        }
+        SDL_free(data->pipelineCachePath);
+        SDL_free(data);
+    }
+    SDL_free(renderer);
+}
+
+static VkBlendFactor GetBlendFunc(SDL_BlendFactor factor)
+{
+    switch (factor) {
+    case SDL_BLENDFACTOR_ZERO:
+        return VK_BLEND_FACTOR_ZERO;
+    case SDL_BLENDFACTOR_ONE:
+        return VK_BLEND_FACTOR_ONE;
+    case SDL_BLENDFACTOR_SRC_COLOR:
+        return VK_BLEND_FACTOR_SRC_COLOR;
+    case SDL_BLENDFACTOR_ONE_MINUS_SRC_COLOR:
+        return VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+    case SDL_BLENDFACTOR_SRC_ALPHA:
+        return VK_BLEND_FACTOR_SRC_ALPHA;
+    case SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA:
+        return VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    case SDL_BLENDFACTOR_DST_COLOR:
+        return VK_BLEND_FACTOR_DST_COLOR;
+    case SDL_BLENDFACTOR_ONE_MINUS_DST_COLOR:
+        return VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR;
+    case SDL_BLENDFACTOR_DST_ALPHA:
+        return VK_BLEND_FACTOR_DST_ALPHA;
+    case SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA:
+        return VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
+    default:
+        return VK_BLEND_FACTOR_MAX_ENUM;
+    }
+}
+
+static VkBlendOp GetBlendEquation(SDL_BlendOperation operation)
+{
+    switch (operation) {
+    case SDL_BLENDOPERATION_ADD:
+        return VK_BLEND_OP_ADD;
+    case SDL_BLENDOPERATION_SUBTRACT:
+        return VK_BLEND_OP_SUBTRACT;
+    case SDL_BLENDOPERATION_REV_SUBTRACT:
+        return VK_BLEND_OP_REVERSE_SUBTRACT;
+    case SDL_BLENDOPERATION_MINIMUM:
+        return VK_BLEND_OP_MIN;
+    case SDL_BLENDOPERATION_MAXIMUM:
+        return VK_BLEND_OP_MAX;
+    default:
+        return VK_BLEND_OP_MAX_ENUM;
+    }
+}
+
+static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
+                                                        VULKAN_Shader shader,
+                                                        SDL_BlendMode blendMode,
+                                                        VkPrimitiveTopology topology,
+                                                        VkFormat format)
+{
+    const VkVertexInputAttributeDescription vertexAttributes[] = {
+        { 0, 0, VK_FORMAT_R32G32_SFLOAT, 0 },
+        { 1, 0, VK_FORMAT_R32G32_SFLOAT, 8 },
+        { 2, 0, VK_FORMAT_R8G8B8A8_UNORM, 16 },
+    };
+    const VkDynamicState dynamicStates[] = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR
+    };
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VkPipelineShaderStageCreateInfo stages[2];
+    VkVertexInputBindingDescription vertexBinding;
+    VkPipelineVertexInputStateCreateInfo vertexInputState;
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+    VkPipelineViewportStateCreateInfo viewportState;
+    VkPipelineRasterizationStateCreateInfo rasterizationState;
+    VkPipelineMultisampleStateCreateInfo multisampleState;
+    VkPipelineColorBlendAttachmentState blendAttachment;
+    VkPipelineColorBlendStateCreateInfo blendState;
+    VkPipelineDynamicStateCreateInfo dynamicState;
+    VkGraphicsPipelineCreateInfo pipelineInfo;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VULKAN_PipelineState *pipelineStates;
+    VkResult result;
+
+    SDL_zeroa(stages);
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = data->vertexShaders[shader];
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = data->pixelShaders[shader];
+    stages[1].pName = "main";
+
+    vertexBinding.binding = 0;
+    vertexBinding.stride = sizeof(VertexPositionColor);
+    vertexBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    SDL_zero(vertexInputState);
+    vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputState.vertexBindingDescriptionCount = 1;
+    vertexInputState.pVertexBindingDescriptions = &vertexBinding;
+    vertexInputState.vertexAttributeDescriptionCount = SDL_arraysize(vertexAttributes);
+    vertexInputState.pVertexAttributeDescriptions = vertexAttributes;
+
+    SDL_zero(inputAssemblyState);
+    inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssemblyState.topology = topology;
+
+    /* The viewport and scissor are dynamic state */
+    SDL_zero(viewportState);
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    SDL_zero(rasterizationState);
+    rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizationState.cullMode = VK_CULL_MODE_NONE;
+    rasterizationState.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizationState.lineWidth = 1.0f;
+
+    SDL_zero(multisampleState);
+    multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    SDL_zero(blendAttachment);
+    blendAttachment.blendEnable = VK_TRUE;
+    blendAttachment.srcColorBlendFactor = GetBlendFunc(SDL_GetBlendModeSrcColorFactor(blendMode));
+    blendAttachment.dstColorBlendFactor = GetBlendFunc(SDL_GetBlendModeDstColorFactor(blendMode));
+    blendAttachment.colorBlendOp = GetBlendEquation(SDL_GetBlendModeColorOperation(blendMode));
+    blendAttachment.srcAlphaBlendFactor = GetBlendFunc(SDL_GetBlendModeSrcAlphaFactor(blendMode));
+    blendAttachment.dstAlphaBlendFactor = GetBlendFunc(SDL_GetBlendModeDstAlphaFactor(blendMode));
+    blendAttachment.alphaBlendOp = GetBlendEquation(SDL_GetBlendModeAlphaOperation(blendMode));
+    blendAttachment.colorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                      VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+
+    SDL_zero(blendState);
+    blendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blendState.attachmentCount = 1;
+    blendState.pAttachments = &blendAttachment;
+
+    SDL_zero(dynamicState);
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = SDL_arraysize(dynamicStates);
+    dynamicState.pDynamicStates = dynamicStates;
+
+    SDL_zero(pipelineInfo);
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = SDL_arraysize(stages);
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInputState;
+    pipelineInfo.pInputAssemblyState = &inputAssemblyState;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizationState;
+    pipelineInfo.pMultisampleState = &multisampleState;
+    pipelineInfo.pColorBlendState = &blendState;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = data->pipelineLayout;
+    pipelineInfo.renderPass = VULKAN_GetRenderPass(data, format);
+    if (pipelineInfo.renderPass == VK_NULL_HANDLE) {
+        return NULL;
+    }
+
+    result = data->vkCreateGraphicsPipelines(data->device, data->pipelineCache, 1, &pipelineInfo, NULL, &pipeline);
+    if (result != VK_SUCCESS) {
+        VULKAN_SetError("vkCreateGraphicsPipelines", result);
+        return NULL;
+    }
+
+    pipelineStates = (VULKAN_PipelineState *)SDL_realloc(data->pipelineStates, (data->pipelineStateCount + 1) * sizeof(*pipelineStates));
+    if (!pipelineStates) {
+        data->vkDestroyPipeline(data->device, pipeline, NULL);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    pipelineStates[data->pipelineStateCount].shader = shader;
+    pipelineStates[data->pipelineStateCount].blendMode = blendMode;
+    pipelineStates[data->pipelineStateCount].topology = topology;
+    pipelineStates[data->pipelineStateCount].format = format;
+    pipelineStates[data->pipelineStateCount].pipeline = pipeline;
+    data->pipelineStates = pipelineStates;
+    ++data->pipelineStateCount;
+
+    return &pipelineStates[data->pipelineStateCount - 1];
+}
+
+static int VULKAN_CreateInstance(VULKAN_RenderData *data)
+{
+    static const char *validationLayer = "VK_LAYER_KHRONOS_validation";
+    VkApplicationInfo appInfo;
+    VkInstanceCreateInfo instanceInfo;
+    const char *const *extensions;
+    Uint32 extensionCount = 0;
+    VkResult result;
+
+    extensions = SDL_Vulkan_GetInstanceExtensions(&extensionCount);
+    if (!extensions) {
+        return -1;
+    }
+
+    SDL_zero(appInfo);
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pEngineName = "SDL";
+    appInfo.engineVersion = VK_MAKE_VERSION(SDL_MAJOR_VERSION, SDL_MINOR_VERSION, SDL_PATCHLEVEL);
+    appInfo.apiVersion = VK_API_VERSION_1_0;
+
+    SDL_zero(instanceInfo);
+    instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instanceInfo.pApplicationInfo = &appInfo;
+    instanceInfo.enabledExtensionCount = extensionCount;
+    instanceInfo.ppEnabledExtensionNames = extensions;
+
+    if (SDL_GetHintBoolean(SDL_HINT_RENDER_VULKAN_DEBUG, SDL_FALSE)) {
+        VkLayerProperties *layers;
+        Uint32 layerCount = 0;
+        Uint32 i;
+
+        if (data->vkEnumerateInstanceLayerProperties(&layerCount, NULL) == VK_SUCCESS && layerCount > 0) {
+            layers = (VkLayerProperties *)SDL_malloc(layerCount * sizeof(*layers));
+            if (layers) {
+                if (data->vkEnumerateInstanceLayerProperties(&layerCount, layers) == VK_SUCCESS) {
+                    for (i = 0; i < layerCount; ++i) {
+                        if (SDL_strcmp(layers[i].layerName, validationLayer) == 0) {
+                            instanceInfo.enabledLayerCount = 1;
+                            instanceInfo.ppEnabledLayerNames = &validationLayer;
+                            break;
+                        }
+                    }
+                }
+                SDL_free(layers);
+            }
+        }
+    }
+
+    result = data->vkCreateInstance(&instanceInfo, NULL, &data->instance);
+    if (result != VK_SUCCESS) {
+        data->instance = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateInstance", result);
+    }
+    return 0;
+}
+
+static SDL_bool VULKAN_DeviceHasSwapchain(VULKAN_RenderData *data, VkPhysicalDevice physicalDevice)
+{
+    VkExtensionProperties *extensions;
+    Uint32 count = 0;
+    Uint32 i;
+    SDL_bool found = SDL_FALSE;
+
+    if (data->vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &count, NULL) != VK_SUCCESS || count == 0) {
+        return SDL_FALSE;
+    }
+    extensions = (VkExtensionProperties *)SDL_malloc(count * sizeof(*extensions));
+    if (!extensions) {
+        return SDL_FALSE;
+    }
+    if (data->vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &count, extensions) == VK_SUCCESS) {
+        for (i = 0; i < count; ++i) {
+            if (SDL_strcmp(extensions[i].extensionName, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) {
+                found = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_free(extensions);
+    return found;
+}
+
+static SDL_bool VULKAN_FindQueueFamily(VULKAN_RenderData *data, VkPhysicalDevice physicalDevice, Uint32 *queueFamilyIndex)
+{
+    VkQueueFamilyProperties *families;
+    Uint32 count = 0;
+    Uint32 i;
+    SDL_bool found = SDL_FALSE;
+
+    data->vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, NULL);
+    if (count == 0) {
+        return SDL_FALSE;
+    }
+    families = (VkQueueFamilyProperties *)SDL_malloc(count * sizeof(*families));
+    if (!families) {
+        return SDL_FALSE;
+    }
+    data->vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, families);
+    for (i = 0; i < count; ++i) {
+        VkBool32 supported = VK_FALSE;
+
+        if (!(families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) || families[i].queueCount == 0) {
+            continue;
+        }
+        if (data->vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, data->surface, &supported) == VK_SUCCESS && supported) {
+            *queueFamilyIndex = i;
+            found = SDL_TRUE;
+            break;
+        }
+    }
+    SDL_free(families);
+    return found;
+}
+
+static int VULKAN_FindPhysicalDevice(VULKAN_RenderData *data)
+{
+    VkPhysicalDevice *physicalDevices;
+    Uint32 count = 0;
+    Uint32 i;
+    int bestScore = -1;
+    VkResult result;
+
+    result = data->vkEnumeratePhysicalDevices(data->instance, &count, NULL);
+    if (result != VK_SUCCESS) {
+        return VULKAN_SetError("vkEnumeratePhysicalDevices", result);
+    }
+    if (count == 0) {
+        return SDL_SetError("No Vulkan devices found");
+    }
+    physicalDevices = (VkPhysicalDevice *)SDL_malloc(count * sizeof(*physicalDevices));
+    if (!physicalDevices) {
+        return SDL_OutOfMemory();
+    }
+    result = data->vkEnumeratePhysicalDevices(data->instance, &count, physicalDevices);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        SDL_free(physicalDevices);
+        return VULKAN_SetError("vkEnumeratePhysicalDevices", result);
+    }
+
+    /* Prefer discrete GPUs, then integrated ones, then anything that can present */
+    for (i = 0; i < count; ++i) {
+        VkPhysicalDeviceProperties properties;
+        Uint32 queueFamilyIndex = 0;
+        int score;
+
+        if (!VULKAN_DeviceHasSwapchain(data, physicalDevices[i]) ||
+            !VULKAN_FindQueueFamily(data, physicalDevices[i], &queueFamilyIndex)) {
+            continue;
+        }
+
+        data->vkGetPhysicalDeviceProperties(physicalDevices[i], &properties);
+        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+            score = 2;
+        } else if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) {
+            score = 1;
+        } else {
+            score = 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            data->physicalDevice = physicalDevices[i];
+            data->physicalDeviceProperties = properties;
+            data->queueFamilyIndex = queueFamilyIndex;
+        }
+    }
+    SDL_free(physicalDevices);
+
+    if (bestScore < 0) {
+        return SDL_SetError("No Vulkan device can render to this window");
+    }
+    data->vkGetPhysicalDeviceMemoryProperties(data->physicalDevice, &data->memoryProperties);
+    return 0;
+}
+
+static int VULKAN_CreateShaderModule(VULKAN_RenderData *data, const Uint32 *code, size_t size, VkShaderModule *module)
+{
+    VkShaderModuleCreateInfo moduleInfo;
+    VkResult result;
+
+    SDL_zero(moduleInfo);
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = size;
+    moduleInfo.pCode = code;
+    result = data->vkCreateShaderModule(data->device, &moduleInfo, NULL, module);
+    if (result != VK_SUCCESS) {
+        *module = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateShaderModule", result);
+    }
+    return 0;
+}
+
+static void VULKAN_CreatePipelineCache(VULKAN_RenderData *data)
+{
+    VkPipelineCacheCreateInfo cacheInfo;
+    void *initialData = NULL;
+    size_t size = 0;
+    VkResult result;
+
+    if (data->pipelineCachePath) {
+        initialData = SDL_LoadFile(data->pipelineCachePath, &size);
+    }
+
+    /* The driver ignores cache data made by a different driver or device */
+    SDL_zero(cacheInfo);
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = initialData ? size : 0;
+    cacheInfo.pInitialData = initialData;
+    result = data->vkCreatePipelineCache(data->device, &cacheInfo, NULL, &data->pipelineCache);
+    if (result != VK_SUCCESS && initialData) {
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = NULL;
+        result = data->vkCreatePipelineCache(data->device, &cacheInfo, NULL, &data->pipelineCache);
+    }
+    if (result != VK_SUCCESS) {
+        /* The pipelines will be created without a cache */
+        data->pipelineCache = VK_NULL_HANDLE;
+    }
+    SDL_free(initialData);
+}
+
+static int VULKAN_CreateDeviceResources(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    const float queuePriority = 1.0f;
+    const char *deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+    VkDeviceQueueCreateInfo queueInfo;
+    VkDeviceCreateInfo deviceInfo;
+    VkCommandPoolCreateInfo commandPoolInfo;
+    VkCommandBufferAllocateInfo commandBufferInfo;
+    VkFenceCreateInfo fenceInfo;
+    VkSemaphoreCreateInfo semaphoreInfo;
+    VkDescriptorSetLayoutBinding binding;
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo;
+    VkPushConstantRange pushConstantRange;
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo;
+    VkSamplerCreateInfo samplerInfo;
+    VkResult result;
+    int i;
+
+    data->vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)SDL_Vulkan_GetVkGetInstanceProcAddr();
+    if (!data->vkGetInstanceProcAddr) {
+        return -1;
+    }
+    if (VULKAN_LoadGlobalFunctions(data) < 0 ||
+        VULKAN_CreateInstance(data) < 0 ||
+        VULKAN_LoadInstanceFunctions(data) < 0) {
+        return -1;
+    }
+
+    if (!SDL_Vulkan_CreateSurface(renderer->window, data->instance, NULL, &data->surface)) {
+        data->surface = VK_NULL_HANDLE;
+        return -1;
+    }
+
+    if (VULKAN_FindPhysicalDevice(data) < 0) {
+        return -1;
+    }
+    renderer->info.max_texture_width = data->physicalDeviceProperties.limits.maxImageDimension2D;
+    renderer->info.max_texture_height = data->physicalDeviceProperties.limits.maxImageDimension2D;
+
+    SDL_zero(queueInfo);
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = data->queueFamilyIndex;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &queuePriority;
+
+    SDL_zero(deviceInfo);
+    deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    deviceInfo.enabledExtensionCount = SDL_arraysize(deviceExtensions);
+    deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+    result = data->vkCreateDevice(data->physicalDevice, &deviceInfo, NULL, &data->device);
+    if (result != VK_SUCCESS) {
+        data->device = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateDevice", result);
+    }
+    if (VULKAN_LoadDeviceFunctions(data) < 0) {
+        /* Can't clean up without the device functions */
+        PFN_vkDestroyDevice destroyDevice = (PFN_vkDestroyDevice)data->vkGetDeviceProcAddr(data->device, "vkDestroyDevice");
+        if (destroyDevice) {
+            destroyDevice(data->device, NULL);
+        }
+        data->device = VK_NULL_HANDLE;
+        return -1;
+    }
+    data->vkGetDeviceQueue(data->device, data->queueFamilyIndex, 0, &data->queue);
+
+    SDL_zero(commandPoolInfo);
+    commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolInfo.queueFamilyIndex = data->queueFamilyIndex;
+    result = data->vkCreateCommandPool(data->device, &commandPoolInfo, NULL, &data->commandPool);
+    if (result != VK_SUCCESS) {
+        data->commandPool = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateCommandPool", result);
+    }
+
+    SDL_zero(commandBufferInfo);
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.commandPool = data->commandPool;
+    commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferInfo.commandBufferCount = 1;
+
+    SDL_zero(fenceInfo);
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    SDL_zero(semaphoreInfo);
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (i = 0; i < SDL_VULKAN_FRAMES_IN_FLIGHT; ++i) {
+        VULKAN_FrameData *frame = &data->frames[i];
+
+        result = data->vkAllocateCommandBuffers(data->device, &commandBufferInfo, &frame->commandBuffer);
+        if (result != VK_SUCCESS) {
+            return VULKAN_SetError("vkAllocateCommandBuffers", result);
+        }
+        result = data->vkCreateFence(data->device, &fenceInfo, NULL, &frame->fence);
+        if (result != VK_SUCCESS) {
+            frame->fence = VK_NULL_HANDLE;
+            return VULKAN_SetError("vkCreateFence", result);
+        }
+        result = data->vkCreateSemaphore(data->device, &semaphoreInfo, NULL, &frame->imageAvailable);
+        if (result != VK_SUCCESS) {
+            frame->imageAvailable = VK_NULL_HANDLE;
+            return VULKAN_SetError("vkCreateSemaphore", result);
+        }
+        if (VULKAN_CreateBuffer(data, SDL_VULKAN_VERTEX_BUFFER_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &frame->vertexBuffer) < 0 ||
+            VULKAN_CreateBuffer(data, SDL_VULKAN_UPLOAD_BUFFER_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                0, &frame->uploadBuffer) < 0) {
+            return -1;
+        }
+    }
+
+    /* Textures are bound as a single combined image sampler */
+    SDL_zero(binding);
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    SDL_zero(setLayoutInfo);
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+    result = data->vkCreateDescriptorSetLayout(data->device, &setLayoutInfo, NULL, &data->descriptorSetLayout);
+    if (result != VK_SUCCESS) {
+        data->descriptorSetLayout = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreateDescriptorSetLayout", result);
+    }
+
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(VertexShaderConstants);
+
+    SDL_zero(pipelineLayoutInfo);
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &data->descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    result = data->vkCreatePipelineLayout(data->device, &pipelineLayoutInfo, NULL, &data->pipelineLayout);
+    if (result != VK_SUCCESS) {
+        data->pipelineLayout = VK_NULL_HANDLE;
+        return VULKAN_SetError("vkCreatePipelineLayout", result);
+    }
+
+    for (i = 0; i < NUM_SHADERS; ++i) {
+        const Uint32 *code;
+        size_t size;
+
+        VULKAN_GetVertexShader((VULKAN_Shader)i, &code, &size);
+        if (VULKAN_CreateShaderModule(data, code, size, &data->vertexShaders[i]) < 0) {
+            return -1;
+        }
+        VULKAN_GetPixelShader((VULKAN_Shader)i, &code, &size);
+        if (VULKAN_CreateShaderModule(data, code, size, &data->pixelShaders[i]) < 0) {
+            return -1;
+        }
+    }
+
+    SDL_zero(samplerInfo);
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = 0.0f;
+    for (i = 0; i < NUM_SAMPLERS; ++i) {
+        samplerInfo.magFilter = (i == SAMPLER_NEAREST) ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+        samplerInfo.minFilter = samplerInfo.magFilter;
+        result = data->vkCreateSampler(data->device, &samplerInfo, NULL, &data->samplers[i]);
+        if (result != VK_SUCCESS) {
+            data->samplers[i] = VK_NULL_HANDLE;
+            return VULKAN_SetError("vkCreateSampler", result);
+        }
+    }
+
+    VULKAN_CreatePipelineCache(data);
+
+    return 0;
+}
+
+static void VULKAN_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+
+    if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+        data->recreateSwapchain = SDL_TRUE;
+    }
+}
+
+static SDL_bool VULKAN_SupportsBlendMode(SDL_Renderer *renderer, SDL_BlendMode blendMode)
+{
+    SDL_BlendFactor srcColorFactor = SDL_GetBlendModeSrcColorFactor(blendMode);
+    SDL_BlendFactor srcAlphaFactor = SDL_GetBlendModeSrcAlphaFactor(blendMode);
+    SDL_BlendOperation colorOperation = SDL_GetBlendModeColorOperation(blendMode);
+    SDL_BlendFactor dstColorFactor = SDL_GetBlendModeDstColorFactor(blendMode);
+    SDL_BlendFactor dstAlphaFactor = SDL_GetBlendModeDstAlphaFactor(blendMode);
+    SDL_BlendOperation alphaOperation = SDL_GetBlendModeAlphaOperation(blendMode);
+
+    if (GetBlendFunc(srcColorFactor) == VK_BLEND_FACTOR_MAX_ENUM ||
+        GetBlendFunc(srcAlphaFactor) == VK_BLEND_FACTOR_MAX_ENUM ||
+        GetBlendEquation(colorOperation) == VK_BLEND_OP_MAX_ENUM ||
+        GetBlendFunc(dstColorFactor) == VK_BLEND_FACTOR_MAX_ENUM ||
+        GetBlendFunc(dstAlphaFactor) == VK_BLEND_FACTOR_MAX_ENUM ||
+        GetBlendEquation(alphaOperation) == VK_BLEND_OP_MAX_ENUM) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static int VULKAN_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_TextureData *textureData;
+    VkImageCreateInfo imageInfo;
+    VkMemoryRequirements requirements;
+    VkFormat format = SDLPixelFormatToVkFormat(texture->format);
+    const SDL_bool opaque = SDL_ISPIXELFORMAT_ALPHA(texture->format) ? SDL_FALSE : SDL_TRUE;
+    VkResult result;
+
+    if (format == VK_FORMAT_UNDEFINED) {
+        return SDL_SetError("%s, An unsupported SDL pixel format (0x%x) was specified",
+                            __FUNCTION__, texture->format);
+    }
+
+    textureData = (VULKAN_TextureData *)SDL_calloc(1, sizeof(*textureData));
+    if (!textureData) {
+        return SDL_OutOfMemory();
+    }
+    textureData->scaleMode = texture->scaleMode;
+    textureData->image.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    textureData->image.format = format;
+    textureData->image.width = (Uint32)texture->w;
+    textureData->image.height = (Uint32)texture->h;
+    texture->driverdata = textureData;
+
+    SDL_zero(imageInfo);
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = format;
+    imageInfo.extent.width = textureData->image.width;
+    imageInfo.extent.height = textureData->image.height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+        imageInfo.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    result = data->vkCreateImage(data->device, &imageInfo, NULL, &textureData->image.image);
+    if (result != VK_SUCCESS) {
+        textureData->image.image = VK_NULL_HANDLE;
+        VULKAN_DestroyTexture(renderer, texture);
+        return VULKAN_SetError("vkCreateImage", result);
+    }
+
+    data->vkGetImageMemoryRequirements(data->device, textureData->image.image, &requirements);
+    if (VULKAN_AllocateMemory(data, &requirements, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &textureData->memory) < 0) {
+        textureData->memory = VK_NULL_HANDLE;
+        VULKAN_DestroyTexture(renderer, texture);
+        return -1;
+    }
+    result = data->vkBindImageMemory(data->device, textureData->image.image, textureData->memory, 0);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyTexture(renderer, texture);
+        return VULKAN_SetError("vkBindImageMemory", result);
+    }
+
+    /* Formats without alpha are sampled as opaque, whatever ends up in the alpha channel */
+    if (VULKAN_CreateImageView(data, textureData->image.image, format, opaque, &textureData->sampledView) < 0) {
+        VULKAN_DestroyTexture(renderer, texture);
+        return -1;
+    }
+
+    if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+        if (VULKAN_CreateImageView(data, textureData->image.image, format, SDL_FALSE, &textureData->image.view) < 0 ||
+            VULKAN_CreateFramebuffer(data, &textureData->image) < 0) {
+            VULKAN_DestroyTexture(renderer, texture);
+            return -1;
+        }
+    }
+
+    /* Make the texture usable for drawing before it's ever updated */
+    if (VULKAN_BeginFrame(data) < 0) {
+        VULKAN_DestroyTexture(renderer, texture);
+        return -1;
+    }
+    VULKAN_TransitionImage(data, &textureData->image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    return 0;
+}
+
+static void VULKAN_DestroyTexture(SDL_Renderer *renderer,
+                                  SDL_Texture *texture)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+    VULKAN_PendingDestroy resource;
+
+    if (!textureData) {
+        return;
+    }
+
+    SDL_zero(resource);
+    resource.framebuffer = textureData->image.framebuffer;
+    resource.views[0] = textureData->image.view;
+    resource.views[1] = textureData->sampledView;
+    resource.image = textureData->image.image;
+    resource.memory = textureData->memory;
+    VULKAN_DeferDestroy(data, &resource);
+
+    SDL_free(textureData->pixels);
+    SDL_free(textureData);
+    texture->driverdata = NULL;
+}
+
+/* Get space for upload data in the current frame, which must be recording */
+static int VULKAN_AllocateUploadSpace(VULKAN_RenderData *data, VkDeviceSize length,
+                                      VkBuffer *outBuffer, VkDeviceSize *outOffset, Uint8 **outData)
+{
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    const VkDeviceSize offset = (frame->uploadBufferOffset + 15) & ~(VkDeviceSize)15;
+
+    if (frame->uploadBuffer.buffer != VK_NULL_HANDLE && offset + length <= frame->uploadBuffer.size) {
+        *outBuffer = frame->uploadBuffer.buffer;
+        *outOffset = offset;
+        *outData = frame->uploadBuffer.mapped + offset;
+        frame->uploadBufferOffset = offset + length;
+    } else {
+        /* Too much to upload this frame, use a buffer just for this */
+        VULKAN_Buffer buffer;
+
+        if (VULKAN_CreateBuffer(data, length, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 0, &buffer) < 0) {
+            return -1;
+        }
+        *outBuffer = buffer.buffer;
+        *outOffset = 0;
+        *outData = buffer.mapped;
+        VULKAN_DeferDestroyBuffer(data, &buffer);
+    }
+    return 0;
+}
+
+static int VULKAN_UpdateTextureInternal(VULKAN_RenderData *data, VULKAN_TextureData *textureData,
+                                        int x, int y, int w, int h, const void *pixels, int pitch)
+{
+    const int bpp = 4;
+    const int length = w * bpp;
+    VkBufferImageCopy region;
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    const Uint8 *src = (const Uint8 *)pixels;
+    Uint8 *dst;
+    int row;
+
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+    if (VULKAN_AllocateUploadSpace(data, (VkDeviceSize)length * h, &buffer, &offset, &dst) < 0) {
+        return -1;
+    }
+
+    if (length == pitch) {
+        SDL_memcpy(dst, src, (size_t)length * h);
+    } else {
+        for (row = 0; row < h; ++row) {
+            SDL_memcpy(dst, src, length);
+            src += pitch;
+            dst += length;
+        }
+    }
+
+    SDL_zero(region);
+    region.bufferOffset = offset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset.x = x;
+    region.imageOffset.y = y;
+    region.imageExtent.width = (Uint32)w;
+    region.imageExtent.height = (Uint32)h;
+    region.imageExtent.depth = 1;
+
+    VULKAN_TransitionImage(data, &textureData->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    data->vkCmdCopyBufferToImage(data->frames[data->currentFrame].commandBuffer, buffer,
+                                 textureData->image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 1, &region);
+    VULKAN_TransitionImage(data, &textureData->image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    return 0;
+}
+
+static int VULKAN_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
+                                const SDL_Rect *rect, const void *srcPixels,
+                                int srcPitch)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+
+    if (!textureData) {
+        return SDL_SetError("Texture is not currently available");
+    }
+
+    return VULKAN_UpdateTextureInternal(data, textureData, rect->x, rect->y, rect->w, rect->h, srcPixels, srcPitch);
+}
+
+static int VULKAN_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
+                              const SDL_Rect *rect, void **pixels, int *pitch)
+{
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+
+    if (!textureData) {
+        return SDL_SetError("Texture is not currently available");
+    }
+
+    if (!textureData->pixels) {
+        textureData->pitch = texture->w * 4;
+        textureData->pixels = (Uint8 *)SDL_malloc((size_t)texture->h * textureData->pitch);
+        if (!textureData->pixels) {
+            return SDL_OutOfMemory();
+        }
+    }
+    textureData->lockedRect = *rect;
+    *pixels = textureData->pixels + rect->y * textureData->pitch + rect->x * 4;
+    *pitch = textureData->pitch;
+    return 0;
+}
+
+static void VULKAN_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+    const SDL_Rect *rect;
+
+    if (!textureData) {
+        return;
+    }
+
+    rect = &textureData->lockedRect;
+    VULKAN_UpdateTextureInternal(data, textureData, rect->x, rect->y, rect->w, rect->h,
+                                 textureData->pixels + rect->y * textureData->pitch + rect->x * 4,
+                                 textureData->pitch);
+}
+
+static void VULKAN_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
+{
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+
+    if (!textureData) {
+        return;
+    }
+
+    textureData->scaleMode = scaleMode;
+}
+
+static int VULKAN_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_TextureData *textureData = NULL;
+
+    if (texture) {
+        textureData = (VULKAN_TextureData *)texture->driverdata;
+        if (!textureData || textureData->image.framebuffer == VK_NULL_HANDLE) {
+            return SDL_SetError("specified texture is not a render target");
+        }
+    }
+
+    if (data->recording) {
+        VULKAN_EndRenderPass(data);
+        if (data->textureRenderTarget) {
+            VULKAN_TransitionImage(data, &data->textureRenderTarget->image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+    }
+
+    data->textureRenderTarget = textureData;
+    return 0;
+}
+
+static int VULKAN_QueueSetViewport(SDL_Renderer *renderer, SDL_RenderCommand *cmd)
+{
+    return 0; /* nothing to do in this backend. */
+}
+
+static int VULKAN_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FPoint *points, int count)
+{
+    VertexPositionColor *verts = (VertexPositionColor *)SDL_AllocateRenderVertices(renderer, count * sizeof(VertexPositionColor), 0, &cmd->data.draw.first);
+    int i;
+    SDL_Color color;
+    color.r = cmd->data.draw.r;
+    color.g = cmd->data.draw.g;
+    color.b = cmd->data.draw.b;
+    color.a = cmd->data.draw.a;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+
+    for (i = 0; i < count; i++) {
+        verts->pos.x = points[i].x + 0.5f;
+        verts->pos.y = points[i].y + 0.5f;
+        verts->tex.x = 0.0f;
+        verts->tex.y = 0.0f;
+        verts->color = color;
+        verts++;
+    }
+
+    return 0;
+}
+
+static int VULKAN_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture,
+                                const float *xy, int xy_stride, const SDL_Color *color, int color_stride, const float *uv, int uv_stride,
+                                int num_vertices, const void *indices, int num_indices, int size_indices,
+                                float scale_x, float scale_y)
+{
+    int i;
+    int count = indices ? num_indices : num_vertices;
+    VertexPositionColor *verts = (VertexPositionColor *)SDL_AllocateRenderVertices(renderer, count * sizeof(VertexPositionColor), 0, &cmd->data.draw.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+    size_indices = indices ? size_indices : 0;
+
+    for (i = 0; i < count; i++) {
+        int j;
+        float *xy_;
+        if (size_indices == 4) {
+            j = ((const Uint32 *)indices)[i];
+        } else if (size_indices == 2) {
+            j = ((const Uint16 *)indices)[i];
+        } else if (size_indices == 1) {
+            j = ((const Uint8 *)indices)[i];
+        } else {
+            j = i;
+        }
+
+        xy_ = (float *)((char *)xy + j * xy_stride);
+
+        verts->pos.x = xy_[0] * scale_x;
+        verts->pos.y = xy_[1] * scale_y;
+        verts->color = *(SDL_Color *)((char *)color + j * color_stride);
+
+        if (texture) {
+            float *uv_ = (float *)((char *)uv + j * uv_stride);
+            verts->tex.x = uv_[0];
+            verts->tex.y = uv_[1];
+        } else {
+            verts->tex.x = 0.0f;
+            verts->tex.y = 0.0f;
+        }
+
+        verts += 1;
+    }
+    return 0;
+}
+
+static int VULKAN_UpdateVertexBuffer(SDL_Renderer *renderer,
+                                     const void *vertexData, size_t dataSizeInBytes)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    VkDeviceSize offset = (frame->vertexBufferOffset + 15) & ~(VkDeviceSize)15;
+
+    if (dataSizeInBytes == 0) {
+        return 0;
+    }
+
+    if (offset + dataSizeInBytes > frame->vertexBuffer.size) {
+        VkDeviceSize size = SDL_max(frame->vertexBuffer.size * 2, SDL_VULKAN_VERTEX_BUFFER_SIZE);
+
+        while (size < dataSizeInBytes) {
+            size *= 2;
+        }
+
+        /* The old buffer may still be in use by this frame */
+        VULKAN_DeferDestroyBuffer(data, &frame->vertexBuffer);
+        if (VULKAN_CreateBuffer(data, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &frame->vertexBuffer) < 0) {
+            return -1;
+        }
+        offset = 0;
+    }
+
+    SDL_memcpy(frame->vertexBuffer.mapped + offset, vertexData, dataSizeInBytes);
+    frame->vertexBufferOffset = offset + dataSizeInBytes;
+
+    data->currentVertexBuffer = frame->vertexBuffer.buffer;
+    data->currentVertexBufferOffset = offset;
+    data->vertexBufferBound = SDL_FALSE;
+    return 0;
+}
+
+static void VULKAN_UpdateViewport(VULKAN_RenderData *data, VkCommandBuffer commandBuffer)
+{
+    const SDL_Rect *viewport = &data->currentViewport;
+    VertexShaderConstants constants;
+    VkViewport vkViewport;
+
+    vkViewport.x = (float)viewport->x;
+    vkViewport.y = (float)viewport->y;
+    vkViewport.width = (float)viewport->w;
+    vkViewport.height = (float)viewport->h;
+    vkViewport.minDepth = 0.0f;
+    vkViewport.maxDepth = 1.0f;
+    data->vkCmdSetViewport(commandBuffer, 0, 1, &vkViewport);
+
+    /* Map viewport pixels to normalized device coordinates, y is down in both */
+    constants.scale[0] = 2.0f / viewport->w;
+    constants.scale[1] = 2.0f / viewport->h;
+    constants.translation[0] = -1.0f;
+    constants.translation[1] = -1.0f;
+    data->vkCmdPushConstants(commandBuffer, data->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
+                             0, sizeof(constants), &constants);
+}
+
+static void VULKAN_UpdateScissor(VULKAN_RenderData *data, VkCommandBuffer commandBuffer, const VULKAN_Image *target)
+{
+    SDL_Rect rect, bounds;
+    VkRect2D scissor;
+
+    if (data->currentCliprectEnabled) {
+        rect.x = data->currentViewport.x + data->currentCliprect.x;
+        rect.y = data->currentViewport.y + data->currentCliprect.y;
+        rect.w = data->currentCliprect.w;
+        rect.h = data->currentCliprect.h;
+    } else {
+        rect = data->currentViewport;
+    }
+
+    /* Vulkan doesn't allow a scissor rectangle outside the render target */
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = (int)target->width;
+    bounds.h = (int)target->height;
+    if (!SDL_GetRectIntersection(&rect, &bounds, &rect)) {
+        SDL_zero(rect);
+    }
+
+    scissor.offset.x = rect.x;
+    scissor.offset.y = rect.y;
+    scissor.extent.width = (Uint32)rect.w;
+    scissor.extent.height = (Uint32)rect.h;
+    data->vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+static int VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, VULKAN_Shader shader,
+                               VkPrimitiveTopology topology, VkDescriptorSet descriptorSet)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    const SDL_BlendMode blendMode = cmd->data.draw.blend;
+    VkCommandBuffer commandBuffer;
+    VULKAN_Image *target = NULL;
+    int i;
+
+    if (data->currentViewport.w <= 0 || data->currentViewport.h <= 0) {
+        return SDL_SetError("Can't set a viewport with zero width or height");
+    }
+
+    if (VULKAN_BeginRenderPass(renderer, &target) < 0) {
+        return -1;
+    }
+    commandBuffer = data->frames[data->currentFrame].commandBuffer;
+
+    /* See if we need to change the pipeline state */
+    if (!data->currentPipelineState ||
+        data->currentPipelineState->shader != shader ||
+        data->currentPipelineState->blendMode != blendMode ||
+        data->currentPipelineState->topology != topology ||
+        data->currentPipelineState->format != target->format) {
+
+        data->currentPipelineState = NULL;
+        for (i = 0; i < data->pipelineStateCount; ++i) {
+            VULKAN_PipelineState *candidatePipelineState = &data->pipelineStates[i];
+            if (candidatePipelineState->shader == shader &&
+                candidatePipelineState->blendMode == blendMode &&
+                candidatePipelineState->topology == topology &&
+                candidatePipelineState->format == target->format) {
+                data->currentPipelineState = candidatePipelineState;
+                break;
+            }
+        }
+
+        /* If we didn't find a match, create a new one -- it must mean the blend mode is non-standard */
+        if (!data->currentPipelineState) {
+            data->currentPipelineState = VULKAN_CreatePipelineState(renderer, shader, blendMode, topology, target->format);
+        }
+
+        if (!data->currentPipelineState) {
+            return -1;
+        }
+
+        data->vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, data->currentPipelineState->pipeline);
+    }
+
+    if (data->viewportDirty) {
+        VULKAN_UpdateViewport(data, commandBuffer);
+        data->viewportDirty = SDL_FALSE;
+        data->cliprectDirty = SDL_TRUE; /* the scissor rectangle is relative to the viewport */
+    }
+
+    if (data->cliprectDirty) {
+        VULKAN_UpdateScissor(data, commandBuffer, target);
+        data->cliprectDirty = SDL_FALSE;
+    }
+
+    if (descriptorSet != VK_NULL_HANDLE && descriptorSet != data->currentDescriptorSet) {
+        data->vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, data->pipelineLayout,
+                                      0, 1, &descriptorSet, 0, NULL);
+        data->currentDescriptorSet = descriptorSet;
+    }
+
+    if (!data->vertexBufferBound) {
+        data->vkCmdBindVertexBuffers(commandBuffer, 0, 1, &data->currentVertexBuffer, &data->currentVertexBufferOffset);
+        data->vertexBufferBound = SDL_TRUE;
+    }
+
+    return 0;
+}
+
+static VkDescriptorSet VULKAN_AllocateDescriptorSet(VULKAN_RenderData *data, VULKAN_FrameData *frame)
+{
+    VkDescriptorSetAllocateInfo allocateInfo;
+    VkDescriptorSet descriptorSet;
+    VkResult result;
+
+    if (frame->currentDescriptorPoolUsed == SDL_VULKAN_DESCRIPTOR_POOL_SIZE) {
+        ++frame->currentDescriptorPool;
+        frame->currentDescriptorPoolUsed = 0;
+    }
+
+    if (frame->currentDescriptorPool == frame->descriptorPoolCount) {
+        VkDescriptorPoolSize poolSize;
+        VkDescriptorPoolCreateInfo poolInfo;
+        VkDescriptorPool *descriptorPools;
+
+        descriptorPools = (VkDescriptorPool *)SDL_realloc(frame->descriptorPools, (frame->descriptorPoolCount + 1) * sizeof(*descriptorPools));
+        if (!descriptorPools) {
+            SDL_OutOfMemory();
+            return VK_NULL_HANDLE;
+        }
+        frame->descriptorPools = descriptorPools;
+
+        poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSize.descriptorCount = SDL_VULKAN_DESCRIPTOR_POOL_SIZE;
+
+        SDL_zero(poolInfo);
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = SDL_VULKAN_DESCRIPTOR_POOL_SIZE;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        result = data->vkCreateDescriptorPool(data->device, &poolInfo, NULL, &descriptorPools[frame->descriptorPoolCount]);
+        if (result != VK_SUCCESS) {
+            VULKAN_SetError("vkCreateDescriptorPool", result);
+            return VK_NULL_HANDLE;
+        }
+        ++frame->descriptorPoolCount;
+    }
+
+    SDL_zero(allocateInfo);
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = frame->descriptorPools[frame->currentDescriptorPool];
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &data->descriptorSetLayout;
+    result = data->vkAllocateDescriptorSets(data->device, &allocateInfo, &descriptorSet);
+    if (result != VK_SUCCESS) {
+        VULKAN_SetError("vkAllocateDescriptorSets", result);
+        return VK_NULL_HANDLE;
+    }
+    ++frame->currentDescriptorPoolUsed;
+    return descriptorSet;
+}
+
+/* Descriptor sets are written once and reused for the rest of the frame */
+static VkDescriptorSet VULKAN_GetDescriptorSet(VULKAN_RenderData *data, VkImageView view, VkSampler sampler)
+{
+    VULKAN_FrameData *frame = &data->frames[data->currentFrame];
+    const Uint64 hash = ((Uint64)(uintptr_t)view * 31) ^ (Uint64)(uintptr_t)sampler;
+    VULKAN_DescriptorCacheEntry *entry = &frame->descriptorCache[(hash >> 4) & (SDL_VULKAN_DESCRIPTOR_CACHE_SIZE - 1)];
+    VkDescriptorImageInfo imageInfo;
+    VkWriteDescriptorSet write;
+    VkDescriptorSet descriptorSet;
+
+    if (entry->descriptorSet != VK_NULL_HANDLE && entry->view == view && entry->sampler == sampler) {
+        return entry->descriptorSet;
+    }
+
+    descriptorSet = VULKAN_AllocateDescriptorSet(data, frame);
+    if (descriptorSet == VK_NULL_HANDLE) {
+        return VK_NULL_HANDLE;
+    }
+
+    imageInfo.sampler = sampler;
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    SDL_zero(write);
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    data->vkUpdateDescriptorSets(data->device, 1, &write, 0, NULL);
+
+    entry->view = view;
+    entry->sampler = sampler;
+    entry->descriptorSet = descriptorSet;
+    return descriptorSet;
+}
+
+static int VULKAN_SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    SDL_Texture *texture = cmd->data.draw.texture;
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->driverdata;
+    VULKAN_Shader shader = SHADER_RGB;
+    VkSampler sampler;
+    VkDescriptorSet descriptorSet;
+
+    if (!textureData) {
+        return SDL_SetError("Texture is not currently available");
+    }
+
+    switch (textureData->scaleMode) {
+    case SDL_SCALEMODE_NEAREST:
+        sampler = data->samplers[SAMPLER_NEAREST];
+        break;
+    case SDL_SCALEMODE_LINEAR:
+    case SDL_SCALEMODE_BEST:
+    case SDL_SCALEMODE_AREA:
+    case SDL_SCALEMODE_LANCZOS:
+        sampler = data->samplers[SAMPLER_LINEAR];
+        break;
+    default:
+        return SDL_SetError("Unknown scale mode: %d\n", textureData->scaleMode);
+    }
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+
+    /* This has to happen before the render pass starts */
+    VULKAN_TransitionImage(data, &textureData->image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    descriptorSet = VULKAN_GetDescriptorSet(data, textureData->sampledView, sampler);
+    if (descriptorSet == VK_NULL_HANDLE) {
+        return -1;
+    }
+
+    if (texture->distance_field == SDL_DISTANCEFIELD_SDF) {
+        shader = SHADER_SDF;
+    } else if (texture->distance_field == SDL_DISTANCEFIELD_MSDF) {
+        shader = SHADER_MSDF;
+    }
+
+    return VULKAN_SetDrawState(renderer, cmd, shader, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, descriptorSet);
+}
+
+static void VULKAN_DrawPrimitives(SDL_Renderer *renderer, const size_t vertexStart, const size_t vertexCount)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+
+    data->vkCmdDraw(data->frames[data->currentFrame].commandBuffer, (Uint32)vertexCount, 1, (Uint32)vertexStart, 0);
+}
+
+static int VULKAN_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+
+    if (VULKAN_UpdateVertexBuffer(renderer, vertices, vertsize) < 0) {
+        return -1;
+    }
+
+    while (cmd) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        {
+            break; /* this isn't currently used in this render backend. */
+        }
+
+        case SDL_RENDERCMD_SETVIEWPORT:
+        {
+            SDL_Rect *viewport = &data->currentViewport;
+            if (SDL_memcmp(viewport, &cmd->data.viewport.rect, sizeof(cmd->data.viewport.rect)) != 0) {
+                SDL_copyp(viewport, &cmd->data.viewport.rect);
+                data->viewportDirty = SDL_TRUE;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_SETCLIPRECT:
+        {
+            const SDL_Rect *rect = &cmd->data.cliprect.rect;
+            if (data->currentCliprectEnabled != cmd->data.cliprect.enabled) {
+                data->currentCliprectEnabled = cmd->data.cliprect.enabled;
+                data->cliprectDirty = SDL_TRUE;
+            }
+            if (SDL_memcmp(&data->currentCliprect, rect, sizeof(*rect)) != 0) {
+                SDL_copyp(&data->currentCliprect, rect);
+                data->cliprectDirty = SDL_TRUE;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_CLEAR:
+        {
+            VULKAN_Image *target = NULL;
+
+            if (VULKAN_BeginRenderPass(renderer, &target) == 0) {
+                VkClearAttachment attachment;
+                VkClearRect rect;
+
+                attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                attachment.colorAttachment = 0;
+                attachment.clearValue.color.float32[0] = cmd->data.color.r / 255.0f;
+                attachment.clearValue.color.float32[1] = cmd->data.color.g / 255.0f;
+                attachment.clearValue.color.float32[2] = cmd->data.color.b / 255.0f;
+                attachment.clearValue.color.float32[3] = cmd->data.color.a / 255.0f;
+
+                rect.rect.offset.x = 0;
+                rect.rect.offset.y = 0;
+                rect.rect.extent.width = target->width;
+                rect.rect.extent.height = target->height;
+                rect.baseArrayLayer = 0;
+                rect.layerCount = 1;
+
+                data->vkCmdClearAttachments(data->frames[data->currentFrame].commandBuffer, 1, &attachment, 1, &rect);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        {
+            const size_t count = cmd->data.draw.count;
+            const size_t first = cmd->data.draw.first;
+            const size_t start = first / sizeof(VertexPositionColor);
+            if (VULKAN_SetDrawState(renderer, cmd, SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_POINT_LIST, VK_NULL_HANDLE) == 0) {
+                VULKAN_DrawPrimitives(renderer, start, count);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_LINES:
+        {
+            const size_t count = cmd->data.draw.count;
+            const size_t first = cmd->data.draw.first;
+            const size_t start = first / sizeof(VertexPositionColor);
+            const VertexPositionColor *verts = (VertexPositionColor *)(((Uint8 *)vertices) + first);
+            if (VULKAN_SetDrawState(renderer, cmd, SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_LINE_STRIP, VK_NULL_HANDLE) == 0) {
+                VULKAN_DrawPrimitives(renderer, start, count);
+            }
+            if (verts[0].pos.x != verts[count - 1].pos.x || verts[0].pos.y != verts[count - 1].pos.y) {
+                if (VULKAN_SetDrawState(renderer, cmd, SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_POINT_LIST, VK_NULL_HANDLE) == 0) {
+                    VULKAN_DrawPrimitives(renderer, start + (count - 1), 1);
+                }
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: /* unused */
+            break;
+
+        case SDL_RENDERCMD_COPY: /* unused */
+            break;
+
+        case SDL_RENDERCMD_COPY_EX: /* unused */
+            break;
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            SDL_Texture *texture = cmd->data.draw.texture;
+            const size_t count = cmd->data.draw.count;
+            const size_t first = cmd->data.draw.first;
+            const size_t start = first / sizeof(VertexPositionColor);
+            int status;
+
+            if (texture) {
+                status = VULKAN_SetCopyState(renderer, cmd);
+            } else {
+                status = VULKAN_SetDrawState(renderer, cmd, SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_NULL_HANDLE);
+            }
+
+            if (status == 0) {
+                VULKAN_DrawPrimitives(renderer, start, count);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_INSTANCES: /* unused */
+            break;
+
+        case SDL_RENDERCMD_NO_OP:
+            break;
+        }
+
+        cmd = cmd->next;
+    }
+
+    return 0;
+}
+
+static int VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
+                                   Uint32 format, void *pixels, int pitch)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VULKAN_Image *target;
+    VULKAN_Buffer readbackBuffer;
+    VkBufferImageCopy region;
+    VkMemoryBarrier barrier;
+    VkCommandBuffer commandBuffer;
+    Uint32 srcFormat;
+    int status;
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+
+    target = VULKAN_GetCurrentRenderTarget(renderer);
+    if (!target) {
+        return SDL_SetError("Couldn't get the current render target");
+    }
+    if (!data->textureRenderTarget && !data->swapchainSupportsReadback) {
+        return SDL_SetError("Reading pixels from the window isn't supported by this Vulkan device");
+    }
+    srcFormat = VkFormatToSDLPixelFormat(target->format);
+    if (srcFormat == SDL_PIXELFORMAT_UNKNOWN) {
+        return SDL_SetError("Unsupported render target format");
+    }
+
+    if (VULKAN_CreateBuffer(data, (VkDeviceSize)rect->w * rect->h * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            VK_MEMORY_PROPERTY_HOST_CACHED_BIT, &readbackBuffer) < 0) {
+        return -1;
+    }
+
+    VULKAN_TransitionImage(data, target, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+    SDL_zero(region);
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset.x = rect->x;
+    region.imageOffset.y = rect->y;
+    region.imageExtent.width = (Uint32)rect->w;
+    region.imageExtent.height = (Uint32)rect->h;
+    region.imageExtent.depth = 1;
+    commandBuffer = data->frames[data->currentFrame].commandBuffer;
+    data->vkCmdCopyImageToBuffer(commandBuffer, target->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                 readbackBuffer.buffer, 1, &region);
+
+    /* Make the copy visible to the CPU */
+    SDL_zero(barrier);
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    data->vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                               1, &barrier, 0, NULL, 0, NULL);
+
+    VULKAN_TransitionImage(data, target, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    /* Wait for the copy to finish */
+    if (VULKAN_IssueBatch(data) < 0) {
+        VULKAN_DeferDestroyBuffer(data, &readbackBuffer);
+        return -1;
+    }
+
+    status = SDL_ConvertPixels(rect->w, rect->h,
+                               srcFormat, readbackBuffer.mapped, rect->w * 4,
+                               format, pixels, pitch);
+
+    VULKAN_DestroyBuffer(data, &readbackBuffer);
+
+    return status;
+}
+
+static int VULKAN_RenderPresent(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+    VkSemaphore renderFinished = VK_NULL_HANDLE;
+    VkPresentInfoKHR presentInfo;
+    VkResult result;
+    int status = 0;
+
+    if (VULKAN_BeginFrame(data) < 0) {
+        return -1;
+    }
+
+    if (!data->swapchainImageAcquired) {
+        /* Nothing was drawn to the window this frame, there may be nothing to present to */
+        VULKAN_AcquireNextImage(renderer);
+    }
+    if (data->swapchainImageAcquired) {
+        VULKAN_TransitionImage(data, &data->swapchainImages[data->currentSwapchainImage], VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        renderFinished = data->renderFinished[data->currentSwapchainImage];
+    }
+
+    if (VULKAN_Submit(data, renderFinished) < 0) {
+        status = -1;
+    } else if (data->swapchainImageAcquired) {
+        SDL_zero(presentInfo);
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &renderFinished;
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &data->swapchain;
+        presentInfo.pImageIndices = &data->currentSwapchainImage;
+        result = data->vkQueuePresentKHR(data->queue, &presentInfo);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+            data->recreateSwapchain = SDL_TRUE;
+        } else if (result != VK_SUCCESS) {
+            status = VULKAN_SetError("vkQueuePresentKHR", result);
+        }
+    }
+    data->swapchainImageAcquired = SDL_FALSE;
+
+    /* Start recording the next frame while this one is in flight */
+    data->currentFrame = (data->currentFrame + 1) % SDL_VULKAN_FRAMES_IN_FLIGHT;
+
+    return status;
+}
+
+static int VULKAN_SetVSync(SDL_Renderer *renderer, const int vsync)
+{
+    VULKAN_RenderData *data = (VULKAN_RenderData *)renderer->driverdata;
+
+    if (vsync) {
+        renderer->info.flags |= SDL_RENDERER_PRESENTVSYNC;
+    } else {
+        renderer->info.flags &= ~SDL_RENDERER_PRESENTVSYNC;
+    }
+    if (data->vsync != (vsync ? SDL_TRUE : SDL_FALSE)) {
+        data->vsync = vsync ? SDL_TRUE : SDL_FALSE;
+        data->recreateSwapchain = SDL_TRUE;
+    }
+    return 0;
+}
+
+static SDL_Renderer *VULKAN_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_props)
+{
+    SDL_Renderer *renderer;
+    VULKAN_RenderData *data;
+    Uint32 window_flags;
+    SDL_bool changed_window = SDL_FALSE;
+    const char *pipeline_cache;
+
+    window_flags = SDL_GetWindowFlags(window);
+    if (!(window_flags & SDL_WINDOW_VULKAN)) {
+        changed_window = SDL_TRUE;
+        if (SDL_RecreateWindow(window, (window_flags & ~(SDL_WINDOW_OPENGL | SDL_WINDOW_METAL)) | SDL_WINDOW_VULKAN) < 0) {
+            goto error;
+        }
+    }
+
+    renderer = (SDL_Renderer *)SDL_calloc(1, sizeof(*renderer));
+    if (!renderer) {
+        SDL_OutOfMemory();
+        goto error;
+    }
+    renderer->magic = &SDL_renderer_magic;
+
+    data = (VULKAN_RenderData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        SDL_free(renderer);
+        SDL_OutOfMemory();
+        goto error;
+    }
+
+    pipeline_cache = SDL_GetStringProperty(create_props, "pipeline_cache", NULL);
+    if (pipeline_cache && *pipeline_cache) {
+        data->pipelineCachePath = SDL_strdup(pipeline_cache);
+    }
+
+    renderer->WindowEvent = VULKAN_WindowEvent;
+    renderer->SupportsBlendMode = VULKAN_SupportsBlendMode;
+    renderer->CreateTexture = VULKAN_CreateTexture;
+    renderer->UpdateTexture = VULKAN_UpdateTexture;
+    renderer->LockTexture = VULKAN_LockTexture;
+    renderer->UnlockTexture = VULKAN_UnlockTexture;
+    renderer->SetTextureScaleMode = VULKAN_SetTextureScaleMode;
+    renderer->SetRenderTarget = VULKAN_SetRenderTarget;
+    renderer->QueueSetViewport = VULKAN_QueueSetViewport;
+    renderer->QueueSetDrawColor = VULKAN_QueueSetViewport; /* SetViewport and SetDrawColor are (currently) no-ops. */
+    renderer->QueueDrawPoints = VULKAN_QueueDrawPoints;
+    renderer->QueueDrawLines = VULKAN_QueueDrawPoints; /* lines and points queue vertices the same way. */
+    renderer->QueueGeometry = VULKAN_QueueGeometry;
+    renderer->RunCommandQueue = VULKAN_RunCommandQueue;
+    renderer->RenderReadPixels = VULKAN_RenderReadPixels;
+    renderer->RenderPresent = VULKAN_RenderPresent;
+    renderer->DestroyTexture = VULKAN_DestroyTexture;
+    renderer->DestroyRenderer = VULKAN_DestroyRenderer;
+    renderer->info = VULKAN_RenderDriver.info;
+    renderer->info.flags = SDL_RENDERER_ACCELERATED;
+    renderer->driverdata = data;
+    renderer->supports_distance_fields = SDL_TRUE;
+
+    if (SDL_GetBooleanProperty(create_props, "present_vsync", SDL_FALSE)) {
+        renderer->info.flags |= SDL_RENDERER_PRESENTVSYNC;
+        data->vsync = SDL_TRUE;
+    }
+    renderer->SetVSync = VULKAN_SetVSync;
+
+    /* HACK: make sure the SDL_Renderer references the SDL_Window data now, in
+     * order to give init functions access to the underlying window handle:
+     */
+    renderer->window = window;
+
+    /* Initialize Vulkan resources */
+    if (VULKAN_CreateDeviceResources(renderer) < 0) {
+        VULKAN_DestroyRenderer(renderer);
+        goto error;
+    }
+
+    return renderer;
+
+error:
+    if (changed_window) {
+        /* Uh oh, better try to put it back... */
+        SDL_RecreateWindow(window, window_flags);
+    }
+    return NULL;
+}
+
+SDL_RenderDriver VULKAN_RenderDriver = {
+    VULKAN_CreateRenderer,
+    {
+        "vulkan",
+        (SDL_RENDERER_ACCELERATED |
+         SDL_RENDERER_PRESENTVSYNC), /* flags.  see SDL_RendererFlags */
+        4,                           /* num_texture_formats */
+        {                            /* texture_formats */
+          SDL_PIXELFORMAT_ARGB8888,
+          SDL_PIXELFORMAT_XRGB8888,
+          SDL_PIXELFORMAT_ABGR8888,
+          SDL_PIXELFORMAT_XBGR8888 },
+        16384, /* max_texture_width */
+        16384  /* max_texture_height */
+    }
+};
+
+#endif /* SDL_VIDEO_RENDER_VULKAN && !SDL_RENDER_DISABLED */
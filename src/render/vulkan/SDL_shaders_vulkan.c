@@ -0,0 +1,294 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#if defined(SDL_VIDEO_RENDER_VULKAN) && !defined(SDL_RENDER_DISABLED)
+
+#include "SDL_shaders_vulkan.h"
+
+/* Vulkan shaders
+
+   SDL's shaders are compiled into SDL itself, to simplify distribution.
+
+   The shaders are stored as SPIR-V 1.0 words.  They correspond to the GLSL
+   listed above each array, and can be regenerated with any SPIR-V
+   compiler, e.g.:
+
+     glslangValidator -V --vn <ARRAY NAME> -o <OUTPUT FILE> <INPUT FILE>
+
+   Vertex positions are in render target pixels relative to the viewport.
+   The vertex shader maps them to normalized device coordinates with a
+   scale and translation that are passed in as push constants.
+  */
+
+/* The vertex shader, shared by all pixel shaders:
+
+   --- VULKAN_VertexShader.vert ---
+   #version 450
+
+   layout(location = 0) in vec2 inPos;
+   layout(location = 1) in vec2 inTex;
+   layout(location = 2) in vec4 inColor;
+
+   layout(location = 0) out vec2 outTex;
+   layout(location = 1) out vec4 outColor;
+
+   layout(push_constant) uniform Constants
+   {
+       vec2 scale;
+       vec2 translation;
+   } constants;
+
+   void main()
+   {
+       gl_Position = vec4(inPos * constants.scale + constants.translation, 0.0, 1.0);
+       gl_PointSize = 1.0;
+       outTex = inTex;
+       outColor = inColor;
+   }
+*/
+static const Uint32 VULKAN_VertexShader[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000002c, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x000b000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00000004, 0x00000005, 0x00000006, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047, 0x00000004, 0x0000001e,
+    0x00000002, 0x00040047, 0x00000005, 0x0000001e, 0x00000000, 0x00040047, 0x00000006, 0x0000001e,
+    0x00000001, 0x00050048, 0x00000008, 0x00000000, 0x0000000b, 0x00000000, 0x00050048, 0x00000008,
+    0x00000001, 0x0000000b, 0x00000001, 0x00030047, 0x00000008, 0x00000002, 0x00050048, 0x00000009,
+    0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000009, 0x00000001, 0x00000023, 0x00000008,
+    0x00030047, 0x00000009, 0x00000002, 0x00020013, 0x0000000a, 0x00030021, 0x0000000b, 0x0000000a,
+    0x00030016, 0x0000000c, 0x00000020, 0x00040017, 0x0000000d, 0x0000000c, 0x00000002, 0x00040017,
+    0x0000000e, 0x0000000c, 0x00000004, 0x00040015, 0x0000000f, 0x00000020, 0x00000001, 0x0004001e,
+    0x00000008, 0x0000000e, 0x0000000c, 0x00040020, 0x00000010, 0x00000003, 0x00000008, 0x0004003b,
+    0x00000010, 0x00000007, 0x00000003, 0x00040020, 0x00000011, 0x00000001, 0x0000000d, 0x00040020,
+    0x00000012, 0x00000001, 0x0000000e, 0x00040020, 0x00000013, 0x00000003, 0x0000000d, 0x00040020,
+    0x00000014, 0x00000003, 0x0000000e, 0x00040020, 0x00000015, 0x00000003, 0x0000000c, 0x0004001e,
+    0x00000009, 0x0000000d, 0x0000000d, 0x00040020, 0x00000016, 0x00000009, 0x00000009, 0x0004003b,
+    0x00000016, 0x00000017, 0x00000009, 0x00040020, 0x00000018, 0x00000009, 0x0000000d, 0x0004002b,
+    0x0000000f, 0x00000019, 0x00000000, 0x0004002b, 0x0000000f, 0x0000001a, 0x00000001, 0x0004002b,
+    0x0000000c, 0x0000001b, 0x00000000, 0x0004002b, 0x0000000c, 0x0000001c, 0x3f800000, 0x0004003b,
+    0x00000011, 0x00000002, 0x00000001, 0x0004003b, 0x00000011, 0x00000003, 0x00000001, 0x0004003b,
+    0x00000012, 0x00000004, 0x00000001, 0x0004003b, 0x00000013, 0x00000005, 0x00000003, 0x0004003b,
+    0x00000014, 0x00000006, 0x00000003, 0x00050036, 0x0000000a, 0x00000001, 0x00000000, 0x0000000b,
+    0x000200f8, 0x0000001d, 0x0004003d, 0x0000000d, 0x0000001e, 0x00000002, 0x00050041, 0x00000018,
+    0x0000001f, 0x00000017, 0x00000019, 0x0004003d, 0x0000000d, 0x00000020, 0x0000001f, 0x00050041,
+    0x00000018, 0x00000021, 0x00000017, 0x0000001a, 0x0004003d, 0x0000000d, 0x00000022, 0x00000021,
+    0x00050085, 0x0000000d, 0x00000023, 0x0000001e, 0x00000020, 0x00050081, 0x0000000d, 0x00000024,
+    0x00000023, 0x00000022, 0x00050051, 0x0000000c, 0x00000025, 0x00000024, 0x00000000, 0x00050051,
+    0x0000000c, 0x00000026, 0x00000024, 0x00000001, 0x00070050, 0x0000000e, 0x00000027, 0x00000025,
+    0x00000026, 0x0000001b, 0x0000001c, 0x00050041, 0x00000014, 0x00000028, 0x00000007, 0x00000019,
+    0x0003003e, 0x00000028, 0x00000027, 0x00050041, 0x00000015, 0x00000029, 0x00000007, 0x0000001a,
+    0x0003003e, 0x00000029, 0x0000001c, 0x0004003d, 0x0000000d, 0x0000002a, 0x00000003, 0x0003003e,
+    0x00000005, 0x0000002a, 0x0004003d, 0x0000000e, 0x0000002b, 0x00000004, 0x0003003e, 0x00000006,
+    0x0000002b, 0x000100fd, 0x00010038,
+};
+
+/* The color-only-rendering pixel shader:
+
+   --- VULKAN_PixelShader_Colors.frag ---
+   #version 450
+
+   layout(location = 1) in vec4 inColor;
+
+   layout(location = 0) out vec4 outColor;
+
+   void main()
+   {
+       outColor = inColor;
+   }
+*/
+static const Uint32 VULKAN_PixelShader_Colors[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000000c, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0007000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000001e, 0x00000001,
+    0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00020013, 0x00000004, 0x00030021, 0x00000005,
+    0x00000004, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004,
+    0x00040020, 0x00000008, 0x00000001, 0x00000007, 0x00040020, 0x00000009, 0x00000003, 0x00000007,
+    0x0004003b, 0x00000008, 0x00000002, 0x00000001, 0x0004003b, 0x00000009, 0x00000003, 0x00000003,
+    0x00050036, 0x00000004, 0x00000001, 0x00000000, 0x00000005, 0x000200f8, 0x0000000a, 0x0004003d,
+    0x00000007, 0x0000000b, 0x00000002, 0x0003003e, 0x00000003, 0x0000000b, 0x000100fd, 0x00010038,
+};
+
+/* The texture-rendering pixel shader:
+
+   --- VULKAN_PixelShader_Textures.frag ---
+   #version 450
+
+   layout(set = 0, binding = 0) uniform sampler2D texture0;
+
+   layout(location = 0) in vec2 inTex;
+   layout(location = 1) in vec4 inColor;
+
+   layout(location = 0) out vec4 outColor;
+
+   void main()
+   {
+       outColor = texture(texture0, inTex) * inColor;
+   }
+*/
+static const Uint32 VULKAN_PixelShader_Textures[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000017, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0008000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00000004, 0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047, 0x00000004, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000005, 0x00000022, 0x00000000, 0x00040047, 0x00000005, 0x00000021,
+    0x00000000, 0x00020013, 0x00000006, 0x00030021, 0x00000007, 0x00000006, 0x00030016, 0x00000008,
+    0x00000020, 0x00040017, 0x00000009, 0x00000008, 0x00000002, 0x00040017, 0x0000000a, 0x00000008,
+    0x00000004, 0x00090019, 0x0000000b, 0x00000008, 0x00000001, 0x00000000, 0x00000000, 0x00000000,
+    0x00000001, 0x00000000, 0x0003001b, 0x0000000c, 0x0000000b, 0x00040020, 0x0000000d, 0x00000000,
+    0x0000000c, 0x0004003b, 0x0000000d, 0x00000005, 0x00000000, 0x00040020, 0x0000000e, 0x00000001,
+    0x00000009, 0x00040020, 0x0000000f, 0x00000001, 0x0000000a, 0x00040020, 0x00000010, 0x00000003,
+    0x0000000a, 0x0004003b, 0x0000000e, 0x00000002, 0x00000001, 0x0004003b, 0x0000000f, 0x00000003,
+    0x00000001, 0x0004003b, 0x00000010, 0x00000004, 0x00000003, 0x00050036, 0x00000006, 0x00000001,
+    0x00000000, 0x00000007, 0x000200f8, 0x00000011, 0x0004003d, 0x0000000c, 0x00000012, 0x00000005,
+    0x0004003d, 0x00000009, 0x00000013, 0x00000002, 0x00050057, 0x0000000a, 0x00000014, 0x00000012,
+    0x00000013, 0x0004003d, 0x0000000a, 0x00000015, 0x00000003, 0x00050085, 0x0000000a, 0x00000016,
+    0x00000014, 0x00000015, 0x0003003e, 0x00000004, 0x00000016, 0x000100fd, 0x00010038,
+};
+
+/* The signed distance field pixel shader, the distance is in the alpha channel:
+
+   --- VULKAN_PixelShader_SDF.frag ---
+   #version 450
+
+   layout(set = 0, binding = 0) uniform sampler2D texture0;
+
+   layout(location = 0) in vec2 inTex;
+   layout(location = 1) in vec4 inColor;
+
+   layout(location = 0) out vec4 outColor;
+
+   void main()
+   {
+       float dist = texture(texture0, inTex).a;
+       float width = fwidth(dist);
+       float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+       outColor = vec4(1.0, 1.0, 1.0, alpha) * inColor;
+   }
+*/
+static const Uint32 VULKAN_PixelShader_SDF[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000020, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00000005,
+    0x00030010, 0x00000002, 0x00000007, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000001, 0x00040047, 0x00000005, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000006, 0x00000022, 0x00000000, 0x00040047, 0x00000006, 0x00000021, 0x00000000, 0x00020013,
+    0x00000007, 0x00030021, 0x00000008, 0x00000007, 0x00030016, 0x00000009, 0x00000020, 0x00040017,
+    0x0000000a, 0x00000009, 0x00000002, 0x00040017, 0x0000000b, 0x00000009, 0x00000004, 0x00090019,
+    0x0000000c, 0x00000009, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+    0x0003001b, 0x0000000d, 0x0000000c, 0x00040020, 0x0000000e, 0x00000000, 0x0000000d, 0x0004003b,
+    0x0000000e, 0x00000006, 0x00000000, 0x00040020, 0x0000000f, 0x00000001, 0x0000000a, 0x00040020,
+    0x00000010, 0x00000001, 0x0000000b, 0x00040020, 0x00000011, 0x00000003, 0x0000000b, 0x0004002b,
+    0x00000009, 0x00000012, 0x3f000000, 0x0004002b, 0x00000009, 0x00000013, 0x3f800000, 0x0004003b,
+    0x0000000f, 0x00000003, 0x00000001, 0x0004003b, 0x00000010, 0x00000004, 0x00000001, 0x0004003b,
+    0x00000011, 0x00000005, 0x00000003, 0x00050036, 0x00000007, 0x00000002, 0x00000000, 0x00000008,
+    0x000200f8, 0x00000014, 0x0004003d, 0x0000000d, 0x00000015, 0x00000006, 0x0004003d, 0x0000000a,
+    0x00000016, 0x00000003, 0x00050057, 0x0000000b, 0x00000017, 0x00000015, 0x00000016, 0x00050051,
+    0x00000009, 0x00000018, 0x00000017, 0x00000003, 0x000400d1, 0x00000009, 0x00000019, 0x00000018,
+    0x00050083, 0x00000009, 0x0000001a, 0x00000012, 0x00000019, 0x00050081, 0x00000009, 0x0000001b,
+    0x00000012, 0x00000019, 0x0008000c, 0x00000009, 0x0000001c, 0x00000001, 0x00000031, 0x0000001a,
+    0x0000001b, 0x00000018, 0x00070050, 0x0000000b, 0x0000001d, 0x00000013, 0x00000013, 0x00000013,
+    0x0000001c, 0x0004003d, 0x0000000b, 0x0000001e, 0x00000004, 0x00050085, 0x0000000b, 0x0000001f,
+    0x0000001d, 0x0000001e, 0x0003003e, 0x00000005, 0x0000001f, 0x000100fd, 0x00010038,
+};
+
+/* The multi-channel signed distance field pixel shader, the distance is the median of red, green and blue:
+
+   --- VULKAN_PixelShader_MSDF.frag ---
+   #version 450
+
+   layout(set = 0, binding = 0) uniform sampler2D texture0;
+
+   layout(location = 0) in vec2 inTex;
+   layout(location = 1) in vec4 inColor;
+
+   layout(location = 0) out vec4 outColor;
+
+   void main()
+   {
+       vec4 sample = texture(texture0, inTex);
+       float dist = max(min(sample.r, sample.g), min(max(sample.r, sample.g), sample.b));
+       float width = fwidth(dist);
+       float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+       outColor = vec4(1.0, 1.0, 1.0, alpha) * inColor;
+   }
+*/
+static const Uint32 VULKAN_PixelShader_MSDF[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000026, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00000005,
+    0x00030010, 0x00000002, 0x00000007, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000001, 0x00040047, 0x00000005, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000006, 0x00000022, 0x00000000, 0x00040047, 0x00000006, 0x00000021, 0x00000000, 0x00020013,
+    0x00000007, 0x00030021, 0x00000008, 0x00000007, 0x00030016, 0x00000009, 0x00000020, 0x00040017,
+    0x0000000a, 0x00000009, 0x00000002, 0x00040017, 0x0000000b, 0x00000009, 0x00000004, 0x00090019,
+    0x0000000c, 0x00000009, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+    0x0003001b, 0x0000000d, 0x0000000c, 0x00040020, 0x0000000e, 0x00000000, 0x0000000d, 0x0004003b,
+    0x0000000e, 0x00000006, 0x00000000, 0x00040020, 0x0000000f, 0x00000001, 0x0000000a, 0x00040020,
+    0x00000010, 0x00000001, 0x0000000b, 0x00040020, 0x00000011, 0x00000003, 0x0000000b, 0x0004002b,
+    0x00000009, 0x00000012, 0x3f000000, 0x0004002b, 0x00000009, 0x00000013, 0x3f800000, 0x0004003b,
+    0x0000000f, 0x00000003, 0x00000001, 0x0004003b, 0x00000010, 0x00000004, 0x00000001, 0x0004003b,
+    0x00000011, 0x00000005, 0x00000003, 0x00050036, 0x00000007, 0x00000002, 0x00000000, 0x00000008,
+    0x000200f8, 0x00000014, 0x0004003d, 0x0000000d, 0x00000015, 0x00000006, 0x0004003d, 0x0000000a,
+    0x00000016, 0x00000003, 0x00050057, 0x0000000b, 0x00000017, 0x00000015, 0x00000016, 0x00050051,
+    0x00000009, 0x00000018, 0x00000017, 0x00000000, 0x00050051, 0x00000009, 0x00000019, 0x00000017,
+    0x00000001, 0x00050051, 0x00000009, 0x0000001a, 0x00000017, 0x00000002, 0x0007000c, 0x00000009,
+    0x0000001b, 0x00000001, 0x00000025, 0x00000018, 0x00000019, 0x0007000c, 0x00000009, 0x0000001c,
+    0x00000001, 0x00000028, 0x00000018, 0x00000019, 0x0007000c, 0x00000009, 0x0000001d, 0x00000001,
+    0x00000025, 0x0000001c, 0x0000001a, 0x0007000c, 0x00000009, 0x0000001e, 0x00000001, 0x00000028,
+    0x0000001b, 0x0000001d, 0x000400d1, 0x00000009, 0x0000001f, 0x0000001e, 0x00050083, 0x00000009,
+    0x00000020, 0x00000012, 0x0000001f, 0x00050081, 0x00000009, 0x00000021, 0x00000012, 0x0000001f,
+    0x0008000c, 0x00000009, 0x00000022, 0x00000001, 0x00000031, 0x00000020, 0x00000021, 0x0000001e,
+    0x00070050, 0x0000000b, 0x00000023, 0x00000013, 0x00000013, 0x00000013, 0x00000022, 0x0004003d,
+    0x0000000b, 0x00000024, 0x00000004, 0x00050085, 0x0000000b, 0x00000025, 0x00000023, 0x00000024,
+    0x0003003e, 0x00000005, 0x00000025, 0x000100fd, 0x00010038,
+};
+
+static struct
+{
+    const Uint32 *ps_shader_data;
+    size_t ps_shader_size;
+    const Uint32 *vs_shader_data;
+    size_t vs_shader_size;
+} VULKAN_shaders[NUM_SHADERS] = {
+    { VULKAN_PixelShader_Colors, sizeof(VULKAN_PixelShader_Colors),
+      VULKAN_VertexShader, sizeof(VULKAN_VertexShader) },
+    { VULKAN_PixelShader_Textures, sizeof(VULKAN_PixelShader_Textures),
+      VULKAN_VertexShader, sizeof(VULKAN_VertexShader) },
+    { VULKAN_PixelShader_SDF, sizeof(VULKAN_PixelShader_SDF),
+      VULKAN_VertexShader, sizeof(VULKAN_VertexShader) },
+    { VULKAN_PixelShader_MSDF, sizeof(VULKAN_PixelShader_MSDF),
+      VULKAN_VertexShader, sizeof(VULKAN_VertexShader) },
+};
+
+void VULKAN_GetVertexShader(VULKAN_Shader shader, const Uint32 **outCode, size_t *outSize)
+{
+    *outCode = VULKAN_shaders[shader].vs_shader_data;
+    *outSize = VULKAN_shaders[shader].vs_shader_size;
+}
+
+void VULKAN_GetPixelShader(VULKAN_Shader shader, const Uint32 **outCode, size_t *outSize)
+{
+    *outCode = VULKAN_shaders[shader].ps_shader_data;
+    *outSize = VULKAN_shaders[shader].ps_shader_size;
+}
+
+#endif /* SDL_VIDEO_RENDER_VULKAN && !SDL_RENDER_DISABLED */
@@ -493,6 +493,81 @@ int SDL_GetSensorData(SDL_Sensor *sensor, float *data, int num_values)
     return 0;
 }
 
+void SDL_AddSensorBatchSample(SDL_SensorBatch *batch, Uint64 timestamp, Uint64 sensor_timestamp, const float *data, int num_values)
+{
+    SDL_SensorSample *sample;
+
+    if (!batch->samples) {
+        /* Nobody has asked for the readings yet */
+        return;
+    }
+
+    if (batch->count == SDL_SENSOR_BATCH_SIZE) {
+        /* Drop the oldest sample */
+        batch->first = (batch->first + 1) % SDL_SENSOR_BATCH_SIZE;
+        --batch->count;
+    }
+
+    sample = &batch->samples[(batch->first + batch->count) % SDL_SENSOR_BATCH_SIZE];
+    sample->timestamp = timestamp;
+    sample->sensor_timestamp = sensor_timestamp;
+    num_values = SDL_min(num_values, SDL_arraysize(sample->data));
+    SDL_memcpy(sample->data, data, num_values * sizeof(*data));
+    SDL_memset(&sample->data[num_values], 0, (SDL_arraysize(sample->data) - num_values) * sizeof(*data));
+    ++batch->count;
+}
+
+int SDL_ReadSensorBatch(SDL_SensorBatch *batch, SDL_SensorSample *samples, int num_samples)
+{
+    int i;
+
+    if (!samples) {
+        return SDL_InvalidParamError("samples");
+    }
+
+    if (!batch->samples) {
+        /* Start collecting samples from now on */
+        batch->samples = (SDL_SensorSample *)SDL_malloc(SDL_SENSOR_BATCH_SIZE * sizeof(*batch->samples));
+        if (!batch->samples) {
+            return SDL_OutOfMemory();
+        }
+        batch->first = 0;
+        batch->count = 0;
+    }
+
+    num_samples = SDL_min(num_samples, batch->count);
+    for (i = 0; i < num_samples; ++i) {
+        samples[i] = batch->samples[batch->first];
+        batch->first = (batch->first + 1) % SDL_SENSOR_BATCH_SIZE;
+    }
+    batch->count -= num_samples;
+
+    return num_samples;
+}
+
+void SDL_FreeSensorBatch(SDL_SensorBatch *batch)
+{
+    SDL_free(batch->samples);
+    batch->samples = NULL;
+    batch->first = 0;
+    batch->count = 0;
+}
+
+int SDL_GetSensorDataBatch(SDL_Sensor *sensor, SDL_SensorSample *samples, int num_samples)
+{
+    int retval;
+
+    SDL_LockSensors();
+    {
+        CHECK_SENSOR_MAGIC(sensor, -1);
+
+        retval = SDL_ReadSensorBatch(&sensor->batch, samples, num_samples);
+    }
+    SDL_UnlockSensors();
+
+    return retval;
+}
+
 /*
  * Close a sensor previously opened with SDL_OpenSensor()
  */
@@ -533,6 +608,7 @@ void SDL_CloseSensor(SDL_Sensor *sensor)
         }
 
         /* Free the data associated with this sensor */
+        SDL_FreeSensorBatch(&sensor->batch);
         SDL_free(sensor->name);
         SDL_free(sensor);
     }
@@ -578,6 +654,7 @@ int SDL_SendSensorUpdate(Uint64 timestamp, SDL_Sensor *sensor, Uint64 sensor_tim
     /* Update internal sensor state */
     num_values = SDL_min(num_values, SDL_arraysize(sensor->data));
     SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
+    SDL_AddSensorBatchSample(&sensor->batch, timestamp, sensor_timestamp, data, num_values);
 
     /* Post the event, if desired */
     posted = 0;
@@ -53,6 +53,18 @@ extern SDL_bool SDL_SensorsOpened(void);
 /* Update an individual sensor, used by gamepad sensor fusion */
 extern void SDL_UpdateSensor(SDL_Sensor *sensor);
 
+/* A queue of sensor readings, allocated the first time they are read */
+typedef struct SDL_SensorBatch
+{
+    SDL_SensorSample *samples;
+    int first;
+    int count;
+} SDL_SensorBatch;
+
+extern void SDL_AddSensorBatchSample(SDL_SensorBatch *batch, Uint64 timestamp, Uint64 sensor_timestamp, const float *data, int num_values);
+extern int SDL_ReadSensorBatch(SDL_SensorBatch *batch, SDL_SensorSample *samples, int num_samples);
+extern void SDL_FreeSensorBatch(SDL_SensorBatch *batch);
+
 /* Internal event queueing functions */
 extern int SDL_SendSensorUpdate(Uint64 timestamp, SDL_Sensor *sensor, Uint64 sensor_timestamp, float *data, int num_values);
 
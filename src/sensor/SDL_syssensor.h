@@ -40,6 +40,7 @@ struct SDL_Sensor
     int non_portable_type _guarded;      /* Platform dependent type of the sensor */
 
     float data[16] _guarded;             /* The current state of the sensor */
+    SDL_SensorBatch batch _guarded;      /* Readings since the last SDL_GetSensorDataBatch() */
 
     struct SDL_SensorDriver *driver _guarded;
 
@@ -0,0 +1,223 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "../thread/SDL_thread_c.h"
+
+/* Arena allocator for temporary memory */
+
+#define SDL_ARENA_ALIGNMENT          16
+#define SDL_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct SDL_ArenaBlock
+{
+    struct SDL_ArenaBlock *next; /* the previous block in use, or the next free block */
+    size_t offset;               /* the position in the arena where this block starts */
+    size_t size;
+    size_t used;
+    /* Memory follows, aligned to SDL_ARENA_ALIGNMENT */
+} SDL_ArenaBlock;
+
+#define SDL_ARENA_HEADER_SIZE ((sizeof(SDL_ArenaBlock) + (SDL_ARENA_ALIGNMENT - 1)) & ~(size_t)(SDL_ARENA_ALIGNMENT - 1))
+
+struct SDL_Arena
+{
+    size_t block_size;
+    SDL_ArenaBlock *current; /* the newest block in use */
+    SDL_ArenaBlock *freelist;
+};
+
+SDL_Arena *SDL_CreateArena(size_t block_size)
+{
+    SDL_Arena *arena = (SDL_Arena *)SDL_calloc(1, sizeof(*arena));
+    if (!arena) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (!block_size) {
+        block_size = SDL_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    arena->block_size = (block_size + (SDL_ARENA_ALIGNMENT - 1)) & ~(size_t)(SDL_ARENA_ALIGNMENT - 1);
+    return arena;
+}
+
+static SDL_ArenaBlock *SDL_GetArenaBlock(SDL_Arena *arena, size_t size)
+{
+    SDL_ArenaBlock *block, *prev = NULL;
+
+    for (block = arena->freelist; block; prev = block, block = block->next) {
+        if (block->size >= size) {
+            if (prev) {
+                prev->next = block->next;
+            } else {
+                arena->freelist = block->next;
+            }
+            return block;
+        }
+    }
+
+    size = SDL_max(size, arena->block_size);
+    block = (SDL_ArenaBlock *)SDL_malloc(SDL_ARENA_HEADER_SIZE + size);
+    if (!block) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    block->size = size;
+    return block;
+}
+
+void *SDL_ArenaAlloc(SDL_Arena *arena, size_t size)
+{
+    SDL_ArenaBlock *block;
+    void *memory;
+
+    if (!arena) {
+        SDL_InvalidParamError("arena");
+        return NULL;
+    }
+
+    if (size > SDL_SIZE_MAX - (SDL_ARENA_HEADER_SIZE + SDL_ARENA_ALIGNMENT)) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    size = (size + (SDL_ARENA_ALIGNMENT - 1)) & ~(size_t)(SDL_ARENA_ALIGNMENT - 1);
+    if (!size) {
+        size = SDL_ARENA_ALIGNMENT;
+    }
+
+    block = arena->current;
+    if (!block || (block->size - block->used) < size) {
+        SDL_ArenaBlock *next = SDL_GetArenaBlock(arena, size);
+        if (!next) {
+            return NULL;
+        }
+        next->offset = block ? (block->offset + block->size) : 0;
+        next->used = 0;
+        next->next = block;
+        arena->current = block = next;
+    }
+
+    memory = (Uint8 *)block + SDL_ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+    return memory;
+}
+
+size_t SDL_GetArenaMark(SDL_Arena *arena)
+{
+    if (!arena || !arena->current) {
+        return 0;
+    }
+    return arena->current->offset + arena->current->used;
+}
+
+void SDL_ResetArena(SDL_Arena *arena, size_t mark)
+{
+    SDL_ArenaBlock *block;
+
+    if (!arena) {
+        return;
+    }
+
+    /* Keep any blocks that were started after the mark for reuse */
+    while (arena->current && arena->current->offset > mark) {
+        block = arena->current;
+        arena->current = block->next;
+        block->next = arena->freelist;
+        arena->freelist = block;
+    }
+
+    block = arena->current;
+    if (block) {
+        if (mark == 0) {
+            arena->current = NULL;
+            block->next = arena->freelist;
+            arena->freelist = block;
+        } else if (mark - block->offset < block->used) {
+            block->used = mark - block->offset;
+        }
+    }
+}
+
+void SDL_DestroyArena(SDL_Arena *arena)
+{
+    if (arena) {
+        SDL_ResetArena(arena, 0);
+        while (arena->freelist) {
+            SDL_ArenaBlock *block = arena->freelist;
+            arena->freelist = block->next;
+            SDL_free(block);
+        }
+        SDL_free(arena);
+    }
+}
+
+#ifdef SDL_THREAD_LOCAL
+static SDL_THREAD_LOCAL SDL_Arena *SDL_thread_arena;
+#endif
+
+static void SDLCALL SDL_CleanupThreadArena(void *arena)
+{
+#ifdef SDL_THREAD_LOCAL
+    SDL_thread_arena = NULL;
+#endif
+    SDL_DestroyArena((SDL_Arena *)arena);
+}
+
+SDL_Arena *SDL_GetThreadArena(void)
+{
+    static SDL_SpinLock tls_lock;
+    static SDL_TLSID tls_arena;
+    SDL_Arena *arena;
+
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_thread_arena) {
+        return SDL_thread_arena;
+    }
+#endif
+
+    if (!tls_arena) {
+        SDL_AtomicLock(&tls_lock);
+        if (!tls_arena) {
+            SDL_TLSID slot = SDL_CreateTLS();
+            SDL_MemoryBarrierRelease();
+            tls_arena = slot;
+        }
+        SDL_AtomicUnlock(&tls_lock);
+        if (!tls_arena) {
+            return NULL;
+        }
+    }
+
+    SDL_MemoryBarrierAcquire();
+    arena = (SDL_Arena *)SDL_GetTLS(tls_arena);
+    if (!arena) {
+        arena = SDL_CreateArena(0);
+        if (arena && SDL_SetTLS(tls_arena, arena, SDL_CleanupThreadArena) < 0) {
+            SDL_DestroyArena(arena);
+            arena = NULL;
+        }
+    }
+#ifdef SDL_THREAD_LOCAL
+    SDL_thread_arena = arena;
+#endif
+    return arena;
+}
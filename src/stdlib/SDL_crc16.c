@@ -26,27 +26,67 @@
    This algorithm is compatible with the 16-bit CRC described here:
    https://www.lammertbies.nl/comm/info/crc-calculation
 */
-/* NOTE: DO NOT CHANGE THIS ALGORITHM
+/* NOTE: DO NOT CHANGE THE RESULTS OF THIS ALGORITHM
    There is code that relies on this in the joystick code
 */
 
-static Uint16 crc16_for_byte(Uint8 r)
+#define CRC16_POLYNOMIAL 0xA001
+
+static Uint16 crc16_table[8][256];
+static SDL_AtomicInt crc16_table_ready;
+
+static void crc16_init_table(void)
 {
-    Uint16 crc = 0;
-    int i;
-    for (i = 0; i < 8; ++i) {
-        crc = ((crc ^ r) & 1 ? 0xA001 : 0) ^ crc >> 1;
-        r >>= 1;
+    static SDL_SpinLock lock;
+    int i, j;
+
+    if (SDL_AtomicGet(&crc16_table_ready)) {
+        return;
     }
-    return crc;
+
+    SDL_AtomicLock(&lock);
+    if (!SDL_AtomicGet(&crc16_table_ready)) {
+        for (i = 0; i < 256; ++i) {
+            Uint16 r = (Uint16)i;
+            for (j = 0; j < 8; ++j) {
+                r = (r & 1 ? CRC16_POLYNOMIAL : 0) ^ r >> 1;
+            }
+            crc16_table[0][i] = r;
+        }
+        /* Each additional table is the CRC of a byte followed by that many zeros */
+        for (i = 0; i < 256; ++i) {
+            for (j = 1; j < 8; ++j) {
+                const Uint16 r = crc16_table[j - 1][i];
+                crc16_table[j][i] = crc16_table[0][r & 0xFF] ^ r >> 8;
+            }
+        }
+        SDL_AtomicSet(&crc16_table_ready, 1);
+    }
+    SDL_AtomicUnlock(&lock);
 }
 
 Uint16 SDL_crc16(Uint16 crc, const void *data, size_t len)
 {
-    /* As an optimization we can precalculate a 256 entry table for each byte */
-    size_t i;
-    for (i = 0; i < len; ++i) {
-        crc = crc16_for_byte((Uint8)crc ^ ((const Uint8 *)data)[i]) ^ crc >> 8;
+    const Uint8 *bytes = (const Uint8 *)data;
+
+    crc16_init_table();
+
+    /* Slice-by-8, processing 8 bytes with independent table lookups */
+    while (len >= 8) {
+        const Uint16 lo = crc ^ (Uint16)(bytes[0] | (bytes[1] << 8));
+        crc = crc16_table[7][lo & 0xFF] ^
+              crc16_table[6][lo >> 8] ^
+              crc16_table[5][bytes[2]] ^
+              crc16_table[4][bytes[3]] ^
+              crc16_table[3][bytes[4]] ^
+              crc16_table[2][bytes[5]] ^
+              crc16_table[1][bytes[6]] ^
+              crc16_table[0][bytes[7]];
+        bytes += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = crc16_table[0][(crc ^ *bytes++) & 0xFF] ^ crc >> 8;
     }
     return crc;
 }
@@ -28,6 +28,8 @@
 #include "../core/android/SDL_android.h"
 #endif
 
+#include "../SDL_hints_c.h"
+
 #if (defined(__WIN32__) || defined(__WINGDK__)) && (!defined(HAVE_SETENV) || !defined(HAVE_GETENV))
 /* Note this isn't thread-safe! */
 static char *SDL_envmem = NULL; /* Ugh, memory leak */
@@ -39,12 +41,18 @@ static size_t SDL_envmemlen = 0;
 #ifdef HAVE_SETENV
 int SDL_setenv(const char *name, const char *value, int overwrite)
 {
+    int result;
+
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
         return -1;
     }
 
-    return setenv(name, value, overwrite);
+    result = setenv(name, value, overwrite);
+
+    /* Hints cache environment variables, so let them know this changed */
+    SDL_MarkHintsChanged();
+    return result;
 }
 #elif defined(__WIN32__) || defined(__WINGDK__)
 int SDL_setenv(const char *name, const char *value, int overwrite)
@@ -62,6 +70,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
     if (!SetEnvironmentVariableA(name, *value ? value : NULL)) {
         return -1;
     }
+    SDL_MarkHintsChanged();
     return 0;
 }
 /* We have a real environment table, but no real setenv? Fake it w/ putenv. */
@@ -70,6 +79,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 {
     size_t len;
     char *new_variable;
+    int result;
 
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
@@ -92,7 +102,9 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
     }
 
     SDL_snprintf(new_variable, len, "%s=%s", name, value);
-    return putenv(new_variable);
+    result = putenv(new_variable);
+    SDL_MarkHintsChanged();
+    return result;
 }
 #else /* roll our own */
 static char **SDL_env = (char **)0;
@@ -155,6 +167,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
             SDL_free(new_variable);
         }
     }
+    SDL_MarkHintsChanged();
     return added ? 0 : -1;
 }
 #endif
@@ -777,6 +777,341 @@ int SDL_iconv_close(SDL_iconv_t cd)
 
 #endif /* !HAVE_ICONV */
 
+/* Fast paths for valid text in the Unicode encodings, which is nearly everything SDL converts.
+   Anything else, including text with invalid sequences, goes through SDL_iconv() as before.
+ */
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_ICONV_SSE2
+#endif
+
+typedef enum
+{
+    UNICODE_UNKNOWN,
+    UNICODE_UTF8,
+    UNICODE_UTF16LE,
+    UNICODE_UTF16BE,
+    UNICODE_UTF32LE,
+    UNICODE_UTF32BE
+} SDL_UnicodeFormat;
+
+static struct
+{
+    const char *name;
+    SDL_UnicodeFormat format;
+} unicode_formats[] = {
+    /* *INDENT-OFF* */ /* clang-format off */
+    { "UTF8", UNICODE_UTF8 },
+    { "UTF-8", UNICODE_UTF8 },
+    { "UTF16LE", UNICODE_UTF16LE },
+    { "UTF-16LE", UNICODE_UTF16LE },
+    { "UTF16BE", UNICODE_UTF16BE },
+    { "UTF-16BE", UNICODE_UTF16BE },
+    { "UTF32LE", UNICODE_UTF32LE },
+    { "UTF-32LE", UNICODE_UTF32LE },
+    { "UTF32BE", UNICODE_UTF32BE },
+    { "UTF-32BE", UNICODE_UTF32BE },
+#if defined(__WIN32__) || defined(__OS2__) || defined(__GDK__)
+    { "WCHAR_T", UNICODE_UTF16LE },
+#elif SDL_BYTEORDER == SDL_BIG_ENDIAN
+    { "WCHAR_T", UNICODE_UTF32BE },
+#else
+    { "WCHAR_T", UNICODE_UTF32LE },
+#endif
+    /* *INDENT-ON* */ /* clang-format on */
+};
+
+/* The bits that are clear in each code unit of ASCII text, in memory order */
+static const Uint8 unicode_ascii_masks[][16] = {
+    /* *INDENT-OFF* */ /* clang-format off */
+    { 0 },
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF },
+    { 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80 },
+    { 0x80, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF },
+    { 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0x80 }
+    /* *INDENT-ON* */ /* clang-format on */
+};
+
+/* The size of a code unit, and where the ASCII value is in it */
+static const size_t unicode_unit_sizes[] = { 0, 1, 2, 2, 4, 4 };
+static const size_t unicode_ascii_offsets[] = { 0, 0, 0, 1, 0, 3 };
+
+static SDL_UnicodeFormat SDL_GetUnicodeFormat(const char *code)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(unicode_formats); ++i) {
+        if (SDL_strcasecmp(code, unicode_formats[i].name) == 0) {
+            return unicode_formats[i].format;
+        }
+    }
+    return UNICODE_UNKNOWN;
+}
+
+/* Returns how many bytes at the start of src are ASCII text, in whole 16 byte chunks */
+static size_t SDL_ScanUnicodeASCII(SDL_UnicodeFormat format, const Uint8 *src, size_t srclen)
+{
+    const Uint8 *mask_bytes = unicode_ascii_masks[format];
+    size_t i = 0;
+#ifdef SDL_ICONV_SSE2
+    const __m128i mask = _mm_loadu_si128((const __m128i *)mask_bytes);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (i + 16 <= srclen &&
+           _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i *)&src[i]), mask), zero)) == 0xFFFF) {
+        i += 16;
+    }
+#else
+    Uint64 mask[2], chunk[2];
+
+    SDL_memcpy(mask, mask_bytes, sizeof(mask));
+    while (i + 16 <= srclen) {
+        SDL_memcpy(chunk, &src[i], sizeof(chunk));
+        if ((chunk[0] & mask[0]) | (chunk[1] & mask[1])) {
+            break;
+        }
+        i += 16;
+    }
+#endif
+    return i;
+}
+
+/* Copies count ASCII characters between formats */
+static void SDL_CopyUnicodeASCII(SDL_UnicodeFormat dst_format, Uint8 *dst, SDL_UnicodeFormat src_format, const Uint8 *src, size_t count)
+{
+    const size_t src_size = unicode_unit_sizes[src_format];
+    const size_t dst_size = unicode_unit_sizes[dst_format];
+    const size_t src_offset = unicode_ascii_offsets[src_format];
+    const size_t dst_offset = unicode_ascii_offsets[dst_format];
+    size_t i;
+
+#ifdef SDL_ICONV_SSE2
+    /* These are the conversions that Windows does all the time */
+    if (src_format == UNICODE_UTF8 && dst_format == UNICODE_UTF16LE) {
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; count >= 16; count -= 16, src += 16, dst += 32) {
+            const __m128i chars = _mm_loadu_si128((const __m128i *)src);
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(chars, zero));
+            _mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi8(chars, zero));
+        }
+    } else if (src_format == UNICODE_UTF16LE && dst_format == UNICODE_UTF8) {
+        for (; count >= 16; count -= 16, src += 32, dst += 16) {
+            const __m128i lo = _mm_loadu_si128((const __m128i *)src);
+            const __m128i hi = _mm_loadu_si128((const __m128i *)(src + 16));
+            _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+    if (dst_size > 1) {
+        SDL_memset(dst, 0, count * dst_size);
+    }
+    for (i = 0; i < count; ++i) {
+        dst[i * dst_size + dst_offset] = src[i * src_size + src_offset];
+    }
+}
+
+static SDL_bool SDL_IsValidUnicode(Uint32 ch)
+{
+    /* The noncharacters U+FFFE and U+FFFF are left to SDL_iconv() too */
+    return (ch < 0xD800 || (ch > 0xDFFF && ch < 0xFFFE) || (ch > 0xFFFF && ch <= 0x10FFFF));
+}
+
+/* Returns how many bytes the next character takes, or 0 if it's invalid or incomplete */
+static size_t SDL_DecodeUnicode(SDL_UnicodeFormat format, const Uint8 *src, size_t srclen, Uint32 *ch)
+{
+    size_t length;
+
+    switch (format) {
+    case UNICODE_UTF8:
+        if (src[0] < 0x80) {
+            *ch = src[0];
+            return 1;
+        } else if (src[0] < 0xC2) {
+            return 0;
+        } else if (src[0] < 0xE0) {
+            if (srclen < 2 || (src[1] & 0xC0) != 0x80) {
+                return 0;
+            }
+            *ch = ((Uint32)(src[0] & 0x1F) << 6) | (Uint32)(src[1] & 0x3F);
+            return 2;
+        } else if (src[0] < 0xF0) {
+            if (srclen < 3 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80) {
+                return 0;
+            }
+            *ch = ((Uint32)(src[0] & 0x0F) << 12) | ((Uint32)(src[1] & 0x3F) << 6) | (Uint32)(src[2] & 0x3F);
+            length = (*ch >= 0x800) ? 3 : 0;
+        } else {
+            if (srclen < 4 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80 || (src[3] & 0xC0) != 0x80) {
+                return 0;
+            }
+            *ch = ((Uint32)(src[0] & 0x07) << 18) | ((Uint32)(src[1] & 0x3F) << 12) | ((Uint32)(src[2] & 0x3F) << 6) | (Uint32)(src[3] & 0x3F);
+            length = (src[0] < 0xF8 && *ch >= 0x10000) ? 4 : 0;
+        }
+        break;
+    case UNICODE_UTF16LE:
+    case UNICODE_UTF16BE:
+    {
+        const size_t hi = (format == UNICODE_UTF16BE) ? 0 : 1;
+        const size_t lo = 1 - hi;
+        Uint32 W1, W2;
+
+        if (srclen < 2) {
+            return 0;
+        }
+        W1 = ((Uint32)src[hi] << 8) | (Uint32)src[lo];
+        if (W1 < 0xD800 || W1 > 0xDFFF) {
+            *ch = W1;
+            length = 2;
+            break;
+        }
+        if (W1 > 0xDBFF || srclen < 4) {
+            return 0;
+        }
+        W2 = ((Uint32)src[2 + hi] << 8) | (Uint32)src[2 + lo];
+        if (W2 < 0xDC00 || W2 > 0xDFFF) {
+            return 0;
+        }
+        *ch = (((W1 & 0x3FF) << 10) | (W2 & 0x3FF)) + 0x10000;
+        length = 4;
+    } break;
+    case UNICODE_UTF32LE:
+        if (srclen < 4) {
+            return 0;
+        }
+        *ch = ((Uint32)src[3] << 24) | ((Uint32)src[2] << 16) | ((Uint32)src[1] << 8) | (Uint32)src[0];
+        length = 4;
+        break;
+    case UNICODE_UTF32BE:
+        if (srclen < 4) {
+            return 0;
+        }
+        *ch = ((Uint32)src[0] << 24) | ((Uint32)src[1] << 16) | ((Uint32)src[2] << 8) | (Uint32)src[3];
+        length = 4;
+        break;
+    default:
+        return 0;
+    }
+    return SDL_IsValidUnicode(*ch) ? length : 0;
+}
+
+static size_t SDL_GetUnicodeEncodedLength(SDL_UnicodeFormat format, Uint32 ch)
+{
+    switch (format) {
+    case UNICODE_UTF8:
+        return (ch <= 0x7F) ? 1 : (ch <= 0x7FF) ? 2 : (ch <= 0xFFFF) ? 3 : 4;
+    case UNICODE_UTF16LE:
+    case UNICODE_UTF16BE:
+        return (ch < 0x10000) ? 2 : 4;
+    default:
+        return 4;
+    }
+}
+
+static void SDL_EncodeUnicode(SDL_UnicodeFormat format, Uint32 ch, Uint8 *dst)
+{
+    switch (format) {
+    case UNICODE_UTF8:
+        if (ch <= 0x7F) {
+            dst[0] = (Uint8)ch;
+        } else if (ch <= 0x7FF) {
+            dst[0] = 0xC0 | (Uint8)(ch >> 6);
+            dst[1] = 0x80 | (Uint8)(ch & 0x3F);
+        } else if (ch <= 0xFFFF) {
+            dst[0] = 0xE0 | (Uint8)(ch >> 12);
+            dst[1] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+            dst[2] = 0x80 | (Uint8)(ch & 0x3F);
+        } else {
+            dst[0] = 0xF0 | (Uint8)(ch >> 18);
+            dst[1] = 0x80 | (Uint8)((ch >> 12) & 0x3F);
+            dst[2] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+            dst[3] = 0x80 | (Uint8)(ch & 0x3F);
+        }
+        break;
+    case UNICODE_UTF16LE:
+    case UNICODE_UTF16BE:
+    {
+        const size_t hi = (format == UNICODE_UTF16BE) ? 0 : 1;
+        const size_t lo = 1 - hi;
+
+        if (ch < 0x10000) {
+            dst[hi] = (Uint8)(ch >> 8);
+            dst[lo] = (Uint8)ch;
+        } else {
+            const Uint32 W1 = 0xD800 | ((ch - 0x10000) >> 10);
+            const Uint32 W2 = 0xDC00 | (ch & 0x3FF);
+            dst[hi] = (Uint8)(W1 >> 8);
+            dst[lo] = (Uint8)W1;
+            dst[2 + hi] = (Uint8)(W2 >> 8);
+            dst[2 + lo] = (Uint8)W2;
+        }
+    } break;
+    case UNICODE_UTF32LE:
+        dst[3] = 0;
+        dst[2] = (Uint8)(ch >> 16);
+        dst[1] = (Uint8)(ch >> 8);
+        dst[0] = (Uint8)ch;
+        break;
+    case UNICODE_UTF32BE:
+        dst[0] = 0;
+        dst[1] = (Uint8)(ch >> 16);
+        dst[2] = (Uint8)(ch >> 8);
+        dst[3] = (Uint8)ch;
+        break;
+    default:
+        break;
+    }
+}
+
+/* Returns SDL_FALSE if the text needs to go through SDL_iconv() instead */
+static SDL_bool SDL_ConvertUnicodeString(SDL_UnicodeFormat dst_format, SDL_UnicodeFormat src_format, const Uint8 *src, size_t srclen, char **result)
+{
+    const size_t src_size = unicode_unit_sizes[src_format];
+    const size_t dst_size = unicode_unit_sizes[dst_format];
+    size_t i, n, length = 0;
+    Uint32 ch;
+    Uint8 *dst;
+
+    /* Check that all the text is valid and find out exactly how big it'll be */
+    for (i = 0; i < srclen; i += n) {
+        n = SDL_ScanUnicodeASCII(src_format, &src[i], srclen - i);
+        if (n) {
+            length += (n / src_size) * dst_size;
+            continue;
+        }
+        n = SDL_DecodeUnicode(src_format, &src[i], srclen - i, &ch);
+        if (!n) {
+            return SDL_FALSE;
+        }
+        length += SDL_GetUnicodeEncodedLength(dst_format, ch);
+    }
+
+    *result = (char *)SDL_malloc(length + sizeof(Uint32));
+    if (!*result) {
+        return SDL_TRUE;
+    }
+    dst = (Uint8 *)*result;
+    SDL_memset(dst + length, 0, sizeof(Uint32));
+
+    if (src_format == dst_format) {
+        SDL_memcpy(dst, src, srclen);
+        return SDL_TRUE;
+    }
+
+    for (i = 0; i < srclen; i += n) {
+        n = SDL_ScanUnicodeASCII(src_format, &src[i], srclen - i);
+        if (n) {
+            SDL_CopyUnicodeASCII(dst_format, dst, src_format, &src[i], n / src_size);
+            dst += (n / src_size) * dst_size;
+            continue;
+        }
+        n = SDL_DecodeUnicode(src_format, &src[i], srclen - i, &ch);
+        SDL_EncodeUnicode(dst_format, ch, dst);
+        dst += SDL_GetUnicodeEncodedLength(dst_format, ch);
+    }
+    return SDL_TRUE;
+}
+
 char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft)
 {
     SDL_iconv_t cd;
@@ -785,6 +1120,7 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     char *outbuf;
     size_t outbytesleft;
     size_t retCode = 0;
+    SDL_UnicodeFormat src_format, dst_format;
 
     if (!tocode || !*tocode) {
         tocode = "UTF-8";
@@ -792,6 +1128,14 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     if (!fromcode || !*fromcode) {
         fromcode = "UTF-8";
     }
+
+    src_format = SDL_GetUnicodeFormat(fromcode);
+    dst_format = SDL_GetUnicodeFormat(tocode);
+    if (src_format != UNICODE_UNKNOWN && dst_format != UNICODE_UNKNOWN &&
+        SDL_ConvertUnicodeString(dst_format, src_format, (const Uint8 *)inbuf, inbytesleft, &string)) {
+        return string;
+    }
+
     cd = SDL_iconv_open(tocode, fromcode);
     if (cd == (SDL_iconv_t)-1) {
         return NULL;
@@ -5203,11 +5203,31 @@ static struct
     SDL_calloc_func calloc_func;
     SDL_realloc_func realloc_func;
     SDL_free_func free_func;
-    SDL_AtomicInt num_allocations;
 } s_mem = {
-    real_malloc, real_calloc, real_realloc, real_free, { 0 }
+    real_malloc, real_calloc, real_realloc, real_free
 };
 
+/* The allocation count is spread over several cache lines, indexed by thread,
+   so threads allocating at the same time don't contend over a single counter.
+   A thread may free memory allocated by another, so entries can go negative.
+ */
+#define NUM_ALLOCATION_COUNTERS 16
+
+typedef struct
+{
+    SDL_AtomicInt count;
+    char pad[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicInt)];
+} SDL_AllocationCounter;
+
+static SDL_AllocationCounter s_num_allocations[NUM_ALLOCATION_COUNTERS];
+
+static SDL_AtomicInt *GetAllocationCounter(void)
+{
+    /* Thread IDs are often aligned pointers, so mix the bits before picking a counter */
+    const Uint64 hash = (Uint64)SDL_ThreadID() * 0x9E3779B97F4A7C15ULL;
+    return &s_num_allocations[(hash >> 32) % NUM_ALLOCATION_COUNTERS].count;
+}
+
 void SDL_GetOriginalMemoryFunctions(SDL_malloc_func *malloc_func,
                                     SDL_calloc_func *calloc_func,
                                     SDL_realloc_func *realloc_func,
@@ -5273,7 +5293,12 @@ int SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
 
 int SDL_GetNumAllocations(void)
 {
-    return SDL_AtomicGet(&s_mem.num_allocations);
+    int i, num_allocations = 0;
+
+    for (i = 0; i < NUM_ALLOCATION_COUNTERS; ++i) {
+        num_allocations += SDL_AtomicGet(&s_num_allocations[i].count);
+    }
+    return num_allocations;
 }
 
 void *SDL_malloc(size_t size)
@@ -5286,7 +5311,7 @@ void *SDL_malloc(size_t size)
 
     mem = s_mem.malloc_func(size);
     if (mem) {
-        SDL_AtomicIncRef(&s_mem.num_allocations);
+        SDL_AtomicIncRef(GetAllocationCounter());
     }
     return mem;
 }
@@ -5302,7 +5327,7 @@ void *SDL_calloc(size_t nmemb, size_t size)
 
     mem = s_mem.calloc_func(nmemb, size);
     if (mem) {
-        SDL_AtomicIncRef(&s_mem.num_allocations);
+        SDL_AtomicIncRef(GetAllocationCounter());
     }
     return mem;
 }
@@ -5317,7 +5342,7 @@ void *SDL_realloc(void *ptr, size_t size)
 
     mem = s_mem.realloc_func(ptr, size);
     if (mem && !ptr) {
-        SDL_AtomicIncRef(&s_mem.num_allocations);
+        SDL_AtomicIncRef(GetAllocationCounter());
     }
     return mem;
 }
@@ -5329,5 +5354,5 @@ void SDL_free(void *ptr)
     }
 
     s_mem.free_func(ptr);
-    (void)SDL_AtomicDecRef(&s_mem.num_allocations);
+    (void)SDL_AtomicDecRef(GetAllocationCounter());
 }
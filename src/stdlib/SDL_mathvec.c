@@ -0,0 +1,374 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Single precision sine, cosine and exponential for bulk work.
+
+   These use the polynomials from the Cephes library, which are good to a
+   couple of ULP in the range they're valid for. Anything outside that range,
+   and infinities and NaNs, go through SDL_sinf(), SDL_cosf() and SDL_expf().
+ */
+
+#define FOPI   1.27323954473516f /* 4 / Pi */
+#define DP1    0.78515625f       /* Pi / 4 in three parts */
+#define DP2    2.4187564849853515625e-4f
+#define DP3    3.77489497744594108e-8f
+#define SIN_C0 -1.9515295891e-4f
+#define SIN_C1 8.3321608736e-3f
+#define SIN_C2 -1.6666654611e-1f
+#define COS_C0 2.443315711809948e-5f
+#define COS_C1 -1.388731625493765e-3f
+#define COS_C2 4.166664568298827e-2f
+#define SINCOS_MAX 8192.0f /* the reduction loses precision above this */
+
+#define LOG2E  1.44269504088896341f
+#define EXP_C1 0.693359375f      /* ln(2) in two parts */
+#define EXP_C2 -2.12194440e-4f
+#define EXP_P0 1.9875691500e-4f
+#define EXP_P1 1.3981999507e-3f
+#define EXP_P2 8.3334519073e-3f
+#define EXP_P3 4.1665795894e-2f
+#define EXP_P4 1.6666665459e-1f
+#define EXP_P5 5.0000001201e-1f
+#define EXP_MAX 88.0f  /* the result is a normal float in this range */
+#define EXP_MIN -87.0f
+
+typedef union
+{
+    float f;
+    Uint32 u;
+} FloatBits;
+
+static void SinCos(float x, float *s, float *c)
+{
+    FloatBits ax, sign, sinv, cosv;
+    float y, r, z, ps, pc;
+    int j, q;
+
+    ax.f = x;
+    sign.u = ax.u & 0x80000000;
+    ax.u &= 0x7FFFFFFF;
+    if (!(ax.f < SINCOS_MAX)) {
+        if (s) {
+            *s = SDL_sinf(x);
+        }
+        if (c) {
+            *c = SDL_cosf(x);
+        }
+        return;
+    }
+
+    /* Reduce to [-Pi/4, Pi/4] and the quadrant of the original angle */
+    j = (int)(ax.f * FOPI);
+    j = (j + 1) & ~1;
+    y = (float)j;
+    r = ((ax.f - y * DP1) - y * DP2) - y * DP3;
+    q = j >> 1;
+
+    z = r * r;
+    ps = r + r * z * ((SIN_C0 * z + SIN_C1) * z + SIN_C2);
+    pc = 1.0f - 0.5f * z + z * z * ((COS_C0 * z + COS_C1) * z + COS_C2);
+
+    if (q & 1) {
+        sinv.f = pc;
+        cosv.f = ps;
+    } else {
+        sinv.f = ps;
+        cosv.f = pc;
+    }
+    if (s) {
+        sinv.u ^= sign.u ^ ((Uint32)(q & 2) << 30);
+        *s = sinv.f;
+    }
+    if (c) {
+        cosv.u ^= (Uint32)((q + 1) & 2) << 30;
+        *c = cosv.f;
+    }
+}
+
+static float Exp(float x)
+{
+    FloatBits pow2n;
+    float n, r, z, y;
+
+    if (!(x <= EXP_MAX && x >= EXP_MIN)) {
+        return SDL_expf(x);
+    }
+
+    /* exp(x) = 2^n * exp(r), with |r| <= ln(2) / 2 */
+    n = SDL_floorf(x * LOG2E + 0.5f);
+    r = x - n * EXP_C1 - n * EXP_C2;
+
+    z = r * r;
+    y = (((((EXP_P0 * r + EXP_P1) * r + EXP_P2) * r + EXP_P3) * r + EXP_P4) * r + EXP_P5) * z + r + 1.0f;
+
+    pow2n.u = (Uint32)((int)n + 127) << 23;
+    return y * pow2n.f;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Returns the number of values that were handled, the rest are left for the caller */
+static int SDL_TARGETING("sse2") SinCosArray_SSE2(const float *src, float *sdst, float *cdst, int count)
+{
+    const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&src[i]);
+        const __m128 sign = _mm_and_ps(x, sign_mask);
+        const __m128 ax = _mm_andnot_ps(sign_mask, x);
+        __m128i j, q;
+        __m128 y, r, z, ps, pc, swap;
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(ax, _mm_set1_ps(SINCOS_MAX))) != 0xF) {
+            int k;
+            for (k = i; k < i + 4; ++k) {
+                SinCos(src[k], sdst ? &sdst[k] : NULL, cdst ? &cdst[k] : NULL);
+            }
+            continue;
+        }
+
+        j = _mm_cvttps_epi32(_mm_mul_ps(ax, _mm_set1_ps(FOPI)));
+        j = _mm_andnot_si128(one, _mm_add_epi32(j, one));
+        y = _mm_cvtepi32_ps(j);
+        r = _mm_sub_ps(ax, _mm_mul_ps(y, _mm_set1_ps(DP1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(DP2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(DP3)));
+        q = _mm_srli_epi32(j, 1);
+
+        z = _mm_mul_ps(r, r);
+        ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C0), z), _mm_set1_ps(SIN_C1));
+        ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(SIN_C2));
+        ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), ps));
+        pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C0), z), _mm_set1_ps(COS_C1));
+        pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(COS_C2));
+        pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), pc));
+
+        swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+        if (sdst) {
+            __m128 s = _mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps));
+            s = _mm_xor_ps(s, _mm_xor_ps(sign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30))));
+            _mm_storeu_ps(&sdst[i], s);
+        }
+        if (cdst) {
+            __m128 c = _mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc));
+            c = _mm_xor_ps(c, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30)));
+            _mm_storeu_ps(&cdst[i], c);
+        }
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") ExpArray_SSE2(const float *src, float *dst, int count)
+{
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&src[i]);
+        __m128i t;
+        __m128 fx, n, r, z, y;
+
+        if (_mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(x, _mm_set1_ps(EXP_MAX)), _mm_cmpge_ps(x, _mm_set1_ps(EXP_MIN)))) != 0xF) {
+            int k;
+            for (k = i; k < i + 4; ++k) {
+                dst[k] = Exp(src[k]);
+            }
+            continue;
+        }
+
+        /* floor() by truncating and stepping down where that rounded up */
+        fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(LOG2E)), _mm_set1_ps(0.5f));
+        t = _mm_cvttps_epi32(fx);
+        t = _mm_add_epi32(t, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(t), fx)));
+        n = _mm_cvtepi32_ps(t);
+        r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(EXP_C1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(EXP_C2)));
+
+        z = _mm_mul_ps(r, r);
+        y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(EXP_P0), r), _mm_set1_ps(EXP_P1));
+        y = _mm_add_ps(_mm_mul_ps(y, r), _mm_set1_ps(EXP_P2));
+        y = _mm_add_ps(_mm_mul_ps(y, r), _mm_set1_ps(EXP_P3));
+        y = _mm_add_ps(_mm_mul_ps(y, r), _mm_set1_ps(EXP_P4));
+        y = _mm_add_ps(_mm_mul_ps(y, r), _mm_set1_ps(EXP_P5));
+        y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), r), _mm_set1_ps(1.0f));
+
+        t = _mm_slli_epi32(_mm_add_epi32(t, _mm_set1_epi32(127)), 23);
+        _mm_storeu_ps(&dst[i], _mm_mul_ps(y, _mm_castsi128_ps(t)));
+    }
+    return i;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_bool AllLanes_NEON(uint32x4_t mask)
+{
+    const uint32x2_t m = vand_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (vget_lane_u32(m, 0) & vget_lane_u32(m, 1)) ? SDL_TRUE : SDL_FALSE;
+}
+
+static int SinCosArray_NEON(const float *src, float *sdst, float *cdst, int count)
+{
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000);
+    const int32x4_t one = vdupq_n_s32(1);
+    const int32x4_t two = vdupq_n_s32(2);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const float32x4_t x = vld1q_f32(&src[i]);
+        const uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), sign_mask);
+        const float32x4_t ax = vabsq_f32(x);
+        int32x4_t j, q;
+        float32x4_t y, r, z, ps, pc;
+        uint32x4_t swap;
+
+        if (!AllLanes_NEON(vcltq_f32(ax, vdupq_n_f32(SINCOS_MAX)))) {
+            int k;
+            for (k = i; k < i + 4; ++k) {
+                SinCos(src[k], sdst ? &sdst[k] : NULL, cdst ? &cdst[k] : NULL);
+            }
+            continue;
+        }
+
+        j = vcvtq_s32_f32(vmulq_f32(ax, vdupq_n_f32(FOPI)));
+        j = vbicq_s32(vaddq_s32(j, one), one);
+        y = vcvtq_f32_s32(j);
+        r = vsubq_f32(ax, vmulq_f32(y, vdupq_n_f32(DP1)));
+        r = vsubq_f32(r, vmulq_f32(y, vdupq_n_f32(DP2)));
+        r = vsubq_f32(r, vmulq_f32(y, vdupq_n_f32(DP3)));
+        q = vshrq_n_s32(j, 1);
+
+        z = vmulq_f32(r, r);
+        ps = vaddq_f32(vmulq_f32(vdupq_n_f32(SIN_C0), z), vdupq_n_f32(SIN_C1));
+        ps = vaddq_f32(vmulq_f32(ps, z), vdupq_n_f32(SIN_C2));
+        ps = vaddq_f32(r, vmulq_f32(vmulq_f32(r, z), ps));
+        pc = vaddq_f32(vmulq_f32(vdupq_n_f32(COS_C0), z), vdupq_n_f32(COS_C1));
+        pc = vaddq_f32(vmulq_f32(pc, z), vdupq_n_f32(COS_C2));
+        pc = vaddq_f32(vsubq_f32(vdupq_n_f32(1.0f), vmulq_f32(vdupq_n_f32(0.5f), z)), vmulq_f32(vmulq_f32(z, z), pc));
+
+        swap = vceqq_s32(vandq_s32(q, one), one);
+        if (sdst) {
+            uint32x4_t s = vreinterpretq_u32_f32(vbslq_f32(swap, pc, ps));
+            s = veorq_u32(s, veorq_u32(sign, vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(q, two)), 30)));
+            vst1q_f32(&sdst[i], vreinterpretq_f32_u32(s));
+        }
+        if (cdst) {
+            uint32x4_t c = vreinterpretq_u32_f32(vbslq_f32(swap, ps, pc));
+            c = veorq_u32(c, vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(q, one), two)), 30));
+            vst1q_f32(&cdst[i], vreinterpretq_f32_u32(c));
+        }
+    }
+    return i;
+}
+
+static int ExpArray_NEON(const float *src, float *dst, int count)
+{
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const float32x4_t x = vld1q_f32(&src[i]);
+        int32x4_t t;
+        float32x4_t fx, n, r, z, y;
+
+        if (!AllLanes_NEON(vandq_u32(vcleq_f32(x, vdupq_n_f32(EXP_MAX)), vcgeq_f32(x, vdupq_n_f32(EXP_MIN))))) {
+            int k;
+            for (k = i; k < i + 4; ++k) {
+                dst[k] = Exp(src[k]);
+            }
+            continue;
+        }
+
+        /* floor() by truncating and stepping down where that rounded up */
+        fx = vaddq_f32(vmulq_f32(x, vdupq_n_f32(LOG2E)), vdupq_n_f32(0.5f));
+        t = vcvtq_s32_f32(fx);
+        t = vaddq_s32(t, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(t), fx)));
+        n = vcvtq_f32_s32(t);
+        r = vsubq_f32(x, vmulq_f32(n, vdupq_n_f32(EXP_C1)));
+        r = vsubq_f32(r, vmulq_f32(n, vdupq_n_f32(EXP_C2)));
+
+        z = vmulq_f32(r, r);
+        y = vaddq_f32(vmulq_f32(vdupq_n_f32(EXP_P0), r), vdupq_n_f32(EXP_P1));
+        y = vaddq_f32(vmulq_f32(y, r), vdupq_n_f32(EXP_P2));
+        y = vaddq_f32(vmulq_f32(y, r), vdupq_n_f32(EXP_P3));
+        y = vaddq_f32(vmulq_f32(y, r), vdupq_n_f32(EXP_P4));
+        y = vaddq_f32(vmulq_f32(y, r), vdupq_n_f32(EXP_P5));
+        y = vaddq_f32(vaddq_f32(vmulq_f32(y, z), r), vdupq_n_f32(1.0f));
+
+        t = vshlq_n_s32(vaddq_s32(t, vdupq_n_s32(127)), 23);
+        vst1q_f32(&dst[i], vmulq_f32(y, vreinterpretq_f32_s32(t)));
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static void SinCosArray(const float *src, float *sdst, float *cdst, int count)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i = SinCosArray_SSE2(src, sdst, cdst, count);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = SinCosArray_NEON(src, sdst, cdst, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        SinCos(src[i], sdst ? &sdst[i] : NULL, cdst ? &cdst[i] : NULL);
+    }
+}
+
+void SDL_sincosf(float x, float *s, float *c)
+{
+    SinCos(x, s, c);
+}
+
+void SDL_sinf_array(const float *src, float *dst, int count)
+{
+    SinCosArray(src, dst, NULL, count);
+}
+
+void SDL_cosf_array(const float *src, float *dst, int count)
+{
+    SinCosArray(src, NULL, dst, count);
+}
+
+void SDL_expf_array(const float *src, float *dst, int count)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i = ExpArray_SSE2(src, dst, count);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = ExpArray_NEON(src, dst, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = Exp(src[i]);
+    }
+}
@@ -20,511 +20,663 @@
 */
 #include "SDL_internal.h"
 
+/* Sorting without allocating memory or copying through temporary elements.
+
+   SDL_qsort_r() is pattern-defeating quicksort, from Orson Peters' pdqsort:
+   https://github.com/orlp/pdqsort, an introsort that picks pivots with a
+   median of three (or of nine for large arrays), handles runs of equal
+   elements in linear time, notices arrays that are already sorted, and
+   shuffles things around and eventually falls back to heapsort when the
+   partitions keep coming out unbalanced.
+ */
 
-#ifdef HAVE_QSORT
-void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void *, const void *))
+/* Arrays smaller than this are insertion sorted */
+#define SDL_SORT_INSERTION_THRESHOLD 24
+
+/* Arrays larger than this use the median of nine for a pivot */
+#define SDL_SORT_NINTHER_THRESHOLD 128
+
+/* This is how many elements the partial insertion sort can move before giving up */
+#define SDL_SORT_PARTIAL_INSERTION_LIMIT 8
+
+typedef enum
 {
-    qsort(base, nmemb, size, compare);
+    SDL_SORT_BYTES,
+    SDL_SORT_DWORDS,
+    SDL_SORT_QWORDS
+} SDL_SortElementType;
+
+typedef struct
+{
+    size_t size;
+    SDL_SortElementType type;
+    SDL_CompareCallback_r compare;
+    void *userdata;
+} SDL_SortContext;
+
+static SDL_SortElementType SDL_GetSortElementType(const void *base, size_t size)
+{
+    if ((((uintptr_t)base | size) & (sizeof(Uint64) - 1)) == 0) {
+        return SDL_SORT_QWORDS;
+    } else if ((((uintptr_t)base | size) & (sizeof(Uint32) - 1)) == 0) {
+        return SDL_SORT_DWORDS;
+    } else {
+        return SDL_SORT_BYTES;
+    }
 }
 
-#else
+static void SDL_SwapElements(const SDL_SortContext *ctx, Uint8 *a, Uint8 *b)
+{
+    size_t i;
+
+    switch (ctx->type) {
+    case SDL_SORT_QWORDS:
+        for (i = 0; i < ctx->size; i += sizeof(Uint64)) {
+            const Uint64 tmp = *(Uint64 *)(a + i);
+            *(Uint64 *)(a + i) = *(Uint64 *)(b + i);
+            *(Uint64 *)(b + i) = tmp;
+        }
+        break;
+    case SDL_SORT_DWORDS:
+        for (i = 0; i < ctx->size; i += sizeof(Uint32)) {
+            const Uint32 tmp = *(Uint32 *)(a + i);
+            *(Uint32 *)(a + i) = *(Uint32 *)(b + i);
+            *(Uint32 *)(b + i) = tmp;
+        }
+        break;
+    default:
+        for (i = 0; i < ctx->size; ++i) {
+            const Uint8 tmp = a[i];
+            a[i] = b[i];
+            b[i] = tmp;
+        }
+        break;
+    }
+}
 
-#ifdef assert
-#undef assert
-#endif
-#define assert SDL_assert
-#ifdef malloc
-#undef malloc
-#endif
-#define malloc SDL_malloc
-#ifdef free
-#undef free
-#endif
-#define free SDL_free
-#ifdef memcpy
-#undef memcpy
-#endif
-#define memcpy SDL_memcpy
-#ifdef memmove
-#undef memmove
-#endif
-#define memmove SDL_memmove
-#ifdef qsortG
-#undef qsortG
-#endif
-#define qsortG SDL_qsort
+static void SDL_CopyElement(const SDL_SortContext *ctx, Uint8 *dst, const Uint8 *src)
+{
+    size_t i;
 
-/*
-This code came from Gareth McCaughan, under the zlib license.
-Specifically this: https://www.mccaughan.org.uk/software/qsort.c-1.15
+    switch (ctx->type) {
+    case SDL_SORT_QWORDS:
+        for (i = 0; i < ctx->size; i += sizeof(Uint64)) {
+            *(Uint64 *)(dst + i) = *(const Uint64 *)(src + i);
+        }
+        break;
+    case SDL_SORT_DWORDS:
+        for (i = 0; i < ctx->size; i += sizeof(Uint32)) {
+            *(Uint32 *)(dst + i) = *(const Uint32 *)(src + i);
+        }
+        break;
+    default:
+        for (i = 0; i < ctx->size; ++i) {
+            dst[i] = src[i];
+        }
+        break;
+    }
+}
 
-Everything below this comment until the HAVE_QSORT #endif was from Gareth
-(any minor changes will be noted inline).
+#define ELEMENT(i) (base + (i) * ctx->size)
+#define LESS(a, b) (ctx->compare(ctx->userdata, (a), (b)) < 0)
 
-Thank you to Gareth for relicensing this code under the zlib license for our
-benefit!
+static void SDL_SortTwo(const SDL_SortContext *ctx, Uint8 *a, Uint8 *b)
+{
+    if (LESS(b, a)) {
+        SDL_SwapElements(ctx, a, b);
+    }
+}
 
---ryan.
-*/
+static void SDL_SortThree(const SDL_SortContext *ctx, Uint8 *a, Uint8 *b, Uint8 *c)
+{
+    SDL_SortTwo(ctx, a, b);
+    SDL_SortTwo(ctx, b, c);
+    SDL_SortTwo(ctx, a, b);
+}
 
-/* This is a drop-in replacement for the C library's |qsort()| routine.
- *
- * It is intended for use where you know or suspect that your
- * platform's qsort is bad. If that isn't the case, then you
- * should probably use the qsort your system gives you in preference
- * to mine -- it will likely have been tested and tuned better.
- *
- * Features:
- *   - Median-of-three pivoting (and more)
- *   - Truncation and final polishing by a single insertion sort
- *   - Early truncation when no swaps needed in pivoting step
- *   - Explicit recursion, guaranteed not to overflow
- *   - A few little wrinkles stolen from the GNU |qsort()|.
- *     (For the avoidance of doubt, no code was stolen, only
- *     broad ideas.)
- *   - separate code for non-aligned / aligned / word-size objects
- *
- * Earlier releases of this code used an idiosyncratic licence
- * I wrote myself, because I'm an idiot. The code is now released
- * under the "zlib/libpng licence"; you will find the actual
- * terms in the next comment. I request (but do not require)
- * that if you make any changes beyond the name of the exported
- * routine and reasonable tweaks to the TRUNC_* and
- * PIVOT_THRESHOLD values, you modify the _ID string so as
- * to make it clear that you have changed the code.
- *
- * If you find problems with this code, or find ways of
- * making it significantly faster, please let me know!
- * My e-mail address, valid as of early 2016 and for the
- * foreseeable future, is
- *    gareth.mccaughan@pobox.com
- * Thanks!
- *
- * Gareth McCaughan
- */
+/* Equal elements never trade places, so this is stable */
+static void SDL_InsertionSort(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    size_t i, j;
 
-/* Copyright (c) 1998-2016 Gareth McCaughan
- *
- * This software is provided 'as-is', without any express or implied
- * warranty. In no event will the authors be held liable for any
- * damages arising from the use of this software.
- *
- * Permission is granted to anyone to use this software for any purpose,
- * including commercial applications, and to alter it and redistribute it
- * freely, subject to the following restrictions:
- *
- * 1. The origin of this software must not be misrepresented;
- *    you must not claim that you wrote the original software.
- *    If you use this software in a product, an acknowledgment
- *    in the product documentation would be appreciated but
- *    is not required.
- *
- * 2. Altered source versions must be plainly marked as such,
- *    and must not be misrepresented as being the original software.
- *
- * 3. This notice may not be removed or altered from any source
- *    distribution.
- */
+    for (i = 1; i < nmemb; ++i) {
+        for (j = i; j > 0 && LESS(ELEMENT(j), ELEMENT(j - 1)); --j) {
+            SDL_SwapElements(ctx, ELEMENT(j), ELEMENT(j - 1));
+        }
+    }
+}
 
-/* Revision history since release:
- *   1998-03-19 v1.12 First release I have any records of.
- *   2007-09-02 v1.13 Fix bug kindly reported by Dan Bodoh
- *                    (premature termination of recursion).
- *                    Add a few clarifying comments.
- *                    Minor improvements to debug output.
- *   2016-02-21 v1.14 Replace licence with 2-clause BSD,
- *                    and clarify a couple of things in
- *                    comments. No code changes.
- *   2016-03-10 v1.15 Fix bug kindly reported by Ryan Gordon
- *                    (pre-insertion-sort messed up).
- *                    Disable DEBUG_QSORT by default.
- *                    Tweak comments very slightly.
- */
+/* Returns SDL_FALSE if it gives up because the elements are too far out of place */
+static SDL_bool SDL_PartialInsertionSort(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    size_t i, j, moved = 0;
 
-/* BEGIN SDL CHANGE ... commented this out with an #if 0 block. --ryan. */
-#if 0
-#include <assert.h>
-#include <stdlib.h>
-#include <string.h>
+    for (i = 1; i < nmemb; ++i) {
+        for (j = i; j > 0 && LESS(ELEMENT(j), ELEMENT(j - 1)); --j) {
+            SDL_SwapElements(ctx, ELEMENT(j), ELEMENT(j - 1));
+        }
+        moved += i - j;
+        if (moved > SDL_SORT_PARTIAL_INSERTION_LIMIT) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
 
-#undef DEBUG_QSORT
+static void SDL_SiftDown(const SDL_SortContext *ctx, Uint8 *base, size_t root, size_t nmemb)
+{
+    for (;;) {
+        size_t child = 2 * root + 1;
 
-static char _ID[]="<qsort.c gjm 1.15 2016-03-10>";
-#endif
-/* END SDL CHANGE ... commented this out with an #if 0 block. --ryan. */
+        if (child >= nmemb) {
+            break;
+        }
+        if (child + 1 < nmemb && LESS(ELEMENT(child), ELEMENT(child + 1))) {
+            ++child;
+        }
+        if (!LESS(ELEMENT(root), ELEMENT(child))) {
+            break;
+        }
+        SDL_SwapElements(ctx, ELEMENT(root), ELEMENT(child));
+        root = child;
+    }
+}
 
-/* How many bytes are there per word? (Must be a power of 2,
- * and must in fact equal sizeof(int).)
- */
-#define WORD_BYTES sizeof(int)
+static void SDL_HeapSort(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    size_t i;
 
-/* How big does our stack need to be? Answer: one entry per
- * bit in a |size_t|.
- */
-#define STACK_SIZE (8*sizeof(size_t))
-
-/* Different situations have slightly different requirements,
- * and we make life epsilon easier by using different truncation
- * points for the three different cases.
- * So far, I have tuned TRUNC_words and guessed that the same
- * value might work well for the other two cases. Of course
- * what works well on my machine might work badly on yours.
- */
-#define TRUNC_nonaligned	12
-#define TRUNC_aligned		12
-#define TRUNC_words		12*WORD_BYTES	/* nb different meaning */
+    for (i = nmemb / 2; i > 0; --i) {
+        SDL_SiftDown(ctx, base, i - 1, nmemb);
+    }
+    for (i = nmemb - 1; i > 0; --i) {
+        SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(i));
+        SDL_SiftDown(ctx, base, 0, i);
+    }
+}
 
-/* We use a simple pivoting algorithm for shortish sub-arrays
- * and a more complicated one for larger ones. The threshold
- * is PIVOT_THRESHOLD.
- */
-#define PIVOT_THRESHOLD 40
-
-typedef struct { char * first; char * last; } stack_entry;
-#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop++].last=last;}
-#define pushRight {stack[stacktop].first=first;stack[stacktop++].last=llast;}
-#define doLeft {first=ffirst;llast=last;continue;}
-#define doRight {ffirst=first;last=llast;continue;}
-#define pop {if (--stacktop<0) break;\
-  first=ffirst=stack[stacktop].first;\
-  last=llast=stack[stacktop].last;\
-  continue;}
-
-/* Some comments on the implementation.
- * 1. When we finish partitioning the array into "low"
- *    and "high", we forget entirely about short subarrays,
- *    because they'll be done later by insertion sort.
- *    Doing lots of little insertion sorts might be a win
- *    on large datasets for locality-of-reference reasons,
- *    but it makes the code much nastier and increases
- *    bookkeeping overhead.
- * 2. We always save the shorter and get to work on the
- *    longer. This guarantees that every time we push
- *    an item onto the stack its size is <= 1/2 of that
- *    of its parent; so the stack can't need more than
- *    log_2(max-array-size) entries.
- * 3. We choose a pivot by looking at the first, last
- *    and middle elements. We arrange them into order
- *    because it's easy to do that in conjunction with
- *    choosing the pivot, and it makes things a little
- *    easier in the partitioning step. Anyway, the pivot
- *    is the middle of these three. It's still possible
- *    to construct datasets where the algorithm takes
- *    time of order n^2, but it simply never happens in
- *    practice.
- * 3' Newsflash: On further investigation I find that
- *    it's easy to construct datasets where median-of-3
- *    simply isn't good enough. So on large-ish subarrays
- *    we do a more sophisticated pivoting: we take three
- *    sets of 3 elements, find their medians, and then
- *    take the median of those.
- * 4. We copy the pivot element to a separate place
- *    because that way we can always do our comparisons
- *    directly against a pointer to that separate place,
- *    and don't have to wonder "did we move the pivot
- *    element?". This makes the inner loop better.
- * 5. It's possible to make the pivoting even more
- *    reliable by looking at more candidates when n
- *    is larger. (Taking this to its logical conclusion
- *    results in a variant of quicksort that doesn't
- *    have that n^2 worst case.) However, the overhead
- *    from the extra bookkeeping means that it's just
- *    not worth while.
- * 6. This is pretty clean and portable code. Here are
- *    all the potential portability pitfalls and problems
- *    I know of:
- *      - In one place (the insertion sort) I construct
- *        a pointer that points just past the end of the
- *        supplied array, and assume that (a) it won't
- *        compare equal to any pointer within the array,
- *        and (b) it will compare equal to a pointer
- *        obtained by stepping off the end of the array.
- *        These might fail on some segmented architectures.
- *      - I assume that there are 8 bits in a |char| when
- *        computing the size of stack needed. This would
- *        fail on machines with 9-bit or 16-bit bytes.
- *      - I assume that if |((int)base&(sizeof(int)-1))==0|
- *        and |(size&(sizeof(int)-1))==0| then it's safe to
- *        get at array elements via |int*|s, and that if
- *        actually |size==sizeof(int)| as well then it's
- *        safe to treat the elements as |int|s. This might
- *        fail on systems that convert pointers to integers
- *        in non-standard ways.
- *      - I assume that |8*sizeof(size_t)<=INT_MAX|. This
- *        would be false on a machine with 8-bit |char|s,
- *        16-bit |int|s and 4096-bit |size_t|s. :-)
+/* Partitions around the first element, with elements equal to it going right.
+   The caller makes sure there's an element that isn't less than the pivot at
+   the end, so the first scan doesn't need a bounds check.
  */
+static size_t SDL_PartitionRight(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb, SDL_bool *already_partitioned)
+{
+    const Uint8 *pivot = ELEMENT(0);
+    size_t first = 1, last = nmemb;
+
+    while (LESS(ELEMENT(first), pivot)) {
+        ++first;
+    }
+    if (first == 1) {
+        while (first < last && !LESS(ELEMENT(--last), pivot)) {
+        }
+    } else {
+        /* The element before first stops this scan */
+        while (!LESS(ELEMENT(--last), pivot)) {
+        }
+    }
 
-/* The recursion logic is the same in each case.
- * We keep chopping up until we reach subarrays of size
- * strictly less than Trunc; we leave these unsorted. */
-#define Recurse(Trunc)				\
-      { size_t l=last-ffirst,r=llast-first;	\
-        if (l<Trunc) {				\
-          if (r>=Trunc) doRight			\
-          else pop				\
-        }					\
-        else if (l<=r) { pushLeft; doRight }	\
-        else if (r>=Trunc) { pushRight; doLeft }\
-        else doLeft				\
-      }
-
-/* and so is the pivoting logic (note: last is inclusive): */
-#define Pivot(swapper,sz)			\
-  if ((size_t)(last-first)>PIVOT_THRESHOLD*sz) mid=pivot_big(first,mid,last,sz,compare);\
-  else {	\
-    if (compare(first,mid)<0) {			\
-      if (compare(mid,last)>0) {		\
-        swapper(mid,last);			\
-        if (compare(first,mid)>0) swapper(first,mid);\
-      }						\
-    }						\
-    else {					\
-      if (compare(mid,last)>0) swapper(first,last)\
-      else {					\
-        swapper(first,mid);			\
-        if (compare(mid,last)>0) swapper(mid,last);\
-      }						\
-    }						\
-    first+=sz; last-=sz;			\
-  }
-
-#ifdef DEBUG_QSORT
-#include <stdio.h>
-#endif
-
-/* and so is the partitioning logic: */
-#define Partition(swapper,sz) {			\
-  do {						\
-    while (compare(first,pivot)<0) first+=sz;	\
-    while (compare(pivot,last)<0) last-=sz;	\
-    if (first<last) {				\
-      swapper(first,last);			\
-      first+=sz; last-=sz; }			\
-    else if (first==last) { first+=sz; last-=sz; break; }\
-  } while (first<=last);			\
+    *already_partitioned = (first >= last);
+
+    while (first < last) {
+        SDL_SwapElements(ctx, ELEMENT(first), ELEMENT(last));
+        while (LESS(ELEMENT(++first), pivot)) {
+        }
+        while (!LESS(ELEMENT(--last), pivot)) {
+        }
+    }
+
+    SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(first - 1));
+    return first - 1;
 }
 
-/* and so is the pre-insertion-sort operation of putting
- * the smallest element into place as a sentinel.
- * Doing this makes the inner loop nicer. I got this
- * idea from the GNU implementation of qsort().
- * We find the smallest element from the first |nmemb|,
- * or the first |limit|, whichever is smaller;
- * therefore we must have ensured that the globally smallest
- * element is in the first |limit| (because our
- * quicksort recursion bottoms out only once we
- * reach subarrays smaller than |limit|).
+/* Partitions around the first element, with elements equal to it going left.
+   This is used when the element before the array equals the pivot, so
+   everything on the left is equal and doesn't need sorting any further.
  */
-#define PreInsertion(swapper,limit,sz)		\
-  first=base;					\
-  last=first + ((nmemb>limit ? limit : nmemb)-1)*sz;\
-  while (last!=base) {				\
-    if (compare(first,last)>0) first=last;	\
-    last-=sz; }					\
-  if (first!=base) swapper(first,(char*)base);
-
-/* and so is the insertion sort, in the first two cases: */
-#define Insertion(swapper)			\
-  last=((char*)base)+nmemb*size;		\
-  for (first=((char*)base)+size;first!=last;first+=size) {	\
-    char *test;					\
-    /* Find the right place for |first|.	\
-     * My apologies for var reuse. */		\
-    for (test=first-size;compare(test,first)>0;test-=size) ;	\
-    test+=size;					\
-    if (test!=first) {				\
-      /* Shift everything in [test,first)	\
-       * up by one, and place |first|		\
-       * where |test| is. */			\
-      memcpy(pivot,first,size);			\
-      memmove(test+size,test,first-test);	\
-      memcpy(test,pivot,size);			\
-    }						\
-  }
-
-#define SWAP_nonaligned(a,b) { \
-  register char *aa=(a),*bb=(b); \
-  register size_t sz=size; \
-  do { register char t=*aa; *aa++=*bb; *bb++=t; } while (--sz); }
-
-#define SWAP_aligned(a,b) { \
-  register int *aa=(int*)(a),*bb=(int*)(b); \
-  register size_t sz=size; \
-  do { register int t=*aa;*aa++=*bb; *bb++=t; } while (sz-=WORD_BYTES); }
-
-#define SWAP_words(a,b) { \
-  register int t=*((int*)a); *((int*)a)=*((int*)b); *((int*)b)=t; }
-
-/* ---------------------------------------------------------------------- */
-
-static char * pivot_big(char *first, char *mid, char *last, size_t size,
-                        int compare(const void *, const void *)) {
-  size_t d=(((last-first)/size)>>3)*size;
-#ifdef DEBUG_QSORT
-fprintf(stderr, "pivot_big: first=%p last=%p size=%lu n=%lu\n", first, (unsigned long)last, size, (unsigned long)((last-first+1)/size));
-#endif
-  char *m1,*m2,*m3;
-  { char *a=first, *b=first+d, *c=first+2*d;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"< %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m1 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
-  }
-  { char *a=mid-d, *b=mid, *c=mid+d;
-#ifdef DEBUG_QSORT
-fprintf(stderr,". %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m2 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
-  }
-  { char *a=last-2*d, *b=last-d, *c=last;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"> %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m3 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
-  }
-#ifdef DEBUG_QSORT
-fprintf(stderr,"-> %d %d %d @ %p %p %p\n",*(int*)m1,*(int*)m2,*(int*)m3, m1,m2,m3);
-#endif
-  return compare(m1,m2)<0 ?
-           (compare(m2,m3)<0 ? m2 : (compare(m1,m3)<0 ? m3 : m1))
-         : (compare(m1,m3)<0 ? m1 : (compare(m2,m3)<0 ? m3 : m2));
+static size_t SDL_PartitionLeft(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    const Uint8 *pivot = ELEMENT(0);
+    size_t first = 0, last = nmemb;
+
+    while (LESS(pivot, ELEMENT(--last))) {
+    }
+    if (last + 1 == nmemb) {
+        while (first < last && !LESS(pivot, ELEMENT(++first))) {
+        }
+    } else {
+        /* The element after last stops this scan */
+        while (!LESS(pivot, ELEMENT(++first))) {
+        }
+    }
+
+    while (first < last) {
+        SDL_SwapElements(ctx, ELEMENT(first), ELEMENT(last));
+        while (LESS(pivot, ELEMENT(--last))) {
+        }
+        while (!LESS(pivot, ELEMENT(++first))) {
+        }
+    }
+
+    SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(last));
+    return last;
+}
+
+/* Swaps some elements around to break up patterns that gave a bad partition */
+static void SDL_BreakPatterns(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    const size_t quarter = nmemb / 4;
+
+    if (nmemb >= SDL_SORT_INSERTION_THRESHOLD) {
+        SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(quarter));
+        SDL_SwapElements(ctx, ELEMENT(nmemb - 1), ELEMENT(nmemb - quarter));
+        if (nmemb > SDL_SORT_NINTHER_THRESHOLD) {
+            SDL_SwapElements(ctx, ELEMENT(1), ELEMENT(quarter + 1));
+            SDL_SwapElements(ctx, ELEMENT(2), ELEMENT(quarter + 2));
+            SDL_SwapElements(ctx, ELEMENT(nmemb - 2), ELEMENT(nmemb - (quarter + 1)));
+            SDL_SwapElements(ctx, ELEMENT(nmemb - 3), ELEMENT(nmemb - (quarter + 2)));
+        }
+    }
+}
+
+static void SDL_PDQSort(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb, int bad_allowed, SDL_bool leftmost)
+{
+    for (;;) {
+        size_t half, pivot, left, right;
+        SDL_bool already_partitioned, unbalanced;
+
+        if (nmemb < SDL_SORT_INSERTION_THRESHOLD) {
+            SDL_InsertionSort(ctx, base, nmemb);
+            return;
+        }
+
+        /* Move the pivot to the start */
+        half = nmemb / 2;
+        if (nmemb > SDL_SORT_NINTHER_THRESHOLD) {
+            SDL_SortThree(ctx, ELEMENT(0), ELEMENT(half), ELEMENT(nmemb - 1));
+            SDL_SortThree(ctx, ELEMENT(1), ELEMENT(half - 1), ELEMENT(nmemb - 2));
+            SDL_SortThree(ctx, ELEMENT(2), ELEMENT(half + 1), ELEMENT(nmemb - 3));
+            SDL_SortThree(ctx, ELEMENT(half - 1), ELEMENT(half), ELEMENT(half + 1));
+            SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(half));
+        } else {
+            SDL_SortThree(ctx, ELEMENT(half), ELEMENT(0), ELEMENT(nmemb - 1));
+        }
+
+        /* If the element before this range is equal to the pivot, this range
+           starts with a run of equal elements, so skip past them. */
+        if (!leftmost && !LESS(ELEMENT(-1), ELEMENT(0))) {
+            pivot = SDL_PartitionLeft(ctx, base, nmemb);
+            base = ELEMENT(pivot + 1);
+            nmemb -= pivot + 1;
+            continue;
+        }
+
+        pivot = SDL_PartitionRight(ctx, base, nmemb, &already_partitioned);
+        left = pivot;
+        right = nmemb - pivot - 1;
+
+        unbalanced = (left < nmemb / 8 || right < nmemb / 8);
+        if (unbalanced) {
+            if (--bad_allowed == 0) {
+                SDL_HeapSort(ctx, base, nmemb);
+                return;
+            }
+            SDL_BreakPatterns(ctx, base, left);
+            SDL_BreakPatterns(ctx, ELEMENT(pivot + 1), right);
+        } else if (already_partitioned &&
+                   SDL_PartialInsertionSort(ctx, base, left) &&
+                   SDL_PartialInsertionSort(ctx, ELEMENT(pivot + 1), right)) {
+            /* It looks like this was already sorted */
+            return;
+        }
+
+        /* Recurse into the smaller side so the stack stays shallow */
+        if (left < right) {
+            SDL_PDQSort(ctx, base, left, bad_allowed, leftmost);
+            base = ELEMENT(pivot + 1);
+            nmemb = right;
+            leftmost = SDL_FALSE;
+        } else {
+            SDL_PDQSort(ctx, ELEMENT(pivot + 1), right, bad_allowed, SDL_FALSE);
+            nmemb = left;
+        }
+    }
+}
+
+void SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    SDL_SortContext ctx;
+    int bad_allowed = 0;
+    size_t n;
+
+    if (!base || nmemb <= 1 || !size || !compare) {
+        return;
+    }
+
+    ctx.size = size;
+    ctx.type = SDL_GetSortElementType(base, size);
+    ctx.compare = compare;
+    ctx.userdata = userdata;
+
+    /* Allow log2(nmemb) bad partitions before falling back to heapsort */
+    for (n = nmemb; n > 1; n >>= 1) {
+        ++bad_allowed;
+    }
+    SDL_PDQSort(&ctx, (Uint8 *)base, nmemb, bad_allowed, SDL_TRUE);
 }
 
-/* ---------------------------------------------------------------------- */
-
-static void qsort_nonaligned(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(size);
-  size_t trunc=TRUNC_nonaligned*size;
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*size;
-
-  if ((size_t)(last-first)>=trunc) {
-    char *ffirst=first, *llast=last;
-    while (1) {
-      /* Select pivot */
-      { char * mid=first+size*((last-first)/size >> 1);
-        Pivot(SWAP_nonaligned,size);
-        memcpy(pivot,mid,size);
-      }
-      /* Partition. */
-      Partition(SWAP_nonaligned,size);
-      /* Prepare to recurse/iterate. */
-      Recurse(trunc)
-    }
-  }
-  PreInsertion(SWAP_nonaligned,TRUNC_nonaligned,size);
-  Insertion(SWAP_nonaligned);
-  free(pivot);
+static void SDL_ReverseElements(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb)
+{
+    size_t i;
+
+    for (i = 0; i < nmemb / 2; ++i) {
+        SDL_SwapElements(ctx, ELEMENT(i), ELEMENT(nmemb - 1 - i));
+    }
 }
 
-static void qsort_aligned(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(size);
-  size_t trunc=TRUNC_aligned*size;
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*size;
-
-  if ((size_t)(last-first)>=trunc) {
-    char *ffirst=first,*llast=last;
-    while (1) {
-      /* Select pivot */
-      { char * mid=first+size*((last-first)/size >> 1);
-        Pivot(SWAP_aligned,size);
-        memcpy(pivot,mid,size);
-      }
-      /* Partition. */
-      Partition(SWAP_aligned,size);
-      /* Prepare to recurse/iterate. */
-      Recurse(trunc)
-    }
-  }
-  PreInsertion(SWAP_aligned,TRUNC_aligned,size);
-  Insertion(SWAP_aligned);
-  free(pivot);
+static void SDL_RotateElements(const SDL_SortContext *ctx, Uint8 *base, size_t middle, size_t nmemb)
+{
+    SDL_ReverseElements(ctx, base, middle);
+    SDL_ReverseElements(ctx, ELEMENT(middle), nmemb - middle);
+    SDL_ReverseElements(ctx, base, nmemb);
 }
 
-static void qsort_words(void *base, size_t nmemb,
-           int (*compare)(const void *, const void *)) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(WORD_BYTES);
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*WORD_BYTES;
-
-  if (last-first>=TRUNC_words) {
-    char *ffirst=first, *llast=last;
-    while (1) {
-#ifdef DEBUG_QSORT
-fprintf(stderr,"Doing %d:%d: ",
-        (first-(char*)base)/WORD_BYTES,
-        (last-(char*)base)/WORD_BYTES);
-#endif
-      /* Select pivot */
-      { char * mid=first+WORD_BYTES*((last-first) / (2*WORD_BYTES));
-        Pivot(SWAP_words,WORD_BYTES);
-        *(int*)pivot=*(int*)mid;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"pivot = %p = #%lu = %d\n", mid, (unsigned long)(((int*)mid)-((int*)base)), *(int*)mid);
-#endif
-      }
-      /* Partition. */
-      Partition(SWAP_words,WORD_BYTES);
-#ifdef DEBUG_QSORT
-fprintf(stderr, "after partitioning first=#%lu last=#%lu\n", (first-(char*)base)/4lu, (last-(char*)base)/4lu);
-#endif
-      /* Prepare to recurse/iterate. */
-      Recurse(TRUNC_words)
-    }
-  }
-  PreInsertion(SWAP_words,TRUNC_words/WORD_BYTES,WORD_BYTES);
-  /* Now do insertion sort. */
-  last=((char*)base)+nmemb*WORD_BYTES;
-  for (first=((char*)base)+WORD_BYTES;first!=last;first+=WORD_BYTES) {
-    /* Find the right place for |first|. My apologies for var reuse */
-    int *pl=(int*)(first-WORD_BYTES),*pr=(int*)first;
-    *(int*)pivot=*(int*)first;
-    for (;compare(pl,pivot)>0;pr=pl,--pl) {
-      *pr=*pl; }
-    if (pr!=(int*)first) *pr=*(int*)pivot;
-  }
-  free(pivot);
+/* Merges two sorted runs in place, by rotating the middle of them around */
+static void SDL_MergeInPlace(const SDL_SortContext *ctx, Uint8 *base, size_t middle, size_t nmemb)
+{
+    size_t first_cut, second_cut, new_middle, low, high;
+
+    if (middle == 0 || middle == nmemb) {
+        return;
+    }
+    if (nmemb == 2) {
+        if (LESS(ELEMENT(1), ELEMENT(0))) {
+            SDL_SwapElements(ctx, ELEMENT(0), ELEMENT(1));
+        }
+        return;
+    }
+
+    if (middle > nmemb - middle) {
+        /* Find where the middle of the left run goes in the right run */
+        first_cut = middle / 2;
+        low = middle;
+        high = nmemb;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (LESS(ELEMENT(mid), ELEMENT(first_cut))) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        second_cut = low;
+    } else {
+        /* Find where the middle of the right run goes in the left run */
+        second_cut = middle + (nmemb - middle) / 2;
+        low = 0;
+        high = middle;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (!LESS(ELEMENT(second_cut), ELEMENT(mid))) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        first_cut = low;
+    }
+
+    SDL_RotateElements(ctx, ELEMENT(first_cut), middle - first_cut, second_cut - first_cut);
+    new_middle = first_cut + (second_cut - middle);
+    SDL_MergeInPlace(ctx, base, first_cut, new_middle);
+    SDL_MergeInPlace(ctx, ELEMENT(new_middle), second_cut - new_middle, nmemb - new_middle);
 }
 
-/* ---------------------------------------------------------------------- */
+/* Merges two sorted runs, with a copy of the left run in scratch */
+static void SDL_MergeWithBuffer(const SDL_SortContext *ctx, Uint8 *base, size_t middle, size_t nmemb, Uint8 *scratch)
+{
+    const size_t size = ctx->size;
+    Uint8 *left = scratch, *left_end = scratch + middle * size;
+    Uint8 *right = ELEMENT(middle), *right_end = ELEMENT(nmemb);
+    Uint8 *dst = base;
+    size_t i;
+
+    for (i = 0; i < middle; ++i) {
+        SDL_CopyElement(ctx, scratch + i * size, ELEMENT(i));
+    }
 
-extern void qsortG(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
+    /* Take from the left run unless the right one is strictly less, to keep it stable */
+    while (left < left_end && right < right_end) {
+        if (LESS(right, left)) {
+            SDL_CopyElement(ctx, dst, right);
+            right += size;
+        } else {
+            SDL_CopyElement(ctx, dst, left);
+            left += size;
+        }
+        dst += size;
+    }
+    while (left < left_end) {
+        SDL_CopyElement(ctx, dst, left);
+        left += size;
+        dst += size;
+    }
+}
 
-  if (nmemb<=1) return;
-  if (((size_t)base|size)&(WORD_BYTES-1))
-    qsort_nonaligned(base,nmemb,size,compare);
-  else if (size!=WORD_BYTES)
-    qsort_aligned(base,nmemb,size,compare);
-  else
-    qsort_words(base,nmemb,compare);
+static void SDL_MergeSort(const SDL_SortContext *ctx, Uint8 *base, size_t nmemb, Uint8 *scratch)
+{
+    size_t middle;
+
+    if (nmemb < SDL_SORT_INSERTION_THRESHOLD) {
+        SDL_InsertionSort(ctx, base, nmemb);
+        return;
+    }
+
+    middle = nmemb / 2;
+    SDL_MergeSort(ctx, base, middle, scratch);
+    SDL_MergeSort(ctx, ELEMENT(middle), nmemb - middle, scratch);
+    if (!LESS(ELEMENT(middle), ELEMENT(middle - 1))) {
+        /* The runs are already in order */
+        return;
+    }
+    if (scratch) {
+        SDL_MergeWithBuffer(ctx, base, middle, nmemb, scratch);
+    } else {
+        SDL_MergeInPlace(ctx, base, middle, nmemb);
+    }
 }
 
+void SDL_StableSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    SDL_SortContext ctx;
+    size_t mark;
+    Uint8 *scratch = NULL;
+
+    if (!base || nmemb <= 1 || !size || !compare) {
+        return;
+    }
+
+    /* Scratch memory is aligned well enough for whatever the elements need */
+    ctx.size = size;
+    ctx.type = SDL_GetSortElementType(base, size);
+    ctx.compare = compare;
+    ctx.userdata = userdata;
+
+    /* Merging needs room for half of the array, if that isn't available it's done in place */
+    mark = SDL_scratch_mark();
+    if (nmemb >= SDL_SORT_INSERTION_THRESHOLD && (nmemb / 2) <= SDL_SIZE_MAX / size) {
+        scratch = SDL_scratch_alloc(Uint8, (nmemb / 2) * size);
+    }
+
+    SDL_MergeSort(&ctx, (Uint8 *)base, nmemb, scratch);
+    SDL_scratch_free(mark);
+}
+
+#undef LESS
+#undef ELEMENT
+
+/* Least significant digit radix sorts, a byte at a time, for keys that can be
+   mapped to unsigned integers that sort in the same order */
+typedef enum
+{
+    SDL_SORT_KEY_UINT32,
+    SDL_SORT_KEY_SINT32,
+    SDL_SORT_KEY_FLOAT
+} SDL_SortKeyType;
+
+static SDL_INLINE Uint32 SDL_GetSortKey(const Uint8 *element, size_t key_offset, SDL_SortKeyType type)
+{
+    Uint32 key;
+    Uint8 *bytes = (Uint8 *)&key;
+
+    /* The key might not be aligned */
+    element += key_offset;
+    bytes[0] = element[0];
+    bytes[1] = element[1];
+    bytes[2] = element[2];
+    bytes[3] = element[3];
+
+    switch (type) {
+    case SDL_SORT_KEY_SINT32:
+        key ^= 0x80000000;
+        break;
+    case SDL_SORT_KEY_FLOAT:
+        /* Negative numbers sort backwards, so flip all their bits */
+        key ^= (key & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+        break;
+    default:
+        break;
+    }
+    return key;
+}
+
+static int SDLCALL SDL_CompareSortKeys(void *userdata, const void *a, const void *b)
+{
+    const size_t *key = (const size_t *)userdata;
+    const Uint32 key_a = SDL_GetSortKey((const Uint8 *)a, key[0], (SDL_SortKeyType)key[1]);
+    const Uint32 key_b = SDL_GetSortKey((const Uint8 *)b, key[0], (SDL_SortKeyType)key[1]);
+
+    return (key_a < key_b) ? -1 : (key_a > key_b);
+}
+
+static void SDL_RadixSort(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType type)
+{
+    SDL_SortContext ctx;
+    size_t mark;
+    size_t(*counts)[256] = NULL;
+    Uint8 *src, *dst, *scratch = NULL;
+    size_t i;
+    int digit;
+
+    if (!base || nmemb <= 1 || size < sizeof(Uint32) || key_offset > size - sizeof(Uint32)) {
+        return;
+    }
+
+    mark = SDL_scratch_mark();
+    if (nmemb <= SDL_SIZE_MAX / size) {
+        scratch = SDL_scratch_alloc(Uint8, nmemb * size);
+        counts = (size_t(*)[256])SDL_scratch_alloc(size_t, 4 * 256);
+    }
+    if (!scratch || !counts) {
+        /* Without somewhere to put the elements, sort by the keys in place */
+        size_t key[2];
+
+        key[0] = key_offset;
+        key[1] = (size_t)type;
+        SDL_StableSort(base, nmemb, size, SDL_CompareSortKeys, key);
+        SDL_scratch_free(mark);
+        return;
+    }
+
+    ctx.size = size;
+    ctx.type = SDL_GetSortElementType(base, size);
+
+    /* Count all the digits in one pass */
+    SDL_memset(counts, 0, 4 * 256 * sizeof(size_t));
+    src = (Uint8 *)base;
+    for (i = 0; i < nmemb; ++i, src += size) {
+        const Uint32 key = SDL_GetSortKey(src, key_offset, type);
+        ++counts[0][key & 0xFF];
+        ++counts[1][(key >> 8) & 0xFF];
+        ++counts[2][(key >> 16) & 0xFF];
+        ++counts[3][key >> 24];
+    }
+
+    src = (Uint8 *)base;
+    dst = scratch;
+    for (digit = 0; digit < 4; ++digit) {
+        const int shift = digit * 8;
+        size_t *count = counts[digit];
+        size_t total = 0;
+        Uint8 *element;
+
+        /* If every key has the same value for this digit, there's nothing to do */
+        if (count[(SDL_GetSortKey(src, key_offset, type) >> shift) & 0xFF] == nmemb) {
+            continue;
+        }
+
+        /* Turn the counts into where each digit starts */
+        for (i = 0; i < 256; ++i) {
+            const size_t n = count[i];
+            count[i] = total;
+            total += n;
+        }
+
+        element = src;
+        for (i = 0; i < nmemb; ++i, element += size) {
+            const Uint32 bucket = (SDL_GetSortKey(element, key_offset, type) >> shift) & 0xFF;
+            SDL_CopyElement(&ctx, dst + count[bucket]++ * size, element);
+        }
+
+        element = src;
+        src = dst;
+        dst = element;
+    }
+
+    if (src != (Uint8 *)base) {
+        SDL_memcpy(base, src, nmemb * size);
+    }
+    SDL_scratch_free(mark);
+}
+
+void SDL_SortByUint32Key(void *base, size_t nmemb, size_t size, size_t key_offset)
+{
+    SDL_RadixSort(base, nmemb, size, key_offset, SDL_SORT_KEY_UINT32);
+}
+
+void SDL_SortBySint32Key(void *base, size_t nmemb, size_t size, size_t key_offset)
+{
+    SDL_RadixSort(base, nmemb, size, key_offset, SDL_SORT_KEY_SINT32);
+}
+
+void SDL_SortByFloatKey(void *base, size_t nmemb, size_t size, size_t key_offset)
+{
+    SDL_RadixSort(base, nmemb, size, key_offset, SDL_SORT_KEY_FLOAT);
+}
+
+#ifdef HAVE_QSORT
+void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void *, const void *))
+{
+    qsort(base, nmemb, size, compare);
+}
+#else
+typedef struct
+{
+    int (SDLCALL *compare)(const void *, const void *);
+} SDL_qsort_context;
+
+static int SDLCALL SDL_qsort_compare(void *userdata, const void *a, const void *b)
+{
+    return ((SDL_qsort_context *)userdata)->compare(a, b);
+}
+
+void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void *, const void *))
+{
+    SDL_qsort_context context;
+
+    context.compare = compare;
+    SDL_qsort_r(base, nmemb, size, SDL_qsort_compare, &context);
+}
 #endif /* HAVE_QSORT */
 
 void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *))
@@ -558,3 +710,23 @@ void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size,
     return NULL;
 #endif /* HAVE_BSEARCH */
 }
+
+void *SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    size_t low = 0, high = nmemb;
+
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const void *element = (const Uint8 *)base + mid * size;
+        const int rc = compare(userdata, key, element);
+
+        if (rc < 0) {
+            high = mid;
+        } else if (rc > 0) {
+            low = mid + 1;
+        } else {
+            return (void *)element;
+        }
+    }
+    return NULL;
+}
@@ -612,11 +612,58 @@ void *SDL_memset(SDL_OUT_BYTECAP(len) void *dst, int c, size_t len)
 #endif /* HAVE_MEMSET */
 }
 
+/* SDL_memset4() fills with 16-byte vector stores when the compiler already targets them */
+#if defined(__APPLE__) && defined(HAVE_STRING_H)
+/* memset_pattern4() is already vectorized */
+#elif defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_MEMSET4_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && defined(__ARM_NEON)
+#define SDL_MEMSET4_NEON
+#endif
+
 /* Note that memset() is a byte assignment and this is a 32-bit assignment, so they're not directly equivalent. */
 void *SDL_memset4(void *dst, Uint32 val, size_t dwords)
 {
 #if defined(__APPLE__) && defined(HAVE_STRING_H)
     memset_pattern4(dst, &val, dwords * 4);
+#elif defined(SDL_MEMSET4_SSE2) || defined(SDL_MEMSET4_NEON)
+    Uint32 *p = SDL_static_cast(Uint32 *, dst);
+#ifdef SDL_MEMSET4_SSE2
+    const __m128i v = _mm_set1_epi32((int)val);
+#else
+    const uint32x4_t v = vdupq_n_u32(val);
+#endif
+
+    if (dwords >= 8) {
+        /* Get to a 16-byte boundary, if the destination is at least 4-byte aligned */
+        while (((uintptr_t)p & 15) && !((uintptr_t)p & 3)) {
+            *p++ = val;
+            --dwords;
+        }
+        for (; dwords >= 16; dwords -= 16, p += 16) {
+#ifdef SDL_MEMSET4_SSE2
+            _mm_storeu_si128((__m128i *)(p + 0), v);
+            _mm_storeu_si128((__m128i *)(p + 4), v);
+            _mm_storeu_si128((__m128i *)(p + 8), v);
+            _mm_storeu_si128((__m128i *)(p + 12), v);
+#else
+            vst1q_u32(p + 0, v);
+            vst1q_u32(p + 4, v);
+            vst1q_u32(p + 8, v);
+            vst1q_u32(p + 12, v);
+#endif
+        }
+        for (; dwords >= 4; dwords -= 4, p += 4) {
+#ifdef SDL_MEMSET4_SSE2
+            _mm_storeu_si128((__m128i *)p, v);
+#else
+            vst1q_u32(p, v);
+#endif
+        }
+    }
+    while (dwords--) {
+        *p++ = val;
+    }
 #elif defined(__GNUC__) && defined(__i386__)
     int u0, u1, u2;
     __asm__ __volatile__(
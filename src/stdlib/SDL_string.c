@@ -36,6 +36,54 @@
 #define UTF8_IsLeadByte(c)     ((c) >= 0xC0 && (c) <= 0xF4)
 #define UTF8_IsTrailingByte(c) ((c) >= 0x80 && (c) <= 0xBF)
 
+#if !defined(HAVE_STRLEN) || (!defined(HAVE_STRCHR) && !defined(HAVE_INDEX)) || (!defined(HAVE_MEMCMP) && !defined(__vita__)) || !defined(HAVE_MEMMOVE)
+/* Word at a time and SIMD versions of the core string functions, for when
+   there isn't a C runtime to provide them.
+
+   The string scans use aligned loads, which can read past the end of the
+   string but never into the next page, the same way C runtimes do it.
+ */
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_STRING_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && defined(__ARM_NEON)
+#define SDL_STRING_NEON
+#endif
+
+#ifdef __GNUC__
+typedef size_t __attribute__((__may_alias__)) SDL_StringWord;
+#else
+typedef size_t SDL_StringWord;
+#endif
+
+#define SDL_STRING_WORD_SIZE  sizeof(SDL_StringWord)
+#define SDL_STRING_WORD_ONES  ((SDL_StringWord)-1 / 0xFF)
+#define SDL_STRING_WORD_HIGHS (SDL_STRING_WORD_ONES * 0x80)
+#define SDL_STRING_WORD_HAS_ZERO(x) ((((x) - SDL_STRING_WORD_ONES) & ~(x) & SDL_STRING_WORD_HIGHS) != 0)
+
+/* x must not be 0 */
+static SDL_INLINE int SDL_LowestBitIndex(Uint64 x)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(x);
+#else
+    int index = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+#ifdef SDL_STRING_NEON
+/* NEON doesn't have movemask, so narrow the comparison to 4 bits per byte */
+static SDL_INLINE Uint64 SDL_NEONByteMask(uint8x16_t cmp)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+}
+#endif
+#endif /* string primitives */
+
 static size_t UTF8_GetTrailingBytes(unsigned char c)
 {
     if (c >= 0xC0 && c <= 0xDF) {
@@ -330,18 +378,66 @@ void *SDL_memmove(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
 #ifdef HAVE_MEMMOVE
     return memmove(dst, src, len);
 #else
-    char *srcp = (char *)src;
-    char *dstp = (char *)dst;
+    const Uint8 *srcp = (const Uint8 *)src;
+    Uint8 *dstp = (Uint8 *)dst;
+
+    if ((uintptr_t)dstp + len <= (uintptr_t)srcp || (uintptr_t)srcp + len <= (uintptr_t)dstp) {
+        /* No overlap */
+        return SDL_memcpy(dst, src, len);
+    }
 
-    if (src < dst) {
-        srcp += len - 1;
-        dstp += len - 1;
+    /* Copy in the direction that reads each chunk before it's overwritten */
+    if (dstp < srcp) {
+#if defined(SDL_STRING_SSE2)
+        for (; len >= 16; len -= 16, srcp += 16, dstp += 16) {
+            _mm_storeu_si128((__m128i *)dstp, _mm_loadu_si128((const __m128i *)srcp));
+        }
+#elif defined(SDL_STRING_NEON)
+        for (; len >= 16; len -= 16, srcp += 16, dstp += 16) {
+            vst1q_u8(dstp, vld1q_u8(srcp));
+        }
+#else
+        if ((((uintptr_t)srcp ^ (uintptr_t)dstp) & (SDL_STRING_WORD_SIZE - 1)) == 0) {
+            for (; len && ((uintptr_t)srcp & (SDL_STRING_WORD_SIZE - 1)); --len) {
+                *dstp++ = *srcp++;
+            }
+            for (; len >= SDL_STRING_WORD_SIZE; len -= SDL_STRING_WORD_SIZE, srcp += SDL_STRING_WORD_SIZE, dstp += SDL_STRING_WORD_SIZE) {
+                *(SDL_StringWord *)dstp = *(const SDL_StringWord *)srcp;
+            }
+        }
+#endif
         while (len--) {
-            *dstp-- = *srcp--;
+            *dstp++ = *srcp++;
         }
     } else {
+        srcp += len;
+        dstp += len;
+#if defined(SDL_STRING_SSE2)
+        for (; len >= 16; len -= 16) {
+            srcp -= 16;
+            dstp -= 16;
+            _mm_storeu_si128((__m128i *)dstp, _mm_loadu_si128((const __m128i *)srcp));
+        }
+#elif defined(SDL_STRING_NEON)
+        for (; len >= 16; len -= 16) {
+            srcp -= 16;
+            dstp -= 16;
+            vst1q_u8(dstp, vld1q_u8(srcp));
+        }
+#else
+        if ((((uintptr_t)srcp ^ (uintptr_t)dstp) & (SDL_STRING_WORD_SIZE - 1)) == 0) {
+            for (; len && ((uintptr_t)srcp & (SDL_STRING_WORD_SIZE - 1)); --len) {
+                *--dstp = *--srcp;
+            }
+            for (; len >= SDL_STRING_WORD_SIZE; len -= SDL_STRING_WORD_SIZE) {
+                srcp -= SDL_STRING_WORD_SIZE;
+                dstp -= SDL_STRING_WORD_SIZE;
+                *(SDL_StringWord *)dstp = *(const SDL_StringWord *)srcp;
+            }
+        }
+#endif
         while (len--) {
-            *dstp++ = *srcp++;
+            *--dstp = *--srcp;
         }
     }
     return dst;
@@ -364,8 +460,34 @@ int SDL_memcmp(const void *s1, const void *s2, size_t len)
 #elif defined(HAVE_MEMCMP)
     return memcmp(s1, s2, len);
 #else
-    char *s1p = (char *)s1;
-    char *s2p = (char *)s2;
+    const Uint8 *s1p = (const Uint8 *)s1;
+    const Uint8 *s2p = (const Uint8 *)s2;
+
+    /* Skip the matching part quickly, and then find the difference a byte at a time */
+#if defined(SDL_STRING_SSE2)
+    for (; len >= 16; len -= 16, s1p += 16, s2p += 16) {
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)s1p), _mm_loadu_si128((const __m128i *)s2p)));
+        if (mask != 0xFFFF) {
+            const int i = SDL_LowestBitIndex((Uint64)(~mask & 0xFFFF));
+            return s1p[i] - s2p[i];
+        }
+    }
+#elif defined(SDL_STRING_NEON)
+    for (; len >= 16; len -= 16, s1p += 16, s2p += 16) {
+        const Uint64 mask = SDL_NEONByteMask(vmvnq_u8(vceqq_u8(vld1q_u8(s1p), vld1q_u8(s2p))));
+        if (mask) {
+            const int i = SDL_LowestBitIndex(mask) / 4;
+            return s1p[i] - s2p[i];
+        }
+    }
+#else
+    if ((((uintptr_t)s1p | (uintptr_t)s2p) & (SDL_STRING_WORD_SIZE - 1)) == 0) {
+        for (; len >= SDL_STRING_WORD_SIZE && *(const SDL_StringWord *)s1p == *(const SDL_StringWord *)s2p; len -= SDL_STRING_WORD_SIZE) {
+            s1p += SDL_STRING_WORD_SIZE;
+            s2p += SDL_STRING_WORD_SIZE;
+        }
+    }
+#endif
     while (len--) {
         if (*s1p != *s2p) {
             return *s1p - *s2p;
@@ -381,12 +503,43 @@ size_t SDL_strlen(const char *string)
 {
 #ifdef HAVE_STRLEN
     return strlen(string);
+#elif defined(SDL_STRING_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const char *aligned = (const char *)((uintptr_t)string & ~(uintptr_t)15);
+    Uint32 mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)aligned), zero));
+
+    /* Ignore anything before the start of the string */
+    mask &= ~0u << ((uintptr_t)string & 15);
+    while (!mask) {
+        aligned += 16;
+        mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)aligned), zero));
+    }
+    return (size_t)(aligned + SDL_LowestBitIndex(mask) - string);
+#elif defined(SDL_STRING_NEON)
+    const char *aligned = (const char *)((uintptr_t)string & ~(uintptr_t)15);
+    Uint64 mask = SDL_NEONByteMask(vceqq_u8(vld1q_u8((const Uint8 *)aligned), vdupq_n_u8(0)));
+
+    /* Ignore anything before the start of the string */
+    mask &= ~(Uint64)0 << (((uintptr_t)string & 15) * 4);
+    while (!mask) {
+        aligned += 16;
+        mask = SDL_NEONByteMask(vceqq_u8(vld1q_u8((const Uint8 *)aligned), vdupq_n_u8(0)));
+    }
+    return (size_t)(aligned + SDL_LowestBitIndex(mask) / 4 - string);
 #else
-    size_t len = 0;
-    while (*string++) {
-        ++len;
+    const char *p = string;
+    const SDL_StringWord *word;
+
+    for (; (uintptr_t)p & (SDL_STRING_WORD_SIZE - 1); ++p) {
+        if (!*p) {
+            return (size_t)(p - string);
+        }
     }
-    return len;
+    for (word = (const SDL_StringWord *)p; !SDL_STRING_WORD_HAS_ZERO(*word); ++word) {
+    }
+    for (p = (const char *)word; *p; ++p) {
+    }
+    return (size_t)(p - string);
 #endif /* HAVE_STRLEN */
 }
 
@@ -790,13 +943,55 @@ char *SDL_strchr(const char *string, int c)
 #elif defined(HAVE_INDEX)
     return SDL_const_cast(char *, index(string, c));
 #else
-    while (*string) {
-        if (*string == c) {
-            return (char *)string;
+    const char ch = (char)c;
+#if defined(SDL_STRING_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i needle = _mm_set1_epi8(ch);
+    const char *aligned = (const char *)((uintptr_t)string & ~(uintptr_t)15);
+    __m128i data = _mm_load_si128((const __m128i *)aligned);
+    Uint32 mask = (Uint32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, needle)));
+
+    /* Ignore anything before the start of the string */
+    mask &= ~0u << ((uintptr_t)string & 15);
+    while (!mask) {
+        aligned += 16;
+        data = _mm_load_si128((const __m128i *)aligned);
+        mask = (Uint32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, needle)));
+    }
+    string = aligned + SDL_LowestBitIndex(mask);
+#elif defined(SDL_STRING_NEON)
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t needle = vdupq_n_u8((Uint8)ch);
+    const char *aligned = (const char *)((uintptr_t)string & ~(uintptr_t)15);
+    uint8x16_t data = vld1q_u8((const Uint8 *)aligned);
+    Uint64 mask = SDL_NEONByteMask(vorrq_u8(vceqq_u8(data, zero), vceqq_u8(data, needle)));
+
+    /* Ignore anything before the start of the string */
+    mask &= ~(Uint64)0 << (((uintptr_t)string & 15) * 4);
+    while (!mask) {
+        aligned += 16;
+        data = vld1q_u8((const Uint8 *)aligned);
+        mask = SDL_NEONByteMask(vorrq_u8(vceqq_u8(data, zero), vceqq_u8(data, needle)));
+    }
+    string = aligned + SDL_LowestBitIndex(mask) / 4;
+#else
+    const SDL_StringWord pattern = SDL_STRING_WORD_ONES * (Uint8)ch;
+    const SDL_StringWord *word;
+
+    for (; (uintptr_t)string & (SDL_STRING_WORD_SIZE - 1); ++string) {
+        if (!*string || *string == ch) {
+            break;
+        }
+    }
+    if (*string && *string != ch) {
+        for (word = (const SDL_StringWord *)string; !SDL_STRING_WORD_HAS_ZERO(*word) && !SDL_STRING_WORD_HAS_ZERO(*word ^ pattern); ++word) {
+        }
+        for (string = (const char *)word; *string && *string != ch; ++string) {
         }
-        ++string;
     }
-    if (c == '\0') {
+#endif
+    /* We stopped at either the character or the end of the string */
+    if (*string == ch) {
         return (char *)string;
     }
     return NULL;
@@ -853,14 +1048,71 @@ char *SDL_strcasestr(const char *haystack, const char *needle)
 #endif /* HAVE_STRCASESTR */
 }
 
-#if !defined(HAVE__LTOA) || !defined(HAVE__I64TOA) || \
-    !defined(HAVE__ULTOA) || !defined(HAVE__UI64TOA)
+#if !defined(HAVE__ULTOA) || !defined(HAVE__UI64TOA)
 static const char ntoa_table[] = {
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
     'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T',
     'U', 'V', 'W', 'X', 'Y', 'Z'
 };
+
+/* Decimal numbers are converted two digits at a time */
+static const char ntoa_decimal_pairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/* This is big enough for a 64-bit number in binary */
+#define SDL_NTOA_BUFFER_SIZE 64
+
+/* Writes the digits backwards, ending at end, and returns where they start */
+static char *SDL_FormatDigits(char *end, Uint64 value, int radix)
+{
+    char *p = end;
+
+    if (radix == 10) {
+        Uint32 small;
+
+        /* Only use 64-bit division while we need to */
+        while (value > 0xFFFFFFFF) {
+            const Uint64 quotient = value / 100;
+            const char *pair = &ntoa_decimal_pairs[(value - quotient * 100) * 2];
+            *--p = pair[1];
+            *--p = pair[0];
+            value = quotient;
+        }
+        small = (Uint32)value;
+        while (small >= 100) {
+            const Uint32 quotient = small / 100;
+            const char *pair = &ntoa_decimal_pairs[(small - quotient * 100) * 2];
+            *--p = pair[1];
+            *--p = pair[0];
+            small = quotient;
+        }
+        if (small >= 10) {
+            *--p = ntoa_decimal_pairs[small * 2 + 1];
+            *--p = ntoa_decimal_pairs[small * 2];
+        } else {
+            *--p = ntoa_table[small];
+        }
+    } else if (radix >= 2 && (radix & (radix - 1)) == 0) {
+        const unsigned int mask = (unsigned int)radix - 1;
+        int shift = 0;
+
+        while ((1 << shift) < radix) {
+            ++shift;
+        }
+        do {
+            *--p = ntoa_table[value & mask];
+            value >>= shift;
+        } while (value);
+    } else {
+        do {
+            *--p = ntoa_table[value % radix];
+            value /= radix;
+        } while (value);
+    }
+    return p;
+}
 #endif /* ntoa() conversion table */
 
 char *SDL_itoa(int value, char *string, int radix)
@@ -890,7 +1142,7 @@ char *SDL_ltoa(long value, char *string, int radix)
 
     if (value < 0) {
         *bufp++ = '-';
-        SDL_ultoa(-value, bufp, radix);
+        SDL_ultoa(0UL - (unsigned long)value, bufp, radix);
     } else {
         SDL_ultoa(value, bufp, radix);
     }
@@ -904,21 +1156,13 @@ char *SDL_ultoa(unsigned long value, char *string, int radix)
 #ifdef HAVE__ULTOA
     return _ultoa(value, string, radix);
 #else
-    char *bufp = string;
-
-    if (value) {
-        while (value > 0) {
-            *bufp++ = ntoa_table[value % radix];
-            value /= radix;
-        }
-    } else {
-        *bufp++ = '0';
-    }
-    *bufp = '\0';
-
-    /* The numbers went into the string backwards. :) */
-    SDL_strrev(string);
+    char buffer[SDL_NTOA_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = SDL_FormatDigits(end, value, radix);
+    const size_t length = (size_t)(end - digits);
 
+    SDL_memcpy(string, digits, length);
+    string[length] = '\0';
     return string;
 #endif /* HAVE__ULTOA */
 }
@@ -932,7 +1176,7 @@ char *SDL_lltoa(Sint64 value, char *string, int radix)
 
     if (value < 0) {
         *bufp++ = '-';
-        SDL_ulltoa(-value, bufp, radix);
+        SDL_ulltoa(0 - (Uint64)value, bufp, radix);
     } else {
         SDL_ulltoa(value, bufp, radix);
     }
@@ -946,21 +1190,13 @@ char *SDL_ulltoa(Uint64 value, char *string, int radix)
 #ifdef HAVE__UI64TOA
     return _ui64toa(value, string, radix);
 #else
-    char *bufp = string;
-
-    if (value) {
-        while (value > 0) {
-            *bufp++ = ntoa_table[value % radix];
-            value /= radix;
-        }
-    } else {
-        *bufp++ = '0';
-    }
-    *bufp = '\0';
-
-    /* The numbers went into the string backwards. :) */
-    SDL_strrev(string);
+    char buffer[SDL_NTOA_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = SDL_FormatDigits(end, value, radix);
+    const size_t length = (size_t)(end - digits);
 
+    SDL_memcpy(string, digits, length);
+    string[length] = '\0';
     return string;
 #endif /* HAVE__UI64TOA */
 }
@@ -1662,22 +1898,23 @@ static size_t SDL_PrintString(char *text, size_t maxlen, SDL_FormatInfo *info, c
         length += width;
     }
 
-    SDL_strlcpy(text, string, maxlen);
-    length += sz;
+    slen = sz;
+    if (info && info->precision >= 0 && (size_t)info->precision < sz) {
+        slen = (size_t)info->precision;
+    }
+    length += slen;
+
+    if (maxlen > 0) {
+        const size_t copylen = SDL_min(slen, maxlen - 1);
 
-    if (info) {
-        if (info->precision >= 0 && (size_t)info->precision < sz) {
-            slen = (size_t)info->precision;
-            if (slen < maxlen) {
-                text[slen] = '\0';
-            }
-            length -= (sz - slen);
-        }
-        if (maxlen > 1) {
-            if (info->force_case == SDL_CASE_LOWER) {
-                SDL_strlwr(text);
-            } else if (info->force_case == SDL_CASE_UPPER) {
-                SDL_strupr(text);
+        SDL_memcpy(text, string, copylen);
+        text[copylen] = '\0';
+
+        if (info && info->force_case != SDL_CASE_NOCHANGE) {
+            size_t i;
+
+            for (i = 0; i < copylen; ++i) {
+                text[i] = (char)((info->force_case == SDL_CASE_LOWER) ? SDL_tolower((unsigned char)text[i]) : SDL_toupper((unsigned char)text[i]));
             }
         }
     }
@@ -1780,12 +2017,35 @@ static size_t SDL_PrintUnsignedLongLong(char *text, size_t maxlen, SDL_FormatInf
 
 static size_t SDL_PrintFloat(char *text, size_t maxlen, SDL_FormatInfo *info, double arg, SDL_bool g)
 {
+    /* The fraction is formatted as an integer when it can be scaled to fit in one */
+    static const Uint64 powers_of_ten[] = {
+        1ULL,
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+        10000000000ULL,
+        100000000000ULL,
+        1000000000000ULL,
+        10000000000000ULL,
+        100000000000000ULL,
+        1000000000000000ULL,
+        10000000000000000ULL,
+        100000000000000000ULL,
+        1000000000000000000ULL,
+        10000000000000000000ULL
+    };
+    const char decimal_separator = '.';
     char num[327];
     size_t length = 0;
+    size_t sign_length;
     size_t integer_length;
     int precision = info->precision;
-
-    /* This isn't especially accurate, but hey, it's easy. :) */
     Uint64 value;
 
     if (arg < 0) {
@@ -1794,6 +2054,16 @@ static size_t SDL_PrintFloat(char *text, size_t maxlen, SDL_FormatInfo *info, do
     } else if (info->force_sign) {
         num[length++] = '+';
     }
+    sign_length = length;
+
+    if (arg != arg || arg - arg != 0.0) {
+        /* NaN or infinity */
+        SDL_strlcpy(&num[length], (arg != arg) ? "nan" : "inf", sizeof(num) - length);
+        info->precision = -1;
+        info->pad_zeroes = SDL_FALSE;
+        return SDL_PrintString(text, maxlen, info, num);
+    }
+
     value = (Uint64)arg;
     integer_length = SDL_PrintUnsignedLongLong(&num[length], sizeof(num) - length, NULL, value);
     length += integer_length;
@@ -1805,8 +2075,43 @@ static size_t SDL_PrintFloat(char *text, size_t maxlen, SDL_FormatInfo *info, do
         /* The precision includes the integer portion */
         precision -= SDL_min((int)integer_length, precision);
     }
-    if (info->force_type || precision > 0) {
-        const char decimal_separator = '.';
+    if (precision < (int)SDL_arraysize(powers_of_ten)) {
+        /* Round the whole fraction once, ties to even like the C runtime, and write out its digits */
+        const Uint64 scale = powers_of_ten[precision];
+        const double scaled = arg * (double)scale;
+        Uint64 fraction = (Uint64)scaled;
+        const double remainder = scaled - (double)fraction;
+        int i;
+
+        if (remainder > 0.5) {
+            ++fraction;
+        } else if (remainder == 0.5) {
+            /* The multiplication may have rounded onto the tie, so check what it lost (Dekker's product) */
+            const double split = 134217729.0; /* 2^27 + 1 */
+            const double a_split = arg * split, b_split = (double)scale * split;
+            const double a_hi = a_split - (a_split - arg), a_lo = arg - a_hi;
+            const double b_hi = b_split - (b_split - (double)scale), b_lo = (double)scale - b_hi;
+            const double error = (((a_hi * b_hi - scaled) + a_hi * b_lo) + a_lo * b_hi) + a_lo * b_lo;
+
+            if (error > 0.0 || (error == 0.0 && ((precision > 0 ? fraction : value) & 1))) {
+                ++fraction;
+            }
+        }
+        if (fraction >= scale) {
+            /* Carry the one... */
+            fraction -= scale;
+            ++value;
+            length = sign_length + SDL_PrintUnsignedLongLong(&num[sign_length], sizeof(num) - sign_length, NULL, value);
+        }
+        if (info->force_type || precision > 0) {
+            num[length++] = decimal_separator;
+            for (i = precision; i--; ) {
+                num[length + i] = (char)('0' + (fraction % 10));
+                fraction /= 10;
+            }
+            length += precision;
+        }
+    } else {
         double integer_value;
 
         SDL_assert(length < sizeof(num));
@@ -1849,22 +2154,22 @@ static size_t SDL_PrintFloat(char *text, size_t maxlen, SDL_FormatInfo *info, do
                 num[length++] = '0' + (char)integer_value;
             }
         }
+    }
 
-        if (g) {
-            /* Trim trailing zeroes and decimal separator */
-            size_t i;
+    if (g && (info->force_type || precision > 0)) {
+        /* Trim trailing zeroes and decimal separator */
+        size_t i;
 
-            for (i = length - 1; num[i] != decimal_separator; --i) {
-                if (num[i] == '0') {
-                    --length;
-                } else {
-                    break;
-                }
-            }
-            if (num[i] == decimal_separator) {
+        for (i = length - 1; num[i] != decimal_separator; --i) {
+            if (num[i] == '0') {
                 --length;
+            } else {
+                break;
             }
         }
+        if (num[i] == decimal_separator) {
+            --length;
+        }
     }
     num[length] = '\0';
 
@@ -2106,11 +2411,15 @@ int SDL_vsnprintf(SDL_OUT_Z_CAP(maxlen) char *text, size_t maxlen, const char *f
                 ++fmt;
             }
         } else {
+            /* Copy everything up to the next format specifier at once */
+            const char *spec = SDL_strchr(fmt, '%');
+            const size_t len = spec ? (size_t)(spec - fmt) : SDL_strlen(fmt);
+
             if (length < maxlen) {
-                text[length] = *fmt;
+                SDL_memcpy(&text[length], fmt, SDL_min(len, maxlen - length));
             }
-            ++fmt;
-            ++length;
+            fmt += len;
+            length += len;
         }
     }
     if (length < maxlen) {
@@ -1079,6 +1079,15 @@ static void SDLTest_PrintPixelFormat(char *text, size_t maxlen, Uint32 format)
     case SDL_PIXELFORMAT_NV21:
         SDL_snprintfcat(text, maxlen, "NV21");
         break;
+    case SDL_PIXELFORMAT_P010:
+        SDL_snprintfcat(text, maxlen, "P010");
+        break;
+    case SDL_PIXELFORMAT_P016:
+        SDL_snprintfcat(text, maxlen, "P016");
+        break;
+    case SDL_PIXELFORMAT_I444:
+        SDL_snprintfcat(text, maxlen, "I444");
+        break;
     default:
         SDL_snprintfcat(text, maxlen, "0x%8.8x", format);
         break;
@@ -1505,8 +1514,18 @@ SDL_bool SDLTest_CommonInit(SDLTest_CommonState *state)
             }
 
             if (!state->skip_renderer && (state->renderdriver || !(state->window_flags & (SDL_WINDOW_OPENGL | SDL_WINDOW_VULKAN | SDL_WINDOW_METAL)))) {
-                state->renderers[i] = SDL_CreateRenderer(state->windows[i],
-                                                         state->renderdriver, state->render_flags);
+                if (state->render_stats) {
+                    SDL_PropertiesID renderer_props = SDL_CreateProperties();
+                    SDL_SetProperty(renderer_props, "window", state->windows[i]);
+                    SDL_SetStringProperty(renderer_props, "name", (state->render_flags & SDL_RENDERER_SOFTWARE) ? "software" : state->renderdriver);
+                    SDL_SetBooleanProperty(renderer_props, "present_vsync", (state->render_flags & SDL_RENDERER_PRESENTVSYNC) != 0);
+                    SDL_SetBooleanProperty(renderer_props, "stats", SDL_TRUE);
+                    state->renderers[i] = SDL_CreateRendererWithProperties(renderer_props);
+                    SDL_DestroyProperties(renderer_props);
+                } else {
+                    state->renderers[i] = SDL_CreateRenderer(state->windows[i],
+                                                             state->renderdriver, state->render_flags);
+                }
                 if (!state->renderers[i]) {
                     SDL_Log("Couldn't create renderer: %s\n",
                             SDL_GetError());
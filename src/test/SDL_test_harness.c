@@ -348,6 +348,30 @@ static void SDLTest_LogTestSuiteSummary(SDLTest_TestSuiteReference *testSuites)
 }
 #endif
 
+/* Runtime of a single test case, for the slowest test report */
+typedef struct SDLTest_TestTiming
+{
+    const char *suiteName;
+    const char *testName;
+    float runtime;
+} SDLTest_TestTiming;
+
+/* Number of slowest test cases listed at the end of a run */
+#define SDLTEST_SLOWEST_TESTS_COUNT 10
+
+static int SDLCALL SDLTest_CompareTestTimings(const void *a, const void *b)
+{
+    const SDLTest_TestTiming *A = (const SDLTest_TestTiming *)a;
+    const SDLTest_TestTiming *B = (const SDLTest_TestTiming *)b;
+
+    if (A->runtime > B->runtime) {
+        return -1;
+    } else if (A->runtime < B->runtime) {
+        return 1;
+    }
+    return 0;
+}
+
 /* Gets a timer value in seconds */
 static float GetClock(void)
 {
@@ -358,18 +382,38 @@ static float GetClock(void)
 /**
  * Execute a test suite using the given run seed and execution key.
  *
+ * \param testSuites Suites containing the test case.
+ * \param userRunSeed Custom run seed provided by user, or NULL to autogenerate one.
+ * \param userExecKey Custom execution key provided by user, or 0 to autogenerate one.
+ * \param filter Filter specification. NULL disables. Case sensitive.
+ * \param testIterations Number of iterations to run each test case.
+ *
+ * \returns Test run result; 0 when all tests passed, 1 if any tests failed.
+ */
+int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations)
+{
+    return SDLTest_RunSuitesShard(testSuites, userRunSeed, userExecKey, filter, testIterations, 0, 1);
+}
+
+/**
+ * Execute one shard of the test suites using the given run seed and execution key.
+ *
  * The filter string is matched to the suite name (full comparison) to select a single suite,
  * or if no suite matches, it is matched to the test names (full comparison) to select a single test.
  *
+ * Suite N runs in shard N % shardCount.
+ *
  * \param testSuites Suites containing the test case.
  * \param userRunSeed Custom run seed provided by user, or NULL to autogenerate one.
  * \param userExecKey Custom execution key provided by user, or 0 to autogenerate one.
  * \param filter Filter specification. NULL disables. Case sensitive.
  * \param testIterations Number of iterations to run each test case.
+ * \param shardIndex The shard to run, from 0 to shardCount-1.
+ * \param shardCount The number of shards the suites are split into.
  *
  * \returns Test run result; 0 when all tests passed, 1 if any tests failed.
  */
-int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations)
+int SDLTest_RunSuitesShard(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations, int shardIndex, int shardCount)
 {
     int totalNumberOfTests = 0;
     int failedNumberOfTests = 0;
@@ -404,6 +448,8 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     int testSkippedCount = 0;
     int countSum = 0;
     const SDLTest_TestCaseReference **failedTests;
+    SDLTest_TestTiming *testTimings;
+    int timedNumberOfTests = 0;
     char generatedSeed[16 + 1];
 
     /* Sanitize test iterations */
@@ -411,6 +457,12 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
         testIterations = 1;
     }
 
+    /* Sanitize shards */
+    if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+        SDLTest_LogError("Invalid shard %d/%d", shardIndex, shardCount);
+        return 2;
+    }
+
     /* Generate run see if we don't have one already */
     if (!userRunSeed || userRunSeed[0] == '\0') {
         char *tmp = SDLTest_GenerateRunSeed(16);
@@ -435,6 +487,9 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
 
     /* Log run with fuzzer parameters */
     SDLTest_Log("::::: Test Run /w seed '%s' started\n", runSeed);
+    if (shardCount > 1) {
+        SDLTest_Log("Sharding: running shard %d of %d", shardIndex, shardCount);
+    }
 
     /* Count the total number of tests */
     suiteCounter = 0;
@@ -461,6 +516,15 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
         return -1;
     }
 
+    /* ... and one for the runtime of each test case */
+    testTimings = (SDLTest_TestTiming *)SDL_malloc(totalNumberOfTests * sizeof(SDLTest_TestTiming));
+    if (!testTimings) {
+        SDLTest_LogError("Unable to allocate cache for test timings");
+        SDL_Error(SDL_ENOMEM);
+        SDL_free((void *)failedTests);
+        return -1;
+    }
+
     /* Initialize filtering */
     if (filter && filter[0] != '\0') {
         /* Loop over all suites to check if we have a filter match */
@@ -509,6 +573,7 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
             }
             SDLTest_Log("Exit code: 2");
             SDL_free((void *)failedTests);
+            SDL_free(testTimings);
             return 2;
         }
     }
@@ -527,6 +592,12 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
             SDLTest_Log("===== Test Suite %i: '%s' " COLOR_BLUE "skipped" COLOR_END "\n",
                         suiteCounter,
                         currentSuiteName);
+        } else if (((suiteCounter - 1) % shardCount) != shardIndex) {
+            /* Suite belongs to another shard */
+            SDLTest_Log("===== Test Suite %i: '%s' " COLOR_BLUE "skipped (shard %d)" COLOR_END "\n",
+                        suiteCounter,
+                        currentSuiteName,
+                        (suiteCounter - 1) % shardCount);
         } else {
 
             /* Reset per-suite counters */
@@ -619,6 +690,11 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
                         SDLTest_Log("Total Test runtime: %.1f sec", runtime);
                     }
 
+                    testTimings[timedNumberOfTests].suiteName = currentSuiteName;
+                    testTimings[timedNumberOfTests].testName = currentTestName;
+                    testTimings[timedNumberOfTests].runtime = runtime;
+                    timedNumberOfTests++;
+
                     /* Log final test result */
                     switch (testResult) {
                     case TEST_RESULT_PASSED:
@@ -672,6 +748,18 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     /* Log total runtime */
     SDLTest_Log("Total Run runtime: %.1f sec", runtime);
 
+    /* Log the slowest tests */
+    if (timedNumberOfTests > 1) {
+        const int count = SDL_min(timedNumberOfTests, SDLTEST_SLOWEST_TESTS_COUNT);
+        SDL_qsort(testTimings, timedNumberOfTests, sizeof(*testTimings), SDLTest_CompareTestTimings);
+        SDLTest_Log("Slowest tests:");
+        for (testCounter = 0; testCounter < count; testCounter++) {
+            SDLTest_Log("  %8.3f sec  %s/%s", testTimings[testCounter].runtime,
+                        testTimings[testCounter].suiteName, testTimings[testCounter].testName);
+        }
+    }
+    SDL_free(testTimings);
+
     /* Log summary and final run result */
     countSum = totalTestPassedCount + totalTestFailedCount + totalTestSkippedCount;
     if (totalTestFailedCount == 0) {
@@ -0,0 +1,199 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_LOCK_PROFILING
+
+#include "SDL_lockprofile.h"
+
+/* This is how many spinlocks can be named */
+#define MAX_SPINLOCK_PROFILES 64
+
+struct SDL_LockProfile
+{
+    char *name;
+    SDL_SpinLock lock;
+    Uint64 acquisitions;
+    Uint64 contended;
+    Uint64 wait_ticks;
+    Uint64 max_wait_ticks;
+    Uint64 hold_ticks;
+    Uint64 max_hold_ticks;
+    struct SDL_LockProfile *next;
+};
+
+struct SDL_SpinLockProfile
+{
+    SDL_SpinLock *lock;
+    SDL_LockProfile *profile;
+    Uint64 hold_start; /* Only touched while holding the spinlock */
+};
+
+static SDL_SpinLock SDL_lock_profiles_lock;
+static SDL_LockProfile *SDL_lock_profiles;
+static SDL_SpinLockProfile SDL_spinlock_profiles[MAX_SPINLOCK_PROFILES];
+static SDL_AtomicInt SDL_num_spinlock_profiles;
+
+/* SDL_AtomicLock() looks up profiles, so we can't use it here */
+static void LockProfileLock(SDL_SpinLock *lock)
+{
+    while (!SDL_AtomicTryLock(lock)) {
+        SDL_CPUPauseInstruction();
+    }
+}
+
+SDL_LockProfile *SDL_GetLockProfile(const char *name)
+{
+    SDL_LockProfile *profile;
+
+    LockProfileLock(&SDL_lock_profiles_lock);
+    for (profile = SDL_lock_profiles; profile; profile = profile->next) {
+        if (SDL_strcmp(profile->name, name) == 0) {
+            break;
+        }
+    }
+    if (!profile) {
+        /* These outlive SDL_Quit(), since locks may be used after it, so use the original allocator */
+        SDL_calloc_func calloc_func;
+        size_t length = SDL_strlen(name) + 1;
+
+        SDL_GetOriginalMemoryFunctions(NULL, &calloc_func, NULL, NULL);
+        profile = (SDL_LockProfile *)calloc_func(1, sizeof(*profile) + length);
+        if (profile) {
+            profile->name = (char *)(profile + 1);
+            SDL_memcpy(profile->name, name, length);
+            profile->next = SDL_lock_profiles;
+            SDL_lock_profiles = profile;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_lock_profiles_lock);
+
+    return profile;
+}
+
+void SDL_RecordLockAcquired(SDL_LockProfile *profile, SDL_bool contended, Uint64 wait_ticks)
+{
+    LockProfileLock(&profile->lock);
+    ++profile->acquisitions;
+    if (contended) {
+        ++profile->contended;
+        profile->wait_ticks += wait_ticks;
+        profile->max_wait_ticks = SDL_max(profile->max_wait_ticks, wait_ticks);
+    }
+    SDL_AtomicUnlock(&profile->lock);
+}
+
+void SDL_RecordLockReleased(SDL_LockProfile *profile, Uint64 hold_ticks)
+{
+    LockProfileLock(&profile->lock);
+    profile->hold_ticks += hold_ticks;
+    profile->max_hold_ticks = SDL_max(profile->max_hold_ticks, hold_ticks);
+    SDL_AtomicUnlock(&profile->lock);
+}
+
+SDL_SpinLockProfile *SDL_FindSpinLockProfile(SDL_SpinLock *lock)
+{
+    /* Entries are filled in before they're counted and never removed, so no lock is needed */
+    const int count = SDL_AtomicGet(&SDL_num_spinlock_profiles);
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (SDL_spinlock_profiles[i].lock == lock) {
+            return &SDL_spinlock_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+void SDL_RecordSpinLockAcquired(SDL_SpinLockProfile *profile, SDL_bool contended, Uint64 wait_ticks)
+{
+    SDL_RecordLockAcquired(profile->profile, contended, wait_ticks);
+    profile->hold_start = SDL_GetPerformanceCounter();
+}
+
+void SDL_RecordSpinLockReleased(SDL_SpinLockProfile *profile)
+{
+    SDL_RecordLockReleased(profile->profile, SDL_GetPerformanceCounter() - profile->hold_start);
+}
+
+void SDL_SetSpinLockName(SDL_SpinLock *lock, const char *name)
+{
+    SDL_LockProfile *profile;
+    int count;
+
+    if (!lock || !name || SDL_FindSpinLockProfile(lock)) {
+        return;
+    }
+
+    profile = SDL_GetLockProfile(name);
+    if (!profile) {
+        return;
+    }
+
+    LockProfileLock(&SDL_lock_profiles_lock);
+    count = SDL_AtomicGet(&SDL_num_spinlock_profiles);
+    if (count < MAX_SPINLOCK_PROFILES) {
+        SDL_spinlock_profiles[count].lock = lock;
+        SDL_spinlock_profiles[count].profile = profile;
+        SDL_AtomicSet(&SDL_num_spinlock_profiles, count + 1);
+    }
+    SDL_AtomicUnlock(&SDL_lock_profiles_lock);
+}
+
+void SDL_QuitLockProfiling(void)
+{
+    const double ms_per_tick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    SDL_LockProfile *profile, stats;
+    SDL_bool logged_header = SDL_FALSE;
+
+    /* Profiles are only ever added to the front of the list */
+    LockProfileLock(&SDL_lock_profiles_lock);
+    profile = SDL_lock_profiles;
+    SDL_AtomicUnlock(&SDL_lock_profiles_lock);
+
+    for (; profile; profile = profile->next) {
+        /* Take a copy and start over, in case SDL is initialized again.
+           Logging may take locks, so don't do it while holding this one. */
+        LockProfileLock(&profile->lock);
+        stats = *profile;
+        profile->acquisitions = 0;
+        profile->contended = 0;
+        profile->wait_ticks = 0;
+        profile->max_wait_ticks = 0;
+        profile->hold_ticks = 0;
+        profile->max_hold_ticks = 0;
+        SDL_AtomicUnlock(&profile->lock);
+
+        if (stats.acquisitions == 0) {
+            continue;
+        }
+        if (!logged_header) {
+            SDL_Log("%-32s %12s %12s %12s %12s %12s %12s", "Lock", "Acquired", "Contended", "Wait ms", "Max wait ms", "Hold ms", "Max hold ms");
+            logged_header = SDL_TRUE;
+        }
+        SDL_Log("%-32s %12" SDL_PRIu64 " %12" SDL_PRIu64 " %12.3f %12.3f %12.3f %12.3f",
+                stats.name, stats.acquisitions, stats.contended,
+                stats.wait_ticks * ms_per_tick, stats.max_wait_ticks * ms_per_tick,
+                stats.hold_ticks * ms_per_tick, stats.max_hold_ticks * ms_per_tick);
+    }
+}
+
+#endif /* SDL_LOCK_PROFILING */
@@ -0,0 +1,70 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_lockprofile_h_
+#define SDL_lockprofile_h_
+
+/* Lock contention profiling, enabled by building with -DSDL_LOCK_PROFILING=ON
+
+   Locks that are given a name record how many times they were taken, how
+   many of those times another thread was holding them, the total time spent
+   waiting for them and how long they were held. Locks with the same name
+   share their statistics, and everything is logged by SDL_Quit().
+
+   Only spinlocks that live for the lifetime of the program should be named,
+   since they are looked up by address.
+ */
+
+#ifdef SDL_LOCK_PROFILING
+
+typedef struct SDL_LockProfile SDL_LockProfile;
+
+/* Get the statistics for a named lock, creating them if needed */
+extern SDL_LockProfile *SDL_GetLockProfile(const char *name);
+
+/* Record a lock being taken, and released after being held for some time, in performance counter ticks */
+extern void SDL_RecordLockAcquired(SDL_LockProfile *profile, SDL_bool contended, Uint64 wait_ticks);
+extern void SDL_RecordLockReleased(SDL_LockProfile *profile, Uint64 hold_ticks);
+
+/* Spinlocks have nowhere to store their statistics, so they're looked up by address */
+typedef struct SDL_SpinLockProfile SDL_SpinLockProfile;
+extern SDL_SpinLockProfile *SDL_FindSpinLockProfile(SDL_SpinLock *lock);
+extern void SDL_RecordSpinLockAcquired(SDL_SpinLockProfile *profile, SDL_bool contended, Uint64 wait_ticks);
+extern void SDL_RecordSpinLockReleased(SDL_SpinLockProfile *profile);
+
+extern void SDL_SetMutexName(SDL_Mutex *mutex, const char *name);
+extern void SDL_SetRWLockName(SDL_RWLock *rwlock, const char *name);
+extern void SDL_SetSpinLockName(SDL_SpinLock *lock, const char *name);
+
+/* Log the statistics for all the named locks */
+extern void SDL_QuitLockProfiling(void);
+
+#else
+
+#define SDL_SetMutexName(mutex, name)
+#define SDL_SetRWLockName(rwlock, name)
+#define SDL_SetSpinLockName(lock, name)
+#define SDL_QuitLockProfiling()
+
+#endif /* SDL_LOCK_PROFILING */
+
+#endif /* SDL_lockprofile_h_ */
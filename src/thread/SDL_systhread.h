@@ -50,6 +50,17 @@ extern void SDL_SYS_SetupThread(const char *name);
 /* This function sets the current thread priority */
 extern int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority);
 
+/* This function moves the current thread to the platform's realtime
+   scheduling class (SCHED_FIFO, MMCSS "Pro Audio", etc), or returns -1
+   if that isn't possible. */
+extern int SDL_SYS_SetThreadRealtime(void);
+
+/* This function restricts the current thread to a set of CPU cores, or all of them if cpus is NULL */
+extern int SDL_SYS_SetThreadAffinity(const int *cpus, int count);
+
+/* This function tells the scheduler what kind of work the current thread does */
+extern int SDL_SYS_SetThreadQoS(SDL_ThreadQoS qos);
+
 /* This function waits for the thread to finish and frees any data
    allocated by SDL_SYS_CreateThread()
  */
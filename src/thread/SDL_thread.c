@@ -26,6 +26,25 @@
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
 
+#ifdef SDL_THREAD_LOCAL
+/* The TLS data for the current thread, which skips the system lookup */
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_data;
+
+static SDL_TLSData *SDL_GetTLSData(void)
+{
+    return SDL_tls_data;
+}
+
+static int SDL_SetTLSData(SDL_TLSData *data)
+{
+    SDL_tls_data = data;
+    return 0;
+}
+#else
+#define SDL_GetTLSData SDL_SYS_GetTLSData
+#define SDL_SetTLSData SDL_SYS_SetTLSData
+#endif /* SDL_THREAD_LOCAL */
+
 SDL_TLSID SDL_CreateTLS(void)
 {
     static SDL_AtomicInt SDL_tls_id;
@@ -36,7 +55,7 @@ void *SDL_GetTLS(SDL_TLSID id)
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || id == 0 || id > storage->limit) {
         return NULL;
     }
@@ -51,7 +70,7 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
         return SDL_InvalidParamError("id");
     }
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || (id > storage->limit)) {
         unsigned int i, oldlimit, newlimit;
         SDL_TLSData *new_storage;
@@ -68,7 +87,7 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
             storage->array[i].data = NULL;
             storage->array[i].destructor = NULL;
         }
-        if (SDL_SYS_SetTLSData(storage) != 0) {
+        if (SDL_SetTLSData(storage) != 0) {
             return -1;
         }
     }
@@ -82,7 +101,7 @@ void SDL_CleanupTLS(void)
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (storage) {
         unsigned int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -90,7 +109,7 @@ void SDL_CleanupTLS(void)
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
-        SDL_SYS_SetTLSData(NULL);
+        SDL_SetTLSData(NULL);
         SDL_free(storage);
     }
 }
@@ -203,10 +222,19 @@ static SDL_error *SDL_GetStaticErrBuf(void)
 }
 
 #ifndef SDL_THREADS_DISABLED
+#ifdef SDL_THREAD_LOCAL
+/* The error buffer is looked up on every SDL_SetError(), so it gets a fixed slot */
+static SDL_THREAD_LOCAL SDL_error *SDL_errbuf;
+#endif
+
 static void SDLCALL SDL_FreeErrBuf(void *data)
 {
     SDL_error *errbuf = (SDL_error *)data;
 
+#ifdef SDL_THREAD_LOCAL
+    SDL_errbuf = NULL;
+#endif
+
     if (errbuf->str) {
         errbuf->free_func(errbuf->str);
     }
@@ -226,6 +254,12 @@ SDL_error *SDL_GetErrBuf(void)
     const SDL_error *ALLOCATION_IN_PROGRESS = (SDL_error *)-1;
     SDL_error *errbuf;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_errbuf) {
+        return SDL_errbuf;
+    }
+#endif
+
     /* tls_being_created is there simply to prevent recursion if SDL_CreateTLS() fails.
        It also means it's possible for another thread to also use SDL_global_errbuf,
        but that's very unlikely and hopefully won't cause issues.
@@ -270,11 +304,23 @@ SDL_error *SDL_GetErrBuf(void)
         errbuf->realloc_func = realloc_func;
         errbuf->free_func = free_func;
         SDL_SetTLS(tls_errbuf, errbuf, SDL_FreeErrBuf);
+#ifdef SDL_THREAD_LOCAL
+        SDL_errbuf = errbuf;
+#endif
     }
     return errbuf;
 #endif /* SDL_THREADS_DISABLED */
 }
 
+int SDL_GetMutexSpinCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_MUTEX_SPIN_COUNT);
+    if (hint && *hint) {
+        return SDL_max(SDL_atoi(hint), 0);
+    }
+    return SDL_MUTEX_DEFAULT_SPIN_COUNT;
+}
+
 void SDL_RunThread(SDL_Thread *thread)
 {
     void *userdata = thread->userdata;
@@ -436,6 +482,49 @@ int SDL_SetThreadPriority(SDL_ThreadPriority priority)
     return SDL_SYS_SetThreadPriority(priority);
 }
 
+int SDL_SetThreadQoS(SDL_ThreadQoS qos)
+{
+    if (qos < SDL_THREAD_QOS_DEFAULT || qos > SDL_THREAD_QOS_INTERACTIVE) {
+        return SDL_InvalidParamError("qos");
+    }
+    return SDL_SYS_SetThreadQoS(qos);
+}
+
+int SDL_SetThreadAffinity(const int *cpus, int count)
+{
+    int i;
+
+    if (cpus) {
+        if (count <= 0) {
+            return SDL_InvalidParamError("count");
+        }
+        for (i = 0; i < count; ++i) {
+            if (cpus[i] < 0) {
+                return SDL_InvalidParamError("cpus");
+            }
+        }
+    }
+    return SDL_SYS_SetThreadAffinity(cpus, count);
+}
+
+#if !defined(SDL_THREAD_PTHREAD) && (!defined(SDL_THREAD_WINDOWS) || defined(SDL_THREAD_STDCPP))
+/* Only the pthread and Windows thread backends implement these. */
+int SDL_SYS_SetThreadRealtime(void)
+{
+    return SDL_Unsupported();
+}
+
+int SDL_SYS_SetThreadAffinity(const int *cpus, int count)
+{
+    return SDL_Unsupported();
+}
+
+int SDL_SYS_SetThreadQoS(SDL_ThreadQoS qos)
+{
+    return SDL_Unsupported();
+}
+#endif
+
 void SDL_WaitThread(SDL_Thread *thread, int *status)
 {
     if (thread) {
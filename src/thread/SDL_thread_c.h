@@ -75,6 +75,10 @@ struct SDL_Thread
 /* This is the function called to run a thread */
 extern void SDL_RunThread(SDL_Thread *thread);
 
+/* This is the number of times a mutex should be retried before sleeping */
+#define SDL_MUTEX_DEFAULT_SPIN_COUNT 100
+extern int SDL_GetMutexSpinCount(void);
+
 /* This is the system-independent thread local storage structure */
 typedef struct
 {
@@ -89,6 +93,20 @@ typedef struct
 /* This is how many TLS entries we allocate at once */
 #define TLS_ALLOC_CHUNKSIZE 4
 
+/* Compiler supported thread-local variables, which are a single memory access
+   instead of a call into the system. These have no destructors, so anything
+   that needs cleaning up at thread exit should also be registered with SDL_SetTLS().
+ */
+#ifndef SDL_THREADS_DISABLED
+#ifdef _MSC_VER
+#define SDL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) && (defined(__LINUX__) || defined(__ANDROID__) || defined(__APPLE__) || \
+                            defined(__WIN32__) || defined(__FREEBSD__) || defined(__NETBSD__) || \
+                            defined(__OPENBSD__) || defined(__HAIKU__))
+#define SDL_THREAD_LOCAL __thread
+#endif
+#endif /* !SDL_THREADS_DISABLED */
+
 /* Get cross-platform, slow, thread local storage for this thread.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
@@ -0,0 +1,421 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_systhread.h"
+
+/* A work stealing thread pool.
+
+   Each worker has its own deque of jobs behind a spinlock. Workers push and
+   pop jobs at the back of their own deque, so jobs submitted from inside a
+   job run depth first on the same thread, and steal from the front of the
+   other workers' deques when they run out. Jobs submitted from other threads
+   are spread across the workers. Jobs with an unfinished dependency wait on
+   a list until their dependency counter reaches 0.
+
+   Lock order: pool->lock, then a worker's spinlock. */
+
+#define SDL_MIN_WORKER_JOBS 16
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction func;
+    void *userdata;
+    SDL_JobCounter *counter;
+} SDL_Job;
+
+typedef struct SDL_WaitingJob
+{
+    SDL_Job job;
+    SDL_JobCounter *dependency;
+    struct SDL_WaitingJob *next;
+} SDL_WaitingJob;
+
+typedef struct SDL_ThreadPoolWorker
+{
+    SDL_ThreadPool *pool;
+    SDL_Thread *thread;
+    int cpu;
+    SDL_SpinLock lock;
+    SDL_Job *jobs;
+    int first;
+    int count;
+    int capacity;
+} SDL_ThreadPoolWorker;
+
+struct SDL_ThreadPool
+{
+    SDL_Mutex *lock;
+    SDL_Condition *cond;    /* Signaled when a job is queued, broadcast when a counter reaches 0 */
+    SDL_AtomicInt pending;  /* Jobs in the worker deques */
+    SDL_AtomicInt active;   /* Jobs submitted that haven't finished */
+    SDL_AtomicInt next_worker;
+    SDL_bool quit;
+    SDL_WaitingJob *waiting;
+    int num_workers;
+    SDL_ThreadPoolWorker *workers;
+};
+
+static SDL_SpinLock SDL_thread_pool_tls_lock;
+static SDL_TLSID SDL_thread_pool_tls;
+
+static SDL_ThreadPoolWorker *SDL_GetCurrentWorker(SDL_ThreadPool *pool)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)SDL_GetTLS(SDL_thread_pool_tls);
+
+    if (worker && worker->pool == pool) {
+        return worker;
+    }
+    return NULL;
+}
+
+static int SDL_PushWorkerJob(SDL_ThreadPoolWorker *worker, const SDL_Job *job)
+{
+    SDL_AtomicLock(&worker->lock);
+    if (worker->count == worker->capacity) {
+        int capacity = SDL_max(worker->capacity * 2, SDL_MIN_WORKER_JOBS);
+        SDL_Job *jobs = (SDL_Job *)SDL_malloc(capacity * sizeof(*jobs));
+        int i;
+
+        if (!jobs) {
+            SDL_AtomicUnlock(&worker->lock);
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < worker->count; ++i) {
+            jobs[i] = worker->jobs[(worker->first + i) % worker->capacity];
+        }
+        SDL_free(worker->jobs);
+        worker->jobs = jobs;
+        worker->first = 0;
+        worker->capacity = capacity;
+    }
+    worker->jobs[(worker->first + worker->count) % worker->capacity] = *job;
+    ++worker->count;
+    SDL_AtomicUnlock(&worker->lock);
+
+    SDL_AtomicIncRef(&worker->pool->pending);
+    return 0;
+}
+
+static SDL_bool SDL_PopWorkerJob(SDL_ThreadPoolWorker *worker, SDL_bool steal, SDL_Job *job)
+{
+    SDL_bool found = SDL_FALSE;
+
+    SDL_AtomicLock(&worker->lock);
+    if (worker->count > 0) {
+        if (steal) {
+            *job = worker->jobs[worker->first];
+            worker->first = (worker->first + 1) % worker->capacity;
+        } else {
+            *job = worker->jobs[(worker->first + worker->count - 1) % worker->capacity];
+        }
+        --worker->count;
+        found = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&worker->lock);
+
+    if (found) {
+        SDL_AtomicDecRef(&worker->pool->pending);
+    }
+    return found;
+}
+
+static SDL_bool SDL_TakeJob(SDL_ThreadPool *pool, SDL_ThreadPoolWorker *self, SDL_Job *job)
+{
+    int i, start;
+
+    if (self && SDL_PopWorkerJob(self, SDL_FALSE, job)) {
+        return SDL_TRUE;
+    }
+
+    if (SDL_AtomicGet(&pool->pending) == 0) {
+        return SDL_FALSE;
+    }
+
+    if (self) {
+        start = (int)(self - pool->workers) + 1;
+    } else {
+        start = SDL_AtomicGet(&pool->next_worker);
+    }
+    for (i = 0; i < pool->num_workers; ++i) {
+        SDL_ThreadPoolWorker *victim = &pool->workers[(start + i) % pool->num_workers];
+        if (victim != self && SDL_PopWorkerJob(victim, SDL_TRUE, job)) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Queues a job that is ready to run, the caller wakes up a worker */
+static int SDL_QueueJob(SDL_ThreadPool *pool, const SDL_Job *job)
+{
+    SDL_ThreadPoolWorker *worker = SDL_GetCurrentWorker(pool);
+
+    if (!worker) {
+        int index = SDL_AtomicAdd(&pool->next_worker, 1);
+        worker = &pool->workers[(unsigned int)index % pool->num_workers];
+    }
+    return SDL_PushWorkerJob(worker, job);
+}
+
+/* Queues any waiting jobs whose dependency has finished, called with the pool locked */
+static void SDL_ReleaseWaitingJobs(SDL_ThreadPool *pool)
+{
+    SDL_WaitingJob *prev = NULL;
+    SDL_WaitingJob *waiting = pool->waiting;
+
+    while (waiting) {
+        SDL_WaitingJob *next = waiting->next;
+
+        if (SDL_AtomicGet(&waiting->dependency->value) == 0 &&
+            SDL_QueueJob(pool, &waiting->job) == 0) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                pool->waiting = next;
+            }
+            SDL_free(waiting);
+        } else {
+            prev = waiting;
+        }
+        waiting = next;
+    }
+}
+
+static void SDL_RunJob(SDL_ThreadPool *pool, const SDL_Job *job)
+{
+    SDL_bool wake = SDL_FALSE;
+
+    job->func(job->userdata);
+
+    if (job->counter && SDL_AtomicDecRef(&job->counter->value)) {
+        wake = SDL_TRUE;
+    }
+    if (SDL_AtomicDecRef(&pool->active)) {
+        wake = SDL_TRUE;
+    }
+
+    if (wake) {
+        SDL_LockMutex(pool->lock);
+        SDL_ReleaseWaitingJobs(pool);
+        SDL_BroadcastCondition(pool->cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static int SDLCALL SDL_ThreadPoolWorkerThread(void *data)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)data;
+    SDL_ThreadPool *pool = worker->pool;
+    SDL_Job job;
+
+    SDL_SetTLS(SDL_thread_pool_tls, worker, NULL);
+    if (worker->cpu >= 0) {
+        SDL_SYS_SetThreadAffinity(&worker->cpu, 1);
+    }
+
+    for ( ;; ) {
+        SDL_bool done;
+
+        if (SDL_TakeJob(pool, worker, &job)) {
+            SDL_RunJob(pool, &job);
+            continue;
+        }
+
+        SDL_LockMutex(pool->lock);
+        while (SDL_AtomicGet(&pool->pending) == 0 &&
+               (!pool->quit || SDL_AtomicGet(&pool->active) > 0)) {
+            SDL_WaitCondition(pool->cond, pool->lock);
+        }
+        done = (SDL_AtomicGet(&pool->pending) == 0);
+        SDL_UnlockMutex(pool->lock);
+
+        if (done) {
+            break;
+        }
+    }
+    return 0;
+}
+
+SDL_ThreadPool *SDL_CreateThreadPool(int num_threads, const int *cpus)
+{
+    SDL_ThreadPool *pool;
+    int i;
+
+    if (num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_max(SDL_GetCPUCount(), 1);
+    }
+
+    if (!SDL_thread_pool_tls) {
+        SDL_AtomicLock(&SDL_thread_pool_tls_lock);
+        if (!SDL_thread_pool_tls) {
+            SDL_thread_pool_tls = SDL_CreateTLS();
+        }
+        SDL_AtomicUnlock(&SDL_thread_pool_tls_lock);
+    }
+
+    pool = (SDL_ThreadPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->lock = SDL_CreateMutex();
+    pool->cond = SDL_CreateCondition();
+    pool->workers = (SDL_ThreadPoolWorker *)SDL_calloc(num_threads, sizeof(*pool->workers));
+    if (!pool->lock || !pool->cond || !pool->workers) {
+        if (!pool->workers) {
+            SDL_OutOfMemory();
+        }
+        SDL_DestroyThreadPool(pool);
+        return NULL;
+    }
+
+    /* All the workers need to exist before any of them look for work */
+    pool->num_workers = num_threads;
+    for (i = 0; i < num_threads; ++i) {
+        SDL_ThreadPoolWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->cpu = cpus ? cpus[i] : -1;
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_ThreadPoolWorker *worker = &pool->workers[i];
+        char name[32];
+
+        (void)SDL_snprintf(name, sizeof(name), "SDLPoolWorker%d", i);
+        worker->thread = SDL_CreateThreadInternal(SDL_ThreadPoolWorkerThread, name, 0, worker);
+        if (!worker->thread) {
+            SDL_DestroyThreadPool(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+int SDL_SubmitJob(SDL_ThreadPool *pool, SDL_JobFunction func, void *userdata, SDL_JobCounter *dependency, SDL_JobCounter *counter)
+{
+    SDL_Job job;
+    int retval = 0;
+
+    if (!pool) {
+        return SDL_InvalidParamError("pool");
+    }
+    if (!func) {
+        return SDL_InvalidParamError("func");
+    }
+
+    job.func = func;
+    job.userdata = userdata;
+    job.counter = counter;
+
+    if (counter) {
+        SDL_AtomicIncRef(&counter->value);
+    }
+    SDL_AtomicIncRef(&pool->active);
+
+    SDL_LockMutex(pool->lock);
+    if (dependency && SDL_AtomicGet(&dependency->value) != 0) {
+        /* This is checked again with the pool locked whenever a counter reaches 0 */
+        SDL_WaitingJob *waiting = (SDL_WaitingJob *)SDL_malloc(sizeof(*waiting));
+        if (waiting) {
+            waiting->job = job;
+            waiting->dependency = dependency;
+            waiting->next = pool->waiting;
+            pool->waiting = waiting;
+        } else {
+            retval = SDL_OutOfMemory();
+        }
+    } else {
+        retval = SDL_QueueJob(pool, &job);
+        if (retval == 0) {
+            SDL_SignalCondition(pool->cond);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    if (retval < 0) {
+        if (counter) {
+            SDL_AtomicDecRef(&counter->value);
+        }
+        SDL_AtomicDecRef(&pool->active);
+    }
+    return retval;
+}
+
+void SDL_WaitJobCounter(SDL_ThreadPool *pool, SDL_JobCounter *counter)
+{
+    SDL_ThreadPoolWorker *self;
+    SDL_Job job;
+
+    if (!pool || !counter) {
+        return;
+    }
+
+    self = SDL_GetCurrentWorker(pool);
+    while (SDL_AtomicGet(&counter->value) != 0) {
+        if (SDL_TakeJob(pool, self, &job)) {
+            SDL_RunJob(pool, &job);
+            continue;
+        }
+
+        SDL_LockMutex(pool->lock);
+        while (SDL_AtomicGet(&counter->value) != 0 && SDL_AtomicGet(&pool->pending) == 0) {
+            SDL_WaitCondition(pool->cond, pool->lock);
+        }
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+void SDL_DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    if (pool->workers) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = SDL_TRUE;
+        SDL_BroadcastCondition(pool->cond);
+        SDL_UnlockMutex(pool->lock);
+
+        for (i = 0; i < pool->num_workers; ++i) {
+            SDL_WaitThread(pool->workers[i].thread, NULL);
+            SDL_free(pool->workers[i].jobs);
+        }
+        SDL_free(pool->workers);
+    }
+
+    /* Only jobs that couldn't be queued because we ran out of memory can be left */
+    while (pool->waiting) {
+        SDL_WaitingJob *next = pool->waiting->next;
+        SDL_free(pool->waiting);
+        pool->waiting = next;
+    }
+
+    SDL_DestroyCondition(pool->cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
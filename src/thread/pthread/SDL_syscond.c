@@ -102,8 +102,16 @@ int SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 tim
         return SDL_InvalidParamError("cond");
     }
 
+#ifdef SDL_LOCK_PROFILING
+    SDL_PauseMutexProfile(mutex);
+#endif
+
     if (timeoutNS < 0) {
-        if (pthread_cond_wait(&cond->cond, &mutex->id) != 0) {
+        retval = pthread_cond_wait(&cond->cond, &mutex->id);
+#ifdef SDL_LOCK_PROFILING
+        SDL_ResumeMutexProfile(mutex);
+#endif
+        if (retval != 0) {
             return SDL_SetError("pthread_cond_wait() failed");
         }
         return 0;
@@ -127,6 +135,11 @@ int SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 tim
 
 tryagain:
     retval = pthread_cond_timedwait(&cond->cond, &mutex->id, &abstime);
+#ifdef SDL_LOCK_PROFILING
+    if (retval != EINTR) {
+        SDL_ResumeMutexProfile(mutex);
+    }
+#endif
     switch (retval) {
     case EINTR:
         goto tryagain;
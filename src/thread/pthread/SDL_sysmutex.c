@@ -24,6 +24,77 @@
 #include <pthread.h>
 
 #include "SDL_sysmutex_c.h"
+#include "../SDL_thread_c.h"
+
+#ifdef SDL_LOCK_PROFILING
+// Only the outermost lock of a recursive mutex is recorded
+static void SDL_MutexAcquired(SDL_Mutex *mutex, SDL_bool contended, Uint64 start)
+{
+    if (mutex->profile && mutex->depth++ == 0) {
+        mutex->hold_start = SDL_GetPerformanceCounter();
+        SDL_RecordLockAcquired(mutex->profile, contended, mutex->hold_start - start);
+    }
+}
+
+static void SDL_MutexReleasing(SDL_Mutex *mutex)
+{
+    if (mutex->profile && --mutex->depth == 0) {
+        SDL_RecordLockReleased(mutex->profile, SDL_GetPerformanceCounter() - mutex->hold_start);
+    }
+}
+
+void SDL_PauseMutexProfile(SDL_Mutex *mutex)
+{
+    if (mutex->profile && mutex->depth > 0) {
+        SDL_RecordLockReleased(mutex->profile, SDL_GetPerformanceCounter() - mutex->hold_start);
+    }
+}
+
+void SDL_ResumeMutexProfile(SDL_Mutex *mutex)
+{
+    if (mutex->profile && mutex->depth > 0) {
+        mutex->hold_start = SDL_GetPerformanceCounter();
+        SDL_RecordLockAcquired(mutex->profile, SDL_FALSE, 0);
+    }
+}
+
+void SDL_SetMutexName(SDL_Mutex *mutex, const char *name)
+{
+    if (mutex && name) {
+        mutex->profile = SDL_GetLockProfile(name);
+    }
+}
+#endif // SDL_LOCK_PROFILING
+
+// Try to take the lock a few times before sleeping, most critical sections are short
+static void SDL_LockMutexSpin(SDL_Mutex *mutex)
+{
+    int i;
+#ifdef SDL_LOCK_PROFILING
+    const Uint64 start = mutex->profile ? SDL_GetPerformanceCounter() : 0;
+
+    if (pthread_mutex_trylock(&mutex->id) == 0) {
+        SDL_MutexAcquired(mutex, SDL_FALSE, start);
+        return;
+    }
+#endif
+
+    for (i = 0; i < mutex->spin_count; ++i) {
+        if (pthread_mutex_trylock(&mutex->id) == 0) {
+            break;
+        }
+        SDL_CPUPauseInstruction();
+    }
+
+    if (i == mutex->spin_count) {
+        const int rc = pthread_mutex_lock(&mutex->id);
+        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+    }
+
+#ifdef SDL_LOCK_PROFILING
+    SDL_MutexAcquired(mutex, SDL_TRUE, start);
+#endif
+}
 
 SDL_Mutex *SDL_CreateMutex(void)
 {
@@ -45,6 +116,8 @@ SDL_Mutex *SDL_CreateMutex(void)
             SDL_SetError("pthread_mutex_init() failed");
             SDL_free(mutex);
             mutex = NULL;
+        } else {
+            mutex->spin_count = SDL_GetMutexSpinCount();
         }
     } else {
         SDL_OutOfMemory();
@@ -72,14 +145,12 @@ void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang does
                We set the locking thread id after we obtain the lock
                so unlocks from other threads will fail.
              */
-            const int rc = pthread_mutex_lock(&mutex->id);
-            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+            SDL_LockMutexSpin(mutex);
             mutex->owner = this_thread;
             mutex->recursive = 0;
         }
 #else
-        const int rc = pthread_mutex_lock(&mutex->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        SDL_LockMutexSpin(mutex);
 #endif
     }
 }
@@ -100,6 +171,9 @@ int SDL_TryLockMutex(SDL_Mutex *mutex)
              */
             const int result = pthread_mutex_trylock(&mutex->id);
             if (result == 0) {
+#ifdef SDL_LOCK_PROFILING
+                SDL_MutexAcquired(mutex, SDL_FALSE, SDL_GetPerformanceCounter());
+#endif
                 mutex->owner = this_thread;
                 mutex->recursive = 0;
             } else if (result == EBUSY) {
@@ -111,6 +185,11 @@ int SDL_TryLockMutex(SDL_Mutex *mutex)
         }
 #else
         const int result = pthread_mutex_trylock(&mutex->id);
+#ifdef SDL_LOCK_PROFILING
+        if (result == 0) {
+            SDL_MutexAcquired(mutex, SDL_FALSE, SDL_GetPerformanceCounter());
+        }
+#endif
         if (result != 0) {
             if (result == EBUSY) {
                 retval = SDL_MUTEX_TIMEDOUT;
@@ -139,6 +218,9 @@ void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang do
                    the mutex and set the ownership before we reset it,
                    then release the lock semaphore.
                  */
+#ifdef SDL_LOCK_PROFILING
+                SDL_MutexReleasing(mutex);
+#endif
                 mutex->owner = 0;
                 pthread_mutex_unlock(&mutex->id);
             }
@@ -147,7 +229,11 @@ void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang do
         }
 
 #else
-        const int rc = pthread_mutex_unlock(&mutex->id);
+        int rc;
+#ifdef SDL_LOCK_PROFILING
+        SDL_MutexReleasing(mutex);
+#endif
+        rc = pthread_mutex_unlock(&mutex->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
 #endif // FAKE_RECURSIVE_MUTEX
     }
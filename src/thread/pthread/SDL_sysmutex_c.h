@@ -23,6 +23,8 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
+#include "../SDL_lockprofile.h"
+
 #if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
     defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
 #define FAKE_RECURSIVE_MUTEX
@@ -31,10 +33,22 @@
 struct SDL_Mutex
 {
     pthread_mutex_t id;
+    int spin_count;
 #ifdef FAKE_RECURSIVE_MUTEX
     int recursive;
     pthread_t owner;
 #endif
+#ifdef SDL_LOCK_PROFILING
+    SDL_LockProfile *profile;
+    int depth;
+    Uint64 hold_start;
+#endif
 };
 
+#ifdef SDL_LOCK_PROFILING
+/* Waiting on a condition releases the mutex, so it doesn't count as holding it */
+extern void SDL_PauseMutexProfile(SDL_Mutex *mutex);
+extern void SDL_ResumeMutexProfile(SDL_Mutex *mutex);
+#endif
+
 #endif /* SDL_mutex_c_h_ */
@@ -23,11 +23,40 @@
 #include <errno.h>
 #include <pthread.h>
 
+#include "../SDL_lockprofile.h"
+
 struct SDL_RWLock
 {
     pthread_rwlock_t id;
+#ifdef SDL_LOCK_PROFILING
+    SDL_LockProfile *profile;
+    SDL_bool writing; /* Only the writer can see this set, since it excludes readers */
+    Uint64 hold_start;
+#endif
 };
 
+#ifdef SDL_LOCK_PROFILING
+void SDL_SetRWLockName(SDL_RWLock *rwlock, const char *name)
+{
+    if (rwlock && name) {
+        rwlock->profile = SDL_GetLockProfile(name);
+    }
+}
+
+/* Readers can hold the lock at the same time, so only the time it's held for writing is recorded */
+static void SDL_RWLockAcquired(SDL_RWLock *rwlock, SDL_bool writing, SDL_bool contended, Uint64 start)
+{
+    if (rwlock->profile) {
+        const Uint64 now = SDL_GetPerformanceCounter();
+        if (writing) {
+            rwlock->writing = SDL_TRUE;
+            rwlock->hold_start = now;
+        }
+        SDL_RecordLockAcquired(rwlock->profile, contended, now - start);
+    }
+}
+#endif /* SDL_LOCK_PROFILING */
+
 
 SDL_RWLock *SDL_CreateRWLock(void)
 {
@@ -58,16 +87,38 @@ void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 void SDL_LockRWLockForReading(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
+#ifdef SDL_LOCK_PROFILING
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (pthread_rwlock_tryrdlock(&rwlock->id) == 0) {
+            SDL_RWLockAcquired(rwlock, SDL_FALSE, SDL_FALSE, start);
+        } else {
+            const int rc = pthread_rwlock_rdlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+            SDL_RWLockAcquired(rwlock, SDL_FALSE, SDL_TRUE, start);
+        }
+#else
         const int rc = pthread_rwlock_rdlock(&rwlock->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+#endif
     }
 }
 
 void SDL_LockRWLockForWriting(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
+#ifdef SDL_LOCK_PROFILING
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (pthread_rwlock_trywrlock(&rwlock->id) == 0) {
+            SDL_RWLockAcquired(rwlock, SDL_TRUE, SDL_FALSE, start);
+        } else {
+            const int rc = pthread_rwlock_wrlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+            SDL_RWLockAcquired(rwlock, SDL_TRUE, SDL_TRUE, start);
+        }
+#else
         const int rc = pthread_rwlock_wrlock(&rwlock->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+#endif
     }
 }
 
@@ -77,6 +128,11 @@ int SDL_TryLockRWLockForReading(SDL_RWLock *rwlock)
 
     if (rwlock) {
         const int result = pthread_rwlock_tryrdlock(&rwlock->id);
+#ifdef SDL_LOCK_PROFILING
+        if (result == 0) {
+            SDL_RWLockAcquired(rwlock, SDL_FALSE, SDL_FALSE, SDL_GetPerformanceCounter());
+        }
+#endif
         if (result != 0) {
             retval = SDL_RWLOCK_TIMEDOUT;
             if (result != EBUSY) {
@@ -94,6 +150,11 @@ int SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
 
     if (rwlock) {
         const int result = pthread_rwlock_trywrlock(&rwlock->id);
+#ifdef SDL_LOCK_PROFILING
+        if (result == 0) {
+            SDL_RWLockAcquired(rwlock, SDL_TRUE, SDL_FALSE, SDL_GetPerformanceCounter());
+        }
+#endif
         if (result != 0) {
             retval = SDL_RWLOCK_TIMEDOUT;
             if (result != EBUSY) {
@@ -108,7 +169,14 @@ int SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
 void SDL_UnlockRWLock(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_unlock(&rwlock->id);
+        int rc;
+#ifdef SDL_LOCK_PROFILING
+        if (rwlock->profile && rwlock->writing) {
+            rwlock->writing = SDL_FALSE;
+            SDL_RecordLockReleased(rwlock->profile, SDL_GetPerformanceCounter() - rwlock->hold_start);
+        }
+#endif
+        rc = pthread_rwlock_unlock(&rwlock->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
     }
 }
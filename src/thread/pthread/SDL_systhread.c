@@ -34,6 +34,7 @@
 #include <sys/resource.h>
 #include <sys/syscall.h>
 #include <unistd.h>
+#include <sched.h>
 
 #include "../../core/linux/SDL_dbus.h"
 #endif /* __LINUX__ */
@@ -55,6 +56,10 @@
 #include <kernel/OS.h>
 #endif
 
+#ifdef __APPLE__
+#include <pthread/qos.h>
+#endif
+
 /* List of signals to mask in the subthreads */
 static const int sig_list[] = {
     SIGHUP, SIGINT, SIGQUIT, SIGPIPE, SIGALRM, SIGTERM, SIGCHLD, SIGWINCH,
@@ -272,6 +277,125 @@ int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif /* #if __RISCOS__ */
 }
 
+int SDL_SYS_SetThreadRealtime(void)
+{
+#ifdef __RISCOS__
+    return SDL_Unsupported();
+#else
+    struct sched_param sched;
+
+    /* This works right away for privileged processes (or with an rtprio limit). */
+    SDL_zero(sched);
+    sched.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sched) == 0) {
+        return 0;
+    }
+
+#ifdef __LINUX__
+    {
+        /* Otherwise, ask rtkit. */
+        pid_t linuxTid = syscall(SYS_gettid);
+        return SDL_LinuxSetThreadPriorityAndPolicy(linuxTid, SDL_THREAD_PRIORITY_TIME_CRITICAL, SCHED_FIFO);
+    }
+#else
+    return SDL_SetError("pthread_setschedparam() failed");
+#endif
+#endif /* __RISCOS__ */
+}
+
+int SDL_SYS_SetThreadAffinity(const int *cpus, int count)
+{
+#ifdef __LINUX__
+    cpu_set_t set;
+    pid_t linuxTid = syscall(SYS_gettid);
+    int i;
+
+    CPU_ZERO(&set);
+    if (cpus) {
+        for (i = 0; i < count; ++i) {
+            if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE) {
+                return SDL_InvalidParamError("cpus");
+            }
+            CPU_SET(cpus[i], &set);
+        }
+    } else {
+        /* The kernel ignores CPUs that don't exist */
+        for (i = 0; i < CPU_SETSIZE; ++i) {
+            CPU_SET(i, &set);
+        }
+    }
+    /* sched_setaffinity() on the thread ID, since Android doesn't have pthread_setaffinity_np(). */
+    if (sched_setaffinity(linuxTid, sizeof(set), &set) != 0) {
+        return SDL_SetError("sched_setaffinity() failed");
+    }
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+int SDL_SYS_SetThreadQoS(SDL_ThreadQoS qos)
+{
+#ifdef __APPLE__
+    qos_class_t qos_class;
+
+    switch (qos) {
+    case SDL_THREAD_QOS_BACKGROUND:
+        qos_class = QOS_CLASS_UTILITY;
+        break;
+    case SDL_THREAD_QOS_INTERACTIVE:
+        qos_class = QOS_CLASS_USER_INTERACTIVE;
+        break;
+    default:
+        qos_class = QOS_CLASS_DEFAULT;
+        break;
+    }
+    if (pthread_set_qos_class_self_np(qos_class, 0) != 0) {
+        return SDL_SetError("pthread_set_qos_class_self_np() failed");
+    }
+    return 0;
+#elif defined(__LINUX__)
+    /* There are no QoS classes, so pick the cores ourselves on hybrid CPUs */
+    SDL_CPUCoreInfo *cores;
+    int *cpus;
+    int i, count, num_cpus = 0, slowest = 0, fastest = 0, retval = 0;
+
+    cores = SDL_GetCPUTopology(&count);
+    if (!cores) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        slowest = (i == 0) ? cores[i].performance_class : SDL_min(slowest, cores[i].performance_class);
+        fastest = (i == 0) ? cores[i].performance_class : SDL_max(fastest, cores[i].performance_class);
+    }
+
+    if (slowest != fastest) {
+        if (qos == SDL_THREAD_QOS_DEFAULT) {
+            retval = SDL_SYS_SetThreadAffinity(NULL, 0);
+        } else {
+            const int wanted = (qos == SDL_THREAD_QOS_BACKGROUND) ? slowest : fastest;
+
+            cpus = (int *)SDL_malloc(count * sizeof(*cpus));
+            if (!cpus) {
+                SDL_free(cores);
+                return SDL_OutOfMemory();
+            }
+            for (i = 0; i < count; ++i) {
+                if (cores[i].performance_class == wanted) {
+                    cpus[num_cpus++] = cores[i].cpu;
+                }
+            }
+            retval = SDL_SYS_SetThreadAffinity(cpus, num_cpus);
+            SDL_free(cpus);
+        }
+    }
+    SDL_free(cores);
+    return retval;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     pthread_join(thread->handle, 0);
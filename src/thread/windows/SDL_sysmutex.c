@@ -31,6 +31,7 @@
  */
 
 #include "SDL_sysmutex_c.h"
+#include "../SDL_thread_c.h"
 
 /* Implementation will be chosen at runtime based on available Kernel features */
 SDL_mutex_impl_t SDL_mutex_impl_active = { 0 };
@@ -63,9 +64,11 @@ static SDL_Mutex *SDL_CreateMutex_srw(void)
     mutex = (SDL_mutex_srw *)SDL_calloc(1, sizeof(*mutex));
     if (!mutex) {
         SDL_OutOfMemory();
+        return NULL;
     }
 
     pInitializeSRWLock(&mutex->srw);
+    mutex->spin_count = SDL_GetMutexSpinCount();
 
     return (SDL_Mutex *)mutex;
 }
@@ -84,11 +87,22 @@ static void SDL_LockMutex_srw(SDL_Mutex *_mutex) SDL_NO_THREAD_SAFETY_ANALYSIS
     if (mutex->owner == this_thread) {
         ++mutex->count;
     } else {
+        int i;
+
         /* The order of operations is important.
            We set the locking thread id after we obtain the lock
            so unlocks from other threads will fail.
          */
-        pAcquireSRWLockExclusive(&mutex->srw);
+        /* SRW locks sleep right away, spin a bit first since most critical sections are short */
+        for (i = 0; i < mutex->spin_count; ++i) {
+            if (pTryAcquireSRWLockExclusive(&mutex->srw) != 0) {
+                break;
+            }
+            SDL_CPUPauseInstruction();
+        }
+        if (i == mutex->spin_count) {
+            pAcquireSRWLockExclusive(&mutex->srw);
+        }
         SDL_assert(mutex->count == 0 && mutex->owner == 0);
         mutex->owner = this_thread;
         mutex->count = 1;
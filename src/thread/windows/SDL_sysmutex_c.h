@@ -65,6 +65,7 @@ typedef struct SDL_mutex_srw
     /* SRW Locks are not recursive, that has to be handled by SDL: */
     DWORD count;
     DWORD owner;
+    int spin_count;
 } SDL_mutex_srw;
 
 typedef struct SDL_mutex_cs
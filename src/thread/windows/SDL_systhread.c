@@ -186,6 +186,106 @@ int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return 0;
 }
 
+int SDL_SYS_SetThreadRealtime(void)
+{
+#if !defined(__WINRT__) && !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
+    typedef HANDLE(WINAPI * pfnAvSetMmThreadCharacteristicsW)(LPCWSTR, LPDWORD);
+    static pfnAvSetMmThreadCharacteristicsW pAvSetMmThreadCharacteristicsW = NULL;
+
+    if (!pAvSetMmThreadCharacteristicsW) {
+        /* Avrt.dll is available in Vista and later; it stays loaded for the rest of the process. */
+        HMODULE avrt = LoadLibrary(TEXT("avrt.dll"));
+        if (avrt) {
+            pAvSetMmThreadCharacteristicsW = (pfnAvSetMmThreadCharacteristicsW)GetProcAddress(avrt, "AvSetMmThreadCharacteristicsW");
+        }
+    }
+
+    if (pAvSetMmThreadCharacteristicsW) {
+        DWORD idx = 0;
+        /* The registration ends with the thread. */
+        if (pAvSetMmThreadCharacteristicsW(L"Pro Audio", &idx)) {
+            return 0;
+        }
+    }
+#endif
+
+    /* Without MMCSS, this is as close as we can get. */
+    return SDL_SYS_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+}
+
+int SDL_SYS_SetThreadAffinity(const int *cpus, int count)
+{
+    DWORD_PTR mask = 0;
+    int i;
+
+    if (cpus) {
+        for (i = 0; i < count; ++i) {
+            if (cpus[i] < 0 || cpus[i] >= (int)(sizeof(DWORD_PTR) * 8)) {
+                return SDL_InvalidParamError("cpus");
+            }
+            mask |= ((DWORD_PTR)1) << cpus[i];
+        }
+    } else {
+        DWORD_PTR system_mask;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &system_mask)) {
+            return WIN_SetError("GetProcessAffinityMask()");
+        }
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        return WIN_SetError("SetThreadAffinityMask()");
+    }
+    return 0;
+}
+
+/* These are only in the Windows 10 SDK and later */
+#define SDL_ThreadPowerThrottling                     3
+#define SDL_THREAD_POWER_THROTTLING_CURRENT_VERSION   1
+#define SDL_THREAD_POWER_THROTTLING_EXECUTION_SPEED   0x1
+
+typedef struct
+{
+    ULONG Version;
+    ULONG ControlMask;
+    ULONG StateMask;
+} SDL_THREAD_POWER_THROTTLING_STATE;
+
+typedef BOOL(WINAPI *pfnSetThreadInformation)(HANDLE, int, LPVOID, DWORD);
+
+int SDL_SYS_SetThreadQoS(SDL_ThreadQoS qos)
+{
+#ifndef __WINRT__
+    static pfnSetThreadInformation pSetThreadInformation = NULL;
+    static HMODULE kernel32 = NULL;
+    SDL_THREAD_POWER_THROTTLING_STATE state;
+
+    if (!kernel32) {
+        kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+        if (kernel32) {
+            pSetThreadInformation = (pfnSetThreadInformation)GetProcAddress(kernel32, "SetThreadInformation");
+        }
+    }
+    if (!pSetThreadInformation) {
+        return SDL_Unsupported();
+    }
+
+    /* EcoQoS throttles the thread and prefers efficiency cores, turning it off keeps it on performance cores */
+    SDL_zero(state);
+    state.Version = SDL_THREAD_POWER_THROTTLING_CURRENT_VERSION;
+    if (qos != SDL_THREAD_QOS_DEFAULT) {
+        state.ControlMask = SDL_THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        if (qos == SDL_THREAD_QOS_BACKGROUND) {
+            state.StateMask = SDL_THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        }
+    }
+    if (!pSetThreadInformation(GetCurrentThread(), SDL_ThreadPowerThrottling, &state, sizeof(state))) {
+        return WIN_SetError("SetThreadInformation()");
+    }
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitForSingleObjectEx(thread->handle, INFINITE, FALSE);
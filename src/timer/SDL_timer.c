@@ -21,6 +21,9 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+#include "../thread/SDL_lockprofile.h"
 #include "../thread/SDL_systhread.h"
 
 /* #define DEBUG_TIMERS */
@@ -31,27 +34,22 @@ typedef struct SDL_Timer
 {
     int timerID;
     SDL_TimerCallback callback;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 sequence; /* Keeps timers scheduled for the same time in the order they were queued */
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    int timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-/* The timers are kept in a sorted list */
+/* The timers are kept in a binary heap ordered by scheduling time */
 typedef struct
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_AtomicInt nextID;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap; /* Maps timer IDs to timers */
     SDL_Mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,8 +62,11 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -76,24 +77,67 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+static SDL_bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
 {
-    SDL_Timer *prev, *curr;
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+static SDL_bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    int i;
+
+    if (data->num_timers == data->max_timers) {
+        int max_timers = SDL_max(data->max_timers * 2, 64);
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return SDL_FALSE;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    /* Sift the new timer up to its place in the heap */
+    i = data->num_timers++;
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, data->timers[parent])) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return SDL_TRUE;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+static void SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *last = data->timers[--data->num_timers];
+    int i = 0;
+
+    /* Sift the last timer down from the top of the heap */
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= data->num_timers) {
+            break;
+        }
+        if (child + 1 < data->num_timers && SDL_TimerBefore(data->timers[child + 1], data->timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(data->timers[child], last)) {
+            break;
+        }
+        data->timers[i] = data->timers[child];
+        i = child;
+    }
+    if (data->num_timers > 0) {
+        data->timers[i] = last;
     }
-    timer->next = curr;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -103,6 +147,7 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_Timer *current;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
+    SDL_Timer *finished;
     Uint64 tick, now, interval, delay;
 
     /* Threaded timer loop:
@@ -126,14 +171,23 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        freelist_head = NULL;
+        freelist_tail = NULL;
+
+        /* Sort the pending timers into our heap */
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                /* Out of memory, drop the timer */
+                SDL_AtomicSet(&current->canceled, 1);
+                current->next = freelist_head;
+                freelist_head = current;
+                if (!freelist_tail) {
+                    freelist_tail = current;
+                }
+            }
         }
-        freelist_head = NULL;
-        freelist_tail = NULL;
 
         /* Check to see if we're still running, after maintenance */
         if (!SDL_AtomicGet(&data->active)) {
@@ -146,8 +200,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
         tick = SDL_GetTicksNS();
 
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 /* Scheduled for the future, wait a bit */
@@ -156,30 +210,39 @@ static int SDLCALL SDL_TimerThread(void *_data)
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
+            } else if (current->callback_ns) {
+                interval = current->callback_ns(current->interval, current->param);
             } else {
-                /* FIXME: We could potentially support sub-millisecond timers now */
                 interval = SDL_MS_TO_NS(current->callback((Uint32)SDL_NS_TO_MS(current->interval), current->param));
             }
 
+            finished = NULL;
             if (interval > 0) {
                 /* Reschedule this timer */
                 current->interval = interval;
                 current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
+                if (!SDL_AddTimerInternal(data, current)) {
+                    finished = current;
+                }
             } else {
+                finished = current;
+            }
+
+            if (finished) {
+                finished->next = NULL;
                 if (!freelist_head) {
-                    freelist_head = current;
+                    freelist_head = finished;
                 }
                 if (freelist_tail) {
-                    freelist_tail->next = current;
+                    freelist_tail->next = finished;
                 }
-                freelist_tail = current;
+                freelist_tail = finished;
 
-                SDL_AtomicSet(&current->canceled, 1);
+                SDL_AtomicSet(&finished->canceled, 1);
             }
         }
 
@@ -202,6 +265,11 @@ static int SDLCALL SDL_TimerThread(void *_data)
     return 0;
 }
 
+static void SDLCALL SDL_NukeTimerMapEntry(const void *key, const void *value, void *unused)
+{
+    /* The timers are owned by the timer thread */
+}
+
 int SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -213,12 +281,23 @@ int SDL_InitTimers(void)
             return -1;
         }
 
+        data->timermap = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, SDL_NukeTimerMapEntry, SDL_FALSE);
+        if (!data->timermap) {
+            SDL_DestroyMutex(data->timermap_lock);
+            data->timermap_lock = NULL;
+            return -1;
+        }
+
         data->sem = SDL_CreateSemaphore(0);
         if (!data->sem) {
+            SDL_DestroyHashTable(data->timermap);
+            data->timermap = NULL;
             SDL_DestroyMutex(data->timermap_lock);
+            data->timermap_lock = NULL;
             return -1;
         }
 
+        SDL_SetSpinLockName(&data->lock, "SDL_timer_data.lock");
         SDL_AtomicSet(&data->active, 1);
 
         /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
@@ -237,7 +316,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -251,9 +330,16 @@ void SDL_QuitTimers(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+        for (i = 0; i < data->num_timers; ++i) {
+            SDL_free(data->timers[i]);
+        }
+        SDL_free(data->timers);
+        data->timers = NULL;
+        data->num_timers = 0;
+        data->max_timers = 0;
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
             SDL_free(timer);
         }
         while (data->freelist) {
@@ -261,22 +347,20 @@ void SDL_QuitTimers(void)
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
-        }
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_TimerID id;
+    SDL_bool added;
 
     SDL_AtomicLock(&data->lock);
     if (!SDL_AtomicGet(&data->active)) {
@@ -303,24 +387,22 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
     timer->callback = callback;
+    timer->callback_ns = callback_ns;
     timer->param = param;
-    timer->interval = SDL_MS_TO_NS(interval);
+    timer->interval = interval;
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_AtomicSet(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        SDL_free(timer);
-        SDL_OutOfMemory();
-        return 0;
-    }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
+    /* Once the timer is queued it may finish and be reused at any time */
+    id = timer->timerID;
 
     SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)id, timer);
     SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
+        SDL_free(timer);
+        return 0;
+    }
 
     /* Add the timer to the pending list for the timer thread */
     SDL_AtomicLock(&data->lock);
@@ -331,37 +413,42 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     /* Wake up the timer thread if necessary */
     SDL_PostSemaphore(data->sem);
 
-    return entry->timerID;
+    return id;
+}
+
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, NULL, callback, param);
 }
 
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    const void *value = NULL;
     SDL_bool canceled = SDL_FALSE;
 
+    if (!data->timermap_lock) {
+        return SDL_FALSE;
+    }
+
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
-    SDL_UnlockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_Timer *timer = (SDL_Timer *)value;
 
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
+        if (!SDL_AtomicGet(&timer->canceled)) {
+            SDL_AtomicSet(&timer->canceled, 1);
             canceled = SDL_TRUE;
         }
-        SDL_free(entry);
     }
+    SDL_UnlockMutex(data->timermap_lock);
+
     return canceled;
 }
 
@@ -374,8 +461,9 @@ typedef struct SDL_TimerMap
 {
     int timerID;
     int timeoutID;
-    Uint32 interval;
+    Uint64 interval;
     SDL_TimerCallback callback;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     struct SDL_TimerMap *next;
 } SDL_TimerMap;
@@ -391,10 +479,14 @@ static SDL_TimerData SDL_timer_data;
 static void SDL_Emscripten_TimerHelper(void *userdata)
 {
     SDL_TimerMap *entry = (SDL_TimerMap *)userdata;
-    entry->interval = entry->callback(entry->interval, entry->param);
+    if (entry->callback_ns) {
+        entry->interval = entry->callback_ns(entry->interval, entry->param);
+    } else {
+        entry->interval = SDL_MS_TO_NS(entry->callback((Uint32)SDL_NS_TO_MS(entry->interval), entry->param));
+    }
     if (entry->interval > 0) {
         entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                                  entry->interval,
+                                                  (double)entry->interval / SDL_NS_PER_MS,
                                                   entry);
     }
 }
@@ -416,7 +508,7 @@ void SDL_QuitTimers(void)
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_TimerMap *entry;
@@ -428,11 +520,12 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     }
     entry->timerID = ++data->nextID;
     entry->callback = callback;
+    entry->callback_ns = callback_ns;
     entry->param = param;
     entry->interval = interval;
 
     entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                              entry->interval,
+                                              (double)entry->interval / SDL_NS_PER_MS,
                                               entry);
 
     entry->next = data->timermap;
@@ -441,6 +534,16 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     return entry->timerID;
 }
 
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, NULL, callback, param);
+}
+
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -476,6 +579,100 @@ static Uint32 tick_denominator_ns;
 static Uint32 tick_numerator_ms;
 static Uint32 tick_denominator_ms;
 
+/* Reading the CPU's counter directly avoids a trip through the OS clock */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_CPU_COUNTER
+static SDL_INLINE Uint64 SDL_GetCPUCounter(void)
+{
+    Uint32 lo, hi;
+
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((Uint64)hi << 32) | lo;
+}
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) && !defined(_M_ARM64EC)
+#define HAVE_CPU_COUNTER
+static SDL_INLINE Uint64 SDL_GetCPUCounter(void)
+{
+    return __rdtsc();
+}
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define HAVE_CPU_COUNTER
+static SDL_INLINE Uint64 SDL_GetCPUCounter(void)
+{
+    Uint64 value;
+
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(value) : : "memory");
+    return value;
+}
+#endif
+
+#ifdef HAVE_CPU_COUNTER
+static SDL_bool tick_use_cpu_counter;
+static Uint64 tick_cpu_start;
+static Uint64 tick_cpu_mult; /* nanoseconds per count, in fixed point */
+static int tick_cpu_shift;
+
+static Uint64 SDL_GetCPUCounterFrequency(void)
+{
+#if defined(__aarch64__)
+    Uint64 freq;
+
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+    return freq;
+#else
+    /* The TSC rate isn't reported reliably, so measure it against the OS clock */
+    const Uint64 pc_freq = SDL_GetPerformanceFrequency();
+    Uint64 pc_start, pc_end, start, end;
+
+    if (!SDL_HasInvariantTSC()) {
+        return 0;
+    }
+
+    pc_start = SDL_GetPerformanceCounter();
+    start = SDL_GetCPUCounter();
+    do {
+        pc_end = SDL_GetPerformanceCounter();
+    } while ((pc_end - pc_start) < (pc_freq / 100));
+    end = SDL_GetCPUCounter();
+
+    return ((end - start) * pc_freq) / (pc_end - pc_start);
+#endif
+}
+
+static void SDL_InitCPUCounter(void)
+{
+    Uint64 freq;
+
+    tick_use_cpu_counter = SDL_FALSE;
+
+    if (!SDL_GetHintBoolean(SDL_HINT_TIMER_CPU_COUNTER, SDL_FALSE)) {
+        return;
+    }
+
+    freq = SDL_GetCPUCounterFrequency();
+    if (!freq) {
+        return;
+    }
+
+    /* Use as many fraction bits as fit, so the multiply never overflows */
+    tick_cpu_shift = 32;
+    while (tick_cpu_shift > 0 && (((Uint64)SDL_NS_PER_SECOND << tick_cpu_shift) / freq) > SDL_MAX_UINT32) {
+        --tick_cpu_shift;
+    }
+    tick_cpu_mult = ((Uint64)SDL_NS_PER_SECOND << tick_cpu_shift) / freq;
+    tick_cpu_start = SDL_GetCPUCounter();
+    tick_use_cpu_counter = SDL_TRUE;
+}
+
+static SDL_INLINE Uint64 SDL_GetCPUCounterTicksNS(void)
+{
+    const Uint64 counts = SDL_GetCPUCounter() - tick_cpu_start;
+    const Uint64 mask = ((Uint64)1 << tick_cpu_shift) - 1;
+
+    return ((counts >> tick_cpu_shift) * tick_cpu_mult) + (((counts & mask) * tick_cpu_mult) >> tick_cpu_shift);
+}
+#endif /* HAVE_CPU_COUNTER */
+
 #if defined(SDL_TIMER_WINDOWS) && \
     !defined(__WINRT__) && !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
 #include <mmsystem.h>
@@ -549,6 +746,10 @@ void SDL_InitTicks(void)
     tick_numerator_ms = (SDL_MS_PER_SECOND / gcd);
     tick_denominator_ms = (Uint32)(tick_freq / gcd);
 
+#ifdef HAVE_CPU_COUNTER
+    SDL_InitCPUCounter();
+#endif
+
     tick_start = SDL_GetPerformanceCounter();
     if (!tick_start) {
         --tick_start;
@@ -573,10 +774,38 @@ Uint64 SDL_GetTicksNS(void)
         SDL_InitTicks();
     }
 
+#ifdef HAVE_CPU_COUNTER
+    if (tick_use_cpu_counter) {
+        return SDL_GetCPUCounterTicksNS();
+    }
+#endif
+
     starting_value = (SDL_GetPerformanceCounter() - tick_start);
     value = (starting_value * tick_numerator_ns);
     SDL_assert(value >= starting_value);
-    value /= tick_denominator_ns;
+    if (tick_denominator_ns != 1) {
+        value /= tick_denominator_ns;
+    }
+    return value;
+}
+
+Uint64 SDL_PerformanceCounterToTicksNS(Uint64 counter)
+{
+    Uint64 starting_value, value;
+
+    if (!tick_start) {
+        SDL_InitTicks();
+    }
+
+    if (counter < tick_start) {
+        return 0;
+    }
+    starting_value = (counter - tick_start);
+    value = (starting_value * tick_numerator_ns);
+    SDL_assert(value >= starting_value);
+    if (tick_denominator_ns != 1) {
+        value /= tick_denominator_ns;
+    }
     return value;
 }
 
@@ -588,6 +817,12 @@ Uint64 SDL_GetTicks(void)
         SDL_InitTicks();
     }
 
+#ifdef HAVE_CPU_COUNTER
+    if (tick_use_cpu_counter) {
+        return SDL_GetCPUCounterTicksNS() / SDL_NS_PER_MS;
+    }
+#endif
+
     starting_value = (SDL_GetPerformanceCounter() - tick_start);
     value = (starting_value * tick_numerator_ms);
     SDL_assert(value >= starting_value);
@@ -599,3 +834,24 @@ void SDL_Delay(Uint32 ms)
 {
     SDL_DelayNS(SDL_MS_TO_NS(ms));
 }
+
+/* OS sleeps can overshoot by up to a scheduler tick, so we spin for this long at the end */
+#define SDL_DELAY_PRECISE_SPIN_NS   SDL_MS_TO_NS(1)
+
+void SDL_DelayPrecise(Uint64 ns)
+{
+    Uint64 now = SDL_GetTicksNS();
+    const Uint64 target = now + ns;
+
+    /* Sleep for most of the time, this may wake early if interrupted */
+    while (now + SDL_DELAY_PRECISE_SPIN_NS < target) {
+        SDL_DelayNS(target - now - SDL_DELAY_PRECISE_SPIN_NS);
+        now = SDL_GetTicksNS();
+    }
+
+    /* Spin for the rest */
+    while (now < target) {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetTicksNS();
+    }
+}
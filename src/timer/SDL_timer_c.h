@@ -31,6 +31,7 @@
 
 extern void SDL_InitTicks(void);
 extern void SDL_QuitTicks(void);
+extern Uint64 SDL_PerformanceCounterToTicksNS(Uint64 counter);
 extern int SDL_InitTimers(void);
 extern void SDL_QuitTimers(void);
 
@@ -89,6 +89,7 @@
 
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
+#include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
 
 #define PIXEL_COPY(to, from, len, bpp) \
@@ -604,6 +605,258 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+/*
+ * Blend a run of translucent pixels. The vectorized versions do the same
+ * packed arithmetic as the BLIT_TRANSL_* macros, lane by lane, so they give
+ * exactly the same results.
+ */
+typedef void (*RLETranslRunFunc)(const Uint32 *src, void *dst, int n);
+
+static void BlitTranslRun_888(const Uint32 *src, void *dst, int n)
+{
+    Uint32 *pixel = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], pixel[i]);
+    }
+}
+
+static void BlitTranslRun_565(const Uint32 *src, void *dst, int n)
+{
+    Uint16 *pixel = (Uint16 *)dst;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_565(src[i], pixel[i]);
+    }
+}
+
+static void BlitTranslRun_555(const Uint32 *src, void *dst, int n)
+{
+    Uint16 *pixel = (Uint16 *)dst;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_555(src[i], pixel[i]);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* x * a modulo 2^32 in each 32-bit lane, with a < 2^16 in both 16-bit halves */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") MulLo32_SSE2(__m128i x, __m128i a)
+{
+    return _mm_add_epi16(_mm_mullo_epi16(x, a), _mm_slli_epi32(_mm_mulhi_epu16(x, a), 16));
+}
+
+static void SDL_TARGETING("sse2") BlitTranslRun_888_SSE2(const Uint32 *src, void *dst, int n)
+{
+    const __m128i rbmask = _mm_set1_epi32(0xff00ff);
+    const __m128i gmask = _mm_set1_epi32(0xff00);
+    const __m128i amask = _mm_set1_epi32((int)0xff000000);
+    Uint32 *d = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i p = _mm_loadu_si128((const __m128i *)(d + i));
+        const __m128i alpha = _mm_srli_epi32(s, 24);
+        const __m128i a = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        const __m128i s1 = _mm_and_si128(s, rbmask);
+        const __m128i d1 = _mm_and_si128(p, rbmask);
+        const __m128i s2 = _mm_and_si128(s, gmask);
+        const __m128i d2 = _mm_and_si128(p, gmask);
+        const __m128i rb = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(MulLo32_SSE2(_mm_sub_epi32(s1, d1), a), 8)), rbmask);
+        const __m128i g = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(MulLo32_SSE2(_mm_sub_epi32(s2, d2), a), 8)), gmask);
+
+        _mm_storeu_si128((__m128i *)(d + i), _mm_or_si128(_mm_or_si128(rb, g), amask));
+    }
+    BlitTranslRun_888(src + i, d + i, n - i);
+}
+
+/* Blend 4 16-bit pixels, widened to 32-bit lanes */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") BlitTransl16_SSE2(__m128i s, __m128i d, __m128i mask)
+{
+    const __m128i alpha = _mm_srli_epi32(_mm_and_si128(s, _mm_set1_epi32(0x3e0)), 5);
+    const __m128i a = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+
+    s = _mm_and_si128(s, mask);
+    d = _mm_and_si128(_mm_or_si128(d, _mm_slli_epi32(d, 16)), mask);
+    d = _mm_and_si128(_mm_add_epi32(d, _mm_srli_epi32(MulLo32_SSE2(_mm_sub_epi32(s, d), a), 5)), mask);
+    d = _mm_or_si128(d, _mm_srli_epi32(d, 16));
+    /* sign extend the low half so the signed pack keeps all 16 bits */
+    return _mm_srai_epi32(_mm_slli_epi32(d, 16), 16);
+}
+
+static SDL_INLINE void SDL_TARGETING("sse2") BlitTranslRun16_SSE2(const Uint32 *src, Uint16 *d, int n, Uint32 mask32)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32((int)mask32);
+    int i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(d + i));
+        const __m128i lo = BlitTransl16_SSE2(_mm_loadu_si128((const __m128i *)(src + i)), _mm_unpacklo_epi16(p, zero), mask);
+        const __m128i hi = BlitTransl16_SSE2(_mm_loadu_si128((const __m128i *)(src + i + 4)), _mm_unpackhi_epi16(p, zero), mask);
+
+        _mm_storeu_si128((__m128i *)(d + i), _mm_packs_epi32(lo, hi));
+    }
+    if (mask32 == 0x07e0f81f) {
+        BlitTranslRun_565(src + i, d + i, n - i);
+    } else {
+        BlitTranslRun_555(src + i, d + i, n - i);
+    }
+}
+
+static void SDL_TARGETING("sse2") BlitTranslRun_565_SSE2(const Uint32 *src, void *dst, int n)
+{
+    BlitTranslRun16_SSE2(src, (Uint16 *)dst, n, 0x07e0f81f);
+}
+
+static void SDL_TARGETING("sse2") BlitTranslRun_555_SSE2(const Uint32 *src, void *dst, int n)
+{
+    BlitTranslRun16_SSE2(src, (Uint16 *)dst, n, 0x03e07c1f);
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") BlitTranslRun_888_AVX2(const Uint32 *src, void *dst, int n)
+{
+    const __m256i rbmask = _mm256_set1_epi32(0xff00ff);
+    const __m256i gmask = _mm256_set1_epi32(0xff00);
+    const __m256i amask = _mm256_set1_epi32((int)0xff000000);
+    Uint32 *d = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i p = _mm256_loadu_si256((const __m256i *)(d + i));
+        const __m256i a = _mm256_srli_epi32(s, 24);
+        const __m256i s1 = _mm256_and_si256(s, rbmask);
+        const __m256i d1 = _mm256_and_si256(p, rbmask);
+        const __m256i s2 = _mm256_and_si256(s, gmask);
+        const __m256i d2 = _mm256_and_si256(p, gmask);
+        const __m256i rb = _mm256_and_si256(_mm256_add_epi32(d1, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, d1), a), 8)), rbmask);
+        const __m256i g = _mm256_and_si256(_mm256_add_epi32(d2, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s2, d2), a), 8)), gmask);
+
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_or_si256(_mm256_or_si256(rb, g), amask));
+    }
+    BlitTranslRun_888(src + i, d + i, n - i);
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static void BlitTranslRun_888_NEON(const Uint32 *src, void *dst, int n)
+{
+    const uint32x4_t rbmask = vdupq_n_u32(0xff00ff);
+    const uint32x4_t gmask = vdupq_n_u32(0xff00);
+    const uint32x4_t amask = vdupq_n_u32(0xff000000);
+    Uint32 *d = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const uint32x4_t s = vld1q_u32(src + i);
+        const uint32x4_t p = vld1q_u32(d + i);
+        const uint32x4_t a = vshrq_n_u32(s, 24);
+        const uint32x4_t s1 = vandq_u32(s, rbmask);
+        const uint32x4_t d1 = vandq_u32(p, rbmask);
+        const uint32x4_t s2 = vandq_u32(s, gmask);
+        const uint32x4_t d2 = vandq_u32(p, gmask);
+        const uint32x4_t rb = vandq_u32(vaddq_u32(d1, vshrq_n_u32(vmulq_u32(vsubq_u32(s1, d1), a), 8)), rbmask);
+        const uint32x4_t g = vandq_u32(vaddq_u32(d2, vshrq_n_u32(vmulq_u32(vsubq_u32(s2, d2), a), 8)), gmask);
+
+        vst1q_u32(d + i, vorrq_u32(vorrq_u32(rb, g), amask));
+    }
+    BlitTranslRun_888(src + i, d + i, n - i);
+}
+
+static SDL_INLINE uint16x4_t BlitTransl16_NEON(uint32x4_t s, uint32x4_t d, uint32x4_t mask)
+{
+    const uint32x4_t a = vshrq_n_u32(vandq_u32(s, vdupq_n_u32(0x3e0)), 5);
+
+    s = vandq_u32(s, mask);
+    d = vandq_u32(vorrq_u32(d, vshlq_n_u32(d, 16)), mask);
+    d = vandq_u32(vaddq_u32(d, vshrq_n_u32(vmulq_u32(vsubq_u32(s, d), a), 5)), mask);
+    return vmovn_u32(vorrq_u32(d, vshrq_n_u32(d, 16)));
+}
+
+static SDL_INLINE void BlitTranslRun16_NEON(const Uint32 *src, Uint16 *d, int n, Uint32 mask32)
+{
+    const uint32x4_t mask = vdupq_n_u32(mask32);
+    int i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const uint16x8_t p = vld1q_u16(d + i);
+        const uint16x4_t lo = BlitTransl16_NEON(vld1q_u32(src + i), vmovl_u16(vget_low_u16(p)), mask);
+        const uint16x4_t hi = BlitTransl16_NEON(vld1q_u32(src + i + 4), vmovl_u16(vget_high_u16(p)), mask);
+
+        vst1q_u16(d + i, vcombine_u16(lo, hi));
+    }
+    if (mask32 == 0x07e0f81f) {
+        BlitTranslRun_565(src + i, d + i, n - i);
+    } else {
+        BlitTranslRun_555(src + i, d + i, n - i);
+    }
+}
+
+static void BlitTranslRun_565_NEON(const Uint32 *src, void *dst, int n)
+{
+    BlitTranslRun16_NEON(src, (Uint16 *)dst, n, 0x07e0f81f);
+}
+
+static void BlitTranslRun_555_NEON(const Uint32 *src, void *dst, int n)
+{
+    BlitTranslRun16_NEON(src, (Uint16 *)dst, n, 0x03e07c1f);
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Pick the translucent run blender for a destination of the given depth */
+static RLETranslRunFunc RLEChooseTranslRun(const SDL_PixelFormat *df)
+{
+    if (df->BytesPerPixel == 4) {
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return BlitTranslRun_888_AVX2;
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return BlitTranslRun_888_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return BlitTranslRun_888_NEON;
+        }
+#endif
+        return BlitTranslRun_888;
+    } else if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return BlitTranslRun_565_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return BlitTranslRun_565_NEON;
+        }
+#endif
+        return BlitTranslRun_565;
+    } else {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return BlitTranslRun_555_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return BlitTranslRun_555_NEON;
+        }
+#endif
+        return BlitTranslRun_555;
+    }
+}
+
 /* used to save the destination format in the encoding. Designed to be
    macro-compatible with SDL_PixelFormat but without the unneeded fields */
 typedef struct
@@ -626,15 +879,15 @@ typedef struct
 
 /* blit a pixel-alpha RLE surface clipped at the right and/or left edges */
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
-                             Uint8 *dstbuf, const SDL_Rect *srcrect)
+                             Uint8 *dstbuf, const SDL_Rect *srcrect,
+                             RLETranslRunFunc blend_run)
 {
     SDL_PixelFormat *df = surf_dst->format;
     /*
-     * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * clipped blitter: Ptype is the destination pixel type and
+     * Ctype the opaque count type.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
+#define RLEALPHACLIPBLIT(Ptype, Ctype)                                    \
     do {                                                                  \
         int linecount = srcrect->h;                                       \
         int left = srcrect->x;                                            \
@@ -687,13 +940,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     }                                                     \
                     if (crun > right - cofs)                              \
                         crun = right - cofs;                              \
-                    if (crun > 0) {                                       \
-                        Ptype *dst = (Ptype *)dstbuf + cofs;              \
-                        Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
-                    }                                                     \
+                    if (crun > 0)                                         \
+                        blend_run((Uint32 *)srcbuf + (cofs - ofs),        \
+                                  (Ptype *)dstbuf + cofs, crun);          \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
                 }                                                         \
@@ -704,14 +953,10 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
 
     switch (df->BytesPerPixel) {
     case 2:
-        if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
-        } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
-        }
+        RLEALPHACLIPBLIT(Uint16, Uint8);
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16);
         break;
     }
 }
@@ -724,6 +969,7 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
     int w = surf_src->w;
     Uint8 *srcbuf, *dstbuf;
     SDL_PixelFormat *df = surf_dst->format;
+    RLETranslRunFunc blend_run = RLEChooseTranslRun(df);
 
     /* Lock the destination if necessary */
     if (SDL_MUSTLOCK(surf_dst)) {
@@ -797,15 +1043,14 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
 
     /* if left or right edge clipping needed, call clip blit */
     if (srcrect->x || srcrect->w != surf_src->w) {
-        RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
+        RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, blend_run);
     } else {
 
         /*
-         * non-clipped blitter. Ptype is the destination pixel type,
-         * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * non-clipped blitter. Ptype is the destination pixel type and
+         * Ctype the opaque count type.
          */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
+#define RLEALPHABLIT(Ptype, Ctype)                                   \
     do {                                                             \
         int linecount = srcrect->h;                                  \
         do {                                                         \
@@ -835,14 +1080,9 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
                 run = ((Uint16 *)srcbuf)[1];                         \
                 srcbuf += 4;                                         \
                 if (run) {                                           \
-                    Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    blend_run((Uint32 *)srcbuf,                      \
+                              (Ptype *)dstbuf + ofs, (int)run);      \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -852,14 +1092,10 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
 
         switch (df->BytesPerPixel) {
         case 2:
-            if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
-            } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
-            }
+            RLEALPHABLIT(Uint16, Uint8);
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16);
             break;
         }
     }
@@ -1214,13 +1450,7 @@ static int RLEAlphaSurface(SDL_Surface *surface)
 
     /* Now that we have it encoded, release the original pixels */
     if (!(surface->flags & SDL_PREALLOC)) {
-        if (surface->flags & SDL_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
+        SDL_FreeSurfacePixels(surface);
     }
 
     /* reallocate the buffer to release unused memory */
@@ -1235,16 +1465,6 @@ static int RLEAlphaSurface(SDL_Surface *surface)
     return 0;
 }
 
-static Uint32 getpix_8(const Uint8 *srcbuf)
-{
-    return *srcbuf;
-}
-
-static Uint32 getpix_16(const Uint8 *srcbuf)
-{
-    return *(const Uint16 *)srcbuf;
-}
-
 static Uint32 getpix_24(const Uint8 *srcbuf)
 {
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
@@ -1254,18 +1474,77 @@ static Uint32 getpix_24(const Uint8 *srcbuf)
 #endif
 }
 
-static Uint32 getpix_32(const Uint8 *srcbuf)
+#ifdef SDL_SSE2_INTRINSICS
+/* Skip whole vectors of pixels that are all (or all not) the colorkey */
+static int SDL_TARGETING("sse2") RLEColorkeyScan_SSE2(const Uint8 *srcbuf, int x, int w, int bpp,
+                                                      Uint32 ckey, Uint32 rgbmask, SDL_bool transparent)
 {
-    return *(const Uint32 *)srcbuf;
+    const int expected = transparent ? 0xFFFF : 0;
+
+    if (bpp == 4) {
+        const __m128i key = _mm_set1_epi32((int)ckey);
+        const __m128i mask = _mm_set1_epi32((int)rgbmask);
+        while (x + 4 <= w) {
+            const __m128i pixels = _mm_loadu_si128((const __m128i *)(srcbuf + x * 4));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(pixels, mask), key)) != expected) {
+                break;
+            }
+            x += 4;
+        }
+    } else if (bpp == 2 && ckey <= 0xFFFF) {
+        const __m128i key = _mm_set1_epi16((short)ckey);
+        const __m128i mask = _mm_set1_epi16((short)rgbmask);
+        while (x + 8 <= w) {
+            const __m128i pixels = _mm_loadu_si128((const __m128i *)(srcbuf + x * 2));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(pixels, mask), key)) != expected) {
+                break;
+            }
+            x += 8;
+        }
+    }
+    return x;
 }
+#endif /* SDL_SSE2_INTRINSICS */
 
-typedef Uint32 (*getpix_func)(const Uint8 *);
+/* Find the end of a run of pixels that are (or aren't) the colorkey */
+static int RLEColorkeyScan(const Uint8 *srcbuf, int x, int w, int bpp,
+                           Uint32 ckey, Uint32 rgbmask, SDL_bool transparent, SDL_bool use_simd)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (use_simd) {
+        x = RLEColorkeyScan_SSE2(srcbuf, x, w, bpp, ckey, rgbmask, transparent);
+    }
+#else
+    (void)use_simd;
+#endif
 
-static const getpix_func getpixes[4] = {
-    getpix_8, getpix_16, getpix_24, getpix_32
-};
+    switch (bpp) {
+    case 1:
+        while (x < w && (srcbuf[x] == ckey) == transparent) {
+            x++;
+        }
+        break;
+    case 2:
+        while (x < w && ((((const Uint16 *)srcbuf)[x] & rgbmask) == ckey) == transparent) {
+            x++;
+        }
+        break;
+    case 3:
+        while (x < w && ((getpix_24(srcbuf + x * 3) & rgbmask) == ckey) == transparent) {
+            x++;
+        }
+        break;
+    default:
+        while (x < w && ((((const Uint32 *)srcbuf)[x] & rgbmask) == ckey) == transparent) {
+            x++;
+        }
+        break;
+    }
+    return x;
+}
 
-static int RLEColorkeySurface(SDL_Surface *surface)
+/* Encode a colorkeyed surface, returning the encoded data and its size */
+static Uint8 *RLEColorkeyEncode(SDL_Surface *surface, size_t *size)
 {
     Uint8 *rlebuf, *dst;
     int maxn;
@@ -1273,9 +1552,9 @@ static int RLEColorkeySurface(SDL_Surface *surface)
     Uint8 *srcbuf, *lastline;
     int maxsize = 0;
     const int bpp = surface->format->BytesPerPixel;
-    getpix_func getpix;
     Uint32 ckey, rgbmask;
     int w, h;
+    SDL_bool use_simd = SDL_FALSE;
 
     /* calculate the worst case size for the compressed surface */
     switch (bpp) {
@@ -1295,12 +1574,14 @@ static int RLEColorkeySurface(SDL_Surface *surface)
         break;
 
     default:
-        return -1;
+        SDL_SetError("Unsupported RLE pixel depth");
+        return NULL;
     }
 
     rlebuf = (Uint8 *)SDL_malloc(maxsize);
     if (!rlebuf) {
-        return SDL_OutOfMemory();
+        SDL_OutOfMemory();
+        return NULL;
     }
 
     /* Set up the conversion */
@@ -1310,9 +1591,11 @@ static int RLEColorkeySurface(SDL_Surface *surface)
     rgbmask = ~surface->format->Amask;
     ckey = surface->map->info.colorkey & rgbmask;
     lastline = dst;
-    getpix = getpixes[bpp - 1];
     w = surface->w;
     h = surface->h;
+#ifdef SDL_SSE2_INTRINSICS
+    use_simd = SDL_HasSSE2();
+#endif
 
 #define ADD_COUNTS(n, m)                \
     if (bpp == 4) {                     \
@@ -1335,13 +1618,9 @@ static int RLEColorkeySurface(SDL_Surface *surface)
             int skipstart = x;
 
             /* find run of transparent, then opaque pixels */
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
-            }
+            x = RLEColorkeyScan(srcbuf, x, w, bpp, ckey, rgbmask, SDL_TRUE, use_simd);
             runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
-            }
+            x = RLEColorkeyScan(srcbuf, x, w, bpp, ckey, rgbmask, SDL_FALSE, use_simd);
             skip = runstart - skipstart;
             if (skip == w) {
                 blankline = 1;
@@ -1379,30 +1658,63 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 
 #undef ADD_COUNTS
 
-    /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
-        if (surface->flags & SDL_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
-    }
-
     /* reallocate the buffer to release unused memory */
+    *size = dst - rlebuf;
     {
         /* If SDL_realloc returns NULL, the original block is left intact */
-        Uint8 *p = SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
+        Uint8 *p = SDL_realloc(rlebuf, *size);
+        if (p) {
+            rlebuf = p;
         }
-        surface->map->data = p;
     }
+    return rlebuf;
+}
+
+static int RLEColorkeySurface(SDL_Surface *surface)
+{
+    size_t size;
+    Uint8 *rlebuf = RLEColorkeyEncode(surface, &size);
+
+    if (!rlebuf) {
+        return -1;
+    }
+
+    /* Now that we have it encoded, release the original pixels */
+    if (!(surface->flags & SDL_PREALLOC)) {
+        SDL_FreeSurfacePixels(surface);
+    }
+    surface->map->data = rlebuf;
 
     return 0;
 }
 
+static SDL_bool RLEFlagsSupported(SDL_Surface *surface, int flags)
+{
+    if ((flags & SDL_COPY_MODULATE_COLOR) ||
+        ((flags & SDL_COPY_MODULATE_ALPHA) && surface->format->Amask) ||
+        (flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) ||
+        (flags & SDL_COPY_NEAREST)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_CanKeepRLESurface(SDL_Surface *surface)
+{
+    const int flags = surface->map->info.flags;
+
+    /* Only colorkey encodings are independent of the destination, and they
+       stay valid as long as the surface would still be encoded that way */
+    if ((surface->flags & SDL_RLEACCEL) != SDL_RLEACCEL ||
+        !(flags & SDL_COPY_RLE_COLORKEY) ||
+        !(flags & SDL_COPY_RLE_DESIRED) ||
+        !(flags & SDL_COPY_COLORKEY) ||
+        ((flags & SDL_COPY_BLEND) && surface->format->Amask)) {
+        return SDL_FALSE;
+    }
+    return RLEFlagsSupported(surface, flags);
+}
+
 int SDL_RLESurface(SDL_Surface *surface)
 {
     int flags;
@@ -1433,10 +1745,7 @@ int SDL_RLESurface(SDL_Surface *surface)
     }
 
     /* Pass on combinations not supported */
-    if ((flags & SDL_COPY_MODULATE_COLOR) ||
-        ((flags & SDL_COPY_MODULATE_ALPHA) && surface->format->Amask) ||
-        (flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) ||
-        (flags & SDL_COPY_NEAREST)) {
+    if (!RLEFlagsSupported(surface, flags)) {
         return -1;
     }
 
@@ -1599,4 +1908,262 @@ void SDL_UnRLESurface(SDL_Surface *surface, int recode)
     }
 }
 
+
+/*
+ * Serialized colorkey encodings
+ *
+ * The stream starts with a little endian header: the magic "SRLE", a
+ * version, the pixel format, width, height, colorkey, the byte order the
+ * data was encoded with, the palette size and colors, and the size of the
+ * encoded data. The encoded data follows as it is kept in memory, which
+ * uses the native byte order for the counts and pixels.
+ */
+#define RLE_STREAM_MAGIC   0x454C5253 /* "SRLE" */
+#define RLE_STREAM_VERSION 1
+
+/* Walk a colorkey encoding, returning its size or 0 if it's malformed */
+static size_t RLEColorkeyLength(const Uint8 *data, size_t maxlen, int w, int h, int bpp)
+{
+    const size_t countsize = (bpp == 4) ? 4 : 2;
+    size_t pos = 0;
+    int y;
+
+    for (y = 0; y <= h; ++y) {
+        int ofs = 0;
+        do {
+            int skip, run;
+
+            if (maxlen - pos < countsize) {
+                return 0;
+            }
+            if (bpp == 4) {
+                skip = ((const Uint16 *)(data + pos))[0];
+                run = ((const Uint16 *)(data + pos))[1];
+            } else {
+                skip = data[pos];
+                run = data[pos + 1];
+            }
+            pos += countsize;
+            if (!skip && !run && !ofs) {
+                return pos;
+            }
+            ofs += skip + run;
+            if (ofs > w || (size_t)run * bpp > maxlen - pos) {
+                return 0;
+            }
+            pos += (size_t)run * bpp;
+        } while (ofs < w);
+    }
+    /* more lines than the surface has */
+    return 0;
+}
+
+int SDL_SaveRLE_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
+{
+    SDL_bool was_error = SDL_TRUE;
+    SDL_bool locked = SDL_FALSE;
+    SDL_Palette *palette;
+    Uint8 *encoded = NULL;
+    const Uint8 *data;
+    size_t size;
+    int i;
+
+    if (!surface) {
+        SDL_InvalidParamError("surface");
+        goto done;
+    }
+    if (!dst) {
+        SDL_InvalidParamError("dst");
+        goto done;
+    }
+    if (!(surface->map->info.flags & SDL_COPY_COLORKEY)) {
+        SDL_SetError("Surface doesn't have a colorkey");
+        goto done;
+    }
+    if (surface->format->BitsPerPixel < 8) {
+        SDL_SetError("Unsupported RLE pixel depth");
+        goto done;
+    }
+
+    if ((surface->flags & SDL_RLEACCEL) && (surface->map->info.flags & SDL_COPY_RLE_COLORKEY)) {
+        /* Save the existing encoding */
+        data = (const Uint8 *)surface->map->data;
+        size = RLEColorkeyLength(data, SDL_SIZE_MAX, surface->w, surface->h, surface->format->BytesPerPixel);
+    } else {
+        if (SDL_MUSTLOCK(surface)) {
+            if (SDL_LockSurface(surface) < 0) {
+                goto done;
+            }
+            locked = SDL_TRUE;
+        }
+        encoded = RLEColorkeyEncode(surface, &size);
+        if (!encoded) {
+            goto done;
+        }
+        data = encoded;
+    }
+
+    palette = surface->format->palette;
+    if (!SDL_WriteU32LE(dst, RLE_STREAM_MAGIC) ||
+        !SDL_WriteU32LE(dst, RLE_STREAM_VERSION) ||
+        !SDL_WriteU32LE(dst, surface->format->format) ||
+        !SDL_WriteS32LE(dst, surface->w) ||
+        !SDL_WriteS32LE(dst, surface->h) ||
+        !SDL_WriteU32LE(dst, surface->map->info.colorkey) ||
+        !SDL_WriteU32LE(dst, SDL_BYTEORDER) ||
+        !SDL_WriteU32LE(dst, palette ? palette->ncolors : 0)) {
+        goto done;
+    }
+    if (palette) {
+        for (i = 0; i < palette->ncolors; ++i) {
+            const SDL_Color *color = &palette->colors[i];
+            if (!SDL_WriteU8(dst, color->r) || !SDL_WriteU8(dst, color->g) ||
+                !SDL_WriteU8(dst, color->b) || !SDL_WriteU8(dst, color->a)) {
+                goto done;
+            }
+        }
+    }
+    if (!SDL_WriteU32LE(dst, (Uint32)size) || SDL_RWwrite(dst, data, size) != size) {
+        goto done;
+    }
+
+    was_error = SDL_FALSE;
+
+done:
+    SDL_free(encoded);
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+    if (freedst && dst) {
+        if (SDL_RWclose(dst) < 0) {
+            was_error = SDL_TRUE;
+        }
+    }
+    if (was_error) {
+        return -1;
+    }
+    return 0;
+}
+
+SDL_Surface *SDL_LoadRLE_RW(SDL_RWops *src, SDL_bool freesrc)
+{
+    SDL_Surface *surface = NULL;
+    Uint8 *data = NULL;
+    Uint32 magic, version, format, colorkey, byteorder, ncolors, size;
+    Sint32 w, h;
+    Uint32 i;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto error;
+    }
+    if (!SDL_ReadU32LE(src, &magic) || !SDL_ReadU32LE(src, &version)) {
+        goto error;
+    }
+    if (magic != RLE_STREAM_MAGIC || version != RLE_STREAM_VERSION) {
+        SDL_SetError("File is not an RLE encoded surface");
+        goto error;
+    }
+    if (!SDL_ReadU32LE(src, &format) ||
+        !SDL_ReadS32LE(src, &w) ||
+        !SDL_ReadS32LE(src, &h) ||
+        !SDL_ReadU32LE(src, &colorkey) ||
+        !SDL_ReadU32LE(src, &byteorder) ||
+        !SDL_ReadU32LE(src, &ncolors)) {
+        goto error;
+    }
+    if (byteorder != SDL_BYTEORDER) {
+        SDL_SetError("RLE data was encoded with a different byte order");
+        goto error;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_BITSPERPIXEL(format) < 8) {
+        SDL_SetError("Unsupported RLE pixel format");
+        goto error;
+    }
+
+    surface = SDL_CreateSurface(w, h, format);
+    if (!surface) {
+        goto error;
+    }
+    if (surface->format->palette) {
+        SDL_Color colors[256];
+
+        if (ncolors > (Uint32)surface->format->palette->ncolors) {
+            SDL_SetError("RLE palette has too many colors");
+            goto error;
+        }
+        for (i = 0; i < ncolors; ++i) {
+            if (!SDL_ReadU8(src, &colors[i].r) || !SDL_ReadU8(src, &colors[i].g) ||
+                !SDL_ReadU8(src, &colors[i].b) || !SDL_ReadU8(src, &colors[i].a)) {
+                goto error;
+            }
+        }
+        if (SDL_SetPaletteColors(surface->format->palette, colors, 0, (int)ncolors) < 0) {
+            goto error;
+        }
+    } else if (ncolors) {
+        SDL_SetError("RLE palette for a format without one");
+        goto error;
+    }
+    if (SDL_SetSurfaceColorKey(surface, SDL_TRUE, colorkey) < 0) {
+        goto error;
+    }
+    SDL_SetSurfaceRLE(surface, 1);
+
+    if (!SDL_ReadU32LE(src, &size)) {
+        goto error;
+    }
+    data = (Uint8 *)SDL_malloc(size ? size : 1);
+    if (!data) {
+        SDL_OutOfMemory();
+        goto error;
+    }
+    if (SDL_RWread(src, data, size) != size) {
+        goto error;
+    }
+    if (RLEColorkeyLength(data, size, surface->w, surface->h, surface->format->BytesPerPixel) != size) {
+        SDL_SetError("Corrupt RLE data");
+        goto error;
+    }
+
+    /* Install the encoding in place of the pixels, as RLEColorkeySurface() does */
+    SDL_FreeSurfacePixels(surface);
+    surface->map->data = data;
+    surface->map->blit = SDL_RLEBlit;
+    surface->map->info.flags |= SDL_COPY_RLE_COLORKEY;
+    surface->flags |= SDL_RLEACCEL;
+
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return surface;
+
+error:
+    SDL_free(data);
+    SDL_DestroySurface(surface);
+    if (freesrc && src) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+#else
+
+int SDL_SaveRLE_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
+{
+    if (freedst && dst) {
+        SDL_RWclose(dst);
+    }
+    return SDL_Unsupported();
+}
+
+SDL_Surface *SDL_LoadRLE_RW(SDL_RWops *src, SDL_bool freesrc)
+{
+    if (freesrc && src) {
+        SDL_RWclose(src);
+    }
+    SDL_Unsupported();
+    return NULL;
+}
+
 #endif /* SDL_HAVE_RLE */
@@ -28,5 +28,6 @@
 
 extern int SDL_RLESurface(SDL_Surface *surface);
 extern void SDL_UnRLESurface(SDL_Surface *surface, int recode);
+extern SDL_bool SDL_CanKeepRLESurface(SDL_Surface *surface);
 
 #endif /* SDL_RLEaccel_c_h_ */
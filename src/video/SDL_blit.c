@@ -27,6 +27,259 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_systhread.h"
+
+/* Large blits can be split into bands of rows run on a pool of worker threads */
+#define SDL_MAX_BLIT_THREADS        16
+#define SDL_MIN_THREADED_BLIT_PIXELS (512 * 512)
+
+typedef struct SDL_BlitWorker
+{
+    SDL_Thread *thread;
+    int row;
+    int rows;
+    SDL_bool has_work;
+} SDL_BlitWorker;
+
+static struct
+{
+    SDL_SpinLock init_lock;
+    SDL_Mutex *job_lock; /* held by the thread using the workers */
+    SDL_Mutex *lock;
+    SDL_Condition *ready;
+    SDL_Condition *done;
+    int num_workers;
+    SDL_BlitWorker *workers;
+    SDL_BandFunc func;
+    void *userdata;
+    Uint32 generation;
+    int remaining;
+    SDL_bool quit;
+} SDL_blit_pool;
+
+static int SDLCALL SDL_BlitThread(void *data)
+{
+    SDL_BlitWorker *worker = (SDL_BlitWorker *)data;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(SDL_blit_pool.lock);
+    for (;;) {
+        while (!SDL_blit_pool.quit && SDL_blit_pool.generation == generation) {
+            SDL_WaitCondition(SDL_blit_pool.ready, SDL_blit_pool.lock);
+        }
+        if (SDL_blit_pool.quit) {
+            break;
+        }
+        generation = SDL_blit_pool.generation;
+        if (worker->has_work) {
+            SDL_BandFunc func = SDL_blit_pool.func;
+            void *userdata = SDL_blit_pool.userdata;
+
+            SDL_UnlockMutex(SDL_blit_pool.lock);
+            func(userdata, worker->row, worker->rows);
+            SDL_LockMutex(SDL_blit_pool.lock);
+
+            worker->has_work = SDL_FALSE;
+            if (--SDL_blit_pool.remaining == 0) {
+                SDL_SignalCondition(SDL_blit_pool.done);
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_blit_pool.lock);
+
+    return 0;
+}
+
+static void SDL_StopBlitThreads(void)
+{
+    int i;
+
+    if (SDL_blit_pool.workers) {
+        SDL_LockMutex(SDL_blit_pool.lock);
+        SDL_blit_pool.quit = SDL_TRUE;
+        SDL_BroadcastCondition(SDL_blit_pool.ready);
+        SDL_UnlockMutex(SDL_blit_pool.lock);
+
+        for (i = 0; i < SDL_blit_pool.num_workers; ++i) {
+            SDL_WaitThread(SDL_blit_pool.workers[i].thread, NULL);
+        }
+        SDL_free(SDL_blit_pool.workers);
+        SDL_blit_pool.workers = NULL;
+    }
+    SDL_blit_pool.num_workers = 0;
+    SDL_blit_pool.quit = SDL_FALSE;
+
+    SDL_DestroyCondition(SDL_blit_pool.done);
+    SDL_blit_pool.done = NULL;
+    SDL_DestroyCondition(SDL_blit_pool.ready);
+    SDL_blit_pool.ready = NULL;
+    SDL_DestroyMutex(SDL_blit_pool.lock);
+    SDL_blit_pool.lock = NULL;
+}
+
+static SDL_bool SDL_StartBlitThreads(int num_workers)
+{
+    int i;
+
+    SDL_blit_pool.lock = SDL_CreateMutex();
+    SDL_blit_pool.ready = SDL_CreateCondition();
+    SDL_blit_pool.done = SDL_CreateCondition();
+    SDL_blit_pool.workers = (SDL_BlitWorker *)SDL_calloc(num_workers, sizeof(*SDL_blit_pool.workers));
+    if (!SDL_blit_pool.lock || !SDL_blit_pool.ready || !SDL_blit_pool.done || !SDL_blit_pool.workers) {
+        SDL_StopBlitThreads();
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < num_workers; ++i) {
+        SDL_BlitWorker *worker = &SDL_blit_pool.workers[i];
+        worker->thread = SDL_CreateThreadInternal(SDL_BlitThread, "SDLBlit", 0, worker);
+        if (!worker->thread) {
+            break;
+        }
+        ++SDL_blit_pool.num_workers;
+    }
+    if (SDL_blit_pool.num_workers == 0) {
+        SDL_StopBlitThreads();
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+void SDL_QuitBlitThreads(void)
+{
+    if (SDL_blit_pool.job_lock) {
+        SDL_LockMutex(SDL_blit_pool.job_lock);
+        SDL_StopBlitThreads();
+        SDL_UnlockMutex(SDL_blit_pool.job_lock);
+        SDL_DestroyMutex(SDL_blit_pool.job_lock);
+        SDL_blit_pool.job_lock = NULL;
+    }
+}
+
+static int SDL_GetNumBlitThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    int num_threads = 0;
+
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+        if (num_threads < 0) {
+            num_threads = SDL_GetCPUCount();
+        }
+    }
+    return SDL_clamp(num_threads, 0, SDL_MAX_BLIT_THREADS);
+}
+
+SDL_bool SDL_RunThreadedBands(SDL_BandFunc func, void *userdata, int width, int height, int alignment)
+{
+    int num_threads, num_bands, band_h, i;
+
+    if ((width * height) < SDL_MIN_THREADED_BLIT_PIXELS) {
+        return SDL_FALSE;
+    }
+    num_threads = SDL_min(SDL_GetNumBlitThreads(), height / alignment);
+    if (num_threads < 2) {
+        return SDL_FALSE;
+    }
+
+    if (!SDL_blit_pool.job_lock) {
+        SDL_AtomicLock(&SDL_blit_pool.init_lock);
+        if (!SDL_blit_pool.job_lock) {
+            SDL_blit_pool.job_lock = SDL_CreateMutex();
+        }
+        SDL_AtomicUnlock(&SDL_blit_pool.init_lock);
+        if (!SDL_blit_pool.job_lock) {
+            return SDL_FALSE;
+        }
+    }
+
+    /* Another thread is using the workers, this job isn't worth waiting for them */
+    if (SDL_TryLockMutex(SDL_blit_pool.job_lock) != 0) {
+        return SDL_FALSE;
+    }
+
+    if (SDL_blit_pool.workers && SDL_blit_pool.num_workers < (num_threads - 1)) {
+        SDL_StopBlitThreads();
+    }
+    if (!SDL_blit_pool.workers && !SDL_StartBlitThreads(num_threads - 1)) {
+        SDL_UnlockMutex(SDL_blit_pool.job_lock);
+        return SDL_FALSE;
+    }
+
+    num_bands = SDL_min(num_threads, SDL_blit_pool.num_workers + 1);
+    band_h = (height + num_bands - 1) / num_bands;
+    band_h = ((band_h + alignment - 1) / alignment) * alignment;
+
+    SDL_LockMutex(SDL_blit_pool.lock);
+    SDL_blit_pool.func = func;
+    SDL_blit_pool.userdata = userdata;
+    SDL_blit_pool.remaining = 0;
+    for (i = 1; i < num_bands; ++i) {
+        SDL_BlitWorker *worker = &SDL_blit_pool.workers[i - 1];
+        const int row = i * band_h;
+
+        if (row >= height) {
+            break;
+        }
+        worker->row = row;
+        worker->rows = SDL_min(band_h, height - row);
+        worker->has_work = SDL_TRUE;
+        ++SDL_blit_pool.remaining;
+    }
+    ++SDL_blit_pool.generation;
+    SDL_BroadcastCondition(SDL_blit_pool.ready);
+    SDL_UnlockMutex(SDL_blit_pool.lock);
+
+    func(userdata, 0, SDL_min(band_h, height));
+
+    SDL_LockMutex(SDL_blit_pool.lock);
+    while (SDL_blit_pool.remaining > 0) {
+        SDL_WaitCondition(SDL_blit_pool.done, SDL_blit_pool.lock);
+    }
+    SDL_UnlockMutex(SDL_blit_pool.lock);
+
+    SDL_UnlockMutex(SDL_blit_pool.job_lock);
+    return SDL_TRUE;
+}
+
+typedef struct
+{
+    SDL_BlitFunc RunBlit;
+    const SDL_BlitInfo *info;
+} SDL_BlitBandJob;
+
+static void SDL_RunBlitBand(void *userdata, int row, int rows)
+{
+    const SDL_BlitBandJob *job = (const SDL_BlitBandJob *)userdata;
+    SDL_BlitInfo band = *job->info;
+
+    band.src += row * band.src_pitch;
+    band.dst += row * band.dst_pitch;
+    band.src_h = band.dst_h = rows;
+    job->RunBlit(&band);
+}
+
+/* Run the blit in bands of rows, the calling thread does the first band.
+   Returns SDL_FALSE if the blit should run on the calling thread alone. */
+static SDL_bool SDL_RunBlitThreaded(SDL_BlitFunc RunBlit, SDL_BlitInfo *info)
+{
+    SDL_BlitBandJob job;
+
+    if (info->src_w != info->dst_w || info->src_h != info->dst_h ||
+        info->src_fmt->BitsPerPixel < 8) {
+        return SDL_FALSE;
+    }
+
+    /* Overlapping blits depend on the order the rows are copied in */
+    if (info->src < info->dst + (size_t)info->dst_h * info->dst_pitch &&
+        info->dst < info->src + (size_t)info->src_h * info->src_pitch) {
+        return SDL_FALSE;
+    }
+
+    job.RunBlit = RunBlit;
+    job.info = info;
+    return SDL_RunThreadedBands(SDL_RunBlitBand, &job, info->dst_w, info->dst_h, 1);
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
@@ -83,7 +336,9 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         RunBlit = (SDL_BlitFunc)src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (!SDL_RunBlitThreaded(RunBlit, info)) {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -221,8 +476,22 @@ int SDL_CalculateBlit(SDL_Surface *surface)
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
+    } else if (SDL_ISPIXELFORMAT_FLOAT(surface->format->format) ||
+               SDL_ISPIXELFORMAT_FLOAT(dst->format->format)) {
+        blit = SDL_CalculateBlitHDR(surface);
     } else if (surface->format->Rloss > 8 || dst->format->Rloss > 8) {
-        blit = SDL_Blit_Slow;
+        /* 10-bit formats have a vectorized converter for plain copies
+           and generated blitters for the common blended conversions */
+        blit = SDL_CalculateBlitHDR(surface);
+#if SDL_HAVE_BLIT_AUTO
+        if (!blit) {
+            blit = SDL_ChooseBlitFunc(surface->format->format, dst->format->format,
+                                      map->info.flags, SDL_GeneratedBlitFuncTable);
+        }
+#endif
+        if (!blit) {
+            blit = SDL_Blit_Slow;
+        }
     }
 #if SDL_HAVE_BLIT_0
     else if (surface->format->BitsPerPixel < 8 &&
@@ -266,13 +535,21 @@ int SDL_CalculateBlit(SDL_Surface *surface)
 
         if (!SDL_ISPIXELFORMAT_INDEXED(src_format) &&
             !SDL_ISPIXELFORMAT_FOURCC(src_format) &&
+            !SDL_ISPIXELFORMAT_FLOAT(src_format) &&
             !SDL_ISPIXELFORMAT_INDEXED(dst_format) &&
-            !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+            !SDL_ISPIXELFORMAT_FOURCC(dst_format) &&
+            !SDL_ISPIXELFORMAT_FLOAT(dst_format)) {
             blit = SDL_Blit_Slow;
         }
     }
     map->data = blit;
 
+    if (blit == SDL_Blit_Slow && SDL_GetHintBoolean(SDL_HINT_SURFACE_BLIT_LOG_SLOW, SDL_FALSE)) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Using slow blit from %s to %s, flags 0x%.8x",
+                    SDL_GetPixelFormatName(surface->format->format),
+                    SDL_GetPixelFormatName(dst->format->format), map->info.flags);
+    }
+
     /* Make sure we have a blit function */
     if (!blit) {
         SDL_InvalidateMap(map);
@@ -102,11 +102,31 @@ struct SDL_BlitMap
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface *surface);
 
+/* Runs func on bands of rows of a large image using the blit worker pool, following
+   SDL_HINT_SURFACE_BLIT_THREADS. The calling thread runs the band starting at row 0,
+   and the other bands start on multiples of alignment. Returns SDL_FALSE without calling
+   func if the image should be processed on the calling thread alone. */
+typedef void (*SDL_BandFunc)(void *userdata, int row, int rows);
+extern SDL_bool SDL_RunThreadedBands(SDL_BandFunc func, void *userdata, int width, int height, int alignment);
+
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface);
+extern SDL_BlitFunc SDL_CalculateBlitHDR(SDL_Surface *surface);
+
+/* Functions found in SDL_stretch.c */
+extern int SDL_PrivateSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+
+/* Scales srcrect to dst_w x dst_h a band of rows at a time, each band is
+   written at the top of the band surface and passed to the callback */
+typedef int (*SDL_StretchBandFunc)(void *userdata, SDL_Surface *band, int y, int h);
+extern int SDL_PrivateSoftStretchBands(SDL_Surface *src, const SDL_Rect *srcrect, int dst_w, int dst_h, SDL_Surface *band, SDL_ScaleMode scaleMode, SDL_StretchBandFunc callback, void *userdata);
+
+/* Fills and copies at least this big write around the cache with non-temporal
+   stores, since they'd evict most of a typical last level cache anyway */
+#define SDL_STREAMING_STORE_THRESHOLD (4 * 1024 * 1024)
 
 /*
  * Useful macros for blitting routines
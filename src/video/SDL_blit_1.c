@@ -423,6 +423,77 @@ static void Blit1to4Key(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+/* 8-bit --> 32-bit, 16 pixels at a time, gathering the colors from the palette map */
+static void SDL_TARGETING("avx2") Blit1to4AVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    const int *map = (const int *)info->table;
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 16; n -= 16) {
+            const __m128i indices = _mm_loadu_si128((const __m128i *)src);
+            const __m256i lo = _mm256_cvtepu8_epi32(indices);
+            const __m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8));
+
+            _mm256_storeu_si256((__m256i *)dst, _mm256_i32gather_epi32(map, lo, 4));
+            _mm256_storeu_si256((__m256i *)(dst + 8), _mm256_i32gather_epi32(map, hi, 4));
+            src += 16;
+            dst += 16;
+        }
+        for (; n; --n) {
+            *dst++ = (Uint32)map[*src++];
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* 8-bit --> 32-bit with colorkey, 8 pixels at a time, keyed pixels keep the destination */
+static void SDL_TARGETING("avx2") Blit1to4KeyAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    const int *map = (const int *)info->table;
+    Uint32 ckey = info->colorkey;
+    const __m256i key = _mm256_set1_epi32((int)ckey);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+            const __m256i keyed = _mm256_cmpeq_epi32(indices, key);
+            const __m256i old = _mm256_loadu_si256((const __m256i *)dst);
+
+            _mm256_storeu_si256((__m256i *)dst, _mm256_blendv_epi8(_mm256_i32gather_epi32(map, indices, 4), old, keyed));
+            src += 8;
+            dst += 8;
+        }
+        for (; n; --n) {
+            if (*src != ckey) {
+                *dst = (Uint32)map[*src];
+            }
+            src++;
+            dst++;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
 static void Blit1toNAlpha(SDL_BlitInfo *info)
 {
     int width = info->dst_w;
@@ -523,6 +594,19 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
     } else {
         which = dstfmt->BytesPerPixel;
     }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (which == 4 && SDL_HasAVX2()) {
+        switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
+        case 0:
+            return Blit1to4AVX2;
+
+        case SDL_COPY_COLORKEY:
+            return Blit1to4KeyAVX2;
+        }
+    }
+#endif
+
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
         return one_blit[which];
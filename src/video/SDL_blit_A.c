@@ -411,6 +411,96 @@ static void SDL_TARGETING("mmx") BlitRGBtoRGBPixelAlphaMMX(SDL_BlitInfo *info)
 
 #endif /* SDL_MMX_INTRINSICS */
 
+#ifdef SDL_AVX2_INTRINSICS
+
+/* Blend 8 ARGB888 pixels with pixel alpha, using the same math as BlitRGBtoRGBPixelAlphaMMX */
+static SDL_INLINE __m256i SDL_TARGETING("avx2") BlendRGBtoRGBPixelAlphaAVX2(__m256i src, __m256i dst, __m256i amask, __m256i alpha_shuffle, __m256i alpha_one)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i alpha = _mm256_and_si256(src, amask);
+    const __m256i transparent = _mm256_cmpeq_epi32(alpha, zero);
+    const __m256i opaque = _mm256_cmpeq_epi32(alpha, amask);
+    __m256i src_lo = _mm256_unpacklo_epi8(src, zero);
+    __m256i src_hi = _mm256_unpackhi_epi8(src, zero);
+    __m256i dst_lo = _mm256_unpacklo_epi8(dst, zero);
+    __m256i dst_hi = _mm256_unpackhi_epi8(dst, zero);
+    /* the pixel alpha in every channel of each pixel */
+    const __m256i alpha_lo = _mm256_shuffle_epi8(src_lo, alpha_shuffle);
+    const __m256i alpha_hi = _mm256_shuffle_epi8(src_hi, alpha_shuffle);
+    __m256i result;
+
+    /* dstRGB = (srcRGB * srcA) + (dstRGB * (1-srcA)), dstA = srcA + (dstA * (1-srcA)) */
+    dst_lo = _mm256_srli_epi16(_mm256_mullo_epi16(dst_lo, _mm256_xor_si256(alpha_lo, ff)), 8);
+    dst_hi = _mm256_srli_epi16(_mm256_mullo_epi16(dst_hi, _mm256_xor_si256(alpha_hi, ff)), 8);
+    src_lo = _mm256_srli_epi16(_mm256_mullo_epi16(src_lo, _mm256_add_epi16(_mm256_or_si256(alpha_lo, alpha_one), _mm256_srli_epi16(alpha_one, 7))), 8);
+    src_hi = _mm256_srli_epi16(_mm256_mullo_epi16(src_hi, _mm256_add_epi16(_mm256_or_si256(alpha_hi, alpha_one), _mm256_srli_epi16(alpha_one, 7))), 8);
+    result = _mm256_packus_epi16(_mm256_add_epi16(src_lo, dst_lo), _mm256_add_epi16(src_hi, dst_hi));
+
+    /* transparent pixels leave the destination alone, opaque ones are copied */
+    result = _mm256_blendv_epi8(result, dst, transparent);
+    return _mm256_blendv_epi8(result, src, opaque);
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha, 8 pixels at a time */
+static void SDL_TARGETING("avx2") BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *)info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    const int achannel = sf->Ashift / 8;
+    const __m256i amask = _mm256_set1_epi32((int)sf->Amask);
+    Uint8 shuffle[16];
+    Sint16 one[8];
+    __m256i alpha_shuffle, alpha_one;
+    int i;
+
+    /* The unpacked pixels have 16-bit channels, pick the alpha word of each pixel.
+       alpha_one is 0xFF in the alpha channel: it makes the source factor of that
+       channel 255, and (0xFF >> 7) adds 1 so the source alpha passes through exactly. */
+    for (i = 0; i < 16; ++i) {
+        shuffle[i] = (Uint8)(((i / 8) * 8) + (achannel * 2) + (i % 2));
+    }
+    for (i = 0; i < 8; ++i) {
+        one[i] = ((i % 4) == achannel) ? 0xFF : 0;
+    }
+    alpha_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)shuffle));
+    alpha_one = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)one));
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i src = _mm256_loadu_si256((const __m256i *)srcp);
+            const __m256i dst = _mm256_loadu_si256((const __m256i *)dstp);
+            _mm256_storeu_si256((__m256i *)dstp, BlendRGBtoRGBPixelAlphaAVX2(src, dst, amask, alpha_shuffle, alpha_one));
+            srcp += 8;
+            dstp += 8;
+        }
+        if (n) {
+            /* Blend the last few pixels through a full sized buffer */
+            Uint32 src[8], dst[8];
+
+            SDL_zeroa(src);
+            SDL_zeroa(dst);
+            SDL_memcpy(src, srcp, n * sizeof(Uint32));
+            SDL_memcpy(dst, dstp, n * sizeof(Uint32));
+            _mm256_storeu_si256((__m256i *)dst, BlendRGBtoRGBPixelAlphaAVX2(_mm256_loadu_si256((const __m256i *)src), _mm256_loadu_si256((const __m256i *)dst), amask, alpha_shuffle, alpha_one));
+            SDL_memcpy(dstp, dst, n * sizeof(Uint32));
+            srcp += n;
+            dstp += n;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#endif /* SDL_AVX2_INTRINSICS */
+
 #ifdef SDL_ARM_SIMD_BLITTERS
 void BlitARGBto565PixelAlphaARMSIMDAsm(int32_t w, int32_t h, uint16_t *dst, int32_t dst_stride, uint32_t *src, int32_t src_stride);
 
@@ -1359,6 +1449,13 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 
         case 4:
             if (sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#ifdef SDL_AVX2_INTRINSICS
+                if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
+                    if (SDL_HasAVX2()) {
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+                    }
+                }
+#endif /* SDL_AVX2_INTRINSICS */
 #ifdef SDL_MMX_INTRINSICS
                 if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
                     if (SDL_HasMMX()) {
@@ -42,7 +42,9 @@ enum blit_features
     BLIT_FEATURE_HAS_MMX = 1,
     BLIT_FEATURE_HAS_ALTIVEC = 2,
     BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH = 4,
-    BLIT_FEATURE_HAS_ARM_SIMD = 8
+    BLIT_FEATURE_HAS_ARM_SIMD = 8,
+    BLIT_FEATURE_HAS_AVX2 = 16,
+    BLIT_FEATURE_HAS_AVX512F = 32
 };
 
 #ifdef SDL_ALTIVEC_BLITTERS
@@ -902,7 +904,8 @@ static enum blit_features GetBlitFeatures(void)
 #endif
 #else
 /* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((SDL_HasMMX() ? BLIT_FEATURE_HAS_MMX : 0) | (SDL_HasARMSIMD() ? BLIT_FEATURE_HAS_ARM_SIMD : 0))
+#define GetBlitFeatures() ((SDL_HasMMX() ? BLIT_FEATURE_HAS_MMX : 0) | (SDL_HasARMSIMD() ? BLIT_FEATURE_HAS_ARM_SIMD : 0) | \
+                           (SDL_HasAVX2() ? BLIT_FEATURE_HAS_AVX2 : 0) | (SDL_HasAVX512F() ? BLIT_FEATURE_HAS_AVX512F : 0))
 #endif
 
 #ifdef SDL_ARM_SIMD_BLITTERS
@@ -1640,6 +1643,58 @@ static void Blit_RGB565_ARGB8888(SDL_BlitInfo * info)
     Blit_RGB565_32(info, RGB565_ARGB8888_LUT);
 }
 
+/* *INDENT-ON* */ /* clang-format on */
+
+#ifdef SDL_AVX2_INTRINSICS
+/* RGB 5-6-5 --> ARGB 8-8-8-8, 16 pixels at a time.
+   The channels are expanded with multiplies that give the same values as RGB565_ARGB8888_LUT */
+static void SDL_TARGETING("avx2") Blit_RGB565_ARGB8888AVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i mask3 = _mm256_set1_epi16(0x07);
+    const __m256i mult5 = _mm256_set1_epi16(1053);
+    const __m256i mult3 = _mm256_set1_epi16(259);
+    const __m256i alpha = _mm256_set1_epi16((short)0xFF00);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 16; n -= 16) {
+            const __m256i pixels = _mm256_loadu_si256((const __m256i *)src);
+            /* floor(x * 255 / 31) == (x * 1053) >> 7 for 5 bit channels */
+            const __m256i r = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(pixels, 11), mult5), 7);
+            const __m256i b = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(pixels, mask5), mult5), 7);
+            /* The high 3 bits of green are scaled like the LUT, the low 3 bits are added in as is */
+            const __m256i g = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(pixels, 8), mask3), mult3), 3),
+                                               _mm256_slli_epi16(_mm256_and_si256(_mm256_srli_epi16(pixels, 5), mask3), 2));
+            const __m256i gb = _mm256_or_si256(_mm256_slli_epi16(g, 8), b);
+            const __m256i ar = _mm256_or_si256(alpha, r);
+            const __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+            const __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+
+            _mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i *)(dst + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+            src += 32;
+            dst += 16;
+        }
+        for (; n; --n) {
+            *dst++ = RGB565_32(dst, src, RGB565_ARGB8888_LUT);
+            src += 2;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+/* *INDENT-OFF* */ /* clang-format off */
+
 /* Special optimized blit for RGB 5-6-5 --> ABGR 8-8-8-8 */
 static const Uint32 RGB565_ABGR8888_LUT[512] = {
     0xff000000, 0x00000000, 0xff080000, 0x00002000,
@@ -2175,6 +2230,151 @@ static void BlitNto1(SDL_BlitInfo *info)
 }
 
 /* blits 32 bit RGB<->RGBA with both surfaces having the same R,G,B fields */
+#if defined(SDL_AVX2_INTRINSICS) || defined(SDL_AVX512F_INTRINSICS)
+/* Any 8-8-8-8 format to any other, each channel is a byte so it can be moved as a whole */
+static SDL_bool Is8888Format(const SDL_PixelFormat *fmt)
+{
+    return fmt->BytesPerPixel == 4 &&
+           SDL_PIXELTYPE(fmt->format) == SDL_PIXELTYPE_PACKED32 &&
+           SDL_PIXELLAYOUT(fmt->format) == SDL_PACKEDLAYOUT_8888;
+}
+
+/* Set up the channel moves shared by the 8888 swizzle blitters.
+   Channels missing from the source are zero, with the (SET_ALPHA) alpha or'd in afterwards. */
+static void Get8888Swizzle(const SDL_BlitInfo *info, int srcshift[4], int dstshift[4], Uint32 *fill)
+{
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+
+    srcshift[0] = srcfmt->Rshift;
+    srcshift[1] = srcfmt->Gshift;
+    srcshift[2] = srcfmt->Bshift;
+    srcshift[3] = srcfmt->Amask ? srcfmt->Ashift : -1;
+    dstshift[0] = dstfmt->Rshift;
+    dstshift[1] = dstfmt->Gshift;
+    dstshift[2] = dstfmt->Bshift;
+    dstshift[3] = dstfmt->Amask ? dstfmt->Ashift : -1;
+
+    *fill = 0;
+    if (dstfmt->Amask && !srcfmt->Amask) {
+        *fill = ((Uint32)info->a) << dstfmt->Ashift;
+    }
+}
+
+static SDL_INLINE Uint32 Swizzle8888(Uint32 pixel, const int srcshift[4], const int dstshift[4], Uint32 fill)
+{
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        if (srcshift[i] >= 0 && dstshift[i] >= 0) {
+            fill |= ((pixel >> srcshift[i]) & 0xFF) << dstshift[i];
+        }
+    }
+    return fill;
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") Blit8888to8888PixelSwizzleAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *)info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    int srcshift[4], dstshift[4];
+    Uint8 control[16];
+    Uint32 fill;
+    __m256i shuffle, alpha;
+    int i, j;
+
+    Get8888Swizzle(info, srcshift, dstshift, &fill);
+
+    /* pshufb control for one pixel, 0x80 clears the byte */
+    SDL_memset(control, 0x80, 4);
+    for (i = 0; i < 4; ++i) {
+        if (srcshift[i] >= 0 && dstshift[i] >= 0) {
+            control[dstshift[i] / 8] = (Uint8)(srcshift[i] / 8);
+        }
+    }
+    for (i = 1; i < 4; ++i) {
+        for (j = 0; j < 4; ++j) {
+            control[i * 4 + j] = (control[j] & 0x80) ? 0x80 : (Uint8)(control[j] + i * 4);
+        }
+    }
+    shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)control));
+    alpha = _mm256_set1_epi32((int)fill);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i pixels = _mm256_loadu_si256((const __m256i *)src);
+            _mm256_storeu_si256((__m256i *)dst, _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha));
+            src += 8;
+            dst += 8;
+        }
+        for (; n; --n) {
+            *dst++ = Swizzle8888(*src++, srcshift, dstshift, fill);
+        }
+        src = (Uint32 *)((Uint8 *)src + srcskip);
+        dst = (Uint32 *)((Uint8 *)dst + dstskip);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_AVX512F_INTRINSICS
+/* AVX-512F has no byte shuffle, so the channels are moved with 32-bit shifts */
+static void SDL_TARGETING("avx512f") Blit8888to8888PixelSwizzleAVX512F(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *)info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    int srcshift[4], dstshift[4];
+    __m128i srccount[4], dstcount[4];
+    int i, nchannels = 0;
+    Uint32 fill;
+    const __m512i mask = _mm512_set1_epi32(0xFF);
+    __m512i alpha;
+
+    Get8888Swizzle(info, srcshift, dstshift, &fill);
+    for (i = 0; i < 4; ++i) {
+        if (srcshift[i] >= 0 && dstshift[i] >= 0) {
+            srccount[nchannels] = _mm_cvtsi32_si128(srcshift[i]);
+            dstcount[nchannels] = _mm_cvtsi32_si128(dstshift[i]);
+            ++nchannels;
+        }
+    }
+    alpha = _mm512_set1_epi32((int)fill);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 16; n -= 16) {
+            const __m512i pixels = _mm512_loadu_si512((const void *)src);
+            __m512i result = alpha;
+
+            for (i = 0; i < nchannels; ++i) {
+                const __m512i channel = _mm512_and_si512(_mm512_srl_epi32(pixels, srccount[i]), mask);
+                result = _mm512_or_si512(result, _mm512_sll_epi32(channel, dstcount[i]));
+            }
+            _mm512_storeu_si512((void *)dst, result);
+            src += 16;
+            dst += 16;
+        }
+        for (; n; --n) {
+            *dst++ = Swizzle8888(*src++, srcshift, dstshift, fill);
+        }
+        src = (Uint32 *)((Uint8 *)src + srcskip);
+        dst = (Uint32 *)((Uint8 *)dst + dstskip);
+    }
+}
+#endif /* SDL_AVX512F_INTRINSICS */
+
 static void Blit4to4MaskAlpha(SDL_BlitInfo *info)
 {
     int width = info->dst_w;
@@ -2550,8 +2750,142 @@ static void BlitNto1Key(SDL_BlitInfo *info)
     }
 }
 
+/* Copies the pixels that don't match the colorkey as (src & andmask) | ormask,
+   returning the number of pixels done, the caller finishes the row */
+typedef int (*BlitKeyRow32Func)(const Uint32 *src, Uint32 *dst, int width, Uint32 rgbmask, Uint32 ckey, Uint32 andmask, Uint32 ormask);
+typedef int (*BlitKeyRow16Func)(const Uint16 *src, Uint16 *dst, int width, Uint16 rgbmask, Uint16 ckey);
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") BlitKeyRow32_SSE2(const Uint32 *src, Uint32 *dst, int width, Uint32 rgbmask, Uint32 ckey, Uint32 andmask, Uint32 ormask)
+{
+    const __m128i vrgbmask = _mm_set1_epi32((int)rgbmask);
+    const __m128i vckey = _mm_set1_epi32((int)ckey);
+    const __m128i vandmask = _mm_set1_epi32((int)andmask);
+    const __m128i vormask = _mm_set1_epi32((int)ormask);
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(pixels, vrgbmask), vckey);
+        const __m128i copied = _mm_or_si128(_mm_and_si128(pixels, vandmask), vormask);
+        const __m128i old = _mm_loadu_si128((const __m128i *)(dst + x));
+
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(keyed, old), _mm_andnot_si128(keyed, copied)));
+    }
+    return count;
+}
+
+static int SDL_TARGETING("sse2") BlitKeyRow16_SSE2(const Uint16 *src, Uint16 *dst, int width, Uint16 rgbmask, Uint16 ckey)
+{
+    const __m128i vrgbmask = _mm_set1_epi16((short)rgbmask);
+    const __m128i vckey = _mm_set1_epi16((short)ckey);
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(pixels, vrgbmask), vckey);
+        const __m128i old = _mm_loadu_si128((const __m128i *)(dst + x));
+
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(keyed, old), _mm_andnot_si128(keyed, pixels)));
+    }
+    return count;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static int BlitKeyRow32_NEON(const Uint32 *src, Uint32 *dst, int width, Uint32 rgbmask, Uint32 ckey, Uint32 andmask, Uint32 ormask)
+{
+    const uint32x4_t vrgbmask = vdupq_n_u32(rgbmask);
+    const uint32x4_t vckey = vdupq_n_u32(ckey);
+    const uint32x4_t vandmask = vdupq_n_u32(andmask);
+    const uint32x4_t vormask = vdupq_n_u32(ormask);
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const uint32x4_t pixels = vld1q_u32(src + x);
+        const uint32x4_t keyed = vceqq_u32(vandq_u32(pixels, vrgbmask), vckey);
+        const uint32x4_t copied = vorrq_u32(vandq_u32(pixels, vandmask), vormask);
+
+        vst1q_u32(dst + x, vbslq_u32(keyed, vld1q_u32(dst + x), copied));
+    }
+    return count;
+}
+
+static int BlitKeyRow16_NEON(const Uint16 *src, Uint16 *dst, int width, Uint16 rgbmask, Uint16 ckey)
+{
+    const uint16x8_t vrgbmask = vdupq_n_u16(rgbmask);
+    const uint16x8_t vckey = vdupq_n_u16(ckey);
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const uint16x8_t pixels = vld1q_u16(src + x);
+        const uint16x8_t keyed = vceqq_u16(vandq_u16(pixels, vrgbmask), vckey);
+
+        vst1q_u16(dst + x, vbslq_u16(keyed, vld1q_u16(dst + x), pixels));
+    }
+    return count;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static BlitKeyRow32Func GetBlitKeyRow32Func(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return BlitKeyRow32_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return BlitKeyRow32_NEON;
+    }
+#endif
+    return NULL;
+}
+
+static BlitKeyRow16Func GetBlitKeyRow16Func(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return BlitKeyRow16_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return BlitKeyRow16_NEON;
+    }
+#endif
+    return NULL;
+}
+
+/* Blits 32-bit pixels that don't match the colorkey as (src & andmask) | ormask */
+static void BlitKey32(SDL_BlitInfo *info, Uint32 rgbmask, Uint32 ckey, Uint32 andmask, Uint32 ormask)
+{
+    const BlitKeyRow32Func row_func = GetBlitKeyRow32Func();
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src32 = (Uint32 *)info->src;
+    Uint32 *dst32 = (Uint32 *)info->dst;
+
+    while (height--) {
+        int x = row_func ? row_func(src32, dst32, width, rgbmask, ckey, andmask, ormask) : 0;
+
+        for (; x < width; ++x) {
+            if ((src32[x] & rgbmask) != ckey) {
+                dst32[x] = (src32[x] & andmask) | ormask;
+            }
+        }
+        src32 = (Uint32 *)((Uint8 *)src32 + width * 4 + info->src_skip);
+        dst32 = (Uint32 *)((Uint8 *)dst32 + width * 4 + info->dst_skip);
+    }
+}
+
 static void Blit2to2Key(SDL_BlitInfo *info)
 {
+    const BlitKeyRow16Func row_func = GetBlitKeyRow16Func();
     int width = info->dst_w;
     int height = info->dst_h;
     Uint16 *srcp = (Uint16 *)info->src;
@@ -2567,19 +2901,15 @@ static void Blit2to2Key(SDL_BlitInfo *info)
     ckey &= rgbmask;
 
     while (height--) {
-        /* *INDENT-OFF* */ /* clang-format off */
-        DUFFS_LOOP(
-        {
-            if ( (*srcp & rgbmask) != ckey ) {
-                *dstp = *srcp;
+        int x = row_func ? row_func(srcp, dstp, width, (Uint16)rgbmask, (Uint16)ckey) : 0;
+
+        for (; x < width; ++x) {
+            if ((srcp[x] & rgbmask) != ckey) {
+                dstp[x] = srcp[x];
             }
-            dstp++;
-            srcp++;
-        },
-        width);
-        /* *INDENT-ON* */ /* clang-format on */
-        srcp += srcskip;
-        dstp += dstskip;
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
     }
 }
 
@@ -2606,46 +2936,14 @@ static void BlitNtoNKey(SDL_BlitInfo *info)
 
     /* BPP 4, same rgb */
     if (srcbpp == 4 && dstbpp == 4 && srcfmt->Rmask == dstfmt->Rmask && srcfmt->Gmask == dstfmt->Gmask && srcfmt->Bmask == dstfmt->Bmask) {
-        Uint32 *src32 = (Uint32 *)src;
-        Uint32 *dst32 = (Uint32 *)dst;
-
         if (dstfmt->Amask) {
             /* RGB->RGBA, SET_ALPHA */
-            Uint32 mask = ((Uint32)info->a) << dstfmt->Ashift;
-            while (height--) {
-                /* *INDENT-OFF* */ /* clang-format off */
-                DUFFS_LOOP(
-                {
-                    if ((*src32 & rgbmask) != ckey) {
-                        *dst32 = *src32 | mask;
-                    }
-                    ++dst32;
-                    ++src32;
-                }, width);
-                /* *INDENT-ON* */ /* clang-format on */
-                src32 = (Uint32 *)((Uint8 *)src32 + srcskip);
-                dst32 = (Uint32 *)((Uint8 *)dst32 + dstskip);
-            }
-            return;
+            BlitKey32(info, rgbmask, ckey, ~0u, ((Uint32)info->a) << dstfmt->Ashift);
         } else {
             /* RGBA->RGB, NO_ALPHA */
-            Uint32 mask = srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask;
-            while (height--) {
-                /* *INDENT-OFF* */ /* clang-format off */
-                DUFFS_LOOP(
-                {
-                    if ((*src32 & rgbmask) != ckey) {
-                        *dst32 = *src32 & mask;
-                    }
-                    ++dst32;
-                    ++src32;
-                }, width);
-                /* *INDENT-ON* */ /* clang-format on */
-                src32 = (Uint32 *)((Uint8 *)src32 + srcskip);
-                dst32 = (Uint32 *)((Uint8 *)dst32 + dstskip);
-            }
-            return;
+            BlitKey32(info, rgbmask, ckey, srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask, 0);
         }
+        return;
     }
 
 #if HAVE_FAST_WRITE_INT8
@@ -2877,32 +3175,13 @@ static void BlitNtoNKeyCopyAlpha(SDL_BlitInfo *info)
     dstbpp = dstfmt->BytesPerPixel;
     ckey &= rgbmask;
 
-    /* Fastpath: same source/destination format, with Amask, bpp 32, loop is vectorized. ~10x faster */
-    if (srcfmt->format == dstfmt->format) {
-
-        if (srcfmt->format == SDL_PIXELFORMAT_ARGB8888 ||
-            srcfmt->format == SDL_PIXELFORMAT_ABGR8888 ||
-            srcfmt->format == SDL_PIXELFORMAT_BGRA8888 ||
-            srcfmt->format == SDL_PIXELFORMAT_RGBA8888) {
-
-            Uint32 *src32 = (Uint32 *)src;
-            Uint32 *dst32 = (Uint32 *)dst;
-            while (height--) {
-                /* *INDENT-OFF* */ /* clang-format off */
-                DUFFS_LOOP(
-                {
-                    if ((*src32 & rgbmask) != ckey) {
-                        *dst32 = *src32;
-                    }
-                    ++src32;
-                    ++dst32;
-                },
-                width);
-                /* *INDENT-ON* */ /* clang-format on */
-                src32 = (Uint32 *)((Uint8 *)src32 + srcskip);
-                dst32 = (Uint32 *)((Uint8 *)dst32 + dstskip);
-            }
-        }
+    /* Fastpath: same source/destination format, with Amask, bpp 32 */
+    if (srcfmt->format == dstfmt->format &&
+        (srcfmt->format == SDL_PIXELFORMAT_ARGB8888 ||
+         srcfmt->format == SDL_PIXELFORMAT_ABGR8888 ||
+         srcfmt->format == SDL_PIXELFORMAT_BGRA8888 ||
+         srcfmt->format == SDL_PIXELFORMAT_RGBA8888)) {
+        BlitKey32(info, rgbmask, ckey, ~0u, 0);
         return;
     }
 
@@ -3225,6 +3504,10 @@ static const struct blit_table normal_blit_2[] = {
       BLIT_FEATURE_HAS_ARM_SIMD, Blit_RGB444_XRGB8888ARMSIMD, NO_ALPHA | COPY_ALPHA },
 #endif
 #if SDL_HAVE_BLIT_N_RGB565
+#ifdef SDL_AVX2_INTRINSICS
+    { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+      BLIT_FEATURE_HAS_AVX2, Blit_RGB565_ARGB8888AVX2, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+#endif
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
       0, Blit_RGB565_ARGB8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
@@ -3374,6 +3657,18 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
             if (dstfmt->Amask) {
                 a_need = srcfmt->Amask ? COPY_ALPHA : SET_ALPHA;
             }
+#ifdef SDL_AVX512F_INTRINSICS
+            if (Is8888Format(srcfmt) && Is8888Format(dstfmt) &&
+                (GetBlitFeatures() & BLIT_FEATURE_HAS_AVX512F)) {
+                return Blit8888to8888PixelSwizzleAVX512F;
+            }
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+            if (Is8888Format(srcfmt) && Is8888Format(dstfmt) &&
+                (GetBlitFeatures() & BLIT_FEATURE_HAS_AVX2)) {
+                return Blit8888to8888PixelSwizzleAVX2;
+            }
+#endif
             table = normal_blit[srcfmt->BytesPerPixel - 1];
             for (which = 0; table[which].dstbpp; ++which) {
                 if (MASKOK(srcfmt->Rmask, table[which].srcR) &&
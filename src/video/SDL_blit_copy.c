@@ -24,7 +24,7 @@
 #include "SDL_blit_copy.h"
 
 #ifdef SDL_SSE_INTRINSICS
-/* This assumes 16-byte aligned src and dst */
+/* This assumes 16-byte aligned src and dst, and writes around the cache */
 static SDL_INLINE void SDL_TARGETING("sse") SDL_memcpySSE(Uint8 *dst, const Uint8 *src, int len)
 {
     int i;
@@ -137,7 +137,8 @@ void SDL_BlitCopy(SDL_BlitInfo *info)
     }
 
 #ifdef SDL_SSE_INTRINSICS
-    if (SDL_HasSSE() &&
+    /* Smaller copies are better off staying in the cache for whatever reads them next */
+    if (SDL_HasSSE() && (size_t)w * h >= SDL_STREAMING_STORE_THRESHOLD &&
         !((uintptr_t)src & 15) && !(srcskip & 15) &&
         !((uintptr_t)dst & 15) && !(dstskip & 15)) {
         while (h--) {
@@ -145,6 +146,7 @@ void SDL_BlitCopy(SDL_BlitInfo *info)
             src += srcskip;
             dst += dstskip;
         }
+        _mm_sfence();
         return;
     }
 #endif
@@ -0,0 +1,587 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_blit.h"
+
+/* Conversions between the 10-bit and floating point formats and everything else.
+
+   Rows are converted a chunk at a time: the source pixels are decoded into one
+   plane of floats per channel, normalized to 0..1 for the integer formats, and
+   then encoded into the destination format.  Float channels keep values
+   outside of 0..1, they are only clamped when encoding an integer format.
+   The vectorized decoders and encoders give exactly the same results as the
+   scalar ones and return how many pixels they converted, leaving the rest of
+   the chunk to the scalar code.
+ */
+
+#define HDR_CHUNK 64
+
+typedef enum
+{
+    HDR_FORMAT_PACKED,  /* channels described by masks, up to 32 bits */
+    HDR_FORMAT_INDEXED, /* 8-bit palette indices */
+    HDR_FORMAT_FLOAT16,
+    HDR_FORMAT_FLOAT32
+} HDR_FormatType;
+
+typedef struct
+{
+    HDR_FormatType type;
+    int bpp;
+    Uint32 shift[4]; /* R, G, B, A */
+    Uint32 max[4];   /* largest value of the channel, 0 if it isn't there */
+    float scale[4];  /* 1 / max */
+    int plane[4];    /* for float formats, the channel stored at each position */
+    const SDL_Palette *palette;
+} HDR_Format;
+
+/* Half float conversions, rounding to nearest even.  The vectorized versions follow
+   the same steps on the bit patterns, so they give the same results. */
+typedef union
+{
+    Uint32 u;
+    float f;
+} HDR_Float;
+
+static SDL_INLINE float HDR_HalfToFloat(Uint16 h)
+{
+    HDR_Float o, magic;
+
+    magic.u = (254 - 15) << 23;
+    o.u = (Uint32)(h & 0x7FFF) << 13; /* exponent and mantissa */
+    o.f *= magic.f;                   /* rebias the exponent, also normalizes denormals */
+    if ((h & 0x7FFF) > 0x7BFF) {
+        o.u |= 255 << 23; /* infinity or NaN */
+    }
+    o.u |= (Uint32)(h & 0x8000) << 16;
+    return o.f;
+}
+
+static SDL_INLINE Uint16 HDR_FloatToHalf(float value)
+{
+    HDR_Float f, denorm_magic;
+    Uint32 sign, o;
+
+    f.f = value;
+    sign = f.u & 0x80000000;
+    f.u ^= sign;
+    if (f.u >= ((127 + 16) << 23)) {
+        o = (f.u > (255 << 23)) ? 0x7E00 : 0x7C00; /* NaN and infinity, including overflows */
+    } else if (f.u < ((127 - 14) << 23)) {
+        /* Denormal or zero, let the float addition do the rounding */
+        denorm_magic.u = ((127 - 15) + (23 - 10) + 1) << 23;
+        f.f += denorm_magic.f;
+        o = f.u - denorm_magic.u;
+    } else {
+        const Uint32 mant_odd = (f.u >> 13) & 1;
+        f.u += ((Uint32)(15 - 127) << 23) + 0xFFF;
+        f.u += mant_odd;
+        o = f.u >> 13;
+    }
+    return (Uint16)(o | (sign >> 16));
+}
+
+static SDL_INLINE float HDR_Clamp(float f)
+{
+    /* NaN ends up as 1, like the vectorized min and max */
+    f = (f < 1.0f) ? f : 1.0f;
+    f = (f > 0.0f) ? f : 0.0f;
+    return f;
+}
+
+static SDL_bool HDR_GetFormat(const SDL_PixelFormat *fmt, HDR_Format *hdr)
+{
+    const Uint32 masks[4] = { fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask };
+    const Uint8 shifts[4] = { fmt->Rshift, fmt->Gshift, fmt->Bshift, fmt->Ashift };
+    int i;
+
+    SDL_zerop(hdr);
+    hdr->bpp = fmt->BytesPerPixel;
+
+    if (SDL_ISPIXELFORMAT_FLOAT(fmt->format)) {
+        static const int orders[][4] = {
+            { 0, 1, 2, 3 }, /* SDL_ARRAYORDER_RGBA */
+            { 3, 0, 1, 2 }, /* SDL_ARRAYORDER_ARGB */
+            { 2, 1, 0, 3 }, /* SDL_ARRAYORDER_BGRA */
+            { 3, 2, 1, 0 }  /* SDL_ARRAYORDER_ABGR */
+        };
+        const int *order;
+
+        switch (SDL_PIXELORDER(fmt->format)) {
+        case SDL_ARRAYORDER_RGBA:
+            order = orders[0];
+            break;
+        case SDL_ARRAYORDER_ARGB:
+            order = orders[1];
+            break;
+        case SDL_ARRAYORDER_BGRA:
+            order = orders[2];
+            break;
+        case SDL_ARRAYORDER_ABGR:
+            order = orders[3];
+            break;
+        default:
+            return SDL_FALSE;
+        }
+        hdr->type = (SDL_PIXELTYPE(fmt->format) == SDL_PIXELTYPE_ARRAYF16) ? HDR_FORMAT_FLOAT16 : HDR_FORMAT_FLOAT32;
+        for (i = 0; i < 4; ++i) {
+            hdr->plane[i] = order[i];
+        }
+        return SDL_TRUE;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(fmt->format)) {
+        if (fmt->BitsPerPixel != 8 || !fmt->palette) {
+            return SDL_FALSE;
+        }
+        hdr->type = HDR_FORMAT_INDEXED;
+        hdr->palette = fmt->palette;
+        return SDL_TRUE;
+    }
+
+    if (hdr->bpp < 1 || hdr->bpp > 4) {
+        return SDL_FALSE;
+    }
+    hdr->type = HDR_FORMAT_PACKED;
+    for (i = 0; i < 4; ++i) {
+        hdr->shift[i] = shifts[i];
+        hdr->max[i] = masks[i] >> shifts[i];
+        hdr->scale[i] = hdr->max[i] ? 1.0f / (float)hdr->max[i] : 0.0f;
+    }
+    return SDL_TRUE;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* 4 half floats in the low 16 bits of each lane */
+static SDL_INLINE __m128 SDL_TARGETING("sse2") HDR_HalfToFloat_SSE2(__m128i h)
+{
+    const __m128i expmant = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i infnan = _mm_and_si128(_mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(255 << 23));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expmant), 16);
+    return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(infnan, sign)));
+}
+
+/* Returns the half floats in the low 16 bits of each lane */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") HDR_FloatToHalf_SSE2(__m128 f)
+{
+    const __m128i denorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128 justsign = _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+    const __m128 absf = _mm_xor_ps(f, justsign);
+    const __m128i absi = _mm_castps_si128(absf);
+    const __m128i isnan = _mm_castps_si128(_mm_cmpunord_ps(absf, absf));
+    const __m128i isregular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absi);
+    const __m128i isdenorm = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absi);
+    const __m128i infnan = _mm_or_si128(_mm_and_si128(isnan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+    const __m128i denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(denorm_magic))), denorm_magic);
+    const __m128i mant_odd = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absi, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), mant_odd), 13);
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isdenorm, denorm), _mm_andnot_si128(isdenorm, normal));
+    const __m128i joined = _mm_or_si128(_mm_and_si128(isregular, finite), _mm_andnot_si128(isregular, infnan));
+    return _mm_or_si128(joined, _mm_srli_epi32(_mm_castps_si128(justsign), 16));
+}
+
+/* Packs the low 16 bits of each lane without saturating */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") HDR_Pack16_SSE2(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+static int SDL_TARGETING("sse2") HDR_Decode_SSE2(const HDR_Format *hdr, const Uint8 *src, float *planes, int n)
+{
+    int i, c;
+
+    switch (hdr->type) {
+    case HDR_FORMAT_PACKED:
+        if (hdr->bpp != 4) {
+            return 0;
+        }
+        for (i = 0; i + 4 <= n; i += 4) {
+            const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i * 4));
+            for (c = 0; c < 4; ++c) {
+                __m128 value;
+                if (hdr->max[c]) {
+                    const __m128i bits = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128((int)hdr->shift[c])), _mm_set1_epi32((int)hdr->max[c]));
+                    value = _mm_mul_ps(_mm_cvtepi32_ps(bits), _mm_set1_ps(hdr->scale[c]));
+                } else {
+                    value = _mm_set1_ps((c == 3) ? 1.0f : 0.0f);
+                }
+                _mm_storeu_ps(planes + c * HDR_CHUNK + i, value);
+            }
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT16:
+        for (i = 0; i + 4 <= n; i += 4) {
+            const __m128i lo = _mm_loadu_si128((const __m128i *)(src + i * 8));
+            const __m128i hi = _mm_loadu_si128((const __m128i *)(src + i * 8 + 16));
+            const __m128i zero = _mm_setzero_si128();
+            __m128 v[4];
+            v[0] = HDR_HalfToFloat_SSE2(_mm_unpacklo_epi16(lo, zero));
+            v[1] = HDR_HalfToFloat_SSE2(_mm_unpackhi_epi16(lo, zero));
+            v[2] = HDR_HalfToFloat_SSE2(_mm_unpacklo_epi16(hi, zero));
+            v[3] = HDR_HalfToFloat_SSE2(_mm_unpackhi_epi16(hi, zero));
+            _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+            for (c = 0; c < 4; ++c) {
+                _mm_storeu_ps(planes + hdr->plane[c] * HDR_CHUNK + i, v[c]);
+            }
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT32:
+        for (i = 0; i + 4 <= n; i += 4) {
+            const float *pixels = (const float *)(src + i * 16);
+            __m128 v[4];
+            v[0] = _mm_loadu_ps(pixels);
+            v[1] = _mm_loadu_ps(pixels + 4);
+            v[2] = _mm_loadu_ps(pixels + 8);
+            v[3] = _mm_loadu_ps(pixels + 12);
+            _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+            for (c = 0; c < 4; ++c) {
+                _mm_storeu_ps(planes + hdr->plane[c] * HDR_CHUNK + i, v[c]);
+            }
+        }
+        return i;
+
+    default:
+        return 0;
+    }
+}
+
+static int SDL_TARGETING("sse2") HDR_Encode_SSE2(const HDR_Format *hdr, const float *planes, Uint8 *dst, int n)
+{
+    int i, c;
+
+    switch (hdr->type) {
+    case HDR_FORMAT_PACKED:
+        if (hdr->bpp != 4) {
+            return 0;
+        }
+        for (i = 0; i + 4 <= n; i += 4) {
+            __m128i pixels = _mm_setzero_si128();
+            for (c = 0; c < 4; ++c) {
+                if (hdr->max[c]) {
+                    __m128 value = _mm_loadu_ps(planes + c * HDR_CHUNK + i);
+                    value = _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+                    value = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps((float)hdr->max[c])), _mm_set1_ps(0.5f));
+                    pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_cvttps_epi32(value), _mm_cvtsi32_si128((int)hdr->shift[c])));
+                }
+            }
+            _mm_storeu_si128((__m128i *)(dst + i * 4), pixels);
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT16:
+        for (i = 0; i + 4 <= n; i += 4) {
+            __m128 v[4];
+            for (c = 0; c < 4; ++c) {
+                v[c] = _mm_loadu_ps(planes + hdr->plane[c] * HDR_CHUNK + i);
+            }
+            _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+            _mm_storeu_si128((__m128i *)(dst + i * 8), HDR_Pack16_SSE2(HDR_FloatToHalf_SSE2(v[0]), HDR_FloatToHalf_SSE2(v[1])));
+            _mm_storeu_si128((__m128i *)(dst + i * 8 + 16), HDR_Pack16_SSE2(HDR_FloatToHalf_SSE2(v[2]), HDR_FloatToHalf_SSE2(v[3])));
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT32:
+        for (i = 0; i + 4 <= n; i += 4) {
+            float *pixels = (float *)(dst + i * 16);
+            __m128 v[4];
+            for (c = 0; c < 4; ++c) {
+                v[c] = _mm_loadu_ps(planes + hdr->plane[c] * HDR_CHUNK + i);
+            }
+            _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+            _mm_storeu_ps(pixels, v[0]);
+            _mm_storeu_ps(pixels + 4, v[1]);
+            _mm_storeu_ps(pixels + 8, v[2]);
+            _mm_storeu_ps(pixels + 12, v[3]);
+        }
+        return i;
+
+    default:
+        return 0;
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+/* The NEON versions need the half float conversions and the number-preferring
+   min and max of AArch64 */
+#if defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define HDR_NEON
+
+static int HDR_Decode_NEON(const HDR_Format *hdr, const Uint8 *src, float *planes, int n)
+{
+    int i, c;
+
+    switch (hdr->type) {
+    case HDR_FORMAT_PACKED:
+        if (hdr->bpp != 4) {
+            return 0;
+        }
+        for (i = 0; i + 4 <= n; i += 4) {
+            const uint32x4_t pixels = vld1q_u32((const uint32_t *)(src + i * 4));
+            for (c = 0; c < 4; ++c) {
+                float32x4_t value;
+                if (hdr->max[c]) {
+                    const uint32x4_t bits = vandq_u32(vshlq_u32(pixels, vdupq_n_s32(-(int)hdr->shift[c])), vdupq_n_u32(hdr->max[c]));
+                    value = vmulq_n_f32(vcvtq_f32_u32(bits), hdr->scale[c]);
+                } else {
+                    value = vdupq_n_f32((c == 3) ? 1.0f : 0.0f);
+                }
+                vst1q_f32(planes + c * HDR_CHUNK + i, value);
+            }
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT16:
+        for (i = 0; i + 4 <= n; i += 4) {
+            const uint16x4x4_t v = vld4_u16((const uint16_t *)(src + i * 8));
+            for (c = 0; c < 4; ++c) {
+                vst1q_f32(planes + hdr->plane[c] * HDR_CHUNK + i, vcvt_f32_f16(vreinterpret_f16_u16(v.val[c])));
+            }
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT32:
+        for (i = 0; i + 4 <= n; i += 4) {
+            const float32x4x4_t v = vld4q_f32((const float *)(src + i * 16));
+            for (c = 0; c < 4; ++c) {
+                vst1q_f32(planes + hdr->plane[c] * HDR_CHUNK + i, v.val[c]);
+            }
+        }
+        return i;
+
+    default:
+        return 0;
+    }
+}
+
+static int HDR_Encode_NEON(const HDR_Format *hdr, const float *planes, Uint8 *dst, int n)
+{
+    int i, c;
+
+    switch (hdr->type) {
+    case HDR_FORMAT_PACKED:
+        if (hdr->bpp != 4) {
+            return 0;
+        }
+        for (i = 0; i + 4 <= n; i += 4) {
+            uint32x4_t pixels = vdupq_n_u32(0);
+            for (c = 0; c < 4; ++c) {
+                if (hdr->max[c]) {
+                    float32x4_t value = vld1q_f32(planes + c * HDR_CHUNK + i);
+                    value = vmaxnmq_f32(vminnmq_f32(value, vdupq_n_f32(1.0f)), vdupq_n_f32(0.0f));
+                    value = vaddq_f32(vmulq_n_f32(value, (float)hdr->max[c]), vdupq_n_f32(0.5f));
+                    pixels = vorrq_u32(pixels, vshlq_u32(vcvtq_u32_f32(value), vdupq_n_s32((int)hdr->shift[c])));
+                }
+            }
+            vst1q_u32((uint32_t *)(dst + i * 4), pixels);
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT16:
+        for (i = 0; i + 4 <= n; i += 4) {
+            uint16x4x4_t v;
+            for (c = 0; c < 4; ++c) {
+                v.val[c] = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(planes + hdr->plane[c] * HDR_CHUNK + i)));
+            }
+            vst4_u16((uint16_t *)(dst + i * 8), v);
+        }
+        return i;
+
+    case HDR_FORMAT_FLOAT32:
+        for (i = 0; i + 4 <= n; i += 4) {
+            float32x4x4_t v;
+            for (c = 0; c < 4; ++c) {
+                v.val[c] = vld1q_f32(planes + hdr->plane[c] * HDR_CHUNK + i);
+            }
+            vst4q_f32((float *)(dst + i * 16), v);
+        }
+        return i;
+
+    default:
+        return 0;
+    }
+}
+#endif /* HDR_NEON */
+
+static void HDR_Decode(const HDR_Format *hdr, const Uint8 *src, float *planes, int i, int n)
+{
+    int c;
+
+    for (; i < n; ++i) {
+        const Uint8 *p = src + i * hdr->bpp;
+        Uint32 pixel;
+
+        switch (hdr->type) {
+        case HDR_FORMAT_PACKED:
+            RETRIEVE_RGB_PIXEL(p, hdr->bpp, pixel);
+            for (c = 0; c < 4; ++c) {
+                if (hdr->max[c]) {
+                    planes[c * HDR_CHUNK + i] = (float)((pixel >> hdr->shift[c]) & hdr->max[c]) * hdr->scale[c];
+                } else {
+                    planes[c * HDR_CHUNK + i] = (c == 3) ? 1.0f : 0.0f;
+                }
+            }
+            break;
+        case HDR_FORMAT_INDEXED:
+        {
+            const SDL_Color *color = &hdr->palette->colors[*p < hdr->palette->ncolors ? *p : 0];
+            planes[0 * HDR_CHUNK + i] = (float)color->r * (1.0f / 255.0f);
+            planes[1 * HDR_CHUNK + i] = (float)color->g * (1.0f / 255.0f);
+            planes[2 * HDR_CHUNK + i] = (float)color->b * (1.0f / 255.0f);
+            planes[3 * HDR_CHUNK + i] = (float)color->a * (1.0f / 255.0f);
+        } break;
+        case HDR_FORMAT_FLOAT16:
+            for (c = 0; c < 4; ++c) {
+                Uint16 half;
+                SDL_memcpy(&half, p + c * 2, sizeof(half));
+                planes[hdr->plane[c] * HDR_CHUNK + i] = HDR_HalfToFloat(half);
+            }
+            break;
+        case HDR_FORMAT_FLOAT32:
+            for (c = 0; c < 4; ++c) {
+                SDL_memcpy(&planes[hdr->plane[c] * HDR_CHUNK + i], p + c * 4, sizeof(float));
+            }
+            break;
+        }
+    }
+}
+
+static void HDR_Encode(const HDR_Format *hdr, const SDL_PixelFormat *fmt, const float *planes, Uint8 *dst, int i, int n)
+{
+    int c;
+
+    for (; i < n; ++i) {
+        Uint8 *p = dst + i * hdr->bpp;
+        Uint32 pixel = 0;
+
+        switch (hdr->type) {
+        case HDR_FORMAT_PACKED:
+            for (c = 0; c < 4; ++c) {
+                if (hdr->max[c]) {
+                    pixel |= (Uint32)(HDR_Clamp(planes[c * HDR_CHUNK + i]) * (float)hdr->max[c] + 0.5f) << hdr->shift[c];
+                }
+            }
+            switch (hdr->bpp) {
+            case 1:
+                *p = (Uint8)pixel;
+                break;
+            case 2:
+                *(Uint16 *)p = (Uint16)pixel;
+                break;
+            case 3:
+                if (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+                    p[0] = (Uint8)pixel;
+                    p[1] = (Uint8)(pixel >> 8);
+                    p[2] = (Uint8)(pixel >> 16);
+                } else {
+                    p[0] = (Uint8)(pixel >> 16);
+                    p[1] = (Uint8)(pixel >> 8);
+                    p[2] = (Uint8)pixel;
+                }
+                break;
+            default:
+                *(Uint32 *)p = pixel;
+                break;
+            }
+            break;
+        case HDR_FORMAT_INDEXED:
+        {
+            Uint8 rgba[4];
+            for (c = 0; c < 4; ++c) {
+                rgba[c] = (Uint8)(HDR_Clamp(planes[c * HDR_CHUNK + i]) * 255.0f + 0.5f);
+            }
+            *p = (Uint8)SDL_MapRGBA(fmt, rgba[0], rgba[1], rgba[2], rgba[3]);
+        } break;
+        case HDR_FORMAT_FLOAT16:
+            for (c = 0; c < 4; ++c) {
+                const Uint16 half = HDR_FloatToHalf(planes[hdr->plane[c] * HDR_CHUNK + i]);
+                SDL_memcpy(p + c * 2, &half, sizeof(half));
+            }
+            break;
+        case HDR_FORMAT_FLOAT32:
+            for (c = 0; c < 4; ++c) {
+                SDL_memcpy(p + c * 4, &planes[hdr->plane[c] * HDR_CHUNK + i], sizeof(float));
+            }
+            break;
+        }
+    }
+}
+
+static void SDL_Blit_HDR(SDL_BlitInfo *info)
+{
+    float planes[4 * HDR_CHUNK];
+    HDR_Format src_hdr, dst_hdr;
+    int (*decode)(const HDR_Format *, const Uint8 *, float *, int) = NULL;
+    int (*encode)(const HDR_Format *, const float *, Uint8 *, int) = NULL;
+    const Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    int x, y;
+
+    if (!HDR_GetFormat(info->src_fmt, &src_hdr) || !HDR_GetFormat(info->dst_fmt, &dst_hdr)) {
+        return;
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        decode = HDR_Decode_SSE2;
+        encode = HDR_Encode_SSE2;
+    }
+#endif
+#ifdef HDR_NEON
+    if (!decode && SDL_HasNEON()) {
+        decode = HDR_Decode_NEON;
+        encode = HDR_Encode_NEON;
+    }
+#endif
+
+    for (y = 0; y < info->dst_h; ++y) {
+        for (x = 0; x < info->dst_w; x += HDR_CHUNK) {
+            const int n = SDL_min(info->dst_w - x, HDR_CHUNK);
+            const Uint8 *s = src + x * src_hdr.bpp;
+            Uint8 *d = dst + x * dst_hdr.bpp;
+
+            HDR_Decode(&src_hdr, s, planes, decode ? decode(&src_hdr, s, planes, n) : 0, n);
+            HDR_Encode(&dst_hdr, info->dst_fmt, planes, d, encode ? encode(&dst_hdr, planes, d, n) : 0, n);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_BlitFunc SDL_CalculateBlitHDR(SDL_Surface *surface)
+{
+    SDL_BlitMap *map = surface->map;
+    HDR_Format hdr;
+
+    /* Only plain conversions, without blending, keys, modulation or scaling */
+    if (map->info.flags & ~SDL_COPY_RLE_DESIRED) {
+        return NULL;
+    }
+    if (!HDR_GetFormat(surface->format, &hdr) || !HDR_GetFormat(map->dst->format, &hdr)) {
+        return NULL;
+    }
+    return SDL_Blit_HDR;
+}
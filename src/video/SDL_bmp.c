@@ -193,7 +193,8 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
-SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
+/* If mem is set, it holds the whole stream and the pixels may be referenced in place */
+static SDL_Surface *LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc, Uint8 *mem, size_t mem_size)
 {
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset = 0;
@@ -206,6 +207,7 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
     SDL_Palette *palette;
     Uint8 *bits;
     Uint8 *top, *end;
+    Uint8 *pixels = NULL;
     SDL_bool topDown;
     SDL_bool haveRGBMasks = SDL_FALSE;
     SDL_bool haveAlphaMask = SDL_FALSE;
@@ -428,10 +430,47 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
     /* Create a compatible surface, note that the colors are RGB ordered */
     {
         Uint32 format;
+        size_t pitch, size;
 
         /* Get the pixel format */
         format = SDL_GetPixelFormatEnumForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
-        surface = SDL_CreateSurface(biWidth, biHeight, format);
+
+        /* Top-down uncompressed rows in memory are already laid out the way
+           SDL expects, unless they need to be byte-swapped */
+        if (mem && topDown && format != SDL_PIXELFORMAT_UNKNOWN &&
+            biCompression != BI_RLE4 && biCompression != BI_RLE8 &&
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            (biBitCount <= 8 || biBitCount == 24) &&
+#endif
+            SDL_CalculateSize(format, biWidth, biHeight, &size, &pitch, SDL_FALSE /* not minimal pitch */) == 0) {
+            const Uint64 offset = (Uint64)fp_offset + bfOffBits;
+            const size_t bpp = SDL_BYTESPERPIXEL(format);
+            const size_t alignment = (bpp == 2 || bpp == 4) ? bpp : 1;
+
+            if (offset <= mem_size && size <= mem_size - offset && ((uintptr_t)(mem + offset) % alignment) == 0) {
+                pixels = mem + offset;
+            }
+        }
+
+        if (pixels) {
+            /* Without any alpha data the pixels are opaque, which doesn't
+               need them to be modified if the format has no alpha channel */
+            if (correctAlpha) {
+                const Uint32 *pixel = (const Uint32 *)pixels;
+                const Uint32 *last = (const Uint32 *)(pixels + size);
+
+                while (pixel < last && !(*pixel & Amask)) {
+                    ++pixel;
+                }
+                if (pixel == last) {
+                    format = SDL_GetPixelFormatEnumForMasks(biBitCount, Rmask, Gmask, Bmask, 0);
+                }
+                correctAlpha = SDL_FALSE;
+            }
+            surface = SDL_CreateSurfaceFrom(pixels, biWidth, biHeight, (int)pitch, format);
+        } else {
+            surface = SDL_CreateSurface(biWidth, biHeight, format);
+        }
 
         if (!surface) {
             goto done;
@@ -503,6 +542,20 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
         }
         goto done;
     }
+    if (pixels) {
+        if (biBitCount == 8 && palette && biClrUsed < (1u << biBitCount)) {
+            for (bits = pixels; bits < pixels + (surface->h * surface->pitch); bits += surface->pitch) {
+                for (i = 0; i < surface->w; ++i) {
+                    if (bits[i] >= biClrUsed) {
+                        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+                        goto done;
+                    }
+                }
+            }
+        }
+        was_error = SDL_FALSE;
+        goto done;
+    }
     top = (Uint8 *)surface->pixels;
     end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
     pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
@@ -583,20 +636,104 @@ done:
     return surface;
 }
 
+SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
+{
+    return LoadBMP_RW(src, freesrc, NULL, 0);
+}
+
 SDL_Surface *SDL_LoadBMP(const char *file)
 {
     return SDL_LoadBMP_RW(SDL_RWFromFile(file, "rb"), 1);
 }
 
+SDL_Surface *SDL_LoadBMP_Mem(void *mem, size_t size)
+{
+    if (!mem) {
+        SDL_InvalidParamError("mem");
+        return NULL;
+    }
+    return LoadBMP_RW(SDL_RWFromMem(mem, size), SDL_TRUE, (Uint8 *)mem, size);
+}
+
+/* Pixels are converted and written this many bytes at a time */
+#define SAVE_BMP_BAND_SIZE (64 * 1024)
+
+/* Fills `band` top-down with `rows` rows of the surface, starting at row `y`,
+   in the format they're saved in. Every row takes `row_size` bytes, and the
+   padding at the end of each row is left alone. */
+static int ConvertBMPRows(SDL_Surface *surface, int y, int rows, Uint32 pixel_format,
+                          Uint8 *band, size_t row_size)
+{
+    const Uint8 *src = (const Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+    SDL_Surface *view, *converted;
+    int i, retval;
+
+    if (pixel_format == surface->format->format &&
+        (surface->format->palette || !(surface->map->info.flags & SDL_COPY_COLORKEY))) {
+        const size_t bw = (size_t)surface->w * surface->format->BytesPerPixel;
+        for (i = 0; i < rows; ++i) {
+            SDL_memcpy(band + i * row_size, src + (size_t)i * surface->pitch, bw);
+        }
+        return 0;
+    }
+
+    if (!surface->format->palette && !(surface->map->info.flags & SDL_COPY_COLORKEY)) {
+        return SDL_ConvertPixels(surface->w, rows, surface->format->format, src, surface->pitch,
+                                 pixel_format, band, (int)row_size);
+    }
+
+    /* Palettes and colorkeys need the full surface conversion, so convert
+       a surface that only covers this band */
+    view = SDL_CreateSurfaceFrom((void *)src, surface->w, rows, surface->pitch, surface->format->format);
+    if (!view) {
+        return -1;
+    }
+    if (surface->format->palette) {
+        SDL_SetSurfacePalette(view, surface->format->palette);
+    }
+    if (surface->map->info.flags & SDL_COPY_COLORKEY) {
+        SDL_SetSurfaceColorKey(view, SDL_TRUE, surface->map->info.colorkey);
+    }
+    converted = SDL_ConvertSurfaceFormat(view, pixel_format);
+    SDL_DestroySurface(view);
+    if (!converted) {
+        return -1;
+    }
+
+    retval = SDL_ConvertPixels(converted->w, converted->h, pixel_format, converted->pixels, converted->pitch,
+                               pixel_format, band, (int)row_size);
+    SDL_DestroySurface(converted);
+    return retval;
+}
+
+/* Reverses the order of the rows in a band, `scratch` holds one row */
+static void FlipBMPRows(Uint8 *band, int rows, size_t row_size, Uint8 *scratch)
+{
+    Uint8 *top = band;
+    Uint8 *bottom = band + (rows - 1) * row_size;
+
+    while (top < bottom) {
+        SDL_memcpy(scratch, top, row_size);
+        SDL_memcpy(top, bottom, row_size);
+        SDL_memcpy(bottom, scratch, row_size);
+        top += row_size;
+        bottom -= row_size;
+    }
+}
+
 int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 {
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset, new_offset;
-    int i, pad;
-    SDL_Surface *intermediate_surface;
-    Uint8 *bits;
+    int i, y, rows, band_rows;
+    size_t bw, row_size;
+    Uint32 pixel_format = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_Palette *palette = NULL;
+    Uint8 *band = NULL;
+    SDL_bool locked = SDL_FALSE;
     SDL_bool save32bit = SDL_FALSE;
     SDL_bool saveLegacyBMP = SDL_FALSE;
+    SDL_bool saveTopDown = SDL_FALSE;
 
     /* The Win32 BMP file header (14 bytes) */
     char magic[2] = { 'B', 'M' };
@@ -630,7 +767,6 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
     Uint32 bV4GammaBlue = 0;
 
     /* Make sure we have somewhere to save */
-    intermediate_surface = NULL;
     if (dst) {
         if (!surface) {
             SDL_InvalidParamError("surface");
@@ -648,7 +784,8 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 
         if (surface->format->palette && !save32bit) {
             if (surface->format->BitsPerPixel == 8) {
-                intermediate_surface = surface;
+                pixel_format = surface->format->format;
+                palette = surface->format->palette;
             } else {
                 SDL_SetError("%d bpp BMP files not supported",
                              surface->format->BitsPerPixel);
@@ -665,23 +802,16 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
                    (surface->format->Bmask == 0x00FF0000)
 #endif
         ) {
-            intermediate_surface = surface;
+            pixel_format = surface->format->format;
         } else {
-            Uint32 pixel_format;
-
             /* If the surface has a colorkey or alpha channel we'll save a
-               32-bit BMP with alpha channel, otherwise save a 24-bit BMP. */
+               32-bit BMP with alpha channel, otherwise save a 24-bit BMP.
+               The pixels are converted a band at a time while writing. */
             if (save32bit) {
                 pixel_format = SDL_PIXELFORMAT_BGRA32;
             } else {
                 pixel_format = SDL_PIXELFORMAT_BGR24;
             }
-            intermediate_surface = SDL_ConvertSurfaceFormat(surface, pixel_format);
-            if (!intermediate_surface) {
-                SDL_SetError("Couldn't convert image to %d bpp",
-                             (int)SDL_BITSPERPIXEL(pixel_format));
-                goto done;
-            }
         }
     } else {
         /* Set no error here because it may overwrite a more useful message from
@@ -692,9 +822,26 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
     if (save32bit) {
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, SDL_FALSE);
     }
+    saveTopDown = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_TOP_DOWN, SDL_FALSE);
+
+    /* Each row is padded to a multiple of 4 bytes */
+    bw = (size_t)surface->w * SDL_BYTESPERPIXEL(pixel_format);
+    row_size = (bw + 3) & ~3;
+    band_rows = SDL_max(surface->h, 1);
+    if (row_size > 0 && (size_t)band_rows > SAVE_BMP_BAND_SIZE / row_size &&
+        !SDL_ISPIXELFORMAT_FOURCC(surface->format->format)) { /* planar formats are converted in one go */
+        band_rows = (int)SDL_max(SAVE_BMP_BAND_SIZE / row_size, 1);
+    }
+
+    /* Room for one band, and a row to flip it with */
+    band = (Uint8 *)SDL_calloc(band_rows + 1, SDL_max(row_size, 1));
+    if (!band) {
+        SDL_OutOfMemory();
+        goto done;
+    }
 
-    if (SDL_LockSurface(intermediate_surface) == 0) {
-        const size_t bw = intermediate_surface->w * intermediate_surface->format->BytesPerPixel;
+    if (SDL_LockSurface(surface) == 0) {
+        locked = SDL_TRUE;
 
         /* Set the BMP file header values */
         bfSize = 0; /* We'll write this when we're done */
@@ -717,16 +864,16 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 
         /* Set the BMP info values */
         biSize = 40;
-        biWidth = intermediate_surface->w;
-        biHeight = intermediate_surface->h;
+        biWidth = surface->w;
+        biHeight = saveTopDown ? -surface->h : surface->h;
         biPlanes = 1;
-        biBitCount = intermediate_surface->format->BitsPerPixel;
+        biBitCount = (Uint16)SDL_BITSPERPIXEL(pixel_format);
         biCompression = BI_RGB;
-        biSizeImage = intermediate_surface->h * intermediate_surface->pitch;
+        biSizeImage = (Uint32)(surface->h * row_size);
         biXPelsPerMeter = 0;
         biYPelsPerMeter = 0;
-        if (intermediate_surface->format->palette) {
-            biClrUsed = intermediate_surface->format->palette->ncolors;
+        if (palette) {
+            biClrUsed = palette->ncolors;
         } else {
             biClrUsed = 0;
         }
@@ -784,12 +931,12 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         }
 
         /* Write the palette (in BGR color order) */
-        if (intermediate_surface->format->palette) {
+        if (palette) {
             SDL_Color *colors;
             int ncolors;
 
-            colors = intermediate_surface->format->palette->colors;
-            ncolors = intermediate_surface->format->palette->ncolors;
+            colors = palette->colors;
+            ncolors = palette->ncolors;
             for (i = 0; i < ncolors; ++i) {
                 if (!SDL_WriteU8(dst, colors[i].b) ||
                     !SDL_WriteU8(dst, colors[i].g) ||
@@ -812,21 +959,20 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             goto done;
         }
 
-        /* Write the bitmap image upside down */
-        bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
-        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *)intermediate_surface->pixels) {
-            bits -= intermediate_surface->pitch;
-            if (SDL_RWwrite(dst, bits, bw) != bw) {
+        /* Write the bitmap image, upside down unless saving top-down */
+        for (i = 0; i < surface->h; i += rows) {
+            rows = SDL_min(band_rows, surface->h - i);
+            y = saveTopDown ? i : (surface->h - i - rows);
+            if (ConvertBMPRows(surface, y, rows, pixel_format, band, row_size) < 0) {
+                SDL_SetError("Couldn't convert image to %d bpp",
+                             (int)SDL_BITSPERPIXEL(pixel_format));
                 goto done;
             }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
-                        goto done;
-                    }
-                }
+            if (!saveTopDown) {
+                FlipBMPRows(band, rows, row_size, band + band_rows * row_size);
+            }
+            if (SDL_RWwrite(dst, band, rows * row_size) != rows * row_size) {
+                goto done;
             }
         }
 
@@ -846,16 +992,14 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             goto done;
         }
 
-        /* Close it up.. */
-        SDL_UnlockSurface(intermediate_surface);
-
         was_error = SDL_FALSE;
     }
 
 done:
-    if (intermediate_surface && intermediate_surface != surface) {
-        SDL_DestroySurface(intermediate_surface);
+    if (locked) {
+        SDL_UnlockSurface(surface);
     }
+    SDL_free(band);
     if (freedst && dst) {
         if (SDL_RWclose(dst) < 0) {
             was_error = SDL_TRUE;
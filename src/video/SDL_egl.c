@@ -450,6 +450,7 @@ static int SDL_EGL_LoadLibraryInternal(SDL_VideoDevice *_this, const char *egl_p
     LOAD_FUNC(PFNEGLBINDAPIPROC, eglBindAPI);
     LOAD_FUNC(PFNEGLGETERRORPROC, eglGetError);
     LOAD_FUNC_EGLEXT(PFNEGLQUERYDEVICESEXTPROC, eglQueryDevicesEXT);
+    LOAD_FUNC_EGLEXT(PFNEGLQUERYDEVICESTRINGEXTPROC, eglQueryDeviceStringEXT);
     LOAD_FUNC_EGLEXT(PFNEGLGETPLATFORMDISPLAYEXTPROC, eglGetPlatformDisplayEXT);
     /* Atomic functions */
     LOAD_FUNC_EGLEXT(PFNEGLCREATESYNCKHRPROC, eglCreateSyncKHR);
@@ -583,6 +584,25 @@ int SDL_EGL_LoadLibrary(SDL_VideoDevice *_this, const char *egl_path, NativeDisp
    valid available GPU for EGL to use.
 */
 
+/* Returns SDL_TRUE if the EGL device is the DRM device at the given path */
+static SDL_bool SDL_EGL_DeviceMatchesPath(SDL_VideoDevice *_this, EGLDeviceEXT device, const char *path)
+{
+    const EGLint names[] = { EGL_DRM_DEVICE_FILE_EXT, EGL_DRM_RENDER_NODE_FILE_EXT };
+    int i;
+
+    if (!_this->egl_data->eglQueryDeviceStringEXT) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < SDL_arraysize(names); ++i) {
+        const char *file = _this->egl_data->eglQueryDeviceStringEXT(device, names[i]);
+        if (file && SDL_strcmp(file, path) == 0) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
 int SDL_EGL_InitializeOffscreen(SDL_VideoDevice *_this, int device)
 {
     void *egl_devices[SDL_EGL_MAX_DEVICES];
@@ -606,11 +626,26 @@ int SDL_EGL_InitializeOffscreen(SDL_VideoDevice *_this, int device)
         return SDL_SetError("eglQueryDevicesEXT() failed");
     }
 
-    egl_device_hint = SDL_GetHint("SDL_HINT_EGL_DEVICE");
-    if (egl_device_hint) {
-        device = SDL_atoi(egl_device_hint);
+    egl_device_hint = SDL_GetHint(SDL_HINT_VIDEO_OFFSCREEN_EGL_DEVICE);
+    if (!egl_device_hint) {
+        /* This is the name the hint was checked under before it was public */
+        egl_device_hint = SDL_GetHint("SDL_HINT_EGL_DEVICE");
+    }
+    if (egl_device_hint && *egl_device_hint) {
+        if (*egl_device_hint == '/') {
+            for (device = 0; device < num_egl_devices; ++device) {
+                if (SDL_EGL_DeviceMatchesPath(_this, egl_devices[device], egl_device_hint)) {
+                    break;
+                }
+            }
+            if (device == num_egl_devices) {
+                return SDL_SetError("No EGL device found for %s", egl_device_hint);
+            }
+        } else {
+            device = SDL_atoi(egl_device_hint);
+        }
 
-        if (device >= num_egl_devices) {
+        if (device < 0 || device >= num_egl_devices) {
             return SDL_SetError("Invalid EGL device is requested.");
         }
 
@@ -94,6 +94,7 @@ typedef struct SDL_EGL_VideoData
     PFNEGLBINDAPIPROC eglBindAPI;
     PFNEGLGETERRORPROC eglGetError;
     PFNEGLQUERYDEVICESEXTPROC eglQueryDevicesEXT;
+    PFNEGLQUERYDEVICESTRINGEXTPROC eglQueryDeviceStringEXT;
     PFNEGLGETPLATFORMDISPLAYPROC eglGetPlatformDisplay;
     PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT;
 
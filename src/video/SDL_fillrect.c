@@ -23,6 +23,9 @@
 #include "SDL_blit.h"
 
 #ifdef SDL_SSE_INTRINSICS
+/* These fill with non-temporal stores, which bypass the cache, so they're
+   only used for fills too big to stay in the cache anyway.
+ */
 /* *INDENT-OFF* */ /* clang-format off */
 
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -52,7 +55,8 @@
         p += 64; \
     }
 
-#define SSE_END
+#define SSE_END \
+    _mm_sfence();
 
 #define DEFINE_SSE_FILLRECT(bpp, type) \
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
@@ -302,6 +306,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
     Uint8 *pixels;
     const SDL_Rect *rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    void (*stream_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
     int i;
 
     if (!dst) {
@@ -378,8 +383,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
             color |= (color << 16);
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect1SSE;
-                break;
+                stream_function = SDL_FillSurfaceRect1SSE;
             }
 #endif
             fill_function = SDL_FillSurfaceRect1;
@@ -391,8 +395,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
             color |= (color << 16);
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect2SSE;
-                break;
+                stream_function = SDL_FillSurfaceRect2SSE;
             }
 #endif
             fill_function = SDL_FillSurfaceRect2;
@@ -410,8 +413,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         {
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect4SSE;
-                break;
+                stream_function = SDL_FillSurfaceRect4SSE;
             }
 #endif
             fill_function = SDL_FillSurfaceRect4;
@@ -434,7 +436,12 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
                  rect->x * dst->format->BytesPerPixel;
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        if (stream_function &&
+            (size_t)rect->w * rect->h * dst->format->BytesPerPixel >= SDL_STREAMING_STORE_THRESHOLD) {
+            stream_function(pixels, dst->pitch, color, rect->w, rect->h);
+        } else {
+            fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        }
     }
 
     /* We're done! */
@@ -123,6 +123,14 @@ const char *SDL_GetPixelFormatName(Uint32 format)
         CASE(SDL_PIXELFORMAT_XBGR2101010)
         CASE(SDL_PIXELFORMAT_ARGB2101010)
         CASE(SDL_PIXELFORMAT_ABGR2101010)
+        CASE(SDL_PIXELFORMAT_RGBA64_FLOAT)
+        CASE(SDL_PIXELFORMAT_ARGB64_FLOAT)
+        CASE(SDL_PIXELFORMAT_BGRA64_FLOAT)
+        CASE(SDL_PIXELFORMAT_ABGR64_FLOAT)
+        CASE(SDL_PIXELFORMAT_RGBA128_FLOAT)
+        CASE(SDL_PIXELFORMAT_ARGB128_FLOAT)
+        CASE(SDL_PIXELFORMAT_BGRA128_FLOAT)
+        CASE(SDL_PIXELFORMAT_ABGR128_FLOAT)
         CASE(SDL_PIXELFORMAT_YV12)
         CASE(SDL_PIXELFORMAT_IYUV)
         CASE(SDL_PIXELFORMAT_YUY2)
@@ -130,6 +138,9 @@ const char *SDL_GetPixelFormatName(Uint32 format)
         CASE(SDL_PIXELFORMAT_YVYU)
         CASE(SDL_PIXELFORMAT_NV12)
         CASE(SDL_PIXELFORMAT_NV21)
+        CASE(SDL_PIXELFORMAT_P010)
+        CASE(SDL_PIXELFORMAT_P016)
+        CASE(SDL_PIXELFORMAT_I444)
         CASE(SDL_PIXELFORMAT_EXTERNAL_OES)
 
     default:
@@ -693,6 +704,20 @@ void SDL_DestroyPixelFormat(SDL_PixelFormat *format)
     return;
 }
 
+/* Palette versions are unique across all palettes, so a version identifies
+   both the palette and its contents in the blit map cache */
+static Uint32 SDL_NextPaletteVersion(void)
+{
+    static SDL_AtomicInt next_version;
+    Uint32 version;
+
+    do {
+        version = (Uint32)SDL_AtomicIncRef(&next_version) + 1;
+    } while (!version);
+
+    return version;
+}
+
 SDL_Palette *SDL_CreatePalette(int ncolors)
 {
     SDL_Palette *palette;
@@ -716,7 +741,7 @@ SDL_Palette *SDL_CreatePalette(int ncolors)
         return NULL;
     }
     palette->ncolors = ncolors;
-    palette->version = 1;
+    palette->version = SDL_NextPaletteVersion();
     palette->refcount = 1;
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
@@ -769,10 +794,7 @@ int SDL_SetPaletteColors(SDL_Palette *palette, const SDL_Color *colors,
         SDL_memcpy(palette->colors + firstcolor, colors,
                    ncolors * sizeof(*colors));
     }
-    ++palette->version;
-    if (!palette->version) {
-        palette->version = 1;
-    }
+    palette->version = SDL_NextPaletteVersion();
 
     return status;
 }
@@ -1000,6 +1022,25 @@ static Uint8 *Map1to1(SDL_Palette *src, SDL_Palette *dst, int *identical)
     return map;
 }
 
+#if SDL_HAVE_RLE
+/* Whether blitting between the formats is a plain copy, as in SDL_MapSurface() */
+static SDL_bool SDL_IsIdentityMap(SDL_PixelFormat *srcfmt, SDL_PixelFormat *dstfmt)
+{
+    if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
+        SDL_Palette *src = srcfmt->palette;
+        SDL_Palette *dst = dstfmt->palette;
+
+        if (!SDL_ISPIXELFORMAT_INDEXED(dstfmt->format) ||
+            srcfmt->BitsPerPixel != dstfmt->BitsPerPixel ||
+            src->ncolors > dst->ncolors) {
+            return SDL_FALSE;
+        }
+        return (src == dst || SDL_memcmp(src->colors, dst->colors, src->ncolors * sizeof(SDL_Color)) == 0);
+    }
+    return (srcfmt == dstfmt);
+}
+#endif
+
 /* Map from Palette to BitField */
 static Uint8 *Map1toN(SDL_PixelFormat *src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
                       SDL_PixelFormat *dst)
@@ -1041,6 +1082,142 @@ static Uint8 *MapNto1(SDL_PixelFormat *src, SDL_PixelFormat *dst, int *identical
     return Map1to1(&dithered, pal, identical);
 }
 
+/* A small LRU cache of blit mappings shared between all surfaces, so a
+   source blitted alternately onto several destinations isn't remapped on
+   every switch.  RLE mappings depend on the surface contents and are never
+   cached. */
+#define SDL_BLIT_MAP_CACHE_SIZE 16
+
+typedef struct SDL_BlitMapCacheEntry
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    Uint32 src_palette_version;
+    Uint32 dst_palette_version;
+    int flags;
+    Uint32 modulate;
+    int identity;
+    SDL_blit blit;
+    void *data;
+    Uint8 *table;
+    size_t table_size;
+    Uint32 last_used;
+} SDL_BlitMapCacheEntry;
+
+static SDL_SpinLock blit_map_cache_lock = 0;
+static SDL_BlitMapCacheEntry blit_map_cache[SDL_BLIT_MAP_CACHE_SIZE];
+static Uint32 blit_map_cache_tick = 0;
+
+static void SDL_GetBlitMapCacheKey(SDL_Surface *src, SDL_Surface *dst, SDL_BlitMapCacheEntry *key)
+{
+    SDL_PixelFormat *srcfmt = src->format;
+    SDL_PixelFormat *dstfmt = dst->format;
+
+    SDL_zerop(key);
+    key->src_format = srcfmt->format;
+    key->dst_format = dstfmt->format;
+    key->src_palette_version = srcfmt->palette ? srcfmt->palette->version : 0;
+    key->dst_palette_version = dstfmt->palette ? dstfmt->palette->version : 0;
+    key->flags = src->map->info.flags;
+    if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
+        /* The palette lookup table and blitter choice depend on the modulation */
+        key->modulate = ((Uint32)src->map->info.r << 24) | ((Uint32)src->map->info.g << 16) |
+                        ((Uint32)src->map->info.b << 8) | src->map->info.a;
+    }
+}
+
+static SDL_bool SDL_MatchBlitMapCacheKey(const SDL_BlitMapCacheEntry *entry, const SDL_BlitMapCacheEntry *key)
+{
+    return entry->data &&
+           entry->src_format == key->src_format &&
+           entry->dst_format == key->dst_format &&
+           entry->src_palette_version == key->src_palette_version &&
+           entry->dst_palette_version == key->dst_palette_version &&
+           entry->flags == key->flags &&
+           entry->modulate == key->modulate;
+}
+
+static SDL_bool SDL_LookupBlitMapCache(const SDL_BlitMapCacheEntry *key, SDL_BlitMap *map)
+{
+    SDL_bool found = SDL_FALSE;
+    int i;
+
+    SDL_AtomicLock(&blit_map_cache_lock);
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        SDL_BlitMapCacheEntry *entry = &blit_map_cache[i];
+
+        if (SDL_MatchBlitMapCacheKey(entry, key)) {
+            if (entry->table) {
+                map->info.table = (Uint8 *)SDL_malloc(entry->table_size);
+                if (!map->info.table) {
+                    /* Fall back to computing the mapping */
+                    break;
+                }
+                SDL_memcpy(map->info.table, entry->table, entry->table_size);
+            }
+            map->identity = entry->identity;
+            map->blit = entry->blit;
+            map->data = entry->data;
+            entry->last_used = ++blit_map_cache_tick;
+            found = SDL_TRUE;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&blit_map_cache_lock);
+
+    return found;
+}
+
+static void SDL_StoreBlitMapCache(const SDL_BlitMapCacheEntry *key, const SDL_BlitMap *map, size_t table_size)
+{
+    SDL_BlitMapCacheEntry *entry;
+    Uint8 *table = NULL;
+    int i;
+
+    if (map->info.table) {
+        table = (Uint8 *)SDL_malloc(table_size);
+        if (!table) {
+            return;
+        }
+        SDL_memcpy(table, map->info.table, table_size);
+    }
+
+    SDL_AtomicLock(&blit_map_cache_lock);
+    entry = &blit_map_cache[0];
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        if (SDL_MatchBlitMapCacheKey(&blit_map_cache[i], key)) {
+            /* Another thread stored the same mapping */
+            entry = &blit_map_cache[i];
+            break;
+        }
+        if (blit_map_cache[i].last_used < entry->last_used) {
+            entry = &blit_map_cache[i];
+        }
+    }
+    SDL_free(entry->table);
+    *entry = *key;
+    entry->identity = map->identity;
+    entry->blit = map->blit;
+    entry->data = map->data;
+    entry->table = table;
+    entry->table_size = table_size;
+    entry->last_used = ++blit_map_cache_tick;
+    SDL_AtomicUnlock(&blit_map_cache_lock);
+}
+
+void SDL_QuitBlitMapCache(void)
+{
+    int i;
+
+    SDL_AtomicLock(&blit_map_cache_lock);
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        SDL_free(blit_map_cache[i].table);
+    }
+    SDL_zeroa(blit_map_cache);
+    blit_map_cache_tick = 0;
+    SDL_AtomicUnlock(&blit_map_cache_lock);
+}
+
 SDL_BlitMap *SDL_AllocBlitMap(void)
 {
     SDL_BlitMap *map;
@@ -1095,12 +1272,21 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
     SDL_PixelFormat *srcfmt;
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
+    SDL_BlitMapCacheEntry key;
+    size_t table_size = 256;
+    SDL_bool cached = SDL_FALSE;
+    SDL_bool keep_rle = SDL_FALSE;
 
     /* Clear out any previous mapping */
     map = src->map;
 #if SDL_HAVE_RLE
     if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(src, 1);
+        /* A colorkey encoding doesn't depend on the destination, so it can
+           be kept for any destination that needs no pixel conversion */
+        keep_rle = SDL_CanKeepRLESurface(src) && SDL_IsIdentityMap(src->format, dst->format);
+        if (!keep_rle) {
+            SDL_UnRLESurface(src, 1);
+        }
     }
 #endif
     SDL_InvalidateMap(map);
@@ -1109,7 +1295,13 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
     map->identity = 0;
     srcfmt = src->format;
     dstfmt = dst->format;
-    if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
+    SDL_GetBlitMapCacheKey(src, dst, &key);
+    if (keep_rle) {
+        map->identity = 1;
+    } else if (!(map->info.flags & SDL_COPY_RLE_DESIRED) &&
+               SDL_LookupBlitMapCache(&key, map)) {
+        cached = SDL_TRUE;
+    } else if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* Palette --> Palette */
             map->info.table =
@@ -1130,6 +1322,7 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
             if (!map->info.table) {
                 return -1;
             }
+            table_size = 256 * (size_t)((dstfmt->BytesPerPixel == 3) ? 4 : dstfmt->BytesPerPixel);
         }
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
@@ -1168,8 +1361,22 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
         map->src_palette_version = 0;
     }
 
+    if (cached || keep_rle) {
+        map->info.src_fmt = srcfmt;
+        map->info.src_pitch = src->pitch;
+        map->info.dst_fmt = dstfmt;
+        map->info.dst_pitch = dst->pitch;
+        return 0;
+    }
+
     /* Choose your blitters wisely */
-    return SDL_CalculateBlit(src);
+    if (SDL_CalculateBlit(src) < 0) {
+        return -1;
+    }
+    if (!(map->info.flags & SDL_COPY_RLE_DESIRED)) {
+        SDL_StoreBlitMapCache(&key, map, table_size);
+    }
+    return 0;
 }
 
 void SDL_FreeBlitMap(SDL_BlitMap *map)
@@ -32,6 +32,9 @@
 extern int SDL_InitFormat(SDL_PixelFormat *format, Uint32 pixel_format);
 extern int SDL_CalculateSize(Uint32 format, int width, int height, size_t *size, size_t *pitch, SDL_bool minimalPitch);
 
+/* Surface functions */
+extern void SDL_FreeSurfacePixels(SDL_Surface *surface);
+
 /* Blit mapping functions */
 extern SDL_BlitMap *SDL_AllocBlitMap(void);
 extern void SDL_InvalidateMap(SDL_BlitMap *map);
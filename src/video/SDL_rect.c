@@ -78,6 +78,525 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
     return SDL_FALSE;
 }
 
+/* SIMD helpers for the batched operations in SDL_rect_impl.h.
+
+   Each one handles as many elements as it can in groups of four and returns
+   how many it handled, the scalar code in SDL_rect_impl.h does the rest.
+   The comparisons are arranged to give the same answers as the scalar code. */
+
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE int hasSSE2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasSSE2();
+    return val;
+}
+
+/* SSE2 doesn't have 32-bit integer min and max, those came with SSE4.1 */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_mm_select_epi32(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_mm_min_epi32(__m128i a, __m128i b)
+{
+    return SDL_mm_select_epi32(_mm_cmpgt_epi32(a, b), b, a);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_mm_max_epi32(__m128i a, __m128i b)
+{
+    return SDL_mm_select_epi32(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+static SDL_INLINE int SDL_TARGETING("sse2") SDL_mm_hmin_epi32(__m128i v)
+{
+    v = SDL_mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = SDL_mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+static SDL_INLINE int SDL_TARGETING("sse2") SDL_mm_hmax_epi32(__m128i v)
+{
+    v = SDL_mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = SDL_mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+static SDL_INLINE float SDL_TARGETING("sse2") SDL_mm_hmin_ps(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+static SDL_INLINE float SDL_TARGETING("sse2") SDL_mm_hmax_ps(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+static int SDL_TARGETING("sse2") HasRectIntersections_SSE2(const SDL_Rect *rects, int count, const SDL_Rect *B, SDL_bool *results, int *found)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bminx = _mm_set1_epi32(B->x);
+    const __m128i bmaxx = _mm_set1_epi32(B->x + B->w);
+    const __m128i bminy = _mm_set1_epi32(B->y);
+    const __m128i bmaxy = _mm_set1_epi32(B->y + B->h);
+    int i, j;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i r0 = _mm_loadu_si128((const __m128i *)&rects[i + 0]);
+        const __m128i r1 = _mm_loadu_si128((const __m128i *)&rects[i + 1]);
+        const __m128i r2 = _mm_loadu_si128((const __m128i *)&rects[i + 2]);
+        const __m128i r3 = _mm_loadu_si128((const __m128i *)&rects[i + 3]);
+        const __m128i t0 = _mm_unpacklo_epi32(r0, r1); /* x0 x1 y0 y1 */
+        const __m128i t1 = _mm_unpacklo_epi32(r2, r3); /* x2 x3 y2 y3 */
+        const __m128i t2 = _mm_unpackhi_epi32(r0, r1); /* w0 w1 h0 h1 */
+        const __m128i t3 = _mm_unpackhi_epi32(r2, r3); /* w2 w3 h2 h3 */
+        const __m128i x = _mm_unpacklo_epi64(t0, t1);
+        const __m128i y = _mm_unpackhi_epi64(t0, t1);
+        const __m128i w = _mm_unpacklo_epi64(t2, t3);
+        const __m128i h = _mm_unpackhi_epi64(t2, t3);
+        __m128i hit;
+        int mask;
+
+        hit = _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+        hit = _mm_and_si128(hit, _mm_cmpgt_epi32(SDL_mm_min_epi32(_mm_add_epi32(x, w), bmaxx), SDL_mm_max_epi32(x, bminx)));
+        hit = _mm_and_si128(hit, _mm_cmpgt_epi32(SDL_mm_min_epi32(_mm_add_epi32(y, h), bmaxy), SDL_mm_max_epi32(y, bminy)));
+
+        mask = _mm_movemask_ps(_mm_castsi128_ps(hit));
+        for (j = 0; j < 4; ++j) {
+            const SDL_bool bit = (mask >> j) & 1;
+            if (results) {
+                results[i + j] = bit;
+            }
+            *found += bit;
+        }
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") HasRectIntersectionsFloat_SSE2(const SDL_FRect *rects, int count, const SDL_FRect *B, SDL_bool *results, int *found)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 bminx = _mm_set1_ps(B->x);
+    const __m128 bmaxx = _mm_set1_ps(B->x + B->w);
+    const __m128 bminy = _mm_set1_ps(B->y);
+    const __m128 bmaxy = _mm_set1_ps(B->y + B->h);
+    int i, j;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&rects[i + 0].x);
+        __m128 y = _mm_loadu_ps(&rects[i + 1].x);
+        __m128 w = _mm_loadu_ps(&rects[i + 2].x);
+        __m128 h = _mm_loadu_ps(&rects[i + 3].x);
+        __m128 hit;
+        int mask;
+
+        _MM_TRANSPOSE4_PS(x, y, w, h);
+
+        hit = _mm_and_ps(_mm_cmpnle_ps(w, zero), _mm_cmpnle_ps(h, zero));
+        hit = _mm_and_ps(hit, _mm_cmpnle_ps(_mm_min_ps(bmaxx, _mm_add_ps(x, w)), _mm_max_ps(bminx, x)));
+        hit = _mm_and_ps(hit, _mm_cmpnle_ps(_mm_min_ps(bmaxy, _mm_add_ps(y, h)), _mm_max_ps(bminy, y)));
+
+        mask = _mm_movemask_ps(hit);
+        for (j = 0; j < 4; ++j) {
+            const SDL_bool bit = (mask >> j) & 1;
+            if (results) {
+                results[i + j] = bit;
+            }
+            *found += bit;
+        }
+    }
+    return i;
+}
+
+/* Lanes that only saw points outside the clip rect keep the starting values,
+   which lose to any real point when the lanes are combined. */
+static int SDL_TARGETING("sse2") EnclosePoints_SSE2(const SDL_Point *points, int count, const SDL_Rect *clip, SDL_bool *added, int *minx, int *miny, int *maxx, int *maxy)
+{
+    const __m128i all = _mm_set1_epi32(-1);
+    const __m128i big = _mm_set1_epi32(SDL_MAX_SINT32);
+    const __m128i small = _mm_set1_epi32(SDL_MIN_SINT32);
+    __m128i cminx = small, cminy = small, cmaxx = big, cmaxy = big;
+    __m128i vminx = big, vminy = big, vmaxx = small, vmaxy = small;
+    __m128i any = _mm_setzero_si128();
+    int i, value;
+
+    if (clip) {
+        cminx = _mm_set1_epi32(clip->x);
+        cminy = _mm_set1_epi32(clip->y);
+        cmaxx = _mm_set1_epi32(clip->x + clip->w - 1);
+        cmaxy = _mm_set1_epi32(clip->y + clip->h - 1);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128 p01 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)&points[i + 0]));
+        const __m128 p23 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)&points[i + 2]));
+        const __m128i x = _mm_castps_si128(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i y = _mm_castps_si128(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i out = _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(x, cminx), _mm_cmpgt_epi32(x, cmaxx)),
+                                         _mm_or_si128(_mm_cmplt_epi32(y, cminy), _mm_cmpgt_epi32(y, cmaxy)));
+
+        any = _mm_or_si128(any, _mm_andnot_si128(out, all));
+        vminx = SDL_mm_min_epi32(vminx, SDL_mm_select_epi32(out, big, x));
+        vminy = SDL_mm_min_epi32(vminy, SDL_mm_select_epi32(out, big, y));
+        vmaxx = SDL_mm_max_epi32(vmaxx, SDL_mm_select_epi32(out, small, x));
+        vmaxy = SDL_mm_max_epi32(vmaxy, SDL_mm_select_epi32(out, small, y));
+    }
+
+    if (_mm_movemask_epi8(any) == 0) {
+        return i; /* none of these points were inside the clip rect */
+    }
+
+    value = SDL_mm_hmin_epi32(vminx);
+    if (!*added || value < *minx) {
+        *minx = value;
+    }
+    value = SDL_mm_hmin_epi32(vminy);
+    if (!*added || value < *miny) {
+        *miny = value;
+    }
+    value = SDL_mm_hmax_epi32(vmaxx);
+    if (!*added || value > *maxx) {
+        *maxx = value;
+    }
+    value = SDL_mm_hmax_epi32(vmaxy);
+    if (!*added || value > *maxy) {
+        *maxy = value;
+    }
+    *added = SDL_TRUE;
+    return i;
+}
+
+static int SDL_TARGETING("sse2") EnclosePointsFloat_SSE2(const SDL_FPoint *points, int count, const SDL_FRect *clip, SDL_bool *added, float *minx, float *miny, float *maxx, float *maxy)
+{
+    const __m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    const __m128 big = _mm_castsi128_ps(_mm_set1_epi32(0x7F800000)); /* +infinity */
+    const __m128 small = _mm_castsi128_ps(_mm_set1_epi32((int)0xFF800000)); /* -infinity */
+    __m128 cminx = small, cminy = small, cmaxx = big, cmaxy = big;
+    __m128 vminx = big, vminy = big, vmaxx = small, vmaxy = small;
+    __m128 any = _mm_setzero_ps();
+    int i;
+    float value;
+
+    if (clip) {
+        cminx = _mm_set1_ps(clip->x);
+        cminy = _mm_set1_ps(clip->y);
+        cmaxx = _mm_set1_ps(clip->x + clip->w - 1);
+        cmaxy = _mm_set1_ps(clip->y + clip->h - 1);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128 p01 = _mm_loadu_ps(&points[i + 0].x);
+        const __m128 p23 = _mm_loadu_ps(&points[i + 2].x);
+        const __m128 x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 out = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, cminx), _mm_cmpgt_ps(x, cmaxx)),
+                                     _mm_or_ps(_mm_cmplt_ps(y, cminy), _mm_cmpgt_ps(y, cmaxy)));
+        const __m128 in = _mm_andnot_ps(out, all);
+
+        any = _mm_or_ps(any, in);
+        vminx = _mm_min_ps(_mm_or_ps(_mm_and_ps(in, x), _mm_and_ps(out, big)), vminx);
+        vminy = _mm_min_ps(_mm_or_ps(_mm_and_ps(in, y), _mm_and_ps(out, big)), vminy);
+        vmaxx = _mm_max_ps(_mm_or_ps(_mm_and_ps(in, x), _mm_and_ps(out, small)), vmaxx);
+        vmaxy = _mm_max_ps(_mm_or_ps(_mm_and_ps(in, y), _mm_and_ps(out, small)), vmaxy);
+    }
+
+    if (_mm_movemask_ps(any) == 0) {
+        return i; /* none of these points were inside the clip rect */
+    }
+
+    value = SDL_mm_hmin_ps(vminx);
+    if (!*added || value < *minx) {
+        *minx = value;
+    }
+    value = SDL_mm_hmin_ps(vminy);
+    if (!*added || value < *miny) {
+        *miny = value;
+    }
+    value = SDL_mm_hmax_ps(vmaxx);
+    if (!*added || value > *maxx) {
+        *maxx = value;
+    }
+    value = SDL_mm_hmax_ps(vmaxy);
+    if (!*added || value > *maxy) {
+        *maxy = value;
+    }
+    *added = SDL_TRUE;
+    return i;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE int hasNEON(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasNEON();
+    return val;
+}
+
+static int HasRectIntersections_NEON(const SDL_Rect *rects, int count, const SDL_Rect *B, SDL_bool *results, int *found)
+{
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t bminx = vdupq_n_s32(B->x);
+    const int32x4_t bmaxx = vdupq_n_s32(B->x + B->w);
+    const int32x4_t bminy = vdupq_n_s32(B->y);
+    const int32x4_t bmaxy = vdupq_n_s32(B->y + B->h);
+    int i, j;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const int32x4x4_t r = vld4q_s32(&rects[i].x); /* x, y, w, h */
+        uint32x4_t hit;
+        Uint32 bits[4];
+
+        hit = vandq_u32(vcgtq_s32(r.val[2], zero), vcgtq_s32(r.val[3], zero));
+        hit = vandq_u32(hit, vcgtq_s32(vminq_s32(vaddq_s32(r.val[0], r.val[2]), bmaxx), vmaxq_s32(r.val[0], bminx)));
+        hit = vandq_u32(hit, vcgtq_s32(vminq_s32(vaddq_s32(r.val[1], r.val[3]), bmaxy), vmaxq_s32(r.val[1], bminy)));
+
+        vst1q_u32(bits, vandq_u32(hit, vdupq_n_u32(1)));
+        for (j = 0; j < 4; ++j) {
+            if (results) {
+                results[i + j] = bits[j];
+            }
+            *found += bits[j];
+        }
+    }
+    return i;
+}
+
+static int HasRectIntersectionsFloat_NEON(const SDL_FRect *rects, int count, const SDL_FRect *B, SDL_bool *results, int *found)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t bminx = vdupq_n_f32(B->x);
+    const float32x4_t bmaxx = vdupq_n_f32(B->x + B->w);
+    const float32x4_t bminy = vdupq_n_f32(B->y);
+    const float32x4_t bmaxy = vdupq_n_f32(B->y + B->h);
+    int i, j;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const float32x4x4_t r = vld4q_f32(&rects[i].x); /* x, y, w, h */
+        float32x4_t x1, x2, y1, y2;
+        uint32x4_t hit;
+        Uint32 bits[4];
+
+        /* Pick the bounds the same way the scalar code does, so NaN behaves the same */
+        x1 = vbslq_f32(vcgtq_f32(bminx, r.val[0]), bminx, r.val[0]);
+        x2 = vaddq_f32(r.val[0], r.val[2]);
+        x2 = vbslq_f32(vcltq_f32(bmaxx, x2), bmaxx, x2);
+        y1 = vbslq_f32(vcgtq_f32(bminy, r.val[1]), bminy, r.val[1]);
+        y2 = vaddq_f32(r.val[1], r.val[3]);
+        y2 = vbslq_f32(vcltq_f32(bmaxy, y2), bmaxy, y2);
+
+        hit = vandq_u32(vmvnq_u32(vcleq_f32(r.val[2], zero)), vmvnq_u32(vcleq_f32(r.val[3], zero)));
+        hit = vandq_u32(hit, vmvnq_u32(vcleq_f32(x2, x1)));
+        hit = vandq_u32(hit, vmvnq_u32(vcleq_f32(y2, y1)));
+
+        vst1q_u32(bits, vandq_u32(hit, vdupq_n_u32(1)));
+        for (j = 0; j < 4; ++j) {
+            if (results) {
+                results[i + j] = bits[j];
+            }
+            *found += bits[j];
+        }
+    }
+    return i;
+}
+
+static int EnclosePoints_NEON(const SDL_Point *points, int count, const SDL_Rect *clip, SDL_bool *added, int *minx, int *miny, int *maxx, int *maxy)
+{
+    const int32x4_t big = vdupq_n_s32(SDL_MAX_SINT32);
+    const int32x4_t small = vdupq_n_s32(SDL_MIN_SINT32);
+    int32x4_t cminx = small, cminy = small, cmaxx = big, cmaxy = big;
+    int32x4_t vminx = big, vminy = big, vmaxx = small, vmaxy = small;
+    uint32x4_t any = vdupq_n_u32(0);
+    Uint32 lanes[4];
+    int32x2_t v;
+    int i, value;
+
+    if (clip) {
+        cminx = vdupq_n_s32(clip->x);
+        cminy = vdupq_n_s32(clip->y);
+        cmaxx = vdupq_n_s32(clip->x + clip->w - 1);
+        cmaxy = vdupq_n_s32(clip->y + clip->h - 1);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const int32x4x2_t p = vld2q_s32(&points[i].x); /* x, y */
+        const uint32x4_t out = vorrq_u32(vorrq_u32(vcltq_s32(p.val[0], cminx), vcgtq_s32(p.val[0], cmaxx)),
+                                         vorrq_u32(vcltq_s32(p.val[1], cminy), vcgtq_s32(p.val[1], cmaxy)));
+
+        any = vorrq_u32(any, vmvnq_u32(out));
+        vminx = vminq_s32(vminx, vbslq_s32(out, big, p.val[0]));
+        vminy = vminq_s32(vminy, vbslq_s32(out, big, p.val[1]));
+        vmaxx = vmaxq_s32(vmaxx, vbslq_s32(out, small, p.val[0]));
+        vmaxy = vmaxq_s32(vmaxy, vbslq_s32(out, small, p.val[1]));
+    }
+
+    vst1q_u32(lanes, any);
+    if (!(lanes[0] | lanes[1] | lanes[2] | lanes[3])) {
+        return i; /* none of these points were inside the clip rect */
+    }
+
+    v = vpmin_s32(vget_low_s32(vminx), vget_high_s32(vminx));
+    value = vget_lane_s32(vpmin_s32(v, v), 0);
+    if (!*added || value < *minx) {
+        *minx = value;
+    }
+    v = vpmin_s32(vget_low_s32(vminy), vget_high_s32(vminy));
+    value = vget_lane_s32(vpmin_s32(v, v), 0);
+    if (!*added || value < *miny) {
+        *miny = value;
+    }
+    v = vpmax_s32(vget_low_s32(vmaxx), vget_high_s32(vmaxx));
+    value = vget_lane_s32(vpmax_s32(v, v), 0);
+    if (!*added || value > *maxx) {
+        *maxx = value;
+    }
+    v = vpmax_s32(vget_low_s32(vmaxy), vget_high_s32(vmaxy));
+    value = vget_lane_s32(vpmax_s32(v, v), 0);
+    if (!*added || value > *maxy) {
+        *maxy = value;
+    }
+    *added = SDL_TRUE;
+    return i;
+}
+
+static int EnclosePointsFloat_NEON(const SDL_FPoint *points, int count, const SDL_FRect *clip, SDL_bool *added, float *minx, float *miny, float *maxx, float *maxy)
+{
+    const float32x4_t big = vreinterpretq_f32_u32(vdupq_n_u32(0x7F800000)); /* +infinity */
+    const float32x4_t small = vreinterpretq_f32_u32(vdupq_n_u32(0xFF800000)); /* -infinity */
+    float32x4_t cminx = small, cminy = small, cmaxx = big, cmaxy = big;
+    float32x4_t vminx = big, vminy = big, vmaxx = small, vmaxy = small;
+    uint32x4_t any = vdupq_n_u32(0);
+    Uint32 lanes[4];
+    float32x2_t v;
+    int i;
+    float value;
+
+    if (clip) {
+        cminx = vdupq_n_f32(clip->x);
+        cminy = vdupq_n_f32(clip->y);
+        cmaxx = vdupq_n_f32(clip->x + clip->w - 1);
+        cmaxy = vdupq_n_f32(clip->y + clip->h - 1);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const float32x4x2_t p = vld2q_f32(&points[i].x); /* x, y */
+        const uint32x4_t out = vorrq_u32(vorrq_u32(vcltq_f32(p.val[0], cminx), vcgtq_f32(p.val[0], cmaxx)),
+                                         vorrq_u32(vcltq_f32(p.val[1], cminy), vcgtq_f32(p.val[1], cmaxy)));
+        float32x4_t x, y;
+
+        any = vorrq_u32(any, vmvnq_u32(out));
+
+        /* Compare and select rather than vminq/vmaxq, which would let NaN through */
+        x = vbslq_f32(out, big, p.val[0]);
+        y = vbslq_f32(out, big, p.val[1]);
+        vminx = vbslq_f32(vcltq_f32(x, vminx), x, vminx);
+        vminy = vbslq_f32(vcltq_f32(y, vminy), y, vminy);
+        x = vbslq_f32(out, small, p.val[0]);
+        y = vbslq_f32(out, small, p.val[1]);
+        vmaxx = vbslq_f32(vcgtq_f32(x, vmaxx), x, vmaxx);
+        vmaxy = vbslq_f32(vcgtq_f32(y, vmaxy), y, vmaxy);
+    }
+
+    vst1q_u32(lanes, any);
+    if (!(lanes[0] | lanes[1] | lanes[2] | lanes[3])) {
+        return i; /* none of these points were inside the clip rect */
+    }
+
+    v = vpmin_f32(vget_low_f32(vminx), vget_high_f32(vminx));
+    value = vget_lane_f32(vpmin_f32(v, v), 0);
+    if (!*added || value < *minx) {
+        *minx = value;
+    }
+    v = vpmin_f32(vget_low_f32(vminy), vget_high_f32(vminy));
+    value = vget_lane_f32(vpmin_f32(v, v), 0);
+    if (!*added || value < *miny) {
+        *miny = value;
+    }
+    v = vpmax_f32(vget_low_f32(vmaxx), vget_high_f32(vmaxx));
+    value = vget_lane_f32(vpmax_f32(v, v), 0);
+    if (!*added || value > *maxx) {
+        *maxx = value;
+    }
+    v = vpmax_f32(vget_low_f32(vmaxy), vget_high_f32(vmaxy));
+    value = vget_lane_f32(vpmax_f32(v, v), 0);
+    if (!*added || value > *maxy) {
+        *maxy = value;
+    }
+    *added = SDL_TRUE;
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static int HasRectIntersections_SIMD(const SDL_Rect *rects, int count, const SDL_Rect *B, SDL_bool *results, int *found)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        return HasRectIntersections_SSE2(rects, count, B, results, found);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        return HasRectIntersections_NEON(rects, count, B, results, found);
+    }
+#endif
+    return 0;
+}
+
+static int HasRectIntersectionsFloat_SIMD(const SDL_FRect *rects, int count, const SDL_FRect *B, SDL_bool *results, int *found)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        return HasRectIntersectionsFloat_SSE2(rects, count, B, results, found);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        return HasRectIntersectionsFloat_NEON(rects, count, B, results, found);
+    }
+#endif
+    return 0;
+}
+
+static int EnclosePoints_SIMD(const SDL_Point *points, int count, const SDL_Rect *clip, SDL_bool *added, int *minx, int *miny, int *maxx, int *maxy)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        return EnclosePoints_SSE2(points, count, clip, added, minx, miny, maxx, maxy);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        return EnclosePoints_NEON(points, count, clip, added, minx, miny, maxx, maxy);
+    }
+#endif
+    return 0;
+}
+
+static int EnclosePointsFloat_SIMD(const SDL_FPoint *points, int count, const SDL_FRect *clip, SDL_bool *added, float *minx, float *miny, float *maxx, float *maxy)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        return EnclosePointsFloat_SSE2(points, count, clip, added, minx, miny, maxx, maxy);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        return EnclosePointsFloat_NEON(points, count, clip, added, minx, miny, maxx, maxy);
+    }
+#endif
+    return 0;
+}
+
 /* For use with the Cohen-Sutherland algorithm for line clipping, in SDL_rect_impl.h */
 #define CODE_BOTTOM 1
 #define CODE_TOP    2
@@ -91,10 +610,13 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
 #define BIGSCALARTYPE            Sint64
 #define COMPUTEOUTCODE           ComputeOutCode
 #define SDL_HASINTERSECTION      SDL_HasRectIntersection
+#define SDL_HASINTERSECTIONS     SDL_HasRectIntersections
+#define HASINTERSECTIONS_SIMD    HasRectIntersections_SIMD
 #define SDL_INTERSECTRECT        SDL_GetRectIntersection
 #define SDL_RECTEMPTY            SDL_RectEmpty
 #define SDL_UNIONRECT            SDL_GetRectUnion
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPoints
+#define ENCLOSEPOINTS_SIMD       EnclosePoints_SIMD
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersection
 #include "SDL_rect_impl.h"
 
@@ -104,9 +626,12 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
 #define BIGSCALARTYPE            double
 #define COMPUTEOUTCODE           ComputeOutCodeFloat
 #define SDL_HASINTERSECTION      SDL_HasRectIntersectionFloat
+#define SDL_HASINTERSECTIONS     SDL_HasRectIntersectionsFloat
+#define HASINTERSECTIONS_SIMD    HasRectIntersectionsFloat_SIMD
 #define SDL_INTERSECTRECT        SDL_GetRectIntersectionFloat
 #define SDL_RECTEMPTY            SDL_RectEmptyFloat
 #define SDL_UNIONRECT            SDL_GetRectUnionFloat
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPointsFloat
+#define ENCLOSEPOINTS_SIMD       EnclosePointsFloat_SIMD
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersectionFloat
 #include "SDL_rect_impl.h"
@@ -66,6 +66,37 @@ SDL_bool SDL_HASINTERSECTION(const RECTTYPE *A, const RECTTYPE *B)
     return SDL_TRUE;
 }
 
+int SDL_HASINTERSECTIONS(const RECTTYPE *rects, int count, const RECTTYPE *B, SDL_bool *results)
+{
+    int i, found = 0;
+
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    } else if (count < 0) {
+        return SDL_InvalidParamError("count");
+    } else if (!B) {
+        return SDL_InvalidParamError("B");
+    } else if (SDL_RECTEMPTY(B)) {
+        if (results) {
+            SDL_memset(results, 0, count * sizeof(*results));
+        }
+        return 0;
+    }
+
+    /* Test as many as we can in parallel, then finish the rest one at a time */
+    i = HASINTERSECTIONS_SIMD(rects, count, B, results, &found);
+    for (; i < count; ++i) {
+        const SDL_bool hit = SDL_HASINTERSECTION(&rects[i], B);
+        if (results) {
+            results[i] = hit;
+        }
+        if (hit) {
+            ++found;
+        }
+    }
+    return found;
+}
+
 SDL_bool SDL_INTERSECTRECT(const RECTTYPE *A, const RECTTYPE *B, RECTTYPE *result)
 {
     SCALARTYPE Amin, Amax, Bmin, Bmax;
@@ -198,7 +229,11 @@ SDL_bool SDL_ENCLOSEPOINTS(const POINTTYPE *points, int count, const RECTTYPE *c
             return SDL_FALSE;
         }
 
-        for (i = 0; i < count; ++i) {
+        i = 0;
+        if (result) {
+            i = ENCLOSEPOINTS_SIMD(points, count, clip, &added, &minx, &miny, &maxx, &maxy);
+        }
+        for (; i < count; ++i) {
             x = points[i].x;
             y = points[i].y;
 
@@ -238,11 +273,14 @@ SDL_bool SDL_ENCLOSEPOINTS(const POINTTYPE *points, int count, const RECTTYPE *c
             return SDL_TRUE;
         }
 
+        SDL_bool added = SDL_TRUE;
+
         /* No clipping, always add the first point */
         minx = maxx = points[0].x;
         miny = maxy = points[0].y;
 
-        for (i = 1; i < count; ++i) {
+        i = 1 + ENCLOSEPOINTS_SIMD(points + 1, count - 1, NULL, &added, &minx, &miny, &maxx, &maxy);
+        for (; i < count; ++i) {
             x = points[i].x;
             y = points[i].y;
 
@@ -430,8 +468,11 @@ SDL_bool SDL_INTERSECTRECTANDLINE(const RECTTYPE *rect, SCALARTYPE *X1, SCALARTY
 #undef BIGSCALARTYPE
 #undef COMPUTEOUTCODE
 #undef SDL_HASINTERSECTION
+#undef SDL_HASINTERSECTIONS
+#undef HASINTERSECTIONS_SIMD
 #undef SDL_INTERSECTRECT
 #undef SDL_RECTEMPTY
 #undef SDL_UNIONRECT
 #undef SDL_ENCLOSEPOINTS
+#undef ENCLOSEPOINTS_SIMD
 #undef SDL_INTERSECTRECTANDLINE
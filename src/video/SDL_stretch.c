@@ -25,6 +25,7 @@
 static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static int SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static int SDL_UpperSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+static int SDL_LowerSoftStretchFiltered(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
 int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
                     SDL_Surface *dst, const SDL_Rect *dstrect)
@@ -38,6 +39,12 @@ int SDL_SoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect,
     return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
 }
 
+int SDL_PrivateSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
+                           SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, scaleMode);
+}
+
 static int SDL_UpperSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
                                 SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -116,6 +123,8 @@ static int SDL_UpperSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
         ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    } else if (scaleMode == SDL_SCALEMODE_AREA || scaleMode == SDL_SCALEMODE_LANCZOS) {
+        ret = SDL_LowerSoftStretchFiltered(src, srcrect, dst, dstrect, scaleMode);
     } else {
         ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
     }
@@ -156,7 +165,8 @@ static int SDL_UpperSoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
     dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    middle_init = dst_w - left_pad_w - right_pad_w;                                   \
+    fp_sum_h += y_start * fp_step_h;
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -283,11 +293,12 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
 }
 
 static int scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch,
-                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch,
+                     int y_start, int y_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y_start; i < y_end; i++) {
 
         BILINEAR___HEIGHT
 
@@ -403,11 +414,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y_start, int y_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y_start; i < y_end; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -567,11 +578,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y_start, int y_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y_start; i < y_end; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -785,35 +796,517 @@ static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch
 }
 #endif
 
+/* Scales src_w x src_h to dst_w x dst_h, only producing the rows from y_start up to y_end,
+   with dst pointing at the destination of row y_start */
+static int scale_mat_rows(const Uint32 *src, int src_w, int src_h, int src_pitch,
+                          Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y_start, int y_end)
+{
+    int ret = -1;
+
+#ifdef SDL_NEON_INTRINSICS
+    if (ret == -1 && hasNEON()) {
+        ret = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, y_start, y_end);
+    }
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (ret == -1 && hasSSE2()) {
+        ret = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, y_start, y_end);
+    }
+#endif
+
+    if (ret == -1) {
+        ret = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, y_start, y_end);
+    }
+
+    return ret;
+}
+
 int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
                                SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    int ret = -1;
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
     int src_pitch = s->pitch;
     int dst_pitch = d->pitch;
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
     Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
 
+    return scale_mat_rows(src, srcrect->w, srcrect->h, src_pitch, dst, dstrect->w, dstrect->h, dst_pitch, 0, dstrect->h);
+}
+
+/* Area averaging and Lanczos-3 scaling.
+   Each axis gets a precomputed table of 2.14 fixed point weights, then every
+   destination row is filtered vertically into a temporary row, which is
+   filtered horizontally into the destination. */
+#define FILTER_BITS 14
+#define FILTER_ONE  (1 << FILTER_BITS)
+
+typedef struct stretch_filter_t
+{
+    int *start;      /* first source pixel of each destination pixel */
+    int *count;      /* number of source pixels of each destination pixel */
+    Sint16 *weights; /* max_taps weights for each destination pixel */
+    int max_taps;
+} stretch_filter_t;
+
+typedef void (*filter_vertical_func)(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int n);
+typedef void (*filter_horizontal_func)(const Uint8 *src, const stretch_filter_t *filter, Uint32 *dst, int dst_w);
+
+static double lanczos3(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+    if (x <= -3.0 || x >= 3.0) {
+        return 0.0;
+    }
+    x *= SDL_PI_D;
+    return 3.0 * SDL_sin(x) * SDL_sin(x / 3.0) / (x * x);
+}
+
+static void free_stretch_filter(stretch_filter_t *filter)
+{
+    SDL_free(filter->start);
+    SDL_free(filter->count);
+    SDL_free(filter->weights);
+}
+
+static int build_stretch_filter(stretch_filter_t *filter, int src_n, int dst_n, SDL_ScaleMode scaleMode)
+{
+    const double scale = (double)src_n / dst_n;
+    const double filter_scale = SDL_max(scale, 1.0);
+    const SDL_bool lanczos = (scaleMode == SDL_SCALEMODE_LANCZOS);
+    const SDL_bool box = (!lanczos && scale > 1.0);
+    double support;
+    double *taps;
+    int i, j, k;
+
+    if (lanczos) {
+        support = 3.0 * filter_scale;
+    } else if (box) {
+        support = scale / 2.0;
+    } else {
+        /* Area averaging doesn't apply when upscaling, interpolate linearly */
+        support = 1.0;
+    }
+
+    filter->max_taps = (int)SDL_ceil(2.0 * support) + 3;
+    filter->start = (int *)SDL_malloc(dst_n * sizeof(*filter->start));
+    filter->count = (int *)SDL_malloc(dst_n * sizeof(*filter->count));
+    filter->weights = (Sint16 *)SDL_calloc((size_t)dst_n * filter->max_taps, sizeof(*filter->weights));
+    taps = (double *)SDL_malloc(filter->max_taps * sizeof(*taps));
+    if (!filter->start || !filter->count || !filter->weights || !taps) {
+        free_stretch_filter(filter);
+        SDL_free(taps);
+        return SDL_OutOfMemory();
+    }
+
+    for (i = 0; i < dst_n; ++i) {
+        const double center = (i + 0.5) * scale;
+        const int lo = (int)SDL_floor(center - support);
+        const int hi = (int)SDL_ceil(center + support);
+        int first = SDL_max(lo, 0);
+        const int last = SDL_min(hi, src_n - 1);
+        int n = last - first + 1;
+        int skip = 0, biggest = 0, fixed_sum = 0;
+        Sint16 *weights = &filter->weights[i * filter->max_taps];
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k) {
+            taps[k] = 0.0;
+        }
+        for (j = lo; j <= hi; ++j) {
+            const double x = j + 0.5 - center;
+            double weight;
+
+            if (lanczos) {
+                weight = lanczos3(x / filter_scale);
+            } else if (box) {
+                weight = SDL_min(j + 1.0, center + support) - SDL_max((double)j, center - support);
+            } else {
+                weight = 1.0 - SDL_fabs(x);
+            }
+            if (weight == 0.0 || (!lanczos && weight < 0.0)) {
+                continue;
+            }
+            /* Pixels past the edges repeat the edge pixel */
+            taps[SDL_clamp(j, first, last) - first] += weight;
+            sum += weight;
+        }
+
+        /* Trim unused taps at both ends */
+        while (n > 1 && taps[n - 1] == 0.0) {
+            --n;
+        }
+        while (skip < n - 1 && taps[skip] == 0.0) {
+            ++skip;
+        }
+        first += skip;
+        n -= skip;
+        if (sum == 0.0) {
+            sum = 1.0;
+            taps[skip] = 1.0;
+        }
+
+        for (k = 0; k < n; ++k) {
+            weights[k] = (Sint16)SDL_floor(taps[skip + k] / sum * FILTER_ONE + 0.5);
+            fixed_sum += weights[k];
+            if (SDL_abs(weights[k]) > SDL_abs(weights[biggest])) {
+                biggest = k;
+            }
+        }
+        /* Make the weights sum to exactly one, so flat areas stay flat */
+        weights[biggest] += (Sint16)(FILTER_ONE - fixed_sum);
+
+        filter->start[i] = first;
+        filter->count[i] = n;
+    }
+
+    SDL_free(taps);
+    return 0;
+}
+
+static SDL_INLINE Uint8 filter_clamp(int value)
+{
+    if (value <= 0) {
+        return 0;
+    }
+    value >>= FILTER_BITS;
+    return (Uint8)((value > 255) ? 255 : value);
+}
+
+static SDL_INLINE void filter_vertical_tail(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int x, int n)
+{
+    int k;
+
+    for (; x < n; ++x) {
+        int acc = FILTER_ONE / 2;
+        for (k = 0; k < taps; ++k) {
+            acc += weights[k] * rows[k][x];
+        }
+        dst[x] = filter_clamp(acc);
+    }
+}
+
+static void filter_vertical(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int n)
+{
+    filter_vertical_tail(rows, weights, taps, dst, 0, n);
+}
+
+static void filter_horizontal(const Uint8 *src, const stretch_filter_t *filter, Uint32 *dst, int dst_w)
+{
+    int x, k;
+
+    for (x = 0; x < dst_w; ++x) {
+        const Uint8 *p = src + filter->start[x] * 4;
+        const Sint16 *weights = &filter->weights[x * filter->max_taps];
+        const int taps = filter->count[x];
+        int acc0 = FILTER_ONE / 2, acc1 = FILTER_ONE / 2, acc2 = FILTER_ONE / 2, acc3 = FILTER_ONE / 2;
+        color_t *c = (color_t *)&dst[x];
+
+        for (k = 0; k < taps; ++k, p += 4) {
+            acc0 += weights[k] * p[0];
+            acc1 += weights[k] * p[1];
+            acc2 += weights[k] * p[2];
+            acc3 += weights[k] * p[3];
+        }
+        c->a = filter_clamp(acc0);
+        c->b = filter_clamp(acc1);
+        c->c = filter_clamp(acc2);
+        c->d = filter_clamp(acc3);
+    }
+}
+
+/* Two 16-bit weights packed for _mm_madd_epi16() */
+#define FILTER_WEIGHT_PAIR(w0, w1) ((int)(((Uint32)(Uint16)(w1) << 16) | (Uint16)(w0)))
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") filter_vertical_SSE2(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(FILTER_ONE / 2);
+    int x, k;
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        __m128i s0 = round, s1 = round, s2 = round, s3 = round;
+
+        for (k = 0; k < taps; k += 2) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(rows[k] + x));
+            __m128i b, w, lo, hi;
+
+            if (k + 1 < taps) {
+                b = _mm_loadu_si128((const __m128i *)(rows[k + 1] + x));
+                w = _mm_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], weights[k + 1]));
+            } else {
+                b = zero;
+                w = _mm_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], 0));
+            }
+            /* Interleave the two rows so each madd sums both taps */
+            lo = _mm_unpacklo_epi8(a, b);
+            hi = _mm_unpackhi_epi8(a, b);
+            s0 = _mm_add_epi32(s0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+            s1 = _mm_add_epi32(s1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+            s3 = _mm_add_epi32(s3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+        }
+        s0 = _mm_srai_epi32(s0, FILTER_BITS);
+        s1 = _mm_srai_epi32(s1, FILTER_BITS);
+        s2 = _mm_srai_epi32(s2, FILTER_BITS);
+        s3 = _mm_srai_epi32(s3, FILTER_BITS);
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(_mm_packs_epi32(s0, s1), _mm_packs_epi32(s2, s3)));
+    }
+    filter_vertical_tail(rows, weights, taps, dst, x, n);
+}
+
+static void SDL_TARGETING("sse2") filter_horizontal_SSE2(const Uint8 *src, const stretch_filter_t *filter, Uint32 *dst, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(FILTER_ONE / 2);
+    int x, k;
+
+    for (x = 0; x < dst_w; ++x) {
+        const Uint8 *p = src + filter->start[x] * 4;
+        const Sint16 *weights = &filter->weights[x * filter->max_taps];
+        const int taps = filter->count[x];
+        __m128i sum = round;
+
+        for (k = 0; k + 1 < taps; k += 2) {
+            /* c0 c1 c2 c3 of two pixels, rearranged to p0c0 p1c0 p0c1 p1c1 ... */
+            __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + k * 4)), zero);
+            v = _mm_unpacklo_epi16(v, _mm_srli_si128(v, 8));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(v, _mm_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], weights[k + 1]))));
+        }
+        if (k < taps) {
+            __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int *)(p + k * 4)), zero);
+            v = _mm_unpacklo_epi16(v, zero);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(v, _mm_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], 0))));
+        }
+        sum = _mm_srai_epi32(sum, FILTER_BITS);
+        sum = _mm_packs_epi32(sum, sum);
+        dst[x] = (Uint32)_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+    }
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") filter_vertical_AVX2(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi32(FILTER_ONE / 2);
+    int x, k;
+
+    /* The unpacks and packs stay within 128-bit lanes, so the byte order
+       comes out the same as the SSE2 version */
+    for (x = 0; x + 32 <= n; x += 32) {
+        __m256i s0 = round, s1 = round, s2 = round, s3 = round;
+
+        for (k = 0; k < taps; k += 2) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(rows[k] + x));
+            __m256i b, w, lo, hi;
+
+            if (k + 1 < taps) {
+                b = _mm256_loadu_si256((const __m256i *)(rows[k + 1] + x));
+                w = _mm256_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], weights[k + 1]));
+            } else {
+                b = zero;
+                w = _mm256_set1_epi32(FILTER_WEIGHT_PAIR(weights[k], 0));
+            }
+            lo = _mm256_unpacklo_epi8(a, b);
+            hi = _mm256_unpackhi_epi8(a, b);
+            s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), w));
+            s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), w));
+            s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), w));
+            s3 = _mm256_add_epi32(s3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), w));
+        }
+        s0 = _mm256_srai_epi32(s0, FILTER_BITS);
+        s1 = _mm256_srai_epi32(s1, FILTER_BITS);
+        s2 = _mm256_srai_epi32(s2, FILTER_BITS);
+        s3 = _mm256_srai_epi32(s3, FILTER_BITS);
+        _mm256_storeu_si256((__m256i *)(dst + x), _mm256_packus_epi16(_mm256_packs_epi32(s0, s1), _mm256_packs_epi32(s2, s3)));
+    }
+    filter_vertical_tail(rows, weights, taps, dst, x, n);
+}
+#endif
+
 #ifdef SDL_NEON_INTRINSICS
-    if (ret == -1 && hasNEON()) {
-        ret = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+static void filter_vertical_NEON(const Uint8 *const *rows, const Sint16 *weights, int taps, Uint8 *dst, int n)
+{
+    int x, k;
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+
+        for (k = 0; k < taps; ++k) {
+            const int16x8_t p = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(rows[k] + x)));
+            lo = vmlal_n_s16(lo, vget_low_s16(p), weights[k]);
+            hi = vmlal_n_s16(hi, vget_high_s16(p), weights[k]);
+        }
+        /* Rounding, saturating narrow back down to bytes */
+        vst1_u8(dst + x, vqmovn_u16(vcombine_u16(vqrshrun_n_s32(lo, FILTER_BITS), vqrshrun_n_s32(hi, FILTER_BITS))));
     }
+    filter_vertical_tail(rows, weights, taps, dst, x, n);
+}
 #endif
 
+typedef struct stretch_filter_state_t
+{
+    stretch_filter_t hfilter;
+    stretch_filter_t vfilter;
+    const Uint8 **rows;
+    Uint8 *tmp;
+    filter_vertical_func vertical;
+    filter_horizontal_func horizontal;
+} stretch_filter_state_t;
+
+static void free_stretch_filter_state(stretch_filter_state_t *state)
+{
+    free_stretch_filter(&state->hfilter);
+    free_stretch_filter(&state->vfilter);
+    SDL_free(state->rows);
+    SDL_free(state->tmp);
+}
+
+static int init_stretch_filter_state(stretch_filter_state_t *state, int src_w, int src_h, int dst_w, int dst_h, SDL_ScaleMode scaleMode)
+{
+    SDL_zerop(state);
+    if (build_stretch_filter(&state->hfilter, src_w, dst_w, scaleMode) < 0) {
+        return -1;
+    }
+    if (build_stretch_filter(&state->vfilter, src_h, dst_h, scaleMode) < 0) {
+        free_stretch_filter(&state->hfilter);
+        return -1;
+    }
+    state->rows = (const Uint8 **)SDL_malloc(state->vfilter.max_taps * sizeof(*state->rows));
+    state->tmp = (Uint8 *)SDL_malloc((size_t)src_w * 4);
+    if (!state->rows || !state->tmp) {
+        free_stretch_filter_state(state);
+        return SDL_OutOfMemory();
+    }
+
+    state->vertical = filter_vertical;
+    state->horizontal = filter_horizontal;
 #ifdef SDL_SSE2_INTRINSICS
-    if (ret == -1 && hasSSE2()) {
-        ret = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (hasSSE2()) {
+        state->vertical = filter_vertical_SSE2;
+        state->horizontal = filter_horizontal_SSE2;
+    }
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        state->vertical = filter_vertical_AVX2;
     }
 #endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        state->vertical = filter_vertical_NEON;
+    }
+#endif
+    return 0;
+}
 
-    if (ret == -1) {
-        ret = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+/* Filters the rows from y_start up to y_end, with dst pointing at the destination of row y_start */
+static void stretch_filter_rows(stretch_filter_state_t *state, const Uint8 *src, int src_w, int src_pitch,
+                                Uint8 *dst, int dst_w, int dst_pitch, int y_start, int y_end)
+{
+    int y, k;
+
+    for (y = y_start; y < y_end; ++y) {
+        const int taps = state->vfilter.count[y];
+        const Sint16 *weights = &state->vfilter.weights[y * state->vfilter.max_taps];
+        const Uint8 *row;
+
+        if (taps == 1) {
+            row = src + state->vfilter.start[y] * src_pitch;
+        } else {
+            for (k = 0; k < taps; ++k) {
+                state->rows[k] = src + (state->vfilter.start[y] + k) * src_pitch;
+            }
+            state->vertical(state->rows, weights, taps, state->tmp, src_w * 4);
+            row = state->tmp;
+        }
+        state->horizontal(row, &state->hfilter, (Uint32 *)dst, dst_w);
+        dst += dst_pitch;
+    }
+}
+
+static int SDL_LowerSoftStretchFiltered(SDL_Surface *s, const SDL_Rect *srcrect,
+                                        SDL_Surface *d, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    const Uint8 *src = (const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * s->pitch;
+    Uint8 *dst = (Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * d->pitch;
+    stretch_filter_state_t state;
+
+    if (init_stretch_filter_state(&state, srcrect->w, srcrect->h, dstrect->w, dstrect->h, scaleMode) < 0) {
+        return -1;
+    }
+    stretch_filter_rows(&state, src, srcrect->w, s->pitch, dst, dstrect->w, d->pitch, 0, dstrect->h);
+    free_stretch_filter_state(&state);
+    return 0;
+}
+
+int SDL_PrivateSoftStretchBands(SDL_Surface *s, const SDL_Rect *srcrect, int dst_w, int dst_h,
+                                SDL_Surface *band, SDL_ScaleMode scaleMode, SDL_StretchBandFunc callback, void *userdata)
+{
+    const Uint8 *src;
+    stretch_filter_state_t state;
+    SDL_bool filtered = (scaleMode == SDL_SCALEMODE_AREA || scaleMode == SDL_SCALEMODE_LANCZOS);
+    int src_locked = 0;
+    int ret = 0;
+    int y, h;
+
+    if (s->format->format != band->format->format) {
+        return SDL_SetError("Only works with same format surfaces");
+    }
+    if (scaleMode == SDL_SCALEMODE_NEAREST ||
+        s->format->BytesPerPixel != 4 || s->format->format == SDL_PIXELFORMAT_ARGB2101010) {
+        return SDL_SetError("Wrong format");
+    }
+    if ((srcrect->x < 0) || (srcrect->y < 0) ||
+        ((srcrect->x + srcrect->w) > s->w) ||
+        ((srcrect->y + srcrect->h) > s->h)) {
+        return SDL_SetError("Invalid source blit rectangle");
+    }
+    if (band->w < dst_w || band->h <= 0) {
+        return SDL_SetError("Band surface is too small");
+    }
+    if (dst_w <= 0 || dst_h <= 0) {
+        return 0;
     }
 
+    if (filtered && init_stretch_filter_state(&state, srcrect->w, srcrect->h, dst_w, dst_h, scaleMode) < 0) {
+        return -1;
+    }
+
+    if (SDL_MUSTLOCK(s)) {
+        if (SDL_LockSurface(s) < 0) {
+            if (filtered) {
+                free_stretch_filter_state(&state);
+            }
+            return SDL_SetError("Unable to lock source surface");
+        }
+        src_locked = 1;
+    }
+
+    src = (const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * s->pitch;
+    for (y = 0; y < dst_h && ret == 0; y += h) {
+        h = SDL_min(band->h, dst_h - y);
+        if (filtered) {
+            stretch_filter_rows(&state, src, srcrect->w, s->pitch, (Uint8 *)band->pixels, dst_w, band->pitch, y, y + h);
+        } else {
+            ret = scale_mat_rows((const Uint32 *)src, srcrect->w, srcrect->h, s->pitch,
+                                 (Uint32 *)band->pixels, dst_w, dst_h, band->pitch, y, y + h);
+        }
+        if (ret == 0) {
+            ret = callback(userdata, band, y, h);
+        }
+    }
+
+    if (src_locked) {
+        SDL_UnlockSurface(s);
+    }
+    if (filtered) {
+        free_stretch_filter_state(&state);
+    }
     return ret;
 }
 
@@ -30,6 +30,10 @@
 #include "../render/SDL_sysrender.h"
 #include "../video/SDL_yuv_c.h"
 
+#ifdef HAVE_MADVISE
+#include <sys/mman.h>
+#endif
+
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
                         sizeof(int) == sizeof(Sint32) && sizeof(size_t) >= sizeof(Sint32));
@@ -115,11 +119,223 @@ int SDL_CalculateSize(Uint32 format, int width, int height, size_t *size, size_t
     return 0;
 }
 
+/* Huge pages are 2 MB on the platforms that have transparent huge pages */
+#define SDL_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/* Pixel memory kept by a surface pool for reuse */
+typedef struct SDL_PooledPixels
+{
+    void *pixels;
+    size_t size;
+} SDL_PooledPixels;
+
+struct SDL_SurfacePool
+{
+    SDL_Mutex *lock;
+    size_t alignment;
+    SDL_bool huge_pages;
+    SDL_bool clear;
+    size_t max_bytes;
+    size_t idle_bytes;
+    SDL_PooledPixels *idle;
+    int num_idle;
+    int max_idle;
+    int refcount; /* one for the application, and one for each surface using the pool */
+};
+
+static void *AllocPoolPixels(SDL_SurfacePool *pool, size_t size)
+{
+    size_t alignment = pool->alignment;
+    void *pixels;
+
+    if (pool->huge_pages && size >= SDL_HUGE_PAGE_SIZE) {
+        alignment = SDL_max(alignment, SDL_HUGE_PAGE_SIZE);
+    }
+    pixels = SDL_aligned_alloc(alignment, size);
+    if (!pixels) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+    if (alignment >= SDL_HUGE_PAGE_SIZE) {
+        /* SDL_aligned_alloc() pads the memory to a multiple of the alignment.
+           This is only advice, so it doesn't matter if it fails. */
+        madvise(pixels, (size + SDL_HUGE_PAGE_SIZE - 1) & ~(size_t)(SDL_HUGE_PAGE_SIZE - 1), MADV_HUGEPAGE);
+    }
+#endif
+    return pixels;
+}
+
+static void FreePool(SDL_SurfacePool *pool)
+{
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->idle);
+    SDL_free(pool);
+}
+
+static void *AcquirePoolPixels(SDL_SurfacePool *pool, size_t size)
+{
+    void *pixels = NULL;
+    int i;
+
+    SDL_LockMutex(pool->lock);
+    for (i = pool->num_idle - 1; i >= 0; --i) {
+        if (pool->idle[i].size == size) {
+            pixels = pool->idle[i].pixels;
+            pool->idle[i] = pool->idle[--pool->num_idle];
+            pool->idle_bytes -= size;
+            break;
+        }
+    }
+    ++pool->refcount;
+    SDL_UnlockMutex(pool->lock);
+
+    if (!pixels) {
+        pixels = AllocPoolPixels(pool, size);
+        if (!pixels) {
+            SDL_LockMutex(pool->lock);
+            --pool->refcount;
+            SDL_UnlockMutex(pool->lock);
+        }
+    }
+    return pixels;
+}
+
+static void ReleasePoolPixels(SDL_SurfacePool *pool, void *pixels, size_t size)
+{
+    SDL_bool destroy;
+
+    SDL_LockMutex(pool->lock);
+    if (size <= pool->max_bytes - pool->idle_bytes) {
+        if (pool->num_idle == pool->max_idle) {
+            const int max_idle = pool->max_idle ? pool->max_idle * 2 : 16;
+            SDL_PooledPixels *idle = (SDL_PooledPixels *)SDL_realloc(pool->idle, max_idle * sizeof(*idle));
+            if (idle) {
+                pool->idle = idle;
+                pool->max_idle = max_idle;
+            }
+        }
+        if (pool->num_idle < pool->max_idle) {
+            pool->idle[pool->num_idle].pixels = pixels;
+            pool->idle[pool->num_idle].size = size;
+            ++pool->num_idle;
+            pool->idle_bytes += size;
+            pixels = NULL;
+        }
+    }
+    destroy = (--pool->refcount == 0);
+    SDL_UnlockMutex(pool->lock);
+
+    SDL_aligned_free(pixels);
+    if (destroy) {
+        FreePool(pool);
+    }
+}
+
+SDL_SurfacePool *SDL_CreateSurfacePool(SDL_PropertiesID props)
+{
+    const Sint64 alignment = SDL_GetNumberProperty(props, "alignment", (Sint64)SDL_SIMDGetAlignment());
+    const Sint64 max_bytes = SDL_GetNumberProperty(props, "max_bytes", 64 * 1024 * 1024);
+    SDL_SurfacePool *pool;
+
+    if (alignment <= 0 || alignment > SDL_MAX_SINT32 || (alignment & (alignment - 1)) != 0) {
+        SDL_InvalidParamError("alignment");
+        return NULL;
+    }
+    if (max_bytes < 0) {
+        SDL_InvalidParamError("max_bytes");
+        return NULL;
+    }
+
+    pool = (SDL_SurfacePool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->lock = SDL_CreateMutex();
+    if (!pool->lock) {
+        SDL_free(pool);
+        return NULL;
+    }
+    pool->alignment = (size_t)alignment;
+    pool->huge_pages = SDL_GetBooleanProperty(props, "huge_pages", SDL_FALSE);
+    pool->clear = SDL_GetBooleanProperty(props, "clear", SDL_TRUE);
+    pool->max_bytes = (size_t)SDL_min((Uint64)max_bytes, SDL_SIZE_MAX);
+    pool->refcount = 1;
+    return pool;
+}
+
+void SDL_DestroySurfacePool(SDL_SurfacePool *pool)
+{
+    SDL_bool destroy;
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    for (i = 0; i < pool->num_idle; ++i) {
+        SDL_aligned_free(pool->idle[i].pixels);
+    }
+    pool->num_idle = 0;
+    pool->idle_bytes = 0;
+    /* Pixels released after this are freed */
+    pool->max_bytes = 0;
+    destroy = (--pool->refcount == 0);
+    SDL_UnlockMutex(pool->lock);
+
+    if (destroy) {
+        FreePool(pool);
+    }
+}
+
+void SDL_FreeSurfacePixels(SDL_Surface *surface)
+{
+    if (surface->flags & SDL_PREALLOC) {
+        /* Don't free */
+    } else if (surface->pool) {
+        /* Give the pixels back to the pool they came from */
+        size_t size;
+
+        if (SDL_CalculateSize(surface->format->format, surface->w, surface->h, &size, NULL, SDL_FALSE) == 0) {
+            ReleasePoolPixels(surface->pool, surface->pixels, size);
+        } else {
+            ReleasePoolPixels(surface->pool, surface->pixels, SDL_SIZE_MAX);
+        }
+        surface->pool = NULL;
+    } else if (surface->flags & SDL_SIMD_ALIGNED) {
+        /* Free aligned */
+        SDL_aligned_free(surface->pixels);
+    } else {
+        /* Normal */
+        SDL_free(surface->pixels);
+    }
+    surface->flags &= ~SDL_SIMD_ALIGNED;
+    surface->pixels = NULL;
+}
+
+static SDL_Surface *SDL_CreateSurfaceInternal(int width, int height, Uint32 format, SDL_SurfacePool *pool);
+
 /*
  * Create an empty RGB surface of the appropriate depth using the given
  * enum SDL_PIXELFORMAT_* format
  */
 SDL_Surface *SDL_CreateSurface(int width, int height, Uint32 format)
+{
+    return SDL_CreateSurfaceInternal(width, height, format, NULL);
+}
+
+SDL_Surface *SDL_CreateSurfaceFromPool(SDL_SurfacePool *pool, int width, int height, Uint32 format)
+{
+    if (!pool) {
+        SDL_InvalidParamError("pool");
+        return NULL;
+    }
+    return SDL_CreateSurfaceInternal(width, height, format, pool);
+}
+
+static SDL_Surface *SDL_CreateSurfaceInternal(int width, int height, Uint32 format, SDL_SurfacePool *pool)
 {
     size_t pitch, size;
     SDL_Surface *surface;
@@ -179,15 +395,29 @@ SDL_Surface *SDL_CreateSurface(int width, int height, Uint32 format)
 
     /* Get the pixels */
     if (surface->w && surface->h) {
-        surface->pixels = SDL_aligned_alloc(SDL_SIMDGetAlignment(), size);
-        if (!surface->pixels) {
-            SDL_DestroySurface(surface);
-            SDL_OutOfMemory();
-            return NULL;
+        if (pool) {
+            surface->pixels = AcquirePoolPixels(pool, size);
+            if (!surface->pixels) {
+                SDL_DestroySurface(surface);
+                return NULL;
+            }
+            surface->pool = pool;
+            if (pool->alignment >= SDL_SIMDGetAlignment()) {
+                surface->flags |= SDL_SIMD_ALIGNED;
+            }
+        } else {
+            surface->pixels = SDL_aligned_alloc(SDL_SIMDGetAlignment(), size);
+            if (!surface->pixels) {
+                SDL_DestroySurface(surface);
+                SDL_OutOfMemory();
+                return NULL;
+            }
+            surface->flags |= SDL_SIMD_ALIGNED;
+        }
+        if (!pool || pool->clear) {
+            /* This is important for bitmaps */
+            SDL_memset(surface->pixels, 0, size);
         }
-        surface->flags |= SDL_SIMD_ALIGNED;
-        /* This is important for bitmaps */
-        SDL_memset(surface->pixels, 0, size);
     }
 
     /* Allocate an empty mapping */
@@ -330,6 +560,15 @@ int SDL_SetSurfaceColorKey(SDL_Surface *surface, int flag, Uint32 key)
     }
 
     flags = surface->map->info.flags;
+#if SDL_HAVE_RLE
+    /* A colorkey encoding is only valid for the key it was made with,
+       so decode it while the old key is still set */
+    if ((surface->flags & SDL_RLEACCEL) && (flags & SDL_COPY_RLE_COLORKEY) &&
+        (!flag || key != surface->map->info.colorkey)) {
+        SDL_UnRLESurface(surface, 1);
+        SDL_InvalidateMap(surface->map);
+    }
+#endif
     if (flag) {
         surface->map->info.flags |= SDL_COPY_COLORKEY;
         surface->map->info.colorkey = key;
@@ -372,11 +611,89 @@ int SDL_GetSurfaceColorKey(SDL_Surface *surface, Uint32 *key)
     return 0;
 }
 
-/* This is a fairly slow function to switch from colorkey to alpha
+/* Clears the alpha of the pixels where (pixel & cmpmask) == ckey, returning the
+   number of pixels done, the caller finishes the row */
+typedef int (*SDL_ColorkeyToAlphaRow32Func)(Uint32 *row, int width, Uint32 cmpmask, Uint32 ckey, Uint32 amask);
+typedef int (*SDL_ColorkeyToAlphaRow16Func)(Uint16 *row, int width, Uint16 cmpmask, Uint16 ckey, Uint16 amask);
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_ColorkeyToAlphaRow32_SSE2(Uint32 *row, int width, Uint32 cmpmask, Uint32 ckey, Uint32 amask)
+{
+    const __m128i vcmpmask = _mm_set1_epi32((int)cmpmask);
+    const __m128i vckey = _mm_set1_epi32((int)ckey);
+    const __m128i vamask = _mm_set1_epi32((int)amask);
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(row + x));
+        const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(pixels, vcmpmask), vckey);
+
+        _mm_storeu_si128((__m128i *)(row + x), _mm_andnot_si128(_mm_and_si128(keyed, vamask), pixels));
+    }
+    return count;
+}
+
+static int SDL_TARGETING("sse2") SDL_ColorkeyToAlphaRow16_SSE2(Uint16 *row, int width, Uint16 cmpmask, Uint16 ckey, Uint16 amask)
+{
+    const __m128i vcmpmask = _mm_set1_epi16((short)cmpmask);
+    const __m128i vckey = _mm_set1_epi16((short)ckey);
+    const __m128i vamask = _mm_set1_epi16((short)amask);
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(row + x));
+        const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(pixels, vcmpmask), vckey);
+
+        _mm_storeu_si128((__m128i *)(row + x), _mm_andnot_si128(_mm_and_si128(keyed, vamask), pixels));
+    }
+    return count;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_ColorkeyToAlphaRow32_NEON(Uint32 *row, int width, Uint32 cmpmask, Uint32 ckey, Uint32 amask)
+{
+    const uint32x4_t vcmpmask = vdupq_n_u32(cmpmask);
+    const uint32x4_t vckey = vdupq_n_u32(ckey);
+    const uint32x4_t vamask = vdupq_n_u32(amask);
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const uint32x4_t pixels = vld1q_u32(row + x);
+        const uint32x4_t keyed = vceqq_u32(vandq_u32(pixels, vcmpmask), vckey);
+
+        vst1q_u32(row + x, vbicq_u32(pixels, vandq_u32(keyed, vamask)));
+    }
+    return count;
+}
+
+static int SDL_ColorkeyToAlphaRow16_NEON(Uint16 *row, int width, Uint16 cmpmask, Uint16 ckey, Uint16 amask)
+{
+    const uint16x8_t vcmpmask = vdupq_n_u16(cmpmask);
+    const uint16x8_t vckey = vdupq_n_u16(ckey);
+    const uint16x8_t vamask = vdupq_n_u16(amask);
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const uint16x8_t pixels = vld1q_u16(row + x);
+        const uint16x8_t keyed = vceqq_u16(vandq_u16(pixels, vcmpmask), vckey);
+
+        vst1q_u16(row + x, vbicq_u16(pixels, vandq_u16(keyed, vamask)));
+    }
+    return count;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Switches from colorkey to alpha
    NB: it doesn't handle bpp 1 or 3, because they have no alpha channel */
 static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alpha)
 {
     int x, y, bpp;
+    Uint32 amask, cmpmask, ckey;
 
     if (!surface) {
         return;
@@ -388,72 +705,59 @@ static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alp
     }
 
     bpp = surface->format->BytesPerPixel;
+    amask = surface->format->Amask;
+
+    /* Ignore, or not, alpha in colorkey comparison */
+    cmpmask = ignore_alpha ? ~amask : ~0u;
+    ckey = surface->map->info.colorkey & cmpmask;
 
     SDL_LockSurface(surface);
 
     if (bpp == 2) {
-        Uint16 *row, *spot;
-        Uint16 ckey = (Uint16)surface->map->info.colorkey;
-        Uint16 mask = (Uint16)(~surface->format->Amask);
-
-        /* Ignore, or not, alpha in colorkey comparison */
-        if (ignore_alpha) {
-            ckey &= mask;
-            row = (Uint16 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if ((*spot & mask) == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 2;
-            }
-        } else {
-            row = (Uint16 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if (*spot == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
+        SDL_ColorkeyToAlphaRow16Func row_func = NULL;
+        Uint16 *row = (Uint16 *)surface->pixels;
+
+#ifdef SDL_SSE2_INTRINSICS
+        if (!row_func && SDL_HasSSE2()) {
+            row_func = SDL_ColorkeyToAlphaRow16_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!row_func && SDL_HasNEON()) {
+            row_func = SDL_ColorkeyToAlphaRow16_NEON;
+        }
+#endif
+        for (y = surface->h; y--;) {
+            x = row_func ? row_func(row, surface->w, (Uint16)cmpmask, (Uint16)ckey, (Uint16)amask) : 0;
+            for (; x < surface->w; ++x) {
+                if ((row[x] & cmpmask) == ckey) {
+                    row[x] &= ~amask;
                 }
-                row += surface->pitch / 2;
             }
+            row += surface->pitch / 2;
         }
     } else if (bpp == 4) {
-        Uint32 *row, *spot;
-        Uint32 ckey = surface->map->info.colorkey;
-        Uint32 mask = ~surface->format->Amask;
-
-        /* Ignore, or not, alpha in colorkey comparison */
-        if (ignore_alpha) {
-            ckey &= mask;
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if ((*spot & mask) == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 4;
-            }
-        } else {
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if (*spot == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
+        SDL_ColorkeyToAlphaRow32Func row_func = NULL;
+        Uint32 *row = (Uint32 *)surface->pixels;
+
+#ifdef SDL_SSE2_INTRINSICS
+        if (!row_func && SDL_HasSSE2()) {
+            row_func = SDL_ColorkeyToAlphaRow32_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!row_func && SDL_HasNEON()) {
+            row_func = SDL_ColorkeyToAlphaRow32_NEON;
+        }
+#endif
+        for (y = surface->h; y--;) {
+            x = row_func ? row_func(row, surface->w, cmpmask, ckey, amask) : 0;
+            for (; x < surface->w; ++x) {
+                if ((row[x] & cmpmask) == ckey) {
+                    row[x] &= ~amask;
                 }
-                row += surface->pitch / 4;
             }
+            row += surface->pitch / 4;
         }
     }
 
@@ -654,8 +958,7 @@ int SDL_GetSurfaceClipRect(SDL_Surface *surface, SDL_Rect *rect)
  * you know exactly what you are doing, you can optimize your code
  * by calling the one(s) you need.
  */
-int SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
-                             SDL_Surface *dst, const SDL_Rect *dstrect)
+static int SDL_ValidateBlitMap(SDL_Surface *src, SDL_Surface *dst)
 {
     /* Check to make sure the blit mapping is valid */
     if ((src->map->dst != dst) ||
@@ -672,30 +975,24 @@ int SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
         /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
         /*              dst->map->info.flags, src->map->blit); */
     }
-    return src->map->blit(src, srcrect, dst, dstrect);
+    return 0;
 }
 
-int SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect,
-                  SDL_Surface *dst, SDL_Rect *dstrect)
+int SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
+                             SDL_Surface *dst, const SDL_Rect *dstrect)
 {
-    SDL_Rect fulldst;
-    int srcx, srcy, w, h;
-
-    /* Make sure the surfaces aren't locked */
-    if (!src || !dst) {
-        return SDL_InvalidParamError("SDL_BlitSurface(): src/dst");
-    }
-    if (src->locked || dst->locked) {
-        return SDL_SetError("Surfaces must not be locked during blit");
+    if (SDL_ValidateBlitMap(src, dst) < 0) {
+        return -1;
     }
+    return src->map->blit(src, srcrect, dst, dstrect);
+}
 
-    /* If the destination rectangle is NULL, use the entire dest surface */
-    if (!dstrect) {
-        fulldst.x = fulldst.y = 0;
-        fulldst.w = dst->w;
-        fulldst.h = dst->h;
-        dstrect = &fulldst;
-    }
+/* Clips a blit against both surfaces, like SDL_BlitSurface() documents;
+   dstrect is updated and the clipped source rectangle is stored in final_srcrect */
+static SDL_bool SDL_ClipBlitRects(SDL_Surface *src, const SDL_Rect *srcrect,
+                                  SDL_Surface *dst, SDL_Rect *dstrect, SDL_Rect *final_srcrect)
+{
+    int srcx, srcy, w, h;
 
     /* clip the source rectangle to the source surface */
     if (srcrect) {
@@ -759,21 +1056,88 @@ int SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect,
         }
     }
 
+    if (w > 0 && h > 0) {
+        final_srcrect->x = srcx;
+        final_srcrect->y = srcy;
+        final_srcrect->w = dstrect->w = w;
+        final_srcrect->h = dstrect->h = h;
+        return SDL_TRUE;
+    }
+    dstrect->w = dstrect->h = 0;
+    return SDL_FALSE;
+}
+
+int SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect,
+                  SDL_Surface *dst, SDL_Rect *dstrect)
+{
+    SDL_Rect fulldst;
+    SDL_Rect sr;
+
+    /* Make sure the surfaces aren't locked */
+    if (!src || !dst) {
+        return SDL_InvalidParamError("SDL_BlitSurface(): src/dst");
+    }
+    if (src->locked || dst->locked) {
+        return SDL_SetError("Surfaces must not be locked during blit");
+    }
+
+    /* If the destination rectangle is NULL, use the entire dest surface */
+    if (!dstrect) {
+        fulldst.x = fulldst.y = 0;
+        fulldst.w = dst->w;
+        fulldst.h = dst->h;
+        dstrect = &fulldst;
+    }
+
     /* Switch back to a fast blit if we were previously stretching */
     if (src->map->info.flags & SDL_COPY_NEAREST) {
         src->map->info.flags &= ~SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
     }
 
-    if (w > 0 && h > 0) {
-        SDL_Rect sr;
-        sr.x = srcx;
-        sr.y = srcy;
-        sr.w = dstrect->w = w;
-        sr.h = dstrect->h = h;
+    if (SDL_ClipBlitRects(src, srcrect, dst, dstrect, &sr)) {
         return SDL_BlitSurfaceUnchecked(src, &sr, dst, dstrect);
     }
-    dstrect->w = dstrect->h = 0;
+    return 0;
+}
+
+int SDL_BlitSurfaces(SDL_Surface *src, const SDL_Rect *srcrects,
+                     SDL_Surface *dst, SDL_Rect *dstrects, int count)
+{
+    SDL_Rect sr;
+    int i;
+
+    if (!src || !dst) {
+        return SDL_InvalidParamError("SDL_BlitSurfaces(): src/dst");
+    }
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if (src->locked || dst->locked) {
+        return SDL_SetError("Surfaces must not be locked during blit");
+    }
+
+    /* Switch back to a fast blit if we were previously stretching */
+    if (src->map->info.flags & SDL_COPY_NEAREST) {
+        src->map->info.flags &= ~SDL_COPY_NEAREST;
+        SDL_InvalidateMap(src->map);
+    }
+
+    /* Resolve the blit once, the rectangles all share it */
+    if (count > 0 && SDL_ValidateBlitMap(src, dst) < 0) {
+        return -1;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (SDL_ClipBlitRects(src, srcrects ? &srcrects[i] : NULL, dst, &dstrects[i], &sr)) {
+            if (src->map->blit(src, &sr, dst, &dstrects[i]) < 0) {
+                return -1;
+            }
+        }
+    }
     return 0;
 }
 
@@ -783,6 +1147,12 @@ int SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect,
     return SDL_PrivateBlitSurfaceScaled(src, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
 }
 
+int SDL_BlitSurfaceScaledWithMode(SDL_Surface *src, const SDL_Rect *srcrect,
+                                  SDL_Surface *dst, SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    return SDL_PrivateBlitSurfaceScaled(src, srcrect, dst, dstrect, scaleMode);
+}
+
 int SDL_PrivateBlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect,
                                SDL_Surface *dst, SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -951,6 +1321,33 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
     return SDL_PrivateBlitSurfaceUncheckedScaled(src, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
 }
 
+/* Linear and filtered scaled blits that need a conversion or blending are
+   scaled into a band of about this many bytes at a time, which is then
+   blitted to the destination, instead of going through a full size copy */
+#define SDL_STRETCH_BAND_BYTES (128 * 1024)
+
+typedef struct
+{
+    SDL_Surface *dst;
+    const SDL_Rect *dstrect;
+} SDL_StretchBandData;
+
+static int SDL_BlitStretchBand(void *userdata, SDL_Surface *band, int y, int h)
+{
+    SDL_StretchBandData *data = (SDL_StretchBandData *)userdata;
+    SDL_Rect srcrect, dstrect;
+
+    srcrect.x = 0;
+    srcrect.y = 0;
+    srcrect.w = data->dstrect->w;
+    srcrect.h = h;
+    dstrect.x = data->dstrect->x;
+    dstrect.y = data->dstrect->y + y;
+    dstrect.w = data->dstrect->w;
+    dstrect.h = h;
+    return SDL_BlitSurfaceUnchecked(band, &srcrect, data->dst, &dstrect);
+}
+
 int SDL_PrivateBlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
                                           SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -983,7 +1380,7 @@ int SDL_PrivateBlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcr
             src->format->BytesPerPixel == 4 &&
             src->format->format != SDL_PIXELFORMAT_ARGB2101010) {
             /* fast path */
-            return SDL_SoftStretchLinear(src, srcrect, dst, dstrect);
+            return SDL_PrivateSoftStretch(src, srcrect, dst, dstrect, scaleMode);
         } else {
             /* Use intermediate surface(s) */
             SDL_Surface *tmp1 = NULL;
@@ -1010,15 +1407,26 @@ int SDL_PrivateBlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcr
                 int fmt;
                 tmprect.x = 0;
                 tmprect.y = 0;
-                tmprect.w = src->w;
-                tmprect.h = src->h;
+                tmprect.w = srcrect->w;
+                tmprect.h = srcrect->h;
                 if (dst->format->BytesPerPixel == 4 && dst->format->format != SDL_PIXELFORMAT_ARGB2101010) {
                     fmt = dst->format->format;
                 } else {
                     fmt = SDL_PIXELFORMAT_ARGB8888;
                 }
-                tmp1 = SDL_CreateSurface(src->w, src->h, fmt);
+                tmp1 = SDL_CreateSurface(srcrect->w, srcrect->h, fmt);
+                if (!tmp1) {
+                    return -1;
+                }
+
+                /* The modulation and blending are applied by the final blit, so this is a plain copy */
+                SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                SDL_SetSurfaceAlphaMod(src, 255);
+                SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
                 SDL_BlitSurfaceUnchecked(src, srcrect, tmp1, &tmprect);
+                SDL_SetSurfaceColorMod(src, r, g, b);
+                SDL_SetSurfaceAlphaMod(src, alpha);
+                SDL_SetSurfaceBlendMode(src, blendMode);
 
                 srcrect2.x = 0;
                 srcrect2.y = 0;
@@ -1029,24 +1437,26 @@ int SDL_PrivateBlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcr
                 src = tmp1;
             }
 
-            /* Intermediate scaling */
+            /* Intermediate scaling, streamed through a band of rows */
             if (is_complex_copy_flags || src->format->format != dst->format->format) {
-                SDL_Rect tmprect;
-                SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format->format);
-                SDL_SoftStretchLinear(src, &srcrect2, tmp2, NULL);
-
-                SDL_SetSurfaceColorMod(tmp2, r, g, b);
-                SDL_SetSurfaceAlphaMod(tmp2, alpha);
-                SDL_SetSurfaceBlendMode(tmp2, blendMode);
-
-                tmprect.x = 0;
-                tmprect.y = 0;
-                tmprect.w = dstrect->w;
-                tmprect.h = dstrect->h;
-                ret = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
-                SDL_DestroySurface(tmp2);
+                SDL_StretchBandData data;
+                int band_h = SDL_clamp(SDL_STRETCH_BAND_BYTES / (dstrect->w * 4), 1, dstrect->h);
+                SDL_Surface *band = SDL_CreateSurface(dstrect->w, band_h, src->format->format);
+
+                if (band) {
+                    SDL_SetSurfaceColorMod(band, r, g, b);
+                    SDL_SetSurfaceAlphaMod(band, alpha);
+                    SDL_SetSurfaceBlendMode(band, blendMode);
+
+                    data.dst = dst;
+                    data.dstrect = dstrect;
+                    ret = SDL_PrivateSoftStretchBands(src, &srcrect2, dstrect->w, dstrect->h, band, scaleMode, SDL_BlitStretchBand, &data);
+                    SDL_DestroySurface(band);
+                } else {
+                    ret = -1;
+                }
             } else {
-                ret = SDL_SoftStretchLinear(src, &srcrect2, dst, dstrect);
+                ret = SDL_PrivateSoftStretch(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1489,23 +1899,320 @@ int SDL_ConvertPixels(int width, int height,
 }
 
 /*
- * Premultiply the alpha on a block of pixels
- *
- * This is currently only implemented for SDL_PIXELFORMAT_ARGB8888
+ * Premultiplied alpha conversion
  *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+ * These are implemented for the 32-bit formats with an 8-bit alpha channel,
+ * where the alpha is in either the top or the bottom byte of the pixel.
+ * The vectorized rows give exactly the same results as the scalar ones and
+ * return the number of pixels they converted, leaving the rest of the row
+ * to the scalar code.
  */
-int SDL_PremultiplyAlpha(int width, int height,
-                         Uint32 src_format, const void *src, int src_pitch,
-                         Uint32 dst_format, void *dst, int dst_pitch)
+static SDL_bool SDL_GetPremultiplyAlphaShift(Uint32 format, int *ashift)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        *ashift = 24;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        *ashift = 0;
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static void SDL_PremultiplyAlphaRow(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    Uint32 pixel, A, result;
+    int shift;
+
+    while (width--) {
+        pixel = *src++;
+        A = (pixel >> ashift) & 0xFF;
+        result = pixel & (0xFFu << ashift);
+        for (shift = 0; shift < 32; shift += 8) {
+            if (shift != ashift) {
+                result |= ((((pixel >> shift) & 0xFF) * A) / 255) << shift;
+            }
+        }
+        *dst++ = result;
+    }
+}
+
+static void SDL_UnpremultiplyAlphaRow(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    Uint32 pixel, A, C, result;
+    int shift;
+
+    while (width--) {
+        pixel = *src++;
+        A = (pixel >> ashift) & 0xFF;
+        result = pixel & (0xFFu << ashift);
+        if (A) {
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != ashift) {
+                    C = ((((pixel >> shift) & 0xFF) * 255) + (A / 2)) / A;
+                    result |= SDL_min(C, 255) << shift;
+                }
+            }
+        }
+        *dst++ = result;
+    }
+}
+
+typedef int (*SDL_PremultiplyAlphaRowFunc)(const Uint32 *src, Uint32 *dst, int width, int ashift);
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+
+#ifdef SDL_SSE2_INTRINSICS
+/* x / 255 for x <= 255 * 255 */
+#define PREMULTIPLY_DIV255_SSE2(x) _mm_srli_epi16(_mm_mulhi_epu16(x, div255), 7)
+
+static int SDL_TARGETING("sse2") SDL_PremultiplyAlphaRow_SSE2(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div255 = _mm_set1_epi16((short)0x8081);
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << ashift));
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        __m128i alo, ahi;
+
+        if (ashift) {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        } else {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+        }
+        lo = PREMULTIPLY_DIV255_SSE2(_mm_mullo_epi16(lo, alo));
+        hi = PREMULTIPLY_DIV255_SSE2(_mm_mullo_epi16(hi, ahi));
+        _mm_storeu_si128((__m128i *)(dst + x),
+                         _mm_or_si128(_mm_andnot_si128(amask, _mm_packus_epi16(lo, hi)), _mm_and_si128(amask, pixels)));
+    }
+    return count;
+}
+
+/* (c * 255 + a / 2) / a, clamped to 255, for one pixel in 32-bit lanes */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_UnpremultiplyPixel_SSE2(__m128i pixel, int ashift)
+{
+    const __m128 c = _mm_cvtepi32_ps(pixel);
+    const __m128 a = _mm_cvtepi32_ps(ashift ? _mm_shuffle_epi32(pixel, _MM_SHUFFLE(3, 3, 3, 3)) : _mm_shuffle_epi32(pixel, _MM_SHUFFLE(0, 0, 0, 0)));
+    __m128 q;
+
+    q = _mm_div_ps(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), _mm_mul_ps(a, _mm_set1_ps(0.5f))), _mm_max_ps(a, _mm_set1_ps(1.0f)));
+    q = _mm_and_ps(_mm_min_ps(q, _mm_set1_ps(255.0f)), _mm_cmpneq_ps(a, _mm_setzero_ps()));
+    return _mm_cvttps_epi32(q);
+}
+
+static int SDL_TARGETING("sse2") SDL_UnpremultiplyAlphaRow_SSE2(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << ashift));
+    const int count = width & ~3;
+    int x;
+
+    for (x = 0; x < count; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i p0 = SDL_UnpremultiplyPixel_SSE2(_mm_unpacklo_epi16(lo, zero), ashift);
+        const __m128i p1 = SDL_UnpremultiplyPixel_SSE2(_mm_unpackhi_epi16(lo, zero), ashift);
+        const __m128i p2 = SDL_UnpremultiplyPixel_SSE2(_mm_unpacklo_epi16(hi, zero), ashift);
+        const __m128i p3 = SDL_UnpremultiplyPixel_SSE2(_mm_unpackhi_epi16(hi, zero), ashift);
+        const __m128i result = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+
+        _mm_storeu_si128((__m128i *)(dst + x),
+                         _mm_or_si128(_mm_andnot_si128(amask, result), _mm_and_si128(amask, pixels)));
+    }
+    return count;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+#define PREMULTIPLY_DIV255_AVX2(x) _mm256_srli_epi16(_mm256_mulhi_epu16(x, div255), 7)
+
+/* The unpacks and packs work within 128-bit lanes, which keeps the pixels in order */
+static int SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow_AVX2(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i div255 = _mm256_set1_epi16((short)0x8081);
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << ashift));
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + x));
+        __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+        __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+        __m256i alo, ahi;
+
+        if (ashift) {
+            alo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            ahi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        } else {
+            alo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+            ahi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+        }
+        lo = PREMULTIPLY_DIV255_AVX2(_mm256_mullo_epi16(lo, alo));
+        hi = PREMULTIPLY_DIV255_AVX2(_mm256_mullo_epi16(hi, ahi));
+        _mm256_storeu_si256((__m256i *)(dst + x),
+                            _mm256_or_si256(_mm256_andnot_si256(amask, _mm256_packus_epi16(lo, hi)), _mm256_and_si256(amask, pixels)));
+    }
+    return count;
+}
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_UnpremultiplyPixels_AVX2(__m256i pixels, int ashift)
+{
+    const __m256 c = _mm256_cvtepi32_ps(pixels);
+    const __m256 a = _mm256_cvtepi32_ps(ashift ? _mm256_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 3)) : _mm256_shuffle_epi32(pixels, _MM_SHUFFLE(0, 0, 0, 0)));
+    __m256 q;
+
+    q = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(c, _mm256_set1_ps(255.0f)), _mm256_mul_ps(a, _mm256_set1_ps(0.5f))), _mm256_max_ps(a, _mm256_set1_ps(1.0f)));
+    q = _mm256_and_ps(_mm256_min_ps(q, _mm256_set1_ps(255.0f)), _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_OQ));
+    return _mm256_cvttps_epi32(q);
+}
+
+static int SDL_TARGETING("avx2") SDL_UnpremultiplyAlphaRow_AVX2(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << ashift));
+    const int count = width & ~7;
+    int x;
+
+    for (x = 0; x < count; x += 8) {
+        const __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + x));
+        const __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+        const __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+        const __m256i p0 = SDL_UnpremultiplyPixels_AVX2(_mm256_unpacklo_epi16(lo, zero), ashift);
+        const __m256i p1 = SDL_UnpremultiplyPixels_AVX2(_mm256_unpackhi_epi16(lo, zero), ashift);
+        const __m256i p2 = SDL_UnpremultiplyPixels_AVX2(_mm256_unpacklo_epi16(hi, zero), ashift);
+        const __m256i p3 = SDL_UnpremultiplyPixels_AVX2(_mm256_unpackhi_epi16(hi, zero), ashift);
+        const __m256i result = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+
+        _mm256_storeu_si256((__m256i *)(dst + x),
+                            _mm256_or_si256(_mm256_andnot_si256(amask, result), _mm256_and_si256(amask, pixels)));
+    }
+    return count;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* x / 255 for x <= 255 * 255, narrowed to bytes */
+static SDL_INLINE uint8x8_t SDL_PremultiplyDiv255_NEON(uint16x8_t x)
+{
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+static int SDL_PremultiplyAlphaRow_NEON(const Uint32 *src, Uint32 *dst, int width, int ashift)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    const int aindex = ashift / 8;
+    const int count = width & ~15;
+    int x, i;
+
+    for (x = 0; x < count; x += 16) {
+        uint8x16x4_t pixels = vld4q_u8((const uint8_t *)(src + x));
+        const uint8x16_t a = pixels.val[aindex];
+
+        for (i = 0; i < 4; ++i) {
+            if (i != aindex) {
+                pixels.val[i] = vcombine_u8(SDL_PremultiplyDiv255_NEON(vmull_u8(vget_low_u8(pixels.val[i]), vget_low_u8(a))),
+                                            SDL_PremultiplyDiv255_NEON(vmull_u8(vget_high_u8(pixels.val[i]), vget_high_u8(a))));
+            }
+        }
+        vst4q_u8((uint8_t *)(dst + x), pixels);
+    }
+    return count;
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+/* Needs the vector division that's only available on 64-bit ARM */
+#define SDL_UNPREMULTIPLY_NEON
+
+static SDL_INLINE uint32x4_t SDL_UnpremultiplyChannel_NEON(uint16x4_t c, uint16x4_t a)
+{
+    const float32x4_t fc = vcvtq_f32_u32(vmovl_u16(c));
+    const float32x4_t fa = vcvtq_f32_u32(vmovl_u16(a));
+    float32x4_t q;
+
+    q = vdivq_f32(vaddq_f32(vmulq_n_f32(fc, 255.0f), vmulq_n_f32(fa, 0.5f)), vmaxq_f32(fa, vdupq_n_f32(1.0f)));
+    return vcvtq_u32_f32(vminq_f32(q, vdupq_n_f32(255.0f)));
+}
+
+static int SDL_UnpremultiplyAlphaRow_NEON(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const int aindex = ashift / 8;
+    const int count = width & ~15;
+    int x, i;
+
+    for (x = 0; x < count; x += 16) {
+        uint8x16x4_t pixels = vld4q_u8((const uint8_t *)(src + x));
+        const uint8x16_t a = pixels.val[aindex];
+        const uint16x8_t alo = vmovl_u8(vget_low_u8(a));
+        const uint16x8_t ahi = vmovl_u8(vget_high_u8(a));
+
+        for (i = 0; i < 4; ++i) {
+            if (i != aindex) {
+                const uint16x8_t clo = vmovl_u8(vget_low_u8(pixels.val[i]));
+                const uint16x8_t chi = vmovl_u8(vget_high_u8(pixels.val[i]));
+                const uint16x8_t qlo = vcombine_u16(vmovn_u32(SDL_UnpremultiplyChannel_NEON(vget_low_u16(clo), vget_low_u16(alo))),
+                                                    vmovn_u32(SDL_UnpremultiplyChannel_NEON(vget_high_u16(clo), vget_high_u16(alo))));
+                const uint16x8_t qhi = vcombine_u16(vmovn_u32(SDL_UnpremultiplyChannel_NEON(vget_low_u16(chi), vget_low_u16(ahi))),
+                                                    vmovn_u32(SDL_UnpremultiplyChannel_NEON(vget_high_u16(chi), vget_high_u16(ahi))));
+
+                /* Transparent pixels have no color to recover */
+                pixels.val[i] = vandq_u8(vcombine_u8(vmovn_u16(qlo), vmovn_u16(qhi)), vtstq_u8(a, a));
+            }
+        }
+        vst4q_u8((uint8_t *)(dst + x), pixels);
+    }
+    return count;
+}
+#endif /* __aarch64__ || _M_ARM64 */
+#endif /* SDL_NEON_INTRINSICS */
+
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+
+static SDL_PremultiplyAlphaRowFunc SDL_GetPremultiplyAlphaRowFunc(SDL_bool unpremultiply)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return unpremultiply ? SDL_UnpremultiplyAlphaRow_AVX2 : SDL_PremultiplyAlphaRow_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return unpremultiply ? SDL_UnpremultiplyAlphaRow_SSE2 : SDL_PremultiplyAlphaRow_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+#ifdef SDL_UNPREMULTIPLY_NEON
+        return unpremultiply ? SDL_UnpremultiplyAlphaRow_NEON : SDL_PremultiplyAlphaRow_NEON;
+#else
+        return unpremultiply ? NULL : SDL_PremultiplyAlphaRow_NEON;
+#endif
+    }
+#endif
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+    (void)unpremultiply;
+    return NULL;
+}
+
+static int SDL_ConvertAlpha(int width, int height,
+                            Uint32 src_format, const void *src, int src_pitch,
+                            Uint32 dst_format, void *dst, int dst_pitch,
+                            SDL_bool unpremultiply)
+{
+    SDL_PremultiplyAlphaRowFunc vector_row;
+    int ashift, done;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1519,30 +2226,32 @@ int SDL_PremultiplyAlpha(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (src_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (!SDL_GetPremultiplyAlphaShift(src_format, &ashift)) {
         return SDL_InvalidParamError("src_format");
     }
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (!SDL_GetPremultiplyAlphaShift(dst_format, &ashift)) {
         return SDL_InvalidParamError("dst_format");
     }
 
+    /* Reorder the channels first and then convert the destination in place */
+    if (src_format != dst_format) {
+        if (SDL_ConvertPixels(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch) < 0) {
+            return -1;
+        }
+        src = dst;
+        src_pitch = dst_pitch;
+    }
+
+    vector_row = SDL_GetPremultiplyAlphaRowFunc(unpremultiply);
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
+
+        done = vector_row ? vector_row(src_px, dst_px, width, ashift) : 0;
+        if (unpremultiply) {
+            SDL_UnpremultiplyAlphaRow(src_px + done, dst_px + done, width - done, ashift);
+        } else {
+            SDL_PremultiplyAlphaRow(src_px + done, dst_px + done, width - done, ashift);
         }
         src = (const Uint8 *)src + src_pitch;
         dst = (Uint8 *)dst + dst_pitch;
@@ -1550,6 +2259,53 @@ int SDL_PremultiplyAlpha(int width, int height,
     return 0;
 }
 
+static int SDL_ConvertSurfaceAlpha(SDL_Surface *surface, SDL_bool unpremultiply)
+{
+    int ret;
+
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) < 0) {
+            return -1;
+        }
+    }
+    ret = SDL_ConvertAlpha(surface->w, surface->h,
+                           surface->format->format, surface->pixels, surface->pitch,
+                           surface->format->format, surface->pixels, surface->pitch,
+                           unpremultiply);
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+    return ret;
+}
+
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void *src, int src_pitch,
+                         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_FALSE);
+}
+
+int SDL_UnpremultiplyAlpha(int width, int height,
+                           Uint32 src_format, const void *src, int src_pitch,
+                           Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_TRUE);
+}
+
+int SDL_PremultiplySurfaceAlpha(SDL_Surface *surface)
+{
+    return SDL_ConvertSurfaceAlpha(surface, SDL_FALSE);
+}
+
+int SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface)
+{
+    return SDL_ConvertSurfaceAlpha(surface, SDL_TRUE);
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -1577,20 +2333,12 @@ void SDL_DestroySurface(SDL_Surface *surface)
         SDL_UnRLESurface(surface, 0);
     }
 #endif
+    SDL_FreeSurfacePixels(surface);
     if (surface->format) {
         SDL_SetSurfacePalette(surface, NULL);
         SDL_DestroyPixelFormat(surface->format);
         surface->format = NULL;
     }
-    if (surface->flags & SDL_PREALLOC) {
-        /* Don't free */
-    } else if (surface->flags & SDL_SIMD_ALIGNED) {
-        /* Free aligned */
-        SDL_aligned_free(surface->pixels);
-    } else {
-        /* Normal */
-        SDL_free(surface->pixels);
-    }
     if (surface->map) {
         SDL_FreeBlitMap(surface->map);
     }
@@ -65,6 +65,8 @@ struct SDL_Window
 
     float opacity;
 
+    SDL_bool variable_refresh_rate; /* The application asked for variable refresh rate */
+
     SDL_Surface *surface;
     SDL_bool surface_valid;
 
@@ -230,6 +232,7 @@ struct SDL_VideoDevice
     void (*OnWindowEnter)(SDL_VideoDevice *_this, SDL_Window *window);
     int (*FlashWindow)(SDL_VideoDevice *_this, SDL_Window *window, SDL_FlashOperation operation);
     int (*SetWindowFocusable)(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool focusable);
+    int (*SetWindowVariableRefreshRate)(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool enabled);
 
     /* * * */
     /*
@@ -469,6 +472,7 @@ extern void SDL_ResetFullscreenDisplayModes(SDL_VideoDisplay *display);
 extern void SDL_SetDesktopDisplayMode(SDL_VideoDisplay *display, const SDL_DisplayMode *mode);
 extern void SDL_SetCurrentDisplayMode(SDL_VideoDisplay *display, const SDL_DisplayMode *mode);
 extern void SDL_SetDisplayContentScale(SDL_VideoDisplay *display, float scale);
+extern void SDL_SetDisplayVariableRefreshRateInfo(SDL_DisplayID displayID, SDL_bool capable, const Uint8 *edid, size_t edid_length);
 extern SDL_VideoDisplay *SDL_GetVideoDisplay(SDL_DisplayID display);
 extern SDL_VideoDisplay *SDL_GetVideoDisplayForWindow(SDL_Window *window);
 extern int SDL_GetDisplayIndex(SDL_DisplayID displayID);
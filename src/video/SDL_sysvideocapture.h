@@ -23,8 +23,6 @@
 #ifndef SDL_sysvideocapture_h_
 #define SDL_sysvideocapture_h_
 
-#include "../SDL_list.h"
-
 /* The SDL video_capture driver */
 typedef struct SDL_VideoCaptureDevice SDL_VideoCaptureDevice;
 
@@ -49,12 +47,34 @@ struct SDL_VideoCaptureDevice
     SDL_Mutex *device_lock;
     SDL_Mutex *acquiring_lock;
 
+    /* Signaled (with device_lock held) when 'enabled' or 'shutdown' change */
+    SDL_Condition *state_cond;
+
     /* A thread to feed the video_capture device */
     SDL_Thread *thread;
     SDL_threadID threadid;
 
-    /* Queued buffers (if app not using callback). */
-    SDL_ListNode *buffer_queue;
+    /* Number of frames the backend can have in flight, set by the backend
+       before capture starts. This sizes the frame queue. */
+    int num_buffers;
+
+    /* Ring of frames waiting to be acquired, protected by device_lock */
+    SDL_VideoCaptureFrame *frame_queue;
+    int frame_queue_size;
+    int frame_queue_head;
+    int frame_queue_count;
+    SDL_bool drop_oldest;
+
+    /* Frame statistics, published in the device properties */
+    SDL_PropertiesID props;
+    Uint64 frames_captured;
+    Uint64 frames_dropped_driver;
+    Uint64 frames_dropped_queue;
+    Uint64 last_sequence;
+
+    /* Called from the capture thread each time a frame is queued */
+    SDL_VideoCaptureFrameCallback frame_callback;
+    void *frame_callback_userdata;
 
     /* * * */
     /* Data private to this driver */
@@ -74,8 +94,12 @@ extern int GetDeviceSpec(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureSpec *sp
 extern int StartCapture(SDL_VideoCaptureDevice *_this);
 extern int StopCapture(SDL_VideoCaptureDevice *_this);
 
+/* AcquireFrame() may block until a frame is ready. It returns 0 without a
+   frame once WakeupAcquireFrame() is called from another thread. */
 extern int AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame);
+extern void WakeupAcquireFrame(SDL_VideoCaptureDevice *_this);
 extern int ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame);
+extern SDL_PropertiesID GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame);
 
 extern int GetNumFormats(SDL_VideoCaptureDevice *_this);
 extern int GetFormat(SDL_VideoCaptureDevice *_this, int index, Uint32 *format);
@@ -32,6 +32,7 @@
 #include "../events/SDL_events_c.h"
 #include "../timer/SDL_timer_c.h"
 #include "SDL_video_capture_c.h"
+#include "../thread/SDL_thread_c.h"
 
 #ifdef SDL_VIDEO_OPENGL
 #include <SDL3/SDL_opengl.h>
@@ -191,6 +192,7 @@ typedef struct
     void *pixels;
     int pitch;
     int bytes_per_pixel;
+    SDL_bool mapped; /* pixels is the texture's own staging memory, see SDL_MapWindowTexture() */
 } SDL_WindowTextureData;
 
 static Uint32 SDL_DefaultGraphicsBackends(SDL_VideoDevice *_this)
@@ -218,10 +220,35 @@ static void SDL_CleanupWindowTextureData(void *userdata, void *value)
     if (data->renderer) {
         SDL_DestroyRenderer(data->renderer);
     }
-    SDL_free(data->pixels);
+    if (!data->mapped) {
+        SDL_free(data->pixels);
+    }
     SDL_free(data);
 }
 
+/* The OpenGL renderers keep a CPU copy of every streaming texture, and
+   locking any part of it hands out a pointer into that copy and uploads
+   just that part when it's unlocked. Using that memory as the window
+   surface saves copying the pixels into it on every update. */
+static SDL_bool SDL_MapWindowTexture(SDL_WindowTextureData *data, const SDL_RendererInfo *info)
+{
+    void *pixels;
+    int pitch;
+
+    if (SDL_strcmp(info->name, "opengl") != 0 && SDL_strcmp(info->name, "opengles2") != 0) {
+        return SDL_FALSE;
+    }
+    if (SDL_LockTexture(data->texture, NULL, &pixels, &pitch) < 0) {
+        return SDL_FALSE;
+    }
+    SDL_UnlockTexture(data->texture);
+
+    data->pixels = pixels;
+    data->pitch = pitch;
+    data->mapped = SDL_TRUE;
+    return SDL_TRUE;
+}
+
 static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, Uint32 *format, void **pixels, int *pitch)
 {
     SDL_RendererInfo info;
@@ -293,8 +320,11 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, U
         SDL_DestroyTexture(data->texture);
         data->texture = NULL;
     }
-    SDL_free(data->pixels);
+    if (!data->mapped) {
+        SDL_free(data->pixels);
+    }
     data->pixels = NULL;
+    data->mapped = SDL_FALSE;
 
     /* Find the first format with or without an alpha channel */
     *format = info.texture_formats[0];
@@ -319,7 +349,7 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, U
     data->bytes_per_pixel = SDL_BYTESPERPIXEL(*format);
     data->pitch = (((w * data->bytes_per_pixel) + 3) & ~3);
 
-    {
+    if (!SDL_MapWindowTexture(data, &info)) {
         /* Make static analysis happy about potential SDL_malloc(0) calls. */
         const size_t allocsize = (size_t)h * data->pitch;
         data->pixels = SDL_malloc((allocsize > 0) ? allocsize : 1);
@@ -338,6 +368,10 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, U
 }
 
 static SDL_VideoDevice *_this = NULL;
+
+/* Bumped each time the video subsystem is initialized, see SDL_GL_SetCurrent() */
+static Uint32 SDL_GL_current_generation = 0;
+
 static SDL_AtomicInt SDL_messagebox_count;
 
 static int SDL_UpdateWindowTexture(SDL_VideoDevice *unused, SDL_Window *window, const SDL_Rect *rects, int numrects)
@@ -356,11 +390,21 @@ static int SDL_UpdateWindowTexture(SDL_VideoDevice *unused, SDL_Window *window,
 
     /* Update a single rect that contains subrects for best DMA performance */
     if (SDL_GetSpanEnclosingRect(w, h, numrects, rects, &rect)) {
-        src = (void *)((Uint8 *)data->pixels +
-                       rect.y * data->pitch +
-                       rect.x * data->bytes_per_pixel);
-        if (SDL_UpdateTexture(data->texture, &rect, src, data->pitch) < 0) {
-            return -1;
+        if (data->mapped) {
+            /* The pixels are already in place, locking and unlocking uploads them */
+            int pitch;
+
+            if (SDL_LockTexture(data->texture, &rect, &src, &pitch) < 0) {
+                return -1;
+            }
+            SDL_UnlockTexture(data->texture);
+        } else {
+            src = (void *)((Uint8 *)data->pixels +
+                           rect.y * data->pitch +
+                           rect.x * data->bytes_per_pixel);
+            if (SDL_UpdateTexture(data->texture, &rect, src, data->pitch) < 0) {
+                return -1;
+            }
         }
 
         if (SDL_RenderTexture(data->renderer, data->texture, NULL, NULL) < 0) {
@@ -530,6 +574,7 @@ int SDL_VideoInit(const char *driver_name)
 
     _this->current_glwin_tls = SDL_CreateTLS();
     _this->current_glctx_tls = SDL_CreateTLS();
+    ++SDL_GL_current_generation;
 
     /* Initialize the video subsystem */
     if (_this->VideoInit(_this) < 0) {
@@ -840,6 +885,39 @@ SDL_PropertiesID SDL_GetDisplayProperties(SDL_DisplayID displayID)
     return display->props;
 }
 
+void SDL_SetDisplayVariableRefreshRateInfo(SDL_DisplayID displayID, SDL_bool capable, const Uint8 *edid, size_t edid_length)
+{
+    static const Uint8 edid_header[] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+    SDL_PropertiesID props = SDL_GetDisplayProperties(displayID);
+    int i;
+
+    if (!props) {
+        return;
+    }
+    SDL_SetBooleanProperty(props, "SDL.display.vrr_capable", capable);
+
+    if (!capable || !edid || edid_length < 128 || SDL_memcmp(edid, edid_header, sizeof(edid_header)) != 0) {
+        return;
+    }
+
+    /* Look for the Display Range Limits descriptor in the base EDID block */
+    for (i = 0; i < 4; ++i) {
+        const Uint8 *desc = &edid[54 + i * 18];
+
+        if (desc[0] == 0 && desc[1] == 0 && desc[3] == 0xFD) {
+            /* EDID 1.4 uses the flags byte to extend the rates past 255 Hz */
+            int min_rate = desc[5] + ((desc[4] & 0x01) ? 255 : 0);
+            int max_rate = desc[6] + ((desc[4] & 0x02) ? 255 : 0);
+
+            if (min_rate > 0 && max_rate > min_rate) {
+                SDL_SetFloatProperty(props, "SDL.display.vrr_min_refresh_rate", (float)min_rate);
+                SDL_SetFloatProperty(props, "SDL.display.vrr_max_refresh_rate", (float)max_rate);
+            }
+            break;
+        }
+    }
+}
+
 const char *SDL_GetDisplayName(SDL_DisplayID displayID)
 {
     SDL_VideoDisplay *display = SDL_GetVideoDisplay(displayID);
@@ -1111,6 +1189,22 @@ const SDL_DisplayMode **SDL_GetFullscreenDisplayModes(SDL_DisplayID displayID, i
     return modes;
 }
 
+/* Returns how far a display refresh rate is from showing content at the
+   given frame rate without judder. A display that refreshes at a multiple
+   of the content frame rate shows every frame for the same number of
+   refreshes, so it's as good a match as the frame rate itself. */
+static float SDL_GetRefreshRateDistance(float display_rate, float content_rate)
+{
+    float multiple;
+
+    if (content_rate <= 0.0f || display_rate <= content_rate) {
+        return SDL_fabsf(display_rate - content_rate);
+    }
+
+    multiple = SDL_roundf(display_rate / content_rate);
+    return SDL_fabsf(display_rate - multiple * content_rate) / multiple;
+}
+
 const SDL_DisplayMode *SDL_GetClosestFullscreenDisplayMode(SDL_DisplayID displayID, int w, int h, float refresh_rate, SDL_bool include_high_density_modes)
 {
     const SDL_DisplayMode **modes;
@@ -1157,7 +1251,7 @@ const SDL_DisplayMode *SDL_GetClosestFullscreenDisplayMode(SDL_DisplayID display
                 }
 
                 if (mode->w == closest->w && mode->h == closest->h &&
-                    SDL_fabsf(closest->refresh_rate - refresh_rate) < SDL_fabsf(mode->refresh_rate - refresh_rate)) {
+                    SDL_GetRefreshRateDistance(closest->refresh_rate, refresh_rate) < SDL_GetRefreshRateDistance(mode->refresh_rate, refresh_rate)) {
                     /* We already found a mode and the new mode is further from our
                      * refresh rate target */
                     continue;
@@ -2046,6 +2140,7 @@ SDL_Window *SDL_CreateWindowWithProperties(SDL_PropertiesID props)
     window->flags = ((flags & CREATE_FLAGS) | SDL_WINDOW_HIDDEN);
     window->display_scale = 1.0f;
     window->opacity = 1.0f;
+    window->variable_refresh_rate = SDL_GetBooleanProperty(props, "variable-refresh-rate", SDL_FALSE);
     window->next = _this->windows;
     window->is_destroying = SDL_FALSE;
     window->last_displayID = SDL_GetDisplayForWindow(window);
@@ -2070,6 +2165,11 @@ SDL_Window *SDL_CreateWindowWithProperties(SDL_PropertiesID props)
         return NULL;
     }
 
+    if (window->variable_refresh_rate && _this->SetWindowVariableRefreshRate) {
+        /* This is only a request, so it's fine if the display can't do it */
+        _this->SetWindowVariableRefreshRate(_this, window, SDL_TRUE);
+    }
+
     /* Clear minimized if not on windows, only windows handles it at create rather than FinishWindowCreation,
      * but it's important or window focus will get broken on windows!
      */
@@ -2986,6 +3086,18 @@ static SDL_Surface *SDL_CreateWindowFramebuffer(SDL_Window *window)
             }
         }
 #endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+        /* wl_shm buffers don't need a GPU context and skip the texture upload, unless a renderer was asked for. */
+        else if (!hint && (_this->CreateWindowFramebuffer) && (SDL_strcmp(_this->name, "wayland") == 0)) {
+            attempt_texture_framebuffer = SDL_FALSE;
+        }
+#endif
+#ifdef SDL_VIDEO_DRIVER_KMSDRM
+        /* Dumb buffers are scanned out directly, without a GPU composition pass. */
+        else if (!hint && (_this->CreateWindowFramebuffer) && (SDL_strcmp(_this->name, "KMSDRM") == 0)) {
+            attempt_texture_framebuffer = SDL_FALSE;
+        }
+#endif
 #if defined(__WIN32__) || defined(__WINGDK__) /* GDI BitBlt() is way faster than Direct3D dynamic textures right now. (!!! FIXME: is this still true?) */
         else if ((_this->CreateWindowFramebuffer) && (SDL_strcmp(_this->name, "windows") == 0)) {
             attempt_texture_framebuffer = SDL_FALSE;
@@ -3175,6 +3287,22 @@ int SDL_SetWindowFocusable(SDL_Window *window, SDL_bool focusable)
     return 0;
 }
 
+int SDL_SetWindowVariableRefreshRate(SDL_Window *window, SDL_bool enabled)
+{
+    CHECK_WINDOW_MAGIC(window, -1);
+
+    if (!_this->SetWindowVariableRefreshRate) {
+        return SDL_Unsupported();
+    }
+
+    enabled = (enabled != SDL_FALSE); /* normalize the flag. */
+    if (_this->SetWindowVariableRefreshRate(_this, window, enabled) < 0) {
+        return -1;
+    }
+    window->variable_refresh_rate = enabled;
+    return 0;
+}
+
 void SDL_UpdateWindowGrab(SDL_Window *window)
 {
     SDL_bool keyboard_grabbed, mouse_grabbed;
@@ -4373,6 +4501,61 @@ int SDL_GL_GetAttribute(SDL_GLattr attr, int *value)
 
 #define NOT_AN_OPENGL_WINDOW "The specified window isn't an OpenGL window"
 
+/* The current window and context are looked up on every SDL_GL_MakeCurrent()
+ * and by the GL renderers every time they're activated, so keep them in a
+ * real thread local variable when the compiler supports it instead of going
+ * through SDL_GetTLS(). The generation catches values left over from a
+ * previous video subsystem initialization.
+ */
+#ifdef SDL_THREAD_LOCAL
+typedef struct
+{
+    Uint32 generation;
+    SDL_Window *window;
+    SDL_GLContext context;
+} SDL_GLCurrentCache;
+
+static SDL_THREAD_LOCAL SDL_GLCurrentCache SDL_GL_current;
+#endif
+
+static SDL_INLINE SDL_Window *SDL_GL_GetCurrentWindowInternal(void)
+{
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_GL_current.generation != SDL_GL_current_generation) {
+        return NULL;
+    }
+    return SDL_GL_current.window;
+#else
+    return (SDL_Window *)SDL_GetTLS(_this->current_glwin_tls);
+#endif
+}
+
+static SDL_INLINE SDL_GLContext SDL_GL_GetCurrentContextInternal(void)
+{
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_GL_current.generation != SDL_GL_current_generation) {
+        return NULL;
+    }
+    return SDL_GL_current.context;
+#else
+    return (SDL_GLContext)SDL_GetTLS(_this->current_glctx_tls);
+#endif
+}
+
+static void SDL_GL_SetCurrent(SDL_Window *window, SDL_GLContext context)
+{
+    _this->current_glwin = window;
+    _this->current_glctx = context;
+#ifdef SDL_THREAD_LOCAL
+    SDL_GL_current.generation = SDL_GL_current_generation;
+    SDL_GL_current.window = window;
+    SDL_GL_current.context = context;
+#else
+    SDL_SetTLS(_this->current_glwin_tls, window, NULL);
+    SDL_SetTLS(_this->current_glctx_tls, context, NULL);
+#endif
+}
+
 SDL_GLContext SDL_GL_CreateContext(SDL_Window *window)
 {
     SDL_GLContext ctx = NULL;
@@ -4387,10 +4570,7 @@ SDL_GLContext SDL_GL_CreateContext(SDL_Window *window)
 
     /* Creating a context is assumed to make it current in the SDL driver. */
     if (ctx) {
-        _this->current_glwin = window;
-        _this->current_glctx = ctx;
-        SDL_SetTLS(_this->current_glwin_tls, window, NULL);
-        SDL_SetTLS(_this->current_glctx_tls, ctx, NULL);
+        SDL_GL_SetCurrent(window, ctx);
     }
     return ctx;
 }
@@ -4403,8 +4583,8 @@ int SDL_GL_MakeCurrent(SDL_Window *window, SDL_GLContext context)
         return SDL_UninitializedVideo();
     }
 
-    if (window == SDL_GL_GetCurrentWindow() &&
-        context == SDL_GL_GetCurrentContext()) {
+    if (window == SDL_GL_GetCurrentWindowInternal() &&
+        context == SDL_GL_GetCurrentContextInternal()) {
         /* We're already current. */
         return 0;
     }
@@ -4423,10 +4603,7 @@ int SDL_GL_MakeCurrent(SDL_Window *window, SDL_GLContext context)
 
     retval = _this->GL_MakeCurrent(_this, window, context);
     if (retval == 0) {
-        _this->current_glwin = window;
-        _this->current_glctx = context;
-        SDL_SetTLS(_this->current_glwin_tls, window, NULL);
-        SDL_SetTLS(_this->current_glctx_tls, context, NULL);
+        SDL_GL_SetCurrent(window, context);
     }
     return retval;
 }
@@ -4437,7 +4614,7 @@ SDL_Window *SDL_GL_GetCurrentWindow(void)
         SDL_UninitializedVideo();
         return NULL;
     }
-    return (SDL_Window *)SDL_GetTLS(_this->current_glwin_tls);
+    return SDL_GL_GetCurrentWindowInternal();
 }
 
 SDL_GLContext SDL_GL_GetCurrentContext(void)
@@ -4446,7 +4623,7 @@ SDL_GLContext SDL_GL_GetCurrentContext(void)
         SDL_UninitializedVideo();
         return NULL;
     }
-    return (SDL_GLContext)SDL_GetTLS(_this->current_glctx_tls);
+    return SDL_GL_GetCurrentContextInternal();
 }
 
 SDL_EGLDisplay SDL_EGL_GetCurrentEGLDisplay(void)
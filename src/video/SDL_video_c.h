@@ -59,4 +59,10 @@ extern int SDL_SetWindowTextureVSync(SDL_Window *window, int vsync);
 
 extern int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
+/* Stop the worker threads used for large surface blits */
+extern void SDL_QuitBlitThreads(void);
+
+/* Free the blit mappings shared between surfaces */
+extern void SDL_QuitBlitMapCache(void);
+
 #endif /* SDL_video_c_h_ */
@@ -31,14 +31,112 @@
 
 
 #ifdef SDL_VIDEO_CAPTURE
-/* list node entries to share frames between SDL and user app */
-typedef struct entry_t
-{
-    SDL_VideoCaptureFrame frame;
-} entry_t;
+/* Frame queue size if the backend doesn't say how many buffers it has */
+#define DEFAULT_NUM_BUFFERS 8
 
 static SDL_VideoCaptureDevice *open_devices[16];
 
+/* Give a queued frame back to the backend. Error entries have no buffer. */
+static void
+release_queued_frame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrame *frame)
+{
+    if (frame->timestampNS) {
+        ReleaseFrame(device, frame);
+    }
+}
+
+/* Add a frame to the queue, dropping one if it's full.
+   Returns SDL_FALSE if the new frame was the one dropped. */
+static SDL_bool
+queue_frame(SDL_VideoCaptureDevice *device, const SDL_VideoCaptureFrame *frame)
+{
+    SDL_VideoCaptureFrame dropped;
+    SDL_bool queued = SDL_TRUE;
+    SDL_bool full = SDL_FALSE;
+    Uint64 frames_dropped;
+
+    SDL_zero(dropped);
+
+    SDL_LockMutex(device->device_lock);
+    if (device->frame_queue_count == device->frame_queue_size) {
+        full = SDL_TRUE;
+        if (device->drop_oldest) {
+            dropped = device->frame_queue[device->frame_queue_head];
+            device->frame_queue_head = (device->frame_queue_head + 1) % device->frame_queue_size;
+            --device->frame_queue_count;
+        } else {
+            dropped = *frame;
+            queued = SDL_FALSE;
+        }
+        ++device->frames_dropped_queue;
+    }
+    frames_dropped = device->frames_dropped_queue;
+    if (queued) {
+        const int tail = (device->frame_queue_head + device->frame_queue_count) % device->frame_queue_size;
+        device->frame_queue[tail] = *frame;
+        ++device->frame_queue_count;
+    }
+    SDL_UnlockMutex(device->device_lock);
+
+    if (full) {
+        release_queued_frame(device, &dropped);
+        SDL_SetNumberProperty(device->props, "SDL.video_capture.frames_dropped_queue", (Sint64)frames_dropped);
+    }
+    return queued;
+}
+
+/* Count frames as they come in, only called from the capture thread */
+static void
+update_frame_stats(SDL_VideoCaptureDevice *device, const SDL_VideoCaptureFrame *frame)
+{
+    const Uint64 now = SDL_GetTicksNS();
+
+    if (device->frames_captured > 0 && frame->sequence > device->last_sequence + 1) {
+        device->frames_dropped_driver += frame->sequence - device->last_sequence - 1;
+        SDL_SetNumberProperty(device->props, "SDL.video_capture.frames_dropped_driver", (Sint64)device->frames_dropped_driver);
+    }
+    device->last_sequence = frame->sequence;
+    ++device->frames_captured;
+
+    SDL_SetNumberProperty(device->props, "SDL.video_capture.frames_captured", (Sint64)device->frames_captured);
+    SDL_SetNumberProperty(device->props, "SDL.video_capture.latency_ns", (Sint64)(now > frame->timestampNS ? now - frame->timestampNS : 0));
+}
+
+/* Take the oldest frame from the queue, if any */
+static SDL_bool
+dequeue_frame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrame *frame)
+{
+    SDL_bool result = SDL_FALSE;
+
+    SDL_LockMutex(device->device_lock);
+    if (device->frame_queue_count > 0) {
+        *frame = device->frame_queue[device->frame_queue_head];
+        device->frame_queue_head = (device->frame_queue_head + 1) % device->frame_queue_size;
+        --device->frame_queue_count;
+        result = SDL_TRUE;
+    }
+    SDL_UnlockMutex(device->device_lock);
+
+    return result;
+}
+
+/* Update the state flags and wake up the capture thread waiting for them */
+static void
+set_device_state(SDL_VideoCaptureDevice *device, int enabled, int shutdown)
+{
+    if (device->device_lock) {
+        SDL_LockMutex(device->device_lock);
+    }
+    SDL_AtomicSet(&device->enabled, enabled);
+    SDL_AtomicSet(&device->shutdown, shutdown);
+    if (device->state_cond) {
+        SDL_BroadcastCondition(device->state_cond);
+    }
+    if (device->device_lock) {
+        SDL_UnlockMutex(device->device_lock);
+    }
+}
+
 static void
 close_device(SDL_VideoCaptureDevice *device)
 {
@@ -46,12 +144,16 @@ close_device(SDL_VideoCaptureDevice *device)
         return;
     }
 
-    SDL_AtomicSet(&device->shutdown, 1);
-    SDL_AtomicSet(&device->enabled, 1);
+    set_device_state(device, 1, 1);
 
     if (device->thread != NULL) {
+        WakeupAcquireFrame(device);
         SDL_WaitThread(device->thread, NULL);
     }
+    if (device->state_cond != NULL) {
+        SDL_DestroyCondition(device->state_cond);
+    }
+    SDL_DestroyProperties(device->props);
     if (device->device_lock != NULL) {
         SDL_DestroyMutex(device->device_lock);
     }
@@ -68,20 +170,13 @@ close_device(SDL_VideoCaptureDevice *device)
         }
     }
 
-    {
-        entry_t *entry = NULL;
-        while (device->buffer_queue != NULL) {
-            SDL_ListPop(&device->buffer_queue, (void**)&entry);
-            if (entry) {
-                SDL_VideoCaptureFrame f = entry->frame;
-                /* Release frames not acquired, if any */
-                if (f.timestampNS) {
-                    ReleaseFrame(device, &f);
-                }
-                SDL_free(entry);
-            }
-        }
+    /* Release frames not acquired, if any */
+    while (device->frame_queue_count > 0) {
+        release_queued_frame(device, &device->frame_queue[device->frame_queue_head]);
+        device->frame_queue_head = (device->frame_queue_head + 1) % device->frame_queue_size;
+        --device->frame_queue_count;
     }
+    SDL_free(device->frame_queue);
 
     CloseDevice(device);
 
@@ -156,7 +251,22 @@ SDL_StartVideoCapture(SDL_VideoCaptureDevice *device)
         return result;
     }
 
-    SDL_AtomicSet(&device->enabled, 1);
+    /* The queue holds one frame less than the backend has, when dropping the
+       oldest frames, so the driver always has a buffer to fill and the queue
+       stays current when the application falls behind. */
+    if (device->frame_queue == NULL) {
+        const int num_buffers = (device->num_buffers > 0) ? device->num_buffers : DEFAULT_NUM_BUFFERS;
+
+        device->drop_oldest = SDL_GetHintBoolean(SDL_HINT_VIDEO_CAPTURE_DROP_OLDEST, SDL_TRUE);
+        device->frame_queue_size = device->drop_oldest ? SDL_max(num_buffers - 1, 1) : num_buffers;
+        device->frame_queue = (SDL_VideoCaptureFrame *)SDL_calloc(device->frame_queue_size, sizeof(*device->frame_queue));
+        if (device->frame_queue == NULL) {
+            StopCapture(device);
+            return SDL_OutOfMemory();
+        }
+    }
+
+    set_device_state(device, 1, 0);
 
     return 0;
 #else
@@ -200,8 +310,10 @@ SDL_StopVideoCapture(SDL_VideoCaptureDevice *device)
         return SDL_SetError("invalid state");
     }
 
-    SDL_AtomicSet(&device->enabled, 0);
-    SDL_AtomicSet(&device->shutdown, 1);
+    set_device_state(device, 0, 1);
+
+    /* The capture thread may be blocked on the device with the lock held */
+    WakeupAcquireFrame(device);
 
     SDL_LockMutex(device->acquiring_lock);
     ret = StopCapture(device);
@@ -374,7 +486,6 @@ SDL_GetVideoCaptureDevices(int *count)
 static int SDLCALL
 SDL_CaptureVideoThread(void *devicep)
 {
-    const int delay = 20;
     SDL_VideoCaptureDevice *device = (SDL_VideoCaptureDevice *) devicep;
 
 #if DEBUG_VIDEO_CAPTURE_CAPTURE
@@ -398,16 +509,19 @@ SDL_CaptureVideoThread(void *devicep)
     /* Perform any thread setup */
     device->threadid = SDL_ThreadID();
 
-    /* Init state */
-    while (!SDL_AtomicGet(&device->enabled)) {
-        SDL_Delay(delay);
+    /* Sleep until capture is started, or the device is closed */
+    SDL_LockMutex(device->device_lock);
+    while (!SDL_AtomicGet(&device->enabled) && !SDL_AtomicGet(&device->shutdown)) {
+        SDL_WaitCondition(device->state_cond, device->device_lock);
     }
+    SDL_UnlockMutex(device->device_lock);
 
     /* Loop, filling the video_capture buffers */
     while (!SDL_AtomicGet(&device->shutdown)) {
         SDL_VideoCaptureFrame f;
+        SDL_VideoCaptureFrameCallback callback;
+        void *userdata;
         int ret;
-        entry_t *entry;
 
         SDL_zero(f);
 
@@ -415,6 +529,8 @@ SDL_CaptureVideoThread(void *devicep)
         ret = AcquireFrame(device, &f);
         SDL_UnlockMutex(device->acquiring_lock);
 
+        /* AcquireFrame() blocks until there's a frame, so this means we were
+           woken up to check the state flags. */
         if (ret == 0) {
             if (f.num_planes == 0) {
                 continue;
@@ -429,21 +545,21 @@ SDL_CaptureVideoThread(void *devicep)
             f.num_planes = 0;
         }
 
-
-        entry = SDL_malloc(sizeof (entry_t));
-        if (entry == NULL) {
-            goto error_mem;
+        if (ret == 0) {
+            update_frame_stats(device, &f);
         }
 
-        entry->frame = f;
+        if (!queue_frame(device, &f)) {
+            continue;
+        }
 
         SDL_LockMutex(device->device_lock);
-        ret = SDL_ListAdd(&device->buffer_queue, entry);
+        callback = device->frame_callback;
+        userdata = device->frame_callback_userdata;
         SDL_UnlockMutex(device->device_lock);
 
-        if (ret < 0) {
-            SDL_free(entry);
-            goto error_mem;
+        if (callback) {
+            callback(userdata, device);
         }
     }
 
@@ -451,14 +567,6 @@ SDL_CaptureVideoThread(void *devicep)
     SDL_Log("dev[%p] End thread 'SDL_CaptureVideo'", (void *)device);
 #endif
     return 0;
-
-error_mem:
-#if DEBUG_VIDEO_CAPTURE_CAPTURE
-    SDL_Log("dev[%p] End thread 'SDL_CaptureVideo' with error: %s", (void *)device, SDL_GetError());
-#endif
-    SDL_AtomicSet(&device->shutdown, 1);
-    SDL_OutOfMemory();
-    return 0;
 }
 #endif
 
@@ -541,12 +649,21 @@ SDL_OpenVideoCapture(SDL_VideoCaptureDeviceID instance_id)
         goto error;
     }
 
+    device->state_cond = SDL_CreateCondition();
+    if (device->state_cond == NULL) {
+        SDL_SetError("Couldn't create state_cond");
+        goto error;
+    }
+
+    device->props = SDL_CreateProperties();
+    if (device->props == 0) {
+        goto error;
+    }
+
     if (OpenDevice(device) < 0) {
         goto error;
     }
 
-    /* empty */
-    device->buffer_queue = NULL;
     open_devices[id] = device;  /* add it to our list of open devices. */
 
 
@@ -632,6 +749,41 @@ SDL_SetVideoCaptureSpec(SDL_VideoCaptureDevice *device,
 #endif /* SDL_VIDEO_CAPTURE */
 }
 
+SDL_PropertiesID
+SDL_GetVideoCaptureProperties(SDL_VideoCaptureDevice *device)
+{
+#ifdef SDL_VIDEO_CAPTURE
+    if (!device) {
+        SDL_InvalidParamError("device");
+        return 0;
+    }
+
+    return device->props;
+#else
+    SDL_Unsupported();
+    return 0;
+#endif /* SDL_VIDEO_CAPTURE */
+}
+
+int
+SDL_SetVideoCaptureFrameCallback(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrameCallback callback, void *userdata)
+{
+#ifdef SDL_VIDEO_CAPTURE
+    if (!device) {
+        return SDL_InvalidParamError("device");
+    }
+
+    SDL_LockMutex(device->device_lock);
+    device->frame_callback = callback;
+    device->frame_callback_userdata = userdata;
+    SDL_UnlockMutex(device->device_lock);
+
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif /* SDL_VIDEO_CAPTURE */
+}
+
 int
 SDL_AcquireVideoCaptureFrame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrame *frame)
 {
@@ -657,22 +809,11 @@ SDL_AcquireVideoCaptureFrame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFra
         }
         return -1;
     } else {
-        entry_t *entry = NULL;
-
-        SDL_LockMutex(device->device_lock);
-        SDL_ListPop(&device->buffer_queue, (void**)&entry);
-        SDL_UnlockMutex(device->device_lock);
-
-        if (entry) {
-            *frame = entry->frame;
-            SDL_free(entry);
-
+        if (dequeue_frame(device, frame)) {
             /* Error from thread */
             if (frame->num_planes == 0 && frame->timestampNS == 0) {
                 return SDL_SetError("error from acquisition thread");
             }
-
-
         } else {
             /* Queue is empty. Not an error. */
         }
@@ -684,6 +825,27 @@ SDL_AcquireVideoCaptureFrame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFra
 #endif /* SDL_VIDEO_CAPTURE */
 }
 
+SDL_PropertiesID
+SDL_GetVideoCaptureFrameProperties(SDL_VideoCaptureDevice *device, const SDL_VideoCaptureFrame *frame)
+{
+#ifdef SDL_VIDEO_CAPTURE
+    if (!device) {
+        SDL_InvalidParamError("device");
+        return 0;
+    }
+
+    if (!frame || !frame->num_planes) {
+        SDL_InvalidParamError("frame");
+        return 0;
+    }
+
+    return GetFrameProperties(device, frame);
+#else
+    SDL_Unsupported();
+    return 0;
+#endif /* SDL_VIDEO_CAPTURE */
+}
+
 int
 SDL_ReleaseVideoCaptureFrame(SDL_VideoCaptureDevice *device, SDL_VideoCaptureFrame *frame)
 {
@@ -921,12 +1083,24 @@ AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
     return -1;
 }
 
+void
+WakeupAcquireFrame(SDL_VideoCaptureDevice *_this)
+{
+}
+
 int
 ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
     return -1;
 }
 
+SDL_PropertiesID
+GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame)
+{
+    SDL_Unsupported();
+    return 0;
+}
+
 int
 GetNumFormats(SDL_VideoCaptureDevice *_this)
 {
@@ -47,6 +47,8 @@ int OpenDevice(SDL_VideoCaptureDevice *_this) {
 int AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame) {
     return -1;
 }
+void WakeupAcquireFrame(SDL_VideoCaptureDevice *_this) {
+}
 void CloseDevice(SDL_VideoCaptureDevice *_this) {
 }
 int GetDeviceName(SDL_VideoCaptureDeviceID instance_id, char *buf, int size) {
@@ -73,6 +75,9 @@ int GetNumFrameSizes(SDL_VideoCaptureDevice *_this, Uint32 format) {
 int ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame) {
     return 0;
 }
+SDL_PropertiesID GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame) {
+    return 0;
+}
 int StartCapture(SDL_VideoCaptureDevice *_this) {
     return 0;
 }
@@ -119,8 +124,14 @@ struct SDL_PrivateVideoCaptureData
     MySampleBufferDelegate *delegate;
     AVCaptureSession *session;
     CMSimpleQueueRef frame_queue;
+    SDL_Semaphore *frame_ready; /* Posted when a frame is queued, or to wake up AcquireFrame() */
+    Uint64 sequence; /* Counts frames delivered or dropped by the session */
+    SDL_PropertiesID frame_props; /* Timing of the frame passed to GetFrameProperties() */
 };
 
+/* Attached to each sample buffer, holding its sequence number */
+static const CFStringRef SDL_SEQUENCE_ATTACHMENT = CFSTR("SDL.video_capture.sequence");
+
 static NSString *
 fourcc_to_nstring(Uint32 code)
 {
@@ -229,14 +240,26 @@ sdlformat_to_nsfourcc(Uint32 fmt)
     - (void) captureOutput:(AVCaptureOutput *)output
         didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer
         fromConnection:(AVCaptureConnection *) connection {
+            SInt64 sequence = (SInt64)_hidden->sequence++;
+            CFNumberRef number = CFNumberCreate(kCFAllocatorDefault, kCFNumberSInt64Type, &sequence);
+            if (number) {
+                CMSetAttachment(sampleBuffer, SDL_SEQUENCE_ATTACHMENT, number, kCMAttachmentMode_ShouldNotPropagate);
+                CFRelease(number);
+            }
+
             CFRetain(sampleBuffer);
-            CMSimpleQueueEnqueue(_hidden->frame_queue, sampleBuffer);
+            if (CMSimpleQueueEnqueue(_hidden->frame_queue, sampleBuffer) == noErr) {
+                SDL_PostSemaphore(_hidden->frame_ready);
+            } else {
+                CFRelease(sampleBuffer);
+            }
         }
 
     - (void)captureOutput:(AVCaptureOutput *)output
         didDropSampleBuffer:(CMSampleBufferRef)sampleBuffer
         fromConnection:(AVCaptureConnection *)connection {
-            SDL_Log("Drop frame..");
+            /* Leave a gap in the sequence numbers */
+            _hidden->sequence++;
         }
 @end
 
@@ -249,6 +272,11 @@ OpenDevice(SDL_VideoCaptureDevice *_this)
         goto error;
     }
 
+    _this->hidden->frame_ready = SDL_CreateSemaphore(0);
+    if (_this->hidden->frame_ready == NULL) {
+        goto error;
+    }
+
     return 0;
 
 error:
@@ -279,6 +307,12 @@ CloseDevice(SDL_VideoCaptureDevice *_this)
             CFRelease(_this->hidden->frame_queue);
         }
 
+        if (_this->hidden->frame_ready) {
+            SDL_DestroySemaphore(_this->hidden->frame_ready);
+        }
+
+        SDL_DestroyProperties(_this->hidden->frame_props);
+
         SDL_free(_this->hidden);
         _this->hidden = NULL;
     }
@@ -431,6 +465,9 @@ StopCapture(SDL_VideoCaptureDevice *_this)
 int
 AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
+    /* Sleep until the delegate queues a frame, or we're woken up */
+    SDL_WaitSemaphore(_this->hidden->frame_ready);
+
     if (CMSimpleQueueGetCount(_this->hidden->frame_queue) > 0) {
         int i, numPlanes, planar;
         CMSampleBufferRef sampleBuffer;
@@ -440,6 +477,26 @@ AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
         frame->internal = (void *) sampleBuffer;
         frame->timestampNS = SDL_GetTicksNS();
 
+        /* The presentation time is on the host clock, take its age off the current time */
+        {
+            CMTime pts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+            if (CMTIME_IS_VALID(pts)) {
+                CMTime age = CMTimeSubtract(CMClockGetTime(CMClockGetHostTimeClock()), pts);
+                Float64 seconds = CMTimeGetSeconds(age);
+                if (seconds >= 0.0 && seconds < 1.0) {
+                    frame->timestampNS -= (Uint64)(seconds * SDL_NS_PER_SECOND);
+                }
+            }
+        }
+
+        {
+            CFNumberRef number = (CFNumberRef)CMGetAttachment(sampleBuffer, SDL_SEQUENCE_ATTACHMENT, NULL);
+            SInt64 sequence = 0;
+            if (number && CFNumberGetValue(number, kCFNumberSInt64Type, &sequence)) {
+                frame->sequence = (Uint64)sequence;
+            }
+        }
+
         i = 0;
         image = CMSampleBufferGetImageBuffer(sampleBuffer);
         numPlanes = CVPixelBufferGetPlaneCount(image);
@@ -473,14 +530,18 @@ AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
         }
 
         /* Unlocked when frame is released */
-
-    } else {
-        // no frame
-        SDL_Delay(20); // TODO fix some delay
     }
     return 0;
 }
 
+void
+WakeupAcquireFrame(SDL_VideoCaptureDevice *_this)
+{
+    if (_this->hidden && _this->hidden->frame_ready) {
+        SDL_PostSemaphore(_this->hidden->frame_ready);
+    }
+}
+
 int
 ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
@@ -495,6 +556,43 @@ ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
     return 0;
 }
 
+SDL_PropertiesID
+GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame)
+{
+    CMSampleBufferRef sampleBuffer = (CMSampleBufferRef) frame->internal;
+    CMTime pts, duration;
+
+    if (!sampleBuffer) {
+        SDL_SetError("invalid frame");
+        return 0;
+    }
+
+    if (!_this->hidden->frame_props) {
+        _this->hidden->frame_props = SDL_CreateProperties();
+        if (!_this->hidden->frame_props) {
+            return 0;
+        }
+    }
+
+    /* The sample buffer timing, on the host clock */
+    pts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+    if (CMTIME_IS_NUMERIC(pts)) {
+        pts = CMTimeConvertScale(pts, (int32_t)SDL_NS_PER_SECOND, kCMTimeRoundingMethod_Default);
+        SDL_SetNumberProperty(_this->hidden->frame_props, "SDL.video_capture.frame.device_timestamp_ns", pts.value);
+    } else {
+        SDL_ClearProperty(_this->hidden->frame_props, "SDL.video_capture.frame.device_timestamp_ns");
+    }
+
+    duration = CMSampleBufferGetDuration(sampleBuffer);
+    if (CMTIME_IS_NUMERIC(duration)) {
+        duration = CMTimeConvertScale(duration, (int32_t)SDL_NS_PER_SECOND, kCMTimeRoundingMethod_Default);
+        SDL_SetNumberProperty(_this->hidden->frame_props, "SDL.video_capture.frame.duration_ns", duration.value);
+    } else {
+        SDL_ClearProperty(_this->hidden->frame_props, "SDL.video_capture.frame.duration_ns");
+    }
+    return _this->hidden->frame_props;
+}
+
 int
 GetNumFormats(SDL_VideoCaptureDevice *_this)
 {
@@ -72,7 +72,11 @@ enum io_method {
 struct buffer {
     void   *start;
     size_t  length;
+    size_t  bytesused; /* Size of the last frame, for compressed formats */
     int available; /* Is available in userspace */
+    int dmabuf_fd; /* Exported with VIDIOC_EXPBUF, or -1 */
+    Uint64 timestamp_ns; /* The driver timestamp of the last frame, or 0 */
+    SDL_PropertiesID props;
 };
 
 struct SDL_PrivateVideoCaptureData
@@ -82,15 +86,39 @@ struct SDL_PrivateVideoCaptureData
     int nb_buffers;
     struct buffer *buffers;
     int first_start;
+    Uint64 read_sequence; /* Frame count with IO_METHOD_READ, which has no sequence numbers */
     int driver_pitch;
+    int wakeup_fd; /* eventfd used to interrupt AcquireFrame() */
+    struct decoder *decoder; /* Decodes MJPEG frames, if the device sends them */
 };
 
+/* A V4L2 memory-to-memory JPEG decoder, turning MJPEG frames into NV12 */
+struct decoder
+{
+    int fd;
+    SDL_bool mplane;
+    Uint32 out_type; /* The queue taking compressed frames */
+    Uint32 cap_type; /* The queue giving decoded frames */
+    struct buffer input;
+    int nb_buffers;
+    struct buffer *buffers;
+    int pitch;
+    int height;
+};
+
+/* The decoder found by find_jpeg_decoder(), if any */
+static char *jpeg_decoder_path = NULL;
+static Uint32 jpeg_decoder_format = 0;
+
 #include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>              /* low-level i/o */
 #include <errno.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <linux/videodev2.h>
 
 static int
@@ -106,6 +134,27 @@ xioctl(int fh, int request, void *arg)
 }
 
 /* -1:error  1:frame 0:no frame*/
+/* Convert the capture time of a buffer to the SDL_GetTicksNS() timebase */
+static Uint64
+get_buffer_timestamp(const struct v4l2_buffer *buf)
+{
+    const Uint64 now = SDL_GetTicksNS();
+
+    if ((buf->flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        struct timespec ts;
+
+        if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+            const Uint64 monotonic_now = (Uint64)ts.tv_sec * SDL_NS_PER_SECOND + ts.tv_nsec;
+            const Uint64 captured = (Uint64)buf->timestamp.tv_sec * SDL_NS_PER_SECOND + SDL_US_TO_NS(buf->timestamp.tv_usec);
+
+            if (captured <= monotonic_now && (monotonic_now - captured) < now) {
+                return now - (monotonic_now - captured);
+            }
+        }
+    }
+    return now;
+}
+
 static int
 acquire_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
@@ -136,6 +185,8 @@ acquire_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
             frame->num_planes = 1;
             frame->data[0] = _this->hidden->buffers[0].start;
             frame->pitch[0] = _this->hidden->driver_pitch;
+            frame->timestampNS = SDL_GetTicksNS();
+            frame->sequence = _this->hidden->read_sequence++;
             break;
 
         case IO_METHOD_MMAP:
@@ -166,6 +217,10 @@ acquire_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
             frame->num_planes = 1;
             frame->data[0] = _this->hidden->buffers[buf.index].start;
             frame->pitch[0] = _this->hidden->driver_pitch;
+            frame->timestampNS = get_buffer_timestamp(&buf);
+            frame->sequence = buf.sequence;
+            _this->hidden->buffers[buf.index].timestamp_ns = (Uint64)buf.timestamp.tv_sec * SDL_NS_PER_SECOND + SDL_US_TO_NS(buf.timestamp.tv_usec);
+            _this->hidden->buffers[buf.index].bytesused = buf.bytesused;
             _this->hidden->buffers[buf.index].available = 1;
 
 #if DEBUG_VIDEO_CAPTURE_CAPTURE
@@ -207,6 +262,9 @@ acquire_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
             frame->num_planes = 1;
             frame->data[0] = (void*)buf.m.userptr;
             frame->pitch[0] = _this->hidden->driver_pitch;
+            frame->timestampNS = get_buffer_timestamp(&buf);
+            frame->sequence = buf.sequence;
+            _this->hidden->buffers[i].timestamp_ns = (Uint64)buf.timestamp.tv_sec * SDL_NS_PER_SECOND + SDL_US_TO_NS(buf.timestamp.tv_usec);
             _this->hidden->buffers[i].available = 1;
 #if DEBUG_VIDEO_CAPTURE_CAPTURE
             SDL_Log("debug userptr: image %d/%d  num_planes:%d data[0]=%p", buf.index, _this->hidden->nb_buffers, frame->num_planes, (void*)frame->data[0]);
@@ -218,6 +276,472 @@ acquire_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 }
 
 
+static Uint32
+get_device_caps(const struct v4l2_capability *cap)
+{
+    if (cap->capabilities & V4L2_CAP_DEVICE_CAPS) {
+        return cap->device_caps;
+    }
+    return cap->capabilities;
+}
+
+static SDL_bool
+has_format(int fd, Uint32 type, Uint32 pixelformat)
+{
+    struct v4l2_fmtdesc fmtdesc;
+
+    SDL_zero(fmtdesc);
+    fmtdesc.type = type;
+    while (ioctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) == 0) {
+        if (fmtdesc.pixelformat == pixelformat) {
+            return SDL_TRUE;
+        }
+        fmtdesc.index++;
+    }
+    return SDL_FALSE;
+}
+
+/* Look for a memory-to-memory device decoding JPEG into NV12 */
+static void
+find_jpeg_decoder(void)
+{
+    char path[PATH_MAX];
+    int i;
+
+    for (i = 0; i < MAX_CAPTURE_DEVICES; ++i) {
+        struct v4l2_capability cap;
+        Uint32 caps, out_type, cap_type;
+        int fd;
+
+        (void)SDL_snprintf(path, sizeof(path), "/dev/video%d", i);
+        fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            if (errno == ENOENT) {
+                break;
+            }
+            continue;
+        }
+
+        SDL_zero(cap);
+        if (ioctl(fd, VIDIOC_QUERYCAP, &cap) == 0) {
+            caps = get_device_caps(&cap);
+            if (caps & (V4L2_CAP_VIDEO_M2M | V4L2_CAP_VIDEO_M2M_MPLANE)) {
+                if (caps & V4L2_CAP_VIDEO_M2M_MPLANE) {
+                    out_type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+                    cap_type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+                } else {
+                    out_type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+                    cap_type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                }
+                if (has_format(fd, cap_type, V4L2_PIX_FMT_NV12)) {
+                    if (has_format(fd, out_type, V4L2_PIX_FMT_MJPEG)) {
+                        jpeg_decoder_format = V4L2_PIX_FMT_MJPEG;
+                    } else if (has_format(fd, out_type, V4L2_PIX_FMT_JPEG)) {
+                        jpeg_decoder_format = V4L2_PIX_FMT_JPEG;
+                    }
+                }
+            }
+        }
+        close(fd);
+
+        if (jpeg_decoder_format) {
+            jpeg_decoder_path = SDL_strdup(path);
+            return;
+        }
+    }
+}
+
+static int
+decoder_query_buffer(struct decoder *dec, Uint32 type, int index, struct buffer *b)
+{
+    struct v4l2_buffer buf;
+    struct v4l2_plane planes[1];
+    Uint32 offset;
+
+    SDL_zero(buf);
+    SDL_zero(planes);
+    buf.type = type;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    if (dec->mplane) {
+        buf.m.planes = planes;
+        buf.length = 1;
+    }
+
+    if (xioctl(dec->fd, VIDIOC_QUERYBUF, &buf) == -1) {
+        return SDL_SetError("VIDIOC_QUERYBUF");
+    }
+
+    if (dec->mplane) {
+        b->length = planes[0].length;
+        offset = planes[0].m.mem_offset;
+    } else {
+        b->length = buf.length;
+        offset = buf.m.offset;
+    }
+
+    b->start = mmap(NULL, b->length, PROT_READ | PROT_WRITE, MAP_SHARED, dec->fd, offset);
+    if (b->start == MAP_FAILED) {
+        b->start = NULL;
+        return SDL_SetError("mmap");
+    }
+    return 0;
+}
+
+static int
+decoder_queue_buffer(struct decoder *dec, Uint32 type, int index, size_t bytesused)
+{
+    struct v4l2_buffer buf;
+    struct v4l2_plane planes[1];
+
+    SDL_zero(buf);
+    SDL_zero(planes);
+    buf.type = type;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    if (dec->mplane) {
+        buf.m.planes = planes;
+        buf.length = 1;
+        planes[0].bytesused = (Uint32)bytesused;
+    } else {
+        buf.bytesused = (Uint32)bytesused;
+    }
+
+    if (xioctl(dec->fd, VIDIOC_QBUF, &buf) == -1) {
+        return SDL_SetError("VIDIOC_QBUF");
+    }
+    return 0;
+}
+
+/* Returns the index of the dequeued buffer, or -1 if none is ready */
+static int
+decoder_dequeue_buffer(struct decoder *dec, Uint32 type, Uint32 *flags)
+{
+    struct v4l2_buffer buf;
+    struct v4l2_plane planes[1];
+
+    SDL_zero(buf);
+    SDL_zero(planes);
+    buf.type = type;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (dec->mplane) {
+        buf.m.planes = planes;
+        buf.length = 1;
+    }
+
+    if (xioctl(dec->fd, VIDIOC_DQBUF, &buf) == -1) {
+        return -1;
+    }
+    if (flags) {
+        *flags = buf.flags;
+    }
+    return (int)buf.index;
+}
+
+static void
+close_decoder(SDL_VideoCaptureDevice *_this)
+{
+    struct decoder *dec = _this->hidden->decoder;
+    int i;
+
+    if (!dec) {
+        return;
+    }
+
+    if (dec->fd != -1) {
+        enum v4l2_buf_type type;
+
+        type = dec->out_type;
+        xioctl(dec->fd, VIDIOC_STREAMOFF, &type);
+        type = dec->cap_type;
+        xioctl(dec->fd, VIDIOC_STREAMOFF, &type);
+    }
+
+    if (dec->input.start) {
+        munmap(dec->input.start, dec->input.length);
+    }
+    if (dec->buffers) {
+        for (i = 0; i < dec->nb_buffers; ++i) {
+            if (dec->buffers[i].start) {
+                munmap(dec->buffers[i].start, dec->buffers[i].length);
+            }
+        }
+        SDL_free(dec->buffers);
+    }
+
+    if (dec->fd != -1) {
+        close(dec->fd);
+    }
+    SDL_free(dec);
+    _this->hidden->decoder = NULL;
+}
+
+static int
+open_decoder(SDL_VideoCaptureDevice *_this, Uint32 width, Uint32 height)
+{
+    struct decoder *dec;
+    struct v4l2_format fmt;
+    struct v4l2_requestbuffers req;
+    enum v4l2_buf_type type;
+    int i;
+
+    dec = (struct decoder *)SDL_calloc(1, sizeof(*dec));
+    if (!dec) {
+        return SDL_OutOfMemory();
+    }
+    _this->hidden->decoder = dec;
+
+    dec->fd = open(jpeg_decoder_path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (dec->fd == -1) {
+        return SDL_SetError("Cannot open JPEG decoder '%s': %s", jpeg_decoder_path, strerror(errno));
+    }
+
+    {
+        struct v4l2_capability cap;
+
+        SDL_zero(cap);
+        if (xioctl(dec->fd, VIDIOC_QUERYCAP, &cap) == -1) {
+            return SDL_SetError("VIDIOC_QUERYCAP");
+        }
+        dec->mplane = (get_device_caps(&cap) & V4L2_CAP_VIDEO_M2M_MPLANE) ? SDL_TRUE : SDL_FALSE;
+    }
+    if (dec->mplane) {
+        dec->out_type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+        dec->cap_type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    } else {
+        dec->out_type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+        dec->cap_type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    }
+
+    /* Compressed frames are at most as large as the device's buffers */
+    SDL_zero(fmt);
+    fmt.type = dec->out_type;
+    if (dec->mplane) {
+        fmt.fmt.pix_mp.width = width;
+        fmt.fmt.pix_mp.height = height;
+        fmt.fmt.pix_mp.pixelformat = jpeg_decoder_format;
+        fmt.fmt.pix_mp.num_planes = 1;
+        fmt.fmt.pix_mp.plane_fmt[0].sizeimage = (Uint32)_this->hidden->buffers[0].length;
+    } else {
+        fmt.fmt.pix.width = width;
+        fmt.fmt.pix.height = height;
+        fmt.fmt.pix.pixelformat = jpeg_decoder_format;
+        fmt.fmt.pix.sizeimage = (Uint32)_this->hidden->buffers[0].length;
+    }
+    if (xioctl(dec->fd, VIDIOC_S_FMT, &fmt) == -1) {
+        return SDL_SetError("Error VIDIOC_S_FMT on JPEG decoder input");
+    }
+
+    SDL_zero(fmt);
+    fmt.type = dec->cap_type;
+    if (dec->mplane) {
+        fmt.fmt.pix_mp.width = width;
+        fmt.fmt.pix_mp.height = height;
+        fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_NV12;
+        fmt.fmt.pix_mp.num_planes = 1;
+    } else {
+        fmt.fmt.pix.width = width;
+        fmt.fmt.pix.height = height;
+        fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_NV12;
+    }
+    if (xioctl(dec->fd, VIDIOC_S_FMT, &fmt) == -1) {
+        return SDL_SetError("Error VIDIOC_S_FMT on JPEG decoder output");
+    }
+    if (dec->mplane) {
+        if (fmt.fmt.pix_mp.pixelformat != V4L2_PIX_FMT_NV12 || fmt.fmt.pix_mp.num_planes != 1) {
+            return SDL_SetError("JPEG decoder can't output NV12");
+        }
+        dec->pitch = fmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+        dec->height = fmt.fmt.pix_mp.height;
+    } else {
+        if (fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_NV12) {
+            return SDL_SetError("JPEG decoder can't output NV12");
+        }
+        dec->pitch = fmt.fmt.pix.bytesperline;
+        dec->height = fmt.fmt.pix.height;
+    }
+
+    /* One input buffer is enough, frames are decoded one at a time */
+    SDL_zero(req);
+    req.count = 1;
+    req.type = dec->out_type;
+    req.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(dec->fd, VIDIOC_REQBUFS, &req) == -1 || req.count < 1) {
+        return SDL_SetError("VIDIOC_REQBUFS on JPEG decoder input");
+    }
+    if (decoder_query_buffer(dec, dec->out_type, 0, &dec->input) < 0) {
+        return -1;
+    }
+
+    SDL_zero(req);
+    req.count = _this->hidden->nb_buffers;
+    req.type = dec->cap_type;
+    req.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(dec->fd, VIDIOC_REQBUFS, &req) == -1 || req.count < 1) {
+        return SDL_SetError("VIDIOC_REQBUFS on JPEG decoder output");
+    }
+    dec->nb_buffers = req.count;
+    dec->buffers = (struct buffer *)SDL_calloc(dec->nb_buffers, sizeof(*dec->buffers));
+    if (!dec->buffers) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < dec->nb_buffers; ++i) {
+        if (decoder_query_buffer(dec, dec->cap_type, i, &dec->buffers[i]) < 0) {
+            return -1;
+        }
+        if (decoder_queue_buffer(dec, dec->cap_type, i, 0) < 0) {
+            return -1;
+        }
+    }
+
+    type = dec->out_type;
+    if (xioctl(dec->fd, VIDIOC_STREAMON, &type) == -1) {
+        return SDL_SetError("VIDIOC_STREAMON on JPEG decoder input");
+    }
+    type = dec->cap_type;
+    if (xioctl(dec->fd, VIDIOC_STREAMON, &type) == -1) {
+        return SDL_SetError("VIDIOC_STREAMON on JPEG decoder output");
+    }
+
+    return 0;
+}
+
+/* Wait for the decoder to be ready, it only takes a few milliseconds */
+static int
+decoder_wait(struct decoder *dec, short events)
+{
+    struct pollfd pfd;
+    int ret;
+
+    pfd.fd = dec->fd;
+    pfd.events = events;
+    pfd.revents = 0;
+    do {
+        ret = poll(&pfd, 1, 1000);
+    } while (ret == -1 && errno == EINTR);
+
+    if (ret == 0) {
+        return SDL_SetError("JPEG decoder timed out");
+    } else if (ret < 0) {
+        return SDL_SetError("poll");
+    }
+    return 0;
+}
+
+/* Replace an MJPEG frame with its decoded NV12 version.
+   Returns 1 if there's a frame, 0 if it had to be dropped. */
+static int
+decode_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
+{
+    struct decoder *dec = _this->hidden->decoder;
+    const Uint64 timestampNS = frame->timestampNS;
+    const Uint64 sequence = frame->sequence;
+    size_t size = 0;
+    Uint32 flags = 0;
+    int i, index, free_buffers = 0;
+
+    for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+        if (frame->data[0] == _this->hidden->buffers[i].start) {
+            size = _this->hidden->buffers[i].bytesused;
+            break;
+        }
+    }
+    for (i = 0; i < dec->nb_buffers; ++i) {
+        if (!dec->buffers[i].available) {
+            ++free_buffers;
+        }
+    }
+
+    /* Drop the frame if it's empty, or the application holds every decoded frame */
+    if (size == 0 || size > dec->input.length || free_buffers == 0) {
+        ReleaseFrame(_this, frame);
+        SDL_zerop(frame);
+        return 0;
+    }
+
+    /* The compressed data is small, copy it and give the buffer back to the device */
+    SDL_memcpy(dec->input.start, frame->data[0], size);
+    if (ReleaseFrame(_this, frame) < 0) {
+        return -1;
+    }
+    SDL_zerop(frame);
+
+    if (decoder_queue_buffer(dec, dec->out_type, 0, size) < 0) {
+        return -1;
+    }
+
+    if (decoder_wait(dec, POLLIN) < 0) {
+        return -1;
+    }
+    index = decoder_dequeue_buffer(dec, dec->cap_type, &flags);
+    if (index < 0 || index >= dec->nb_buffers) {
+        return SDL_SetError("VIDIOC_DQBUF on JPEG decoder output");
+    }
+
+    /* Take the input buffer back for the next frame */
+    if (decoder_wait(dec, POLLOUT) < 0) {
+        return -1;
+    }
+    if (decoder_dequeue_buffer(dec, dec->out_type, NULL) < 0) {
+        return SDL_SetError("VIDIOC_DQBUF on JPEG decoder input");
+    }
+
+    if (flags & V4L2_BUF_FLAG_ERROR) {
+        /* Corrupted JPEG data, cameras send some now and then */
+        if (decoder_queue_buffer(dec, dec->cap_type, index, 0) < 0) {
+            return -1;
+        }
+        return 0;
+    }
+
+    dec->buffers[index].available = 1;
+    frame->timestampNS = timestampNS;
+    frame->sequence = sequence;
+    frame->num_planes = 2;
+    frame->data[0] = dec->buffers[index].start;
+    frame->pitch[0] = dec->pitch;
+    frame->data[1] = (Uint8 *)dec->buffers[index].start + (size_t)dec->pitch * dec->height;
+    frame->pitch[1] = dec->pitch;
+    return 1;
+}
+
+/* Returns 1 if the frame isn't one of the decoder's */
+static int
+release_decoded_frame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
+{
+    struct decoder *dec = _this->hidden->decoder;
+    int i;
+
+    for (i = 0; i < dec->nb_buffers; ++i) {
+        if (frame->num_planes && frame->data[0] == dec->buffers[i].start) {
+            if (decoder_queue_buffer(dec, dec->cap_type, i, 0) < 0) {
+                return -1;
+            }
+            dec->buffers[i].available = 0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Are all the buffers dequeued and held by the application? */
+static SDL_bool
+all_buffers_acquired(SDL_VideoCaptureDevice *_this)
+{
+    int i;
+
+    if (_this->hidden->io == IO_METHOD_READ) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+        if (_this->hidden->buffers[i].available == 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
 int
 ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
@@ -225,6 +749,14 @@ ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
     int i;
     int fd = _this->hidden->fd;
     enum io_method io = _this->hidden->io;
+    const SDL_bool starved = all_buffers_acquired(_this);
+
+    if (_this->hidden->decoder) {
+        int ret = release_decoded_frame(_this, frame);
+        if (ret <= 0) {
+            return ret;
+        }
+    }
 
     for (i = 0; i < _this->hidden->nb_buffers; ++i) {
         if (frame->num_planes && frame->data[0] == _this->hidden->buffers[i].start) {
@@ -269,6 +801,11 @@ ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
             break;
     }
 
+    if (starved) {
+        /* The capture thread is waiting for a buffer to fill */
+        WakeupAcquireFrame(_this);
+    }
+
     return 0;
 }
 
@@ -276,52 +813,62 @@ ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 int
 AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
-    fd_set fds;
-    struct timeval tv;
+    struct pollfd fds[2];
     int ret;
 
-    int fd = _this->hidden->fd;
-
-    FD_ZERO(&fds);
-    FD_SET(fd, &fds);
-
-    /* Timeout. */
-    tv.tv_sec = 0;
-    tv.tv_usec = 300 * 1000;
-
-    ret = select(fd + 1, &fds, NULL, NULL, &tv);
+    for (;;) {
+        /* With no buffer queued, the driver reports an error right away, so
+           wait for ReleaseFrame() to give one back instead. */
+        fds[0].fd = all_buffers_acquired(_this) ? -1 : _this->hidden->fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = _this->hidden->wakeup_fd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+
+        ret = poll(fds, 2, -1);
+        if (ret == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return SDL_SetError("poll");
+        }
 
-    if (ret == -1) {
-        if (errno == EINTR) {
-#if DEBUG_VIDEO_CAPTURE_CAPTURE
-            SDL_Log("continue ..");
-#endif
+        if (fds[1].revents & POLLIN) {
+            eventfd_t value;
+            eventfd_read(_this->hidden->wakeup_fd, &value);
             return 0;
         }
-        return SDL_SetError("select");
-    }
 
-    if (ret == 0) {
-        /* Timeout. Not an error */
-        SDL_SetError("timeout select");
-        return 0;
-    }
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            return SDL_SetError("Video capture device '%s' is gone", _this->dev_name);
+        }
 
-    ret = acquire_frame(_this, frame);
-    if (ret < 0) {
-        return -1;
+        if (fds[0].revents & POLLIN) {
+            ret = acquire_frame(_this, frame);
+            if (ret < 0) {
+                return -1;
+            }
+            if (ret == 1 && _this->hidden->decoder) {
+                ret = decode_frame(_this, frame);
+                if (ret < 0) {
+                    return -1;
+                }
+            }
+            if (ret == 1) {
+                return 0;
+            }
+            /* EAGAIN, wait for the next frame */
+        }
     }
+}
 
-    if (ret == 1){
-        frame->timestampNS = SDL_GetTicksNS();
-    } else if (ret == 0) {
-#if DEBUG_VIDEO_CAPTURE_CAPTURE
-        SDL_Log("No frame continue: %s", SDL_GetError());
-#endif
+void
+WakeupAcquireFrame(SDL_VideoCaptureDevice *_this)
+{
+    if (_this->hidden && _this->hidden->wakeup_fd != -1) {
+        eventfd_write(_this->hidden->wakeup_fd, 1);
     }
-
-    /* EAGAIN - continue select loop. */
-    return 0;
 }
 
 
@@ -495,6 +1042,8 @@ StartCapture(SDL_VideoCaptureDevice *_this)
             break;
     }
 
+    _this->num_buffers = _this->hidden->nb_buffers;
+
     return 0;
 }
 
@@ -538,6 +1087,20 @@ alloc_buffer_mmap(SDL_VideoCaptureDevice *_this)
         if (MAP_FAILED == _this->hidden->buffers[i].start) {
             return SDL_SetError("mmap");
         }
+
+        /* Not all drivers can export their buffers, that's not an error */
+        {
+            struct v4l2_exportbuffer expbuf;
+
+            SDL_zero(expbuf);
+            expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            expbuf.index = i;
+            expbuf.flags = O_RDONLY | O_CLOEXEC;
+
+            if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == 0) {
+                _this->hidden->buffers[i].dmabuf_fd = expbuf.fd;
+            }
+        }
     }
     return 0;
 }
@@ -560,6 +1123,11 @@ alloc_buffer_userp(SDL_VideoCaptureDevice *_this, size_t buffer_size)
 static Uint32
 format_v4l2_2_sdl(Uint32 fmt)
 {
+    /* MJPEG frames are given to the application decoded */
+    if (fmt == V4L2_PIX_FMT_MJPEG && jpeg_decoder_path) {
+        return SDL_PIXELFORMAT_NV12;
+    }
+
     switch (fmt) {
 #define CASE(x, y)  case x: return y
         CASE(V4L2_PIX_FMT_YUYV, SDL_PIXELFORMAT_YUY2);
@@ -571,9 +1139,25 @@ format_v4l2_2_sdl(Uint32 fmt)
     }
 }
 
+/* The DRM fourcc of a frame, for importing it as a dmabuf */
+static Uint32
+format_v4l2_2_drm(Uint32 fmt)
+{
+    switch (fmt) {
+        case V4L2_PIX_FMT_YUYV:
+            return SDL_FOURCC('Y', 'U', 'Y', 'V'); /* DRM_FORMAT_YUYV */
+        default:
+            return 0;
+    }
+}
+
 static Uint32
 format_sdl_2_v4l2(Uint32 fmt)
 {
+    if (fmt == SDL_PIXELFORMAT_NV12 && jpeg_decoder_path) {
+        return V4L2_PIX_FMT_MJPEG;
+    }
+
     switch (fmt) {
 #define CASE(y, x)  case x: return y
         CASE(V4L2_PIX_FMT_YUYV, SDL_PIXELFORMAT_YUY2);
@@ -584,6 +1168,71 @@ format_sdl_2_v4l2(Uint32 fmt)
     }
 }
 
+SDL_PropertiesID
+GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame)
+{
+    struct buffer *buffer = NULL;
+    int i;
+
+    if (_this->hidden->decoder) {
+        SDL_SetError("Decoded MJPEG frames can't be exported");
+        return 0;
+    }
+
+    for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+        if (frame->data[0] == _this->hidden->buffers[i].start) {
+            buffer = &_this->hidden->buffers[i];
+            break;
+        }
+    }
+
+    if (!buffer) {
+        SDL_SetError("invalid buffer index");
+        return 0;
+    }
+
+    if (!buffer->props) {
+        buffer->props = SDL_CreateProperties();
+        if (!buffer->props) {
+            return 0;
+        }
+    }
+
+    if (buffer->dmabuf_fd != -1 && SDL_GetPropertyType(buffer->props, "SDL.video_capture.frame.dmabuf_fd") == SDL_PROPERTY_TYPE_INVALID) {
+        struct v4l2_format fmt;
+        Uint32 drm_format;
+
+        SDL_zero(fmt);
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(_this->hidden->fd, VIDIOC_G_FMT, &fmt) == -1) {
+            SDL_SetError("Error VIDIOC_G_FMT");
+            return 0;
+        }
+
+        SDL_SetNumberProperty(buffer->props, "SDL.video_capture.frame.dmabuf_fd", buffer->dmabuf_fd);
+
+        /* Enough to create a texture from the buffer without a copy */
+        drm_format = format_v4l2_2_drm(fmt.fmt.pix.pixelformat);
+        if (drm_format) {
+            SDL_SetNumberProperty(buffer->props, "format", SDL_PIXELFORMAT_EXTERNAL_OES);
+            SDL_SetNumberProperty(buffer->props, "width", fmt.fmt.pix.width);
+            SDL_SetNumberProperty(buffer->props, "height", fmt.fmt.pix.height);
+            SDL_SetNumberProperty(buffer->props, "opengles2.dmabuf.fd0", buffer->dmabuf_fd);
+            SDL_SetNumberProperty(buffer->props, "opengles2.dmabuf.offset0", 0);
+            SDL_SetNumberProperty(buffer->props, "opengles2.dmabuf.pitch0", fmt.fmt.pix.bytesperline);
+            SDL_SetNumberProperty(buffer->props, "opengles2.dmabuf.format", drm_format);
+        }
+    }
+
+    /* The buffer timestamp, on the clock given by its V4L2_BUF_FLAG_TIMESTAMP_* flags */
+    if (buffer->timestamp_ns) {
+        SDL_SetNumberProperty(buffer->props, "SDL.video_capture.frame.device_timestamp_ns", (Sint64)buffer->timestamp_ns);
+    } else {
+        SDL_ClearProperty(buffer->props, "SDL.video_capture.frame.device_timestamp_ns");
+    }
+    return buffer->props;
+}
+
 int
 GetNumFormats(SDL_VideoCaptureDevice *_this)
 {
@@ -743,6 +1392,8 @@ InitDevice(SDL_VideoCaptureDevice *_this)
     int fd = _this->hidden->fd;
     enum io_method io = _this->hidden->io;
     int ret = -1;
+    SDL_bool is_mjpeg = SDL_FALSE;
+    Uint32 width = 0, height = 0;
 
     /* Select video input, video standard and tune here. */
     SDL_zero(cropcap);
@@ -789,6 +1440,9 @@ InitDevice(SDL_VideoCaptureDevice *_this)
         if (xioctl(fd, VIDIOC_S_FMT, &fmt) == -1) {
             return SDL_SetError("Error VIDIOC_S_FMT");
         }
+        is_mjpeg = (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG);
+        width = fmt.fmt.pix.width;
+        height = fmt.fmt.pix.height;
     }
 
     GetDeviceSpec(_this, &_this->spec);
@@ -798,10 +1452,15 @@ InitDevice(SDL_VideoCaptureDevice *_this)
     }
 
     {
+        int i;
+
         _this->hidden->buffers = SDL_calloc(_this->hidden->nb_buffers, sizeof(*_this->hidden->buffers));
         if (!_this->hidden->buffers) {
             return SDL_OutOfMemory();
         }
+        for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+            _this->hidden->buffers[i].dmabuf_fd = -1;
+        }
     }
 
     {
@@ -827,6 +1486,16 @@ InitDevice(SDL_VideoCaptureDevice *_this)
         return -1;
     }
 
+    if (is_mjpeg && jpeg_decoder_path) {
+        if (io != IO_METHOD_MMAP) {
+            return SDL_SetError("MJPEG decoding needs mmap buffers");
+        }
+        if (open_decoder(_this, width, height) < 0) {
+            close_decoder(_this);
+            return -1;
+        }
+    }
+
     return 0;
 }
 
@@ -838,17 +1507,24 @@ CloseDevice(SDL_VideoCaptureDevice *_this)
     }
 
     if (_this->hidden) {
+        close_decoder(_this);
+
         if (_this->hidden->buffers) {
             int i;
             enum io_method io = _this->hidden->io;
 
             switch (io) {
                 case IO_METHOD_READ:
+                    SDL_DestroyProperties(_this->hidden->buffers[0].props);
                     SDL_free(_this->hidden->buffers[0].start);
                     break;
 
                 case IO_METHOD_MMAP:
                     for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+                        SDL_DestroyProperties(_this->hidden->buffers[i].props);
+                        if (_this->hidden->buffers[i].dmabuf_fd != -1) {
+                            close(_this->hidden->buffers[i].dmabuf_fd);
+                        }
                         if (munmap(_this->hidden->buffers[i].start, _this->hidden->buffers[i].length) == -1) {
                             SDL_SetError("munmap");
                         }
@@ -857,6 +1533,7 @@ CloseDevice(SDL_VideoCaptureDevice *_this)
 
                 case IO_METHOD_USERPTR:
                     for (i = 0; i < _this->hidden->nb_buffers; ++i) {
+                        SDL_DestroyProperties(_this->hidden->buffers[i].props);
                         SDL_free(_this->hidden->buffers[i].start);
                     }
                     break;
@@ -870,6 +1547,9 @@ CloseDevice(SDL_VideoCaptureDevice *_this)
                 SDL_SetError("close video capture device");
             }
         }
+        if (_this->hidden->wakeup_fd != -1) {
+            close(_this->hidden->wakeup_fd);
+        }
         SDL_free(_this->hidden);
 
         _this->hidden = NULL;
@@ -892,6 +1572,7 @@ OpenDevice(SDL_VideoCaptureDevice *_this)
     }
 
     _this->hidden->fd = -1;
+    _this->hidden->wakeup_fd = -1;
 
     if (stat(_this->dev_name, &st) == -1) {
         SDL_SetError("Cannot identify '%s': %d, %s", _this->dev_name, errno, strerror(errno));
@@ -910,6 +1591,12 @@ OpenDevice(SDL_VideoCaptureDevice *_this)
     }
 
     _this->hidden->fd = fd;
+
+    _this->hidden->wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_this->hidden->wakeup_fd == -1) {
+        return SDL_SetError("Cannot create eventfd: %s", strerror(errno));
+    }
+
     _this->hidden->io = IO_METHOD_MMAP;
 //    _this->hidden->io = IO_METHOD_USERPTR;
 //    _this->hidden->io = IO_METHOD_READ;
@@ -1015,6 +1702,10 @@ int SDL_SYS_VideoCaptureInit(void)
     char path[PATH_MAX];
     int i, j;
 
+    if (SDL_GetHintBoolean(SDL_HINT_VIDEO_CAPTURE_MJPEG_DECODE, SDL_TRUE)) {
+        find_jpeg_decoder();
+    }
+
     /*
      * Limit amount of checks to MAX_CAPTURE_DEVICES since we may or may not have
      * permission to some or all devices.
@@ -1061,6 +1752,10 @@ int SDL_SYS_VideoCaptureQuit(void)
     SDL_capturelist = NULL;
     SDL_capturelist_tail = NULL;
 
+    SDL_free(jpeg_decoder_path);
+    jpeg_decoder_path = NULL;
+    jpeg_decoder_format = 0;
+
     return SDL_FALSE;
 }
 
@@ -1124,6 +1819,11 @@ static int MaybeAddDevice(const char *path)
         return -1;
     }
 
+    /* Skip codecs and output devices, like the JPEG decoder */
+    if (!(get_device_caps(&vcap) & V4L2_CAP_VIDEO_CAPTURE)) {
+        return -1;
+    }
+
     bus_info = SDL_strdup((char *)vcap.bus_info);
 
     if (DeviceExists(path, bus_info)) {
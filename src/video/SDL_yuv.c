@@ -31,6 +31,8 @@ static SDL_YUV_CONVERSION_MODE SDL_YUV_ConversionMode = SDL_YUV_CONVERSION_BT601
 
 #if SDL_HAVE_YUV
 static SDL_bool IsPlanar2x2Format(Uint32 format);
+static SDL_bool IsP01xFormat(Uint32 format);
+static SDL_bool IsPlanar444Format(Uint32 format);
 #endif
 
 void SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_MODE mode)
@@ -67,7 +69,7 @@ int SDL_CalculateYUVSize(Uint32 format, int w, int h, size_t *size, size_t *pitc
 #if SDL_HAVE_YUV
     int sz_plane = 0, sz_plane_chroma = 0, sz_plane_packed = 0;
 
-    if (IsPlanar2x2Format(format) == SDL_TRUE) {
+    if (IsPlanar2x2Format(format) == SDL_TRUE || IsP01xFormat(format) || IsPlanar444Format(format)) {
         {
             /* sz_plane == w * h; */
             size_t s1;
@@ -173,6 +175,48 @@ int SDL_CalculateYUVSize(Uint32 format, int w, int h, size_t *size, size_t *pitc
         }
         break;
 
+    case SDL_PIXELFORMAT_P010: /**< Planar mode: Y + U/V interleaved, 16-bit samples  (2 planes) */
+    case SDL_PIXELFORMAT_P016: /**< Planar mode: Y + U/V interleaved, 16-bit samples  (2 planes) */
+        if (pitch) {
+            /* pitch == w * 2; */
+            size_t p1;
+            if (SDL_size_mul_overflow(w, 2, &p1) < 0) {
+                return -1;
+            }
+            *pitch = p1;
+        }
+
+        if (size) {
+            /* dst_size == 2 * (sz_plane + sz_plane_chroma + sz_plane_chroma); */
+            size_t s1, s2, s3;
+            if (SDL_size_add_overflow(sz_plane, sz_plane_chroma, &s1) < 0) {
+                return -1;
+            }
+            if (SDL_size_add_overflow(s1, sz_plane_chroma, &s2) < 0) {
+                return -1;
+            }
+            if (SDL_size_mul_overflow(s2, 2, &s3) < 0) {
+                return -1;
+            }
+            *size = (int) s3;
+        }
+        break;
+
+    case SDL_PIXELFORMAT_I444: /**< Planar mode: Y + U + V, full resolution chroma  (3 planes) */
+        if (pitch) {
+            *pitch = w;
+        }
+
+        if (size) {
+            /* dst_size == 3 * sz_plane; */
+            size_t s1;
+            if (SDL_size_mul_overflow(sz_plane, 3, &s1) < 0) {
+                return -1;
+            }
+            *size = (int) s1;
+        }
+        break;
+
     default:
         return -1;
     }
@@ -213,6 +257,17 @@ static SDL_bool IsPacked4Format(Uint32 format)
     return format == SDL_PIXELFORMAT_YUY2 || format == SDL_PIXELFORMAT_UYVY || format == SDL_PIXELFORMAT_YVYU;
 }
 
+/* The 2x2 subsampled formats with 16-bit samples */
+static SDL_bool IsP01xFormat(Uint32 format)
+{
+    return format == SDL_PIXELFORMAT_P010 || format == SDL_PIXELFORMAT_P016;
+}
+
+static SDL_bool IsPlanar444Format(Uint32 format)
+{
+    return format == SDL_PIXELFORMAT_I444;
+}
+
 static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, int yuv_pitch,
                         const Uint8 **y, const Uint8 **u, const Uint8 **v, Uint32 *y_stride, Uint32 *uv_stride)
 {
@@ -242,6 +297,20 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
         planes[0] = (const Uint8 *)yuv;
         planes[1] = planes[0] + pitches[0] * height;
         break;
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        pitches[0] = yuv_pitch;
+        pitches[1] = 4 * ((pitches[0] + 3) / 4);
+        planes[0] = (const Uint8 *)yuv;
+        planes[1] = planes[0] + pitches[0] * height;
+        break;
+    case SDL_PIXELFORMAT_I444:
+        pitches[0] = yuv_pitch;
+        pitches[1] = yuv_pitch;
+        planes[0] = (const Uint8 *)yuv;
+        planes[1] = planes[0] + pitches[0] * height;
+        planes[2] = planes[1] + pitches[1] * height;
+        break;
     default:
         return SDL_SetError("GetYUVPlanes(): Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
     }
@@ -296,6 +365,21 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
         *u = *v + 1;
         *uv_stride = pitches[1];
         break;
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        *y = planes[0];
+        *y_stride = pitches[0];
+        *u = planes[1];
+        *v = *u + 2;
+        *uv_stride = pitches[1];
+        break;
+    case SDL_PIXELFORMAT_I444:
+        *y = planes[0];
+        *y_stride = pitches[0];
+        *u = planes[1];
+        *v = planes[2];
+        *uv_stride = pitches[1];
+        break;
     default:
         /* Should have caught this above */
         return SDL_SetError("GetYUVPlanes[2]: Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
@@ -303,6 +387,244 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
     return 0;
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_bool yuv_rgb_neon(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasNEON()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_neon(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
 #ifdef SDL_SSE2_INTRINSICS
 static SDL_bool SDL_TARGETING("sse2") yuv_rgb_sse(
     Uint32 src_format, Uint32 dst_format,
@@ -544,72 +866,477 @@ static SDL_bool yuv_rgb_std(
         }
     }
 
-    if (src_format == SDL_PIXELFORMAT_NV12 ||
-        src_format == SDL_PIXELFORMAT_NV21) {
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Returns the planes of a YUV image, starting at the given row */
+static int GetYUVBandPlanes(int width, int height, Uint32 format, const void *yuv, int yuv_pitch, int row,
+                            const Uint8 **y, const Uint8 **u, const Uint8 **v, Uint32 *y_stride, Uint32 *uv_stride)
+{
+    /* Only full chroma rows can be split, so the 2x2 formats start on even rows */
+    const int uv_row = (IsPlanar2x2Format(format) || IsP01xFormat(format)) ? (row / 2) : row;
+
+    if (GetYUVPlanes(width, height, format, yuv, yuv_pitch, y, u, v, y_stride, uv_stride) < 0) {
+        return -1;
+    }
+    *y += (size_t)row * *y_stride;
+    *u += (size_t)uv_row * *uv_stride;
+    *v += (size_t)uv_row * *uv_stride;
+    return 0;
+}
+
+typedef struct
+{
+    int width;
+    int height;
+    Uint32 src_format;
+    const void *src;
+    int src_pitch;
+    Uint32 dst_format;
+    void *dst;
+    int dst_pitch;
+    int result;
+} YUVConversionJob;
+
+static SDL_bool GetRGB8888Shifts(Uint32 format, int shift[3])
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_XRGB8888:
+        shift[0] = 16;
+        shift[1] = 8;
+        shift[2] = 0;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_XBGR8888:
+        shift[0] = 0;
+        shift[1] = 8;
+        shift[2] = 16;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_RGBX8888:
+        shift[0] = 24;
+        shift[1] = 16;
+        shift[2] = 8;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_BGRA8888:
+    case SDL_PIXELFORMAT_BGRX8888:
+        shift[0] = 8;
+        shift[1] = 16;
+        shift[2] = 24;
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* P010, P016 and I444 are converted through rows of 10-bit Y, U and V samples, one of each per pixel */
+#define YUV10_ROW_CHUNK 256
+
+typedef struct
+{
+    float y_offset;
+    float y_factor;
+    float v_r_factor;
+    float u_g_factor;
+    float v_g_factor;
+    float u_b_factor;
+    float max;
+    int shift[3];
+    Uint32 fill;
+} YUV10toRGBParams;
+
+/* Converts part of a row of samples, returning the number of pixels converted */
+typedef int (*YUV10toRGBFunc)(const Uint16 *y, const Uint16 *u, const Uint16 *v, int width, Uint32 *dst, const YUV10toRGBParams *params);
+
+/* The samples are scaled to 8 bits as floats, so the factors are the same as for 8-bit formats,
+   and the results are scaled to the output depth. The kernels below use the same arithmetic
+   in the same order as the C version, so they give identical results. */
+static SDL_bool GetYUV10toRGBParams(Uint32 dst_format, YCbCrType yuv_type, YUV10toRGBParams *params)
+{
+    static const float factors[3][5] = {
+        /* ITU-T T.871 (JPEG) */
+        { 1.0f, 1.402f, -0.3441f, -0.7141f, 1.772f },
+        /* ITU-R BT.601-7 */
+        { 1.1644f, 1.596f, -0.3918f, -0.813f, 2.0172f },
+        /* ITU-R BT.709-6 */
+        { 1.1644f, 1.7927f, -0.2132f, -0.5329f, 2.1124f }
+    };
+    float scale;
+
+    if (GetRGB8888Shifts(dst_format, params->shift)) {
+        scale = 1.0f;
+        params->max = 255.0f;
+        params->fill = ~(((Uint32)0xFF << params->shift[0]) | ((Uint32)0xFF << params->shift[1]) | ((Uint32)0xFF << params->shift[2]));
+    } else {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+        case SDL_PIXELFORMAT_ARGB2101010:
+            params->shift[0] = 20;
+            params->shift[1] = 10;
+            params->shift[2] = 0;
+            break;
+        case SDL_PIXELFORMAT_XBGR2101010:
+        case SDL_PIXELFORMAT_ABGR2101010:
+            params->shift[0] = 0;
+            params->shift[1] = 10;
+            params->shift[2] = 20;
+            break;
+        default:
+            return SDL_FALSE;
+        }
+        scale = 1023.0f / 255.0f;
+        params->max = 1023.0f;
+        params->fill = 0xC0000000;
+    }
+    params->y_offset = (yuv_type == YCBCR_JPEG) ? 0.0f : 16.0f;
+    params->y_factor = factors[yuv_type][0] * scale;
+    params->v_r_factor = factors[yuv_type][1] * scale;
+    params->u_g_factor = factors[yuv_type][2] * scale;
+    params->v_g_factor = factors[yuv_type][3] * scale;
+    params->u_b_factor = factors[yuv_type][4] * scale;
+    return SDL_TRUE;
+}
+
+static SDL_INLINE Uint32 YUV10_Clamp(float value, float max)
+{
+    value += 0.5f;
+    if (value < 0.0f) {
+        value = 0.0f;
+    }
+    if (value > max) {
+        value = max;
+    }
+    return (Uint32)value;
+}
+
+static SDL_INLINE Uint32 YUV10_to_RGB_Pixel(Uint16 y, Uint16 u, Uint16 v, const YUV10toRGBParams *params)
+{
+    const float yy = ((float)y * 0.25f - params->y_offset) * params->y_factor;
+    const float uu = (float)u * 0.25f - 128.0f;
+    const float vv = (float)v * 0.25f - 128.0f;
+    const Uint32 r = YUV10_Clamp(yy + params->v_r_factor * vv, params->max);
+    const Uint32 g = YUV10_Clamp(yy + params->u_g_factor * uu + params->v_g_factor * vv, params->max);
+    const Uint32 b = YUV10_Clamp(yy + params->u_b_factor * uu, params->max);
+
+    return (r << params->shift[0]) | (g << params->shift[1]) | (b << params->shift[2]) | params->fill;
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256i SDL_TARGETING("avx2") YUV10_Clamp_AVX2(__m256 value, __m256 max)
+{
+    value = _mm256_add_ps(value, _mm256_set1_ps(0.5f));
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), max);
+    return _mm256_cvttps_epi32(value);
+}
+
+static int SDL_TARGETING("avx2") YUV10_to_RGB_AVX2(const Uint16 *y, const Uint16 *u, const Uint16 *v, int width, Uint32 *dst, const YUV10toRGBParams *params)
+{
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    const __m256 y_offset = _mm256_set1_ps(params->y_offset);
+    const __m256 bias = _mm256_set1_ps(128.0f);
+    const __m256 max = _mm256_set1_ps(params->max);
+    const __m128i r_shift = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i g_shift = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i b_shift = _mm_cvtsi32_si128(params->shift[2]);
+    const __m256i fill = _mm256_set1_epi32((int)params->fill);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        const __m256 yf = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(y + i))));
+        const __m256 uf = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(u + i))));
+        const __m256 vf = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(v + i))));
+        const __m256 yy = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(yf, quarter), y_offset), _mm256_set1_ps(params->y_factor));
+        const __m256 uu = _mm256_sub_ps(_mm256_mul_ps(uf, quarter), bias);
+        const __m256 vv = _mm256_sub_ps(_mm256_mul_ps(vf, quarter), bias);
+        const __m256i r = YUV10_Clamp_AVX2(_mm256_add_ps(yy, _mm256_mul_ps(_mm256_set1_ps(params->v_r_factor), vv)), max);
+        const __m256i g = YUV10_Clamp_AVX2(_mm256_add_ps(_mm256_add_ps(yy, _mm256_mul_ps(_mm256_set1_ps(params->u_g_factor), uu)),
+                                                         _mm256_mul_ps(_mm256_set1_ps(params->v_g_factor), vv)), max);
+        const __m256i b = YUV10_Clamp_AVX2(_mm256_add_ps(yy, _mm256_mul_ps(_mm256_set1_ps(params->u_b_factor), uu)), max);
+        __m256i pixels = _mm256_or_si256(_mm256_sll_epi32(r, r_shift), _mm256_sll_epi32(g, g_shift));
+
+        pixels = _mm256_or_si256(pixels, _mm256_or_si256(_mm256_sll_epi32(b, b_shift), fill));
+        _mm256_storeu_si256((__m256i *)(dst + i), pixels);
+    }
+    return i;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE __m128i SDL_TARGETING("sse2") YUV10_Clamp_SSE2(__m128 value, __m128 max)
+{
+    value = _mm_add_ps(value, _mm_set1_ps(0.5f));
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), max);
+    return _mm_cvttps_epi32(value);
+}
+
+static int SDL_TARGETING("sse2") YUV10_to_RGB_SSE2(const Uint16 *y, const Uint16 *u, const Uint16 *v, int width, Uint32 *dst, const YUV10toRGBParams *params)
+{
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const __m128 y_offset = _mm_set1_ps(params->y_offset);
+    const __m128 bias = _mm_set1_ps(128.0f);
+    const __m128 max = _mm_set1_ps(params->max);
+    const __m128i r_shift = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i g_shift = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i b_shift = _mm_cvtsi32_si128(params->shift[2]);
+    const __m128i fill = _mm_set1_epi32((int)params->fill);
+    const __m128i zero = _mm_setzero_si128();
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128 yf = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(y + i)), zero));
+        const __m128 uf = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(u + i)), zero));
+        const __m128 vf = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(v + i)), zero));
+        const __m128 yy = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(yf, quarter), y_offset), _mm_set1_ps(params->y_factor));
+        const __m128 uu = _mm_sub_ps(_mm_mul_ps(uf, quarter), bias);
+        const __m128 vv = _mm_sub_ps(_mm_mul_ps(vf, quarter), bias);
+        const __m128i r = YUV10_Clamp_SSE2(_mm_add_ps(yy, _mm_mul_ps(_mm_set1_ps(params->v_r_factor), vv)), max);
+        const __m128i g = YUV10_Clamp_SSE2(_mm_add_ps(_mm_add_ps(yy, _mm_mul_ps(_mm_set1_ps(params->u_g_factor), uu)),
+                                                      _mm_mul_ps(_mm_set1_ps(params->v_g_factor), vv)), max);
+        const __m128i b = YUV10_Clamp_SSE2(_mm_add_ps(yy, _mm_mul_ps(_mm_set1_ps(params->u_b_factor), uu)), max);
+        __m128i pixels = _mm_or_si128(_mm_sll_epi32(r, r_shift), _mm_sll_epi32(g, g_shift));
+
+        pixels = _mm_or_si128(pixels, _mm_or_si128(_mm_sll_epi32(b, b_shift), fill));
+        _mm_storeu_si128((__m128i *)(dst + i), pixels);
+    }
+    return i;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE uint32x4_t YUV10_Clamp_NEON(float32x4_t value, float32x4_t max)
+{
+    value = vaddq_f32(value, vdupq_n_f32(0.5f));
+    value = vminq_f32(vmaxq_f32(value, vdupq_n_f32(0.0f)), max);
+    return vcvtq_u32_f32(value);
+}
+
+static int YUV10_to_RGB_NEON(const Uint16 *y, const Uint16 *u, const Uint16 *v, int width, Uint32 *dst, const YUV10toRGBParams *params)
+{
+    const float32x4_t y_offset = vdupq_n_f32(params->y_offset);
+    const float32x4_t bias = vdupq_n_f32(128.0f);
+    const float32x4_t max = vdupq_n_f32(params->max);
+    const int32x4_t r_shift = vdupq_n_s32(params->shift[0]);
+    const int32x4_t g_shift = vdupq_n_s32(params->shift[1]);
+    const int32x4_t b_shift = vdupq_n_s32(params->shift[2]);
+    const uint32x4_t fill = vdupq_n_u32(params->fill);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const float32x4_t yf = vcvtq_f32_u32(vmovl_u16(vld1_u16(y + i)));
+        const float32x4_t uf = vcvtq_f32_u32(vmovl_u16(vld1_u16(u + i)));
+        const float32x4_t vf = vcvtq_f32_u32(vmovl_u16(vld1_u16(v + i)));
+        const float32x4_t yy = vmulq_n_f32(vsubq_f32(vmulq_n_f32(yf, 0.25f), y_offset), params->y_factor);
+        const float32x4_t uu = vsubq_f32(vmulq_n_f32(uf, 0.25f), bias);
+        const float32x4_t vv = vsubq_f32(vmulq_n_f32(vf, 0.25f), bias);
+        const uint32x4_t r = YUV10_Clamp_NEON(vaddq_f32(yy, vmulq_n_f32(vv, params->v_r_factor)), max);
+        const uint32x4_t g = YUV10_Clamp_NEON(vaddq_f32(vaddq_f32(yy, vmulq_n_f32(uu, params->u_g_factor)),
+                                                        vmulq_n_f32(vv, params->v_g_factor)), max);
+        const uint32x4_t b = YUV10_Clamp_NEON(vaddq_f32(yy, vmulq_n_f32(uu, params->u_b_factor)), max);
+        uint32x4_t pixels = vorrq_u32(vshlq_u32(r, r_shift), vshlq_u32(g, g_shift));
+
+        pixels = vorrq_u32(pixels, vorrq_u32(vshlq_u32(b, b_shift), fill));
+        vst1q_u32(dst + i, pixels);
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Reads part of a row as 10-bit samples, repeating the chroma of the 2x2 formats for both pixels */
+static void GetYUV10Samples(Uint32 format, const Uint8 *y, const Uint8 *u, const Uint8 *v, int x, int count,
+                            Uint16 *y10, Uint16 *u10, Uint16 *v10)
+{
+    int i;
+
+    if (IsP01xFormat(format)) {
+        const Uint16 *y16 = (const Uint16 *)y + x;
+        const Uint16 *u16 = (const Uint16 *)u;
+        const Uint16 *v16 = (const Uint16 *)v;
+
+        for (i = 0; i < count; ++i) {
+            const int uv = ((x + i) / 2) * 2;
+
+            y10[i] = SDL_SwapLE16(y16[i]) >> 6;
+            u10[i] = SDL_SwapLE16(u16[uv]) >> 6;
+            v10[i] = SDL_SwapLE16(v16[uv]) >> 6;
+        }
+    } else {
+        y += x;
+        u += x;
+        v += x;
+        for (i = 0; i < count; ++i) {
+            y10[i] = (Uint16)(y[i] << 2);
+            u10[i] = (Uint16)(u[i] << 2);
+            v10[i] = (Uint16)(v[i] << 2);
+        }
+    }
+}
+
+static SDL_bool YUV10_to_RGB_Rows(const YUVConversionJob *job, int rows,
+                                  const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+                                  Uint8 *dst, Uint32 dst_pitch, YCbCrType yuv_type)
+{
+    const int uv_shift = IsP01xFormat(job->src_format) ? 1 : 0;
+    Uint16 y10[YUV10_ROW_CHUNK], u10[YUV10_ROW_CHUNK], v10[YUV10_ROW_CHUNK];
+    YUV10toRGBParams params;
+    YUV10toRGBFunc kernel = NULL;
+    int i, j, x, count;
+
+    if ((!IsP01xFormat(job->src_format) && !IsPlanar444Format(job->src_format)) ||
+        !GetYUV10toRGBParams(job->dst_format, yuv_type, &params)) {
+        return SDL_FALSE;
+    }
 
-        switch (dst_format) {
-        case SDL_PIXELFORMAT_RGB565:
-            yuvnv12_rgb565_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        case SDL_PIXELFORMAT_RGB24:
-            yuvnv12_rgb24_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        case SDL_PIXELFORMAT_RGBX8888:
-        case SDL_PIXELFORMAT_RGBA8888:
-            yuvnv12_rgba_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        case SDL_PIXELFORMAT_BGRX8888:
-        case SDL_PIXELFORMAT_BGRA8888:
-            yuvnv12_bgra_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        case SDL_PIXELFORMAT_XRGB8888:
-        case SDL_PIXELFORMAT_ARGB8888:
-            yuvnv12_argb_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        case SDL_PIXELFORMAT_XBGR8888:
-        case SDL_PIXELFORMAT_ABGR8888:
-            yuvnv12_abgr_std(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
-            return SDL_TRUE;
-        default:
-            break;
+#ifdef SDL_AVX2_INTRINSICS
+    if (!kernel && SDL_HasAVX2()) {
+        kernel = YUV10_to_RGB_AVX2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!kernel && SDL_HasNEON()) {
+        kernel = YUV10_to_RGB_NEON;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (!kernel && SDL_HasSSE2()) {
+        kernel = YUV10_to_RGB_SSE2;
+    }
+#endif
+
+    for (j = 0; j < rows; ++j) {
+        const Uint8 *y_row = y + (size_t)j * y_stride;
+        const Uint8 *u_row = u + (size_t)(j >> uv_shift) * uv_stride;
+        const Uint8 *v_row = v + (size_t)(j >> uv_shift) * uv_stride;
+        Uint32 *dst_row = (Uint32 *)(dst + (size_t)j * dst_pitch);
+
+        for (x = 0; x < job->width; x += count) {
+            count = SDL_min(job->width - x, YUV10_ROW_CHUNK);
+            GetYUV10Samples(job->src_format, y_row, u_row, v_row, x, count, y10, u10, v10);
+            i = 0;
+            if (kernel) {
+                i = kernel(y10, u10, v10, count, dst_row + x, &params);
+            }
+            for (; i < count; ++i) {
+                dst_row[x + i] = YUV10_to_RGB_Pixel(y10[i], u10[i], v10[i], &params);
+            }
         }
     }
-    return SDL_FALSE;
+    return SDL_TRUE;
 }
 
-int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
-                                 Uint32 src_format, const void *src, int src_pitch,
-                                 Uint32 dst_format, void *dst, int dst_pitch)
+static SDL_bool YUV_to_RGB_Rows(const YUVConversionJob *job, int rows,
+                                const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+                                Uint8 *dst, Uint32 dst_pitch, YCbCrType yuv_type)
+{
+    return yuv_rgb_avx2(job->src_format, job->dst_format, job->width, rows, y, u, v, y_stride, uv_stride, dst, dst_pitch, yuv_type) ||
+           yuv_rgb_neon(job->src_format, job->dst_format, job->width, rows, y, u, v, y_stride, uv_stride, dst, dst_pitch, yuv_type) ||
+           yuv_rgb_sse(job->src_format, job->dst_format, job->width, rows, y, u, v, y_stride, uv_stride, dst, dst_pitch, yuv_type) ||
+           yuv_rgb_lsx(job->src_format, job->dst_format, job->width, rows, y, u, v, y_stride, uv_stride, dst, dst_pitch, yuv_type) ||
+           yuv_rgb_std(job->src_format, job->dst_format, job->width, rows, y, u, v, y_stride, uv_stride, dst, dst_pitch, yuv_type);
+}
+
+static void YUV_to_RGB_Band(void *userdata, int row, int rows)
 {
+    YUVConversionJob *job = (YUVConversionJob *)userdata;
     const Uint8 *y = NULL;
     const Uint8 *u = NULL;
     const Uint8 *v = NULL;
     Uint32 y_stride = 0;
     Uint32 uv_stride = 0;
     YCbCrType yuv_type = YCBCR_601;
-
-    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
-        return -1;
-    }
-
-    if (GetYUVConversionType(width, height, &yuv_type) < 0) {
-        return -1;
-    }
-
-    if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
-    }
-
-    if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
+    Uint8 *dst = (Uint8 *)job->dst + (size_t)row * job->dst_pitch;
+    int result = -1;
+
+    /* The conversion type follows the size of the whole image */
+    if (GetYUVBandPlanes(job->width, job->height, job->src_format, job->src, job->src_pitch, row, &y, &u, &v, &y_stride, &uv_stride) == 0 &&
+        GetYUVConversionType(job->width, job->height, &yuv_type) == 0) {
+        if (YUV_to_RGB_Rows(job, rows, y, u, v, y_stride, uv_stride, dst, job->dst_pitch, yuv_type) ||
+            YUV10_to_RGB_Rows(job, rows, y, u, v, y_stride, uv_stride, dst, job->dst_pitch, yuv_type)) {
+            result = 0;
+
+            /* The 4:2:2 kernels convert the last row they are given with the scalar code,
+               to avoid reading past the end of the image. Convert the last row of a band
+               again together with the next one, so the result matches an undivided image. */
+            if (IsPacked4Format(job->src_format) && row + rows < job->height) {
+                const size_t row_size = (size_t)job->width * SDL_BYTESPERPIXEL(job->dst_format);
+                const size_t last = (size_t)(rows - 1);
+                Uint8 *tmp = (Uint8 *)SDL_malloc(row_size * 2);
+                if (tmp) {
+                    YUV_to_RGB_Rows(job, 2, y + last * y_stride, u + last * uv_stride, v + last * uv_stride, y_stride, uv_stride, tmp, (Uint32)row_size, yuv_type);
+                    SDL_memcpy(dst + last * job->dst_pitch, tmp, row_size);
+                    SDL_free(tmp);
+                }
+            }
+        } else {
+            /* No fast path for this pair of formats */
+            result = 1;
+        }
     }
 
-    if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
+    /* Every band gets the same result, and the first one runs on the calling thread */
+    if (row == 0) {
+        job->result = result;
     }
+}
 
-    /* No fast path for the RGB format, instead convert using an intermediate buffer */
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
+                                 Uint32 src_format, const void *src, int src_pitch,
+                                 Uint32 dst_format, void *dst, int dst_pitch)
+{
+    const Uint32 tmp_format = IsP01xFormat(src_format) ? SDL_PIXELFORMAT_ARGB2101010 : SDL_PIXELFORMAT_ARGB8888;
+    YUVConversionJob job;
+
+    job.width = width;
+    job.height = height;
+    job.src_format = src_format;
+    job.src = src;
+    job.src_pitch = src_pitch;
+    job.dst_format = dst_format;
+    job.dst = dst;
+    job.dst_pitch = dst_pitch;
+    job.result = -1;
+
+    /* Bands of the 2x2 formats need to start on even rows */
+    if (!SDL_RunThreadedBands(YUV_to_RGB_Band, &job, width, height, 2)) {
+        YUV_to_RGB_Band(&job, 0, height);
+    }
+    if (job.result <= 0) {
+        return job.result;
+    }
+
+    /* No fast path for the RGB format, instead convert using an intermediate buffer,
+       which keeps 10 bits per channel for the formats with 16-bit samples */
+    if (dst_format != tmp_format) {
         int ret;
         void *tmp;
         int tmp_pitch = (width * sizeof(Uint32));
@@ -619,15 +1346,15 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
             return SDL_OutOfMemory();
         }
 
-        /* convert src/src_format to tmp/ARGB8888 */
-        ret = SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src, src_pitch, SDL_PIXELFORMAT_ARGB8888, tmp, tmp_pitch);
+        /* convert src/src_format to tmp/tmp_format */
+        ret = SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src, src_pitch, tmp_format, tmp, tmp_pitch);
         if (ret < 0) {
             SDL_free(tmp);
             return ret;
         }
 
-        /* convert tmp/ARGB8888 to dst/RGB */
-        ret = SDL_ConvertPixels(width, height, SDL_PIXELFORMAT_ARGB8888, tmp, tmp_pitch, dst_format, dst, dst_pitch);
+        /* convert tmp/tmp_format to dst/RGB */
+        ret = SDL_ConvertPixels(width, height, tmp_format, tmp, tmp_pitch, dst_format, dst, dst_pitch);
         SDL_free(tmp);
         return ret;
     }
@@ -643,7 +1370,290 @@ struct RGB2YUVFactors
     float v[3]; /* Rfactor, Gfactor, Bfactor */
 };
 
-static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
+/* Bit offsets of the red, green and blue channels in a 32-bit pixel, used to read
+   the common 8888 formats directly */
+typedef struct
+{
+    int shift[3];
+    const struct RGB2YUVFactors *cvt;
+} RGB8888toYUVParams;
+
+/* Converts part of a row to Y, returning the number of pixels converted */
+typedef int (*RGB8888toYFunc)(const Uint8 *src, int width, Uint8 *plane_y, const RGB8888toYUVParams *params);
+
+/* Converts part of a pair of rows to chroma, returning the number of samples written.
+   If uv_step is 2 the samples are interleaved, in the order of plane_u and plane_v. */
+typedef int (*RGB8888toUVFunc)(const Uint8 *curr_row, const Uint8 *next_row, int width_half, Uint8 *plane_u, Uint8 *plane_v, int uv_step, const RGB8888toYUVParams *params);
+
+/* The kernels use the same float arithmetic as the MAKE_* macros below, in the same order,
+   and wrap to 8 bits the same way, so they give identical results. */
+
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256 SDL_TARGETING("avx2") RGB8888_Channel_AVX2(__m256i p, __m128i shift)
+{
+    return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(p, shift), _mm256_set1_epi32(0xff)));
+}
+
+/* Averages 2x2 blocks of one channel from two rows of 16 pixels, with the result in pixel order */
+static SDL_INLINE __m256 SDL_TARGETING("avx2") RGB8888_Channel2x2_AVX2(__m256i c0, __m256i c1, __m256i n0, __m256i n1, __m128i shift)
+{
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256 s0 = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_and_si256(_mm256_srl_epi32(c0, shift), mask), _mm256_and_si256(_mm256_srl_epi32(n0, shift), mask)));
+    const __m256 s1 = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_and_si256(_mm256_srl_epi32(c1, shift), mask), _mm256_and_si256(_mm256_srl_epi32(n1, shift), mask)));
+    __m256i sum = _mm256_add_epi32(_mm256_castps_si256(_mm256_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0))),
+                                   _mm256_castps_si256(_mm256_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1))));
+    sum = _mm256_permute4x64_epi64(sum, _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm256_cvtepi32_ps(_mm256_srli_epi32(sum, 2));
+}
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") RGB8888_MakeYUV_AVX2(__m256 r, __m256 g, __m256 b, const float *factors, int offset)
+{
+    __m256 x = _mm256_mul_ps(_mm256_set1_ps(factors[0]), r);
+    x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(factors[1]), g));
+    x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(factors[2]), b));
+    x = _mm256_add_ps(x, _mm256_set1_ps(0.5f));
+    return _mm256_and_si256(_mm256_add_epi32(_mm256_cvttps_epi32(x), _mm256_set1_epi32(offset)), _mm256_set1_epi32(0xff));
+}
+
+/* Packs two vectors of 8 values in 0-255 to 16 ordered 16-bit values */
+static SDL_INLINE __m256i SDL_TARGETING("avx2") RGB8888_Pack16_AVX2(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static int SDL_TARGETING("avx2") RGB8888_to_Y_AVX2(const Uint8 *src, int width, Uint8 *plane_y, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const __m128i rs = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i gs = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i bs = _mm_cvtsi32_si128(params->shift[2]);
+    int i;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        const __m256i p0 = _mm256_loadu_si256((const __m256i *)(src + i * 4));
+        const __m256i p1 = _mm256_loadu_si256((const __m256i *)(src + i * 4 + 32));
+        const __m256i y0 = RGB8888_MakeYUV_AVX2(RGB8888_Channel_AVX2(p0, rs), RGB8888_Channel_AVX2(p0, gs), RGB8888_Channel_AVX2(p0, bs), cvt->y, cvt->y_offset);
+        const __m256i y1 = RGB8888_MakeYUV_AVX2(RGB8888_Channel_AVX2(p1, rs), RGB8888_Channel_AVX2(p1, gs), RGB8888_Channel_AVX2(p1, bs), cvt->y, cvt->y_offset);
+        __m256i y = RGB8888_Pack16_AVX2(y0, y1);
+
+        y = _mm256_permute4x64_epi64(_mm256_packus_epi16(y, y), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128((__m128i *)(plane_y + i), _mm256_castsi256_si128(y));
+    }
+    return i;
+}
+
+static int SDL_TARGETING("avx2") RGB8888_to_UV_AVX2(const Uint8 *curr_row, const Uint8 *next_row, int width_half, Uint8 *plane_u, Uint8 *plane_v, int uv_step, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const __m128i rs = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i gs = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i bs = _mm_cvtsi32_si128(params->shift[2]);
+    int i, k;
+
+    for (i = 0; i + 16 <= width_half; i += 16) {
+        __m256i u[2], v[2], uv;
+        __m128i u_8, v_8;
+
+        for (k = 0; k < 2; ++k) {
+            const __m256i c0 = _mm256_loadu_si256((const __m256i *)(curr_row + (i + k * 8) * 8));
+            const __m256i c1 = _mm256_loadu_si256((const __m256i *)(curr_row + (i + k * 8) * 8 + 32));
+            const __m256i n0 = _mm256_loadu_si256((const __m256i *)(next_row + (i + k * 8) * 8));
+            const __m256i n1 = _mm256_loadu_si256((const __m256i *)(next_row + (i + k * 8) * 8 + 32));
+            const __m256 r = RGB8888_Channel2x2_AVX2(c0, c1, n0, n1, rs);
+            const __m256 g = RGB8888_Channel2x2_AVX2(c0, c1, n0, n1, gs);
+            const __m256 b = RGB8888_Channel2x2_AVX2(c0, c1, n0, n1, bs);
+
+            u[k] = RGB8888_MakeYUV_AVX2(r, g, b, cvt->u, 128);
+            v[k] = RGB8888_MakeYUV_AVX2(r, g, b, cvt->v, 128);
+        }
+        uv = _mm256_packus_epi16(RGB8888_Pack16_AVX2(u[0], u[1]), RGB8888_Pack16_AVX2(v[0], v[1]));
+        uv = _mm256_permute4x64_epi64(uv, _MM_SHUFFLE(3, 1, 2, 0));
+        u_8 = _mm256_castsi256_si128(uv);
+        v_8 = _mm256_extracti128_si256(uv, 1);
+
+        if (uv_step == 1) {
+            _mm_storeu_si128((__m128i *)(plane_u + i), u_8);
+            _mm_storeu_si128((__m128i *)(plane_v + i), v_8);
+        } else if (plane_u < plane_v) {
+            _mm_storeu_si128((__m128i *)(plane_u + i * 2), _mm_unpacklo_epi8(u_8, v_8));
+            _mm_storeu_si128((__m128i *)(plane_u + i * 2 + 16), _mm_unpackhi_epi8(u_8, v_8));
+        } else {
+            _mm_storeu_si128((__m128i *)(plane_v + i * 2), _mm_unpacklo_epi8(v_8, u_8));
+            _mm_storeu_si128((__m128i *)(plane_v + i * 2 + 16), _mm_unpackhi_epi8(v_8, u_8));
+        }
+    }
+    return i;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE __m128 SDL_TARGETING("sse2") RGB8888_Channel_SSE2(__m128i p, __m128i shift)
+{
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(p, shift), _mm_set1_epi32(0xff)));
+}
+
+/* Averages 2x2 blocks of one channel from two rows of 8 pixels */
+static SDL_INLINE __m128 SDL_TARGETING("sse2") RGB8888_Channel2x2_SSE2(__m128i c0, __m128i c1, __m128i n0, __m128i n1, __m128i shift)
+{
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128 s0 = _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(_mm_srl_epi32(c0, shift), mask), _mm_and_si128(_mm_srl_epi32(n0, shift), mask)));
+    const __m128 s1 = _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(_mm_srl_epi32(c1, shift), mask), _mm_and_si128(_mm_srl_epi32(n1, shift), mask)));
+    const __m128i sum = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0))),
+                                      _mm_castps_si128(_mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1))));
+    return _mm_cvtepi32_ps(_mm_srli_epi32(sum, 2));
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") RGB8888_MakeYUV_SSE2(__m128 r, __m128 g, __m128 b, const float *factors, int offset)
+{
+    __m128 x = _mm_mul_ps(_mm_set1_ps(factors[0]), r);
+    x = _mm_add_ps(x, _mm_mul_ps(_mm_set1_ps(factors[1]), g));
+    x = _mm_add_ps(x, _mm_mul_ps(_mm_set1_ps(factors[2]), b));
+    x = _mm_add_ps(x, _mm_set1_ps(0.5f));
+    return _mm_and_si128(_mm_add_epi32(_mm_cvttps_epi32(x), _mm_set1_epi32(offset)), _mm_set1_epi32(0xff));
+}
+
+static int SDL_TARGETING("sse2") RGB8888_to_Y_SSE2(const Uint8 *src, int width, Uint8 *plane_y, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const __m128i rs = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i gs = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i bs = _mm_cvtsi32_si128(params->shift[2]);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i *)(src + i * 4));
+        const __m128i p1 = _mm_loadu_si128((const __m128i *)(src + i * 4 + 16));
+        const __m128i y0 = RGB8888_MakeYUV_SSE2(RGB8888_Channel_SSE2(p0, rs), RGB8888_Channel_SSE2(p0, gs), RGB8888_Channel_SSE2(p0, bs), cvt->y, cvt->y_offset);
+        const __m128i y1 = RGB8888_MakeYUV_SSE2(RGB8888_Channel_SSE2(p1, rs), RGB8888_Channel_SSE2(p1, gs), RGB8888_Channel_SSE2(p1, bs), cvt->y, cvt->y_offset);
+        const __m128i y = _mm_packs_epi32(y0, y1);
+
+        _mm_storel_epi64((__m128i *)(plane_y + i), _mm_packus_epi16(y, y));
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") RGB8888_to_UV_SSE2(const Uint8 *curr_row, const Uint8 *next_row, int width_half, Uint8 *plane_u, Uint8 *plane_v, int uv_step, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const __m128i rs = _mm_cvtsi32_si128(params->shift[0]);
+    const __m128i gs = _mm_cvtsi32_si128(params->shift[1]);
+    const __m128i bs = _mm_cvtsi32_si128(params->shift[2]);
+    int i, k;
+
+    for (i = 0; i + 8 <= width_half; i += 8) {
+        __m128i u[2], v[2], uv, vu;
+
+        for (k = 0; k < 2; ++k) {
+            const __m128i c0 = _mm_loadu_si128((const __m128i *)(curr_row + (i + k * 4) * 8));
+            const __m128i c1 = _mm_loadu_si128((const __m128i *)(curr_row + (i + k * 4) * 8 + 16));
+            const __m128i n0 = _mm_loadu_si128((const __m128i *)(next_row + (i + k * 4) * 8));
+            const __m128i n1 = _mm_loadu_si128((const __m128i *)(next_row + (i + k * 4) * 8 + 16));
+            const __m128 r = RGB8888_Channel2x2_SSE2(c0, c1, n0, n1, rs);
+            const __m128 g = RGB8888_Channel2x2_SSE2(c0, c1, n0, n1, gs);
+            const __m128 b = RGB8888_Channel2x2_SSE2(c0, c1, n0, n1, bs);
+
+            u[k] = RGB8888_MakeYUV_SSE2(r, g, b, cvt->u, 128);
+            v[k] = RGB8888_MakeYUV_SSE2(r, g, b, cvt->v, 128);
+        }
+        /* U in the low half, V in the high half */
+        uv = _mm_packus_epi16(_mm_packs_epi32(u[0], u[1]), _mm_packs_epi32(v[0], v[1]));
+        vu = _mm_srli_si128(uv, 8);
+
+        if (uv_step == 1) {
+            _mm_storel_epi64((__m128i *)(plane_u + i), uv);
+            _mm_storel_epi64((__m128i *)(plane_v + i), vu);
+        } else if (plane_u < plane_v) {
+            _mm_storeu_si128((__m128i *)(plane_u + i * 2), _mm_unpacklo_epi8(uv, vu));
+        } else {
+            _mm_storeu_si128((__m128i *)(plane_v + i * 2), _mm_unpacklo_epi8(vu, uv));
+        }
+    }
+    return i;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* Returns the index of the byte holding the channel at the given bit offset */
+static int RGB8888_ChannelIndex_NEON(int shift)
+{
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    return 3 - shift / 8;
+#else
+    return shift / 8;
+#endif
+}
+
+static SDL_INLINE int32x4_t RGB8888_MakeYUV4_NEON(uint16x4_t r, uint16x4_t g, uint16x4_t b, const float *factors, int offset)
+{
+    float32x4_t x = vmulq_f32(vdupq_n_f32(factors[0]), vcvtq_f32_u32(vmovl_u16(r)));
+    x = vaddq_f32(x, vmulq_f32(vdupq_n_f32(factors[1]), vcvtq_f32_u32(vmovl_u16(g))));
+    x = vaddq_f32(x, vmulq_f32(vdupq_n_f32(factors[2]), vcvtq_f32_u32(vmovl_u16(b))));
+    x = vaddq_f32(x, vdupq_n_f32(0.5f));
+    return vaddq_s32(vcvtq_s32_f32(x), vdupq_n_s32(offset));
+}
+
+/* The narrowing moves keep the low 8 bits, like the casts in the C code */
+static SDL_INLINE uint8x8_t RGB8888_MakeYUV_NEON(uint16x8_t r, uint16x8_t g, uint16x8_t b, const float *factors, int offset)
+{
+    const int32x4_t lo = RGB8888_MakeYUV4_NEON(vget_low_u16(r), vget_low_u16(g), vget_low_u16(b), factors, offset);
+    const int32x4_t hi = RGB8888_MakeYUV4_NEON(vget_high_u16(r), vget_high_u16(g), vget_high_u16(b), factors, offset);
+    return vmovn_u16(vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(lo)), vmovn_u32(vreinterpretq_u32_s32(hi))));
+}
+
+static int RGB8888_to_Y_NEON(const Uint8 *src, int width, Uint8 *plane_y, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const int ri = RGB8888_ChannelIndex_NEON(params->shift[0]);
+    const int gi = RGB8888_ChannelIndex_NEON(params->shift[1]);
+    const int bi = RGB8888_ChannelIndex_NEON(params->shift[2]);
+    int i;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        const uint8x16x4_t p = vld4q_u8(src + i * 4);
+        const uint8x8_t y0 = RGB8888_MakeYUV_NEON(vmovl_u8(vget_low_u8(p.val[ri])), vmovl_u8(vget_low_u8(p.val[gi])), vmovl_u8(vget_low_u8(p.val[bi])), cvt->y, cvt->y_offset);
+        const uint8x8_t y1 = RGB8888_MakeYUV_NEON(vmovl_u8(vget_high_u8(p.val[ri])), vmovl_u8(vget_high_u8(p.val[gi])), vmovl_u8(vget_high_u8(p.val[bi])), cvt->y, cvt->y_offset);
+
+        vst1q_u8(plane_y + i, vcombine_u8(y0, y1));
+    }
+    return i;
+}
+
+static int RGB8888_to_UV_NEON(const Uint8 *curr_row, const Uint8 *next_row, int width_half, Uint8 *plane_u, Uint8 *plane_v, int uv_step, const RGB8888toYUVParams *params)
+{
+    const struct RGB2YUVFactors *cvt = params->cvt;
+    const int ri = RGB8888_ChannelIndex_NEON(params->shift[0]);
+    const int gi = RGB8888_ChannelIndex_NEON(params->shift[1]);
+    const int bi = RGB8888_ChannelIndex_NEON(params->shift[2]);
+    int i;
+
+    for (i = 0; i + 8 <= width_half; i += 8) {
+        const uint8x16x4_t c = vld4q_u8(curr_row + i * 8);
+        const uint8x16x4_t n = vld4q_u8(next_row + i * 8);
+        const uint16x8_t r = vshrq_n_u16(vaddq_u16(vpaddlq_u8(c.val[ri]), vpaddlq_u8(n.val[ri])), 2);
+        const uint16x8_t g = vshrq_n_u16(vaddq_u16(vpaddlq_u8(c.val[gi]), vpaddlq_u8(n.val[gi])), 2);
+        const uint16x8_t b = vshrq_n_u16(vaddq_u16(vpaddlq_u8(c.val[bi]), vpaddlq_u8(n.val[bi])), 2);
+        uint8x8x2_t uv;
+
+        uv.val[0] = RGB8888_MakeYUV_NEON(r, g, b, cvt->u, 128);
+        uv.val[1] = RGB8888_MakeYUV_NEON(r, g, b, cvt->v, 128);
+
+        if (uv_step == 1) {
+            vst1_u8(plane_u + i, uv.val[0]);
+            vst1_u8(plane_v + i, uv.val[1]);
+        } else if (plane_u < plane_v) {
+            vst2_u8(plane_u + i * 2, uv);
+        } else {
+            const uint8x8_t u = uv.val[0];
+            uv.val[0] = uv.val[1];
+            uv.val[1] = u;
+            vst2_u8(plane_v + i * 2, uv);
+        }
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static int SDL_ConvertPixels_8888_to_YUV(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
 {
     const int src_pitch_x_2 = src_pitch * 2;
     const int height_half = height / 2;
@@ -676,49 +1686,82 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
         },
     };
     const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[SDL_GetYUVConversionModeForResolution(width, height)];
+    RGB8888toYUVParams params;
+    RGB8888toYFunc row_y = NULL;
+    RGB8888toUVFunc row_uv = NULL;
+    int rshift, gshift, bshift;
+
+    if (!GetRGB8888Shifts(src_format, params.shift)) {
+        return SDL_SetError("Unsupported RGB source format: %s", SDL_GetPixelFormatName(src_format));
+    }
+    params.cvt = cvt;
+    rshift = params.shift[0];
+    gshift = params.shift[1];
+    bshift = params.shift[2];
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (!row_y && SDL_HasAVX2()) {
+        row_y = RGB8888_to_Y_AVX2;
+        row_uv = RGB8888_to_UV_AVX2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!row_y && SDL_HasNEON()) {
+        row_y = RGB8888_to_Y_NEON;
+        row_uv = RGB8888_to_UV_NEON;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (!row_y && SDL_HasSSE2()) {
+        row_y = RGB8888_to_Y_SSE2;
+        row_uv = RGB8888_to_UV_SSE2;
+    }
+#endif
 
 #define MAKE_Y(r, g, b) (Uint8)((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset)
 #define MAKE_U(r, g, b) (Uint8)((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 128)
 #define MAKE_V(r, g, b) (Uint8)((int)(cvt->v[0] * (r) + cvt->v[1] * (g) + cvt->v[2] * (b) + 0.5f) + 128)
 
-#define READ_2x2_PIXELS                                                                                     \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];                                                    \
-    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];                                                \
-    const Uint32 p3 = ((const Uint32 *)next_row)[2 * i];                                                    \
-    const Uint32 p4 = ((const Uint32 *)next_row)[2 * i + 1];                                                \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000) + (p3 & 0x00ff0000) + (p4 & 0x00ff0000)) >> 18; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00) + (p3 & 0x0000ff00) + (p4 & 0x0000ff00)) >> 10; \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff) + (p3 & 0x000000ff) + (p4 & 0x000000ff)) >> 2;
-
-#define READ_2x1_PIXELS                                             \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];            \
-    const Uint32 p2 = ((const Uint32 *)next_row)[2 * i];            \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000)) >> 17; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00)) >> 9;  \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff)) >> 1;
-
-#define READ_1x2_PIXELS                                             \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];            \
-    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];        \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000)) >> 17; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00)) >> 9;  \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff)) >> 1;
+#define CHANNEL(p, shift) (((p) >> (shift)) & 0xff)
+
+#define READ_2x2_PIXELS                                                                                            \
+    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];                                                           \
+    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];                                                       \
+    const Uint32 p3 = ((const Uint32 *)next_row)[2 * i];                                                           \
+    const Uint32 p4 = ((const Uint32 *)next_row)[2 * i + 1];                                                       \
+    const Uint32 r = (CHANNEL(p1, rshift) + CHANNEL(p2, rshift) + CHANNEL(p3, rshift) + CHANNEL(p4, rshift)) >> 2; \
+    const Uint32 g = (CHANNEL(p1, gshift) + CHANNEL(p2, gshift) + CHANNEL(p3, gshift) + CHANNEL(p4, gshift)) >> 2; \
+    const Uint32 b = (CHANNEL(p1, bshift) + CHANNEL(p2, bshift) + CHANNEL(p3, bshift) + CHANNEL(p4, bshift)) >> 2;
+
+#define READ_2x1_PIXELS                                                \
+    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];               \
+    const Uint32 p2 = ((const Uint32 *)next_row)[2 * i];               \
+    const Uint32 r = (CHANNEL(p1, rshift) + CHANNEL(p2, rshift)) >> 1; \
+    const Uint32 g = (CHANNEL(p1, gshift) + CHANNEL(p2, gshift)) >> 1; \
+    const Uint32 b = (CHANNEL(p1, bshift) + CHANNEL(p2, bshift)) >> 1;
+
+#define READ_1x2_PIXELS                                                \
+    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];               \
+    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];           \
+    const Uint32 r = (CHANNEL(p1, rshift) + CHANNEL(p2, rshift)) >> 1; \
+    const Uint32 g = (CHANNEL(p1, gshift) + CHANNEL(p2, gshift)) >> 1; \
+    const Uint32 b = (CHANNEL(p1, bshift) + CHANNEL(p2, bshift)) >> 1;
 
 #define READ_1x1_PIXEL                                  \
     const Uint32 p = ((const Uint32 *)curr_row)[2 * i]; \
-    const Uint32 r = (p & 0x00ff0000) >> 16;            \
-    const Uint32 g = (p & 0x0000ff00) >> 8;             \
-    const Uint32 b = (p & 0x000000ff);
+    const Uint32 r = CHANNEL(p, rshift);                \
+    const Uint32 g = CHANNEL(p, gshift);                \
+    const Uint32 b = CHANNEL(p, bshift);
 
 #define READ_TWO_RGB_PIXELS                                  \
     const Uint32 p = ((const Uint32 *)curr_row)[2 * i];      \
-    const Uint32 r = (p & 0x00ff0000) >> 16;                 \
-    const Uint32 g = (p & 0x0000ff00) >> 8;                  \
-    const Uint32 b = (p & 0x000000ff);                       \
+    const Uint32 r = CHANNEL(p, rshift);                     \
+    const Uint32 g = CHANNEL(p, gshift);                     \
+    const Uint32 b = CHANNEL(p, bshift);                     \
     const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i + 1]; \
-    const Uint32 r1 = (p1 & 0x00ff0000) >> 16;               \
-    const Uint32 g1 = (p1 & 0x0000ff00) >> 8;                \
-    const Uint32 b1 = (p1 & 0x000000ff);                     \
+    const Uint32 r1 = CHANNEL(p1, rshift);                   \
+    const Uint32 g1 = CHANNEL(p1, gshift);                   \
+    const Uint32 b1 = CHANNEL(p1, bshift);                   \
     const Uint32 R = (r + r1) / 2;                           \
     const Uint32 G = (g + g1) / 2;                           \
     const Uint32 B = (b + b1) / 2;
@@ -733,11 +1776,11 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     {
         const Uint8 *curr_row, *next_row;
 
-        Uint8 *plane_y;
-        Uint8 *plane_u;
-        Uint8 *plane_v;
+        Uint8 *plane_y = NULL;
+        Uint8 *plane_u = NULL;
+        Uint8 *plane_v = NULL;
         Uint8 *plane_interleaved_uv;
-        Uint32 y_stride, uv_stride, y_skip, uv_skip;
+        Uint32 y_stride = 0, uv_stride = 0, y_skip, uv_skip;
 
         if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
                          (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
@@ -752,11 +1795,16 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
 
         /* Write Y plane */
         for (j = 0; j < height; j++) {
-            for (i = 0; i < width; i++) {
+            i = 0;
+            if (row_y) {
+                i = row_y(curr_row, width, plane_y, &params);
+                plane_y += i;
+            }
+            for (; i < width; i++) {
                 const Uint32 p1 = ((const Uint32 *)curr_row)[i];
-                const Uint32 r = (p1 & 0x00ff0000) >> 16;
-                const Uint32 g = (p1 & 0x0000ff00) >> 8;
-                const Uint32 b = (p1 & 0x000000ff);
+                const Uint32 r = CHANNEL(p1, rshift);
+                const Uint32 g = CHANNEL(p1, gshift);
+                const Uint32 b = CHANNEL(p1, bshift);
                 *plane_y++ = MAKE_Y(r, g, b);
             }
             plane_y += y_skip;
@@ -771,7 +1819,13 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
             /* Write UV planes, not interleaved */
             uv_skip = (uv_stride - (width + 1) / 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = 0;
+                if (row_uv) {
+                    i = row_uv(curr_row, next_row, width_half, plane_u, plane_v, 1, &params);
+                    plane_u += i;
+                    plane_v += i;
+                }
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_u++ = MAKE_U(r, g, b);
                     *plane_v++ = MAKE_V(r, g, b);
@@ -803,7 +1857,12 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
         } else if (dst_format == SDL_PIXELFORMAT_NV12) {
             uv_skip = (uv_stride - ((width + 1) / 2) * 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = 0;
+                if (row_uv) {
+                    i = row_uv(curr_row, next_row, width_half, plane_interleaved_uv, plane_interleaved_uv + 1, 2, &params);
+                    plane_interleaved_uv += i * 2;
+                }
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_interleaved_uv++ = MAKE_U(r, g, b);
                     *plane_interleaved_uv++ = MAKE_V(r, g, b);
@@ -832,7 +1891,12 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
         } else /* dst_format == SDL_PIXELFORMAT_NV21 */ {
             uv_skip = (uv_stride - ((width + 1) / 2) * 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = 0;
+                if (row_uv) {
+                    i = row_uv(curr_row, next_row, width_half, plane_interleaved_uv + 1, plane_interleaved_uv, 2, &params);
+                    plane_interleaved_uv += i * 2;
+                }
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_interleaved_uv++ = MAKE_V(r, g, b);
                     *plane_interleaved_uv++ = MAKE_U(r, g, b);
@@ -942,6 +2006,48 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
         }
     } break;
 
+    case SDL_PIXELFORMAT_I444:
+    {
+        const Uint8 *curr_row = (const Uint8 *)src;
+        Uint8 *plane_y;
+        Uint8 *plane_u;
+        Uint8 *plane_v;
+        Uint32 y_stride, uv_stride;
+
+        if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+                         (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
+                         &y_stride, &uv_stride) != 0) {
+            return -1;
+        }
+
+        /* Write the planes at full resolution */
+        for (j = 0; j < height; j++) {
+            i = 0;
+            if (row_y) {
+                i = row_y(curr_row, width, plane_y, &params);
+            }
+            for (; i < width; i++) {
+                const Uint32 p1 = ((const Uint32 *)curr_row)[i];
+                const Uint32 r = CHANNEL(p1, rshift);
+                const Uint32 g = CHANNEL(p1, gshift);
+                const Uint32 b = CHANNEL(p1, bshift);
+                plane_y[i] = MAKE_Y(r, g, b);
+            }
+            for (i = 0; i < width; i++) {
+                const Uint32 p1 = ((const Uint32 *)curr_row)[i];
+                const Uint32 r = CHANNEL(p1, rshift);
+                const Uint32 g = CHANNEL(p1, gshift);
+                const Uint32 b = CHANNEL(p1, bshift);
+                plane_u[i] = MAKE_U(r, g, b);
+                plane_v[i] = MAKE_V(r, g, b);
+            }
+            plane_y += y_stride;
+            plane_u += uv_stride;
+            plane_v += uv_stride;
+            curr_row += src_pitch;
+        }
+    } break;
+
     default:
         return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
     }
@@ -954,13 +2060,56 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
 #undef READ_1x1_PIXEL
 #undef READ_TWO_RGB_PIXELS
 #undef READ_ONE_RGB_PIXEL
+#undef CHANNEL
     return 0;
 }
 
+/* Widens NV12 to the formats with 16-bit samples, video range samples keep their scale in the high bits */
+static void SDL_ConvertPixels_NV12_to_P01x(int width, int height, const Uint8 *src, int src_pitch, void *dst, int dst_pitch)
+{
+    const int uv_width = ((width + 1) / 2) * 2;
+    const int uv_height = (height + 1) / 2;
+    const int uv_pitch = 4 * ((dst_pitch + 3) / 4);
+    Uint8 *plane = (Uint8 *)dst;
+    int i, j;
+
+    for (j = 0; j < height + uv_height; j++) {
+        const int row_width = (j < height) ? width : uv_width;
+        Uint16 *row = (Uint16 *)plane;
+
+        for (i = 0; i < row_width; i++) {
+            row[i] = SDL_SwapLE16((Uint16)(src[i] << 8));
+        }
+        src += src_pitch;
+        plane += (j < height) ? dst_pitch : uv_pitch;
+    }
+}
+
 int SDL_ConvertPixels_RGB_to_YUV(int width, int height,
                                  Uint32 src_format, const void *src, int src_pitch,
                                  Uint32 dst_format, void *dst, int dst_pitch)
 {
+    int shift[3];
+
+    /* The formats with 16-bit samples are converted to NV12, and widened from there */
+    if (IsP01xFormat(dst_format)) {
+        int ret;
+        Uint8 *tmp;
+        const int tmp_pitch = 2 * ((width + 1) / 2);
+
+        tmp = (Uint8 *)SDL_malloc((size_t)tmp_pitch * (height + (height + 1) / 2));
+        if (!tmp) {
+            return SDL_OutOfMemory();
+        }
+
+        ret = SDL_ConvertPixels_RGB_to_YUV(width, height, src_format, src, src_pitch, SDL_PIXELFORMAT_NV12, tmp, tmp_pitch);
+        if (ret == 0) {
+            SDL_ConvertPixels_NV12_to_P01x(width, height, tmp, tmp_pitch, dst, dst_pitch);
+        }
+        SDL_free(tmp);
+        return ret;
+    }
+
 #if 0 /* Doesn't handle odd widths */
     /* RGB24 to FOURCC */
     if (src_format == SDL_PIXELFORMAT_RGB24) {
@@ -984,12 +2133,12 @@ int SDL_ConvertPixels_RGB_to_YUV(int width, int height,
     }
 #endif
 
-    /* ARGB8888 to FOURCC */
-    if (src_format == SDL_PIXELFORMAT_ARGB8888) {
-        return SDL_ConvertPixels_ARGB8888_to_YUV(width, height, src, src_pitch, dst_format, dst, dst_pitch);
+    /* 8888 to FOURCC */
+    if (GetRGB8888Shifts(src_format, shift)) {
+        return SDL_ConvertPixels_8888_to_YUV(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
     }
 
-    /* not ARGB8888 to FOURCC : need an intermediate conversion */
+    /* not 8888 to FOURCC : need an intermediate conversion */
     {
         int ret;
         void *tmp;
@@ -1008,46 +2157,62 @@ int SDL_ConvertPixels_RGB_to_YUV(int width, int height,
         }
 
         /* convert tmp/ARGB8888 to dst/FOURCC */
-        ret = SDL_ConvertPixels_ARGB8888_to_YUV(width, height, tmp, tmp_pitch, dst_format, dst, dst_pitch);
+        ret = SDL_ConvertPixels_8888_to_YUV(width, height, SDL_PIXELFORMAT_ARGB8888, tmp, tmp_pitch, dst_format, dst, dst_pitch);
         SDL_free(tmp);
         return ret;
     }
 }
 
-static int SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, Uint32 format,
+static int SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, int row, int rows, Uint32 format,
                                              const void *src, int src_pitch, void *dst, int dst_pitch)
 {
     int i;
 
-    if (IsPlanar2x2Format(format)) {
+    if (IsPlanar2x2Format(format) || IsP01xFormat(format) || IsPlanar444Format(format)) {
+        const Uint8 *srcY, *srcU, *srcV;
+        Uint8 *dstY, *dstU, *dstV;
+        Uint32 srcY_pitch, srcUV_pitch, dstY_pitch, dstUV_pitch;
+        const int uv_rows = IsPlanar444Format(format) ? rows : (rows + 1) / 2;
+        const int bpp = SDL_BYTESPERPIXEL(format);
+
+        if (GetYUVBandPlanes(width, height, format, src, src_pitch, row,
+                             &srcY, &srcU, &srcV, &srcY_pitch, &srcUV_pitch) < 0 ||
+            GetYUVBandPlanes(width, height, format, dst, dst_pitch, row,
+                             (const Uint8 **)&dstY, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
+                             &dstY_pitch, &dstUV_pitch) < 0) {
+            return -1;
+        }
+
         /* Y plane */
-        for (i = height; i--;) {
-            SDL_memcpy(dst, src, width);
-            src = (const Uint8 *)src + src_pitch;
-            dst = (Uint8 *)dst + dst_pitch;
+        for (i = rows; i--;) {
+            SDL_memcpy(dstY, srcY, (size_t)width * bpp);
+            srcY += srcY_pitch;
+            dstY += dstY_pitch;
         }
 
-        if (format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV) {
-            /* U and V planes are a quarter the size of the Y plane, rounded up */
-            width = (width + 1) / 2;
-            height = (height + 1) / 2;
-            src_pitch = (src_pitch + 1) / 2;
-            dst_pitch = (dst_pitch + 1) / 2;
-            for (i = height * 2; i--;) {
-                SDL_memcpy(dst, src, width);
-                src = (const Uint8 *)src + src_pitch;
-                dst = (Uint8 *)dst + dst_pitch;
+        if (format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_I444) {
+            /* U and V planes are a quarter the size of the Y plane, rounded up, or full size for 4:4:4 */
+            if (format != SDL_PIXELFORMAT_I444) {
+                width = (width + 1) / 2;
+            }
+            for (i = uv_rows; i--;) {
+                SDL_memcpy(dstU, srcU, width);
+                SDL_memcpy(dstV, srcV, width);
+                srcU += srcUV_pitch;
+                srcV += srcUV_pitch;
+                dstU += dstUV_pitch;
+                dstV += dstUV_pitch;
             }
-        } else if (format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21) {
+        } else {
             /* U/V plane is half the height of the Y plane, rounded up */
-            height = (height + 1) / 2;
-            width = ((width + 1) / 2) * 2;
-            src_pitch = ((src_pitch + 1) / 2) * 2;
-            dst_pitch = ((dst_pitch + 1) / 2) * 2;
-            for (i = height; i--;) {
-                SDL_memcpy(dst, src, width);
-                src = (const Uint8 *)src + src_pitch;
-                dst = (Uint8 *)dst + dst_pitch;
+            const Uint8 *srcUV = SDL_min(srcU, srcV);
+            Uint8 *dstUV = SDL_min(dstU, dstV);
+
+            width = ((width + 1) / 2) * 2 * bpp;
+            for (i = uv_rows; i--;) {
+                SDL_memcpy(dstUV, srcUV, width);
+                srcUV += srcUV_pitch;
+                dstUV += dstUV_pitch;
             }
         }
         return 0;
@@ -1055,8 +2220,10 @@ static int SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, Uint32 forma
 
     if (IsPacked4Format(format)) {
         /* Packed planes */
+        src = (const Uint8 *)src + (size_t)row * src_pitch;
+        dst = (Uint8 *)dst + (size_t)row * dst_pitch;
         width = 4 * ((width + 1) / 2);
-        for (i = height; i--;) {
+        for (i = rows; i--;) {
             SDL_memcpy(dst, src, width);
             src = (const Uint8 *)src + src_pitch;
             dst = (Uint8 *)dst + dst_pitch;
@@ -2069,7 +3236,7 @@ static int SDL_ConvertPixels_Packed4_to_Packed4(int width, int height,
                         SDL_GetPixelFormatName(dst_format));
 }
 
-static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
+static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height, int row, int rows,
                                                   Uint32 src_format, const void *src, int src_pitch,
                                                   Uint32 dst_format, void *dst, int dst_pitch)
 {
@@ -2085,8 +3252,8 @@ static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
         return SDL_SetError("Can't change YUV plane types in-place");
     }
 
-    if (GetYUVPlanes(width, height, src_format, src, src_pitch,
-                     &srcY1, &srcU, &srcV, &srcY_pitch, &srcUV_pitch) < 0) {
+    if (GetYUVBandPlanes(width, height, src_format, src, src_pitch, row,
+                         &srcY1, &srcU, &srcV, &srcY_pitch, &srcUV_pitch) < 0) {
         return -1;
     }
     srcY2 = srcY1 + srcY_pitch;
@@ -2100,9 +3267,9 @@ static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
         srcUV_pitch_left = (srcUV_pitch - ((width + 1) / 2));
     }
 
-    if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                     (const Uint8 **)&dstY1, (const Uint8 **)&dstU1, (const Uint8 **)&dstV1,
-                     &dstY_pitch, &dstUV_pitch) < 0) {
+    if (GetYUVBandPlanes(width, height, dst_format, dst, dst_pitch, row,
+                         (const Uint8 **)&dstY1, (const Uint8 **)&dstU1, (const Uint8 **)&dstV1,
+                         &dstY_pitch, &dstUV_pitch) < 0) {
         return -1;
     }
     dstY2 = dstY1 + dstY_pitch;
@@ -2111,7 +3278,7 @@ static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
     dst_pitch_left = (dstY_pitch - 4 * ((width + 1) / 2));
 
     /* Copy 2x2 blocks of pixels at a time */
-    for (y = 0; y < (height - 1); y += 2) {
+    for (y = 0; y < (rows - 1); y += 2) {
         for (x = 0; x < (width - 1); x += 2) {
             /* Row 1 */
             *dstY1 = *srcY1++;
@@ -2176,7 +3343,7 @@ static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
     }
 
     /* Last row */
-    if (y == (height - 1)) {
+    if (y == (rows - 1)) {
         for (x = 0; x < (width - 1); x += 2) {
             /* Row 1 */
             *dstY1 = *srcY1++;
@@ -2211,7 +3378,7 @@ static int SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
     return 0;
 }
 
-static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
+static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height, int row, int rows,
                                                   Uint32 src_format, const void *src, int src_pitch,
                                                   Uint32 dst_format, void *dst, int dst_pitch)
 {
@@ -2227,8 +3394,8 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
         return SDL_SetError("Can't change YUV plane types in-place");
     }
 
-    if (GetYUVPlanes(width, height, src_format, src, src_pitch,
-                     &srcY1, &srcU1, &srcV1, &srcY_pitch, &srcUV_pitch) < 0) {
+    if (GetYUVBandPlanes(width, height, src_format, src, src_pitch, row,
+                         &srcY1, &srcU1, &srcV1, &srcY_pitch, &srcUV_pitch) < 0) {
         return -1;
     }
     srcY2 = srcY1 + srcY_pitch;
@@ -2236,9 +3403,9 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
     srcV2 = srcV1 + srcUV_pitch;
     src_pitch_left = (srcY_pitch - 4 * ((width + 1) / 2));
 
-    if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                     (const Uint8 **)&dstY1, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
-                     &dstY_pitch, &dstUV_pitch) < 0) {
+    if (GetYUVBandPlanes(width, height, dst_format, dst, dst_pitch, row,
+                         (const Uint8 **)&dstY1, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
+                         &dstY_pitch, &dstUV_pitch) < 0) {
         return -1;
     }
     dstY2 = dstY1 + dstY_pitch;
@@ -2253,7 +3420,7 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
     }
 
     /* Copy 2x2 blocks of pixels at a time */
-    for (y = 0; y < (height - 1); y += 2) {
+    for (y = 0; y < (rows - 1); y += 2) {
         for (x = 0; x < (width - 1); x += 2) {
             /* Row 1 */
             *dstY1++ = *srcY1;
@@ -2316,7 +3483,7 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
     }
 
     /* Last row */
-    if (y == (height - 1)) {
+    if (y == (rows - 1)) {
         for (x = 0; x < (width - 1); x += 2) {
             *dstY1++ = *srcY1;
             srcY1 += 2;
@@ -2342,6 +3509,29 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
     return 0;
 }
 
+static void YUV_to_YUV_Band(void *userdata, int row, int rows)
+{
+    YUVConversionJob *job = (YUVConversionJob *)userdata;
+    int result;
+
+    if (job->src_format == job->dst_format) {
+        result = SDL_ConvertPixels_YUV_to_YUV_Copy(job->width, job->height, row, rows, job->src_format, job->src, job->src_pitch, job->dst, job->dst_pitch);
+    } else if (IsPacked4Format(job->src_format) && IsPacked4Format(job->dst_format)) {
+        result = SDL_ConvertPixels_Packed4_to_Packed4(job->width, rows,
+                                                      job->src_format, (const Uint8 *)job->src + (size_t)row * job->src_pitch, job->src_pitch,
+                                                      job->dst_format, (Uint8 *)job->dst + (size_t)row * job->dst_pitch, job->dst_pitch);
+    } else if (IsPlanar2x2Format(job->src_format)) {
+        result = SDL_ConvertPixels_Planar2x2_to_Packed4(job->width, job->height, row, rows, job->src_format, job->src, job->src_pitch, job->dst_format, job->dst, job->dst_pitch);
+    } else {
+        result = SDL_ConvertPixels_Packed4_to_Planar2x2(job->width, job->height, row, rows, job->src_format, job->src, job->src_pitch, job->dst_format, job->dst, job->dst_pitch);
+    }
+
+    /* Every band gets the same result, and the first one runs on the calling thread */
+    if (row == 0) {
+        job->result = result;
+    }
+}
+
 #endif /* SDL_HAVE_YUV */
 
 int SDL_ConvertPixels_YUV_to_YUV(int width, int height,
@@ -2349,26 +3539,38 @@ int SDL_ConvertPixels_YUV_to_YUV(int width, int height,
                                  Uint32 dst_format, void *dst, int dst_pitch)
 {
 #if SDL_HAVE_YUV
+    YUVConversionJob job;
+
     if (src_format == dst_format) {
         if (src == dst) {
             /* Nothing to do */
             return 0;
         }
-        return SDL_ConvertPixels_YUV_to_YUV_Copy(width, height, src_format, src, src_pitch, dst, dst_pitch);
-    }
-
-    if (IsPlanar2x2Format(src_format) && IsPlanar2x2Format(dst_format)) {
+    } else if (IsPlanar2x2Format(src_format) && IsPlanar2x2Format(dst_format)) {
+        /* These can convert in-place, so they run on the calling thread */
         return SDL_ConvertPixels_Planar2x2_to_Planar2x2(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPacked4Format(src_format) && IsPacked4Format(dst_format)) {
-        return SDL_ConvertPixels_Packed4_to_Packed4(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPlanar2x2Format(src_format) && IsPacked4Format(dst_format)) {
-        return SDL_ConvertPixels_Planar2x2_to_Packed4(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPacked4Format(src_format) && IsPlanar2x2Format(dst_format)) {
-        return SDL_ConvertPixels_Packed4_to_Planar2x2(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else {
+    } else if (!(IsPacked4Format(src_format) && IsPacked4Format(dst_format)) &&
+               !(IsPlanar2x2Format(src_format) && IsPacked4Format(dst_format)) &&
+               !(IsPacked4Format(src_format) && IsPlanar2x2Format(dst_format))) {
         return SDL_SetError("SDL_ConvertPixels_YUV_to_YUV: Unsupported YUV conversion: %s -> %s", SDL_GetPixelFormatName(src_format),
                             SDL_GetPixelFormatName(dst_format));
     }
+
+    job.width = width;
+    job.height = height;
+    job.src_format = src_format;
+    job.src = src;
+    job.src_pitch = src_pitch;
+    job.dst_format = dst_format;
+    job.dst = dst;
+    job.dst_pitch = dst_pitch;
+    job.result = -1;
+
+    /* Bands of the 2x2 formats need to start on even rows */
+    if (!SDL_RunThreadedBands(YUV_to_YUV_Band, &job, width, height, 2)) {
+        YUV_to_YUV_Band(&job, 0, height);
+    }
+    return job.result;
 #else
     return SDL_SetError("SDL not built with YUV support");
 #endif
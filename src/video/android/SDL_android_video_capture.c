@@ -58,9 +58,14 @@
 #include <media/NdkImage.h>
 #include <media/NdkImageReader.h>
 
+#include <time.h>
+
 #include "../../core/android/SDL_android.h"
 
 
+/* Number of images the reader can have acquired at once */
+#define ANDROID_NUM_BUFFERS 10
+
 static ACameraManager *cameraMgr = NULL;
 static ACameraIdList *cameraIdList = NULL;
 
@@ -105,6 +110,11 @@ struct SDL_PrivateVideoCaptureData
     ACameraCaptureSession_stateCallbacks capture_callbacks;
     ACaptureSessionOutputContainer *sessionOutputContainer;
     AImageReader *reader;
+    AImageReader_ImageListener image_listener;
+    SDL_Semaphore *frame_ready; /* Posted when an image is available, or to wake up AcquireFrame() */
+    Uint64 sequence;
+    SDL_bool realtime_timestamps; /* Image timestamps are on the CLOCK_BOOTTIME timebase */
+    SDL_PropertiesID frame_props; /* Timing of the frame passed to GetFrameProperties() */
     int num_formats;
     int count_formats[6]; // see format_2_id
 };
@@ -219,6 +229,13 @@ onActive(void* context, ACameraCaptureSession *session)
     SDL_Log("CB onActive");
 }
 
+static void
+onImageAvailable(void *context, AImageReader *reader)
+{
+    SDL_VideoCaptureDevice *_this = (SDL_VideoCaptureDevice *) context;
+    SDL_PostSemaphore(_this->hidden->frame_ready);
+}
+
 int
 OpenDevice(SDL_VideoCaptureDevice *_this)
 {
@@ -241,6 +258,11 @@ OpenDevice(SDL_VideoCaptureDevice *_this)
         return SDL_OutOfMemory();
     }
 
+    _this->hidden->frame_ready = SDL_CreateSemaphore(0);
+    if (_this->hidden->frame_ready == NULL) {
+        return -1;
+    }
+
     create_cameraMgr();
 
     _this->hidden->dev_callbacks.context = (void *) _this;
@@ -252,6 +274,20 @@ OpenDevice(SDL_VideoCaptureDevice *_this)
         return SDL_SetError("Failed to open camera");
     }
 
+    /* Image timestamps can only be compared with our clock if the sensor uses elapsedRealtimeNanos() */
+    {
+        ACameraMetadata *metadata;
+        ACameraMetadata_const_entry entry;
+
+        if (ACameraManager_getCameraCharacteristics(cameraMgr, _this->dev_name, &metadata) == ACAMERA_OK) {
+            if (ACameraMetadata_getConstEntry(metadata, ACAMERA_SENSOR_INFO_TIMESTAMP_SOURCE, &entry) == ACAMERA_OK &&
+                entry.count > 0 && entry.data.u8[0] == ACAMERA_SENSOR_INFO_TIMESTAMP_SOURCE_REALTIME) {
+                _this->hidden->realtime_timestamps = SDL_TRUE;
+            }
+            ACameraMetadata_free(metadata);
+        }
+    }
+
     return 0;
 }
 
@@ -275,6 +311,12 @@ CloseDevice(SDL_VideoCaptureDevice *_this)
             ACameraDevice_close(_this->hidden->device);
         }
 
+        if (_this->hidden->frame_ready) {
+            SDL_DestroySemaphore(_this->hidden->frame_ready);
+        }
+
+        SDL_DestroyProperties(_this->hidden->frame_props);
+
         SDL_free(_this->hidden);
 
         _this->hidden = NULL;
@@ -314,11 +356,20 @@ StartCapture(SDL_VideoCaptureDevice *_this)
     ACameraOutputTarget *outputTarget;
     ACaptureRequest *request;
 
-    res2 = AImageReader_new(_this->spec.width, _this->spec.height, format_sdl_2_android(_this->spec.format), 10 /* nb buffers */, &_this->hidden->reader);
+    res2 = AImageReader_new(_this->spec.width, _this->spec.height, format_sdl_2_android(_this->spec.format), ANDROID_NUM_BUFFERS, &_this->hidden->reader);
     if (res2 != AMEDIA_OK) {
         SDL_SetError("Error AImageReader_new");
         goto error;
     }
+    _this->num_buffers = ANDROID_NUM_BUFFERS;
+    _this->hidden->image_listener.context = (void *) _this;
+    _this->hidden->image_listener.onImageAvailable = onImageAvailable;
+    res2 = AImageReader_setImageListener(_this->hidden->reader, &_this->hidden->image_listener);
+    if (res2 != AMEDIA_OK) {
+        SDL_SetError("Error AImageReader_setImageListener");
+        goto error;
+    }
+
     res2 = AImageReader_getWindow(_this->hidden->reader, &window);
     if (res2 != AMEDIA_OK) {
         SDL_SetError("Error AImageReader_new");
@@ -398,18 +449,41 @@ StopCapture(SDL_VideoCaptureDevice *_this)
     return 0;
 }
 
+/* Convert the capture time of an image to the SDL_GetTicksNS() timebase */
+static Uint64
+get_image_timestamp(SDL_VideoCaptureDevice *_this, const AImage *image)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    int64_t captured = 0;
+    struct timespec ts;
+
+    /* Otherwise the timestamp source is unknown, and only good for comparing frames with each other */
+    if (_this->hidden->realtime_timestamps &&
+        AImage_getTimestamp(image, &captured) == AMEDIA_OK &&
+        clock_gettime(CLOCK_BOOTTIME, &ts) == 0) {
+        const Uint64 boottime_now = (Uint64)ts.tv_sec * SDL_NS_PER_SECOND + ts.tv_nsec;
+
+        if (captured >= 0 && (Uint64)captured <= boottime_now && (boottime_now - (Uint64)captured) < now) {
+            return now - (boottime_now - (Uint64)captured);
+        }
+    }
+    return now;
+}
+
 int
 AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
     media_status_t res;
     AImage *image;
+
+    /* Sleep until the reader has an image, or we're woken up */
+    SDL_WaitSemaphore(_this->hidden->frame_ready);
+
     res = AImageReader_acquireNextImage(_this->hidden->reader, &image);
     /* We could also use this one:
     res = AImageReader_acquireLatestImage(_this->hidden->reader, &image);
     */
     if (res == AMEDIA_IMGREADER_NO_BUFFER_AVAILABLE ) {
-
-        SDL_Delay(20); // TODO fix some delay
 #if DEBUG_VIDEO_CAPTURE_CAPTURE
 //        SDL_Log("AImageReader_acquireNextImage: AMEDIA_IMGREADER_NO_BUFFER_AVAILABLE");
 #endif
@@ -419,7 +493,8 @@ AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
         int32_t numPlanes = 0;
         AImage_getNumberOfPlanes(image, &numPlanes);
 
-        frame->timestampNS = SDL_GetTicksNS();
+        frame->timestampNS = get_image_timestamp(_this, image);
+        frame->sequence = _this->hidden->sequence++;
 
         for (i = 0; i < numPlanes && i < 3; i++) {
             int dataLength = 0;
@@ -454,6 +529,14 @@ AcquireFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
     return -1;
 }
 
+void
+WakeupAcquireFrame(SDL_VideoCaptureDevice *_this)
+{
+    if (_this->hidden && _this->hidden->frame_ready) {
+        SDL_PostSemaphore(_this->hidden->frame_ready);
+    }
+}
+
 int
 ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
 {
@@ -463,6 +546,33 @@ ReleaseFrame(SDL_VideoCaptureDevice *_this, SDL_VideoCaptureFrame *frame)
     return 0;
 }
 
+SDL_PropertiesID
+GetFrameProperties(SDL_VideoCaptureDevice *_this, const SDL_VideoCaptureFrame *frame)
+{
+    const AImage *image = (const AImage *)frame->internal;
+    int64_t timestamp = 0;
+
+    if (!image) {
+        SDL_SetError("invalid frame");
+        return 0;
+    }
+
+    if (!_this->hidden->frame_props) {
+        _this->hidden->frame_props = SDL_CreateProperties();
+        if (!_this->hidden->frame_props) {
+            return 0;
+        }
+    }
+
+    /* The sensor timestamp, on the clock given by ACAMERA_SENSOR_INFO_TIMESTAMP_SOURCE */
+    if (AImage_getTimestamp(image, &timestamp) == AMEDIA_OK) {
+        SDL_SetNumberProperty(_this->hidden->frame_props, "SDL.video_capture.frame.device_timestamp_ns", timestamp);
+    } else {
+        SDL_ClearProperty(_this->hidden->frame_props, "SDL.video_capture.frame.device_timestamp_ns");
+    }
+    return _this->hidden->frame_props;
+}
+
 int
 GetNumFormats(SDL_VideoCaptureDevice *_this)
 {
@@ -24,6 +24,9 @@
 
 #include <emscripten/emscripten.h>
 #include <emscripten/html5_webgl.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/threading.h>
+#endif
 #include <GLES2/gl2.h>
 
 #include "SDL_emscriptenvideo.h"
@@ -95,9 +98,27 @@ SDL_GLContext Emscripten_GLES_CreateContext(SDL_VideoDevice *_this, SDL_Window *
         return NULL;
     }
 
-    context = emscripten_webgl_create_context(window_data->canvas_id, &attribs);
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (!emscripten_is_main_browser_thread()) {
+        /* A worker never returns to the browser, so frames are committed in
+           SDL_GL_SwapWindow(). Prefer drawing straight into a canvas that was
+           transferred to this thread (-sOFFSCREENCANVAS_SUPPORT), and fall back
+           to proxying WebGL calls to the main thread (-sOFFSCREEN_FRAMEBUFFER). */
+        attribs.explicitSwapControl = EM_TRUE;
+        attribs.proxyContextToMainThread = EMSCRIPTEN_WEBGL_CONTEXT_PROXY_FALLBACK;
+        context = emscripten_webgl_create_context(window_data->canvas_id, &attribs);
+        if (context <= 0) {
+            attribs.renderViaOffscreenBackBuffer = EM_TRUE;
+            context = emscripten_webgl_create_context(window_data->canvas_id, &attribs);
+        }
+        window_data->gl_explicit_swap = SDL_TRUE;
+    } else
+#endif
+    {
+        context = emscripten_webgl_create_context(window_data->canvas_id, &attribs);
+    }
 
-    if (context < 0) {
+    if (context <= 0) {
         SDL_SetError("Could not create webgl context");
         return NULL;
     }
@@ -122,6 +143,7 @@ int Emscripten_GLES_DeleteContext(SDL_VideoDevice *_this, SDL_GLContext context)
 
         if (window_data->gl_context == context) {
             window_data->gl_context = NULL;
+            window_data->gl_explicit_swap = SDL_FALSE;
         }
     }
 
@@ -131,6 +153,15 @@ int Emscripten_GLES_DeleteContext(SDL_VideoDevice *_this, SDL_GLContext context)
 
 int Emscripten_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 {
+    SDL_WindowData *window_data = window->driverdata;
+
+    if (window_data->gl_explicit_swap) {
+        if (emscripten_webgl_commit_frame() != EMSCRIPTEN_RESULT_SUCCESS) {
+            return SDL_SetError("Could not commit webgl frame");
+        }
+        return 0;
+    }
+
     if (emscripten_has_asyncify() && SDL_GetHintBoolean(SDL_HINT_EMSCRIPTEN_ASYNCIFY, SDL_TRUE)) {
         /* give back control to browser for screen refresh */
         emscripten_sleep(0);
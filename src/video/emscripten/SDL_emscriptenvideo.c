@@ -168,7 +168,13 @@ static int Emscripten_GetDisplayUsableBounds(SDL_VideoDevice *_this, SDL_VideoDi
 
 static void Emscripten_PumpEvents(SDL_VideoDevice *_this)
 {
-    /* do nothing. */
+#ifdef __EMSCRIPTEN_PTHREADS__
+    /* Browser events are handled on the main thread and proxied to the thread
+       that registered for them, which is us if the app runs in a worker. */
+    if (!emscripten_is_main_browser_thread()) {
+        emscripten_current_thread_process_queued_calls();
+    }
+#endif
 }
 
 static int Emscripten_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_PropertiesID props)
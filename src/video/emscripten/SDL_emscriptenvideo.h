@@ -34,6 +34,7 @@ struct SDL_WindowData
     SDL_Surface *surface;
 
     SDL_GLContext gl_context;
+    SDL_bool gl_explicit_swap; /* The context is rendered from a worker and frames must be committed */
 
     char *canvas_id;
 
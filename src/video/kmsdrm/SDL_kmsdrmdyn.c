@@ -44,14 +44,21 @@ static kmsdrmdynlib kmsdrmlibs[] = {
     { NULL, SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC }
 };
 
+/* The symbols are listed grouped by the library that provides them, so the
+   search starts in the library where the previous symbol was found instead
+   of trying every library in turn. */
+static int kmsdrm_lastlib = 0;
+
 static void *KMSDRM_GetSym(const char *fnname, int *pHasModule)
 {
-    int i;
+    int i, lib = 0;
     void *fn = NULL;
     for (i = 0; i < SDL_TABLESIZE(kmsdrmlibs); i++) {
-        if (kmsdrmlibs[i].lib) {
-            fn = SDL_LoadFunction(kmsdrmlibs[i].lib, fnname);
+        lib = (kmsdrm_lastlib + i) % (int)SDL_TABLESIZE(kmsdrmlibs);
+        if (kmsdrmlibs[lib].lib) {
+            fn = SDL_LoadFunction(kmsdrmlibs[lib].lib, fnname);
             if (fn) {
+                kmsdrm_lastlib = lib;
                 break;
             }
         }
@@ -59,7 +66,7 @@ static void *KMSDRM_GetSym(const char *fnname, int *pHasModule)
 
 #if DEBUG_DYNAMIC_KMSDRM
     if (fn)
-        SDL_Log("KMSDRM: Found '%s' in %s (%p)\n", fnname, kmsdrmlibs[i].libname, fn);
+        SDL_Log("KMSDRM: Found '%s' in %s (%p)\n", fnname, kmsdrmlibs[lib].libname, fn);
     else
         SDL_Log("KMSDRM: Symbol '%s' NOT FOUND!\n", fnname);
 #endif
@@ -118,6 +125,7 @@ int SDL_KMSDRM_LoadSymbols(void)
 #ifdef SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC
         int i;
         int *thismod = NULL;
+        kmsdrm_lastlib = 0;
         for (i = 0; i < SDL_TABLESIZE(kmsdrmlibs); i++) {
             if (kmsdrmlibs[i].libname) {
                 kmsdrmlibs[i].lib = SDL_LoadObject(kmsdrmlibs[i].libname);
@@ -0,0 +1,278 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_KMSDRM
+
+#include <sys/mman.h>
+
+#include "SDL_kmsdrmvideo.h"
+#include "SDL_kmsdrmdyn.h"
+#include "SDL_kmsdrmframebuffer.h"
+
+/* The window surface is memory of our own, and when the window is updated
+ * the parts that changed are copied into the dumb buffer that isn't being
+ * scanned out, which is then flipped to the screen. Dumb buffer mappings are
+ * often uncached, so the application never draws into them directly.
+ */
+#define KMSDRM_FRAMEBUFFER_NUM_BUFFERS 2
+
+typedef struct
+{
+    uint32_t handle;
+    uint32_t fb_id;
+    uint32_t pitch;
+    void *pixels;
+    size_t size;
+    SDL_Rect damage; /* The area that changed since this buffer was filled */
+} KMSDRM_DumbBuffer;
+
+typedef struct SDL_KMSDRM_Framebuffer
+{
+    void *pixels;
+    int width, height, pitch;
+    int mode_width, mode_height; /* The size of the dumb buffers */
+    KMSDRM_DumbBuffer buffers[KMSDRM_FRAMEBUFFER_NUM_BUFFERS];
+    int back;           /* The buffer that isn't on screen */
+    SDL_bool crtc_set;  /* Has the CRTC been pointed at one of our buffers? */
+} SDL_KMSDRM_Framebuffer;
+
+static void KMSDRM_DestroyDumbBuffer(int drm_fd, KMSDRM_DumbBuffer *buf)
+{
+    struct drm_mode_destroy_dumb dreq;
+
+    if (buf->pixels) {
+        munmap(buf->pixels, buf->size);
+        buf->pixels = NULL;
+    }
+    if (buf->fb_id) {
+        KMSDRM_drmModeRmFB(drm_fd, buf->fb_id);
+        buf->fb_id = 0;
+    }
+    if (buf->handle) {
+        SDL_zero(dreq);
+        dreq.handle = buf->handle;
+        KMSDRM_drmIoctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &dreq);
+        buf->handle = 0;
+    }
+}
+
+static int KMSDRM_CreateDumbBuffer(int drm_fd, KMSDRM_DumbBuffer *buf, int w, int h)
+{
+    struct drm_mode_create_dumb creq;
+    struct drm_mode_map_dumb mreq;
+
+    SDL_zero(creq);
+    creq.width = w;
+    creq.height = h;
+    creq.bpp = 32;
+    if (KMSDRM_drmIoctl(drm_fd, DRM_IOCTL_MODE_CREATE_DUMB, &creq) < 0) {
+        return SDL_SetError("Could not create dumb buffer");
+    }
+    buf->handle = creq.handle;
+    buf->pitch = creq.pitch;
+    buf->size = (size_t)creq.size;
+
+    if (KMSDRM_drmModeAddFB(drm_fd, w, h, 24, 32, buf->pitch, buf->handle, &buf->fb_id)) {
+        buf->fb_id = 0;
+        KMSDRM_DestroyDumbBuffer(drm_fd, buf);
+        return SDL_SetError("Could not create DRM framebuffer for dumb buffer");
+    }
+
+    SDL_zero(mreq);
+    mreq.handle = buf->handle;
+    if (KMSDRM_drmIoctl(drm_fd, DRM_IOCTL_MODE_MAP_DUMB, &mreq) < 0) {
+        KMSDRM_DestroyDumbBuffer(drm_fd, buf);
+        return SDL_SetError("Could not map dumb buffer");
+    }
+
+    buf->pixels = mmap(NULL, buf->size, PROT_READ | PROT_WRITE, MAP_SHARED, drm_fd, (off_t)mreq.offset);
+    if (buf->pixels == MAP_FAILED) {
+        buf->pixels = NULL;
+        KMSDRM_DestroyDumbBuffer(drm_fd, buf);
+        return SDL_SetError("mmap() failed.");
+    }
+
+    /* Whatever isn't covered by the window surface stays black */
+    SDL_memset(buf->pixels, 0, buf->size);
+
+    buf->damage.x = 0;
+    buf->damage.y = 0;
+    buf->damage.w = w;
+    buf->damage.h = h;
+    return 0;
+}
+
+int KMSDRM_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, Uint32 *format,
+                                   void **pixels, int *pitch)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    SDL_KMSDRM_Framebuffer *fb;
+    int w, h, i;
+
+    SDL_GetWindowSizeInPixels(window, &w, &h);
+
+    /* Free the old framebuffer */
+    KMSDRM_DestroyWindowFramebuffer(_this, window);
+
+    if (viddata->vulkan_mode || viddata->drm_fd < 0) {
+        return SDL_SetError("Window framebuffers need the DRM device");
+    }
+    if ((Sint64)w * 4 * h > SDL_MAX_SINT32) {
+        return SDL_SetError("Window is too large for a framebuffer");
+    }
+
+    fb = (SDL_KMSDRM_Framebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return SDL_OutOfMemory();
+    }
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = w * 4;
+    fb->mode_width = dispdata->mode.hdisplay;
+    fb->mode_height = dispdata->mode.vdisplay;
+    fb->pixels = SDL_calloc(1, SDL_max((size_t)h * fb->pitch, 1));
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return SDL_OutOfMemory();
+    }
+    windata->framebuffer = fb;
+
+    for (i = 0; i < KMSDRM_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        if (KMSDRM_CreateDumbBuffer(viddata->drm_fd, &fb->buffers[i], fb->mode_width, fb->mode_height) < 0) {
+            KMSDRM_DestroyWindowFramebuffer(_this, window);
+            return -1;
+        }
+    }
+
+    *format = SDL_PIXELFORMAT_XRGB8888;
+    *pixels = fb->pixels;
+    *pitch = fb->pitch;
+    return 0;
+}
+
+int KMSDRM_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects,
+                                   int numrects)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    SDL_KMSDRM_Framebuffer *fb = windata->framebuffer;
+    KMSDRM_DumbBuffer *buf;
+    SDL_Rect bounds, rect, changed;
+    int i, ret;
+
+    if (!fb) {
+        return SDL_SetError("Window doesn't have a framebuffer");
+    }
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = SDL_min(fb->width, fb->mode_width);
+    bounds.h = SDL_min(fb->height, fb->mode_height);
+    SDL_zero(changed);
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            SDL_GetRectUnion(&changed, &rect, &changed);
+        }
+    }
+    if (SDL_RectEmpty(&changed) && fb->crtc_set) {
+        return 0;
+    }
+
+    for (i = 0; i < KMSDRM_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        SDL_GetRectUnion(&fb->buffers[i].damage, &changed, &fb->buffers[i].damage);
+    }
+
+    /* The back buffer may still be on screen until the last flip is done */
+    if (!KMSDRM_WaitPageflip(_this, windata)) {
+        return SDL_SetError("Wait for previous pageflip failed");
+    }
+
+    /* Bring the back buffer up to date */
+    buf = &fb->buffers[fb->back];
+    if (SDL_GetRectIntersection(&buf->damage, &bounds, &rect)) {
+        const Uint8 *src = (const Uint8 *)fb->pixels + (size_t)rect.y * fb->pitch + (size_t)rect.x * 4;
+        Uint8 *dst = (Uint8 *)buf->pixels + (size_t)rect.y * buf->pitch + (size_t)rect.x * 4;
+        int y;
+
+        for (y = 0; y < rect.h; ++y) {
+            SDL_memcpy(dst, src, (size_t)rect.w * 4);
+            src += fb->pitch;
+            dst += buf->pitch;
+        }
+    }
+    SDL_zero(buf->damage);
+
+    if (!fb->crtc_set) {
+        /* The first update takes the CRTC over from whatever showed before */
+        ret = KMSDRM_drmModeSetCrtc(viddata->drm_fd, dispdata->crtc->crtc_id, buf->fb_id, 0, 0,
+                                    &dispdata->connector->connector_id, 1, &dispdata->mode);
+        if (ret) {
+            return SDL_SetError("Could not set videomode on CRTC.");
+        }
+        fb->crtc_set = SDL_TRUE;
+    } else {
+        ret = KMSDRM_QueuePageflip(_this, window, buf->fb_id, -1, SDL_FALSE);
+        if (ret) {
+            return SDL_SetError("Could not queue pageflip: %d", ret);
+        }
+    }
+
+    fb->back = (fb->back + 1) % KMSDRM_FRAMEBUFFER_NUM_BUFFERS;
+    return 0;
+}
+
+void KMSDRM_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_KMSDRM_Framebuffer *fb;
+    int i;
+
+    if (!windata || !windata->framebuffer) {
+        /* The window wasn't fully initialized */
+        return;
+    }
+    fb = windata->framebuffer;
+
+    /* Removing the framebuffer that's being scanned out turns the CRTC off,
+       so put back what was on screen before we took it over. */
+    if (fb->crtc_set) {
+        SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+
+        KMSDRM_WaitPageflip(_this, windata);
+        KMSDRM_drmModeSetCrtc(viddata->drm_fd, dispdata->crtc->crtc_id,
+                              dispdata->crtc->buffer_id, 0, 0, &dispdata->connector->connector_id, 1,
+                              &dispdata->original_mode);
+    }
+
+    for (i = 0; i < KMSDRM_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        KMSDRM_DestroyDumbBuffer(viddata->drm_fd, &fb->buffers[i]);
+    }
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+    windata->framebuffer = NULL;
+}
+
+#endif /* SDL_VIDEO_DRIVER_KMSDRM */
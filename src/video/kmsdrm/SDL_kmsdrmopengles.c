@@ -84,18 +84,32 @@ SDL_EGL_CreateContext_impl(KMSDRM)
     return 0;
 }
 
+/* Creates a native fence sync, which either wraps fd or, when fd is
+   EGL_NO_NATIVE_FENCE_FD_ANDROID, signals when the GL commands issued so
+   far are done. EGL takes ownership of fd. */
+static EGLSyncKHR KMSDRM_GLES_CreateFence(SDL_VideoDevice *_this, int fd)
+{
+    EGLint attrib_list[] = {
+        EGL_SYNC_NATIVE_FENCE_FD_ANDROID,
+        fd,
+        EGL_NONE,
+    };
+
+    return _this->egl_data->eglCreateSyncKHR(_this->egl_data->egl_display,
+                                             EGL_SYNC_NATIVE_FENCE_ANDROID, attrib_list);
+}
+
 int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 {
     SDL_WindowData *windata = window->driverdata;
     SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
     SDL_VideoData *viddata = _this->driverdata;
     KMSDRM_FBInfo *fb_info;
+    EGLSyncKHR gpu_fence = EGL_NO_SYNC_KHR;
+    int gpu_fence_fd = -1;
+    int result = 0;
     int ret = 0;
 
-    /* Always wait for the previous issued flip before issuing a new one,
-       even if you do async flips. */
-    uint32_t flip_flags = DRM_MODE_PAGE_FLIP_EVENT;
-
     /* Skip the swap if we've switched away to another VT */
     if (windata->egl_surface == EGL_NO_SURFACE) {
         /* Wait a bit, throttling to ~100 FPS */
@@ -123,28 +137,43 @@ int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 
     windata->bo = windata->next_bo;
 
+    /* With atomic commits, KMS can wait for the GPU to finish this frame
+       by itself, so we don't have to. The fence has to be inserted before
+       eglSwapBuffers() flushes the GL commands. */
+    if (viddata->native_fence_support) {
+        gpu_fence = KMSDRM_GLES_CreateFence(_this, EGL_NO_NATIVE_FENCE_FD_ANDROID);
+    }
+
     /* Mark a buffer to become the next front buffer.
        This won't happen until pagelip completes. */
     if (!(_this->egl_data->eglSwapBuffers(_this->egl_data->egl_display,
                                           windata->egl_surface))) {
         SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "eglSwapBuffers failed");
+        if (gpu_fence != EGL_NO_SYNC_KHR) {
+            _this->egl_data->eglDestroySyncKHR(_this->egl_data->egl_display, gpu_fence);
+        }
         return 0;
     }
 
+    if (gpu_fence != EGL_NO_SYNC_KHR) {
+        gpu_fence_fd = _this->egl_data->eglDupNativeFenceFDANDROID(_this->egl_data->egl_display, gpu_fence);
+        _this->egl_data->eglDestroySyncKHR(_this->egl_data->egl_display, gpu_fence);
+    }
+
     /* From the GBM surface, get the next BO to become the next front buffer,
        and lock it so it can't be allocated as a back buffer (to prevent EGL
        from drawing into it!) */
     windata->next_bo = KMSDRM_gbm_surface_lock_front_buffer(windata->gs);
     if (!windata->next_bo) {
         SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not lock front buffer on GBM surface");
-        return 0;
+        goto cleanup;
     }
 
     /* Get an actual usable fb for the next front buffer. */
     fb_info = KMSDRM_FBFromBO(_this, windata->next_bo);
     if (!fb_info) {
         SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not get a framebuffer");
-        return 0;
+        goto cleanup;
     }
 
     if (!windata->bo) {
@@ -157,31 +186,26 @@ int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 
         if (ret) {
             SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not set videomode on CRTC.");
-            return 0;
+            goto cleanup;
         }
     } else {
         /* On subsequent swaps, queue the new front buffer to be flipped during
            the next vertical blank
 
-           Remember: drmModePageFlip() never blocks, it just issues the flip,
+           Remember: queueing a flip never blocks, it just issues the flip,
            which will be done during the next vblank, or immediately if
-           we pass the DRM_MODE_PAGE_FLIP_ASYNC flag.
-           Since calling drmModePageFlip() will return EBUSY if we call it
-           without having completed the last issued flip, we must pass the
-           DRM_MODE_PAGE_FLIP_ASYNC if we don't block on EGL (egl_swapinterval = 0).
+           we ask for an async flip.
+           Since queueing a flip will return EBUSY if we do it without having
+           completed the last issued flip, we must ask for an async flip if we
+           don't block on EGL (egl_swapinterval = 0).
            That makes it flip immediately, without waiting for the next vblank
            to do so, so even if we don't block on EGL, the flip will have completed
            when we get here again. */
-        if (_this->egl_data->egl_swapinterval == 0 && viddata->async_pageflip_support) {
-            flip_flags |= DRM_MODE_PAGE_FLIP_ASYNC;
-        }
-
-        ret = KMSDRM_drmModePageFlip(viddata->drm_fd, dispdata->crtc->crtc_id,
-                                     fb_info->fb_id, flip_flags, &windata->waiting_for_flip);
+        ret = KMSDRM_QueuePageflip(_this, window, fb_info->fb_id, gpu_fence_fd,
+                                   _this->egl_data->egl_swapinterval == 0);
+        gpu_fence_fd = -1;
 
-        if (ret == 0) {
-            windata->waiting_for_flip = SDL_TRUE;
-        } else {
+        if (ret != 0) {
             SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not queue pageflip: %d", ret);
         }
 
@@ -195,14 +219,28 @@ int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
            Run your SDL program with "SDL_KMSDRM_DOUBLE_BUFFER=1 <program_name>"
            to enable this. */
         if (windata->double_buffer) {
-            if (!KMSDRM_WaitPageflip(_this, windata)) {
+            if (windata->kms_out_fence_fd >= 0 && viddata->native_fence_support) {
+                /* Have the GPU wait for the flip before it draws the next frame
+                   into the old front buffer, instead of blocking here. */
+                EGLSyncKHR kms_fence = KMSDRM_GLES_CreateFence(_this, windata->kms_out_fence_fd);
+                if (kms_fence != EGL_NO_SYNC_KHR) {
+                    windata->kms_out_fence_fd = -1;
+                    _this->egl_data->eglWaitSyncKHR(_this->egl_data->egl_display, kms_fence, 0);
+                    _this->egl_data->eglDestroySyncKHR(_this->egl_data->egl_display, kms_fence);
+                }
+            } else if (!KMSDRM_WaitPageflip(_this, windata)) {
                 SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Immediate wait for previous pageflip failed");
                 return 0;
             }
         }
     }
+    result = 1;
 
-    return 1;
+cleanup:
+    if (gpu_fence_fd >= 0) {
+        close(gpu_fence_fd);
+    }
+    return result;
 }
 
 SDL_EGL_MakeCurrent_impl(KMSDRM)
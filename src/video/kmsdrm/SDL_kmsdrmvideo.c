@@ -38,6 +38,7 @@
 /* KMS/DRM declarations */
 #include "SDL_kmsdrmdyn.h"
 #include "SDL_kmsdrmevents.h"
+#include "SDL_kmsdrmframebuffer.h"
 #include "SDL_kmsdrmmouse.h"
 #include "SDL_kmsdrmvideo.h"
 #include "SDL_kmsdrmopengles.h"
@@ -65,6 +66,16 @@ static char kmsdrm_dri_cardpath[32];
 #define EGL_PLATFORM_GBM_MESA 0x31D7
 #endif
 
+#ifndef DRM_MODE_FB_MODIFIERS
+#define DRM_MODE_FB_MODIFIERS (1 << 1)
+#endif
+
+#define KMSDRM_FOURCC(a, b, c, d)     ((Uint32)(a) | ((Uint32)(b) << 8) | ((Uint32)(c) << 16) | ((Uint32)(d) << 24))
+#define KMSDRM_FORMAT_P010            KMSDRM_FOURCC('P', '0', '1', '0')
+#define KMSDRM_FORMAT_MOD_LINEAR      0
+#define KMSDRM_FORMAT_MOD_INVALID     0x00ffffffffffffffULL
+#define KMSDRM_OVERLAY_MAX_PLANES     4
+
 static int get_driindex(void)
 {
     int available = -ENOENT;
@@ -291,7 +302,11 @@ static SDL_VideoDevice *KMSDRM_CreateDevice(void)
     device->MaximizeWindow = KMSDRM_MaximizeWindow;
     device->MinimizeWindow = KMSDRM_MinimizeWindow;
     device->RestoreWindow = KMSDRM_RestoreWindow;
+    device->SetWindowVariableRefreshRate = KMSDRM_SetWindowVariableRefreshRate;
     device->DestroyWindow = KMSDRM_DestroyWindow;
+    device->CreateWindowFramebuffer = KMSDRM_CreateWindowFramebuffer;
+    device->UpdateWindowFramebuffer = KMSDRM_UpdateWindowFramebuffer;
+    device->DestroyWindowFramebuffer = KMSDRM_DestroyWindowFramebuffer;
 
     device->GL_LoadLibrary = KMSDRM_GLES_LoadLibrary;
     device->GL_GetProcAddress = KMSDRM_GLES_GetProcAddress;
@@ -479,6 +494,369 @@ SDL_bool KMSDRM_WaitPageflip(SDL_VideoDevice *_this, SDL_WindowData *windata)
     return SDL_TRUE;
 }
 
+/* Can the display's overlay plane scan out this format with this modifier? */
+static SDL_bool KMSDRM_OverlaySupportsFormat(const SDL_DisplayData *dispdata, uint32_t format, uint64_t modifier)
+{
+    const struct drm_format_modifier_blob *blob = dispdata->overlay_in_formats;
+    uint32_t i, j;
+
+    if (blob) {
+        const uint32_t *formats = (const uint32_t *)((const Uint8 *)blob + blob->formats_offset);
+        const struct drm_format_modifier *modifiers = (const struct drm_format_modifier *)((const Uint8 *)blob + blob->modifiers_offset);
+
+        for (i = 0; i < blob->count_formats; i++) {
+            if (formats[i] != format) {
+                continue;
+            }
+            if (modifier == KMSDRM_FORMAT_MOD_INVALID) {
+                return SDL_TRUE; /* The driver picks the layout */
+            }
+            /* Each modifier has a mask of the 64 formats starting at its offset */
+            for (j = 0; j < blob->count_modifiers; j++) {
+                if (modifiers[j].modifier == modifier &&
+                    i >= modifiers[j].offset && i < modifiers[j].offset + 64 &&
+                    (modifiers[j].formats & (1ULL << (i - modifiers[j].offset)))) {
+                    return SDL_TRUE;
+                }
+            }
+            return SDL_FALSE;
+        }
+        return SDL_FALSE;
+    }
+
+    /* Without IN_FORMATS, only assume the layouts every driver scans out */
+    if (modifier != KMSDRM_FORMAT_MOD_INVALID && modifier != KMSDRM_FORMAT_MOD_LINEAR) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < dispdata->num_overlay_formats; i++) {
+        if (dispdata->overlay_formats[i] == format) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Closes the GEM handles of an overlay buffer that no other cached buffer uses */
+static void KMSDRM_CloseOverlayHandles(SDL_VideoDevice *_this, SDL_WindowData *windata, const uint32_t *handles, const KMSDRM_OverlayBuffer *skip)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    int i, j, k;
+
+    for (i = 0; i < KMSDRM_OVERLAY_MAX_PLANES; i++) {
+        SDL_bool in_use = SDL_FALSE;
+
+        if (!handles[i]) {
+            continue;
+        }
+
+        /* Planes of one dmabuf share a handle, only close it once */
+        for (j = 0; j < i && !in_use; j++) {
+            in_use = (handles[j] == handles[i]);
+        }
+        for (j = 0; j < KMSDRM_OVERLAY_BUFFERS && !in_use; j++) {
+            const KMSDRM_OverlayBuffer *other = &windata->overlay_buffers[j];
+
+            if (other == skip || !other->fb_id) {
+                continue;
+            }
+            for (k = 0; k < KMSDRM_OVERLAY_MAX_PLANES; k++) {
+                if (other->handles[k] == handles[i]) {
+                    in_use = SDL_TRUE;
+                    break;
+                }
+            }
+        }
+
+        if (!in_use) {
+            struct drm_gem_close gem_close;
+
+            SDL_zero(gem_close);
+            gem_close.handle = handles[i];
+            KMSDRM_drmIoctl(viddata->drm_fd, DRM_IOCTL_GEM_CLOSE, &gem_close);
+        }
+    }
+}
+
+static void KMSDRM_ReleaseOverlayBuffer(SDL_VideoDevice *_this, SDL_WindowData *windata, KMSDRM_OverlayBuffer *buffer)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+
+    if (buffer->fb_id) {
+        KMSDRM_drmModeRmFB(viddata->drm_fd, buffer->fb_id);
+        KMSDRM_CloseOverlayHandles(_this, windata, buffer->handles, buffer);
+    }
+    SDL_zerop(buffer);
+}
+
+static void KMSDRM_ReleaseOverlayBuffers(SDL_VideoDevice *_this, SDL_WindowData *windata)
+{
+    int i;
+
+    for (i = 0; i < KMSDRM_OVERLAY_BUFFERS; i++) {
+        KMSDRM_ReleaseOverlayBuffer(_this, windata, &windata->overlay_buffers[i]);
+    }
+    windata->overlay_frame = 0;
+}
+
+/* Returns the KMS framebuffer for the dmabuf in the window's overlay
+   properties, importing it the first time it's seen, or NULL if there
+   is none or the display can't scan it out. */
+static KMSDRM_OverlayBuffer *KMSDRM_GetOverlayBuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PropertiesID props)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    KMSDRM_OverlayBuffer key, *buffer = NULL;
+    uint64_t modifiers[KMSDRM_OVERLAY_MAX_PLANES];
+    char name[64];
+    int i, ret;
+
+    SDL_zero(key);
+    SDL_zeroa(modifiers);
+    key.format = (uint32_t)SDL_GetNumberProperty(props, "SDL.window.kmsdrm.overlay.format", 0);
+    key.width = (uint32_t)SDL_GetNumberProperty(props, "SDL.window.kmsdrm.overlay.width", 0);
+    key.height = (uint32_t)SDL_GetNumberProperty(props, "SDL.window.kmsdrm.overlay.height", 0);
+    key.modifier = (uint64_t)SDL_GetNumberProperty(props, "SDL.window.kmsdrm.overlay.modifier", (Sint64)KMSDRM_FORMAT_MOD_INVALID);
+    if (!key.width || !key.height || !KMSDRM_OverlaySupportsFormat(dispdata, key.format, key.modifier)) {
+        return NULL;
+    }
+
+    for (i = 0; i < KMSDRM_OVERLAY_MAX_PLANES; i++) {
+        Sint64 fd;
+
+        SDL_snprintf(name, sizeof(name), "SDL.window.kmsdrm.overlay.fd%d", i);
+        fd = SDL_GetNumberProperty(props, name, -1);
+        if (fd < 0) {
+            break;
+        }
+        if (KMSDRM_drmPrimeFDToHandle(viddata->drm_fd, (int)fd, &key.handles[i]) != 0) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Could not import overlay dmabuf plane %d", i);
+            KMSDRM_CloseOverlayHandles(_this, windata, key.handles, NULL);
+            return NULL;
+        }
+        SDL_snprintf(name, sizeof(name), "SDL.window.kmsdrm.overlay.offset%d", i);
+        key.offsets[i] = (uint32_t)SDL_GetNumberProperty(props, name, 0);
+        SDL_snprintf(name, sizeof(name), "SDL.window.kmsdrm.overlay.pitch%d", i);
+        key.pitches[i] = (uint32_t)SDL_GetNumberProperty(props, name, 0);
+        modifiers[i] = key.modifier;
+    }
+
+    /* Importing a dmabuf we already have gives back the same handles */
+    for (i = 0; i < KMSDRM_OVERLAY_BUFFERS; i++) {
+        KMSDRM_OverlayBuffer *cached = &windata->overlay_buffers[i];
+
+        if (cached->fb_id && cached->format == key.format &&
+            cached->width == key.width && cached->height == key.height &&
+            cached->modifier == key.modifier &&
+            SDL_memcmp(cached->handles, key.handles, sizeof(key.handles)) == 0 &&
+            SDL_memcmp(cached->pitches, key.pitches, sizeof(key.pitches)) == 0 &&
+            SDL_memcmp(cached->offsets, key.offsets, sizeof(key.offsets)) == 0) {
+            buffer = cached;
+            break;
+        }
+    }
+
+    if (!buffer) {
+        KMSDRM_OverlayBuffer old;
+
+        if (key.modifier != KMSDRM_FORMAT_MOD_INVALID) {
+            ret = KMSDRM_drmModeAddFB2WithModifiers(viddata->drm_fd, key.width, key.height, key.format,
+                                                    key.handles, key.pitches, key.offsets, modifiers,
+                                                    &key.fb_id, DRM_MODE_FB_MODIFIERS);
+        } else {
+            ret = KMSDRM_drmModeAddFB2(viddata->drm_fd, key.width, key.height, key.format,
+                                       key.handles, key.pitches, key.offsets, &key.fb_id, 0);
+        }
+        if (ret != 0) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Could not create a framebuffer for the overlay dmabuf");
+            KMSDRM_CloseOverlayHandles(_this, windata, key.handles, NULL);
+            return NULL;
+        }
+
+        /* Reuse a free slot, or the one that was on screen the longest time ago */
+        buffer = &windata->overlay_buffers[0];
+        for (i = 0; i < KMSDRM_OVERLAY_BUFFERS && buffer->fb_id; i++) {
+            KMSDRM_OverlayBuffer *slot = &windata->overlay_buffers[i];
+
+            if (!slot->fb_id || slot->last_used < buffer->last_used) {
+                buffer = slot;
+            }
+        }
+
+        /* Only close the old handles once the new buffer holds on to its own */
+        old = *buffer;
+        *buffer = key;
+        if (old.fb_id) {
+            KMSDRM_drmModeRmFB(viddata->drm_fd, old.fb_id);
+            KMSDRM_CloseOverlayHandles(_this, windata, old.handles, NULL);
+        }
+    }
+
+    if (buffer->rejected) {
+        return NULL;
+    }
+    buffer->last_used = ++windata->overlay_frame;
+    return buffer;
+}
+
+/* Adds the overlay plane to an atomic commit: on with the window's overlay
+   dmabuf, or off if the app cleared it. Returns the buffer shown, if any. */
+static KMSDRM_OverlayBuffer *KMSDRM_AddOverlayPlane(SDL_VideoDevice *_this, SDL_Window *window, drmModeAtomicReqPtr req)
+{
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    const KMSDRM_PlaneProps *props = &dispdata->overlay_props;
+    const uint32_t plane_id = dispdata->overlay_plane_id;
+    SDL_PropertiesID window_props;
+    KMSDRM_OverlayBuffer *buffer = NULL;
+
+    if (!plane_id) {
+        return NULL;
+    }
+
+    window_props = SDL_GetWindowProperties(window);
+    if (SDL_GetNumberProperty(window_props, "SDL.window.kmsdrm.overlay.fd0", -1) >= 0) {
+        buffer = KMSDRM_GetOverlayBuffer(_this, window, window_props);
+    }
+
+    if (buffer) {
+        const Sint64 x = SDL_GetNumberProperty(window_props, "SDL.window.kmsdrm.overlay.x", 0);
+        const Sint64 y = SDL_GetNumberProperty(window_props, "SDL.window.kmsdrm.overlay.y", 0);
+        const Sint64 w = SDL_GetNumberProperty(window_props, "SDL.window.kmsdrm.overlay.w", dispdata->mode.hdisplay);
+        const Sint64 h = SDL_GetNumberProperty(window_props, "SDL.window.kmsdrm.overlay.h", dispdata->mode.vdisplay);
+
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->fb_id, buffer->fb_id);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_id, dispdata->crtc->crtc_id);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->src_x, 0);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->src_y, 0);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->src_w, (uint64_t)buffer->width << 16);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->src_h, (uint64_t)buffer->height << 16);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_x, (uint64_t)x);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_y, (uint64_t)y);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_w, (uint64_t)w);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_h, (uint64_t)h);
+    } else if (windata->overlay_active) {
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->fb_id, 0);
+        KMSDRM_drmModeAtomicAddProperty(req, plane_id, props->crtc_id, 0);
+    }
+    return buffer;
+}
+
+static int KMSDRM_AtomicPageflip(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id, int in_fence_fd)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    const KMSDRM_PlaneProps *props = &dispdata->plane_props;
+    const uint32_t crtc_id = dispdata->crtc->crtc_id;
+    const uint64_t w = dispdata->mode.hdisplay;
+    const uint64_t h = dispdata->mode.vdisplay;
+    drmModeAtomicReqPtr req;
+    KMSDRM_OverlayBuffer *overlay;
+    int cursor;
+    int ret;
+
+    req = KMSDRM_drmModeAtomicAlloc();
+    if (!req) {
+        return -ENOMEM;
+    }
+
+    /* Source coordinates are 16.16 fixed point */
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->fb_id, fb_id);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->crtc_id, crtc_id);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->src_x, 0);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->src_y, 0);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->src_w, w << 16);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->src_h, h << 16);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->crtc_x, 0);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->crtc_y, 0);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->crtc_w, w);
+    KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->crtc_h, h);
+
+    /* The buffer is scanned out once the GPU signals this, so the kernel
+       doesn't have to wait for rendering to finish on its own. */
+    if (in_fence_fd >= 0 && props->in_fence_fd) {
+        KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, props->in_fence_fd, (uint64_t)in_fence_fd);
+    }
+
+    /* The kernel writes a new fence FD here when the commit is accepted. */
+    if (dispdata->out_fence_ptr_prop_id) {
+        if (windata->kms_out_fence_fd >= 0) {
+            close(windata->kms_out_fence_fd);
+        }
+        windata->kms_out_fence_fd = -1;
+        KMSDRM_drmModeAtomicAddProperty(req, crtc_id, dispdata->out_fence_ptr_prop_id,
+                                        (uint64_t)(uintptr_t)&windata->kms_out_fence_fd);
+    }
+
+    /* The overlay goes last, so it can be dropped from the request again */
+    cursor = KMSDRM_drmModeAtomicGetCursor(req);
+    overlay = KMSDRM_AddOverlayPlane(_this, window, req);
+
+    ret = KMSDRM_drmModeAtomicCommit(viddata->drm_fd, req,
+                                     DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                                     &windata->waiting_for_flip);
+    if (ret != 0 && overlay) {
+        /* The plane can't show this buffer, maybe because of its size or
+           the scaling asked for. Don't try it again, and show the frame
+           without it, turning off what the plane was showing before. */
+        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "The overlay plane rejected the dmabuf, not using it");
+        overlay->rejected = SDL_TRUE;
+        overlay = NULL;
+        KMSDRM_drmModeAtomicSetCursor(req, cursor);
+        if (windata->overlay_active) {
+            KMSDRM_drmModeAtomicAddProperty(req, dispdata->overlay_plane_id, dispdata->overlay_props.fb_id, 0);
+            KMSDRM_drmModeAtomicAddProperty(req, dispdata->overlay_plane_id, dispdata->overlay_props.crtc_id, 0);
+        }
+        ret = KMSDRM_drmModeAtomicCommit(viddata->drm_fd, req,
+                                         DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                                         &windata->waiting_for_flip);
+    }
+    KMSDRM_drmModeAtomicFree(req);
+
+    if (ret == 0 && windata->overlay_active != (overlay != NULL)) {
+        windata->overlay_active = (overlay != NULL);
+        SDL_SetBooleanProperty(SDL_GetWindowProperties(window), "SDL.window.kmsdrm.overlay.active", windata->overlay_active);
+    }
+
+    return ret;
+}
+
+/* Queues fb_id to be scanned out on the window's CRTC at the next vblank,
+   or right away if async is set and the hardware can do it.
+   Takes ownership of in_fence_fd, which may be -1. */
+int KMSDRM_QueuePageflip(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id, int in_fence_fd, SDL_bool async)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_WindowData *windata = window->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    uint32_t flip_flags = DRM_MODE_PAGE_FLIP_EVENT;
+    int ret;
+
+    /* Async atomic commits aren't supported by every kernel we run on,
+       so those go through the legacy path. */
+    async = async && viddata->async_pageflip_support;
+
+    if (viddata->atomic_support && !async) {
+        ret = KMSDRM_AtomicPageflip(_this, window, fb_id, in_fence_fd);
+    } else {
+        if (async) {
+            flip_flags |= DRM_MODE_PAGE_FLIP_ASYNC;
+        }
+        ret = KMSDRM_drmModePageFlip(viddata->drm_fd, dispdata->crtc->crtc_id,
+                                     fb_id, flip_flags, &windata->waiting_for_flip);
+    }
+
+    if (in_fence_fd >= 0) {
+        close(in_fence_fd);
+    }
+
+    if (ret == 0) {
+        windata->waiting_for_flip = SDL_TRUE;
+    }
+    return ret;
+}
+
 /* Given w, h and refresh rate, returns the closest DRM video mode
    available on the DRM connector of the display.
    We use the SDL mode list (which we filled in KMSDRM_GetDisplayModes)
@@ -507,6 +885,15 @@ static drmModeModeInfo *KMSDRM_GetClosestDisplayMode(SDL_VideoDisplay *display,
 /* _this is a SDL_VideoDevice *                                              */
 /*****************************************************************************/
 
+static void KMSDRM_FreeOverlayFormats(SDL_DisplayData *dispdata)
+{
+    SDL_free(dispdata->overlay_formats);
+    dispdata->overlay_formats = NULL;
+    dispdata->num_overlay_formats = 0;
+    SDL_free(dispdata->overlay_in_formats);
+    dispdata->overlay_in_formats = NULL;
+}
+
 /* Deinitializes the driverdata of the SDL Displays in the SDL display list. */
 static void KMSDRM_DeinitDisplays(SDL_VideoDevice *_this)
 {
@@ -533,6 +920,10 @@ static void KMSDRM_DeinitDisplays(SDL_VideoDevice *_this)
                 KMSDRM_drmModeFreeCrtc(dispdata->crtc);
                 dispdata->crtc = NULL;
             }
+
+            if (dispdata) {
+                KMSDRM_FreeOverlayFormats(dispdata);
+            }
         }
         SDL_free(displays);
     }
@@ -672,6 +1063,44 @@ static SDL_bool KMSDRM_CrtcGetVrr(uint32_t drm_fd, uint32_t crtc_id)
     return SDL_FALSE;
 }
 
+/* Reports the display's variable refresh rate support, with the range
+   from the monitor's EDID */
+static void KMSDRM_SetDisplayVrrInfo(uint32_t drm_fd, uint32_t connector_id,
+                                     SDL_bool capable, SDL_DisplayID displayID)
+{
+    drmModePropertyBlobPtr edid = NULL;
+    uint32_t i;
+
+    if (capable) {
+        drmModeObjectPropertiesPtr props = KMSDRM_drmModeObjectGetProperties(drm_fd,
+                                                                             connector_id,
+                                                                             DRM_MODE_OBJECT_CONNECTOR);
+        if (props) {
+            for (i = 0; !edid && i < props->count_props; ++i) {
+                drmModePropertyPtr drm_prop = KMSDRM_drmModeGetProperty(drm_fd, props->props[i]);
+
+                if (!drm_prop) {
+                    continue;
+                }
+
+                if (SDL_strcmp(drm_prop->name, "EDID") == 0 && props->prop_values[i]) {
+                    edid = KMSDRM_drmModeGetPropertyBlob(drm_fd, (uint32_t)props->prop_values[i]);
+                }
+
+                KMSDRM_drmModeFreeProperty(drm_prop);
+            }
+            KMSDRM_drmModeFreeObjectProperties(props);
+        }
+    }
+
+    if (edid) {
+        SDL_SetDisplayVariableRefreshRateInfo(displayID, capable, (const Uint8 *)edid->data, edid->length);
+        KMSDRM_drmModeFreePropertyBlob(edid);
+    } else {
+        SDL_SetDisplayVariableRefreshRateInfo(displayID, capable, NULL, 0);
+    }
+}
+
 /* Gets a DRM connector, builds an SDL_Display with it, and adds it to the
    list of SDL Displays in _this->displays[]  */
 static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connector, drmModeRes *resources)
@@ -682,6 +1111,7 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     SDL_DisplayModeData *modedata = NULL;
     drmModeEncoder *encoder = NULL;
     drmModeCrtc *crtc = NULL;
+    SDL_DisplayID displayID;
     int mode_index;
     int i, j;
     int ret = 0;
@@ -835,13 +1265,9 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     dispdata->connector = connector;
     dispdata->crtc = crtc;
 
-    /* save previous vrr state */
+    /* save previous vrr state, windows turn vrr on when they ask for it */
     dispdata->saved_vrr = KMSDRM_CrtcGetVrr(viddata->drm_fd, crtc->crtc_id);
-    /* try to enable vrr */
-    if (KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE")) {
-        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Enabling VRR");
-        KMSDRM_CrtcSetVrr(viddata->drm_fd, crtc->crtc_id, SDL_TRUE);
-    }
+    dispdata->vrr_capable = KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE");
 
     /*****************************************/
     /* Part 2: setup the SDL_Display itself. */
@@ -866,10 +1292,12 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     display.desktop_mode.driverdata = modedata;
 
     /* Add the display to the list of SDL displays. */
-    if (SDL_AddVideoDisplay(&display, SDL_FALSE) == 0) {
+    displayID = SDL_AddVideoDisplay(&display, SDL_FALSE);
+    if (displayID == 0) {
         ret = -1;
         goto cleanup;
     }
+    KMSDRM_SetDisplayVrrInfo(viddata->drm_fd, connector->connector_id, dispdata->vrr_capable, displayID);
 
 cleanup:
     if (encoder) {
@@ -985,6 +1413,268 @@ cleanup:
     return ret;
 }
 
+/* Gets the IDs of the plane properties we set on atomic commits.
+   IN_FENCE_FD is optional, the rest isn't. */
+static SDL_bool KMSDRM_GetPlaneProps(SDL_VideoDevice *_this, uint32_t plane_id, KMSDRM_PlaneProps *props)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    drmModeObjectPropertiesPtr obj_props;
+
+    obj_props = KMSDRM_drmModeObjectGetProperties(viddata->drm_fd, plane_id, DRM_MODE_OBJECT_PLANE);
+    if (!obj_props) {
+        return SDL_FALSE;
+    }
+    props->fb_id = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "FB_ID");
+    props->crtc_id = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "CRTC_ID");
+    props->src_x = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "SRC_X");
+    props->src_y = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "SRC_Y");
+    props->src_w = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "SRC_W");
+    props->src_h = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "SRC_H");
+    props->crtc_x = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "CRTC_X");
+    props->crtc_y = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "CRTC_Y");
+    props->crtc_w = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "CRTC_W");
+    props->crtc_h = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "CRTC_H");
+    props->in_fence_fd = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "IN_FENCE_FD");
+    KMSDRM_drmModeFreeObjectProperties(obj_props);
+
+    return (props->fb_id && props->crtc_id &&
+            props->src_x && props->src_y && props->src_w && props->src_h &&
+            props->crtc_x && props->crtc_y && props->crtc_w && props->crtc_h);
+}
+
+/* The formats video decoders hand out, which we put on an overlay plane
+   instead of the primary plane. */
+static SDL_bool KMSDRM_IsOverlayFormat(uint32_t format)
+{
+    switch (format) {
+    case GBM_FORMAT_NV12:
+    case GBM_FORMAT_NV21:
+    case GBM_FORMAT_YUV420:
+    case GBM_FORMAT_YVU420:
+    case GBM_FORMAT_YUYV:
+    case GBM_FORMAT_YVYU:
+    case GBM_FORMAT_UYVY:
+    case KMSDRM_FORMAT_P010:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Keeps a copy of the formats an overlay plane takes, and of its IN_FORMATS
+   blob, which also says which modifiers work with each format. */
+static void KMSDRM_InitOverlayFormats(SDL_VideoDevice *_this, SDL_DisplayData *dispdata, drmModePlane *plane)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    drmModeObjectPropertiesPtr obj_props;
+    uint32_t i;
+
+    dispdata->overlay_formats = SDL_malloc(plane->count_formats * sizeof(*plane->formats));
+    if (dispdata->overlay_formats) {
+        SDL_memcpy(dispdata->overlay_formats, plane->formats, plane->count_formats * sizeof(*plane->formats));
+        dispdata->num_overlay_formats = plane->count_formats;
+    }
+
+    obj_props = KMSDRM_drmModeObjectGetProperties(viddata->drm_fd, plane->plane_id, DRM_MODE_OBJECT_PLANE);
+    for (i = 0; obj_props && i < obj_props->count_props; i++) {
+        drmModePropertyPtr drm_prop = KMSDRM_drmModeGetProperty(viddata->drm_fd, obj_props->props[i]);
+
+        if (!drm_prop) {
+            continue;
+        }
+
+        if (SDL_strcmp(drm_prop->name, "IN_FORMATS") == 0) {
+            drmModePropertyBlobPtr blob = KMSDRM_drmModeGetPropertyBlob(viddata->drm_fd, (uint32_t)obj_props->prop_values[i]);
+
+            if (blob) {
+                const struct drm_format_modifier_blob *header = blob->data;
+
+                /* Only trust a blob whose lists fit inside it */
+                if (blob->length >= sizeof(*header) &&
+                    (uint64_t)header->formats_offset + (uint64_t)header->count_formats * sizeof(uint32_t) <= blob->length &&
+                    (uint64_t)header->modifiers_offset + (uint64_t)header->count_modifiers * sizeof(struct drm_format_modifier) <= blob->length) {
+                    dispdata->overlay_in_formats = SDL_malloc(blob->length);
+                    if (dispdata->overlay_in_formats) {
+                        SDL_memcpy(dispdata->overlay_in_formats, blob->data, blob->length);
+                    }
+                }
+                KMSDRM_drmModeFreePropertyBlob(blob);
+            }
+        }
+
+        KMSDRM_drmModeFreeProperty(drm_prop);
+    }
+    if (obj_props) {
+        KMSDRM_drmModeFreeObjectProperties(obj_props);
+    }
+}
+
+/* Finds the primary plane that can feed the display's CRTC, and the IDs of
+   the properties we need to flip it with atomic commits.
+
+   Also looks for an overlay plane on the same CRTC that can scan out YUV
+   buffers. Apps hand us dmabufs for it with the SDL.window.kmsdrm.overlay.*
+   window properties, and KMSDRM_AtomicPageflip() puts them on screen in the
+   same commit as the window contents, so video frames don't have to be
+   converted and composited by the GPU. Not having one is fine. */
+static SDL_bool KMSDRM_InitDisplayPlane(SDL_VideoDevice *_this, SDL_DisplayData *dispdata, drmModeRes *resources)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    drmModePlaneRes *plane_resources;
+    drmModeObjectPropertiesPtr obj_props;
+    drmModePlane *overlay_plane = NULL;
+    uint32_t crtc_mask = 0;
+    uint32_t i;
+
+    for (i = 0; i < (uint32_t)resources->count_crtcs; i++) {
+        if (resources->crtcs[i] == dispdata->crtc->crtc_id) {
+            crtc_mask = 1u << i;
+            break;
+        }
+    }
+
+    plane_resources = KMSDRM_drmModeGetPlaneResources(viddata->drm_fd);
+    if (!plane_resources) {
+        return SDL_FALSE;
+    }
+
+    /* The FD may have been reopened, so start over */
+    dispdata->plane_id = 0;
+    dispdata->overlay_plane_id = 0;
+    KMSDRM_FreeOverlayFormats(dispdata);
+
+    for (i = 0; i < plane_resources->count_planes; i++) {
+        drmModePlane *plane = KMSDRM_drmModeGetPlane(viddata->drm_fd, plane_resources->planes[i]);
+        uint32_t j;
+
+        if (!plane) {
+            continue;
+        }
+
+        if (plane->possible_crtcs & crtc_mask) {
+            obj_props = KMSDRM_drmModeObjectGetProperties(viddata->drm_fd, plane->plane_id,
+                                                          DRM_MODE_OBJECT_PLANE);
+            for (j = 0; obj_props && j < obj_props->count_props; j++) {
+                drmModePropertyPtr drm_prop = KMSDRM_drmModeGetProperty(viddata->drm_fd, obj_props->props[j]);
+
+                if (!drm_prop) {
+                    continue;
+                }
+
+                if (SDL_strcmp(drm_prop->name, "type") == 0) {
+                    if (obj_props->prop_values[j] == DRM_PLANE_TYPE_PRIMARY) {
+                        /* Prefer the plane that's already showing this CRTC */
+                        if (!dispdata->plane_id || plane->crtc_id == dispdata->crtc->crtc_id) {
+                            dispdata->plane_id = plane->plane_id;
+                        }
+                    } else if (obj_props->prop_values[j] == DRM_PLANE_TYPE_OVERLAY && !overlay_plane &&
+                               (!plane->crtc_id || plane->crtc_id == dispdata->crtc->crtc_id)) {
+                        uint32_t k;
+
+                        for (k = 0; k < plane->count_formats; k++) {
+                            if (KMSDRM_IsOverlayFormat(plane->formats[k])) {
+                                break;
+                            }
+                        }
+                        if (k < plane->count_formats &&
+                            KMSDRM_GetPlaneProps(_this, plane->plane_id, &dispdata->overlay_props)) {
+                            overlay_plane = plane;
+                        }
+                    }
+                }
+
+                KMSDRM_drmModeFreeProperty(drm_prop);
+            }
+            if (obj_props) {
+                KMSDRM_drmModeFreeObjectProperties(obj_props);
+            }
+        }
+
+        if (plane != overlay_plane) {
+            KMSDRM_drmModeFreePlane(plane);
+        }
+    }
+    KMSDRM_drmModeFreePlaneResources(plane_resources);
+
+    if (overlay_plane) {
+        dispdata->overlay_plane_id = overlay_plane->plane_id;
+        KMSDRM_InitOverlayFormats(_this, dispdata, overlay_plane);
+        KMSDRM_drmModeFreePlane(overlay_plane);
+    }
+
+    if (!dispdata->plane_id) {
+        return SDL_FALSE;
+    }
+
+    obj_props = KMSDRM_drmModeObjectGetProperties(viddata->drm_fd, dispdata->crtc->crtc_id,
+                                                  DRM_MODE_OBJECT_CRTC);
+    if (obj_props) {
+        dispdata->out_fence_ptr_prop_id = KMSDRM_CrtcGetPropId(viddata->drm_fd, obj_props, "OUT_FENCE_PTR");
+        KMSDRM_drmModeFreeObjectProperties(obj_props);
+    }
+
+    return KMSDRM_GetPlaneProps(_this, dispdata->plane_id, &dispdata->plane_props);
+}
+
+/* Switches the DRM FD to atomic modesetting if the driver and every display
+   can do it. Displays are still set up with drmModeSetCrtc(), which works
+   for atomic clients too; only page flips go through atomic commits. */
+static void KMSDRM_InitAtomic(SDL_VideoDevice *_this)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_DisplayID *displays;
+    drmModeRes *resources;
+    int i;
+
+    viddata->atomic_support = SDL_FALSE;
+
+    if (!SDL_GetHintBoolean(SDL_HINT_KMSDRM_ATOMIC, SDL_TRUE)) {
+        return;
+    }
+
+    if (KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_ATOMIC, 1) != 0) {
+        return;
+    }
+
+    resources = KMSDRM_drmModeGetResources(viddata->drm_fd);
+    if (!resources) {
+        KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_ATOMIC, 0);
+        return;
+    }
+
+    viddata->atomic_support = SDL_TRUE;
+    displays = SDL_GetDisplays(NULL);
+    if (displays) {
+        for (i = 0; displays[i]; ++i) {
+            SDL_DisplayData *dispdata = SDL_GetDisplayDriverData(displays[i]);
+
+            int j;
+
+            if (!dispdata || !KMSDRM_InitDisplayPlane(_this, dispdata, resources)) {
+                viddata->atomic_support = SDL_FALSE;
+                break;
+            }
+
+            /* An overlay plane can only be on one CRTC at a time */
+            for (j = 0; j < i && dispdata->overlay_plane_id; ++j) {
+                SDL_DisplayData *other = SDL_GetDisplayDriverData(displays[j]);
+
+                if (other->overlay_plane_id == dispdata->overlay_plane_id) {
+                    dispdata->overlay_plane_id = 0;
+                    KMSDRM_FreeOverlayFormats(dispdata);
+                }
+            }
+        }
+        SDL_free(displays);
+    }
+    KMSDRM_drmModeFreeResources(resources);
+
+    if (!viddata->atomic_support) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Missing primary plane properties, not using atomic commits");
+        KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_ATOMIC, 0);
+    }
+}
+
 /* Init the Vulkan-INCOMPATIBLE stuff:
    Reopen FD, create gbm dev, create dumb buffer and setup display plane.
    This is to be called late, in WindowCreate(), and ONLY if this is not
@@ -1010,6 +1700,9 @@ static int KMSDRM_GBMInit(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
         ret = SDL_SetError("Couldn't create gbm device.");
     }
 
+    /* The client caps belong to this FD, so this is done every time it's reopened. */
+    KMSDRM_InitAtomic(_this);
+
     viddata->gbm_init = SDL_TRUE;
 
     return ret;
@@ -1033,6 +1726,8 @@ static void KMSDRM_GBMDeinit(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
         viddata->drm_fd = -1;
     }
 
+    viddata->atomic_support = SDL_FALSE;
+    viddata->native_fence_support = SDL_FALSE;
     viddata->gbm_init = SDL_FALSE;
 }
 
@@ -1068,6 +1763,15 @@ static void KMSDRM_DestroySurfaces(SDL_VideoDevice *_this, SDL_Window *window)
         SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not restore CRTC");
     }
 
+    /* Take the app's dmabuf off the overlay plane before letting go of it */
+    if (windata->overlay_active) {
+        KMSDRM_drmModeSetPlane(viddata->drm_fd, dispdata->overlay_plane_id, 0, 0, 0,
+                               0, 0, 0, 0, 0, 0, 0, 0);
+        windata->overlay_active = SDL_FALSE;
+        SDL_SetBooleanProperty(SDL_GetWindowProperties(window), "SDL.window.kmsdrm.overlay.active", SDL_FALSE);
+    }
+    KMSDRM_ReleaseOverlayBuffers(_this, windata);
+
     /***************************/
     /* Destroy the EGL surface */
     /***************************/
@@ -1079,6 +1783,11 @@ static void KMSDRM_DestroySurfaces(SDL_VideoDevice *_this, SDL_Window *window)
         windata->egl_surface = EGL_NO_SURFACE;
     }
 
+    if (windata->kms_out_fence_fd >= 0) {
+        close(windata->kms_out_fence_fd);
+        windata->kms_out_fence_fd = -1;
+    }
+
     /***************************/
     /* Destroy the GBM buffers */
     /***************************/
@@ -1465,6 +2174,7 @@ int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Properti
 
     /* Setup driver data for this window */
     windata->viddata = viddata;
+    windata->kms_out_fence_fd = -1;
     window->driverdata = windata;
 
     SDL_PropertiesID props = SDL_GetWindowProperties(window);
@@ -1522,6 +2232,14 @@ int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Properti
             _this->gl_config.driver_loaded = 1;
         }
 
+        /* Rendering fences can only be handed to KMS in atomic commits. */
+        viddata->native_fence_support = viddata->atomic_support &&
+                                        _this->egl_data->eglCreateSyncKHR &&
+                                        _this->egl_data->eglDestroySyncKHR &&
+                                        _this->egl_data->eglDupNativeFenceFDANDROID &&
+                                        _this->egl_data->eglWaitSyncKHR &&
+                                        SDL_EGL_HasExtension(_this, SDL_EGL_DISPLAY_EXTENSION, "EGL_ANDROID_native_fence_sync");
+
         /* Create the cursor BO for the display of this window,
            now that we know this is not a VK window. */
         KMSDRM_CreateCursorBO(display);
@@ -1626,4 +2344,18 @@ void KMSDRM_RestoreWindow(SDL_VideoDevice *_this, SDL_Window *window)
 {
 }
 
+int KMSDRM_SetWindowVariableRefreshRate(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool enabled)
+{
+    SDL_VideoData *viddata = _this->driverdata;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+
+    if (!dispdata->vrr_capable) {
+        return SDL_SetError("Display doesn't support variable refresh rate");
+    }
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "%s VRR", enabled ? "Enabling" : "Disabling");
+    KMSDRM_CrtcSetVrr(viddata->drm_fd, dispdata->crtc->crtc_id, enabled);
+    return 0;
+}
+
 #endif /* SDL_VIDEO_DRIVER_KMSDRM */
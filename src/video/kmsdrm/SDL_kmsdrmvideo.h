@@ -44,6 +44,8 @@ struct SDL_VideoData
     SDL_bool video_init;             /* Has VideoInit succeeded? */
     SDL_bool vulkan_mode;            /* Are we in Vulkan mode? One VK window is enough to be. */
     SDL_bool async_pageflip_support; /* Does the hardware support async. pageflips? */
+    SDL_bool atomic_support;         /* Are page flips done with atomic commits? */
+    SDL_bool native_fence_support;   /* Can EGL give us fences to pass to KMS? */
 
     SDL_Window **windows;
     int max_windows;
@@ -55,6 +57,34 @@ struct SDL_VideoData
 
 };
 
+/* The IDs of the plane properties we set on each atomic commit */
+typedef struct KMSDRM_PlaneProps
+{
+    uint32_t fb_id;
+    uint32_t crtc_id;
+    uint32_t src_x, src_y, src_w, src_h;
+    uint32_t crtc_x, crtc_y, crtc_w, crtc_h;
+    uint32_t in_fence_fd;
+} KMSDRM_PlaneProps;
+
+/* A dmabuf from the SDL.window.kmsdrm.overlay.* window properties, imported
+   as a KMS framebuffer. Players cycle through a handful of buffers, so these
+   are kept around instead of being added and removed on every flip. */
+typedef struct KMSDRM_OverlayBuffer
+{
+    uint32_t fb_id; /* 0 if this slot is unused */
+    uint32_t format;
+    uint32_t width, height;
+    uint32_t handles[4];
+    uint32_t pitches[4];
+    uint32_t offsets[4];
+    uint64_t modifier;
+    Uint64 last_used;
+    SDL_bool rejected; /* The overlay plane wouldn't take it */
+} KMSDRM_OverlayBuffer;
+
+#define KMSDRM_OVERLAY_BUFFERS 8
+
 struct SDL_DisplayModeData
 {
     int mode_index;
@@ -70,6 +100,19 @@ struct SDL_DisplayData
 
     drmModeCrtc *saved_crtc; /* CRTC to restore on quit */
     SDL_bool saved_vrr;
+    SDL_bool vrr_capable;
+
+    /* Atomic modesetting: the primary plane feeding our CRTC. */
+    uint32_t plane_id;
+    KMSDRM_PlaneProps plane_props;
+    uint32_t out_fence_ptr_prop_id; /* 0 if the CRTC can't give out fences */
+
+    /* Atomic modesetting: an overlay plane that can scan out YUV buffers, or 0. */
+    uint32_t overlay_plane_id;
+    KMSDRM_PlaneProps overlay_props;
+    uint32_t *overlay_formats;
+    uint32_t num_overlay_formats;
+    struct drm_format_modifier_blob *overlay_in_formats; /* NULL if the driver doesn't list modifiers */
 
     /* DRM & GBM cursor stuff lives here, not in an SDL_Cursor's driverdata struct,
        because setting/unsetting up these is done on window creation/destruction,
@@ -96,6 +139,15 @@ struct SDL_WindowData
     SDL_bool waiting_for_flip;
     SDL_bool double_buffer;
 
+    /* Signaled by KMS when the last committed buffer is on screen, or -1 */
+    int kms_out_fence_fd;
+
+    struct SDL_KMSDRM_Framebuffer *framebuffer;
+
+    KMSDRM_OverlayBuffer overlay_buffers[KMSDRM_OVERLAY_BUFFERS];
+    Uint64 overlay_frame;
+    SDL_bool overlay_active; /* The last commit put a buffer on the overlay plane */
+
     EGLSurface egl_surface;
     SDL_bool egl_surface_dirty;
 };
@@ -111,6 +163,7 @@ int KMSDRM_CreateSurfaces(SDL_VideoDevice *_this, SDL_Window *window);
 KMSDRM_FBInfo *KMSDRM_FBFromBO(SDL_VideoDevice *_this, struct gbm_bo *bo);
 KMSDRM_FBInfo *KMSDRM_FBFromBO2(SDL_VideoDevice *_this, struct gbm_bo *bo, int w, int h);
 SDL_bool KMSDRM_WaitPageflip(SDL_VideoDevice *_this, SDL_WindowData *windata);
+int KMSDRM_QueuePageflip(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id, int in_fence_fd, SDL_bool async);
 
 /****************************************************************************/
 /* SDL_VideoDevice functions declaration                                    */
@@ -132,6 +185,7 @@ void KMSDRM_RaiseWindow(SDL_VideoDevice *_this, SDL_Window *window);
 void KMSDRM_MaximizeWindow(SDL_VideoDevice *_this, SDL_Window *window);
 void KMSDRM_MinimizeWindow(SDL_VideoDevice *_this, SDL_Window *window);
 void KMSDRM_RestoreWindow(SDL_VideoDevice *_this, SDL_Window *window);
+int KMSDRM_SetWindowVariableRefreshRate(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool enabled);
 void KMSDRM_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window);
 
 /* OpenGL/OpenGL ES functions */
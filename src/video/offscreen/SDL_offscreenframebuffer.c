@@ -23,7 +23,9 @@
 #ifdef SDL_VIDEO_DRIVER_OFFSCREEN
 
 #include "../SDL_sysvideo.h"
+#include "../SDL_egl_c.h"
 #include "SDL_offscreenframebuffer_c.h"
+#include "SDL_offscreenwindow.h"
 
 #define OFFSCREEN_SURFACE "SDL.internal.window.surface"
 
@@ -58,7 +60,7 @@ int SDL_OFFSCREEN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *wi
 
 int SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
 {
-    static int frame_number;
+    SDL_WindowData *data = window->driverdata;
     SDL_Surface *surface;
 
     surface = (SDL_Surface *)SDL_GetProperty(SDL_GetWindowProperties(window), OFFSCREEN_SURFACE, NULL);
@@ -70,7 +72,7 @@ int SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *wi
     if (SDL_getenv("SDL_VIDEO_OFFSCREEN_SAVE_FRAMES")) {
         char file[128];
         (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.bmp",
-                           SDL_GetWindowID(window), ++frame_number);
+                           SDL_GetWindowID(window), ++data->frame_number);
         SDL_SaveBMP(surface, file);
     }
     return 0;
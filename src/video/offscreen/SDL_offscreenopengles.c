@@ -70,7 +70,9 @@ int OFFSCREEN_GLES_MakeCurrent(SDL_VideoDevice *_this, SDL_Window *window, SDL_G
         EGLSurface egl_surface = window->driverdata->egl_surface;
         return SDL_EGL_MakeCurrent(_this, egl_surface, context);
     } else {
-        return SDL_EGL_MakeCurrent(_this, NULL, NULL);
+        /* Contexts can be used without a window with EGL_KHR_surfaceless_context,
+           which lets worker threads render into their own framebuffer objects. */
+        return SDL_EGL_MakeCurrent(_this, NULL, context);
     }
 }
 
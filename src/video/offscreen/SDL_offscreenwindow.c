@@ -30,6 +30,9 @@
 int OFFSCREEN_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_PropertiesID create_props)
 {
     SDL_WindowData *offscreen_window = (SDL_WindowData *)SDL_calloc(1, sizeof(SDL_WindowData));
+#ifdef SDL_VIDEO_OPENGL_EGL
+    SDL_PropertiesID props;
+#endif
 
     if (!offscreen_window) {
         return SDL_OutOfMemory();
@@ -60,6 +63,12 @@ int OFFSCREEN_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Prope
             return SDL_SetError("Failed to created an offscreen surface (EGL display: %p)",
                                 _this->egl_data->egl_display);
         }
+
+        /* Let applications read back or export what they render without going through SDL */
+        props = SDL_GetWindowProperties(window);
+        SDL_SetProperty(props, "SDL.window.offscreen.egl_display", _this->egl_data->egl_display);
+        SDL_SetProperty(props, "SDL.window.offscreen.egl_config", _this->egl_data->egl_config);
+        SDL_SetProperty(props, "SDL.window.offscreen.egl_surface", offscreen_window->egl_surface);
     } else {
         offscreen_window->egl_surface = EGL_NO_SURFACE;
     }
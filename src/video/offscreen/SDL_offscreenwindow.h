@@ -28,6 +28,7 @@
 struct SDL_WindowData
 {
     SDL_Window *sdl_window;
+    int frame_number; /* The number of the last frame saved by SDL_VIDEO_OFFSCREEN_SAVE_FRAMES */
 #ifdef SDL_VIDEO_OPENGL_EGL
     EGLSurface egl_surface;
 #endif
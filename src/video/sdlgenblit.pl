@@ -33,11 +33,16 @@ my @src_formats = (
     "RGBA8888",
     "ABGR8888",
     "BGRA8888",
+    "ARGB2101010",
 );
 my @dst_formats = (
     "XRGB8888",
     "XBGR8888",
     "ARGB8888",
+    "RGBA8888",
+    "ABGR8888",
+    "BGRA8888",
+    "ARGB2101010",
 );
 
 my %format_size = (
@@ -47,6 +52,7 @@ my %format_size = (
     "RGBA8888" => 4,
     "ABGR8888" => 4,
     "BGRA8888" => 4,
+    "ARGB2101010" => 4,
 );
 
 my %format_type = (
@@ -56,6 +62,7 @@ my %format_type = (
     "RGBA8888" => "Uint32",
     "ABGR8888" => "Uint32",
     "BGRA8888" => "Uint32",
+    "ARGB2101010" => "Uint32",
 );
 
 my %get_rgba_string_ignore_alpha = (
@@ -65,6 +72,7 @@ my %get_rgba_string_ignore_alpha = (
     "RGBA8888" => "_R = (Uint8)(_pixel >> 24); _G = (Uint8)(_pixel >> 16); _B = (Uint8)(_pixel >> 8);",
     "ABGR8888" => "_B = (Uint8)(_pixel >> 16); _G = (Uint8)(_pixel >> 8); _R = (Uint8)_pixel;",
     "BGRA8888" => "_B = (Uint8)(_pixel >> 24); _G = (Uint8)(_pixel >> 16); _R = (Uint8)(_pixel >> 8);",
+    "ARGB2101010" => "_R = (Uint8)(_pixel >> 22); _G = (Uint8)(_pixel >> 12); _B = (Uint8)(_pixel >> 2);",
 );
 
 my %get_rgba_string = (
@@ -74,6 +82,7 @@ my %get_rgba_string = (
     "RGBA8888" => $get_rgba_string_ignore_alpha{"RGBA8888"} . " _A = (Uint8)_pixel;",
     "ABGR8888" => $get_rgba_string_ignore_alpha{"ABGR8888"} . " _A = (Uint8)(_pixel >> 24);",
     "BGRA8888" => $get_rgba_string_ignore_alpha{"BGRA8888"} . " _A = (Uint8)_pixel;",
+    "ARGB2101010" => $get_rgba_string_ignore_alpha{"ARGB2101010"} . " _A = (_pixel >> 30) * 0x55;",
 );
 
 my %set_rgba_string = (
@@ -83,6 +92,7 @@ my %set_rgba_string = (
     "RGBA8888" => "_pixel = (_R << 24) | (_G << 16) | (_B << 8) | _A;",
     "ABGR8888" => "_pixel = (_A << 24) | (_B << 16) | (_G << 8) | _R;",
     "BGRA8888" => "_pixel = (_B << 24) | (_G << 16) | (_R << 8) | _A;",
+    "ARGB2101010" => "_pixel = (((_A * 3) / 255) << 30) | ((_R ? ((_R << 2) | 0x3) : 0) << 20) | ((_G ? ((_G << 2) | 0x3) : 0) << 10) | (_B ? ((_B << 2) | 0x3) : 0);",
 );
 
 sub open_file {
@@ -249,10 +259,10 @@ __EOF__
             *dst = pixel;
 __EOF__
                 } else {
-                    # ARGB -> RGBA -- unused
+                    # ARGB -> RGBA
                     print FILE <<__EOF__;
             pixel = *src;
-            pixel = (pixel << 8) | A;
+            pixel = (pixel << 8) | (pixel >> 24);
             *dst = pixel;
 __EOF__
                 }
@@ -266,7 +276,7 @@ __EOF__
             *dst = pixel;
 __EOF__
                 } else {
-                    # XRGB -> RGBA -- unused
+                    # XRGB -> RGBA
                     print FILE <<__EOF__;
             pixel = *src;
             pixel = (pixel << 8) | A;
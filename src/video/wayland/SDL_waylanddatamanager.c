@@ -87,14 +87,21 @@ static ssize_t write_pipe(int fd, const void *buffer, size_t total_length, size_
     return bytes_written;
 }
 
-static ssize_t read_pipe(int fd, void **buffer, size_t *total_length)
+/* Read the next chunk straight into the output buffer, which grows geometrically so large transfers aren't quadratic */
+static ssize_t read_pipe(int fd, void **buffer, size_t *total_length, size_t *allocated)
 {
     int ready = 0;
-    void *output_buffer = NULL;
-    char temp[PIPE_BUF];
-    size_t new_buffer_length = 0;
     ssize_t bytes_read = 0;
-    size_t pos = 0;
+
+    if (*total_length + PIPE_BUF + sizeof(Uint32) > *allocated) {
+        size_t new_allocated = SDL_max(*allocated * 2, *total_length + PIPE_BUF + sizeof(Uint32));
+        void *output_buffer = SDL_realloc(*buffer, new_allocated);
+        if (!output_buffer) {
+            return SDL_OutOfMemory();
+        }
+        *buffer = output_buffer;
+        *allocated = new_allocated;
+    }
 
     ready = SDL_IOReady(fd, SDL_IOR_READ, PIPE_TIMEOUT_NS);
 
@@ -103,32 +110,30 @@ static ssize_t read_pipe(int fd, void **buffer, size_t *total_length)
     } else if (ready < 0) {
         bytes_read = SDL_SetError("Pipe select error");
     } else {
-        bytes_read = read(fd, temp, sizeof(temp));
+        bytes_read = read(fd, (Uint8 *)*buffer + *total_length, *allocated - *total_length - sizeof(Uint32));
     }
 
     if (bytes_read > 0) {
-        pos = *total_length;
         *total_length += bytes_read;
+    }
+    SDL_memset((Uint8 *)*buffer + *total_length, 0, sizeof(Uint32));
 
-        new_buffer_length = *total_length + sizeof(Uint32);
-
-        if (!*buffer) {
-            output_buffer = SDL_malloc(new_buffer_length);
-        } else {
-            output_buffer = SDL_realloc(*buffer, new_buffer_length);
-        }
+    return bytes_read;
+}
 
-        if (!output_buffer) {
-            bytes_read = SDL_OutOfMemory();
-        } else {
-            SDL_memcpy((Uint8 *)output_buffer + pos, temp, bytes_read);
-            SDL_memset((Uint8 *)output_buffer + (new_buffer_length - sizeof(Uint32)), 0, sizeof(Uint32));
+/* Read everything the other end writes to the pipe */
+static void *receive_pipe(int fd, size_t *length)
+{
+    void *buffer = NULL;
+    size_t allocated = 0;
 
-            *buffer = output_buffer;
-        }
+    while (read_pipe(fd, &buffer, length, &allocated) > 0) {
     }
-
-    return bytes_read;
+    if (*length == 0) {
+        SDL_free(buffer);
+        buffer = NULL;
+    }
+    return buffer;
 }
 
 static SDL_MimeDataList *mime_data_list_find(struct wl_list *list,
@@ -380,8 +385,7 @@ void *Wayland_data_offer_receive(SDL_WaylandDataOffer *offer,
 
         close(pipefd[1]);
 
-        while (read_pipe(pipefd[0], &buffer, length) > 0) {
-        }
+        buffer = receive_pipe(pipefd[0], length);
         close(pipefd[0]);
     }
     return buffer;
@@ -413,8 +417,7 @@ void *Wayland_primary_selection_offer_receive(SDL_WaylandPrimarySelectionOffer *
 
         close(pipefd[1]);
 
-        while (read_pipe(pipefd[0], &buffer, length) > 0) {
-        }
+        buffer = receive_pipe(pipefd[0], length);
         close(pipefd[0]);
     }
     return buffer;
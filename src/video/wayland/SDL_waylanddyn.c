@@ -51,14 +51,23 @@ static waylanddynlib waylandlibs[] = {
     { NULL, NULL }
 };
 
+/* The symbols are listed grouped by the library that provides them, so the
+   search starts in the library where the previous symbol was found instead
+   of trying every library in turn. */
+static int wayland_lastlib = 0;
+
 static void *WAYLAND_GetSym(const char *fnname, int *pHasModule, SDL_bool required)
 {
+    const int numlibs = (int)SDL_TABLESIZE(waylandlibs) - 1; /* the last entry is the terminator */
     void *fn = NULL;
-    waylanddynlib *dynlib;
-    for (dynlib = waylandlibs; dynlib->libname; dynlib++) {
+    waylanddynlib *dynlib = NULL;
+    int i;
+    for (i = 0; i < numlibs; i++) {
+        dynlib = &waylandlibs[(wayland_lastlib + i) % numlibs];
         if (dynlib->lib) {
             fn = SDL_LoadFunction(dynlib->lib, fnname);
             if (fn) {
+                wayland_lastlib = (int)(dynlib - waylandlibs);
                 break;
             }
         }
@@ -132,6 +141,7 @@ int SDL_WAYLAND_LoadSymbols(void)
 #ifdef SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC
         int i;
         int *thismod = NULL;
+        wayland_lastlib = 0;
         for (i = 0; i < SDL_TABLESIZE(waylandlibs); i++) {
             if (waylandlibs[i].libname) {
                 waylandlibs[i].lib = SDL_LoadObject(waylandlibs[i].libname);
@@ -391,8 +391,12 @@ int Wayland_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
      * If the default queue is empty, it will prepare us for our SDL_IOReady() call. */
     if (WAYLAND_wl_display_prepare_read(d->display) == 0) {
         /* Use SDL_IOR_NO_RETRY to ensure SIGINT will break us out of our wait */
-        int err = SDL_IOReady(WAYLAND_wl_display_get_fd(d->display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
-        if (err > 0) {
+        int err = SDL_IOReadyWakeup(WAYLAND_wl_display_get_fd(d->display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+        if (err == 2) {
+            /* An input device woke us up, let the caller pump events */
+            WAYLAND_wl_display_cancel_read(d->display);
+            return 1;
+        } else if (err > 0) {
             /* There are new events available to read */
             WAYLAND_wl_display_read_events(d->display);
             return dispatch_queued_events(d);
@@ -0,0 +1,295 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "SDL_waylandvideo.h"
+#include "SDL_waylandwindow.h"
+#include "SDL_waylandframebuffer.h"
+
+/* The window surface is memory of our own, and when the window is updated
+ * the parts that changed are copied into a wl_shm buffer the compositor
+ * isn't using. Up to three buffers are created as they're needed, so a
+ * compositor that holds on to a buffer while it shows the next one doesn't
+ * hold us up. If all of them are still in use, the update is sent as soon
+ * as one of them is released.
+ */
+#define WAYLAND_FRAMEBUFFER_MAX_BUFFERS 3
+
+typedef struct
+{
+    struct wl_buffer *buffer;
+    void *pixels;
+    size_t size;
+    SDL_Rect damage; /* The area that changed since this buffer was filled */
+    SDL_bool busy;   /* Attached and not released by the compositor yet */
+} Wayland_FramebufferBuffer;
+
+typedef struct SDL_WaylandFramebuffer SDL_WaylandFramebuffer;
+
+struct SDL_WaylandFramebuffer
+{
+    SDL_WindowData *wind;
+    void *pixels;
+    int width, height, pitch;
+    Wayland_FramebufferBuffer buffers[WAYLAND_FRAMEBUFFER_MAX_BUFFERS];
+    int num_buffers;
+    SDL_Rect unsent; /* The area that changed since the last commit */
+};
+
+static int Wayland_PresentFramebuffer(SDL_WaylandFramebuffer *fb, const SDL_Rect *rects, int numrects);
+
+static void framebuffer_buffer_release(void *data, struct wl_buffer *buffer)
+{
+    SDL_WaylandFramebuffer *fb = (SDL_WaylandFramebuffer *)data;
+    int i;
+
+    for (i = 0; i < fb->num_buffers; ++i) {
+        if (fb->buffers[i].buffer == buffer) {
+            fb->buffers[i].busy = SDL_FALSE;
+        }
+    }
+
+    /* Send an update that was held back because no buffer was free */
+    if (!SDL_RectEmpty(&fb->unsent)) {
+        Wayland_PresentFramebuffer(fb, NULL, 0);
+    }
+}
+
+static const struct wl_buffer_listener framebuffer_buffer_listener = {
+    framebuffer_buffer_release
+};
+
+static Wayland_FramebufferBuffer *Wayland_AddFramebufferBuffer(SDL_WaylandFramebuffer *fb)
+{
+    SDL_VideoData *viddata = fb->wind->waylandData;
+    Wayland_FramebufferBuffer *buf = &fb->buffers[fb->num_buffers];
+    const size_t size = (size_t)fb->height * fb->pitch;
+    struct wl_shm_pool *shm_pool;
+    int shm_fd;
+
+    shm_fd = Wayland_CreateShmFile((off_t)size);
+    if (shm_fd < 0) {
+        SDL_SetError("Creating window framebuffer failed.");
+        return NULL;
+    }
+
+    buf->pixels = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    if (buf->pixels == MAP_FAILED) {
+        buf->pixels = NULL;
+        close(shm_fd);
+        SDL_SetError("mmap() failed.");
+        return NULL;
+    }
+
+    shm_pool = wl_shm_create_pool(viddata->shm, shm_fd, (int32_t)size);
+    buf->buffer = wl_shm_pool_create_buffer(shm_pool, 0, fb->width, fb->height, fb->pitch, WL_SHM_FORMAT_XRGB8888);
+    wl_buffer_add_listener(buf->buffer, &framebuffer_buffer_listener, fb);
+    wl_shm_pool_destroy(shm_pool);
+    close(shm_fd);
+
+    /* All of a new buffer has to be filled */
+    buf->size = size;
+    buf->damage.x = 0;
+    buf->damage.y = 0;
+    buf->damage.w = fb->width;
+    buf->damage.h = fb->height;
+    buf->busy = SDL_FALSE;
+    ++fb->num_buffers;
+    return buf;
+}
+
+/* Sends fb->unsent, or the given rects if they cover all of it */
+static int Wayland_PresentFramebuffer(SDL_WaylandFramebuffer *fb, const SDL_Rect *rects, int numrects)
+{
+    SDL_WindowData *wind = fb->wind;
+    Wayland_FramebufferBuffer *buf = NULL;
+    int i;
+
+    /* Attaching a buffer before the surface is configured is a protocol error,
+     * and there's no point in drawing a hidden window.
+     */
+    if (wind->surface_status != WAYLAND_SURFACE_STATUS_SHOWN &&
+        wind->surface_status != WAYLAND_SURFACE_STATUS_WAITING_FOR_FRAME) {
+        return 0;
+    }
+
+    for (i = 0; i < fb->num_buffers; ++i) {
+        if (!fb->buffers[i].busy) {
+            buf = &fb->buffers[i];
+            break;
+        }
+    }
+    if (!buf) {
+        if (fb->num_buffers == WAYLAND_FRAMEBUFFER_MAX_BUFFERS) {
+            return 0; /* Sent when a buffer is released */
+        }
+        buf = Wayland_AddFramebufferBuffer(fb);
+        if (!buf) {
+            return -1;
+        }
+    }
+
+    /* Bring the buffer up to date */
+    if (!SDL_RectEmpty(&buf->damage)) {
+        const size_t offset = (size_t)buf->damage.y * fb->pitch + (size_t)buf->damage.x * 4;
+        const Uint8 *src = (const Uint8 *)fb->pixels + offset;
+        Uint8 *dst = (Uint8 *)buf->pixels + offset;
+        int y;
+
+        for (y = 0; y < buf->damage.h; ++y) {
+            SDL_memcpy(dst, src, (size_t)buf->damage.w * 4);
+            src += fb->pitch;
+            dst += fb->pitch;
+        }
+        SDL_zero(buf->damage);
+    }
+
+    wl_surface_attach(wind->surface, buf->buffer, 0, 0);
+    if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+        if (rects) {
+            const SDL_Rect bounds = { 0, 0, fb->width, fb->height };
+            SDL_Rect rect;
+
+            for (i = 0; i < numrects; ++i) {
+                if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+                    wl_surface_damage_buffer(wind->surface, rect.x, rect.y, rect.w, rect.h);
+                }
+            }
+        } else {
+            wl_surface_damage_buffer(wind->surface, fb->unsent.x, fb->unsent.y, fb->unsent.w, fb->unsent.h);
+        }
+    } else {
+        /* Surface coordinates depend on the scale, so damage everything */
+        wl_surface_damage(wind->surface, 0, 0, wind->wl_window_width, wind->wl_window_height);
+    }
+    wl_surface_commit(wind->surface);
+    WAYLAND_wl_display_flush(wind->waylandData->display);
+
+    buf->busy = SDL_TRUE;
+    SDL_zero(fb->unsent);
+    return 0;
+}
+
+int Wayland_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, Uint32 *format,
+                                    void **pixels, int *pitch)
+{
+    SDL_WindowData *wind = window->driverdata;
+    SDL_WaylandFramebuffer *fb;
+    int w, h;
+
+    SDL_GetWindowSizeInPixels(window, &w, &h);
+
+    /* Free the old framebuffer */
+    Wayland_DestroyWindowFramebuffer(_this, window);
+
+    if (!wind->waylandData->shm) {
+        return SDL_SetError("Compositor doesn't support wl_shm");
+    }
+    if ((Sint64)w * 4 * h > SDL_MAX_SINT32) {
+        return SDL_SetError("Window is too large for a framebuffer");
+    }
+
+    fb = (SDL_WaylandFramebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return SDL_OutOfMemory();
+    }
+    fb->wind = wind;
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = w * 4;
+    fb->pixels = SDL_calloc(1, SDL_max((size_t)h * fb->pitch, 1));
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return SDL_OutOfMemory();
+    }
+    wind->framebuffer = fb;
+
+    *format = SDL_PIXELFORMAT_XRGB8888;
+    *pixels = fb->pixels;
+    *pitch = fb->pitch;
+    return 0;
+}
+
+int Wayland_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects,
+                                    int numrects)
+{
+    SDL_WindowData *wind = window->driverdata;
+    SDL_WaylandFramebuffer *fb = wind->framebuffer;
+    SDL_Rect bounds, rect, changed;
+    SDL_bool coalesce;
+    int i;
+
+    if (!fb) {
+        return SDL_SetError("Window doesn't have a framebuffer");
+    }
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = fb->width;
+    bounds.h = fb->height;
+    SDL_zero(changed);
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            SDL_GetRectUnion(&changed, &rect, &changed);
+        }
+    }
+    if (SDL_RectEmpty(&changed)) {
+        return 0;
+    }
+
+    for (i = 0; i < fb->num_buffers; ++i) {
+        SDL_GetRectUnion(&fb->buffers[i].damage, &changed, &fb->buffers[i].damage);
+    }
+
+    /* If an earlier update hasn't been sent yet, both go out as one rect */
+    coalesce = !SDL_RectEmpty(&fb->unsent);
+    SDL_GetRectUnion(&fb->unsent, &changed, &fb->unsent);
+    return Wayland_PresentFramebuffer(fb, coalesce ? NULL : rects, numrects);
+}
+
+void Wayland_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
+{
+    SDL_WindowData *wind = window->driverdata;
+    SDL_WaylandFramebuffer *fb;
+    int i;
+
+    if (!wind || !wind->framebuffer) {
+        /* The window wasn't fully initialized */
+        return;
+    }
+    fb = wind->framebuffer;
+
+    /* The compositor keeps showing a buffer that's destroyed while attached */
+    for (i = 0; i < fb->num_buffers; ++i) {
+        wl_buffer_destroy(fb->buffers[i].buffer);
+        munmap(fb->buffers[i].pixels, fb->buffers[i].size);
+    }
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+    wind->framebuffer = NULL;
+}
+
+#endif /* SDL_VIDEO_DRIVER_WAYLAND */
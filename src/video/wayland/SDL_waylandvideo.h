@@ -25,6 +25,7 @@
 #define SDL_waylandvideo_h_
 
 #include <EGL/egl.h>
+#include <sys/types.h>
 #include "wayland-util.h"
 
 #include "../SDL_sysvideo.h"
@@ -111,4 +112,7 @@ extern SDL_bool Wayland_LoadLibdecor(SDL_VideoData *data, SDL_bool ignore_xdg);
 
 extern SDL_bool Wayland_VideoReconnect(SDL_VideoDevice *_this);
 
+/* Creates a file for a wl_shm_pool of the given size, returns the descriptor or -1 */
+extern int Wayland_CreateShmFile(off_t size);
+
 #endif /* SDL_waylandvideo_h_ */
@@ -557,13 +557,17 @@ static void surface_frame_done(void *data, struct wl_callback *cb, uint32_t time
     /*
      * wl_surface.damage_buffer is the preferred method of setting the damage region
      * on compositor version 4 and above.
+     *
+     * The framebuffer damages only what changed along with its own commits.
      */
-    if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
-        wl_surface_damage_buffer(wind->surface, 0, 0,
-                                 wind->drawable_width, wind->drawable_height);
-    } else {
-        wl_surface_damage(wind->surface, 0, 0,
-                          wind->wl_window_width, wind->wl_window_height);
+    if (!wind->framebuffer) {
+        if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+            wl_surface_damage_buffer(wind->surface, 0, 0,
+                                     wind->drawable_width, wind->drawable_height);
+        } else {
+            wl_surface_damage(wind->surface, 0, 0,
+                              wind->wl_window_width, wind->wl_window_height);
+        }
     }
 
     if (wind->surface_status == WAYLAND_SURFACE_STATUS_WAITING_FOR_FRAME) {
@@ -30,6 +30,7 @@
 #include "SDL_waylandvideo.h"
 
 struct SDL_WaylandInput;
+struct SDL_WaylandFramebuffer;
 
 struct SDL_WindowData
 {
@@ -82,6 +83,7 @@ struct SDL_WindowData
     } surface_status;
 
     struct wl_egl_window *egl_window;
+    struct SDL_WaylandFramebuffer *framebuffer;
     struct SDL_WaylandInput *keyboard_device;
 #ifdef SDL_VIDEO_OPENGL_EGL
     EGLSurface egl_surface;
@@ -284,6 +284,98 @@ static void WIN_CheckRawMouseButtons(ULONG rawButtons, SDL_WindowData *data, SDL
     }
 }
 
+void WIN_HandleRawMouseInput(Uint64 timestamp, SDL_WindowData *data, RAWMOUSE *rawmouse)
+{
+    SDL_MouseID mouseID;
+
+    /* Ignore the synthetic mouse input generated for touchscreens */
+    if (SDL_GetNumTouchDevices() > 0 && (rawmouse->ulExtraInformation & 0x82) == 0x82) {
+        return;
+    }
+
+    /* We do all of our mouse state checking against mouse ID 0
+     * We would only use the actual hDevice if we were tracking
+     * all mouse motion independently, and never using mouse ID 0.
+     */
+    mouseID = 0;
+
+    if ((rawmouse->usFlags & 0x01) == MOUSE_MOVE_RELATIVE) {
+        SDL_SendMouseMotion(timestamp, data->window, mouseID, 1, (float)rawmouse->lLastX, (float)rawmouse->lLastY);
+    } else if (rawmouse->lLastX || rawmouse->lLastY) {
+        /* This is absolute motion, either using a tablet or mouse over RDP
+
+           Notes on how RDP appears to work, as of Windows 10 2004:
+            - SetCursorPos() calls are cached, with multiple calls coalesced into a single call that's sent to the RDP client. If the last call to SetCursorPos() has the same value as the last one that was sent to the client, it appears to be ignored and not sent. This means that we need to jitter the SetCursorPos() position slightly in order for the recentering to work correctly.
+            - User mouse motion is coalesced with SetCursorPos(), so the WM_INPUT positions we see will not necessarily match the position we requested with SetCursorPos().
+            - SetCursorPos() outside of the bounds of the focus window appears not to do anything.
+            - SetCursorPos() while the cursor is NULL doesn't do anything
+
+           We handle this by creating a safe area within the application window, and when the mouse leaves that safe area, we warp back to the opposite side. Any single motion > 50% of the safe area is assumed to be a warp and ignored.
+        */
+        SDL_bool remote_desktop = GetSystemMetrics(SM_REMOTESESSION) ? SDL_TRUE : SDL_FALSE;
+        SDL_bool virtual_desktop = (rawmouse->usFlags & MOUSE_VIRTUAL_DESKTOP) ? SDL_TRUE : SDL_FALSE;
+        SDL_bool normalized_coordinates = !(rawmouse->usFlags & 0x40) ? SDL_TRUE : SDL_FALSE;
+        int w = GetSystemMetrics(virtual_desktop ? SM_CXVIRTUALSCREEN : SM_CXSCREEN);
+        int h = GetSystemMetrics(virtual_desktop ? SM_CYVIRTUALSCREEN : SM_CYSCREEN);
+        int x = normalized_coordinates ? (int)(((float)rawmouse->lLastX / 65535.0f) * w) : (int)rawmouse->lLastX;
+        int y = normalized_coordinates ? (int)(((float)rawmouse->lLastY / 65535.0f) * h) : (int)rawmouse->lLastY;
+        int relX, relY;
+
+        /* Calculate relative motion */
+        if (data->last_raw_mouse_position.x == 0 && data->last_raw_mouse_position.y == 0) {
+            data->last_raw_mouse_position.x = x;
+            data->last_raw_mouse_position.y = y;
+        }
+        relX = x - data->last_raw_mouse_position.x;
+        relY = y - data->last_raw_mouse_position.y;
+
+        if (remote_desktop) {
+            if (!data->in_title_click && !data->focus_click_pending) {
+                static int wobble;
+                float floatX = (float)x / w;
+                float floatY = (float)y / h;
+
+                /* See if the mouse is at the edge of the screen, or in the RDP title bar area */
+                if (floatX <= 0.01f || floatX >= 0.99f || floatY <= 0.01f || floatY >= 0.99f || y < 32) {
+                    /* Wobble the cursor position so it's not ignored if the last warp didn't have any effect */
+                    RECT rect = data->cursor_clipped_rect;
+                    int warpX = rect.left + ((rect.right - rect.left) / 2) + wobble;
+                    int warpY = rect.top + ((rect.bottom - rect.top) / 2);
+
+                    WIN_SetCursorPos(warpX, warpY);
+
+                    ++wobble;
+                    if (wobble > 1) {
+                        wobble = -1;
+                    }
+                } else {
+                    /* Send relative motion if we didn't warp last frame (had good position data)
+                       We also sometimes get large deltas due to coalesced mouse motion and warping,
+                       so ignore those.
+                     */
+                    const int MAX_RELATIVE_MOTION = (h / 6);
+                    if (SDL_abs(relX) < MAX_RELATIVE_MOTION &&
+                        SDL_abs(relY) < MAX_RELATIVE_MOTION) {
+                        SDL_SendMouseMotion(timestamp, data->window, mouseID, 1, (float)relX, (float)relY);
+                    }
+                }
+            }
+        } else {
+            const int MAXIMUM_TABLET_RELATIVE_MOTION = 32;
+            if (SDL_abs(relX) > MAXIMUM_TABLET_RELATIVE_MOTION ||
+                SDL_abs(relY) > MAXIMUM_TABLET_RELATIVE_MOTION) {
+                /* Ignore this motion, probably a pen lift and drop */
+            } else {
+                SDL_SendMouseMotion(timestamp, data->window, mouseID, 1, (float)relX, (float)relY);
+            }
+        }
+
+        data->last_raw_mouse_position.x = x;
+        data->last_raw_mouse_position.y = y;
+    }
+    WIN_CheckRawMouseButtons(rawmouse->usButtonFlags, data, mouseID);
+}
+
 static void WIN_CheckAsyncMouseRelease(SDL_WindowData *data)
 {
     Uint32 mouseFlags;
@@ -705,94 +797,10 @@ WIN_WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
         /* Mouse data (ignoring synthetic mouse events generated for touchscreens) */
         if (inp.header.dwType == RIM_TYPEMOUSE) {
-            SDL_MouseID mouseID;
-            RAWMOUSE *rawmouse;
-            if (SDL_GetNumTouchDevices() > 0 &&
-                (GetMouseMessageSource() == SDL_MOUSE_EVENT_SOURCE_TOUCH || (GetMessageExtraInfo() & 0x82) == 0x82)) {
+            if (SDL_GetNumTouchDevices() > 0 && GetMouseMessageSource() == SDL_MOUSE_EVENT_SOURCE_TOUCH) {
                 break;
             }
-            /* We do all of our mouse state checking against mouse ID 0
-             * We would only use the actual hDevice if we were tracking
-             * all mouse motion independently, and never using mouse ID 0.
-             */
-            mouseID = 0; /* (SDL_MouseID)(uintptr_t)inp.header.hDevice; */
-            rawmouse = &inp.data.mouse;
-
-            if ((rawmouse->usFlags & 0x01) == MOUSE_MOVE_RELATIVE) {
-                SDL_SendMouseMotion(WIN_GetEventTimestamp(), data->window, mouseID, 1, (float)rawmouse->lLastX, (float)rawmouse->lLastY);
-            } else if (rawmouse->lLastX || rawmouse->lLastY) {
-                /* This is absolute motion, either using a tablet or mouse over RDP
-
-                   Notes on how RDP appears to work, as of Windows 10 2004:
-                    - SetCursorPos() calls are cached, with multiple calls coalesced into a single call that's sent to the RDP client. If the last call to SetCursorPos() has the same value as the last one that was sent to the client, it appears to be ignored and not sent. This means that we need to jitter the SetCursorPos() position slightly in order for the recentering to work correctly.
-                    - User mouse motion is coalesced with SetCursorPos(), so the WM_INPUT positions we see will not necessarily match the position we requested with SetCursorPos().
-                    - SetCursorPos() outside of the bounds of the focus window appears not to do anything.
-                    - SetCursorPos() while the cursor is NULL doesn't do anything
-
-                   We handle this by creating a safe area within the application window, and when the mouse leaves that safe area, we warp back to the opposite side. Any single motion > 50% of the safe area is assumed to be a warp and ignored.
-                */
-                SDL_bool remote_desktop = GetSystemMetrics(SM_REMOTESESSION) ? SDL_TRUE : SDL_FALSE;
-                SDL_bool virtual_desktop = (rawmouse->usFlags & MOUSE_VIRTUAL_DESKTOP) ? SDL_TRUE : SDL_FALSE;
-                SDL_bool normalized_coordinates = !(rawmouse->usFlags & 0x40) ? SDL_TRUE : SDL_FALSE;
-                int w = GetSystemMetrics(virtual_desktop ? SM_CXVIRTUALSCREEN : SM_CXSCREEN);
-                int h = GetSystemMetrics(virtual_desktop ? SM_CYVIRTUALSCREEN : SM_CYSCREEN);
-                int x = normalized_coordinates ? (int)(((float)rawmouse->lLastX / 65535.0f) * w) : (int)rawmouse->lLastX;
-                int y = normalized_coordinates ? (int)(((float)rawmouse->lLastY / 65535.0f) * h) : (int)rawmouse->lLastY;
-                int relX, relY;
-
-                /* Calculate relative motion */
-                if (data->last_raw_mouse_position.x == 0 && data->last_raw_mouse_position.y == 0) {
-                    data->last_raw_mouse_position.x = x;
-                    data->last_raw_mouse_position.y = y;
-                }
-                relX = x - data->last_raw_mouse_position.x;
-                relY = y - data->last_raw_mouse_position.y;
-
-                if (remote_desktop) {
-                    if (!data->in_title_click && !data->focus_click_pending) {
-                        static int wobble;
-                        float floatX = (float)x / w;
-                        float floatY = (float)y / h;
-
-                        /* See if the mouse is at the edge of the screen, or in the RDP title bar area */
-                        if (floatX <= 0.01f || floatX >= 0.99f || floatY <= 0.01f || floatY >= 0.99f || y < 32) {
-                            /* Wobble the cursor position so it's not ignored if the last warp didn't have any effect */
-                            RECT rect = data->cursor_clipped_rect;
-                            int warpX = rect.left + ((rect.right - rect.left) / 2) + wobble;
-                            int warpY = rect.top + ((rect.bottom - rect.top) / 2);
-
-                            WIN_SetCursorPos(warpX, warpY);
-
-                            ++wobble;
-                            if (wobble > 1) {
-                                wobble = -1;
-                            }
-                        } else {
-                            /* Send relative motion if we didn't warp last frame (had good position data)
-                               We also sometimes get large deltas due to coalesced mouse motion and warping,
-                               so ignore those.
-                             */
-                            const int MAX_RELATIVE_MOTION = (h / 6);
-                            if (SDL_abs(relX) < MAX_RELATIVE_MOTION &&
-                                SDL_abs(relY) < MAX_RELATIVE_MOTION) {
-                                SDL_SendMouseMotion(WIN_GetEventTimestamp(), data->window, mouseID, 1, (float)relX, (float)relY);
-                            }
-                        }
-                    }
-                } else {
-                    const int MAXIMUM_TABLET_RELATIVE_MOTION = 32;
-                    if (SDL_abs(relX) > MAXIMUM_TABLET_RELATIVE_MOTION ||
-                        SDL_abs(relY) > MAXIMUM_TABLET_RELATIVE_MOTION) {
-                        /* Ignore this motion, probably a pen lift and drop */
-                    } else {
-                        SDL_SendMouseMotion(WIN_GetEventTimestamp(), data->window, mouseID, 1, (float)relX, (float)relY);
-                    }
-                }
-
-                data->last_raw_mouse_position.x = x;
-                data->last_raw_mouse_position.y = y;
-            }
-            WIN_CheckRawMouseButtons(rawmouse->usButtonFlags, data, mouseID);
+            WIN_HandleRawMouseInput(WIN_GetEventTimestamp(), data, &inp.data.mouse);
         }
     } break;
 
@@ -23,6 +23,7 @@
 #if defined(SDL_VIDEO_DRIVER_WINDOWS) && !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
 
 #include "SDL_windowsvideo.h"
+#include "SDL_windowsrawinput.h"
 
 #include "../../events/SDL_mouse_c.h"
 
@@ -34,8 +35,6 @@ static int rawInputEnableCount = 0;
 
 static int ToggleRawInput(SDL_bool enabled)
 {
-    RAWINPUTDEVICE rawMouse = { 0x01, 0x02, 0, NULL }; /* Mouse: UsagePage = 1, Usage = 2 */
-
     if (enabled) {
         rawInputEnableCount++;
         if (rawInputEnableCount > 1) {
@@ -51,21 +50,12 @@ static int ToggleRawInput(SDL_bool enabled)
         }
     }
 
-    if (!enabled) {
-        rawMouse.dwFlags |= RIDEV_REMOVE;
-    }
-
-    /* (Un)register raw input for mice */
-    if (RegisterRawInputDevices(&rawMouse, 1, sizeof(RAWINPUTDEVICE)) == FALSE) {
+    /* (Un)register raw input for mice, which is read on its own thread */
+    if (WIN_SetRawMouseEnabled(SDL_GetVideoDevice(), enabled) < 0) {
         /* Reset the enable count, otherwise subsequent enable calls will
            believe raw input is enabled */
         rawInputEnableCount = 0;
-
-        /* Only return an error when registering. If we unregister and fail,
-           then it's probably that we unregistered twice. That's OK. */
-        if (enabled) {
-            return SDL_Unsupported();
-        }
+        return -1;
     }
     return 0;
 }
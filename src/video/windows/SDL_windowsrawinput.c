@@ -0,0 +1,201 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#if defined(SDL_VIDEO_DRIVER_WINDOWS) && !defined(__XBOXONE__) && !defined(__XBOXSERIES__)
+
+#include "SDL_windowsvideo.h"
+#include "SDL_windowsrawinput.h"
+#include "../../events/SDL_mouse_c.h"
+#include "../../thread/SDL_systhread.h"
+
+/* Raw mouse input is read on its own thread, in batches with GetRawInputBuffer(),
+   so a high rate mouse doesn't flood the message queue of the application's windows. */
+
+typedef struct
+{
+    SDL_Thread *thread;
+    HANDLE ready_event;
+    HANDLE done_event;
+    SDL_bool registered;
+    BYTE *buffer;
+    UINT buffer_size;
+    UINT header_offset; /* Offset of the device data in each RAWINPUT block */
+} RawInputThreadData;
+
+static RawInputThreadData thread_data;
+
+static void WIN_PollRawInput(SDL_VideoDevice *_this)
+{
+    SDL_Mouse *mouse = SDL_GetMouse();
+    SDL_Window *window;
+    RAWINPUT *input;
+    UINT size, remaining, count, i, total = 0;
+    Uint64 timestamp;
+
+    /* Read everything that's pending, growing the buffer if a block doesn't fit */
+    for (;;) {
+        input = (RAWINPUT *)thread_data.buffer;
+        for (i = 0; i < total; ++i) {
+            input = NEXTRAWINPUTBLOCK(input);
+        }
+        remaining = thread_data.buffer_size - (UINT)((BYTE *)input - thread_data.buffer);
+        size = remaining;
+        count = GetRawInputBuffer(thread_data.buffer ? input : NULL, &size, sizeof(RAWINPUTHEADER));
+        if (count == (UINT)-1 && GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+            break;
+        }
+        if (count == 0 && remaining >= sizeof(RAWINPUT)) {
+            break; /* Nothing more is pending */
+        }
+        if (count == 0 || count == (UINT)-1) {
+            const UINT BUFFER_SIZE_INCREMENT = 64 * sizeof(RAWINPUT);
+            BYTE *buffer = (BYTE *)SDL_realloc(thread_data.buffer, thread_data.buffer_size + BUFFER_SIZE_INCREMENT);
+            if (!buffer) {
+                break;
+            }
+            thread_data.buffer = buffer;
+            thread_data.buffer_size += BUFFER_SIZE_INCREMENT;
+            continue;
+        }
+        total += count;
+    }
+
+    /* We only use raw mouse input in relative mode, and the motion goes to the window with keyboard focus */
+    window = SDL_GetKeyboardFocus();
+    if (total == 0 || !window || !mouse->relative_mode || mouse->relative_mode_warp) {
+        return;
+    }
+
+    timestamp = SDL_GetTicksNS();
+    input = (RAWINPUT *)thread_data.buffer;
+    for (i = 0; i < total; ++i, input = NEXTRAWINPUTBLOCK(input)) {
+        if (input->header.dwType == RIM_TYPEMOUSE) {
+            RAWMOUSE *rawmouse = (RAWMOUSE *)((BYTE *)input + thread_data.header_offset);
+            WIN_HandleRawMouseInput(timestamp, window->driverdata, rawmouse);
+        }
+    }
+}
+
+static int SDLCALL WIN_RawInputThread(void *param)
+{
+    SDL_VideoDevice *_this = (SDL_VideoDevice *)param;
+    RAWINPUTDEVICE rawMouse = { 0x01, 0x02, 0, NULL }; /* Mouse: UsagePage = 1, Usage = 2 */
+    HWND window;
+
+    window = CreateWindowEx(0, TEXT("Message"), NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, NULL, NULL);
+    if (!window) {
+        SetEvent(thread_data.ready_event);
+        return 0;
+    }
+
+    rawMouse.hwndTarget = window;
+    if (!RegisterRawInputDevices(&rawMouse, 1, sizeof(RAWINPUTDEVICE))) {
+        DestroyWindow(window);
+        SetEvent(thread_data.ready_event);
+        return 0;
+    }
+    thread_data.registered = SDL_TRUE;
+
+    /* Make sure we get the input as soon as it arrives */
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    SetEvent(thread_data.ready_event);
+
+    for (;;) {
+        if (MsgWaitForMultipleObjects(1, &thread_data.done_event, FALSE, INFINITE, QS_RAWINPUT) != WAIT_OBJECT_0 + 1) {
+            break;
+        }
+
+        /* Clear the queue status so MsgWaitForMultipleObjects() waits for new input */
+        (void)GetQueueStatus(QS_RAWINPUT);
+
+        WIN_PollRawInput(_this);
+    }
+
+    rawMouse.dwFlags = RIDEV_REMOVE;
+    rawMouse.hwndTarget = NULL;
+    RegisterRawInputDevices(&rawMouse, 1, sizeof(RAWINPUTDEVICE));
+    DestroyWindow(window);
+    return 0;
+}
+
+static void WIN_CleanupRawInputThread(void)
+{
+    if (thread_data.thread) {
+        SetEvent(thread_data.done_event);
+        SDL_WaitThread(thread_data.thread, NULL);
+    }
+    if (thread_data.ready_event) {
+        CloseHandle(thread_data.ready_event);
+    }
+    if (thread_data.done_event) {
+        CloseHandle(thread_data.done_event);
+    }
+    SDL_free(thread_data.buffer);
+    SDL_zero(thread_data);
+}
+
+int WIN_SetRawMouseEnabled(SDL_VideoDevice *_this, SDL_bool enabled)
+{
+    if (!enabled) {
+        WIN_CleanupRawInputThread();
+        return 0;
+    }
+
+    if (thread_data.thread) {
+        return 0; /* already done. */
+    }
+
+    thread_data.header_offset = sizeof(RAWINPUTHEADER);
+#if !defined(_WIN64) && !defined(__GDK__)
+    {
+        BOOL isWow64 = FALSE;
+        if (IsWow64Process(GetCurrentProcess(), &isWow64) && isWow64) {
+            /* The buffered blocks use the 64-bit layout of the header */
+            thread_data.header_offset += 8;
+        }
+    }
+#endif
+
+    thread_data.ready_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+    thread_data.done_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!thread_data.ready_event || !thread_data.done_event) {
+        WIN_CleanupRawInputThread();
+        return WIN_SetError("CreateEvent");
+    }
+
+    thread_data.thread = SDL_CreateThreadInternal(WIN_RawInputThread, "SDLRawInput", 64 * 1024, _this);
+    if (!thread_data.thread) {
+        WIN_CleanupRawInputThread();
+        return -1;
+    }
+
+    /* Wait for the thread to register for raw input */
+    WaitForSingleObject(thread_data.ready_event, INFINITE);
+    if (!thread_data.registered) {
+        WIN_CleanupRawInputThread();
+        return SDL_SetError("Couldn't register for raw mouse input");
+    }
+    return 0;
+}
+
+#endif /* SDL_VIDEO_DRIVER_WINDOWS */
@@ -27,8 +27,15 @@
 #include "SDL_x11video.h"
 #include "SDL_x11clipboard.h"
 #include "../SDL_clipboard_c.h"
+#include "../../core/unix/SDL_poll.h"
 #include "../../events/SDL_events_c.h"
 
+/* How long to wait for the selection owner to answer or send the next chunk */
+#define SELECTION_TIMEOUT_NS    SDL_MS_TO_NS(1000)
+
+/* How long a requestor may take to ask for the next chunk of an INCR transfer */
+#define INCR_TRANSFER_TIMEOUT_NS SDL_MS_TO_NS(5000)
+
 static const char *text_mime_types[] = {
     "text/plain;charset=utf-8",
     "text/plain",
@@ -50,9 +57,13 @@ static Window GetWindow(SDL_VideoDevice *_this)
         Display *dpy = data->display;
         Window parent = RootWindow(dpy, DefaultScreen(dpy));
         XSetWindowAttributes xattr;
+
+        /* Property changes drive incremental (INCR) selection transfers */
+        SDL_zero(xattr);
+        xattr.event_mask = PropertyChangeMask;
         data->clipboard_window = X11_XCreateWindow(dpy, parent, -10, -10, 1, 1, 0,
                                                    CopyFromParent, InputOnly,
-                                                   CopyFromParent, 0, &xattr);
+                                                   CopyFromParent, CWEventMask, &xattr);
         X11_XFlush(data->display);
     }
 
@@ -111,26 +122,147 @@ static void *CloneDataBuffer(const void *buffer, size_t *len)
     return clone;
 }
 
+typedef struct
+{
+    Window window;
+    Atom property;
+} SelectionEventFilter;
+
+static Bool IsSelectionNotify(Display *display, XEvent *event, XPointer arg)
+{
+    const SelectionEventFilter *filter = (const SelectionEventFilter *)arg;
+
+    return event->xany.window == filter->window && event->type == SelectionNotify;
+}
+
+static Bool IsSelectionPropertyNewValue(Display *display, XEvent *event, XPointer arg)
+{
+    const SelectionEventFilter *filter = (const SelectionEventFilter *)arg;
+
+    return event->xany.window == filter->window && event->type == PropertyNotify &&
+           event->xproperty.atom == filter->property && event->xproperty.state == PropertyNewValue;
+}
+
+/* Wait for a single event on the clipboard window, leaving all other events queued */
+static SDL_bool WaitForSelectionEvent(Display *display, Bool (*predicate)(Display *, XEvent *, XPointer),
+                                      SelectionEventFilter *filter, XEvent *event)
+{
+    const Uint64 timeout = SDL_GetTicksNS() + SELECTION_TIMEOUT_NS;
+
+    X11_XFlush(display);
+    while (!X11_XCheckIfEvent(display, event, predicate, (XPointer)filter)) {
+        const Uint64 now = SDL_GetTicksNS();
+        if (now >= timeout ||
+            SDL_IOReady(ConnectionNumber(display), SDL_IOR_READ, (Sint64)(timeout - now)) <= 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool AppendSelectionData(Uint8 **data, size_t *length, size_t *allocated, const void *chunk, size_t chunk_length)
+{
+    if (*length + chunk_length + sizeof(Uint32) > *allocated) {
+        size_t new_allocated = SDL_max(*allocated * 2, *length + chunk_length + sizeof(Uint32));
+        Uint8 *new_data = (Uint8 *)SDL_realloc(*data, new_allocated);
+        if (!new_data) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        *data = new_data;
+        *allocated = new_allocated;
+    }
+    SDL_memcpy(*data + *length, chunk, chunk_length);
+    *length += chunk_length;
+    SDL_memset(*data + *length, 0, sizeof(Uint32));
+    return SDL_TRUE;
+}
+
+static size_t GetPropertyLength(int format, unsigned long count)
+{
+    /* Xlib returns 32-bit properties as arrays of long */
+    switch (format) {
+    case 16:
+        return count * sizeof(short);
+    case 32:
+        return count * sizeof(long);
+    default:
+        return count;
+    }
+}
+
+/* Read the selection the owner converted onto our window, following the INCR protocol if the data comes in chunks */
+static void *ReadSelectionProperty(Display *display, Window window, Atom property, Atom type, size_t *length)
+{
+    Atom XA_INCR = X11_XInternAtom(display, "INCR", False);
+    SelectionEventFilter filter;
+    XEvent event;
+    Atom seln_type;
+    int seln_format;
+    unsigned long count;
+    unsigned long overflow;
+    unsigned char *src = NULL;
+    Uint8 *data = NULL;
+    size_t allocated = 0;
+
+    *length = 0;
+
+    if (X11_XGetWindowProperty(display, window, property, 0, INT_MAX / 4, True,
+                               AnyPropertyType, &seln_type, &seln_format, &count, &overflow, &src) != Success) {
+        return NULL;
+    }
+    if (seln_type != XA_INCR) {
+        if (seln_type == type) {
+            AppendSelectionData(&data, length, &allocated, src, GetPropertyLength(seln_format, count));
+        }
+        X11_XFree(src);
+        return data;
+    }
+    X11_XFree(src);
+
+    /* Deleting the INCR property told the owner to start sending chunks.
+       Each chunk replaces the property, and an empty one ends the transfer. */
+    filter.window = window;
+    filter.property = property;
+    for (;;) {
+        if (!WaitForSelectionEvent(display, IsSelectionPropertyNewValue, &filter, &event)) {
+            SDL_SetError("Selection timeout");
+            break;
+        }
+        if (X11_XGetWindowProperty(display, window, property, 0, INT_MAX / 4, True,
+                                   AnyPropertyType, &seln_type, &seln_format, &count, &overflow, &src) != Success) {
+            break;
+        }
+        if (count == 0) {
+            X11_XFree(src);
+            return data;
+        }
+        if (seln_type != type ||
+            !AppendSelectionData(&data, length, &allocated, src, GetPropertyLength(seln_format, count))) {
+            X11_XFree(src);
+            break;
+        }
+        X11_XFree(src);
+    }
+
+    SDL_free(data);
+    *length = 0;
+    return NULL;
+}
+
 static void *GetSelectionData(SDL_VideoDevice *_this, Atom selection_type,
-                              const char *mime_type, size_t *length)
+                              const char *mime_type, Atom type, size_t *length)
 {
     SDL_VideoData *videodata = _this->driverdata;
     Display *display = videodata->display;
     Window window;
     Window owner;
     Atom selection;
-    Atom seln_type;
-    int seln_format;
-    unsigned long count;
-    unsigned long overflow;
-    Uint64 waitStart;
-    Uint64 waitElapsed;
+    SelectionEventFilter filter;
+    XEvent event;
 
     SDLX11_ClipboardData *clipboard;
     void *data = NULL;
-    unsigned char *src = NULL;
-    Atom XA_MIME = X11_XInternAtom(display, mime_type, False);
-    Atom XA_INCR = X11_XInternAtom(display, "INCR", False);
 
     *length = 0;
 
@@ -141,7 +273,6 @@ static void *GetSelectionData(SDL_VideoDevice *_this, Atom selection_type,
         /* This requires a fallback to ancient X10 cut-buffers. We will just skip those for now */
         data = NULL;
     } else if (owner == window) {
-        owner = DefaultRootWindow(display);
         if (selection_type == XA_PRIMARY) {
             clipboard = &videodata->primary_selection;
         } else {
@@ -154,45 +285,128 @@ static void *GetSelectionData(SDL_VideoDevice *_this, Atom selection_type,
         }
     } else {
         /* Request that the selection owner copy the data to our window */
-        owner = window;
         selection = X11_XInternAtom(display, "SDL_SELECTION", False);
-        X11_XConvertSelection(display, selection_type, XA_MIME, selection, owner,
+        filter.window = window;
+        filter.property = selection;
+
+        /* Drop any notifications left over from an earlier transfer */
+        while (X11_XCheckIfEvent(display, &event, IsSelectionPropertyNewValue, (XPointer)&filter)) {
+        }
+        X11_XDeleteProperty(display, window, selection);
+        X11_XConvertSelection(display, selection_type, type, selection, window,
                               CurrentTime);
 
         /* When using synergy on Linux and when data has been put in the clipboard
-           on the remote (Windows anyway) machine then selection_waiting may never
-           be set to False. Time out after a while. */
-        waitStart = SDL_GetTicks();
-        videodata->selection_waiting = SDL_TRUE;
-        while (videodata->selection_waiting) {
-            SDL_PumpEvents();
-            waitElapsed = SDL_GetTicks() - waitStart;
-            /* Wait one second for a selection response. */
-            if (waitElapsed > 1000) {
-                videodata->selection_waiting = SDL_FALSE;
-                SDL_SetError("Selection timeout");
-                /* We need to set the selection text so that next time we won't
-                   timeout, otherwise we will hang on every call to this function. */
-                SetSelectionData(_this, selection_type, SDL_ClipboardTextCallback, NULL,
-                                 text_mime_types, SDL_arraysize(text_mime_types), 0);
-                data = NULL;
-                *length = 0;
+           on the remote (Windows anyway) machine then the selection owner may never
+           answer. Time out after a while. */
+        if (!WaitForSelectionEvent(display, IsSelectionNotify, &filter, &event)) {
+            SDL_SetError("Selection timeout");
+            /* We need to set the selection text so that next time we won't
+               timeout, otherwise we will hang on every call to this function. */
+            SetSelectionData(_this, selection_type, SDL_ClipboardTextCallback, NULL,
+                             text_mime_types, SDL_arraysize(text_mime_types), 0);
+        } else if (event.xselection.property != None) {
+            /* Only the events for this transfer have been taken off the queue */
+            while (X11_XCheckIfEvent(display, &event, IsSelectionPropertyNewValue, (XPointer)&filter)) {
             }
+            data = ReadSelectionProperty(display, window, selection, type, length);
         }
+    }
+    return data;
+}
+
+SDL_bool X11_SendSelectionData(SDL_VideoDevice *_this, Window requestor, Atom property, Atom target, const void *data, size_t length)
+{
+    SDL_VideoData *videodata = _this->driverdata;
+    Display *display = videodata->display;
+    /* Leave room for the request header, XMaxRequestSize() is in 4 byte units */
+    const size_t max_chunk = (size_t)X11_XMaxRequestSize(display) * 4 - 64;
+    SDLX11_IncrTransfer *transfer;
+    long incr_length;
+
+    if (length <= max_chunk) {
+        /* This is a safe cast, XChangeProperty() doesn't take a const value, but it doesn't modify the data */
+        X11_XChangeProperty(display, requestor, property, target, 8, PropModeReplace,
+                            (unsigned char *)data, (int)length);
+        return SDL_TRUE;
+    }
+
+    /* The data is too large for one request, so it's sent in chunks as the requestor deletes the property.
+       The data is copied because the application may change the clipboard before the transfer finishes. */
+    transfer = (SDLX11_IncrTransfer *)SDL_calloc(1, sizeof(*transfer));
+    if (!transfer) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+    transfer->data = (Uint8 *)SDL_malloc(length);
+    if (!transfer->data) {
+        SDL_free(transfer);
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+    SDL_memcpy(transfer->data, data, length);
+    transfer->requestor = requestor;
+    transfer->property = property;
+    transfer->target = target;
+    transfer->length = length;
+    transfer->last_activity = SDL_GetTicksNS();
+    transfer->next = videodata->incr_transfers;
+    videodata->incr_transfers = transfer;
+
+    X11_XSelectInput(display, requestor, PropertyChangeMask);
+    incr_length = (long)SDL_min(length, (size_t)SDL_MAX_SINT32);
+    X11_XChangeProperty(display, requestor, property, X11_XInternAtom(display, "INCR", False), 32,
+                        PropModeReplace, (unsigned char *)&incr_length, 1);
+    return SDL_TRUE;
+}
+
+static void FreeIncrTransfer(SDL_VideoData *videodata, SDLX11_IncrTransfer *transfer)
+{
+    SDLX11_IncrTransfer **prev = &videodata->incr_transfers;
+
+    while (*prev != transfer) {
+        prev = &(*prev)->next;
+    }
+    *prev = transfer->next;
 
-        if (X11_XGetWindowProperty(display, owner, selection, 0, INT_MAX / 4, False,
-                                   XA_MIME, &seln_type, &seln_format, &count, &overflow, &src) == Success) {
-            if (seln_type == XA_MIME) {
-                *length = (size_t)count;
-                data = CloneDataBuffer(src, length);
-            } else if (seln_type == XA_INCR) {
-                /* FIXME: Need to implement the X11 INCR protocol */
-                /*SDL_Log("Need to implement the X11 INCR protocol");*/
+    SDL_free(transfer->data);
+    SDL_free(transfer);
+}
+
+SDL_bool X11_HandleIncrTransferEvent(SDL_VideoDevice *_this, const XEvent *xevent)
+{
+    SDL_VideoData *videodata = _this->driverdata;
+    Display *display = videodata->display;
+    const size_t max_chunk = (size_t)X11_XMaxRequestSize(display) * 4 - 64;
+    const Uint64 now = SDL_GetTicksNS();
+    SDLX11_IncrTransfer *transfer, *next;
+    SDL_bool handled = SDL_FALSE;
+
+    for (transfer = videodata->incr_transfers; transfer; transfer = next) {
+        next = transfer->next;
+
+        if (xevent->type == PropertyNotify && xevent->xproperty.state == PropertyDelete &&
+            xevent->xproperty.window == transfer->requestor && xevent->xproperty.atom == transfer->property) {
+            /* The requestor took the last chunk, send the next one. The final chunk is empty. */
+            const size_t chunk = SDL_min(transfer->length - transfer->offset, max_chunk);
+
+            X11_XChangeProperty(display, transfer->requestor, transfer->property, transfer->target, 8,
+                                PropModeReplace, transfer->data + transfer->offset, (int)chunk);
+            if (chunk == 0) {
+                X11_XSelectInput(display, transfer->requestor, NoEventMask);
+                FreeIncrTransfer(videodata, transfer);
+            } else {
+                transfer->offset += chunk;
+                transfer->last_activity = now;
             }
-            X11_XFree(src);
+            X11_XFlush(display);
+            handled = SDL_TRUE;
+        } else if (now - transfer->last_activity > INCR_TRANSFER_TIMEOUT_NS) {
+            /* The requestor went away or gave up */
+            FreeIncrTransfer(videodata, transfer);
         }
     }
-    return data;
+    return handled;
 }
 
 const char **X11_GetTextMimeTypes(SDL_VideoDevice *_this, size_t *num_mime_types)
@@ -220,18 +434,44 @@ void *X11_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t
         *length = 0;
         return NULL;
     }
-    return GetSelectionData(_this, XA_CLIPBOARD, mime_type, length);
+    return GetSelectionData(_this, XA_CLIPBOARD, mime_type, X11_XInternAtom(videodata->display, mime_type, False), length);
 }
 
 SDL_bool X11_HasClipboardData(SDL_VideoDevice *_this, const char *mime_type)
 {
-    size_t length;
-    void *data;
-    data = X11_GetClipboardData(_this, mime_type, &length);
-    if (data) {
-        SDL_free(data);
+    SDL_VideoData *videodata = _this->driverdata;
+    Display *display = videodata->display;
+    Atom XA_CLIPBOARD = X11_XInternAtom(display, "CLIPBOARD", 0);
+    Atom XA_MIME = X11_XInternAtom(display, mime_type, False);
+    SDL_bool result = SDL_FALSE;
+    size_t i, length;
+    Atom *targets;
+
+    if (XA_CLIPBOARD == None) {
+        return SDL_FALSE;
     }
-    return length > 0;
+
+    if (X11_XGetSelectionOwner(display, XA_CLIPBOARD) == GetWindow(_this)) {
+        for (i = 0; i < videodata->clipboard.mime_count; ++i) {
+            if (SDL_strcmp(mime_type, videodata->clipboard.mime_types[i]) == 0) {
+                return SDL_TRUE;
+            }
+        }
+        return SDL_FALSE;
+    }
+
+    /* Ask which formats are available instead of transferring the data itself */
+    targets = (Atom *)GetSelectionData(_this, XA_CLIPBOARD, "TARGETS", XA_ATOM, &length);
+    if (targets) {
+        for (i = 0; i < length / sizeof(*targets); ++i) {
+            if (targets[i] == XA_MIME) {
+                result = SDL_TRUE;
+                break;
+            }
+        }
+        SDL_free(targets);
+    }
+    return result;
 }
 
 int X11_SetPrimarySelectionText(SDL_VideoDevice *_this, const char *text)
@@ -242,7 +482,8 @@ int X11_SetPrimarySelectionText(SDL_VideoDevice *_this, const char *text)
 char *X11_GetPrimarySelectionText(SDL_VideoDevice *_this)
 {
     size_t length;
-    char *text = GetSelectionData(_this, XA_PRIMARY, text_mime_types[0], &length);
+    SDL_VideoData *videodata = _this->driverdata;
+    char *text = GetSelectionData(_this, XA_PRIMARY, text_mime_types[0], X11_XInternAtom(videodata->display, text_mime_types[0], False), &length);
     if (!text) {
         text = SDL_strdup("");
     }
@@ -265,6 +506,10 @@ SDL_bool X11_HasPrimarySelectionText(SDL_VideoDevice *_this)
 void X11_QuitClipboard(SDL_VideoDevice *_this)
 {
     SDL_VideoData *data = _this->driverdata;
+
+    while (data->incr_transfers) {
+        FreeIncrTransfer(data, data->incr_transfers);
+    }
     if (data->primary_selection.sequence == 0) {
         SDL_free(data->primary_selection.userdata);
     }
@@ -33,6 +33,18 @@ typedef struct X11_ClipboardData {
     Uint32 sequence;
 } SDLX11_ClipboardData;
 
+/* Selection data that is too large for one property, sent in chunks with the INCR protocol */
+typedef struct X11_IncrTransfer {
+    Window requestor;
+    Atom property;
+    Atom target;
+    Uint8 *data;
+    size_t length;
+    size_t offset;
+    Uint64 last_activity;
+    struct X11_IncrTransfer *next;
+} SDLX11_IncrTransfer;
+
 extern const char **X11_GetTextMimeTypes(SDL_VideoDevice *_this, size_t *num_mime_types);
 extern int X11_SetClipboardData(SDL_VideoDevice *_this);
 extern void *X11_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t *length);
@@ -40,6 +52,8 @@ extern SDL_bool X11_HasClipboardData(SDL_VideoDevice *_this, const char *mime_ty
 extern int X11_SetPrimarySelectionText(SDL_VideoDevice *_this, const char *text);
 extern char *X11_GetPrimarySelectionText(SDL_VideoDevice *_this);
 extern SDL_bool X11_HasPrimarySelectionText(SDL_VideoDevice *_this);
+extern SDL_bool X11_SendSelectionData(SDL_VideoDevice *_this, Window requestor, Atom property, Atom target, const void *data, size_t length);
+extern SDL_bool X11_HandleIncrTransferEvent(SDL_VideoDevice *_this, const XEvent *xevent);
 extern void X11_QuitClipboard(SDL_VideoDevice *_this);
 
 #endif /* SDL_x11clipboard_h_ */
@@ -50,6 +50,9 @@ typedef struct
 #ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES
 #define SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES NULL
 #endif
+#ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT
+#define SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT NULL
+#endif
 #ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR
 #define SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR NULL
 #endif
@@ -63,18 +66,27 @@ static x11dynlib x11libs[] = {
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XCURSOR },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XINPUT2 },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES },
+    { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XSS }
 };
 
+/* The symbols are listed grouped by the library that provides them, so the
+   search starts in the library where the previous symbol was found. A miss
+   costs two dlsym() calls and an SDL_SetError(), and with several hundred
+   symbols that adds up at startup. */
+static int x11_lastlib = 0;
+
 static void *X11_GetSym(const char *fnname, int *pHasModule)
 {
-    int i;
+    int i, lib = 0;
     void *fn = NULL;
     for (i = 0; i < SDL_TABLESIZE(x11libs); i++) {
-        if (x11libs[i].lib) {
-            fn = SDL_LoadFunction(x11libs[i].lib, fnname);
+        lib = (x11_lastlib + i) % (int)SDL_TABLESIZE(x11libs);
+        if (x11libs[lib].lib) {
+            fn = SDL_LoadFunction(x11libs[lib].lib, fnname);
             if (fn) {
+                x11_lastlib = lib;
                 break;
             }
         }
@@ -82,7 +94,7 @@ static void *X11_GetSym(const char *fnname, int *pHasModule)
 
 #if DEBUG_DYNAMIC_X11
     if (fn)
-        printf("X11: Found '%s' in %s (%p)\n", fnname, x11libs[i].libname, fn);
+        printf("X11: Found '%s' in %s (%p)\n", fnname, x11libs[lib].libname, fn);
     else
         printf("X11: Symbol '%s' NOT FOUND!\n", fnname);
 #endif
@@ -153,6 +165,7 @@ int SDL_X11_LoadSymbols(void)
 #ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC
         int i;
         int *thismod = NULL;
+        x11_lastlib = 0;
         for (i = 0; i < SDL_TABLESIZE(x11libs); i++) {
             if (x11libs[i].libname) {
                 x11libs[i].lib = SDL_LoadObject(x11libs[i].libname);
@@ -29,6 +29,7 @@
 #include <limits.h> /* For INT_MAX */
 
 #include "SDL_x11video.h"
+#include "SDL_x11framebuffer.h"
 #include "SDL_x11touch.h"
 #include "SDL_x11xinput2.h"
 #include "SDL_x11xfixes.h"
@@ -342,6 +343,9 @@ static void X11_HandleGenericEvent(SDL_VideoDevice *_this, XEvent *xev)
     if (X11_XGetEventData(videodata->display, cookie)) {
         if (!g_X11EventHook || g_X11EventHook(g_X11EventHookData, xev)) {
             X11_HandleXinput2Event(_this, cookie);
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+            X11_HandlePresentEvent(_this, cookie);
+#endif
         }
         X11_XFreeEventData(videodata->display, cookie);
     }
@@ -641,7 +645,7 @@ static void X11_HandleClipboardEvent(SDL_VideoDevice *_this, const XEvent *xeven
         const XSelectionRequestEvent *req = &xevent->xselectionrequest;
         XEvent sevent;
         int mime_formats;
-        unsigned char *seln_data;
+        const void *seln_data;
         size_t seln_length = 0;
         Atom XA_TARGETS = X11_XInternAtom(display, "TARGETS", 0);
         SDLX11_ClipboardData *clipboard;
@@ -697,13 +701,9 @@ static void X11_HandleClipboardEvent(SDL_VideoDevice *_this, const XEvent *xeven
                         continue;
                     }
 
-                    /* FIXME: We don't support the X11 INCR protocol for large clipboards. Do we want that? - Yes, yes we do. */
-                    /* This is a safe cast, XChangeProperty() doesn't take a const value, but it doesn't modify the data */
-                    seln_data = (unsigned char *)clipboard->callback(clipboard->userdata, mime_type, &seln_length);
-                    if (seln_data) {
-                        X11_XChangeProperty(display, req->requestor, req->property,
-                                            req->target, 8, PropModeReplace,
-                                            seln_data, seln_length);
+                    seln_data = clipboard->callback(clipboard->userdata, mime_type, &seln_length);
+                    if (seln_data &&
+                        X11_SendSelectionData(_this, req->requestor, req->property, req->target, seln_data, seln_length)) {
                         sevent.xselection.property = req->property;
                         sevent.xselection.target = req->target;
                     }
@@ -721,7 +721,6 @@ static void X11_HandleClipboardEvent(SDL_VideoDevice *_this, const XEvent *xeven
         printf("window CLIPBOARD: SelectionNotify (requestor = %ld, target = %ld)\n",
                xevent->xselection.requestor, xevent->xselection.target);
 #endif
-        videodata->selection_waiting = SDL_FALSE;
     } break;
 
     case SelectionClear:
@@ -818,6 +817,38 @@ SDL_WindowData *X11_FindWindow(SDL_VideoDevice *_this, Window window)
     return NULL;
 }
 
+/* Convert an X server timestamp (milliseconds since server start, 32-bit) to an SDL timestamp */
+Uint64 X11_GetEventTimestamp(unsigned long time)
+{
+    static Uint64 last;
+    static Uint64 timestamp_offset;
+    const Uint64 now = SDL_GetTicksNS();
+    Uint64 timestamp;
+
+    if (!time) {
+        return 0;
+    }
+
+    timestamp = SDL_MS_TO_NS((Uint64)(time & 0xFFFFFFFF));
+    if (timestamp < last) {
+        /* 32-bit timer rollover, bump the offset */
+        timestamp_offset += SDL_MS_TO_NS(0x100000000LLU);
+    }
+    last = timestamp;
+
+    if (!timestamp_offset) {
+        timestamp_offset = (now - timestamp);
+    }
+    timestamp += timestamp_offset;
+
+    if (timestamp > now) {
+        timestamp_offset -= (timestamp - now);
+        timestamp = now;
+    }
+
+    return timestamp;
+}
+
 void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, int button, const float x, const float y, const unsigned long time)
 {
     SDL_Window *window = windowdata->window;
@@ -828,7 +859,7 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, i
     printf("window %p: ButtonPress (X11 button = %d)\n", window, button);
 #endif
     if (X11_IsWheelEvent(display, button, &xticks, &yticks)) {
-        SDL_SendMouseWheel(0, window, 0, (float)-xticks, (float)yticks, SDL_MOUSEWHEEL_NORMAL);
+        SDL_SendMouseWheel(X11_GetEventTimestamp(time), window, 0, (float)-xticks, (float)yticks, SDL_MOUSEWHEEL_NORMAL);
     } else {
         SDL_bool ignore_click = SDL_FALSE;
         if (button == Button1) {
@@ -849,13 +880,13 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, i
             windowdata->last_focus_event_time = 0;
         }
         if (!ignore_click) {
-            SDL_SendMouseButton(0, window, 0, SDL_PRESSED, button);
+            SDL_SendMouseButton(X11_GetEventTimestamp(time), window, 0, SDL_PRESSED, button);
         }
     }
     X11_UpdateUserTime(windowdata, time);
 }
 
-void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata, int button)
+void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata, int button, const unsigned long time)
 {
     SDL_Window *window = windowdata->window;
     const SDL_VideoData *videodata = (SDL_VideoData *)_this->driverdata;
@@ -870,7 +901,7 @@ void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata,
             /* see explanation at case ButtonPress */
             button -= (8 - SDL_BUTTON_X1);
         }
-        SDL_SendMouseButton(0, window, 0, SDL_RELEASED, button);
+        SDL_SendMouseButton(X11_GetEventTimestamp(time), window, 0, SDL_RELEASED, button);
     }
 }
 
@@ -911,6 +942,9 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
     SDL_assert(videodata != NULL);
     display = videodata->display;
 
+    /* Deliver the accumulated relative motion before any event that might depend on it */
+    X11_FlushXinput2Motion(_this, xevent);
+
     /* Save the original keycode for dead keys, which are filtered out by
        the XFilterEvent() call below.
     */
@@ -937,9 +971,9 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
             videodata->filter_time = xevent->xkey.time;
 
             if (orig_event_type == KeyPress) {
-                SDL_SendKeyboardKey(0, SDL_PRESSED, scancode);
+                SDL_SendKeyboardKey(X11_GetEventTimestamp(xevent->xkey.time), SDL_PRESSED, scancode);
             } else {
-                SDL_SendKeyboardKey(0, SDL_RELEASED, scancode);
+                SDL_SendKeyboardKey(X11_GetEventTimestamp(xevent->xkey.time), SDL_RELEASED, scancode);
             }
 #endif
         }
@@ -998,6 +1032,10 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
         return;
     }
 
+    if (videodata->incr_transfers && X11_HandleIncrTransferEvent(_this, xevent)) {
+        return;
+    }
+
     data = X11_FindWindow(_this, xevent->xany.window);
 
     if (!data) {
@@ -1016,11 +1054,15 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 #ifdef DEBUG_XEVENTS
             printf("window %p: MappingNotify!\n", data);
 #endif
-            if ((request == MappingKeyboard) || (request == MappingModifier)) {
+            if (request == MappingKeyboard) {
                 X11_XRefreshKeyboardMapping(&xevent->xmapping);
-            }
 
-            X11_UpdateKeymap(_this, SDL_TRUE);
+                /* Only the keys in the notification changed */
+                X11_UpdateKeymapRange(_this, xevent->xmapping.first_keycode, xevent->xmapping.count, SDL_TRUE);
+            } else if (request == MappingModifier) {
+                /* The modifier map doesn't change which keysyms the keys produce */
+                X11_XRefreshKeyboardMapping(&xevent->xmapping);
+            }
         } else if (xevent->type == PropertyNotify && videodata && videodata->windowlist) {
             char *name_of_atom = X11_XGetAtomName(display, xevent->xproperty.atom);
 
@@ -1086,7 +1128,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 #endif
 
         if (!mouse->relative_mode) {
-            SDL_SendMouseMotion(0, data->window, 0, 0, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xcrossing.time), data->window, 0, 0, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
         }
 
         /* We ungrab in LeaveNotify, so we may need to grab again here */
@@ -1110,7 +1152,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
         }
 #endif
         if (!SDL_GetMouse()->relative_mode) {
-            SDL_SendMouseMotion(0, data->window, 0, 0, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xcrossing.time), data->window, 0, 0, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
         }
 
         if (xevent->xcrossing.mode != NotifyGrab &&
@@ -1242,7 +1284,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
             if (xevent->type == KeyPress) {
                 /* Don't send the key if it looks like a duplicate of a filtered key sent by an IME */
                 if (xevent->xkey.keycode != videodata->filter_code || xevent->xkey.time != videodata->filter_time) {
-                    SDL_SendKeyboardKey(0, SDL_PRESSED, videodata->key_layout[keycode]);
+                    SDL_SendKeyboardKey(X11_GetEventTimestamp(xevent->xkey.time), SDL_PRESSED, videodata->key_layout[keycode]);
                 }
                 if (*text) {
                     SDL_SendKeyboardText(text);
@@ -1252,7 +1294,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
                     /* We're about to get a repeated key down, ignore the key up */
                     break;
                 }
-                SDL_SendKeyboardKey(0, SDL_RELEASED, videodata->key_layout[keycode]);
+                SDL_SendKeyboardKey(X11_GetEventTimestamp(xevent->xkey.time), SDL_RELEASED, videodata->key_layout[keycode]);
             }
         }
 
@@ -1499,7 +1541,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 #endif
 
             X11_ProcessHitTest(_this, data, (float)xevent->xmotion.x, (float)xevent->xmotion.y, SDL_FALSE);
-            SDL_SendMouseMotion(0, data->window, 0, 0, (float)xevent->xmotion.x, (float)xevent->xmotion.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xmotion.time), data->window, 0, 0, (float)xevent->xmotion.x, (float)xevent->xmotion.y);
         }
     } break;
 
@@ -1511,7 +1553,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 
     case ButtonRelease:
     {
-        X11_HandleButtonRelease(_this, data, xevent->xbutton.button);
+        X11_HandleButtonRelease(_this, data, xevent->xbutton.button, xevent->xbutton.time);
     } break;
 #endif /* !SDL_VIDEO_DRIVER_X11_XINPUT2 */
 
@@ -1781,7 +1823,7 @@ int X11_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
         return 0;
     } else {
         /* Use SDL_IOR_NO_RETRY to ensure SIGINT will break us out of our wait */
-        int err = SDL_IOReady(ConnectionNumber(display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+        int err = SDL_IOReadyWakeup(ConnectionNumber(display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
         if (err > 0) {
             if (!X11_PollEvent(display, &xevent)) {
                 /* Someone may have beat us to reading the fd. Return 1 here to
@@ -1805,6 +1847,7 @@ int X11_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
     }
 
     X11_DispatchEvent(_this, &xevent);
+    X11_FlushXinput2Motion(_this, NULL);
 
 #ifdef SDL_USE_IME
     if (SDL_EventEnabled(SDL_EVENT_TEXT_INPUT)) {
@@ -1822,6 +1865,7 @@ void X11_PumpEvents(SDL_VideoDevice *_this)
 {
     SDL_VideoData *data = _this->driverdata;
     XEvent xevent;
+    int num_events;
     int i;
 
     if (data->last_mode_change_deadline) {
@@ -1846,10 +1890,15 @@ void X11_PumpEvents(SDL_VideoDevice *_this)
 
     SDL_zero(xevent);
 
-    /* Keep processing pending events */
-    while (X11_PollEvent(data->display, &xevent)) {
-        X11_DispatchEvent(_this, &xevent);
+    /* Keep processing pending events, reading everything the server has sent
+       at once instead of checking the connection before each event */
+    while ((num_events = X11_XEventsQueued(data->display, QueuedAfterReading)) > 0) {
+        while (num_events-- > 0) {
+            X11_XNextEvent(data->display, &xevent);
+            X11_DispatchEvent(_this, &xevent);
+        }
     }
+    X11_FlushXinput2Motion(_this, NULL);
 
 #ifdef SDL_USE_IME
     if (SDL_EventEnabled(SDL_EVENT_TEXT_INPUT)) {
@@ -23,8 +23,15 @@
 #ifdef SDL_VIDEO_DRIVER_X11
 
 #include "SDL_x11video.h"
+#include "SDL_x11events.h"
 #include "SDL_x11framebuffer.h"
 
+/* Updates are sent as at most this many rects. Rects that are close together
+   are merged, because sending the pixels between them costs less than another
+   request and another copy on the server. */
+#define X11_FRAMEBUFFER_MAX_RECTS   16
+#define X11_FRAMEBUFFER_MERGE_SLACK (64 * 64)
+
 #ifndef NO_SHARED_MEMORY
 
 /* Shared memory error handler routine */
@@ -45,8 +52,337 @@ static SDL_bool have_mitshm(Display *dpy)
     return X11_XShmQueryExtension(dpy) ? SDL_X11_HAVE_SHM : SDL_FALSE;
 }
 
+/* Creates a shared memory segment and attaches the X server to it */
+static SDL_bool X11_CreateShmSegment(Display *display, XShmSegmentInfo *shminfo, size_t size)
+{
+    shminfo->shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0777);
+    if (shminfo->shmid < 0) {
+        return SDL_FALSE;
+    }
+
+    shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
+    shminfo->readOnly = False;
+    if (shminfo->shmaddr == (char *)-1) {
+        shm_error = True;
+    } else {
+        shm_error = False;
+        X_handler = X11_XSetErrorHandler(shm_errhandler);
+        X11_XShmAttach(display, shminfo);
+        X11_XSync(display, False);
+        X11_XSetErrorHandler(X_handler);
+        if (shm_error) {
+            shmdt(shminfo->shmaddr);
+        }
+    }
+    shmctl(shminfo->shmid, IPC_RMID, NULL);
+
+    if (shm_error) {
+        shminfo->shmaddr = NULL;
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
 #endif /* !NO_SHARED_MEMORY */
 
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+
+/* With XPresent, the window surface is memory of our own, and when the
+ * window is updated the parts that changed are copied into a shared memory
+ * pixmap the server isn't using, which is then presented at the next vblank.
+ * The server tells us when it's done with each pixmap, and if both are in use
+ * the update waits for one, which keeps us in step with the display.
+ */
+#define X11_PRESENT_NUM_BUFFERS 2
+
+typedef struct
+{
+    Pixmap pixmap;
+    XShmSegmentInfo shminfo;
+    SDL_Rect damage; /* The area that changed since this pixmap was filled */
+    SDL_bool busy;   /* Presented and not idle yet */
+} X11_PresentBuffer;
+
+typedef struct SDL_X11PresentFramebuffer
+{
+    void *pixels;
+    int width, height, pitch;
+    X11_PresentBuffer buffers[X11_PRESENT_NUM_BUFFERS];
+    XID event_id;
+    uint32_t serial;
+    uint64_t last_msc;   /* The frame counter of the last completed present */
+    uint64_t target_msc; /* The frame counter the last present was queued for */
+} SDL_X11PresentFramebuffer;
+
+static SDL_bool have_xpresent(SDL_VideoData *videodata)
+{
+    Display *display = videodata->display;
+
+    if (!videodata->xpresent_checked) {
+        int opcode, event_base, error_base;
+        int major = 1, minor = 0;
+        Bool shared_pixmaps = False;
+
+        videodata->xpresent_checked = SDL_TRUE;
+        videodata->xpresent_opcode = 0;
+
+        if (SDL_X11_HAVE_XPRESENT && have_mitshm(display) &&
+            X11_XShmQueryVersion(display, &major, &minor, &shared_pixmaps) && shared_pixmaps &&
+            X11_XShmPixmapFormat(display) == ZPixmap &&
+            X11_XPresentQueryExtension(display, &opcode, &event_base, &error_base)) {
+            major = 1;
+            minor = 0;
+            if (X11_XPresentQueryVersion(display, &major, &minor)) {
+                videodata->xpresent_opcode = opcode;
+            }
+        }
+    }
+    return videodata->xpresent_opcode != 0;
+}
+
+static void X11_DestroyPresentFramebuffer(SDL_WindowData *data)
+{
+    SDL_X11PresentFramebuffer *fb = data->present;
+    Display *display = data->videodata->display;
+    int i;
+
+    if (fb->event_id) {
+        X11_XPresentFreeInput(display, data->xwindow, fb->event_id);
+    }
+    for (i = 0; i < X11_PRESENT_NUM_BUFFERS; ++i) {
+        X11_PresentBuffer *buf = &fb->buffers[i];
+
+        if (buf->pixmap) {
+            X11_XFreePixmap(display, buf->pixmap);
+        }
+        if (buf->shminfo.shmaddr) {
+            X11_XShmDetach(display, &buf->shminfo);
+            X11_XSync(display, False);
+            shmdt(buf->shminfo.shmaddr);
+        }
+    }
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+    data->present = NULL;
+}
+
+static int X11_CreatePresentFramebuffer(SDL_WindowData *data, int w, int h, int depth, int pitch)
+{
+    Display *display = data->videodata->display;
+    SDL_X11PresentFramebuffer *fb;
+    int i;
+
+    fb = (SDL_X11PresentFramebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return SDL_OutOfMemory();
+    }
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = pitch;
+    fb->pixels = SDL_calloc(1, SDL_max((size_t)h * pitch, 1));
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return SDL_OutOfMemory();
+    }
+    data->present = fb;
+
+    for (i = 0; i < X11_PRESENT_NUM_BUFFERS; ++i) {
+        X11_PresentBuffer *buf = &fb->buffers[i];
+
+        if (!X11_CreateShmSegment(display, &buf->shminfo, SDL_max((size_t)h * pitch, 1))) {
+            X11_DestroyPresentFramebuffer(data);
+            return SDL_SetError("Couldn't create shared memory pixmap");
+        }
+        buf->pixmap = X11_XShmCreatePixmap(display, data->xwindow, buf->shminfo.shmaddr,
+                                           &buf->shminfo, w, h, depth);
+        if (!buf->pixmap) {
+            X11_DestroyPresentFramebuffer(data);
+            return SDL_SetError("Couldn't create shared memory pixmap");
+        }
+
+        /* All of a new pixmap has to be filled */
+        buf->damage.x = 0;
+        buf->damage.y = 0;
+        buf->damage.w = w;
+        buf->damage.h = h;
+    }
+
+    fb->event_id = X11_XPresentSelectInput(display, data->xwindow,
+                                           PresentCompleteNotifyMask | PresentIdleNotifyMask);
+    return 0;
+}
+
+static Bool X11_IsPresentEvent(Display *display, XEvent *xevent, XPointer arg)
+{
+    const SDL_VideoData *videodata = (const SDL_VideoData *)arg;
+
+    return xevent->type == GenericEvent && xevent->xcookie.extension == videodata->xpresent_opcode;
+}
+
+void X11_HandlePresentEvent(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
+{
+    SDL_VideoData *videodata = _this->driverdata;
+    SDL_WindowData *data;
+    int i;
+
+    if (!videodata->xpresent_opcode || cookie->extension != videodata->xpresent_opcode) {
+        return;
+    }
+
+    switch (cookie->evtype) {
+    case PresentCompleteNotify:
+    {
+        const XPresentCompleteNotifyEvent *ev = (const XPresentCompleteNotifyEvent *)cookie->data;
+
+        data = X11_FindWindow(_this, ev->window);
+        if (data && data->present && ev->kind == PresentCompleteKindPixmap) {
+            data->present->last_msc = ev->msc;
+        }
+    } break;
+
+    case PresentIdleNotify:
+    {
+        const XPresentIdleNotifyEvent *ev = (const XPresentIdleNotifyEvent *)cookie->data;
+
+        data = X11_FindWindow(_this, ev->window);
+        if (data && data->present) {
+            for (i = 0; i < X11_PRESENT_NUM_BUFFERS; ++i) {
+                if (data->present->buffers[i].pixmap == ev->pixmap) {
+                    data->present->buffers[i].busy = SDL_FALSE;
+                }
+            }
+        }
+    } break;
+
+    default:
+        break;
+    }
+}
+
+static int X11_PresentFramebuffer(SDL_VideoDevice *_this, SDL_WindowData *data, const SDL_Rect *rects, int numrects)
+{
+    SDL_VideoData *videodata = data->videodata;
+    SDL_X11PresentFramebuffer *fb = data->present;
+    Display *display = videodata->display;
+    X11_PresentBuffer *buf = NULL;
+    XRectangle xrects[X11_FRAMEBUFFER_MAX_RECTS];
+    XserverRegion region;
+    SDL_Rect changed;
+    int i;
+
+    SDL_zero(changed);
+    for (i = 0; i < numrects; ++i) {
+        SDL_GetRectUnion(&changed, &rects[i], &changed);
+    }
+    if (SDL_RectEmpty(&changed)) {
+        return 0;
+    }
+    for (i = 0; i < X11_PRESENT_NUM_BUFFERS; ++i) {
+        SDL_GetRectUnion(&fb->buffers[i].damage, &changed, &fb->buffers[i].damage);
+    }
+
+    /* Wait for the server to let go of a pixmap, this is where we block
+       when updates come in faster than the display refreshes. */
+    X11_XFlush(display);
+    for (;;) {
+        XEvent xevent;
+
+        for (i = 0; i < X11_PRESENT_NUM_BUFFERS; ++i) {
+            if (!fb->buffers[i].busy) {
+                buf = &fb->buffers[i];
+                break;
+            }
+        }
+        if (buf) {
+            break;
+        }
+
+        X11_XIfEvent(display, &xevent, X11_IsPresentEvent, (XPointer)videodata);
+        if (X11_XGetEventData(display, &xevent.xcookie)) {
+            X11_HandlePresentEvent(_this, &xevent.xcookie);
+            X11_XFreeEventData(display, &xevent.xcookie);
+        }
+    }
+
+    /* Bring the pixmap up to date */
+    if (!SDL_RectEmpty(&buf->damage)) {
+        const int bpp = fb->pitch / fb->width;
+        const size_t offset = (size_t)buf->damage.y * fb->pitch + (size_t)buf->damage.x * bpp;
+        const Uint8 *src = (const Uint8 *)fb->pixels + offset;
+        Uint8 *dst = (Uint8 *)buf->shminfo.shmaddr + offset;
+        int y;
+
+        for (y = 0; y < buf->damage.h; ++y) {
+            SDL_memcpy(dst, src, (size_t)buf->damage.w * bpp);
+            src += fb->pitch;
+            dst += fb->pitch;
+        }
+        SDL_zero(buf->damage);
+    }
+
+    for (i = 0; i < numrects; ++i) {
+        xrects[i].x = (short)rects[i].x;
+        xrects[i].y = (short)rects[i].y;
+        xrects[i].width = (unsigned short)rects[i].w;
+        xrects[i].height = (unsigned short)rects[i].h;
+    }
+    region = X11_XFixesCreateRegion(display, xrects, numrects);
+
+    /* Queue each update for the frame after the last one, so updates that
+       come in quickly are shown one per refresh instead of being skipped. */
+    fb->target_msc = SDL_max(fb->target_msc, fb->last_msc) + 1;
+    X11_XPresentPixmap(display, data->xwindow, buf->pixmap, ++fb->serial,
+                       None, region, 0, 0, None, None, None, PresentOptionNone,
+                       fb->target_msc, 0, 0, NULL, 0);
+    X11_XFixesDestroyRegion(display, region);
+    X11_XFlush(display);
+
+    buf->busy = SDL_TRUE;
+    return 0;
+}
+
+#endif /* SDL_VIDEO_DRIVER_X11_XPRESENT && !NO_SHARED_MEMORY */
+
+/* Clips the rects to the window and merges the ones that are close together.
+   Returns the number of rects written to merged. */
+static int X11_MergeFramebufferRects(const SDL_Rect *rects, int numrects, int window_w, int window_h,
+                                     SDL_Rect merged[X11_FRAMEBUFFER_MAX_RECTS])
+{
+    SDL_Rect bounds, rect, merge;
+    int count = 0;
+    int i, j;
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = window_w;
+    bounds.h = window_h;
+
+    for (i = 0; i < numrects; ++i) {
+        if (!SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            continue;
+        }
+
+        /* Fold it into a rect we already have if that doesn't add much area.
+           Merged rects may overlap, which is harmless. */
+        for (j = 0; j < count; ++j) {
+            SDL_GetRectUnion(&merged[j], &rect, &merge);
+            if ((Sint64)merge.w * merge.h <= (Sint64)merged[j].w * merged[j].h +
+                                                 (Sint64)rect.w * rect.h + X11_FRAMEBUFFER_MERGE_SLACK) {
+                merged[j] = merge;
+                break;
+            }
+        }
+        if (j == count) {
+            if (count < X11_FRAMEBUFFER_MAX_RECTS) {
+                merged[count++] = rect;
+            } else {
+                SDL_GetRectUnion(&merged[count - 1], &rect, &merged[count - 1]);
+            }
+        }
+    }
+    return count;
+}
+
 int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, Uint32 *format,
                                 void **pixels, int *pitch)
 {
@@ -81,47 +417,34 @@ int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, Uint
     /* Calculate pitch */
     *pitch = (((w * SDL_BYTESPERPIXEL(*format)) + 3) & ~3);
 
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+    /* Present from shared memory pixmaps, falling back to XShmPutImage() */
+    if (SDL_BYTESPERPIXEL(*format) * w == *pitch && have_xpresent(data->videodata) &&
+        X11_CreatePresentFramebuffer(data, w, h, vinfo.depth, *pitch) == 0) {
+        *pixels = data->present->pixels;
+        return 0;
+    }
+#endif
+
     /* Create the actual image */
 #ifndef NO_SHARED_MEMORY
-    if (have_mitshm(display)) {
+    if (have_mitshm(display) && X11_CreateShmSegment(display, &data->shminfo, (size_t)h * (*pitch))) {
         XShmSegmentInfo *shminfo = &data->shminfo;
 
-        shminfo->shmid = shmget(IPC_PRIVATE, (size_t)h * (*pitch), IPC_CREAT | 0777);
-        if (shminfo->shmid >= 0) {
-            shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
-            shminfo->readOnly = False;
-            if (shminfo->shmaddr != (char *)-1) {
-                shm_error = False;
-                X_handler = X11_XSetErrorHandler(shm_errhandler);
-                X11_XShmAttach(display, shminfo);
-                X11_XSync(display, False);
-                X11_XSetErrorHandler(X_handler);
-                if (shm_error) {
-                    shmdt(shminfo->shmaddr);
-                }
-            } else {
-                shm_error = True;
-            }
-            shmctl(shminfo->shmid, IPC_RMID, NULL);
+        data->ximage = X11_XShmCreateImage(display, data->visual,
+                                           vinfo.depth, ZPixmap,
+                                           shminfo->shmaddr, shminfo,
+                                           w, h);
+        if (!data->ximage) {
+            X11_XShmDetach(display, shminfo);
+            X11_XSync(display, False);
+            shmdt(shminfo->shmaddr);
         } else {
-            shm_error = True;
-        }
-        if (!shm_error) {
-            data->ximage = X11_XShmCreateImage(display, data->visual,
-                                               vinfo.depth, ZPixmap,
-                                               shminfo->shmaddr, shminfo,
-                                               w, h);
-            if (!data->ximage) {
-                X11_XShmDetach(display, shminfo);
-                X11_XSync(display, False);
-                shmdt(shminfo->shmaddr);
-            } else {
-                /* Done! */
-                data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
-                data->use_mitshm = SDL_TRUE;
-                *pixels = shminfo->shmaddr;
-                return 0;
-            }
+            /* Done! */
+            data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
+            data->use_mitshm = SDL_TRUE;
+            *pixels = shminfo->shmaddr;
+            return 0;
         }
     }
 #endif /* not NO_SHARED_MEMORY */
@@ -147,72 +470,48 @@ int X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, cons
 {
     SDL_WindowData *data = window->driverdata;
     Display *display = data->videodata->display;
+    SDL_Rect merged[X11_FRAMEBUFFER_MAX_RECTS];
     int i;
-    int x, y, w, h;
     int window_w, window_h;
 
     SDL_GetWindowSizeInPixels(window, &window_w, &window_h);
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+    if (data->present) {
+        window_w = SDL_min(window_w, data->present->width);
+        window_h = SDL_min(window_h, data->present->height);
+    }
+#endif
+    if (data->ximage) {
+        window_w = SDL_min(window_w, data->ximage->width);
+        window_h = SDL_min(window_h, data->ximage->height);
+    }
+
+    numrects = X11_MergeFramebufferRects(rects, numrects, window_w, window_h, merged);
+
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+    if (data->present) {
+        return X11_PresentFramebuffer(_this, data, merged, numrects);
+    }
+#endif
+
+    if (!data->ximage) {
+        return SDL_SetError("Window doesn't have a framebuffer");
+    }
 
 #ifndef NO_SHARED_MEMORY
     if (data->use_mitshm) {
         for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
-
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
-                continue;
-            }
-            if (x < 0) {
-                x += w;
-                w += rects[i].x;
-            }
-            if (y < 0) {
-                y += h;
-                h += rects[i].y;
-            }
-            if (x + w > window_w) {
-                w = window_w - x;
-            }
-            if (y + h > window_h) {
-                h = window_h - y;
-            }
-
             X11_XShmPutImage(display, data->xwindow, data->gc, data->ximage,
-                             x, y, x, y, w, h, False);
+                             merged[i].x, merged[i].y, merged[i].x, merged[i].y,
+                             merged[i].w, merged[i].h, False);
         }
     } else
 #endif /* !NO_SHARED_MEMORY */
     {
         for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
-
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
-                continue;
-            }
-            if (x < 0) {
-                x += w;
-                w += rects[i].x;
-            }
-            if (y < 0) {
-                y += h;
-                h += rects[i].y;
-            }
-            if (x + w > window_w) {
-                w = window_w - x;
-            }
-            if (y + h > window_h) {
-                h = window_h - y;
-            }
-
             X11_XPutImage(display, data->xwindow, data->gc, data->ximage,
-                          x, y, x, y, w, h);
+                          merged[i].x, merged[i].y, merged[i].x, merged[i].y,
+                          merged[i].w, merged[i].h);
         }
     }
 
@@ -233,6 +532,12 @@ void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
 
     display = data->videodata->display;
 
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+    if (data->present) {
+        X11_DestroyPresentFramebuffer(data);
+    }
+#endif
+
     if (data->ximage) {
         XDestroyImage(data->ximage);
 
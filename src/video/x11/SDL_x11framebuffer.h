@@ -31,4 +31,8 @@ extern int X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *windo
                                        const SDL_Rect *rects, int numrects);
 extern void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window);
 
+#if defined(SDL_VIDEO_DRIVER_X11_XPRESENT) && !defined(NO_SHARED_MEMORY)
+extern void X11_HandlePresentEvent(SDL_VideoDevice *_this, XGenericEventCookie *cookie);
+#endif
+
 #endif /* SDL_x11framebuffer_h_ */
@@ -335,66 +335,130 @@ int X11_InitKeyboard(SDL_VideoDevice *_this)
     return 0;
 }
 
-void X11_UpdateKeymap(SDL_VideoDevice *_this, SDL_bool send_event)
+static SDL_Keycode X11_KeyCodeToSDLKeycode(SDL_VideoDevice *_this, KeyCode keycode, unsigned char group)
+{
+    SDL_Scancode scancode;
+
+    /* See if there is a UCS keycode for this scancode */
+    Uint32 key = X11_KeyCodeToUcs4(_this, keycode, group);
+    if (key) {
+        return key;
+    }
+
+    scancode = X11_KeyCodeToSDLScancode(_this, keycode);
+    switch (scancode) {
+    case SDL_SCANCODE_RETURN:
+        return SDLK_RETURN;
+    case SDL_SCANCODE_ESCAPE:
+        return SDLK_ESCAPE;
+    case SDL_SCANCODE_BACKSPACE:
+        return SDLK_BACKSPACE;
+    case SDL_SCANCODE_TAB:
+        return SDLK_TAB;
+    case SDL_SCANCODE_DELETE:
+        return SDLK_DELETE;
+    default:
+        return SDL_SCANCODE_TO_KEYCODE(scancode);
+    }
+}
+
+static void X11_UpdateKeyCodes(SDL_VideoDevice *_this, int first_keycode, int count)
 {
     SDL_VideoData *data = _this->driverdata;
     int i;
-    SDL_Scancode scancode;
+
+    for (i = first_keycode; i < first_keycode + count; i++) {
+        /* Make sure this is a valid scancode */
+        if (data->key_layout[i] == SDL_SCANCODE_UNKNOWN) {
+            continue;
+        }
+        data->key_keycodes[i] = X11_KeyCodeToSDLKeycode(_this, (KeyCode)i, data->keymap_group);
+    }
+}
+
+/* Passes the keymap on to SDL, if it changed */
+static void X11_SetKeymap(SDL_VideoDevice *_this, SDL_bool send_event)
+{
+    SDL_VideoData *data = _this->driverdata;
     SDL_Keycode keymap[SDL_NUM_SCANCODES];
-    unsigned char group = 0;
+    int i;
 
     SDL_GetDefaultKeymap(keymap);
+    for (i = 0; i < SDL_arraysize(data->key_layout); i++) {
+        const SDL_Scancode scancode = data->key_layout[i];
+        if (scancode != SDL_SCANCODE_UNKNOWN) {
+            keymap[scancode] = data->key_keycodes[i];
+        }
+    }
+
+    if (SDL_memcmp(keymap, data->keymap, sizeof(keymap)) != 0) {
+        SDL_memcpy(data->keymap, keymap, sizeof(keymap));
+        SDL_SetKeymap(0, keymap, SDL_NUM_SCANCODES, send_event);
+    }
+}
 
+/* Returns the current keyboard group */
+static unsigned char X11_GetKeyboardGroup(SDL_VideoDevice *_this)
+{
+    unsigned char group = 0;
 #ifdef SDL_VIDEO_DRIVER_X11_HAS_XKBKEYCODETOKEYSYM
+    SDL_VideoData *data = _this->driverdata;
+
     if (data->xkb) {
         XkbStateRec state;
-        X11_XkbGetUpdatedMap(data->display, XkbAllClientInfoMask, data->xkb);
-
         if (X11_XkbGetState(data->display, XkbUseCoreKbd, &state) == Success) {
             group = state.group;
         }
     }
 #endif
+    return group;
+}
 
-    for (i = 0; i < SDL_arraysize(data->key_layout); i++) {
-        Uint32 key;
+void X11_UpdateKeymap(SDL_VideoDevice *_this, SDL_bool send_event)
+{
+    SDL_VideoData *data = _this->driverdata;
 
-        /* Make sure this is a valid scancode */
-        scancode = data->key_layout[i];
-        if (scancode == SDL_SCANCODE_UNKNOWN) {
-            continue;
-        }
+#ifdef SDL_VIDEO_DRIVER_X11_HAS_XKBKEYCODETOKEYSYM
+    if (data->xkb) {
+        X11_XkbGetUpdatedMap(data->display, XkbAllClientInfoMask, data->xkb);
+    }
+#endif
+    data->keymap_group = X11_GetKeyboardGroup(_this);
 
-        /* See if there is a UCS keycode for this scancode */
-        key = X11_KeyCodeToUcs4(_this, (KeyCode)i, group);
-        if (key) {
-            keymap[scancode] = key;
-        } else {
-            SDL_Scancode keyScancode = X11_KeyCodeToSDLScancode(_this, (KeyCode)i);
-
-            switch (keyScancode) {
-            case SDL_SCANCODE_RETURN:
-                keymap[scancode] = SDLK_RETURN;
-                break;
-            case SDL_SCANCODE_ESCAPE:
-                keymap[scancode] = SDLK_ESCAPE;
-                break;
-            case SDL_SCANCODE_BACKSPACE:
-                keymap[scancode] = SDLK_BACKSPACE;
-                break;
-            case SDL_SCANCODE_TAB:
-                keymap[scancode] = SDLK_TAB;
-                break;
-            case SDL_SCANCODE_DELETE:
-                keymap[scancode] = SDLK_DELETE;
-                break;
-            default:
-                keymap[scancode] = SDL_SCANCODE_TO_KEYCODE(keyScancode);
-                break;
-            }
-        }
+    X11_UpdateKeyCodes(_this, 0, SDL_arraysize(data->key_layout));
+    X11_SetKeymap(_this, send_event);
+}
+
+void X11_UpdateKeymapRange(SDL_VideoDevice *_this, int first_keycode, int count, SDL_bool send_event)
+{
+    SDL_VideoData *data = _this->driverdata;
+    const int max_keycode = SDL_arraysize(data->key_layout);
+
+    if (first_keycode < 0) {
+        count += first_keycode;
+        first_keycode = 0;
+    }
+    if (count > max_keycode - first_keycode) {
+        count = max_keycode - first_keycode;
+    }
+    if (count <= 0) {
+        return;
     }
-    SDL_SetKeymap(0, keymap, SDL_NUM_SCANCODES, send_event);
+
+    if (X11_GetKeyboardGroup(_this) != data->keymap_group) {
+        /* Every key changed */
+        X11_UpdateKeymap(_this, send_event);
+        return;
+    }
+
+#ifdef SDL_VIDEO_DRIVER_X11_HAS_XKBKEYCODETOKEYSYM
+    if (data->xkb) {
+        X11_XkbGetKeySyms(data->display, first_keycode, count, data->xkb);
+    }
+#endif
+
+    X11_UpdateKeyCodes(_this, first_keycode, count);
+    X11_SetKeymap(_this, send_event);
 }
 
 void X11_QuitKeyboard(SDL_VideoDevice *_this)
@@ -25,6 +25,7 @@
 
 extern int X11_InitKeyboard(SDL_VideoDevice *_this);
 extern void X11_UpdateKeymap(SDL_VideoDevice *_this, SDL_bool send_event);
+extern void X11_UpdateKeymapRange(SDL_VideoDevice *_this, int first_keycode, int count, SDL_bool send_event);
 extern void X11_QuitKeyboard(SDL_VideoDevice *_this);
 extern void X11_StartTextInput(SDL_VideoDevice *_this);
 extern void X11_StopTextInput(SDL_VideoDevice *_this);
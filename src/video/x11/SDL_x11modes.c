@@ -494,6 +494,72 @@ static void SetXRandRDisplayName(Display *dpy, Atom EDID, char *name, const size
 #endif
 }
 
+static void SetXRandRDisplayVRRInfo(Display *dpy, Atom EDID, RROutput output, SDL_DisplayID displayID)
+{
+    /* The amdgpu and modesetting X drivers report whether the monitor
+       and the GPU can do variable refresh rate on each output */
+    Atom vrr_capable = X11_XInternAtom(dpy, "vrr_capable", True);
+    SDL_bool capable = SDL_FALSE;
+    unsigned char *edid = NULL;
+    unsigned long edid_length = 0;
+    int nprop;
+    Atom *props = X11_XRRListOutputProperties(dpy, output, &nprop);
+    int i;
+
+    for (i = 0; i < nprop; ++i) {
+        unsigned char *prop;
+        int actual_format;
+        unsigned long nitems, bytes_after;
+        Atom actual_type;
+
+        if (vrr_capable == None || props[i] != vrr_capable) {
+            continue;
+        }
+        if (X11_XRRGetOutputProperty(dpy, output, props[i], 0, 1, False,
+                                     False, AnyPropertyType, &actual_type,
+                                     &actual_format, &nitems, &bytes_after,
+                                     &prop) == Success) {
+            if (actual_format == 32 && nitems > 0 && *(long *)prop) {
+                capable = SDL_TRUE;
+            }
+            X11_XFree(prop);
+        }
+        break;
+    }
+
+    if (capable) {
+        for (i = 0; i < nprop; ++i) {
+            int actual_format;
+            unsigned long bytes_after;
+            Atom actual_type;
+
+            if (props[i] == EDID) {
+                if (X11_XRRGetOutputProperty(dpy, output, props[i], 0, 100, False,
+                                             False, AnyPropertyType, &actual_type,
+                                             &actual_format, &edid_length, &bytes_after,
+                                             &edid) != Success || actual_format != 8) {
+                    if (edid) {
+                        X11_XFree(edid);
+                    }
+                    edid = NULL;
+                    edid_length = 0;
+                }
+                break;
+            }
+        }
+    }
+
+    if (props) {
+        X11_XFree(props);
+    }
+
+    SDL_SetDisplayVariableRefreshRateInfo(displayID, capable, edid, edid_length);
+
+    if (edid) {
+        X11_XFree(edid);
+    }
+}
+
 static int X11_AddXRandRDisplay(SDL_VideoDevice *_this, Display *dpy, int screen, RROutput outputid, XRRScreenResources *res, SDL_bool send_event)
 {
     Atom EDID = X11_XInternAtom(dpy, "EDID", False);
@@ -505,6 +571,7 @@ static int X11_AddXRandRDisplay(SDL_VideoDevice *_this, Display *dpy, int screen
     SDL_DisplayMode mode;
     SDL_DisplayModeData *modedata;
     SDL_VideoDisplay display;
+    SDL_DisplayID displayID;
     RRMode modeID;
     RRCrtc output_crtc;
     XRRCrtcInfo *crtc;
@@ -596,9 +663,11 @@ static int X11_AddXRandRDisplay(SDL_VideoDevice *_this, Display *dpy, int screen
     display.desktop_mode = mode;
     display.content_scale = GetGlobalContentScale(_this);
     display.driverdata = displaydata;
-    if (SDL_AddVideoDisplay(&display, send_event) == 0) {
+    displayID = SDL_AddVideoDisplay(&display, send_event);
+    if (displayID == 0) {
         return -1;
     }
+    SetXRandRDisplayVRRInfo(dpy, EDID, outputid, displayID);
     return 0;
 }
 
@@ -58,6 +58,7 @@ SDL_X11_SYM(int,XEventsQueued,(Display* a,int b),(a,b),return)
 SDL_X11_SYM(int,XFillRectangle,(Display* a,Drawable b,GC c,int d,int e,unsigned int f,unsigned int g),(a,b,c,d,e,f,g),return)
 SDL_X11_SYM(Bool,XFilterEvent,(XEvent *event,Window w),(event,w),return)
 SDL_X11_SYM(int,XFlush,(Display* a),(a),return)
+SDL_X11_SYM(long,XMaxRequestSize,(Display* a),(a),return)
 SDL_X11_SYM(int,XFree,(void*a),(a),return)
 SDL_X11_SYM(int,XFreeCursor,(Display* a,Cursor b),(a,b),return)
 SDL_X11_SYM(void,XFreeFontSet,(Display* a, XFontSet b),(a,b),)
@@ -94,6 +95,7 @@ SDL_X11_SYM(int,XMapRaised,(Display* a,Window b),(a,b),return)
 SDL_X11_SYM(Status,XMatchVisualInfo,(Display* a,int b,int c,int d,XVisualInfo* e),(a,b,c,d,e),return)
 SDL_X11_SYM(int,XMissingExtension,(Display* a,_Xconst char* b),(a,b),return)
 SDL_X11_SYM(int,XMoveWindow,(Display* a,Window b,int c,int d),(a,b,c,d),return)
+SDL_X11_SYM(int,XNextEvent,(Display* a,XEvent* b),(a,b),return)
 SDL_X11_SYM(Display*,XOpenDisplay,(_Xconst char* a),(a),return)
 SDL_X11_SYM(Status,XInitThreads,(void),(),return)
 SDL_X11_SYM(int,XPeekEvent,(Display* a,XEvent* b),(a,b),return)
@@ -173,6 +175,18 @@ SDL_X11_SYM(Status, XFixesQueryVersion,(Display* a, int* b, int* c), (a,b,c), re
 SDL_X11_SYM(Status, XFixesSelectSelectionInput, (Display* a, Window b, Atom c, unsigned long d), (a,b,c,d), return)
 #endif
 
+/* The region functions come from libXfixes, which libXpresent links to */
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+SDL_X11_MODULE(XPRESENT)
+SDL_X11_SYM(Bool,XPresentQueryExtension,(Display* a,int* b,int* c,int* d),(a,b,c,d),return)
+SDL_X11_SYM(Status,XPresentQueryVersion,(Display* a,int* b,int* c),(a,b,c),return)
+SDL_X11_SYM(void,XPresentPixmap,(Display* a,Window b,Pixmap c,uint32_t d,XserverRegion e,XserverRegion f,int g,int h,RRCrtc i,XSyncFence j,XSyncFence k,uint32_t l,uint64_t m,uint64_t n,uint64_t o,XPresentNotify* p,int q),(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q),)
+SDL_X11_SYM(XID,XPresentSelectInput,(Display* a,Window b,unsigned c),(a,b,c),return)
+SDL_X11_SYM(void,XPresentFreeInput,(Display* a,Window b,XID c),(a,b,c),)
+SDL_X11_SYM(XserverRegion,XFixesCreateRegion,(Display* a,XRectangle* b,int c),(a,b,c),return)
+SDL_X11_SYM(void,XFixesDestroyRegion,(Display* a,XserverRegion b),(a,b),)
+#endif
+
 #ifdef SDL_VIDEO_DRIVER_X11_SUPPORTS_GENERIC_EVENTS
 SDL_X11_SYM(Bool,XGetEventData,(Display* a,XGenericEventCookie* b),(a,b),return)
 SDL_X11_SYM(void,XFreeEventData,(Display* a,XGenericEventCookie* b),(a,b),)
@@ -187,6 +201,7 @@ SDL_X11_SYM(KeySym,XkbKeycodeToKeysym,(Display* a,KeyCode b,int c,int d),(a,b,c,
 #endif
 SDL_X11_SYM(Status,XkbGetState,(Display* a,unsigned int b,XkbStatePtr c),(a,b,c),return)
 SDL_X11_SYM(Status,XkbGetUpdatedMap,(Display* a,unsigned int b,XkbDescPtr c),(a,b,c),return)
+SDL_X11_SYM(Status,XkbGetKeySyms,(Display* a,unsigned int b,unsigned int c,XkbDescPtr d),(a,b,c,d),return)
 SDL_X11_SYM(XkbDescPtr,XkbGetMap,(Display* a,unsigned int b,unsigned int c),(a,b,c),return)
 SDL_X11_SYM(void,XkbFreeClientMap,(XkbDescPtr a,unsigned int b, Bool c),(a,b,c),)
 SDL_X11_SYM(void,XkbFreeKeyboard,(XkbDescPtr a,unsigned int b, Bool c),(a,b,c),)
@@ -232,6 +247,8 @@ SDL_X11_SYM(Status,XShmPutImage,(Display* a,Drawable b,GC c,XImage* d,int e,int
 SDL_X11_SYM(XImage*,XShmCreateImage,(Display* a,Visual* b,unsigned int c,int d,char* e,XShmSegmentInfo* f,unsigned int g,unsigned int h),(a,b,c,d,e,f,g,h),return)
 SDL_X11_SYM(Pixmap,XShmCreatePixmap,(Display *a,Drawable b,char* c,XShmSegmentInfo* d, unsigned int e, unsigned int f, unsigned int g),(a,b,c,d,e,f,g),return)
 SDL_X11_SYM(Bool,XShmQueryExtension,(Display* a),(a),return)
+SDL_X11_SYM(Bool,XShmQueryVersion,(Display* a,int* b,int* c,Bool* d),(a,b,c,d),return)
+SDL_X11_SYM(int,XShmPixmapFormat,(Display* a),(a),return)
 #endif
 
 /*
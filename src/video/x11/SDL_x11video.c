@@ -211,6 +211,7 @@ static SDL_VideoDevice *X11_CreateDevice(void)
     device->FlashWindow = X11_FlashWindow;
     device->ShowWindowSystemMenu = X11_ShowWindowSystemMenu;
     device->SetWindowFocusable = X11_SetWindowFocusable;
+    device->SetWindowVariableRefreshRate = X11_SetWindowVariableRefreshRate;
 
 #ifdef SDL_VIDEO_DRIVER_X11_XFIXES
     device->SetWindowMouseRect = X11_SetWindowMouseRect;
@@ -391,6 +392,7 @@ int X11_VideoInit(SDL_VideoDevice *_this)
     GET_ATOM(_NET_WM_USER_TIME);
     GET_ATOM(_NET_ACTIVE_WINDOW);
     GET_ATOM(_NET_FRAME_EXTENTS);
+    GET_ATOM(_VARIABLE_REFRESH);
     GET_ATOM(_SDL_WAKEUP);
     GET_ATOM(UTF8_STRING);
     GET_ATOM(PRIMARY);
@@ -55,9 +55,14 @@ struct SDL_VideoData
     Window clipboard_window;
     SDLX11_ClipboardData clipboard;
     SDLX11_ClipboardData primary_selection;
+    SDLX11_IncrTransfer *incr_transfers;
 #ifdef SDL_VIDEO_DRIVER_X11_XFIXES
     SDL_Window *active_cursor_confined_window;
 #endif /* SDL_VIDEO_DRIVER_X11_XFIXES */
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    SDL_bool xpresent_checked;
+    int xpresent_opcode; /* 0 if window framebuffers can't be presented with XPresent */
+#endif /* SDL_VIDEO_DRIVER_X11_XPRESENT */
 
     /* This is true for ICCCM2.0-compliant window managers */
     SDL_bool net_wm;
@@ -86,6 +91,7 @@ struct SDL_VideoData
     Atom _NET_WM_USER_TIME;
     Atom _NET_ACTIVE_WINDOW;
     Atom _NET_FRAME_EXTENTS;
+    Atom _VARIABLE_REFRESH;
     Atom _SDL_WAKEUP;
     Atom UTF8_STRING;
     Atom PRIMARY;
@@ -100,7 +106,9 @@ struct SDL_VideoData
     Atom XKLAVIER_STATE;
 
     SDL_Scancode key_layout[256];
-    SDL_bool selection_waiting;
+    SDL_Keycode key_keycodes[256];          /* SDL keycode of each X keycode in keymap_group */
+    SDL_Keycode keymap[SDL_NUM_SCANCODES];  /* the keymap last passed to SDL_SetKeymap() */
+    unsigned char keymap_group;
 
     SDL_bool broken_pointer_grab; /* true if XGrabPointer seems unreliable. */
 
@@ -2001,4 +2001,20 @@ int X11_SetWindowFocusable(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool
     return 0;
 }
 
+int X11_SetWindowVariableRefreshRate(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool enabled)
+{
+    SDL_WindowData *data = window->driverdata;
+    Display *display = data->videodata->display;
+    const long value = enabled ? 1 : 0;
+
+    /* The amdgpu and modesetting X drivers turn on variable refresh rate
+       for fullscreen windows that have this property set, it's the same
+       property Mesa sets for its adaptive_sync option. */
+    X11_XChangeProperty(display, data->xwindow, data->videodata->_VARIABLE_REFRESH, XA_CARDINAL, 32,
+                        PropModeReplace, (const unsigned char *)&value, 1);
+    X11_XFlush(display);
+
+    return 0;
+}
+
 #endif /* SDL_VIDEO_DRIVER_X11 */
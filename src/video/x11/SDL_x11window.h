@@ -53,6 +53,9 @@ struct SDL_WindowData
 #endif
     XImage *ximage;
     GC gc;
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    struct SDL_X11PresentFramebuffer *present;
+#endif
     XIC ic;
     SDL_bool created;
     int border_left;
@@ -116,6 +119,7 @@ extern void X11_AcceptDragAndDrop(SDL_Window *window, SDL_bool accept);
 extern int X11_FlashWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_FlashOperation operation);
 extern void X11_ShowWindowSystemMenu(SDL_Window *window, int x, int y);
 extern int X11_SetWindowFocusable(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool focusable);
+extern int X11_SetWindowVariableRefreshRate(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool enabled);
 
 int SDL_X11_SetWindowTitle(Display *display, Window xwindow, char *title);
 void X11_UpdateWindowPosition(SDL_Window *window);
@@ -45,6 +45,14 @@ static int xinput2_multitouch_supported = 0;
  * this extension */
 static int xinput2_opcode;
 
+/* Relative motion from raw events, delivered as one motion event per batch of X events */
+static struct
+{
+    SDL_bool pending;
+    double x, y;
+    Uint64 timestamp;
+} xinput2_relative_motion;
+
 static void parse_valuators(const double *input_values, const unsigned char *mask, int mask_len,
                             double *output_values, int output_values_len)
 {
@@ -285,6 +293,29 @@ static void xinput2_pen_ensure_window(SDL_VideoDevice *_this, const SDL_Pen *pen
 }
 #endif
 
+void X11_FlushXinput2Motion(SDL_VideoDevice *_this, const XEvent *next_event)
+{
+#ifdef SDL_VIDEO_DRIVER_X11_XINPUT2
+    if (!xinput2_relative_motion.pending) {
+        return;
+    }
+
+    /* Keep accumulating while raw motion keeps coming */
+    if (next_event && next_event->type == GenericEvent &&
+        next_event->xcookie.extension == xinput2_opcode && next_event->xcookie.evtype == XI_RawMotion) {
+        return;
+    }
+
+    if (xinput2_relative_motion.x != 0.0 || xinput2_relative_motion.y != 0.0) {
+        SDL_Mouse *mouse = SDL_GetMouse();
+
+        SDL_SendMouseMotion(xinput2_relative_motion.timestamp, mouse->focus, mouse->mouseID, 1,
+                            (float)xinput2_relative_motion.x, (float)xinput2_relative_motion.y);
+    }
+    SDL_zero(xinput2_relative_motion);
+#endif
+}
+
 int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
 {
 #ifdef SDL_VIDEO_DRIVER_X11_XINPUT2
@@ -349,7 +380,10 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
             }
         }
 
-        SDL_SendMouseMotion(0, mouse->focus, mouse->mouseID, 1, (float)processed_coords[0], (float)processed_coords[1]);
+        xinput2_relative_motion.x += processed_coords[0];
+        xinput2_relative_motion.y += processed_coords[1];
+        xinput2_relative_motion.timestamp = X11_GetEventTimestamp(rawev->time);
+        xinput2_relative_motion.pending = SDL_TRUE;
         devinfo->prev_coords[0] = coords[0];
         devinfo->prev_coords[1] = coords[1];
         return 1;
@@ -401,10 +435,10 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                 return 1; /* Don't pass on this event */
 		    }
 		}
-		SDL_SendPenTipEvent(0, pen->header.id,
+		SDL_SendPenTipEvent(X11_GetEventTimestamp(xev->time), pen->header.id,
 				    pressed ? SDL_PRESSED : SDL_RELEASED);
 	    } else {
-		SDL_SendPenButton(0, pen->header.id,
+		SDL_SendPenButton(X11_GetEventTimestamp(xev->time), pen->header.id,
 				  pressed ? SDL_PRESSED : SDL_RELEASED,
 				  button - 1);
 	    }
@@ -422,7 +456,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                 X11_HandleButtonPress(_this, windowdata, button,
                                       xev->event_x, xev->event_y, xev->time);
             } else {
-                X11_HandleButtonRelease(_this, windowdata, button);
+                X11_HandleButtonRelease(_this, windowdata, button, xev->time);
             }
         }
     } break;
@@ -454,7 +488,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
 
             xinput2_pen_ensure_window(_this, pen, xev->event);
 
-            SDL_SendPenMotion(0, pen->header.id,
+            SDL_SendPenMotion(X11_GetEventTimestamp(xev->time), pen->header.id,
                               SDL_TRUE,
                               &pen_status);
             return 1;
@@ -467,7 +501,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                 SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
                 if (window) {
                     X11_ProcessHitTest(_this, window->driverdata, (float)xev->event_x, (float)xev->event_y, SDL_FALSE);
-                    SDL_SendMouseMotion(0, window, 0, 0, (float)xev->event_x, (float)xev->event_y);
+                    SDL_SendMouseMotion(X11_GetEventTimestamp(xev->time), window, 0, 0, (float)xev->event_x, (float)xev->event_y);
                 }
             }
         }
@@ -482,7 +516,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouch(0, xev->sourceid, xev->detail, window, SDL_TRUE, x, y, 1.0);
+        SDL_SendTouch(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, SDL_TRUE, x, y, 1.0);
         return 1;
     } break;
     case XI_TouchEnd:
@@ -491,7 +525,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouch(0, xev->sourceid, xev->detail, window, SDL_FALSE, x, y, 1.0);
+        SDL_SendTouch(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, SDL_FALSE, x, y, 1.0);
         return 1;
     } break;
     case XI_TouchUpdate:
@@ -500,7 +534,7 @@ int X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouchMotion(0, xev->sourceid, xev->detail, window, x, y, 1.0);
+        SDL_SendTouchMotion(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, x, y, 1.0);
         return 1;
     } break;
 #endif /* SDL_VIDEO_DRIVER_X11_XINPUT2_SUPPORTS_MULTITOUCH */
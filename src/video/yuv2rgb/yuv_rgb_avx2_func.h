@@ -0,0 +1,264 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	AVX2_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* Pixels are converted 16 at a time, kept in order in 16-bit lanes, with the
+   chroma values repeated for both pixels of a pair. The arithmetic is the same
+   as in the SSE version, so both give the same results. */
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y_ptr)))
+
+#define READ_UV(uv_ptr) \
+	_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(uv_ptr)))
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(y_ptr)), _mm256_set1_epi16(0xFF))
+
+#define READ_UV(uv_ptr) \
+	_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(uv_ptr)), _mm256_set1_epi32(0xFF))
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y_ptr)))
+
+#define READ_UV(uv_ptr) \
+	_mm256_and_si256(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(uv_ptr))), _mm256_set1_epi32(0xFFFF))
+
+#else
+#error READ_UV unimplemented
+#endif
+
+/* READ_UV leaves one chroma value in each 32-bit lane, repeat it for both pixels */
+#define DUP_UV(uv) \
+	_mm256_sub_epi16(_mm256_or_si256(uv, _mm256_slli_epi32(uv, 16)), _mm256_set1_epi16(128))
+
+/* Stores 16 pixels whose bytes are C0, C1, C2, C3 in memory order */
+#define PACK_RGBA_32(C0, C1, C2, C3, rgb_ptr) \
+{ \
+	const __m256i p = _mm256_packus_epi16(C0, C2), q = _mm256_packus_epi16(C1, C3); \
+	const __m256i t0 = _mm256_unpacklo_epi8(p, q), t1 = _mm256_unpackhi_epi8(p, q); \
+	const __m256i lo = _mm256_unpacklo_epi16(t0, t1), hi = _mm256_unpackhi_epi16(t0, t1); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), _mm256_permute2x128_si256(lo, hi, 0x20)); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+32), _mm256_permute2x128_si256(lo, hi, 0x31)); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define PACK_PIXEL(rgb_ptr) \
+{ \
+	const __m256i zero = _mm256_setzero_si256(), max = _mm256_set1_epi16(255); \
+	r = _mm256_min_epi16(_mm256_max_epi16(r, zero), max); \
+	g = _mm256_min_epi16(_mm256_max_epi16(g, zero), max); \
+	b = _mm256_min_epi16(_mm256_max_epi16(b, zero), max); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), _mm256_or_si256(_mm256_or_si256( \
+		_mm256_slli_epi16(_mm256_and_si256(r, _mm256_set1_epi16(0xF8)), 8), \
+		_mm256_slli_epi16(_mm256_and_si256(g, _mm256_set1_epi16(0xFC)), 3)), \
+		_mm256_srli_epi16(b, 3))); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+/* Each lane holds 8 pixels, interleaved into 16 bytes and 8 more */
+#define PACK_PIXEL(rgb_ptr) \
+{ \
+	const __m256i p = _mm256_packus_epi16(r, g), q = _mm256_packus_epi16(b, b); \
+	const __m256i first = _mm256_or_si256(_mm256_shuffle_epi8(p, rgb24_mask1), _mm256_shuffle_epi8(q, rgb24_mask2)); \
+	const __m256i last = _mm256_or_si256(_mm256_shuffle_epi8(p, rgb24_mask3), _mm256_shuffle_epi8(q, rgb24_mask4)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr), _mm256_castsi256_si128(first)); \
+	_mm_storel_epi64((__m128i*)(rgb_ptr+16), _mm256_castsi256_si128(last)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+24), _mm256_extracti128_si256(first, 1)); \
+	_mm_storel_epi64((__m128i*)(rgb_ptr+40), _mm256_extracti128_si256(last, 1)); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(_mm256_set1_epi16(255), b, g, r, rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(_mm256_set1_epi16(255), r, g, b, rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(b, g, r, _mm256_set1_epi16(255), rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(r, g, b, _mm256_set1_epi16(255), rgb_ptr)
+
+#else
+#error PACK_PIXEL unimplemented
+#endif
+
+#define YUV2RGB_16(y_ptr, rgb_ptr) \
+{ \
+	__m256i y, r, g, b; \
+	\
+	y = _mm256_mullo_epi16(_mm256_sub_epi16(READ_Y(y_ptr), y_shift), y_factor); \
+	r = _mm256_srai_epi16(_mm256_add_epi16(r_uv, y), PRECISION); \
+	g = _mm256_srai_epi16(_mm256_add_epi16(g_uv, y), PRECISION); \
+	b = _mm256_srai_epi16(_mm256_add_epi16(b_uv, y), PRECISION); \
+	PACK_PIXEL(rgb_ptr) \
+}
+
+void SDL_TARGETING("avx2") AVX2_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+	const __m256i rgb24_mask1 = _mm256_setr_epi8(
+		0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5,
+		0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5);
+	const __m256i rgb24_mask2 = _mm256_setr_epi8(
+		-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1,
+		-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+	const __m256i rgb24_mask3 = _mm256_setr_epi8(
+		13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m256i rgb24_mask4 = _mm256_setr_epi8(
+		-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+	const __m256i y_shift = _mm256_set1_epi16(param->y_shift);
+	const __m256i y_factor = _mm256_set1_epi16(param->y_factor);
+	const __m256i v_r_factor = _mm256_set1_epi16(param->v_r_factor);
+	const __m256i u_g_factor = _mm256_set1_epi16(param->u_g_factor);
+	const __m256i v_g_factor = _mm256_set1_epi16(param->v_g_factor);
+	const __m256i u_b_factor = _mm256_set1_epi16(param->u_b_factor);
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+	uint32_t converted = (width & ~15);
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* The interleaved chroma is read 16 bytes at a time, which goes one byte past
+	   the end of the row for the last pixels, see the SSE version */
+	if (converted > 0 && converted == width) {
+		converted -= 16;
+	}
+#endif
+
+	if (converted > 0) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<converted; xpos+=16)
+			{
+				const __m256i u = DUP_UV(READ_UV(u_ptr));
+				const __m256i v = DUP_UV(READ_UV(v_ptr));
+				const __m256i r_uv = _mm256_mullo_epi16(v, v_r_factor);
+				const __m256i g_uv = _mm256_add_epi16(_mm256_mullo_epi16(u, u_g_factor), _mm256_mullo_epi16(v, v_g_factor));
+				const __m256i b_uv = _mm256_mullo_epi16(u, u_b_factor);
+
+				YUV2RGB_16(y_ptr1, rgb_ptr1)
+				if (uv_y_sample_interval > 1)
+				{
+					YUV2RGB_16(y_ptr2, rgb_ptr2)
+				}
+
+				y_ptr1+=16*y_pixel_stride;
+				y_ptr2+=16*y_pixel_stride;
+				u_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=16*rgb_pixel_stride;
+				rgb_ptr2+=16*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width)
+	{
+		const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+			*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+			*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+		uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+		STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+	}
+}
+
+#undef AVX2_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef READ_Y
+#undef READ_UV
+#undef DUP_UV
+#undef PACK_RGBA_32
+#undef PACK_PIXEL
+#undef YUV2RGB_16
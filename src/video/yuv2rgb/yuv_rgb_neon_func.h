@@ -0,0 +1,270 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	NEON_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* Pixels are converted 16 at a time, as two vectors of 8 pixels in 16-bit lanes.
+   The arithmetic is the same as in the SSE version, so both give the same results. */
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	vld1q_u8(y_ptr)
+
+#define READ_UV(uv_ptr) \
+	vld1_u8(uv_ptr)
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	vld2q_u8(y_ptr).val[0]
+
+#define READ_UV(uv_ptr) \
+	vld4_u8(uv_ptr).val[0]
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	vld1q_u8(y_ptr)
+
+#define READ_UV(uv_ptr) \
+	vld2_u8(uv_ptr).val[0]
+
+#else
+#error READ_UV unimplemented
+#endif
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define PACK_PIXEL(rgb_ptr) \
+{ \
+	uint16x8_t rgb_1, rgb_2; \
+	\
+	rgb_1 = vshll_n_u8(vget_low_u8(r), 8); \
+	rgb_1 = vsriq_n_u16(rgb_1, vshll_n_u8(vget_low_u8(g), 8), 5); \
+	rgb_1 = vsriq_n_u16(rgb_1, vshll_n_u8(vget_low_u8(b), 8), 11); \
+	rgb_2 = vshll_n_u8(vget_high_u8(r), 8); \
+	rgb_2 = vsriq_n_u16(rgb_2, vshll_n_u8(vget_high_u8(g), 8), 5); \
+	rgb_2 = vsriq_n_u16(rgb_2, vshll_n_u8(vget_high_u8(b), 8), 11); \
+	vst1q_u16((uint16_t *)(rgb_ptr), rgb_1); \
+	vst1q_u16((uint16_t *)(rgb_ptr+16), rgb_2); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define PACK_PIXEL(rgb_ptr) \
+{ \
+	uint8x16x3_t rgb; \
+	\
+	rgb.val[0] = r; \
+	rgb.val[1] = g; \
+	rgb.val[2] = b; \
+	vst3q_u8(rgb_ptr, rgb); \
+}
+
+#else
+
+/* Stores 16 pixels whose bytes are C0, C1, C2, C3 in memory order */
+#define PACK_RGBA_32(C0, C1, C2, C3, rgb_ptr) \
+{ \
+	uint8x16x4_t rgba; \
+	\
+	rgba.val[0] = C0; \
+	rgba.val[1] = C1; \
+	rgba.val[2] = C2; \
+	rgba.val[3] = C3; \
+	vst4q_u8(rgb_ptr, rgba); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(vdupq_n_u8(255), b, g, r, rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(vdupq_n_u8(255), r, g, b, rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(b, g, r, vdupq_n_u8(255), rgb_ptr)
+
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define PACK_PIXEL(rgb_ptr) PACK_RGBA_32(r, g, b, vdupq_n_u8(255), rgb_ptr)
+
+#else
+#error PACK_PIXEL unimplemented
+#endif
+
+#endif
+
+/* Adds the luma to the chroma contributions, 8 pixels at a time */
+#define ADD_Y2RGB_8(Y, I) \
+	Y = vmulq_s16(vsubq_s16(Y, y_shift), y_factor); \
+	r_8[I] = vqmovun_s16(vshrq_n_s16(vaddq_s16(r_uv[I], Y), PRECISION)); \
+	g_8[I] = vqmovun_s16(vshrq_n_s16(vaddq_s16(g_uv[I], Y), PRECISION)); \
+	b_8[I] = vqmovun_s16(vshrq_n_s16(vaddq_s16(b_uv[I], Y), PRECISION)); \
+
+#define YUV2RGB_16(y_ptr, rgb_ptr) \
+{ \
+	const uint8x16_t y = READ_Y(y_ptr); \
+	int16x8_t y_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	int16x8_t y_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	uint8x8_t r_8[2], g_8[2], b_8[2]; \
+	uint8x16_t r, g, b; \
+	\
+	ADD_Y2RGB_8(y_1, 0) \
+	ADD_Y2RGB_8(y_2, 1) \
+	r = vcombine_u8(r_8[0], r_8[1]); \
+	g = vcombine_u8(g_8[0], g_8[1]); \
+	b = vcombine_u8(b_8[0], b_8[1]); \
+	PACK_PIXEL(rgb_ptr) \
+}
+
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+	const int16x8_t y_shift = vdupq_n_s16(param->y_shift);
+	const int16x8_t y_factor = vdupq_n_s16(param->y_factor);
+	const int16x8_t bias = vdupq_n_s16(128);
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+	uint32_t converted = (width & ~15);
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* The interleaved chroma is read 16 bytes at a time, which goes one byte past
+	   the end of the row for the last pixels, see the SSE version */
+	if (converted > 0 && converted == width) {
+		converted -= 16;
+	}
+#endif
+
+	if (converted > 0) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<converted; xpos+=16)
+			{
+				/* Repeat the chroma values for both pixels of each pair */
+				const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(READ_UV(u_ptr))), bias);
+				const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(READ_UV(v_ptr))), bias);
+				const int16x8x2_t u_16 = vzipq_s16(u, u);
+				const int16x8x2_t v_16 = vzipq_s16(v, v);
+				int16x8_t r_uv[2], g_uv[2], b_uv[2];
+				int i;
+
+				for (i = 0; i < 2; ++i) {
+					r_uv[i] = vmulq_n_s16(v_16.val[i], param->v_r_factor);
+					g_uv[i] = vaddq_s16(vmulq_n_s16(u_16.val[i], param->u_g_factor), vmulq_n_s16(v_16.val[i], param->v_g_factor));
+					b_uv[i] = vmulq_n_s16(u_16.val[i], param->u_b_factor);
+				}
+
+				YUV2RGB_16(y_ptr1, rgb_ptr1)
+				if (uv_y_sample_interval > 1)
+				{
+					YUV2RGB_16(y_ptr2, rgb_ptr2)
+				}
+
+				y_ptr1+=16*y_pixel_stride;
+				y_ptr2+=16*y_pixel_stride;
+				u_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=16*rgb_pixel_stride;
+				rgb_ptr2+=16*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width)
+	{
+		const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+			*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+			*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+		uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+		STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+	}
+}
+
+#undef NEON_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef READ_Y
+#undef READ_UV
+#undef PACK_RGBA_32
+#undef PACK_PIXEL
+#undef ADD_Y2RGB_8
+#undef YUV2RGB_16
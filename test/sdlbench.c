@@ -0,0 +1,713 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Throughput benchmarks for SDL's hot paths.
+
+   Every case is run for a fixed amount of time and reported as a rate, so
+   results from different machines and commits can be compared directly.
+   Use --json to write the results somewhere a regression tracker can read
+   them, and --filter to run a subset, e.g. --filter blit/ or --filter NV12. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define BENCH_WIDTH     512
+#define BENCH_HEIGHT    512
+#define BENCH_EVENTS    1000
+#define BENCH_PROPS     256
+#define AUDIO_FRAMES    4096
+
+typedef struct
+{
+    char category[32];
+    char name[64];
+    double value;
+    const char *unit;
+} BenchResult;
+
+static double bench_seconds = 0.25;
+static const char *bench_filter = NULL;
+static const char *bench_json = NULL;
+static BenchResult *results = NULL;
+static int num_results = 0;
+
+static const SDL_PixelFormatEnum rgb_formats[] = {
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24
+};
+
+static const SDL_PixelFormatEnum yuv_formats[] = {
+    SDL_PIXELFORMAT_YV12,
+    SDL_PIXELFORMAT_IYUV,
+    SDL_PIXELFORMAT_NV12,
+    SDL_PIXELFORMAT_NV21,
+    SDL_PIXELFORMAT_YUY2,
+    SDL_PIXELFORMAT_UYVY,
+    SDL_PIXELFORMAT_YVYU
+};
+
+static const int sprite_counts[] = { 100, 1000, 10000 };
+
+static const char *FormatName(SDL_PixelFormatEnum format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+
+    if (SDL_strncmp(name, "SDL_PIXELFORMAT_", 16) == 0) {
+        name += 16;
+    }
+    return name;
+}
+
+static SDL_bool BenchWanted(const char *category, const char *name)
+{
+    if (bench_filter) {
+        char full[128];
+        SDL_snprintf(full, sizeof(full), "%s/%s", category, name);
+        return SDL_strstr(full, bench_filter) ? SDL_TRUE : SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static double ElapsedSeconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void Report(const char *category, const char *name, Uint64 count, double seconds, const char *unit)
+{
+    const double value = (seconds > 0.0) ? ((double)count / seconds / 1000000.0) : 0.0;
+    BenchResult *new_results;
+
+    SDL_Log("%-10s %-40s %10.2f %s\n", category, name, value, unit);
+
+    new_results = (BenchResult *)SDL_realloc(results, (num_results + 1) * sizeof(*results));
+    if (new_results) {
+        results = new_results;
+        SDL_strlcpy(results[num_results].category, category, sizeof(results[num_results].category));
+        SDL_strlcpy(results[num_results].name, name, sizeof(results[num_results].name));
+        results[num_results].value = value;
+        results[num_results].unit = unit;
+        ++num_results;
+    }
+}
+
+static void FillPattern(Uint8 *pixels, size_t size)
+{
+    size_t i;
+    for (i = 0; i < size; ++i) {
+        pixels[i] = (Uint8)((i * 7) ^ (i >> 9));
+    }
+}
+
+static SDL_Surface *CreatePatternSurface(SDL_PixelFormatEnum format)
+{
+    SDL_Surface *surface = SDL_CreateSurface(BENCH_WIDTH, BENCH_HEIGHT, format);
+
+    if (surface) {
+        FillPattern((Uint8 *)surface->pixels, (size_t)surface->pitch * surface->h);
+    }
+    return surface;
+}
+
+static int BenchBlitCase(SDL_PixelFormatEnum src_format, SDL_PixelFormatEnum dst_format, SDL_BlendMode blend, SDL_bool scaled)
+{
+    SDL_Surface *src = NULL;
+    SDL_Surface *dst = NULL;
+    SDL_Rect dst_rect;
+    Uint64 pixels = 0;
+    Uint64 start;
+    double elapsed;
+    char name[64];
+    int ret = -1;
+
+    SDL_snprintf(name, sizeof(name), "%s->%s%s%s", FormatName(src_format), FormatName(dst_format),
+                 (blend == SDL_BLENDMODE_BLEND) ? " blend" : "", scaled ? " scaled" : "");
+    if (!BenchWanted("blit", name)) {
+        return 0;
+    }
+
+    src = CreatePatternSurface(src_format);
+    dst = CreatePatternSurface(dst_format);
+    if (!src || !dst || SDL_SetSurfaceBlendMode(src, blend) < 0) {
+        goto end;
+    }
+
+    /* Scaled blits stretch the source up by half again */
+    dst_rect.x = 0;
+    dst_rect.y = 0;
+    dst_rect.w = scaled ? (BENCH_WIDTH * 2 / 3) : BENCH_WIDTH;
+    dst_rect.h = scaled ? (BENCH_HEIGHT * 2 / 3) : BENCH_HEIGHT;
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        if (scaled) {
+            if (SDL_BlitSurfaceScaled(src, NULL, dst, &dst_rect) < 0) {
+                goto end;
+            }
+        } else {
+            if (SDL_BlitSurface(src, NULL, dst, NULL) < 0) {
+                goto end;
+            }
+        }
+        pixels += (Uint64)dst_rect.w * dst_rect.h;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("blit", name, pixels, elapsed, "Mpixels/s");
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "blit/%s failed: %s\n", name, SDL_GetError());
+    }
+    SDL_DestroySurface(dst);
+    SDL_DestroySurface(src);
+    return ret;
+}
+
+static int BenchBlit(void)
+{
+    int i, j;
+
+    for (i = 0; i < (int)SDL_arraysize(rgb_formats); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(rgb_formats); ++j) {
+            if (BenchBlitCase(rgb_formats[i], rgb_formats[j], SDL_BLENDMODE_NONE, SDL_FALSE) < 0) {
+                return -1;
+            }
+        }
+    }
+    for (i = 0; i < (int)SDL_arraysize(rgb_formats); ++i) {
+        if (BenchBlitCase(SDL_PIXELFORMAT_ARGB8888, rgb_formats[i], SDL_BLENDMODE_BLEND, SDL_FALSE) < 0) {
+            return -1;
+        }
+    }
+    if (BenchBlitCase(SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE, SDL_TRUE) < 0 ||
+        BenchBlitCase(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_BLEND, SDL_TRUE) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Planar YUV formats have one byte of Y per pixel in the first plane */
+static int GetPitch(SDL_PixelFormatEnum format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        return BENCH_WIDTH * 2;
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        return BENCH_WIDTH;
+    default:
+        return BENCH_WIDTH * SDL_BYTESPERPIXEL(format);
+    }
+}
+
+static int BenchConvertCase(const char *category, SDL_PixelFormatEnum src_format, SDL_PixelFormatEnum dst_format)
+{
+    /* Big enough for any of the formats used here */
+    const size_t size = (size_t)BENCH_WIDTH * BENCH_HEIGHT * 4;
+    const int src_pitch = GetPitch(src_format);
+    const int dst_pitch = GetPitch(dst_format);
+    Uint8 *src = NULL;
+    Uint8 *dst = NULL;
+    Uint64 pixels = 0;
+    Uint64 start;
+    double elapsed;
+    char name[64];
+    int ret = -1;
+
+    SDL_snprintf(name, sizeof(name), "%s->%s", FormatName(src_format), FormatName(dst_format));
+    if (!BenchWanted(category, name)) {
+        return 0;
+    }
+
+    src = (Uint8 *)SDL_malloc(size);
+    dst = (Uint8 *)SDL_malloc(size);
+    if (!src || !dst) {
+        goto end;
+    }
+    FillPattern(src, size);
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        if (SDL_ConvertPixels(BENCH_WIDTH, BENCH_HEIGHT, src_format, src, src_pitch, dst_format, dst, dst_pitch) < 0) {
+            goto end;
+        }
+        pixels += (Uint64)BENCH_WIDTH * BENCH_HEIGHT;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report(category, name, pixels, elapsed, "Mpixels/s");
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s/%s failed: %s\n", category, name, SDL_GetError());
+    }
+    SDL_free(dst);
+    SDL_free(src);
+    return ret;
+}
+
+static int BenchConvert(void)
+{
+    int i, j;
+
+    for (i = 0; i < (int)SDL_arraysize(rgb_formats); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(rgb_formats); ++j) {
+            if (i != j && BenchConvertCase("convert", rgb_formats[i], rgb_formats[j]) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int BenchYUV(void)
+{
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(yuv_formats); ++i) {
+        if (BenchConvertCase("yuv", yuv_formats[i], SDL_PIXELFORMAT_XRGB8888) < 0 ||
+            BenchConvertCase("yuv", SDL_PIXELFORMAT_XRGB8888, yuv_formats[i]) < 0) {
+            return -1;
+        }
+    }
+    if (BenchConvertCase("yuv", SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_IYUV) < 0 ||
+        BenchConvertCase("yuv", SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_NV12) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int BenchRenderCase(const char *driver, int num_sprites)
+{
+    SDL_Window *window = NULL;
+    SDL_Renderer *renderer = NULL;
+    SDL_Texture *texture = NULL;
+    SDL_Surface *surface = NULL;
+    Uint64 sprites = 0;
+    Uint64 start;
+    double elapsed;
+    char name[64];
+    int ret = -1;
+    int i;
+
+    SDL_snprintf(name, sizeof(name), "%s %d sprites", driver, num_sprites);
+    if (!BenchWanted("render", name)) {
+        return 0;
+    }
+
+    window = SDL_CreateWindow("sdlbench", 640, 480, SDL_WINDOW_HIDDEN);
+    if (!window) {
+        goto end;
+    }
+    renderer = SDL_CreateRenderer(window, driver, 0);
+    if (!renderer) {
+        /* Not every driver works on every system, just skip it */
+        SDL_Log("%-10s %-40s %10s\n", "render", name, "skipped");
+        ret = 0;
+        goto end;
+    }
+    surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        goto end;
+    }
+    FillPattern((Uint8 *)surface->pixels, (size_t)surface->pitch * surface->h);
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture || SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND) < 0) {
+        goto end;
+    }
+
+    /* One untimed frame to upload the texture and set up the pipeline */
+    SDL_RenderClear(renderer);
+    SDL_RenderTexture(renderer, texture, NULL, NULL);
+    SDL_RenderPresent(renderer);
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        SDL_RenderClear(renderer);
+        for (i = 0; i < num_sprites; ++i) {
+            SDL_FRect rect;
+
+            rect.x = (float)((i * 37) % (640 - 32));
+            rect.y = (float)((i * 53) % (480 - 32));
+            rect.w = 32.0f;
+            rect.h = 32.0f;
+            SDL_RenderTexture(renderer, texture, NULL, &rect);
+        }
+        SDL_RenderPresent(renderer);
+        sprites += num_sprites;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("render", name, sprites, elapsed, "Msprites/s");
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "render/%s failed: %s\n", name, SDL_GetError());
+    }
+    SDL_DestroyTexture(texture);
+    SDL_DestroySurface(surface);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    return ret;
+}
+
+static int BenchRender(void)
+{
+    int i, j;
+
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("%-10s %-40s %10s\n", "render", "(no video)", "skipped");
+        return 0;
+    }
+
+    for (i = 0; i < SDL_GetNumRenderDrivers(); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(sprite_counts); ++j) {
+            if (BenchRenderCase(SDL_GetRenderDriver(i), sprite_counts[j]) < 0) {
+                SDL_QuitSubSystem(SDL_INIT_VIDEO);
+                return -1;
+            }
+        }
+    }
+
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    return 0;
+}
+
+static int BenchEvents(void)
+{
+    Uint32 type;
+    Uint64 events = 0;
+    Uint64 start;
+    double elapsed;
+    int i;
+
+    if (!BenchWanted("events", "push+poll")) {
+        return 0;
+    }
+
+    if (SDL_InitSubSystem(SDL_INIT_EVENTS) < 0) {
+        return -1;
+    }
+    type = SDL_RegisterEvents(1);
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        SDL_Event event;
+
+        for (i = 0; i < BENCH_EVENTS; ++i) {
+            SDL_zero(event);
+            event.type = type;
+            event.user.code = i;
+            SDL_PushEvent(&event);
+        }
+        while (SDL_PollEvent(&event)) {
+        }
+        events += BENCH_EVENTS;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("events", "push+poll", events, elapsed, "Mevents/s");
+
+    SDL_QuitSubSystem(SDL_INIT_EVENTS);
+    return 0;
+}
+
+static int BenchAudioStream(const char *name, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
+{
+    SDL_AudioStream *stream = NULL;
+    Uint8 *src = NULL;
+    Uint8 *dst = NULL;
+    const int src_len = AUDIO_FRAMES * SDL_AUDIO_FRAMESIZE(*src_spec);
+    const int dst_len = (int)(((Sint64)AUDIO_FRAMES * dst_spec->freq / src_spec->freq) + 256) * SDL_AUDIO_FRAMESIZE(*dst_spec);
+    Uint64 frames = 0;
+    Uint64 start;
+    double elapsed;
+    int ret = -1;
+
+    if (!BenchWanted("audio", name)) {
+        return 0;
+    }
+
+    src = (Uint8 *)SDL_calloc(1, src_len);
+    dst = (Uint8 *)SDL_malloc(dst_len);
+    stream = SDL_CreateAudioStream(src_spec, dst_spec);
+    if (!src || !dst || !stream) {
+        goto end;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        if (SDL_PutAudioStreamData(stream, src, src_len) < 0) {
+            goto end;
+        }
+        while (SDL_GetAudioStreamData(stream, dst, dst_len) > 0) {
+        }
+        frames += AUDIO_FRAMES;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("audio", name, frames, elapsed, "Mframes/s");
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "audio/%s failed: %s\n", name, SDL_GetError());
+    }
+    SDL_DestroyAudioStream(stream);
+    SDL_free(dst);
+    SDL_free(src);
+    return ret;
+}
+
+static int BenchAudioMix(void)
+{
+    const int len = AUDIO_FRAMES * 2 * (int)sizeof(float);
+    float *src = NULL;
+    float *dst = NULL;
+    Uint64 frames = 0;
+    Uint64 start;
+    double elapsed;
+    int ret = -1;
+    int i;
+
+    if (!BenchWanted("audio", "mix F32 x4")) {
+        return 0;
+    }
+
+    src = (float *)SDL_malloc(len);
+    dst = (float *)SDL_malloc(len);
+    if (!src || !dst) {
+        goto end;
+    }
+    for (i = 0; i < AUDIO_FRAMES * 2; ++i) {
+        src[i] = 0.5f * SDL_sinf((float)i * 0.05f);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        SDL_memset(dst, 0, len);
+        for (i = 0; i < 4; ++i) {
+            if (SDL_MixAudioFormat((Uint8 *)dst, (const Uint8 *)src, SDL_AUDIO_F32, len, SDL_MIX_MAXVOLUME / 2) < 0) {
+                goto end;
+            }
+        }
+        frames += AUDIO_FRAMES;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("audio", "mix F32 x4", frames, elapsed, "Mframes/s");
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "audio/mix failed: %s\n", SDL_GetError());
+    }
+    SDL_free(dst);
+    SDL_free(src);
+    return ret;
+}
+
+static int BenchAudio(void)
+{
+    SDL_AudioSpec src_spec, dst_spec;
+
+    /* testaudiobench covers every format, layout and rate, these are the common cases */
+    src_spec.format = SDL_AUDIO_S16;
+    src_spec.channels = 2;
+    src_spec.freq = 48000;
+    dst_spec = src_spec;
+    dst_spec.format = SDL_AUDIO_F32;
+    if (BenchAudioStream("convert S16->F32", &src_spec, &dst_spec) < 0) {
+        return -1;
+    }
+
+    src_spec.format = SDL_AUDIO_F32;
+    src_spec.freq = 44100;
+    dst_spec.freq = 48000;
+    if (BenchAudioStream("resample 44100->48000", &src_spec, &dst_spec) < 0) {
+        return -1;
+    }
+
+    return BenchAudioMix();
+}
+
+static int BenchProperties(void)
+{
+    char keys[BENCH_PROPS][16];
+    SDL_PropertiesID props;
+    Uint64 ops;
+    Uint64 start;
+    double elapsed;
+    Sint64 sum = 0;
+    int i;
+
+    for (i = 0; i < BENCH_PROPS; ++i) {
+        SDL_snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+    }
+
+    props = SDL_CreateProperties();
+    if (!props) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "properties failed: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    if (BenchWanted("properties", "set number")) {
+        ops = 0;
+        start = SDL_GetPerformanceCounter();
+        do {
+            for (i = 0; i < BENCH_PROPS; ++i) {
+                SDL_SetNumberProperty(props, keys[i], i);
+            }
+            ops += BENCH_PROPS;
+            elapsed = ElapsedSeconds(start);
+        } while (elapsed < bench_seconds);
+        Report("properties", "set number", ops, elapsed, "Mops/s");
+    } else {
+        for (i = 0; i < BENCH_PROPS; ++i) {
+            SDL_SetNumberProperty(props, keys[i], i);
+        }
+    }
+
+    if (BenchWanted("properties", "get number")) {
+        ops = 0;
+        start = SDL_GetPerformanceCounter();
+        do {
+            for (i = 0; i < BENCH_PROPS; ++i) {
+                sum += SDL_GetNumberProperty(props, keys[i], 0);
+            }
+            ops += BENCH_PROPS;
+            elapsed = ElapsedSeconds(start);
+        } while (elapsed < bench_seconds);
+        Report("properties", "get number", ops, elapsed, "Mops/s");
+    }
+
+    if (BenchWanted("properties", "create+destroy")) {
+        ops = 0;
+        start = SDL_GetPerformanceCounter();
+        do {
+            SDL_PropertiesID temp = SDL_CreateProperties();
+            for (i = 0; i < 16; ++i) {
+                SDL_SetNumberProperty(temp, keys[i], i);
+            }
+            SDL_DestroyProperties(temp);
+            ++ops;
+            elapsed = ElapsedSeconds(start);
+        } while (elapsed < bench_seconds);
+        Report("properties", "create+destroy", ops, elapsed, "Mops/s");
+    }
+
+    SDL_DestroyProperties(props);
+    (void)sum;
+    return 0;
+}
+
+static int WriteJSON(const char *file)
+{
+    SDL_RWops *rw = SDL_RWFromFile(file, "w");
+    int i;
+
+    if (!rw) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s\n", file, SDL_GetError());
+        return -1;
+    }
+
+    SDL_RWprintf(rw, "{\n  \"revision\": \"%s\",\n  \"platform\": \"%s\",\n  \"cpus\": %d,\n  \"seconds_per_case\": %g,\n  \"results\": [",
+                 SDL_GetRevision(), SDL_GetPlatform(), SDL_GetCPUCount(), bench_seconds);
+    for (i = 0; i < num_results; ++i) {
+        SDL_RWprintf(rw, "%s\n    { \"category\": \"%s\", \"name\": \"%s\", \"value\": %.4f, \"unit\": \"%s\" }",
+                     (i > 0) ? "," : "", results[i].category, results[i].name, results[i].value, results[i].unit);
+    }
+    SDL_RWprintf(rw, "\n  ]\n}\n");
+    SDL_RWclose(rw);
+    return 0;
+}
+
+static void log_usage(char *progname, SDLTest_CommonState *state) {
+    static const char *options[] = { "[--seconds N]", "[--filter substring]", "[--json file]", "[--cpu-mask mask]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int ret = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && argv[i + 1]) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0) {
+                bench_seconds = SDL_atof(argv[i + 1]);
+                consumed = (bench_seconds > 0.0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--filter") == 0) {
+                bench_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--json") == 0) {
+                bench_json = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--cpu-mask") == 0) {
+                /* This has to happen before anything queries the CPU features. */
+                SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            SDLTest_CommonDestroyState(state);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_Log("SDL revision %s, %s, %d CPUs, %g seconds per case\n",
+            SDL_GetRevision(), SDL_GetPlatform(), SDL_GetCPUCount(), bench_seconds);
+
+    if (BenchBlit() < 0 || BenchConvert() < 0 || BenchYUV() < 0 || BenchRender() < 0 ||
+        BenchEvents() < 0 || BenchAudio() < 0 || BenchProperties() < 0) {
+        ret = 2;
+    }
+
+    if (bench_json && WriteJSON(bench_json) < 0) {
+        ret = 2;
+    }
+
+    SDL_free(results);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -695,6 +695,176 @@ static void RunFIFOTest(SDL_bool lock_free)
 /* End FIFO test */
 /**************************************************************************/
 
+/**************************************************************************/
+/* Lock-free queue test */
+
+#define QUEUE_THREADS          4
+#define QUEUE_ITEMS_PER_THREAD 25000
+
+typedef struct
+{
+    SDL_SPSCQueue *spsc;
+    SDL_MPMCQueue *mpmc;
+    SDL_AtomicInt writers_done;
+} QueueTest;
+
+typedef struct
+{
+    QueueTest *test;
+    int index;
+    int counts[QUEUE_THREADS];
+    SDL_bool in_order;
+} QueueThreadData;
+
+static int SDLCALL SPSC_Writer(void *_data)
+{
+    QueueThreadData *data = (QueueThreadData *)_data;
+    int i;
+
+    for (i = 0; i < QUEUE_THREADS * QUEUE_ITEMS_PER_THREAD; ++i) {
+        while (!SDL_EnqueueSPSC(data->test->spsc, &i)) {
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+static int SDLCALL MPMC_Writer(void *_data)
+{
+    QueueThreadData *data = (QueueThreadData *)_data;
+    int i;
+
+    for (i = 0; i < QUEUE_ITEMS_PER_THREAD; ++i) {
+        const int item = (data->index << 24) | i;
+        while (!SDL_EnqueueMPMC(data->test->mpmc, &item)) {
+            SDL_Delay(0);
+        }
+    }
+    SDL_AtomicIncRef(&data->test->writers_done);
+    return 0;
+}
+
+static int SDLCALL MPMC_Reader(void *_data)
+{
+    QueueThreadData *data = (QueueThreadData *)_data;
+    int last[QUEUE_THREADS];
+    int i, item;
+
+    for (i = 0; i < QUEUE_THREADS; ++i) {
+        last[i] = -1;
+    }
+    data->in_order = SDL_TRUE;
+
+    for (;;) {
+        /* Check this first, so an empty queue afterwards means we're done */
+        const SDL_bool writers_done = (SDL_AtomicGet(&data->test->writers_done) == QUEUE_THREADS);
+
+        if (SDL_DequeueMPMC(data->test->mpmc, &item)) {
+            const int writer = item >> 24;
+            const int sequence = item & 0xFFFFFF;
+
+            /* Items from each writer must come out in the order they went in */
+            if (sequence <= last[writer]) {
+                data->in_order = SDL_FALSE;
+            }
+            last[writer] = sequence;
+            ++data->counts[writer];
+        } else if (writers_done) {
+            break;
+        } else {
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+static SDL_bool RunQueueTest(void)
+{
+    QueueTest test;
+    QueueThreadData writers[QUEUE_THREADS], readers[QUEUE_THREADS];
+    SDL_Thread *threads[QUEUE_THREADS * 2];
+    SDL_bool passed = SDL_TRUE;
+    int i, j, item, expected;
+
+    SDL_Log("\nLock-free queue test---------------------------\n\n");
+
+    SDL_zero(test);
+    test.spsc = SDL_CreateSPSCQueue(100, sizeof(int));
+    test.mpmc = SDL_CreateMPMCQueue(100, sizeof(int));
+    if (!test.spsc || !test.mpmc) {
+        SDL_Log("Couldn't create queues: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    /* The capacity is rounded up to a power of two */
+    for (i = 0; SDL_EnqueueSPSC(test.spsc, &i); ++i) {
+    }
+    SDL_Log("SPSC queue capacity: %d, expected 128\n", i);
+    passed = passed && (i == 128);
+    for (i = 0; SDL_EnqueueMPMC(test.mpmc, &i); ++i) {
+    }
+    SDL_Log("MPMC queue capacity: %d, expected 128\n", i);
+    passed = passed && (i == 128);
+    for (i = 0; SDL_DequeueSPSC(test.spsc, &item); ++i) {
+        passed = passed && (item == i);
+    }
+    for (i = 0; SDL_DequeueMPMC(test.mpmc, &item); ++i) {
+        passed = passed && (item == i);
+    }
+
+    /* One writer and the main thread as the reader */
+    SDL_zeroa(writers);
+    writers[0].test = &test;
+    threads[0] = SDL_CreateThread(SPSC_Writer, "SPSCWriter", &writers[0]);
+    for (expected = 0; expected < QUEUE_THREADS * QUEUE_ITEMS_PER_THREAD;) {
+        if (SDL_DequeueSPSC(test.spsc, &item)) {
+            if (item != expected) {
+                passed = SDL_FALSE;
+            }
+            ++expected;
+        } else {
+            SDL_Delay(0);
+        }
+    }
+    SDL_WaitThread(threads[0], NULL);
+    SDL_Log("SPSC queue passed %d items %s\n", expected, passed ? "in order" : "out of order");
+
+    /* Several writers and readers */
+    SDL_zeroa(readers);
+    for (i = 0; i < QUEUE_THREADS; ++i) {
+        writers[i].test = &test;
+        writers[i].index = i;
+        readers[i].test = &test;
+        readers[i].index = i;
+        threads[i] = SDL_CreateThread(MPMC_Reader, "MPMCReader", &readers[i]);
+        threads[QUEUE_THREADS + i] = SDL_CreateThread(MPMC_Writer, "MPMCWriter", &writers[i]);
+    }
+    for (i = 0; i < QUEUE_THREADS * 2; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    for (i = 0; i < QUEUE_THREADS; ++i) {
+        int total = 0;
+        for (j = 0; j < QUEUE_THREADS; ++j) {
+            total += readers[j].counts[i];
+        }
+        SDL_Log("MPMC writer %d had %d of %d items read\n", i, total, QUEUE_ITEMS_PER_THREAD);
+        passed = passed && (total == QUEUE_ITEMS_PER_THREAD);
+        if (!readers[i].in_order) {
+            SDL_Log("MPMC reader %d saw items out of order\n", i);
+            passed = SDL_FALSE;
+        }
+    }
+
+    SDL_DestroySPSCQueue(test.spsc);
+    SDL_DestroyMPMCQueue(test.mpmc);
+
+    SDL_Log("Lock-free queue test %s\n", passed ? "passed" : "FAILED");
+    return passed;
+}
+
+/* End lock-free queue test */
+/**************************************************************************/
+
 int main(int argc, char *argv[])
 {
     SDLTest_CommonState *state;
@@ -715,6 +885,11 @@ int main(int argc, char *argv[])
 
     RunBasicTest();
 
+    if (!RunQueueTest()) {
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
     if (SDL_getenv("SDL_TESTS_QUICK") != NULL) {
         SDL_Log("Not running slower tests");
         return 0;
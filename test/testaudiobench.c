@@ -0,0 +1,411 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Throughput benchmark for the audio conversion, resampling and mixing code.
+
+   Every case is run for a fixed amount of time and reported in millions of
+   frames per second. Run it once normally and once with --cpu-mask -all (or
+   any other SDL_HINT_CPU_FEATURE_MASK value) to compare the SIMD paths
+   against the scalar fallbacks. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define BENCH_FRAMES 4096
+
+static double bench_seconds = 0.25;
+static const char *bench_filter = NULL;
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { SDL_AUDIO_U8, "U8" },
+    { SDL_AUDIO_S8, "S8" },
+    { SDL_AUDIO_S16LE, "S16LE" },
+    { SDL_AUDIO_S16BE, "S16BE" },
+    { SDL_AUDIO_S32LE, "S32LE" },
+    { SDL_AUDIO_S32BE, "S32BE" },
+    { SDL_AUDIO_F32LE, "F32LE" },
+    { SDL_AUDIO_F32BE, "F32BE" }
+};
+
+static const int resample_rates[][2] = {
+    { 44100, 48000 },
+    { 48000, 44100 },
+    { 22050, 48000 },
+    { 8000, 48000 },
+    { 96000, 48000 },
+    { 48000, 16000 }
+};
+
+static const int mix_stream_counts[] = { 1, 2, 4, 8, 16 };
+
+static const char *FormatName(SDL_AudioFormat format)
+{
+    int i;
+    for (i = 0; i < (int)SDL_arraysize(formats); ++i) {
+        if (formats[i].format == format) {
+            return formats[i].name;
+        }
+    }
+    return "?";
+}
+
+static SDL_bool BenchWanted(const char *category, const char *name)
+{
+    if (bench_filter) {
+        char full[128];
+        SDL_snprintf(full, sizeof(full), "%s/%s", category, name);
+        return SDL_strstr(full, bench_filter) ? SDL_TRUE : SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static double ElapsedSeconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void Report(const char *category, const char *name, Uint64 frames, double seconds)
+{
+    SDL_Log("%-10s %-32s %10.2f Mframes/s\n", category, name, (seconds > 0.0) ? ((double)frames / seconds / 1000000.0) : 0.0);
+}
+
+/* Generates BENCH_FRAMES frames of a sine wave in the requested format, so float inputs stay in range. */
+static Uint8 *CreateTestSignal(const SDL_AudioSpec *spec, int *len)
+{
+    const int num_samples = BENCH_FRAMES * spec->channels;
+    float *samples = (float *)SDL_malloc(num_samples * sizeof(float));
+    SDL_AudioSpec float_spec;
+    Uint8 *data = NULL;
+    int i;
+
+    float_spec.format = SDL_AUDIO_F32;
+    float_spec.channels = spec->channels;
+    float_spec.freq = spec->freq;
+    if (!samples) {
+        return NULL;
+    }
+    for (i = 0; i < num_samples; ++i) {
+        samples[i] = 0.5f * SDL_sinf((float)(i / spec->channels) * 0.05f + (float)(i % spec->channels));
+    }
+    if (SDL_ConvertAudioSamples(&float_spec, (const Uint8 *)samples, num_samples * (int)sizeof(float), spec, &data, len) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ConvertAudioSamples() failed: %s\n", SDL_GetError());
+        data = NULL;
+    }
+    SDL_free(samples);
+    return data;
+}
+
+static int BenchStream(const char *category, const char *name, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
+{
+    SDL_AudioStream *stream = NULL;
+    Uint8 *src = NULL;
+    Uint8 *dst = NULL;
+    int src_len = 0;
+    int dst_len;
+    Uint64 frames = 0;
+    Uint64 start;
+    double elapsed;
+    int ret = -1;
+
+    if (!BenchWanted(category, name)) {
+        return 0;
+    }
+
+    src = CreateTestSignal(src_spec, &src_len);
+    dst_len = (int)(((Sint64)BENCH_FRAMES * dst_spec->freq / src_spec->freq) + 256) * SDL_AUDIO_FRAMESIZE(*dst_spec);
+    dst = (Uint8 *)SDL_malloc(dst_len);
+    stream = SDL_CreateAudioStream(src_spec, dst_spec);
+    if (!src || !dst || !stream) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s/%s: setup failed: %s\n", category, name, SDL_GetError());
+        goto end;
+    }
+
+    /* One untimed pass to allocate the stream's internal buffers. */
+    if (SDL_PutAudioStreamData(stream, src, src_len) < 0) {
+        goto end;
+    }
+    while (SDL_GetAudioStreamData(stream, dst, dst_len) > 0) {
+    }
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        if (SDL_PutAudioStreamData(stream, src, src_len) < 0) {
+            goto end;
+        }
+        while (SDL_GetAudioStreamData(stream, dst, dst_len) > 0) {
+        }
+        frames += BENCH_FRAMES;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report(category, name, frames, elapsed);
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s/%s failed: %s\n", category, name, SDL_GetError());
+    }
+    SDL_DestroyAudioStream(stream);
+    SDL_free(dst);
+    SDL_free(src);
+    return ret;
+}
+
+static int BenchFormats(void)
+{
+    int i, j;
+    for (i = 0; i < (int)SDL_arraysize(formats); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(formats); ++j) {
+            SDL_AudioSpec src_spec, dst_spec;
+            char name[64];
+            if (i == j) {
+                continue;
+            }
+            src_spec.format = formats[i].format;
+            src_spec.channels = 2;
+            src_spec.freq = 48000;
+            dst_spec = src_spec;
+            dst_spec.format = formats[j].format;
+            SDL_snprintf(name, sizeof(name), "%s->%s", formats[i].name, formats[j].name);
+            if (BenchStream("format", name, &src_spec, &dst_spec) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int BenchChannels(void)
+{
+    int i, j;
+    for (i = 1; i <= 8; ++i) {
+        for (j = 1; j <= 8; ++j) {
+            SDL_AudioSpec src_spec, dst_spec;
+            char name[64];
+            if (i == j) {
+                continue;
+            }
+            src_spec.format = SDL_AUDIO_F32;
+            src_spec.channels = i;
+            src_spec.freq = 48000;
+            dst_spec = src_spec;
+            dst_spec.channels = j;
+            SDL_snprintf(name, sizeof(name), "%d->%d", i, j);
+            if (BenchStream("channels", name, &src_spec, &dst_spec) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int BenchResampler(void)
+{
+    static const int channels[] = { 1, 2, 6 };
+    int i, j;
+    for (i = 0; i < (int)SDL_arraysize(resample_rates); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(channels); ++j) {
+            SDL_AudioSpec src_spec, dst_spec;
+            char name[64];
+            src_spec.format = SDL_AUDIO_F32;
+            src_spec.channels = channels[j];
+            src_spec.freq = resample_rates[i][0];
+            dst_spec = src_spec;
+            dst_spec.freq = resample_rates[i][1];
+            SDL_snprintf(name, sizeof(name), "%d->%d %dch", resample_rates[i][0], resample_rates[i][1], channels[j]);
+            if (BenchStream("resample", name, &src_spec, &dst_spec) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int BenchMixFormat(SDL_AudioFormat format, int num_streams)
+{
+    SDL_AudioSpec spec;
+    Uint8 *src = NULL;
+    Uint8 *dst = NULL;
+    int len = 0;
+    Uint64 frames = 0;
+    Uint64 start;
+    double elapsed;
+    char name[64];
+    int ret = -1;
+    int i;
+
+    SDL_snprintf(name, sizeof(name), "%s x%d", FormatName(format), num_streams);
+    if (!BenchWanted("mix", name)) {
+        return 0;
+    }
+
+    spec.format = format;
+    spec.channels = 2;
+    spec.freq = 48000;
+
+    src = CreateTestSignal(&spec, &len);
+    dst = (Uint8 *)SDL_malloc(len);
+    if (!src || !dst) {
+        goto end;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        SDL_memset(dst, SDL_GetSilenceValueForFormat(format), len);
+        for (i = 0; i < num_streams; ++i) {
+            if (SDL_MixAudioFormat(dst, src, format, len, SDL_MIX_MAXVOLUME / 2) < 0) {
+                goto end;
+            }
+        }
+        frames += BENCH_FRAMES;
+        elapsed = ElapsedSeconds(start);
+    } while (elapsed < bench_seconds);
+
+    Report("mix", name, frames, elapsed);
+    ret = 0;
+
+end:
+    if (ret < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "mix/%s failed: %s\n", name, SDL_GetError());
+    }
+    SDL_free(dst);
+    SDL_free(src);
+    return ret;
+}
+
+static int BenchMixer(void)
+{
+    static const SDL_AudioFormat mix_formats[] = { SDL_AUDIO_S16LE, SDL_AUDIO_S32LE, SDL_AUDIO_F32LE };
+    int i, j;
+    for (i = 0; i < (int)SDL_arraysize(mix_formats); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(mix_stream_counts); ++j) {
+            if (BenchMixFormat(mix_formats[i], mix_stream_counts[j]) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void LogCPUFeatures(void)
+{
+    char features[256];
+
+    features[0] = '\0';
+    if (SDL_HasAltiVec()) {
+        SDL_strlcat(features, " AltiVec", sizeof(features));
+    }
+    if (SDL_HasMMX()) {
+        SDL_strlcat(features, " MMX", sizeof(features));
+    }
+    if (SDL_HasSSE()) {
+        SDL_strlcat(features, " SSE", sizeof(features));
+    }
+    if (SDL_HasSSE2()) {
+        SDL_strlcat(features, " SSE2", sizeof(features));
+    }
+    if (SDL_HasSSE3()) {
+        SDL_strlcat(features, " SSE3", sizeof(features));
+    }
+    if (SDL_HasSSE41()) {
+        SDL_strlcat(features, " SSE4.1", sizeof(features));
+    }
+    if (SDL_HasSSE42()) {
+        SDL_strlcat(features, " SSE4.2", sizeof(features));
+    }
+    if (SDL_HasAVX()) {
+        SDL_strlcat(features, " AVX", sizeof(features));
+    }
+    if (SDL_HasAVX2()) {
+        SDL_strlcat(features, " AVX2", sizeof(features));
+    }
+    if (SDL_HasAVX512F()) {
+        SDL_strlcat(features, " AVX-512F", sizeof(features));
+    }
+    if (SDL_HasARMSIMD()) {
+        SDL_strlcat(features, " ARMSIMD", sizeof(features));
+    }
+    if (SDL_HasNEON()) {
+        SDL_strlcat(features, " NEON", sizeof(features));
+    }
+    if (SDL_HasLSX()) {
+        SDL_strlcat(features, " LSX", sizeof(features));
+    }
+    if (SDL_HasLASX()) {
+        SDL_strlcat(features, " LASX", sizeof(features));
+    }
+    SDL_Log("CPU features:%s\n", features[0] ? features : " (none)");
+    SDL_Log("Seconds per case: %g\n", bench_seconds);
+}
+
+static void log_usage(char *progname, SDLTest_CommonState *state) {
+    static const char *options[] = { "[--seconds N]", "[--filter substring]", "[--cpu-mask mask]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int ret = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && argv[i + 1]) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0) {
+                bench_seconds = SDL_atof(argv[i + 1]);
+                consumed = (bench_seconds > 0.0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--filter") == 0) {
+                bench_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--cpu-mask") == 0) {
+                /* This has to happen before anything queries the CPU features. */
+                SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            SDLTest_CommonDestroyState(state);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    LogCPUFeatures();
+
+    if (BenchFormats() < 0 || BenchChannels() < 0 || BenchResampler() < 0 || BenchMixer() < 0) {
+        ret = 2;
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -26,6 +26,7 @@ static SDLTest_TestSuiteReference *testSuites[] = {
     &clipboardTestSuite,
     &eventsTestSuite,
     &guidTestSuite,
+    &hashtableTestSuite,
     &hintsTestSuite,
     &intrinsicsTestSuite,
     &joystickTestSuite,
@@ -43,6 +44,7 @@ static SDLTest_TestSuiteReference *testSuites[] = {
     &sdltestTestSuite,
     &stdlibTestSuite,
     &surfaceTestSuite,
+    &threadTestSuite,
     &timerTestSuite,
     &videoTestSuite,
     &subsystemsTestSuite, /* run last, not interfere with other test enviroment */
@@ -67,6 +69,8 @@ int main(int argc, char *argv[])
     Uint64 userExecKey = 0;
     char *userRunSeed = NULL;
     char *filter = NULL;
+    int shardIndex = 0;
+    int shardCount = 1;
     int i, done;
     SDL_Event event;
     int list = 0;
@@ -110,13 +114,19 @@ int main(int argc, char *argv[])
                     filter = SDL_strdup(argv[i + 1]);
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--shard") == 0) {
+                if (argv[i + 1] &&
+                    SDL_sscanf(argv[i + 1], "%d/%d", &shardIndex, &shardCount) == 2 &&
+                    shardCount >= 1 && shardIndex >= 0 && shardIndex < shardCount) {
+                    consumed = 2;
+                }
             } else if (SDL_strcasecmp(argv[i], "--list") == 0) {
                 consumed = 1;
                 list = 1;
             }
         }
         if (consumed < 0) {
-            static const char *options[] = { "[--iterations #]", "[--execKey #]", "[--seed string]", "[--filter suite_name|test_name]", "[--list]", NULL };
+            static const char *options[] = { "[--iterations #]", "[--execKey #]", "[--seed string]", "[--filter suite_name|test_name]", "[--shard index/count]", "[--list]", NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             quit(1);
         }
@@ -152,7 +162,7 @@ int main(int argc, char *argv[])
     }
 
     /* Call Harness */
-    result = SDLTest_RunSuites(testSuites, userRunSeed, userExecKey, filter, testIterations);
+    result = SDLTest_RunSuitesShard(testSuites, userRunSeed, userExecKey, filter, testIterations, shardIndex, shardCount);
 
     /* Empty event queue */
     done = 0;
@@ -1249,6 +1249,1226 @@ cleanup:
 
     return status;
 }
+/**
+ * Check that mixing matches the scalar definition at every sample, including saturation.
+ *
+ * \sa SDL_MixAudioFormat
+ */
+static int audio_mixAudioFormat(void *arg)
+{
+    static const int volumes[] = { SDL_MIX_MAXVOLUME, 100, 1 };
+    Sint16 src16[37], dst16[37], expected16[37];
+    Sint32 src32[37], dst32[37], expected32[37];
+    float srcf[37], dstf[37], expectedf[37];
+    int i, j, mismatches;
+
+    for (j = 0; j < SDL_arraysize(volumes); ++j) {
+        const int volume = volumes[j];
+
+        for (i = 0; i < SDL_arraysize(src16); ++i) {
+            int sum;
+            Sint64 sum64;
+
+            src16[i] = (Sint16)((i * 7919) - 15000 + (i % 3) * 20000);
+            dst16[i] = (Sint16)(SDL_MAX_SINT16 - i * 1777);
+            sum = ((src16[i] * volume) / SDL_MIX_MAXVOLUME) + dst16[i];
+            expected16[i] = (Sint16)SDL_clamp(sum, SDL_MIN_SINT16, SDL_MAX_SINT16);
+
+            src32[i] = (Sint32)((i % 2) ? SDL_MAX_SINT32 - i * 1000 : SDL_MIN_SINT32 + i * 3000000);
+            dst32[i] = (Sint32)((i % 4) < 2 ? i * 50000000 : -i * 50000000);
+            sum64 = (((Sint64)src32[i] * volume) / SDL_MIX_MAXVOLUME) + dst32[i];
+            expected32[i] = (Sint32)SDL_clamp(sum64, SDL_MIN_SINT32, SDL_MAX_SINT32);
+
+            srcf[i] = (float)(i - 18) / 9.0f;
+            dstf[i] = 0.25f;
+            expectedf[i] = (float)((double)((srcf[i] * (float)volume) * (1.0f / SDL_MIX_MAXVOLUME)) + (double)dstf[i]);
+        }
+
+        SDL_MixAudioFormat((Uint8 *)dst16, (const Uint8 *)src16, SDL_AUDIO_S16, sizeof(dst16), volume);
+        SDL_MixAudioFormat((Uint8 *)dst32, (const Uint8 *)src32, SDL_AUDIO_S32, sizeof(dst32), volume);
+        SDL_MixAudioFormat((Uint8 *)dstf, (const Uint8 *)srcf, SDL_AUDIO_F32, sizeof(dstf), volume);
+
+        mismatches = 0;
+        for (i = 0; i < SDL_arraysize(src16); ++i) {
+            mismatches += (dst16[i] != expected16[i]);
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify S16 mixing at volume %d, expected: 0 mismatches, got: %d", volume, mismatches);
+        mismatches = 0;
+        for (i = 0; i < SDL_arraysize(src32); ++i) {
+            mismatches += (dst32[i] != expected32[i]);
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify S32 mixing at volume %d, expected: 0 mismatches, got: %d", volume, mismatches);
+        mismatches = 0;
+        for (i = 0; i < SDL_arraysize(srcf); ++i) {
+            mismatches += (dstf[i] != expectedf[i]);
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify F32 mixing at volume %d, expected: 0 mismatches, got: %d", volume, mismatches);
+    }
+
+    return TEST_COMPLETED;
+}
+static SDL_AtomicInt g_audio_postmixCount;
+static SDL_AtomicInt g_audio_postmixMismatches;
+
+static void SDLCALL audio_mixThreadsPostmix(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    const float expected = *(const float *)userdata;
+    const int num_samples = buflen / (int)sizeof(float);
+    int i, mismatches = 0;
+
+    for (i = 0; i < num_samples; ++i) {
+        mismatches += (buffer[i] != expected);
+    }
+    SDL_AtomicAdd(&g_audio_postmixMismatches, mismatches);
+    SDL_AtomicAdd(&g_audio_postmixCount, 1);
+}
+
+/**
+ * Check that streams bound to a device mix to the same result when spread across mix threads.
+ *
+ * \sa SDL_HINT_AUDIO_DEVICE_MIX_THREADS
+ */
+static int audio_mixThreads(void *arg)
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    SDL_AudioStream *streams[6];
+    float *data;
+    float expected = 0.0f;
+    SDL_AudioDeviceID devid;
+    int i, j, num_samples, result, totalDelay;
+
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_MIX_THREADS, "4");
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDL_ResetHint(SDL_HINT_AUDIO_DEVICE_MIX_THREADS);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, F32 stereo 48000)");
+    SDLTest_AssertCheck(devid != 0, "Verify return value; expected: != 0, got: %" SDL_PRIu32, devid);
+    if (devid == 0) {
+        return TEST_ABORTED;
+    }
+    SDL_PauseAudioDevice(devid);
+
+    /* Feed the streams at the device's own rate, so nothing gets resampled. */
+    result = SDL_GetAudioDeviceFormat(devid, &spec, NULL);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_GetAudioDeviceFormat() result; expected: 0, got: %d", result);
+    spec.format = SDL_AUDIO_F32;
+    num_samples = spec.freq * spec.channels;
+
+    data = (float *)SDL_malloc(num_samples * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Verify sample buffer was allocated");
+    if (data == NULL) {
+        SDL_CloseAudioDevice(devid);
+        return TEST_ABORTED;
+    }
+
+    /* Values with exact float sums, so the result doesn't depend on mixing order. */
+    for (i = 0; i < SDL_arraysize(streams); ++i) {
+        const float value = (float)(i + 1) / 64.0f;
+        for (j = 0; j < num_samples; ++j) {
+            data[j] = value;
+        }
+        expected += value;
+        streams[i] = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Verify stream %d was created", i);
+        result = SDL_PutAudioStreamData(streams[i], data, num_samples * (int)sizeof(float));
+        SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioStreamData() result; expected: 0, got: %d", result);
+    }
+    SDL_free(data);
+
+    SDL_AtomicSet(&g_audio_postmixCount, 0);
+    SDL_AtomicSet(&g_audio_postmixMismatches, 0);
+    result = SDL_SetAudioPostmixCallback(devid, audio_mixThreadsPostmix, &expected);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioPostmixCallback() result; expected: 0, got: %d", result);
+    result = SDL_BindAudioStreams(devid, streams, SDL_arraysize(streams));
+    SDLTest_AssertCheck(result == 0, "Verify SDL_BindAudioStreams() result; expected: 0, got: %d", result);
+    SDL_ResumeAudioDevice(devid);
+
+    totalDelay = 0;
+    while (SDL_AtomicGet(&g_audio_postmixCount) < 4 && totalDelay < 2000) {
+        SDL_Delay(10);
+        totalDelay += 10;
+    }
+
+    SDL_CloseAudioDevice(devid);
+    for (i = 0; i < SDL_arraysize(streams); ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_audio_postmixCount) >= 4, "Verify postmix callback ran; expected: >= 4, got: %d", SDL_AtomicGet(&g_audio_postmixCount));
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_audio_postmixMismatches) == 0, "Verify mixed samples; expected: 0 mismatches, got: %d", SDL_AtomicGet(&g_audio_postmixMismatches));
+
+    return TEST_COMPLETED;
+}
+#define LOCK_FREE_TEST_FRAMES (64 * 1024)
+
+static int SDLCALL audio_lockFreeProducer(void *data)
+{
+    SDL_AudioStream *stream = (SDL_AudioStream *)data;
+    Sint16 buf[333];
+    int i, total = 0;
+
+    while (total < LOCK_FREE_TEST_FRAMES) {
+        const int frames = SDL_min((int)SDL_arraysize(buf), LOCK_FREE_TEST_FRAMES - total);
+        for (i = 0; i < frames; ++i) {
+            buf[i] = (Sint16)(total + i);
+        }
+        if (SDL_PutAudioStreamData(stream, buf, frames * (int)sizeof(Sint16)) != 0) {
+            return -1;
+        }
+        total += frames;
+    }
+    return 0;
+}
+
+/**
+ * Check that data put into a lock-free stream from another thread arrives intact and in order.
+ *
+ * \sa SDL_SetAudioStreamLockFree
+ */
+static int audio_lockFreeStream(void *arg)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_S16, 1, 48000 };
+    SDL_AudioStream *stream;
+    SDL_Thread *thread;
+    Sint16 sample, buf[1000];
+    int i, result, status, total, mismatches;
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Data put before, during and after lock-free mode must come out in order. */
+    sample = 1;
+    SDL_PutAudioStreamData(stream, &sample, sizeof(sample));
+    result = SDL_SetAudioStreamLockFree(stream, SDL_TRUE);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamLockFree(SDL_TRUE) result; expected: 0, got: %d", result);
+    sample = 2;
+    SDL_PutAudioStreamData(stream, &sample, sizeof(sample));
+    sample = 3;
+    SDL_PutAudioStreamData(stream, &sample, sizeof(sample));
+    result = SDL_GetAudioStreamQueued(stream);
+    SDLTest_AssertCheck(result == 3 * (int)sizeof(Sint16), "Verify queued bytes; expected: %d, got: %d", 3 * (int)sizeof(Sint16), result);
+    result = SDL_SetAudioStreamLockFree(stream, SDL_FALSE);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamLockFree(SDL_FALSE) result; expected: 0, got: %d", result);
+    sample = 4;
+    SDL_PutAudioStreamData(stream, &sample, sizeof(sample));
+    result = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(result == 4 * (int)sizeof(Sint16), "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", 4 * (int)sizeof(Sint16), result);
+    SDLTest_AssertCheck(buf[0] == 1 && buf[1] == 2 && buf[2] == 3 && buf[3] == 4,
+                        "Verify order of samples; expected: 1 2 3 4, got: %d %d %d %d", buf[0], buf[1], buf[2], buf[3]);
+
+    /* Now feed it from another thread while reading here. */
+    SDL_SetAudioStreamLockFree(stream, SDL_TRUE);
+    thread = SDL_CreateThread(audio_lockFreeProducer, "AudioLockFreeProducer", stream);
+    SDLTest_AssertCheck(thread != NULL, "Verify producer thread was created");
+    if (thread == NULL) {
+        SDL_DestroyAudioStream(stream);
+        return TEST_ABORTED;
+    }
+
+    total = 0;
+    mismatches = 0;
+    while (total < LOCK_FREE_TEST_FRAMES) {
+        result = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+        if (result < 0) {
+            break;
+        }
+        for (i = 0; i < result / (int)sizeof(Sint16); ++i) {
+            mismatches += (buf[i] != (Sint16)(total + i));
+        }
+        total += result / (int)sizeof(Sint16);
+    }
+    SDL_WaitThread(thread, &status);
+
+    SDLTest_AssertCheck(status == 0, "Verify producer result; expected: 0, got: %d", status);
+    SDLTest_AssertCheck(total == LOCK_FREE_TEST_FRAMES, "Verify frames read; expected: %d, got: %d", LOCK_FREE_TEST_FRAMES, total);
+    SDLTest_AssertCheck(mismatches == 0, "Verify samples; expected: 0 mismatches, got: %d", mismatches);
+
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+/**
+ * Check that stream gain, pan and fades are applied to converted data.
+ *
+ * \sa SDL_SetAudioStreamGain
+ * \sa SDL_SetAudioStreamPan
+ * \sa SDL_FadeAudioStreamGain
+ */
+static int audio_streamGain(void *arg)
+{
+    const SDL_AudioSpec f32_spec = { SDL_AUDIO_F32, 2, 48000 };
+    const SDL_AudioSpec s16_spec = { SDL_AUDIO_S16, 2, 48000 };
+    const SDL_AudioSpec resampled_spec = { SDL_AUDIO_F32, 2, 44100 };
+    SDL_AudioStream *stream;
+    float input[200], output[400];
+    Sint16 input16[200], output16[200];
+    int i, result, mismatches;
+
+    for (i = 0; i < SDL_arraysize(input); ++i) {
+        input[i] = 0.5f;
+        input16[i] = 16000;
+    }
+
+    /* Float in, float out: applied in place. */
+    stream = SDL_CreateAudioStream(&f32_spec, &f32_spec);
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_GetAudioStreamGain(stream) == 1.0f, "Verify default gain; expected: 1.0, got: %f", SDL_GetAudioStreamGain(stream));
+    result = SDL_SetAudioStreamGain(stream, -1.0f);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetAudioStreamGain(-1.0) result; expected: -1, got: %d", result);
+    result = SDL_SetAudioStreamPan(stream, 2.0f);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetAudioStreamPan(2.0) result; expected: -1, got: %d", result);
+
+    SDL_SetAudioStreamGain(stream, 0.5f);
+    SDL_SetAudioStreamPan(stream, 0.5f);
+    SDL_PutAudioStreamData(stream, input, sizeof(input));
+    result = SDL_GetAudioStreamData(stream, output, sizeof(input));
+    SDLTest_AssertCheck(result == sizeof(input), "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", (int)sizeof(input), result);
+    mismatches = 0;
+    for (i = 0; i < SDL_arraysize(input); i += 2) {
+        mismatches += (output[i] != 0.125f) || (output[i + 1] != 0.25f);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify gain and pan on F32 data; expected: 0 mismatches, got: %d", mismatches);
+
+    /* Fade from 1.0 to 0.0 over 50 frames, then hold at silence. */
+    SDL_SetAudioStreamPan(stream, 0.0f);
+    SDL_SetAudioStreamGain(stream, 1.0f);
+    result = SDL_FadeAudioStreamGain(stream, 0.0f, 50);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_FadeAudioStreamGain() result; expected: 0, got: %d", result);
+    SDL_PutAudioStreamData(stream, input, sizeof(input));
+    SDL_GetAudioStreamData(stream, output, 30 * 2 * sizeof(float));
+    SDLTest_AssertCheck(SDL_fabsf(SDL_GetAudioStreamGain(stream) - 0.4f) < 0.0001f, "Verify gain partway through fade; expected: 0.4, got: %f", SDL_GetAudioStreamGain(stream));
+    SDL_GetAudioStreamData(stream, &output[60], 70 * 2 * sizeof(float));
+    mismatches = 0;
+    for (i = 0; i < 100; ++i) {
+        const float expected = (i < 50) ? 0.5f * (1.0f - (float)i / 50.0f) : 0.0f;
+        mismatches += (SDL_fabsf(output[i * 2] - expected) > 0.0001f) || (output[i * 2] != output[i * 2 + 1]);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify faded samples; expected: 0 mismatches, got: %d", mismatches);
+    SDLTest_AssertCheck(SDL_GetAudioStreamGain(stream) == 0.0f, "Verify gain after fade; expected: 0.0, got: %f", SDL_GetAudioStreamGain(stream));
+    SDL_DestroyAudioStream(stream);
+
+    /* Integer in, integer out: goes through float32 to apply the gain. */
+    stream = SDL_CreateAudioStream(&s16_spec, &s16_spec);
+    SDL_SetAudioStreamGain(stream, 0.25f);
+    SDL_PutAudioStreamData(stream, input16, sizeof(input16));
+    result = SDL_GetAudioStreamData(stream, output16, sizeof(output16));
+    SDLTest_AssertCheck(result == sizeof(output16), "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", (int)sizeof(output16), result);
+    mismatches = 0;
+    for (i = 0; i < SDL_arraysize(output16); ++i) {
+        mismatches += (SDL_abs(output16[i] - 4000) > 1);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify gain on S16 data; expected: 0 mismatches, got: %d", mismatches);
+    SDL_DestroyAudioStream(stream);
+
+    /* Resampled: applied after resampling. */
+    stream = SDL_CreateAudioStream(&f32_spec, &resampled_spec);
+    SDL_SetAudioStreamGain(stream, 0.5f);
+    for (i = 0; i < 10; ++i) {
+        SDL_PutAudioStreamData(stream, input, sizeof(input));
+    }
+    SDL_FlushAudioStream(stream);
+    result = SDL_GetAudioStreamData(stream, output, sizeof(output));
+    SDLTest_AssertCheck(result == sizeof(output), "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", (int)sizeof(output), result);
+    mismatches = 0;
+    for (i = 100; i < SDL_arraysize(output); ++i) {
+        mismatches += (SDL_fabsf(output[i] - 0.25f) > 0.001f);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify gain on resampled data; expected: 0 mismatches, got: %d", mismatches);
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+/**
+ * Check that each resampling quality produces the right amount of data at a sensible signal-to-noise ratio.
+ *
+ * \sa SDL_SetAudioStreamResampleQuality
+ */
+static int audio_resampleQuality(void *arg)
+{
+    static const struct {
+        SDL_AudioResampleQuality quality;
+        const char *name;
+        double signal_to_noise;
+    } qualities[] = {
+        { SDL_AUDIO_RESAMPLE_QUALITY_LOW, "low", 60 },
+        { SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM, "medium", 80 },
+        { SDL_AUDIO_RESAMPLE_QUALITY_HIGH, "high", 95 }
+    };
+    const int rate_in = 44100, rate_out = 48000, freq = 440, seconds = 2;
+    const SDL_AudioSpec spec_in = { SDL_AUDIO_F32, 1, 44100 };
+    const SDL_AudioSpec spec_out = { SDL_AUDIO_F32, 1, 48000 };
+    const int frames_in = seconds * rate_in;
+    const int frames_out = seconds * rate_out;
+    float *buf_in, *buf_out;
+    SDL_AudioStream *stream;
+    int i, q, result;
+
+    buf_in = (float *)SDL_malloc(frames_in * sizeof(float));
+    buf_out = (float *)SDL_malloc(frames_out * sizeof(float));
+    SDLTest_AssertCheck(buf_in != NULL && buf_out != NULL, "Verify buffers were allocated");
+    if (buf_in == NULL || buf_out == NULL) {
+        SDL_free(buf_in);
+        SDL_free(buf_out);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < frames_in; ++i) {
+        buf_in[i] = (float)sine_wave_sample(i, rate_in, freq, 0);
+    }
+
+    for (q = 0; q < SDL_arraysize(qualities); ++q) {
+        double sum_squared_error = 0, sum_squared_value = 0, signal_to_noise;
+
+        stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+        SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+        if (stream == NULL) {
+            break;
+        }
+        SDLTest_AssertCheck(SDL_GetAudioStreamResampleQuality(stream) == SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM, "Verify default quality is medium");
+        result = SDL_SetAudioStreamResampleQuality(stream, qualities[q].quality);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamResampleQuality(%s) result; expected: 0, got: %d", qualities[q].name, result);
+
+        SDL_PutAudioStreamData(stream, buf_in, frames_in * (int)sizeof(float));
+        SDL_FlushAudioStream(stream);
+        result = SDL_GetAudioStreamData(stream, buf_out, frames_out * (int)sizeof(float));
+        SDLTest_AssertCheck(result == frames_out * (int)sizeof(float), "Verify %s quality output length; expected: %d, got: %d",
+                            qualities[q].name, frames_out * (int)sizeof(float), result);
+        SDL_DestroyAudioStream(stream);
+
+        for (i = 0; i < frames_out; ++i) {
+            const double target = sine_wave_sample(i, rate_out, freq, 0);
+            const double error = target - buf_out[i];
+            sum_squared_error += error * error;
+            sum_squared_value += target * target;
+        }
+        signal_to_noise = 10 * SDL_log10(sum_squared_value / sum_squared_error);
+        SDLTest_AssertCheck(signal_to_noise >= qualities[q].signal_to_noise, "Verify %s quality signal-to-noise ratio %f dB is no less than %f dB",
+                            qualities[q].name, signal_to_noise, qualities[q].signal_to_noise);
+    }
+
+    stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+    result = SDL_SetAudioStreamResampleQuality(stream, (SDL_AudioResampleQuality)42);
+    SDLTest_AssertCheck(result == -1, "Verify invalid quality is rejected; expected: -1, got: %d", result);
+    SDL_DestroyAudioStream(stream);
+
+    SDL_free(buf_in);
+    SDL_free(buf_out);
+
+    return TEST_COMPLETED;
+}
+/**
+ * \brief Check mixing audio stream channels through custom matrices.
+ *
+ * \sa SDL_SetAudioStreamChannelMatrix
+ */
+static int audio_channelMatrix(void *arg)
+{
+    static const struct {
+        int src_channels;
+        int dst_channels;
+    } layouts[] = { { 6, 1 }, { 8, 2 }, { 5, 3 }, { 2, 5 }, { 3, 8 }, { 4, 4 } };
+    static float input[1001 * 8], output[1001 * 8];
+    const int num_frames = 1001; /* not a multiple of any SIMD width, so the leftovers get checked too. */
+    const float swap[] = { 0.0f, 1.0f, 1.0f, 0.0f };
+    const SDL_AudioSpec stereo_spec = { SDL_AUDIO_F32, 2, 48000 };
+    const SDL_AudioSpec s16_spec = { SDL_AUDIO_S16, 2, 24000 };
+    Sint16 input16[200];
+    SDL_AudioStream *stream;
+    float matrix[8 * 8];
+    int i, j, f, o, result, mismatches;
+
+    for (i = 0; i < SDL_arraysize(layouts); ++i) {
+        const int src_channels = layouts[i].src_channels;
+        const int dst_channels = layouts[i].dst_channels;
+        const SDL_AudioSpec src_spec = { SDL_AUDIO_F32, src_channels, 48000 };
+        const SDL_AudioSpec dst_spec = { SDL_AUDIO_F32, dst_channels, 48000 };
+        const int output_bytes = num_frames * dst_channels * (int)sizeof(float);
+        float max_error = 0.0f;
+
+        for (j = 0; j < src_channels * dst_channels; ++j) {
+            matrix[j] = (float)((j * 5) % 7) / 7.0f - 0.25f;
+        }
+        for (j = 0; j < num_frames * src_channels; ++j) {
+            input[j] = (float)((j * 13) % 17) / 17.0f - 0.5f;
+        }
+
+        stream = SDL_CreateAudioStream(&src_spec, &dst_spec);
+        SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+        if (stream == NULL) {
+            return TEST_ABORTED;
+        }
+        result = SDL_SetAudioStreamChannelMatrix(stream, src_channels, dst_channels, matrix);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamChannelMatrix() result; expected: 0, got: %d", result);
+        SDL_PutAudioStreamData(stream, input, num_frames * src_channels * sizeof(float));
+        result = SDL_GetAudioStreamData(stream, output, output_bytes);
+        SDLTest_AssertCheck(result == output_bytes, "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", output_bytes, result);
+
+        for (f = 0; f < num_frames; ++f) {
+            for (o = 0; o < dst_channels; ++o) {
+                float expected = 0.0f;
+                for (j = 0; j < src_channels; ++j) {
+                    expected += input[f * src_channels + j] * matrix[o * src_channels + j];
+                }
+                max_error = SDL_max(max_error, SDL_fabsf(output[f * dst_channels + o] - expected));
+            }
+        }
+        SDLTest_AssertCheck(max_error < 0.00001f, "Verify %d to %d channel mix; expected max error < 0.00001, got: %f", src_channels, dst_channels, max_error);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    /* Swap stereo channels, which needs the matrix even though the channel count doesn't change. */
+    stream = SDL_CreateAudioStream(&stereo_spec, &stereo_spec);
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+    result = SDL_SetAudioStreamChannelMatrix(stream, 9, 2, swap);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetAudioStreamChannelMatrix(9 channels) result; expected: -1, got: %d", result);
+    SDL_SetAudioStreamChannelMatrix(stream, 2, 2, swap);
+    for (f = 0; f < 100; ++f) {
+        input[f * 2] = 0.25f;
+        input[f * 2 + 1] = 0.75f;
+        input16[f * 2] = 8192;
+        input16[f * 2 + 1] = 24576;
+    }
+    SDL_PutAudioStreamData(stream, input, 100 * 2 * sizeof(float));
+    SDL_GetAudioStreamData(stream, output, 100 * 2 * sizeof(float));
+    mismatches = 0;
+    for (f = 0; f < 100; ++f) {
+        mismatches += (output[f * 2] != 0.75f) || (output[f * 2 + 1] != 0.25f);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify swapped F32 channels; expected: 0 mismatches, got: %d", mismatches);
+
+    /* Again with integer input and resampling in the way. */
+    SDL_SetAudioStreamFormat(stream, &s16_spec, NULL);
+    SDL_PutAudioStreamData(stream, input16, sizeof(input16));
+    SDL_FlushAudioStream(stream);
+    result = SDL_GetAudioStreamData(stream, output, 200 * 2 * sizeof(float));
+    SDLTest_AssertCheck(result == 200 * 2 * sizeof(float), "Verify resampled SDL_GetAudioStreamData() result; expected: %d, got: %d", (int)(200 * 2 * sizeof(float)), result);
+    mismatches = 0;
+    for (f = 40; f < 160; ++f) { /* skip the edges, where the resampler fades in and out of silence. */
+        mismatches += (SDL_fabsf(output[f * 2] - 0.75f) > 0.01f) || (SDL_fabsf(output[f * 2 + 1] - 0.25f) > 0.01f);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify swapped resampled channels; expected: 0 mismatches, got: %d", mismatches);
+
+    /* A matrix for other channel counts is ignored, and NULL goes back to the builtin conversion. */
+    SDL_SetAudioStreamFormat(stream, &stereo_spec, NULL);
+    SDL_SetAudioStreamChannelMatrix(stream, 2, 1, swap);
+    SDL_PutAudioStreamData(stream, input, 10 * 2 * sizeof(float));
+    SDL_GetAudioStreamData(stream, output, 10 * 2 * sizeof(float));
+    SDLTest_AssertCheck(output[0] == 0.25f && output[1] == 0.75f, "Verify unmatched matrix is ignored; expected: 0.25 0.75, got: %f %f", output[0], output[1]);
+    SDL_SetAudioStreamChannelMatrix(stream, 2, 2, swap);
+    result = SDL_SetAudioStreamChannelMatrix(stream, 0, 0, NULL);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamChannelMatrix(NULL) result; expected: 0, got: %d", result);
+    SDL_PutAudioStreamData(stream, input, 10 * 2 * sizeof(float));
+    SDL_GetAudioStreamData(stream, output, 10 * 2 * sizeof(float));
+    SDLTest_AssertCheck(output[0] == 0.25f && output[1] == 0.75f, "Verify cleared matrix; expected: 0.25 0.75, got: %f %f", output[0], output[1]);
+
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct NoCopyCallbackData
+{
+    int calls;
+    const void *buf;
+    int buflen;
+} NoCopyCallbackData;
+
+static void SDLCALL audio_noCopyComplete(void *userdata, const void *buf, int buflen)
+{
+    NoCopyCallbackData *data = (NoCopyCallbackData *)userdata;
+    data->calls++;
+    data->buf = buf;
+    data->buflen = buflen;
+}
+
+/**
+ * \brief Check adding caller-owned data to an audio stream without copying it.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+static int audio_putNoCopy(void *arg)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_S16, 2, 48000 };
+    Sint16 copied[64], borrowed[256], output[256 + 64 * 2];
+    NoCopyCallbackData data;
+    SDL_AudioStream *stream;
+    int i, result, mismatches;
+
+    for (i = 0; i < SDL_arraysize(copied); ++i) {
+        copied[i] = (Sint16)(i + 1);
+    }
+    for (i = 0; i < SDL_arraysize(borrowed); ++i) {
+        borrowed[i] = (Sint16)(1000 + i);
+    }
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* The borrowed buffer sits between two copies, and the stream reads it in place. */
+    SDL_zero(data);
+    SDL_PutAudioStreamData(stream, copied, sizeof(copied));
+    result = SDL_PutAudioStreamDataNoCopy(stream, borrowed, sizeof(borrowed), audio_noCopyComplete, &data);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioStreamDataNoCopy() result; expected: 0, got: %d", result);
+    SDL_PutAudioStreamData(stream, copied, sizeof(copied));
+    result = SDL_GetAudioStreamAvailable(stream);
+    SDLTest_AssertCheck(result == (int)sizeof(output), "Verify available data; expected: %d, got: %d", (int)sizeof(output), result);
+    borrowed[0] = -1;  /* not copied, so this change shows up in the output. */
+
+    result = SDL_GetAudioStreamData(stream, output, sizeof(copied) + 100);
+    SDLTest_AssertCheck(data.calls == 0, "Verify callback doesn't fire while data remains; expected: 0 calls, got: %d", data.calls);
+    result += SDL_GetAudioStreamData(stream, (Uint8 *)output + result, sizeof(output) - result);
+    SDLTest_AssertCheck(result == (int)sizeof(output), "Verify SDL_GetAudioStreamData() result; expected: %d, got: %d", (int)sizeof(output), result);
+    mismatches = 0;
+    for (i = 0; i < SDL_arraysize(output); ++i) {
+        const Sint16 expected = (i < 64) ? copied[i] : (i < 64 + 256) ? borrowed[i - 64] : copied[i - 64 - 256];
+        mismatches += (output[i] != expected);
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify output order and contents; expected: 0 mismatches, got: %d", mismatches);
+    SDLTest_AssertCheck(output[64] == -1, "Verify the buffer was read in place; expected: -1, got: %d", output[64]);
+    SDLTest_AssertCheck(data.calls == 1, "Verify callback after reading; expected: 1 call, got: %d", data.calls);
+    SDLTest_AssertCheck(data.buf == borrowed && data.buflen == (int)sizeof(borrowed), "Verify callback arguments; expected: %p %d, got: %p %d", (void *)borrowed, (int)sizeof(borrowed), data.buf, data.buflen);
+
+    /* When the borrowed data is the last thing queued, it's let go as soon as it has been read. */
+    SDL_zero(data);
+    SDL_PutAudioStreamDataNoCopy(stream, borrowed, sizeof(borrowed), audio_noCopyComplete, &data);
+    SDL_GetAudioStreamData(stream, output, sizeof(borrowed));
+    SDLTest_AssertCheck(data.calls == 1, "Verify callback once the last data is read; expected: 1 call, got: %d", data.calls);
+
+    /* Clearing or destroying the stream lets go of unread data. */
+    SDL_zero(data);
+    SDL_PutAudioStreamDataNoCopy(stream, borrowed, sizeof(borrowed), audio_noCopyComplete, &data);
+    SDL_ClearAudioStream(stream);
+    SDLTest_AssertCheck(data.calls == 1, "Verify callback after clearing; expected: 1 call, got: %d", data.calls);
+
+    SDL_zero(data);
+    result = SDL_PutAudioStreamDataNoCopy(stream, borrowed, 3, audio_noCopyComplete, &data);
+    SDLTest_AssertCheck(result == -1, "Verify partial frames are rejected; expected: -1, got: %d", result);
+    SDL_PutAudioStreamDataNoCopy(stream, borrowed, sizeof(borrowed), audio_noCopyComplete, &data);
+    SDL_PutAudioStreamDataNoCopy(stream, borrowed, sizeof(borrowed), NULL, NULL);
+    SDL_DestroyAudioStream(stream);
+    SDLTest_AssertCheck(data.calls == 1, "Verify callback after destroying; expected: 1 call, got: %d", data.calls);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that low-latency mode shrinks the device buffer and is reported through the device properties.
+ *
+ * \sa SDL_HINT_AUDIO_DEVICE_LOW_LATENCY
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int audio_lowLatencyDevice(void *arg)
+{
+    const SDL_bool is_dummy = (SDL_strcmp(SDL_GetCurrentAudioDriver(), "dummy") == 0) ? SDL_TRUE : SDL_FALSE;
+    const char *modes[] = { "1", "exclusive", NULL };
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    SDL_AudioSpec devspec;
+    SDL_PropertiesID props;
+    SDL_AudioDeviceID devid;
+    Sint64 latency;
+    int i, result, frames, normal_frames = 0;
+
+    /* the test harness keeps the default output open, so use a capture device that we get to open fresh. */
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        SDL_SetHint(SDL_HINT_AUDIO_DEVICE_LOW_LATENCY, modes[i]);
+        devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE, &spec);
+        SDL_ResetHint(SDL_HINT_AUDIO_DEVICE_LOW_LATENCY);
+        SDLTest_AssertPass("Call to SDL_OpenAudioDevice() with SDL_HINT_AUDIO_DEVICE_LOW_LATENCY=%s", modes[i] ? modes[i] : "(null)");
+        SDLTest_AssertCheck(devid != 0, "Verify return value; expected: != 0, got: %" SDL_PRIu32, devid);
+        if (devid == 0) {
+            return TEST_ABORTED;
+        }
+
+        frames = 0;
+        result = SDL_GetAudioDeviceFormat(devid, &devspec, &frames);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_GetAudioDeviceFormat() result; expected: 0, got: %d", result);
+
+        props = SDL_GetAudioDeviceProperties(devid);
+        SDLTest_AssertCheck(props != 0, "Verify SDL_GetAudioDeviceProperties() returned properties");
+        latency = SDL_GetNumberProperty(props, "SDL.audio.device.latency_frames", 0);
+        SDLTest_AssertCheck(latency > 0, "Verify reported latency; expected: > 0, got: %" SDL_PRIs64, latency);
+
+        if (modes[i]) {
+            if (is_dummy) {
+                SDLTest_AssertCheck(frames <= 128, "Verify low-latency buffer size; expected: <= 128, got: %d", frames);
+                SDLTest_AssertCheck(SDL_GetBooleanProperty(props, "SDL.audio.device.low_latency", SDL_FALSE), "Verify low latency is reported");
+                SDLTest_AssertCheck(!SDL_GetBooleanProperty(props, "SDL.audio.device.exclusive", SDL_TRUE), "Verify exclusive access is not reported by a backend that can't do it");
+            }
+        } else {
+            normal_frames = frames;
+            SDLTest_AssertCheck(!SDL_GetBooleanProperty(props, "SDL.audio.device.low_latency", SDL_TRUE), "Verify low latency is not reported");
+        }
+
+        SDL_CloseAudioDevice(devid);
+    }
+
+    if (is_dummy) {
+        SDLTest_AssertCheck(normal_frames > 128, "Verify normal buffer size; expected: > 128, got: %d", normal_frames);
+    }
+
+    /* a closed device doesn't claim to be in either mode. */
+    props = SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE);
+    SDLTest_AssertCheck(props != 0, "Verify SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE) returned properties");
+    SDLTest_AssertCheck(!SDL_GetBooleanProperty(props, "SDL.audio.device.low_latency", SDL_TRUE), "Verify closed device doesn't report low latency");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that an audio stream decoding a WAVE file incrementally produces the same data as loading it.
+ *
+ * \sa SDL_CreateAudioStreamFromWAV_RW
+ * \sa SDL_LoadWAV_RW
+ */
+static int audio_streamFromWAV(void *arg)
+{
+    const int num_frames = 10000; /* more than one piece of decoded data. */
+    const int data_len = num_frames * 2 * (int)sizeof(Sint16);
+    const SDL_AudioSpec f32_spec = { SDL_AUDIO_F32, 2, 22050 };
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    Uint8 *wav, *loaded = NULL, *streamed;
+    Uint32 loaded_len = 0;
+    Uint8 buf[1000];
+    int i, result, total;
+
+    wav = (Uint8 *)SDL_calloc(1, 44 + data_len);
+    streamed = (Uint8 *)SDL_malloc(data_len);
+    SDLTest_AssertCheck(wav != NULL && streamed != NULL, "Verify buffers were allocated");
+    if (!wav || !streamed) {
+        SDL_free(wav);
+        SDL_free(streamed);
+        return TEST_ABORTED;
+    }
+
+    /* a 16-bit stereo PCM file at 22050Hz. */
+    SDL_memcpy(wav, "RIFF", 4);
+    *(Uint32 *)(wav + 4) = SDL_SwapLE32(36 + data_len);
+    SDL_memcpy(wav + 8, "WAVEfmt ", 8);
+    *(Uint32 *)(wav + 16) = SDL_SwapLE32(16);
+    *(Uint16 *)(wav + 20) = SDL_SwapLE16(1);
+    *(Uint16 *)(wav + 22) = SDL_SwapLE16(2);
+    *(Uint32 *)(wav + 24) = SDL_SwapLE32(22050);
+    *(Uint32 *)(wav + 28) = SDL_SwapLE32(22050 * 4);
+    *(Uint16 *)(wav + 32) = SDL_SwapLE16(4);
+    *(Uint16 *)(wav + 34) = SDL_SwapLE16(16);
+    SDL_memcpy(wav + 36, "data", 4);
+    *(Uint32 *)(wav + 40) = SDL_SwapLE32(data_len);
+    for (i = 0; i < num_frames * 2; i++) {
+        *(Sint16 *)(wav + 44 + i * 2) = (Sint16)SDL_SwapLE16((Uint16)((i * 37) & 0xFFFF));
+    }
+
+    result = SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, 44 + data_len), SDL_TRUE, &spec, &loaded, &loaded_len);
+    SDLTest_AssertPass("Call to SDL_LoadWAV_RW()");
+    SDLTest_AssertCheck(result == 0 && loaded_len == (Uint32)data_len, "Verify loaded length; expected: %d, got: %" SDL_PRIu32, data_len, loaded_len);
+
+    stream = SDL_CreateAudioStreamFromWAV_RW(SDL_RWFromConstMem(wav, 44 + data_len), SDL_TRUE, NULL);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStreamFromWAV_RW(NULL dst_spec)");
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream) {
+        total = 0;
+        do {
+            result = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+            if (result > 0 && total + result <= data_len) {
+                SDL_memcpy(streamed + total, buf, result);
+            }
+            total += SDL_max(result, 0);
+        } while (result > 0);
+        SDLTest_AssertCheck(result == 0, "Verify the stream ended without errors; got: %d", result);
+        SDLTest_AssertCheck(total == data_len, "Verify streamed length; expected: %d, got: %d", data_len, total);
+        if (loaded && total == data_len) {
+            SDLTest_AssertCheck(SDL_memcmp(loaded, streamed, data_len) == 0, "Verify streamed data matches loaded data");
+        }
+        SDL_DestroyAudioStream(stream);
+    }
+
+    /* converting to float at the same rate gives one float per sample. */
+    stream = SDL_CreateAudioStreamFromWAV_RW(SDL_RWFromConstMem(wav, 44 + data_len), SDL_TRUE, &f32_spec);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStreamFromWAV_RW(F32 dst_spec)");
+    SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+    if (stream) {
+        total = 0;
+        while ((result = SDL_GetAudioStreamData(stream, buf, sizeof(buf))) > 0) {
+            total += result;
+        }
+        SDLTest_AssertCheck(total == num_frames * 2 * (int)sizeof(float), "Verify converted length; expected: %d, got: %d", num_frames * 2 * (int)sizeof(float), total);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    /* not a WAVE file. */
+    stream = SDL_CreateAudioStreamFromWAV_RW(SDL_RWFromConstMem(wav + 44, data_len), SDL_TRUE, NULL);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStreamFromWAV_RW() with invalid data");
+    SDLTest_AssertCheck(stream == NULL, "Verify invalid data was rejected");
+
+    SDL_free(loaded);
+    SDL_free(streamed);
+    SDL_free(wav);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check the timing stats of the device thread.
+ *
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int audio_deviceThreadStats(void *arg)
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    SDL_AudioStream *stream;
+    SDL_PropertiesID props;
+    SDL_AudioDeviceID devid;
+    Sint64 iterations = 0;
+    int i;
+
+    /* the test harness keeps the default output open, so use a capture device that we get to open fresh. */
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE, &spec);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE)");
+    SDLTest_AssertCheck(devid != 0, "Verify return value; expected: != 0, got: %" SDL_PRIu32, devid);
+    if (devid == 0) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_GetAudioDeviceProperties(devid);
+    SDLTest_AssertCheck(props != 0, "Verify SDL_GetAudioDeviceProperties() returned properties");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "SDL.audio.device.stats.xruns", -1) >= 0, "Verify xruns are reported");
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Verify SDL_CreateAudioStream() returned a stream");
+    if (stream) {
+        SDL_BindAudioStream(devid, stream);
+    }
+
+    /* wait for the device thread to go around a few times. */
+    for (i = 0; i < 100 && iterations < 3; i++) {
+        SDL_Delay(10);
+        props = SDL_GetAudioDeviceProperties(devid);
+        iterations = SDL_GetNumberProperty(props, "SDL.audio.device.stats.iterations", 0);
+    }
+
+    SDLTest_AssertCheck(iterations >= 3, "Verify the device thread iterated; expected: >= 3, got: %" SDL_PRIs64, iterations);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "SDL.audio.device.stats.streams", 0) == (stream ? 1 : 0), "Verify the bound stream was counted");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "SDL.audio.device.stats.max_mix_ns", -1) >= SDL_GetNumberProperty(props, "SDL.audio.device.stats.average_mix_ns", 0), "Verify the maximum mixing time is at least the average");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "SDL.audio.device.stats.max_wait_ns", 0) > 0, "Verify time spent waiting was measured");
+
+    SDL_CloseAudioDevice(devid);
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check requesting a scheduling class and CPU affinity for the device thread.
+ *
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int audio_deviceThreadProperties(void *arg)
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    SDL_PropertiesID props;
+    SDL_AudioDeviceID devid;
+    SDL_bool applied = SDL_FALSE;
+    int i;
+
+    /* the test harness keeps the default output open, so use a capture device that we get to open fresh. */
+    props = SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE);
+    SDLTest_AssertCheck(props != 0, "Verify SDL_GetAudioDeviceProperties() returned properties");
+    if (!props) {
+        return TEST_ABORTED;
+    }
+
+    SDL_SetStringProperty(props, "SDL.audio.device.thread.priority", "normal");
+    SDL_SetNumberProperty(props, "SDL.audio.device.thread.cpu", 0);
+    SDLTest_AssertPass("Call to SDL_SetStringProperty(\"SDL.audio.device.thread.priority\", \"normal\")");
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE, &spec);
+    SDLTest_AssertCheck(devid != 0, "Verify SDL_OpenAudioDevice() return value; expected: != 0, got: %" SDL_PRIu32, devid);
+    if (devid != 0) {
+        /* the device thread applies this when it starts. */
+        for (i = 0; i < 100 && !applied; i++) {
+            SDL_Delay(10);
+            applied = SDL_GetBooleanProperty(SDL_GetAudioDeviceProperties(devid), "SDL.audio.device.thread.priority_applied", SDL_FALSE);
+        }
+        SDLTest_AssertCheck(applied, "Verify the normal scheduling class was applied");
+        SDL_CloseAudioDevice(devid);
+    }
+
+    props = SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE);
+    SDLTest_AssertCheck(!SDL_GetBooleanProperty(props, "SDL.audio.device.thread.priority_applied", SDL_TRUE), "Verify a closed device doesn't report an applied scheduling class");
+
+    SDL_ClearProperty(props, "SDL.audio.device.thread.priority");
+    SDL_ClearProperty(props, "SDL.audio.device.thread.cpu");
+
+    return TEST_COMPLETED;
+}
+
+/* postmix callback that remembers the last sample of the mix, in 1/10000ths, once the mix isn't silent. */
+static void SDLCALL submix_postmix_callback(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    const int num_samples = buflen / (int)sizeof(float);
+    (void)spec;
+    if (num_samples > 0 && buffer[num_samples - 1] != 0.0f) {
+        SDL_AtomicSet((SDL_AtomicInt *)userdata, (int)SDL_lroundf(buffer[num_samples - 1] * 10000.0f));
+    }
+}
+
+static int wait_for_submix_sample(SDL_AtomicInt *sample)
+{
+    int i;
+    SDL_AtomicSet(sample, 0);
+    for (i = 0; i < 200 && SDL_AtomicGet(sample) == 0; i++) {
+        SDL_Delay(10);
+    }
+    SDL_Delay(50);  /* let the resampler settle on the constant signal. */
+    return SDL_AtomicGet(sample);
+}
+
+/**
+ * Check mixing streams through nested submix buses with gain and postmix callbacks.
+ *
+ * \sa SDL_OpenAudioSubmix
+ * \sa SDL_SetAudioDeviceGain
+ */
+static int audio_submixBuses(void *arg)
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    SDL_AtomicInt bus_sample;
+    SDL_AtomicInt device_sample;
+    SDL_AudioDeviceID devid, bus, inner;
+    SDL_AudioStream *stream;
+    float *data;
+    const int num_frames = 48000 * 4;
+    int result;
+    int i;
+
+    SDL_AtomicSet(&bus_sample, 0);
+    SDL_AtomicSet(&device_sample, 0);
+
+    result = SDL_OpenAudioSubmix(0);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_OpenAudioSubmix(0) fails");
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(0) == -1.0f, "Verify SDL_GetAudioDeviceGain(0) fails");
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid != 0, "Verify SDL_OpenAudioDevice() return value; expected: != 0, got: %" SDL_PRIu32, devid);
+    if (devid == 0) {
+        return TEST_ABORTED;
+    }
+
+    bus = SDL_OpenAudioSubmix(devid);
+    SDLTest_AssertCheck(bus != 0, "Verify SDL_OpenAudioSubmix(devid) return value; expected: != 0, got: %" SDL_PRIu32, bus);
+    inner = SDL_OpenAudioSubmix(bus);
+    SDLTest_AssertCheck(inner != 0, "Verify SDL_OpenAudioSubmix(bus) return value; expected: != 0, got: %" SDL_PRIu32, inner);
+    if (bus == 0 || inner == 0) {
+        SDL_CloseAudioDevice(inner);
+        SDL_CloseAudioDevice(bus);
+        SDL_CloseAudioDevice(devid);
+        return TEST_ABORTED;
+    }
+
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(inner) == 1.0f, "Verify a new bus has a gain of 1.0");
+    result = SDL_SetAudioDeviceGain(inner, -1.0f);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetAudioDeviceGain() rejects a negative gain, got: %d", result);
+    result = SDL_SetAudioDeviceGain(inner, 0.5f);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioDeviceGain(inner, 0.5) return value; expected: 0, got: %d", result);
+    result = SDL_SetAudioDeviceGain(bus, 0.5f);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioDeviceGain(bus, 0.5) return value; expected: 0, got: %d", result);
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(bus) == 0.5f, "Verify SDL_GetAudioDeviceGain(bus) returns 0.5");
+
+    SDL_SetAudioPostmixCallback(bus, submix_postmix_callback, &bus_sample);
+    SDL_SetAudioPostmixCallback(devid, submix_postmix_callback, &device_sample);
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    data = (float *)SDL_malloc(num_frames * 2 * sizeof(float));
+    SDLTest_AssertCheck(stream != NULL && data != NULL, "Verify the stream and its data were created");
+    if (stream && data) {
+        for (i = 0; i < num_frames * 2; i++) {
+            data[i] = 0.8f;
+        }
+        SDL_PutAudioStreamData(stream, data, num_frames * 2 * (int)sizeof(float));
+        result = SDL_BindAudioStream(inner, stream);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_BindAudioStream(inner) return value; expected: 0, got: %d", result);
+
+        /* the stream goes through inner (0.5) and bus (0.5), the bus postmix sees it before the bus gain. */
+        result = wait_for_submix_sample(&device_sample);
+        SDLTest_AssertCheck(SDL_abs(result - 2000) <= 100, "Verify the device mix is scaled by both buses; expected: ~2000, got: %d", result);
+        result = SDL_AtomicGet(&bus_sample);
+        SDLTest_AssertCheck(SDL_abs(result - 4000) <= 100, "Verify the bus postmix sees the inner bus output; expected: ~4000, got: %d", result);
+
+        /* closing the middle bus makes the inner bus mix straight into the device. */
+        SDL_CloseAudioDevice(bus);
+        result = wait_for_submix_sample(&device_sample);
+        SDLTest_AssertCheck(SDL_abs(result - 4000) <= 100, "Verify the inner bus moved to the device; expected: ~4000, got: %d", result);
+    }
+
+    SDL_CloseAudioDevice(inner);
+    SDL_CloseAudioDevice(devid);
+    SDL_DestroyAudioStream(stream);
+    SDL_free(data);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that several streams bound to one capture device all get every captured buffer.
+ *
+ * \sa SDL_BindAudioStreams
+ */
+static int audio_captureMultipleStreams(void *arg)
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_S16, 2, 48000 };
+    SDL_AudioSpec f32spec = { SDL_AUDIO_F32, 1, 22050 };
+    SDL_AudioStream *streams[3];
+    SDL_AudioDeviceID devid;
+    Uint8 buffer[4096];
+    int avail[3];
+    int result;
+    int i, j;
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE, &spec);
+    SDLTest_AssertCheck(devid != 0, "Verify SDL_OpenAudioDevice() return value; expected: != 0, got: %" SDL_PRIu32, devid);
+    if (devid == 0) {
+        return TEST_ABORTED;
+    }
+
+    SDL_PauseAudioDevice(devid);
+    streams[0] = SDL_CreateAudioStream(NULL, &spec);
+    streams[1] = SDL_CreateAudioStream(NULL, &spec);
+    streams[2] = SDL_CreateAudioStream(NULL, &f32spec);  /* this one converts on read. */
+    SDLTest_AssertCheck(streams[0] && streams[1] && streams[2], "Verify SDL_CreateAudioStream() succeeded");
+    if (!streams[0] || !streams[1] || !streams[2]) {
+        SDL_CloseAudioDevice(devid);
+        return TEST_ABORTED;
+    }
+
+    result = SDL_BindAudioStreams(devid, streams, 3);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_BindAudioStreams() return value; expected: 0, got: %d", result);
+    SDL_ResumeAudioDevice(devid);
+
+    for (i = 0; i < 100 && SDL_GetAudioStreamAvailable(streams[1]) < 48000; i++) {
+        SDL_Delay(10);
+    }
+
+    /* read from one stream while the others fill, so buffers are released out of order. */
+    SDL_GetAudioStreamData(streams[0], buffer, sizeof(buffer));
+    SDL_Delay(50);
+    SDL_PauseAudioDevice(devid);
+    SDL_Delay(50);  /* let an in-flight iteration finish. */
+
+    avail[0] = SDL_GetAudioStreamAvailable(streams[0]) + (int)sizeof(buffer);
+    avail[1] = SDL_GetAudioStreamAvailable(streams[1]);
+    avail[2] = SDL_GetAudioStreamAvailable(streams[2]);
+    SDLTest_AssertCheck(avail[1] > 0, "Verify the stream got captured data, got: %d bytes", avail[1]);
+    SDLTest_AssertCheck(avail[0] == avail[1], "Verify both streams got the same data; expected: %d, got: %d", avail[1], avail[0]);
+    SDLTest_AssertCheck(avail[2] > 0, "Verify the converting stream got captured data, got: %d bytes", avail[2]);
+
+    /* queued capture data has to outlive the device. */
+    SDL_CloseAudioDevice(devid);
+    for (j = 0; j < 3; j++) {
+        int total = 0;
+        while ((result = SDL_GetAudioStreamData(streams[j], buffer, sizeof(buffer))) > 0) {
+            total += result;
+        }
+        SDLTest_AssertCheck(result == 0 && total > 0, "Verify stream %d can still be read after closing the device, got: %d bytes", j, total);
+        SDL_DestroyAudioStream(streams[j]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that a stream converting at put time gives the same output as one converting at get time.
+ *
+ * \sa SDL_SetAudioStreamPreconvert
+ */
+static int audio_preconvertStream(void *arg)
+{
+    const SDL_AudioSpec src_spec = { SDL_AUDIO_S16, 2, 44100 };
+    const SDL_AudioSpec dst_spec = { SDL_AUDIO_F32, 1, 48000 };
+    const int num_frames = 44100;
+    const int max_output = 52000 * (int)sizeof(float);
+    SDL_AudioStream *normal, *preconvert;
+    Sint16 *input = NULL;
+    Uint8 *output_normal = NULL, *output_preconvert = NULL;
+    int total_normal = 0, total_preconvert = 0;
+    int result, i;
+
+    normal = SDL_CreateAudioStream(&src_spec, &dst_spec);
+    preconvert = SDL_CreateAudioStream(&src_spec, &dst_spec);
+    input = (Sint16 *)SDL_malloc(num_frames * 2 * sizeof(Sint16));
+    output_normal = (Uint8 *)SDL_malloc(max_output);
+    output_preconvert = (Uint8 *)SDL_malloc(max_output);
+    SDLTest_AssertCheck(normal && preconvert && input && output_normal && output_preconvert, "Verify the streams and buffers were created");
+    if (!normal || !preconvert || !input || !output_normal || !output_preconvert) {
+        goto cleanup;
+    }
+
+    result = SDL_SetAudioStreamPreconvert(preconvert, SDL_TRUE);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetAudioStreamPreconvert() return value; expected: 0, got: %d", result);
+    result = SDL_SetAudioStreamPreconvert(NULL, SDL_TRUE);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetAudioStreamPreconvert(NULL) fails, got: %d", result);
+
+    for (i = 0; i < num_frames * 2; i++) {
+        input[i] = (Sint16)((i * 7919) & 0x7FFF) - 0x4000;
+    }
+
+    /* put in uneven pieces, taking some output after each one. */
+    for (i = 0; i < num_frames; i += 1000) {
+        const int frames = SDL_min(1000, num_frames - i);
+        SDL_PutAudioStreamData(normal, &input[i * 2], frames * 2 * (int)sizeof(Sint16));
+        SDL_PutAudioStreamData(preconvert, &input[i * 2], frames * 2 * (int)sizeof(Sint16));
+        SDLTest_AssertCheck(SDL_GetAudioStreamAvailable(normal) == SDL_GetAudioStreamAvailable(preconvert), "Verify both streams report the same available data");
+        SDLTest_AssertCheck(SDL_abs(SDL_GetAudioStreamQueued(normal) - SDL_GetAudioStreamQueued(preconvert)) <= 8, "Verify both streams report about the same queued data");
+        if ((i / 1000) % 3 == 0) {
+            total_normal += SDL_GetAudioStreamData(normal, &output_normal[total_normal], 3000);
+            total_preconvert += SDL_GetAudioStreamData(preconvert, &output_preconvert[total_preconvert], 3000);
+        }
+    }
+
+    SDL_FlushAudioStream(normal);
+    SDL_FlushAudioStream(preconvert);
+    while ((result = SDL_GetAudioStreamData(normal, &output_normal[total_normal], SDL_min(4096, max_output - total_normal))) > 0) {
+        total_normal += result;
+    }
+    while ((result = SDL_GetAudioStreamData(preconvert, &output_preconvert[total_preconvert], SDL_min(4096, max_output - total_preconvert))) > 0) {
+        total_preconvert += result;
+    }
+
+    SDLTest_AssertCheck(total_normal == total_preconvert, "Verify both streams produced the same amount of data; expected: %d, got: %d", total_normal, total_preconvert);
+    SDLTest_AssertCheck(total_normal == total_preconvert && SDL_memcmp(output_normal, output_preconvert, total_normal) == 0, "Verify both streams produced the same data");
+    SDLTest_AssertCheck(SDL_GetAudioStreamQueued(preconvert) == 0, "Verify nothing is still queued, got: %d", SDL_GetAudioStreamQueued(preconvert));
+
+cleanup:
+    SDL_DestroyAudioStream(normal);
+    SDL_DestroyAudioStream(preconvert);
+    SDL_free(input);
+    SDL_free(output_normal);
+    SDL_free(output_preconvert);
+
+    return TEST_COMPLETED;
+}
+
+static int convertWithStream(const SDL_AudioSpec *src_spec, const Uint8 *src_data, int src_len,
+                             const SDL_AudioSpec *dst_spec, Uint8 **dst_data, int *dst_len)
+{
+    SDL_AudioStream *stream = SDL_CreateAudioStream(src_spec, dst_spec);
+    int available;
+
+    *dst_data = NULL;
+    *dst_len = 0;
+    if (!stream) {
+        return -1;
+    }
+    if (SDL_PutAudioStreamData(stream, src_data, src_len) < 0 || SDL_FlushAudioStream(stream) < 0) {
+        SDL_DestroyAudioStream(stream);
+        return -1;
+    }
+    available = SDL_GetAudioStreamAvailable(stream);
+    *dst_data = (Uint8 *)SDL_malloc(available + 1);
+    if (*dst_data) {
+        *dst_len = SDL_GetAudioStreamData(stream, *dst_data, available);
+    }
+    SDL_DestroyAudioStream(stream);
+    return *dst_data ? 0 : -1;
+}
+
+/**
+ * Check that SDL_ConvertAudioSamples() gives the same output as an audio stream, with and without threads.
+ *
+ * \sa SDL_ConvertAudioSamples
+ */
+static int audio_convertAudioSamples(void *arg)
+{
+    static const struct
+    {
+        SDL_AudioSpec src;
+        SDL_AudioSpec dst;
+        int frames;
+    } cases[] = {
+        { { SDL_AUDIO_S16, 2, 44100 }, { SDL_AUDIO_F32, 2, 44100 }, 10000 },
+        { { SDL_AUDIO_S16, 2, 44100 }, { SDL_AUDIO_F32, 1, 48000 }, 20000 },
+        { { SDL_AUDIO_F32, 1, 48000 }, { SDL_AUDIO_S16, 2, 22050 }, 20000 },
+        { { SDL_AUDIO_U8, 1, 8000 }, { SDL_AUDIO_S32, 6, 96000 }, 3000 },
+        { { SDL_AUDIO_S32, 8, 96000 }, { SDL_AUDIO_U8, 4, 11025 }, 5000 },
+        { { SDL_AUDIO_S16, 2, 44100 }, { SDL_AUDIO_S16, 2, 48000 }, 0 },
+        { { SDL_AUDIO_S16, 1, 48000 }, { SDL_AUDIO_F32, 2, 44100 }, 300000 },
+    };
+    const int max_samples = 300000 * 8;
+    Uint8 *input = NULL;
+    int i, j;
+
+    input = (Uint8 *)SDL_malloc(max_samples * sizeof(Sint32));
+    SDLTest_AssertCheck(input != NULL, "Verify the input buffer was created");
+    if (!input) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(cases); i++) {
+        const int src_len = cases[i].frames * SDL_AUDIO_FRAMESIZE(cases[i].src);
+        Uint8 *expected = NULL, *output = NULL, *threaded = NULL;
+        int expected_len = 0, output_len = 0, threaded_len = 0;
+        int result;
+        const int num_samples = cases[i].frames * cases[i].src.channels;
+        Uint32 noise = 1;
+
+        /* Fill the input with data of the source format */
+        for (j = 0; j < num_samples; j++) {
+            noise = noise * 1664525u + 1013904223u;
+            switch (cases[i].src.format) {
+            case SDL_AUDIO_U8:
+                input[j] = (Uint8)(noise >> 24);
+                break;
+            case SDL_AUDIO_S16:
+                ((Sint16 *)input)[j] = (Sint16)(noise >> 16);
+                break;
+            case SDL_AUDIO_S32:
+                ((Sint32 *)input)[j] = (Sint32)noise;
+                break;
+            case SDL_AUDIO_F32:
+                ((float *)input)[j] = SDL_sinf(j * 0.01f) * 0.5f + (float)(noise >> 8) / (float)(1 << 24) * 0.25f;
+                break;
+            default:
+                SDLTest_AssertCheck(SDL_FALSE, "Case %d: unexpected source format", i);
+                break;
+            }
+        }
+
+        result = convertWithStream(&cases[i].src, input, src_len, &cases[i].dst, &expected, &expected_len);
+        SDLTest_AssertCheck(result == 0, "Case %d: verify the stream converted the data", i);
+
+        SDL_SetHint(SDL_HINT_AUDIO_CONVERT_THREADS, "0");
+        result = SDL_ConvertAudioSamples(&cases[i].src, input, src_len, &cases[i].dst, &output, &output_len);
+        SDLTest_AssertCheck(result == 0, "Case %d: verify SDL_ConvertAudioSamples() return value; expected: 0, got: %d", i, result);
+        SDLTest_AssertCheck(output_len == expected_len, "Case %d: verify the converted length; expected: %d, got: %d", i, expected_len, output_len);
+        SDLTest_AssertCheck(output_len == expected_len && SDL_memcmp(output, expected, output_len) == 0, "Case %d: verify the converted data matches the stream", i);
+
+        for (j = 0; j < 2; j++) {
+            SDL_SetHint(SDL_HINT_AUDIO_CONVERT_THREADS, j ? "-1" : "3");
+            result = SDL_ConvertAudioSamples(&cases[i].src, input, src_len, &cases[i].dst, &threaded, &threaded_len);
+            SDLTest_AssertCheck(result == 0, "Case %d: verify threaded SDL_ConvertAudioSamples() return value; expected: 0, got: %d", i, result);
+            SDLTest_AssertCheck(threaded_len == expected_len && SDL_memcmp(threaded, expected, threaded_len) == 0, "Case %d: verify the threaded conversion matches the stream", i);
+            SDL_free(threaded);
+            threaded = NULL;
+        }
+
+        SDL_free(expected);
+        SDL_free(output);
+    }
+    SDL_ResetHint(SDL_HINT_AUDIO_CONVERT_THREADS);
+    SDL_free(input);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1326,12 +2546,72 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_mixAudioFormat, "audio_mixAudioFormat", "Check mixing audio in various formats and volumes.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_mixThreads, "audio_mixThreads", "Check mixing bound streams on several threads.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_lockFreeStream, "audio_lockFreeStream", "Check putting data into a stream without taking its lock.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_streamGain, "audio_streamGain", "Check gain, pan and fades on audio streams.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest23 = {
+    audio_resampleQuality, "audio_resampleQuality", "Check each resampling quality level.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest24 = {
+    audio_channelMatrix, "audio_channelMatrix", "Check mixing stream channels through custom matrices.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest25 = {
+    audio_putNoCopy, "audio_putNoCopy", "Check adding data to a stream without copying it.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest26 = {
+    audio_lowLatencyDevice, "audio_lowLatencyDevice", "Check low-latency device buffers and the properties that report them.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest27 = {
+    audio_streamFromWAV, "audio_streamFromWAV", "Check decoding a WAVE file incrementally through an audio stream.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest28 = {
+    audio_deviceThreadStats, "audio_deviceThreadStats", "Check the timing stats of the device thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest29 = {
+    audio_deviceThreadProperties, "audio_deviceThreadProperties", "Check requesting a scheduling class and CPU affinity for the device thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest30 = {
+    audio_submixBuses, "audio_submixBuses", "Check mixing streams through nested submix buses with gain and postmix callbacks.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest31 = {
+    audio_captureMultipleStreams, "audio_captureMultipleStreams", "Check that several streams bound to one capture device all get every captured buffer.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest32 = {
+    audio_preconvertStream, "audio_preconvertStream", "Check that a stream converting at put time gives the same output as one converting at get time.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest33 = {
+    audio_convertAudioSamples, "audio_convertAudioSamples", "Check that SDL_ConvertAudioSamples() gives the same output as an audio stream, with and without threads.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22, &audioTest23, &audioTest24, &audioTest25, &audioTest26, &audioTest27, &audioTest28, &audioTest29, &audioTest30, &audioTest31, &audioTest32, &audioTest33, NULL
 };
 
 /* Audio test suite (global) */
@@ -175,6 +175,661 @@ static int events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+#define EVENT_PRODUCER_THREADS  4
+#define EVENTS_PER_PRODUCER     5000
+
+static int SDLCALL events_producerThread(void *data)
+{
+    const int producer = (int)(intptr_t)data;
+    int i;
+
+    for (i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = producer;
+        event.user.data1 = (void *)(intptr_t)i;
+        while (SDL_PushEvent(&event) <= 0) {
+            SDL_Delay(1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Pushes events from several threads while the main thread drains them, and
+ * checks that nothing is lost and each producer's events stay in order.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+static int events_pushFromMultipleThreads(void *arg)
+{
+    SDL_Thread *threads[EVENT_PRODUCER_THREADS];
+    int next_expected[EVENT_PRODUCER_THREADS];
+    int received = 0;
+    int out_of_order = 0;
+    int unexpected = 0;
+    Uint64 start;
+    int i;
+
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_USER);
+
+    for (i = 0; i < EVENT_PRODUCER_THREADS; ++i) {
+        next_expected[i] = 0;
+        threads[i] = SDL_CreateThread(events_producerThread, "EventProducer", (void *)(intptr_t)i);
+        SDLTest_AssertCheck(threads[i] != NULL, "Check SDL_CreateThread(), expected: non-NULL, got: %s", threads[i] ? "non-NULL" : SDL_GetError());
+    }
+
+    start = SDL_GetTicks();
+    while (received < EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER && (SDL_GetTicks() - start) < 30000) {
+        SDL_Event events[64];
+        int count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+
+        if (count <= 0) {
+            SDL_Delay(0);
+            continue;
+        }
+        for (i = 0; i < count; ++i) {
+            const int producer = events[i].user.code;
+            const int sequence = (int)(intptr_t)events[i].user.data1;
+
+            if (producer < 0 || producer >= EVENT_PRODUCER_THREADS) {
+                ++unexpected;
+                continue;
+            }
+            if (sequence != next_expected[producer]) {
+                ++out_of_order;
+            }
+            next_expected[producer] = sequence + 1;
+            ++received;
+        }
+    }
+
+    for (i = 0; i < EVENT_PRODUCER_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    SDLTest_AssertCheck(received == EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER, "Check received events, expected: %d, got: %d", EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER, received);
+    SDLTest_AssertCheck(out_of_order == 0, "Check events arrived in order per producer, expected: 0 out of order, got: %d", out_of_order);
+    SDLTest_AssertCheck(unexpected == 0, "Check for unexpected user events, expected: 0, got: %d", unexpected);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Fills the queue past the size of its lock-free ring and checks the events
+ * come back out in the order they were pushed.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+static int events_pushPastRingCapacity(void *arg)
+{
+    const int total = 5000;
+    int i, count, next = 0, out_of_order = 0;
+    SDL_Event events[128];
+
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_USER);
+
+    for (i = 0; i < total; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        if (SDL_PushEvent(&event) != 1) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == total, "Check pushed events, expected: %d, got: %d", total, i);
+
+    /* Peek doesn't remove anything */
+    count = SDL_PeepEvents(events, 1, SDL_PEEKEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(count == 1 && events[0].user.code == 0, "Check peeked event, expected: code 0, got: %d events, code %d", count, count > 0 ? events[0].user.code : -1);
+
+    while ((count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER)) > 0) {
+        for (i = 0; i < count; ++i) {
+            if (events[i].user.code != next) {
+                ++out_of_order;
+            }
+            next = events[i].user.code + 1;
+        }
+    }
+    SDLTest_AssertCheck(next == total, "Check last event, expected: %d, got: %d", total - 1, next - 1);
+    SDLTest_AssertCheck(out_of_order == 0, "Check events arrived in order, expected: 0 out of order, got: %d", out_of_order);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks typed peeks, counts and flushes against a queue holding many
+ * events of other types, including ranges that span several types.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_HasEvent
+ * \sa SDL_FlushEvent
+ */
+static int events_peepTypeRanges(void *arg)
+{
+    const Uint32 user1 = SDL_EVENT_USER + 1;
+    const Uint32 user2 = SDL_EVENT_USER + 2;
+    const Uint32 user3 = SDL_EVENT_USER + 0x100; /* in a different block of types */
+    SDL_Event event, events[16];
+    int i, count, next, out_of_order = 0;
+
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_LAST);
+
+    SDLTest_AssertCheck(!SDL_HasEvent(user1), "Check SDL_HasEvent() on an empty type, expected: SDL_FALSE");
+
+    /* Interleave lots of one type with a few events of others, recording the order in the code */
+    for (i = 0; i < 3000; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        if (i % 1000 == 500) {
+            event.type = user1;
+        } else if (i % 1000 == 700) {
+            event.type = user2;
+        } else if (i % 1000 == 900) {
+            event.type = user3;
+        }
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    SDLTest_AssertCheck(SDL_HasEvent(user1), "Check SDL_HasEvent(), expected: SDL_TRUE");
+    count = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, user1, user2);
+    SDLTest_AssertCheck(count == 6, "Check count of two types, expected: 6, got: %d", count);
+    count = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_USER, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(count == 3000, "Check count of all user events, expected: 3000, got: %d", count);
+
+    /* Peeking one type only sees that type */
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_PEEKEVENT, user2, user2);
+    SDLTest_AssertCheck(count == 3, "Check peeked events, expected: 3, got: %d", count);
+    for (i = 0; i < count; ++i) {
+        SDLTest_AssertCheck(events[i].type == user2 && events[i].user.code == i * 1000 + 700, "Check peeked event %d, expected: code %d, got: type 0x%x code %d", i, i * 1000 + 700, events[i].type, events[i].user.code);
+    }
+
+    /* A range over several types, and blocks of types, comes back in queue order */
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, user1, user3);
+    SDLTest_AssertCheck(count == 9, "Check events in range, expected: 9, got: %d", count);
+    for (i = 1; i < count; ++i) {
+        if (events[i - 1].user.code >= events[i].user.code) {
+            ++out_of_order;
+        }
+    }
+    SDLTest_AssertCheck(out_of_order == 0, "Check events in range are in order, expected: 0 out of order, got: %d", out_of_order);
+    SDLTest_AssertCheck(!SDL_HasEvents(user1, user3), "Check range is empty after getting it, expected: SDL_FALSE");
+
+    /* Put one back and flush the common type around it */
+    SDL_zero(event);
+    event.type = user1;
+    event.user.code = 3000;
+    SDL_PushEvent(&event);
+    SDL_FlushEvent(SDL_EVENT_USER);
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER), "Check flushed type, expected: SDL_FALSE");
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(count == 1 && events[0].type == user1 && events[0].user.code == 3000, "Check remaining event, expected: 1 event with code 3000, got: %d events", count);
+
+    /* The full range walks everything in order */
+    for (i = 0; i < 10; ++i) {
+        SDL_zero(event);
+        event.type = (i & 1) ? user3 : user1;
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    next = 0;
+    out_of_order = 0;
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_LAST) == 1) {
+        if (event.user.code != next) {
+            ++out_of_order;
+        }
+        ++next;
+    }
+    SDLTest_AssertCheck(next == 10 && out_of_order == 0, "Check full range order, expected: 10 events in order, got: %d events, %d out of order", next, out_of_order);
+
+    return TEST_COMPLETED;
+}
+
+static void events_pushMotion(Uint32 windowID, Uint32 state, float x, float y, float xrel, float yrel)
+{
+    SDL_Event event;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.windowID = windowID;
+    event.motion.which = 1;
+    event.motion.state = state;
+    event.motion.x = x;
+    event.motion.y = y;
+    event.motion.xrel = xrel;
+    event.motion.yrel = yrel;
+    SDL_PushEvent(&event);
+}
+
+/**
+ * Checks that consecutive motion events are merged when
+ * SDL_HINT_EVENT_COALESCE_MOTION is set, and recorded for
+ * SDL_GetMotionHistory().
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_GetMotionHistory
+ */
+static int events_coalesceMotion(void *arg)
+{
+    SDL_Event events[16];
+    SDL_Event event;
+    int count, i;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+    SDL_SetHint(SDL_HINT_EVENT_MOTION_HISTORY, "6");
+    SDLTest_AssertPass("Enabled motion coalescing and history");
+
+    for (i = 1; i <= 4; ++i) {
+        events_pushMotion(1, 0, 10.0f * i, 20.0f * i, 1.0f, 2.0f);
+    }
+    /* Starts a new event for a different button state, then one after a non-motion event */
+    events_pushMotion(1, SDL_BUTTON_LMASK, 50.0f, 60.0f, 1.0f, 1.0f);
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    events_pushMotion(1, SDL_BUTTON_LMASK, 51.0f, 61.0f, 1.0f, 1.0f);
+    /* ...and for a different window */
+    events_pushMotion(2, SDL_BUTTON_LMASK, 1.0f, 1.0f, 1.0f, 1.0f);
+    events_pushMotion(2, SDL_BUTTON_LMASK, 2.0f, 3.0f, 1.0f, 2.0f);
+
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(count == 5, "Check queued events, expected: 5, got: %d", count);
+    if (count == 5) {
+        SDLTest_AssertCheck(events[0].type == SDL_EVENT_MOUSE_MOTION && events[0].motion.x == 40.0f && events[0].motion.y == 80.0f,
+                            "Check merged position, expected: 40,80, got: %g,%g", events[0].motion.x, events[0].motion.y);
+        SDLTest_AssertCheck(events[0].motion.xrel == 4.0f && events[0].motion.yrel == 8.0f,
+                            "Check merged relative motion, expected: 4,8, got: %g,%g", events[0].motion.xrel, events[0].motion.yrel);
+        SDLTest_AssertCheck(events[1].type == SDL_EVENT_MOUSE_MOTION && events[1].motion.state == SDL_BUTTON_LMASK, "Check button state change started a new event");
+        SDLTest_AssertCheck(events[2].type == SDL_EVENT_USER, "Check non-motion event kept its place, got type 0x%x", events[2].type);
+        SDLTest_AssertCheck(events[3].type == SDL_EVENT_MOUSE_MOTION && events[3].motion.windowID == 1, "Check motion after another event wasn't merged into earlier motion");
+        SDLTest_AssertCheck(events[4].motion.windowID == 2 && events[4].motion.xrel == 2.0f && events[4].motion.yrel == 3.0f,
+                            "Check second window motion, expected: 2,3 relative, got: %g,%g", events[4].motion.xrel, events[4].motion.yrel);
+    }
+
+    /* The history has every raw event, but only the last 6 of the 8 pushed */
+    count = SDL_GetMotionHistory(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 6, "Check SDL_GetMotionHistory(), expected: 6, got: %d", count);
+    if (count == 6) {
+        SDLTest_AssertCheck(events[0].motion.x == 30.0f && events[5].motion.x == 2.0f,
+                            "Check recorded motion order, expected: 30 .. 2, got: %g .. %g", events[0].motion.x, events[5].motion.x);
+    }
+    count = SDL_GetMotionHistory(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 0, "Check history is consumed, expected: 0, got: %d", count);
+    count = SDL_GetMotionHistory(NULL, 1);
+    SDLTest_AssertCheck(count < 0, "Check SDL_GetMotionHistory(NULL), expected: < 0, got: %d", count);
+
+    SDL_ResetHint(SDL_HINT_EVENT_MOTION_HISTORY);
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+
+    /* With coalescing off, everything is queued separately again */
+    events_pushMotion(1, 0, 1.0f, 1.0f, 1.0f, 1.0f);
+    events_pushMotion(1, 0, 2.0f, 2.0f, 1.0f, 1.0f);
+    count = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDLTest_AssertCheck(count == 2, "Check motion without coalescing, expected: 2, got: %d", count);
+    SDL_FlushEvent(SDL_EVENT_MOUSE_MOTION);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Retrieves queued events in batches with SDL_PollEvents().
+ *
+ * \sa SDL_PollEvents
+ */
+static int events_pollEventsBatch(void *arg)
+{
+    SDL_Event events[16];
+    SDL_Event event;
+    int i, count, total = 0, out_of_order = 0;
+
+    /* Finish any poll cycle in progress */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    for (i = 0; i < 10; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    count = SDL_PollEvents(events, 4);
+    SDLTest_AssertCheck(count == 4, "Check first batch, expected: 4, got: %d", count);
+    for (i = 0; i < count; ++i) {
+        if (events[i].type != SDL_EVENT_USER || events[i].user.code != total++) {
+            ++out_of_order;
+        }
+    }
+    count = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 6, "Check second batch, expected: 6, got: %d", count);
+    for (i = 0; i < count; ++i) {
+        if (events[i].type != SDL_EVENT_USER || events[i].user.code != total++) {
+            ++out_of_order;
+        }
+    }
+    SDLTest_AssertCheck(out_of_order == 0, "Check events arrived in order, expected: 0 out of order, got: %d", out_of_order);
+
+    /* Events pushed after the poll cycle ended show up in the next one */
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.user.code = 10;
+    SDL_PushEvent(&event);
+    count = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 1 && events[0].user.code == 10, "Check next poll cycle, expected: 1 event, got: %d", count);
+
+    count = SDL_PollEvents(NULL, 1);
+    SDLTest_AssertCheck(count < 0, "Check SDL_PollEvents(NULL), expected: < 0, got: %d", count);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Allocates event memory of various sizes and checks the blocks are
+ * aligned, don't overlap, and survive until the events are consumed.
+ *
+ * \sa SDL_AllocateEventMemory
+ */
+static int events_allocateEventMemory(void *arg)
+{
+    static const size_t sizes[] = { 1, 7, 16, 100, 1000, 3000, 10000, 3, 4096, 33 };
+    Uint8 *blocks[SDL_arraysize(sizes)];
+    SDL_Event event;
+    int i, misaligned = 0, corrupted = 0;
+    size_t j;
+
+    for (i = 0; i < (int)SDL_arraysize(sizes); ++i) {
+        blocks[i] = (Uint8 *)SDL_AllocateEventMemory(sizes[i]);
+        SDLTest_AssertCheck(blocks[i] != NULL, "Check SDL_AllocateEventMemory(%d), expected: non-NULL", (int)sizes[i]);
+        if (!blocks[i]) {
+            return TEST_ABORTED;
+        }
+        if (((uintptr_t)blocks[i] % sizeof(void *)) != 0) {
+            ++misaligned;
+        }
+        SDL_memset(blocks[i], i + 1, sizes[i]);
+
+        /* Reference it from an event, like text input does */
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.data1 = blocks[i];
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertCheck(misaligned == 0, "Check allocations are aligned, expected: 0 misaligned, got: %d", misaligned);
+
+    for (i = 0; i < (int)SDL_arraysize(sizes); ++i) {
+        SDLTest_AssertCheck(SDL_PollEvent(&event) && event.type == SDL_EVENT_USER && event.user.data1 == blocks[i], "Check event %d references its memory", i);
+        for (j = 0; j < sizes[i]; ++j) {
+            if (blocks[i][j] != (Uint8)(i + 1)) {
+                ++corrupted;
+                break;
+            }
+        }
+    }
+    SDLTest_AssertCheck(corrupted == 0, "Check allocations don't overlap, expected: 0 corrupted, got: %d", corrupted);
+
+    /* Finish the poll cycle, which releases the memory */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    int count;
+    int out_of_order;
+    int bad_times;
+    Sint32 next_code;
+} LatencyTrace;
+
+static void SDLCALL events_sampleLatencyCallback(void *userdata, const SDL_Event *event, Uint64 queued_ns, Uint64 retrieved_ns)
+{
+    LatencyTrace *trace = (LatencyTrace *)userdata;
+
+    if (event->type != SDL_EVENT_USER) {
+        return;
+    }
+    if (event->user.code != trace->next_code++) {
+        ++trace->out_of_order;
+    }
+    if (queued_ns == 0 || queued_ns > retrieved_ns || event->common.timestamp > queued_ns) {
+        ++trace->bad_times;
+    }
+    ++trace->count;
+}
+
+/**
+ * Traces the latency of events retrieved from the queue
+ */
+static int events_traceEventLatency(void *arg)
+{
+    LatencyTrace trace;
+    SDL_Event events[8];
+    SDL_Event event;
+    int i;
+
+    SDL_zero(trace);
+
+    /* Finish any poll cycle in progress */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    /* Events queued before tracing starts aren't reported */
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.user.code = -1;
+    SDL_PushEvent(&event);
+
+    SDL_SetEventLatencyCallback(events_sampleLatencyCallback, &trace);
+    SDLTest_AssertPass("Call to SDL_SetEventLatencyCallback()");
+
+    for (i = 0; i < 8; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    /* Peeking doesn't retrieve events */
+    SDL_PeepEvents(events, SDL_arraysize(events), SDL_PEEKEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(trace.count == 0, "Check peeked events weren't traced, expected: 0, got: %d", trace.count);
+
+    SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(event.user.code == -1 && trace.count == 0, "Check untraced event, expected: 0 traced, got: %d", trace.count);
+
+    SDL_PeepEvents(events, 2, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDL_PollEvents(events, 3);
+    while (SDL_PollEvent(&event)) {
+    }
+    SDLTest_AssertCheck(trace.count == 8, "Check traced events, expected: 8, got: %d", trace.count);
+    SDLTest_AssertCheck(trace.out_of_order == 0, "Check traced events were in order, expected: 0 out of order, got: %d", trace.out_of_order);
+    SDLTest_AssertCheck(trace.bad_times == 0, "Check traced times were ordered, expected: 0 bad, got: %d", trace.bad_times);
+
+    SDL_SetEventLatencyCallback(NULL, NULL);
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    while (SDL_PollEvent(&event)) {
+    }
+    SDLTest_AssertCheck(trace.count == 8, "Check tracing stopped, expected: 8, got: %d", trace.count);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL events_countingEventWatch(void *userdata, SDL_Event *event)
+{
+    SDL_AtomicIncRef((SDL_AtomicInt *)userdata);
+    return 0;
+}
+
+static int SDLCALL events_selfDeletingEventWatch(void *userdata, SDL_Event *event)
+{
+    SDL_AtomicIncRef((SDL_AtomicInt *)userdata);
+    SDL_DelEventWatch(events_selfDeletingEventWatch, userdata);
+    return 0;
+}
+
+/**
+ * Adds event watches for ranges of event types, and adds and deletes them
+ * while other threads are pushing events.
+ *
+ * \sa SDL_AddEventWatchRange
+ * \sa SDL_DelEventWatch
+ */
+static int events_addEventWatchRange(void *arg)
+{
+    SDL_Thread *threads[EVENT_PRODUCER_THREADS];
+    SDL_AtomicInt range_calls, all_calls, self_calls;
+    SDL_Event events[64];
+    SDL_Event event;
+    int received = 0;
+    Uint64 start;
+    int i, count, result;
+
+    SDL_AtomicSet(&range_calls, 0);
+    SDL_AtomicSet(&all_calls, 0);
+    SDL_AtomicSet(&self_calls, 0);
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_USER + 1);
+
+    result = SDL_AddEventWatchRange(events_countingEventWatch, &range_calls, SDL_EVENT_USER + 1, SDL_EVENT_USER + 1);
+    SDLTest_AssertCheck(result == 0, "Check SDL_AddEventWatchRange(), expected: 0, got: %d", result);
+    SDL_AddEventWatchRange(events_selfDeletingEventWatch, &self_calls, SDL_EVENT_USER, SDL_EVENT_USER + 1);
+    SDL_AddEventWatch(events_countingEventWatch, &all_calls);
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+    event.type = SDL_EVENT_USER + 1;
+    SDL_PushEvent(&event);
+
+    SDLTest_AssertCheck(SDL_AtomicGet(&range_calls) == 1, "Check range watch calls, expected: 1, got: %d", SDL_AtomicGet(&range_calls));
+    SDLTest_AssertCheck(SDL_AtomicGet(&all_calls) == 3, "Check watch calls, expected: 3, got: %d", SDL_AtomicGet(&all_calls));
+    SDLTest_AssertCheck(SDL_AtomicGet(&self_calls) == 1, "Check self deleting watch calls, expected: 1, got: %d", SDL_AtomicGet(&self_calls));
+
+    SDL_DelEventWatch(events_countingEventWatch, &range_calls);
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_USER + 1);
+
+    /* Change the watchers while other threads are dispatching to them */
+    for (i = 0; i < EVENT_PRODUCER_THREADS; ++i) {
+        threads[i] = SDL_CreateThread(events_producerThread, "EventProducer", (void *)(intptr_t)i);
+        SDLTest_AssertCheck(threads[i] != NULL, "Check SDL_CreateThread(), expected: non-NULL, got: %s", threads[i] ? "non-NULL" : SDL_GetError());
+    }
+
+    start = SDL_GetTicks();
+    while (received < EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER && SDL_GetTicks() - start < 10000) {
+        SDL_AddEventWatchRange(events_countingEventWatch, &range_calls, SDL_EVENT_USER, SDL_EVENT_USER);
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+        SDL_DelEventWatch(events_countingEventWatch, &range_calls);
+        if (count > 0) {
+            received += count;
+        } else {
+            SDL_Delay(0);
+        }
+    }
+
+    for (i = 0; i < EVENT_PRODUCER_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_DelEventWatch(events_countingEventWatch, &all_calls);
+
+    SDLTest_AssertCheck(received == EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER, "Check events received, expected: %d, got: %d", EVENT_PRODUCER_THREADS * EVENTS_PER_PRODUCER, received);
+    SDLTest_AssertCheck(SDL_AtomicGet(&all_calls) == 3 + received, "Check watch calls, expected: %d, got: %d", 3 + received, SDL_AtomicGet(&all_calls));
+    SDLTest_AssertCheck(SDL_AtomicGet(&self_calls) == 1, "Check self deleting watch calls, expected: 1, got: %d", SDL_AtomicGet(&self_calls));
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Batches touch and pen motion into frame events, keeping it in order with
+ * finger down and up events.
+ */
+static int events_batchTouch(void *arg)
+{
+    SDL_Event events[8];
+    SDL_Event event;
+    int i, count;
+
+    /* Finish any poll cycle in progress */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    SDL_SetHint(SDL_HINT_EVENT_BATCH_TOUCH, "1");
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_FINGER_DOWN;
+    event.tfinger.touchId = 1;
+    event.tfinger.fingerId = 1;
+    SDL_PushEvent(&event);
+    for (i = 0; i < 3; ++i) {
+        event.type = SDL_EVENT_FINGER_MOTION;
+        event.tfinger.x = i * 0.25f;
+        SDL_PushEvent(&event);
+    }
+    event.type = SDL_EVENT_FINGER_UP;
+    SDL_PushEvent(&event);
+    event.type = SDL_EVENT_FINGER_MOTION;
+    SDL_PushEvent(&event);
+    SDL_PumpEvents();
+    SDLTest_AssertPass("Pushed finger events and called SDL_PumpEvents()");
+
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FINGER_DOWN, SDL_EVENT_FINGER_FRAME);
+    SDLTest_AssertCheck(count == 4, "Check finger events, expected: 4, got: %d", count);
+    if (count == 4) {
+        SDLTest_AssertCheck(events[0].type == SDL_EVENT_FINGER_DOWN, "Check first event is finger down, got: 0x%x", (unsigned int)events[0].type);
+        SDLTest_AssertCheck(events[1].type == SDL_EVENT_FINGER_FRAME, "Check second event is a frame, got: 0x%x", (unsigned int)events[1].type);
+        SDLTest_AssertCheck(events[2].type == SDL_EVENT_FINGER_UP, "Check third event is finger up, got: 0x%x", (unsigned int)events[2].type);
+        SDLTest_AssertCheck(events[3].type == SDL_EVENT_FINGER_FRAME, "Check fourth event is a frame, got: 0x%x", (unsigned int)events[3].type);
+        SDLTest_AssertCheck(events[1].tframe.num_samples == 3, "Check first frame samples, expected: 3, got: %d", events[1].tframe.num_samples);
+        SDLTest_AssertCheck(events[3].tframe.num_samples == 1, "Check second frame samples, expected: 1, got: %d", events[3].tframe.num_samples);
+        for (i = 0; i < events[1].tframe.num_samples; ++i) {
+            SDLTest_AssertCheck(events[1].tframe.samples[i].type == SDL_EVENT_FINGER_MOTION && events[1].tframe.samples[i].x == i * 0.25f,
+                                "Check sample %d, expected x: %g, got: %g", i, i * 0.25f, events[1].tframe.samples[i].x);
+        }
+        SDLTest_AssertCheck(events[1].tframe.timestamp == events[1].tframe.samples[2].timestamp, "Check frame has the newest sample timestamp");
+    }
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_PEN_MOTION;
+    event.pmotion.which = 1;
+    for (i = 0; i < 4; ++i) {
+        event.pmotion.x = (float)i;
+        SDL_PushEvent(&event);
+    }
+    SDL_PumpEvents();
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_PEN_DOWN, SDL_EVENT_PEN_FRAME);
+    SDLTest_AssertCheck(count == 1 && events[0].type == SDL_EVENT_PEN_FRAME, "Check pen motion was batched, expected: 1 frame, got: %d events", count);
+    if (count == 1) {
+        SDLTest_AssertCheck(events[0].pframe.num_samples == 4, "Check pen frame samples, expected: 4, got: %d", events[0].pframe.num_samples);
+        SDLTest_AssertCheck(events[0].pframe.samples[3].x == 3.0f, "Check last pen sample, expected x: 3, got: %g", events[0].pframe.samples[3].x);
+    }
+
+    /* Nothing is batched while the frame event is disabled */
+    SDL_SetEventEnabled(SDL_EVENT_FINGER_FRAME, SDL_FALSE);
+    SDL_zero(event);
+    event.type = SDL_EVENT_FINGER_MOTION;
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+    SDL_PumpEvents();
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FINGER_DOWN, SDL_EVENT_FINGER_FRAME);
+    SDLTest_AssertCheck(count == 2 && events[0].type == SDL_EVENT_FINGER_MOTION, "Check unbatched finger motion, expected: 2, got: %d", count);
+    SDL_SetEventEnabled(SDL_EVENT_FINGER_FRAME, SDL_TRUE);
+
+    SDL_ResetHint(SDL_HINT_EVENT_BATCH_TOUCH);
+    while (SDL_PollEvent(&event)) {
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -190,9 +845,45 @@ static const SDLTest_TestCaseReference eventsTest3 = {
     (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest4 = {
+    (SDLTest_TestCaseFp)events_pushFromMultipleThreads, "events_pushFromMultipleThreads", "Pushes events from several threads while draining them", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest5 = {
+    (SDLTest_TestCaseFp)events_pushPastRingCapacity, "events_pushPastRingCapacity", "Pushes more events than fit in the lock-free ring and checks their order", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest6 = {
+    (SDLTest_TestCaseFp)events_peepTypeRanges, "events_peepTypeRanges", "Peeks, counts and flushes events by type and type range", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest7 = {
+    (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Coalesces motion events and records their history", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest8 = {
+    (SDLTest_TestCaseFp)events_pollEventsBatch, "events_pollEventsBatch", "Polls events in batches", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest9 = {
+    (SDLTest_TestCaseFp)events_allocateEventMemory, "events_allocateEventMemory", "Allocates memory for events", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest10 = {
+    (SDLTest_TestCaseFp)events_traceEventLatency, "events_traceEventLatency", "Traces the latency of events retrieved from the queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest11 = {
+    (SDLTest_TestCaseFp)events_addEventWatchRange, "events_addEventWatchRange", "Adds event watches for ranges of event types while events are being pushed", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest12 = {
+    (SDLTest_TestCaseFp)events_batchTouch, "events_batchTouch", "Batches touch and pen motion into frame events", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, &eventsTest8, &eventsTest9, &eventsTest10, &eventsTest11, &eventsTest12, NULL
 };
 
 /* Events test suite (global) */
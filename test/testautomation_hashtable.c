@@ -0,0 +1,104 @@
+/**
+ * Hash table test suite
+ */
+
+#define SDL_internal_h_ /* Inhibit dynamic symbol redefinitions that clash with ours */
+
+/* ================= System Under Test (SUT) ================== */
+/* Renaming SUT operations to avoid link-time symbol clashes */
+#define SDL_CreateHashTable     SDL_SUT_CreateHashTable
+#define SDL_DestroyHashTable    SDL_SUT_DestroyHashTable
+#define SDL_InsertIntoHashTable SDL_SUT_InsertIntoHashTable
+#define SDL_RemoveFromHashTable SDL_SUT_RemoveFromHashTable
+#define SDL_FindInHashTable     SDL_SUT_FindInHashTable
+#define SDL_HashTableEmpty      SDL_SUT_HashTableEmpty
+#define SDL_IterateHashTableKey SDL_SUT_IterateHashTableKey
+#define SDL_IterateHashTable    SDL_SUT_IterateHashTable
+#define SDL_HashString          SDL_SUT_HashString
+#define SDL_KeyMatchString      SDL_SUT_KeyMatchString
+#define SDL_HashID              SDL_SUT_HashID
+#define SDL_KeyMatchID          SDL_SUT_KeyMatchID
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+/* Import SUT code with macro-renamed function names */
+#include "../src/SDL_hashtable.c"
+
+/* ================= Test Case Implementation ================== */
+
+static void SDLCALL nuke_nothing(const void *key, const void *value, void *data)
+{
+}
+
+/**
+ * Checks that the latest value inserted under a key in a stackable table is found first.
+ */
+static int hashtable_testStackableOrder(void *arg)
+{
+    SDL_HashTable *table;
+    const void *value = NULL;
+    void *iter = NULL;
+    uintptr_t expected;
+    int i, count;
+
+    table = SDL_CreateHashTable(NULL, 4, SDL_HashID, SDL_KeyMatchID, nuke_nothing, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_CreateHashTable(stackable)");
+    SDLTest_AssertCheck(table != NULL, "Verify table is not NULL");
+    if (!table) {
+        return TEST_ABORTED;
+    }
+
+    SDL_InsertIntoHashTable(table, (const void *)1, (const void *)100);
+    SDL_InsertIntoHashTable(table, (const void *)1, (const void *)101);
+    SDLTest_AssertPass("Call to SDL_InsertIntoHashTable() twice with the same key");
+    SDL_FindInHashTable(table, (const void *)1, &value);
+    SDLTest_AssertCheck(value == (const void *)101, "Verify the newest value is found, got %d, expected 101", (int)(uintptr_t)value);
+
+    /* Fill the table with other keys, so it has to grow, and stack more values on the first one */
+    for (i = 2; i < 64; ++i) {
+        SDL_InsertIntoHashTable(table, (const void *)(uintptr_t)i, (const void *)(uintptr_t)i);
+        SDL_InsertIntoHashTable(table, (const void *)1, (const void *)(uintptr_t)(100 + i));
+    }
+    SDL_FindInHashTable(table, (const void *)1, &value);
+    SDLTest_AssertCheck(value == (const void *)163, "Verify the newest value is found after growing, got %d, expected 163", (int)(uintptr_t)value);
+
+    count = 0;
+    expected = 163;
+    while (SDL_IterateHashTableKey(table, (const void *)1, &value, &iter)) {
+        if ((uintptr_t)value != expected) {
+            break;
+        }
+        --expected;
+        ++count;
+    }
+    SDLTest_AssertCheck(count == 64, "Verify the values are iterated newest first, got %d in order, expected 64", count);
+
+    SDL_RemoveFromHashTable(table, (const void *)1);
+    SDL_FindInHashTable(table, (const void *)1, &value);
+    SDLTest_AssertCheck(value == (const void *)162, "Verify removing drops the newest value, got %d, expected 162", (int)(uintptr_t)value);
+
+    SDL_DestroyHashTable(table);
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Hash table test cases */
+static const SDLTest_TestCaseReference hashtableTest1 = {
+    (SDLTest_TestCaseFp)hashtable_testStackableOrder, "hashtable_testStackableOrder", "Check that stackable tables find the newest value first", TEST_ENABLED
+};
+
+/* Sequence of hash table test cases */
+static const SDLTest_TestCaseReference *hashtableTests[] = {
+    &hashtableTest1, NULL
+};
+
+/* Hash table test suite (global) */
+SDLTest_TestSuiteReference hashtableTestSuite = {
+    "Hashtable",
+    NULL,
+    hashtableTests,
+    NULL
+};
@@ -235,6 +235,49 @@ static int hints_setHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_GetHintBoolean, checking that cached values follow changes
+ */
+static int hints_getHintBoolean(void *arg)
+{
+    const char *testHint = "SDL_AUTOMATED_TEST_HINT_BOOLEAN";
+
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_TRUE) == SDL_TRUE,
+        "Verify unset hint returns the default value");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_FALSE) == SDL_FALSE,
+        "Verify unset hint returns the default value");
+
+    SDL_SetHint(testHint, "0");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_TRUE) == SDL_FALSE,
+        "Verify hint set to \"0\" is false");
+
+    SDL_SetHint(testHint, "1");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_FALSE) == SDL_TRUE,
+        "Verify hint set to \"1\" is true");
+
+    SDL_SetHint(testHint, "");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_TRUE) == SDL_TRUE,
+        "Verify empty hint returns the default value");
+
+    SDL_setenv(testHint, "false", 1);
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_TRUE) == SDL_FALSE,
+        "Verify environment variable set to \"false\" overrides the hint");
+
+    SDL_setenv(testHint, "true", 1);
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_FALSE) == SDL_TRUE,
+        "Verify changed environment variable is picked up");
+
+    SDL_SetHintWithPriority(testHint, "0", SDL_HINT_OVERRIDE);
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_TRUE) == SDL_FALSE,
+        "Verify override hint takes priority over the environment");
+
+    SDL_ResetHint(testHint);
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, SDL_FALSE) == SDL_TRUE,
+        "Verify reset hint uses the environment again");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -246,9 +289,13 @@ static const SDLTest_TestCaseReference hintsTest2 = {
     (SDLTest_TestCaseFp)hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference hintsTest3 = {
+    (SDLTest_TestCaseFp)hints_getHintBoolean, "hints_getHintBoolean", "Call to SDL_GetHintBoolean", TEST_ENABLED
+};
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] = {
-    &hintsTest1, &hintsTest2, NULL
+    &hintsTest1, &hintsTest2, &hintsTest3, NULL
 };
 
 /* Hints test suite (global) */
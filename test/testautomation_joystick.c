@@ -126,6 +126,419 @@ static int TestVirtualJoystick(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Check that joysticks are updated on the input thread without pumping events
+ *
+ * \sa SDL_HINT_EVENT_INPUT_THREAD
+ */
+static int TestInputThread(void *arg)
+{
+    SDL_Joystick *joystick = NULL;
+    SDL_JoystickID device_id;
+    SDL_Event event;
+    SDL_bool got_button = SDL_FALSE;
+    Uint64 start;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_JOYSTICK) == 0, "SDL_InitSubSystem(SDL_INIT_JOYSTICK)");
+
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+    SDL_SetHint(SDL_HINT_EVENT_INPUT_THREAD, "1");
+
+    device_id = SDL_AttachVirtualJoystick(SDL_JOYSTICK_TYPE_GAMEPAD, 2, 4, 0);
+    SDLTest_AssertCheck(device_id > 0, "SDL_AttachVirtualJoystick()");
+    if (device_id > 0) {
+        joystick = SDL_OpenJoystick(device_id);
+        SDLTest_AssertCheck(joystick != NULL, "SDL_OpenJoystick()");
+        if (joystick) {
+            SDL_FlushEvents(SDL_EVENT_JOYSTICK_BUTTON_DOWN, SDL_EVENT_JOYSTICK_BUTTON_DOWN);
+            SDLTest_AssertCheck(SDL_SetJoystickVirtualButton(joystick, 1, SDL_PRESSED) == 0, "SDL_SetJoystickVirtualButton(1, SDL_PRESSED)");
+
+            /* Don't pump events, the input thread should pick up the change */
+            start = SDL_GetTicks();
+            while (!got_button && SDL_GetTicks() - start < 1000) {
+                if (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_JOYSTICK_BUTTON_DOWN, SDL_EVENT_JOYSTICK_BUTTON_DOWN) == 1) {
+                    got_button = (event.jbutton.button == 1) ? SDL_TRUE : SDL_FALSE;
+                } else {
+                    SDL_Delay(1);
+                }
+            }
+            SDLTest_AssertCheck(got_button, "Check button event from the input thread");
+            SDLTest_AssertCheck(SDL_GetJoystickButton(joystick, 1) == SDL_PRESSED, "SDL_GetJoystickButton(1) == SDL_PRESSED");
+
+            SDL_CloseJoystick(joystick);
+        }
+        SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
+    }
+
+    /* Shut down joysticks while the input thread is still running */
+    SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+
+    SDL_ResetHint(SDL_HINT_EVENT_INPUT_THREAD);
+    SDL_ResetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that a large gamepad mapping database can be added and searched
+ *
+ * \sa SDL_AddGamepadMapping
+ * \sa SDL_GetGamepadMappingForGUID
+ */
+static int TestGamepadMappingDatabase(void *arg)
+{
+    const int num_test_mappings = 2048;
+    char guid_string[33];
+    char mapping_string[128];
+    char expected[32];
+    char *mapping;
+    int i, added, num_mappings;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_GAMEPAD) == 0, "SDL_InitSubSystem(SDL_INIT_GAMEPAD)");
+
+    num_mappings = SDL_GetNumGamepadMappings();
+
+    added = 0;
+    for (i = 0; i < num_test_mappings; ++i) {
+        (void)SDL_snprintf(guid_string, sizeof(guid_string), "03000000%04x0000%04x000000000000", (unsigned int)(i + 1), 0xbeefU);
+        (void)SDL_snprintf(mapping_string, sizeof(mapping_string), "%s,Test Mapping %d,a:b0,b:b1,x:b2,y:b3,", guid_string, i);
+        if (SDL_AddGamepadMapping(mapping_string) == 1) {
+            ++added;
+        }
+    }
+    SDLTest_AssertCheck(added == num_test_mappings, "Check added mappings, expected: %d, got: %d", num_test_mappings, added);
+    SDLTest_AssertCheck(SDL_GetNumGamepadMappings() == num_mappings + num_test_mappings,
+                        "Check number of mappings, expected: %d, got: %d", num_mappings + num_test_mappings, SDL_GetNumGamepadMappings());
+
+    for (i = 0; i < num_test_mappings; i += 97) {
+        (void)SDL_snprintf(guid_string, sizeof(guid_string), "03000000%04x0000%04x000000000000", (unsigned int)(i + 1), 0xbeefU);
+        (void)SDL_snprintf(expected, sizeof(expected), ",Test Mapping %d,", i);
+        mapping = SDL_GetGamepadMappingForGUID(SDL_GetJoystickGUIDFromString(guid_string));
+        SDLTest_AssertCheck(mapping && SDL_strstr(mapping, expected), "Check mapping for %s, expected: %s, got: %s", guid_string, expected, mapping ? mapping : "NULL");
+        SDL_free(mapping);
+    }
+
+    /* Adding a mapping for an existing GUID replaces it */
+    (void)SDL_snprintf(guid_string, sizeof(guid_string), "03000000%04x0000%04x000000000000", 1U, 0xbeefU);
+    (void)SDL_snprintf(mapping_string, sizeof(mapping_string), "%s,Replaced Mapping,a:b1,b:b0,", guid_string);
+    SDLTest_AssertCheck(SDL_AddGamepadMapping(mapping_string) == 0, "Check replacing a mapping returns 0");
+    mapping = SDL_GetGamepadMappingForGUID(SDL_GetJoystickGUIDFromString(guid_string));
+    SDLTest_AssertCheck(mapping && SDL_strstr(mapping, ",Replaced Mapping,"), "Check replaced mapping, got: %s", mapping ? mapping : "NULL");
+    SDL_free(mapping);
+
+    /* Reloading discards mappings added by the application */
+    SDL_ReloadGamepadMappings();
+    mapping = SDL_GetGamepadMappingForGUID(SDL_GetJoystickGUIDFromString(guid_string));
+    SDLTest_AssertCheck(mapping == NULL, "Check mapping was discarded after SDL_ReloadGamepadMappings()");
+    SDL_free(mapping);
+
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_Joystick *joystick;
+    SDL_AtomicInt done;
+    int snapshots;
+    int torn_snapshots;
+} JoystickSnapshotReader;
+
+static int SDLCALL JoystickSnapshotThread(void *data)
+{
+    JoystickSnapshotReader *reader = (JoystickSnapshotReader *)data;
+    SDL_JoystickSnapshot snapshot;
+
+    /* Always read at least once, the updates may finish before this thread runs */
+    do {
+        if (SDL_GetJoystickSnapshot(reader->joystick, &snapshot) == 0) {
+            /* Both axes and the button are always changed in the same update */
+            if (snapshot.axes[1] != -snapshot.axes[0] ||
+                snapshot.buttons[0] != (snapshot.axes[0] & 1)) {
+                ++reader->torn_snapshots;
+            }
+            ++reader->snapshots;
+        }
+    } while (!SDL_AtomicGet(&reader->done));
+    return 0;
+}
+
+/**
+ * Check reading joystick snapshots while the joystick is being updated
+ *
+ * \sa SDL_GetJoystickSnapshot
+ */
+static int TestJoystickSnapshot(void *arg)
+{
+    JoystickSnapshotReader reader;
+    SDL_JoystickSnapshot snapshot;
+    SDL_JoystickID device_id;
+    SDL_Thread *thread;
+    Sint16 i;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_JOYSTICK) == 0, "SDL_InitSubSystem(SDL_INIT_JOYSTICK)");
+
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+
+    SDL_zero(reader);
+    device_id = SDL_AttachVirtualJoystick(SDL_JOYSTICK_TYPE_GAMEPAD, 2, 1, 1);
+    SDLTest_AssertCheck(device_id > 0, "SDL_AttachVirtualJoystick()");
+    if (device_id > 0) {
+        reader.joystick = SDL_OpenJoystick(device_id);
+        SDLTest_AssertCheck(reader.joystick != NULL, "SDL_OpenJoystick()");
+    }
+    if (reader.joystick) {
+        SDLTest_AssertCheck(SDL_GetJoystickSnapshot(NULL, &snapshot) == -1, "Check SDL_GetJoystickSnapshot(NULL) fails");
+        SDLTest_AssertCheck(SDL_GetJoystickSnapshot(reader.joystick, NULL) == -1, "Check SDL_GetJoystickSnapshot(snapshot = NULL) fails");
+
+        SDL_SetJoystickVirtualAxis(reader.joystick, 0, 1000);
+        SDL_SetJoystickVirtualAxis(reader.joystick, 1, -1000);
+        SDL_SetJoystickVirtualHat(reader.joystick, 0, SDL_HAT_UP);
+        SDL_UpdateJoysticks();
+        SDLTest_AssertCheck(SDL_GetJoystickSnapshot(reader.joystick, &snapshot) == 0, "SDL_GetJoystickSnapshot()");
+        SDLTest_AssertCheck(snapshot.naxes == 2 && snapshot.nbuttons == 1 && snapshot.nhats == 1,
+                            "Check snapshot counts, expected: 2/1/1, got: %d/%d/%d", snapshot.naxes, snapshot.nbuttons, snapshot.nhats);
+        SDLTest_AssertCheck(snapshot.axes[0] == 1000 && snapshot.axes[1] == -1000, "Check snapshot axes");
+        SDLTest_AssertCheck(snapshot.hats[0] == SDL_HAT_UP, "Check snapshot hat");
+        SDLTest_AssertCheck(snapshot.timestamp != 0, "Check snapshot timestamp");
+
+        thread = SDL_CreateThread(JoystickSnapshotThread, "JoystickSnapshotThread", &reader);
+        SDLTest_AssertCheck(thread != NULL, "SDL_CreateThread()");
+        for (i = 1; i <= 2000; ++i) {
+            SDL_SetJoystickVirtualAxis(reader.joystick, 0, i);
+            SDL_SetJoystickVirtualAxis(reader.joystick, 1, -i);
+            SDL_SetJoystickVirtualButton(reader.joystick, 0, (Uint8)(i & 1));
+            SDL_UpdateJoysticks();
+        }
+        SDL_AtomicSet(&reader.done, 1);
+        SDL_WaitThread(thread, NULL);
+        SDLTest_AssertCheck(reader.snapshots > 0, "Check snapshots were read, got: %d", reader.snapshots);
+        SDLTest_AssertCheck(reader.torn_snapshots == 0, "Check for inconsistent snapshots, expected: 0, got: %d", reader.torn_snapshots);
+
+        SDL_CloseJoystick(reader.joystick);
+    }
+    if (device_id > 0) {
+        SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
+    }
+
+    SDL_ResetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS);
+    SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that setting the whole state of a virtual joystick only sends events for changed controls
+ */
+static int TestVirtualJoystickState(void *arg)
+{
+    SDL_JoystickSnapshot state;
+    SDL_JoystickID device_id;
+    SDL_Joystick *joystick = NULL;
+    SDL_Event events[16];
+    int count;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_JOYSTICK) == 0, "SDL_InitSubSystem(SDL_INIT_JOYSTICK)");
+
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+
+    device_id = SDL_AttachVirtualJoystick(SDL_JOYSTICK_TYPE_GAMEPAD, 4, 3, 1);
+    SDLTest_AssertCheck(device_id > 0, "SDL_AttachVirtualJoystick()");
+    if (device_id > 0) {
+        joystick = SDL_OpenJoystick(device_id);
+        SDLTest_AssertCheck(joystick != NULL, "SDL_OpenJoystick()");
+    }
+    if (joystick) {
+        SDLTest_AssertCheck(SDL_SetJoystickVirtualState(joystick, NULL) == -1, "Check SDL_SetJoystickVirtualState(state = NULL) fails");
+
+        /* Controls the joystick doesn't have are ignored */
+        SDL_zero(state);
+        state.naxes = SDL_JOYSTICK_SNAPSHOT_MAX_AXES;
+        state.axes[0] = 1000;
+        state.axes[3] = -1000;
+        state.nbuttons = 3;
+        state.buttons[1] = SDL_PRESSED;
+        state.nhats = 1;
+        state.hats[0] = SDL_HAT_LEFT;
+        SDLTest_AssertCheck(SDL_SetJoystickVirtualState(joystick, &state) == 0, "SDL_SetJoystickVirtualState()");
+        SDL_UpdateJoysticks();
+        SDLTest_AssertCheck(SDL_GetJoystickAxis(joystick, 0) == 1000 && SDL_GetJoystickAxis(joystick, 3) == -1000, "Check axes were set");
+        SDLTest_AssertCheck(SDL_GetJoystickButton(joystick, 1) == SDL_PRESSED, "Check button was set");
+        SDLTest_AssertCheck(SDL_GetJoystickHat(joystick, 0) == SDL_HAT_LEFT, "Check hat was set");
+
+        /* Only the control that changed sends an event */
+        SDL_FlushEvents(SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_UPDATE_COMPLETE);
+        state.axes[3] = 2000;
+        SDLTest_AssertCheck(SDL_SetJoystickVirtualState(joystick, &state) == 0, "SDL_SetJoystickVirtualState()");
+        SDL_UpdateJoysticks();
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_BUTTON_UP);
+        SDLTest_AssertCheck(count == 1, "Check number of state change events, expected: 1, got: %d", count);
+        SDLTest_AssertCheck(count == 1 && events[0].type == SDL_EVENT_JOYSTICK_AXIS_MOTION && events[0].jaxis.axis == 3 && events[0].jaxis.value == 2000,
+                            "Check axis 3 motion event");
+
+        SDL_CloseJoystick(joystick);
+    }
+    if (device_id > 0) {
+        SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
+    }
+
+    SDL_ResetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS);
+    SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that only the buttons that changed send events when a joystick with many buttons is updated
+ *
+ * \sa SDL_SetJoystickVirtualButton
+ */
+static int TestJoystickChangedButtons(void *arg)
+{
+    static const int pressed[] = { 3, 17, 31, 32, 38 };
+    SDL_JoystickID device_id;
+    SDL_Joystick *joystick = NULL;
+    SDL_Event events[16];
+    int count, i;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_JOYSTICK) == 0, "SDL_InitSubSystem(SDL_INIT_JOYSTICK)");
+
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+
+    device_id = SDL_AttachVirtualJoystick(SDL_JOYSTICK_TYPE_GAMEPAD, 2, 40, 0);
+    SDLTest_AssertCheck(device_id > 0, "SDL_AttachVirtualJoystick()");
+    if (device_id > 0) {
+        joystick = SDL_OpenJoystick(device_id);
+        SDLTest_AssertCheck(joystick != NULL, "SDL_OpenJoystick()");
+    }
+    if (joystick) {
+        SDL_UpdateJoysticks();
+        SDL_FlushEvents(SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_UPDATE_COMPLETE);
+
+        for (i = 0; i < SDL_arraysize(pressed); ++i) {
+            SDL_SetJoystickVirtualButton(joystick, pressed[i], SDL_PRESSED);
+        }
+        SDL_SetJoystickVirtualAxis(joystick, 1, 1000);
+        SDL_UpdateJoysticks();
+        SDL_FlushEvent(SDL_EVENT_JOYSTICK_AXIS_MOTION);
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_JOYSTICK_BUTTON_DOWN, SDL_EVENT_JOYSTICK_BUTTON_UP);
+        SDLTest_AssertCheck(count == SDL_arraysize(pressed), "Check number of button events, expected: %d, got: %d", (int)SDL_arraysize(pressed), count);
+        for (i = 0; i < count && i < SDL_arraysize(pressed); ++i) {
+            SDLTest_AssertCheck(events[i].type == SDL_EVENT_JOYSTICK_BUTTON_DOWN && events[i].jbutton.button == pressed[i],
+                                "Check button %d down event, got button %d", pressed[i], events[i].jbutton.button);
+        }
+        for (i = 0; i < 40; ++i) {
+            SDL_bool expected = (i == 3 || i == 17 || i == 31 || i == 32 || i == 38);
+            if (SDL_GetJoystickButton(joystick, i) != expected) {
+                SDLTest_AssertCheck(SDL_FALSE, "Check button %d state, expected: %d", i, expected);
+            }
+        }
+
+        /* Nothing changed, nothing is sent */
+        SDL_UpdateJoysticks();
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_BUTTON_UP);
+        SDLTest_AssertCheck(count == 0, "Check there are no events without changes, got: %d", count);
+
+        SDL_SetJoystickVirtualButton(joystick, 32, SDL_RELEASED);
+        SDL_SetJoystickVirtualAxis(joystick, 1, 2000);
+        SDL_UpdateJoysticks();
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_BUTTON_UP);
+        SDLTest_AssertCheck(count == 2, "Check number of state change events, expected: 2, got: %d", count);
+        SDLTest_AssertCheck(count == 2 && events[0].type == SDL_EVENT_JOYSTICK_AXIS_MOTION && events[0].jaxis.axis == 1 && events[0].jaxis.value == 2000,
+                            "Check axis 1 motion event");
+        SDLTest_AssertCheck(count == 2 && events[1].type == SDL_EVENT_JOYSTICK_BUTTON_UP && events[1].jbutton.button == 32,
+                            "Check button 32 up event");
+
+        SDL_CloseJoystick(joystick);
+    }
+    if (device_id > 0) {
+        SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
+    }
+
+    SDL_ResetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS);
+    SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+
+    return TEST_COMPLETED;
+}
+
+static size_t AppendGamepadDBString(Uint8 *strings, size_t *strings_size, const char *string)
+{
+    size_t offset = *strings_size;
+
+    SDL_strlcpy((char *)strings + offset, string, SDL_strlen(string) + 1);
+    *strings_size += SDL_strlen(string) + 1;
+    return offset;
+}
+
+static void WriteGamepadDB32(Uint8 *data, Uint32 value)
+{
+    value = SDL_SwapLE32(value);
+    SDL_memcpy(data, &value, sizeof(value));
+}
+
+/**
+ * Check loading a compiled gamepad mapping database
+ *
+ * \sa SDL_AddGamepadMappingsFromRW
+ */
+static int TestGamepadMappingBinaryDatabase(void *arg)
+{
+    const char *guid_string = "03000000efbe0000feca000000000000";
+    const char *other_guid_string = "03000000efbe0000adde000000000000";
+    SDL_JoystickGUID guid = SDL_GetJoystickGUIDFromString(guid_string);
+    SDL_JoystickGUID other_guid = SDL_GetJoystickGUIDFromString(other_guid_string);
+    Uint8 db[512];
+    Uint8 strings[256];
+    char mapping_string[128];
+    size_t strings_size = 0;
+    size_t db_size;
+    Uint8 *entry;
+    char *mapping;
+    int result;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_GAMEPAD) == 0, "SDL_InitSubSystem(SDL_INIT_GAMEPAD)");
+
+    /* One mapping for this platform and one for another platform, which should be skipped */
+    SDL_zeroa(db);
+    SDL_memcpy(db, "SDLGPDB", 8);
+    WriteGamepadDB32(&db[8], 1);
+    WriteGamepadDB32(&db[12], 2);
+    entry = &db[20];
+    SDL_memcpy(entry, guid.data, sizeof(guid.data));
+    WriteGamepadDB32(&entry[20], (Uint32)AppendGamepadDBString(strings, &strings_size, "Binary Mapping"));
+    (void)SDL_snprintf(mapping_string, sizeof(mapping_string), "a:b0,b:b1,platform:%s,", SDL_GetPlatform());
+    WriteGamepadDB32(&entry[24], (Uint32)AppendGamepadDBString(strings, &strings_size, mapping_string));
+    WriteGamepadDB32(&entry[28], (Uint32)AppendGamepadDBString(strings, &strings_size, SDL_GetPlatform()));
+    entry += 32;
+    SDL_memcpy(entry, other_guid.data, sizeof(other_guid.data));
+    WriteGamepadDB32(&entry[20], (Uint32)AppendGamepadDBString(strings, &strings_size, "Other Mapping"));
+    WriteGamepadDB32(&entry[24], (Uint32)AppendGamepadDBString(strings, &strings_size, "a:b0,b:b1,platform:Other,"));
+    WriteGamepadDB32(&entry[28], (Uint32)AppendGamepadDBString(strings, &strings_size, "Other"));
+    entry += 32;
+    WriteGamepadDB32(&db[16], (Uint32)strings_size);
+    SDL_memcpy(entry, strings, strings_size);
+    db_size = (entry - db) + strings_size;
+
+    result = SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, db_size), SDL_TRUE);
+    SDLTest_AssertCheck(result == 1, "Check SDL_AddGamepadMappingsFromRW(), expected: 1, got: %d", result);
+    mapping = SDL_GetGamepadMappingForGUID(guid);
+    SDLTest_AssertCheck(mapping && SDL_strstr(mapping, ",Binary Mapping,a:b0,b:b1,"), "Check mapping for %s, got: %s", guid_string, mapping ? mapping : "NULL");
+    SDL_free(mapping);
+    mapping = SDL_GetGamepadMappingForGUID(other_guid);
+    SDLTest_AssertCheck(mapping == NULL, "Check mapping for another platform was skipped");
+    SDL_free(mapping);
+
+    /* A truncated database is rejected */
+    result = SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, db_size - 1), SDL_TRUE);
+    SDLTest_AssertCheck(result == -1, "Check truncated database, expected: -1, got: %d", result);
+
+    SDL_ReloadGamepadMappings();
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Joystick routine test cases */
@@ -133,9 +546,39 @@ static const SDLTest_TestCaseReference joystickTest1 = {
     (SDLTest_TestCaseFp)TestVirtualJoystick, "TestVirtualJoystick", "Test virtual joystick functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference joystickTest2 = {
+    (SDLTest_TestCaseFp)TestInputThread, "TestInputThread", "Test updating joysticks on the input thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference joystickTest3 = {
+    (SDLTest_TestCaseFp)TestGamepadMappingDatabase, "TestGamepadMappingDatabase", "Test adding and searching a large gamepad mapping database", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference joystickTest4 = {
+    (SDLTest_TestCaseFp)TestGamepadMappingBinaryDatabase, "TestGamepadMappingBinaryDatabase", "Test loading a compiled gamepad mapping database", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference joystickTest5 = {
+    (SDLTest_TestCaseFp)TestJoystickSnapshot, "TestJoystickSnapshot", "Test reading joystick snapshots from another thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference joystickTest6 = {
+    (SDLTest_TestCaseFp)TestVirtualJoystickState, "TestVirtualJoystickState", "Test setting the whole state of a virtual joystick", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference joystickTest7 = {
+    (SDLTest_TestCaseFp)TestJoystickChangedButtons, "TestJoystickChangedButtons", "Test that only changed buttons send events", TEST_ENABLED
+};
+
 /* Sequence of Joystick routine test cases */
 static const SDLTest_TestCaseReference *joystickTests[] = {
     &joystickTest1,
+    &joystickTest2,
+    &joystickTest3,
+    &joystickTest4,
+    &joystickTest5,
+    &joystickTest6,
+    &joystickTest7,
     NULL
 };
 
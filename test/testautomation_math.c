@@ -2785,6 +2785,118 @@ atan2_bottomLeftQuadrantTest(void *args)
     return helper_ddtod_inexact("SDL_atan2", SDL_atan2, bottom_left_cases, SDL_arraysize(bottom_left_cases));
 }
 
+/* SDL_sincosf and array tests functions */
+
+/**
+ * Inputs: Angles from -100 to 100, large angles and non-finite values.
+ * Expected: The same sine and cosine as SDL_sinf() and SDL_cosf().
+ */
+static int
+sincosf_precisionTest(void *args)
+{
+    const float special_cases[] = { 10000.0f, -123456.0f, 1.0e20f, INFINITY, -INFINITY };
+    float x, s, c;
+    int i;
+
+    for (x = -100.0f; x <= 100.0f; x += 0.0371f) {
+        SDL_sincosf(x, &s, &c);
+        if (SDL_fabsf(s - SDL_sinf(x)) > 1.0e-6f || SDL_fabsf(c - SDL_cosf(x)) > 1.0e-6f) {
+            SDLTest_AssertCheck(SDL_FALSE, "SDL_sincosf(%f), expected (%f, %f), got (%f, %f)",
+                                x, SDL_sinf(x), SDL_cosf(x), s, c);
+            return TEST_ABORTED;
+        }
+    }
+    SDLTest_AssertPass("SDL_sincosf() matches SDL_sinf() and SDL_cosf() from -100 to 100");
+
+    for (i = 0; i < SDL_arraysize(special_cases); ++i) {
+        x = special_cases[i];
+        SDL_sincosf(x, &s, &c);
+        SDLTest_AssertCheck((s == SDL_sinf(x) || (isnan(s) && isnan(SDL_sinf(x)))) &&
+                            (c == SDL_cosf(x) || (isnan(c) && isnan(SDL_cosf(x)))),
+                            "SDL_sincosf(%f), expected (%f, %f), got (%f, %f)",
+                            x, SDL_sinf(x), SDL_cosf(x), s, c);
+    }
+
+    SDL_sincosf(NAN, &s, &c);
+    SDLTest_AssertCheck(isnan(s) && isnan(c), "SDL_sincosf(NAN), expected (NAN, NAN), got (%f, %f)", s, c);
+
+    s = 2.0f;
+    SDL_sincosf(0.0f, &s, NULL);
+    SDLTest_AssertCheck(s == 0.0f, "SDL_sincosf(0.0, &s, NULL), expected 0.0, got %f", s);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Inputs: An array whose length isn't a multiple of the SIMD width, including
+ *         values the vector code can't handle.
+ * Expected: The same results as calling the scalar functions on each value.
+ */
+static int
+array_precisionTest(void *args)
+{
+    float src[1027], dst[1027], expected;
+    int i;
+    SDL_bool ok;
+
+    for (i = 0; i < SDL_arraysize(src); ++i) {
+        src[i] = -95.0f + i * 0.1831f;
+    }
+    src[5] = INFINITY;
+    src[6] = -INFINITY;
+    src[7] = 20000.0f;
+    src[8] = -300.0f;
+
+    SDL_sinf_array(src, dst, SDL_arraysize(src));
+    ok = SDL_TRUE;
+    for (i = 0; ok && i < SDL_arraysize(src); ++i) {
+        expected = SDL_sinf(src[i]);
+        if (!(SDL_fabsf(dst[i] - expected) <= 1.0e-6f) && !(isnan(dst[i]) && isnan(expected))) {
+            SDLTest_AssertCheck(SDL_FALSE, "SDL_sinf_array(): sin(%f), expected %f, got %f", src[i], expected, dst[i]);
+            ok = SDL_FALSE;
+        }
+    }
+    SDLTest_AssertCheck(ok, "SDL_sinf_array() matches SDL_sinf()");
+
+    SDL_cosf_array(src, dst, SDL_arraysize(src));
+    ok = SDL_TRUE;
+    for (i = 0; ok && i < SDL_arraysize(src); ++i) {
+        expected = SDL_cosf(src[i]);
+        if (!(SDL_fabsf(dst[i] - expected) <= 1.0e-6f) && !(isnan(dst[i]) && isnan(expected))) {
+            SDLTest_AssertCheck(SDL_FALSE, "SDL_cosf_array(): cos(%f), expected %f, got %f", src[i], expected, dst[i]);
+            ok = SDL_FALSE;
+        }
+    }
+    SDLTest_AssertCheck(ok, "SDL_cosf_array() matches SDL_cosf()");
+
+    SDL_expf_array(src, dst, SDL_arraysize(src));
+    ok = SDL_TRUE;
+    for (i = 0; ok && i < SDL_arraysize(src); ++i) {
+        expected = SDL_expf(src[i]);
+        if (!(SDL_fabsf(dst[i] - expected) <= 1.0e-6f * expected) && dst[i] != expected) {
+            SDLTest_AssertCheck(SDL_FALSE, "SDL_expf_array(): exp(%f), expected %g, got %g", src[i], expected, dst[i]);
+            ok = SDL_FALSE;
+        }
+    }
+    SDLTest_AssertCheck(ok, "SDL_expf_array() matches SDL_expf()");
+
+    /* In place */
+    SDL_memcpy(dst, src, sizeof(src));
+    SDL_sinf_array(dst, dst, SDL_arraysize(dst));
+    ok = SDL_TRUE;
+    for (i = 0; ok && i < SDL_arraysize(src); ++i) {
+        float s;
+        SDL_sincosf(src[i], &s, NULL);
+        if (dst[i] != s && !(isnan(dst[i]) && isnan(s))) {
+            SDLTest_AssertCheck(SDL_FALSE, "SDL_sinf_array() in place: sin(%f), expected %f, got %f", src[i], s, dst[i]);
+            ok = SDL_FALSE;
+        }
+    }
+    SDLTest_AssertCheck(ok, "SDL_sinf_array() works in place and matches SDL_sincosf()");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* SDL_floor test cases */
@@ -3314,6 +3426,17 @@ static const SDLTest_TestCaseReference atan2TestQuadrantBottomLeft = {
     "Checks values in the bottom left quadrant", TEST_ENABLED
 };
 
+/* SDL_sincosf and array test cases */
+
+static const SDLTest_TestCaseReference sincosfTestPrecision = {
+    (SDLTest_TestCaseFp)sincosf_precisionTest, "sincosf_precisionTest",
+    "Checks SDL_sincosf against SDL_sinf and SDL_cosf", TEST_ENABLED
+};
+static const SDLTest_TestCaseReference arrayTestPrecision = {
+    (SDLTest_TestCaseFp)array_precisionTest, "array_precisionTest",
+    "Checks the array functions against the scalar ones", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference *mathTests[] = {
     &floorTestInf, &floorTestZero, &floorTestNan,
     &floorTestRound, &floorTestFraction, &floorTestRange,
@@ -3376,6 +3499,8 @@ static const SDLTest_TestCaseReference *mathTests[] = {
     &atan2TestNan, &atan2TestQuadrantTopRight, &atan2TestQuadrantTopLeft,
     &atan2TestQuadrantBottomRight, &atan2TestQuadrantBottomLeft,
 
+    &sincosfTestPrecision, &arrayTestPrecision,
+
     NULL
 };
 
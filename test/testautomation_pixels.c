@@ -45,13 +45,24 @@ static const Uint32 g_AllFormats[] = {
     SDL_PIXELFORMAT_XBGR2101010,
     SDL_PIXELFORMAT_ARGB2101010,
     SDL_PIXELFORMAT_ABGR2101010,
+    SDL_PIXELFORMAT_RGBA64_FLOAT,
+    SDL_PIXELFORMAT_ARGB64_FLOAT,
+    SDL_PIXELFORMAT_BGRA64_FLOAT,
+    SDL_PIXELFORMAT_ABGR64_FLOAT,
+    SDL_PIXELFORMAT_RGBA128_FLOAT,
+    SDL_PIXELFORMAT_ARGB128_FLOAT,
+    SDL_PIXELFORMAT_BGRA128_FLOAT,
+    SDL_PIXELFORMAT_ABGR128_FLOAT,
     SDL_PIXELFORMAT_YV12,
     SDL_PIXELFORMAT_IYUV,
     SDL_PIXELFORMAT_YUY2,
     SDL_PIXELFORMAT_UYVY,
     SDL_PIXELFORMAT_YVYU,
     SDL_PIXELFORMAT_NV12,
-    SDL_PIXELFORMAT_NV21
+    SDL_PIXELFORMAT_NV21,
+    SDL_PIXELFORMAT_P010,
+    SDL_PIXELFORMAT_P016,
+    SDL_PIXELFORMAT_I444
 };
 static const int g_numAllFormats = SDL_arraysize(g_AllFormats);
 
@@ -92,13 +103,24 @@ static const char *g_AllFormatsVerbose[] = {
     "SDL_PIXELFORMAT_XBGR2101010",
     "SDL_PIXELFORMAT_ARGB2101010",
     "SDL_PIXELFORMAT_ABGR2101010",
+    "SDL_PIXELFORMAT_RGBA64_FLOAT",
+    "SDL_PIXELFORMAT_ARGB64_FLOAT",
+    "SDL_PIXELFORMAT_BGRA64_FLOAT",
+    "SDL_PIXELFORMAT_ABGR64_FLOAT",
+    "SDL_PIXELFORMAT_RGBA128_FLOAT",
+    "SDL_PIXELFORMAT_ARGB128_FLOAT",
+    "SDL_PIXELFORMAT_BGRA128_FLOAT",
+    "SDL_PIXELFORMAT_ABGR128_FLOAT",
     "SDL_PIXELFORMAT_YV12",
     "SDL_PIXELFORMAT_IYUV",
     "SDL_PIXELFORMAT_YUY2",
     "SDL_PIXELFORMAT_UYVY",
     "SDL_PIXELFORMAT_YVYU",
     "SDL_PIXELFORMAT_NV12",
-    "SDL_PIXELFORMAT_NV21"
+    "SDL_PIXELFORMAT_NV21",
+    "SDL_PIXELFORMAT_P010",
+    "SDL_PIXELFORMAT_P016",
+    "SDL_PIXELFORMAT_I444"
 };
 
 /* Definition of some invalid formats for negative tests */
@@ -164,7 +186,7 @@ static int pixels_allocFreeFormat(void *arg)
             if (!SDL_ISPIXELFORMAT_FOURCC(format)) {
                 SDLTest_AssertCheck(result->BitsPerPixel > 0, "Verify value of result.BitsPerPixel; expected: >0, got %u", result->BitsPerPixel);
                 SDLTest_AssertCheck(result->BytesPerPixel > 0, "Verify value of result.BytesPerPixel; expected: >0, got %u", result->BytesPerPixel);
-                if (!SDL_ISPIXELFORMAT_INDEXED(format)) {
+                if (!SDL_ISPIXELFORMAT_INDEXED(format) && !SDL_ISPIXELFORMAT_FLOAT(format)) {
                     masks = result->Rmask | result->Gmask | result->Bmask | result->Amask;
                     SDLTest_AssertCheck(masks > 0, "Verify value of result.[RGBA]mask combined; expected: >0, got %" SDL_PRIu32, masks);
                 }
@@ -359,6 +381,285 @@ static int pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_ConvertPixels from the 8888 formats to planar YUV formats
+ *
+ * \sa SDL_ConvertPixels
+ */
+static int pixels_convertRGBToYUV(void *arg)
+{
+    static const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGBX8888, SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGRX8888
+    };
+    const int w = 70, h = 37, pitch = w * 4;
+    const int uv_w = (w + 1) / 2, uv_h = (h + 1) / 2;
+    const int yuv_size = w * h + 2 * uv_w * uv_h;
+    const SDL_YUV_CONVERSION_MODE mode = SDL_GetYUVConversionMode();
+    Uint32 *argb = (Uint32 *)SDL_malloc(pitch * h);
+    Uint32 *src = (Uint32 *)SDL_malloc(pitch * h);
+    Uint8 *expected = (Uint8 *)SDL_malloc(yuv_size);
+    Uint8 *actual = (Uint8 *)SDL_malloc(yuv_size);
+    Uint8 *strip = (Uint8 *)SDL_malloc(2 * h + 2 * uv_h);
+    int x, y, i, ret, mismatches;
+
+    SDLTest_AssertCheck(argb && src && expected && actual && strip, "Verify buffers were allocated");
+    if (!argb || !src || !expected || !actual || !strip) {
+        goto done;
+    }
+    SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_BT601);
+
+    /* Solid white converts to video range white */
+    for (i = 0; i < w * h; i++) {
+        argb[i] = 0xFFFFFFFF;
+    }
+    ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, argb, pitch, SDL_PIXELFORMAT_IYUV, actual, w);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+    mismatches = 0;
+    for (i = 0; i < yuv_size; i++) {
+        if (actual[i] != ((i < w * h) ? 235 : 128)) {
+            mismatches++;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify white converts to Y=235 U=V=128, %d mismatches", mismatches);
+
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            const Uint32 r = (x * 7 + y * 3) & 0xFF, g = (x * x + y * 5) & 0xFF, b = (x * y + 13) & 0xFF;
+            argb[y * w + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    /* Narrow strips take the C path, so each one checks a slice of the full conversion */
+    ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, argb, pitch, SDL_PIXELFORMAT_IYUV, expected, w);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+    mismatches = 0;
+    for (x = 0; x < w; x += 2) {
+        ret = SDL_ConvertPixels(2, h, SDL_PIXELFORMAT_ARGB8888, argb + x, pitch, SDL_PIXELFORMAT_IYUV, strip, 2);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        for (y = 0; y < h; y++) {
+            mismatches += (strip[y * 2] != expected[y * w + x]);
+            mismatches += (strip[y * 2 + 1] != expected[y * w + x + 1]);
+        }
+        for (y = 0; y < uv_h; y++) {
+            mismatches += (strip[2 * h + y] != expected[w * h + y * uv_w + x / 2]);
+            mismatches += (strip[2 * h + uv_h + y] != expected[w * h + uv_w * uv_h + y * uv_w + x / 2]);
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify full rows match narrow strips, %d mismatches", mismatches);
+
+    /* Every 8888 format is read directly and gives the same result */
+    for (i = 0; i < (int)SDL_arraysize(formats); i++) {
+        const char *name = SDL_GetPixelFormatName(formats[i]);
+        int j;
+
+        ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, argb, pitch, formats[i], src, pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+
+        ret = SDL_ConvertPixels(w, h, formats[i], src, pitch, SDL_PIXELFORMAT_IYUV, actual, w);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        SDLTest_AssertCheck(SDL_memcmp(actual, expected, yuv_size) == 0, "Verify %s to IYUV", name);
+
+        ret = SDL_ConvertPixels(w, h, formats[i], src, pitch, SDL_PIXELFORMAT_YV12, actual, w);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        SDLTest_AssertCheck(SDL_memcmp(actual, expected, w * h) == 0 &&
+                                SDL_memcmp(actual + w * h, expected + w * h + uv_w * uv_h, uv_w * uv_h) == 0 &&
+                                SDL_memcmp(actual + w * h + uv_w * uv_h, expected + w * h, uv_w * uv_h) == 0,
+                            "Verify %s to YV12", name);
+
+        for (j = 0; j < 2; j++) {
+            const Uint32 nv = j ? SDL_PIXELFORMAT_NV21 : SDL_PIXELFORMAT_NV12;
+            const Uint8 *first = expected + w * h + (j ? uv_w * uv_h : 0);
+            const Uint8 *second = expected + w * h + (j ? 0 : uv_w * uv_h);
+
+            ret = SDL_ConvertPixels(w, h, formats[i], src, pitch, nv, actual, w);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+            mismatches = (SDL_memcmp(actual, expected, w * h) != 0);
+            for (x = 0; x < uv_w * uv_h; x++) {
+                mismatches += (actual[w * h + x * 2] != first[x]);
+                mismatches += (actual[w * h + x * 2 + 1] != second[x]);
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify %s to %s, %d mismatches", name, SDL_GetPixelFormatName(nv), mismatches);
+        }
+    }
+
+done:
+    SDL_SetYUVConversionMode(mode);
+    SDL_free(argb);
+    SDL_free(src);
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_free(strip);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_ConvertPixels from YUV formats, split into bands on several threads
+ *
+ * \sa SDL_ConvertPixels
+ */
+static int pixels_convertYUVThreaded(void *arg)
+{
+    static const Uint32 conversions[][2] = {
+        { SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_RGB24 },
+        { SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_XRGB2101010 },
+        { SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_NV12 },
+        { SDL_PIXELFORMAT_NV21, SDL_PIXELFORMAT_UYVY },
+        { SDL_PIXELFORMAT_YVYU, SDL_PIXELFORMAT_YUY2 },
+        { SDL_PIXELFORMAT_P010, SDL_PIXELFORMAT_XRGB2101010 },
+        { SDL_PIXELFORMAT_I444, SDL_PIXELFORMAT_ABGR8888 }
+    };
+    /* An odd height leaves an odd last band */
+    const int w = 640, h = 517;
+    const size_t size = (size_t)w * 4 * h;
+    Uint8 *src = (Uint8 *)SDL_malloc(size);
+    Uint8 *expected = (Uint8 *)SDL_malloc(size);
+    Uint8 *actual = (Uint8 *)SDL_malloc(size);
+    size_t i;
+
+    SDLTest_AssertCheck(src && expected && actual, "Verify buffers were allocated");
+    if (!src || !expected || !actual) {
+        goto done;
+    }
+    for (i = 0; i < size; i++) {
+        src[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    }
+
+    for (i = 0; i < SDL_arraysize(conversions); i++) {
+        const Uint32 src_format = conversions[i][0], dst_format = conversions[i][1];
+        const int src_pitch = w * SDL_BYTESPERPIXEL(src_format);
+        const int dst_pitch = w * SDL_BYTESPERPIXEL(dst_format);
+        int ret;
+
+        SDL_memset(expected, 0xCD, size);
+        SDL_memset(actual, 0xCD, size);
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        ret = SDL_ConvertPixels(w, h, src_format, src, src_pitch, dst_format, expected, dst_pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+        ret = SDL_ConvertPixels(w, h, src_format, src, src_pitch, dst_format, actual, dst_pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        SDLTest_AssertCheck(SDL_memcmp(actual, expected, size) == 0,
+                            "Verify threaded %s to %s matches a single thread",
+                            SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+    }
+
+done:
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    SDL_free(src);
+    SDL_free(expected);
+    SDL_free(actual);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_ConvertPixels between RGB and the 16-bit and 4:4:4 YUV formats
+ *
+ * \sa SDL_ConvertPixels
+ */
+static int pixels_convertHighDepthYUV(void *arg)
+{
+    static const Uint32 formats[] = { SDL_PIXELFORMAT_P010, SDL_PIXELFORMAT_P016, SDL_PIXELFORMAT_I444 };
+    const int w = 70, h = 9, pitch = w * 4;
+    const int yuv_size = w * h * 4;
+    const SDL_YUV_CONVERSION_MODE mode = SDL_GetYUVConversionMode();
+    Uint32 *argb = (Uint32 *)SDL_malloc(pitch * h);
+    Uint32 *expected = (Uint32 *)SDL_malloc(pitch * h);
+    Uint32 *actual = (Uint32 *)SDL_malloc(pitch * h);
+    Uint8 *yuv = (Uint8 *)SDL_malloc(yuv_size);
+    Uint8 *strip = (Uint8 *)SDL_malloc(yuv_size);
+    Uint16 white[6];
+    int x, y, i, ret, mismatches;
+
+    SDLTest_AssertCheck(argb && expected && actual && yuv && strip, "Verify buffers were allocated");
+    if (!argb || !expected || !actual || !yuv || !strip) {
+        goto done;
+    }
+    SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_BT601);
+
+    /* Video range white in P010 keeps its full 10 bits in 2101010 formats */
+    for (i = 0; i < 4; i++) {
+        white[i] = SDL_SwapLE16(940 << 6);
+    }
+    white[4] = white[5] = SDL_SwapLE16(512 << 6);
+    ret = SDL_ConvertPixels(2, 2, SDL_PIXELFORMAT_P010, white, 4, SDL_PIXELFORMAT_ARGB8888, actual, 8);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+    SDLTest_AssertCheck(actual[0] == 0xFFFFFFFF && actual[3] == 0xFFFFFFFF, "Verify P010 white to ARGB8888, got: 0x%.8" SDL_PRIx32, actual[0]);
+    ret = SDL_ConvertPixels(2, 2, SDL_PIXELFORMAT_P010, white, 4, SDL_PIXELFORMAT_XRGB2101010, actual, 8);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+    SDLTest_AssertCheck((actual[0] & 0x3FFFFFFF) == 0x3FFFFFFF && (actual[3] & 0x3FFFFFFF) == 0x3FFFFFFF,
+                        "Verify P010 white to XRGB2101010, got: 0x%.8" SDL_PRIx32, actual[0]);
+
+    /* Narrow strips take the C path, so each one checks a slice of the full conversion */
+    for (i = 0; i < yuv_size; i++) {
+        yuv[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    }
+    for (i = 0; i < (int)SDL_arraysize(formats); i++) {
+        const int bpp = SDL_BYTESPERPIXEL(formats[i]);
+        const int planes = (formats[i] == SDL_PIXELFORMAT_I444) ? 3 : 1;
+
+        ret = SDL_ConvertPixels(w, h, formats[i], yuv, w * bpp, SDL_PIXELFORMAT_ARGB2101010, expected, pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        mismatches = 0;
+        for (x = 0; x < w; x += 2) {
+            for (y = 0; y < h * planes; y++) {
+                SDL_memcpy(strip + y * 2 * bpp, yuv + y * w * bpp + x * bpp, 2 * bpp);
+            }
+            if (planes == 1) {
+                for (y = 0; y < (h + 1) / 2; y++) {
+                    SDL_memcpy(strip + (h + y) * 4, yuv + (h + y) * w * 2 + x * 2, 4);
+                }
+            }
+            ret = SDL_ConvertPixels(2, h, formats[i], strip, 2 * bpp, SDL_PIXELFORMAT_ARGB2101010, actual, 8);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+            for (y = 0; y < h; y++) {
+                mismatches += (actual[y * 2] != expected[y * w + x]);
+                mismatches += (actual[y * 2 + 1] != expected[y * w + x + 1]);
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify %s full rows match narrow strips, %d mismatches",
+                            SDL_GetPixelFormatName(formats[i]), mismatches);
+    }
+
+    /* Colors that are constant over each 2x2 block survive the chroma subsampling */
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            const Uint32 r = (x / 2 * 7 + y / 2 * 29) & 0xFF, g = (x / 2 * 13) & 0xFF, b = (y / 2 * 41 + 5) & 0xFF;
+            argb[y * w + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+    for (i = 0; i < (int)SDL_arraysize(formats); i++) {
+        const int yuv_pitch = w * SDL_BYTESPERPIXEL(formats[i]);
+        int max_diff = 0;
+
+        ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, argb, pitch, formats[i], yuv, yuv_pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        ret = SDL_ConvertPixels(w, h, formats[i], yuv, yuv_pitch, SDL_PIXELFORMAT_ARGB8888, actual, pitch);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %d", ret);
+        for (x = 0; x < w * h; x++) {
+            int shift;
+            for (shift = 0; shift < 32; shift += 8) {
+                const int diff = SDL_abs((int)((argb[x] >> shift) & 0xFF) - (int)((actual[x] >> shift) & 0xFF));
+                max_diff = SDL_max(max_diff, diff);
+            }
+        }
+        SDLTest_AssertCheck(max_diff <= 3, "Verify ARGB8888 round trip through %s, max difference %d",
+                            SDL_GetPixelFormatName(formats[i]), max_diff);
+    }
+
+done:
+    SDL_SetYUVConversionMode(mode);
+    SDL_free(argb);
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_free(yuv);
+    SDL_free(strip);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -374,9 +675,21 @@ static const SDLTest_TestCaseReference pixelsTest3 = {
     (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTest4 = {
+    (SDLTest_TestCaseFp)pixels_convertRGBToYUV, "pixels_convertRGBToYUV", "Call to SDL_ConvertPixels from 8888 formats to YUV", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest5 = {
+    (SDLTest_TestCaseFp)pixels_convertYUVThreaded, "pixels_convertYUVThreaded", "Call to SDL_ConvertPixels from YUV formats on several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest6 = {
+    (SDLTest_TestCaseFp)pixels_convertHighDepthYUV, "pixels_convertHighDepthYUV", "Call to SDL_ConvertPixels between RGB and P010, P016 and I444", TEST_ENABLED
+};
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] = {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, NULL
 };
 
 /* Pixels test suite (global) */
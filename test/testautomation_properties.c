@@ -250,6 +250,54 @@ static int properties_testCleanup(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test destroying properties from inside a property cleanup
+ */
+static void SDLCALL cleanup_destroy(void *userdata, void *value)
+{
+    SDL_DestroyProperties((SDL_PropertiesID)(uintptr_t)userdata);
+}
+static int properties_testCleanupDestroy(void *arg)
+{
+    SDL_PropertiesID props[64];
+    SDL_PropertiesID fresh[64];
+    int i, missing = 0, wrong = 0;
+
+    for (i = 0; i < SDL_arraysize(props); ++i) {
+        props[i] = SDL_CreateProperties();
+        SDL_SetProperty(props[i], "self", &props[i]);
+    }
+    for (i = 0; i < SDL_arraysize(props) - 1; ++i) {
+        SDL_SetPropertyWithCleanup(props[i], "next", &props[i + 1], cleanup_destroy, (void *)(uintptr_t)props[i + 1]);
+    }
+
+    /* Destroying the first one destroys the rest from inside the cleanups */
+    SDLTest_AssertPass("Call to SDL_DestroyProperties()");
+    SDL_DestroyProperties(props[0]);
+    for (i = 0; i < SDL_arraysize(props); ++i) {
+        if (SDL_GetProperty(props[i], "self", NULL) != NULL) {
+            ++missing;
+        }
+    }
+    SDLTest_AssertCheck(missing == 0,
+        "Verify all properties were destroyed, got %d remaining", missing);
+
+    for (i = 0; i < SDL_arraysize(fresh); ++i) {
+        fresh[i] = SDL_CreateProperties();
+        SDL_SetProperty(fresh[i], "self", &fresh[i]);
+    }
+    for (i = 0; i < SDL_arraysize(fresh); ++i) {
+        if (SDL_GetProperty(fresh[i], "self", NULL) != &fresh[i]) {
+            ++wrong;
+        }
+        SDL_DestroyProperties(fresh[i]);
+    }
+    SDLTest_AssertCheck(wrong == 0,
+        "Verify properties created afterwards work, got %d wrong", wrong);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Test locking functionality
  */
@@ -321,6 +369,177 @@ static int properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+static void SDLCALL count_all_properties(void *userdata, SDL_PropertiesID props, const char *name)
+{
+    int *count = (int *)userdata;
+    ++(*count);
+}
+
+/**
+ * Test many properties, growing and shrinking the table
+ */
+static int properties_testMany(void *arg)
+{
+    const int num_properties = 1000;
+    SDL_PropertiesID props;
+    char key[32];
+    int i, count, mismatches;
+
+    props = SDL_CreateProperties();
+    SDLTest_AssertPass("Call to SDL_CreateProperties()");
+    SDLTest_AssertCheck(props != 0,
+        "Verify props were created, got: %" SDL_PRIu32 "", props);
+
+    for (i = 0; i < num_properties; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "property.%d", i);
+        SDL_SetNumberProperty(props, key, i);
+    }
+    SDLTest_AssertPass("Call to SDL_SetNumberProperty() %d times", num_properties);
+
+    mismatches = 0;
+    for (i = 0; i < num_properties; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "property.%d", i);
+        if (SDL_GetNumberProperty(props, key, -1) != i) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0,
+        "Verify all properties were found, got %d mismatches", mismatches);
+
+    /* Remove every other property, which moves the others around in the table */
+    for (i = 0; i < num_properties; i += 2) {
+        SDL_snprintf(key, SDL_arraysize(key), "property.%d", i);
+        SDL_ClearProperty(props, key);
+    }
+    SDLTest_AssertPass("Call to SDL_ClearProperty() %d times", num_properties / 2);
+
+    mismatches = 0;
+    for (i = 0; i < num_properties; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "property.%d", i);
+        if (SDL_GetNumberProperty(props, key, -1) != ((i % 2) ? i : -1)) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0,
+        "Verify the remaining properties were found, got %d mismatches", mismatches);
+
+    count = 0;
+    SDL_EnumerateProperties(props, count_all_properties, &count);
+    SDLTest_AssertCheck(count == num_properties / 2,
+            "Verify property count, expected %d, got: %d", num_properties / 2, count);
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test reading properties from several threads and stale property IDs
+ */
+struct properties_reader_data
+{
+    SDL_PropertiesID props;
+    int mismatches;
+};
+static int properties_reader_thread(void *arg)
+{
+    struct properties_reader_data *data = (struct properties_reader_data *)arg;
+    int i;
+
+    for (i = 0; i < 10000; ++i) {
+        const char *string = SDL_GetStringProperty(data->props, "number", NULL);
+        if (!string || SDL_strcmp(string, "42") != 0) {
+            ++data->mismatches;
+        }
+        if (SDL_GetNumberProperty(data->props, "number", -1) != 42) {
+            ++data->mismatches;
+        }
+    }
+    return 0;
+}
+static int properties_testReaders(void *arg)
+{
+    struct properties_reader_data data[4];
+    SDL_Thread *threads[SDL_arraysize(data)];
+    SDL_PropertiesID props, stale;
+    int i;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "number", 42);
+    for (i = 0; i < SDL_arraysize(data); ++i) {
+        data[i].props = props;
+        data[i].mismatches = 0;
+        threads[i] = SDL_CreateThread(properties_reader_thread, "properties_reader", &data[i]);
+    }
+    for (i = 0; i < SDL_arraysize(data); ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        SDLTest_AssertCheck(data[i].mismatches == 0,
+            "Verify reader thread %d read the right values, got %d mismatches", i, data[i].mismatches);
+    }
+
+    /* Setting an existing property replaces its value */
+    SDL_SetStringProperty(props, "number", "100");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "number", -1) == 100,
+        "Verify replaced property, got: %" SDL_PRIs64 "", SDL_GetNumberProperty(props, "number", -1));
+    SDL_DestroyProperties(props);
+
+    /* A destroyed ID shouldn't find properties that reuse its memory */
+    stale = props;
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "number", 42);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(stale, "number", -1) == -1,
+        "Verify destroyed properties aren't found, got: %" SDL_PRIs64 "", SDL_GetNumberProperty(stale, "number", -1));
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test interned property keys
+ */
+static int properties_testKeys(void *arg)
+{
+    const SDL_PropertyKey *key;
+    SDL_PropertiesID props;
+    char name[32];
+
+    key = SDL_GetPropertyKey("number");
+    SDLTest_AssertPass("Call to SDL_GetPropertyKey()");
+    SDLTest_AssertCheck(key != NULL, "Verify key was created");
+    SDL_strlcpy(name, "number", sizeof(name));
+    SDLTest_AssertCheck(SDL_GetPropertyKey(name) == key, "Verify the same name gets the same key");
+    SDLTest_AssertCheck(SDL_strcmp(SDL_GetPropertyKeyName(key), "number") == 0,
+        "Verify key name, got: %s", SDL_GetPropertyKeyName(key));
+    SDLTest_AssertCheck(SDL_GetPropertyKey("") == NULL, "Verify empty names don't have a key");
+
+    props = SDL_CreateProperties();
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByKey(props, key, -1) == -1,
+        "Verify unset property by key, got: %" SDL_PRIs64 "", SDL_GetNumberPropertyByKey(props, key, -1));
+
+    SDL_SetNumberProperty(props, "number", 1);
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByKey(props, key, -1) == 1,
+        "Verify number property by key, got: %" SDL_PRIs64 "", SDL_GetNumberPropertyByKey(props, key, -1));
+    SDLTest_AssertCheck(SDL_GetFloatPropertyByKey(props, key, -1.0f) == 1.0f,
+        "Verify float property by key, got: %f", SDL_GetFloatPropertyByKey(props, key, -1.0f));
+    SDLTest_AssertCheck(SDL_GetBooleanPropertyByKey(props, key, SDL_FALSE) == SDL_TRUE,
+        "Verify boolean property by key");
+    SDLTest_AssertCheck(SDL_strcmp(SDL_GetStringPropertyByKey(props, key, ""), "1") == 0,
+        "Verify string property by key, got: %s", SDL_GetStringPropertyByKey(props, key, ""));
+    SDLTest_AssertCheck(SDL_GetPropertyByKey(props, key, NULL) == NULL,
+        "Verify number property isn't a pointer property");
+
+    SDL_ClearProperty(props, "number");
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByKey(props, key, -1) == -1,
+        "Verify cleared property by key, got: %" SDL_PRIs64 "", SDL_GetNumberPropertyByKey(props, key, -1));
+
+    SDL_SetProperty(props, "pointer", (void *)0x01);
+    SDLTest_AssertCheck(SDL_GetPropertyByKey(props, SDL_GetPropertyKey("pointer"), NULL) == (void *)0x01,
+        "Verify pointer property by key");
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -336,9 +555,25 @@ static const SDLTest_TestCaseReference propertiesTest3 = {
     (SDLTest_TestCaseFp)properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTest4 = {
+    (SDLTest_TestCaseFp)properties_testMany, "properties_testMany", "Test many properties", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest5 = {
+    (SDLTest_TestCaseFp)properties_testReaders, "properties_testReaders", "Test reading properties from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest6 = {
+    (SDLTest_TestCaseFp)properties_testKeys, "properties_testKeys", "Test interned property keys", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest7 = {
+    (SDLTest_TestCaseFp)properties_testCleanupDestroy, "properties_testCleanupDestroy", "Test destroying properties from a property cleanup", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
-    &propertiesTest1, &propertiesTest2, &propertiesTest3, NULL
+    &propertiesTest1, &propertiesTest2, &propertiesTest3, &propertiesTest4, &propertiesTest5, &propertiesTest6, &propertiesTest7, NULL
 };
 
 /* Properties test suite (global) */
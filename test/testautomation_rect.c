@@ -1665,6 +1665,190 @@ static int rect_testFRectEqualsParam(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests SDL_HasRectIntersections() and SDL_HasRectIntersectionsFloat() against
+ * the single rectangle versions, with counts that aren't a multiple of the SIMD width
+ *
+ * \sa SDL_HasRectIntersections
+ * \sa SDL_HasRectIntersectionsFloat
+ */
+static int rect_testHasIntersections(void *arg)
+{
+    SDL_Rect rects[67];
+    SDL_FRect frects[67];
+    SDL_bool results[67];
+    SDL_Rect clip = { 20, 30, 40, 50 };
+    SDL_FRect fclip = { 20.5f, 30.5f, 40.0f, 50.0f };
+    int count, found, expected;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(rects); ++i) {
+        rects[i].x = SDLTest_RandomIntegerInRange(-20, 100);
+        rects[i].y = SDLTest_RandomIntegerInRange(-20, 100);
+        rects[i].w = SDLTest_RandomIntegerInRange(-5, 40); /* some of these will be empty */
+        rects[i].h = SDLTest_RandomIntegerInRange(-5, 40);
+        frects[i].x = (float)rects[i].x + 0.25f;
+        frects[i].y = (float)rects[i].y + 0.75f;
+        frects[i].w = (float)rects[i].w;
+        frects[i].h = (float)rects[i].h;
+    }
+    /* Make sure both edge cases are covered, touching the clip rect isn't intersecting it */
+    rects[0].x = clip.x + clip.w;
+    rects[0].w = 10;
+    rects[1] = clip;
+
+    for (count = 0; count <= SDL_arraysize(rects); count += SDLTest_RandomIntegerInRange(1, 7)) {
+        expected = 0;
+        found = SDL_HasRectIntersections(rects, count, &clip, results);
+        for (i = 0; i < count; ++i) {
+            const SDL_bool hit = SDL_HasRectIntersection(&rects[i], &clip);
+            if (results[i] != hit) {
+                break;
+            }
+            if (hit) {
+                ++expected;
+            }
+        }
+        SDLTest_AssertCheck(i == count, "Check that each result matches SDL_HasRectIntersection() with count %d, mismatch at %d", count, i);
+        SDLTest_AssertCheck(found == expected, "Check that the number of intersections is %d, got %d", expected, found);
+        found = SDL_HasRectIntersections(rects, count, &clip, NULL);
+        SDLTest_AssertCheck(found == expected, "Check that the number of intersections is %d without results, got %d", expected, found);
+
+        expected = 0;
+        found = SDL_HasRectIntersectionsFloat(frects, count, &fclip, results);
+        for (i = 0; i < count; ++i) {
+            const SDL_bool hit = SDL_HasRectIntersectionFloat(&frects[i], &fclip);
+            if (results[i] != hit) {
+                break;
+            }
+            if (hit) {
+                ++expected;
+            }
+        }
+        SDLTest_AssertCheck(i == count, "Check that each result matches SDL_HasRectIntersectionFloat() with count %d, mismatch at %d", count, i);
+        SDLTest_AssertCheck(found == expected, "Check that the number of float intersections is %d, got %d", expected, found);
+    }
+
+    /* Nothing intersects an empty rectangle */
+    clip.w = 0;
+    found = SDL_HasRectIntersections(rects, SDL_arraysize(rects), &clip, results);
+    SDLTest_AssertCheck(found == 0, "Check that nothing intersects an empty rectangle, got %d", found);
+
+    /* invalid parameter combinations */
+    found = SDL_HasRectIntersections(NULL, 1, &clip, results);
+    SDLTest_AssertCheck(found < 0, "Check that function returns an error when 1st parameter is NULL");
+    found = SDL_HasRectIntersections(rects, -1, &clip, results);
+    SDLTest_AssertCheck(found < 0, "Check that function returns an error when 2nd parameter is negative");
+    found = SDL_HasRectIntersections(rects, 1, NULL, results);
+    SDLTest_AssertCheck(found < 0, "Check that function returns an error when 3rd parameter is NULL");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests SDL_GetRectEnclosingPoints() and SDL_GetRectEnclosingPointsFloat() with
+ * enough points to use the SIMD paths, with and without clipping
+ *
+ * \sa SDL_GetRectEnclosingPoints
+ * \sa SDL_GetRectEnclosingPointsFloat
+ */
+static int rect_testEnclosePointsMany(void *arg)
+{
+    SDL_Point points[103];
+    SDL_FPoint fpoints[103];
+    SDL_Rect clip = { 10, 10, 30, 30 };
+    SDL_FRect fclip = { 10.0f, 10.0f, 30.0f, 30.0f };
+    SDL_Rect result, expected;
+    SDL_FRect fresult, fexpected;
+    SDL_bool anyEnclosed, expectedEnclosed;
+    int pass, count, i;
+
+    for (pass = 0; pass < 2; ++pass) {
+        SDL_bool clipped = (pass == 1);
+        const SDL_Rect *c = clipped ? &clip : NULL;
+        const SDL_FRect *fc = clipped ? &fclip : NULL;
+
+        for (i = 0; i < SDL_arraysize(points); ++i) {
+            points[i].x = SDLTest_RandomIntegerInRange(-100, 100);
+            points[i].y = SDLTest_RandomIntegerInRange(-100, 100);
+            fpoints[i].x = (float)points[i].x * 0.5f;
+            fpoints[i].y = (float)points[i].y * 0.5f;
+        }
+
+        for (count = 1; count <= SDL_arraysize(points); count += SDLTest_RandomIntegerInRange(1, 9)) {
+            /* Work out the expected results one point at a time */
+            expectedEnclosed = SDL_FALSE;
+            SDL_zero(expected);
+            for (i = 0; i < count; ++i) {
+                SDL_Rect r;
+                r.x = points[i].x;
+                r.y = points[i].y;
+                r.w = r.h = 1;
+                if (c && !SDL_HasRectIntersection(&r, c)) {
+                    continue;
+                }
+                if (!expectedEnclosed) {
+                    expected = r;
+                    expectedEnclosed = SDL_TRUE;
+                } else {
+                    SDL_GetRectUnion(&expected, &r, &expected);
+                }
+            }
+            anyEnclosed = SDL_GetRectEnclosingPoints(points, count, c, &result);
+            SDLTest_AssertCheck(anyEnclosed == expectedEnclosed, "Check return value %d, expected %d, with %d points", anyEnclosed, expectedEnclosed, count);
+            if (expectedEnclosed) {
+                SDLTest_AssertCheck(SDL_RectsEqual(&result, &expected),
+                                    "Check enclosing rect with %d points, got (%d,%d,%d,%d), expected (%d,%d,%d,%d)", count,
+                                    result.x, result.y, result.w, result.h,
+                                    expected.x, expected.y, expected.w, expected.h);
+            }
+
+            expectedEnclosed = SDL_FALSE;
+            SDL_zero(fexpected);
+            for (i = 0; i < count; ++i) {
+                const float x = fpoints[i].x;
+                const float y = fpoints[i].y;
+                if (fc && (x < fc->x || x > fc->x + fc->w - 1 || y < fc->y || y > fc->y + fc->h - 1)) {
+                    continue;
+                }
+                if (!expectedEnclosed) {
+                    fexpected.x = x;
+                    fexpected.y = y;
+                    fexpected.w = x;
+                    fexpected.h = y;
+                    expectedEnclosed = SDL_TRUE;
+                } else {
+                    fexpected.x = SDL_min(fexpected.x, x);
+                    fexpected.y = SDL_min(fexpected.y, y);
+                    fexpected.w = SDL_max(fexpected.w, x);
+                    fexpected.h = SDL_max(fexpected.h, y);
+                }
+            }
+            /* w and h were holding the maximum */
+            fexpected.w = fexpected.w - fexpected.x + 1;
+            fexpected.h = fexpected.h - fexpected.y + 1;
+            anyEnclosed = SDL_GetRectEnclosingPointsFloat(fpoints, count, fc, &fresult);
+            SDLTest_AssertCheck(anyEnclosed == expectedEnclosed, "Check float return value %d, expected %d, with %d points", anyEnclosed, expectedEnclosed, count);
+            if (expectedEnclosed) {
+                SDLTest_AssertCheck(SDL_RectsEqualFloat(&fresult, &fexpected),
+                                    "Check float enclosing rect with %d points, got (%g,%g,%g,%g), expected (%g,%g,%g,%g)", count,
+                                    fresult.x, fresult.y, fresult.w, fresult.h,
+                                    fexpected.x, fexpected.y, fexpected.w, fexpected.h);
+            }
+        }
+    }
+
+    /* No points inside the clip rect */
+    for (i = 0; i < SDL_arraysize(points); ++i) {
+        points[i].x = 100 + i;
+        points[i].y = 5;
+    }
+    anyEnclosed = SDL_GetRectEnclosingPoints(points, SDL_arraysize(points), &clip, &result);
+    SDLTest_AssertCheck(anyEnclosed == SDL_FALSE, "Check that no points are enclosed when they're all outside the clip rect");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Rect test cases */
@@ -1803,13 +1987,23 @@ static const SDLTest_TestCaseReference rectTest31 = {
     (SDLTest_TestCaseFp)rect_testFRectEqualsParam, "rect_testFRectEqualsParam", "Negative tests against SDL_RectsEqualFloat with invalid parameters", TEST_ENABLED
 };
 
+/* SDL_HasRectIntersections */
+static const SDLTest_TestCaseReference rectTest32 = {
+    (SDLTest_TestCaseFp)rect_testHasIntersections, "rect_testHasIntersections", "Tests SDL_HasRectIntersections against SDL_HasRectIntersection", TEST_ENABLED
+};
+
+/* SDL_GetRectEnclosingPoints */
+static const SDLTest_TestCaseReference rectTest33 = {
+    (SDLTest_TestCaseFp)rect_testEnclosePointsMany, "rect_testEnclosePointsMany", "Tests SDL_GetRectEnclosingPoints with many points", TEST_ENABLED
+};
+
 /**
  * Sequence of Rect test cases; functions that handle simple rectangles including overlaps and merges.
  */
 static const SDLTest_TestCaseReference *rectTests[] = {
     &rectTest1, &rectTest2, &rectTest3, &rectTest4, &rectTest5, &rectTest6, &rectTest7, &rectTest8, &rectTest9, &rectTest10, &rectTest11, &rectTest12, &rectTest13, &rectTest14,
     &rectTest15, &rectTest16, &rectTest17, &rectTest18, &rectTest19, &rectTest20, &rectTest21, &rectTest22, &rectTest23, &rectTest24, &rectTest25, &rectTest26, &rectTest27,
-    &rectTest28, &rectTest29, &rectTest30, &rectTest31, NULL
+    &rectTest28, &rectTest29, &rectTest30, &rectTest31, &rectTest32, &rectTest33, NULL
 };
 
 /* Rect test suite (global) */
@@ -815,6 +815,1075 @@ static int render_testViewport(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests recording and replaying render command lists
+ */
+static int render_testCommandList(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_RenderCommandList *list;
+    SDL_Rect expected;
+    SDL_FRect rect;
+
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = TESTRENDER_SCREEN_W / 4.0f;
+    rect.h = TESTRENDER_SCREEN_H / 4.0f;
+
+    expected.x = TESTRENDER_SCREEN_W / 2;
+    expected.y = TESTRENDER_SCREEN_H / 3;
+    expected.w = (int)rect.w;
+    expected.h = (int)rect.h;
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &expected, RENDER_COLOR_GREEN))
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Record a fill operation, nothing should be drawn yet */
+    CHECK_FUNC(SDL_BeginRenderCommandList, (renderer))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    list = SDL_EndRenderCommandList(renderer);
+    SDLTest_AssertCheck(list != NULL, "Validate result from SDL_EndRenderCommandList, expected: not NULL, got: %s", SDL_GetError());
+    if (list == NULL) {
+        SDL_DestroySurface(referenceSurface);
+        return TEST_ABORTED;
+    }
+
+    /* Replay it at an offset, with a different draw color set */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_ReplayRenderCommandList, (renderer, list, (float)expected.x, (float)expected.y))
+
+    /* Check to see if final image matches. */
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Replaying again draws the same thing */
+    clearScreen();
+    CHECK_FUNC(SDL_ReplayRenderCommandList, (renderer, list, (float)expected.x, (float)expected.y))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Presenting while recording is an error */
+    CHECK_FUNC(SDL_BeginRenderCommandList, (renderer))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    SDLTest_AssertCheck(SDL_RenderPresent(renderer) < 0, "Validate SDL_RenderPresent fails while recording");
+    SDLTest_AssertCheck(SDL_EndRenderCommandList(renderer) == NULL, "Validate interrupted recording returns NULL");
+
+    SDL_DestroyRenderCommandList(list);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing small textures packed into a texture atlas
+ */
+static int render_testTextureAtlas(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Surface *referenceSurface;
+    SDL_Surface *face;
+    SDL_Texture *green;
+    SDL_Texture *blue;
+    SDL_Vertex verts[4];
+    const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+    SDL_TextureInstance instance;
+    SDL_Rect green_rect, blue_rect;
+    SDL_FRect dst;
+    int i;
+
+    /* Recreate the renderer with texture atlasing enabled */
+    SDL_DestroyRenderer(renderer);
+    props = SDL_CreateProperties();
+    SDL_SetProperty(props, "window", window);
+    SDL_SetBooleanProperty(props, "texture_atlas", SDL_TRUE);
+    renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRendererWithProperties result");
+    if (renderer == NULL) {
+        return TEST_ABORTED;
+    }
+
+    face = SDL_CreateSurface(8, 8, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (face, NULL, RENDER_COLOR_GREEN))
+    green = SDL_CreateTextureFromSurface(renderer, face);
+    CHECK_FUNC(SDL_FillSurfaceRect, (face, NULL, 0xFF0000FF))
+    blue = SDL_CreateTextureFromSurface(renderer, face);
+    SDL_DestroySurface(face);
+    SDLTest_AssertCheck(green != NULL && blue != NULL, "Check SDL_CreateTextureFromSurface results");
+    if (green == NULL || blue == NULL) {
+        return TEST_ABORTED;
+    }
+
+    green_rect.x = 4;
+    green_rect.y = 4;
+    green_rect.w = 16;
+    green_rect.h = 16;
+    blue_rect.x = 32;
+    blue_rect.y = 8;
+    blue_rect.w = 8;
+    blue_rect.h = 24;
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &green_rect, RENDER_COLOR_GREEN))
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &blue_rect, 0xFF0000FF))
+
+    SDL_zeroa(verts);
+    for (i = 0; i < 4; ++i) {
+        verts[i].color.r = 255;
+        verts[i].color.g = 255;
+        verts[i].color.b = 255;
+        verts[i].color.a = 255;
+    }
+    verts[0].position.x = (float)blue_rect.x;
+    verts[0].position.y = (float)blue_rect.y;
+    verts[1].position.x = (float)(blue_rect.x + blue_rect.w);
+    verts[1].position.y = (float)blue_rect.y;
+    verts[1].tex_coord.x = 1.0f;
+    verts[2].position.x = (float)(blue_rect.x + blue_rect.w);
+    verts[2].position.y = (float)(blue_rect.y + blue_rect.h);
+    verts[2].tex_coord.x = 1.0f;
+    verts[2].tex_coord.y = 1.0f;
+    verts[3].position.x = (float)blue_rect.x;
+    verts[3].position.y = (float)(blue_rect.y + blue_rect.h);
+    verts[3].tex_coord.y = 1.0f;
+
+    dst.x = (float)green_rect.x;
+    dst.y = (float)green_rect.y;
+    dst.w = (float)green_rect.w;
+    dst.h = (float)green_rect.h;
+
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, green, NULL, &dst))
+    CHECK_FUNC(SDL_RenderGeometry, (renderer, blue, verts, 4, indices, 6))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Instances are drawn from the atlas page too */
+    SDL_zero(instance);
+    instance.srcrect.w = 8.0f;
+    instance.srcrect.h = 8.0f;
+    instance.dstrect = dst;
+    instance.color = verts[0].color;
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTextureInstanced, (renderer, green, &instance, 1))
+    CHECK_FUNC(SDL_RenderGeometry, (renderer, blue, verts, 4, indices, 6))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Changing the scale mode moves the texture out of the atlas */
+    CHECK_FUNC(SDL_SetTextureScaleMode, (green, SDL_SCALEMODE_LINEAR))
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, green, NULL, &dst))
+    CHECK_FUNC(SDL_RenderGeometry, (renderer, blue, verts, 4, indices, 6))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    SDL_DestroyTexture(green);
+    SDL_DestroyTexture(blue);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing many copies of a texture in one call
+ */
+static int render_testTextureInstanced(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Surface *face;
+    SDL_Texture *tface;
+    SDL_TextureInstance instances[5];
+    SDL_Rect rect;
+    int i;
+
+    /* A texture with a green left half and a blue right half */
+    face = SDL_CreateSurface(16, 16, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (face, NULL, 0xFF0000FF))
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = 8;
+    rect.h = 16;
+    CHECK_FUNC(SDL_FillSurfaceRect, (face, &rect, RENDER_COLOR_GREEN))
+    tface = SDL_CreateTextureFromSurface(renderer, face);
+    SDL_DestroySurface(face);
+    SDLTest_AssertCheck(tface != NULL, "Check SDL_CreateTextureFromSurface result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    SDL_zeroa(instances);
+    for (i = 0; i < SDL_arraysize(instances); ++i) {
+        instances[i].srcrect.w = 16.0f;
+        instances[i].srcrect.h = 16.0f;
+        instances[i].dstrect.x = (float)(i * 20);
+        instances[i].dstrect.y = 10.0f;
+        instances[i].dstrect.w = 16.0f;
+        instances[i].dstrect.h = 16.0f;
+        instances[i].color.r = 255;
+        instances[i].color.g = 255;
+        instances[i].color.b = 255;
+        instances[i].color.a = 255;
+    }
+    /* The green half, the blue half, the whole texture without blue, flipped and rotated */
+    instances[0].srcrect.w = 8.0f;
+    instances[1].srcrect.x = 8.0f;
+    instances[1].srcrect.w = 8.0f;
+    instances[2].color.b = 0;
+    instances[3].flip = SDL_FLIP_HORIZONTAL;
+    instances[4].angle = 90.0;
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    rect.x = 0;
+    rect.y = 10;
+    rect.w = 16;
+    rect.h = 16;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    rect.x = 20;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, 0xFF0000FF))
+    rect.x = 40;
+    rect.w = 8;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    rect.x = 60;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, 0xFF0000FF))
+    rect.x = 68;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    rect.x = 80;
+    rect.w = 16;
+    rect.h = 8;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    rect.y = 18;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, 0xFF0000FF))
+
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTextureInstanced, (renderer, tface, instances, SDL_arraysize(instances)))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyTexture(tface);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL render_recordThread(void *data)
+{
+    SDL_RenderRecorder *recorder = (SDL_RenderRecorder *)data;
+    SDL_FRect rect;
+
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = TESTRENDER_SCREEN_W / 2.0f;
+    rect.h = TESTRENDER_SCREEN_H / 2.0f;
+    if (SDL_RecordRenderDrawColor(recorder, 0, 255, 0, SDL_ALPHA_OPAQUE) < 0 ||
+        SDL_RecordRenderFillRects(recorder, &rect, 1) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Tests drawing operations recorded on another thread
+ */
+static int render_testRecorder(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_RenderRecorder *first, *second;
+    SDL_Thread *thread;
+    SDL_Rect expected;
+    SDL_FRect rect;
+    Uint8 r, g, b, a;
+    int status = -1;
+
+    first = SDL_CreateRenderRecorder(renderer);
+    second = SDL_CreateRenderRecorder(renderer);
+    SDLTest_AssertCheck(first != NULL && second != NULL, "Check SDL_CreateRenderRecorder results");
+    if (first == NULL || second == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* The second recording covers part of the first one */
+    rect.x = TESTRENDER_SCREEN_W / 4.0f;
+    rect.y = TESTRENDER_SCREEN_H / 4.0f;
+    rect.w = TESTRENDER_SCREEN_W / 4.0f;
+    rect.h = TESTRENDER_SCREEN_H / 4.0f;
+    CHECK_FUNC(SDL_RecordRenderDrawColor, (second, 0, 0, 255, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RecordRenderFillRects, (second, &rect, 1))
+
+    thread = SDL_CreateThread(render_recordThread, "render_recordThread", first);
+    SDLTest_AssertCheck(thread != NULL, "Check SDL_CreateThread result");
+    SDL_WaitThread(thread, &status);
+    SDLTest_AssertCheck(status == 0, "Validate recording thread result, expected: 0, got: %i", status);
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    expected.x = 0;
+    expected.y = 0;
+    expected.w = TESTRENDER_SCREEN_W / 2;
+    expected.h = TESTRENDER_SCREEN_H / 2;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &expected, RENDER_COLOR_GREEN))
+    expected.x = (int)rect.x;
+    expected.y = (int)rect.y;
+    expected.w = (int)rect.w;
+    expected.h = (int)rect.h;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &expected, 0xFF0000FF))
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Recordings are drawn in submission order when flushing or presenting */
+    CHECK_FUNC(SDL_SubmitRenderRecorder, (first))
+    CHECK_FUNC(SDL_SubmitRenderRecorder, (second))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 1, 2, 3, 4))
+    CHECK_FUNC(SDL_RenderFlush, (renderer))
+
+    /* The draw color isn't affected by the recordings */
+    CHECK_FUNC(SDL_GetRenderDrawColor, (renderer, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 1 && g == 2 && b == 3 && a == 4, "Validate draw color after replaying recordings");
+
+    /* Check to see if final image matches. */
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make the render present effective */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyRenderRecorder(first);
+    SDL_DestroyRenderRecorder(second);
+
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests updating a texture asynchronously
+ *
+ * \sa SDL_UpdateTextureAsync
+ * \sa SDL_IsTextureUploadComplete
+ * \sa SDL_WaitTextureUpload
+ */
+static int render_testUpdateTextureAsync(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Texture *texture;
+    Uint32 pixels[16 * 16];
+    SDL_FRect dst;
+    SDL_Rect rect;
+    Uint64 ticket;
+    int i;
+
+    texture = SDL_CreateTexture(renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    SDLTest_AssertCheck(texture != NULL, "Check SDL_CreateTexture result");
+    if (texture == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        pixels[i] = RENDER_COLOR_GREEN;
+    }
+    CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, pixels, 16 * sizeof(Uint32)))
+
+    clearScreen();
+    dst.x = 0.0f;
+    dst.y = 10.0f;
+    dst.w = 16.0f;
+    dst.h = 16.0f;
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, &dst))
+
+    /* The draw above must still see the old contents */
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        pixels[i] = 0xFF0000FF;
+    }
+    ticket = SDL_UpdateTextureAsync(texture, NULL, pixels, 16 * sizeof(Uint32));
+    SDLTest_AssertCheck(ticket != 0, "Validate result from SDL_UpdateTextureAsync, expected: non-zero, got: %" SDL_PRIu64, ticket);
+    SDL_memset(pixels, 0, sizeof(pixels));
+
+    dst.x = 20.0f;
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, &dst))
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    rect.x = 0;
+    rect.y = 10;
+    rect.w = 16;
+    rect.h = 16;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    rect.x = 20;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, 0xFF0000FF))
+
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    CHECK_FUNC(SDL_WaitTextureUpload, (renderer, ticket))
+    SDLTest_AssertCheck(SDL_IsTextureUploadComplete(renderer, ticket), "Validate result from SDL_IsTextureUploadComplete, expected: SDL_TRUE");
+    SDLTest_AssertCheck(!SDL_IsTextureUploadComplete(renderer, 0), "Validate result from SDL_IsTextureUploadComplete with an invalid ticket, expected: SDL_FALSE");
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests the render statistics published at present time
+ *
+ * \sa SDL_CreateRendererWithProperties
+ * \sa SDL_GetRendererProperties
+ */
+static int render_testStats(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Surface *surface;
+    SDL_Renderer *stats_renderer;
+    SDL_Texture *texture;
+    Uint32 pixels[8 * 8];
+    SDL_FRect rect;
+    Sint64 value;
+
+    surface = SDL_CreateSurface(32, 32, RENDER_COMPARE_FORMAT);
+    SDLTest_AssertCheck(surface != NULL, "Check SDL_CreateSurface result");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetProperty(props, "surface", surface);
+    SDL_SetBooleanProperty(props, "stats", SDL_TRUE);
+    stats_renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(stats_renderer != NULL, "Check SDL_CreateRendererWithProperties result");
+    if (stats_renderer == NULL) {
+        SDL_DestroySurface(surface);
+        return TEST_ABORTED;
+    }
+
+    texture = SDL_CreateTexture(stats_renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 8, 8);
+    SDLTest_AssertCheck(texture != NULL, "Check SDL_CreateTexture result");
+    SDL_memset(pixels, 0xFF, sizeof(pixels));
+    CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, pixels, 8 * sizeof(Uint32)))
+
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = 8.0f;
+    rect.h = 8.0f;
+    CHECK_FUNC(SDL_SetRenderDrawColor, (stats_renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (stats_renderer, &rect))
+    rect.x = 16.0f;
+    CHECK_FUNC(SDL_RenderTexture, (stats_renderer, texture, NULL, &rect))
+    CHECK_FUNC(SDL_RenderPresent, (stats_renderer))
+
+    props = SDL_GetRendererProperties(stats_renderer);
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.commands.fill_rects", -1);
+    SDLTest_AssertCheck(value == 1, "Validate fill_rects, expected: 1, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.commands.copy", -1);
+    SDLTest_AssertCheck(value == 1, "Validate copy, expected: 1, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.batches", -1);
+    SDLTest_AssertCheck(value == 1, "Validate batches, expected: 1, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.vertex_bytes", -1);
+    SDLTest_AssertCheck(value > 0, "Validate vertex_bytes, expected: > 0, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.texture_upload_bytes", -1);
+    SDLTest_AssertCheck(value == sizeof(pixels), "Validate texture_upload_bytes, expected: %d, got: %" SDL_PRIs64, (int)sizeof(pixels), value);
+
+    /* The counters are reset every frame */
+    CHECK_FUNC(SDL_RenderPresent, (stats_renderer))
+    value = SDL_GetNumberProperty(props, "SDL.renderer.stats.commands", -1);
+    SDLTest_AssertCheck(value == 0, "Validate commands after an empty frame, expected: 0, got: %" SDL_PRIs64, value);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(stats_renderer);
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+/* Draws a scene exercising the software renderer paths, returns the result */
+static SDL_Surface *render_drawSoftwareScene(const char *threads)
+{
+    SDL_Surface *surface;
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *texture;
+    SDL_Vertex verts[3];
+    SDL_FRect rect;
+    SDL_Rect viewport;
+    SDL_FPoint points[64];
+    Uint32 pixels[16 * 16];
+    int i;
+
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+    surface = SDL_CreateSurface(512, 384, RENDER_COMPARE_FORMAT);
+    if (!surface) {
+        return NULL;
+    }
+    sw_renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!sw_renderer) {
+        SDL_DestroySurface(surface);
+        return NULL;
+    }
+
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        pixels[i] = 0xFF000000 | (i * 0x010305);
+    }
+    texture = SDL_CreateTexture(sw_renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    SDL_UpdateTexture(texture, NULL, pixels, 16 * sizeof(Uint32));
+
+    SDL_SetRenderDrawColor(sw_renderer, 10, 20, 30, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(sw_renderer);
+
+    /* Rectangles crossing the bands, opaque and blended */
+    SDL_SetRenderDrawBlendMode(sw_renderer, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < 16; ++i) {
+        rect.x = (float)(i * 29);
+        rect.y = (float)(i * 21);
+        rect.w = 90.0f;
+        rect.h = 70.0f;
+        SDL_SetRenderDrawColor(sw_renderer, (Uint8)(i * 16), 255, (Uint8)(255 - i * 16), (Uint8)((i & 1) ? 128 : 255));
+        SDL_RenderFillRect(sw_renderer, &rect);
+    }
+
+    /* A texture copy in between, which runs on this thread */
+    rect.x = 100.0f;
+    rect.y = 100.0f;
+    rect.w = 64.0f;
+    rect.h = 64.0f;
+    SDL_RenderTexture(sw_renderer, texture, NULL, &rect);
+
+    /* Triangles, lines and points inside an offset viewport with a clip rect */
+    viewport.x = 37;
+    viewport.y = 53;
+    viewport.w = 400;
+    viewport.h = 300;
+    SDL_SetRenderViewport(sw_renderer, &viewport);
+    viewport.x = 10;
+    viewport.y = 10;
+    viewport.w = 350;
+    viewport.h = 250;
+    SDL_SetRenderClipRect(sw_renderer, &viewport);
+
+    SDL_zeroa(verts);
+    verts[0].position.x = 0.0f;
+    verts[0].position.y = 0.0f;
+    verts[1].position.x = 390.0f;
+    verts[1].position.y = 40.0f;
+    verts[2].position.x = 120.0f;
+    verts[2].position.y = 290.0f;
+    verts[0].color.r = 255;
+    verts[0].color.a = 255;
+    verts[1].color.g = 255;
+    verts[1].color.a = 200;
+    verts[2].color.b = 255;
+    verts[2].color.a = 100;
+    SDL_RenderGeometry(sw_renderer, NULL, verts, 3, NULL, 0);
+
+    SDL_SetRenderDrawColor(sw_renderer, 255, 255, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderLine(sw_renderer, 0.0f, 0.0f, 399.0f, 299.0f);
+    for (i = 0; i < SDL_arraysize(points); ++i) {
+        points[i].x = (float)(i * 6);
+        points[i].y = (float)(i * 4);
+    }
+    SDL_RenderPoints(sw_renderer, points, SDL_arraysize(points));
+
+    SDL_SetRenderClipRect(sw_renderer, NULL);
+    SDL_SetRenderViewport(sw_renderer, NULL);
+    SDL_SetRenderDrawColor(sw_renderer, 0, 0, 0, 64);
+    rect.x = 0.0f;
+    rect.y = 190.0f;
+    rect.w = 512.0f;
+    rect.h = 4.0f;
+    SDL_RenderFillRect(sw_renderer, &rect);
+
+    SDL_RenderPresent(sw_renderer);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(sw_renderer);
+    return surface;
+}
+
+/**
+ * Tests that the software renderer draws the same with and without threads
+ *
+ * \sa SDL_CreateSoftwareRenderer
+ */
+static int render_testSoftwareThreads(void *arg)
+{
+    SDL_Surface *single;
+    SDL_Surface *threaded;
+    int ret;
+
+    single = render_drawSoftwareScene("1");
+    threaded = render_drawSoftwareScene("4");
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    SDLTest_AssertCheck(single != NULL && threaded != NULL, "Check software rendered surfaces");
+    if (single == NULL || threaded == NULL) {
+        SDL_DestroySurface(single);
+        SDL_DestroySurface(threaded);
+        return TEST_ABORTED;
+    }
+
+    ret = SDLTest_CompareSurfaces(threaded, single, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+    SDL_DestroySurface(single);
+    SDL_DestroySurface(threaded);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests the presentation timing feedback
+ *
+ * \sa SDL_GetRenderPresentTiming
+ * \sa SDL_WaitRenderFrame
+ */
+static int render_testPresentTiming(void *arg)
+{
+    SDL_RenderPresentTiming timing;
+    Uint64 start, elapsed;
+    int i, ret;
+
+    ret = SDL_GetRenderPresentTiming(renderer, NULL);
+    SDLTest_AssertCheck(ret == -1, "Validate SDL_GetRenderPresentTiming() rejects NULL, got: %i", ret);
+
+    ret = SDL_SetRenderVSync(renderer, 1);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderVSync, expected: 0, got: %i", ret);
+
+    for (i = 0; i < 3; ++i) {
+        SDL_RenderClear(renderer);
+        SDL_RenderPresent(renderer);
+    }
+
+    ret = SDL_GetRenderPresentTiming(renderer, &timing);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderPresentTiming, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(timing.last_present_ns > 0, "Check that the last present time is set");
+    SDLTest_AssertCheck(timing.refresh_interval_ns > 0, "Check that the refresh interval is set");
+    SDLTest_AssertCheck(timing.next_vblank_ns > timing.last_present_ns, "Check that the next vertical blank is after the last present");
+    if (timing.refresh_interval_ns > 0 && timing.next_vblank_ns > timing.last_present_ns) {
+        SDLTest_AssertCheck((timing.next_vblank_ns - timing.last_present_ns) % timing.refresh_interval_ns == 0,
+                            "Check that the next vertical blank is on the refresh timeline");
+    }
+
+    /* Starting a frame late shouldn't take longer than a refresh or two */
+    start = SDL_GetTicksNS();
+    ret = SDL_WaitRenderFrame(renderer, timing.refresh_interval_ns / 2);
+    elapsed = SDL_GetTicksNS() - start;
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_WaitRenderFrame, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(elapsed < SDL_MS_TO_NS(1000), "Check that SDL_WaitRenderFrame() returned in time, took %" SDL_PRIu64 " ns", elapsed);
+
+    /* There's nothing to wait for without vsync */
+    SDL_SetRenderVSync(renderer, 0);
+    SDL_RenderPresent(renderer);
+    ret = SDL_WaitRenderFrame(renderer, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_WaitRenderFrame without vsync, expected: 0, got: %i", ret);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reusing render targets from the pool
+ *
+ * \sa SDL_AcquireRenderTarget
+ * \sa SDL_ReleaseRenderTarget
+ */
+static int render_testRenderTargetPool(void *arg)
+{
+    SDL_Texture *target, *again, *other, *streaming;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID;
+    Uint8 r = 0, g = 0, b = 0, a = 0;
+    int access = 0, w = 0, h = 0;
+    int i, ret;
+
+    target = SDL_AcquireRenderTarget(renderer, 0, 64, 32);
+    SDLTest_AssertCheck(target != NULL, "Check SDL_AcquireRenderTarget result");
+    if (target == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_QueryTexture(target, NULL, &access, &w, &h);
+    SDLTest_AssertCheck(access == SDL_TEXTUREACCESS_TARGET && w == 64 && h == 32,
+                        "Check the acquired texture, expected: target 64x32, got: %d %dx%d", access, w, h);
+
+    /* Changed state shouldn't follow the texture back out of the pool */
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(target, 10, 20, 30);
+    SDL_SetTextureAlphaMod(target, 40);
+
+    SDL_SetRenderTarget(renderer, target);
+    ret = SDL_ReleaseRenderTarget(target);
+    SDLTest_AssertCheck(ret == -1, "Validate SDL_ReleaseRenderTarget() rejects the current target, got: %i", ret);
+    SDL_SetRenderTarget(renderer, NULL);
+
+    ret = SDL_ReleaseRenderTarget(target);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ReleaseRenderTarget, expected: 0, got: %i", ret);
+    ret = SDL_ReleaseRenderTarget(target);
+    SDLTest_AssertCheck(ret == -1, "Validate SDL_ReleaseRenderTarget() rejects a second release, got: %i", ret);
+
+    other = SDL_AcquireRenderTarget(renderer, 0, 32, 32);
+    SDLTest_AssertCheck(other != NULL && other != target, "Check that a different size gets a different texture");
+
+    again = SDL_AcquireRenderTarget(renderer, 0, 64, 32);
+    SDLTest_AssertCheck(again == target, "Check that the released texture was reused");
+    SDL_GetTextureBlendMode(again, &blendMode);
+    SDL_GetTextureColorMod(again, &r, &g, &b);
+    SDL_GetTextureAlphaMod(again, &a);
+    SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_NONE, "Check the reused blend mode, expected: %d, got: %d", SDL_BLENDMODE_NONE, blendMode);
+    SDLTest_AssertCheck(r == 255 && g == 255 && b == 255 && a == 255,
+                        "Check the reused modulation, expected: 255,255,255,255, got: %d,%d,%d,%d", r, g, b, a);
+
+    /* Released textures are destroyed if they aren't reused for a while */
+    SDL_ReleaseRenderTarget(again);
+    SDL_ReleaseRenderTarget(other);
+    for (i = 0; i < 5; ++i) {
+        SDL_RenderPresent(renderer);
+    }
+    target = SDL_AcquireRenderTarget(renderer, 0, 64, 32);
+    SDLTest_AssertCheck(target != NULL, "Check SDL_AcquireRenderTarget result after the pool expired");
+    if (target) {
+        SDL_SetRenderTarget(renderer, target);
+        ret = SDL_RenderClear(renderer);
+        SDLTest_AssertCheck(ret == 0, "Validate drawing to the new target, expected: 0, got: %i", ret);
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_DestroyTexture(target);
+    }
+
+    streaming = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+    if (streaming) {
+        ret = SDL_ReleaseRenderTarget(streaming);
+        SDLTest_AssertCheck(ret == -1, "Validate SDL_ReleaseRenderTarget() rejects other textures, got: %i", ret);
+        SDL_DestroyTexture(streaming);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading pixels asynchronously
+ */
+static int render_testReadPixelsAsync(void *arg)
+{
+    const SDL_Rect rect = { -4, 0, 16, 8 };
+    Uint32 pixels[16 * 8];
+    Uint32 expected[16 * 8];
+    Uint64 ticket, other;
+    SDL_bool complete;
+    int i, ret;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderPoint(renderer, 1.0f, 1.0f);
+
+    /* The rectangle starts left of the viewport, so the pixels are offset like SDL_RenderReadPixels() */
+    SDL_memset(expected, 0xAA, sizeof(expected));
+    ret = SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_RGBA8888, expected, 16 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+    ticket = SDL_RenderReadPixelsAsync(renderer, &rect, SDL_PIXELFORMAT_RGBA8888);
+    SDLTest_AssertCheck(ticket != 0, "Validate result from SDL_RenderReadPixelsAsync, expected: non-zero, got: 0");
+    other = SDL_RenderReadPixelsAsync(renderer, NULL, 0);
+    SDLTest_AssertCheck(other > ticket, "Validate tickets increase, expected: > %" SDL_PRIu64 ", got: %" SDL_PRIu64, ticket, other);
+
+    /* Drawing after the read doesn't change what was read */
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_RenderPresent(renderer);
+
+    complete = SDL_IsRenderReadPixelsComplete(renderer, ticket);
+    SDLTest_AssertCheck(complete == SDL_TRUE, "Validate the read completed after a present, got: %d", complete);
+
+    SDL_memset(pixels, 0xAA, sizeof(pixels));
+    ret = SDL_FinishRenderReadPixels(renderer, ticket, pixels, 16 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FinishRenderReadPixels, expected: 0, got: %i", ret);
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        if (pixels[i] != expected[i]) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == SDL_arraysize(pixels), "Check the pixels match SDL_RenderReadPixels(), first difference at %d", i);
+
+    /* Finished tickets are no longer valid */
+    ret = SDL_FinishRenderReadPixels(renderer, ticket, pixels, 16 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == -1, "Validate a finished ticket is rejected, got: %i", ret);
+    complete = SDL_IsRenderReadPixelsComplete(renderer, ticket);
+    SDLTest_AssertCheck(complete == SDL_FALSE, "Validate a finished ticket isn't complete, got: %d", complete);
+
+    /* Discard the other one, anything left over is released with the renderer */
+    ret = SDL_FinishRenderReadPixels(renderer, other, NULL, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate discarding a read, expected: 0, got: %i", ret);
+    ticket = SDL_RenderReadPixelsAsync(renderer, NULL, 0);
+    SDLTest_AssertCheck(ticket != 0, "Validate result from SDL_RenderReadPixelsAsync, expected: non-zero, got: 0");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests streaming textures shadowed in CPU memory
+ */
+static int render_testLockShadow(void *arg)
+{
+    const SDL_Rect rect = { 2, 1, 3, 2 };
+    const SDL_Rect read_rect = { 0, 0, 8, 4 };
+    const SDL_FRect dst = { 0.0f, 0.0f, 8.0f, 4.0f };
+    SDL_PropertiesID props;
+    SDL_Texture *texture;
+    Uint32 *pixels;
+    Uint32 result[8 * 4];
+    void *locked;
+    int pitch, x, y, ret;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "format", SDL_PIXELFORMAT_RGBA8888);
+    SDL_SetNumberProperty(props, "access", SDL_TEXTUREACCESS_STREAMING);
+    SDL_SetNumberProperty(props, "width", 8);
+    SDL_SetNumberProperty(props, "height", 4);
+    SDL_SetBooleanProperty(props, "lock_shadow", SDL_TRUE);
+    texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(texture != NULL, "Validate result from SDL_CreateTextureWithProperties, expected: non-NULL");
+    if (!texture) {
+        return TEST_ABORTED;
+    }
+
+    /* Fill the whole texture, then change part of it */
+    ret = SDL_LockTexture(texture, NULL, &locked, &pitch);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_LockTexture, expected: 0, got: %i", ret);
+    for (y = 0; y < 4; ++y) {
+        pixels = (Uint32 *)((Uint8 *)locked + y * pitch);
+        for (x = 0; x < 8; ++x) {
+            pixels[x] = 0x0000FFFF;
+        }
+    }
+    SDL_UnlockTexture(texture);
+
+    ret = SDL_LockTexture(texture, &rect, &locked, &pitch);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_LockTexture, expected: 0, got: %i", ret);
+    pixels = (Uint32 *)locked;
+    SDLTest_AssertCheck(pixels[0] == 0x0000FFFF, "Validate locked pixels keep their contents, expected: 0x0000FFFF, got: 0x%.8" SDL_PRIx32, pixels[0]);
+    for (y = 0; y < rect.h; ++y) {
+        pixels = (Uint32 *)((Uint8 *)locked + y * pitch);
+        for (x = 0; x < rect.w; ++x) {
+            pixels[x] = 0xFF0000FF;
+        }
+    }
+    SDL_UnlockTexture(texture);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_RenderTexture(renderer, texture, NULL, &dst);
+
+    ret = SDL_RenderReadPixels(renderer, &read_rect, SDL_PIXELFORMAT_RGBA8888, result, 8 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    for (y = 0; y < 4; ++y) {
+        for (x = 0; x < 8; ++x) {
+            const SDL_Point point = { x, y };
+            const Uint32 expected = SDL_PointInRect(&point, &rect) ? 0xFF0000FF : 0x0000FFFF;
+
+            SDLTest_AssertCheck(result[y * 8 + x] == expected, "Validate pixel %d,%d, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, x, y, expected, result[y * 8 + x]);
+        }
+    }
+
+    SDL_DestroyTexture(texture);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing distance field textures
+ */
+static int render_testDistanceField(void *arg)
+{
+    const SDL_FRect dst = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SDL_Rect inside = { 4, 16, 1, 1 };
+    const SDL_Rect outside = { 28, 16, 1, 1 };
+    SDL_PropertiesID props;
+    SDL_Texture *texture;
+    Uint32 pixels[8 * 8];
+    Uint32 result;
+    int x, y, ret;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "format", SDL_PIXELFORMAT_RGBA8888);
+    SDL_SetNumberProperty(props, "width", 8);
+    SDL_SetNumberProperty(props, "height", 8);
+
+    SDL_SetNumberProperty(props, "distance_field", 42);
+    texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDLTest_AssertCheck(texture == NULL, "Validate an unknown distance field is rejected");
+
+    SDL_SetNumberProperty(props, "distance_field", SDL_DISTANCEFIELD_SDF);
+    texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    if (!texture) {
+        SDLTest_Log("Distance fields aren't supported by this renderer: %s", SDL_GetError());
+        return TEST_COMPLETED;
+    }
+
+    /* The edge runs down the middle of the texture, the left half is inside */
+    for (y = 0; y < 8; ++y) {
+        for (x = 0; x < 8; ++x) {
+            pixels[y * 8 + x] = 0xFFFFFF00 | (Uint32)SDL_clamp(128 + (4 - x) * 32, 0, 255);
+        }
+    }
+    ret = SDL_UpdateTexture(texture, NULL, pixels, 8 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    SDL_SetTextureColorMod(texture, 255, 0, 0);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    ret = SDL_RenderTexture(renderer, texture, NULL, &dst);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderTexture, expected: 0, got: %i", ret);
+
+    ret = SDL_RenderReadPixels(renderer, &inside, SDL_PIXELFORMAT_RGBA8888, &result, sizeof(result));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(result == 0xFF0000FF, "Validate the inside of the shape is drawn in the color modulation, expected: 0xFF0000FF, got: 0x%.8" SDL_PRIx32, result);
+    ret = SDL_RenderReadPixels(renderer, &outside, SDL_PIXELFORMAT_RGBA8888, &result, sizeof(result));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(result == 0x000000FF, "Validate the outside of the shape isn't drawn, expected: 0x000000FF, got: 0x%.8" SDL_PRIx32, result);
+
+    SDL_DestroyTexture(texture);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing points and lines with a render scale
+ */
+static int render_testScaledPointsAndLines(void *arg)
+{
+    const SDL_FPoint points[2] = { { 1.0f, 1.0f }, { 3.0f, 1.0f } };
+    const SDL_Rect squares[2] = { { 2, 2, 2, 2 }, { 6, 2, 2, 2 } };
+    const SDL_Rect line = { 0, 8, 8, 2 };
+    const SDL_Rect read_rect = { 0, 0, 10, 12 };
+    Uint32 result[10 * 12];
+    int x, y, ret;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    ret = SDL_SetRenderScale(renderer, 2.0f, 2.0f);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderScale, expected: 0, got: %i", ret);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+    ret = SDL_RenderPoints(renderer, points, SDL_arraysize(points));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderPoints, expected: 0, got: %i", ret);
+    ret = SDL_RenderLine(renderer, 0.0f, 4.0f, 3.0f, 4.0f);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderLine, expected: 0, got: %i", ret);
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+
+    ret = SDL_RenderReadPixels(renderer, &read_rect, SDL_PIXELFORMAT_RGBA8888, result, 10 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    for (y = 0; y < read_rect.h; ++y) {
+        for (x = 0; x < read_rect.w; ++x) {
+            const SDL_Point point = { x, y };
+            const SDL_bool drawn = SDL_PointInRect(&point, &squares[0]) ||
+                                   SDL_PointInRect(&point, &squares[1]) ||
+                                   SDL_PointInRect(&point, &line);
+            const Uint32 expected = drawn ? 0xFFFFFFFF : 0x000000FF;
+
+            SDLTest_AssertCheck(result[y * read_rect.w + x] == expected, "Validate pixel %d,%d, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, x, y, expected, result[y * read_rect.w + x]);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing rotated and flipped textures
+ */
+static int render_testRotatedCopy(void *arg)
+{
+    const Uint32 pixels[2 * 3] = {
+        0xFF0000FF, 0x00FF00FF, 0x0000FFFF,
+        0xFFFF00FF, 0x00FFFFFF, 0xFF00FFFF
+    };
+    const SDL_FRect rotated = { 10.0f, 10.0f, 3.0f, 2.0f };
+    const SDL_FRect flipped = { 20.0f, 10.0f, 3.0f, 2.0f };
+    const SDL_FRect smooth = { 40.0f, 20.0f, 16.0f, 16.0f };
+    const SDL_FPoint origin = { 0.0f, 0.0f };
+    const SDL_Rect rotated_read = { 8, 10, 2, 3 };
+    const SDL_Rect flipped_read = { 20, 10, 3, 2 };
+    const SDL_Rect inside = { 48, 28, 1, 1 };
+    const SDL_Rect corner = { 40, 20, 1, 1 };
+    SDL_Texture *texture, *white;
+    Uint32 result[3 * 2];
+    Uint32 white_pixels[4 * 4];
+    int i, j, ret;
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 3, 2);
+    SDLTest_AssertCheck(texture != NULL, "Validate result from SDL_CreateTexture, expected: non-NULL");
+    white = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 4, 4);
+    SDLTest_AssertCheck(white != NULL, "Validate result from SDL_CreateTexture, expected: non-NULL");
+    if (!texture || !white) {
+        SDL_DestroyTexture(texture);
+        SDL_DestroyTexture(white);
+        return TEST_ABORTED;
+    }
+    SDL_UpdateTexture(texture, NULL, pixels, 3 * sizeof(Uint32));
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    for (i = 0; i < SDL_arraysize(white_pixels); ++i) {
+        white_pixels[i] = 0xFFFFFFFF;
+    }
+    SDL_UpdateTexture(white, NULL, white_pixels, 4 * sizeof(Uint32));
+    SDL_SetTextureScaleMode(white, SDL_SCALEMODE_LINEAR);
+    SDL_SetTextureBlendMode(white, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    /* 90 degrees clockwise around the top left corner */
+    ret = SDL_RenderTextureRotated(renderer, texture, NULL, &rotated, 90.0, &origin, SDL_FLIP_NONE);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderTextureRotated, expected: 0, got: %i", ret);
+    /* Flipping both ways undoes a half turn */
+    ret = SDL_RenderTextureRotated(renderer, texture, NULL, &flipped, 180.0, NULL, (SDL_RendererFlip)(SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderTextureRotated, expected: 0, got: %i", ret);
+    /* A filtered copy of a single color keeps that color up to the edges */
+    ret = SDL_RenderTextureRotated(renderer, white, NULL, &smooth, 30.0, NULL, SDL_FLIP_NONE);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderTextureRotated, expected: 0, got: %i", ret);
+
+    ret = SDL_RenderReadPixels(renderer, &rotated_read, SDL_PIXELFORMAT_RGBA8888, result, rotated_read.w * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    for (j = 0; j < 2; ++j) {
+        for (i = 0; i < 3; ++i) {
+            const Uint32 got = result[i * rotated_read.w + (1 - j)];
+            SDLTest_AssertCheck(got == pixels[j * 3 + i], "Validate rotated texel %d,%d, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, i, j, pixels[j * 3 + i], got);
+        }
+    }
+
+    ret = SDL_RenderReadPixels(renderer, &flipped_read, SDL_PIXELFORMAT_RGBA8888, result, flipped_read.w * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    for (i = 0; i < SDL_arraysize(result); ++i) {
+        SDLTest_AssertCheck(result[i] == pixels[i], "Validate flipped texel %d, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, i, pixels[i], result[i]);
+    }
+
+    ret = SDL_RenderReadPixels(renderer, &inside, SDL_PIXELFORMAT_RGBA8888, result, sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(result[0] == 0xFFFFFFFF, "Validate the inside of the rotated rect, expected: 0xFFFFFFFF, got: 0x%.8" SDL_PRIx32, result[0]);
+    ret = SDL_RenderReadPixels(renderer, &corner, SDL_PIXELFORMAT_RGBA8888, result, sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(result[0] == 0x000000FF, "Validate the corner rotated out of the rect isn't drawn, expected: 0x000000FF, got: 0x%.8" SDL_PRIx32, result[0]);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyTexture(white);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Test logical size
  */
@@ -923,6 +1992,149 @@ static int render_testLogicalSize(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests logical presentation rendered straight to the output.
+ *
+ * \sa SDL_HINT_RENDER_DIRECT_LOGICAL_PRESENTATION
+ */
+static int render_testLogicalSizeDirect(void *arg)
+{
+    int w, h, logical_w, logical_h;
+    float scale_x, scale_y, x, y;
+    int retval;
+
+    SDL_SetHint(SDL_HINT_RENDER_DIRECT_LOGICAL_PRESENTATION, "1");
+
+    /* The app sees the logical size and its own scale, not the presentation's */
+    CHECK_FUNC(SDL_GetCurrentRenderOutputSize, (renderer, &w, &h))
+    CHECK_FUNC(SDL_SetRenderLogicalPresentation, (renderer, w / 2, h / 2,
+                                           SDL_LOGICAL_PRESENTATION_INTEGER_SCALE,
+                                           SDL_SCALEMODE_NEAREST))
+    CHECK_FUNC(SDL_GetCurrentRenderOutputSize, (renderer, &logical_w, &logical_h))
+    SDLTest_AssertCheck(logical_w == w / 2 && logical_h == h / 2,
+                        "Validate output size, expected %dx%d, got %dx%d", w / 2, h / 2, logical_w, logical_h);
+    CHECK_FUNC(SDL_SetRenderScale, (renderer, 2.0f, 2.0f))
+    CHECK_FUNC(SDL_GetRenderScale, (renderer, &scale_x, &scale_y))
+    SDLTest_AssertCheck(scale_x == 2.0f && scale_y == 2.0f,
+                        "Validate render scale, expected 2x2, got %gx%g", scale_x, scale_y);
+    CHECK_FUNC(SDL_RenderCoordinatesToWindow, (renderer, 10.0f, 20.0f, &x, &y))
+    CHECK_FUNC(SDL_RenderCoordinatesFromWindow, (renderer, x, y, &x, &y))
+    SDLTest_AssertCheck(x == 10.0f && y == 20.0f,
+                        "Validate coordinate round trip, expected 10,20, got %g,%g", x, y);
+    CHECK_FUNC(SDL_SetRenderScale, (renderer, 1.0f, 1.0f))
+    CHECK_FUNC(SDL_SetRenderLogicalPresentation, (renderer, 0, 0,
+                                           SDL_LOGICAL_PRESENTATION_DISABLED,
+                                           SDL_SCALEMODE_NEAREST))
+
+    /* Drawing should come out the same as through the intermediate texture */
+    retval = render_testLogicalSize(arg);
+
+    SDL_ResetHint(SDL_HINT_RENDER_DIRECT_LOGICAL_PRESENTATION);
+    return retval;
+}
+
+static int reload_count = 0;
+
+static int SDLCALL reloadTexture(void *userdata, SDL_Texture *texture)
+{
+    SDL_Surface *face = (SDL_Surface *)userdata;
+
+    ++reload_count;
+    return SDL_UpdateTexture(texture, NULL, face->pixels, face->pitch);
+}
+
+/**
+ * Tests texture memory accounting and eviction
+ */
+static int render_testTextureMemoryBudget(void *arg)
+{
+    const Sint64 size = 16 * 16 * 4;
+    SDL_PropertiesID props;
+    SDL_Surface *referenceSurface;
+    SDL_Surface *face;
+    SDL_Texture *textures[4];
+    Sint64 base, memory, evictions;
+    SDL_Rect rect;
+    SDL_FRect dst;
+    int i;
+
+    /* Recreate the renderer with room for three 16x16 textures */
+    SDL_DestroyRenderer(renderer);
+    props = SDL_CreateProperties();
+    SDL_SetProperty(props, "window", window);
+    SDL_SetNumberProperty(props, "texture_memory_budget", 3 * size);
+    renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRendererWithProperties result");
+    if (renderer == NULL) {
+        return TEST_ABORTED;
+    }
+    props = SDL_GetRendererProperties(renderer);
+    base = SDL_GetNumberProperty(props, "SDL.renderer.texture_memory", 0);
+
+    face = SDL_CreateSurface(16, 16, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (face, NULL, RENDER_COLOR_GREEN))
+    for (i = 0; i < 2; ++i) {
+        textures[i] = SDL_CreateTextureFromSurface(renderer, face);
+        SDLTest_AssertCheck(textures[i] != NULL, "Check SDL_CreateTextureFromSurface result");
+        if (textures[i] == NULL) {
+            return TEST_ABORTED;
+        }
+        CHECK_FUNC(SDL_SetTextureReloadCallback, (textures[i], reloadTexture, face))
+    }
+    memory = SDL_GetNumberProperty(props, "SDL.renderer.texture_memory", 0);
+    SDLTest_AssertCheck(memory == base + 2 * size, "Validate texture memory, expected: %" SDL_PRIs64 ", got: %" SDL_PRIs64, base + 2 * size, memory);
+
+    dst.x = 0.0f;
+    dst.y = 0.0f;
+    dst.w = 16.0f;
+    dst.h = 16.0f;
+    CHECK_FUNC(SDL_RenderTexture, (renderer, textures[0], NULL, &dst))
+    CHECK_FUNC(SDL_RenderTexture, (renderer, textures[1], NULL, &dst))
+
+    /* Going over the budget evicts the least recently drawn texture */
+    reload_count = 0;
+    textures[2] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_UNKNOWN, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    textures[3] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_UNKNOWN, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    SDLTest_AssertCheck(textures[2] != NULL && textures[3] != NULL, "Check SDL_CreateTexture results");
+    if (textures[2] == NULL || textures[3] == NULL) {
+        return TEST_ABORTED;
+    }
+    memory = SDL_GetNumberProperty(props, "SDL.renderer.texture_memory", 0);
+    evictions = SDL_GetNumberProperty(props, "SDL.renderer.texture_evictions", 0);
+    SDLTest_AssertCheck(evictions == 1, "Validate evictions, expected: 1, got: %" SDL_PRIs64, evictions);
+    SDLTest_AssertCheck(memory == base + 3 * size, "Validate texture memory, expected: %" SDL_PRIs64 ", got: %" SDL_PRIs64, base + 3 * size, memory);
+
+    /* Drawing the evicted texture brings it back, making room by evicting the other one */
+    rect.x = 8;
+    rect.y = 4;
+    rect.w = 16;
+    rect.h = 16;
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+
+    dst.x = (float)rect.x;
+    dst.y = (float)rect.y;
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, textures[0], NULL, &dst))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+    evictions = SDL_GetNumberProperty(props, "SDL.renderer.texture_evictions", 0);
+    SDLTest_AssertCheck(reload_count == 1, "Validate reloads, expected: 1, got: %d", reload_count);
+    SDLTest_AssertCheck(evictions == 2, "Validate evictions, expected: 2, got: %" SDL_PRIs64, evictions);
+
+    for (i = 0; i < 4; ++i) {
+        SDL_DestroyTexture(textures[i]);
+    }
+    memory = SDL_GetNumberProperty(props, "SDL.renderer.texture_memory", 0);
+    SDLTest_AssertCheck(memory == base, "Validate texture memory, expected: %" SDL_PRIs64 ", got: %" SDL_PRIs64, base, memory);
+
+    SDL_DestroySurface(face);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
 /* Helper functions */
 
 /**
@@ -1275,11 +2487,77 @@ static const SDLTest_TestCaseReference renderTest9 = {
     (SDLTest_TestCaseFp)render_testLogicalSize, "render_testLogicalSize", "Tests logical size", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testCommandList, "render_testCommandList", "Tests recording and replaying command lists", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest11 = {
+    (SDLTest_TestCaseFp)render_testTextureAtlas, "render_testTextureAtlas", "Tests drawing textures packed into an atlas", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest12 = {
+    (SDLTest_TestCaseFp)render_testTextureInstanced, "render_testTextureInstanced", "Tests drawing texture instances", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest13 = {
+    (SDLTest_TestCaseFp)render_testRecorder, "render_testRecorder", "Tests drawing operations recorded on another thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest14 = {
+    (SDLTest_TestCaseFp)render_testUpdateTextureAsync, "render_testUpdateTextureAsync", "Tests updating a texture asynchronously", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest15 = {
+    (SDLTest_TestCaseFp)render_testStats, "render_testStats", "Tests the render statistics properties", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest16 = {
+    (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests threaded software rasterization", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest17 = {
+    (SDLTest_TestCaseFp)render_testPresentTiming, "render_testPresentTiming", "Tests the presentation timing feedback", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest18 = {
+    (SDLTest_TestCaseFp)render_testRenderTargetPool, "render_testRenderTargetPool", "Tests reusing render targets from the pool", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest19 = {
+    (SDLTest_TestCaseFp)render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels asynchronously", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest20 = {
+    (SDLTest_TestCaseFp)render_testLockShadow, "render_testLockShadow", "Tests streaming textures shadowed in CPU memory", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest21 = {
+    (SDLTest_TestCaseFp)render_testDistanceField, "render_testDistanceField", "Tests drawing distance field textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest22 = {
+    (SDLTest_TestCaseFp)render_testScaledPointsAndLines, "render_testScaledPointsAndLines", "Tests drawing points and lines with a render scale", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest23 = {
+    (SDLTest_TestCaseFp)render_testRotatedCopy, "render_testRotatedCopy", "Tests drawing rotated and flipped textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest24 = {
+    (SDLTest_TestCaseFp)render_testLogicalSizeDirect, "render_testLogicalSizeDirect", "Tests logical presentation without an intermediate texture", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest25 = {
+    (SDLTest_TestCaseFp)render_testTextureMemoryBudget, "render_testTextureMemoryBudget", "Tests texture memory accounting and eviction", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTest1, &renderTest2, &renderTest3, &renderTest4,
     &renderTest5, &renderTest6, &renderTest7, &renderTest8,
-    &renderTest9, NULL
+    &renderTest9, &renderTest10, &renderTest11, &renderTest12,
+    &renderTest13, &renderTest14, &renderTest15, &renderTest16,
+    &renderTest17, &renderTest18, &renderTest19, &renderTest20, &renderTest21, &renderTest22, &renderTest23, &renderTest24, &renderTest25, NULL
 };
 
 /* Render test suite (global) */
@@ -365,6 +365,64 @@ static int rwops_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a memory mapped file.
+ *
+ * \sa SDL_RWFromFileMapped
+ * \sa SDL_GetRWMemory
+ * \sa SDL_RWClose
+ */
+static int rwops_testFileMapped(void *arg)
+{
+    SDL_RWops *rw;
+    const void *mem;
+    size_t size;
+    int result;
+
+    rw = SDL_RWFromFileMapped(RWopsReadTestFilename);
+    SDLTest_AssertPass("Call to SDL_RWFromFileMapped() succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFileMapped does not return NULL");
+
+    /* Bail out if NULL */
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* A mapped file is backed by memory, other streams aren't */
+    mem = SDL_GetRWMemory(rw, &size);
+    if (rw->type == SDL_RWOPS_MAPPED) {
+        SDLTest_AssertCheck(mem != NULL, "Verify SDL_GetRWMemory() does not return NULL");
+        SDLTest_AssertCheck(size == SDL_strlen(RWopsHelloWorldTestString), "Verify mapped size; expected: %d, got: %d", (int)SDL_strlen(RWopsHelloWorldTestString), (int)size);
+        if (mem) {
+            SDLTest_AssertCheck(SDL_memcmp(mem, RWopsHelloWorldTestString, size) == 0, "Verify mapped contents");
+        }
+    } else {
+        SDLTest_AssertCheck(mem == NULL, "Verify SDL_GetRWMemory() returns NULL for a stream that isn't mapped");
+        SDLTest_AssertCheck(size == 0, "Verify size is 0; got: %d", (int)size);
+    }
+
+    /* Run generic tests */
+    testGenericRWopsValidations(rw, SDL_FALSE);
+
+    /* Close handle */
+    result = SDL_RWclose(rw);
+    SDLTest_AssertPass("Call to SDL_RWclose() succeeded");
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Memory streams are backed by their buffer */
+    rw = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromConstMem does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    mem = SDL_GetRWMemory(rw, &size);
+    SDLTest_AssertCheck(mem == RWopsAlphabetString, "Verify SDL_GetRWMemory() returns the buffer");
+    SDLTest_AssertCheck(size == sizeof(RWopsAlphabetString) - 1, "Verify size; expected: %d, got: %d", (int)sizeof(RWopsAlphabetString) - 1, (int)size);
+    SDL_RWclose(rw);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -440,6 +498,389 @@ static int rwops_testAllocFree(void *arg)
     return TEST_COMPLETED;
 }
 
+/* A stream that doesn't know its size, and returns its data in short reads like a pipe */
+static size_t SDLCALL pipe_read(SDL_RWops *context, void *ptr, size_t size)
+{
+    const Uint8 *data = (const Uint8 *)context->hidden.unknown.data1;
+    size_t *left = (size_t *)context->hidden.unknown.data2;
+
+    size = SDL_min(size, SDL_min(*left, 1000));
+    SDL_memcpy(ptr, data, size);
+    context->hidden.unknown.data1 = (void *)(data + size);
+    *left -= size;
+    return size;
+}
+
+/**
+ * Tests loading a stream of unknown size.
+ *
+ * \sa SDL_LoadFile_RW
+ */
+static int rwops_testLoadFileUnknownSize(void *arg)
+{
+    const size_t datalen = 300000;
+    const Sint64 hints[] = { 0, 1, 300000, 1000000 };
+    Uint8 *data;
+    size_t i, left, size;
+    int h;
+
+    data = (Uint8 *)SDL_malloc(datalen);
+    SDLTest_AssertCheck(data != NULL, "Verify memory allocation");
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < datalen; ++i) {
+        data[i] = (Uint8)(i * 7 + (i >> 8));
+    }
+
+    for (h = 0; h < SDL_arraysize(hints); ++h) {
+        SDL_RWops *rw = SDL_CreateRW();
+        void *loaded;
+
+        SDLTest_AssertCheck(rw != NULL, "Validate result from SDL_CreateRW() is not NULL");
+        if (rw == NULL) {
+            break;
+        }
+        left = datalen;
+        rw->read = pipe_read;
+        rw->hidden.unknown.data1 = data;
+        rw->hidden.unknown.data2 = &left;
+        if (hints[h]) {
+            SDL_SetNumberProperty(SDL_GetRWProperties(rw), "SDL.rwops.size_hint", hints[h]);
+        }
+
+        size = 0;
+        loaded = SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+        SDLTest_AssertPass("Call to SDL_LoadFile_RW() with size hint %d", (int)hints[h]);
+        SDLTest_AssertCheck(loaded != NULL, "Verify result is not NULL");
+        SDLTest_AssertCheck(size == datalen, "Verify size; expected: %d, got: %d", (int)datalen, (int)size);
+        if (loaded) {
+            SDLTest_AssertCheck(SDL_memcmp(loaded, data, datalen) == 0, "Verify loaded data");
+            SDLTest_AssertCheck(((Uint8 *)loaded)[size] == 0, "Verify loaded data is null terminated");
+            SDL_free(loaded);
+        }
+    }
+
+    SDL_free(data);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading and writing through a buffered stream
+ *
+ * \sa SDL_CreateBufferedRW
+ */
+static int rwops_testBuffered(void *arg)
+{
+    const size_t datalen = 4000;
+    SDL_RWops *rw;
+    Uint8 *data;
+    Uint8 u8 = 0;
+    Uint16 u16 = 0;
+    Uint32 u32 = 0;
+    Uint64 u64 = 0;
+    char buf[64];
+    size_t i, left, count;
+    Sint64 pos;
+    int result;
+
+    /* Small values and a write larger than the buffer, read back with seeks */
+    rw = SDL_CreateBufferedRW(SDL_RWFromFile(RWopsWriteTestFilename, "w+"), 16, SDL_TRUE);
+    SDLTest_AssertCheck(rw != NULL, "Verify result from SDL_CreateBufferedRW() is not NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(rw->type == SDL_RWOPS_BUFFERED, "Verify RWops type is SDL_RWOPS_BUFFERED; expected: %d, got: %" SDL_PRIu32, SDL_RWOPS_BUFFERED, rw->type);
+    SDLTest_AssertCheck(SDL_WriteU8(rw, 0x12), "Verify result from SDL_WriteU8()");
+    SDLTest_AssertCheck(SDL_WriteU16BE(rw, 0x3456), "Verify result from SDL_WriteU16BE()");
+    SDLTest_AssertCheck(SDL_WriteU32LE(rw, 0x789ABCDE), "Verify result from SDL_WriteU32LE()");
+    SDLTest_AssertCheck(SDL_WriteU64BE(rw, 0x0123456789ABCDEFULL), "Verify result from SDL_WriteU64BE()");
+    count = SDL_RWwrite(rw, RWopsAlphabetString, SDL_strlen(RWopsAlphabetString));
+    SDLTest_AssertCheck(count == SDL_strlen(RWopsAlphabetString), "Verify result from SDL_RWwrite(); expected: %d, got: %d", (int)SDL_strlen(RWopsAlphabetString), (int)count);
+    pos = SDL_RWtell(rw);
+    SDLTest_AssertCheck(pos == 15 + 26, "Verify position after writing; expected: 41, got: %d", (int)pos);
+
+    pos = SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == 0, "Verify result from SDL_RWseek(0, SDL_RW_SEEK_SET); expected: 0, got: %d", (int)pos);
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 0x12, "Verify result from SDL_ReadU8()");
+    SDLTest_AssertCheck(SDL_ReadU16BE(rw, &u16) && u16 == 0x3456, "Verify result from SDL_ReadU16BE()");
+    SDLTest_AssertCheck(SDL_ReadU32LE(rw, &u32) && u32 == 0x789ABCDE, "Verify result from SDL_ReadU32LE()");
+    pos = SDL_RWseek(rw, -4, SDL_RW_SEEK_CUR);
+    SDLTest_AssertCheck(pos == 3, "Verify seeking back within the buffer; expected: 3, got: %d", (int)pos);
+    SDLTest_AssertCheck(SDL_ReadU32LE(rw, &u32) && u32 == 0x789ABCDE, "Verify result from SDL_ReadU32LE() after seeking");
+    SDLTest_AssertCheck(SDL_ReadU64BE(rw, &u64) && u64 == 0x0123456789ABCDEFULL, "Verify result from SDL_ReadU64BE()");
+    pos = SDL_RWtell(rw);
+    SDLTest_AssertCheck(pos == 15, "Verify position after reading; expected: 15, got: %d", (int)pos);
+    count = SDL_RWread(rw, buf, sizeof(buf));
+    SDLTest_AssertCheck(count == 26, "Verify result from SDL_RWread(); expected: 26, got: %d", (int)count);
+    SDLTest_AssertCheck(SDL_memcmp(buf, RWopsAlphabetString, 26) == 0, "Verify the data read back");
+    count = SDL_RWread(rw, buf, 1);
+    SDLTest_AssertCheck(count == 0 && rw->status == SDL_RWOPS_STATUS_EOF, "Verify reading at the end of the file");
+    pos = SDL_RWsize(rw);
+    SDLTest_AssertCheck(pos == 41, "Verify result from SDL_RWsize(); expected: 41, got: %d", (int)pos);
+
+    /* Overwrite in the middle after reading, the buffered read data has to be dropped */
+    pos = SDL_RWseek(rw, 1, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == 1, "Verify result from SDL_RWseek(1, SDL_RW_SEEK_SET); expected: 1, got: %d", (int)pos);
+    SDLTest_AssertCheck(SDL_ReadU16BE(rw, &u16) && u16 == 0x3456, "Verify result from SDL_ReadU16BE()");
+    SDLTest_AssertCheck(SDL_WriteU32LE(rw, 0x01020304), "Verify result from SDL_WriteU32LE()");
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 0x01, "Verify the byte after the write");
+    pos = SDL_RWseek(rw, 3, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == 3, "Verify result from SDL_RWseek(3, SDL_RW_SEEK_SET); expected: 3, got: %d", (int)pos);
+    SDLTest_AssertCheck(SDL_ReadU32LE(rw, &u32) && u32 == 0x01020304, "Verify the written value");
+
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_RWclose(), expected 0, got %i", result);
+
+    /* Small reads from a stream that can't seek */
+    data = (Uint8 *)SDL_malloc(datalen);
+    SDLTest_AssertCheck(data != NULL, "Verify memory allocation");
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < datalen; ++i) {
+        data[i] = (Uint8)(i * 7 + (i >> 8));
+    }
+    rw = SDL_CreateRW();
+    SDLTest_AssertCheck(rw != NULL, "Validate result from SDL_CreateRW() is not NULL");
+    if (rw == NULL) {
+        SDL_free(data);
+        return TEST_ABORTED;
+    }
+    left = datalen;
+    rw->read = pipe_read;
+    rw->hidden.unknown.data1 = data;
+    rw->hidden.unknown.data2 = &left;
+    rw = SDL_CreateBufferedRW(rw, 0, SDL_TRUE);
+    SDLTest_AssertCheck(rw != NULL, "Verify result from SDL_CreateBufferedRW() is not NULL");
+    if (rw == NULL) {
+        SDL_free(data);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(rw->seek == NULL && rw->write == NULL, "Verify a read-only stream that can't seek stays that way");
+    for (i = 0; i < datalen; i += 4) {
+        const Uint32 expected = (Uint32)data[i] | ((Uint32)data[i + 1] << 8) | ((Uint32)data[i + 2] << 16) | ((Uint32)data[i + 3] << 24);
+        if (!SDL_ReadU32LE(rw, &u32) || u32 != expected) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == datalen, "Verify values read; expected: %d bytes, got: %d", (int)datalen, (int)i);
+    SDLTest_AssertCheck(!SDL_ReadU8(rw, &u8), "Verify reading past the end fails");
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_RWclose(), expected 0, got %i", result);
+
+    SDL_free(data);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading and writing at offsets, with native support and by seeking
+ *
+ * \sa SDL_RWreadAt
+ * \sa SDL_RWreadvAt
+ * \sa SDL_RWwriteAt
+ */
+static int rwops_testReadAt(void *arg)
+{
+    const char *names[] = { "file", "memory", "memory without positional callbacks" };
+    char mem[26];
+    char buf[64];
+    char part1[5], part2[7], part3[40];
+    SDL_RWvec vec[3];
+    SDL_RWops *rw;
+    size_t count;
+    Sint64 pos;
+    int i, result;
+
+    for (i = 0; i < SDL_arraysize(names); ++i) {
+        if (i == 0) {
+            rw = SDL_RWFromFile(RWopsWriteTestFilename, "w+");
+            SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in write mode does not return NULL");
+            if (rw == NULL) {
+                return TEST_ABORTED;
+            }
+            count = SDL_RWwrite(rw, RWopsAlphabetString, sizeof(mem));
+            SDLTest_AssertCheck(count == sizeof(mem), "Verify result from SDL_RWwrite(); expected: %d, got: %d", (int)sizeof(mem), (int)count);
+        } else {
+            SDL_memcpy(mem, RWopsAlphabetString, sizeof(mem));
+            rw = SDL_RWFromMem(mem, sizeof(mem));
+            SDLTest_AssertCheck(rw != NULL, "Verify result from SDL_RWFromMem() is not NULL");
+            if (rw == NULL) {
+                return TEST_ABORTED;
+            }
+            if (i == 2) {
+                rw->readat = NULL;
+                rw->writeat = NULL;
+            }
+            SDL_RWseek(rw, 0, SDL_RW_SEEK_END);
+        }
+        SDLTest_Log("Testing %s stream", names[i]);
+
+        count = SDL_RWwriteAt(rw, "0123", 4, 10);
+        SDLTest_AssertCheck(count == 4, "Verify result from SDL_RWwriteAt(); expected: 4, got: %d", (int)count);
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 26, "Verify the position after SDL_RWwriteAt(); expected: 26, got: %d", (int)pos);
+        count = SDL_RWreadAt(rw, buf, sizeof(buf), 8);
+        SDLTest_AssertCheck(count == 18, "Verify result from SDL_RWreadAt(); expected: 18, got: %d", (int)count);
+        SDLTest_AssertCheck(SDL_memcmp(buf, "IJ0123OPQRSTUVWXYZ", 18) == 0, "Verify the data read at an offset");
+        count = SDL_RWreadAt(rw, buf, 1, 26);
+        SDLTest_AssertCheck(count == 0, "Verify reading at the end with SDL_RWreadAt(); expected: 0, got: %d", (int)count);
+        count = SDL_RWreadAt(rw, buf, 1, -1);
+        SDLTest_AssertCheck(count == 0, "Verify reading at a negative offset with SDL_RWreadAt(); expected: 0, got: %d", (int)count);
+
+        /* Sequential reads keep their place around reads at an offset */
+        SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+        count = SDL_RWread(rw, buf, 4);
+        SDLTest_AssertCheck(count == 4 && SDL_memcmp(buf, "ABCD", 4) == 0, "Verify result from SDL_RWread()");
+        vec[0].ptr = part1;
+        vec[0].size = sizeof(part1);
+        vec[1].ptr = part2;
+        vec[1].size = sizeof(part2);
+        vec[2].ptr = part3;
+        vec[2].size = sizeof(part3);
+        count = SDL_RWreadvAt(rw, vec, SDL_arraysize(vec), 2);
+        SDLTest_AssertCheck(count == 24, "Verify result from SDL_RWreadvAt(); expected: 24, got: %d", (int)count);
+        SDLTest_AssertCheck(SDL_memcmp(part1, "CDEFG", sizeof(part1)) == 0, "Verify the data read into the first area");
+        SDLTest_AssertCheck(SDL_memcmp(part2, "HIJ0123", sizeof(part2)) == 0, "Verify the data read into the second area");
+        SDLTest_AssertCheck(SDL_memcmp(part3, "OPQRSTUVWXYZ", 12) == 0, "Verify the data read into the third area");
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 4, "Verify the position after SDL_RWreadvAt(); expected: 4, got: %d", (int)pos);
+        count = SDL_RWread(rw, buf, 4);
+        SDLTest_AssertCheck(count == 4 && SDL_memcmp(buf, "EFGH", 4) == 0, "Verify result from SDL_RWread() after SDL_RWreadvAt()");
+
+        /* Sequential reads see what was written at an offset */
+        count = SDL_RWwriteAt(rw, "xy", 2, 8);
+        SDLTest_AssertCheck(count == 2, "Verify result from SDL_RWwriteAt(); expected: 2, got: %d", (int)count);
+        count = SDL_RWread(rw, buf, 4);
+        SDLTest_AssertCheck(count == 4 && SDL_memcmp(buf, "xy01", 4) == 0, "Verify result from SDL_RWread() after SDL_RWwriteAt()");
+
+        result = SDL_RWclose(rw);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_RWclose(), expected 0, got %i", result);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests writing and reading a file with asynchronous I/O
+ *
+ * \sa SDL_AsyncIOFromFile
+ * \sa SDL_WriteAsyncIO
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_CloseAsyncIO
+ */
+static int rwops_testAsyncIO(void *arg)
+{
+    const size_t datalen = 256 * 1024;
+    const int numreads = 8;
+    const size_t readlen = datalen / numreads;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOOutcome outcome;
+    SDL_AsyncIO *asyncio;
+    Uint8 *data, *readback;
+    size_t i;
+    int result, done, fails;
+
+    data = (Uint8 *)SDL_malloc(datalen);
+    readback = (Uint8 *)SDL_calloc(1, datalen + 16);
+    SDLTest_AssertCheck(data != NULL && readback != NULL, "Verify memory allocation");
+    if (data == NULL || readback == NULL) {
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < datalen; ++i) {
+        data[i] = (Uint8)(i * 13 + (i >> 10));
+    }
+
+    queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(queue != NULL, "Verify result from SDL_CreateAsyncIOQueue() is not NULL");
+    if (queue == NULL) {
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+
+    SDLTest_AssertCheck(!SDL_GetAsyncIOResult(queue, &outcome), "Verify an empty queue has no results");
+    SDL_SignalAsyncIOQueue(queue);
+    SDLTest_AssertCheck(!SDL_WaitAsyncIOResult(queue, &outcome, 10), "Verify waiting on an empty queue times out");
+
+    asyncio = SDL_AsyncIOFromFile(RWopsWriteTestFilename, "a");
+    SDLTest_AssertCheck(asyncio == NULL, "Verify append mode is rejected");
+
+    /* Write the file in two halves, in reverse order */
+    asyncio = SDL_AsyncIOFromFile(RWopsWriteTestFilename, "w");
+    SDLTest_AssertCheck(asyncio != NULL, "Verify result from SDL_AsyncIOFromFile(\"w\") is not NULL");
+    if (asyncio == NULL) {
+        SDL_DestroyAsyncIOQueue(queue);
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+    result = SDL_WriteAsyncIO(asyncio, data + datalen / 2, datalen / 2, datalen / 2, queue, &data[1]);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_WriteAsyncIO(), expected 0, got %i", result);
+    result = SDL_WriteAsyncIO(asyncio, data, 0, datalen / 2, queue, &data[0]);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_WriteAsyncIO(), expected 0, got %i", result);
+    result = SDL_CloseAsyncIO(asyncio, queue, NULL);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_CloseAsyncIO(), expected 0, got %i", result);
+
+    done = fails = 0;
+    while (done < 3 && SDL_WaitAsyncIOResult(queue, &outcome, 5000)) {
+        ++done;
+        if (outcome.result != SDL_ASYNCIO_COMPLETE) {
+            ++fails;
+        }
+        if (outcome.type == SDL_ASYNCIO_TASK_CLOSE) {
+            SDLTest_AssertCheck(done == 3, "Verify the close finished after the writes");
+        } else {
+            SDLTest_AssertCheck(outcome.type == SDL_ASYNCIO_TASK_WRITE, "Verify the task type is a write");
+            SDLTest_AssertCheck(outcome.bytes_transferred == datalen / 2, "Verify bytes written; expected: %d, got: %d", (int)(datalen / 2), (int)outcome.bytes_transferred);
+            SDLTest_AssertCheck(outcome.userdata == &data[0] || outcome.userdata == &data[1], "Verify the userdata");
+        }
+    }
+    SDLTest_AssertCheck(done == 3, "Verify all writes finished; expected: 3, got: %d", done);
+    SDLTest_AssertCheck(fails == 0, "Verify no tasks failed; got: %d", fails);
+
+    /* Read it back in pieces all at once, plus a read past the end */
+    asyncio = SDL_AsyncIOFromFile(RWopsWriteTestFilename, "r");
+    SDLTest_AssertCheck(asyncio != NULL, "Verify result from SDL_AsyncIOFromFile(\"r\") is not NULL");
+    if (asyncio == NULL) {
+        SDL_DestroyAsyncIOQueue(queue);
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_GetAsyncIOSize(asyncio) == (Sint64)datalen, "Verify result from SDL_GetAsyncIOSize(); expected: %d, got: %d", (int)datalen, (int)SDL_GetAsyncIOSize(asyncio));
+    for (i = 0; i < (size_t)numreads; ++i) {
+        const size_t len = (i == numreads - 1) ? (readlen + 16) : readlen;
+        result = SDL_ReadAsyncIO(asyncio, readback + i * readlen, i * readlen, len, queue, NULL);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_ReadAsyncIO(), expected 0, got %i", result);
+    }
+    result = SDL_CloseAsyncIO(asyncio, queue, NULL);
+    SDLTest_AssertCheck(result == 0, "Verify result from SDL_CloseAsyncIO(), expected 0, got %i", result);
+
+    done = fails = 0;
+    while (done < numreads + 1 && SDL_WaitAsyncIOResult(queue, &outcome, 5000)) {
+        ++done;
+        if (outcome.result != SDL_ASYNCIO_COMPLETE) {
+            ++fails;
+        }
+        if (outcome.type == SDL_ASYNCIO_TASK_READ) {
+            SDLTest_AssertCheck(outcome.bytes_transferred == readlen, "Verify bytes read at %d; expected: %d, got: %d", (int)outcome.offset, (int)readlen, (int)outcome.bytes_transferred);
+        }
+    }
+    SDLTest_AssertCheck(done == numreads + 1, "Verify all reads finished; expected: %d, got: %d", numreads + 1, done);
+    SDLTest_AssertCheck(fails == 0, "Verify no tasks failed; got: %d", fails);
+    SDLTest_AssertCheck(SDL_memcmp(readback, data, datalen) == 0, "Verify the data read back");
+
+    SDL_DestroyAsyncIOQueue(queue);
+    SDLTest_AssertPass("Call to SDL_DestroyAsyncIOQueue()");
+
+    SDL_free(data);
+    SDL_free(readback);
+    return TEST_COMPLETED;
+}
+
 /**
  * Compare memory and file reads
  *
@@ -670,10 +1111,31 @@ static const SDLTest_TestCaseReference rwopsTest8 = {
     (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference rwopsTest9 = {
+    (SDLTest_TestCaseFp)rwops_testFileMapped, "rwops_testFileMapped", "Tests reading from a memory mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest10 = {
+    (SDLTest_TestCaseFp)rwops_testLoadFileUnknownSize, "rwops_testLoadFileUnknownSize", "Tests loading a stream of unknown size", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest11 = {
+    (SDLTest_TestCaseFp)rwops_testAsyncIO, "rwops_testAsyncIO", "Tests asynchronous file reads and writes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest12 = {
+    (SDLTest_TestCaseFp)rwops_testBuffered, "rwops_testBuffered", "Tests reading and writing through a buffered stream", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest13 = {
+    (SDLTest_TestCaseFp)rwops_testReadAt, "rwops_testReadAt", "Tests reading and writing at offsets", TEST_ENABLED
+};
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] = {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9,
+    &rwopsTest10, &rwopsTest11, &rwopsTest12, &rwopsTest13, NULL
 };
 
 /* RWops test suite (global) */
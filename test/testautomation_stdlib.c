@@ -766,6 +766,378 @@ static int stdlib_aligned_alloc(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_CreateArena, SDL_ArenaAlloc, SDL_ResetArena and SDL_GetThreadArena
+ */
+static int stdlib_arena(void *arg)
+{
+    SDL_Arena *arena;
+    void *first, *second, *large, *ptr;
+    size_t mark, inner_mark;
+
+    arena = SDL_CreateArena(256);
+    SDLTest_AssertPass("Call to SDL_CreateArena(256)");
+    SDLTest_AssertCheck(arena != NULL, "Check output, expected non-NULL, got: %p", (void *)arena);
+    if (!arena) {
+        return TEST_ABORTED;
+    }
+
+    first = SDL_ArenaAlloc(arena, 1);
+    second = SDL_ArenaAlloc(arena, 100);
+    SDLTest_AssertPass("Call to SDL_ArenaAlloc()");
+    SDLTest_AssertCheck(first != NULL && second != NULL, "Check output, expected non-NULL");
+    SDLTest_AssertCheck((((size_t)second) % 16) == 0, "Check output, expected aligned pointer, actual offset: %" SIZE_FORMAT, (((size_t)second) % 16));
+    SDLTest_AssertCheck(second != first, "Check output, expected separate allocations");
+    SDL_memset(second, 0xAA, 100);
+
+    mark = SDL_GetArenaMark(arena);
+    SDLTest_AssertPass("Call to SDL_GetArenaMark()");
+    SDLTest_AssertCheck(mark != 0, "Check output, expected non-zero mark");
+
+    /* Allocations larger than a block get one of their own */
+    large = SDL_ArenaAlloc(arena, 4096);
+    SDLTest_AssertCheck(large != NULL, "Check output, expected non-NULL, got: %p", large);
+    SDL_memset(large, 0xBB, 4096);
+
+    inner_mark = SDL_GetArenaMark(arena);
+    ptr = SDL_ArenaAlloc(arena, 16);
+    SDL_ResetArena(arena, inner_mark);
+    SDLTest_AssertPass("Call to SDL_ResetArena() with a nested mark");
+    SDLTest_AssertCheck(SDL_ArenaAlloc(arena, 16) == ptr, "Check output, expected the nested allocation to be reused");
+
+    SDL_ResetArena(arena, mark);
+    SDLTest_AssertPass("Call to SDL_ResetArena() with an outer mark");
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == mark, "Check output, expected mark %" SIZE_FORMAT ", got %" SIZE_FORMAT, mark, SDL_GetArenaMark(arena));
+    SDLTest_AssertCheck(((Uint8 *)second)[99] == 0xAA, "Check output, expected earlier allocations to be kept");
+
+    SDL_ResetArena(arena, 0);
+    SDLTest_AssertPass("Call to SDL_ResetArena(0)");
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == 0, "Check output, expected mark 0, got %" SIZE_FORMAT, SDL_GetArenaMark(arena));
+    SDLTest_AssertCheck(SDL_ArenaAlloc(arena, 4096) == large, "Check output, expected the large block to be reused");
+
+    SDL_DestroyArena(arena);
+    SDLTest_AssertPass("Call to SDL_DestroyArena()");
+
+    SDL_ClearError();
+    ptr = SDL_ArenaAlloc(NULL, 1);
+    SDLTest_AssertPass("Call to SDL_ArenaAlloc(NULL, 1)");
+    SDLTest_AssertCheck(ptr == NULL, "Check output, expected NULL, got: %p", ptr);
+    SDLTest_AssertCheck(*SDL_GetError() != '\0', "Check that an error was set");
+    SDL_ResetArena(NULL, 0);
+    SDL_DestroyArena(NULL);
+    SDLTest_AssertPass("Call to SDL_ResetArena(NULL) and SDL_DestroyArena(NULL)");
+
+    arena = SDL_GetThreadArena();
+    SDLTest_AssertPass("Call to SDL_GetThreadArena()");
+    SDLTest_AssertCheck(arena != NULL, "Check output, expected non-NULL, got: %p", (void *)arena);
+    SDLTest_AssertCheck(SDL_GetThreadArena() == arena, "Check that the same arena is returned each time");
+    mark = SDL_GetArenaMark(arena);
+    ptr = SDL_ArenaAlloc(arena, 64);
+    SDLTest_AssertCheck(ptr != NULL, "Check output, expected non-NULL, got: %p", ptr);
+    SDL_ResetArena(arena, mark);
+
+    return TEST_COMPLETED;
+}
+
+/* The original bit at a time implementations, which the optimized ones must match */
+static Uint32 reference_crc32(Uint32 crc, const Uint8 *data, size_t len)
+{
+    size_t i;
+    int j;
+
+    for (i = 0; i < len; ++i) {
+        Uint32 r = (Uint8)crc ^ data[i];
+        for (j = 0; j < 8; ++j) {
+            r = (r & 1 ? 0 : (Uint32)0xEDB88320L) ^ r >> 1;
+        }
+        crc = (r ^ (Uint32)0xFF000000L) ^ crc >> 8;
+    }
+    return crc;
+}
+
+static Uint16 reference_crc16(Uint16 crc, const Uint8 *data, size_t len)
+{
+    size_t i;
+    int j;
+
+    for (i = 0; i < len; ++i) {
+        Uint8 r = (Uint8)crc ^ data[i];
+        Uint16 value = 0;
+        for (j = 0; j < 8; ++j) {
+            value = ((value ^ r) & 1 ? 0xA001 : 0) ^ value >> 1;
+            r >>= 1;
+        }
+        crc = value ^ crc >> 8;
+    }
+    return crc;
+}
+
+/**
+ * Call to SDL_crc32 and SDL_crc16
+ */
+static int stdlib_crc(void *arg)
+{
+    static const size_t lengths[] = { 0, 1, 7, 8, 15, 16, 63, 64, 65, 127, 128, 200, 1000, 4096 };
+    Uint8 data[4096 + 8];
+    Uint32 crc32;
+    Uint16 crc16;
+    size_t i, offset;
+    int mismatches = 0;
+
+    crc32 = SDL_crc32(0, "123456789", 9);
+    SDLTest_AssertCheck(crc32 == 0xCBF43926, "Check CRC32 check value, expected 0xCBF43926, got: 0x%.8" SDL_PRIx32, crc32);
+    crc16 = SDL_crc16(0, "123456789", 9);
+    SDLTest_AssertCheck(crc16 == 0xBB3D, "Check CRC16 check value, expected 0xBB3D, got: 0x%.4x", crc16);
+
+    for (i = 0; i < sizeof(data); ++i) {
+        data[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    }
+    for (offset = 0; offset < 8; ++offset) {
+        for (i = 0; i < SDL_arraysize(lengths); ++i) {
+            const Uint8 *p = data + offset;
+            const size_t len = lengths[i];
+            if (SDL_crc32(0x12345678, p, len) != reference_crc32(0x12345678, p, len) ||
+                SDL_crc16(0x1234, p, len) != reference_crc16(0x1234, p, len)) {
+                SDLTest_LogError("CRC mismatch at offset %d, length %d", (int)offset, (int)len);
+                ++mismatches;
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Check CRCs match the reference implementation, got %d mismatches", mismatches);
+
+    crc32 = SDL_crc32(SDL_crc32(0, data, 100), data + 100, 1000);
+    SDLTest_AssertCheck(crc32 == SDL_crc32(0, data, 1100), "Check CRC32 can be calculated incrementally");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_iconv_string
+ */
+static int stdlib_iconv_string(void *arg)
+{
+    /* This is long enough to have a run of ASCII text, with 2, 3 and 4 byte characters */
+    static const char utf8[] = "The quick brown fox says \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 to the lazy dog";
+    static const Uint8 utf16le_tail[] = { 0xE9, 0x00, 0xAC, 0x20, 0x3D, 0xD8, 0x00, 0xDE, ' ', 0x00 };
+    static const char *formats[] = { "UTF-8", "UTF-16LE", "UTF-16BE", "UTF-32LE", "UTF-32BE", "WCHAR_T" };
+    const size_t count = SDL_utf8strlen(utf8) + 1;
+    /* There's one character that needs a surrogate pair */
+    const size_t sizes[] = { sizeof(utf8), (count + 1) * 2, (count + 1) * 2, count * 4, count * 4, (sizeof(wchar_t) == 2) ? (count + 1) * 2 : count * 4 };
+    char *utf16le, *converted, *result;
+    int i;
+
+    utf16le = SDL_iconv_string("UTF-16LE", "UTF-8", utf8, sizeof(utf8));
+    SDLTest_AssertPass("Call to SDL_iconv_string(\"UTF-16LE\", \"UTF-8\", ...)");
+    SDLTest_AssertCheck(utf16le != NULL, "Check result is not NULL");
+    if (utf16le) {
+        SDLTest_AssertCheck(utf16le[0] == 'T' && utf16le[1] == 0 && utf16le[46] == 's' && utf16le[47] == 0, "Check ASCII characters were widened");
+        SDLTest_AssertCheck(SDL_memcmp(&utf16le[50], utf16le_tail, sizeof(utf16le_tail)) == 0, "Check non-ASCII characters were encoded");
+        SDL_free(utf16le);
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        converted = SDL_iconv_string(formats[i], "UTF-8", utf8, sizeof(utf8));
+        result = SDL_iconv_string("UTF-8", formats[i], converted, sizes[i]);
+        SDLTest_AssertPass("Call to SDL_iconv_string(\"%s\", \"UTF-8\", ...) and back", formats[i]);
+        SDLTest_AssertCheck(result && SDL_strcmp(result, utf8) == 0, "Check round trip, expected: '%s', got: '%s'", utf8, result ? result : "(null)");
+        SDL_free(converted);
+        SDL_free(result);
+    }
+
+    /* Invalid sequences are handled by the general converter */
+    result = SDL_iconv_string("UTF-16LE", "UTF-8", "a\xFF" "b", 4);
+    SDLTest_AssertPass("Call to SDL_iconv_string(\"UTF-16LE\", \"UTF-8\", \"a\\xFFb\")");
+    SDLTest_AssertCheck(result && result[0] == 'a' && result[1] == 0, "Check text before the invalid sequence was converted");
+    SDL_free(result);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    Uint8 pad; /* Makes the keys unaligned */
+    Uint8 key[4];
+    int index;
+} sort_element;
+
+static int SDLCALL sort_compare_int(void *userdata, const void *a, const void *b)
+{
+    const int A = *(const int *)a;
+    const int B = *(const int *)b;
+
+    ++*(int *)userdata;
+    return (A < B) ? -1 : (A > B);
+}
+
+static int SDLCALL sort_compare_uint8(void *userdata, const void *a, const void *b)
+{
+    (void)userdata;
+    return (int)*(const Uint8 *)a - (int)*(const Uint8 *)b;
+}
+
+static int SDLCALL sort_compare_key(void *userdata, const void *a, const void *b)
+{
+    Uint32 A, B;
+
+    (void)userdata;
+    SDL_memcpy(&A, ((const sort_element *)a)->key, sizeof(A));
+    SDL_memcpy(&B, ((const sort_element *)b)->key, sizeof(B));
+    return (A < B) ? -1 : (A > B);
+}
+
+static SDL_bool sort_check_elements(const sort_element *elements, int count, SDL_bool floats)
+{
+    int i;
+
+    for (i = 1; i < count; ++i) {
+        const int order = SDL_memcmp(elements[i - 1].key, elements[i].key, 4) == 0 ? 0 : 1;
+        Uint32 A, B;
+        float fA, fB;
+
+        SDL_memcpy(&A, elements[i - 1].key, sizeof(A));
+        SDL_memcpy(&B, elements[i].key, sizeof(B));
+        SDL_memcpy(&fA, &A, sizeof(fA));
+        SDL_memcpy(&fB, &B, sizeof(fB));
+        if (floats ? (fA > fB) : (A > B)) {
+            return SDL_FALSE;
+        }
+        /* Equal keys keep their order */
+        if (!order && elements[i - 1].index > elements[i].index) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/**
+ * Call to SDL_qsort_r, SDL_StableSort and the radix sorts
+ */
+static int stdlib_sort(void *arg)
+{
+    static const int counts[] = { 0, 1, 2, 23, 24, 25, 129, 1000, 10000 };
+    const int max_count = 10000;
+    int *numbers = (int *)SDL_malloc(max_count * sizeof(*numbers));
+    Uint8 *bytes = (Uint8 *)SDL_malloc(max_count * 3);
+    sort_element *elements = (sort_element *)SDL_malloc(max_count * sizeof(*elements));
+    int i, j, pattern, comparisons = 0;
+    SDL_bool sorted;
+    size_t key_offset;
+
+    SDLTest_AssertCheck(numbers && bytes && elements, "Check memory allocation");
+    if (!numbers || !bytes || !elements) {
+        SDL_free(numbers);
+        SDL_free(bytes);
+        SDL_free(elements);
+        return TEST_ABORTED;
+    }
+
+    for (pattern = 0; pattern < 5; ++pattern) {
+        for (i = 0; i < SDL_arraysize(counts); ++i) {
+            const int count = counts[i];
+            void *found;
+
+            for (j = 0; j < count; ++j) {
+                switch (pattern) {
+                case 0: /* random */
+                    numbers[j] = SDLTest_RandomIntegerInRange(-1000000, 1000000);
+                    break;
+                case 1: /* sorted */
+                    numbers[j] = j;
+                    break;
+                case 2: /* reversed */
+                    numbers[j] = count - j;
+                    break;
+                case 3: /* lots of duplicates */
+                    numbers[j] = SDLTest_RandomIntegerInRange(0, 3);
+                    break;
+                default: /* sawtooth */
+                    numbers[j] = j % 17;
+                    break;
+                }
+            }
+            comparisons = 0;
+            SDL_qsort_r(numbers, count, sizeof(*numbers), sort_compare_int, &comparisons);
+            sorted = SDL_TRUE;
+            for (j = 1; j < count; ++j) {
+                if (numbers[j - 1] > numbers[j]) {
+                    sorted = SDL_FALSE;
+                }
+            }
+            SDLTest_AssertCheck(sorted, "Check SDL_qsort_r() sorted %d integers with pattern %d", count, pattern);
+            if (pattern == 1 && count == max_count) {
+                SDLTest_AssertCheck(comparisons < 3 * count, "Check a sorted array takes linear time, expected < %d comparisons, got %d", 3 * count, comparisons);
+            }
+
+            if (count > 0) {
+                found = SDL_bsearch_r(&numbers[count / 2], numbers, count, sizeof(*numbers), sort_compare_int, &comparisons);
+                SDLTest_AssertCheck(found && *(int *)found == numbers[count / 2], "Check SDL_bsearch_r() found an element");
+            }
+        }
+    }
+
+    /* Elements that aren't a multiple of the word size */
+    for (j = 0; j < max_count * 3; ++j) {
+        bytes[j] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    }
+    SDL_qsort_r(bytes, max_count, 3, sort_compare_uint8, NULL);
+    sorted = SDL_TRUE;
+    for (j = 1; j < max_count; ++j) {
+        if (bytes[(j - 1) * 3] > bytes[j * 3]) {
+            sorted = SDL_FALSE;
+        }
+    }
+    SDLTest_AssertCheck(sorted, "Check SDL_qsort_r() sorted 3 byte elements");
+
+    key_offset = (size_t)(elements[0].key - (Uint8 *)&elements[0]);
+    for (i = 0; i < 4; ++i) {
+        for (j = 0; j < max_count; ++j) {
+            Uint32 key;
+
+            if (i == 3) {
+                const float value = (float)SDLTest_RandomIntegerInRange(-100, 100) / 4.0f;
+                SDL_memcpy(&key, &value, sizeof(key));
+            } else {
+                key = (Uint32)SDLTest_RandomIntegerInRange(0, 100) * 0x01010101;
+            }
+            SDL_memcpy(elements[j].key, &key, sizeof(key));
+            elements[j].index = j;
+        }
+        switch (i) {
+        case 0:
+            SDL_StableSort(elements, max_count, sizeof(*elements), sort_compare_key, NULL);
+            SDLTest_AssertCheck(sort_check_elements(elements, max_count, SDL_FALSE), "Check SDL_StableSort() sorted elements and kept equal ones in order");
+            break;
+        case 1:
+            SDL_SortByUint32Key(elements, max_count, sizeof(*elements), key_offset);
+            SDLTest_AssertCheck(sort_check_elements(elements, max_count, SDL_FALSE), "Check SDL_SortByUint32Key() sorted elements and kept equal ones in order");
+            break;
+        case 2:
+            SDL_SortBySint32Key(elements, max_count, sizeof(*elements), key_offset);
+            sorted = SDL_TRUE;
+            for (j = 1; j < max_count; ++j) {
+                Sint32 A, B;
+
+                SDL_memcpy(&A, elements[j - 1].key, sizeof(A));
+                SDL_memcpy(&B, elements[j].key, sizeof(B));
+                if (A > B || (A == B && elements[j - 1].index > elements[j].index)) {
+                    sorted = SDL_FALSE;
+                }
+            }
+            SDLTest_AssertCheck(sorted, "Check SDL_SortBySint32Key() sorted elements and kept equal ones in order");
+            break;
+        default:
+            SDL_SortByFloatKey(elements, max_count, sizeof(*elements), key_offset);
+            SDLTest_AssertCheck(sort_check_elements(elements, max_count, SDL_TRUE), "Check SDL_SortByFloatKey() sorted elements and kept equal ones in order");
+            break;
+        }
+    }
+
+    SDL_free(numbers);
+    SDL_free(bytes);
+    SDL_free(elements);
+    return TEST_COMPLETED;
+}
+
 typedef struct
 {
     size_t a;
@@ -949,6 +1321,22 @@ static const SDLTest_TestCaseReference stdlibTest7 = {
     stdlib_aligned_alloc, "stdlib_aligned_alloc", "Call to SDL_aligned_alloc", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest8 = {
+    stdlib_arena, "stdlib_arena", "Call to SDL_ArenaAlloc and SDL_ResetArena", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest9 = {
+    stdlib_crc, "stdlib_crc", "Call to SDL_crc32 and SDL_crc16", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest10 = {
+    stdlib_iconv_string, "stdlib_iconv_string", "Call to SDL_iconv_string", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest11 = {
+    stdlib_sort, "stdlib_sort", "Call to SDL_qsort_r, SDL_StableSort and the radix sorts", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference stdlibTestOverflow = {
     stdlib_overflow, "stdlib_overflow", "Overflow detection", TEST_ENABLED
 };
@@ -962,6 +1350,10 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest5,
     &stdlibTest6,
     &stdlibTest7,
+    &stdlibTest8,
+    &stdlibTest9,
+    &stdlibTest10,
+    &stdlibTest11,
     &stdlibTestOverflow,
     NULL
 };
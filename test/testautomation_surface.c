@@ -331,6 +331,14 @@ static int surface_testCompleteSurfaceConversion(void *arg)
         SDL_PIXELFORMAT_XBGR2101010,
         SDL_PIXELFORMAT_ARGB2101010,
         SDL_PIXELFORMAT_ABGR2101010,
+        SDL_PIXELFORMAT_RGBA64_FLOAT,
+        SDL_PIXELFORMAT_ARGB64_FLOAT,
+        SDL_PIXELFORMAT_BGRA64_FLOAT,
+        SDL_PIXELFORMAT_ABGR64_FLOAT,
+        SDL_PIXELFORMAT_RGBA128_FLOAT,
+        SDL_PIXELFORMAT_ARGB128_FLOAT,
+        SDL_PIXELFORMAT_BGRA128_FLOAT,
+        SDL_PIXELFORMAT_ABGR128_FLOAT,
     };
     SDL_Surface *face = NULL, *cvt1, *cvt2, *final;
     SDL_PixelFormat *fmt1, *fmt2;
@@ -781,6 +789,1316 @@ static int surface_testOverflow(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests blitting between 8888 formats, and blending fully transparent and opaque pixels.
+ * The widths are picked so both the vectorized loops and their leftovers are used.
+ */
+static int surface_testBlit8888(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888
+    };
+    const int width = 37;
+    int i, j, x, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            SDL_Surface *src = SDL_CreateSurface(width, 1, formats[i]);
+            SDL_Surface *dst = SDL_CreateSurface(width, 1, formats[j]);
+            const SDL_bool src_alpha = SDL_ISPIXELFORMAT_ALPHA(formats[i]);
+            const SDL_bool dst_alpha = SDL_ISPIXELFORMAT_ALPHA(formats[j]);
+            int errors = 0;
+
+            SDLTest_AssertCheck(src && dst, "Validate result from SDL_CreateSurface, expected: non-NULL");
+            if (!src || !dst) {
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+                return TEST_ABORTED;
+            }
+
+            for (x = 0; x < width; ++x) {
+                ((Uint32 *)src->pixels)[x] = SDL_MapRGBA(src->format, (Uint8)(x * 7), (Uint8)(x * 13), (Uint8)(x * 29), (Uint8)(x * 41));
+            }
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+            ret = SDL_BlitSurface(src, NULL, dst, NULL);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+            for (x = 0; x < width; ++x) {
+                Uint8 r, g, b, a;
+                const Uint8 expected_a = (Uint8)((src_alpha && dst_alpha) ? (x * 41) : 255);
+
+                SDL_GetRGBA(((Uint32 *)dst->pixels)[x], dst->format, &r, &g, &b, &a);
+                if (r != (Uint8)(x * 7) || g != (Uint8)(x * 13) || b != (Uint8)(x * 29) || a != expected_a) {
+                    ++errors;
+                }
+            }
+            SDLTest_AssertCheck(errors == 0, "Validate blit from %s to %s, expected: 0 errors, got: %d",
+                                SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), errors);
+
+            if (src_alpha && i == j) {
+                /* Alternate fully transparent and opaque source pixels */
+                errors = 0;
+                for (x = 0; x < width; ++x) {
+                    ((Uint32 *)src->pixels)[x] = SDL_MapRGBA(src->format, 255, 0, 0, (x & 1) ? 255 : 0);
+                    ((Uint32 *)dst->pixels)[x] = SDL_MapRGBA(dst->format, 0, 0, 255, 128);
+                }
+                SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+                ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+                for (x = 0; x < width; ++x) {
+                    const Uint32 expected = (x & 1) ? ((Uint32 *)src->pixels)[x] : SDL_MapRGBA(dst->format, 0, 0, 255, 128);
+                    if (((Uint32 *)dst->pixels)[x] != expected) {
+                        ++errors;
+                    }
+                }
+                SDLTest_AssertCheck(errors == 0, "Validate blended blit of %s, expected: 0 errors, got: %d",
+                                    SDL_GetPixelFormatName(formats[i]), errors);
+            }
+
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests splitting large blits across threads with SDL_HINT_SURFACE_BLIT_THREADS.
+ */
+static int surface_testBlitThreaded(void *arg)
+{
+    const int width = 601, height = 523;
+    SDL_Surface *src, *expected, *result;
+    int x, y, ret;
+
+    src = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888);
+    expected = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ABGR8888);
+    result = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ABGR8888);
+    SDLTest_AssertCheck(src && expected && result, "Validate result from SDL_CreateSurface, expected: non-NULL");
+    if (!src || !expected || !result) {
+        ret = TEST_ABORTED;
+        goto done;
+    }
+
+    for (y = 0; y < height; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < width; ++x) {
+            row[x] = (Uint32)(x * 2654435761u) ^ (Uint32)(y * 40503u);
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+    ret = SDL_BlitSurface(src, NULL, expected, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+    ret = SDL_BlitSurface(src, NULL, result, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    ret = 0;
+    for (y = 0; y < height; ++y) {
+        if (SDL_memcmp((Uint8 *)expected->pixels + y * expected->pitch, (Uint8 *)result->pixels + y * result->pitch, width * sizeof(Uint32)) != 0) {
+            ++ret;
+        }
+    }
+    SDLTest_AssertCheck(ret == 0, "Validate threaded blit matches, expected: 0 rows differing, got: %d", ret);
+    ret = TEST_COMPLETED;
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(expected);
+    SDL_DestroySurface(result);
+    return ret;
+}
+
+/**
+ * Tests blending onto destination formats that have generated blitters.
+ */
+static int surface_testBlitBlendGenerated(void *arg)
+{
+    static const struct
+    {
+        Uint32 format;
+        Uint32 dst_pixel;
+        Uint32 expected;
+    } cases[] = {
+        { SDL_PIXELFORMAT_RGBA8888, 0x0000FFFF, 0x80007FFF },
+        { SDL_PIXELFORMAT_BGRA8888, 0xFF0000FF, 0x7F0080FF },
+        { SDL_PIXELFORMAT_ARGB2101010, 0xC00003FF, 0xE03001FF },
+    };
+    SDL_Surface *src, *dst;
+    Uint32 pixel;
+    int i, ret;
+
+    src = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(src, NULL, 0x80FF0000);
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        dst = SDL_CreateSurface(8, 8, cases[i].format);
+        SDLTest_AssertCheck(dst != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+        if (dst == NULL) {
+            continue;
+        }
+        SDL_FillSurfaceRect(dst, NULL, cases[i].dst_pixel);
+
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+        pixel = *(Uint32 *)dst->pixels;
+        SDLTest_AssertCheck(pixel == cases[i].expected, "Validate blend onto %s, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32,
+                            SDL_GetPixelFormatName(cases[i].format), cases[i].expected, pixel);
+
+        ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurfaceScaled, expected: 0, got: %i", ret);
+        SDL_DestroySurface(dst);
+    }
+
+    SDL_DestroySurface(src);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests blitting one source alternately onto several destinations.
+ */
+static int surface_testBlitAlternateDestinations(void *arg)
+{
+    SDL_Color color = { 0x10, 0x20, 0x30, 0xFF };
+    SDL_Surface *src, *dst1, *dst2;
+    Uint32 pixel;
+    int i, ret;
+
+    src = SDL_CreateSurface(4, 4, SDL_PIXELFORMAT_INDEX8);
+    dst1 = SDL_CreateSurface(4, 4, SDL_PIXELFORMAT_ARGB8888);
+    dst2 = SDL_CreateSurface(4, 4, SDL_PIXELFORMAT_XBGR8888);
+    SDLTest_AssertCheck(src && dst1 && dst2, "Validate result from SDL_CreateSurface, expected: non-NULL");
+    if (!src || !dst1 || !dst2) {
+        ret = TEST_ABORTED;
+        goto done;
+    }
+    SDL_SetPaletteColors(src->format->palette, &color, 0, 1);
+    SDL_FillSurfaceRect(src, NULL, 0);
+
+    for (i = 0; i < 3; ++i) {
+        ret = SDL_BlitSurface(src, NULL, dst1, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+        ret = SDL_BlitSurface(src, NULL, dst2, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    }
+    pixel = *(Uint32 *)dst1->pixels;
+    SDLTest_AssertCheck(pixel == 0xFF102030, "Validate first destination, expected: 0xff102030, got: 0x%.8" SDL_PRIx32, pixel);
+    pixel = *(Uint32 *)dst2->pixels & 0x00FFFFFF;
+    SDLTest_AssertCheck(pixel == 0x00302010, "Validate second destination, expected: 0x00302010, got: 0x%.8" SDL_PRIx32, pixel);
+
+    /* Changing the palette must not reuse the old mapping */
+    color.r = 0x40;
+    SDL_SetPaletteColors(src->format->palette, &color, 0, 1);
+    ret = SDL_BlitSurface(src, NULL, dst1, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    pixel = *(Uint32 *)dst1->pixels;
+    SDLTest_AssertCheck(pixel == 0xFF402030, "Validate updated palette, expected: 0xff402030, got: 0x%.8" SDL_PRIx32, pixel);
+
+    /* Neither must changing the alpha modulation */
+    SDL_SetSurfaceAlphaMod(src, 0x80);
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    SDL_FillSurfaceRect(dst1, NULL, 0xFF000000);
+    ret = SDL_BlitSurface(src, NULL, dst2, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    ret = SDL_BlitSurface(src, NULL, dst1, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    pixel = (*(Uint32 *)dst1->pixels >> 16) & 0xFF;
+    SDLTest_AssertCheck(pixel >= 0x1F && pixel <= 0x21, "Validate alpha modulation, expected: 0x20, got: 0x%.2" SDL_PRIx32, pixel);
+    ret = TEST_COMPLETED;
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst1);
+    SDL_DestroySurface(dst2);
+    return ret;
+}
+
+/**
+ * Tests the area averaging and Lanczos scale modes.
+ */
+static int surface_testBlitScaledFilters(void *arg)
+{
+    static const SDL_ScaleMode modes[] = { SDL_SCALEMODE_AREA, SDL_SCALEMODE_LANCZOS };
+    static const int sizes[][2] = { { 8, 8 }, { 37, 23 }, { 100, 3 }, { 1, 1 } };
+    SDL_Surface *src, *dst;
+    SDL_Rect rect;
+    Uint32 pixel;
+    int i, j, x, y, ret, worst;
+
+    src = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        /* A flat color must come out unchanged at any size */
+        SDL_FillSurfaceRect(src, NULL, 0xFF336699);
+        for (j = 0; j < SDL_arraysize(sizes); ++j) {
+            dst = SDL_CreateSurface(sizes[j][0], sizes[j][1], SDL_PIXELFORMAT_ARGB8888);
+            SDLTest_AssertCheck(dst != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+            if (dst == NULL) {
+                continue;
+            }
+            ret = SDL_BlitSurfaceScaledWithMode(src, NULL, dst, NULL, modes[i]);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurfaceScaledWithMode, expected: 0, got: %i", ret);
+            worst = 0;
+            for (y = 0; y < dst->h; ++y) {
+                for (x = 0; x < dst->w; ++x) {
+                    pixel = ((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x];
+                    if (pixel != 0xFF336699) {
+                        ++worst;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(worst == 0, "Validate flat color scaled to %dx%d with mode %d, expected: 0 pixels changed, got: %d",
+                                sizes[j][0], sizes[j][1], modes[i], worst);
+            SDL_DestroySurface(dst);
+        }
+
+        /* A one pixel checkerboard must downscale to gray, not alias */
+        for (y = 0; y < src->h; ++y) {
+            for (x = 0; x < src->w; ++x) {
+                ((Uint32 *)((Uint8 *)src->pixels + y * src->pitch))[x] = ((x ^ y) & 1) ? 0xFFFFFFFF : 0xFF000000;
+            }
+        }
+        dst = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(dst != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+        if (dst == NULL) {
+            continue;
+        }
+        ret = SDL_BlitSurfaceScaledWithMode(src, NULL, dst, NULL, modes[i]);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurfaceScaledWithMode, expected: 0, got: %i", ret);
+        worst = 0;
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                pixel = ((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x];
+                worst = SDL_max(worst, SDL_abs((int)(pixel & 0xFF) - 128));
+            }
+        }
+        SDLTest_AssertCheck(worst <= 2, "Validate checkerboard downscale with mode %d, expected: gray within 2, got: %d away", modes[i], worst);
+
+        /* Other formats go through an intermediate surface */
+        rect.x = 2;
+        rect.y = 2;
+        rect.w = 4;
+        rect.h = 4;
+        SDL_DestroySurface(dst);
+        dst = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_RGB565);
+        if (dst) {
+            ret = SDL_BlitSurfaceScaledWithMode(src, NULL, dst, &rect, modes[i]);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurfaceScaledWithMode, expected: 0, got: %i", ret);
+        }
+        SDL_DestroySurface(dst);
+    }
+
+    SDL_DestroySurface(src);
+    return TEST_COMPLETED;
+}
+
+static Uint32 readTestPixel(SDL_Surface *surface, int x, int y)
+{
+    const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+
+    if (surface->format->BytesPerPixel == 2) {
+        return ((const Uint16 *)row)[x];
+    }
+    return ((const Uint32 *)row)[x];
+}
+
+static void writeTestPixel(SDL_Surface *surface, int x, int y, Uint32 pixel)
+{
+    Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+
+    if (surface->format->BytesPerPixel == 2) {
+        ((Uint16 *)row)[x] = (Uint16)pixel;
+    } else {
+        ((Uint32 *)row)[x] = pixel;
+    }
+}
+
+/**
+ * Tests blended rectangle fills against the per pixel blend equations.
+ */
+static int surface_testBlendFillRects(void *arg)
+{
+    static const SDL_PixelFormatEnum formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 };
+    static const SDL_BlendMode modes[] = { SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL };
+    static const Uint8 color[4] = { 200, 100, 50, 96 };
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    SDL_FRect rect;
+    Uint32 pixel, expected;
+    Uint8 r, g, b, a, cr, cg, cb;
+    int i, j, x, y, mismatches;
+    const int inva = 0xFF - color[3];
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            surface = SDL_CreateSurface(45, 4, formats[i]);
+            SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+            if (surface == NULL) {
+                continue;
+            }
+            for (y = 0; y < surface->h; ++y) {
+                for (x = 0; x < surface->w; ++x) {
+                    pixel = SDL_MapRGBA(surface->format, (Uint8)(x * 13), (Uint8)(y * 71 + x), (Uint8)(255 - x * 5), (Uint8)(x * 37));
+                    writeTestPixel(surface, x, y, pixel);
+                }
+            }
+
+            renderer = SDL_CreateSoftwareRenderer(surface);
+            SDLTest_AssertCheck(renderer != NULL, "Validate result from SDL_CreateSoftwareRenderer, expected: non-NULL");
+            if (renderer == NULL) {
+                SDL_DestroySurface(surface);
+                continue;
+            }
+            SDL_SetRenderDrawBlendMode(renderer, modes[j]);
+            SDL_SetRenderDrawColor(renderer, color[0], color[1], color[2], color[3]);
+
+            /* Cover a width with both a vectorized run and a remainder */
+            rect.x = 3.0f;
+            rect.y = 1.0f;
+            rect.w = 39.0f;
+            rect.h = 2.0f;
+            SDL_RenderFillRect(renderer, &rect);
+            SDL_RenderPresent(renderer);
+
+            if (modes[j] == SDL_BLENDMODE_BLEND || modes[j] == SDL_BLENDMODE_ADD) {
+                cr = (Uint8)(color[0] * color[3] / 255);
+                cg = (Uint8)(color[1] * color[3] / 255);
+                cb = (Uint8)(color[2] * color[3] / 255);
+            } else {
+                cr = color[0];
+                cg = color[1];
+                cb = color[2];
+            }
+
+            mismatches = 0;
+            for (y = 1; y < 3; ++y) {
+                for (x = 3; x < 42; ++x) {
+                    SDL_GetRGBA(SDL_MapRGBA(surface->format, (Uint8)(x * 13), (Uint8)(y * 71 + x), (Uint8)(255 - x * 5), (Uint8)(x * 37)),
+                                surface->format, &r, &g, &b, &a);
+                    switch (modes[j]) {
+                    case SDL_BLENDMODE_BLEND:
+                        r = (Uint8)(r * inva / 255 + cr);
+                        g = (Uint8)(g * inva / 255 + cg);
+                        b = (Uint8)(b * inva / 255 + cb);
+                        a = (Uint8)(a * inva / 255 + color[3]);
+                        break;
+                    case SDL_BLENDMODE_ADD:
+                        r = (Uint8)SDL_min(r + cr, 255);
+                        g = (Uint8)SDL_min(g + cg, 255);
+                        b = (Uint8)SDL_min(b + cb, 255);
+                        break;
+                    case SDL_BLENDMODE_MOD:
+                        r = (Uint8)(r * cr / 255);
+                        g = (Uint8)(g * cg / 255);
+                        b = (Uint8)(b * cb / 255);
+                        break;
+                    default:
+                        r = (Uint8)SDL_min(r * cr / 255 + r * inva / 255, 255);
+                        g = (Uint8)SDL_min(g * cg / 255 + g * inva / 255, 255);
+                        b = (Uint8)SDL_min(b * cb / 255 + b * inva / 255, 255);
+                        break;
+                    }
+                    expected = SDL_MapRGBA(surface->format, r, g, b, a);
+                    pixel = readTestPixel(surface, x, y);
+                    if (pixel != expected) {
+                        if (mismatches == 0) {
+                            SDLTest_LogError("Pixel %d,%d: expected 0x%.8" SDL_PRIx32 ", got 0x%.8" SDL_PRIx32, x, y, expected, pixel);
+                        }
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Validate %s fill with blend mode 0x%x, expected: 0 mismatches, got: %d",
+                                SDL_GetPixelFormatName(formats[i]), modes[j], mismatches);
+
+            /* Pixels outside the rectangle must be untouched */
+            pixel = readTestPixel(surface, 2, 1);
+            expected = SDL_MapRGBA(surface->format, 26, 73, 245, 74);
+            SDLTest_AssertCheck(pixel == expected, "Validate pixel left of the fill, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, expected, pixel);
+            pixel = readTestPixel(surface, 42, 1);
+            expected = SDL_MapRGBA(surface->format, (Uint8)(42 * 13), (Uint8)(71 + 42), (Uint8)(255 - 42 * 5), (Uint8)(42 * 37));
+            SDLTest_AssertCheck(pixel == expected, "Validate pixel right of the fill, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32, expected, pixel);
+
+            SDL_DestroyRenderer(renderer);
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests premultiplying and unpremultiplying alpha.
+ */
+static int surface_testPremultiplyAlpha(void *arg)
+{
+    SDL_Surface *surface;
+    Uint32 *pixels;
+    Uint32 converted[37];
+    int x, ret, mismatches;
+
+    surface = SDL_CreateSurface(37, 3, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* The first row is opaque, the second half transparent, the last fully transparent */
+    for (x = 0; x < surface->w; ++x) {
+        const Uint32 rgb = (Uint32)(x * 7) << 16 | (Uint32)(255 - x * 3) << 8 | (Uint32)(x * 5);
+
+        ((Uint32 *)surface->pixels)[x] = 0xFF000000 | rgb;
+        ((Uint32 *)((Uint8 *)surface->pixels + surface->pitch))[x] = 0x80000000 | rgb;
+        ((Uint32 *)((Uint8 *)surface->pixels + 2 * surface->pitch))[x] = rgb;
+    }
+
+    ret = SDL_PremultiplySurfaceAlpha(surface);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_PremultiplySurfaceAlpha, expected: 0, got: %i", ret);
+    pixels = (Uint32 *)((Uint8 *)surface->pixels + surface->pitch);
+    SDLTest_AssertCheck(pixels[1] == 0x80037E02, "Validate premultiplied pixel, expected: 0x80037E02, got: 0x%.8" SDL_PRIx32, pixels[1]);
+    pixels = (Uint32 *)((Uint8 *)surface->pixels + 2 * surface->pitch);
+    SDLTest_AssertCheck(pixels[36] == 0, "Validate premultiplied transparent pixel, expected: 0, got: 0x%.8" SDL_PRIx32, pixels[36]);
+
+    ret = SDL_UnpremultiplySurfaceAlpha(surface);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UnpremultiplySurfaceAlpha, expected: 0, got: %i", ret);
+    mismatches = 0;
+    for (x = 0; x < surface->w; ++x) {
+        const int channels[3] = { x * 7, 255 - x * 3, x * 5 };
+        Uint8 r, g, b, a;
+
+        /* Opaque pixels survive the round trip, half transparent ones lose one bit of precision */
+        pixels = (Uint32 *)surface->pixels;
+        if (pixels[x] != (0xFF000000 | (Uint32)channels[0] << 16 | (Uint32)channels[1] << 8 | (Uint32)channels[2])) {
+            ++mismatches;
+        }
+        pixels = (Uint32 *)((Uint8 *)surface->pixels + surface->pitch);
+        SDL_GetRGBA(pixels[x], surface->format, &r, &g, &b, &a);
+        if (a != 0x80 || SDL_abs(r - channels[0]) > 2 || SDL_abs(g - channels[1]) > 2 || SDL_abs(b - channels[2]) > 2) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate alpha round trip, expected: 0 mismatches, got: %d", mismatches);
+
+    /* Converting between formats swaps the channels along the way */
+    ret = SDL_PremultiplyAlpha(surface->w, 1, SDL_PIXELFORMAT_ARGB8888, (Uint8 *)surface->pixels + surface->pitch, surface->pitch,
+                               SDL_PIXELFORMAT_RGBA8888, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_PremultiplyAlpha, expected: 0, got: %i", ret);
+    ret = SDL_PremultiplySurfaceAlpha(surface);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_PremultiplySurfaceAlpha, expected: 0, got: %i", ret);
+    mismatches = 0;
+    pixels = (Uint32 *)((Uint8 *)surface->pixels + surface->pitch);
+    for (x = 0; x < surface->w; ++x) {
+        if (converted[x] != ((pixels[x] << 8) | (pixels[x] >> 24))) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate premultiplying into another format, expected: 0 mismatches, got: %d", mismatches);
+
+    ret = SDL_UnpremultiplyAlpha(surface->w, 1, SDL_PIXELFORMAT_RGB565, surface->pixels, surface->pitch,
+                                 SDL_PIXELFORMAT_ARGB8888, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == -1, "Validate result from SDL_UnpremultiplyAlpha with an unsupported format, expected: -1, got: %i", ret);
+
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests saving and loading RLE encoded colorkeyed surfaces.
+ */
+static int surface_testSaveLoadRLE(void *arg)
+{
+    static const SDL_PixelFormatEnum formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_INDEX8 };
+    static Uint8 buffer[32 * 1024];
+    SDL_Surface *sprite, *loaded, *expected, *actual;
+    SDL_Palette *palette;
+    SDL_RWops *rw;
+    Sint64 size;
+    Uint32 key;
+    int i, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        sprite = SDL_CreateSurface(61, 17, formats[i]);
+        SDLTest_AssertCheck(sprite != NULL, "Validate result from SDL_CreateSurface, expected: non-NULL");
+        if (sprite == NULL) {
+            continue;
+        }
+        palette = sprite->format->palette;
+        if (palette) {
+            for (x = 0; x < palette->ncolors; ++x) {
+                palette->colors[x].r = (Uint8)x;
+                palette->colors[x].g = (Uint8)(255 - x);
+                palette->colors[x].b = (Uint8)(x * 3);
+            }
+            palette->version++;
+        }
+        key = SDL_MapRGB(sprite->format, 255, 0, 255);
+
+        /* Mix transparent and opaque runs of different lengths */
+        for (y = 0; y < sprite->h; ++y) {
+            for (x = 0; x < sprite->w; ++x) {
+                Uint32 pixel = ((x / (y + 1)) & 1) ? key : SDL_MapRGB(sprite->format, (Uint8)(x * 4), (Uint8)(y * 15), 0x40);
+                Uint8 *row = (Uint8 *)sprite->pixels + y * sprite->pitch;
+
+                switch (sprite->format->BytesPerPixel) {
+                case 1:
+                    row[x] = (Uint8)pixel;
+                    break;
+                case 2:
+                    ((Uint16 *)row)[x] = (Uint16)pixel;
+                    break;
+                default:
+                    ((Uint32 *)row)[x] = pixel;
+                    break;
+                }
+            }
+        }
+        ret = SDL_SetSurfaceColorKey(sprite, SDL_TRUE, key);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetSurfaceColorKey, expected: 0, got: %i", ret);
+
+        /* Encoding doesn't need a blit first */
+        rw = SDL_RWFromMem(buffer, sizeof(buffer));
+        ret = SDL_SaveRLE_RW(sprite, rw, SDL_FALSE);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SaveRLE_RW, expected: 0, got: %i", ret);
+        size = SDL_RWtell(rw);
+        SDL_RWclose(rw);
+
+        expected = SDL_CreateSurface(80, 30, formats[i]);
+        actual = SDL_CreateSurface(80, 30, formats[i]);
+        rw = SDL_RWFromConstMem(buffer, (size_t)size);
+        loaded = SDL_LoadRLE_RW(rw, SDL_TRUE);
+        SDLTest_AssertCheck(loaded != NULL, "Validate result from SDL_LoadRLE_RW, expected: non-NULL");
+        if (loaded && expected && actual) {
+            SDL_Rect dstrect = { 7, 5, 0, 0 };
+
+            SDLTest_AssertCheck(SDL_SurfaceHasRLE(loaded), "Validate loaded surface has RLE");
+            if (palette) {
+                SDL_SetSurfacePalette(expected, palette);
+                SDL_SetSurfacePalette(actual, palette);
+            }
+            SDL_FillSurfaceRect(expected, NULL, 1);
+            SDL_FillSurfaceRect(actual, NULL, 1);
+            ret = SDL_BlitSurface(sprite, NULL, expected, &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+            ret = SDL_BlitSurface(loaded, NULL, actual, &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_BlitSurface, expected: 0, got: %i", ret);
+            SDLTest_AssertCheck(loaded->pixels == NULL, "Validate the encoding was kept for an identical format");
+            ret = SDLTest_CompareSurfaces(actual, expected, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate blit of loaded RLE surface, expected: 0, got: %i", ret);
+
+            /* Clipped on the left and top; the blit updates the rectangle */
+            dstrect.x = -9;
+            dstrect.y = -3;
+            SDL_BlitSurface(sprite, NULL, expected, &dstrect);
+            dstrect.x = -9;
+            dstrect.y = -3;
+            SDL_BlitSurface(loaded, NULL, actual, &dstrect);
+            ret = SDLTest_CompareSurfaces(actual, expected, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate clipped blit of loaded RLE surface, expected: 0, got: %i", ret);
+        }
+        SDL_DestroySurface(loaded);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+
+        /* Truncated data must be rejected */
+        rw = SDL_RWFromConstMem(buffer, (size_t)size - 3);
+        loaded = SDL_LoadRLE_RW(rw, SDL_TRUE);
+        SDLTest_AssertCheck(loaded == NULL, "Validate result from SDL_LoadRLE_RW with truncated data, expected: NULL");
+        SDL_DestroySurface(loaded);
+
+        SDL_DestroySurface(sprite);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests conversions between the 8-bit, 10-bit and floating point formats.
+ */
+static int surface_testHDRConversion(void *arg)
+{
+    static Uint32 pixels[1025], converted[1025];
+    static Uint16 halfs[1025 * 4];
+    static float floats[1025 * 4];
+    const float values[4] = { 0.5f, 2.0f, -1.0f, 1.0f };
+    const Uint16 expected[4] = { 0x3800, 0x4000, 0xBC00, 0x3C00 };
+    Uint32 pixel;
+    int x, ret, mismatches;
+
+    /* 8-bit values survive a round trip through half floats */
+    for (x = 0; x < 259; ++x) {
+        const Uint32 v = (Uint32)(x & 0xFF);
+        pixels[x] = v << 24 | (255 - v) << 16 | (v ^ 0x5A) << 8 | v;
+    }
+    ret = SDL_ConvertPixels(259, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels), SDL_PIXELFORMAT_RGBA64_FLOAT, halfs, sizeof(halfs));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(halfs[255 * 4 + 0] == 0 && halfs[255 * 4 + 2] == 0x3C00 && halfs[255 * 4 + 3] == 0x3C00,
+                        "Validate half float pixel, expected: 0000 3c00 3c00, got: %.4x %.4x %.4x", halfs[255 * 4 + 0], halfs[255 * 4 + 2], halfs[255 * 4 + 3]);
+    ret = SDL_ConvertPixels(259, 1, SDL_PIXELFORMAT_RGBA64_FLOAT, halfs, sizeof(halfs), SDL_PIXELFORMAT_ARGB8888, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    mismatches = 0;
+    for (x = 0; x < 259; ++x) {
+        if (converted[x] != pixels[x]) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate 8-bit round trip, expected: 0 mismatches, got: %d", mismatches);
+
+    /* 10-bit values survive a round trip through half and single floats */
+    for (x = 0; x < 1025; ++x) {
+        const Uint32 v = (Uint32)(x & 0x3FF);
+        pixels[x] = (v & 3) << 30 | v << 20 | (1023 - v) << 10 | ((v * 7) & 0x3FF);
+    }
+    ret = SDL_ConvertPixels(1025, 1, SDL_PIXELFORMAT_ARGB2101010, pixels, sizeof(pixels), SDL_PIXELFORMAT_BGRA128_FLOAT, floats, sizeof(floats));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(floats[1023 * 4 + 2] == 1.0f && floats[1023 * 4 + 1] == 0.0f,
+                        "Validate float pixel, expected: 1.0 0.0, got: %g %g", floats[1023 * 4 + 2], floats[1023 * 4 + 1]);
+    ret = SDL_ConvertPixels(1025, 1, SDL_PIXELFORMAT_BGRA128_FLOAT, floats, sizeof(floats), SDL_PIXELFORMAT_ARGB2101010, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    mismatches = 0;
+    for (x = 0; x < 1025; ++x) {
+        if (converted[x] != pixels[x]) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate 10-bit round trip through floats, expected: 0 mismatches, got: %d", mismatches);
+
+    ret = SDL_ConvertPixels(1025, 1, SDL_PIXELFORMAT_ARGB2101010, pixels, sizeof(pixels), SDL_PIXELFORMAT_ABGR64_FLOAT, halfs, sizeof(halfs));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    ret = SDL_ConvertPixels(1025, 1, SDL_PIXELFORMAT_ABGR64_FLOAT, halfs, sizeof(halfs), SDL_PIXELFORMAT_ARGB2101010, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    mismatches = 0;
+    for (x = 0; x < 1025; ++x) {
+        if (converted[x] != pixels[x]) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate 10-bit round trip through half floats, expected: 0 mismatches, got: %d", mismatches);
+
+    /* Float formats keep values outside of 0..1, integer formats clamp them */
+    for (x = 0; x < 4 * 5; ++x) {
+        floats[x] = values[x % 4];
+    }
+    ret = SDL_ConvertPixels(5, 1, SDL_PIXELFORMAT_RGBA128_FLOAT, floats, sizeof(floats), SDL_PIXELFORMAT_RGBA64_FLOAT, halfs, sizeof(halfs));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    mismatches = 0;
+    for (x = 0; x < 4 * 5; ++x) {
+        if (halfs[x] != expected[x % 4]) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate conversion to half floats, expected: 0 mismatches, got: %d", mismatches);
+    ret = SDL_ConvertPixels(5, 1, SDL_PIXELFORMAT_RGBA64_FLOAT, halfs, sizeof(halfs), SDL_PIXELFORMAT_ARGB8888, converted, sizeof(converted));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+    pixel = converted[4];
+    SDLTest_AssertCheck(converted[0] == 0xFF80FF00 && pixel == 0xFF80FF00, "Validate clamped pixels, expected: 0xFF80FF00, got: 0x%.8" SDL_PRIx32 " 0x%.8" SDL_PRIx32, converted[0], pixel);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests loading bitmaps from memory, referencing the pixels where possible.
+ */
+static int surface_testLoadBMPFromMemory(void *arg)
+{
+    static Uint32 storage[256];
+    const int w = 7, h = 5, pitch = w * 4;
+    /* The 32-bit header is 122 bytes, so this puts the pixels on a 4 byte boundary */
+    Uint8 *data = (Uint8 *)storage + 2;
+    SDL_Surface *face, *loaded;
+    SDL_RWops *rw;
+    Sint64 size;
+    Uint32 offset;
+    Uint8 row[7 * 4];
+    int x, y, ret, mismatches;
+
+    face = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_BGRA32);
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < h; ++y) {
+        for (x = 0; x < pitch; ++x) {
+            ((Uint8 *)face->pixels)[y * face->pitch + x] = (Uint8)(y * 37 + x * 11 + 1);
+        }
+    }
+
+    rw = SDL_RWFromMem(data, sizeof(storage) - 2);
+    ret = SDL_SaveBMP_RW(face, rw, SDL_FALSE);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SaveBMP_RW, expected: 0, got: %i", ret);
+    size = SDL_RWtell(rw);
+    SDL_RWclose(rw);
+    offset = (Uint32)data[10] | (Uint32)data[11] << 8 | (Uint32)data[12] << 16 | (Uint32)data[13] << 24;
+    SDLTest_AssertCheck(offset == 122 && size == offset + h * pitch, "Verify saved bitmap layout, got offset %" SDL_PRIu32 " and size %" SDL_PRIs64, offset, size);
+    if (offset != 122 || size != offset + h * pitch) {
+        SDL_DestroySurface(face);
+        return TEST_ABORTED;
+    }
+
+    /* Bottom-up images are copied into a new surface */
+    loaded = SDL_LoadBMP_Mem(data, (size_t)size);
+    SDLTest_AssertCheck(loaded != NULL, "Verify result from SDL_LoadBMP_Mem is not NULL");
+    if (loaded) {
+        mismatches = 0;
+        for (y = 0; y < h; ++y) {
+            mismatches += (SDL_memcmp((Uint8 *)loaded->pixels + y * loaded->pitch, (Uint8 *)face->pixels + y * face->pitch, pitch) != 0);
+        }
+        SDLTest_AssertCheck(!(loaded->flags & SDL_PREALLOC), "Verify bottom-up pixels were copied");
+        SDLTest_AssertCheck(mismatches == 0, "Verify bottom-up pixels, expected: 0 mismatched rows, got: %d", mismatches);
+        SDL_DestroySurface(loaded);
+    }
+
+    /* Top-down images reference the pixels in place */
+    data[22] = (Uint8)-h;
+    data[23] = data[24] = data[25] = 0xFF;
+    for (y = 0; y < h / 2; ++y) {
+        SDL_memcpy(row, data + offset + y * pitch, pitch);
+        SDL_memcpy(data + offset + y * pitch, data + offset + (h - 1 - y) * pitch, pitch);
+        SDL_memcpy(data + offset + (h - 1 - y) * pitch, row, pitch);
+    }
+    loaded = SDL_LoadBMP_Mem(data, (size_t)size);
+    SDLTest_AssertCheck(loaded != NULL, "Verify result from SDL_LoadBMP_Mem is not NULL");
+    if (loaded) {
+        mismatches = 0;
+        for (y = 0; y < h; ++y) {
+            mismatches += (SDL_memcmp((Uint8 *)loaded->pixels + y * loaded->pitch, (Uint8 *)face->pixels + y * face->pitch, pitch) != 0);
+        }
+        SDLTest_AssertCheck((loaded->flags & SDL_PREALLOC) && loaded->pixels == data + offset, "Verify top-down pixels are referenced in place");
+        SDLTest_AssertCheck(mismatches == 0, "Verify top-down pixels, expected: 0 mismatched rows, got: %d", mismatches);
+        SDL_DestroySurface(loaded);
+    }
+
+    /* Truncated pixel data can't be referenced and fails to load */
+    loaded = SDL_LoadBMP_Mem(data, (size_t)size - 1);
+    SDLTest_AssertCheck(loaded == NULL, "Verify result from SDL_LoadBMP_Mem with truncated data, expected: NULL");
+    SDL_DestroySurface(loaded);
+
+    SDL_DestroySurface(face);
+    return TEST_COMPLETED;
+}
+
+/* Saves a surface to memory, loads it back and compares it with the
+   surface converted to the format it was saved in */
+static int checkSaveBMPRoundTrip(SDL_Surface *face, Uint32 saved_format, SDL_bool top_down)
+{
+    const size_t storage_size = 512 * 1024;
+    Uint8 *storage;
+    SDL_Surface *expected, *loaded;
+    SDL_RWops *rw;
+    Sint64 size = -1;
+    Sint32 height;
+    int y, ret, mismatches;
+
+    storage = (Uint8 *)SDL_malloc(storage_size);
+    expected = SDL_ConvertSurfaceFormat(face, saved_format);
+    SDLTest_AssertCheck(storage && expected, "Verify setup for saving %s bitmap", top_down ? "top-down" : "bottom-up");
+    if (!storage || !expected) {
+        SDL_free(storage);
+        SDL_DestroySurface(expected);
+        return TEST_ABORTED;
+    }
+
+    SDL_SetHint(SDL_HINT_BMP_SAVE_TOP_DOWN, top_down ? "1" : "0");
+    rw = SDL_RWFromMem(storage, storage_size);
+    ret = SDL_SaveBMP_RW(face, rw, SDL_FALSE);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SaveBMP_RW, expected: 0, got: %i", ret);
+    if (ret == 0) {
+        size = SDL_RWtell(rw);
+    }
+    SDL_RWclose(rw);
+    SDL_ResetHint(SDL_HINT_BMP_SAVE_TOP_DOWN);
+
+    height = (Sint32)((Uint32)storage[22] | (Uint32)storage[23] << 8 | (Uint32)storage[24] << 16 | (Uint32)storage[25] << 24);
+    SDLTest_AssertCheck(height == (top_down ? -face->h : face->h), "Verify saved height, expected: %d, got: %d", top_down ? -face->h : face->h, (int)height);
+
+    loaded = size > 0 ? SDL_LoadBMP_Mem(storage, (size_t)size) : NULL;
+    SDLTest_AssertCheck(loaded != NULL, "Verify result from SDL_LoadBMP_Mem is not NULL");
+    if (loaded) {
+        SDLTest_AssertCheck(loaded->format->format == saved_format, "Verify loaded format, expected: %s, got: %s",
+                            SDL_GetPixelFormatName(saved_format), SDL_GetPixelFormatName(loaded->format->format));
+        mismatches = 0;
+        for (y = 0; y < face->h && loaded->format->format == saved_format; ++y) {
+            mismatches += (SDL_memcmp((Uint8 *)loaded->pixels + y * loaded->pitch,
+                                      (Uint8 *)expected->pixels + y * expected->pitch,
+                                      (size_t)face->w * expected->format->BytesPerPixel) != 0);
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify loaded pixels, expected: 0 mismatched rows, got: %d", mismatches);
+        SDL_DestroySurface(loaded);
+    }
+
+    SDL_DestroySurface(expected);
+    SDL_free(storage);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests saving bitmaps that take several bands to convert and write.
+ */
+static int surface_testSaveBMPBands(void *arg)
+{
+    SDL_Surface *face;
+    int x, y;
+
+    /* Odd sizes, so the rows need padding and the last band is short */
+    face = SDL_CreateSurface(301, 203, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < face->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)face->pixels + y * face->pitch);
+        for (x = 0; x < face->w; ++x) {
+            row[x] = (Uint32)(x * 7 + y * 13) | (Uint32)(y * 3) << 8 | (Uint32)(x ^ y) << 16;
+        }
+    }
+
+    /* Converted to 24-bit with SDL_ConvertPixels() */
+    checkSaveBMPRoundTrip(face, SDL_PIXELFORMAT_BGR24, SDL_FALSE);
+    checkSaveBMPRoundTrip(face, SDL_PIXELFORMAT_BGR24, SDL_TRUE);
+
+    /* Colorkeys are saved as alpha, which needs a surface conversion */
+    SDL_SetSurfaceColorKey(face, SDL_TRUE, *(Uint32 *)face->pixels);
+    checkSaveBMPRoundTrip(face, SDL_PIXELFORMAT_BGRA32, SDL_FALSE);
+    checkSaveBMPRoundTrip(face, SDL_PIXELFORMAT_BGRA32, SDL_TRUE);
+
+    SDL_DestroySurface(face);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reusing pixel memory from a surface pool.
+ */
+static int surface_testSurfacePool(void *arg)
+{
+    SDL_SurfacePool *pool;
+    SDL_PropertiesID props;
+    SDL_Surface *surface, *other;
+    void *pixels;
+    int i, nonzero;
+
+    pool = SDL_CreateSurfacePool(0);
+    SDLTest_AssertCheck(pool != NULL, "Verify result from SDL_CreateSurfacePool is not NULL");
+    if (pool == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Pixels given back to the pool are reused and cleared */
+    surface = SDL_CreateSurfaceFromPool(pool, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateSurfaceFromPool is not NULL");
+    if (surface == NULL) {
+        SDL_DestroySurfacePool(pool);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(((uintptr_t)surface->pixels % SDL_SIMDGetAlignment()) == 0, "Verify pixels are aligned to %d bytes", (int)SDL_SIMDGetAlignment());
+    SDL_memset(surface->pixels, 0xAA, (size_t)surface->h * surface->pitch);
+    pixels = surface->pixels;
+    SDL_DestroySurface(surface);
+
+    surface = SDL_CreateSurfaceFromPool(pool, 32, 32, SDL_PIXELFORMAT_RGBA64_FLOAT);
+    SDLTest_AssertCheck(surface != NULL && surface->pixels == pixels, "Verify pixels of the same size are reused");
+    if (surface) {
+        nonzero = 0;
+        for (i = 0; i < surface->h * surface->pitch; ++i) {
+            nonzero += (((Uint8 *)surface->pixels)[i] != 0);
+        }
+        SDLTest_AssertCheck(nonzero == 0, "Verify reused pixels are cleared, expected: 0 nonzero bytes, got: %d", nonzero);
+    }
+    other = SDL_CreateSurfaceFromPool(pool, 16, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(other != NULL && other->pixels != pixels, "Verify pixels in use aren't shared");
+
+    /* Surfaces stay valid after the pool is destroyed, including releasing their pixels for RLE */
+    SDL_DestroySurfacePool(pool);
+    if (other) {
+        SDL_SetSurfaceColorKey(other, SDL_TRUE, 0);
+        SDL_SetSurfaceRLE(other, SDL_TRUE);
+        SDL_BlitSurface(other, NULL, surface, NULL);
+        SDLTest_AssertCheck(SDL_SurfaceHasRLE(other), "Verify pooled surface is RLE encoded");
+    }
+    SDL_DestroySurface(other);
+    SDL_DestroySurface(surface);
+
+    /* The alignment can be set, and must be a power of two */
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "alignment", 4096);
+    pool = SDL_CreateSurfacePool(props);
+    SDLTest_AssertCheck(pool != NULL, "Verify result from SDL_CreateSurfacePool is not NULL");
+    surface = SDL_CreateSurfaceFromPool(pool, 100, 10, SDL_PIXELFORMAT_RGB24);
+    SDLTest_AssertCheck(surface != NULL && ((uintptr_t)surface->pixels % 4096) == 0, "Verify pixels are aligned to 4096 bytes");
+    SDL_DestroySurface(surface);
+    SDL_DestroySurfacePool(pool);
+
+    SDL_SetNumberProperty(props, "alignment", 24);
+    pool = SDL_CreateSurfacePool(props);
+    SDLTest_AssertCheck(pool == NULL, "Verify result from SDL_CreateSurfacePool with an alignment of 24, expected: NULL");
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testColorkeyWidths(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormatEnum src_format;
+        SDL_PixelFormatEnum dst_format;
+    } blits[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_ARGB4444 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565 },
+    };
+    static const struct
+    {
+        SDL_PixelFormatEnum src_format;
+        SDL_PixelFormatEnum dst_format;
+    } conversions[] = {
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB4444 },
+    };
+    const int w = 19, h = 3;
+    SDL_Surface *src, *dst;
+    Uint32 key, pixel, expected, actual;
+    Uint8 r, g, b, a;
+    int i, x, y, keyed, mismatches;
+
+    for (i = 0; i < SDL_arraysize(blits); ++i) {
+        src = SDL_CreateSurface(w, h, blits[i].src_format);
+        dst = SDL_CreateSurface(w, h, blits[i].dst_format);
+        SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+        if (src == NULL || dst == NULL) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            return TEST_ABORTED;
+        }
+
+        /* Every third pixel matches the key in color, with varying alpha */
+        key = SDL_MapRGBA(src->format, 0x20, 0x40, 0x80, 0xFF);
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                if (((x + y) % 3) == 0) {
+                    pixel = SDL_MapRGBA(src->format, 0x20, 0x40, 0x80, (Uint8)(x * 13));
+                } else {
+                    pixel = SDL_MapRGBA(src->format, (Uint8)(x * 11), (Uint8)(y * 70), (Uint8)(x * 7 + 3), (Uint8)(255 - x));
+                }
+                SDL_memcpy((Uint8 *)src->pixels + y * src->pitch + x * src->format->BytesPerPixel, &pixel, src->format->BytesPerPixel);
+            }
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorKey(src, SDL_TRUE, key);
+        SDL_memset(dst->pixels, 0x5A, (size_t)dst->h * dst->pitch);
+
+        SDL_BlitSurface(src, NULL, dst, NULL);
+
+        mismatches = 0;
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                keyed = (((x + y) % 3) == 0);
+                pixel = 0;
+                SDL_memcpy(&pixel, (Uint8 *)src->pixels + y * src->pitch + x * src->format->BytesPerPixel, src->format->BytesPerPixel);
+                if (keyed) {
+                    expected = 0;
+                    SDL_memset(&expected, 0x5A, dst->format->BytesPerPixel);
+                } else if (blits[i].src_format == blits[i].dst_format) {
+                    expected = pixel;
+                } else {
+                    SDL_GetRGBA(pixel, src->format, &r, &g, &b, &a);
+                    expected = SDL_MapRGBA(dst->format, r, g, b, a);
+                }
+                actual = 0;
+                SDL_memcpy(&actual, (Uint8 *)dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel, dst->format->BytesPerPixel);
+                if (actual != expected) {
+                    if (mismatches == 0) {
+                        SDLTest_LogError("%s to %s at %d,%d, expected: 0x%.8" SDL_PRIx32 ", got: 0x%.8" SDL_PRIx32,
+                                         SDL_GetPixelFormatName(blits[i].src_format), SDL_GetPixelFormatName(blits[i].dst_format), x, y, expected, actual);
+                    }
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify colorkey blit from %s to %s, expected: 0 mismatches, got: %d",
+                            SDL_GetPixelFormatName(blits[i].src_format), SDL_GetPixelFormatName(blits[i].dst_format), mismatches);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+
+    for (i = 0; i < SDL_arraysize(conversions); ++i) {
+        src = SDL_CreateSurface(w, h, conversions[i].src_format);
+        SDLTest_AssertCheck(src != NULL, "Verify surface is not NULL");
+        if (src == NULL) {
+            return TEST_ABORTED;
+        }
+        key = SDL_MapRGB(src->format, 0xFF, 0x00, 0xFF);
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                pixel = (x % 2) ? key : SDL_MapRGB(src->format, 0x00, (Uint8)(x * 13), 0x00);
+                SDL_memcpy((Uint8 *)src->pixels + y * src->pitch + x * src->format->BytesPerPixel, &pixel, src->format->BytesPerPixel);
+            }
+        }
+        SDL_SetSurfaceColorKey(src, SDL_TRUE, key);
+
+        dst = SDL_ConvertSurfaceFormat(src, conversions[i].dst_format);
+        SDLTest_AssertCheck(dst != NULL, "Verify result from SDL_ConvertSurfaceFormat is not NULL");
+        if (dst) {
+            mismatches = 0;
+            for (y = 0; y < h; ++y) {
+                for (x = 0; x < w; ++x) {
+                    actual = 0;
+                    SDL_memcpy(&actual, (Uint8 *)dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel, dst->format->BytesPerPixel);
+                    SDL_GetRGBA(actual, dst->format, &r, &g, &b, &a);
+                    if (a != ((x % 2) ? 0 : 255)) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify colorkey converted to alpha from %s to %s, expected: 0 mismatches, got: %d",
+                                SDL_GetPixelFormatName(conversions[i].src_format), SDL_GetPixelFormatName(conversions[i].dst_format), mismatches);
+            SDL_DestroySurface(dst);
+        }
+        SDL_DestroySurface(src);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testBlitSurfaces(void *arg)
+{
+    SDL_Surface *src, *batched, *single;
+    SDL_Rect srcrects[16], dstrects[16], expected;
+    SDL_Rect clip;
+    int i, x, y, ret, mismatches;
+
+    src = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    batched = SDL_CreateSurface(40, 40, SDL_PIXELFORMAT_RGB565);
+    single = SDL_CreateSurface(40, 40, SDL_PIXELFORMAT_RGB565);
+    SDLTest_AssertCheck(src != NULL && batched != NULL && single != NULL, "Verify surfaces are not NULL");
+    if (src == NULL || batched == NULL || single == NULL) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(batched);
+        SDL_DestroySurface(single);
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            ((Uint32 *)src->pixels)[y * (src->pitch / 4) + x] = SDL_MapRGBA(src->format, (Uint8)(x * 8), (Uint8)(y * 8), (Uint8)((x ^ y) * 8), 0xFF);
+        }
+    }
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+    /* Draw the tiles in a shuffled order, some of them clipped by the destination */
+    clip.x = 2;
+    clip.y = 3;
+    clip.w = 30;
+    clip.h = 34;
+    SDL_SetSurfaceClipRect(batched, &clip);
+    SDL_SetSurfaceClipRect(single, &clip);
+    for (i = 0; i < SDL_arraysize(srcrects); ++i) {
+        srcrects[i].x = ((i * 5) % 4) * 8;
+        srcrects[i].y = ((i * 7) % 16 / 4) * 8;
+        srcrects[i].w = 8;
+        srcrects[i].h = 8;
+        dstrects[i].x = (i % 4) * 9 - 4;
+        dstrects[i].y = (i / 4) * 9;
+        dstrects[i].w = 0;
+        dstrects[i].h = 0;
+    }
+    ret = SDL_BlitSurfaces(src, srcrects, batched, dstrects, SDL_arraysize(srcrects));
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaces, expected: 0, got: %i", ret);
+
+    mismatches = 0;
+    for (i = 0; i < SDL_arraysize(srcrects); ++i) {
+        expected.x = (i % 4) * 9 - 4;
+        expected.y = (i / 4) * 9;
+        SDL_BlitSurface(src, &srcrects[i], single, &expected);
+        if (SDL_memcmp(&expected, &dstrects[i], sizeof(expected)) != 0) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify clipped rectangles match SDL_BlitSurface, expected: 0 mismatches, got: %d", mismatches);
+    ret = SDL_memcmp(batched->pixels, single->pixels, (size_t)batched->h * batched->pitch);
+    SDLTest_AssertCheck(ret == 0, "Verify pixels match SDL_BlitSurface, expected: 0, got: %i", ret);
+
+    /* A NULL source rectangle copies the entire source for each destination */
+    dstrects[0].x = 0;
+    dstrects[0].y = 0;
+    dstrects[1].x = 100;
+    dstrects[1].y = 100;
+    ret = SDL_BlitSurfaces(src, NULL, batched, dstrects, 2);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaces with NULL srcrects, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(dstrects[0].x == 2 && dstrects[0].y == 3 && dstrects[0].w == 30 && dstrects[0].h == 29,
+                        "Verify first rectangle is clipped, got: %d,%d %dx%d", dstrects[0].x, dstrects[0].y, dstrects[0].w, dstrects[0].h);
+    SDLTest_AssertCheck(dstrects[1].w == 0 && dstrects[1].h == 0, "Verify rectangle outside of the clip rectangle is empty");
+
+    ret = SDL_BlitSurfaces(src, srcrects, batched, NULL, 1);
+    SDLTest_AssertCheck(ret < 0, "Verify result from SDL_BlitSurfaces with NULL dstrects, expected: < 0, got: %i", ret);
+    ret = SDL_BlitSurfaces(src, srcrects, batched, dstrects, 0);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaces with no rectangles, expected: 0, got: %i", ret);
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(batched);
+    SDL_DestroySurface(single);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testPaletteBlit(void *arg)
+{
+    SDL_Surface *src, *dst;
+    SDL_Color colors[256];
+    Uint32 expected, actual;
+    int i, x, y, key, mismatches;
+
+    src = SDL_CreateSurface(37, 5, SDL_PIXELFORMAT_INDEX8);
+    dst = SDL_CreateSurface(37, 5, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+    if (src == NULL || dst == NULL) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        colors[i].r = (Uint8)i;
+        colors[i].g = (Uint8)(255 - i);
+        colors[i].b = (Uint8)(i * 7);
+        colors[i].a = 255;
+    }
+    SDL_SetPaletteColors(src->format->palette, colors, 0, SDL_arraysize(colors));
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            ((Uint8 *)src->pixels)[y * src->pitch + x] = (Uint8)((x * 53 + y * 31) & 0xFF);
+        }
+    }
+
+    /* Without and then with a colorkey, at a width that needs the scalar tail */
+    for (key = -1; key < 256; key += 84) {
+        if (key >= 0) {
+            SDL_SetSurfaceColorKey(src, SDL_TRUE, (Uint32)key);
+        }
+        SDL_memset(dst->pixels, 0x5A, (size_t)dst->h * dst->pitch);
+        SDL_BlitSurface(src, NULL, dst, NULL);
+
+        mismatches = 0;
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                Uint8 index = ((Uint8 *)src->pixels)[y * src->pitch + x];
+
+                if (index == key) {
+                    expected = 0x5A5A5A5A;
+                } else {
+                    expected = SDL_MapRGBA(dst->format, colors[index].r, colors[index].g, colors[index].b, colors[index].a);
+                }
+                actual = ((Uint32 *)dst->pixels)[y * (dst->pitch / 4) + x];
+                if (actual != expected) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify palette blit with colorkey %d, expected: 0 mismatches, got: %d", key, mismatches);
+    }
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testBlitScaledBlended(void *arg)
+{
+    static const SDL_ScaleMode modes[] = { SDL_SCALEMODE_LINEAR, SDL_SCALEMODE_AREA };
+    SDL_Surface *src, *converted, *scaled, *expected, *actual;
+    SDL_Rect srcrect = { 10, 5, 90, 70 };
+    SDL_Rect dstrect = { 3, 4, 300, 250 };
+    SDL_Rect tmprect;
+    int i, x, y, ret, mismatches;
+
+    src = SDL_CreateSurface(120, 80, SDL_PIXELFORMAT_RGB565);
+    scaled = SDL_CreateSurface(dstrect.w, dstrect.h, SDL_PIXELFORMAT_ARGB8888);
+    expected = SDL_CreateSurface(320, 260, SDL_PIXELFORMAT_ARGB8888);
+    actual = SDL_CreateSurface(320, 260, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL && scaled != NULL && expected != NULL && actual != NULL, "Verify surfaces are not NULL");
+    if (src == NULL || scaled == NULL || expected == NULL || actual == NULL) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(scaled);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            ((Uint16 *)src->pixels)[y * (src->pitch / 2) + x] = (Uint16)SDL_MapRGB(src->format, (Uint8)(x * 2), (Uint8)(y * 3), (Uint8)(x + y));
+        }
+    }
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceAlphaMod(src, 128);
+
+    /* The expected result scales the subrectangle into a full size copy, which is then blended */
+    converted = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(converted != NULL, "Verify result from SDL_ConvertSurfaceFormat is not NULL");
+    if (converted == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceAlphaMod(converted, 255);
+    SDL_SetSurfaceBlendMode(scaled, SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceAlphaMod(scaled, 128);
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        SDL_FillSurfaceRect(expected, NULL, 0xFF204060);
+        SDL_FillSurfaceRect(actual, NULL, 0xFF204060);
+
+        ret = SDL_BlitSurfaceScaledWithMode(converted, &srcrect, scaled, NULL, modes[i]);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaceScaledWithMode, expected: 0, got: %i", ret);
+        tmprect = dstrect;
+        SDL_BlitSurface(scaled, NULL, expected, &tmprect);
+
+        tmprect = dstrect;
+        ret = SDL_BlitSurfaceScaledWithMode(src, &srcrect, actual, &tmprect, modes[i]);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaceScaledWithMode, expected: 0, got: %i", ret);
+
+        /* The conversion of the source may round differently by one */
+        mismatches = 0;
+        for (y = 0; y < actual->h; ++y) {
+            for (x = 0; x < actual->w; ++x) {
+                Uint32 e = ((Uint32 *)expected->pixels)[y * (expected->pitch / 4) + x];
+                Uint32 a = ((Uint32 *)actual->pixels)[y * (actual->pitch / 4) + x];
+                int shift;
+
+                for (shift = 0; shift < 32; shift += 8) {
+                    if (SDL_abs((int)((e >> shift) & 0xFF) - (int)((a >> shift) & 0xFF)) > 1) {
+                        ++mismatches;
+                        break;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify blended scaled blit with scale mode %d matches, expected: 0 mismatches, got: %d", (int)modes[i], mismatches);
+    }
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(converted);
+    SDL_DestroySurface(scaled);
+    SDL_DestroySurface(expected);
+    SDL_DestroySurface(actual);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -835,6 +2153,70 @@ static const SDLTest_TestCaseReference surfaceTest12 = {
     (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTest13 = {
+    (SDLTest_TestCaseFp)surface_testBlit8888, "surface_testBlit8888", "Tests blitting between 8888 pixel formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest14 = {
+    (SDLTest_TestCaseFp)surface_testBlitThreaded, "surface_testBlitThreaded", "Tests splitting large blits across threads.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest15 = {
+    (SDLTest_TestCaseFp)surface_testBlitBlendGenerated, "surface_testBlitBlendGenerated", "Tests blending onto formats with generated blitters.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest16 = {
+    (SDLTest_TestCaseFp)surface_testBlitAlternateDestinations, "surface_testBlitAlternateDestinations", "Tests blitting one source onto several destinations.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest17 = {
+    (SDLTest_TestCaseFp)surface_testBlitScaledFilters, "surface_testBlitScaledFilters", "Tests area averaging and Lanczos scaling.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest18 = {
+    (SDLTest_TestCaseFp)surface_testBlendFillRects, "surface_testBlendFillRects", "Tests blended rectangle fills on 16 and 32-bit surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest19 = {
+    (SDLTest_TestCaseFp)surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Tests premultiplying and unpremultiplying alpha.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest20 = {
+    (SDLTest_TestCaseFp)surface_testSaveLoadRLE, "surface_testSaveLoadRLE", "Tests saving and loading RLE encoded colorkeyed surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest21 = {
+    (SDLTest_TestCaseFp)surface_testHDRConversion, "surface_testHDRConversion", "Tests conversions between 8-bit, 10-bit and floating point formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest22 = {
+    (SDLTest_TestCaseFp)surface_testLoadBMPFromMemory, "surface_testLoadBMPFromMemory", "Tests loading bitmaps from memory without copying the pixels.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest23 = {
+    (SDLTest_TestCaseFp)surface_testSurfacePool, "surface_testSurfacePool", "Tests reusing pixel memory from a surface pool.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest24 = {
+    (SDLTest_TestCaseFp)surface_testColorkeyWidths, "surface_testColorkeyWidths", "Tests colorkey blits and conversions at widths that aren't a multiple of the vector size.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest25 = {
+    (SDLTest_TestCaseFp)surface_testBlitSurfaces, "surface_testBlitSurfaces", "Tests blitting a batch of rectangles.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest26 = {
+    (SDLTest_TestCaseFp)surface_testPaletteBlit, "surface_testPaletteBlit", "Tests blitting 8-bit palettized surfaces to 32-bit surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest27 = {
+    (SDLTest_TestCaseFp)surface_testBlitScaledBlended, "surface_testBlitScaledBlended", "Tests filtered scaled blits that convert and blend.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTest28 = {
+    (SDLTest_TestCaseFp)surface_testSaveBMPBands, "surface_testSaveBMPBands", "Tests saving bitmaps a band of rows at a time, bottom-up and top-down.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
@@ -843,7 +2225,7 @@ static const SDLTest_TestCaseReference surfaceTestOverflow = {
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, &surfaceTest16, &surfaceTest17, &surfaceTest18, &surfaceTest19, &surfaceTest20, &surfaceTest21, &surfaceTest22, &surfaceTest23, &surfaceTest24, &surfaceTest25, &surfaceTest26, &surfaceTest27, &surfaceTest28, &surfaceTestOverflow, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,322 @@
+/**
+ * Thread pool and mutex test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+#define NUM_JOBS    1000
+#define NUM_STAGES  4
+
+typedef struct
+{
+    SDL_ThreadPool *pool;
+    SDL_AtomicInt count;
+    SDL_AtomicInt stage_done[NUM_STAGES];
+    SDL_AtomicInt out_of_order;
+} ThreadPoolTest;
+
+typedef struct
+{
+    ThreadPoolTest *test;
+    int stage;
+} ThreadPoolStageJob;
+
+static void SDLCALL CountJob(void *userdata)
+{
+    ThreadPoolTest *test = (ThreadPoolTest *)userdata;
+
+    SDL_AtomicIncRef(&test->count);
+}
+
+static void SDLCALL StageJob(void *userdata)
+{
+    ThreadPoolStageJob *job = (ThreadPoolStageJob *)userdata;
+    ThreadPoolTest *test = job->test;
+
+    /* Every job of the previous stage has to be done before this one starts */
+    if (job->stage > 0 && SDL_AtomicGet(&test->stage_done[job->stage - 1]) != NUM_JOBS) {
+        SDL_AtomicIncRef(&test->out_of_order);
+    }
+    SDL_AtomicIncRef(&test->stage_done[job->stage]);
+}
+
+static void SDLCALL NestedJob(void *userdata)
+{
+    ThreadPoolTest *test = (ThreadPoolTest *)userdata;
+    SDL_JobCounter counter;
+    int i;
+
+    SDL_zero(counter);
+    for (i = 0; i < 10; ++i) {
+        SDL_SubmitJob(test->pool, CountJob, test, NULL, &counter);
+    }
+    SDL_WaitJobCounter(test->pool, &counter);
+    if (SDL_AtomicGet(&counter.value) != 0) {
+        SDL_AtomicIncRef(&test->out_of_order);
+    }
+}
+
+/* Test case functions */
+
+/**
+ * Run a large number of jobs on a thread pool and wait for them
+ */
+static int thread_poolJobs(void *arg)
+{
+    ThreadPoolTest test;
+    SDL_JobCounter counter;
+    int cpus[2] = { 0, -1 };
+    int i, result;
+
+    SDL_zero(test);
+    SDL_zero(counter);
+
+    SDLTest_AssertCheck(SDL_CreateThreadPool(-1, NULL) == NULL, "Check SDL_CreateThreadPool(-1) fails");
+    SDLTest_AssertCheck(SDL_SubmitJob(NULL, CountJob, &test, NULL, NULL) == -1, "Check SDL_SubmitJob(pool = NULL) fails");
+
+    test.pool = SDL_CreateThreadPool(2, cpus);
+    SDLTest_AssertCheck(test.pool != NULL, "SDL_CreateThreadPool(2, cpus)");
+    if (!test.pool) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_SubmitJob(test.pool, NULL, &test, NULL, NULL) == -1, "Check SDL_SubmitJob(func = NULL) fails");
+
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDL_SubmitJob(test.pool, CountJob, &test, NULL, &counter);
+    }
+    SDL_WaitJobCounter(test.pool, &counter);
+    result = SDL_AtomicGet(&test.count);
+    SDLTest_AssertCheck(result == NUM_JOBS, "Check jobs that ran, expected: %d, got: %d", NUM_JOBS, result);
+    result = SDL_AtomicGet(&counter.value);
+    SDLTest_AssertCheck(result == 0, "Check counter, expected: 0, got: %d", result);
+
+    /* Jobs left running are finished before the pool is destroyed */
+    SDL_AtomicSet(&test.count, 0);
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDL_SubmitJob(test.pool, CountJob, &test, NULL, NULL);
+    }
+    SDL_DestroyThreadPool(test.pool);
+    result = SDL_AtomicGet(&test.count);
+    SDLTest_AssertCheck(result == NUM_JOBS, "Check jobs that ran before destroying the pool, expected: %d, got: %d", NUM_JOBS, result);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Run stages of jobs that depend on each other, and jobs that wait for their own jobs
+ */
+static int thread_poolDependencies(void *arg)
+{
+    ThreadPoolTest test;
+    ThreadPoolStageJob *jobs;
+    SDL_JobCounter counters[NUM_STAGES];
+    SDL_JobCounter nested;
+    int stage, i, result;
+
+    SDL_zero(test);
+    SDL_zero(counters);
+    SDL_zero(nested);
+
+    jobs = (ThreadPoolStageJob *)SDL_malloc(NUM_STAGES * NUM_JOBS * sizeof(*jobs));
+    SDLTest_AssertCheck(jobs != NULL, "SDL_malloc()");
+    if (!jobs) {
+        return TEST_ABORTED;
+    }
+
+    test.pool = SDL_CreateThreadPool(4, NULL);
+    SDLTest_AssertCheck(test.pool != NULL, "SDL_CreateThreadPool(4, NULL)");
+    if (!test.pool) {
+        SDL_free(jobs);
+        return TEST_ABORTED;
+    }
+
+    /* Submit every stage up front, later stages wait while the earlier ones are still running */
+    for (stage = 0; stage < NUM_STAGES; ++stage) {
+        for (i = 0; i < NUM_JOBS; ++i) {
+            ThreadPoolStageJob *job = &jobs[stage * NUM_JOBS + i];
+            job->test = &test;
+            job->stage = stage;
+            SDL_SubmitJob(test.pool, StageJob, job, stage > 0 ? &counters[stage - 1] : NULL, &counters[stage]);
+        }
+    }
+    SDL_WaitJobCounter(test.pool, &counters[NUM_STAGES - 1]);
+    for (stage = 0; stage < NUM_STAGES; ++stage) {
+        result = SDL_AtomicGet(&test.stage_done[stage]);
+        SDLTest_AssertCheck(result == NUM_JOBS, "Check stage %d jobs that ran, expected: %d, got: %d", stage, NUM_JOBS, result);
+    }
+    result = SDL_AtomicGet(&test.out_of_order);
+    SDLTest_AssertCheck(result == 0, "Check jobs that ran before their dependency, expected: 0, got: %d", result);
+
+    /* Jobs waiting for jobs they submit keep running them rather than blocking the workers */
+    for (i = 0; i < 100; ++i) {
+        SDL_SubmitJob(test.pool, NestedJob, &test, NULL, &nested);
+    }
+    SDL_WaitJobCounter(test.pool, &nested);
+    result = SDL_AtomicGet(&test.count);
+    SDLTest_AssertCheck(result == 100 * 10, "Check nested jobs that ran, expected: %d, got: %d", 100 * 10, result);
+    result = SDL_AtomicGet(&test.out_of_order);
+    SDLTest_AssertCheck(result == 0, "Check nested waits, expected: 0 failures, got: %d", result);
+
+    SDL_DestroyThreadPool(test.pool);
+    SDL_free(jobs);
+
+    return TEST_COMPLETED;
+}
+
+#define NUM_MUTEX_THREADS    4
+#define NUM_MUTEX_INCREMENTS 10000
+
+typedef struct
+{
+    SDL_Mutex *mutex;
+    int count;
+} MutexTest;
+
+static int SDLCALL MutexThread(void *data)
+{
+    MutexTest *test = (MutexTest *)data;
+    int i;
+
+    for (i = 0; i < NUM_MUTEX_INCREMENTS; ++i) {
+        SDL_LockMutex(test->mutex);
+        SDL_LockMutex(test->mutex); /* Mutexes are recursive */
+        ++test->count;
+        SDL_UnlockMutex(test->mutex);
+        SDL_UnlockMutex(test->mutex);
+    }
+    return 0;
+}
+
+/**
+ * Lock a mutex from several threads, with and without spinning
+ */
+static int thread_mutexContention(void *arg)
+{
+    static const char *spin_counts[] = { "0", NULL };
+    SDL_Thread *threads[NUM_MUTEX_THREADS];
+    MutexTest test;
+    int i, j;
+
+    for (i = 0; i < (int)SDL_arraysize(spin_counts); ++i) {
+        SDL_SetHint(SDL_HINT_MUTEX_SPIN_COUNT, spin_counts[i]);
+
+        SDL_zero(test);
+        test.mutex = SDL_CreateMutex();
+        SDLTest_AssertCheck(test.mutex != NULL, "SDL_CreateMutex() with spin count %s", spin_counts[i] ? spin_counts[i] : "default");
+        if (!test.mutex) {
+            continue;
+        }
+
+        for (j = 0; j < NUM_MUTEX_THREADS; ++j) {
+            threads[j] = SDL_CreateThread(MutexThread, "MutexThread", &test);
+            SDLTest_AssertCheck(threads[j] != NULL, "SDL_CreateThread()");
+        }
+        for (j = 0; j < NUM_MUTEX_THREADS; ++j) {
+            SDL_WaitThread(threads[j], NULL);
+        }
+        SDLTest_AssertCheck(test.count == NUM_MUTEX_THREADS * NUM_MUTEX_INCREMENTS,
+                            "Check count, expected: %d, got: %d", NUM_MUTEX_THREADS * NUM_MUTEX_INCREMENTS, test.count);
+
+        SDL_DestroyMutex(test.mutex);
+    }
+    SDL_ResetHint(SDL_HINT_MUTEX_SPIN_COUNT);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    int cpu;
+    int result;
+} AffinityTest;
+
+static int SDLCALL AffinityThread(void *data)
+{
+    AffinityTest *test = (AffinityTest *)data;
+
+    test->result = SDL_SetThreadAffinity(&test->cpu, 1);
+    if (test->result == 0) {
+        test->result = SDL_SetThreadAffinity(NULL, 0);
+    }
+    if (test->result == 0) {
+        test->result = SDL_SetThreadQoS(SDL_THREAD_QOS_INTERACTIVE);
+    }
+    return 0;
+}
+
+/**
+ * Query the CPU topology and move a thread between cores
+ */
+static int thread_affinity(void *arg)
+{
+    SDL_CPUCoreInfo *cores;
+    SDL_Thread *thread;
+    AffinityTest test;
+    int i, j, count = 0;
+    int cpus[1] = { -1 };
+
+    cores = SDL_GetCPUTopology(&count);
+    SDLTest_AssertPass("Call to SDL_GetCPUTopology()");
+    SDLTest_AssertCheck(cores != NULL && count > 0, "Check output, expected cores, got %d", count);
+    if (!cores) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < count; ++i) {
+        SDLTest_AssertCheck(cores[i].cpu >= 0, "Check CPU %d, expected cpu >= 0, got %d", i, cores[i].cpu);
+        SDLTest_AssertCheck(cores[i].core >= 0 && cores[i].core < count, "Check CPU %d, expected core in [0, %d), got %d", i, count, cores[i].core);
+        SDLTest_AssertCheck(cores[i].cache_group >= 0 && cores[i].cache_group < count, "Check CPU %d, expected cache group in [0, %d), got %d", i, count, cores[i].cache_group);
+        SDLTest_AssertCheck(cores[i].performance_class >= 0 && cores[i].performance_class < count, "Check CPU %d, expected performance class in [0, %d), got %d", i, count, cores[i].performance_class);
+        for (j = 0; j < i; ++j) {
+            SDLTest_AssertCheck(cores[i].cpu != cores[j].cpu, "Check CPU %d, expected a unique cpu, got %d twice", i, cores[i].cpu);
+        }
+    }
+
+    SDLTest_AssertCheck(SDL_SetThreadAffinity(cpus, 1) < 0, "Check SDL_SetThreadAffinity() with an invalid CPU fails");
+    SDLTest_AssertCheck(SDL_SetThreadAffinity(cpus, 0) < 0, "Check SDL_SetThreadAffinity() with no CPUs fails");
+    SDLTest_AssertCheck(SDL_SetThreadQoS((SDL_ThreadQoS)-1) < 0, "Check SDL_SetThreadQoS() with an invalid class fails");
+
+    /* Do this on another thread, to leave the test thread where it was */
+    test.cpu = cores[0].cpu;
+    test.result = -1;
+    SDL_free(cores);
+    thread = SDL_CreateThread(AffinityThread, "AffinityThread", &test);
+    SDLTest_AssertCheck(thread != NULL, "SDL_CreateThread()");
+    SDL_WaitThread(thread, NULL);
+    /* This isn't supported everywhere, and the first CPU may be outside of our cgroup */
+    SDLTest_Log("Setting thread affinity and QoS returned %d", test.result);
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Thread test cases */
+static const SDLTest_TestCaseReference threadTest1 = {
+    (SDLTest_TestCaseFp)thread_poolJobs, "thread_poolJobs", "Run jobs on a thread pool", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest2 = {
+    (SDLTest_TestCaseFp)thread_poolDependencies, "thread_poolDependencies", "Run thread pool jobs with dependencies", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest3 = {
+    (SDLTest_TestCaseFp)thread_mutexContention, "thread_mutexContention", "Lock a mutex from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest4 = {
+    (SDLTest_TestCaseFp)thread_affinity, "thread_affinity", "Get the CPU topology and set thread affinity", TEST_ENABLED
+};
+
+/* Sequence of Thread test cases */
+static const SDLTest_TestCaseReference *threadTests[] = {
+    &threadTest1, &threadTest2, &threadTest3, &threadTest4, NULL
+};
+
+/* Thread test suite (global) */
+SDLTest_TestSuiteReference threadTestSuite = {
+    "Thread",
+    NULL,
+    threadTests,
+    NULL
+};
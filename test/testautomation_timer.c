@@ -168,6 +168,120 @@ static int timer_addRemoveTimer(void *arg)
     return TEST_COMPLETED;
 }
 
+#define NUM_MANY_TIMERS 5000
+
+static SDL_AtomicInt g_timerOrderCount;
+static int g_timerOrder[5];
+
+static Uint32 SDLCALL timerOrderCallback(Uint32 interval, void *param)
+{
+    int index = SDL_AtomicAdd(&g_timerOrderCount, 1);
+
+    if (index < (int)SDL_arraysize(g_timerOrder)) {
+        g_timerOrder[index] = (int)(intptr_t)param;
+    }
+    return 0;
+}
+
+/**
+ * Add and remove a large number of timers, and check timers fire in order
+ */
+static int timer_manyTimers(void *arg)
+{
+    static const Uint32 intervals[] = { 50, 10, 40, 20, 30 };
+    SDL_TimerID *ids;
+    SDL_bool result;
+    int i, removed = 0, count;
+    Uint64 start;
+
+    ids = (SDL_TimerID *)SDL_malloc(NUM_MANY_TIMERS * sizeof(*ids));
+    SDLTest_AssertCheck(ids != NULL, "SDL_malloc()");
+    if (!ids) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < NUM_MANY_TIMERS; i++) {
+        ids[i] = SDL_AddTimer(60000, timerTestCallback, NULL);
+    }
+    SDLTest_AssertPass("Call to SDL_AddTimer() %d times", NUM_MANY_TIMERS);
+
+    /* Remove them in an order unrelated to how they were added */
+    for (i = 0; i < NUM_MANY_TIMERS; i++) {
+        if (SDL_RemoveTimer(ids[(i * 7919) % NUM_MANY_TIMERS])) {
+            removed++;
+        }
+    }
+    SDLTest_AssertCheck(removed == NUM_MANY_TIMERS, "Check removed timers, expected: %d, got: %d", NUM_MANY_TIMERS, removed);
+    result = SDL_RemoveTimer(ids[0]);
+    SDLTest_AssertCheck(result == SDL_FALSE, "Check removing a timer twice, expected: %i, got: %i", SDL_FALSE, result);
+    SDL_free(ids);
+
+    SDL_AtomicSet(&g_timerOrderCount, 0);
+    for (i = 0; i < (int)SDL_arraysize(intervals); i++) {
+        SDL_AddTimer(intervals[i], timerOrderCallback, (void *)(intptr_t)intervals[i]);
+    }
+    start = SDL_GetTicks();
+    while (SDL_AtomicGet(&g_timerOrderCount) < (int)SDL_arraysize(intervals) && (SDL_GetTicks() - start) < 5000) {
+        SDL_Delay(10);
+    }
+    count = SDL_AtomicGet(&g_timerOrderCount);
+    SDLTest_AssertCheck(count == (int)SDL_arraysize(intervals), "Check timers that fired, expected: %d, got: %d", (int)SDL_arraysize(intervals), count);
+    for (i = 1; i < count; i++) {
+        SDLTest_AssertCheck(g_timerOrder[i - 1] < g_timerOrder[i], "Check timer %d fired in order, %d before %d", i, g_timerOrder[i - 1], g_timerOrder[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static SDL_AtomicInt g_timerNSCount;
+
+static Uint64 SDLCALL timerNSCallback(Uint64 interval, void *param)
+{
+    if (SDL_AtomicAdd(&g_timerNSCount, 1) + 1 >= *(int *)param) {
+        return 0;
+    }
+    return interval;
+}
+
+/**
+ * Call to SDL_DelayPrecise and SDL_AddTimerNS
+ */
+static int timer_highResolution(void *arg)
+{
+    const Uint64 testDelay = SDL_US_TO_NS(2500);
+    const Uint64 interval = SDL_US_TO_NS(500);
+    int repeats = 10;
+    SDL_TimerID id;
+    Uint64 start, elapsed;
+    int count;
+
+    /* Zero delay */
+    SDL_DelayPrecise(0);
+    SDLTest_AssertPass("Call to SDL_DelayPrecise(0)");
+
+    start = SDL_GetTicksNS();
+    SDL_DelayPrecise(testDelay);
+    elapsed = SDL_GetTicksNS() - start;
+    SDLTest_AssertCheck(elapsed >= testDelay, "Check SDL_DelayPrecise() waited, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, testDelay, elapsed);
+
+    /* Run a sub-millisecond timer a few times */
+    SDL_AtomicSet(&g_timerNSCount, 0);
+    start = SDL_GetTicksNS();
+    id = SDL_AddTimerNS(interval, timerNSCallback, &repeats);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS()");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+    while (SDL_AtomicGet(&g_timerNSCount) < repeats && (SDL_GetTicksNS() - start) < SDL_MS_TO_NS(5000)) {
+        SDL_Delay(1);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    count = SDL_AtomicGet(&g_timerNSCount);
+    SDLTest_AssertCheck(count == repeats, "Check timer callback count, expected: %d, got: %d", repeats, count);
+    SDLTest_AssertCheck(elapsed >= repeats * interval, "Check timer interval, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, repeats * interval, elapsed);
+    SDLTest_AssertCheck(SDL_RemoveTimer(id) == SDL_FALSE, "Check finished timer can't be removed");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +301,17 @@ static const SDLTest_TestCaseReference timerTest4 = {
     (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    (SDLTest_TestCaseFp)timer_manyTimers, "timer_manyTimers", "Call to SDL_AddTimer and SDL_RemoveTimer with many timers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest6 = {
+    (SDLTest_TestCaseFp)timer_highResolution, "timer_highResolution", "Call to SDL_DelayPrecise and SDL_AddTimerNS", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, NULL
 };
 
 /* Timer test suite (global) */
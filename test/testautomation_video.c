@@ -1822,6 +1822,56 @@ static int video_setWindowCenteredOnDisplay(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests the variable refresh rate display properties and SDL_SetWindowVariableRefreshRate
+ */
+static int video_setWindowVariableRefreshRate(void *arg)
+{
+    const char *title = "video_setWindowVariableRefreshRate Test Window";
+    SDL_DisplayID *displays;
+    SDL_Window *window;
+    int result;
+    int i;
+
+    /* Displays that support VRR report a sensible range, if they report one */
+    displays = SDL_GetDisplays(NULL);
+    if (displays) {
+        for (i = 0; displays[i]; ++i) {
+            SDL_PropertiesID props = SDL_GetDisplayProperties(displays[i]);
+            SDLTest_AssertPass("Call to SDL_GetDisplayProperties(%" SDL_PRIu32 ")", displays[i]);
+            if (SDL_GetBooleanProperty(props, "SDL.display.vrr_capable", SDL_FALSE)) {
+                float min_rate = SDL_GetFloatProperty(props, "SDL.display.vrr_min_refresh_rate", 0.0f);
+                float max_rate = SDL_GetFloatProperty(props, "SDL.display.vrr_max_refresh_rate", 0.0f);
+                SDLTest_AssertCheck(min_rate <= max_rate, "Validate VRR range; got: %f-%f", min_rate, max_rate);
+            }
+        }
+        SDL_free(displays);
+    }
+
+    window = createVideoSuiteTestWindow(title);
+    if (!window) {
+        return TEST_ABORTED;
+    }
+
+    /* Whether this succeeds depends on the driver, but it mustn't crash */
+    result = SDL_SetWindowVariableRefreshRate(window, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_SetWindowVariableRefreshRate(window, SDL_TRUE), got: %d", result);
+    result = SDL_SetWindowVariableRefreshRate(window, SDL_FALSE);
+    SDLTest_AssertPass("Call to SDL_SetWindowVariableRefreshRate(window, SDL_FALSE), got: %d", result);
+
+    destroyVideoSuiteTestWindow(window);
+
+    /* Negative tests */
+    SDL_ClearError();
+    SDLTest_AssertPass("Call to SDL_ClearError()");
+    result = SDL_SetWindowVariableRefreshRate(NULL, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_SetWindowVariableRefreshRate(window=NULL)");
+    SDLTest_AssertCheck(result == -1, "Verify return value; expected: -1, got: %d", result);
+    checkInvalidWindowError();
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -1897,12 +1947,16 @@ static const SDLTest_TestCaseReference videoTest18 = {
     (SDLTest_TestCaseFp)video_setWindowCenteredOnDisplay, "video_setWindowCenteredOnDisplay", "Checks using SDL_WINDOWPOS_CENTERED_DISPLAY centers the window on a display", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference videoTest19 = {
+    (SDLTest_TestCaseFp)video_setWindowVariableRefreshRate, "video_setWindowVariableRefreshRate", "Checks the VRR display properties and SDL_SetWindowVariableRefreshRate", TEST_ENABLED
+};
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTest1, &videoTest2, &videoTest3, &videoTest4, &videoTest5, &videoTest6,
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
-    &videoTest18, NULL
+    &videoTest18, &videoTest19, NULL
 };
 
 /* Video test suite (global) */
@@ -45,8 +45,19 @@ static SDL_bool suspend_when_occluded;
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
 static int iterations = -1;
 
+/* Benchmark mode: measure a fixed number of frames, then print statistics and quit */
+#define BENCHMARK_WARMUP_FRAMES 10
+static int benchmark_frames = 0;
+static int benchmark_frame;
+static Uint64 *frame_times;
+static Uint64 last_frame_ns;
+static clock_t benchmark_cpu_start;
+static Uint64 benchmark_draw_commands;
+static Uint64 benchmark_batches;
+
 void SDL_AppQuit(void)
 {
+    SDL_free(frame_times);
     SDL_free(sprites);
     SDL_free(positions);
     SDL_free(velocities);
@@ -384,6 +395,96 @@ static void MoveSprites(SDL_Renderer *renderer, SDL_Texture *sprite)
     SDL_RenderPresent(renderer);
 }
 
+static int SDLCALL CompareFrameTimes(const void *a, const void *b)
+{
+    const Uint64 A = *(const Uint64 *)a;
+    const Uint64 B = *(const Uint64 *)b;
+
+    if (A < B) {
+        return -1;
+    } else if (A > B) {
+        return 1;
+    }
+    return 0;
+}
+
+static double FrameTimePercentile(int percent)
+{
+    int index = (benchmark_frames * percent + 99) / 100 - 1;
+    if (index < 0) {
+        index = 0;
+    }
+    return frame_times[index] / 1000000.0;
+}
+
+static void CountFrameStats(SDL_Renderer *renderer)
+{
+    static const char *draw_commands[] = {
+        "SDL.renderer.stats.commands.clear",
+        "SDL.renderer.stats.commands.draw_points",
+        "SDL.renderer.stats.commands.draw_lines",
+        "SDL.renderer.stats.commands.fill_rects",
+        "SDL.renderer.stats.commands.copy",
+        "SDL.renderer.stats.commands.copy_ex",
+        "SDL.renderer.stats.commands.geometry",
+        "SDL.renderer.stats.commands.draw_instances"
+    };
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    int i;
+
+    for (i = 0; i < SDL_arraysize(draw_commands); ++i) {
+        benchmark_draw_commands += SDL_GetNumberProperty(props, draw_commands[i], 0);
+    }
+    benchmark_batches += SDL_GetNumberProperty(props, "SDL.renderer.stats.batches", 0);
+}
+
+static void LogBenchmark(void)
+{
+    const double cpu_ms = (double)(clock() - benchmark_cpu_start) * 1000.0 / CLOCKS_PER_SEC;
+    SDL_RendererInfo info;
+    Uint64 total = 0;
+    int i;
+
+    for (i = 0; i < benchmark_frames; ++i) {
+        total += frame_times[i];
+    }
+    SDL_qsort(frame_times, benchmark_frames, sizeof(*frame_times), CompareFrameTimes);
+
+    SDL_GetRendererInfo(state->renderers[0], &info);
+    SDL_Log("Benchmark: renderer %s, %d sprites, %d windows, %d frames\n", info.name, num_sprites, state->num_windows, benchmark_frames);
+    SDL_Log("  frame time: mean %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+            (total / (double)benchmark_frames) / 1000000.0,
+            FrameTimePercentile(50), FrameTimePercentile(90), FrameTimePercentile(99),
+            frame_times[benchmark_frames - 1] / 1000000.0);
+    SDL_Log("  per frame: %.1f draw commands, %.1f batches, %.3f ms CPU time\n",
+            benchmark_draw_commands / (double)benchmark_frames,
+            benchmark_batches / (double)benchmark_frames,
+            cpu_ms / benchmark_frames);
+}
+
+/* Returns 1 when the benchmark is done */
+static int UpdateBenchmark(void)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    int i;
+
+    if (benchmark_frame >= BENCHMARK_WARMUP_FRAMES) {
+        frame_times[benchmark_frame - BENCHMARK_WARMUP_FRAMES] = now - last_frame_ns;
+        for (i = 0; i < state->num_windows; ++i) {
+            CountFrameStats(state->renderers[i]);
+        }
+    } else if (benchmark_frame == BENCHMARK_WARMUP_FRAMES - 1) {
+        benchmark_cpu_start = clock();
+    }
+    last_frame_ns = now;
+
+    if (++benchmark_frame == BENCHMARK_WARMUP_FRAMES + benchmark_frames) {
+        LogBenchmark();
+        return 1;
+    }
+    return 0;
+}
+
 int SDL_AppEvent(const SDL_Event *event)
 {
     return SDLTest_CommonEventMainCallbacks(state, event);
@@ -409,6 +510,10 @@ int SDL_AppIterate(void)
         SDL_DelayNS(SDL_NS_PER_SECOND / 15);
     }
 
+    if (benchmark_frames > 0) {
+        return UpdateBenchmark();
+    }
+
     frames++;
     now = SDL_GetTicks();
     if (now >= next_fps_check) {
@@ -474,6 +579,13 @@ int SDL_AppInit(int argc, char *argv[])
                     }
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--benchmark") == 0) {
+                if (argv[i + 1]) {
+                    benchmark_frames = SDL_atoi(argv[i + 1]);
+                    if (benchmark_frames > 0) {
+                        consumed = 2;
+                    }
+                }
             } else if (SDL_strcasecmp(argv[i], "--cyclecolor") == 0) {
                 cycle_color = SDL_TRUE;
                 consumed = 1;
@@ -512,6 +624,7 @@ int SDL_AppInit(int argc, char *argv[])
                 "[--cyclealpha]",
                 "[--suspend-when-occluded]",
                 "[--iterations N]",
+                "[--benchmark N]",
                 "[--use-rendergeometry mode1|mode2]",
                 "[num_sprites]",
                 "[icon.bmp]",
@@ -522,6 +635,16 @@ int SDL_AppInit(int argc, char *argv[])
         }
         i += consumed;
     }
+    if (benchmark_frames > 0) {
+        /* Measure as fast as the renderer can go, and collect its statistics */
+        state->render_flags &= ~SDL_RENDERER_PRESENTVSYNC;
+        state->render_stats = SDL_TRUE;
+        frame_times = (Uint64 *)SDL_malloc(benchmark_frames * sizeof(*frame_times));
+        if (!frame_times) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+            return -1;
+        }
+    }
     if (!SDLTest_CommonInit(state)) {
         return -1;
     }
@@ -554,6 +677,9 @@ int SDL_AppInit(int argc, char *argv[])
     if (iterations >= 0) {
         /* Deterministic seed - used for visual tests */
         seed = (Uint64)iterations;
+    } else if (benchmark_frames > 0) {
+        /* Deterministic seed, so every benchmark run draws the same scene */
+        seed = 0;
     } else {
         /* Pseudo-random seed generated from the time */
         seed = (Uint64)time(NULL);